@@ -20,13 +20,105 @@
 
 #include <DataTypes.h>
 #include <fixmath/FixPoint.h>
+#include <misc/SDL2pp.h>
 
 #include <list>
+#include <memory>
 #include <vector>
 
 class UnitBase;
 class Map;
 
+#define ASTAR_BLOCKSHIFT    4                               ///< the nodes are allocated in blocks of 16x16 tiles
+#define ASTAR_BLOCKSIZE     (1 << ASTAR_BLOCKSHIFT)
+#define ASTAR_BLOCKMASK     (ASTAR_BLOCKSIZE - 1)
+
+/**
+    Scratch memory for one path search. The nodes are allocated in blocks of ASTAR_BLOCKSIZE x ASTAR_BLOCKSIZE
+    tiles on their first access, so the memory scales with the area searched and not with the map size. The
+    nodes are never cleared between searches; instead every node remembers the generation of the search that
+    last touched it and is reset lazily on its first access in a new search.
+*/
+class AStarWorkspace {
+public:
+    struct TileData {
+        Coord    parentCoord;
+        size_t   openListIndex;
+        FixPoint g;
+        FixPoint h;
+        FixPoint f;
+        bool     bInOpenList;
+        bool     bClosed;
+        Uint32   generation;        ///< the search generation this node was last initialized for
+    };
+
+    AStarWorkspace() = default;
+
+    AStarWorkspace(const AStarWorkspace &) = delete;
+    AStarWorkspace(AStarWorkspace &&) = delete;
+    AStarWorkspace& operator=(const AStarWorkspace &) = delete;
+    AStarWorkspace& operator=(AStarWorkspace &&) = delete;
+
+    /**
+        Starts a new search on a map of the given size. All nodes are considered unvisited afterwards.
+        \param  sizeX   the width of the map
+        \param  sizeY   the height of the map
+    */
+    void beginSearch(int sizeX, int sizeY);
+
+    inline TileData& getMapData(const Coord& coord) {
+        std::unique_ptr<TileData[]>& pBlock = blocks[(coord.y >> ASTAR_BLOCKSHIFT) * numBlocksX + (coord.x >> ASTAR_BLOCKSHIFT)];
+        if(!pBlock) {
+            pBlock = std::make_unique<TileData[]>(ASTAR_BLOCKSIZE*ASTAR_BLOCKSIZE);
+        }
+
+        TileData& data = pBlock[((coord.y & ASTAR_BLOCKMASK) << ASTAR_BLOCKSHIFT) | (coord.x & ASTAR_BLOCKMASK)];
+        if(data.generation != currentGeneration) {
+            data = TileData();
+            data.generation = currentGeneration;
+        }
+        return data;
+    }
+
+    std::vector<Coord> openList;    ///< the open list as a binary heap (keeps its capacity between searches)
+    bool bInUse = false;            ///< is this workspace currently used by an AStarSearch?
+
+private:
+    std::vector<std::unique_ptr<TileData[]>> blocks;    ///< the node blocks (nullptr if not yet accessed)
+    int sizeX = 0;                                      ///< the width of the map the blocks were allocated for
+    int sizeY = 0;                                      ///< the height of the map the blocks were allocated for
+    int numBlocksX = 0;                                 ///< the number of blocks in x direction
+    Uint32 currentGeneration = 0;
+};
+
+/**
+    A per-map pool of AStarWorkspace objects. Normally only one workspace is needed but if a search is started
+    while another one is still alive a second workspace is created. Searches may run concurrently (see
+    PathRequestQueue), so acquiring and releasing a workspace is guarded by a mutex.
+*/
+class AStarWorkspacePool {
+public:
+    AStarWorkspacePool();
+    ~AStarWorkspacePool();
+
+    AStarWorkspacePool(const AStarWorkspacePool &) = delete;
+    AStarWorkspacePool(AStarWorkspacePool &&) = delete;
+    AStarWorkspacePool& operator=(const AStarWorkspacePool &) = delete;
+    AStarWorkspacePool& operator=(AStarWorkspacePool &&) = delete;
+
+    AStarWorkspace& acquire(int sizeX, int sizeY);
+
+    void release(AStarWorkspace& workspace) {
+        SDL_LockMutex(mutex);
+        workspace.bInUse = false;
+        SDL_UnlockMutex(mutex);
+    }
+
+private:
+    SDL_mutex* mutex;                                           ///< guards workspaces and their bInUse flags
+    std::vector<std::unique_ptr<AStarWorkspace>> workspaces;
+};
+
 class AStarSearch {
 public:
     AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destination);
@@ -37,6 +129,11 @@ public:
     AStarSearch& operator=(const AStarSearch &) = delete;
     AStarSearch& operator=(AStarSearch &&) = delete;
 
+    /**
+        Returns the number of nodes that were expanded by this search. This is a measure of how expensive the search was.
+    */
+    int getNumNodesChecked() const noexcept { return numNodesChecked; }
+
     std::list<Coord> getFoundPath() {
         std::list<Coord> path;
 
@@ -60,18 +157,15 @@ public:
     };
 
 private:
-    struct TileData {
-        Coord    parentCoord;
-        size_t   openListIndex;
-        FixPoint g;
-        FixPoint h;
-        FixPoint f;
-        bool     bInOpenList;
-        bool     bClosed;
-    };
+    typedef AStarWorkspace::TileData TileData;
 
+    /**
+        Runs the search. The movement and turning costs are looked up in tables calculated once per search.
+        Flying units never search (see UnitBase::preparePathSearch()).
+    */
+    void search(Map* pMap, UnitBase* pUnit, Coord start, Coord destination);
 
-    inline TileData& getMapData(const Coord& coord) const { return mapData[coord.y * sizeX + coord.x]; };
+    inline TileData& getMapData(const Coord& coord) const { return workspace.getMapData(coord); };
 
     void trickleUp(size_t openListIndex) {
         Coord bottom = openList[openListIndex];
@@ -181,11 +275,13 @@ private:
         return ret;
     };
 
+    AStarWorkspacePool& workspacePool;
+    AStarWorkspace& workspace;
     int sizeX;
     int sizeY;
     Coord bestCoord;
-    TileData* mapData;
-    std::vector<Coord> openList;
+    int numNodesChecked = 0;
+    std::vector<Coord>& openList;
 };
 
 #endif //ASTARSEARCH_H
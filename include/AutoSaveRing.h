@@ -0,0 +1,86 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef AUTOSAVERING_H
+#define AUTOSAVERING_H
+
+#include <misc/InputStream.h>
+#include <misc/SDL2pp.h>
+
+#include <memory>
+#include <string>
+
+#define AUTOSAVE_DELTA_MAGIC    0x41534444      ///< marks an autosave that is stored as delta to a base file
+#define AUTOSAVE_NUM_BASES      2               ///< the number of base files the autosaves alternate between
+
+class BackgroundFileWriter;
+class OMemoryStream;
+
+/**
+    Writes the autosaves of a game into a ring of numSlots savegames ("autosave1.dls", ...). Only every numSlots-th
+    autosave writes the complete game state to a base file ("autosave_base1.dlb", ...), the savegames in the ring just
+    contain a SnapshotDelta to that base. The bases alternate, so a base is only overwritten when no savegame in the
+    ring refers to it anymore.
+*/
+class AutoSaveRing {
+public:
+    /**
+        Constructor
+        \param  directory   the directory for the savegames (with trailing slash)
+        \param  numSlots    the number of savegames in the ring
+    */
+    AutoSaveRing(const std::string& directory, int numSlots);
+
+    AutoSaveRing(const AutoSaveRing &) = delete;
+    AutoSaveRing& operator=(const AutoSaveRing &) = delete;
+
+    /**
+        Adds a restore point to the ring. The first restore point removes the autosaves of a previous game. The
+        delta to the base is created on the thread of writer.
+        \param  pSnapshot   the save game data (see Game::saveGame())
+        \param  writer      the writer for the files
+    */
+    void add(std::unique_ptr<OMemoryStream> pSnapshot, BackgroundFileWriter& writer);
+
+    /**
+        Opens a savegame that might be an autosave delta or compressed.
+        \param  filename    the savegame to open
+        \return the stream to read the game state from or nullptr if the file cannot be opened
+    */
+    static std::unique_ptr<InputStream> openSaveGame(const std::string& filename);
+
+    /**
+        Reads a complete savegame that might be an autosave delta or compressed. Throws std::runtime_error if the
+        savegame is an autosave delta whose base file is missing or was overwritten.
+        \param  filename    the savegame to read
+        \return the game state or an empty string if the file cannot be read
+    */
+    static std::string readSaveGame(const std::string& filename);
+
+private:
+    std::string getSlotFilename(int slot) const;
+    std::string getBaseFilename(int base) const;
+
+    const std::string directory;                ///< the directory for the savegames
+    const int numSlots;                         ///< the number of savegames in the ring
+
+    int nextSlot = 0;                           ///< the slot the next restore point is written to
+    int currentBase = -1;                       ///< the base file the restore points are written relative to (-1 before the first restore point)
+    int numRestorePointsOnBase = 0;             ///< the number of restore points written relative to currentBase
+    std::shared_ptr<const std::string> pBaseSnapshot;   ///< the content of the current base file (shared with the queued deltas)
+};
+
+#endif // AUTOSAVERING_H
@@ -0,0 +1,81 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <misc/SDL2pp.h>
+
+#include <string>
+
+/**
+    The outcome of simulating a benchmark scenario in headless mode (see runBenchmark()).
+*/
+struct BenchmarkResult {
+    std::string scenario;           ///< the name of the scenario (see section [BENCHMARK] of the scenario file)
+    Uint32 gameCycles = 0;          ///< the number of simulated game cycles
+    Uint32 randomSeed = 0;          ///< the seed of the game's random generator at the end
+    std::string checksum;           ///< md5 of the saved final game state as hex string
+    Uint32 elapsedTime = 0;         ///< the time needed for the simulation in ms
+    Uint32 peakMemory = 0;          ///< the peak memory usage (resident set size) of the process in KiB
+
+    /**
+        Returns the simulation throughput.
+        \return the simulated game cycles per second
+    */
+    Uint32 getCyclesPerSecond() const;
+
+    /**
+        Formats this result as one line of csv output (see getCSVHeader()).
+        \return the csv line without line break
+    */
+    std::string toCSV() const;
+
+    /**
+        Returns the header line of the csv output.
+        \return the csv line without line break
+    */
+    static const char* getCSVHeader();
+};
+
+/**
+    Simulates a benchmark scenario in headless mode. A scenario is a custom map with an additional section [BENCHMARK]:
+    <pre>
+    [BENCHMARK]
+    Name=8 QuantBots
+    Seed=1
+    GameCycles=6000
+    Harkonnen=qBotMedium,qBotMedium
+    Atreides=qBotMedium,qBotMedium
+    </pre>
+    Every other key names a house and the classes of the AI players controlling it. Every house gets its own team.
+    The game is started with the given seed and default game options, so every run of the same scenario simulates
+    exactly the same game and must end with the same checksum.
+    \param  filename        the filename of the scenario
+    \param  maxGameCycle    overrides GameCycles of the scenario (0 = use GameCycles)
+    \return the outcome of the simulation
+*/
+BenchmarkResult runBenchmark(const std::string& filename, Uint32 maxGameCycle = 0);
+
+/**
+    Returns the peak memory usage of the process so far. As this never decreases, every scenario should be run by
+    a separate process to measure its own peak.
+    \return the peak resident set size in KiB (0 if unknown)
+*/
+Uint32 getPeakMemoryUsage();
+
+#endif // BENCHMARK_H
@@ -88,6 +88,7 @@ private:
     // drawing information
     zoomable_texture graphic{};          ///< The graphic of the bullet
     int              numFrames = 0;      ///< Number of frames of the bullet
+    int              drawBucket = -1;    ///< The cell of the bullet draw buckets of the map this bullet is in
 };
 
 #endif // BULLET_H
@@ -22,8 +22,12 @@
 #include <misc/OutputStream.h>
 
 #include <vector>
+#include <array>
+#include <memory>
 #include <misc/SDL2pp.h>
 
+#define COMMAND_INLINE_PARAMETERS   4       ///< number of parameters stored inside the command; longer parameter lists are stored on the heap
+
 typedef enum {
     CMD_NONE,
     CMD_PLACE_STRUCTURE,                ///< PLACE_STRUCTURE(BUILDER_ID, X, Y)
@@ -50,6 +54,9 @@ typedef enum {
     CMD_STARPORT_CANCELORDER,           ///< CMD_STARPORT_CANCELORDER(OBJECT_ID)
     CMD_TURRET_ATTACKOBJECT,            ///< TURRET_ATTACKOBJECT(OBJECT_ID,TARGET_OBJECT_ID)
     CMD_TEST_SYNC,                      ///< TEST_SYNC(SEED)
+    CMD_NETWORK_CYCLE_BUFFER,           ///< NETWORK_CYCLE_BUFFER(NUM_CYCLES)
+    CMD_TEST_STATEHASH,                 ///< TEST_STATEHASH(GAMECYCLE, UNITS, STRUCTURES, HOUSES, SPICE)
+    CMD_UNIT_MOVE2POS_GROUP,            ///< UNIT_MOVE2POS_GROUP(X,Y,BFORCED,OBJECT_ID...)
     CMD_MAX
 } CMDTYPE;
 
@@ -60,6 +67,23 @@ typedef enum {
 class Command {
 public:
 
+    /**
+        A read-only view of the parameters of a command. It is only valid as long as the command exists.
+    */
+    class Parameters {
+    public:
+        Parameters(const Uint32* pData, size_t size) : pData(pData), numParameters(size) { }
+
+        size_t size() const { return numParameters; }
+        const Uint32* begin() const { return pData; }
+        const Uint32* end() const { return pData + numParameters; }
+        Uint32 operator[](size_t index) const { return pData[index]; }
+
+    private:
+        const Uint32* pData;        ///< the first parameter
+        size_t numParameters;       ///< the number of parameters
+    };
+
     /**
         Construct a command with CMDTYPE id and no parameter.
         \param  id  the id of the command
@@ -100,6 +124,13 @@ public:
     */
     Command(Uint8 playerID, CMDTYPE id, Uint32 parameter1, Uint32 parameter2, Uint32 parameter3, Uint32 parameter4);
 
+    /**
+        Construct a command with CMDTYPE id and any number of parameters.
+        \param  id          the id of the command
+        \param  parameters  the parameters
+    */
+    Command(Uint8 playerID, CMDTYPE id, const std::vector<Uint32>& parameters);
+
     /**
         Construct a command from raw memory.
         \param  data        pointer to the data
@@ -113,6 +144,13 @@ public:
     */
     explicit Command(InputStream& stream);
 
+    /**
+        Read a command written by saveCompact() from stream.
+        \param  stream          the stream to read from
+        \param  pPrevCommand    the command read before this one (or nullptr if this is the first one)
+    */
+    Command(InputStream& stream, const Command* pPrevCommand);
+
     /// destructor
     virtual ~Command();
 
@@ -122,6 +160,15 @@ public:
     */
     void save(OutputStream& stream) const;
 
+    /**
+        Writes the command to a stream in the compact network format. The player id and
+        all parameters are delta coded against the previous command as the same units
+        are often ordered several times in a row.
+        \param  stream          the stream to write to
+        \param  pPrevCommand    the command written before this one (or nullptr if this is the first one)
+    */
+    void saveCompact(OutputStream& stream, const Command* pPrevCommand) const;
+
     /**
         Gets the ID of the player that added this command.
         \return the ID of the player
@@ -138,7 +185,9 @@ public:
         Gets the parameters of this command.
         \return the parameters of this command
     */
-    const std::vector<Uint32> getParameter() const { return parameter; };
+    Parameters getParameter() const {
+        return Parameters((pLongParameters != nullptr) ? pLongParameters->data() : inlineParameters.data(), numParameters);
+    };
 
 
     /**
@@ -147,9 +196,18 @@ public:
     void executeCommand() const;
 
 private:
+    /**
+        Sets the parameters of this command.
+        \param  pParameters     the parameters
+        \param  count           the number of parameters
+    */
+    void setParameters(const Uint32* pParameters, size_t count);
+
     Uint8   playerID;                   ///< the ID of the player that gave the command
     CMDTYPE commandID;                  ///< the type of command
-    std::vector<Uint32> parameter;      ///< the parameters for this command
+    Uint32  numParameters = 0;          ///< the number of parameters for this command
+    std::array<Uint32, COMMAND_INLINE_PARAMETERS> inlineParameters;     ///< the parameters if there are at most COMMAND_INLINE_PARAMETERS
+    std::shared_ptr<const std::vector<Uint32>> pLongParameters;         ///< the parameters if there are more (immutable, so copies of the command share them)
 };
 
 #endif // COMMAND_H
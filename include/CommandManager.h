@@ -19,14 +19,25 @@
 #define COMMANDMANAGER_H
 
 #include <Command.h>
+#include <CommandTimeline.h>
 
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
 
 #include <Network/CommandList.h>
 
+#include <Definitions.h>
+
+#include <functional>
+#include <map>
 #include <vector>
 
+#define NETWORKCYCLEBUFFER_MIN              3                       ///< the minimum number of game cycles commands are given in advance
+#define NETWORKCYCLEBUFFER_MAX              MILLI2CYCLES(2000)      ///< the maximum number of game cycles commands are given in advance
+#define NETWORKCYCLEBUFFER_MARGIN           2                       ///< additional game cycles on top of the measured latency
+#define NETWORKCYCLEBUFFER_UPDATE_INTERVAL  MILLI2CYCLES(4000)      ///< every player requests a new network cycle buffer after this many game cycles
+#define NETWORKCYCLEBUFFER_REQUEST_LIFETIME (3*NETWORKCYCLEBUFFER_UPDATE_INTERVAL)   ///< requests of players that did not renew them within this many game cycles are ignored
+
 /**
     The command manager collects all the given user commands (e.g. move unit u to position (x,y)) . These commands might be transfered over a network.
 */
@@ -54,6 +65,13 @@ public:
     */
     OutputStream* getStream() const { return pStream.get(); }
 
+    /**
+        Sets the function that should be called for every added command, just like it is written to the stream set by
+        setStream(). This is used for broadcasting the game to spectators.
+        \param  pOnAddCommand   function to call with the game cycle and the added command
+    */
+    void setOnAddCommand(std::function<void (Uint32, const Command&)> pOnAddCommand) { this->pOnAddCommand = pOnAddCommand; }
+
     /**
         If bReadOnly == true it is impossible to add new commands to this command manager. This is useful for replays.
         \param  bReadOnly   true = addCommand() is a NO-OP, false = addCommand() has normal behaviour
@@ -84,6 +102,28 @@ public:
 
     void setNetworkCycleBuffer(Uint32 newNetworkCycleBuffer) { networkCycleBuffer = newNetworkCycleBuffer; };
 
+    /**
+        Calculates the number of game cycles commands have to be given in advance to arrive at all peers in time.
+        This is based on the round trip time and jitter to the peer with the worst connection.
+        \return the network cycle buffer the local player needs
+    */
+    Uint32 getMeasuredNetworkCycleBuffer() const;
+
+    /**
+        Adds a CMD_NETWORK_CYCLE_BUFFER command requesting the network cycle buffer currently measured for the local player.
+        This should be called every NETWORKCYCLEBUFFER_UPDATE_INTERVAL game cycles. Nothing is requested while a peer
+        does not know this command (see NetworkManager::getMinPeerProtocolVersion()).
+    */
+    void requestNetworkCycleBuffer();
+
+    /**
+        Executes a CMD_NETWORK_CYCLE_BUFFER command. As every peer executes this command in the same game cycle,
+        all peers switch to the same cycle buffer at the same time: the maximum of the recent requests of all players.
+        \param  playerID                the player that requested the network cycle buffer
+        \param  requestedCycleBuffer    the network cycle buffer the player needs
+    */
+    void onRequestNetworkCycleBuffer(Uint8 playerID, Uint32 requestedCycleBuffer);
+
     /**
         Updates the command manager and sends commands to other peers
     */
@@ -96,6 +136,36 @@ public:
     */
     void addCommandList(const std::string& playername, const CommandList& commandList);
 
+    /**
+        Returns all commands of all players scheduled for the game cycles from startCycle to endCycle-1.
+        This is used for catching up a rejoining player.
+        \param  startCycle  the first game cycle
+        \param  endCycle    the game cycle after the last one
+        \return the command list with one entry for every game cycle with commands
+    */
+    CommandList getCommandList(Uint32 startCycle, Uint32 endCycle) const;
+
+    /**
+        After loading the snapshot for rejoining a running game all received command lists are ignored until the catch up
+        commands are added with addCatchUpCommands(). The other players resend their recent commands with every command list anyway.
+    */
+    void waitForCatchUpCommands() { bWaitingForCatchUpCommands = true; }
+
+    /**
+        Are we waiting for the catch up commands (see waitForCatchUpCommands())?
+        \return true if waiting, false otherwise
+    */
+    bool isWaitingForCatchUpCommands() const { return bWaitingForCatchUpCommands; }
+
+    /**
+        Adds the commands given since the snapshot of the running game was taken. They replace all commands scheduled
+        from the current game cycle on. The commands from catchUpCycle on are received with the command lists of the other
+        players and local commands are not scheduled before catchUpCycle as the other players have already simulated these game cycles.
+        \param  catchUpCycle    the game cycle of the game host when it sent the catch up commands
+        \param  commandList     all commands from the snapshot to catchUpCycle
+    */
+    void addCatchUpCommands(Uint32 catchUpCycle, const CommandList& commandList);
+
     /**
         Adds a command at the next possible game cycle
         \param  cmd     the command to add
@@ -115,11 +185,46 @@ public:
     */
     void executeCommands(Uint32 CycleNumber) const;
 
+    /**
+        Returns the number of game cycles commands are scheduled for.
+        \return one more than the last game cycle with a scheduled command (0 if there are no commands)
+    */
+    Uint32 getNumScheduledCycles() const { return timeline.getNumCycles(); }
+
+    /**
+        Returns all scheduled commands, e.g. for walking over the game cycles with commands.
+        \return the timeline of all commands
+    */
+    const CommandTimeline& getTimeline() const { return timeline; }
+
 private:
-    std::vector< std::vector<Command> > timeslot;   ///< a vector of vectors containing the scheduled commands. At index x is a list of all commands scheduled for game cycle x.
+    /**
+        Adds commands at the game cycle CycleNumber, just like calling addCommand() for each of them
+        \param  commands    the commands to add
+        \param  CycleNumber the game cycle these commands shall take effect
+    */
+    void addCommands(const std::vector<Command>& commands, Uint32 CycleNumber);
+
+    /**
+        Writes an added command to the stream and passes it to the function set by setOnAddCommand()
+        \param  cmd         the added command
+        \param  CycleNumber the game cycle the command takes effect
+    */
+    void recordCommand(const Command& cmd, Uint32 CycleNumber);
+
+    CommandTimeline timeline;                       ///< all scheduled commands ordered by game cycle
     std::unique_ptr<OutputStream> pStream;          ///< a stream all added commands will be written to. May be nullptr
+    std::function<void (Uint32, const Command&)> pOnAddCommand; ///< called for all added commands (see setOnAddCommand())
     bool bReadOnly;                                 ///< true = addCommand() is a NO-OP, false = addCommand() has normal behaviour
     Uint32 networkCycleBuffer;                      ///< the number of frames a command is given in advance
+    Uint32 nextUnsentCycle = 0;                     ///< the command lists before this game cycle are already sent to the other peers and must not change anymore
+    bool bWaitingForCatchUpCommands = false;        ///< see waitForCatchUpCommands()
+
+    struct NetworkCycleBufferRequest {
+        Uint32 cycleBuffer;                         ///< the requested network cycle buffer
+        Uint32 gameCycle;                           ///< the game cycle the request was executed
+    };
+    std::map<Uint8, NetworkCycleBufferRequest> networkCycleBufferRequests;  ///< the last request of every player (see onRequestNetworkCycleBuffer())
 };
 
 #endif // COMMANDMANAGER_H
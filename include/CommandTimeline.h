@@ -0,0 +1,114 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMMANDTIMELINE_H
+#define COMMANDTIMELINE_H
+
+#include <Command.h>
+
+#include <vector>
+
+/**
+    All scheduled commands of a game, ordered by game cycle. The commands are stored in one contiguous buffer (sorted by
+    the game cycle and for each game cycle by the player id) and every game cycle only stores the offset of its first
+    command into this buffer. Commands are usually added for the last game cycles (e.g. when recording or replaying a game),
+    which only appends to the buffer. The game cycles with commands can be walked with getNextCycleWithCommands() without
+    looking at the empty game cycles in between.
+*/
+class CommandTimeline {
+public:
+    /**
+        The commands of a range of game cycles. Can be used in a range based for loop.
+    */
+    class Range {
+    public:
+        Range(const Command* pFirst, const Command* pLast) : pFirst(pFirst), pLast(pLast) { }
+
+        const Command* begin() const { return pFirst; }
+        const Command* end() const { return pLast; }
+        bool empty() const { return (pFirst == pLast); }
+        size_t size() const { return pLast - pFirst; }
+
+    private:
+        const Command* pFirst;  ///< the first command
+        const Command* pLast;   ///< the command after the last command
+    };
+
+    CommandTimeline() = default;
+
+    /**
+        Returns the number of game cycles in this timeline.
+        \return one more than the last game cycle commands were added for (0 if the timeline is empty)
+    */
+    Uint32 getNumCycles() const { return cycleStart.empty() ? 0 : (Uint32) (cycleStart.size() - 1); }
+
+    /**
+        Returns the number of commands in this timeline.
+        \return the number of commands of all game cycles
+    */
+    size_t getNumCommands() const { return commands.size(); }
+
+    /**
+        Adds a command for a game cycle. It is executed after all commands of players with a lower or equal player id.
+        \param  cycle   the game cycle
+        \param  command the command to add
+    */
+    void insert(Uint32 cycle, const Command& command);
+
+    /**
+        Adds commands for a game cycle, just like calling insert() for each command but cheaper.
+        \param  cycle       the game cycle
+        \param  newCommands the commands to add
+    */
+    void insert(Uint32 cycle, const std::vector<Command>& newCommands);
+
+    /**
+        Removes all commands from game cycle numCycles on.
+        \param  numCycles   the number of game cycles to keep
+    */
+    void truncate(Uint32 numCycles);
+
+    /**
+        Returns the commands of one game cycle.
+        \param  cycle   the game cycle
+        \return the commands of this cycle (empty if there are none)
+    */
+    Range getCommands(Uint32 cycle) const;
+
+    /**
+        Returns the next game cycle with at least one command.
+        \param  cycle   the first game cycle to consider
+        \return the first game cycle >= cycle with commands or getNumCycles() if there is no such game cycle
+    */
+    Uint32 getNextCycleWithCommands(Uint32 cycle) const;
+
+private:
+    /**
+        Adds empty game cycles until there are at least numCycles game cycles.
+    */
+    void extendTo(Uint32 numCycles);
+
+    /**
+        Adds num to the offsets of all game cycles after cycle.
+    */
+    void shiftCyclesAfter(Uint32 cycle, Uint32 num);
+
+    std::vector<Command> commands;      ///< all commands sorted by game cycle and for each game cycle by player id
+    std::vector<Uint32> cycleStart;     ///< cycleStart[c] is the index of the first command of game cycle c; has one extra entry for the end of the last cycle
+};
+
+#endif // COMMANDTIMELINE_H
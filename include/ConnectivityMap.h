@@ -0,0 +1,94 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONNECTIVITYMAP_H
+#define CONNECTIVITYMAP_H
+
+#include <DataTypes.h>
+
+#include <vector>
+
+class Map;
+
+/**
+    Labels the connected regions of the map. Two tiles have the same label if a unit can move from one to the other
+    without crossing a static obstacle (mountains and structures). This allows rejecting path requests to a destination
+    that cannot be reached at all (e.g. an enclosed plateau) before AStarSearch expands thousands of nodes to find out.
+
+    The labels are calculated for the whole map on the first request. Placing or destroying a structure only
+    relabels the regions touching the changed area.
+*/
+class ConnectivityMap {
+public:
+    explicit ConnectivityMap(const Map* pMap);
+
+    ConnectivityMap(const ConnectivityMap &) = delete;
+    ConnectivityMap(ConnectivityMap &&) = delete;
+    ConnectivityMap& operator=(const ConnectivityMap &) = delete;
+    ConnectivityMap& operator=(ConnectivityMap &&) = delete;
+
+    /**
+        Discards all labels. They are recalculated on the next request. Must be called whenever the map size changes.
+    */
+    void reset();
+
+    /**
+        Updates the labels after a static obstacle was placed or removed in the specified area.
+        \param  x       the x coordinate of the top left tile of the area
+        \param  y       the y coordinate of the top left tile of the area
+        \param  width   the width of the area
+        \param  height  the height of the area
+    */
+    void updateArea(int x, int y, int width, int height);
+
+    /**
+        Checks if destination can be reached from start. A blocked destination (e.g. a structure to attack) is
+        considered reachable if one of its neighbours can be reached.
+        \param  bInfantry   true for infantry (can climb mountains), false for vehicles
+        \param  start       the start tile
+        \param  destination the destination tile
+        \return false if destination is definitely not reachable, true otherwise
+    */
+    bool isReachable(bool bInfantry, const Coord& start, const Coord& destination);
+
+    /**
+        Returns the tile closest to destination that can be reached from start.
+        \param  bInfantry   true for infantry (can climb mountains), false for vehicles
+        \param  start       the start tile
+        \param  destination the destination tile
+        \param  closest     the closest reachable tile is returned here
+        \return true if a tile was found, false if start is blocked itself
+    */
+    bool findClosestReachable(bool bInfantry, const Coord& start, const Coord& destination, Coord& closest);
+
+private:
+    struct Layer {
+        std::vector<Uint32> labels;     ///< label of every tile (NONE_ID if blocked)
+        Uint32 nextLabel = 0;           ///< the label the next labelled region gets
+        bool bDirty = true;             ///< have all labels to be recalculated?
+    };
+
+    bool isPassable(int layerIndex, int x, int y) const;
+    Layer& getLayer(bool bInfantry);
+    void floodFill(int layerIndex, const Coord& start, Uint32 label);
+
+    const Map* pMap;                    ///< the map this connectivity belongs to
+    Layer layers[2];                    ///< one layer for vehicles and one for infantry
+    std::vector<Coord> openTiles;       ///< scratch memory for floodFill()
+};
+
+#endif // CONNECTIVITYMAP_H
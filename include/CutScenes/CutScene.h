@@ -19,12 +19,16 @@
 #define CUTSCENE_H
 
 #include <CutScenes/Scene.h>
+#include <CutScenes/CutScenePrefetcher.h>
 #include <FileClasses/Palette.h>
 #include <FileClasses/Wsafile.h>
 #include <misc/SDL2pp.h>
 
 #include <queue>
 
+/// if drawing falls behind the schedule by more than this many milliseconds (e.g. because a sound was not loaded yet) the schedule is restarted instead of catching up
+#define CUTSCENE_MAX_LAG    100
+
 /// A base class for running Dune 2 Cutscenes.
 /**
     This class runs a Dune 2 Cutscene. The cutscene is composed of video elements with aditional audio and text elements. The video
@@ -89,6 +93,8 @@ protected:
     static std::unique_ptr<Wsafile> create_wsafile(const char* name1, const char* name2);
     static std::unique_ptr<Wsafile> create_wsafile(const char* name1, const char* name2, const char* name3);
 
+    CutScenePrefetcher prefetcher;              ///< Loads the sounds of the scenes in the background (see CutSceneSoundTrigger)
+
 private:
     std::queue<std::unique_ptr<Scene>> scenes;  ///< List of all scenes
     bool quiting;                               ///< Quit the cutscene?
@@ -0,0 +1,84 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CUTSCENEPREFETCHER_H
+#define CUTSCENEPREFETCHER_H
+
+#include <misc/SDL2pp.h>
+
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// Loads the sounds of a cutscene in the background while the first scenes are already playing.
+/**
+    The sounds are loaded on a background thread in the order they are added, which should be the order the scenes
+    use them. The scenes refer to a sound by the index returned from addSound() (see CutSceneSoundTrigger) and only
+    wait if it is played before it is loaded.
+*/
+class CutScenePrefetcher final {
+public:
+    CutScenePrefetcher();
+
+    CutScenePrefetcher(const CutScenePrefetcher &) = delete;
+    CutScenePrefetcher(CutScenePrefetcher &&) = delete;
+    CutScenePrefetcher& operator=(const CutScenePrefetcher &) = delete;
+    CutScenePrefetcher& operator=(CutScenePrefetcher &&) = delete;
+
+    /// Destructor. Stops the loader thread; sounds not loaded yet are skipped.
+    ~CutScenePrefetcher();
+
+    /**
+        Queues a voc file for loading (see getChunkFromFile()).
+        \param  filename    the file to load
+        \return the index of the sound for getSound()
+    */
+    int addSound(const std::string& filename);
+
+    /**
+        Queues a sound that is created by a function, e.g. by concatenating other sounds. The function is called on
+        the loader thread.
+        \param  loader  the function creating the sound
+        \return the index of the sound for getSound()
+    */
+    int addSound(std::function<sdl2::mix_chunk_ptr ()> loader);
+
+    /**
+        Returns a sound. Waits if the loader thread has not loaded it yet. An exception thrown while loading is
+        rethrown here.
+        \param  index   the index returned by addSound()
+        \return the sound
+    */
+    Mix_Chunk* getSound(int index);
+
+private:
+    static int loaderThreadMain(void* data);
+    void loadSounds();
+
+    SDL_mutex* mutex = nullptr;                     ///< guards all members below
+    SDL_cond* soundAddedCond = nullptr;             ///< signaled when a sound was added or bStop is set
+    SDL_cond* soundLoadedCond = nullptr;            ///< signaled when numLoaded increased or loading failed
+    std::vector<std::function<sdl2::mix_chunk_ptr ()>> loaders;     ///< the functions creating the sounds
+    std::vector<sdl2::mix_chunk_ptr> sounds;        ///< the loaded sounds (the first numLoaded entries are valid)
+    int numLoaded = 0;                              ///< the number of sounds the loader thread has loaded
+    bool bStop = false;                             ///< tells the loader thread to exit
+    std::exception_ptr pException;                  ///< the exception thrown by the loader thread
+    SDL_Thread* pThread = nullptr;                  ///< the loader thread (nullptr if sounds are loaded in getSound())
+};
+
+#endif // CUTSCENEPREFETCHER_H
@@ -21,6 +21,7 @@
 #include <SDL2/SDL_mixer.h>
 
 #include <SoundPlayer.h>
+#include <CutScenes/CutScenePrefetcher.h>
 
 
 /**
@@ -38,6 +39,16 @@ public:
         this->sound = sound;
     }
 
+    /**
+        Constructor
+        \param  frameNumber     the frame number relative to the scene start where the sound shall be played
+        \param  prefetcher      the prefetcher loading the sound
+        \param  soundIndex      the index of the sound in prefetcher (see CutScenePrefetcher::addSound())
+    */
+    CutSceneSoundTrigger(int frameNumber, CutScenePrefetcher& prefetcher, int soundIndex)
+     : CutSceneTrigger(frameNumber), sound(nullptr), pPrefetcher(&prefetcher), soundIndex(soundIndex) {
+    }
+
     /// destructor
     ~CutSceneSoundTrigger() = default;
 
@@ -47,11 +58,13 @@ public:
     */
     void trigger(int currentFrameNumber) override
     {
-        soundPlayer->playSound(sound);
+        soundPlayer->playSound((pPrefetcher != nullptr) ? pPrefetcher->getSound(soundIndex) : sound);
     }
 
 private:
-    Mix_Chunk* sound;   ///< the sound to play
+    Mix_Chunk* sound;                           ///< the sound to play
+    CutScenePrefetcher* pPrefetcher = nullptr;  ///< the prefetcher loading the sound (nullptr if sound is already loaded)
+    int soundIndex = -1;                        ///< the index of the sound in pPrefetcher
 };
 
 #endif // CUTSCENESOUNDTRIGGER_H
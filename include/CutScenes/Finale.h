@@ -70,11 +70,12 @@ private:
     std::unique_ptr<Wsafile> pImperator;            ///< video sequence showing the imperator taking
     std::unique_ptr<Wsafile> pImperatorShocked;     ///< video sequence showing the imperator shocked
 
-    sdl2::mix_chunk_ptr  lizard;     ///< SFX: the lizard barking
-    sdl2::mix_chunk_ptr  glass;      ///< SFX: glass bursting
-    sdl2::mix_chunk_ptr  click;      ///< SFX: loading the gun
-    sdl2::mix_chunk_ptr  blaster;    ///< SFX: shooting the gun
-    sdl2::mix_chunk_ptr  blowup;     ///< SFX: explosion
+    // the sound effects are indices in prefetcher
+    int lizard = -1;    ///< SFX: the lizard barking
+    int glass = -1;     ///< SFX: glass bursting
+    int click = -1;     ///< SFX: loading the gun
+    int blaster = -1;   ///< SFX: shooting the gun
+    int blowup = -1;    ///< SFX: explosion
 };
 
 #endif // FINALE_H
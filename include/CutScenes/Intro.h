@@ -131,7 +131,7 @@ private:
 
     static const char* VoiceFileNames[Voice_NUM_ENTRIES];   ///< List of all the voice files
 
-    sdl2::mix_chunk_ptr  voice[Voice_NUM_ENTRIES];          ///< All the loaded voices
+    int voice[Voice_NUM_ENTRIES];                           ///< All the voices (indices in prefetcher, -1 if not english)
 
     std::unique_ptr<Wsafile> pDuneText;         ///< 1. video sequence showing the dune text
     std::unique_ptr<Wsafile> pPlanet;           ///< 2. video sequence showing the planet
@@ -145,15 +145,16 @@ private:
     std::unique_ptr<Wsafile> pHarkonnen;        ///< 10. video sequence showing two harkonnen troopers under attack
     std::unique_ptr<Wsafile> pDestroyedTank;    ///< 11. video sequence showing destroyed tanks
 
-    sdl2::mix_chunk_ptr  wind;               ///< SFX: wind blowing
-    sdl2::mix_chunk_ptr  carryallLanding;    ///< SFX: carryall loading a harvester
-    sdl2::mix_chunk_ptr  harvester;          ///< SFX: harvester stopping
-    sdl2::mix_chunk_ptr  gunshot;            ///< SFX: a gunshot
-    sdl2::mix_chunk_ptr  glass;              ///< SFX: broken glass, destroyed by atreides ornithopters
-    sdl2::mix_chunk_ptr  missle;             ///< SFX: missle launched
-    sdl2::mix_chunk_ptr  blaster;            ///< SFX: trooper hit
-    sdl2::mix_chunk_ptr  blowup1;            ///< SFX: explosion
-    sdl2::mix_chunk_ptr  blowup2;            ///< SFX: explosion
+    // the sound effects are indices in prefetcher
+    int wind;                                ///< SFX: wind blowing
+    int carryallLanding;                     ///< SFX: carryall loading a harvester
+    int harvester;                           ///< SFX: harvester stopping
+    int gunshot;                             ///< SFX: a gunshot
+    int glass;                               ///< SFX: broken glass, destroyed by atreides ornithopters
+    int missle;                              ///< SFX: missle launched
+    int blaster;                             ///< SFX: trooper hit
+    int blowup1;                             ///< SFX: explosion
+    int blowup2;                             ///< SFX: explosion
 };
 
 #endif // INTRO_H
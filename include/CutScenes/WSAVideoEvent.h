@@ -20,6 +20,9 @@
 
 #include <CutScenes/VideoEvent.h>
 #include <FileClasses/Wsafile.h>
+#include <FileClasses/WsaStream.h>
+
+#include <memory>
 
 /**
     This VideoEvent is used for playing a wsa video.
@@ -51,6 +54,7 @@ public:
 private:
     int currentFrame;               ///< the current frame number relative to the start of this WSAVideoEvent
     Wsafile* pWsafile;              ///< the video to play
+    std::unique_ptr<WsaStream> pWsaStream;  ///< decodes the frames ahead of playback; only exists while playing
     sdl2::texture_ptr pStreamingTexture; ///< the texture used for rendering from
     bool bCenterVertical;           ///< true = center the video vertically on the screen, false = blit the video frames at the top of the screen
 };
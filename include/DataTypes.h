@@ -165,6 +165,9 @@ public:
         std::string     language;           ///< Language code: "en" = English, "fr" = French, "de" = German
         int             scrollSpeed;        ///< Scroll speed in pixels
         bool            showTutorialHints;  ///< If true, tutorial hints are shown during the game
+        int             autosaveInterval;   ///< Minutes between two autosaves (0 = no autosaves)
+        int             autosaveSlots;      ///< The number of autosaves that are kept
+        bool            pauseWhenInactive;  ///< Hold single player games while the window has no input focus?
     } general;
 
     class VideoClass {
@@ -175,9 +178,13 @@ public:
         int         width;
         int         height;
         bool        frameLimit;
+        bool        vsync;                  ///< wait for the vertical retrace when presenting a frame
         int         preferredZoomLevel;
         std::string scaler;
         bool        rotateUnitGraphics;
+        bool        gpuZoomScaling;         ///< scale zoomed object pictures on the GPU instead of keeping scaled surfaces
+        std::string screenshotFormat;       ///< "png" or "qoi"
+        int         screenshotCompression;  ///< PNG compression level of screenshots (0 = uncompressed to 9)
     } video;
 
     class AudioClass {
@@ -187,6 +194,7 @@ public:
         bool        playMusic;
         int         musicVolume;
         std::string musicType;
+        bool        cacheMusic;
     } audio;
 
     class NetworkClass {
@@ -194,6 +202,9 @@ public:
         int         serverPort;
         std::string metaServer;
         bool        debugNetwork;
+        int         broadcastPort;      ///< the port multiplayer games are broadcast to spectators on (0 = no broadcast)
+        int         broadcastDelay;     ///< the number of seconds the broadcast is delayed
+        int         metricsPort;        ///< the port the metrics of running games are served on (0 = no metrics, see MetricsServer)
     } network;
 
     class AIClass {
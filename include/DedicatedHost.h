@@ -0,0 +1,43 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DEDICATEDHOST_H
+#define DEDICATEDHOST_H
+
+#include <string>
+
+#define DEDICATEDHOST_WAIT_TIMEOUT      50      ///< the dedicated host waits at most this many ms for network events before checking the lobby again
+#define DEDICATEDHOST_STARTGAME_DELAY   5000    ///< the countdown in ms announced to the players before the game starts
+
+/**
+    Hosts multiplayer games on a custom map without playing them and without window, input and sound. The lobby
+    is announced to the metaserver (or in the LAN) and run like CustomGamePlayers does for a hosting player: every
+    player gets a free slot when connecting and may change its house and team. The game is started as soon as no
+    open slot is left. The players send their command lists to each other as usual, so the host never holds
+    back the game; it is only one more peer that receives all command lists. They are recorded and saved as a
+    replay to the replay directory when the last player left. Afterwards the next lobby is opened.
+    Several lobbies are hosted by starting one process per lobby with different server ports.
+    \param  mapFilename the custom map to host
+    \param  bLANServer  announce the lobby in the LAN instead of to the metaserver
+    \param  bValidate   simulate the replay of every game in headless mode and check it for desyncs
+    \param  numGames    stop after this many games (0 = run until the process is terminated)
+    \return true if all games were played (and were in sync if validated), false otherwise
+*/
+bool runDedicatedHost(const std::string& mapFilename, bool bLANServer, bool bValidate, int numGames = 0);
+
+#endif // DEDICATEDHOST_H
@@ -28,9 +28,11 @@
 
 #define DEFAULT_PORT        28747
 #define DEFAULT_METASERVER  "http://dunelegacy.sourceforge.net/metaserver/metaserver.php"
+#define DEFAULT_BROADCASTPORT   28748
+#define DEFAULT_BROADCASTDELAY  120
 
 #define SAVEMAGIC           8675309
-#define SAVEGAMEVERSION     9704
+#define SAVEGAMEVERSION     9716
 
 #define MAX_PLAYERNAMELENGHT    24
 
@@ -56,6 +58,12 @@
 
 #define BUILDRANGE 2
 #define MIN_CARRYALL_LIFT_DISTANCE 6
+#define UNIT_MAXBLOCKEDWAIT 4           // a unit waits this many navigation steps (every 5th cycle) for a moving friendly unit to clear its next spot before searching a new path
+#define PATHREPAIR_RADIUS 3             // a blocked unit looks for a detour around its next spot within this many tiles of its location
+#define PATHREPAIR_LOOKAHEAD 6          // the detour has to rejoin the path within this many spots after the blocked one
+#define REFINERY_QUEUEDISTANCE 3        // returning harvesters this close to a busy refinery stop and wait until they may drive in
+#define TARGETSCAN_STAGGER 32           // the target scan timers of units and turrets get an extra delay of 0 to TARGETSCAN_STAGGER-1 cycles (depending on the object id)
+#define TARGETSCAN_SIGHTING_RANGE 10    // units and turrets up to this many tiles away scan for targets as soon as an enemy comes into sight
 #define STRUCTURE_ANIMATIONTIMER 31
 
 #define RANDOMSPICEMIN (111 - 37)        //how much spice on each spice tile
@@ -0,0 +1,90 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DETERMINISMCHECK_H
+#define DETERMINISMCHECK_H
+
+#include <StateHashes.h>
+
+#include <misc/SDL2pp.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#define DETERMINISMCHECK_DEFAULT_INTERVAL   MILLI2CYCLES(2000)      ///< the default distance between two compared game cycles
+
+typedef std::vector<std::pair<Uint32, StateHashes>> StateHashTrace;    ///< the state hashes of a game indexed by game cycle (see Game::setStateHashTrace())
+
+/**
+    Simulates a replay in headless mode and records its state hashes every interval game cycles to a csv file.
+    Recording the same replay with two builds (e.g. before and after changing a container or vectorizing a loop) and
+    comparing the files with compareStateHashTraces() shows whether and where the simulation diverges.
+    If lastGameCycle is given, the simulation stops there and the complete hashed state of this game cycle is
+    written to traceFilename + ".snapshot" (see writeStateSnapshot()), so the snapshots of both builds can be diffed.
+    \param  replayFilename      the replay to simulate
+    \param  traceFilename       the csv file to write
+    \param  interval            the distance between two recorded game cycles
+    \param  firstGameCycle      the first game cycle to record
+    \param  lastGameCycle       the last game cycle to record (INVALID_GAMECYCLE = until the replay ends)
+    \param  numWorkerThreads    the number of worker threads to simulate with (-1 = WorkerPool::getDefaultNumThreads())
+    \return true if the replay could be simulated and the file written, false otherwise
+*/
+bool recordStateHashTrace(const std::string& replayFilename, const std::string& traceFilename, Uint32 interval,
+                          Uint32 firstGameCycle = 0, Uint32 lastGameCycle = INVALID_GAMECYCLE, int numWorkerThreads = -1);
+
+/**
+    Compares two files written by recordStateHashTrace() and prints the first game cycle and the subsystems that
+    differ to stdout. If the traces were recorded every N > 1 game cycles, the window containing the first divergence
+    is printed so that both builds can record it again with an interval of 1.
+    \param  traceFilenameA  the first csv file
+    \param  traceFilenameB  the second csv file
+    \return true if both traces are identical, false otherwise
+*/
+bool compareStateHashTraces(const std::string& traceFilenameA, const std::string& traceFilenameB);
+
+/**
+    Simulates a replay twice in this process with a different number of worker threads (by default serial and parallel)
+    and compares the state hashes every interval game cycles. On a mismatch the window between the last matching
+    and the first mismatching game cycle is simulated again and compared at every game cycle. The first diverging game
+    cycle and subsystems are printed to stdout and the hashed state of both runs at this game cycle is written to
+    replayFilename + ".<cycle>.a.txt" and ".b.txt" for diffing.
+    \param  replayFilename      the replay to simulate
+    \param  interval            the distance between two compared game cycles
+    \param  numWorkerThreadsA   the number of worker threads of the first run (0 = serial)
+    \param  numWorkerThreadsB   the number of worker threads of the second run (-1 = WorkerPool::getDefaultNumThreads())
+    \return true if both runs are identical, false if they diverge or the replay cannot be simulated
+*/
+bool checkDeterminism(const std::string& replayFilename, Uint32 interval = DETERMINISMCHECK_DEFAULT_INTERVAL,
+                      int numWorkerThreadsA = 0, int numWorkerThreadsB = -1);
+
+/**
+    Simulates a replay once while recording its keyframes (see ReplayKeyframes) and then continues it from every keyframe
+    until it ends. Every keyframe is a save game, so the state hashes every interval game cycles after it have to be the
+    same as the ones of the uninterrupted run unless some simulation state is not saved or restored differently. This is
+    also what a rejoining player does after loading the snapshot of the game host. The first keyframe after which the
+    runs diverge, the first diverging game cycle and the subsystems are printed to stdout and the hashed state of both runs
+    at this game cycle is written to replayFilename + ".<cycle>.a.txt" and ".b.txt" for diffing.
+    \param  replayFilename      the replay to simulate
+    \param  interval            the distance between two compared game cycles
+    \param  numWorkerThreads    the number of worker threads to simulate with (-1 = WorkerPool::getDefaultNumThreads())
+    \return true if all continued runs are identical to the uninterrupted one, false otherwise
+*/
+bool checkSaveGameDeterminism(const std::string& replayFilename, Uint32 interval = DETERMINISMCHECK_DEFAULT_INTERVAL, int numWorkerThreads = 0);
+
+#endif // DETERMINISMCHECK_H
@@ -37,16 +37,25 @@ public:
 
     void blitToScreen() const;
 
+    /**
+        Removes the explosion once its animation has finished. The current frame itself is only calculated when drawing.
+    */
     void update();
 
 private:
+    /**
+        Gets the number of game cycles since the explosion was created.
+        \return the age in game cycles
+    */
+    Uint32 getAge() const;
+
     Uint32 explosionID;
     Coord position;
     int house;
     zoomable_texture graphic{};
     int numFrames = 0;
-    int currentFrame;
-    int frameTimer;
+    Uint32 startGameCycle;          ///< the game cycle the explosion was created in
+    int drawBucket = -1;            ///< the cell of the explosion draw buckets of the map this explosion is in
 };
 
 
@@ -18,6 +18,8 @@
 #ifndef DECODE_H
 #define DECODE_H
 
+#include <cstddef>
+
 /// A variant of memcpy that can handle overlapping memory areas.
 /**
     Copies memory areas that may overlap byte by byte from small memory
@@ -31,22 +33,29 @@ inline void memcpy_overlap(unsigned char *dst, const unsigned char *src, unsigne
 
 
 /// Decompresses format40 compressed images/data.
-/** Decompresses format40 compressed images/data specified by image_in to image_out.
-    \param  image_in    format80 compressed data
+/** Decompresses format40 compressed images/data specified by image_in to image_out. Format40 data is XORed onto the
+    existing content of image_out.
+    \param  image_in    format40 compressed data
+    \param  inSize      size of image_in in bytes
     \param  image_out   pointer to output uncompressed data
+    \param  outSize     size of image_out in bytes
     \return written bytes to image_out
+    \throw  std::invalid_argument if the data reads beyond image_in or writes beyond image_out
  */
-int decode40(const unsigned char *image_in, unsigned char *image_out);
+int decode40(const unsigned char *image_in, size_t inSize, unsigned char *image_out, size_t outSize);
 
 
 /// Decompresses format80 compressed images/data.
 /** Decompresses format80 compressed images/data specified by image_in to image_out. The checksum is also calculated and
     compared with the parameter checksum.
     \param  image_in    format80 compressed data
+    \param  inSize      size of image_in in bytes
     \param  image_out   pointer to output uncompressed data
+    \param  outSize     size of image_out in bytes
     \param  checksum    checksum for this file
     \return 0 if checksum is correct<br> -1 if checksum is incorrect
+    \throw  std::invalid_argument if the data reads beyond image_in or references or writes data outside image_out
  */
-int decode80(const unsigned char *image_in, unsigned char *image_out,unsigned checksum);
+int decode80(const unsigned char *image_in, size_t inSize, unsigned char *image_out, size_t outSize, unsigned checksum);
 
 #endif // DECODE_H
@@ -22,9 +22,14 @@
 #include <misc/SDL2pp.h>
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
+class INIFile;
+
+#define PAKCHECKSUMCACHE_FILENAME   "pakchecksums.ini"   ///< remembers the md5 checksums of the pak files by path, size and modification date
+
 /// A class for loading all the PAK-Files.
 /**
     This class manages all the PAK-Files and provides access to the contained files through SDL_RWops.
@@ -59,10 +64,39 @@ public:
     sdl2::RWops_ptr openFile(const std::string& filename);
 
     bool exists(const std::string& filename) const;
+
+    /**
+        Returns a string identifying the content of all opened pak files. It changes whenever a pak file is added, removed or modified.
+        \return the md5 checksums of all pak files
+    */
+    const std::string& getPakFilesChecksum() const { return pakFilesChecksum; };
+
 private:
+    /// Where a file is found; either in the search path or inside a pak file
+    struct IndexEntry {
+        std::string externalFilepath;   ///< the path of the file in the search path or empty if the file is inside a pak file
+        Pakfile* pPakfile;              ///< the pak file containing the file
+        unsigned int pakIndex;          ///< the index of the file inside pPakfile
+    };
+
     std::string md5FromFilename(const std::string& filename) const;
 
+    /**
+        Returns the md5 checksum of a file. The checksum is only computed if checksumCache does not contain it for the current
+        size and modification date of the file.
+        \param  checksumCache           the cached checksums
+        \param  filename                the file to get the checksum of
+        \param  bChecksumCacheChanged   set to true if checksumCache was updated
+        \return the md5 checksum as a hex string
+    */
+    std::string cachedMD5FromFilename(INIFile& checksumCache, const std::string& filename, bool& bChecksumCacheChanged) const;
+
+    void buildIndex();
+    const IndexEntry* findFile(const std::string& filename) const;
+
     std::vector<std::unique_ptr<Pakfile>> pakFiles;
+    std::unordered_map<std::string, IndexEntry> fileIndex;  ///< maps the upper case filenames to the first file in search path priority order
+    std::string pakFilesChecksum;           ///< the md5 checksums of all pak files concatenated
 };
 
 #endif // FILEMANAGER_H
@@ -29,6 +29,16 @@ public:
 
     virtual void drawTextOnSurface(SDL_Surface* pSurface, const std::string& text, Uint32 baseColor = 0xFFFFFFFF) = 0;
 
+    /// Draws a text directly with the renderer
+    /**
+        The text is drawn the same way as by drawTextOnSurface() but without creating any surface or texture for it.
+        \param  x           the x-coordinate of the left side of the text
+        \param  y           the y-coordinate of the top side of the text
+        \param  text        the text to draw
+        \param  baseColor   the color of the text
+    */
+    virtual void drawText(int x, int y, const std::string& text, Uint32 baseColor = 0xFFFFFFFF) = 0;
+
     /// Returns the number of pixels a text needs
     /**
         This methods returns the number of pixels this text would need if printed.
@@ -24,6 +24,10 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <unordered_map>
+#include <utility>
+
+#define FONTMANAGER_MAX_CACHED_TEXTURES     64  ///< all cached text textures are dropped when more are needed
 
 /// A class for managing fonts.
 /**
@@ -36,12 +40,23 @@ public:
     ~FontManager();
 
     void drawTextOnSurface(SDL_Surface* pSurface, const std::string& text, Uint32 color, unsigned int fontSize);
+    void drawText(int x, int y, const std::string& text, Uint32 color, unsigned int fontSize);
     int getTextWidth(const std::string& text, unsigned int fontSize);
     int getTextHeight(unsigned int fontSize);
     sdl2::surface_ptr createSurfaceWithText(const std::string& text, Uint32 color, unsigned int fontSize);
     sdl2::texture_ptr createTextureWithText(const std::string& text, Uint32 color, unsigned int fontSize);
     sdl2::surface_ptr createSurfaceWithMultilineText(const std::string& text, Uint32 color, unsigned int fontSize, bool bCentered = false);
     sdl2::texture_ptr createTextureWithMultilineText(const std::string& text, Uint32 color, unsigned int fontSize, bool bCentered = false);
+
+    /**
+        Returns a texture with text like createTextureWithText() but keeps it for later calls with the same text,
+        color and font size. Use this for texts that are drawn unchanged every frame.
+        \param  text        the text
+        \param  color       the color of the text
+        \param  fontSize    the font size
+        \return the texture (owned by this FontManager and only valid until the next call of this method)
+    */
+    SDL_Texture* getCachedTextureWithText(const std::string& text, Uint32 color, unsigned int fontSize);
 private:
     inline Font* getFont(unsigned int fontSize) {
         auto iter = fonts.find(fontSize);
@@ -53,9 +68,19 @@ private:
         }
     }
 
+    /**
+        Opens the font in the given size. The font file is read only once and shared by all sizes.
+        \param  fontSize    the font size
+        \return the font
+    */
     std::unique_ptr<Font> loadFont(unsigned int fontSize);
 
-    std::map<unsigned int, std::unique_ptr<Font>> fonts;
+    std::string fontFileData;           ///< the content of the font file all fonts are opened from (read when the first font is opened, outlives fonts)
+
+    std::map<unsigned int, std::unique_ptr<Font>> fonts;    ///< the fonts by size, each opened on first use
+
+    std::map<std::pair<unsigned int, Uint32>, std::unordered_map<std::string, sdl2::texture_ptr>> cachedTextures;   ///< the cached text textures by font size and color
+    size_t numCachedTextures = 0;       ///< the number of textures in cachedTextures
 
 };
 
@@ -21,13 +21,17 @@
 #include "Animation.h"
 #include "Shpfile.h"
 #include "Wsafile.h"
+#include "SurfaceCache.h"
 #include <DataTypes.h>
 
 #include <misc/SDL2pp.h>
+#include <misc/TextureAtlas.h>
 
 #include <string>
 #include <array>
+#include <deque>
 #include <memory>
+#include <vector>
 
 #define NUM_TERRAIN_TILES_X 11
 #define NUM_TERRAIN_TILES_Y 8
@@ -36,6 +40,9 @@
 #define NUM_WINDTRAP_ANIMATIONS_PER_ROW 10
 #define NUM_STATIC_ANIMATIONS_PER_ROW 7
 
+#define OBJPICCACHE_FILENAME    "objpics.cache"
+#define OBJPICCACHE_VERSION     "1"             ///< increase whenever the generation of the zoomed or recolored object pictures changes
+
 // ObjPics
 typedef enum {
     ObjPic_Tank_Base,
@@ -510,6 +517,33 @@ typedef enum {
 } Animation_enum;
 
 
+/**
+    A sprite sheet that may be packed together with other sprite sheets into one texture.
+*/
+struct AtlasPic {
+    SDL_Texture* texture;   ///< the texture containing this sprite sheet
+    SDL_Rect rect;          ///< the position of this sprite sheet inside texture
+
+    /**
+        Returns the source rect for a part of this sprite sheet.
+        \param  x   the x position inside the sprite sheet
+        \param  y   the y position inside the sprite sheet
+        \param  w   the width
+        \param  h   the height
+        \return the source rect inside texture
+    */
+    SDL_Rect getSourceRect(int x, int y, int w, int h) const noexcept {
+        return { rect.x + x, rect.y + y, w, h };
+    }
+
+    /**
+        Checks if the specified part lies inside this sprite sheet.
+    */
+    bool contains(int x, int y, int w, int h) const noexcept {
+        return (x >= 0) && (y >= 0) && (x + w <= rect.w) && (y + h <= rect.h);
+    }
+};
+
 class GFXManager {
 public:
     GFXManager();
@@ -524,6 +558,44 @@ public:
     SDL_Texture*     getZoomedObjPic(unsigned int id, unsigned int z) { return getZoomedObjPic(id, HOUSE_HARKONNEN, z); };
     zoomable_texture getObjPic(unsigned int id, int house=HOUSE_HARKONNEN);
 
+    /**
+        Returns the object picture id for zoom level z. The terrain, destroyed structure, damage, tracks and
+        hidden/fog pictures are packed into one atlas per zoom level, so that the per tile ground and fog passes
+        never switch textures. All other pictures are returned as their own texture.
+        \param  id  the object picture
+        \param  z   the zoom level
+        \return the texture and the position of the picture inside it
+    */
+    AtlasPic         getZoomedAtlasPic(unsigned int id, unsigned int z);
+
+    /**
+        Queues all object pictures in the colors of the given houses for generation by processPrefetchQueue(). The zoomed and
+        recolored pictures are otherwise generated on first use, which may cause a noticeable stutter when a new unit type
+        first appears on the screen. Any previously queued pictures are discarded.
+        \param  houses          the houses taking part in the game
+        \param  firstZoomlevel  the zoom level to generate first (usually the current one)
+    */
+    void             prefetchObjPics(const std::vector<int>& houses, unsigned int firstZoomlevel);
+
+    /**
+        Generates queued object pictures until the queue is empty or maxTime milliseconds have passed.
+        \param  maxTime the time budget in milliseconds
+        \return true if there are still pictures queued, false otherwise
+    */
+    bool             processPrefetchQueue(Uint32 maxTime);
+
+    /**
+        Redraws all object pictures that were scaled on the GPU (see settings.video.gpuZoomScaling). Their contents are
+        lost when the renderer reports SDL_RENDER_TARGETS_RESET. The textures themselves stay valid.
+    */
+    void             restoreGPUScaledObjPics();
+
+    /**
+        Recreates the graphics that depend on the screen size (the menu background, the top and side bars, ...) after
+        settings.video.width or settings.video.height has changed. All other graphics and textures stay loaded.
+    */
+    void             recreateScreenSizeDependentGraphics();
+
     SDL_Texture*     getSmallDetailPic(unsigned int id);
     SDL_Texture*     getTinyPicture(unsigned int id);
     SDL_Texture*     getUIGraphic(unsigned int id, int house=HOUSE_HARKONNEN);
@@ -536,25 +608,74 @@ public:
 
     Animation*       getAnimation(unsigned int id);
 
+    /**
+        Estimates the memory of the graphics card used by all loaded textures (without the animations).
+        \return the estimated size in bytes
+    */
+    size_t           getTextureMemory() const;
+
+    /**
+        Returns the main memory used by the pixels of all loaded surfaces (without the animations).
+        \return the size in bytes
+    */
+    size_t           getSurfaceMemory() const;
+
 private:
     std::unique_ptr<Animation>  loadAnimationFromWsa(const std::string& filename) const;
     sdl2::surface_ptr           generateWindtrapAnimationFrames(SDL_Surface* windtrapPic) const;
     sdl2::surface_ptr           generateMapChoiceArrowFrames(SDL_Surface* arrowPic, int house=HOUSE_HARKONNEN) const;
 
+    /**
+        Replaces the UI graphic id and drops its recolored surfaces and all its textures, which are then regenerated
+        on first use.
+        \param  id          the id of the UI graphic
+        \param  pSurface    the new picture in the colors of HOUSE_HARKONNEN
+    */
+    void                        replaceUIGraphic(unsigned int id, sdl2::surface_ptr pSurface);
+
     std::unique_ptr<Shpfile>  loadShpfile(const std::string& filename) const;
     std::unique_ptr<Wsafile>  loadWsafile(const std::string& filename) const;
 
-    sdl2::texture_ptr   extractSmallDetailPic(const std::string& filename) const;
+    /**
+        Decodes the first frame of the WSA file filename and returns it at half size. This does not touch the renderer
+        and may be called from several threads at once.
+    */
+    sdl2::surface_ptr   extractSmallDetailPic(const std::string& filename) const;
+
 
+    /**
+        Returns the 8-bit surface of the object picture id in the color of house for zoom level z. Zoomed and recolored
+        surfaces are generated on first request from the unzoomed surface of this house or from the HOUSE_HARKONNEN surface.
+    */
+    SDL_Surface*        getObjPicSurface(unsigned int id, int house, unsigned int z);
 
     sdl2::surface_ptr   generateDoubledObjPic(unsigned int id, int h) const;
     sdl2::surface_ptr   generateTripledObjPic(unsigned int id, int h) const;
 
+    void                buildGroundAtlas(unsigned int z);
+
+    /**
+        Creates the texture of the object picture id in the color of house for zoom level z > 0 by scaling the unzoomed
+        texture on the GPU with nearest neighbour sampling. No zoomed 8-bit surface is generated or kept in main memory.
+    */
+    sdl2::texture_ptr   createGPUScaledObjPic(unsigned int id, int house, unsigned int z);
+
+    /**
+        Draws pSource scaled by factor into the render target pTarget, replacing its contents.
+        \return true on success, false if pTarget could not be set as render target
+    */
+    static bool         renderGPUScaledObjPic(SDL_Texture* pSource, SDL_Texture* pTarget, int factor);
+
+    // declared first so that it outlives the object pictures taken from its read-only mapping
+    std::unique_ptr<SurfaceCache> pObjPicCache;                             ///< the zoomed and recolored object pictures of previous runs
+
     // 8-bit surfaces kept in main memory for processing as needed, e.g. color remapping
     std::array<std::array<std::array<sdl2::surface_ptr, NUM_ZOOMLEVEL>, NUM_HOUSES>, NUM_OBJPICS> objPic;
     std::array<std::array<sdl2::surface_ptr, NUM_HOUSES>, NUM_UIGRAPHICS> uiGraphic;
     std::array<std::array<sdl2::surface_ptr, NUM_HOUSES>, NUM_MAPCHOICEPIECES> mapChoicePieces;
     std::array<std::unique_ptr<Animation>, NUM_ANIMATION> animation{};
+    std::array<sdl2::surface_ptr, NUM_SMALLDETAILPICS> smallDetailPic;   ///< converted to smallDetailPicTex on first use
+    std::array<sdl2::surface_ptr, NUM_TINYPICTURE> tinyPicture;           ///< converted to tinyPictureTex on first use
 
     // 32-bit surfaces
     sdl2::surface_ptr    pBackgroundSurface;
@@ -565,6 +686,19 @@ private:
     std::array<sdl2::texture_ptr, NUM_TINYPICTURE> tinyPictureTex;
     std::array<std::array<sdl2::texture_ptr, NUM_HOUSES>, NUM_UIGRAPHICS> uiGraphicTex;
     std::array<std::array<sdl2::texture_ptr, NUM_HOUSES>, NUM_MAPCHOICEPIECES> mapChoicePiecesTex;
+
+    std::array<TextureAtlas, NUM_ZOOMLEVEL> groundAtlas;                    ///< the ground pictures packed per zoom level
+    std::array<bool, NUM_ZOOMLEVEL> groundAtlasBuilt{};                     ///< was building groundAtlas attempted?
+
+    struct PrefetchItem {
+        unsigned int id;                                                    ///< the object picture
+        int house;                                                          ///< the color of the object picture
+        unsigned int z;                                                     ///< the zoom level
+    };
+
+    std::deque<PrefetchItem> prefetchQueue;                                 ///< the object pictures still to generate by processPrefetchQueue()
+
+    std::array<std::array<std::array<bool, NUM_ZOOMLEVEL>, NUM_HOUSES>, NUM_OBJPICS> objPicGenerated{};   ///< generated in this run and not cached yet?
 };
 
 #endif // GFXMANAGER_H
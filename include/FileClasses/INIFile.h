@@ -23,6 +23,7 @@
 #include <string>
 #include <list>
 #include <algorithm>
+#include <unordered_map>
 
 #define INVALID_LINE (-1)
 
@@ -44,6 +45,22 @@
 */
 class INIFile
 {
+private:
+    //\cond
+    /// Case insensitive hash for section and key names
+    struct NameHash {
+        size_t operator()(const std::string& name) const;
+    };
+
+    /// Case insensitive comparison for section and key names
+    struct NameEqual {
+        bool operator()(const std::string& name1, const std::string& name2) const;
+    };
+
+    template<class T>
+    using NameIndex = std::unordered_map<std::string, T*, NameHash, NameEqual>;
+    //\endcond
+
 public:
 
     //\cond
@@ -175,12 +192,16 @@ public:
 
     protected:
         void insertKey(Key* newKey);
+        void unlinkKey(Key* key);
+        void clearKeys();
 
         int sectionStringBegin;
         int sectionStringLength;
         Section* nextSection;
         Section* prevSection;
         Key* keyRoot;
+        Key* keyLast;                   ///< last key in this section (for appending in constant time)
+        NameIndex<Key> keyIndex;        ///< the first key for every key name in this section
         bool bWhitespace;
     };
 
@@ -262,12 +283,15 @@ public:
 private:
     INIFileLine* firstLine;
     Section* sectionRoot;
+    Section* sectionLast;               ///< last section in this file (for appending in constant time)
+    NameIndex<Section> sectionIndex;    ///< the first section for every section name
     bool bWhitespace;
 
     void flush() const;
     void readfile(SDL_RWops * file);
 
     void insertSection(Section* newSection);
+    void unlinkSection(Section* section);
 
     const Section* getSectionInternal(const std::string& sectionname) const;
     Section* getSectionOrCreate(const std::string& sectionname);
@@ -20,12 +20,22 @@
 
 #include <misc/SDL2pp.h>
 
+#define PNG_MAX_COMPRESSION         9   ///< compress as good as possible (slowest)
+#define PNG_DEFAULT_COMPRESSION     6   ///< the compression level of SavePNG()
+
 #define LoadPNG(file) SDL_LoadPNG_RW(sdl2::RWops_ptr{SDL_RWFromFile(file, "rb")}.get())
 #define SavePNG(surface, file) SavePNG_RW(surface, sdl2::RWops_ptr{SDL_RWFromFile(file, "wb")}.get())
 
 
 sdl2::surface_ptr LoadPNG_RW(SDL_RWops* RWop);
 
-int SavePNG_RW(SDL_Surface* surface, SDL_RWops* RWop);
+/**
+    Encodes surface as a PNG image and writes it to RWop.
+    \param  surface             the surface to save
+    \param  RWop                the stream to write to
+    \param  compressionLevel    0 (uncompressed, fastest) to PNG_MAX_COMPRESSION (smallest, slowest)
+    \return 0 on success, -1 on error
+*/
+int SavePNG_RW(SDL_Surface* surface, SDL_RWops* RWop, int compressionLevel = PNG_DEFAULT_COMPRESSION);
 
 #endif // LOADSAVEPNG_H
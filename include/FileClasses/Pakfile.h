@@ -64,11 +64,22 @@ public:
     inline int getNumFiles() const { return fileEntries.size(); };
 
     sdl2::RWops_ptr openFile(const std::string& filename);
+    sdl2::RWops_ptr openFile(unsigned int index);
 
     bool exists(const std::string& filename) const;
 
     void addFile(SDL_RWops* rwop, const std::string& filename);
 
+    /// Is this PAK-File memory-mapped?
+    /**
+        Returns if the content of this PAK-File is memory-mapped. Files of a mapped PAK-File are read without any system call
+        and their content can be accessed in place with getMappedData(). If mapping fails the file is read through the file handle.
+        \return true if mapped, false otherwise
+    */
+    inline bool isMapped() const { return (pMappedData != nullptr); };
+
+    static const unsigned char* getMappedData(SDL_RWops* pRWop, size_t* pSize);
+
 private:
     static size_t ReadFile(SDL_RWops* pRWop, void *ptr, size_t size, size_t n);
     static size_t WriteFile(SDL_RWops *pRWop, const void *ptr, size_t size, size_t n);
@@ -78,13 +89,23 @@ private:
 
     void readIndex();
 
+    void mapFile();
+    void unmapFile();
+
     bool write;
     SDL_RWops * fPakFile;
+    SDL_mutex * fPakFileMutex;          ///< serializes the seek and read on fPakFile of RWops used by different threads
     std::string filename;
 
     char* writeOutData;
     int numWriteOutData;
     std::vector<PakFileEntry> fileEntries;
+
+    const unsigned char* pMappedData;   ///< the content of the PAK-File if it is memory-mapped, nullptr otherwise
+    size_t mappedSize;                  ///< the size of the mapping
+#ifdef _WIN32
+    void* hMapping;                     ///< the file mapping object
+#endif
 };
 
 #endif // PAKFILE_H
@@ -22,7 +22,9 @@
 #include <DataTypes.h>
 #include <misc/sound_util.h>
 
+#include <array>
 #include <string>
+#include <vector>
 
 #define NUM_MAPCHOICEPIECES 28
 #define NUM_MAPCHOICEARROWS 9
@@ -90,6 +92,12 @@ typedef enum {
 } Sound_enum;
 
 
+/// the maximum number of voices kept loaded; the least recently used voice that is not playing is freed first
+#define SFXMANAGER_MAX_LOADED_VOICES    40
+
+/**
+    Loads voices and sounds on first use. Sounds stay loaded, voices are kept in a small least recently used cache.
+*/
 class SFXManager {
 public:
     SFXManager();
@@ -98,16 +106,33 @@ public:
     Mix_Chunk*      getVoice(Voice_enum id, int house);
     Mix_Chunk*      getSound(Sound_enum id);
 
+    /**
+        Loads all sounds and all voices of house so that no file has to be loaded in the middle of a game.
+        \param  house   the house of the local player
+    */
+    void            prewarm(int house);
+
+    /**
+        Returns the memory used by the samples of all loaded voices and sounds.
+        \return the size in bytes
+    */
+    size_t          getSoundMemory() const;
+
 private:
     sdl2::mix_chunk_ptr loadMixFromADL(const std::string& adlFile, int index, int volume = MIX_MAX_VOLUME/2) const;
 
-    void            loadEnglishVoice();
-    Mix_Chunk*      getEnglishVoice(Voice_enum id, int house) const;
+    sdl2::mix_chunk_ptr loadEnglishVoice(Voice_enum id, int house) const;
+    sdl2::mix_chunk_ptr loadNonEnglishVoice(Voice_enum id) const;
+    sdl2::mix_chunk_ptr loadSound(Sound_enum id) const;
 
-    void            loadNonEnglishVoice(const std::string& languagePrefix);
-    Mix_Chunk*      getNonEnglishVoice(Voice_enum id, int house) const;
+    void            evictLeastRecentlyUsedVoice(size_t keepIndex);
+    static bool     isPlaying(const Mix_Chunk* pChunk);
 
-    std::vector<sdl2::mix_chunk_ptr> lngVoice;
+    std::string languagePrefix;                         ///< "G" or "F" for the german or french voices, empty for english
+    std::vector<sdl2::mix_chunk_ptr> lngVoice;          ///< english voices are indexed by id*NUM_HOUSES + house, others by id
+    std::vector<Uint32> lngVoiceLastUse;                ///< the value of voiceUseCounter when lngVoice[i] was last requested
+    Uint32 voiceUseCounter = 0;                         ///< incremented on every call to getVoice()
+    int numLoadedVoices = 0;                            ///< the number of non-null entries in lngVoice
     std::array<sdl2::mix_chunk_ptr, NUM_SOUNDCHUNK> soundChunk;
 };
 
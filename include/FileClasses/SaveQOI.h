@@ -0,0 +1,35 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SAVEQOI_H
+#define SAVEQOI_H
+
+#include <misc/SDL2pp.h>
+
+#define SaveQOI(surface, file) SaveQOI_RW(surface, sdl2::RWops_ptr{SDL_RWFromFile(file, "wb")}.get())
+
+/**
+    Encodes surface as a QOI image ("Quite OK Image" format, RGBA, sRGB) and writes it to RWop. QOI files are
+    larger than PNG files but encoding them is only a single pass with a few comparisons per pixel.
+    \param  surface the surface to save
+    \param  RWop    the stream to write to
+    \return 0 on success, -1 on error
+*/
+int SaveQOI_RW(SDL_Surface* surface, SDL_RWops* RWop);
+
+#endif // SAVEQOI_H
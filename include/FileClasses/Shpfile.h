@@ -67,11 +67,13 @@ public:
 
 private:
     void readIndex();
+    size_t getRemainingSize(const unsigned char* p) const;
     static void shpCorrectLF(const unsigned char *in, unsigned char *out, int size);
     static void applyPalOffsets(const unsigned char *offsets, unsigned char *data,unsigned int length);
 
     std::vector<ShpfileEntry> shpfileEntries;
-    std::unique_ptr<unsigned char[]> pFiledata;
+    std::unique_ptr<unsigned char[]> pOwnedFiledata;    ///< a copy of the file if it could not be accessed in place
+    const unsigned char* pFiledata;                     ///< the content of the shp-File
     size_t shpFilesize;
 };
 
@@ -0,0 +1,121 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SURFACECACHE_H
+#define SURFACECACHE_H
+
+#include <misc/SDL2pp.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#define SURFACECACHE_VERSION        1
+#define SURFACECACHE_NO_COLORKEY    0xFFFFFFFF
+
+/// A persistent on-disk cache of 8-bit surfaces.
+/**
+    The cache file stores a number of 8-bit surfaces together with their palette and color key. It is tagged with a source key
+    (e.g. a checksum of all input files and settings the surfaces were generated from) and is discarded if the key, the version or
+    the checksum over the content does not match. The pixel data of each surface is stored 16-byte aligned with the pitch SDL uses for
+    8-bit surfaces, so that it can be used in place: the file is memory-mapped read-only and the surfaces loaded from it refer to the
+    mapping directly. Thus all game processes on one machine share a single copy of these pixels in the page cache.
+*/
+class SurfaceCache final {
+public:
+    /**
+        Constructor. Loads the cache file if it exists and is valid, otherwise the cache starts out empty.
+        \param  filename    the path of the cache file
+        \param  sourceKey   identifies the input the cached surfaces were generated from
+    */
+    SurfaceCache(const std::string& filename, const std::string& sourceKey);
+
+    SurfaceCache(const SurfaceCache &) = delete;
+    SurfaceCache(SurfaceCache &&) = delete;
+    SurfaceCache& operator=(const SurfaceCache &) = delete;
+    SurfaceCache& operator=(SurfaceCache &&) = delete;
+
+    ~SurfaceCache();
+
+    /**
+        Returns the cached surface with the given key. If the surface was loaded from the memory-mapped cache file, the returned
+        surface refers to the read-only mapping: its pixels must not be modified and it must not be used after the cache is destroyed.
+        Palette and color key are owned by the returned surface and may be changed.
+        \param  key the key of the surface
+        \return the surface or nullptr if no surface is cached under this key
+    */
+    sdl2::surface_ptr getSurface(Uint32 key) const;
+
+    /**
+        Adds the 8-bit surface pSurface to the cache. The surface is copied, so the caller keeps ownership; surfaces with another
+        pixel format are ignored.
+        \param  key         the key of the surface
+        \param  pSurface    the surface to cache
+    */
+    void putSurface(Uint32 key, SDL_Surface* pSurface);
+
+    /**
+        Writes the cache file if surfaces were added since it was loaded. The file is written under a temporary name and then
+        renamed, so that the mapping of this and other processes stays valid.
+        \return true if the file is up-to-date, false if writing failed
+    */
+    bool save();
+
+    inline size_t getNumSurfaces() const { return entries.size(); };
+
+private:
+    struct Entry {
+        Uint16 width;                   ///< the width of the surface
+        Uint16 height;                  ///< the height of the surface
+        Uint32 pitch;                   ///< the length of one row in bytes
+        Uint32 colorKey;                ///< the color key or SURFACECACHE_NO_COLORKEY
+        Uint32 paletteIndex;            ///< index into palettes
+        size_t fileOffset;              ///< the offset of the pixels in pFileData for entries loaded from the cache file
+        std::vector<Uint8> pixels;      ///< pitch*height bytes for entries added by putSurface()
+    };
+
+    bool load();
+
+    /**
+        Maps the cache file read-only into memory. On success pFileData and fileSize describe the mapping.
+    */
+    void mapFile(SDL_RWops* pFile);
+
+    /**
+        Releases the mapping created by mapFile() and the content read by load().
+    */
+    void unmapFile();
+
+    const Uint8* getPixels(const Entry& entry) const {
+        return entry.pixels.empty() ? (pFileData + entry.fileOffset) : entry.pixels.data();
+    }
+
+    std::string filename;                               ///< the path of the cache file
+    Uint8 sourceChecksum[16];                           ///< md5 of the source key
+    const Uint8* pFileData = nullptr;                   ///< the content of the cache file (mapped or in fileBuffer)
+    size_t fileSize = 0;                                ///< the size of the content
+    bool bMapped = false;                               ///< is pFileData a memory mapping of the cache file?
+#ifdef _WIN32
+    void* hMapping = nullptr;                           ///< the file mapping object
+#endif
+    std::vector<Uint8> fileBuffer;                      ///< the content of the cache file if it cannot be mapped
+    std::vector<std::vector<SDL_Color>> palettes;       ///< the distinct palettes of all cached surfaces
+    std::map<Uint32, Entry> entries;                    ///< the cached surfaces
+    bool bModified = false;                             ///< were surfaces added since loading?
+};
+
+#endif // SURFACECACHE_H
@@ -23,13 +23,23 @@
 
 #include <SDL2/SDL_ttf.h>
 
+#include <string>
+#include <unordered_map>
 #include <vector>
 
+/// the width and height of the glyph atlas texture of each font size
+#define TTFFONT_ATLAS_SIZE              512
+
+/// the maximum number of text layouts kept per font size before the cache is cleared
+#define TTFFONT_MAX_CACHED_LAYOUTS      256
+
 typedef sdl2::implementation::unique_ptr_deleter<TTF_Font, TTF_CloseFont> font_ptr;
 
 /// A class for loading a ttf font.
 /**
-    This class can read a ttf font.
+    This class can read a ttf font. For drawing with the renderer every glyph is rendered only once into a glyph atlas
+    texture and the positions of the glyphs of recently drawn texts are cached. Drawing a text is then just copying
+    the glyphs out of the atlas.
 */
 class TTFFont : public Font
 {
@@ -39,6 +49,8 @@ public:
 
     void drawTextOnSurface(SDL_Surface* pSurface, const std::string& text, Uint32 baseColor = 0xFFFFFFFF) override;
 
+    void drawText(int x, int y, const std::string& text, Uint32 baseColor = 0xFFFFFFFF) override;
+
     int getTextWidth(const std::string& text) const override;
 
     /// Returns the number of pixels this font needs in y-direction.
@@ -49,8 +61,36 @@ public:
     inline int getTextHeight() const override { return characterHeight; };
 
 private:
+    /// A glyph inside the atlas
+    struct Glyph {
+        SDL_Rect atlasRect;     ///< the position of the glyph inside the atlas
+        int offsetX;            ///< the offset from the pen position to the left side of atlasRect
+        int advance;            ///< the number of pixels the pen is advanced after this glyph
+        Uint16 ch;              ///< the code point of this glyph (0 if outside the basic multilingual plane)
+    };
+
+    /// A glyph of a text layout
+    struct GlyphQuad {
+        SDL_Rect atlasRect;     ///< the position of the glyph inside the atlas
+        int x;                  ///< the offset of the glyph from the left side of the text
+    };
+
+    const Glyph* getGlyph(const std::string& utf8Char);
+    const std::vector<GlyphQuad>& getLayout(const std::string& text);
+    void resetAtlas();
+
     font_ptr pTTFFont;
     int characterHeight;
+
+    sdl2::surface_ptr pAtlasSurface;        ///< the glyphs in white on transparent background
+    sdl2::texture_ptr pAtlasTexture;        ///< pAtlasSurface on the GPU; colored by the texture color mod
+    int atlasPenX = 0;                      ///< the x-position for the next glyph in the atlas
+    int atlasPenY = 0;                      ///< the y-position of the current row in the atlas
+    int atlasRowHeight = 0;                 ///< the height of the current row in the atlas
+    Uint32 atlasGeneration = 0;             ///< increased every time the atlas is cleared
+
+    std::unordered_map<std::string, Glyph> glyphs;                      ///< the glyphs in the atlas, keyed by their utf-8 encoding
+    std::unordered_map<std::string, std::vector<GlyphQuad>> layouts;    ///< the layouts of recently drawn texts
 };
 
 #endif //TTFFONT_H
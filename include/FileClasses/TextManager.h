@@ -23,6 +23,7 @@
 
 #include <string>
 #include <vector>
+#include <deque>
 #include <map>
 #include <memory>
 
@@ -33,6 +34,40 @@
 #define MISSION_LOSE            2
 #define MISSION_ADVICE          3
 
+/**
+    The index of a string that is localized with _("..."). Every _("...") call site creates its id once, i.e. the
+    English text is registered on the first call and all later calls look up the localized text by this index
+    (see TextManager::getLocalized(const LocalizedStringID&)) without comparing any strings.
+*/
+class LocalizedStringID {
+public:
+    /**
+        Registers unlocalizedString and assigns the next free index to it.
+        \param  unlocalizedString   the string in English
+    */
+    explicit LocalizedStringID(const char* unlocalizedString);
+
+    LocalizedStringID(const LocalizedStringID &) = delete;
+    LocalizedStringID& operator=(const LocalizedStringID &) = delete;
+
+    inline size_t getIndex() const { return index; }
+
+    /**
+        Returns the registered English text of this id.
+    */
+    const std::string& getUnlocalizedString() const;
+
+    /**
+        Returns the number of registered ids.
+    */
+    static size_t getNumIDs();
+
+private:
+    static std::deque<std::string>& getRegisteredStrings();
+
+    size_t index;   ///< the index of this id in getRegisteredStrings()
+};
+
 
 class TextManager {
 public:
@@ -64,9 +99,18 @@ public:
         This method returns all mentat entries for a specific house and up to the specified tech level.
         \param  house       the house to get the text from (only HOUSE_ATREIDES, HOUSE_ORDOS and HOUSE_HARKONNEN)
         \param  techLevel   the tech level (1 to 8)
-        \return a vector of mentat texts
+        \return the mentat entries (they stay valid as long as this TextManager exists)
     */
-    std::vector<MentatTextFile::MentatEntry> getAllMentatEntries(int house, unsigned int techLevel) const;
+    std::vector<const MentatTextFile::MentatEntry*> getAllMentatEntries(int house, unsigned int techLevel) const;
+
+    /**
+        This method returns an original Dune II (indexed) text file, e.g. "INTRO.ENG". Every file is loaded and
+        decoded only once and then shared by all callers.
+        \param  filename    the name of the file
+        \param  bDecode     true if the texts are compressed (the TEXT?.ENG files)
+        \return the loaded file (it stays valid as long as this TextManager exists)
+    */
+    const IndexedTextFile& getIndexedTextFile(const std::string& filename, bool bDecode = false) const;
 
     /**
         This method returns a localized version of unlocalizedString
@@ -84,6 +128,19 @@ public:
         }
     }
 
+    /**
+        This method returns a localized version of the string registered for id. After the first call for an id
+        this is only an array access.
+        \param  id  the id of the string in English
+        \return the localized version of the string
+    */
+    const std::string& getLocalized(const LocalizedStringID& id) const {
+        if((id.getIndex() < localizedStringByID.size()) && (localizedStringByID[id.getIndex()] != nullptr)) {
+            return *localizedStringByID[id.getIndex()];
+        } else {
+            return resolveLocalized(id);
+        }
+    }
 
 
 private:
@@ -112,6 +169,13 @@ private:
     */
     const std::string& postProcessString(const std::string& unprocessedString) const;
 
+    /**
+        Looks up the localized string for id and stores it in localizedStringByID.
+        \param  id  the id of the string in English
+        \return the localized version of the string
+    */
+    const std::string& resolveLocalized(const LocalizedStringID& id) const;
+
     /**
         Add a original Dune 2 text file
     */
@@ -120,9 +184,11 @@ private:
 
     std::array<std::unique_ptr<MentatTextFile>,3> mentatStrings;            ///< The MENTAT?.<EXTENSION> mentat menu texts
 
-    std::map<std::string,std::unique_ptr<IndexedTextFile> > origDuneText;   ///< This map contains all the loaded original Dune II (indexed) text files
+    mutable std::map<std::string,std::unique_ptr<IndexedTextFile> > origDuneText;   ///< This map contains all the loaded original Dune II (indexed) text files
 
     mutable std::map<std::string, std::string> localizedString;             ///< The mapping between English text and localized text
+
+    mutable std::vector<const std::string*> localizedStringByID;            ///< The localized text by LocalizedStringID (nullptr = not looked up yet)
 };
 
 #endif //TEXTMANAGER_H
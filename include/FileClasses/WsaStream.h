@@ -0,0 +1,78 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WSASTREAM_H
+#define WSASTREAM_H
+
+#include <FileClasses/Wsafile.h>
+#include <misc/SDL2pp.h>
+
+#include <exception>
+#include <vector>
+
+/// the number of decoded frames a WsaStream keeps ready by default
+#define WSASTREAM_NUM_BUFFERS   4
+
+/// Plays the frames of a Wsafile in order without decoding the whole animation.
+/**
+    A background thread decodes the frames a few frames ahead of playback into a small ring of frame buffers. The
+    Wsafile must outlive this stream.
+*/
+class WsaStream final {
+public:
+    /**
+        Starts decoding the first frames of pWsafile.
+        \param  pWsafile    the animation to play
+        \param  numBuffers  the number of frames that are decoded ahead
+    */
+    explicit WsaStream(const Wsafile* pWsafile, int numBuffers = WSASTREAM_NUM_BUFFERS);
+
+    WsaStream(const WsaStream &) = delete;
+    WsaStream(WsaStream &&) = delete;
+    WsaStream& operator=(const WsaStream &) = delete;
+    WsaStream& operator=(WsaStream &&) = delete;
+
+    /// Destructor. Stops the decoder thread.
+    ~WsaStream();
+
+    /**
+        Returns the next frame of the animation. Waits if the decoder thread has not finished this frame yet. An
+        exception thrown while decoding is rethrown here.
+        \return the next frame as an 8-bit surface or nullptr after the last frame
+    */
+    sdl2::surface_ptr getNextPicture();
+
+private:
+    static int decoderThreadMain(void* data);
+    void decodeFrames();
+
+    const Wsafile* pWsafile;                        ///< the animation to play
+    size_t frameSize;                               ///< the size of one frame in bytes
+    std::vector<std::vector<unsigned char>> frameBuffers;   ///< ring of decoded frames, frame i is in frameBuffers[i % frameBuffers.size()]
+
+    SDL_mutex* mutex = nullptr;                     ///< guards all members below
+    SDL_cond* frameDecodedCond = nullptr;           ///< signaled when numDecoded increased or decoding failed
+    SDL_cond* bufferFreeCond = nullptr;             ///< signaled when numConsumed increased or bStop is set
+    int numDecoded = 0;                             ///< the number of frames the decoder thread has written to frameBuffers
+    int numConsumed = 0;                            ///< the number of frames returned by getNextPicture()
+    bool bStop = false;                             ///< tells the decoder thread to exit
+    std::exception_ptr pException;                  ///< the exception thrown by the decoder thread
+
+    SDL_Thread* pThread = nullptr;                  ///< the decoder thread (nullptr if frames are decoded in getNextPicture())
+};
+
+#endif // WSASTREAM_H
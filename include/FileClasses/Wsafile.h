@@ -25,7 +25,9 @@
 
 /// A class for loading a *.WSA-File.
 /**
-    This class can read the animation in a *.WSA-File and return it as SDL_Surfaces.
+    This class can read the animation in a *.WSA-File and return it as SDL_Surfaces. Only the compressed file is kept
+    after construction; all frames are decoded on the first call to getPicture() or getAnimationAsPictureRow(). A WsaStream
+    can play the animation without ever decoding all frames at once.
 */
 class Wsafile
 {
@@ -42,6 +44,7 @@ public:
     virtual ~Wsafile();
 
     sdl2::surface_ptr getPicture(Uint32 FrameNumber) const;
+    void decodeFrame(Uint32 frameNumber, unsigned char* pFrame) const;
     sdl2::surface_ptr getAnimationAsPictureRow(int numFramesX = std::numeric_limits<int>::max()) const;
     std::unique_ptr<Animation> getAnimation(unsigned int startindex, unsigned int endindex, bool bDoublePic=true, bool bSetColorKey=true) const;
 
@@ -72,11 +75,22 @@ public:
     bool isAnimationLooped() const noexcept { return looped; };
 
 private:
-    void decodeFrames(const unsigned char* pFiledata, Uint32* index, int numberOfFrames, unsigned char* pDecodedFrames, int x, int y) const;
+    /// One of the concatenated wsa-Files
+    struct WsaPart {
+        std::unique_ptr<unsigned char[]> pFiledata;     ///< the complete compressed file
+        size_t filesize = 0;                            ///< the size of pFiledata in bytes
+        const Uint32* index = nullptr;                  ///< the start offset of every frame inside pFiledata
+        Uint16 numFrames = 0;                           ///< the number of frames in this file
+        bool extended = false;                          ///< the first frame continues the last frame of the previous file
+    };
+
+    void decodeAllFrames() const;
     std::unique_ptr<unsigned char[]> readfile(SDL_RWops* rwop, int* filesize) const;
     void readdata(int numFiles, ...);
     void readdata(int numFiles, va_list args);
-    std::vector<unsigned char> decodedFrames;
+
+    std::vector<WsaPart> parts;
+    mutable std::vector<unsigned char> decodedFrames;   ///< all frames, decoded on first use by decodeAllFrames()
 
     Uint16 numFrames = 0;
     Uint16 sizeX = 0;
@@ -21,12 +21,26 @@
 
 #include <FileClasses/music/MusicPlayer.h>
 
+#include <string>
 #include <vector>
 #include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_atomic.h>
+#include <SDL2/SDL_thread.h>
+
+/// the directory inside the configuration directory the rendered tracks are cached in
+#define ADLPLAYER_CACHE_DIRECTORY       "music-cache"
+
+/// tracks are cut off after this many seconds when they are rendered into the cache
+#define ADLPLAYER_MAX_RENDER_SECONDS    900
 
 // Forward declarations
 class SoundAdlibPC;
 
+/**
+    Plays the ADL music by emulating an OPL chip in the SDL_mixer music callback. If settings.audio.cacheMusic is set,
+    every track is also rendered into a WAV file in ADLPLAYER_CACHE_DIRECTORY by a background thread the first time it
+    is played. From then on it is streamed from that file by SDL_mixer and no emulation is needed.
+*/
 class ADLPlayer : public MusicPlayer {
 public:
     ADLPlayer();
@@ -62,7 +76,29 @@ public:
     void setMusicVolume(int newVolume) override;
 
 private:
-    SoundAdlibPC* pSoundAdlibPC;
+    void stopMusic();
+    static std::vector<unsigned char> readFile(const std::string& filename);
+    std::string getCacheFilepath(const std::vector<unsigned char>& adlData, int musicNum) const;
+    bool playCachedTrack(const std::string& cacheFilepath);
+    void startRendering(std::vector<unsigned char>&& adlData, int musicNum, const std::string& cacheFilepath);
+    static int renderThreadMain(void* data);
+    void renderTrack();
+
+    SoundAdlibPC* pSoundAdlibPC;        ///< the emulator for the track currently played (nullptr if none or if the track is played from the cache)
+    Mix_Music* music;                   ///< the cached track currently played (nullptr if none)
+
+    std::string cacheDirectory;         ///< the directory for the rendered tracks (empty if caching is off)
+
+    /// The track rendered by the render thread
+    struct RenderJob {
+        std::vector<unsigned char> adlData; ///< the content of the ADL file
+        int musicNum = 0;                   ///< the track inside adlData
+        std::string cacheFilepath;          ///< the file to render to
+    } renderJob;
+
+    SDL_Thread* pRenderThread;          ///< renders renderJob (nullptr if no track was rendered yet)
+    SDL_atomic_t renderFinished;        ///< set by the render thread when it is done
+    SDL_atomic_t abortRendering;        ///< tells the render thread to stop and discard the unfinished file
 };
 
 #endif // ADLPLAYER_H
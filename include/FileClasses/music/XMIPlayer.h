@@ -23,6 +23,14 @@
 
 #include <Definitions.h>
 
+#define XMIPLAYER_CACHE_DIRECTORY   "music-cache"   ///< directory below the config directory for the converted music
+#define XMIPLAYER_CACHE_MAGIC       0x444c584d      ///< "DLXM"
+#define XMIPLAYER_CACHE_VERSION     1               ///< increase when the conversion changes
+
+#include <misc/SDL2pp.h>
+
+#include <map>
+#include <utility>
 #include <vector>
 #include <string>
 #include <SDL2/SDL_mixer.h>
@@ -70,10 +78,49 @@ public:
 
 private:
 
-    std::string getTmpFileName();
+    /**
+        Returns the converted MIDI data of one track of an XMI file. All tracks of the file are converted on first use
+        unless the preconvert thread has already done so.
+        \param  filename    the name of the XMI file
+        \param  musicNum    the number of the track
+        \return the MIDI data or nullptr if the track does not exist
+    */
+    const std::vector<Uint8>* getMIDITrack(const std::string& filename, int musicNum);
+
+    /**
+        Reads a complete XMI file. Must be called on the main thread, as pFileManager is replaced when reinitializing.
+        \param  filename    the name of the XMI file
+        \return the content of the file
+    */
+    static std::string readXMIFile(const std::string& filename);
+
+    /**
+        Converts all tracks of an XMI file to MIDI. The result is taken from the cache on disk if it was converted
+        from the same content before.
+        \param  filename    the name of the XMI file
+        \param  source      the content of the XMI file
+        \return the MIDI data of every track
+    */
+    static std::vector<std::vector<Uint8>> convertXMIFile(const std::string& filename, const std::string& source);
+
+    static bool loadFromCache(const std::string& cacheFilepath, const unsigned char sourceHash[16], std::vector<std::vector<Uint8>>& tracks);
+    static void saveToCache(const std::string& cacheFilepath, const unsigned char sourceHash[16], const std::vector<std::vector<Uint8>>& tracks);
+
+    static int preconvertThreadMain(void* data);
+
+    /**
+        Converts the files in preconvertSources into midiCache. Runs on pPreconvertThread.
+    */
+    void preconvertAll();
 
 
     Mix_Music*      music;
+
+    SDL_mutex*      midiCacheMutex = nullptr;       ///< guards midiCache and bStopPreconvert
+    std::map<std::string, std::vector<std::vector<Uint8>>> midiCache;  ///< the converted tracks of the XMI files converted so far (an entry is never changed once inserted)
+    bool            bStopPreconvert = false;        ///< tells the preconvert thread to exit
+    std::vector<std::pair<std::string, std::string>> preconvertSources;    ///< the names and contents of the XMI files to convert ahead of their first use
+    SDL_Thread*     pPreconvertThread = nullptr;    ///< converts all XMI files ahead of their first use (nullptr if not running)
 };
 
 #endif // XMIPLAYER_H
@@ -0,0 +1,116 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FLOWFIELDCACHE_H
+#define FLOWFIELDCACHE_H
+
+#include <DataTypes.h>
+#include <fixmath/FixPoint.h>
+
+#include <list>
+#include <vector>
+
+class InputStream;
+class Map;
+class OutputStream;
+class UnitBase;
+
+/**
+    Shares the path search of many units moving to the same destination (e.g. after a group move order).
+    When the second unit of the same movement class requests a path to a destination a flow field is calculated:
+    One Dijkstra search from the destination over the whole map. Every further unit of that group just follows
+    the decreasing costs of this field instead of doing its own AStarSearch.
+
+    Like HierarchicalPathGraph only static obstacles are considered. If the first steps of a path taken from
+    a flow field are blocked the caller falls back to AStarSearch.
+
+    All flow fields are discarded whenever a structure or the type of a tile changes, so the costs of a cached field
+    are always those a new calculation on the current map would give. Which unit gets a path from which field still
+    depends on the earlier requests, so the fields and the recent requests are saved with the map. The costs
+    themselves are not saved but calculated again when a loaded field is used first.
+*/
+class FlowFieldCache {
+public:
+    explicit FlowFieldCache(const Map* pMap);
+
+    FlowFieldCache(const FlowFieldCache &) = delete;
+    FlowFieldCache(FlowFieldCache &&) = delete;
+    FlowFieldCache& operator=(const FlowFieldCache &) = delete;
+    FlowFieldCache& operator=(FlowFieldCache &&) = delete;
+
+    /**
+        Discards all flow fields and recorded path requests.
+    */
+    void reset();
+
+    /**
+        Discards all flow fields because the static obstacles or the terrain on the map have changed.
+    */
+    void invalidate();
+
+    /**
+        Loads the flow fields (without their costs) and the recent path requests from stream.
+        \param  stream  the stream to read from
+    */
+    void load(InputStream& stream);
+
+    /**
+        Saves the flow fields (without their costs) and the recent path requests to stream.
+        \param  stream  the stream to write to
+    */
+    void save(OutputStream& stream) const;
+
+    /**
+        Returns a path for pUnit from its current location to destination if a flow field for this destination is
+        available or this request makes it worthwhile to create one.
+        \param  pUnit       the unit to find a path for (must be a ground unit)
+        \param  destination the destination of the unit
+        \param  path        the path is returned here
+        \return true if a path was found, false if the caller has to do a normal path search
+    */
+    bool getPath(const UnitBase* pUnit, const Coord& destination, std::list<Coord>& path);
+
+    /**
+        Returns the class of terrain pUnit can move on. Units of the same class get the same paths from static obstacles.
+        \param  pUnit   the unit to consider
+        \return 0 for wheeled units, 1 for tracked units, 2 for infantry and -1 for units that are not handled
+    */
+    static int getMovementClass(const UnitBase* pUnit);
+
+private:
+    struct FlowField {
+        Coord   destination;                    ///< the tile all paths of this field lead to
+        int     movementClass;                  ///< the movement class this field was calculated for
+        Uint32  lastUsedCycle;                  ///< the game cycle this field was last used in
+        std::vector<FixPoint> costs;            ///< cost to reach destination for every tile (FixPt_MAX if unreachable; empty if not calculated yet)
+    };
+
+    struct PathRequest {
+        Coord   destination;
+        int     movementClass;
+        Uint32  objectID;
+        Uint32  cycle;
+    };
+
+    void calculateFlowField(const UnitBase* pUnit, FlowField& flowField) const;
+
+    const Map* pMap;                            ///< the map this cache belongs to
+    std::vector<FlowField> flowFields;          ///< the currently cached flow fields
+    std::vector<PathRequest> recentRequests;    ///< path requests that did not use a flow field yet
+};
+
+#endif // FLOWFIELDCACHE_H
@@ -0,0 +1,95 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FOGOVERLAYCACHE_H
+#define FOGOVERLAYCACHE_H
+
+#include <misc/SDL2pp.h>
+
+#include <vector>
+
+#define FOGCHUNK_SIZE   16      ///< width and height of one chunk in tiles
+
+class Map;
+
+/**
+    Caches the shroud (unexplored tiles) and the fog of war overlay of the map for one team in render target textures
+    of FOGCHUNK_SIZE x FOGCHUNK_SIZE tiles for the current zoom level. The overlay needs one copy per visible chunk
+    instead of up to two copies per visible tile.
+
+    The visibility of every tile (explored, fogged) is kept in a small per-tile array. Each frame it is compared with
+    the map for the visible chunks, and only the chunks around changed tiles are rendered again with the usual edge
+    tiles. If render targets are not supported the tiles are drawn directly.
+*/
+class FogOverlayCache {
+public:
+    FogOverlayCache() = default;
+
+    FogOverlayCache(const FogOverlayCache &) = delete;
+    FogOverlayCache(FogOverlayCache &&) = delete;
+    FogOverlayCache& operator=(const FogOverlayCache &) = delete;
+    FogOverlayCache& operator=(FogOverlayCache &&) = delete;
+
+    /**
+        Releases all chunk textures. They are rendered again when needed.
+    */
+    void invalidateAll();
+
+    /**
+        Draws the shroud and fog of war of the tiles [x1,x2) x [y1,y2) of currentGameMap as seen by team teamID to the
+        screen. Tiles outside the map are drawn as unexplored.
+        \param  x1      the x coordinate of the left most tile to draw
+        \param  y1      the y coordinate of the top most tile to draw
+        \param  x2      the x coordinate of the tile right of the right most tile to draw
+        \param  y2      the y coordinate of the tile below the bottom most tile to draw
+        \param  teamID  the team to draw the overlay for
+    */
+    void draw(int x1, int y1, int x2, int y2, int teamID);
+
+private:
+    struct Chunk {
+        sdl2::texture_ptr texture;  ///< the rendered overlay of this chunk (nullptr if not rendered yet)
+        bool bDirty = true;         ///< does texture need to be rendered again?
+    };
+
+    enum Visibility : Uint8 {
+        Visibility_Explored = 0x01, ///< the tile is explored by the team
+        Visibility_Fogged   = 0x02, ///< the tile is covered by fog of war for the team
+        Visibility_Unknown  = 0x80  ///< the tile was not checked yet
+    };
+
+    void reset(const Map* pNewMap, int newTeamID);
+    void updateVisibility(int x1, int y1, int x2, int y2);
+    void invalidateArea(int x, int y, int width, int height);
+    bool renderChunk(Chunk& chunk, int chunkX, int chunkY);
+    void drawTiles(int x1, int y1, int x2, int y2) const;
+    void drawTile(int x, int y, int screenX, int screenY) const;
+    int getEdgeTile(int x, int y, Uint8 flag, bool bSet) const;
+
+    const Map* pMap = nullptr;      ///< the map the chunks belong to
+    int teamID = -1;                ///< the team the overlay is drawn for
+    int mapSizeX = 0;               ///< the width of pMap when the chunks were created
+    int mapSizeY = 0;               ///< the height of pMap when the chunks were created
+    int numChunksX = 0;             ///< number of chunks in x direction
+    int numChunksY = 0;             ///< number of chunks in y direction
+    int zoomlevel = -1;             ///< the zoom level the chunk textures are rendered for
+    bool bRenderTargetsFailed = false;  ///< could not render to a texture => draw all tiles directly
+    std::vector<Uint8> visibility;  ///< for every tile a combination of Visibility flags (indexed x*mapSizeY + y)
+    std::vector<Chunk> chunks;      ///< all chunks of the map
+};
+
+#endif // FOGOVERLAYCACHE_H
@@ -113,8 +113,9 @@ public:
         \param bToggleState true = toggled, false = untoggled
     */
     virtual void setToggleState(bool bToggleState) {
-        if(isToggleButton()) {
+        if(isToggleButton() && (this->bToggleState != bToggleState)) {
             this->bToggleState = bToggleState;
+            requestRedraw();
         }
     }
 
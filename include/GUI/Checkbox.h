@@ -66,6 +66,7 @@ public:
         this->textcolor = textcolor;
         this->textshadowcolor = textshadowcolor;
         invalidateTextures();
+        requestRedraw();
     }
 
     /**
@@ -27,11 +27,15 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string>
+#include <list>
+#include <unordered_map>
 
 #include "Widget.h"
 
 #define COLOR_DEFAULT COLOR_INVALID
 
+#define GUISTYLE_SURFACECACHESIZE   128     // number of rendered widget surfaces kept by GUIStyle
+
 typedef enum {
     Alignment_VCenter = 1,
     Alignment_Top = 2,
@@ -294,8 +298,34 @@ public:
     */
     virtual unsigned int getTextWidth(const std::string& text, unsigned int FontNum) = 0;
 
+    /**
+        Drops all surfaces rendered so far from the surface cache
+    */
+    void clearSurfaceCache();
+
+protected:
+    /**
+        Looks up a previously rendered surface in the surface cache.
+        \param  key     a key describing all parameters the surface was rendered from
+        \return a copy of the cached surface or nullptr if there is none
+    */
+    sdl2::surface_ptr getCachedSurface(const std::string& key);
+
+    /**
+        Stores a copy of a rendered surface in the surface cache. If the cache is full the least recently used surface is dropped.
+        \param  key         a key describing all parameters the surface was rendered from
+        \param  pSurface    the rendered surface (may be nullptr)
+        \return pSurface
+    */
+    sdl2::surface_ptr cacheSurface(const std::string& key, sdl2::surface_ptr pSurface);
+
 private:
     static std::unique_ptr<GUIStyle> currentGUIStyle;
+
+    typedef std::list<std::pair<std::string, sdl2::surface_ptr>> SurfaceCacheList;
+
+    SurfaceCacheList surfaceCacheList;                                                  ///< cached surfaces, most recently used first
+    std::unordered_map<std::string, SurfaceCacheList::iterator> surfaceCacheIndex;      ///< maps a key to its entry in surfaceCacheList
 };
 
 #endif //GUISTYLE_H
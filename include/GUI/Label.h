@@ -67,6 +67,7 @@ public:
         this->textshadowcolor = textshadowcolor;
         this->backgroundcolor = backgroundcolor;
         invalidateTextures();
+        requestRedraw();
     }
 
     /**
@@ -76,6 +77,7 @@ public:
     virtual inline void setAlignment(Alignment_Enum alignment) {
         this->alignment = alignment;
         invalidateTextures();
+        requestRedraw();
     }
 
     /**
@@ -26,6 +26,8 @@
 #include <string>
 #include <functional>
 
+#define LISTBOX_RENDERMARGIN    8   // number of entries rendered above and below the visible ones so that scrolling does not need to render them
+
 class DropDownBox;
 
 /// A class for a list box widget
@@ -421,9 +423,23 @@ protected:
 private:
     void updateList();
 
+    /**
+        Returns the number of entries that fit completely into this list box
+        \return the number of visible entries
+    */
+    int getNumVisibleElements() const;
+
     void onScrollbarChange() {
         firstVisibleElement = scrollbar.getCurrentValue();
-        updateList();
+
+        // scrolling inside the already rendered entries only moves the visible part of pForeground
+        if((pForeground != nullptr)
+            && (firstVisibleElement >= firstRenderedElement)
+            && (firstVisibleElement + getNumVisibleElements() <= firstRenderedElement + numRenderedElements)) {
+            requestRedraw();
+        } else {
+            updateList();
+        }
     }
 
     class ListEntry {
@@ -456,6 +472,8 @@ private:
     bool bAutohideScrollbar;                        ///< hide the scrollbar if not needed (default = true)
     bool bHighlightSelectedElement;                 ///< highlight selected element (default = true);
     int firstVisibleElement;                        ///< the index of the first shown element in the list
+    int firstRenderedElement;                       ///< the index of the first element rendered into pForeground
+    int numRenderedElements;                        ///< the number of entry rows rendered into pForeground
     int selectedElement;                            ///< the selected element
     Uint32 lastClickTime;                           ///< the time an element was clicked on the last time (needed for double clicking)
 };
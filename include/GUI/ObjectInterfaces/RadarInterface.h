@@ -67,8 +67,9 @@ protected:
 
         House* pOwner = pObject->getOwner();
 
-        friendlyUnitsLabel.setText(" " + _("Friend") + ": " + std::to_string(pOwner->getNumVisibleFriendlyUnits()));
-        enemyUnitsLabel.setText(" " + _("Enemy") + ": " + std::to_string(pOwner->getNumVisibleEnemyUnits()));
+        FrameArena& frameArena = currentGame->getFrameArena();
+        friendlyUnitsLabel.setText(frameArena.sprintf(" %s: %d", _("Friend").c_str(), pOwner->getNumVisibleFriendlyUnits()));
+        enemyUnitsLabel.setText(frameArena.sprintf(" %s: %d", _("Enemy").c_str(), pOwner->getNumVisibleEnemyUnits()));
 
         return DefaultStructureInterface::update();
     }
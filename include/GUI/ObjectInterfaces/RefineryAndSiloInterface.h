@@ -67,8 +67,9 @@ protected:
 
         House* pOwner = pObject->getOwner();
 
-        capacityLabel.setText(" " + _("Capacity") + ": " + std::to_string(pOwner->getCapacity()));
-        storedCreditsLabel.setText(" " + _("Stored") + ": " + std::to_string(lround(pOwner->getStoredCredits())));
+        FrameArena& frameArena = currentGame->getFrameArena();
+        capacityLabel.setText(frameArena.sprintf(" %s: %d", _("Capacity").c_str(), pOwner->getCapacity()));
+        storedCreditsLabel.setText(frameArena.sprintf(" %s: %d", _("Stored").c_str(), lround(pOwner->getStoredCredits())));
 
         return DefaultStructureInterface::update();
     }
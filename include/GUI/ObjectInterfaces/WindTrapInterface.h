@@ -67,8 +67,9 @@ protected:
 
         House* pOwner = pObject->getOwner();
 
-        requiredEnergyLabel.setText(" " + _("Required") + ": " + std::to_string(pOwner->getPowerRequirement()));
-        producedEnergyLabel.setText(" " + _("Produced") + ": " + std::to_string(pOwner->getProducedPower()));
+        FrameArena& frameArena = currentGame->getFrameArena();
+        requiredEnergyLabel.setText(frameArena.sprintf(" %s: %d", _("Required").c_str(), pOwner->getPowerRequirement()));
+        producedEnergyLabel.setText(frameArena.sprintf(" %s: %d", _("Produced").c_str(), pOwner->getProducedPower()));
 
         return DefaultStructureInterface::update();
     }
@@ -67,6 +67,7 @@ public:
             }
 
             invalidateTextures();
+            requestRedraw();
         }
     }
 
@@ -85,6 +86,7 @@ public:
     void setColor(Uint32 color = COLOR_DEFAULT) {
         this->color = color;
         invalidateTextures();
+        requestRedraw();
     }
 
     /**
@@ -212,6 +214,7 @@ public:
         this->textcolor = textcolor;
         this->textshadowcolor = textshadowcolor;
         invalidateTextures();
+        requestRedraw();
     }
 
     /**
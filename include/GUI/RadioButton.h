@@ -93,6 +93,7 @@ public:
         this->textcolor = textcolor;
         this->textshadowcolor = textshadowcolor;
         invalidateTextures();
+        requestRedraw();
     }
 
 
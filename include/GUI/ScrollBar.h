@@ -174,6 +174,7 @@ public:
         }
 
         updateSliderButton();
+        requestRedraw();
 
         if(pOnChange) {
             pOnChange();
@@ -94,6 +94,7 @@ public:
         this->textcolor = textcolor;
         this->textshadowcolor = textshadowcolor;
         invalidateTextures();
+        requestRedraw();
     }
 
     /**
@@ -221,6 +222,10 @@ public:
             if(SDL_GetTicks() - lastCarretTime >= 1000) {
                 lastCarretTime = SDL_GetTicks();
             }
+
+            // redraw when the carret blinks next
+            Uint32 carretTime = SDL_GetTicks() - lastCarretTime;
+            requestRedraw((carretTime < 500) ? (500 - carretTime) : (1000 - carretTime));
         } else {
             SDL_RenderCopy(renderer, pTextureWithoutCarret.get(), nullptr, &dest);
         }
@@ -325,6 +330,7 @@ protected:
         bool bChanged = (text != this->text);
         this->text = text;
         invalidateTextures();
+        requestRedraw();
         if(bChanged && pOnTextChange) {
             pOnTextChange(bInteractive);
         }
@@ -69,6 +69,7 @@ public:
         this->textcolor = textcolor;
         this->textshadowcolor = textshadowcolor;
         invalidateTextures();
+        requestRedraw();
     }
 
     /**
@@ -62,6 +62,7 @@ public:
         this->textshadowcolor = textshadowcolor;
         this->backgroundcolor = backgroundcolor;
         invalidateTextures();
+        requestRedraw();
     }
 
     /**
@@ -71,6 +72,7 @@ public:
     virtual void setAlignment(Alignment_Enum alignment) {
         this->alignment = alignment;
         invalidateTextures();
+        requestRedraw();
     }
 
     /**
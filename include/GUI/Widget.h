@@ -166,7 +166,10 @@ public:
         if((bEnabled == false) && (isActive() == true)) {
             setInactive();
         }
-        enabled = bEnabled;
+        if(enabled != bEnabled) {
+            enabled = bEnabled;
+            requestRedraw();
+        }
     };
 
     /**
@@ -180,7 +183,12 @@ public:
         responding to clicks and key presses.
         \return bVisible    true = visible, false = invisible
     */
-    virtual inline void setVisible(bool bVisible) { visible = bVisible; };
+    virtual inline void setVisible(bool bVisible) {
+        if(visible != bVisible) {
+            visible = bVisible;
+            requestRedraw();
+        }
+    };
 
     /**
         Returns whether this widget is visible or not.
@@ -266,6 +274,19 @@ public:
     virtual inline void resize(Uint32 width, Uint32 height) {
         size.x = width;
         size.y = height;
+        requestRedraw();
+    };
+
+    /**
+        Requests that this widget is drawn again. Widgets call this whenever their look changes and animated widgets
+        call it from draw() with the time until their next frame. The request is passed up to the top-level window,
+        which only redraws if something requested it (see Window::isRedrawRequested()).
+        \param  delay   the number of milliseconds from now after which the widget has to be drawn again
+    */
+    virtual void requestRedraw(Uint32 delay = 0) {
+        if(parent != nullptr) {
+            parent->requestRedraw(delay);
+        }
     };
 
     /**
@@ -450,6 +471,8 @@ protected:
         active = bActive;
 
         if(oldActive != bActive) {
+            requestRedraw();
+
             if(active && pOnGainFocus) {
                 pOnGainFocus();
             } else if(!active && pOnLostFocus) {
@@ -248,6 +248,36 @@ public:
     */
     virtual void setTransparentBackground(bool bTransparent);
 
+    /**
+        Requests that this window is drawn again. Child windows pass the request to their parent, a top-level window
+        remembers the earliest requested time.
+        \param  delay   the number of milliseconds from now after which the window has to be drawn again
+    */
+    void requestRedraw(Uint32 delay = 0) override;
+
+    /**
+        Checks whether a redraw of this top-level window was requested and is due now.
+        \return true if the window should be drawn, false if the last drawn frame is still up to date
+    */
+    bool isRedrawRequested() const;
+
+    /**
+        Returns the time of the earliest pending redraw request.
+        \return the time in SDL ticks; only meaningful if hasPendingRedraw() is true
+    */
+    Uint32 getRedrawTime() const { return redrawTime; };
+
+    /**
+        Checks whether there is a redraw request, even if it is not due yet.
+        \return true if there is a pending request, false otherwise
+    */
+    bool hasPendingRedraw() const { return bRedrawRequested; };
+
+    /**
+        Forgets all redraw requests. This is called right before the window is drawn.
+    */
+    void clearRedrawRequest() { bRedrawRequested = false; };
+
 protected:
 
     bool processChildWindowOpenCloses();
@@ -261,6 +291,8 @@ protected:
     bool bTransparentBackground;                        ///< true = no background is drawn
     bool bSelfGeneratedBackground;                      ///< true = background is created by this window, false = created by someone else
     sdl2::texture_unique_or_nonowning_ptr pBackground;  ///< background texture
+    bool bRedrawRequested;                              ///< Was a redraw requested since the last time this window was drawn?
+    Uint32 redrawTime;                                  ///< The earliest time a redraw was requested for (only valid if bRedrawRequested)
 };
 
 #endif //WINDOW_H
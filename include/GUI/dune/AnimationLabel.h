@@ -64,6 +64,9 @@ public:
         if(isVisible()) {
             SDL_Rect dest = calcDrawingRect(tex, position.x, position.y);
             SDL_RenderCopy(renderer, tex, nullptr, &dest);
+
+            // keep the animation running
+            requestRedraw();
         }
     };
 
@@ -22,6 +22,11 @@
 #include <GUI/PictureButton.h>
 #include <GUI/TextButton.h>
 #include <misc/SDL2pp.h>
+#include <data.h>
+
+#include <vector>
+
+class BuilderBase;
 
 #define ARROWBTN_WIDTH 48
 #define ARROWBTN_HEIGHT 16
@@ -148,6 +153,45 @@ private:
     void onOrder();
     void onCancel();
 
+    /// Everything that determines how one visible button of the list is drawn
+    struct ButtonState {
+        int             slot = 0;               ///< the position of the button in the visible part of the list
+        int             itemID = ItemID_Invalid;
+        int             price = 0;
+        int             num = 0;                ///< the number of times this item is queued
+        int             shadeWidth = 0;         ///< the width of the half transparent overlay (production progress or not available)
+        SDL_Texture*    pText = nullptr;        ///< the text drawn over the button (e.g. "ON HOLD") or nullptr
+
+        bool operator==(const ButtonState& other) const {
+            return (slot == other.slot) && (itemID == other.itemID) && (price == other.price) && (num == other.num)
+                    && (shadeWidth == other.shadeWidth) && (pText == other.pText);
+        }
+
+        bool operator!=(const ButtonState& other) const { return !(*this == other); }
+    };
+
+    /**
+        Computes the state of all visible buttons from the build list of pBuilder.
+        \param  pBuilder    the builder this list belongs to
+        \param  states      the states are stored here
+    */
+    void getButtonStates(BuilderBase* pBuilder, std::vector<ButtonState>& states);
+
+    /**
+        Draws the buttons of buttonStates to the current render target.
+        \param  position    the position of this widget on the render target
+    */
+    void drawButtons(Point position);
+
+    /**
+        Draws the area with the buttons from pButtonsTexture. The texture is only rendered again if buttonStates differs
+        from the states it was rendered for, so a builder that is not producing costs one texture copy per frame.
+        \param  areaPosition    the position of the black area behind the buttons on screen
+        \param  areaSize        the size of the black area behind the buttons
+        \return true on success, false if render targets are not available and drawButtons() has to be used instead
+    */
+    bool drawCachedButtons(Point areaPosition, Point areaSize);
+
     int currentListPos;
     PictureButton   upButton;
     PictureButton   downButton;
@@ -164,8 +208,16 @@ private:
     sdl2::texture_ptr    pOnHoldTextTexture;
     sdl2::texture_ptr    pUnitLimitReachedTextTexture;
 
+    std::vector<ButtonState> buttonStates;          ///< the states of the visible buttons in this frame
+    std::vector<ButtonState> renderedButtonStates;  ///< the states pButtonsTexture was rendered for
+    sdl2::texture_ptr    pButtonsTexture;           ///< the black area with all visible buttons
+    Point           buttonsTextureSize;
+    bool            bButtonsTextureValid = false;   ///< false if pButtonsTexture has to be rendered again
+    bool            bRenderTargetsFailed = false;   ///< could no render target be created? then the buttons are drawn directly
+
     sdl2::texture_ptr    pLastTooltip;
-    std::string     tooltipText;
+    int             tooltipItemID;              ///< the item pLastTooltip was created for
+    bool            bTooltipWaitingToPlace;     ///< was the item of pLastTooltip waiting to be placed?
     Uint32          lastMouseMovement;
     Point           lastMousePos;
 };
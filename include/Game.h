@@ -20,6 +20,14 @@
 
 #include <misc/Random.h>
 #include <misc/RobustList.h>
+#include <misc/EntityList.h>
+#include <misc/ObjectPool.h>
+#include <misc/WorkerPool.h>
+#include <misc/BackgroundFileWriter.h>
+#include <misc/FrameArena.h>
+#include <misc/PrimitiveBatcher.h>
+#include <misc/ObjectIDSet.h>
+#include <misc/AllocationCounter.h>
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
 #include <ObjectData.h>
@@ -31,6 +39,14 @@
 #include <Trigger/TriggerManager.h>
 #include <players/Player.h>
 #include <players/HumanPlayer.h>
+#include <TerrainChunkCache.h>
+#include <FogOverlayCache.h>
+#include <StrategicMapView.h>
+#include <ReplayKeyframes.h>
+#include <AutoSaveRing.h>
+#include <Profiler.h>
+#include <SimulationStats.h>
+#include <StateHashes.h>
 #include <misc/SDL2pp.h>
 
 #include <DataTypes.h>
@@ -38,20 +54,40 @@
 #include <stdarg.h>
 #include <string>
 #include <map>
+#include <memory>
 #include <utility>
+#include <vector>
 
 // forward declarations
 class ObjectBase;
 class InGameMenu;
 class MentatHelp;
 class WaitingForOtherPlayers;
+class BroadcastServer;
+class BroadcastClient;
+struct CatchUpData;
+class MetricsServer;
+class VideoEncoderPipe;
 class ObjectManager;
 class House;
 class Explosion;
+class Tile;
 
 
 #define END_WAIT_TIME               (6*1000)
 
+#define GFX_PREFETCH_TIME_PER_FRAME 2           ///< milliseconds per frame spent on generating not yet used sprites
+
+#define GAME_IDLE_FRAMETIME         100         ///< milliseconds per frame while paused or inactive (see Game::isIdle())
+#define GAME_IDLE_REDRAW_INTERVAL   250         ///< milliseconds after which an idle game is redrawn even without input
+#define GAME_INPUT_TIME_BUDGET      4           ///< milliseconds per game cycle spent on processing input events
+
+#define FRAMESKIP_BEHIND_CYCLES     2           ///< game cycles one frame may have to catch up before the next frame is skipped
+#define FRAMESKIP_MAX_CONSECUTIVE   4           ///< frames skipped at most in a row, so the screen still changes several times per second
+
+#define HEADLESS_CYCLES_PER_FRAME       1000    ///< game cycles simulated between two checks for the end of the game in headless mode
+#define HEADLESS_REPLAY_TRAILING_CYCLES 200     ///< game cycles a headless replay keeps running after its last recorded command
+
 #define GAME_NOTHING            -1
 #define GAME_RETURN_TO_MENU     0
 #define GAME_NEXTMISSION        1
@@ -61,6 +97,23 @@ class Explosion;
 #define GAME_CUSTOM_GAME_STATS  5
 
 
+/**
+    The parts of a finished game that the next game can take over instead of creating them again (see
+    Game::releaseResources()): the worker threads, the textures of the terrain chunks, the parsed object data and the
+    parsed scenario file. The next game only loads what differs for its GameInitSettings.
+*/
+struct GameResources {
+    std::unique_ptr<WorkerPool>     pWorkerPool;                    ///< the worker threads (nullptr = not created yet)
+    std::vector<sdl2::texture_ptr>  terrainChunkTextures;           ///< the textures of the terrain chunk cache
+    int                             terrainChunkZoomlevel = -1;     ///< the zoom level terrainChunkTextures are created for
+    std::unique_ptr<ObjectData>     pObjectData;                    ///< the object data as loaded from ObjectData.ini (nullptr = not loaded yet)
+    GameType                        scenarioGameType = GameType::Invalid;   ///< the game type pScenarioINIFile was loaded for
+    std::string                     scenarioFilename;               ///< the map name pScenarioINIFile was loaded for
+    std::string                     scenarioFiledata;               ///< the map data pScenarioINIFile was loaded from (custom games only)
+    std::unique_ptr<INIFile>        pScenarioINIFile;               ///< the parsed scenario file (nullptr = not loaded yet)
+};
+
+
 class Game
 {
 public:
@@ -70,6 +123,12 @@ public:
     */
     Game();
 
+    /**
+        Constructor that takes over the resources of a previous game. Call initGame() or initReplay() afterwards.
+        \param  pPreviousResources  the resources released by the previous game (see releaseResources())
+    */
+    explicit Game(std::unique_ptr<GameResources> pPreviousResources);
+
 
     Game(const Game& o) = delete;
 
@@ -84,12 +143,154 @@ public:
     */
     void initGame(const GameInitSettings& newGameInitSettings);
 
+    /**
+        Releases the resources of this game that the next game can take over (see Game(std::unique_ptr<GameResources>)).
+        This game must be destroyed afterwards without being run again.
+        \return the resources for the next game
+    */
+    std::unique_ptr<GameResources> releaseResources();
+
     /**
         Initializes a replay from the specified filename
         \param  filename    the file containing the replay
     */
     void initReplay(const std::string& filename);
 
+    /**
+        Initializes a replay from one of the keyframes recorded while playing it back before. The replay is then
+        fast forwarded to targetGameCycle.
+        \param  pKeyframes          the keyframes of the replay
+        \param  targetGameCycle     the game cycle to seek to
+        \param  replayPlayerName    the name of the local player when the replay was created
+    */
+    void initReplayFromKeyframe(const std::shared_ptr<ReplayKeyframes>& pKeyframes, Uint32 targetGameCycle, const std::string& replayPlayerName);
+
+    /**
+        Initializes a game spectated from a broadcast (see BroadcastServer). The game is simulated like a replay,
+        but only up to the game cycle the commands were received for. Waits for at most BROADCAST_CONNECT_TIMEOUT
+        milliseconds for the replay header.
+        \param  pNewBroadcastClient the client connecting to the broadcast server
+    */
+    void initSpectator(std::unique_ptr<BroadcastClient> pNewBroadcastClient);
+
+    /**
+        Seeks this replay to the specified game cycle. If there is a keyframe that is closer to the target than the
+        current game cycle this game is quit and isReplaySeekPending() returns true; the caller has to continue with a
+        new game initialized by initReplayFromKeyframe(). Otherwise the replay is just fast forwarded.
+        \param  targetGameCycle     the game cycle to seek to
+    */
+    void seekReplay(Uint32 targetGameCycle);
+
+    /**
+        Was this replay quit to continue from a keyframe (see seekReplay())?
+        \return true if a new game should be initialized with initReplayFromKeyframe()
+    */
+    bool isReplaySeekPending() const { return replaySeekTarget != INVALID_GAMECYCLE; };
+
+    /**
+        Returns the game cycle this replay should be continued at (see seekReplay()).
+        \return the target game cycle
+    */
+    Uint32 getReplaySeekTarget() const { return replaySeekTarget; };
+
+    /**
+        Returns the keyframes recorded while playing back this replay.
+        \return the keyframes (nullptr if this game is no replay)
+    */
+    const std::shared_ptr<ReplayKeyframes>& getReplayKeyframes() const { return pReplayKeyframes; };
+
+    /**
+        Switches this game into headless mode. Nothing is drawn, no input is processed and the game cycles are simulated
+        as fast as possible instead of every getGameSpeed() ms. Must be called before runMainLoop().
+        \param  maxGameCycle    the game is quit when reaching this game cycle (0 = for replays keep running until
+                                HEADLESS_REPLAY_TRAILING_CYCLES after the last recorded command, otherwise unlimited)
+        \param  bKeepReplayKeyframes    still record the keyframes of a replay (see getReplayKeyframes()), e.g. to continue it from them
+    */
+    void setHeadless(Uint32 maxGameCycle = 0, bool bKeepReplayKeyframes = false);
+
+    /**
+        Records the state hashes at every game cycle in [firstGameCycle; lastGameCycle] that is a multiple of interval.
+        The hashes of game cycle c are computed after simulating c game cycles, i.e. right before executing the commands of c.
+        \param  interval        the distance between two recorded game cycles (0 = record nothing)
+        \param  firstGameCycle  the first game cycle to record
+        \param  lastGameCycle   the last game cycle to record
+    */
+    void setStateHashTrace(Uint32 interval, Uint32 firstGameCycle = 0, Uint32 lastGameCycle = INVALID_GAMECYCLE);
+
+    /**
+        Returns the state hashes recorded since setStateHashTrace() was called.
+        \return the game cycles and their hashes in ascending order of game cycles
+    */
+    const std::vector<std::pair<Uint32, StateHashes>>& getStateHashTrace() const { return stateHashTrace; };
+
+    /**
+        Replaces the worker threads used for the parallel phases of processObjects(). Must be called before runMainLoop().
+        \param  numThreads  the number of worker threads (0 = run all phases on the main thread)
+    */
+    void setNumWorkerThreads(int numThreads);
+
+    /**
+        Switches this replay into offline rendering. Every frame advances the game by exactly 1000/framesPerSecond ms
+        of game time, is drawn into screenTexture and is passed to pVideoEncoderPipe instead of being shown. Neither
+        getGameSpeed() nor vsync pace the loop, so the video is rendered as fast as drawing and encoding allow.
+        Must be called before runMainLoop().
+        \param  pVideoEncoderPipe   the encoder the frames are written to (must outlive this game)
+        \param  framesPerSecond     the frame rate of the video
+        \param  maxGameCycle        the game is quit when reaching this game cycle (0 = keep running until
+                                    HEADLESS_REPLAY_TRAILING_CYCLES after the last recorded command)
+    */
+    void setOfflineRendering(VideoEncoderPipe* pVideoEncoderPipe, int framesPerSecond, Uint32 maxGameCycle = 0);
+
+    /**
+        Is this game running in headless mode?
+        \return true if headless, false otherwise
+    */
+    bool isHeadless() const { return bHeadless; };
+
+    /**
+        Is this game finished?
+        \return true if the game is won or lost
+    */
+    bool isFinished() const { return finished; };
+
+    /**
+        If the game is finished, was it won by the local house?
+        \return true if the game is won, false otherwise
+    */
+    bool isWon() const { return won; };
+
+    /**
+        Records that the game state does not match the state the game was recorded with (see CMD_TEST_SYNC).
+    */
+    void reportDesync();
+
+    /**
+        Returns the first game cycle the game state did not match the recorded state (see reportDesync()).
+        \return the game cycle of the first desync or INVALID_GAMECYCLE if the game is in sync
+    */
+    Uint32 getFirstDesyncGameCycle() const { return firstDesyncGameCycle; };
+
+    /**
+        Returns how often the game state did not match the recorded state (see reportDesync()).
+        \return the number of desyncs
+    */
+    Uint32 getNumDesyncs() const { return numDesyncs; };
+
+    /**
+        Compares the state hashes a player computed in gameCycle with the own ones (see CMD_TEST_STATEHASH).
+        On the first mismatch a state snapshot is written that can be compared with the one of the other peer.
+        \param  playerID        the player that sent the hashes
+        \param  gameCycle       the game cycle the hashes were computed at
+        \param  stateHashes     the hashes of that player
+    */
+    void checkStateHashes(Uint8 playerID, Uint32 gameCycle, const StateHashes& stateHashes);
+
+    /**
+        Is this game spectated from a broadcast?
+        \return true if spectated (see initSpectator()), false otherwise
+    */
+    bool isSpectator() const { return pBroadcastClient != nullptr; };
+
 
 
     friend class INIMapLoader; // loading INI Maps is done with a INIMapLoader helper object
@@ -138,7 +339,13 @@ public:
         Get the explosion list.
         \return the explosion list
     */
-    RobustList<Explosion*>& getExplosionList() { return explosionList; };
+    ObjectPool<Explosion>& getExplosionList() { return explosionList; };
+
+    /**
+        Get the cache of the pre-rendered ground.
+        \return the terrain chunk cache
+    */
+    TerrainChunkCache& getTerrainChunkCache() { return terrainChunkCache; };
 
     /**
         Returns the house with the id houseID
@@ -184,12 +391,36 @@ public:
     bool loadSaveGame(InputStream& stream);
 
     /**
-        This method saves the current running game.
+        This method saves the current running game. The game state is serialized immediately but the file is
+        compressed and written in the background; a failure is reported in the news ticker later.
         \param filename the name of the file to save to
         \return true on success, false on failure
     */
     bool saveGame(const std::string& filename);
 
+    /**
+        Blocks until all savegames passed to saveGame() are written.
+    */
+    void waitForSaveGames();
+
+    /**
+        This method saves the current running game to a stream.
+        \param stream the stream to save to
+    */
+    void saveGame(OutputStream& stream);
+
+    /**
+        Writes the replay of this game so far (local player name, init settings and all commands) to a stream.
+        \param stream the stream to save to
+    */
+    void saveReplay(OutputStream& stream) const;
+
+    /**
+        Writes the replay of this game so far as a compressed replay file with metadata (see ReplayFile).
+        \param stream the stream to save to
+    */
+    void saveReplayFile(OutputStream& stream) const;
+
     /**
         This method starts the game. Will return when the game is finished or aborted.
     */
@@ -227,7 +458,12 @@ public:
     ObjectBase* loadObject(InputStream& stream, Uint32 objectID);
 
     inline ObjectManager& getObjectManager() { return objectManager; };
+    inline WorkerPool& getWorkerPool() { return *pWorkerPool; };
     inline GameInterface& getGameInterface() { return *pInterface; };
+    inline Profiler& getProfiler() { return profiler; };
+    inline const SimulationStats& getSimulationStats() const { return simulationStats; };
+    inline FrameArena& getFrameArena() const { return frameArena; };
+    inline PrimitiveBatcher& getPrimitiveBatcher() { return primitiveBatcher; };
 
     const GameInitSettings& getGameInitSettings() const { return gameInitSettings; };
     void setNextGameInitSettings(const GameInitSettings& nextGameInitSettings) { this->nextGameInitSettings = nextGameInitSettings; };
@@ -270,19 +506,19 @@ public:
         This method selects all units/structures in the list aList.
         \param aList the list containing all the units/structures to be selected
     */
-    void selectAll(const std::set<Uint32>& aList);
+    void selectAll(const ObjectIDSet& aList);
 
     /**
         This method unselects all units/structures in the list aList.
         \param aList the list containing all the units/structures to be unselected
     */
-    void unselectAll(const std::set<Uint32>& aList);
+    void unselectAll(const ObjectIDSet& aList);
 
     /**
         Returns a list of all currently selected objects.
         \return list of currently selected units/structures
     */
-    std::set<Uint32>& getSelectedList() { return selectedList; };
+    ObjectIDSet& getSelectedList() { return selectedList; };
 
     /**
         Marks that the selection changed (and must be retransmitted to other players in multiplayer games)
@@ -296,19 +532,57 @@ public:
     };
 
 
-    void onReceiveSelectionList(const std::string& name, const std::set<Uint32>& newSelectionList, int groupListIndex);
+    void onReceiveSelectionList(const std::string& name, const ObjectIDSet& newSelectionList, int groupListIndex);
 
     /**
         Returns a list of all currently by  the other player selected objects (Only in multiplayer with multiple players per house).
         \return list of currently selected units/structures by the other player
     */
-    std::set<Uint32>& getSelectedByOtherPlayerList() { return selectedByOtherPlayerList; };
+    ObjectIDSet& getSelectedByOtherPlayerList() { return selectedByOtherPlayerList; };
 
     /**
         Called when a peer disconnects the game.
     */
     void onPeerDisconnected(const std::string& name, bool bHost, int cause);
 
+    /**
+        Called on the game host when a player connects to the running game.
+        \param  name    the name of the connecting player
+        \return a save game of the current game state or an empty string if the player is not one of the disconnected players
+    */
+    std::string getSnapshotForRejoiningPlayer(const std::string& name);
+
+    /**
+        Called on the game host when a rejoining player has loaded the snapshot.
+        \param  name    the name of the rejoining player
+        \return the current game cycle, all commands given since the snapshot of this player was taken and the current state hashes
+    */
+    CatchUpData getCatchUpCommandsForRejoiningPlayer(const std::string& name);
+
+    /**
+        Called on the rejoining player when the commands since the snapshot are received. The game is fast forwarded to
+        the game cycle of the game host and the state hashes are compared with the ones of the game host there
+        (see checkRejoinStateHashes()).
+        \param  catchUpData     the game cycle of the game host, the commands since the snapshot and the state hashes of the game host
+    */
+    void onReceiveCatchUpCommands(const CatchUpData& catchUpData);
+
+    /**
+        Compares the own state hashes with the ones the game host sent with the catch up commands once the game cycle
+        of the game host is reached. A mismatch means that loading the snapshot and fast forwarding did not give the
+        state of the game host, e.g. because some simulation state is not saved.
+    */
+    void checkRejoinStateHashes();
+
+    /**
+        Reports that the own state hashes of gameCycle differ from the ones of another peer and writes a state snapshot on the first mismatch.
+        \param  peerName        the name of the other peer
+        \param  gameCycle       the game cycle the hashes were computed at
+        \param  ownStateHashes  the own hashes
+        \param  stateHashes     the hashes of the other peer
+    */
+    void reportStateHashMismatch(const std::string& peerName, Uint32 gameCycle, const StateHashes& ownStateHashes, const StateHashes& stateHashes);
+
     /**
         Adds a new message to the news ticker.
         \param  text    the text to add
@@ -335,6 +609,14 @@ public:
     */
     bool isGamePaused() const { return bPause; };
 
+    /**
+        Returns how far the current frame lies between the last game cycle and the next one. Units are drawn at their
+        position of the previous cycle moved by this fraction towards their current position, which gives smooth
+        movement when more frames than game cycles are drawn per second. It does not affect the simulation.
+        \return the interpolation factor between 0 and 1
+    */
+    float getDrawInterpolation() const { return drawInterpolation; };
+
     /**
         This method returns wether the game is finished
         \return true, if paused, false otherwise
@@ -419,8 +701,163 @@ public:
     */
     void takeScreenshot() const;
 
+    /**
+        Checks if the next frame has to be drawn into screenTexture instead of directly into the backbuffer. This is
+        the case if effects that read back the already drawn screen (the sonic blast and the sandworm shimmer) might be
+        visible or a screenshot is requested.
+        \return true if screenTexture is needed
+    */
+    bool isScreenTextureNeeded() const;
+
+    /**
+        Saves the samples of the profiler to a csv file with a unique name
+    */
+    void saveProfile() const;
+
+    /**
+        Saves the memory used per subsystem (see getMemoryUsage()) to a text file with a unique name
+    */
+    void saveMemoryReport() const;
+
+    /// The memory used by one subsystem
+    struct MemoryUsage {
+        const char* name;       ///< the name of the subsystem
+        Uint64      bytes;      ///< the used memory in bytes
+    };
+
+    /// the heap memory of every memory tag and the estimates of the textures, surfaces, sounds and map tiles
+    typedef std::array<MemoryUsage, NUM_MEMORYTAGS + 4> MemoryUsageList;
+
+    /**
+        Returns the memory used per subsystem. The heap memory per memory tag is only accounted if PROFILING is
+        defined (see AllocationCounter), the other values are estimated from the loaded data.
+        \return the memory usage of all subsystems
+    */
+    MemoryUsageList getMemoryUsage() const;
+
+    /**
+        Starts recording a trace or, if already recording, saves the trace to a file with a unique name (see Tracing)
+    */
+    void toggleTraceRecording();
+
+    /**
+        Draws the statistics of all profiled phases (see Profiler)
+    */
+    void drawProfilerOverlay() const;
+
 private:
 
+    /**
+        Checks if the game window is minimized or hidden, so that nothing drawn would be visible.
+    */
+    static bool isWindowMinimized();
+
+    /**
+        Checks if the simulation is held because the window lost the input focus. This only happens in games without
+        other players or spectators and only if enabled in the settings (see SettingsClass::GeneralClass).
+    */
+    bool isSimulationSuspended() const;
+
+    /**
+        Checks if nothing on the screen moves on its own, so the main loop only needs to redraw after input.
+    */
+    bool isIdle() const;
+
+    /**
+        Draws the part of the map shown by the normal (not strategic) view with all units, effects and overlays.
+    */
+    void drawGameBoard();
+
+    /**
+        Draws one viewport of the game board from the tiles gathered by drawGameBoard(). The viewport is the one of
+        the current screenborder.
+        \param  bActiveViewport    true if this is the viewport the mouse is in (only this one shows the selection
+                                    rectangle, the placement preview and the action indicator)
+    */
+    void drawViewport(bool bActiveViewport);
+
+    /**
+        Returns the tiles to draw for a viewport, which are the visible tiles plus one tile margin.
+        \param  border          the screen border of the viewport
+        \param  topLeftTile     returns the top left tile to draw
+        \param  bottomRightTile returns the bottom right tile to draw (inclusive)
+    */
+    void getVisibleTiles(const ScreenBorder& border, Coord& topLeftTile, Coord& bottomRightTile) const;
+
+    /**
+        Switches between one viewport and two side by side viewports of the map. The other viewport starts at the
+        same position as the current one.
+    */
+    void toggleSplitView();
+
+    /**
+        Changes the zoom level of all viewports and keeps their centers.
+        \param  newZoomlevel    the new zoom level (0-2)
+    */
+    void setZoomlevel(int newZoomlevel);
+
+    /**
+        Checks if drawing the next frame should be skipped to give the simulation time to get back on schedule. This is
+        the case if the last frame had to catch up more than FRAMESKIP_BEHIND_CYCLES game cycles and drawing takes a
+        considerable part of a game cycle, but never for more than FRAMESKIP_MAX_CONSECUTIVE frames in a row.
+        \param  lastCatchUpCycles   the number of game cycles simulated after the last frame
+        \return true if the next frame should not be drawn
+    */
+    bool isFrameSkipNeeded(Uint32 lastCatchUpCycles) const;
+
+    /**
+        Updates all units of one type in the order they were created. UnitType is the final class of
+        the units, so the calls to update() need no virtual dispatch.
+        \param  units   the units of unitListByItemID for the item id of UnitType
+    */
+    template<class UnitType>
+    void updateUnitsOfType(const EntityList<UnitBase*>& units);
+
+    /**
+        Runs the target scans of all units and structures that will look for a new target in this cycle on the worker
+        pool. The scans only read the game state; each object consumes its result later during its own update.
+    */
+    void prefetchTargets();
+
+    /**
+        Lets all players that plan concurrently (see Player::isPlanningConcurrently()) think on the worker pool, one
+        task per house. They only read the game, which does not change until all of them are done; their orders are
+        executed afterwards in the order of the house IDs by House::update(). Each player draws from its own random
+        stream, so the orders do not depend on the number of threads.
+    */
+    void planPlayers();
+
+    /**
+        Records a keyframe of this replay for the current game cycle if one is due (see ReplayKeyframes).
+    */
+    void recordReplayKeyframe();
+
+    /**
+        Adds the current game state to the autosaves if one is due (see AutoSaveRing).
+    */
+    void recordAutoSave();
+
+    /**
+        Starts streaming the commands of this game to spectators on the broadcast port (see SettingsClass::NetworkClass).
+        The game goes on without spectators if the broadcast server cannot be created.
+    */
+    void startBroadcast();
+
+    /**
+        Returns the current metrics of this game in the text exposition format served by the MetricsServer: the game
+        cycle, the profiler statistics of the game cycle phases and of the frame, the time spent waiting for other
+        players, the round trip time of every peer, the number of objects and the resident memory of the process.
+        \return the metrics
+    */
+    std::string getMetrics();
+
+    /**
+        Called when the commands of a spectated game are received (see BroadcastClient::setOnReceiveCommands())
+        \param  availableCycle  all commands scheduled before this game cycle are received
+        \param  commands        the recorded commands
+    */
+    void onReceiveBroadcastCommands(Uint32 availableCycle, const std::string& commands);
+
     /**
         Checks whether the cursor is on the radar view
         \param  mouseX  x-coordinate of cursor
@@ -491,6 +928,15 @@ private:
     */
     bool handleSelectedObjectsActionClick(int xPos, int yPos);
 
+    /**
+        Issues the move of the given units to (xPos, yPos) as one CMD_UNIT_MOVE2POS_GROUP command instead of one command per unit.
+        If a peer does not know this command (see NetworkManager::getMinPeerProtocolVersion()) one CMD_UNIT_MOVE2POS per unit is given.
+        \param  xPos            x-coordinate in map coordinates
+        \param  yPos            y-coordinate in map coordinates
+        \param  groupParameters x, y and bForced followed by the object ids of the units to move
+    */
+    void addMove2PosCommand(int xPos, int yPos, const std::vector<Uint32>& groupParameters);
+
 
     /**
         Selects the next structure of any of the types specified in itemIDs. If none of this type is currently selected the first one is selected.
@@ -527,6 +973,7 @@ public:
     ObjectData  objectData;         ///< This contains all the unit/structure data
 
     GameState   gameState = GameState::Start;
+    bool        bSpawningInBulk = false;    ///< Set while the preplaced objects of a map are spawned; the build lists are updated once afterwards
 
 private:
     bool        chatMode = false;   ///< chat mode on?
@@ -548,12 +995,18 @@ private:
     Coord       indicatorPosition = Coord::Invalid();
 
     float       averageFrameTime = 31.25f;      ///< The weighted average of the frame time of all previous frames (smoothed fps = 1000.0f/averageFrameTime)
+    float       averageSimulationTime = 0.0f;   ///< The weighted average of the milliseconds needed for one game cycle
+    float       averageRenderTime = 0.0f;       ///< The weighted average of the milliseconds needed for drawing one frame
+    float       skippedFramesRatio = 0.0f;      ///< The weighted average of the share of frames skipped to keep up with the simulation
+    int         numConsecutiveSkippedFrames = 0;    ///< The number of frames skipped since the last drawn frame
+    bool        bRedrawRequested = true;        ///< Did any input arrive since the last frame was drawn?
 
     Uint32      gameCycleCount = 0;
 
     Uint32      skipToGameCycle = 0;            ///< skip to this game cycle
 
     bool        takePeriodicalScreenshots = false;      ///< take a screenshot every 10 seconds
+    bool        bScreenshotRequested = false;           ///< take a screenshot of the next drawn frame
 
     SDL_Rect    powerIndicatorPos = {14, 146, 4, 0};    ///< position of the power indicator in the right game bar
     SDL_Rect    spiceIndicatorPos = {20, 146, 4, 0};    ///< position of the spice indicator in the right game bar
@@ -577,8 +1030,23 @@ private:
     bool    bPause = false;                     ///< Is the game currently halted
     bool    bMenu = false;                      ///< Is there currently a menu shown (options or mentat menu)
     bool    bReplay = false;                    ///< Is this game actually a replay
+    bool    bHeadless = false;                  ///< Only simulate the game without drawing, input and waiting for the next game cycle
+    Uint32  headlessMaxGameCycle = 0;           ///< In headless mode the game is quit at this game cycle (0 = unlimited)
+    Uint32  firstDesyncGameCycle = INVALID_GAMECYCLE;   ///< The first game cycle the game state did not match the recorded state
+    Uint32  numDesyncs = 0;                     ///< How often the game state did not match the recorded state
+    bool    bBroadcastCaughtUp = false;         ///< Was a spectated game already fast forwarded to the first received available cycle
+    std::map<Uint32, StateHashes> stateHashHistory;     ///< The own state hashes of the last STATEHASH_HISTORY_LENGTH game cycles indexed by game cycle
+    Uint32  stateHashTraceInterval = 0;         ///< The state hashes are recorded every stateHashTraceInterval game cycles (0 = not recorded)
+    Uint32  stateHashTraceFirstCycle = 0;       ///< The first game cycle to record the state hashes at
+    Uint32  stateHashTraceLastCycle = INVALID_GAMECYCLE;    ///< The last game cycle to record the state hashes at
+    std::vector<std::pair<Uint32, StateHashes>> stateHashTrace; ///< The recorded state hashes (see setStateHashTrace())
+    std::map<std::string, Uint32> rejoinSnapshotCycles; ///< The game cycles the snapshots for the rejoining players were taken (only on the game host)
+    Uint32  rejoinCheckCycle = INVALID_GAMECYCLE;   ///< The game cycle to compare the state hashes with rejoinCheckStateHashes at (only on a rejoining player)
+    StateHashes rejoinCheckStateHashes;         ///< The state hashes of the game host at rejoinCheckCycle
 
     bool    bShowFPS = false;                   ///< Show the FPS
+    bool    bStrategicZoom = false;             ///< Show the whole map in the strategic view instead of the normal view
+    bool    bShowProfiler = false;              ///< Show the statistics of the profiled phases
 
     bool    bShowTime = false;                  ///< Show how long this game is running
 
@@ -593,14 +1061,62 @@ private:
     std::unique_ptr<InGameMenu>             pInGameMenu;                            ///< This is the menu that is opened by the option button
     std::unique_ptr<MentatHelp>             pInGameMentat;                          ///< This is the mentat dialog opened by the mentat button
     std::unique_ptr<WaitingForOtherPlayers> pWaitingForOtherPlayers;                ///< This is the dialog that pops up when we are waiting for other players during network hangs
+    std::unique_ptr<WorkerPool>             pWorkerPool;                            ///< The worker threads for the parallel phases of processObjects()
+    std::unique_ptr<GameResources>          pResources;                             ///< The loaded data to pass on to the next game (see releaseResources())
+    std::unique_ptr<BroadcastServer>        pBroadcastServer;                       ///< Streams the commands of this game to spectators (nullptr if not broadcast)
+    std::unique_ptr<BroadcastClient>        pBroadcastClient;                       ///< Receives the commands of this game if it is spectated (nullptr otherwise)
+    std::unique_ptr<MetricsServer>          pMetricsServer;                         ///< Serves the metrics of this game (nullptr if no metrics port is set)
+    VideoEncoderPipe*                       pVideoEncoderPipe = nullptr;            ///< Receives every drawn frame in offline rendering (nullptr otherwise)
+    int                                     videoFramesPerSecond = 0;               ///< The frame rate of offline rendering
+    std::unique_ptr<BackgroundFileWriter>   pSaveGameWriter;                        ///< Writes the savegames in the background (created on the first save)
+    std::vector<ObjectBase*>                targetScanObjects;                      ///< The objects whose target scan is run by prefetchTargets() (reused every cycle)
+    std::vector<House*>                     planningHouses;                         ///< The houses whose players are run by planPlayers() (reused every cycle)
+
+    enum DrawLayer {
+        DrawLayer_GroundDetails,
+        DrawLayer_Structures,
+        DrawLayer_UndergroundUnits,
+        DrawLayer_DeadUnits,
+        DrawLayer_Infantry,
+        DrawLayer_NonInfantryGroundUnits,
+        DrawLayer_AirUnits,
+        DrawLayer_SelectionRects,
+        NUM_DRAWLAYERS
+    };
+
+    struct DrawItem {
+        Tile*   pTile;      ///< the tile to draw
+        int     screenX;    ///< the x position of the left top corner of the tile on the screen
+        int     screenY;    ///< the y position of the left top corner of the tile on the screen
+    };
+
+    std::array<std::vector<Tile*>, NUM_DRAWLAYERS> drawTiles;                       ///< The tiles with something to draw per layer in any viewport, gathered by drawGameBoard() (reused every frame)
+    std::array<std::vector<DrawItem>, NUM_DRAWLAYERS> drawLists;                    ///< The tiles of drawTiles inside the viewport being drawn with their screen positions (reused every viewport)
+    std::unique_ptr<ScreenBorder>           pSplitScreenborder;                     ///< The viewport the mouse is not in while the split view is on (nullptr if off)
     Uint32                                  startWaitingForOtherPlayersTime = 0;    ///< The time in milliseconds when we started waiting for other players
+    Uint32                                  lastGameCycleTime = 0;                  ///< The time in milliseconds when the last game cycle was executed
+    Uint64                                  networkWaitTime = 0;                    ///< The total time in milliseconds spent waiting for the data of other players
+    float                                   drawInterpolation = 1.0f;               ///< The interpolation factor for the frame being drawn (see getDrawInterpolation())
 
     bool    bSelectionChanged = false;                  ///< Has the selected list changed (and must be retransmitted to other plays in multiplayer games)
-    std::set<Uint32> selectedList;                      ///< A set of all selected units/structures
-    std::set<Uint32> selectedByOtherPlayerList;         ///< This is only used in multiplayer games where two players control one house
-    RobustList<Explosion*> explosionList;               ///< A list containing all the explosions that must be drawn
+    ObjectIDSet selectedList;                      ///< A set of all selected units/structures
+    ObjectIDSet selectedByOtherPlayerList;         ///< This is only used in multiplayer games where two players control one house
+    ObjectPool<Explosion> explosionList;                ///< A list containing all the explosions that must be drawn
+    TerrainChunkCache terrainChunkCache;                ///< The pre-rendered ground of the map
+    FogOverlayCache fogOverlayCache;                    ///< The pre-rendered shroud and fog of war of the map
+    StrategicMapView strategicMapView;                  ///< The view of the whole map shown instead of the game board if bStrategicZoom is set
+    Profiler profiler;                                  ///< Times the phases of every game cycle and frame
+    SimulationStats simulationStats;                    ///< Counts the hot path events of every game cycle
+    mutable FrameArena frameArena;                      ///< The scratch strings of the frame being drawn (reset by drawScreen())
+    PrimitiveBatcher primitiveBatcher;                  ///< Collects the selection boxes, health bars and lines of the selection layer
+    Uint32 numFrameAllocations = 0;                     ///< The heap allocations of the last drawScreen() (see AllocationCounter)
 
     std::string localPlayerName;                            ///< the name of the local player
+
+    std::shared_ptr<ReplayKeyframes> pReplayKeyframes;      ///< the keyframes recorded while playing back this replay (shared with the games continuing this replay)
+    std::unique_ptr<AutoSaveRing> pAutoSaveRing;            ///< the autosaves of this game (nullptr if there are no autosaves)
+    Uint32 autosaveInterval = 0;                            ///< the number of game cycles between two autosaves
+    Uint32 replaySeekTarget = INVALID_GAMECYCLE;            ///< the game cycle this replay shall be continued at from a keyframe
     std::multimap<std::string, Player*> playerName2Player;  ///< mapping player names to players (one entry per player)
     std::map<Uint8, Player*> playerID2Player;               ///< mapping player ids to players (one entry per player)
 
@@ -0,0 +1,101 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GAMECONTEXT_H
+#define GAMECONTEXT_H
+
+#include <misc/EntityList.h>
+#include <misc/ObjectArena.h>
+#include <misc/ObjectPool.h>
+#include <data.h>
+
+#include <array>
+
+class Game;
+class Map;
+class ScreenBorder;
+class House;
+class HumanPlayer;
+class UnitBase;
+class StructureBase;
+class Bullet;
+
+/**
+    The state of one running game that the game objects access globally: the game itself, its map, the local house
+    and player and the lists of all units, structures and bullets. The units and structures of the game are allocated
+    from the context's ObjectArena. The globals currentGame, currentGameMap, screenborder,
+    pLocalHouse, pLocalPlayer, unitList, structureList and bulletList (see globals.h) refer to the context of the calling
+    thread. Every thread starts with the same default context, so code that only runs one game at a time needs no
+    changes. To run several games side by side each game gets its own thread and binds its own context with a
+    GameContext::Scope before creating the game; work that a game hands to other threads must bind the game's context
+    there as well.
+*/
+class GameContext final {
+public:
+    GameContext();
+    ~GameContext();
+
+    GameContext(const GameContext &) = delete;
+    GameContext(GameContext &&) = delete;
+    GameContext& operator=(const GameContext &) = delete;
+    GameContext& operator=(GameContext &&) = delete;
+
+    /**
+        Returns the context of the calling thread.
+        \return the context bound by the innermost Scope of this thread or the default context
+    */
+    static GameContext* getCurrent() { return pCurrent; }
+
+    /**
+        Binds a context to the calling thread for the lifetime of this object and restores the previous one afterwards.
+    */
+    class Scope final {
+    public:
+        explicit Scope(GameContext* pContext) : pPrevious(pCurrent) {
+            pCurrent = pContext;
+        }
+
+        ~Scope() {
+            pCurrent = pPrevious;
+        }
+
+        Scope(const Scope &) = delete;
+        Scope& operator=(const Scope &) = delete;
+
+    private:
+        GameContext* pPrevious;     ///< the context bound before this scope
+    };
+
+    ObjectArena     objectArena;            ///< the memory of all units and structures (declared first to outlive every object)
+
+    Game*           pGame = nullptr;        ///< the running game
+    ScreenBorder*   pScreenborder = nullptr;///< the screen border of the running game
+    Map*            pMap = nullptr;         ///< the map of the running game
+    House*          pLocalHouse = nullptr;  ///< the house of the human player that is playing the running game on this computer
+    HumanPlayer*    pLocalPlayer = nullptr; ///< the player that is playing the running game on this computer
+
+    EntityList<UnitBase*>       unitList;       ///< the list of all units
+    EntityList<StructureBase*>  structureList;  ///< the list of all structures
+    std::array<EntityList<UnitBase*>, Num_ItemID>       unitListByItemID;       ///< the units of unitList by item id (in the same order)
+    std::array<EntityList<StructureBase*>, Num_ItemID>  structureListByItemID;  ///< the structures of structureList by item id (in the same order)
+    ObjectPool<Bullet>          bulletList;     ///< the list of all bullets
+
+private:
+    static thread_local GameContext* pCurrent;  ///< the context of this thread
+};
+
+#endif // GAMECONTEXT_H
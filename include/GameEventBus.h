@@ -0,0 +1,150 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef GAMEEVENTBUS_H
+#define GAMEEVENTBUS_H
+
+#include <Definitions.h>
+#include <misc/SDL2pp.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define GAMEEVENTBUS_BATCHSIZE      256                     ///< the events are handed to the sink thread in batches of this size
+#define GAMEEVENTBUS_MAXBATCHES     64                      ///< batches waiting for the sink thread; further batches are dropped
+#define GAMEEVENTBUS_FLUSHINTERVAL  MILLI2CYCLES(1000)      ///< game cycles after which an incomplete batch is handed over anyway
+#define GAMEEVENTBUS_CREDITSINTERVAL MILLI2CYCLES(1000)     ///< game cycles between two GameEventType::Credits events of every house
+
+enum class GameEventType : Uint8 {
+    Built,          ///< a unit or structure was built (itemID = the built item, value = its price)
+    Killed,         ///< a unit or structure of another house was killed (itemID = the killed item, value = 1)
+    Damaged,        ///< a unit or structure of another house was damaged (itemID = the damaged item, value = the damage)
+    Harvested,      ///< spice was refined (value = the credits gained)
+    Credits         ///< the current credits of a house (value = the credits), sent every GAMEEVENTBUS_CREDITSINTERVAL game cycles
+};
+
+/// One event of the simulation seen by a GameEventSink
+struct GameEvent {
+    Uint32 gameCycle;       ///< the game cycle the event happened in
+    GameEventType type;     ///< what happened
+    Uint8 houseID;          ///< the house the event is about
+    Uint16 itemID;          ///< the unit or structure type concerned (ItemID_Invalid if none)
+    Sint32 value;           ///< the value of the event (see GameEventType)
+};
+
+/**
+    The consumer of the events of a GameEventBus. All methods are called on the sink thread of the bus.
+*/
+class GameEventSink {
+public:
+    virtual ~GameEventSink() = default;
+
+    /**
+        Consumes a batch of events.
+        \param  events  the events in the order they happened
+    */
+    virtual void write(const std::vector<GameEvent>& events) = 0;
+
+    /**
+        Called when the sink is detached; all events are written before.
+        \param  numDroppedEvents    the number of events that were dropped as the sink could not keep up
+    */
+    virtual void close(Uint64 numDroppedEvents) { }
+};
+
+/**
+    Writes the events as csv lines ("gamecycle,event,house,item,value") to a file.
+*/
+class GameEventFileSink : public GameEventSink {
+public:
+    /**
+        Constructor
+        \param  filename    the file to write to
+    */
+    explicit GameEventFileSink(const std::string& filename);
+    ~GameEventFileSink() override;
+
+    /**
+        Was the file opened successfully?
+        \return true if the file is open
+    */
+    bool isOpen() const { return fp != nullptr; }
+
+    void write(const std::vector<GameEvent>& events) override;
+    void close(Uint64 numDroppedEvents) override;
+
+private:
+    FILE* fp;   ///< the file written to
+};
+
+/**
+    Passes events of the simulation (units built, kills, damage, harvested spice and credits) to an attached GameEventSink,
+    e.g. for feeding external dashboards. The thread simulating the game appends the events to a batch that is handed
+    over through a lock-free queue (see SPSCQueue) to the sink thread, so the simulation never waits for the sink. If the
+    sink is slower than the simulation, whole batches are dropped. Without an attached sink every event costs one check
+    of isAttached().
+*/
+class GameEventBus {
+public:
+    GameEventBus() = delete;
+
+    /**
+        Attaches a sink and starts the sink thread. A previously attached sink is detached first.
+        \param  pSink   the sink to pass all events to
+    */
+    static void attach(std::unique_ptr<GameEventSink> pSink);
+
+    /**
+        Passes all remaining events to the sink, stops the sink thread and destroys the sink.
+    */
+    static void detach();
+
+    /**
+        Is there a sink attached?
+        \return true if the events are passed to a sink
+    */
+    static bool isAttached() {
+        return bAttached;
+    }
+
+    /**
+        Adds an event of the current game cycle. Shall only be called from the thread simulating the game and only if
+        isAttached() is true.
+        \param  type    the type of the event
+        \param  houseID the house the event is about
+        \param  itemID  the unit or structure type concerned
+        \param  value   the value of the event
+    */
+    static void add(GameEventType type, int houseID, int itemID, Sint32 value);
+
+    /**
+        Adds the periodic events and hands the current batch over if it is due. Called by the game after every game cycle
+        if isAttached() is true.
+        \param  gameCycle   the game cycle that just ended
+    */
+    static void endGameCycle(Uint32 gameCycle);
+
+private:
+    static void submitBatch();
+    static int sinkThreadMain(void* data);
+
+    static bool bAttached;      ///< is a sink attached
+};
+
+#endif // GAMEEVENTBUS_H
@@ -172,6 +172,7 @@ public:
     inline const std::string& getFiledata() const { return filedata; };
     inline const std::string& getServername() const { return servername; };
     inline Uint32 getRandomSeed() const { return randomSeed; };
+    inline void setRandomSeed(Uint32 randomSeed) { this->randomSeed = randomSeed; };
 
     inline bool isMultiplePlayersPerHouse() const { return multiplePlayersPerHouse; };
     inline void setMultiplePlayersPerHouse(bool multiplePlayersPerHouse) { this->multiplePlayersPerHouse = multiplePlayersPerHouse; };
@@ -88,6 +88,14 @@ public:
     */
     virtual void updateObjectInterface();
 
+    /**
+        Discards the object interface, so that updateObjectInterface() creates it again. This is needed
+        if the contents of render targets were lost (SDL_RENDER_TARGETS_RESET), e.g. the one of BuilderList.
+    */
+    void resetObjectInterface() {
+        removeOldContainer();
+    }
+
 private:
     void removeOldContainer();
 
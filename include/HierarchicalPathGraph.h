@@ -0,0 +1,102 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HIERARCHICALPATHGRAPH_H
+#define HIERARCHICALPATHGRAPH_H
+
+#include <DataTypes.h>
+
+#include <utility>
+#include <vector>
+
+class Map;
+
+/**
+    An abstraction of the map for long distance path requests. The map is divided into square clusters and
+    for every border between two neighbouring clusters the passable transitions are determined. The cheapest
+    paths between the transitions inside each cluster are cached. A coarse route is then searched on this graph
+    and only the first leg of it has to be searched on tile level by AStarSearch.
+
+    Only static obstacles (mountains and structures) are considered. The graph is updated lazily for all clusters
+    that were invalidated by placing or destroying a structure.
+*/
+class HierarchicalPathGraph {
+public:
+    explicit HierarchicalPathGraph(const Map* pMap);
+
+    HierarchicalPathGraph(const HierarchicalPathGraph &) = delete;
+    HierarchicalPathGraph(HierarchicalPathGraph &&) = delete;
+    HierarchicalPathGraph& operator=(const HierarchicalPathGraph &) = delete;
+    HierarchicalPathGraph& operator=(HierarchicalPathGraph &&) = delete;
+
+    /**
+        Discards the whole graph. It is rebuilt on the next request. Must be called whenever the map size changes.
+    */
+    void reset();
+
+    /**
+        Marks all clusters touching the specified area as outdated.
+        \param  x       the x coordinate of the top left tile of the area
+        \param  y       the y coordinate of the top left tile of the area
+        \param  width   the width of the area
+        \param  height  the height of the area
+    */
+    void invalidateArea(int x, int y, int width, int height);
+
+    /**
+        Searches a coarse route from start to destination and returns the furthest point on it that is still
+        close enough to start to be searched with AStarSearch.
+        \param  bInfantry   true if the route is for infantry (can climb mountains), false for vehicles
+        \param  start       the start tile
+        \param  destination the destination tile
+        \param  waypoint    the intermediate destination is returned here
+        \return true if a waypoint was found, false if the destination is near enough or not reachable at all
+    */
+    bool findWaypoint(bool bInfantry, const Coord& start, const Coord& destination, Coord& waypoint);
+
+private:
+    struct Cluster {
+        std::vector<Coord> entrances;               ///< all transition tiles inside this cluster
+        std::vector<std::vector<Coord>> partners;   ///< for every entrance the neighbouring tiles in other clusters
+        std::vector<int> distances;                 ///< entrances.size()^2 matrix of path costs (-1 if unreachable)
+        bool bBordersDirty = true;                  ///< have the transitions on the borders of this cluster to be recalculated?
+        bool bEdgesDirty = true;                    ///< have entrances and distances to be recalculated?
+    };
+
+    typedef std::vector<std::pair<Coord,Coord>> Border;   ///< pairs of (tile in first cluster, tile in second cluster)
+
+    struct Layer {
+        std::vector<Cluster> clusters;
+        std::vector<Border> eastBorders;            ///< border between cluster (cx,cy) and (cx+1,cy)
+        std::vector<Border> southBorders;           ///< border between cluster (cx,cy) and (cx,cy+1)
+        bool bDirty = true;                         ///< is at least one cluster outdated?
+    };
+
+    bool isPassable(int layerIndex, int x, int y) const;
+    int getClusterIndex(const Coord& coord) const;
+    void update(int layerIndex);
+    void calculateBorder(int layerIndex, const Coord& first, const Coord& second, bool bVertical, int length, Border& border) const;
+    void calculateEdges(int layerIndex, int clusterIndex);
+    void calculateClusterDistances(int layerIndex, int clusterIndex, const Coord& source, std::vector<int>& costs) const;
+
+    const Map* pMap;                ///< the map this graph belongs to
+    int numClustersX = 0;           ///< number of clusters in x direction
+    int numClustersY = 0;           ///< number of clusters in y direction
+    Layer layers[2];                ///< one layer for vehicles and one for infantry
+};
+
+#endif // HIERARCHICALPATHGRAPH_H
@@ -35,6 +35,7 @@ class UnitBase;
 class StructureBase;
 class ObjectBase;
 class HumanPlayer;
+class Carryall;
 
 class House
 {
@@ -78,6 +79,14 @@ public:
     void setProducedPower(int newPower);
     inline int getPowerRequirement() const { return powerRequirement; }
 
+    /**
+        Recounts the spice capacity, the produced power and the power requirement from the structure list and
+        logs every aggregate that differs from the incrementally maintained value. Called every game cycle if
+        DEBUG_HOUSE_AGGREGATES is defined.
+        \return true if all aggregates match the recount
+    */
+    bool checkStructureAggregates() const;
+
     inline int getBuiltValue() const { return unitBuiltValue + structureBuiltValue; }
     inline int getUnitBuiltValue() const { return unitBuiltValue; }
     inline int getMilitaryValue() const { return militaryValue; }
@@ -150,12 +159,51 @@ public:
     void returnCredits(FixPoint newCredits);
     FixPoint takeCredits(FixPoint amount);
 
+    /**
+        Queues spice that was extracted from a harvester in this game cycle. It is credited
+        together with the spice of all other refineries of this house by updateEconomy().
+        \param  refinedSpice    the amount of extracted spice
+    */
+    inline void addRefinedSpice(FixPoint refinedSpice) { pendingRefinedSpice += refinedSpice; }
+
     void printStat() const;
 
     void updateBuildLists();
 
+    /**
+        Starts the planning of the players of this house that plan concurrently (see Player::isPlanningConcurrently()).
+        Must be called on the game thread before planPlayers().
+        \return true if this house has such players, false otherwise
+    */
+    bool beginPlanning();
+
+    /**
+        Lets the players of this house that plan concurrently think. This may run on a worker thread together with the
+        planning of the other houses. The orders of these players are executed in update().
+    */
+    void planPlayers();
+
     void update();
 
+    /**
+        The economy tick of this house, called once per game cycle after all structures were updated: credits the spice
+        refined in this cycle, drains the spice that exceeds the storage capacity and plays the credits tick sound.
+    */
+    void updateEconomy();
+
+    /**
+        Queues a request for one of this house's carryalls. All requests of a game cycle are
+        served together by dispatchCarryalls() at the end of the cycle.
+        \param  pRequester  the ground unit to pick up or the refinery/repair yard whose unit shall be carried back
+    */
+    void requestCarryall(const ObjectBase* pRequester);
+
+    /**
+        Matches the carryall requests of this game cycle to the idle carryalls of this house, the closest
+        pair first. Each requester is answered, with nullptr if no carryall was left for it.
+    */
+    void dispatchCarryalls();
+
     void incrementUnits(int itemID);
     void decrementUnits(int itemID);
     void incrementStructures(int itemID);
@@ -196,6 +244,8 @@ public:
 protected:
     void decrementHarvesters();
 
+    void assignCarryall(ObjectBase* pRequester, Carryall* pCarryall);
+
     std::list<std::unique_ptr<Player> > players;        ///< List of associated players that control this house
 
     bool    ai;             ///< Is this an ai player?
@@ -211,13 +261,14 @@ protected:
     int numItemLosses [Num_ItemID]; /// Number of items lost by player
     Sint32 numItemDamageInflicted[Num_ItemID]; /// Amount of damage inflicted by a specific unit type owned by the player
 
-    int capacity;             ///< Total spice capacity
-    int producedPower;        ///< Power prodoced by this player
-    int powerRequirement;     ///< How much power does this player use?
+    int capacity;             ///< Total spice capacity; maintained by incrementStructures()/decrementStructures()
+    int producedPower;        ///< Power prodoced by this player; maintained by the wind traps on construction, health change and destruction
+    int powerRequirement;     ///< How much power does this player use? Maintained by incrementStructures()/decrementStructures()
 
     FixPoint storedCredits;   ///< current number of credits that are stored in refineries/silos
     FixPoint startingCredits; ///< number of starting credits this player still has
     int oldCredits;           ///< amount of credits in the last game cycle (used for playing the credits tick sound)
+    FixPoint pendingRefinedSpice; ///< spice refined in this game cycle; credited by updateEconomy()
 
     int maxUnits;             ///< maximum number of units this house is allowed to build
     int quota;                ///< number of credits to win
@@ -226,6 +277,8 @@ protected:
 
     std::vector<AITeamInfo> aiteams;    ///< the ai teams that were loaded from the map
 
+    std::vector<Uint32> carryallRequests;   ///< object ids of the objects that requested a carryall in this cycle; emptied by dispatchCarryalls()
+
     int powerUsageTimer;      ///< every N ticks you have to pay for your power usage
 
     bool bHadContactWithEnemy;      ///< did this house already have contact with an enemy (= tiles with enemy units were explored by this house or allied houses)
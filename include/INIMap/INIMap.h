@@ -41,22 +41,39 @@ public:
 
     }
 
-    INIMap(GameType gameType, const std::string& mapname, const std::string& mapdata = "") : mapname(mapname) {
+    INIMap(inifile_ptr pINIFile, const std::string& mapname)
+     : mapname(mapname), inifile(std::move(pINIFile)) {
 
+    }
+
+    INIMap(GameType gameType, const std::string& mapname, const std::string& mapdata = "")
+     : mapname(mapname), inifile(loadINIFile(gameType, mapname, mapdata)) {
+
+    }
+
+    ~INIMap() = default;
+
+    /**
+        Parses the scenario file of a map.
+        \param  gameType    the type of the game (campaign and skirmish maps are loaded from the PAK-Files, custom maps from mapdata)
+        \param  mapname     the name of the map
+        \param  mapdata     the content of the scenario file for custom games
+        \return the parsed scenario file
+    */
+    static std::unique_ptr<INIFile> loadINIFile(GameType gameType, const std::string& mapname, const std::string& mapdata = "") {
         if(gameType == GameType::Campaign || gameType == GameType::Skirmish) {
             // load from PAK-File
-            inifile = std::make_unique<INIFile>(pFileManager->openFile(this->mapname).get());
+            return std::make_unique<INIFile>(pFileManager->openFile(mapname).get());
         } else if(gameType == GameType::CustomGame || gameType == GameType::CustomMultiplayer) {
             SDL_RWops* RWops = SDL_RWFromConstMem(mapdata.c_str(), mapdata.size());
-            inifile = std::make_unique<INIFile>(RWops);
+            auto pINIFile = std::make_unique<INIFile>(RWops);
             SDL_RWclose(RWops);
+            return pINIFile;
         } else {
-            inifile = std::make_unique<INIFile>(mapname);
+            return std::make_unique<INIFile>(mapname);
         }
     }
 
-    ~INIMap() = default;
-
 protected:
 
     /**
@@ -36,6 +36,14 @@ class House;
 class INIMapLoader : public INIMap {
 public:
     INIMapLoader(Game* pGame, const std::string& mapname, const std::string& mapdata = "");
+
+    /**
+        Loads the map from an already parsed scenario file.
+        \param  pGame       the game to load the map into
+        \param  pINIFile    the parsed scenario file (only used while loading, not owned)
+        \param  mapname     the name of the map (used for warnings and errors)
+    */
+    INIMapLoader(Game* pGame, INIFile* pINIFile, const std::string& mapname);
     ~INIMapLoader();
 
 private:
@@ -0,0 +1,71 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INIMAPPRELOADER_H
+#define INIMAPPRELOADER_H
+
+#include <DataTypes.h>
+#include <FileClasses/INIFile.h>
+#include <misc/SDL2pp.h>
+
+#include <exception>
+#include <memory>
+#include <string>
+
+/**
+    Parses the scenario file of a map on a background thread (see INIMap::loadINIFile()), so that the scenario of the
+    next mission is parsed while the player reads the briefing. Only the parsing is done in the background: building
+    the map and its objects (see INIMapLoader) needs the game context and the renderer of the game thread.
+*/
+class INIMapPreloader final {
+public:
+    /**
+        Starts parsing the scenario file of a map.
+        \param  gameType    the type of the game (see INIMap::loadINIFile())
+        \param  mapname     the name of the map
+        \param  mapdata     the content of the scenario file for custom games
+    */
+    INIMapPreloader(GameType gameType, const std::string& mapname, const std::string& mapdata = "");
+
+    INIMapPreloader(const INIMapPreloader &) = delete;
+    INIMapPreloader(INIMapPreloader &&) = delete;
+    INIMapPreloader& operator=(const INIMapPreloader &) = delete;
+    INIMapPreloader& operator=(INIMapPreloader &&) = delete;
+
+    /// Destructor. Waits for the background thread to finish.
+    ~INIMapPreloader();
+
+    /**
+        Waits until the scenario file is parsed and returns it. An exception thrown while parsing is rethrown here.
+        \return the parsed scenario file
+    */
+    std::unique_ptr<INIFile> getINIFile();
+
+private:
+    static int preloaderThreadMain(void* data);
+    void wait();
+
+    GameType gameType;                      ///< the type of the game
+    std::string mapname;                    ///< the name of the map
+    std::string mapdata;                    ///< the content of the scenario file for custom games
+
+    SDL_Thread* pThread = nullptr;          ///< the thread parsing the scenario file (nullptr once joined)
+    std::unique_ptr<INIFile> pINIFile;      ///< the parsed scenario file
+    std::exception_ptr pException;          ///< the exception thrown while parsing
+};
+
+#endif // INIMAPPRELOADER_H
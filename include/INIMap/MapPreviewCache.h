@@ -0,0 +1,91 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPPREVIEWCACHE_H
+#define MAPPREVIEWCACHE_H
+
+#include <FileClasses/INIFile.h>
+#include <misc/SDL2pp.h>
+
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_mutex.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+
+/// the directory inside the configuration directory the previews are stored in
+#define MAPPREVIEWCACHE_DIRECTORY   "mappreview-cache"
+
+/// Everything the map choosers show about a map
+struct MapPreview {
+    int sizeX = 0;                  ///< the width of the map
+    int sizeY = 0;                  ///< the height of the map
+    int numPlayers = 0;             ///< the number of player/house sections
+    std::string author;             ///< the author of the map ("-" if unknown)
+    std::string license;            ///< the license of the map ("-" if unknown)
+    sdl2::surface_ptr pMinimap;     ///< the minimap or nullptr if the map could not be read
+};
+
+/// A persistent cache of the map previews shown in the map choosers.
+/**
+    Parsing a map and rendering its minimap takes long enough to make scrolling through a big map pool sluggish.
+    This class does it on a background thread instead and stores the results in MAPPREVIEWCACHE_DIRECTORY. They are
+    keyed by the md5 of the map file; the md5 itself is remembered together with the size and the modification date
+    of the file, so unchanged maps are not even read again.
+*/
+class MapPreviewCache {
+public:
+    MapPreviewCache();
+    ~MapPreviewCache();
+
+    MapPreviewCache(const MapPreviewCache &) = delete;
+    MapPreviewCache(MapPreviewCache &&) = delete;
+    MapPreviewCache& operator=(const MapPreviewCache &) = delete;
+    MapPreviewCache& operator=(MapPreviewCache &&) = delete;
+
+    void setDirectory(const std::string& directory);
+
+    const MapPreview* getPreview(const std::string& mapFilepath);
+
+private:
+    /// A map the background thread has to create the preview for
+    struct Job {
+        std::string filepath;       ///< the map file
+        std::string fileSize;       ///< the size of the file as listed in the directory
+        std::string modifyDate;     ///< the modification date of the file as listed in the directory
+    };
+
+    static int workerMain(void* data);
+    void processJobs();
+    std::unique_ptr<MapPreview> createPreview(const Job& job);
+    static std::unique_ptr<MapPreview> readPreview(INIFile& inimap);
+
+    std::string cacheDirectory;                                     ///< where the index and the minimaps are stored
+    INIFile index;                                                  ///< the hashes and the properties of all maps seen so far (only used by the background thread)
+    bool bIndexChanged;                                             ///< save the index when done?
+
+    SDL_Thread* pWorkerThread;                                      ///< creates the previews (nullptr if it could not be started)
+    SDL_mutex* mutex;                                               ///< protects jobs, previews and bQuit
+    SDL_cond* jobAvailableCond;                                     ///< signaled when jobs are added
+    std::deque<Job> jobs;                                           ///< the maps still to do; the first one is done next
+    std::map<std::string, std::unique_ptr<MapPreview>> previews;    ///< the finished previews by file path
+    bool bQuit;                                                     ///< tells the background thread to stop
+};
+
+#endif // MAPPREVIEWCACHE_H
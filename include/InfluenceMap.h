@@ -0,0 +1,104 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFLUENCEMAP_H
+#define INFLUENCEMAP_H
+
+#include <DataTypes.h>
+#include <fixmath/FixPoint.h>
+
+#include <vector>
+
+class Map;
+
+/**
+    Per-house summaries of the structures on the map that AI players can read instead of scanning all structures for
+    every decision: the centre of all structures (except walls and turrets), the totals of all structures and their
+    locations for queries like the distance to the nearest enemy structure.
+
+    Structures do not move, so the summaries are only rebuilt when a structure is added to or removed from the
+    structure list and always match a scan over the current list. They only depend on the game state and are thus
+    deterministic and need not be saved.
+*/
+class InfluenceMap {
+public:
+    explicit InfluenceMap(const Map* pMap);
+
+    InfluenceMap(const InfluenceMap &) = delete;
+    InfluenceMap(InfluenceMap &&) = delete;
+    InfluenceMap& operator=(const InfluenceMap &) = delete;
+    InfluenceMap& operator=(InfluenceMap &&) = delete;
+
+    /**
+        Drops all summaries, so they are rebuilt from the structure list on the next query.
+    */
+    void reset();
+
+    /**
+        Returns the average location of all structures of house houseID except walls and turrets.
+        \param  houseID     the house to look at
+        \return the centre of the base or Coord::Invalid() if the house has no such structures
+    */
+    Coord getBaseCentre(int houseID) const;
+
+    /// The number of structures of a house and the sums of their coordinates
+    struct StructureTotals {
+        int numStructures = 0;      ///< the number of structures
+        int totalX = 0;             ///< the sum of the x coordinates of all structures
+        int totalY = 0;             ///< the sum of the y coordinates of all structures
+    };
+
+    /**
+        Returns the number of all structures (including walls and turrets) of house houseID and the sums of their locations.
+        \param  houseID     the house to look at
+        \return the totals of the structures of this house
+    */
+    StructureTotals getStructureTotals(int houseID) const;
+
+    /**
+        Returns the distance (see blockDistance()) from location to the nearest structure of a house not in team teamID.
+        \param  teamID      the team of the asking house
+        \param  location    the tile to measure from
+        \param  maxDistance the distance to return if no enemy structure is nearer
+        \return the distance to the nearest enemy structure or maxDistance
+    */
+    FixPoint getDistanceToNearestEnemyStructure(int teamID, const Coord& location, FixPoint maxDistance) const;
+
+    /**
+        Rebuilds the summaries if the structure list changed since the last update. The queries call this themselves;
+        calling it before the summaries are queried from several threads makes these queries read-only.
+    */
+    void updateStructures() const;
+
+private:
+    const Map* pMap;                                            ///< the map this influence map belongs to
+
+    struct BaseCentre {
+        int numStructures = 0;      ///< the number of structures
+        int totalX = 0;             ///< the sum of the x coordinates of all structures
+        int totalY = 0;             ///< the sum of the y coordinates of all structures
+    };
+    mutable BaseCentre baseCentres[NUM_HOUSES];                 ///< the base centre of each house
+
+    mutable StructureTotals structureTotals[NUM_HOUSES];        ///< the totals of all structures of each house
+    mutable std::vector<Coord> structureLocations[NUM_HOUSES];  ///< the locations of all structures of each house
+    mutable int houseTeams[NUM_HOUSES];                         ///< the team of each house with structures
+    mutable Uint32 lastStructureListVersion = 0;                ///< the version of the structure list at the last updateStructures()
+    mutable bool bStructuresValid = false;                      ///< was updateStructures() called since the last reset()?
+};
+
+#endif // INFLUENCEMAP_H
@@ -19,12 +19,34 @@
 #define MAP_H
 
 #include <Tile.h>
+#include <AStarSearch.h>
+#include <HierarchicalPathGraph.h>
+#include <InfluenceMap.h>
+#include <ConnectivityMap.h>
+#include <FlowFieldCache.h>
+#include <PathCache.h>
+#include <PathRequestQueue.h>
+#include <SpatialObjectIndex.h>
+#include <SandwormPreyIndex.h>
+#include <PlacementTables.h>
+#include <SpiceIndex.h>
+#include <TargetChangeGrid.h>
+#include <TileLayout.h>
+#include <TilePlanes.h>
+#include <VisibilityGrid.h>
+#include <misc/DrawBuckets.h>
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
 #include <misc/exceptions.h>
 #include <misc/Random.h>
 
 #include <cstdio>
+#include <deque>
+#include <unordered_map>
+
+// forward declarations
+class Bullet;
+class Explosion;
 
 class Map
 {
@@ -44,7 +66,34 @@ public:
     void save(OutputStream& stream) const;
 
     void createSandRegions();
+
+    /**
+        Updates all tiles that registered for updates (only tiles with dead units on them have something to update).
+    */
+    void updateTiles();
+
+    /**
+        Adds pTile to the tiles updated by updateTiles(). Called by Tile itself.
+        \param pTile   the tile to update every cycle
+    */
+    void addActiveTile(Tile* pTile) {
+        activeTiles.push_back(pTile);
+    }
     void damage(Uint32 damagerID, House* damagerOwner, const Coord& realPos, Uint32 bulletID, FixPoint damage, int damageRadius, bool air);
+
+    /**
+        Damages at from and then at to, i.e. the same as two damage() calls, but the candidates along the line between
+        both points are collected only once. Used by the sonic wave which damages twice per cycle along its path.
+        \param damagerID       the object causing the damage
+        \param damagerOwner    the house owning the damager
+        \param from            the first impact position (in world coordinates)
+        \param to              the second impact position (in world coordinates)
+        \param bulletID        the type of bullet
+        \param damage          the damage of each impact
+        \param damageRadius    the damage radius of each impact (must not exceed TILESIZE)
+        \param air             damage air units instead of ground objects?
+    */
+    void damageLine(Uint32 damagerID, House* damagerOwner, const Coord& from, const Coord& to, Uint32 bulletID, FixPoint damage, int damageRadius, bool air);
     static Coord getMapPos(int angle, const Coord& source);
     void removeObjectFromMap(Uint32 objectID);
     void spiceRemoved(const Coord& coord);
@@ -55,6 +104,29 @@ public:
         viewMap(houseID, Coord(x, y), maxViewRange);
     }
 
+    /**
+        Makes pObject a permanent vision source at location (with its current owner and view range). Tiles in range stay
+        unfogged until the source moves away or the object is removed from the map (see removeObjectFromMap()).
+        \param  pObject     the unit or structure
+        \param  location    the tile the object is on (the top left tile for structures)
+    */
+    void updateVisionSource(const ObjectBase* pObject, const Coord& location);
+
+    /**
+        Recreates the vision sources of all objects on the map. Vision sources are not saved, so this has to be called
+        after the objects of a savegame are loaded.
+    */
+    void restoreVisionSources();
+
+    /**
+        Informs the houses that just got sight of pObject. pObject moved from oldLocation to its current location. Each
+        house of another team that sees the new location but not the old one gets its units and turrets within
+        TARGETSCAN_SIGHTING_RANGE to look for targets again (see ObjectBase::restartTargetScan()).
+        \param  pObject     the unit that moved
+        \param  oldLocation the location pObject moved away from
+    */
+    void restartTargetScans(const ObjectBase* pObject, const Coord& oldLocation);
+
     bool findSpice(Coord& destination, const Coord& origin) const;
     bool okayToPlaceStructure(int x, int y, int buildingSizeX, int buildingSizeY, bool tilesRequired, const House* pHouse, bool bIgnoreUnits = false) const;
     bool isAStructureGap(int x, int y, int buildingSizeX, int buildingSizeY) const; // Allows AI to check to see if a gap exists between the current structure
@@ -65,6 +137,206 @@ public:
 
     void createSpiceField(Coord location, int radius, bool centerIsThickSpice = false) const;
 
+    /**
+        Returns the pool of reusable path search workspaces for this map.
+    */
+    AStarWorkspacePool& getPathWorkspacePool() noexcept {
+        return pathWorkspacePool;
+    }
+
+    /**
+        Returns the hierarchical abstraction of this map used for long distance path requests.
+    */
+    HierarchicalPathGraph& getHierarchicalPathGraph() noexcept {
+        return pathGraph;
+    }
+
+    /**
+        Returns the labels of the regions of this map that are connected for ground units.
+    */
+    ConnectivityMap& getConnectivityMap() noexcept {
+        return connectivity;
+    }
+
+    /**
+        Returns the cache of flow fields shared by units moving to the same destination.
+    */
+    FlowFieldCache& getFlowFieldCache() noexcept {
+        return flowFields;
+    }
+
+    /**
+        Returns the cache of recently found paths shared by units starting at the same location.
+    */
+    PathCache& getPathCache() noexcept {
+        return pathCache;
+    }
+
+    /**
+        Returns the queue all path requests of units are collected in.
+    */
+    PathRequestQueue& getPathRequestQueue() noexcept {
+        return pathRequests;
+    }
+
+    /**
+        Returns the per-house structure summaries AI players can read instead of scanning all structures.
+    */
+    const InfluenceMap& getInfluenceMap() const noexcept {
+        return influenceMap;
+    }
+
+    InfluenceMap& getInfluenceMap() noexcept {
+        return influenceMap;
+    }
+
+    /**
+        Returns the summed-area tables used for answering structure placement queries.
+    */
+    const PlacementTables& getPlacementTables() const noexcept {
+        return placementTables;
+    }
+
+    /**
+        Brings the lazily updated caches the AI players query (PlacementTables and InfluenceMap) up to date,
+        so that they can be read from several threads until the map or the structure list changes.
+    */
+    void updateCaches() const {
+        placementTables.update();
+        influenceMap.updateStructures();
+    }
+
+    /**
+        Returns the per-chunk summary of the spice on this map.
+    */
+    const SpiceIndex& getSpiceIndex() const noexcept {
+        return spiceIndex;
+    }
+
+    SpiceIndex& getSpiceIndex() noexcept {
+        return spiceIndex;
+    }
+
+    /**
+        Returns the grid of all ground and underground objects used for finding targets.
+    */
+    const SpatialObjectIndex& getSpatialObjectIndex() const noexcept {
+        return objectIndex;
+    }
+
+    SpatialObjectIndex& getSpatialObjectIndex() noexcept {
+        return objectIndex;
+    }
+
+    /**
+        Returns the buckets of all bullets used for drawing only the bullets near the screen.
+    */
+    DrawBuckets<Bullet>& getBulletDrawBuckets() noexcept {
+        return bulletDrawBuckets;
+    }
+
+    /**
+        Returns the buckets of all explosions used for drawing only the explosions near the screen.
+    */
+    DrawBuckets<Explosion>& getExplosionDrawBuckets() noexcept {
+        return explosionDrawBuckets;
+    }
+
+    /**
+        Called by Tile whenever an object is assigned to or unassigned from a tile. It invalidates the damage candidates
+        cached by damage() and the empty target scans around the tile (see noteTargetsChanged()).
+        \param  location    the location of the tile
+    */
+    void noteTileObjectsChanged(const Coord& location) {
+        tileObjectsGeneration++;
+        noteTargetsChanged(location);
+    }
+
+    /**
+        Records that a new target may have appeared within range around location in the current game cycle, e.g. because
+        the tiles there were revealed or an object there changed its owner. Target scans that found nothing earlier in
+        this cycle are run again (see ObjectBase::getScannedTarget()).
+        \param  location    the center of the changed area
+        \param  range       the distance of the changed tiles to location (in tiles)
+    */
+    void noteTargetsChanged(const Coord& location, int range = 0);
+
+    /**
+        Returns the game cycles in which new targets may have appeared in the parts of the map.
+    */
+    const TargetChangeGrid& getTargetChangeGrid() const noexcept {
+        return targetChanges;
+    }
+
+    /**
+        Returns the ground units on sand grouped by sand region, used by sandworms for finding prey.
+    */
+    const SandwormPreyIndex& getSandwormPreyIndex() const noexcept {
+        return sandwormPreyIndex;
+    }
+
+    /**
+        Lists pUnit in the sandworm prey index under the sand region of its current location (or removes it if it is
+        not on sand). Has to be called whenever the location of a ground unit changes.
+        \param  pUnit   the unit that changed its location
+    */
+    void updateSandwormPrey(const UnitBase* pUnit);
+
+    /**
+        Removes pUnit from the sandworm prey index.
+        \param  pUnit   the unit that is destroyed
+    */
+    void removeSandwormPrey(const UnitBase* pUnit);
+
+    /**
+        Rebuilds the sandworm prey index from all units. Has to be called after the sand regions were created and after
+        the objects of a savegame are loaded.
+    */
+    void restoreSandwormPrey();
+
+    /**
+        Returns the packed per-tile state of this map. Map scans that only need e.g. the terrain type or the exploration
+        state should read these planes directly instead of going through every Tile.
+    */
+    const TilePlanes& getTilePlanes() const noexcept {
+        return tilePlanes;
+    }
+
+    /**
+        Calls fn(x, y) for every tile whose radar color may have changed since the last call (see TilePlanes::takeRadarDirtyTiles()).
+        \param  cycle   the current game cycle
+        \param  fn      the function to call for every changed tile
+    */
+    template<typename Function>
+    void takeRadarDirtyTiles(Uint32 cycle, Function&& fn) {
+        tilePlanes.takeRadarDirtyTiles(cycle, [this, &fn](int index) {
+            const Coord location = layout.getCoord(index);
+            fn(location.x, location.y);
+        });
+    }
+
+    /**
+        Returns the index of the tile at (xPos,yPos) in the planes returned by getTilePlanes().
+    */
+    int getTileIndex(int xPos, int yPos) const noexcept {
+        return tile_index(xPos, yPos);
+    }
+
+    /**
+        Has to be called whenever a static obstacle (e.g. a structure) is placed or removed.
+        \param  x       the x coordinate of the top left tile of the changed area
+        \param  y       the y coordinate of the top left tile of the changed area
+        \param  width   the width of the changed area
+        \param  height  the height of the changed area
+    */
+    void invalidatePathCaches(int x, int y, int width, int height) {
+        pathGraph.invalidateArea(x, y, width, height);
+        connectivity.updateArea(x, y, width, height);
+        flowFields.invalidate();
+        pathCache.invalidate();
+        placementTables.invalidateStructures();
+    }
+
     Sint32 getSizeX() const noexcept {
         return sizeX;
     }
@@ -107,16 +379,20 @@ public:
         return getTile(location.x, location.y);
     }
 
+    /**
+        Calls f for every tile of the map. The tiles are visited column by column (x-major) independent of the
+        storage layout, so the order stays the same for savegames and the simulation.
+    */
     template<typename F>
     void for_all(F&& f)
     {
-        std::for_each(std::begin(tiles), std::end(tiles), f);
+        for_each(0, 0, sizeX, sizeY, f);
     }
 
     template<typename F>
     void for_all(F&& f) const
     {
-        std::for_each(std::begin(tiles), std::end(tiles), f);
+        for_each(0, 0, sizeX, sizeY, f);
     }
 
     template<typename F>
@@ -178,14 +454,47 @@ public:
 private:
     Sint32  sizeX;                          ///< number of tiles this map is wide (read only)
     Sint32  sizeY;                          ///< number of tiles this map is high (read only)
-    std::vector<Tile> tiles;                ///< the 2d-array containing all the tiles of the map
+    TileLayout layout;                      ///< the order of the tiles in tiles and tilePlanes
+    std::vector<Tile> tiles;                ///< the 2d-array containing all the tiles of the map (see layout)
+    std::vector<Tile*> activeTiles;         ///< the tiles that need to be updated every cycle
     ObjectBase* lastSinglySelectedObject;   ///< The last selected object. If selected again all units of the same type are selected
+    AStarWorkspacePool pathWorkspacePool;   ///< reusable scratch memory for AStarSearch
+    HierarchicalPathGraph pathGraph;        ///< coarse graph for long distance path requests
+    ConnectivityMap connectivity;           ///< connected regions for rejecting unreachable destinations
+    FlowFieldCache flowFields;              ///< flow fields for group movement
+    PathCache pathCache;                    ///< recently found paths
+    PathRequestQueue pathRequests;          ///< path requests waiting to be serviced
+    SpatialObjectIndex objectIndex;         ///< grid of all ground and underground objects
+    TargetChangeGrid targetChanges;         ///< the game cycles in which new targets may have appeared in each part of the map
+    DrawBuckets<Bullet> bulletDrawBuckets;          ///< grid of all bullets for drawing
+    DrawBuckets<Explosion> explosionDrawBuckets;    ///< grid of all explosions for drawing
+    SandwormPreyIndex sandwormPreyIndex;    ///< ground units on sand per sand region
+    SpiceIndex spiceIndex;                  ///< spice totals per chunk of the map
+    PlacementTables placementTables;        ///< area counts for structure placement queries
+    InfluenceMap influenceMap;              ///< summaries of the structures of each house
+    TilePlanes tilePlanes;                  ///< packed per-tile state the tiles forward to
+    VisibilityGrid visibility;              ///< reference counted vision of all units and structures
+
+    struct DamageCandidates {
+        std::vector<Uint32> airUnits;                   ///< air units near the impact
+        std::vector<Uint32> groundAndUndergroundUnits;  ///< ground objects and underground units near the impact
+    };
+    std::deque<DamageCandidates> damageCandidates;  ///< reusable buffers for damage(), one per nesting level
+    int damageDepth = 0;                            ///< number of damage() calls currently running
+
+    std::vector<bool> lineTileVisited;              ///< tiles of the bounding box of the line already collected by damageLine()
+
+    std::unordered_map<Uint64, DamageCandidates> impactCandidateCache;  ///< sorted damage candidates per impact tile, shared by all impacts on that tile
+    Uint32 tileObjectsGeneration = 0;           ///< incremented on every change of the objects assigned to any tile
+    Uint32 impactCandidateCacheGeneration = 0;  ///< the tileObjectsGeneration impactCandidateCache was built for
+
+    void applyDamage(const DamageCandidates& candidates, Uint32 damagerID, House* damagerOwner, const Coord& realPos, Uint32 bulletID, FixPoint damage, int damageRadius, bool air);
 
     void init_tile_location();
 
     int tile_index(int xPos, int yPos) const noexcept
     {
-        return xPos * sizeY + yPos;
+        return layout.getIndex(xPos, yPos);
     }
 
     Tile* getTile_internal(int xPos, int yPos) noexcept {
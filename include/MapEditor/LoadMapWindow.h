@@ -27,6 +27,7 @@
 #include <GUI/TextButton.h>
 #include <GUI/ListBox.h>
 #include <GUI/PictureLabel.h>
+#include <INIMap/MapPreviewCache.h>
 #include <misc/SDL2pp.h>
 
 class  LoadMapWindow : public Window
@@ -41,6 +42,12 @@ public:
 
     bool handleKeyPress(SDL_KeyboardEvent& key) override;
 
+    /**
+        Draws this window to screen. A pending map preview is shown as soon as it is ready.
+        \param  position    Position to draw the window to. The position of the window is added to this.
+    */
+    void draw(Point position) override;
+
     /**
         This method is called, when the child window is about to be closed.
         This child window will be closed after this method returns.
@@ -66,6 +73,7 @@ private:
     void onLoad();
     void onMapTypeChange(int buttonID);
     void onMapListSelectionChange(bool bInteractive);
+    void showMapPreview();
 
     HBox    mainHBox;
     VBox    mainVBox;
@@ -101,6 +109,8 @@ private:
     std::string loadMapname;
     bool        loadMapSingleplayer;
     std::string currentMapDirectory;
+    MapPreviewCache mapPreviewCache;
+    std::string pendingPreviewFilename;     ///< the map whose preview is still being created (empty if none)
 };
 
 
@@ -38,6 +38,11 @@
 #include <string>
 #include <vector>
 #include <stack>
+#include <deque>
+#include <unordered_map>
+
+#define MAPEDITOR_UNDO_MEMORY_LIMIT (16*1024*1024)  ///< the undo history drops its oldest operations when it gets bigger than this (in bytes)
+#define MAPEDITOR_LOADEDMAPCACHE_SIZE (8)           ///< the number of loaded maps kept in memory to reopen them without parsing
 
 class MapMirror;
 
@@ -151,6 +156,36 @@ public:
 
     bool hasChangeSinceLastSave() const { return bChangedSinceLastSave; };
 
+    /**
+        Returns a counter that is increased on every change of the map (edits, undo, redo, new or loaded map).
+    */
+    Uint32 getEditCount() const { return editCount; };
+
+    /**
+        Informs the editor that the terrain, the map items or the units/structures on the given tiles have changed.
+        The cached terrain sprites of these tiles and their neighbours are recalculated on the next draw and
+        the tiles are added to the changed area reported by takeChangedTiles().
+        \param  x       the x coordinate of the first changed tile
+        \param  y       the y coordinate of the first changed tile
+        \param  width   the number of changed tiles in x direction
+        \param  height  the number of changed tiles in y direction
+    */
+    void markTilesChanged(int x, int y, int width = 1, int height = 1);
+
+    /**
+        Informs the editor that the whole map has changed (e.g. a new map was loaded).
+    */
+    void markAllTilesChanged();
+
+    /**
+        Returns the bounding box of all tiles changed since the last call and resets it. Used by the radar view
+        to only recalculate the changed part of the minimap.
+        \param  topLeft     the top left changed tile
+        \param  bottomRight the bottom right changed tile
+        \return true if any tile changed, false otherwise
+    */
+    bool takeChangedTiles(Coord& topLeft, Coord& bottomRight);
+
     std::string generateMapname() const;
 
     std::vector<Player>& getPlayers() {
@@ -258,8 +293,9 @@ public:
     void startOperation();
 
     void addUndoOperation(std::unique_ptr<MapEditorOperation> op) {
-        undoOperationStack.push(std::move(op));
+        pushUndoOperation(std::move(op));
         bChangedSinceLastSave = true;
+        editCount++;
     }
 
     void undoLastOperation();
@@ -280,13 +316,57 @@ private:
 
     void performTerrainChange(int x, int y, TERRAINTYPE terrainType);
 
+    /**
+        Adds the terrain changes of the current brush stroke as one MapEditorTerrainStrokeOperation to the undo history.
+    */
+    void finishTerrainStroke();
+
+    void pushUndoOperation(std::unique_ptr<MapEditorOperation> op);
+    std::unique_ptr<MapEditorOperation> popUndoOperation();
+    void clearUndoHistory();
+
+    /**
+        Drops the oldest operations (always a whole group up to the next MapEditorStartOperation) until the undo
+        history is smaller than MAPEDITOR_UNDO_MEMORY_LIMIT. The newest group is always kept.
+    */
+    void limitUndoHistory();
+
     void drawScreen();
     void processInput();
     void drawCursor();
     void drawMap(ScreenBorder* pScreenborder, bool bCompleteMap);
     TERRAINTYPE getTerrain(int x, int y);
+
+    /**
+        Returns the index of the sprite in ObjPic_Terrain for the tile (x,y) which also depends on the terrain of
+        the four neighbours. The result is cached until the tile or a neighbour is marked as changed.
+    */
+    int getTerrainTile(int x, int y);
+    int calculateTerrainTile(int x, int y);
     void saveMapshot();
 
+    /// The editor state of a map right after INIMapEditorLoader has read it
+    struct LoadedMap {
+        std::string                     fileContent;    ///< the map file this state was read from
+        MapData                         map;
+        MapInfo                         mapInfo;
+        std::vector<Player>             players;
+        std::vector<Coord>              spiceBlooms;
+        std::vector<Coord>              specialBlooms;
+        std::vector<Coord>              spiceFields;
+        std::map<int,int>               choam;
+        std::vector<ReinforcementInfo>  reinforcements;
+        std::vector<AITeamInfo>         aiteams;
+        std::vector<Unit>               units;
+        std::vector<Structure>          structures;
+    };
+
+    /**
+        Returns the maps loaded so far by their file path. They outlive the editor so that reopening a map in a later
+        editor session is instant as well.
+    */
+    static std::map<std::string, LoadedMap>& getLoadedMapCache();
+
 private:
     std::unique_ptr<MapEditorInterface> pInterface;     ///< This is the whole interface (top bar and side bar)
 
@@ -305,6 +385,12 @@ private:
     bool                            shift;
 
     bool                            bChangedSinceLastSave;
+    Uint32                          editCount = 0;      ///< increased on every change of the map
+
+    std::vector<Sint16>             terrainTileCache;   ///< the sprite index of every tile as returned by calculateTerrainTile() or -1 if it needs to be recalculated
+    Coord                           changedTilesTopLeft;        ///< top left tile of the area changed since the last takeChangedTiles()
+    Coord                           changedTilesBottomRight;    ///< bottom right tile of the area changed since the last takeChangedTiles()
+    bool                            bTilesChanged = false;      ///< was any tile changed since the last takeChangedTiles()?
 
     EditorMode                      currentEditorMode;
 
@@ -323,6 +409,7 @@ private:
 
     std::string                     lastSaveName;
     std::unique_ptr<INIFile>        loadedINIFile;
+    std::string                     loadedINIFileContent;   ///< the map file to parse into loadedINIFile on the next save if it was restored from the cache
 
     std::vector<Player>             players;
 
@@ -344,8 +431,11 @@ private:
     std::vector<Structure>          structures;
 
 
-    std::stack<std::unique_ptr<MapEditorOperation> > undoOperationStack;
+    std::deque<std::unique_ptr<MapEditorOperation> > undoOperationStack;   ///< the newest operation is at the back
     std::stack<std::unique_ptr<MapEditorOperation> > redoOperationStack;
+    size_t undoMemoryUsage = 0;                                             ///< sum of getMemoryUsage() of all operations in undoOperationStack
+
+    std::unordered_map<Uint32, TERRAINTYPE> strokeOldTerrain;   ///< the terrain before the current brush stroke of all tiles it touched, by tile index
 };
 
 #endif // MAPEDITOR_H
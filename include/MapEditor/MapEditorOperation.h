@@ -39,6 +39,14 @@ public:
     virtual ~MapEditorOperation() = default;
 
     virtual std::unique_ptr<MapEditorOperation> perform(MapEditor *pMapEditor) = 0;
+
+    /**
+        Returns the approximate number of bytes this operation occupies in the undo history.
+        \return the memory usage in bytes
+    */
+    virtual size_t getMemoryUsage() const {
+        return sizeof(MapEditorOperation);
+    }
 };
 
 class MapEditorNoOperation : public MapEditorOperation {
@@ -65,20 +73,37 @@ public:
     std::unique_ptr<MapEditorOperation> perform(MapEditor *pMapEditor) override;
 };
 
-class MapEditorTerrainEditOperation : public MapEditorOperation {
+/**
+    All terrain changes of one brush stroke. The changed tiles are stored as runs of consecutive tile indices
+    together with the terrain to set on each of them. perform() swaps this terrain with the terrain on the map,
+    so undo and redo take time proportional to the number of changed tiles.
+*/
+class MapEditorTerrainStrokeOperation : public MapEditorOperation {
 public:
 
-    MapEditorTerrainEditOperation(int x, int y, TERRAINTYPE terrainType)
-     : MapEditorOperation(), x(x), y(y), terrainType(terrainType) {
+    struct Run {
+        Uint32 startIndex;  ///< index of the first tile of this run (y*sizeX + x)
+        Uint32 length;      ///< number of consecutive tiles in this run
+    };
+
+    MapEditorTerrainStrokeOperation(std::vector<Run> runs, std::vector<Uint8> terrainTypes)
+     : MapEditorOperation(), runs(std::move(runs)), terrainTypes(std::move(terrainTypes)) {
     }
 
-    virtual ~MapEditorTerrainEditOperation() = default;
+    virtual ~MapEditorTerrainStrokeOperation() = default;
 
+    /**
+        Sets the stored terrain and returns the operation to revert it. The stored tiles are moved into the
+        returned operation, so this operation is left empty.
+    */
     std::unique_ptr<MapEditorOperation> perform(MapEditor *pMapEditor) override;
 
-    int x;
-    int y;
-    TERRAINTYPE terrainType;
+    size_t getMemoryUsage() const override {
+        return sizeof(MapEditorTerrainStrokeOperation) + runs.capacity()*sizeof(Run) + terrainTypes.capacity()*sizeof(Uint8);
+    }
+
+    std::vector<Run> runs;              ///< the changed tiles
+    std::vector<Uint8> terrainTypes;    ///< the terrain to set on each tile of runs (in the same order)
 };
 
 class MapEditorTerrainAddSpiceBloomOperation : public MapEditorOperation {
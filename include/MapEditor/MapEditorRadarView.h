@@ -60,7 +60,13 @@ public:
     void draw(Point position) override;
 
 private:
-    void updateRadarSurface(const MapData& map, int scale, int offsetX, int offsetY);
+    /**
+        Recalculates the radar colors of all tiles inside the rectangle from topLeft to bottomRight (inclusive).
+        \param  map         the map to draw
+        \param  topLeft     the top left tile of the rectangle
+        \param  bottomRight the bottom right tile of the rectangle
+    */
+    void updateRadarSurface(const MapData& map, const Coord& topLeft, const Coord& bottomRight);
 
     MapEditor* pMapEditor;
 
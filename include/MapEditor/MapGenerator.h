@@ -21,10 +21,25 @@
 #include <MapEditor/MapData.h>
 #include <MapEditor/MapMirror.h>
 
+#include <vector>
+
 #define ROCKFIELDS 5        //how many fields it will randomly generate
 #define SPICEFIELDS 7
 #define DUNEFIELDS 3
 
 MapData generateRandomMap(int sizeX, int sizeY, int randSeed, int rockfields = ROCKFIELDS, int spicefields = SPICEFIELDS, MirrorMode mirrorMode = MirrorModeNone);
 
+/**
+    Creates one random map for every seed. The maps are generated in parallel and are identical to the ones
+    created by generateRandomMap() with the same parameters.
+    \param sizeX        width of the new maps (in tiles)
+    \param sizeY        height of the new maps (in tiles)
+    \param randSeeds    the seed values for the random generator
+    \param rockfields   num rock fields to add
+    \param spicefields  num spice fields to add
+    \param mirrorMode   the mirror mode of the maps
+    \return the generated maps in the order of randSeeds
+*/
+std::vector<MapData> generateRandomMaps(int sizeX, int sizeY, const std::vector<int>& randSeeds, int rockfields = ROCKFIELDS, int spicefields = SPICEFIELDS, MirrorMode mirrorMode = MirrorModeNone);
+
 #endif // MAPGENERATOR_H
@@ -22,7 +22,18 @@
 
 #include <MapEditor/MapData.h>
 
+#include <vector>
+
 void createMapWithSeed(Uint32 Para_Seed,Uint16 *pResultMap);
 MapData createMapWithSeed(Uint32 Para_Seed, int mapscale);
 
+/**
+    Creates one map for every seed. The maps are created in parallel and are identical to the ones created by
+    createMapWithSeed().
+    \param seeds       the seeds of the maps
+    \param mapscale    the map scale of all maps
+    \return the created maps in the order of seeds
+*/
+std::vector<MapData> createMapsWithSeeds(const std::vector<Uint32>& seeds, int mapscale);
+
 #endif // MAPSEED_H
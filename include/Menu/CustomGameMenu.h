@@ -27,6 +27,8 @@
 #include <GUI/PictureLabel.h>
 #include <GUI/Checkbox.h>
 
+#include <INIMap/MapPreviewCache.h>
+
 #include <DataTypes.h>
 
 #include <string>
@@ -46,6 +48,8 @@ public:
     */
     void onChildWindowClose(Window* pChildWindow) override;
 
+    void update() override;
+
 private:
     void onNext();
     void onCancel();
@@ -53,11 +57,14 @@ private:
     void onGameOptions();
     void onMapTypeChange(int buttonID);
     void onMapListSelectionChange(bool bInteractive);
+    void showMapPreview();
 
     bool bMultiplayer;
     bool bLANServer;
 
     std::string currentMapDirectory;
+    MapPreviewCache mapPreviewCache;
+    std::string pendingPreviewFilename;     ///< the map whose preview is still being created (empty if none)
 
     SettingsClass::GameOptionsClass currentGameOptions;
 
@@ -44,7 +44,7 @@ private:
     void onListBoxClick();
 
     int mission;
-    std::vector<MentatTextFile::MentatEntry> mentatEntries;
+    std::vector<const MentatTextFile::MentatEntry*> mentatEntries;
 
     Label           backgroundLabel;
     Label           itemDescriptionLabel;
@@ -23,6 +23,12 @@
 
 #define MENU_QUIT_DEFAULT   (-1)
 
+/// the menu is drawn at least this often (in ms), even if no widget requested a redraw
+#define MENUBASE_IDLE_REDRAW_INTERVAL   500
+
+/// the maximum time (in ms) the menu loop waits for input before calling update() again
+#define MENUBASE_MAX_IDLE_WAIT          50
+
 class MenuBase: public Window
 {
 public:
@@ -62,6 +62,8 @@ private:
 
     void onReceiveGameInfo(const GameInitSettings& gameInitSettings, const ChangeEventList& changeEventList);
 
+    void onReceiveSnapshot(const std::string& snapshot);
+
     std::list<GameServerInfo> LANGameList;
     std::list<GameServerInfo> InternetGameList;
 
@@ -32,7 +32,8 @@
 #include <vector>
 
 
-#define MENU_QUIT_REINITIALIZE  (1)
+#define MENU_QUIT_REINITIALIZE      (1)
+#define MENU_QUIT_VIDEOMODECHANGED  (2)
 
 
 class OptionsMenu : public MenuBase
@@ -0,0 +1,93 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BROADCASTCLIENT_H
+#define BROADCASTCLIENT_H
+
+#include <misc/SDL2pp.h>
+
+#include <enet/enet.h>
+
+#include <functional>
+#include <string>
+
+#define BROADCAST_CONNECT_TIMEOUT           10000   ///< the maximum time in milliseconds to wait for the replay header after connecting
+
+/**
+    The broadcast client receives the delayed command stream of a BroadcastServer. It is used by spectators and by relays.
+    All methods have to be called from the game thread; the received data is passed to the callbacks from within update().
+*/
+class BroadcastClient {
+public:
+    /**
+        Starts connecting to a broadcast server. Use update() to wait for the connection.
+        \param  hostname    the host name or IP address of the broadcast server
+        \param  port        the port of the broadcast server
+    */
+    BroadcastClient(const std::string& hostname, int port);
+    ~BroadcastClient();
+
+    BroadcastClient(const BroadcastClient&) = delete;
+    BroadcastClient& operator=(const BroadcastClient&) = delete;
+
+    /**
+        Receives all data sent by the broadcast server and calls the callbacks.
+        \param  timeout the maximum time in milliseconds to wait for data (0 = do not wait)
+    */
+    void update(Uint32 timeout = 0);
+
+    /**
+        Is the connection to the broadcast server lost (or could not be established)?
+        \return true if disconnected, false if connected or still connecting
+    */
+    bool isDisconnected() const { return bDisconnected; };
+
+    /**
+        Gets the game cycle the commands received so far are complete for.
+        \return all commands scheduled before this game cycle were received
+    */
+    Uint32 getAvailableCycle() const { return availableCycle; };
+
+    /**
+        Sets the function that should be called when the replay header is received.
+        \param  pOnReceiveHeader    function to call with the player name, GameInitSettings and the commands before the broadcast started
+    */
+    inline void setOnReceiveHeader(std::function<void (const std::string&)> pOnReceiveHeader) {
+        this->pOnReceiveHeader = pOnReceiveHeader;
+    }
+
+    /**
+        Sets the function that should be called when new commands are received.
+        \param  pOnReceiveCommands  function to call with the new available cycle (see getAvailableCycle()) and the recorded commands
+    */
+    inline void setOnReceiveCommands(std::function<void (Uint32, const std::string&)> pOnReceiveCommands) {
+        this->pOnReceiveCommands = pOnReceiveCommands;
+    }
+
+private:
+    void handlePacket(ENetPacket* pPacket);
+
+    ENetHost* host;                     ///< the local ENet host
+    ENetPeer* serverPeer;               ///< the broadcast server
+    bool bDisconnected = false;         ///< is the connection to the broadcast server lost?
+    Uint32 availableCycle = 0;          ///< all commands scheduled before this game cycle were received
+
+    std::function<void (const std::string&)>            pOnReceiveHeader;
+    std::function<void (Uint32, const std::string&)>    pOnReceiveCommands;
+};
+
+#endif // BROADCASTCLIENT_H
@@ -0,0 +1,117 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BROADCASTSERVER_H
+#define BROADCASTSERVER_H
+
+#include <misc/SDL2pp.h>
+
+#include <enet/enet.h>
+
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define BROADCASTPACKET_HEADER              0       ///< the replay header: name of the broadcasting player, init settings and all commands before the broadcast started
+#define BROADCASTPACKET_COMMANDS            1       ///< newly released commands and the game cycle spectators may simulate up to
+
+#define BROADCAST_MAX_SPECTATORS            64      ///< the maximum number of spectators (or relays) connected to one broadcast server
+#define BROADCAST_SEND_INTERVAL             250     ///< the released commands are sent to the spectators every this many milliseconds
+#define BROADCAST_MAX_QUEUED_COMMANDS       4096    ///< spectators with more unacknowledged ENet commands (packet fragments) are too slow and get disconnected
+#define BROADCAST_FINISH_TIMEOUT            1000    ///< the maximum time in milliseconds finish() waits for the last commands to be delivered
+#define BROADCAST_RELAY_WAIT_TIMEOUT        10      ///< a relay waits this many milliseconds for new data before servicing its own spectators
+
+/**
+    The broadcast server streams the recorded commands of a game (the same stream CommandManager::setStream() writes
+    for replays) to spectators. The commands are released with a delay, so spectators can neither learn about the plans
+    of the players early nor slow down the players: the spectators are no lockstep peers, they only simulate the game
+    locally up to the game cycle they have received all commands for. A spectator can in turn be a relay that
+    broadcasts the received stream to further spectators without an additional delay.
+    All methods have to be called from the game thread; the ENet host is only serviced by update().
+*/
+class BroadcastServer {
+public:
+    /**
+        Creates a broadcast server listening for spectators on the specified port.
+        \param  port    the port to listen on
+        \param  delay   the number of game cycles the commands are delayed
+    */
+    BroadcastServer(int port, Uint32 delay);
+    ~BroadcastServer();
+
+    BroadcastServer(const BroadcastServer&) = delete;
+    BroadcastServer& operator=(const BroadcastServer&) = delete;
+
+    /**
+        Sets the replay header every spectator receives first. Spectators connecting before the header is set wait for it.
+        \param  header  the player name, GameInitSettings and the commands recorded so far (as written for replays)
+    */
+    void setHeader(const std::string& header);
+
+    /**
+        Adds recorded commands. They are released to the spectators when the game cycle passed to update() is more than
+        the delay after cycle.
+        \param  cycle   the last game cycle the commands are scheduled for
+        \param  data    one or more recorded commands (each the game cycle followed by the saved command)
+    */
+    void addCommands(Uint32 cycle, const std::string& data);
+
+    /**
+        Releases the commands that are old enough, accepts new spectators and sends the released commands to them.
+        This never blocks.
+        \param  gameCycle   the current game cycle; all commands scheduled before it must have been added
+    */
+    void update(Uint32 gameCycle);
+
+    /**
+        Releases all commands scheduled before gameCycle regardless of the delay and waits for at most BROADCAST_FINISH_TIMEOUT
+        milliseconds until they are delivered. Should be called when the game has ended as there is nothing to hide anymore.
+        \param  gameCycle   the last game cycle of the game
+    */
+    void finish(Uint32 gameCycle);
+
+    /**
+        Gets the number of spectators currently receiving the broadcast (relays count as one spectator).
+        \return the number of spectators
+    */
+    int getNumSpectators() const { return spectatorList.size(); }
+
+private:
+    void releaseCommands(Uint32 newAvailableCycle);
+    void serviceHost();
+    void sendCommands();
+    void sendStreamTo(ENetPeer* peer);
+    void sendCommandsTo(ENetPeer* peer, Uint32 cycle, const std::string& data);
+
+    ENetHost* host;                                             ///< the ENet host the spectators connect to
+    Uint32 delay;                                               ///< the number of game cycles the commands are delayed
+
+    bool bHeaderSet = false;                                    ///< was setHeader() called already?
+    std::string header;                                         ///< the replay header (see setHeader())
+    std::vector<std::pair<Uint32, std::string>> pendingCommands;    ///< the commands not released yet and the last game cycle they are scheduled for
+    std::string releasedCommands;                               ///< all released commands; late spectators receive them at once
+    size_t numSentBytes = 0;                                    ///< the first bytes of releasedCommands already sent to all spectators
+    Uint32 availableCycle = 0;                                  ///< spectators have all commands scheduled before this game cycle
+    Uint32 sentAvailableCycle = 0;                              ///< the available cycle last sent to all spectators
+    Uint32 lastSendTime = 0;                                    ///< the time in milliseconds released commands were last sent
+
+    std::list<ENetPeer*> awaitingHeaderList;                    ///< connected spectators waiting for the header
+    std::list<ENetPeer*> spectatorList;                         ///< spectators that received the header and are kept up to date
+};
+
+#endif // BROADCASTSERVER_H
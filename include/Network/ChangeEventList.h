@@ -24,6 +24,11 @@
 
 #include <list>
 
+// the values of ChangeEventList::ChangeEvent::EventType::ChangePlayer besides the index of an AI player in PlayerFactory
+#define PLAYER_HUMAN        0
+#define PLAYER_OPEN         -1
+#define PLAYER_CLOSED       -2
+
 class ChangeEventList {
 public:
     class ChangeEvent {
@@ -21,6 +21,7 @@
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
 #include <misc/SDL2pp.h>
+#include <misc/exceptions.h>
 
 #include <Command.h>
 
@@ -65,6 +66,49 @@ public:
         }
     }
 
+    /**
+        Reads a command list written by saveCompact() from stream.
+        \param  stream  the stream to read from
+        \return the read command list
+    */
+    static CommandList loadCompact(InputStream& stream) {
+        CommandList result;
+        std::vector<CommandListEntry>& commandList = result.commandList;
+
+        Uint32 numCommandListEntries = stream.readVarUint32();
+        Uint32 nextCycle = 0;
+        const Command* pLastCommand = nullptr;
+        while(commandList.size() < numCommandListEntries) {
+            Uint32 cycle = nextCycle + (Uint32) stream.readVarSint32();
+            Uint32 numCommands = stream.readVarUint32();
+            if(numCommands == 0) {
+                Uint32 numEmptyCycles = stream.readVarUint32() + 1;
+                if(numEmptyCycles > numCommandListEntries - commandList.size()) {
+                    THROW(InputStream::error, "CommandList::CommandList(): Too many empty cycles!");
+                }
+                for(Uint32 i = 0; i < numEmptyCycles; i++) {
+                    commandList.emplace_back(cycle + i, std::vector<Command>());
+                }
+                nextCycle = cycle + numEmptyCycles;
+            } else {
+                std::vector<Command> commands;
+                for(Uint32 i = 0; i < numCommands; i++) {
+                    Command command(stream, (i > 0) ? &commands.back() : pLastCommand);
+                    commands.push_back(command);
+                }
+                commandList.emplace_back(cycle, commands);
+                nextCycle = cycle + 1;
+            }
+
+            // the commands of the entries are never reallocated, only moved together with their entry
+            if(!commandList.back().commands.empty()) {
+                pLastCommand = &commandList.back().commands.back();
+            }
+        }
+
+        return result;
+    }
+
     ~CommandList() = default;
 
     void save(OutputStream& stream) const {
@@ -74,6 +118,37 @@ public:
         }
     }
 
+    /**
+        Writes the command list in the compact network format. Cycles are delta coded against the previous entry,
+        consecutive cycles without commands are run-length coded and each command is delta coded against the previous one.
+        \param  stream  the stream to write to
+    */
+    void saveCompact(OutputStream& stream) const {
+        stream.writeVarUint32((Uint32) commandList.size());
+        Uint32 nextCycle = 0;
+        const Command* pPrevCommand = nullptr;
+        for(size_t i = 0; i < commandList.size(); i++) {
+            const CommandListEntry& commandListEntry = commandList[i];
+            stream.writeVarSint32((Sint32) (commandListEntry.cycle - nextCycle));
+            stream.writeVarUint32((Uint32) commandListEntry.commands.size());
+            if(commandListEntry.commands.empty()) {
+                Uint32 numEmptyCycles = 1;
+                while((i + 1 < commandList.size()) && commandList[i+1].commands.empty() && (commandList[i+1].cycle == commandListEntry.cycle + numEmptyCycles)) {
+                    numEmptyCycles++;
+                    i++;
+                }
+                stream.writeVarUint32(numEmptyCycles - 1);
+                nextCycle = commandListEntry.cycle + numEmptyCycles;
+            } else {
+                for(const Command& command : commandListEntry.commands) {
+                    command.saveCompact(stream, pPrevCommand);
+                    pPrevCommand = &command;
+                }
+                nextCycle = commandListEntry.cycle + 1;
+            }
+        }
+    }
+
     std::vector<CommandListEntry> commandList;
 };
 
@@ -18,11 +18,15 @@
 #ifndef ENETHTTP_H
 #define ENETHTTP_H
 
+#include <enet/enet.h>
+
 #include <string>
 #include <map>
 
 #define PORT_HTTP   80
 
+#define HTTP_TIMEOUT    (10*1000)   ///< the time in ms to wait for the response of the server
+
 std::string getDomainFromURL(const std::string& url);
 
 std::string getFilePathFromURL(const std::string& url);
@@ -31,9 +35,64 @@ int getPortFromURL(const std::string& url);
 
 std::string percentEncode(const std::string & s);
 
+/**
+    Appends the parameters percent encoded as query to the file path of url.
+    \param  url         the url to request
+    \param  parameters  the parameters for the query
+    \return the file path with the query
+*/
+std::string getFilePathWithQuery(const std::string& url, const std::map<std::string, std::string>& parameters);
+
 std::string loadFromHttp(const std::string& url, const std::map<std::string, std::string>& parameters = std::map<std::string, std::string>());
 
 std::string loadFromHttp(const std::string& domain, const std::string& filepath, unsigned short port = PORT_HTTP);
 
+/**
+    A connection to a HTTP server that is kept open between requests (HTTP/1.1 keep-alive), so only the first request
+    has to wait for resolving the domain and connecting. If the server closed the connection in the meantime, it is reopened.
+    All methods are blocking and an instance must only be used by one thread at a time.
+*/
+class HttpConnection {
+public:
+    /**
+        Constructor. The connection is opened with the first request.
+        \param  domain  the domain of the HTTP server
+        \param  port    the port of the HTTP server
+    */
+    HttpConnection(const std::string& domain, unsigned short port);
+
+    /**
+        Constructor taking domain and port from an url
+        \param  url the url (only domain and port are used)
+    */
+    explicit HttpConnection(const std::string& url);
+
+    HttpConnection(const HttpConnection&) = delete;
+    HttpConnection& operator=(const HttpConnection&) = delete;
+
+    ~HttpConnection();
+
+    /**
+        Sends a GET request and waits for the response
+        \param  filepath    the requested file path including the query
+        \return the content of the response (throws a std::runtime_error on error)
+    */
+    std::string get(const std::string& filepath);
+
+    /**
+        Closes the connection. The next request opens a new one.
+    */
+    void close();
+
+private:
+    void open();
+    bool receive();
+    std::string receiveResponse();
+
+    std::string domain;                 ///< the domain of the HTTP server
+    unsigned short port;                ///< the port of the HTTP server
+    ENetSocket httpSocket;              ///< the open connection or ENET_SOCKET_NULL
+    std::string receiveBuffer;          ///< data received but not yet consumed
+};
 
 #endif // ENETHTTP_H
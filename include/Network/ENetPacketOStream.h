@@ -19,19 +19,29 @@
 #define ENETPACKETOSTREAM_H
 
 #include <misc/OutputStream.h>
+#include <misc/exceptions.h>
+#include <Network/ENetPacketPool.h>
 
 #include <enet/enet.h>
 
 #include <string>
+#include <cstring>
+
+#define ENETPACKETOSTREAM_DEFAULT_SIZE  64
 
 class ENetPacketOStream : public OutputStream
 {
 public:
-    explicit ENetPacketOStream(enet_uint32 flags)
+    /**
+        Creates a new packet stream. The packet buffer is taken from the ENetPacketPool.
+        \param flags       the ENet packet flags
+        \param sizeHint    the expected size of the packet (to avoid growing the buffer while writing)
+    */
+    explicit ENetPacketOStream(enet_uint32 flags, size_t sizeHint = ENETPACKETOSTREAM_DEFAULT_SIZE)
      : currentPos(0) {
-        packet = enet_packet_create(nullptr,16,flags);
+        packet = ENetPacketPool::createPacket(sizeHint, flags);
         if(packet == nullptr) {
-            THROW(OutputStream::error, "ENetPacketOStream: enet_packet_create() failed!");
+            THROW(OutputStream::error, "ENetPacketOStream: ENetPacketPool::createPacket() failed!");
         }
     }
 
@@ -48,10 +58,11 @@ public:
 
     ENetPacketOStream& operator=(const ENetPacketOStream& p) {
         if(this != &p) {
-            ENetPacket* packetCopy = enet_packet_create(p.packet->data,p.packet->dataLength,p.packet->flags);
+            ENetPacket* packetCopy = ENetPacketPool::createPacket(p.packet->dataLength, p.packet->flags);
             if(packetCopy == nullptr) {
-                THROW(InputStream::error, "ENetPacketOStream::operator=(): enet_packet_create() failed!");
+                THROW(OutputStream::error, "ENetPacketOStream::operator=(): ENetPacketPool::createPacket() failed!");
             }
+            memcpy(packetCopy->data, p.packet->data, p.currentPos);
 
             if(packet != nullptr) {
                 enet_packet_destroy(packet);
@@ -138,7 +149,7 @@ public:
     }
 
     void ensureBufferSize(size_t minBufferSize) {
-        if(minBufferSize < packet->dataLength) {
+        if(minBufferSize <= packet->dataLength) {
             return;
         }
 
@@ -147,8 +158,8 @@ public:
             newBufferSize = minBufferSize;
         }
 
-        if(enet_packet_resize(packet,newBufferSize) < 0) {
-            THROW(OutputStream::error, "ENetPacketOStream::ensureBufferSize(): enet_packet_resize() failed!");
+        if(!ENetPacketPool::growPacket(packet, newBufferSize, currentPos)) {
+            THROW(OutputStream::error, "ENetPacketOStream::ensureBufferSize(): ENetPacketPool::growPacket() failed!");
         }
     }
 
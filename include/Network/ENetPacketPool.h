@@ -0,0 +1,79 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ENETPACKETPOOL_H
+#define ENETPACKETPOOL_H
+
+#include <misc/SDL2pp.h>
+
+#include <enet/enet.h>
+
+#include <array>
+#include <vector>
+
+#define ENETPACKETPOOL_MIN_BUFFERSIZE       64      ///< the smallest buffer handed out by the pool
+#define ENETPACKETPOOL_NUM_SIZECLASSES      11      ///< pooled buffers are 64 bytes up to 64 KiB (in powers of two); bigger buffers are not pooled
+#define ENETPACKETPOOL_MAX_FREEBUFFERS      32      ///< the maximum number of unused buffers kept per size class
+
+/**
+    This class provides the data buffers for all outgoing packets. The packets are created with ENET_PACKET_FLAG_NO_ALLOCATE
+    and their data is returned to the pool by the free callback as soon as ENet has sent the packet to all peers.
+    The free callback might be called from any thread servicing the ENet host, thus the pool is guarded by a mutex.
+*/
+class ENetPacketPool {
+public:
+    /**
+        Creates a packet whose data buffer is taken from the pool. The data length of the packet is the size
+        of the buffer and must be reduced to the actual length before sending the packet.
+        \param  sizeHint    the expected size of the packet
+        \param  flags       the ENet packet flags (ENET_PACKET_FLAG_NO_ALLOCATE is added)
+        \return the new packet or nullptr on failure
+    */
+    static ENetPacket* createPacket(size_t sizeHint, enet_uint32 flags);
+
+    /**
+        Replaces the data buffer of a packet created by createPacket() by a bigger one. The content is kept.
+        \param  pPacket         the packet to resize
+        \param  minBufferSize   the new minimum size of the buffer
+        \param  usedSize        the number of bytes to copy to the new buffer
+        \return true on success, false otherwise
+    */
+    static bool growPacket(ENetPacket* pPacket, size_t minBufferSize, size_t usedSize);
+
+    /**
+        Gets the size of the data buffer of a packet created by createPacket().
+        \param  pPacket the packet
+        \return the size of the buffer in bytes
+    */
+    static size_t getBufferSize(const ENetPacket* pPacket);
+
+private:
+    ENetPacketPool();
+    ~ENetPacketPool();
+
+    static ENetPacketPool& getInstance();
+
+    static void ENET_CALLBACK freePacket(ENetPacket* pPacket);
+
+    enet_uint8* allocateBuffer(int sizeClass, size_t bufferSize);
+    void releaseBuffer(enet_uint8* pBuffer, int sizeClass);
+
+    SDL_mutex* mutex;                                                                       ///< guards freeBuffers
+    std::array<std::vector<enet_uint8*>, ENETPACKETPOOL_NUM_SIZECLASSES> freeBuffers;       ///< the unused buffers of each size class
+};
+
+#endif // ENETPACKETPOOL_H
@@ -27,7 +27,9 @@
 #include <functional>
 
 #define LANGAME_ANNOUNCER_PORT                  28746
-#define LANGAME_ANNOUNCER_INTERVAL              3000
+#define LANGAME_ANNOUNCER_INTERVAL              15000   ///< games are announced on every change and otherwise only as keep-alive after this time
+#define LANGAME_ANNOUNCER_EXPIRY_TIME           (3*LANGAME_ANNOUNCER_INTERVAL)  ///< games not announced within this time are removed from the list
+#define LANGAME_ANNOUNCER_MAXPACKETSPERUPDATE   256     ///< the maximum number of received packets processed in one update()
 #define LANGAME_ANNOUNCER_MAGICNUMBER           82071105
 #define LANGAME_ANNOUNCER_MAXGAMENAMESIZE       32
 #define LANGAME_ANNOUNCER_MAXGAMEVERSIONSIZE    32
@@ -49,8 +51,9 @@ public:
     }
 
     void updateAnnounce(Uint8 numPlayers) {
+        const bool bChanged = (this->numPlayers != numPlayers);
         this->numPlayers = numPlayers;
-        if(serverPort > 0) {
+        if((serverPort > 0) && bChanged) {
             announceGame();
         }
     }
@@ -63,7 +66,11 @@ public:
 
     void update();
 
-    void announceGame();
+    /**
+        Announces the game to all computers in the LAN or only to one that requested it.
+        \param  pDestinationAddress the address to send the announcement to or nullptr for broadcasting it
+    */
+    void announceGame(const ENetAddress* pDestinationAddress = nullptr);
 
     void refreshServerList() const;
 
@@ -97,6 +104,7 @@ public:
 
 private:
     void receivePackets();
+    bool receivePacket();
     void updateServerInfoList();
     void sendRemoveGameAnnouncement();
 
@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <functional>
+#include <array>
 
 #include <enet/enet.h>
 #include <string>
@@ -31,6 +32,11 @@
 
 #define SERVERLIST_UPDATE_INTERVAL  (8*1000)
 #define GAMESERVER_UPDATE_INTERVAL  (10*1000)
+#define SERVERLIST_CACHE_TTL        (60*1000)   ///< a received server list is shown immediately if it is requested again within this time
+
+#define METASERVERCONNECTION_ANNOUNCE   0       ///< the connection for adding, updating and removing the own game server (these commands must stay in order)
+#define METASERVERCONNECTION_LIST       1       ///< the connection for requesting the server list
+#define METASERVER_NUM_CONNECTIONS      2
 
 
 class MetaServerClient {
@@ -40,13 +46,11 @@ public:
     ~MetaServerClient();
 
     /**
-        Sets the function that shall be called if there is an update to the server list
+        Sets the function that shall be called if there is an update to the server list. If the last received list is
+        not older than SERVERLIST_CACHE_TTL it is passed on the next update() while a new list is requested in the background.
         \param  pOnGameServerInfoList   Function to call on an update to the server list
     */
-    inline void setOnGameServerInfoList(std::function<void (std::list<GameServerInfo>&)> pOnGameServerInfoList) {
-        this->pOnGameServerInfoList = pOnGameServerInfoList;
-        lastServerInfoListUpdate = 0;
-    }
+    void setOnGameServerInfoList(std::function<void (std::list<GameServerInfo>&)> pOnGameServerInfoList);
 
     /**
         Sets the function that shall be called if the metaserver reports an error
@@ -70,24 +74,44 @@ public:
 private:
 
     /**
-        The main function of the thread that performes the complete communication with the metaserver.
-        \param  data    this void pointer should point to an instance of this MetaServerClient class
+        Every connection to the metaserver has its own thread, command queue and kept-alive HTTP connection,
+        so the requests of different connections are in flight at the same time.
+    */
+    struct Connection {
+        MetaServerClient* pMetaServerClient = nullptr;                              ///< The client this connection belongs to
+        std::list<std::unique_ptr<MetaServerCommand> > metaServerCommandList;       ///< The command queue for this connection thread (shared between main thread and connection thread, \see sharedDataMutex)
+        SDL_sem*    availableMetaServerCommandsSemaphore = nullptr;                 ///< This semaphore counts how many commands are available in the metaServerCommandList
+        SDL_Thread* connectionThread = nullptr;                                     ///< The thread that processes the commands of this connection
+    };
+
+    /**
+        The main function of the threads that perform the communication with the metaserver.
+        \param  data    this void pointer should point to a Connection of this MetaServerClient class
         \return returns 0
     */
     static int connectionThreadMain(void* data);
 
 
     /**
-        Enqueues a new command in the command queue for processing by the metaserver connection thread.
+        Enqueues a new command in the command queue of its connection for processing by the metaserver connection thread.
+        A queued command that is superseded by the new command is replaced.
         \param  metaServerCommand   a shared pointer to a command
     */
     void enqueueMetaServerCommand(std::unique_ptr<MetaServerCommand> metaServerCommand);
 
+    /**
+        Enqueues a new command in the command queue of one connection.
+        \param  connection          the connection to process the command
+        \param  metaServerCommand   a shared pointer to a command
+    */
+    void enqueueMetaServerCommand(Connection& connection, std::unique_ptr<MetaServerCommand> metaServerCommand);
+
     /**
         Dequeues a command from the command queue. This method shall only be called from the metaserver connection thread.
+        \param  connection  the connection of the calling thread
         \return a shared pointer to the first command in the queue
     */
-    std::unique_ptr<MetaServerCommand> dequeueMetaServerCommand();
+    std::unique_ptr<MetaServerCommand> dequeueMetaServerCommand(Connection& connection);
 
 
     /**
@@ -99,6 +123,7 @@ private:
 
     /**
         Sets a new game server info list. This method shall only be called from the metaserver connection thread.
+        The main thread is only notified if the list differs from the last one.
         \param  newGameServerInfoList   the new game server list
     */
     void setNewGameServerInfoList(const std::list<GameServerInfo>& newGameServerInfoList);
@@ -106,17 +131,15 @@ private:
 
     // Shared data (used by main thread and connection thread):
 
-    std::list<std::unique_ptr<MetaServerCommand> > metaServerCommandList;       ///< The command queue for the metaserver connection thread (shared between main thread and metaserver connection thread, \see sharedDataMutex)
-    SDL_sem*    availableMetaServerCommandsSemaphore;                           ///< This semaphore counts how many commands are available in the metaServerCommandList
+    std::array<Connection, METASERVER_NUM_CONNECTIONS> connections;             ///< The connections to the metaserver (\see METASERVERCONNECTION_ANNOUNCE and METASERVERCONNECTION_LIST)
 
     int metaserverErrorCause = 0;                                               ///< Set to 0 in case of no error, else the id of the command sent to the metaserver
     std::string metaserverError = "";                                           ///< Set to some string in case a metaserver error occurs (only one error can be pending at once)
     bool bUpdatedGameServerInfoList = false;                                    ///< Was the gameServerInfoList updated? Set to true by the metaserver connection thread and reset to false in the main thread (\see sharedDataMutex)
     std::list<GameServerInfo> gameServerInfoList;                               ///< A list of all available game servers. Writen by the metaserver connection thread and read by the main thread (\see sharedDataMutex)
+    Uint32 gameServerInfoListTime = 0;                                          ///< The time the gameServerInfoList was received (0 = never) (\see sharedDataMutex)
 
-    SDL_mutex* sharedDataMutex;                                                 ///< This mutex must be locked before any shared data structures between the main thread and the metaserver connection thread is read or modified)
-
-    SDL_Thread* connectionThread;                                               ///< The metaserver connection thread that processes all the metaserver communication
+    SDL_mutex* sharedDataMutex;                                                 ///< This mutex must be locked before any shared data structures between the main thread and the metaserver connection threads is read or modified)
 
 
     // Non-Shared data (used only by main thread):
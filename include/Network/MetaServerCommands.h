@@ -41,6 +41,15 @@ public:
         return (type == metaServerCommand.type);
     }
 
+    /**
+        Does this command make an older queued command unnecessary? The older command is then replaced by this one.
+        \param  metaServerCommand   the queued command
+        \return true if the older command need not be sent anymore
+    */
+    virtual bool supersedes(const MetaServerCommand& metaServerCommand) const {
+        return (*this == metaServerCommand);
+    }
+
     int type;
 };
 
@@ -98,6 +107,15 @@ public:
         }
     }
 
+    bool supersedes(const MetaServerCommand& metaServerCommand) const override
+    {
+        // only the latest number of players has to be sent
+        const MetaServerUpdate* pMetaServerUpdate = dynamic_cast<const MetaServerUpdate*>(&metaServerCommand);
+        return ((pMetaServerUpdate != nullptr)
+                 && (serverPort == pMetaServerUpdate->serverPort)
+                 && (secret == pMetaServerUpdate->secret));
+    }
+
     std::string serverName;
     int serverPort;
     std::string secret;
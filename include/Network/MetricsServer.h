@@ -0,0 +1,75 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#include <misc/SDL2pp.h>
+
+#include <enet/enet.h>
+
+#include <functional>
+#include <list>
+#include <string>
+
+#define METRICS_MAX_CLIENTS             8       ///< the maximum number of simultaneously connected metrics clients
+#define METRICS_MAX_REQUESTSIZE         4096    ///< clients sending a longer request are disconnected
+#define METRICS_CLIENT_TIMEOUT          1000    ///< clients that have not sent their request after this many milliseconds are disconnected
+
+/**
+    The metrics server answers every HTTP request on its port with the current metrics of a running game in the
+    plain text exposition format of Prometheus (one "name{labels} value" line per sample). It is meant for hosted
+    games (e.g. dedicated headless servers) to be scraped by a monitoring system. The server never blocks: all sockets
+    are non-blocking and update() only handles what is already received. All methods have to be called from the game
+    thread.
+*/
+class MetricsServer {
+public:
+    /**
+        Creates a metrics server listening on the specified port (throws a std::runtime_error on failure).
+        \param  port    the TCP port to listen on
+    */
+    explicit MetricsServer(int port);
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    /**
+        Accepts new clients and answers all complete requests. The metrics are only generated if there is a request
+        to answer.
+        \param  getMetrics  returns the current metrics in the text exposition format
+    */
+    void update(const std::function<std::string ()>& getMetrics);
+
+private:
+    struct Client {
+        ENetSocket  socket;         ///< the connection to the client
+        Uint32      connectTime;    ///< the time in milliseconds the client connected
+        std::string request;        ///< the part of the request received so far
+        std::string response;       ///< the part of the response that is not sent yet
+    };
+
+    void acceptClients();
+    static bool receiveRequest(Client& client);
+    static bool sendResponse(Client& client);
+
+    ENetSocket          listenSocket;   ///< the socket accepting new clients
+    std::list<Client>   clients;        ///< the connected clients
+};
+
+#endif // METRICSSERVER_H
@@ -26,19 +26,33 @@
 #include <Network/LANGameFinderAndAnnouncer.h>
 #include <Network/MetaServerClient.h>
 
+#include <StateHashes.h>
+
 #include <misc/string_util.h>
 #include <misc/SDL2pp.h>
+#include <misc/SPSCQueue.h>
+#include <misc/ObjectIDSet.h>
 
 #include <enet/enet.h>
 #include <string>
 #include <list>
+#include <vector>
 #include <functional>
+#include <utility>
 #include <stdarg.h>
 
+/// What a rejoining player needs to continue the game after loading the snapshot (see NETWORKPACKET_CATCHUPCOMMANDS)
+struct CatchUpData {
+    Uint32      gameCycle = 0;          ///< the game cycle of the game host
+    CommandList commandList;            ///< all commands given for the game cycles since the snapshot
+    StateHashes stateHashes;            ///< the state hashes of the game host at the beginning of gameCycle
+};
+
 #define NETWORKDISCONNECT_QUIT              1
 #define NETWORKDISCONNECT_TIMEOUT           2
 #define NETWORKDISCONNECT_PLAYER_EXISTS     3
 #define NETWORKDISCONNECT_GAME_FULL         4
+#define NETWORKDISCONNECT_GAME_RUNNING      5
 
 #define NETWORKPACKET_UNKNOWN               0
 #define NETWORKPACKET_CONNECT               1
@@ -51,9 +65,33 @@
 #define NETWORKPACKET_STARTGAME             8
 #define NETWORKPACKET_COMMANDLIST           9
 #define NETWORKPACKET_SELECTIONLIST         10
+#define NETWORKPACKET_COMMANDLIST_COMPACT   11
+#define NETWORKPACKET_SNAPSHOTCHUNK         12
+#define NETWORKPACKET_SNAPSHOTLOADED        13
+#define NETWORKPACKET_CATCHUPCOMMANDS       14
+
+#define NETWORKCHANNEL_SNAPSHOT             1      ///< the snapshots for rejoining players are sent on their own channel so they do not hold back the command lists
+
+// initial buffer sizes for packets that are typically bigger than ENETPACKETOSTREAM_DEFAULT_SIZE
+#define NETWORKPACKET_SIZEHINT_SENDGAMEINFO     16384
+#define NETWORKPACKET_SIZEHINT_CHANGEEVENTLIST  1024
+#define NETWORKPACKET_SIZEHINT_CATCHUPCOMMANDS 16384
+
+// the protocol version is sent together with the player name and sending newer packet types is only allowed to peers that support them
+#define NETWORKPROTOCOL_VERSION_LEGACY                  0   ///< peers that do not send a protocol version
+#define NETWORKPROTOCOL_VERSION_COMPACTCOMMANDLIST      1   ///< peers that understand NETWORKPACKET_COMMANDLIST_COMPACT and CMD_NETWORK_CYCLE_BUFFER
+#define NETWORKPROTOCOL_VERSION_REJOIN                  2   ///< peers that can rejoin a running game (NETWORKPACKET_SNAPSHOTCHUNK and following) and know CMD_TEST_STATEHASH
+#define NETWORKPROTOCOL_VERSION_GROUPCOMMANDS           3   ///< peers that know CMD_UNIT_MOVE2POS_GROUP
+#define NETWORKPROTOCOL_VERSION                         NETWORKPROTOCOL_VERSION_GROUPCOMMANDS
 
 #define AWAITING_CONNECTION_TIMEOUT     5000
 
+#define NETWORKTHREAD_WAIT_TIMEOUT      2       ///< the network thread waits at most this many ms for incoming data before servicing the host again
+#define NETWORKTHREAD_QUEUE_SIZE        4096    ///< the number of received events that can wait for the game thread
+
+#define NETWORKSNAPSHOT_CHUNK_SIZE          1024    ///< the snapshot is split into chunks of this size that fit into one UDP datagram
+#define NETWORKSNAPSHOT_MAX_QUEUED_CHUNKS   32      ///< new chunks are only queued while ENet has less unacknowledged reliable commands for the peer
+
 class GameInitSettings;
 
 class NetworkManager {
@@ -64,6 +102,18 @@ public:
 
     bool isServer() const { return bIsServer; };
 
+    /**
+        Was this game hosted by us? Unlike isServer() this stays true after stopServer() when the game is started.
+        \return true if startServer() was called
+    */
+    bool isGameHost() const { return bGameHost; };
+
+    /**
+        Are we rejoining a running game? This is the case after the snapshot is received and until the catch up commands are received.
+        \return true if rejoining, false otherwise
+    */
+    bool isRejoining() const { return bRejoining; };
+
     void startServer(bool bLANServer, const std::string& serverName, const std::string& playerName, GameInitSettings* pGameInitSettings, int numPlayers, int maxPlayers);
     void updateServer(int numPlayers);
     void stopServer();
@@ -73,8 +123,24 @@ public:
 
     void disconnect();
 
+    /**
+        Processes all events the network thread has received since the last call. All callbacks are called from here.
+        Must be called regularly from the game thread.
+    */
     void update();
 
+    /**
+        Hands all packets queued since the last call to ENet and sends them. All messages of one frame to a peer thus
+        leave in as few datagrams as possible. Called once per frame from the game loop and from update().
+    */
+    void flush();
+
+    /**
+        Waits until the network thread has received new events or the timeout expires. Call update() afterwards to process them.
+        \param timeout the maximum time to wait in ms
+    */
+    void waitForReceivedEvents(Uint32 timeout);
+
     void sendChatMessage(const std::string& message);
 
     void sendChangeEventList(const ChangeEventList& changeEventList);
@@ -83,7 +149,13 @@ public:
 
     void sendCommandList(const CommandList& commandList);
 
-    void sendSelectedList(const std::set<Uint32>& selectedList, int groupListIndex = -1);
+    void sendSelectedList(const ObjectIDSet& selectedList, int groupListIndex = -1);
+
+    /**
+        Tells the game host that the received snapshot is loaded (see setOnReceiveSnapshot()). The host then connects
+        all other peers to us and sends the catch up commands.
+    */
+    void sendSnapshotLoaded();
 
     std::list<std::string> getConnectedPeers() const {
         std::list<std::string> peerNameList;
@@ -100,6 +172,26 @@ public:
 
     int getMaxPeerRoundTripTime();
 
+    /**
+        Returns the round trip time of every connected peer as measured by ENet.
+        \return a list of the peer names and their round trip times in ms
+    */
+    std::list<std::pair<std::string, int>> getPeerRoundTripTimes();
+
+    /**
+        Returns the largest jitter of all connected peers. For every peer this is the larger one of the round trip
+        time variance measured by ENet and the variation of the arrival intervals of its command lists.
+        \return the jitter in ms
+    */
+    int getMaxPeerJitter();
+
+    /**
+        Returns the lowest protocol version of all connected peers and of the ones connecting. Every peer executes all
+        commands, so a command type that came with a newer protocol version may only be given if every peer supports it.
+        \return the lowest protocol version or NETWORKPROTOCOL_VERSION if there are no other peers
+    */
+    Uint32 getMinPeerProtocolVersion();
+
     LANGameFinderAndAnnouncer* getLANGameFinderAndAnnouncer() {
         return pLANGameFinderAndAnnouncer.get();
     };
@@ -170,10 +262,43 @@ public:
         Sets the function that should be called when a selection list is received.
         \param  pOnReceiveSelectionList function to call on receive
     */
-    inline void setOnReceiveSelectionList(std::function<void (const std::string&, const std::set<Uint32>&, int)> pOnReceiveSelectionList) {
+    inline void setOnReceiveSelectionList(std::function<void (const std::string&, const ObjectIDSet&, int)> pOnReceiveSelectionList) {
         this->pOnReceiveSelectionList = pOnReceiveSelectionList;
     }
 
+    /**
+        Sets the function that is called when a player connects to the running game. Setting this function lets the game host
+        accept players that lost their connection while the game keeps running.
+        \param  pGetSnapshotForRejoiningPlayerCallback  function returning a save game of the current state for the player or an empty string if the player cannot rejoin
+    */
+    inline void setGetSnapshotForRejoiningPlayerCallback(std::function<std::string (const std::string&)> pGetSnapshotForRejoiningPlayerCallback) {
+        this->pGetSnapshotForRejoiningPlayerCallback = pGetSnapshotForRejoiningPlayerCallback;
+    }
+
+    /**
+        Sets the function that is called when a rejoining player has loaded the snapshot and is connected to all other peers.
+        \param  pGetCatchUpCommandsCallback function returning the current game cycle, all commands given for the game cycles since the snapshot and the current state hashes
+    */
+    inline void setGetCatchUpCommandsCallback(std::function<CatchUpData (const std::string&)> pGetCatchUpCommandsCallback) {
+        this->pGetCatchUpCommandsCallback = pGetCatchUpCommandsCallback;
+    }
+
+    /**
+        Sets the function that should be called when the snapshot of the running game is received after connecting to the game host.
+        \param  pOnReceiveSnapshot  function to call with the save game to load
+    */
+    inline void setOnReceiveSnapshot(std::function<void (const std::string&)> pOnReceiveSnapshot) {
+        this->pOnReceiveSnapshot = pOnReceiveSnapshot;
+    }
+
+    /**
+        Sets the function that should be called when the commands since the snapshot are received.
+        \param  pOnReceiveCatchUpCommands   function to call with the game cycle of the game host, the commands given before it and its state hashes
+    */
+    inline void setOnReceiveCatchUpCommands(std::function<void (const CatchUpData&)> pOnReceiveCatchUpCommands) {
+        this->pOnReceiveCatchUpCommands = pOnReceiveCatchUpCommands;
+    }
+
 private:
     static void debugNetwork(PRINTF_FORMAT_STRING const char* fmt, ...) PRINTF_VARARG_FUNC(1);
 
@@ -183,7 +308,66 @@ private:
 
     void sendPacketToAllConnectedPeers(ENetPacketOStream& packetStream, int channel = 0);
 
-    void handlePacket(ENetPeer* peer, ENetPacketIStream& packetStream);
+    /**
+        Queues a packet for a peer until the next flush(). The packet is referenced until it is sent.
+        \param pPeer      the receiving peer
+        \param channel    the ENet channel
+        \param pPacket    the packet
+    */
+    void queuePacket(ENetPeer* pPeer, int channel, ENetPacket* pPacket);
+
+    /**
+        The main function of the network thread. It services the ENet host (keepalives, acks, resends) independent
+        of the frame rate and passes all received events to the game thread.
+        \param data    the NetworkManager
+    */
+    static int networkThreadMain(void* data);
+
+    /**
+        Services the ENet host and queues all received events. This method shall only be called from the network thread.
+    */
+    void serviceHost();
+
+    /**
+        Handles a received packet.
+        \param peer            the peer that sent the packet
+        \param packetStream    the packet
+        \param receiveTime     the time (SDL_GetTicks()) the network thread received the packet
+    */
+    void handlePacket(ENetPeer* peer, ENetPacketIStream& packetStream, Uint32 receiveTime);
+
+    /**
+        Reads the protocol version that follows the player name in NETWORKPACKET_SENDNAME and NETWORKPACKET_CONNECT.
+        \param packetStream    the stream to read from
+        \return the protocol version or NETWORKPROTOCOL_VERSION_LEGACY if the sender did not send one
+    */
+    static Uint32 readProtocolVersion(ENetPacketIStream& packetStream);
+
+    /**
+        Does this peer accept new peers? This is the server in the game lobby and the game host in a running game if rejoining is allowed.
+        \return true if accepting peers
+    */
+    bool isAcceptingPeers() const { return bIsServer || pGetSnapshotForRejoiningPlayerCallback; };
+
+    /**
+        Instructs all connected peers to connect to a new peer or adds it immediately if there are no other peers.
+        \param pNewPeer    the new peer (the first one in awaitingConnectionList)
+    */
+    void connectOtherPeersTo(ENetPeer* pNewPeer);
+
+    /**
+        Moves a new peer that is connected to all other peers to the peer list and sends it the game info
+        (or the catch up commands if rejoining the running game).
+        \param pNewPeer    the new peer
+    */
+    void addConnectedPeer(ENetPeer* pNewPeer);
+
+    /**
+        Queues the next chunks of the snapshot for a rejoining peer. Only a few chunks are queued at once, so the
+        transfer does not delay the command lists.
+        \param pPeer   the rejoining peer
+    */
+    void sendSnapshotChunks(ENetPeer* pPeer);
 
     class PeerData {
     public:
@@ -192,6 +376,7 @@ private:
             WaitingForName,
             ReadyForOtherPeersToConnect,
             WaitingForOtherPeersToConnect,
+            ReceivingSnapshot,
             Connected
         };
 
@@ -207,11 +392,44 @@ private:
         Uint32                  timeout;
 
         std::string             name;
+        Uint32                  protocolVersion = NETWORKPROTOCOL_VERSION_LEGACY;      ///< the network protocol version this peer supports
         std::list<ENetPeer*>    notYetConnectedPeers;
+
+        Uint32                  lastCommandListTime = 0;        ///< the time (SDL_GetTicks()) the last command list of this peer arrived
+        int                     lastCommandListInterval = 0;    ///< the time in ms between the last two command lists of this peer
+        float                   commandListJitter = 0.0f;       ///< the smoothed variation of the command list arrival intervals in ms (as in RFC 3550)
+
+        std::string             snapshot;                       ///< the snapshot sent to this peer while rejoining
+        size_t                  snapshotOffset = 0;             ///< the number of bytes of snapshot already queued for sending
+    };
+
+    /// an event received by the network thread
+    struct ReceivedEvent {
+        ENetEvent   event;          ///< the event returned by enet_host_service()
+        ENetAddress address;        ///< the address of event.peer at the time of the event (the peer may be reused after a disconnect)
+        Uint32      receiveTime;    ///< the time (SDL_GetTicks()) the event was received
+    };
+
+    /// a packet waiting for the next flush()
+    struct OutgoingPacket {
+        ENetPeer*   pPeer;          ///< the receiving peer
+        int         channel;        ///< the ENet channel
+        ENetPacket* pPacket;        ///< the packet (referenced once per queued entry)
     };
 
-    ENetHost* host = nullptr;
+    ENetHost* host = nullptr;                   ///< the ENet host (only accessed with hostMutex locked)
+    SDL_mutex* hostMutex = nullptr;             ///< guards host and all its peers, because ENet is not thread-safe
+    SDL_Thread* networkThread = nullptr;        ///< the thread servicing host
+    SDL_atomic_t quitNetworkThread;             ///< set to 1 to stop the network thread
+    SDL_sem* receivedEventsSemaphore = nullptr; ///< posted by the network thread when new events were queued
+
+    SPSCQueue<ReceivedEvent, NETWORKTHREAD_QUEUE_SIZE> receivedEvents;     ///< events passed from the network thread to the game thread
+    std::vector<OutgoingPacket> outgoingPackets;                            ///< the packets queued since the last flush() (only accessed by the game thread)
+
     bool bIsServer = false;
+    bool bGameHost = false;                     ///< see isGameHost()
+    bool bRejoining = false;                    ///< see isRejoining()
+    std::string receivedSnapshot;               ///< the chunks of the snapshot received so far while rejoining
     bool bLANServer = false;
     GameInitSettings* pGameInitSettings = nullptr;
     int numPlayers = 0;
@@ -232,7 +450,11 @@ private:
     std::function<ChangeEventList (const std::string&)>                     pGetChangeEventListForNewPlayerCallback;
     std::function<void (unsigned int)>                                      pOnStartGame;
     std::function<void (const std::string&, const CommandList&)>            pOnReceiveCommandList;
-    std::function<void (const std::string&, const std::set<Uint32>&, int)>  pOnReceiveSelectionList;
+    std::function<void (const std::string&, const ObjectIDSet&, int)>  pOnReceiveSelectionList;
+    std::function<std::string (const std::string&)>                         pGetSnapshotForRejoiningPlayerCallback;
+    std::function<CatchUpData (const std::string&)>                         pGetCatchUpCommandsCallback;
+    std::function<void (const std::string&)>                                pOnReceiveSnapshot;
+    std::function<void (const CatchUpData&)>                                pOnReceiveCatchUpCommands;
 
     std::unique_ptr<LANGameFinderAndAnnouncer>  pLANGameFinderAndAnnouncer = nullptr;
     std::unique_ptr<MetaServerClient>           pMetaServerClient = nullptr;
@@ -22,8 +22,10 @@
 
 #include <Definitions.h>
 #include <DataTypes.h>
+#include <ObjectData.h>
 #include <fixmath/FixPoint.h>
 #include <misc/SDL2pp.h>
+#include <misc/Random.h>
 #include <mmath.h>
 
 #include <globals.h>
@@ -37,6 +39,7 @@ class InputStream;
 class OutputStream;
 class ObjectInterface;
 class Coord;
+class Tile;
 template<class WidgetData> class Container;
 
 #define VIS_ALL -1
@@ -57,6 +60,18 @@ public:
     ObjectBase& operator=(const ObjectBase &) = delete;
     ObjectBase& operator=(ObjectBase &&) = delete;
 
+    /**
+        Allocates the memory for a unit or structure from the ObjectArena of the current GameContext.
+        \param  size    the size of the object
+    */
+    static void* operator new(size_t size);
+
+    /**
+        Returns the memory of a unit or structure to the ObjectArena it was allocated from.
+        \param  p   the memory of the object
+    */
+    static void operator delete(void* p);
+
     virtual void save(OutputStream& stream) const;
 
     virtual ObjectInterface* getInterfaceContainer();
@@ -129,6 +144,24 @@ public:
     const ObjectBase* findClosestTarget() const;
     virtual const ObjectBase* findTarget() const;
 
+    /**
+        Returns true if this object will look for a new target (call findTarget()) in its next update.
+        Game runs these scans in parallel before updating the objects (see prefetchTarget()).
+    */
+    virtual bool isTargetScanPending() const { return false; }
+
+    /**
+        Makes this object look for a new target in its next update instead of waiting for its target scan timer.
+        This is called when an enemy comes into sight nearby (see Map::restartTargetScans()).
+    */
+    virtual void restartTargetScan() { }
+
+    /**
+        Runs findTarget() and remembers the result for the current game cycle (see getScannedTarget()).
+        This is called from worker threads and must not modify anything but the stored scan result.
+    */
+    void prefetchTarget();
+
     inline void addHealth() { if (health < getMaxHealth()) setHealth(health + 1); }
     inline void setActive(bool status) { active = status; }
     inline void setForced(bool status) { forced = status; }
@@ -161,6 +194,14 @@ public:
     int getMaxHealth() const;
     inline Uint32 getObjectID() const { return objectID; }
 
+    /**
+        Returns the random number generator of this object. Every object has its own stream derived from the game seed
+        and its object id, so the numbers an object draws do not depend on the order the objects are updated in.
+        \return the random number generator of this object
+    */
+    inline Random& getRandomGen() { return randomGen; }
+    inline const Random& getRandomGen() const { return randomGen; }
+
 
     int getViewRange() const;
     int getAreaGuardRange() const;
@@ -174,9 +215,20 @@ public:
     inline const Coord& getDestination() const { return destination; }
     inline ObjectBase* getTarget() { return target.getObjPointer(); }
     inline const ObjectBase* getTarget() const { return target.getObjPointer(); }
+    inline bool isTargetFriendly() const { return targetFriendly; }
 
     inline int getOriginalHouseID() const { return originalHouseID; }
-    virtual void setOriginalHouseID(int i) { originalHouseID = i; }
+    virtual void setOriginalHouseID(int i) { originalHouseID = i; pObjectData = nullptr; }
+
+    /**
+        Returns the unit/structure data of the type of this object as built by its original house. The entry in
+        currentGame->objectData is looked up once and then kept, so the hot getters (e.g. getWeaponRange()) and
+        the movement code need no two-dimensional lookup every time.
+        \return the object data of this object
+    */
+    inline const ObjectData::ObjectDataStruct& getObjectData() const {
+        return (pObjectData != nullptr) ? *pObjectData : resolveObjectData();
+    }
     inline House* getOwner() { return owner; }
     inline const House* getOwner() const { return owner; }
 
@@ -188,6 +240,41 @@ public:
 protected:
     bool targetInWeaponRange() const;
 
+    const ObjectBase* findClosestTargetObject(bool bStructures, bool bUnits) const;
+
+    /**
+        Returns the result of findTarget(). If the target was already searched by prefetchTarget() in this game cycle
+        the stored result is used, otherwise findTarget() is called. findTarget() is also called if the stored target
+        is not valid anymore or if nothing was found but a new target may have appeared in range since then (see
+        Map::noteTargetsChanged()).
+    */
+    const ObjectBase* getScannedTarget() const;
+
+    /**
+        Returns the range findTarget() searches for targets in with the current attack mode.
+        \return the range in tiles or -1 if findTarget() does not search tiles in range (STOP and HUNT)
+    */
+    int getTargetScanRange() const;
+
+    /**
+        Can findTarget() see objects on this tile (explored and not fogged for the owner)?
+    */
+    bool isTargetTileScannable(const Tile* pTile) const;
+
+    /**
+        Checks if a target stored by prefetchTarget() would still be found by findTarget(), i.e. it can still be
+        attacked, is still on the map and (unless hunting) is still on a visible tile in range.
+        \param  pTarget the stored target
+        \return true if the target is still valid
+    */
+    bool isScannedTargetValid(const ObjectBase* pTarget) const;
+
+    /**
+        Returns the extra delay for the target scan timer of this object. Objects created in the same cycle get
+        different delays, so their target scans are spread over several cycles instead of all running in the same one.
+    */
+    inline Sint32 getTargetScanStagger() const { return objectID % TARGETSCAN_STAGGER; }
+
     // constant for all objects of the same type
     Uint32   itemID;                 ///< The ItemID of this object.
     int      radius;                 ///< The radius of this object
@@ -205,6 +292,7 @@ protected:
     // object state/properties
     Uint32   objectID;               ///< The unique object ID of this object
     int      originalHouseID;        ///< for takeover/deviation, we still want to keep track of what the original house was
+    mutable const ObjectData::ObjectDataStruct* pObjectData = nullptr;  ///< the entry in currentGame->objectData for itemID and originalHouseID (nullptr = not looked up yet)
     House    *owner;                 ///< The owner of this object
 
     Coord    location;               ///< The current position of this object in tile coordinates
@@ -229,6 +317,8 @@ protected:
 
     std::bitset<NUM_TEAMS> visible;  ///< To which teams is this unit visible?
 
+    Random   randomGen;              ///< The random number generator of this object (see getRandomGen())
+
     // drawing information
     bool     badlyDamaged;           ///< Is the health below 50%?
 
@@ -239,7 +329,23 @@ protected:
 
 private:
     FixPoint health;                 ///< The health of this object
+
+    Uint32   scannedTargetID = NONE_ID;                 ///< The target found by prefetchTarget()
+    Uint32   scannedTargetCycle = INVALID_GAMECYCLE;    ///< The game cycle scannedTargetID was found in
+    Coord    scannedTargetLocation;                     ///< The location of this object when scannedTargetID was found
+    ATTACKMODE scannedTargetAttackMode = STOP;          ///< The attack mode of this object when scannedTargetID was found
     void init();
+
+    /**
+        Looks up the entry of this object in currentGame->objectData and keeps it in pObjectData once itemID is known.
+    */
+    const ObjectData::ObjectDataStruct& resolveObjectData() const;
+
+    /**
+        Adds a new unit or structure to unitListByItemID or structureListByItemID.
+        \param  pObject the object created by createObject() or loadObject()
+    */
+    static void addToItemList(ObjectBase* pObject);
 };
 
 
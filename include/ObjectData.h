@@ -28,6 +28,10 @@
 
 #include <bitset>
 
+#define OBJECTDATA_CACHE_DIRECTORY  "objectdata-cache"  ///< directory below the config directory for compiled object data
+#define OBJECTDATA_CACHE_MAGIC      0x444f4c44          ///< "DLOD"
+#define OBJECTDATA_CACHE_VERSION    2                   ///< increase when the compiled format or the INI interpretation changes
+
 class INIFile;
 
 /// This class stores all the unit/structure data
@@ -70,12 +74,16 @@ public:
             TurnSpeed = 0.25<br>
             BuildTime = 56<br>
             InfSpawnProp = 45<br>
+        <br>
+        The parsed result is kept in a compiled binary form in the config directory. As long as the md5 of the INI-File
+        matches the one stored with the compiled data it is loaded from there instead of being parsed again.
         \param filename the INI-File to load.
     */
     void loadFromINIFile(const std::string& filename);
 
     /**
-        Saves all stored data out into a binary stream.
+        Saves all stored data out into a binary stream. The values of a house are only saved completely if they
+        differ from the ones of the first house.
         \param stream   the stream to save to
         \see load
     */
@@ -106,12 +114,41 @@ public:
         std::bitset<Structure_LastID + 1>   prerequisiteStructuresSet;    ///< What buildings are prerequisite for building this item
         Sint8    techLevel;                                           ///< What techLevel is needed to build this item (in campaign mode this equals to mission number)
         Sint8    upgradeLevel;                                        ///< How many upgrades must the builder already have made
+
+        bool operator==(const ObjectDataStruct& other) const {
+            return (enabled == other.enabled) && (hitpoints == other.hitpoints) && (price == other.price) && (power == other.power)
+                    && (viewrange == other.viewrange) && (capacity == other.capacity) && (weapondamage == other.weapondamage)
+                    && (weaponrange == other.weaponrange) && (weaponreloadtime == other.weaponreloadtime) && (maxspeed == other.maxspeed)
+                    && (turnspeed == other.turnspeed) && (buildtime == other.buildtime) && (infspawnprop == other.infspawnprop)
+                    && (builder == other.builder) && (prerequisiteStructuresSet == other.prerequisiteStructuresSet)
+                    && (techLevel == other.techLevel) && (upgradeLevel == other.upgradeLevel);
+        }
     };
 
     ObjectDataStruct data[Num_ItemID][NUM_HOUSES];      ///< here is all the data stored. It is public for easy and fast access. Use only read-only.
 
 private:
 
+    void parseINIFile(const INIFile& objectDataFile);
+
+    static void saveObjectDataStruct(OutputStream& stream, const ObjectDataStruct& objectDataStruct);
+    static void loadObjectDataStruct(InputStream& stream, ObjectDataStruct& objectDataStruct);
+
+    /**
+        Loads the compiled object data from cacheFilepath if it was compiled from a source with the md5 sourceHash.
+        \param cacheFilepath   the compiled file
+        \param sourceHash      the md5 of the INI-File
+        \return true if the data was loaded, false if the compiled file is missing, outdated or damaged
+    */
+    bool loadFromCache(const std::string& cacheFilepath, const unsigned char sourceHash[16]);
+
+    /**
+        Saves the object data in compiled form to cacheFilepath.
+        \param cacheFilepath   the compiled file
+        \param sourceHash      the md5 of the INI-File
+    */
+    void saveToCache(const std::string& cacheFilepath, const unsigned char sourceHash[16]) const;
+
     int loadIntValue(const INIFile& objectDataFile, const std::string& section, const std::string& key, char houseChar, int defaultValue = 0);
     bool loadBoolValue(const INIFile& objectDataFile, const std::string& section, const std::string& key, char houseChar, bool defaultValue = false);
     FixPoint loadFixPointValue(const INIFile& objectDataFile, const std::string& section, const std::string& key, char houseChar, FixPoint defaultValue = 0);
@@ -21,21 +21,30 @@
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
 #include <misc/SDL2pp.h>
+#include <SimulationStats.h>
 
-#include <map>
+#include <memory>
+#include <vector>
+
+#define OBJECTMANAGER_PAGESIZE  1024    ///< number of object slots allocated at once
 
 // forward declarations
 class ObjectBase;
 
-typedef std::map<Uint32,ObjectBase*> ObjectMap;
-
-/// This class holds all objects (structures and units) in the game.
+/**
+    This class holds all objects (structures and units) in the game.
+    Object IDs are handed out in increasing order and are never reused. Thus the objects are stored in a dense array
+    indexed directly by their ID which makes lookups O(1). A removed object just leaves an empty slot which makes
+    stale IDs resolve to nullptr.
+    The slots are allocated in pages of OBJECTMANAGER_PAGESIZE and never move, so ObjectPointer can keep the address of
+    the slot of its object and skip the lookup (see getSlot()).
+*/
 class ObjectManager{
 public:
     /**
         Default constructor
     */
-    ObjectManager() : nextFreeObjectID(1)
+    ObjectManager() : nextFreeObjectID(1), numObjects(0)
     {
     }
 
@@ -52,7 +61,8 @@ public:
     void save(OutputStream& stream) const;
 
     /**
-        Loads all objects from a stream
+        Loads all objects from a stream. All objects are created first and then put into their slots in one pass, so
+        the slots are allocated only once and objects referencing each other are only linked when all of them exist.
         \param  stream  Stream to load from
     */
     void load(InputStream& stream);
@@ -70,13 +80,22 @@ public:
         \return Pointer to this object (nullptr if not found)
     */
     inline ObjectBase* getObject(Uint32 objectID) const {
-        ObjectMap::const_iterator iter = objectMap.find(objectID);
+        COUNT_SIMULATION_EVENT(SimulationCounter_GetObjectCalls);
+        ObjectBase* const* pSlot = getSlot(objectID);
+        return (pSlot != nullptr) ? *pSlot : nullptr;
+    }
 
-        if(iter == objectMap.end()) {
+    /**
+        Returns the slot of the object with objectID. The slot stays at the same address as long as this object manager
+        exists and contains nullptr once the object is removed (IDs are not reused).
+        \param  ObjectID        ID of the object
+        \return the slot or nullptr if no object with this ID was added yet
+    */
+    inline ObjectBase* const* getSlot(Uint32 objectID) const {
+        if(objectID >= pages.size() * OBJECTMANAGER_PAGESIZE) {
             return nullptr;
-        } else {
-            return iter->second;
         }
+        return &pages[objectID / OBJECTMANAGER_PAGESIZE][objectID % OBJECTMANAGER_PAGESIZE];
     }
 
     /**
@@ -85,12 +104,22 @@ public:
         \return false if there was no object with this ObjectID, true if it could be removed
     */
     bool removeObject(Uint32 objectID) {
-        return (objectMap.erase(objectID) != 0);
+        if((objectID >= pages.size() * OBJECTMANAGER_PAGESIZE) || (pages[objectID / OBJECTMANAGER_PAGESIZE][objectID % OBJECTMANAGER_PAGESIZE] == nullptr)) {
+            return false;
+        }
+
+        pages[objectID / OBJECTMANAGER_PAGESIZE][objectID % OBJECTMANAGER_PAGESIZE] = nullptr;
+        numObjects--;
+        return true;
     }
 
 private:
+    void insertObject(Uint32 objectID, ObjectBase* pObject);
+    void allocateSlots(Uint32 maxObjectID);
+
     Uint32 nextFreeObjectID;
-    ObjectMap objectMap;
+    Uint32 numObjects;                                      ///< number of non-empty slots
+    std::vector<std::unique_ptr<ObjectBase*[]>> pages;      ///< all objects indexed by their object ID (nullptr for unused IDs), OBJECTMANAGER_PAGESIZE per page
 };
 
 #endif //OBJECTMANAGER_H
@@ -28,6 +28,11 @@ class ObjectBase;
 class UnitBase;
 class StructureBase;
 
+/**
+    A reference to a unit or structure by its object ID. Once resolved the pointer keeps the address of the slot of
+    its object in the ObjectManager, so dereferencing it is one load from the slot. The slot becomes nullptr when the
+    object is removed and as object IDs are never reused no further validation is needed. Only the ID is saved.
+*/
 class ObjectPointer
 {
 public:
@@ -36,11 +41,18 @@ public:
     ObjectPointer(const ObjectBase* newObject) { pointTo(newObject); };
     ~ObjectPointer() = default;
 
-    inline void pointTo(Uint32 newItemID) { objectID = newItemID; };
+    inline void pointTo(Uint32 newItemID) { objectID = newItemID; pSlot = nullptr; };
     void pointTo(const ObjectBase* newObject);
 
     inline Uint32 getObjectID() const { return objectID; };
-    ObjectBase* getObjPointer() const;
+
+    inline ObjectBase* getObjPointer() const {
+        if((pSlot != nullptr) && (*pSlot != nullptr)) {
+            return *pSlot;
+        }
+
+        return (objectID == NONE_ID) ? nullptr : resolve();
+    }
     inline UnitBase* getUnitPointer() const { return reinterpret_cast<UnitBase*>(getObjPointer()); };
     inline StructureBase* getStructurePointer() const { return reinterpret_cast<StructureBase*>(getObjPointer()); };
 
@@ -52,7 +64,15 @@ public:
     };
 
 private:
+    /**
+        Looks up the slot of objectID in the ObjectManager of the current game. The ID is reset to NONE_ID if there is
+        no such object (anymore).
+        \return the object or nullptr if it does not exist
+    */
+    ObjectBase* resolve() const;
+
     mutable Uint32 objectID;
+    mutable ObjectBase* const* pSlot = nullptr;     ///< the slot of the object in the ObjectManager (nullptr if not resolved yet)
 };
 
 
@@ -0,0 +1,134 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PATHCACHE_H
+#define PATHCACHE_H
+
+#include <DataTypes.h>
+
+#include <list>
+#include <memory>
+#include <vector>
+
+class InputStream;
+class Map;
+class OutputStream;
+class UnitBase;
+
+/**
+    Shares the results of AStarSearch between units that start at (nearly) the same tile and move to the same
+    destination, e.g. an AI attack wave leaving its rally point. For every finished search the path is stored once as an
+    immutable vector. A later request of a unit with the same movement class, target and destination gets
+    - the stored path if it starts at the same tile or
+    - the part of the stored path behind the tile where it can re-join the path if it starts close to it.
+
+    Dynamic obstacles (other units) are only considered by checking the first steps of a shared path.
+    All paths are discarded when a static obstacle is placed or removed and after PATHCACHE_LIFETIME.
+
+    A hit gives a unit a different path than a new search would, so the cached paths are part of the game state and
+    are saved with the map.
+*/
+class PathCache {
+public:
+    explicit PathCache(const Map* pMap);
+
+    PathCache(const PathCache &) = delete;
+    PathCache(PathCache &&) = delete;
+    PathCache& operator=(const PathCache &) = delete;
+    PathCache& operator=(PathCache &&) = delete;
+
+    /**
+        Discards all paths and resets the statistics.
+    */
+    void reset();
+
+    /**
+        Discards all paths because the static obstacles on the map have changed.
+    */
+    void invalidate();
+
+    /**
+        Loads the cached paths from stream. The statistics are not saved.
+        \param  stream  the stream to read from
+    */
+    void load(InputStream& stream);
+
+    /**
+        Saves the cached paths to stream.
+        \param  stream  the stream to write to
+    */
+    void save(OutputStream& stream) const;
+
+    /**
+        Returns a cached path for pUnit from its current location to destination.
+        \param  pUnit       the unit to find a path for
+        \param  destination the tile to search a path to
+        \param  path        the path is returned here
+        \return true if a path was found, false if the caller has to do a normal path search
+    */
+    bool getPath(const UnitBase* pUnit, const Coord& destination, std::list<Coord>& path);
+
+    /**
+        Stores the result of a path search for pUnit from its current location to destination.
+        \param  pUnit       the unit the path was searched for
+        \param  destination the tile the path was searched to
+        \param  path        the found path
+    */
+    void addPath(const UnitBase* pUnit, const Coord& destination, const std::list<Coord>& path);
+
+    /**
+        Checks if the path search of pOther (once stored with addPath()) could be shared with pUnit.
+        \param  pUnit               the unit to find a path for
+        \param  destination         the tile to search a path to for pUnit
+        \param  pOther              a unit whose path search is not finished yet
+        \param  otherDestination    the tile the path is searched to for pOther
+        \return true if pUnit should wait for the result of pOther
+    */
+    bool canShare(const UnitBase* pUnit, const Coord& destination, const UnitBase* pOther, const Coord& otherDestination) const;
+
+    Uint32 getNumHits() const noexcept { return numHits; }                 ///< requests answered with the whole path
+    Uint32 getNumSplicedHits() const noexcept { return numSplicedHits; }   ///< requests answered by re-joining a path
+    Uint32 getNumMisses() const noexcept { return numMisses; }             ///< requests that needed a path search
+
+private:
+    struct Key {
+        int     movementClass;                  ///< the movement class of the unit (see FlowFieldCache::getMovementClass())
+        Uint32  targetID;                       ///< the object ID of the target of the unit (NONE_ID if none)
+        Coord   destination;                    ///< the tile the path leads to
+
+        bool operator==(const Key& key) const {
+            return (movementClass == key.movementClass) && (targetID == key.targetID) && (destination == key.destination);
+        }
+    };
+
+    struct CachedPath {
+        Key     key;
+        Coord   start;                                  ///< the tile the path starts at (not part of the path)
+        Uint32  cycle;                                  ///< the game cycle this path was searched in
+        std::shared_ptr<const std::vector<Coord>> path; ///< the path without the start tile
+    };
+
+    static bool getKey(const UnitBase* pUnit, const Coord& destination, Key& key);
+
+    const Map* pMap;                            ///< the map this cache belongs to
+    std::vector<CachedPath> cachedPaths;        ///< the currently cached paths
+    Uint32  numHits;                            ///< number of requests answered with the whole path
+    Uint32  numSplicedHits;                     ///< number of requests answered by re-joining a path
+    Uint32  numMisses;                          ///< number of requests that needed a path search
+};
+
+#endif // PATHCACHE_H
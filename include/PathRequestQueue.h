@@ -0,0 +1,104 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PATHREQUESTQUEUE_H
+#define PATHREQUESTQUEUE_H
+
+#include <DataTypes.h>
+
+#include <deque>
+#include <list>
+#include <vector>
+
+class InputStream;
+class Map;
+class OutputStream;
+class UnitBase;
+
+/**
+    Collects the path requests of all units and services them once per game cycle. Instead of searching a path
+    synchronously inside UnitBase::navigate() a unit only enqueues its request. At the beginning of the next game cycle
+    the requests are taken from the queue in FIFO order and searched in batches of PATHREQUEST_BATCHSIZE units on the
+    worker pool of the game. The results are handed back to the units in queue order. Requests that can be answered
+    from the PathCache of the map are not searched at all.
+
+    The number of AStarSearch nodes expanded per cycle is limited by PATHREQUEST_NODEBUDGET; requests that do not fit
+    into the budget of this cycle stay queued for the next one. The batch size is fixed and the node count of a search
+    does not depend on the thread it runs on, so all peers of a multiplayer game service exactly the same requests in
+    the same cycle.
+
+    The pending requests are saved with the map, so a loaded game services the same requests in the same cycles as
+    the game that kept running.
+*/
+class PathRequestQueue {
+public:
+    explicit PathRequestQueue(Map* pMap);
+
+    PathRequestQueue(const PathRequestQueue &) = delete;
+    PathRequestQueue(PathRequestQueue &&) = delete;
+    PathRequestQueue& operator=(const PathRequestQueue &) = delete;
+    PathRequestQueue& operator=(PathRequestQueue &&) = delete;
+
+    /**
+        Discards all pending requests.
+    */
+    void reset();
+
+    /**
+        Loads the pending requests from stream.
+        \param  stream  the stream to read from
+    */
+    void load(InputStream& stream);
+
+    /**
+        Saves the pending requests to stream.
+        \param  stream  the stream to write to
+    */
+    void save(OutputStream& stream) const;
+
+    /**
+        Enqueues a path request for pUnit. The unit is informed about the result by UnitBase::onPathSearchFinished().
+        \param  pUnit   the unit to find a path for
+    */
+    void request(const UnitBase* pUnit);
+
+    /**
+        Services pending requests until the node budget of this cycle is used up. Must be called once per game cycle.
+    */
+    void service();
+
+    /**
+        Returns the number of requests still waiting to be serviced.
+    */
+    size_t getNumPendingRequests() const noexcept {
+        return pendingRequests.size();
+    }
+
+private:
+    struct Search {
+        UnitBase*           pUnit;                  ///< the unit this search is for
+        Coord               destination;            ///< the tile to search a path to
+        std::list<Coord>    path;                   ///< the found path (empty if none was found)
+        int                 numNodesChecked;        ///< the number of nodes expanded by the search
+    };
+
+    Map* pMap;                                      ///< the map to search on
+    std::deque<Uint32> pendingRequests;             ///< object IDs of the requesting units in request order
+    std::vector<Search> batch;                      ///< the searches currently run in parallel
+};
+
+#endif // PATHREQUESTQUEUE_H
@@ -0,0 +1,113 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PLACEMENTTABLES_H
+#define PLACEMENTTABLES_H
+
+#include <DataTypes.h>
+#include <Definitions.h>
+
+#include <vector>
+
+class Map;
+
+/**
+    Summed-area tables over the tiles of a map for the structure placement queries of Map (okayToPlaceStructure(),
+    isAStructureGap() and isWithinBuildRange()). With them the number of rock tiles, slabs, blocked tiles, structures
+    or tiles owned by a house inside any rectangle is known in constant time instead of scanning the rectangle.
+
+    Every table is rebuilt lazily on the next query after the underlying tile state has changed. The TilePlanes of the
+    map tell by their version counters if terrain, passability or ownership changed; structures are reported by
+    invalidateStructures().
+*/
+class PlacementTables {
+public:
+    explicit PlacementTables(const Map* pMap);
+
+    PlacementTables(const PlacementTables &) = delete;
+    PlacementTables(PlacementTables &&) = delete;
+    PlacementTables& operator=(const PlacementTables &) = delete;
+    PlacementTables& operator=(PlacementTables &&) = delete;
+
+    /**
+        Discards all tables. Must be called whenever the map is (re-)initialized.
+    */
+    void reset();
+
+    /**
+        Has to be called whenever a structure is placed or removed.
+    */
+    void invalidateStructures() noexcept {
+        bStructuresDirty = true;
+    }
+
+    /**
+        Returns the number of rock tiles (including slabs and mountains) inside the specified rectangle.
+        Parts of the rectangle outside the map are ignored by all count methods.
+    */
+    int countRock(int x, int y, int width, int height) const;
+
+    /**
+        Returns the number of slabs inside the specified rectangle.
+    */
+    int countSlab(int x, int y, int width, int height) const;
+
+    /**
+        Returns the number of tiles blocked by mountains or ground objects inside the specified rectangle.
+    */
+    int countBlocked(int x, int y, int width, int height) const;
+
+    /**
+        Returns the number of tiles occupied by a structure that is not placed on a slab inside the specified rectangle.
+    */
+    int countStructures(int x, int y, int width, int height) const;
+
+    /**
+        Returns the number of tiles owned by the house houseID inside the specified rectangle.
+    */
+    int countOwnedBy(int houseID, int x, int y, int width, int height) const;
+
+    /**
+        Rebuilds the tables that are out of date. The queries call this themselves; calling it before the tables are
+        queried from several threads makes these queries read-only as long as the map does not change.
+    */
+    void update() const;
+
+private:
+    enum Tables {
+        Table_Rock,
+        Table_Slab,
+        Table_Blocked,
+        Table_Structure,
+        Table_Owner,                    ///< first of NUM_HOUSES tables for the owners
+        NUM_TABLES = Table_Owner + NUM_HOUSES
+    };
+
+    int count(int table, int x, int y, int width, int height) const;
+
+    const Map* pMap;                                ///< the map these tables belong to
+
+    mutable std::vector<int> tables[NUM_TABLES];    ///< (sizeX+1)*(sizeY+1) prefix sums for each table (column-major)
+
+    mutable bool bStructuresDirty = true;           ///< has a structure been placed or removed since the last update?
+    mutable bool bValid = false;                    ///< have the tables been built at least once since the last reset?
+    mutable Uint32 terrainVersion = 0;              ///< TilePlanes::getTerrainVersion() at the last update
+    mutable Uint32 blockedVersion = 0;              ///< TilePlanes::getBlockedVersion() at the last update
+    mutable Uint32 ownerVersion = 0;                ///< TilePlanes::getOwnerVersion() at the last update
+};
+
+#endif // PLACEMENTTABLES_H
@@ -0,0 +1,180 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <misc/SDL2pp.h>
+#include <misc/Tracing.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#define PROFILER_NUM_SAMPLES    1024    ///< the statistics of a phase are computed over this many of its latest samples
+
+/// The phases of a game cycle and of a frame that are timed by the profiler
+enum ProfilerPhase {
+    // timed per game cycle (see Profiler::endCycle())
+    ProfilerPhase_Cycle,                ///< the whole game cycle
+    ProfilerPhase_Network,              ///< receiving and sending network data
+    ProfilerPhase_Commands,             ///< CommandManager::update() and executing the commands of this cycle
+    ProfilerPhase_Houses,               ///< House::update() of all houses (including their AI players)
+    ProfilerPhase_AIPlayers,            ///< Player::update() of all players
+    ProfilerPhase_Tiles,                ///< Map::updateTiles()
+    ProfilerPhase_PathRequests,         ///< servicing the queued path requests
+    ProfilerPhase_TargetScans,          ///< the parallel target scans
+    ProfilerPhase_Structures,           ///< StructureBase::update() of all structures
+    ProfilerPhase_Units,                ///< UnitBase::update() of all units
+    ProfilerPhase_Bullets,              ///< Bullet::update() of all bullets
+    ProfilerPhase_Explosions,           ///< Explosion::update() of all explosions
+
+    // timed per frame (see Profiler::endFrame())
+    ProfilerPhase_Frame,                ///< drawing the whole frame
+    ProfilerPhase_DrawGround,           ///< terrain and ground details
+    ProfilerPhase_DrawStructures,
+    ProfilerPhase_DrawUndergroundUnits,
+    ProfilerPhase_DrawDeadUnits,
+    ProfilerPhase_DrawInfantry,
+    ProfilerPhase_DrawGroundUnits,
+    ProfilerPhase_DrawBullets,
+    ProfilerPhase_DrawExplosions,
+    ProfilerPhase_DrawAirUnits,
+    ProfilerPhase_DrawSelectionRects,
+    ProfilerPhase_DrawFog,
+    ProfilerPhase_DrawInterface,        ///< sidebar, top bar and radar
+
+    NUM_PROFILERPHASES
+};
+
+/**
+    Measures the wall clock time spent in the phases of every game cycle and every frame. All the time measured for a
+    phase until the end of the current game cycle (or frame) is one sample. For every phase the minimum, average and
+    99th percentile over the last PROFILER_NUM_SAMPLES samples are available.
+
+    The scoped timers (see PROFILE_PHASE) are only compiled in if PROFILING (configure --enable-profiling) or TRACING
+    (configure --enable-tracing) is defined.
+*/
+class Profiler {
+public:
+
+    /// The statistics of one phase (all times in microseconds)
+    struct Statistics {
+        Uint32  numSamples = 0;     ///< the number of samples the statistics are computed over
+        float   min = 0.0f;         ///< the shortest sample
+        float   avg = 0.0f;         ///< the average of all samples
+        float   p99 = 0.0f;         ///< 99% of all samples are shorter or equal
+        float   max = 0.0f;         ///< the longest sample
+    };
+
+    Profiler() = default;
+
+    /**
+        Adds time spent in a phase to its current sample.
+        \param  phase   the phase
+        \param  ticks   the time in ticks of SDL_GetPerformanceCounter()
+    */
+    void addTime(ProfilerPhase phase, Uint64 ticks) {
+        pendingTicks[phase] += ticks;
+    }
+
+    /**
+        Ends the current sample of all per game cycle phases.
+    */
+    void endCycle() {
+        commitSamples(0, ProfilerPhase_Frame);
+    }
+
+    /**
+        Ends the current sample of all per frame phases.
+    */
+    void endFrame() {
+        commitSamples(ProfilerPhase_Frame, NUM_PROFILERPHASES);
+    }
+
+    /**
+        Computes the statistics over the latest samples of a phase.
+        \param  phase   the phase
+        \return the statistics
+    */
+    Statistics getStatistics(ProfilerPhase phase) const;
+
+    /**
+        Saves the latest samples of all phases to a csv file with the columns phase, sample and microseconds.
+        \param  filename    the file to save to
+        \return true on success, false on failure
+    */
+    bool saveCSV(const std::string& filename) const;
+
+    /**
+        Returns the name of a phase.
+        \param  phase   the phase
+        \return the name
+    */
+    static const char* getPhaseName(ProfilerPhase phase);
+
+private:
+    void commitSamples(int firstPhase, int lastPhase);
+
+    std::array<Uint64, NUM_PROFILERPHASES> pendingTicks = {};           ///< the time spent in each phase in the current sample
+    std::array<std::vector<Uint32>, NUM_PROFILERPHASES> samples;        ///< the latest samples of every phase (ring buffers of microseconds)
+    std::array<Uint32, NUM_PROFILERPHASES> numSamples = {};             ///< the number of samples taken of every phase so far
+};
+
+/**
+    Adds the time from its construction to its destruction to the current sample of a phase. If TRACING is defined
+    this time is also recorded as zone of the trace (see Tracing).
+*/
+class ScopedPhaseTimer {
+public:
+    ScopedPhaseTimer(Profiler& profiler, ProfilerPhase phase)
+     : profiler(profiler), phase(phase), start(SDL_GetPerformanceCounter()) {
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer &) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer &) = delete;
+
+    ~ScopedPhaseTimer() {
+        const Uint64 end = SDL_GetPerformanceCounter();
+        profiler.addTime(phase, end - start);
+#ifdef TRACING
+        if(Tracing::isRecording()) {
+            Tracing::addZone(Profiler::getPhaseName(phase), start, end);
+        }
+#endif
+    }
+
+private:
+    Profiler& profiler;         ///< the profiler to add the time to
+    ProfilerPhase phase;        ///< the phase being timed
+    Uint64 start;               ///< the performance counter at construction
+};
+
+#if defined(PROFILING) || defined(TRACING)
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_IMPL(a, b)
+/// Times the rest of the enclosing block as part of phase
+#define PROFILE_PHASE(profiler, phase) ScopedPhaseTimer PROFILER_CONCAT(phaseTimer, __LINE__)((profiler), (phase))
+#define PROFILE_END_CYCLE(profiler) (profiler).endCycle()
+#define PROFILE_END_FRAME(profiler) (profiler).endFrame()
+#else
+#define PROFILE_PHASE(profiler, phase)
+#define PROFILE_END_CYCLE(profiler)
+#define PROFILE_END_FRAME(profiler)
+#endif
+
+#endif // PROFILER_H
@@ -96,7 +96,7 @@ private:
         AnimationRadarOn
     };
 
-    void updateRadarSurface(int mapSizeX, int mapSizeY, int scale, int offsetX, int offsetY);
+    void updateRadarSurface(int mapSizeX, int mapSizeY, int scale, int downsampling, int offsetX, int offsetY);
 
     RadarMode currentRadarMode;             ///< the current mode of the radar
 
@@ -104,6 +104,9 @@ private:
 
     int animCounter;                        ///< this counter is for counting the ticks one animation frame is shown
 
+    bool bLastRadar = false;                ///< was the radar on when the radar surface was last updated?
+    bool bLastDebug = false;                ///< was debug mode on when the radar surface was last updated?
+
     sdl2::surface_ptr radarSurface;         ///< contains the image to be drawn when the radar is active
     sdl2::texture_ptr radarTexture;         ///< streaming texture to be used when the radar is active
     SDL_Texture* radarStaticAnimation;      ///< holds the animation graphic for radar static
@@ -24,7 +24,11 @@
 
 #include <misc/SDL2pp.h>
 
+#include <Colors.h>
+
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 
 #define NUM_STATIC_FRAMES 21
@@ -79,13 +83,14 @@ public:
     */
     bool isOnRadar(int mouseX, int mouseY) const {
         int scale = 1;
+        int downsampling = 1;
         int offsetX = 0;
         int offsetY = 0;
 
-        calculateScaleAndOffsets(getMapSizeX(), getMapSizeY(), scale, offsetX, offsetY);
+        calculateScaleAndOffsets(getMapSizeX(), getMapSizeY(), scale, downsampling, offsetX, offsetY);
 
-        int offsetFromRightX = 128 - getMapSizeX()*scale - offsetX;
-        int offsetFromBottomY = 128 - getMapSizeY()*scale - offsetY;
+        int offsetFromRightX = 128 - getRadarSize(getMapSizeX(), scale, downsampling) - offsetX;
+        int offsetFromBottomY = 128 - getRadarSize(getMapSizeY(), scale, downsampling) - offsetY;
 
         return ((mouseX >= offsetX + RADARVIEW_BORDERTHICKNESS)
                 && (mouseX < RADARWIDTH - offsetFromRightX + RADARVIEW_BORDERTHICKNESS)
@@ -103,29 +108,37 @@ public:
         Coord positionOnRadar(mouseX - RADARVIEW_BORDERTHICKNESS, mouseY - RADARVIEW_BORDERTHICKNESS);
 
         int scale = 1;
+        int downsampling = 1;
         int offsetX = 0;
         int offsetY = 0;
 
-        calculateScaleAndOffsets(getMapSizeX(), getMapSizeY(), scale, offsetX, offsetY);
+        calculateScaleAndOffsets(getMapSizeX(), getMapSizeY(), scale, downsampling, offsetX, offsetY);
 
-        return Coord( ((positionOnRadar.x - offsetX) * getMapSizeX() * TILESIZE) / (getMapSizeX() * scale),
-                      ((positionOnRadar.y - offsetY) * getMapSizeY() * TILESIZE) / (getMapSizeY() * scale));
+        return Coord( ((positionOnRadar.x - offsetX) * TILESIZE * downsampling) / scale,
+                      ((positionOnRadar.y - offsetY) * TILESIZE * downsampling) / scale);
     }
 
 
     /**
         This method calculates the scale and the offsets that are neccessary to show a minimap centered inside a 128x128 rectangle.
-        \param  MapSizeX    The width of the map in tiles
-        \param  MapSizeY    The height of the map in tiles
-        \param  scale       The scale factor is saved here
-        \param  offsetX     The offset in x direction is saved here
-        \param  offsetY     The offset in y direction is saved here
+        Maps larger than 128x128 are downsampled: every pixel shows the top left tile of a block of downsampling x downsampling tiles.
+        \param  MapSizeX        The width of the map in tiles
+        \param  MapSizeY        The height of the map in tiles
+        \param  scale           The scale factor (pixels per tile) is saved here
+        \param  downsampling    The number of tiles per pixel is saved here (1 for maps up to 128x128)
+        \param  offsetX         The offset in x direction is saved here
+        \param  offsetY         The offset in y direction is saved here
     */
-    static void calculateScaleAndOffsets(int MapSizeX, int MapSizeY, int& scale, int& offsetX, int& offsetY) {
+    static void calculateScaleAndOffsets(int MapSizeX, int MapSizeY, int& scale, int& downsampling, int& offsetX, int& offsetY) {
         scale = 1;
+        downsampling = 1;
         offsetX = 0;
         offsetY = 0;
 
+        while((MapSizeX > 128*downsampling) || (MapSizeY > 128*downsampling)) {
+            downsampling*=2;
+        }
+
         if(MapSizeX <= 32 && MapSizeY <= 32) {
             scale*=2;
         }
@@ -138,8 +151,19 @@ public:
             scale++;
         }
 
-        offsetX = (128 - (MapSizeX*scale))/2;
-        offsetY = (128 - (MapSizeY*scale))/2;
+        offsetX = (128 - getRadarSize(MapSizeX, scale, downsampling))/2;
+        offsetY = (128 - getRadarSize(MapSizeY, scale, downsampling))/2;
+    }
+
+    /**
+        Returns the size in pixels of a map dimension on the radar.
+        \param  mapSize         the width or height of the map in tiles
+        \param  scale           the scale factor (see calculateScaleAndOffsets())
+        \param  downsampling    the number of tiles per pixel (see calculateScaleAndOffsets())
+        \return the width or height on the radar in pixels
+    */
+    static int getRadarSize(int mapSize, int scale, int downsampling) {
+        return (mapSize*scale + downsampling - 1)/downsampling;
     }
 
 
@@ -225,9 +249,141 @@ public:
     }
 
 protected:
+    /**
+        Prepares drawing the tiles of a map with the given size to pSurface. If the map size, the scale or the offsets
+        changed since the last call, pSurface is cleared and all tiles have to be drawn again.
+        \param  pSurface    the radar surface
+        \param  mapSizeX    the width of the map in tiles
+        \param  mapSizeY    the height of the map in tiles
+        \param  scale           the scale factor (see calculateScaleAndOffsets())
+        \param  downsampling    the number of tiles per pixel (see calculateScaleAndOffsets())
+        \param  offsetX         the offset in x direction (see calculateScaleAndOffsets())
+        \param  offsetY         the offset in y direction (see calculateScaleAndOffsets())
+        \return true if all tiles have to be drawn, false if drawing the changed tiles is enough
+    */
+    bool prepareRadarTiles(SDL_Surface* pSurface, int mapSizeX, int mapSizeY, int scale, int downsampling, int offsetX, int offsetY) {
+        if((mapSizeX == radarTilesSizeX) && (mapSizeY == radarTilesSizeY) && (scale == radarTilesScale)
+            && (downsampling == radarTilesDownsampling) && (offsetX == radarTilesOffsetX) && (offsetY == radarTilesOffsetY)) {
+            return false;
+        }
+
+        radarTilesSizeX = mapSizeX;
+        radarTilesSizeY = mapSizeY;
+        radarTilesScale = scale;
+        radarTilesDownsampling = downsampling;
+        radarTilesOffsetX = offsetX;
+        radarTilesOffsetY = offsetY;
+
+        SDL_FillRect(pSurface, nullptr, COLOR_BLACK);
+        radarTileColors.assign(mapSizeX * mapSizeY, MapRGBA(pSurface->format, COLOR_BLACK));
+        dirtyRowLeft.assign(pSurface->h, 0);
+        dirtyRowRight.assign(pSurface->h, pSurface->w);
+        return true;
+    }
+
+    /**
+        Checks if the tile (x,y) is shown on the radar. On downsampled maps only the top left tile of every block
+        is shown; the color of all other tiles does not need to be calculated.
+        \param  x           the x coordinate of the tile
+        \param  y           the y coordinate of the tile
+        \return true if the tile is shown, false otherwise
+    */
+    bool isRadarTileShown(int x, int y) const {
+        return ((x % radarTilesDownsampling) == 0) && ((y % radarTilesDownsampling) == 0);
+    }
+
+    /**
+        Sets the color of the tile (x,y) on the radar. The pixels are only written (and later uploaded by
+        updateRadarTexture()) if the color differs from the last color set for this tile. Tiles that are not shown
+        (see isRadarTileShown()) are ignored. pSurface has to be locked.
+        \param  pSurface    the radar surface
+        \param  x           the x coordinate of the tile
+        \param  y           the y coordinate of the tile
+        \param  color       the color of the tile (as returned by MapRGBA() for the format of pSurface)
+    */
+    void setRadarTileColor(SDL_Surface* pSurface, int x, int y, Uint32 color) {
+        if(!isRadarTileShown(x, y)) {
+            return;
+        }
+
+        Uint32& tileColor = radarTileColors[x * radarTilesSizeY + y];
+        if(tileColor == color) {
+            return;
+        }
+        tileColor = color;
+
+        const int pixelX = radarTilesOffsetX + radarTilesScale*(x / radarTilesDownsampling);
+        const int pixelY = radarTilesOffsetY + radarTilesScale*(y / radarTilesDownsampling);
+
+        for(int j = 0; j < radarTilesScale; j++) {
+            Uint32* p = ((Uint32*) ((Uint8 *) pSurface->pixels + (pixelY + j) * pSurface->pitch)) + pixelX;
+
+            for(int i = 0; i < radarTilesScale; i++, p++) {
+                // Do not use putPixel here to avoid overhead
+                *p = color;
+            }
+        }
+
+        for(int j = pixelY; j < pixelY + radarTilesScale; j++) {
+            if(dirtyRowLeft[j] >= dirtyRowRight[j]) {
+                dirtyRowLeft[j] = pixelX;
+                dirtyRowRight[j] = pixelX + radarTilesScale;
+            } else {
+                dirtyRowLeft[j] = std::min(dirtyRowLeft[j], pixelX);
+                dirtyRowRight[j] = std::max(dirtyRowRight[j], pixelX + radarTilesScale);
+            }
+        }
+    }
+
+    /**
+        Uploads the parts of pSurface changed since the last call to pTexture. Every run of consecutive changed rows
+        is uploaded as one rectangle, so changes far apart (e.g. units in opposite corners) do not upload everything in between.
+        \param  pTexture    the streaming texture to update
+        \param  pSurface    the radar surface
+    */
+    void updateRadarTexture(SDL_Texture* pTexture, SDL_Surface* pSurface) {
+        const int numRows = (int) dirtyRowLeft.size();
+
+        int y = 0;
+        while(y < numRows) {
+            if(dirtyRowLeft[y] >= dirtyRowRight[y]) {
+                y++;
+                continue;
+            }
+
+            SDL_Rect dirtyRect = { dirtyRowLeft[y], y, 0, 0 };
+            int right = dirtyRowRight[y];
+            int bottom = y;
+            while((bottom < numRows) && (dirtyRowLeft[bottom] < dirtyRowRight[bottom])) {
+                dirtyRect.x = std::min(dirtyRect.x, dirtyRowLeft[bottom]);
+                right = std::max(right, dirtyRowRight[bottom]);
+                dirtyRowLeft[bottom] = dirtyRowRight[bottom] = 0;
+                bottom++;
+            }
+            dirtyRect.w = right - dirtyRect.x;
+            dirtyRect.h = bottom - y;
+
+            const Uint8* pPixels = (const Uint8*) pSurface->pixels + dirtyRect.y * pSurface->pitch + dirtyRect.x * pSurface->format->BytesPerPixel;
+            SDL_UpdateTexture(pTexture, &dirtyRect, pPixels, pSurface->pitch);
+
+            y = bottom;
+        }
+    }
+
     std::function<bool (Coord,bool,bool)> pOnRadarClick;  ///< this function is called when the user clicks on the radar (1st parameter is world coordinate; 2nd parameter is whether the right mouse button was pressed; 3rd parameter is whether the mouse was moved while being pressed, e.g. dragging; return value shall be true if dragging should start or continue)
 
     bool bRadarInteraction;                               ///< currently dragging on the radar? (e.g. moving the view rectangle on the radar)
+
+private:
+    std::vector<Uint32> radarTileColors;                  ///< the color last set for each tile by setRadarTileColor()
+    int radarTilesSizeX = 0;                              ///< the map width radarTileColors was prepared for
+    int radarTilesSizeY = 0;                              ///< the map height radarTileColors was prepared for
+    int radarTilesScale = 0;                              ///< the scale radarTileColors was prepared for
+    int radarTilesDownsampling = 1;                       ///< the downsampling radarTileColors was prepared for
+    int radarTilesOffsetX = 0;                            ///< the offset in x direction radarTileColors was prepared for
+    int radarTilesOffsetY = 0;                            ///< the offset in y direction radarTileColors was prepared for
+    std::vector<int> dirtyRowLeft;                        ///< for every row of the radar surface the first pixel changed since the last updateRadarTexture()
+    std::vector<int> dirtyRowRight;                       ///< for every row of the radar surface the pixel after the last changed one (equal to dirtyRowLeft if unchanged)
 };
 
 #endif // RADARVIEWBASE_H
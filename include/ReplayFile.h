@@ -0,0 +1,93 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef REPLAYFILE_H
+#define REPLAYFILE_H
+
+#include <Definitions.h>
+#include <misc/SDL2pp.h>
+
+#include <memory>
+#include <string>
+
+class InputStream;
+class OutputStream;
+class GameInitSettings;
+class CommandManager;
+
+#define REPLAYMAGIC             0x32504C52              ///< "RPL2"; too large for the length of the player name at the beginning of the old format
+#define REPLAYVERSION           1                       ///< increase whenever the replay file format changes
+#define REPLAY_CHUNKCYCLES      MILLI2CYCLES(60*1000)   ///< the commands of this many game cycles are compressed together
+
+/**
+    The part of a replay file that can be read without decompressing anything (see ReplayFile::readMetadata()).
+*/
+struct ReplayMetadata {
+    std::string localPlayerName;    ///< the name of the local player when the replay was recorded
+    std::string mapFilename;        ///< the map the game was played on
+    std::string duneVersion;        ///< the version of Dune Legacy that recorded the replay
+    Uint32 numGameCycles = 0;       ///< the number of game cycles recorded
+    Uint32 numCommands = 0;         ///< the number of recorded commands
+};
+
+/**
+    Reads and writes replay files. The format is
+    <pre>
+    REPLAYMAGIC, REPLAYVERSION
+    metadata (see ReplayMetadata)
+    number of chunks, for every chunk: first game cycle, number of commands (the index)
+    compressed GameInitSettings
+    for every chunk: the compressed commands of up to REPLAY_CHUNKCYCLES game cycles
+    </pre>
+    The old format (local player name, GameInitSettings and the uncompressed commands) is still read. The live
+    recording of "auto.rpl" and the broadcast header use the old format, as they are written while the game is running.
+*/
+class ReplayFile {
+public:
+    /**
+        Writes a replay.
+        \param  stream              the stream to write to
+        \param  localPlayerName     the name of the local player
+        \param  numGameCycles       the number of game cycles played
+        \param  gameInitSettings    the settings the game was started with
+        \param  cmdManager          all commands of the game
+    */
+    static void save(OutputStream& stream, const std::string& localPlayerName, Uint32 numGameCycles, const GameInitSettings& gameInitSettings, const CommandManager& cmdManager);
+
+    /**
+        Reads the metadata of a replay file.
+        \param  filename    the replay file
+        \param  metadata    the metadata read
+        \return true on success, false if the file cannot be read or is in the old format (which has no metadata)
+    */
+    static bool readMetadata(const std::string& filename, ReplayMetadata& metadata);
+
+    /**
+        Reads a replay file in either format.
+        \param  filename            the replay file
+        \param  localPlayerName     the name of the local player when the replay was recorded
+        \param  cmdManager          all recorded commands are added to it
+        \return the settings the game was started with
+    */
+    static std::unique_ptr<GameInitSettings> load(const std::string& filename, std::string& localPlayerName, CommandManager& cmdManager);
+
+private:
+    static ReplayMetadata readMetadata(InputStream& stream);
+};
+
+#endif // REPLAYFILE_H
@@ -0,0 +1,88 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REPLAYKEYFRAMES_H
+#define REPLAYKEYFRAMES_H
+
+#include <Definitions.h>
+#include <misc/SDL2pp.h>
+
+#include <map>
+#include <string>
+
+#define REPLAY_KEYFRAME_INTERVAL    MILLI2CYCLES(30*1000)   ///< game cycles between two keyframes of a replay
+#define REPLAY_KEYFRAME_MIN_GAIN    MILLI2CYCLES(10*1000)   ///< only restore a keyframe ahead of the current game cycle if it saves at least this many cycles
+#define REPLAY_KEYFRAME_MAX_DELTAS  9                       ///< the number of keyframes stored as delta to the same complete keyframe
+
+/**
+    The in-memory snapshots ("keyframes") taken while a replay is played back. Every keyframe is a save game
+    (see Game::saveGame()) of the state at the beginning of its game cycle, so seeking to a game cycle only needs to load
+    the closest keyframe before it and simulate the remaining cycles. Most keyframes are only stored as a SnapshotDelta
+    to the closest complete keyframe before them.
+*/
+class ReplayKeyframes {
+public:
+    ReplayKeyframes() = default;
+    ReplayKeyframes(const ReplayKeyframes &) = delete;
+    ReplayKeyframes& operator=(const ReplayKeyframes &) = delete;
+
+    /**
+        Adds a keyframe. An existing keyframe for the same game cycle is kept.
+        \param  gameCycle   the game cycle the snapshot was taken at
+        \param  snapshot    the save game data
+    */
+    void add(Uint32 gameCycle, std::string&& snapshot);
+
+    /**
+        Is there a keyframe for this game cycle?
+        \param  gameCycle   the game cycle to check
+        \return true if there is a keyframe, false otherwise
+    */
+    bool has(Uint32 gameCycle) const { return keyframes.count(gameCycle) > 0; }
+
+    /**
+        Returns the game cycle of the latest keyframe at or before gameCycle.
+        \param  gameCycle   the game cycle to look for
+        \return the game cycle of the keyframe or INVALID_GAMECYCLE if there is none
+    */
+    Uint32 findKeyframeBefore(Uint32 gameCycle) const;
+
+    /**
+        Returns the snapshot taken at gameCycle.
+        \param  gameCycle   the game cycle of the keyframe (must exist)
+        \return the save game data
+    */
+    std::string getSnapshot(Uint32 gameCycle) const;
+
+    /**
+        Returns the memory used by all snapshots.
+        \return the size in bytes
+    */
+    size_t getTotalSize() const { return totalSize; }
+
+private:
+    struct Keyframe {
+        Uint32      baseGameCycle;  ///< the game cycle of the keyframe data is a delta to (INVALID_GAMECYCLE if data is the complete snapshot)
+        int         numDeltas;      ///< the number of keyframes that are stored as delta to this keyframe
+        std::string data;           ///< the snapshot or the delta
+    };
+
+    std::map<Uint32, Keyframe> keyframes;       ///< the keyframes by game cycle
+    size_t totalSize = 0;                       ///< the sum of the sizes of all stored snapshots and deltas
+};
+
+#endif // REPLAYKEYFRAMES_H
@@ -0,0 +1,90 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REPLAYVERIFIER_H
+#define REPLAYVERIFIER_H
+
+#include <misc/SDL2pp.h>
+
+#include <string>
+
+/**
+    The outcome of simulating a replay in headless mode (see Game::setHeadless()).
+*/
+struct ReplayResult {
+    std::string filename;           ///< the name of the replay file (without directory)
+    std::string result;             ///< "won", "lost", "stopped" (before the game was finished) or "error" (replay could not be simulated)
+    Uint32 gameCycles = 0;          ///< the game cycle the simulation ended at
+    Uint32 randomSeed = 0;          ///< the seed of the game's random generator at the end
+    std::string checksum;           ///< md5 of the saved final game state as hex string
+    Uint32 firstDesyncGameCycle;    ///< the first game cycle the simulation did not match the recorded state (INVALID_GAMECYCLE if in sync)
+    Uint32 numDesyncs = 0;          ///< how often the simulation did not match the recorded state
+    Uint32 elapsedTime = 0;         ///< the time needed for the simulation in ms
+
+    ReplayResult();
+
+    /**
+        Returns the simulation throughput.
+        \return the simulated game cycles per second
+    */
+    Uint32 getCyclesPerSecond() const;
+
+    /**
+        Formats this result as one line of the verifier's csv output (see getCSVHeader()).
+        \return the csv line without line break
+    */
+    std::string toCSV() const;
+
+    /**
+        Returns the header line of the verifier's csv output.
+        \return the csv line without line break
+    */
+    static const char* getCSVHeader();
+};
+
+class Game;
+
+/**
+    Computes a checksum over the complete state of a game by saving it to memory.
+    \param  pGame   the game to compute the checksum for
+    \return the md5 of the save game as hex string
+*/
+std::string getGameStateChecksum(Game* pGame);
+
+/**
+    Simulates a replay in headless mode until it is finished or maxGameCycle is reached.
+    \param  filename        the filename of the replay file
+    \param  maxGameCycle    the replay is stopped at this game cycle (0 = shortly after the last recorded command)
+    \return the outcome of the simulation
+*/
+ReplayResult simulateReplay(const std::string& filename, Uint32 maxGameCycle = 0);
+
+/**
+    Simulates all replays (*.rpl) in a directory one after the other and prints one csv line with the
+    final checksum, desyncs and cycles per second for each of them to stdout. This output can be saved and passed as
+    referenceFile to a later run to check that the simulation of every replay still ends in exactly the same state.
+    The replays can be split into shards to verify them with several processes in parallel.
+    \param  directory       the directory containing the replays
+    \param  referenceFile   the csv output of an earlier run to compare against (empty = no comparison)
+    \param  shardIndex      only simulate the replays with (index % numShards) == shardIndex
+    \param  numShards       the number of shards the replays are split into
+    \param  maxGameCycle    every replay is stopped at this game cycle (0 = shortly after its last recorded command)
+    \return true if all replays could be simulated, are in sync and match the reference, false otherwise
+*/
+bool verifyReplays(const std::string& directory, const std::string& referenceFile = "", int shardIndex = 0, int numShards = 1, Uint32 maxGameCycle = 0);
+
+#endif // REPLAYVERIFIER_H
@@ -0,0 +1,103 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SANDWORMPREYINDEX_H
+#define SANDWORMPREYINDEX_H
+
+#include <DataTypes.h>
+#include <Definitions.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+/**
+    The IDs of all ground units that stand on sand, grouped by the sand region (see Map::createSandRegions()) of
+    their location. A sandworm can only reach units in its own sand region, so its target search only has to look at
+    the units listed for that region instead of all units. Units are moved between the regions when their location
+    changes; tiles that turn into rock are not tracked, so an entry may be outdated and has to be checked by the worm.
+    The index is not saved but rebuilt from the units on the map after loading.
+*/
+class SandwormPreyIndex {
+public:
+    SandwormPreyIndex() = default;
+
+    SandwormPreyIndex(const SandwormPreyIndex &) = delete;
+    SandwormPreyIndex(SandwormPreyIndex &&) = delete;
+    SandwormPreyIndex& operator=(const SandwormPreyIndex &) = delete;
+    SandwormPreyIndex& operator=(SandwormPreyIndex &&) = delete;
+
+    /**
+        Removes all units.
+    */
+    void reset() {
+        regions.clear();
+        regionOfObject.clear();
+    }
+
+    /**
+        Lists objectID under sandRegion and removes it from the region it was listed under before.
+        \param  objectID    the id of the unit
+        \param  sandRegion  the sand region of the unit's location or NONE_ID to remove the unit
+    */
+    void setRegion(Uint32 objectID, Uint32 sandRegion) {
+        auto iter = regionOfObject.find(objectID);
+        const Uint32 oldRegion = (iter != regionOfObject.end()) ? iter->second : NONE_ID;
+        if(oldRegion == sandRegion) {
+            return;
+        }
+
+        if(oldRegion != NONE_ID) {
+            std::vector<Uint32>& units = regions[oldRegion];
+            auto unitIter = std::find(units.begin(), units.end(), objectID);
+            if(unitIter != units.end()) {
+                *unitIter = units.back();
+                units.pop_back();
+            }
+        }
+
+        if(sandRegion == NONE_ID) {
+            regionOfObject.erase(iter);
+        } else {
+            if(sandRegion >= regions.size()) {
+                regions.resize(sandRegion + 1);
+            }
+            regions[sandRegion].push_back(objectID);
+            regionOfObject[objectID] = sandRegion;
+        }
+    }
+
+    /**
+        Calls f(objectID) for every unit listed under sandRegion (in no particular order).
+        \param  sandRegion  the sand region
+        \param  f           the function to call
+    */
+    template<typename F>
+    void forEachInRegion(Uint32 sandRegion, F&& f) const {
+        if(sandRegion < regions.size()) {
+            for(Uint32 objectID : regions[sandRegion]) {
+                f(objectID);
+            }
+        }
+    }
+
+private:
+    std::vector<std::vector<Uint32>> regions;           ///< the ids of the units in each sand region
+    std::unordered_map<Uint32, Uint32> regionOfObject;  ///< the region each listed unit is listed under
+};
+
+#endif // SANDWORMPREYINDEX_H
@@ -333,6 +333,14 @@ public:
                 && zoomedWorld2world(y) >= topLeftCornerOnScreen.y  && zoomedWorld2world(y) < bottomRightCornerOnScreen.y);
     }
 
+    /**
+        Returns the rectangle on the screen where the map is shown.
+        \return the game board rectangle in screen coordinates
+    */
+    inline const SDL_Rect& getGameBoard() const {
+        return gameBoardRect;
+    }
+
     /**
         This method adjusts the screen border to the current map size.
         \param newMapSizeX         the number of map tiles in x direction
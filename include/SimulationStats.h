@@ -0,0 +1,180 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMULATIONSTATS_H
+#define SIMULATIONSTATS_H
+
+#include <DataTypes.h>
+
+#include <array>
+#include <vector>
+
+/// The hot path events of the simulation counted by SimulationStats
+enum SimulationCounter {
+    SimulationCounter_PathNodesExpanded,        ///< nodes expanded by AStarSearch
+    SimulationCounter_PathSearchesAborted,      ///< AStarSearch runs stopped at MAX_NODES_CHECKED
+    SimulationCounter_TargetTilesScanned,       ///< tiles looked at by ObjectBase::findTarget()
+    SimulationCounter_GetObjectCalls,           ///< calls of ObjectManager::getObject()
+    SimulationCounter_DamageCandidates,         ///< objects considered by Map::damage()
+    SimulationCounter_EntityListIterators,      ///< loops started over the unit and structure lists (EntityList)
+    NUM_SIMULATIONCOUNTERS
+};
+
+/**
+    Counts hot path events of the simulation per game cycle and per house to find the behaviours that take up the CPU.
+    Every thread counts into its own block without any synchronization; endCycle() collects all blocks while no
+    worker thread is running. Events are attributed to an explicitly passed house or otherwise to the house the
+    calling thread currently simulates (see HouseScope); events outside of any house are counted for HOUSE_INVALID.
+
+    The counting (see COUNT_SIMULATION_EVENT) is only compiled in if PROFILING is defined (configure --enable-profiling).
+    As the blocks are shared by all threads only one game may be simulated at a time while counting.
+*/
+class SimulationStats {
+public:
+    /**
+        Attributes all events counted by the calling thread to a house while this object exists.
+    */
+    class HouseScope {
+    public:
+        explicit HouseScope(int houseID) : previousHouseIndex(currentHouseIndex) {
+            currentHouseIndex = toIndex(houseID);
+        }
+
+        HouseScope(const HouseScope &) = delete;
+        HouseScope& operator=(const HouseScope &) = delete;
+
+        ~HouseScope() {
+            currentHouseIndex = previousHouseIndex;
+        }
+
+    private:
+        int previousHouseIndex;     ///< the house index to restore
+    };
+
+    SimulationStats() = default;
+
+    /**
+        Counts events for the house the calling thread currently simulates.
+        \param  counter the kind of event
+        \param  n       the number of events
+    */
+    static void count(SimulationCounter counter, Uint32 n = 1) {
+        threadCounts.counts[currentHouseIndex][counter] += n;
+    }
+
+    /**
+        Counts events for a house.
+        \param  counter the kind of event
+        \param  n       the number of events
+        \param  houseID the house causing the events (HOUSE_INVALID for none)
+    */
+    static void count(SimulationCounter counter, Uint32 n, int houseID) {
+        threadCounts.counts[toIndex(houseID)][counter] += n;
+    }
+
+    /**
+        Collects the events of all threads as the events of the game cycle that just ended.
+    */
+    void endCycle();
+
+    /**
+        Returns the number of events counted in the last game cycle.
+        \param  counter the kind of event
+        \param  houseID the house (HOUSE_INVALID for the events outside of any house)
+        \return the number of events
+    */
+    Uint64 getLastCycle(SimulationCounter counter, int houseID) const {
+        return lastCycle[toIndex(houseID)][counter];
+    }
+
+    /**
+        Returns the number of events of all houses counted in the last game cycle.
+        \param  counter the kind of event
+        \return the number of events
+    */
+    Uint64 getLastCycle(SimulationCounter counter) const;
+
+    /**
+        Returns the number of events counted since the game started.
+        \param  counter the kind of event
+        \param  houseID the house (HOUSE_INVALID for the events outside of any house)
+        \return the number of events
+    */
+    Uint64 getTotal(SimulationCounter counter, int houseID) const {
+        return total[toIndex(houseID)][counter];
+    }
+
+    /**
+        Returns the number of events of all houses counted since the game started.
+        \param  counter the kind of event
+        \return the number of events
+    */
+    Uint64 getTotal(SimulationCounter counter) const;
+
+    /**
+        Returns the number of game cycles counted so far.
+        \return the number of calls of endCycle()
+    */
+    Uint32 getNumCycles() const { return numCycles; }
+
+    /**
+        Writes the totals and averages per game cycle of all counters and houses to the log.
+    */
+    void logTotals() const;
+
+    /**
+        Returns the name of a counter.
+        \param  counter the kind of event
+        \return the name
+    */
+    static const char* getCounterName(SimulationCounter counter);
+
+private:
+    static constexpr int NUM_HOUSEINDICES = NUM_HOUSES + 1;     ///< index NUM_HOUSES is used for HOUSE_INVALID
+
+    typedef std::array<std::array<Uint64, NUM_SIMULATIONCOUNTERS>, NUM_HOUSEINDICES> Counts;
+
+    /// The events counted by one thread since the last endCycle(); registers itself in allThreadCounts
+    struct ThreadCounts {
+        ThreadCounts();
+        ~ThreadCounts();
+
+        Counts counts = {};
+    };
+
+    static int toIndex(int houseID) {
+        return ((houseID >= 0) && (houseID < NUM_HOUSES)) ? houseID : NUM_HOUSES;
+    }
+
+    static thread_local ThreadCounts threadCounts;          ///< the events of the calling thread
+    static thread_local int currentHouseIndex;              ///< the house the calling thread currently simulates
+    static std::vector<ThreadCounts*> allThreadCounts;      ///< the counts of all running threads
+
+    Counts lastCycle = {};          ///< the events of the last game cycle
+    Counts total = {};              ///< the events of all game cycles
+    Uint32 numCycles = 0;           ///< the number of game cycles counted
+};
+
+#ifdef PROFILING
+#define COUNT_SIMULATION_EVENT(...) SimulationStats::count(__VA_ARGS__)
+#define SIMULATION_STATS_HOUSE(houseID) SimulationStats::HouseScope simulationStatsHouseScope(houseID)
+#else
+#define COUNT_SIMULATION_EVENT(...)
+#define SIMULATION_STATS_HOUSE(houseID)
+#endif
+
+#endif // SIMULATIONSTATS_H
@@ -0,0 +1,62 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SNAPSHOTDELTA_H
+#define SNAPSHOTDELTA_H
+
+#include <misc/SDL2pp.h>
+
+#include <string>
+
+#define SNAPSHOTDELTA_MAGIC             0x544C4444              ///< marks the beginning of a delta
+#define SNAPSHOTDELTA_MIN_CHUNK_SIZE    64                      ///< the minimum size of a chunk compared between two snapshots
+#define SNAPSHOTDELTA_MAX_CHUNK_SIZE    (16*1024)               ///< the maximum size of a chunk compared between two snapshots
+#define SNAPSHOTDELTA_CHUNK_MASK        0x3FF                   ///< a chunk ends where the rolling hash has these bits cleared (about 1 KiB chunks)
+
+/**
+    Computes the difference between two snapshots of the game state (see Game::saveGame()). Both snapshots are split
+    into chunks at positions determined by their content, so an object that is only moved to a different position in
+    the snapshot (e.g. because an object before it was removed) is still found. Chunks of the target that also occur
+    in the base are stored as references, all other chunks are stored as they are.
+*/
+class SnapshotDelta {
+public:
+    /**
+        Computes the delta that turns base into target.
+        \param  base    the snapshot the delta is relative to
+        \param  target  the snapshot to reconstruct with apply()
+        \return the delta
+    */
+    static std::string create(const std::string& base, const std::string& target);
+
+    /**
+        Reconstructs the target snapshot from the base snapshot and a delta created by create(). Throws
+        std::invalid_argument if the delta is corrupt or was not created for base.
+        \param  base    the snapshot the delta is relative to
+        \param  delta   the delta
+        \return the target snapshot
+    */
+    static std::string apply(const std::string& base, const std::string& delta);
+
+    /**
+        Returns the hash of a snapshot that is stored in every delta to identify its base.
+        \param  data    the snapshot
+        \return the FNV-1a hash of data
+    */
+    static Uint32 hash(const std::string& data);
+};
+
+#endif // SNAPSHOTDELTA_H
@@ -22,6 +22,11 @@
 
 #include <SDL2/SDL_mixer.h>
 
+#include <array>
+
+#define SOUNDPLAYER_NUM_CHANNELS            24  ///< the number of reserved and grouped mixer channels
+#define SOUNDPLAYER_MAX_INSTANCES_PER_SOUND 2   ///< how many channels may play the same located sound at once
+
 // forward declaration
 class Coord;
 
@@ -41,11 +46,26 @@ public:
         plays a certain sound at certain coordinates.
         the volume of sound depends on the difference between
         location of the sound and if location is explored.
+        The sound is only queued, all identical sounds queued until the next
+        call of playQueuedSounds() are played once with their combined volume.
         @param soundID id of the sound to be played
         @param location coordinates where the sound is to be played
     */
     void playSoundAt(Sound_enum soundID, const Coord& location);
 
+    /*!
+        Plays the sounds queued by playSoundAt(). Should be called once per frame.
+        Each sound is started at most once and at most SOUNDPLAYER_MAX_INSTANCES_PER_SOUND
+        channels play the same sound. If its channel group is full, the quietest
+        channel of the group is stopped if it is quieter than the new sound.
+    */
+    void playQueuedSounds();
+
+    /*!
+        Discards the sounds queued by playSoundAt(), e.g. when a new game starts.
+    */
+    void clearQueuedSounds();
+
     /*!
         Toggle the sound on and off
     */
@@ -90,9 +110,19 @@ private:
         Rocket,
         Scream,
         Sonic,
-        Other
+        Other,
+        NumGroups
+    };
+
+    //! the channels [first;last] of a channel group
+    struct ChannelRange {
+        int first;
+        int last;
     };
 
+    //! the channel ranges indexed by ChannelGroup
+    static const ChannelRange channelRanges[static_cast<int>(ChannelGroup::NumGroups)];
+
     /*!
         the function plays a sound with a given volume
         @param soundID id of a sound to be played
@@ -100,6 +130,42 @@ private:
     */
     void playSound(Sound_enum soundID, int volume);
 
+    /*!
+        Finds a channel of group for soundID, respecting SOUNDPLAYER_MAX_INSTANCES_PER_SOUND and
+        stopping a quieter channel if necessary.
+        @param soundID  id of the sound to be played
+        @param group    the channel group of the sound
+        @param volume   the volume the sound will be played with
+        @return the channel to play the sound on or -1 if the sound should be dropped
+    */
+    int findChannel(Sound_enum soundID, ChannelGroup group, int volume);
+
+    /*!
+        Starts playing a sound and remembers which sound plays on the channel.
+        @param soundID  id of the sound to be played
+        @param channel  the channel to play on (-1 = the first free channel)
+        @param volume   the volume to play with
+    */
+    void startSound(Sound_enum soundID, int channel, int volume);
+
+    static ChannelGroup getChannelGroup(Sound_enum soundID);
+
+    //! a sound that was queued by playSoundAt() once or more
+    struct QueuedSound {
+        int count = 0;                  ///< how often the sound was queued
+        int maxVolume = 0;              ///< the loudest of these sounds
+        int sumVolume = 0;              ///< the sum of the volumes of these sounds
+    };
+
+    //! the sounds queued by playSoundAt() since the last playQueuedSounds()
+    std::array<QueuedSound, NUM_SOUNDCHUNK> queuedSounds;
+
+    //! the sound each channel was started with (NUM_SOUNDCHUNK if none)
+    std::array<Sound_enum, SOUNDPLAYER_NUM_CHANNELS> channelSounds;
+
+    //! the volume each channel was started with
+    std::array<int, SOUNDPLAYER_NUM_CHANNELS> channelVolumes;
+
     //! whether sound should be played
     bool    soundOn;
 
@@ -0,0 +1,137 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPATIALOBJECTINDEX_H
+#define SPATIALOBJECTINDEX_H
+
+#include <DataTypes.h>
+
+#include <algorithm>
+#include <vector>
+
+#define SPATIALINDEX_CELLSIZE   8   ///< width and height of one cell in tiles
+
+/**
+    A uniform grid over the map with the IDs of all ground and underground objects (units and structures) in each cell.
+    It is maintained by Tile when objects are assigned to/unassigned from tiles and is used to find the closest targets
+    by searching ring by ring around the searching object instead of iterating over all units and structures.
+    Air units are not stored as they can never be the target of findClosestTarget().
+*/
+class SpatialObjectIndex {
+public:
+    SpatialObjectIndex() = default;
+
+    SpatialObjectIndex(const SpatialObjectIndex &) = delete;
+    SpatialObjectIndex(SpatialObjectIndex &&) = delete;
+    SpatialObjectIndex& operator=(const SpatialObjectIndex &) = delete;
+    SpatialObjectIndex& operator=(SpatialObjectIndex &&) = delete;
+
+    /**
+        Removes all objects and resizes the grid to a map of the given size.
+        \param  mapSizeX    the width of the map
+        \param  mapSizeY    the height of the map
+    */
+    void reset(int mapSizeX, int mapSizeY) {
+        numCellsX = (mapSizeX + SPATIALINDEX_CELLSIZE - 1) / SPATIALINDEX_CELLSIZE;
+        numCellsY = (mapSizeY + SPATIALINDEX_CELLSIZE - 1) / SPATIALINDEX_CELLSIZE;
+        cells.clear();
+        cells.resize(numCellsX*numCellsY);
+    }
+
+    /**
+        Adds one occurrence of objectID at the tile location.
+    */
+    void add(const Coord& location, Uint32 objectID) {
+        if(isInside(location)) {
+            cells[getCellIndex(location)].push_back(objectID);
+        }
+    }
+
+    /**
+        Removes num occurrences of objectID at the tile location.
+    */
+    void remove(const Coord& location, Uint32 objectID, size_t num = 1) {
+        if(isInside(location)) {
+            std::vector<Uint32>& cell = cells[getCellIndex(location)];
+            for(size_t i = 0; i < num; i++) {
+                auto iter = std::find(cell.begin(), cell.end(), objectID);
+                if(iter == cell.end()) {
+                    break;
+                }
+                *iter = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+
+    /**
+        Calls f(objectID) for every object in the cells that have a chebyshev distance (in cells) of ring to the cell containing location.
+        An object may be reported more than once.
+        \param  location    the tile to search around
+        \param  ring        the ring to search (0 = the cell containing location)
+        \param  f           the function to call
+        \return false if the ring is completely outside the map, true otherwise
+    */
+    template<typename F>
+    bool forEachInRing(const Coord& location, int ring, F&& f) const {
+        const int centerX = location.x / SPATIALINDEX_CELLSIZE;
+        const int centerY = location.y / SPATIALINDEX_CELLSIZE;
+
+        if((centerX - ring < 0) && (centerY - ring < 0) && (centerX + ring >= numCellsX) && (centerY + ring >= numCellsY)) {
+            return false;
+        }
+
+        for(int cy = std::max(0, centerY - ring); cy <= std::min(numCellsY - 1, centerY + ring); cy++) {
+            const bool bBorderRow = (cy == centerY - ring) || (cy == centerY + ring);
+            for(int cx = std::max(0, centerX - ring); cx <= std::min(numCellsX - 1, centerX + ring); cx++) {
+                if(!bBorderRow && (cx != centerX - ring) && (cx != centerX + ring)) {
+                    continue;
+                }
+
+                for(Uint32 objectID : cells[cy*numCellsX + cx]) {
+                    f(objectID);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    /**
+        Objects in ring r+1 or beyond have at least this tile distance from the searching location.
+        \param  ring    the last ring that was searched
+        \return the minimum distance of all objects not found yet
+    */
+    static int getMinimumDistanceBeyond(int ring) noexcept {
+        return ring*SPATIALINDEX_CELLSIZE + 1;
+    }
+
+private:
+    bool isInside(const Coord& location) const noexcept {
+        return (location.x >= 0) && (location.y >= 0) && (location.x / SPATIALINDEX_CELLSIZE < numCellsX) && (location.y / SPATIALINDEX_CELLSIZE < numCellsY);
+    }
+
+    int getCellIndex(const Coord& location) const noexcept {
+        return (location.y / SPATIALINDEX_CELLSIZE)*numCellsX + (location.x / SPATIALINDEX_CELLSIZE);
+    }
+
+    int numCellsX = 0;                          ///< number of cells in x direction
+    int numCellsY = 0;                          ///< number of cells in y direction
+    std::vector<std::vector<Uint32>> cells;     ///< the object IDs in each cell
+};
+
+#endif // SPATIALOBJECTINDEX_H
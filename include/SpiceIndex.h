@@ -0,0 +1,115 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPICEINDEX_H
+#define SPICEINDEX_H
+
+#include <DataTypes.h>
+#include <fixmath/FixPoint.h>
+
+#include <vector>
+
+#define SPICEINDEX_CHUNKSIZE    8   ///< width and height of one chunk in tiles
+
+/**
+    Summary of the spice on a map. The map is divided into chunks of SPICEINDEX_CHUNKSIZE x SPICEINDEX_CHUNKSIZE tiles
+    and for every chunk the total amount of spice and the number of tiles with spice are kept up to date by Tile.
+    Searching spice can thus skip all empty chunks instead of looking at every tile.
+*/
+class SpiceIndex {
+public:
+    SpiceIndex() = default;
+
+    SpiceIndex(const SpiceIndex &) = delete;
+    SpiceIndex(SpiceIndex &&) = delete;
+    SpiceIndex& operator=(const SpiceIndex &) = delete;
+    SpiceIndex& operator=(SpiceIndex &&) = delete;
+
+    /**
+        Resizes the index to a map of the given size without any spice.
+        \param  sizeX   the width of the map in tiles
+        \param  sizeY   the height of the map in tiles
+    */
+    void reset(int sizeX, int sizeY) {
+        numChunksX = (sizeX + SPICEINDEX_CHUNKSIZE - 1) / SPICEINDEX_CHUNKSIZE;
+        numChunksY = (sizeY + SPICEINDEX_CHUNKSIZE - 1) / SPICEINDEX_CHUNKSIZE;
+        chunks.assign(numChunksX * numChunksY, Chunk());
+        spiceHash = 0;
+    }
+
+    /**
+        Has to be called whenever the amount of spice of a tile changes.
+        \param  location    the location of the tile
+        \param  oldSpice    the amount of spice before the change
+        \param  newSpice    the amount of spice after the change
+    */
+    void spiceChanged(const Coord& location, FixPoint oldSpice, FixPoint newSpice) {
+        Chunk& chunk = chunks[getChunkIndex(location.x / SPICEINDEX_CHUNKSIZE, location.y / SPICEINDEX_CHUNKSIZE)];
+        chunk.totalSpice += newSpice - oldSpice;
+        chunk.numSpiceTiles += ((newSpice > 0) ? 1 : 0) - ((oldSpice > 0) ? 1 : 0);
+        spiceHash += getTileSpiceHash(location, newSpice) - getTileSpiceHash(location, oldSpice);
+    }
+
+    int getNumChunksX() const noexcept { return numChunksX; }
+    int getNumChunksY() const noexcept { return numChunksY; }
+
+    /**
+        Returns the total amount of spice in chunk (chunkX, chunkY).
+    */
+    FixPoint getSpice(int chunkX, int chunkY) const { return chunks[getChunkIndex(chunkX, chunkY)].totalSpice; }
+
+    /**
+        Returns the number of tiles with spice in chunk (chunkX, chunkY).
+    */
+    int getNumSpiceTiles(int chunkX, int chunkY) const { return chunks[getChunkIndex(chunkX, chunkY)].numSpiceTiles; }
+
+    /**
+        Returns a hash of the spice on all tiles. As the hashes of the single tiles are summed up it is kept up to date
+        by spiceChanged() without looking at the whole map (see StateHashes).
+    */
+    Uint32 getSpiceHash() const noexcept { return spiceHash; }
+
+private:
+    struct Chunk {
+        FixPoint    totalSpice = 0;     ///< sum of the spice of all tiles in this chunk
+        int         numSpiceTiles = 0;  ///< number of tiles with spice in this chunk
+    };
+
+    int getChunkIndex(int chunkX, int chunkY) const noexcept { return chunkY * numChunksX + chunkX; }
+
+    static Uint32 getTileSpiceHash(const Coord& location, FixPoint spice) noexcept {
+        if(spice == 0) {
+            return 0;
+        }
+
+        Uint64 rawSpice = (Uint64) spice.getRawValue();
+        Uint32 h = ((Uint32) location.x * 73856093u) ^ ((Uint32) location.y * 19349663u) ^ (Uint32) rawSpice ^ ((Uint32) (rawSpice >> 32) * 83492791u);
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        h *= 0xC2B2AE35u;
+        h ^= h >> 16;
+        return h;
+    }
+
+    int numChunksX = 0;             ///< number of chunks in x direction
+    int numChunksY = 0;             ///< number of chunks in y direction
+    std::vector<Chunk> chunks;      ///< the chunks row by row
+    Uint32 spiceHash = 0;           ///< sum of getTileSpiceHash() of all tiles
+};
+
+#endif // SPICEINDEX_H
@@ -0,0 +1,87 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATEHASHES_H
+#define STATEHASHES_H
+
+#include <misc/SDL2pp.h>
+#include <Definitions.h>
+
+#include <string>
+#include <vector>
+
+#define STATEHASH_INTERVAL          MILLI2CYCLES(2000)      ///< every peer sends its state hashes every STATEHASH_INTERVAL game cycles
+#define STATEHASH_HISTORY_LENGTH    MILLI2CYCLES(15000)     ///< how long the own hashes are kept to compare them with the ones of the other peers
+
+class ObjectBase;
+
+/**
+    Hashes of the simulation state of every subsystem. Peers exchange them with CMD_TEST_STATEHASH, so a desync is
+    noticed at most STATEHASH_INTERVAL game cycles after it happened and the mismatching subsystems show where to look.
+    The spice hash is maintained by SpiceIndex whenever the spice of a tile changes, all other hashes only look at a
+    few fields of every object instead of the complete saved game.
+*/
+struct StateHashes {
+    Uint32 units = 0;           ///< hash of all units
+    Uint32 structures = 0;      ///< hash of all structures
+    Uint32 houses = 0;          ///< hash of all houses
+    Uint32 spice = 0;           ///< hash of the spice on the map
+
+    /**
+        Computes the hashes of the current game.
+        \return the hashes
+    */
+    static StateHashes compute();
+
+    /**
+        Creates the hashes from the parameters of a CMD_TEST_STATEHASH command (without the game cycle).
+        \param  parameters  the four hashes
+    */
+    static StateHashes fromParameters(const std::vector<Uint32>& parameters);
+
+    /**
+        Returns the parameters for a CMD_TEST_STATEHASH command.
+        \param  gameCycle   the game cycle the hashes were computed at
+        \return the game cycle followed by the four hashes
+    */
+    std::vector<Uint32> toParameters(Uint32 gameCycle) const;
+
+    /**
+        Returns the names of all subsystems whose hashes differ.
+        \param  other   the hashes to compare with
+        \return a comma separated list (empty if all hashes match)
+    */
+    std::string getMismatchingSubsystems(const StateHashes& other) const;
+
+    bool operator==(const StateHashes& other) const {
+        return (units == other.units) && (structures == other.structures) && (houses == other.houses) && (spice == other.spice);
+    }
+
+    bool operator!=(const StateHashes& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+    Writes the state that goes into the StateHashes as text, one line per house, unit, structure and spice chunk.
+    All peers write it in the same game cycle, so the files of two peers can be compared with diff.
+    \param  filename    the file to write to
+    \return true on success, false otherwise
+*/
+bool writeStateSnapshot(const std::string& filename);
+
+#endif // STATEHASHES_H
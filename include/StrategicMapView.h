@@ -0,0 +1,77 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef STRATEGICMAPVIEW_H
+#define STRATEGICMAPVIEW_H
+
+#include <misc/PrimitiveBatcher.h>
+#include <misc/SDL2pp.h>
+#include <DataTypes.h>
+
+#define STRATEGICMAPVIEW_MAX_TILESIZE       16  ///< pixels per tile the strategic map view never exceeds (the size of zoom level 0)
+#define STRATEGICMAPVIEW_MIN_MARKERSIZE     2   ///< minimum width and height of the marker of a unit or structure in pixels
+#define STRATEGICMAPVIEW_SHROUD_ROWS        32  ///< rows of tiles whose shroud and fog is refreshed per frame
+
+class TerrainChunkCache;
+
+/**
+    Shows the whole map scaled to the game board. Instead of the sprites of the normal view the ground is drawn from the
+    downsampled chunks of the TerrainChunkCache, units and structures are drawn as radar-like markers in the color of
+    their house (all of one color with a single call) and the shroud and fog come from a texture with one pixel per
+    tile, of which only STRATEGICMAPVIEW_SHROUD_ROWS rows are refreshed per frame. So the cost of a frame depends on
+    the number of units and structures but not on the size of the map.
+*/
+class StrategicMapView {
+public:
+    StrategicMapView() = default;
+
+    StrategicMapView(const StrategicMapView &) = delete;
+    StrategicMapView(StrategicMapView &&) = delete;
+    StrategicMapView& operator=(const StrategicMapView &) = delete;
+    StrategicMapView& operator=(StrategicMapView &&) = delete;
+
+    /**
+        Draws currentGameMap as seen by pLocalHouse centered into gameBoardRect.
+        \param  gameBoardRect       the rectangle on the screen the map is shown in
+        \param  terrainChunkCache   the cache providing the downsampled ground
+    */
+    void draw(const SDL_Rect& gameBoardRect, TerrainChunkCache& terrainChunkCache);
+
+    /**
+        Converts a position on the screen to the tile shown there by the last draw().
+        \param  screenX the x coordinate on the screen
+        \param  screenY the y coordinate on the screen
+        \return the tile or an invalid coordinate if there is no tile at this position
+    */
+    Coord screen2MapTile(int screenX, int screenY) const;
+
+private:
+    void updateShroud();
+
+    SDL_Rect mapRect = { 0, 0, 0, 0 };      ///< where draw() has drawn the map
+    int mapSizeX = 0;                       ///< the width of the map drawn by draw()
+    int mapSizeY = 0;                       ///< the height of the map drawn by draw()
+
+    sdl2::texture_ptr shroudTexture;        ///< one pixel per tile: black for unexplored, dark for fogged and transparent otherwise
+    int nextShroudRow = 0;                  ///< the first row of tiles refreshed by the next updateShroud()
+    bool bShroudComplete = false;           ///< were all rows of shroudTexture refreshed since it was created?
+
+    PrimitiveBatcher markers;               ///< the markers of the units and structures of the current frame
+};
+
+#endif // STRATEGICMAPVIEW_H
@@ -0,0 +1,109 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef TARGETCHANGEGRID_H
+#define TARGETCHANGEGRID_H
+
+#include <DataTypes.h>
+#include <Definitions.h>
+
+#include <algorithm>
+#include <vector>
+
+#define TARGETCHANGEGRID_CELLSIZE   4   ///< width and height of one cell in tiles
+
+/**
+    A uniform grid over the map with the last game cycle in which a new target may have appeared in each cell: an object
+    was assigned to or unassigned from a tile, tiles were revealed or an object changed its owner or its visibility.
+    ObjectBase::getScannedTarget() uses it to find out if a target scan that found nothing earlier in the cycle is
+    outdated.
+*/
+class TargetChangeGrid {
+public:
+    TargetChangeGrid() = default;
+
+    TargetChangeGrid(const TargetChangeGrid &) = delete;
+    TargetChangeGrid(TargetChangeGrid &&) = delete;
+    TargetChangeGrid& operator=(const TargetChangeGrid &) = delete;
+    TargetChangeGrid& operator=(TargetChangeGrid &&) = delete;
+
+    /**
+        Forgets all changes and resizes the grid to a map of the given size.
+        \param  mapSizeX    the width of the map
+        \param  mapSizeY    the height of the map
+    */
+    void reset(int mapSizeX, int mapSizeY) {
+        numCellsX = (mapSizeX + TARGETCHANGEGRID_CELLSIZE - 1) / TARGETCHANGEGRID_CELLSIZE;
+        numCellsY = (mapSizeY + TARGETCHANGEGRID_CELLSIZE - 1) / TARGETCHANGEGRID_CELLSIZE;
+        changeCycles.assign(numCellsX*numCellsY, INVALID_GAMECYCLE);
+        lastChangeCycle = INVALID_GAMECYCLE;
+    }
+
+    /**
+        Records a change of the tiles within range around location.
+        \param  location    the center of the changed area
+        \param  range       the distance of the changed tiles to location (in tiles)
+        \param  cycle       the current game cycle
+    */
+    void noteChange(const Coord& location, int range, Uint32 cycle) {
+        lastChangeCycle = cycle;
+        forEachCell(location, range, [&](int cellIndex) { changeCycles[cellIndex] = cycle; return false; });
+    }
+
+    /**
+        Was a change recorded for a tile within range around location in the game cycle cycle?
+        \param  location    the center of the area to check
+        \param  range       the distance of the tiles to check to location (in tiles) or -1 for the whole map
+        \param  cycle       the current game cycle
+        \return true if there may have been a change, false if there was none
+    */
+    bool hasChanged(const Coord& location, int range, Uint32 cycle) const {
+        if(range < 0) {
+            return (lastChangeCycle == cycle);
+        }
+
+        return forEachCell(location, range, [&](int cellIndex) { return (changeCycles[cellIndex] == cycle); });
+    }
+
+private:
+    /**
+        Calls f(cellIndex) for every cell overlapping the square of tiles within range around location until f returns true.
+        \return true if f returned true for one of the cells
+    */
+    template<typename F>
+    bool forEachCell(const Coord& location, int range, F&& f) const {
+        const int cellX1 = std::max(0, (location.x - range) / TARGETCHANGEGRID_CELLSIZE);
+        const int cellY1 = std::max(0, (location.y - range) / TARGETCHANGEGRID_CELLSIZE);
+        const int cellX2 = std::min(numCellsX - 1, (location.x + range) / TARGETCHANGEGRID_CELLSIZE);
+        const int cellY2 = std::min(numCellsY - 1, (location.y + range) / TARGETCHANGEGRID_CELLSIZE);
+
+        for(int cy = cellY1; cy <= cellY2; cy++) {
+            for(int cx = cellX1; cx <= cellX2; cx++) {
+                if(f(cy*numCellsX + cx)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    int numCellsX = 0;                          ///< number of cells in x direction
+    int numCellsY = 0;                          ///< number of cells in y direction
+    std::vector<Uint32> changeCycles;           ///< the last game cycle each cell changed in (INVALID_GAMECYCLE if never)
+    Uint32 lastChangeCycle = INVALID_GAMECYCLE; ///< the last game cycle any cell changed in
+};
+
+#endif // TARGETCHANGEGRID_H
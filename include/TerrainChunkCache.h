@@ -0,0 +1,142 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TERRAINCHUNKCACHE_H
+#define TERRAINCHUNKCACHE_H
+
+#include <misc/SDL2pp.h>
+
+#include <vector>
+
+#define TERRAINCHUNK_SIZE   16      ///< width and height of one chunk in tiles
+
+#define TERRAINCHUNK_MIPTILESIZE    4   ///< width and height of one tile in the downsampled chunks in pixels
+#define TERRAINCHUNK_MIPS_PER_FRAME 8   ///< downsampled chunks rendered at most per call of drawMipLevel()
+
+class Map;
+
+/**
+    Caches the static part of the ground (the terrain and destroyed structures) of the map in render target textures
+    of TERRAINCHUNK_SIZE x TERRAINCHUNK_SIZE tiles for the current zoom level. Instead of one copy per visible tile the
+    ground pass only needs one copy per visible chunk.
+
+    A chunk is rendered again when it is marked as dirty by invalidateTile() or invalidateArea(), which have to be
+    called whenever the terrain type or the destroyed structure of a tile changes or a structure is placed/removed.
+    If render targets are not supported the tiles are drawn directly.
+
+    For the strategic map view every chunk additionally has a downsampled copy with TERRAINCHUNK_MIPTILESIZE pixels per
+    tile (see drawMipLevel()).
+*/
+class TerrainChunkCache {
+public:
+    TerrainChunkCache() = default;
+
+    TerrainChunkCache(const TerrainChunkCache &) = delete;
+    TerrainChunkCache(TerrainChunkCache &&) = delete;
+    TerrainChunkCache& operator=(const TerrainChunkCache &) = delete;
+    TerrainChunkCache& operator=(TerrainChunkCache &&) = delete;
+
+    /**
+        Marks the chunks containing the tile x,y or one of its neighbours as dirty. The neighbours are included
+        because the terrain tile used for drawing depends on the terrain type of the surrounding tiles.
+        \param  x   the x coordinate of the changed tile
+        \param  y   the y coordinate of the changed tile
+    */
+    void invalidateTile(int x, int y) {
+        invalidateArea(x - 1, y - 1, 3, 3);
+    }
+
+    /**
+        Marks all chunks overlapping the specified rectangle as dirty.
+        \param  x       the x coordinate of the top left tile of the changed area
+        \param  y       the y coordinate of the top left tile of the changed area
+        \param  width   the width of the changed area
+        \param  height  the height of the changed area
+    */
+    void invalidateArea(int x, int y, int width, int height);
+
+    /**
+        Releases all chunk textures. They are rendered again when needed.
+    */
+    void invalidateAll();
+
+    /**
+        Takes all chunk textures out of this cache so that the cache of the next game can reuse them (see adoptTextures()).
+        \return the chunk textures
+    */
+    std::vector<sdl2::texture_ptr> releaseTextures();
+
+    /**
+        Provides textures of the cache of a previous game. They are used for chunks of the same size instead of creating
+        new textures and released if the zoom level changes.
+        \param  textures            the textures released by TerrainChunkCache::releaseTextures()
+        \param  texturesZoomlevel   the zoom level the textures were created for
+    */
+    void adoptTextures(std::vector<sdl2::texture_ptr> textures, int texturesZoomlevel);
+
+    /**
+        Returns the zoom level the chunk textures are created for (-1 if none were created yet).
+    */
+    int getZoomlevel() const noexcept { return zoomlevel; }
+
+    /**
+        Draws the cached ground of all chunks overlapping the tiles [x1,x2) x [y1,y2) of currentGameMap to the screen.
+        \param  x1  the x coordinate of the left most tile to draw
+        \param  y1  the y coordinate of the top most tile to draw
+        \param  x2  the x coordinate of the tile right of the right most tile to draw
+        \param  y2  the y coordinate of the tile below the bottom most tile to draw
+    */
+    void draw(int x1, int y1, int x2, int y2);
+
+    /**
+        Draws the cached ground of the whole currentGameMap scaled into dest using the downsampled copies of the chunks.
+        At most TERRAINCHUNK_MIPS_PER_FRAME changed or missing copies are rendered per call; until then changed chunks
+        are drawn from their old copy and missing ones are left out, so the cost per frame does not depend on the
+        map size. Nothing is drawn if render targets are not supported.
+        \param  dest    the rectangle on the screen the whole map is drawn to
+    */
+    void drawMipLevel(const SDL_Rect& dest);
+
+private:
+    struct Chunk {
+        sdl2::texture_ptr texture;      ///< the rendered ground of this chunk (nullptr if not rendered yet)
+        sdl2::texture_ptr mipTexture;   ///< the downsampled ground of this chunk (nullptr if not rendered yet)
+        bool bDirty = true;             ///< does texture need to be rendered again?
+        bool bMipDirty = true;          ///< does mipTexture need to be rendered again?
+    };
+
+    void reset(const Map* pNewMap);
+    void checkMapAndZoomlevel();
+    void renderGround(int tileX, int tileY, int chunkSizeX, int chunkSizeY) const;
+    bool renderChunk(Chunk& chunk, int chunkX, int chunkY);
+    bool renderChunkMip(Chunk& chunk, int chunkX, int chunkY);
+    sdl2::texture_ptr takeSpareTexture(int width, int height);
+    void drawTiles(int x1, int y1, int x2, int y2) const;
+
+    const Map* pMap = nullptr;      ///< the map the chunks belong to
+    int mapSizeX = 0;               ///< the width of pMap when the chunks were created
+    int mapSizeY = 0;               ///< the height of pMap when the chunks were created
+    int numChunksX = 0;             ///< number of chunks in x direction
+    int numChunksY = 0;             ///< number of chunks in y direction
+    int zoomlevel = -1;             ///< the zoom level the chunk textures are rendered for
+    bool bRenderTargetsFailed = false;  ///< could not render to a texture => draw all tiles directly
+    std::vector<Chunk> chunks;      ///< all chunks of the map
+    std::vector<sdl2::texture_ptr> spareTextures;   ///< unused textures for the current zoom level (e.g. of a previous map)
+    sdl2::texture_ptr mipScratchTexture;            ///< a chunk rendered at the current zoom level before downsampling it
+};
+
+#endif // TERRAINCHUNKCACHE_H
@@ -21,16 +21,19 @@
 #include <DataTypes.h>
 #include <mmath.h>
 #include <data.h>
+#include <TilePlanes.h>
 
-#include <misc/InputStream.h>
-#include <misc/OutputStream.h>
+#include <misc/IMemoryStream.h>
+#include <misc/OMemoryStream.h>
+#include <misc/SmallVector.h>
 #include <fixmath/FixPoint.h>
 
 #include <list>
 #include <vector>
 #include <algorithm>
 
-#define DAMAGE_PER_TILE 5
+typedef SmallVector<Uint32, 2> TileObjectList;                          ///< IDs of the objects of one kind on a tile
+typedef SmallVector<Uint32, NUM_INFANTRY_PER_TILE> TileInfantryList;    ///< IDs of the infantry units on a tile
 
 
 // forward declarations
@@ -49,22 +52,6 @@ enum deadUnitEnum {
     DeadUnit_Ornithopter = 5
 };
 
-typedef struct
-{
-    Uint32 damageType;
-    int tile;
-    Coord realPos;
-} DAMAGETYPE;
-
-typedef struct
-{
-    Coord   realPos;
-    Sint16  timer;
-    Uint8   type;
-    Uint8   house;
-    bool    onSand;
-} DEADUNITTYPE;
-
 enum destroyedStructureEnum {
     DestroyedStructure_None             = -1,
     DestroyedStructure_Wall             = 0,
@@ -218,36 +205,63 @@ public:
 
 
     /**
-        Default constructor. Creates a tile of type Terrain_Sand.
+        Default constructor. The terrain type and the exploration state of a tile are stored in the map's TilePlanes,
+        so a tile is unusable until bindPlanes() has been called.
     */
     Tile();
     ~Tile();
 
-    void load(InputStream& stream);
-    void save(OutputStream& stream) const;
+    /**
+        Connects this tile to the planes holding its packed state.
+        \param  pNewPlanes      the planes of the map this tile belongs to
+        \param  newPlaneIndex   the index of this tile inside the planes
+    */
+    void bindPlanes(TilePlanes* pNewPlanes, int newPlaneIndex) noexcept {
+        pPlanes = pNewPlanes;
+        planeIndex = newPlaneIndex;
+    }
+
+    /**
+        Loads this tile. Map::load() reads all tiles as one block, so the tiles are only read from memory.
+        \param  stream  the stream to load from
+    */
+    void load(IMemoryStream& stream);
+
+    /**
+        Saves this tile. Map::save() collects all tiles in memory and writes them as one block.
+        \param  stream  the stream to save to
+    */
+    void save(OMemoryStream& stream) const;
 
     void assignAirUnit(Uint32 newObjectID);
-    void assignDeadUnit(Uint8 type, Uint8 house, const Coord& position) {
-        DEADUNITTYPE newDeadUnit;
-        newDeadUnit.type = type;
-        newDeadUnit.house = house;
-        newDeadUnit.onSand = isSand() || isDunes();
-        newDeadUnit.realPos = position;
-        newDeadUnit.timer = 2000;
-
-        deadUnits.push_back(newDeadUnit);
-    }
+    void assignDeadUnit(Uint8 type, Uint8 house, const Coord& position);
 
     void assignNonInfantryGroundObject(Uint32 newObjectID);
-    int assignInfantry(Uint32 newObjectID, Sint8 currentPosition = INVALID_POS);
+
+    /**
+        Assigns an infantry unit to this tile and reserves a position for it.
+        \param  newObjectID     the id of the infantry unit
+        \param  team            the team of the infantry unit
+        \param  currentPosition the position to take or INVALID_POS to take the first free one
+        \return the position of the infantry unit on this tile (NUM_INFANTRY_PER_TILE if all were taken)
+    */
+    int assignInfantry(Uint32 newObjectID, int team, Sint8 currentPosition = INVALID_POS);
     void assignUndergroundUnit(Uint32 newObjectID);
 
     /**
-        This method draws the terrain of this tile
+        This method draws the terrain and destroyed structures of this tile. This is the static part of the ground
+        that is cached by TerrainChunkCache.
         \param xPos the x position of the left top corner of this tile on the screen
         \param yPos the y position of the left top corner of this tile on the screen
     */
-    void blitGround(int xPos, int yPos);
+    void blitGroundTerrain(int xPos, int yPos) const;
+
+    /**
+        This method draws the tracks and damage on the ground of this tile
+        \param xPos the x position of the left top corner of this tile on the screen
+        \param yPos the y position of the left top corner of this tile on the screen
+    */
+    void blitGroundDetails(int xPos, int yPos) const;
 
     /**
         This method draws the structures.
@@ -299,11 +313,19 @@ public:
     void blitSelectionRects(int xPos, int yPos) const;
 
 
-    void update() {
-        if (deadUnits.empty())
-            return;
-
+    /**
+        Updates the timers of the dead units on this tile. Only tiles registered at the map by
+        registerForUpdates() are updated (see Map::updateTiles()).
+        \return true if this tile still needs to be updated, false if it can be removed from the update list
+    */
+    bool update() {
         update_impl();
+
+        if (!hasDeadUnits()) {
+            bRegisteredForUpdates = false;
+            return false;
+        }
+        return true;
     }
 
     void clearTerrain();
@@ -311,7 +333,6 @@ public:
     void setTrack(Uint8 direction);
 
     void selectAllPlayersUnits(int houseID, ObjectBase** lastCheckedObject, ObjectBase** lastSelectedObject);
-    void selectAllPlayersUnitsOfType(int houseID, int itemID, ObjectBase** lastCheckedObject, ObjectBase** lastSelectedObject);
     void unassignAirUnit(Uint32 objectID);
     void unassignNonInfantryGroundObject(Uint32 objectID);
     void unassignObject(Uint32 objectID);
@@ -319,7 +340,19 @@ public:
     void unassignUndergroundUnit(Uint32 objectID);
     void setType(int newType);
     void squash() const;
-    int getInfantryTeam() const;
+
+    /**
+        Returns the team of the infantry on this tile. All infantry units on a tile are expected to be of the same
+        team, the first one assigned decides.
+        \return the team of the infantry or INVALID if there is none
+    */
+    int getInfantryTeam() const noexcept { return infantryTeam; }
+
+    /**
+        Reads the team of the infantry on this tile again. Needs to be called when the owner of an infantry unit on
+        this tile changes.
+    */
+    void updateInfantryTeam();
     FixPoint harvestSpice();
     void setSpice(FixPoint newSpice);
 
@@ -364,19 +397,19 @@ public:
     ObjectBase* getObjectWithID(Uint32 objectID) const;
 
 
-    const std::list<Uint32>& getAirUnitList() const {
+    const TileObjectList& getAirUnitList() const {
         return assignedAirUnitList;
     }
 
-    const std::list<Uint32>& getInfantryList() const {
+    const TileInfantryList& getInfantryList() const {
         return assignedInfantryList;
     }
 
-    const std::list<Uint32>& getUndergroundUnitList() const {
+    const TileObjectList& getUndergroundUnitList() const {
         return assignedUndergroundUnitList;
     }
 
-    const std::list<Uint32>& getNonInfantryGroundObjectList() const {
+    const TileObjectList& getNonInfantryGroundObjectList() const {
         return assignedNonInfantryGroundObjectList;
     }
 
@@ -398,13 +431,19 @@ public:
         \param  cycle   the cycle this happens (normally the current game cycle)
     */
     void setExplored(int houseID, Uint32 cycle) {
-        lastAccess[houseID] = cycle;
-        explored[houseID] = true;
+        pPlanes->view(planeIndex, houseID, cycle);
     }
 
-    void setOwner(int newOwner) noexcept { owner = newOwner; }
+    void setOwner(int newOwner) noexcept { pPlanes->setOwner(planeIndex, newOwner); }
+
+    /**
+        Has to be called when the radar color of this tile changes for other reasons than objects entering or leaving
+        it or terrain and exploration changes (e.g. when the owner of the unit on this tile changes).
+    */
+    void invalidateRadarColor() { pPlanes->markRadarDirty(planeIndex); }
+
     void setSandRegion(Uint32 newSandRegion) noexcept { sandRegion = newSandRegion; }
-    void setDestroyedStructureTile(int newDestroyedStructureTile) noexcept { destroyedStructureTile = newDestroyedStructureTile; };
+    void setDestroyedStructureTile(int newDestroyedStructureTile);
 
     bool hasAGroundObject() const noexcept { return (hasInfantry() || hasANonInfantryGroundObject()); }
     bool hasAnAirUnit() const noexcept { return !assignedAirUnitList.empty(); }
@@ -412,29 +451,43 @@ public:
     bool hasANonInfantryGroundObject() const noexcept { return !assignedNonInfantryGroundObjectList.empty(); }
     bool hasAStructure() const;
     bool hasInfantry() const noexcept { return !assignedInfantryList.empty(); }
+    bool hasDeadUnits() const noexcept { return (decalIndex != NO_TILEDECALS) && !getDecals().deadUnits.empty(); }
+    bool hasGroundDetails() const noexcept;
     bool hasAnObject() const noexcept { return (hasAGroundObject() || hasAnAirUnit() || hasAnUndergroundUnit()); }
 
+    /**
+        Checks if the object with the given id is assigned to this tile.
+        \param  objectID    the id of the object
+        \return true if the object is on this tile, false otherwise
+    */
+    bool hasObjectID(Uint32 objectID) const {
+        const auto contains = [objectID](const auto& objectList) { return std::find(objectList.begin(), objectList.end(), objectID) != objectList.end(); };
+        return contains(assignedInfantryList) || contains(assignedNonInfantryGroundObjectList)
+                || contains(assignedUndergroundUnitList) || contains(assignedAirUnitList);
+    }
+
     bool hasSpice() const noexcept { return (spice > 0); }
     bool infantryNotFull() const noexcept { return (assignedInfantryList.size() < NUM_INFANTRY_PER_TILE); }
-    bool isConcrete() const noexcept { return (type == Terrain_Slab); }
-    bool isExploredByHouse(int houseID) const { return explored[houseID]; }
+    bool isConcrete() const noexcept { return (getType() == Terrain_Slab); }
+    bool isExploredByHouse(int houseID) const { return pPlanes->isExplored(planeIndex, houseID); }
+    bool isInSightOfHouse(int houseID) const noexcept { return pPlanes->isInSight(planeIndex, houseID); }
     bool isExploredByTeam(int teamID) const;
 
     bool isFoggedByHouse(int houseID) const noexcept;
     bool isFoggedByTeam(int teamID) const noexcept;
-    bool isMountain() const noexcept { return (type == Terrain_Mountain); }
-    bool isRock() const noexcept { return ((type == Terrain_Rock) || (type == Terrain_Slab) || (type == Terrain_Mountain)); }
+    bool isMountain() const noexcept { return (getType() == Terrain_Mountain); }
+    bool isRock() const noexcept { return ((getType() == Terrain_Rock) || (getType() == Terrain_Slab) || (getType() == Terrain_Mountain)); }
 
-    bool isSand() const noexcept { return (type == Terrain_Sand); }
-    bool isDunes() const noexcept { return (type == Terrain_Dunes); }
-    bool isSpiceBloom() const noexcept { return (type == Terrain_SpiceBloom); }
-    bool isSpecialBloom() const noexcept { return (type == Terrain_SpecialBloom); }
-    bool isSpice() const noexcept { return ((type == Terrain_Spice) || (type == Terrain_ThickSpice)); }
-    bool isThickSpice() const noexcept { return (type == Terrain_ThickSpice); }
+    bool isSand() const noexcept { return (getType() == Terrain_Sand); }
+    bool isDunes() const noexcept { return (getType() == Terrain_Dunes); }
+    bool isSpiceBloom() const noexcept { return (getType() == Terrain_SpiceBloom); }
+    bool isSpecialBloom() const noexcept { return (getType() == Terrain_SpecialBloom); }
+    bool isSpice() const noexcept { return ((getType() == Terrain_Spice) || (getType() == Terrain_ThickSpice)); }
+    bool isThickSpice() const noexcept { return (getType() == Terrain_ThickSpice); }
 
     Uint32 getSandRegion() const noexcept { return sandRegion; }
-    int getOwner() const noexcept { return owner; }
-    int getType() const noexcept { return type; }
+    int getOwner() const noexcept { return pPlanes->getOwner(planeIndex); }
+    int getType() const noexcept { return pPlanes->getTerrainType(planeIndex); }
     FixPoint getSpice() const noexcept { return spice; }
 
     FixPoint getSpiceRemaining() const noexcept { return spice; }
@@ -442,56 +495,110 @@ public:
     const Coord& getLocation() const noexcept { return location; }
 
     Uint32 getRadarColor(House* pHouse, bool radar);
-    int getTerrainTile() const;
+
+    /**
+        Returns the index of the picture in the terrain atlas for this tile, which depends on the terrain types of the
+        four neighbours. The index is cached until the terrain type of this tile or of a neighbour changes.
+    */
+    int getTerrainTile() const {
+        if(terrainTile < 0) {
+            terrainTile = static_cast<Sint8>(computeTerrainTile());
+        }
+        return terrainTile;
+    }
+
     int getHideTile(int teamID) const;
     int getFogTile(int teamID) const;
     int getDestroyedStructureTile() const noexcept { return  destroyedStructureTile; };
 
     bool isBlocked() const noexcept {
-        return (isMountain() || hasAGroundObject());
+        return pPlanes->isBlocked(planeIndex);
     }
 
 
     void addDamage(Uint32 damageType, int tile, Coord realPos) {
-        if (damage.size() >= DAMAGE_PER_TILE) return;
+        if ((decalIndex != NO_TILEDECALS) && (getDecals().damage.size() >= DAMAGE_PER_TILE)) return;
 
         DAMAGETYPE newDamage;
         newDamage.tile = tile;
         newDamage.damageType = damageType;
         newDamage.realPos = realPos;
 
-        damage.push_back(newDamage);
+        createDecals().damage.push_back(newDamage);
     }
 
     Coord   location;   ///< location of this tile in map coordinates
 
 private:
 
-    Uint32      type;           ///< the type of the tile (Terrain_Sand, Terrain_Rock, ...)
+    TilePlanes* pPlanes = nullptr;  ///< packed terrain type, exploration, passability and owner of this tile (owned by the map)
+    int         planeIndex = 0;     ///< index of this tile in pPlanes
 
     Uint32      fogColor;       ///< remember last color (radar)
 
-    Sint32      owner;          ///< house ID of the owner of this tile
     Uint32      sandRegion;     ///< used by sandworms to check if can get to a unit
 
     FixPoint    spice;          ///< how much spice on this particular tile is left
 
-    zoomable_texture sprite{};  ///< the graphic to draw
 
     Sint32                          destroyedStructureTile;         ///< the tile drawn for a destroyed structure
     Uint32                          tracksCreationTime[NUM_ANGLES]; ///< Contains the game cycle the tracks on sand appeared
-    std::vector<DAMAGETYPE>         damage;                         ///< damage positions
-    std::vector<DEADUNITTYPE>       deadUnits;                      ///< dead units
+    Uint32                          decalIndex = NO_TILEDECALS;     ///< the entry of this tile in the decal store of the planes
+    bool                            bRegisteredForUpdates = false;  ///< is this tile in the update list of the map? (not saved)
+    mutable Sint8                   terrainTile = -1;               ///< the cached result of getTerrainTile() (-1 = not computed yet; not saved)
+
+    TileObjectList      assignedAirUnitList;                      ///< all the air units on this tile
+    TileInfantryList    assignedInfantryList;                     ///< all infantry units on this tile
+    Sint8               infantryPositions[NUM_INFANTRY_PER_TILE]; ///< the position of the first NUM_INFANTRY_PER_TILE entries of assignedInfantryList (INVALID_POS if they have none)
+    Uint8               infantryPositionMask = 0;                 ///< bit i is set if position i on this tile is taken
+    Sint8               infantryTeam = INVALID;                   ///< the team of the infantry on this tile (INVALID if there is none)
+    TileObjectList      assignedUndergroundUnitList;              ///< all underground units on this tile
+    TileObjectList      assignedNonInfantryGroundObjectList;      ///< all structures/vehicles on this tile
 
-    std::list<Uint32>   assignedAirUnitList;                      ///< all the air units on this tile
-    std::list<Uint32>   assignedInfantryList;                     ///< all infantry units on this tile
-    std::list<Uint32>   assignedUndergroundUnitList;              ///< all underground units on this tile
-    std::list<Uint32>   assignedNonInfantryGroundObjectList;      ///< all structures/vehicles on this tile
+    void update_impl();
 
-    Uint32      lastAccess[NUM_TEAMS];    ///< contains for every team when this tile was seen last by this house
-    bool        explored[NUM_TEAMS];      ///< contains for every team if this tile is explored
+    /**
+        Returns the decals of this tile. Only valid if decalIndex != NO_TILEDECALS.
+    */
+    const TileDecals& getDecals() const noexcept { return pPlanes->getDecalStore().get(decalIndex); }
 
-    void update_impl();
+    /**
+        Returns the decals of this tile and allocates an entry in the decal store first if this tile has none.
+    */
+    TileDecals& createDecals() {
+        if (decalIndex == NO_TILEDECALS) {
+            decalIndex = pPlanes->getDecalStore().allocate();
+        }
+        return pPlanes->getDecalStore().get(decalIndex);
+    }
+
+    /**
+        Gives the entry of this tile in the decal store back if it became empty.
+    */
+    void releaseDecalsIfEmpty() {
+        if ((decalIndex != NO_TILEDECALS) && getDecals().empty()) {
+            pPlanes->getDecalStore().release(decalIndex);
+            decalIndex = NO_TILEDECALS;
+        }
+    }
+
+    void registerForUpdates();
+
+    void changeSpice(FixPoint newSpice);
+
+    int computeTerrainTile() const;
+
+    /**
+        Drops the cached terrain tile index of this tile and its four neighbours after the terrain type of this tile changed.
+    */
+    void invalidateTerrainTiles();
+
+    void updateBlocked() noexcept {
+        pPlanes->setGroundObjectBlocked(planeIndex, hasAGroundObject());
+    }
+
+    template<class ObjectList>
+    void unassignFromList(ObjectList& objectList, Uint32 objectID);
 
     template<typename Pred>
     void selectFilter(int houseID, ObjectBase** lastCheckedObject, ObjectBase** lastSelectedObject, Pred&& predicate);
@@ -0,0 +1,109 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TILEDECALS_H
+#define TILEDECALS_H
+
+#include <DataTypes.h>
+
+#include <vector>
+
+#define DAMAGE_PER_TILE     5               ///< maximum number of damage decals on one tile
+#define DEADUNITS_PER_TILE  8               ///< maximum number of dead units on one tile; the oldest one is removed first
+#define NO_TILEDECALS       0xFFFFFFFFu     ///< the decal index of a tile without decals
+
+typedef struct
+{
+    Uint32 damageType;
+    int tile;
+    Coord realPos;
+} DAMAGETYPE;
+
+typedef struct
+{
+    Coord   realPos;
+    Sint16  timer;
+    Uint8   type;
+    Uint8   house;
+    bool    onSand;
+} DEADUNITTYPE;
+
+/// The damage and the dead units drawn on one tile
+struct TileDecals {
+    std::vector<DAMAGETYPE>     damage;     ///< damage positions
+    std::vector<DEADUNITTYPE>   deadUnits;  ///< dead units
+
+    bool empty() const noexcept { return damage.empty() && deadUnits.empty(); }
+};
+
+/**
+    The decals of all tiles of a map. Most tiles never get any decals, so a tile only keeps an index into this store
+    instead of two vectors of its own. Released entries keep their memory and are handed out again to the next tile
+    that needs decals, so the store does not allocate any more once a battlefield has reached its size.
+*/
+class TileDecalStore {
+public:
+    TileDecalStore() = default;
+
+    TileDecalStore(const TileDecalStore &) = delete;
+    TileDecalStore(TileDecalStore &&) = delete;
+    TileDecalStore& operator=(const TileDecalStore &) = delete;
+    TileDecalStore& operator=(TileDecalStore &&) = delete;
+
+    /**
+        Removes all decals of all tiles.
+    */
+    void clear() {
+        decals.clear();
+        freeIndices.clear();
+    }
+
+    /**
+        Returns an empty entry. References returned by get() are invalidated.
+        \return the index of the entry
+    */
+    Uint32 allocate() {
+        if(!freeIndices.empty()) {
+            const Uint32 index = freeIndices.back();
+            freeIndices.pop_back();
+            return index;
+        }
+
+        decals.emplace_back();
+        return static_cast<Uint32>(decals.size() - 1);
+    }
+
+    /**
+        Empties an entry and makes it available to allocate() again.
+        \param  index   the index of the entry
+    */
+    void release(Uint32 index) {
+        decals[index].damage.clear();
+        decals[index].deadUnits.clear();
+        freeIndices.push_back(index);
+    }
+
+    TileDecals& get(Uint32 index) noexcept { return decals[index]; }
+    const TileDecals& get(Uint32 index) const noexcept { return decals[index]; }
+
+private:
+    std::vector<TileDecals> decals;     ///< all entries
+    std::vector<Uint32> freeIndices;    ///< the released entries
+};
+
+#endif // TILEDECALS_H
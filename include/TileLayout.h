@@ -0,0 +1,66 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILELAYOUT_H
+#define TILELAYOUT_H
+
+#include <DataTypes.h>
+
+#define TILELAYOUT_STRIPSHIFT   3                                   ///< the map is stored in strips of 8 columns
+#define TILELAYOUT_STRIPWIDTH   (1 << TILELAYOUT_STRIPSHIFT)
+
+/**
+    Maps the coordinates of a tile to its index in the tile array of Map and in TilePlanes. The map is stored in
+    strips of TILELAYOUT_STRIPWIDTH columns one after another and every strip is stored row by row. Tiles that are
+    close on the map are thereby close in memory in both directions: the neighbours in y direction are only
+    TILELAYOUT_STRIPWIDTH tiles apart instead of a whole column of the map. If the map width is not a multiple of
+    TILELAYOUT_STRIPWIDTH the last strip is narrower, so the indices are exactly 0 to sizeX*sizeY-1.
+*/
+class TileLayout {
+public:
+    TileLayout() = default;
+
+    TileLayout(int sizeX, int sizeY)
+     : sizeY(sizeY), lastStripX((sizeX - 1) & ~(TILELAYOUT_STRIPWIDTH - 1)), lastStripWidth(sizeX - lastStripX) {
+    }
+
+    /**
+        Returns the index of the tile (x,y). The tile has to exist.
+    */
+    int getIndex(int x, int y) const noexcept {
+        const int stripX = x & ~(TILELAYOUT_STRIPWIDTH - 1);
+        const int stripWidth = (stripX == lastStripX) ? lastStripWidth : TILELAYOUT_STRIPWIDTH;
+        return stripX * sizeY + y * stripWidth + (x - stripX);
+    }
+
+    /**
+        Returns the coordinates of the tile with the given index. This is the inverse of getIndex().
+    */
+    Coord getCoord(int index) const noexcept {
+        const int stripX = (index / (TILELAYOUT_STRIPWIDTH * sizeY)) << TILELAYOUT_STRIPSHIFT;
+        const int stripWidth = (stripX == lastStripX) ? lastStripWidth : TILELAYOUT_STRIPWIDTH;
+        const int offset = index - stripX * sizeY;
+        return Coord(stripX + offset % stripWidth, offset / stripWidth);
+    }
+
+private:
+    int sizeY = 0;              ///< the height of the map
+    int lastStripX = 0;         ///< the first column of the last strip
+    int lastStripWidth = 0;     ///< the number of columns of the last strip
+};
+
+#endif // TILELAYOUT_H
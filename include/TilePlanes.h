@@ -0,0 +1,278 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILEPLANES_H
+#define TILEPLANES_H
+
+#include <DataTypes.h>
+#include <Definitions.h>
+#include <data.h>
+#include <TileDecals.h>
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#define FOGTIME MILLI2CYCLES(10 * 1000)         ///< number of cycles a tile stays visible after it was seen last
+
+#define TILEPLANE_BLOCKED_MOUNTAIN      0x01    ///< the tile is a mountain
+#define TILEPLANE_BLOCKED_GROUNDOBJECT  0x02    ///< the tile is occupied by a ground unit or a structure
+
+/**
+    Packed per-tile state of a map stored as one plane per field (structure of arrays).
+    Scans over the whole map (targeting, vision, radar, AI placement) usually only need one or two of these values
+    per tile and would otherwise have to pull the whole Tile object into the cache for it. The planes are owned by Map
+    and indexed the same way as Map's tile array; the Tile accessors forward to them.
+*/
+class TilePlanes {
+public:
+    TilePlanes() = default;
+
+    TilePlanes(const TilePlanes &) = delete;
+    TilePlanes(TilePlanes &&) = delete;
+    TilePlanes& operator=(const TilePlanes &) = delete;
+    TilePlanes& operator=(TilePlanes &&) = delete;
+
+    /**
+        Resizes all planes to the given number of tiles and sets every tile to unseen sand.
+        \param  newNumTiles the number of tiles of the map
+        \param  bExplored   should all tiles start explored by all houses?
+    */
+    void reset(int newNumTiles, bool bExplored) {
+        numTiles = newNumTiles;
+
+        terrainTypes.assign(numTiles, Terrain_Sand);
+        exploredMasks.assign(numTiles, bExplored ? 0xFF : 0x00);
+        lastAccess.assign(numTiles * NUM_TEAMS, 0);
+        sightCounts.assign(numTiles * NUM_TEAMS, 0);
+        blockedMasks.assign(numTiles, 0);
+        owners.assign(numTiles, INVALID);
+
+        radarDirty.assign(numTiles, 1);
+        radarDirtyTiles.resize(numTiles);
+        for(int i = 0; i < numTiles; i++) {
+            radarDirtyTiles[i] = i;
+        }
+        fogTimeouts.clear();
+        bFogTimeoutsUnsorted = false;
+
+        decalStore.clear();
+
+        terrainVersion++;
+        blockedVersion++;
+        ownerVersion++;
+    }
+
+    int getNumTiles() const noexcept { return numTiles; }
+
+    /**
+        Returns the damage and dead unit decals of all tiles. A tile only keeps the index of its entry.
+        \return the decal store of this map
+    */
+    TileDecalStore& getDecalStore() noexcept { return decalStore; }
+    const TileDecalStore& getDecalStore() const noexcept { return decalStore; }
+
+    Uint8 getTerrainType(int index) const noexcept { return terrainTypes[index]; }
+
+    void setTerrainType(int index, Uint8 type) noexcept {
+        if(terrainTypes[index] != type) {
+            terrainVersion++;
+            markRadarDirty(index);
+        }
+
+        terrainTypes[index] = type;
+
+        const Uint8 oldMask = blockedMasks[index];
+        if(type == Terrain_Mountain) {
+            blockedMasks[index] |= TILEPLANE_BLOCKED_MOUNTAIN;
+        } else {
+            blockedMasks[index] &= ~TILEPLANE_BLOCKED_MOUNTAIN;
+        }
+
+        if(blockedMasks[index] != oldMask) {
+            blockedVersion++;
+        }
+    }
+
+    /**
+        Returns a bitmask with bit h set for every house h that has explored this tile.
+    */
+    Uint8 getExploredMask(int index) const noexcept { return exploredMasks[index]; }
+
+    bool isExplored(int index, int houseID) const noexcept { return (exploredMasks[index] & (1 << houseID)) != 0; }
+
+    void setExplored(int index, int houseID, bool bExplored) noexcept {
+        if(bExplored) {
+            exploredMasks[index] |= (1 << houseID);
+        } else {
+            exploredMasks[index] &= ~(1 << houseID);
+        }
+        markRadarDirty(index);
+    }
+
+    /**
+        Returns the cycle this tile was seen last by the house houseID (0 = never, or not since loading).
+    */
+    Uint32 getLastAccess(int index, int houseID) const noexcept { return lastAccess[houseID * numTiles + index]; }
+
+    void setLastAccess(int index, int houseID, Uint32 cycle) {
+        lastAccess[houseID * numTiles + index] = cycle;
+        markRadarDirty(index);
+        addFogTimeout(cycle + FOGTIME, index);
+    }
+
+    /**
+        Marks the tile as explored by houseID and seen in cycle.
+    */
+    void view(int index, int houseID, Uint32 cycle) {
+        lastAccess[houseID * numTiles + index] = cycle;
+        exploredMasks[index] |= (1 << houseID);
+        markRadarDirty(index);
+        if(sightCounts[houseID * numTiles + index] == 0) {
+            addFogTimeout(cycle + FOGTIME, index);
+        }
+    }
+
+    /**
+        Is this tile currently in the view range of at least one vision source (unit or structure) of house houseID?
+    */
+    bool isInSight(int index, int houseID) const noexcept { return sightCounts[houseID * numTiles + index] != 0; }
+
+    /**
+        Adds one vision source of house houseID covering this tile. The tile becomes explored and visible.
+    */
+    void addSight(int index, int houseID, Uint32 cycle) {
+        sightCounts[houseID * numTiles + index]++;
+        view(index, houseID, cycle);
+    }
+
+    /**
+        Removes one vision source of house houseID covering this tile. When the last source is gone the tile counts as
+        seen last in cycle and fogs over after the usual delay.
+    */
+    void removeSight(int index, int houseID, Uint32 cycle) {
+        auto& count = sightCounts[houseID * numTiles + index];
+        if((count > 0) && (--count == 0)) {
+            lastAccess[houseID * numTiles + index] = cycle;
+            addFogTimeout(cycle + FOGTIME, index);
+        }
+    }
+
+    bool isBlocked(int index) const noexcept { return blockedMasks[index] != 0; }
+
+    void setGroundObjectBlocked(int index, bool bBlocked) noexcept {
+        const Uint8 oldMask = blockedMasks[index];
+
+        if(bBlocked) {
+            blockedMasks[index] |= TILEPLANE_BLOCKED_GROUNDOBJECT;
+        } else {
+            blockedMasks[index] &= ~TILEPLANE_BLOCKED_GROUNDOBJECT;
+        }
+
+        if(blockedMasks[index] != oldMask) {
+            blockedVersion++;
+        }
+    }
+
+    /**
+        Returns the house ID of the owner of this tile (INVALID if none).
+    */
+    int getOwner(int index) const noexcept { return owners[index]; }
+
+    void setOwner(int index, int newOwner) noexcept {
+        if(owners[index] != newOwner) {
+            owners[index] = static_cast<Sint8>(newOwner);
+            ownerVersion++;
+        }
+    }
+
+    /**
+        Marks the radar color of this tile as possibly changed. This is done automatically for changes of the terrain type
+        and the exploration state; changes of the objects on a tile have to be reported by the caller.
+    */
+    void markRadarDirty(int index) {
+        if(radarDirty[index] == 0) {
+            radarDirty[index] = 1;
+            radarDirtyTiles.push_back(index);
+        }
+    }
+
+    /**
+        Calls fn(index) for every tile whose radar color may have changed since the last call and clears the list.
+        Tiles that fog over before or in cycle (as they have not been seen for FOGTIME cycles) are included.
+        \param  cycle   the current game cycle
+        \param  fn      the function to call for every changed tile
+    */
+    template<typename Function>
+    void takeRadarDirtyTiles(Uint32 cycle, Function&& fn) {
+        if(bFogTimeoutsUnsorted) {
+            // only happens while loading a savegame
+            std::stable_sort(fogTimeouts.begin(), fogTimeouts.end(), [](const std::pair<Uint32, int>& a, const std::pair<Uint32, int>& b) { return a.first < b.first; });
+            bFogTimeoutsUnsorted = false;
+        }
+
+        while(!fogTimeouts.empty() && (fogTimeouts.front().first <= cycle)) {
+            markRadarDirty(fogTimeouts.front().second);
+            fogTimeouts.pop_front();
+        }
+
+        for(int index : radarDirtyTiles) {
+            radarDirty[index] = 0;
+            fn(index);
+        }
+        radarDirtyTiles.clear();
+    }
+
+    /**
+        The versions are increased whenever the terrain type, the blocked state or the owner of any tile changes.
+        Caches derived from the planes (e.g. PlacementTables) compare them to find out if they are outdated.
+    */
+    Uint32 getTerrainVersion() const noexcept { return terrainVersion; }
+    Uint32 getBlockedVersion() const noexcept { return blockedVersion; }
+    Uint32 getOwnerVersion() const noexcept { return ownerVersion; }
+
+private:
+    void addFogTimeout(Uint32 cycle, int index) {
+        if(!fogTimeouts.empty() && (cycle < fogTimeouts.back().first)) {
+            bFogTimeoutsUnsorted = true;
+        }
+        fogTimeouts.emplace_back(cycle, index);
+    }
+
+    int numTiles = 0;                   ///< number of tiles in each plane
+
+    std::vector<Uint8>  terrainTypes;   ///< the terrain type of each tile (Terrain_Sand, Terrain_Rock, ...)
+    std::vector<Uint8>  exploredMasks;  ///< for each tile a bitmask of the houses that explored it
+    std::vector<Uint32> lastAccess;     ///< NUM_TEAMS consecutive planes with the cycle each tile was seen last by that house
+    std::vector<Uint16> sightCounts;    ///< NUM_TEAMS consecutive planes with the number of vision sources of that house covering each tile
+    std::vector<Uint8>  blockedMasks;   ///< for each tile a combination of TILEPLANE_BLOCKED_* flags
+    std::vector<Sint8>  owners;         ///< the house ID of the owner of each tile (INVALID if none)
+
+    std::vector<Uint8>  radarDirty;     ///< is the tile in radarDirtyTiles?
+    std::vector<int>    radarDirtyTiles;///< the tiles whose radar color may have changed
+    std::deque<std::pair<Uint32, int>> fogTimeouts;    ///< (cycle, tile) pairs of tiles that may fog over in that cycle; sorted by cycle
+    bool bFogTimeoutsUnsorted = false;  ///< were entries added to fogTimeouts out of order?
+
+    Uint32 terrainVersion = 0;          ///< increased on every change of terrainTypes
+    Uint32 blockedVersion = 0;          ///< increased on every change of blockedMasks
+    Uint32 ownerVersion = 0;            ///< increased on every change of owners
+
+    TileDecalStore decalStore;          ///< the decals of the tiles with damage or dead units
+};
+
+#endif // TILEPLANES_H
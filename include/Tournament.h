@@ -0,0 +1,76 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include <DataTypes.h>
+
+#include <misc/SDL2pp.h>
+
+#include <string>
+
+/**
+    The outcome of one game between two AI players of a tournament (see runTournament()).
+*/
+struct TournamentGameResult {
+    std::string map;                ///< the name of the map
+    Uint32 seed = 0;                ///< the random seed the game was started with
+    std::string playerClass[2];     ///< the player classes of the two AI players
+    HOUSETYPE house[2] = { HOUSE_INVALID, HOUSE_INVALID };  ///< the houses of the two AI players
+    std::string result;             ///< "won" or "lost" from the view of the first player, "draw" if none won in time or "error"
+    Uint32 gameCycles = 0;          ///< the number of simulated game cycles
+    Uint32 elapsedTime = 0;         ///< the time needed for the simulation in ms
+
+    /**
+        Formats this result as one line of csv output (see getCSVHeader()).
+        \return the csv line without line break
+    */
+    std::string toCSV() const;
+
+    /**
+        Returns the header line of the csv output.
+        \return the csv line without line break
+    */
+    static const char* getCSVHeader();
+};
+
+/**
+    Plays a round robin tournament between AI players in headless mode. A tournament is described by an ini file:
+    <pre>
+    [TOURNAMENT]
+    Players=qBotEasy,qBotMedium,qBotHard
+    Maps=2P - Cliffs.ini,2P - Dunes.ini
+    Seeds=10
+    GameCycles=60000
+    Houses=Harkonnen,Atreides
+    </pre>
+    Every pair of players plays one game per map and seed (1 to Seeds); the players swap houses with every seed.
+    Map filenames are relative to the directory of the tournament file. A game that is not decided after GameCycles
+    counts as a draw. The result of every game is written as csv to stdout, followed by a summary of the win rate of
+    every pairing with its 95% confidence interval and the average game length. Replays of draws and of games won
+    by the weaker player are saved to the replay directory.
+    \param  filename        the filename of the tournament
+    \param  shardIndex      only play every numShards-th game starting with this one (0-based)
+    \param  numShards       the number of processes the tournament is split into
+    \param  maxGameCycle    overrides GameCycles of the tournament (0 = use GameCycles)
+    \return true if all games could be played, false if a game failed
+*/
+bool runTournament(const std::string& filename, int shardIndex = 0, int numShards = 1, Uint32 maxGameCycle = 0);
+
+#endif // TOURNAMENT_H
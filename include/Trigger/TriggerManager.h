@@ -23,7 +23,7 @@
 #include <misc/OutputStream.h>
 
 #include <memory>
-#include <list>
+#include <vector>
 
 /**
     This class manages triggers for the game play. A trigger is triggered at a specific game cycle.
@@ -62,13 +62,38 @@ public:
     void addTrigger(std::unique_ptr<Trigger> newTrigger);
 
     /**
-        This method returns a list of all the managed triggers.
-        \return a list of all the triggers
+        This method returns the first managed trigger (in no particular order) pred returns true for.
+        \param  pred    the predicate to check the triggers with
+        \return the found trigger or nullptr if there is none
     */
-    const std::list<std::unique_ptr<Trigger> >& getTriggers() const { return triggers; }
+    template<class Predicate>
+    Trigger* findTrigger(Predicate pred) const {
+        for(const QueuedTrigger& queuedTrigger : triggers) {
+            if(pred(queuedTrigger.pTrigger.get())) {
+                return queuedTrigger.pTrigger.get();
+            }
+        }
+        return nullptr;
+    }
 
 private:
-    std::list<std::unique_ptr<Trigger> > triggers;  ///< list of all triggers. sorted by the time when they shall be triggered.
+    struct QueuedTrigger {
+        std::unique_ptr<Trigger> pTrigger;  ///< the trigger
+        Uint32 sequenceNumber;              ///< the order the trigger was added in; triggers of the same cycle fire in this order
+    };
+
+    /**
+        Heap order for triggers: returns true if a shall be triggered after b.
+    */
+    static bool isTriggeredLater(const QueuedTrigger& a, const QueuedTrigger& b) {
+        if(a.pTrigger->getCycleNumber() != b.pTrigger->getCycleNumber()) {
+            return a.pTrigger->getCycleNumber() > b.pTrigger->getCycleNumber();
+        }
+        return a.sequenceNumber > b.sequenceNumber;
+    }
+
+    std::vector<QueuedTrigger> triggers;    ///< min-heap of all triggers. the front is the next trigger to trigger (see isTriggeredLater()).
+    Uint32 nextSequenceNumber = 0;          ///< the sequence number for the next added trigger
 
     typedef enum {
         Type_ReinforcementTrigger = 1,      ///< the trigger is of type ReinforcementTrigger
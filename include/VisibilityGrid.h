@@ -0,0 +1,114 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VISIBILITYGRID_H
+#define VISIBILITYGRID_H
+
+#include <DataTypes.h>
+#include <TileLayout.h>
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+class TilePlanes;
+
+/**
+    Reference counted vision of units and structures. Every object on the map is a vision source: The tiles inside its
+    view range are counted in the sight planes of TilePlanes and are never fogged while the count is nonzero. When a
+    source moves to a neighbour tile only the tiles entering and leaving its view range are touched (using
+    precomputed delta masks), so the cost of vision per cycle depends on the number of tile crossings instead of
+    units * range^2. Once the count of a tile drops to zero it is stamped with the current cycle and fogs over
+    after the usual delay, just as a tile revealed once by Map::viewMap().
+
+    Sources are not saved but restored from the objects on the map after loading.
+*/
+class VisibilityGrid {
+public:
+    explicit VisibilityGrid(TilePlanes& tilePlanes);
+
+    VisibilityGrid(const VisibilityGrid &) = delete;
+    VisibilityGrid(VisibilityGrid &&) = delete;
+    VisibilityGrid& operator=(const VisibilityGrid &) = delete;
+    VisibilityGrid& operator=(VisibilityGrid &&) = delete;
+
+    /**
+        Removes all vision sources. Has to be called after the tile planes were reset.
+        \param  newSizeX    the width of the map
+        \param  newSizeY    the height of the map
+    */
+    void reset(int newSizeX, int newSizeY);
+
+    /**
+        Sets the vision source of the object objectID. If the object already has a source it is moved, otherwise a new
+        one is added. Calling this again with unchanged parameters is cheap.
+        \param  objectID    the id of the object this source belongs to
+        \param  houseID     the house that sees through this source
+        \param  location    the tile the source is located at
+        \param  viewRange   the view range of the source in tiles
+        \param  cycle       the current game cycle
+    */
+    void setSource(Uint32 objectID, int houseID, const Coord& location, int viewRange, Uint32 cycle);
+
+    /**
+        Removes the vision source of the object objectID (if it has one).
+        \param  objectID    the id of the object
+        \param  cycle       the current game cycle
+    */
+    void removeSource(Uint32 objectID, Uint32 cycle);
+
+    /**
+        Returns the offsets of all tiles inside the view range viewRange around a tile.
+        Up to a range of 1 this is a square, above it is the diamond-like shape of blockDistanceApprox().
+    */
+    const std::vector<Coord>& getCircleMask(int viewRange);
+
+private:
+    struct VisionSource {
+        int     houseID;        ///< the house that sees through this source
+        Coord   location;       ///< the tile the source is located at
+        int     viewRange;      ///< the view range of this source
+    };
+
+    struct DeltaMask {
+        bool bCalculated = false;       ///< are the offset lists already filled?
+        std::vector<Coord> entering;    ///< offsets (relative to the new location) that are only in the new range
+        std::vector<Coord> leaving;     ///< offsets (relative to the old location) that are only in the old range
+    };
+
+    static bool isInRange(const Coord& offset, int viewRange);
+    static int getDirectionIndex(const Coord& step) { return (step.x + 1) * 3 + (step.y + 1); }
+
+    const DeltaMask& getDeltaMask(int viewRange, const Coord& step);
+
+    template<class OffsetList>
+    void addSight(int houseID, const Coord& location, const OffsetList& offsets, Uint32 cycle);
+
+    template<class OffsetList>
+    void removeSight(int houseID, const Coord& location, const OffsetList& offsets, Uint32 cycle);
+
+    TilePlanes& tilePlanes;                                     ///< the planes holding the sight counts
+    int sizeX = 0;                                              ///< the width of the map
+    int sizeY = 0;                                              ///< the height of the map
+    TileLayout layout;                                          ///< the tile order of tilePlanes
+
+    std::unordered_map<Uint32, VisionSource> sources;           ///< the vision source of each object
+    std::vector<std::vector<Coord>> circleMasks;                ///< the circle mask for each view range (lazily filled)
+    std::vector<std::array<DeltaMask, 9>> deltaMasks;           ///< for each view range the delta masks for the 9 possible steps
+};
+
+#endif // VISIBILITYGRID_H
@@ -1,6 +1,10 @@
 #ifndef __libfixmath_fix32_h__
 #define __libfixmath_fix32_h__
 
+#if !defined(FIXMATH_NO_INT128) && !defined(__SIZEOF_INT128__) && defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -120,9 +124,84 @@ extern fix32_t fix32_ssub(fix32_t a, fix32_t b) FIXMATH_FUNC_ATTRS;
 
 #endif
 
+/* 128 bit arithmetic is used for multiplication, division and square root where the
+ * compiler provides it. The results are bit-exact to the portable implementations below,
+ * which are also used as reference by the fixmath micro-benchmark (tests/Benchmarks).
+ * Define FIXMATH_NO_INT128 to always use the portable implementations.
+ */
+#if !defined(FIXMATH_NO_INT128) && defined(__SIZEOF_INT128__)
+#define FIXMATH_HAVE_INT128
+__extension__ typedef __int128 fix32_int128_t;
+__extension__ typedef unsigned __int128 fix32_uint128_t;
+#elif !defined(FIXMATH_NO_INT128) && defined(_MSC_VER) && defined(_M_X64)
+#define FIXMATH_HAVE_MUL128
+#endif
+
+/*! Portable 64-bit implementation of fix32_mul() using 32*32->64bit multiplications.
+*/
+extern fix32_t fix32_mul_portable(fix32_t inArg0, fix32_t inArg1) FIXMATH_FUNC_ATTRS;
+
+/*! Portable 64-bit implementation of fix32_div() using repeated 64/64 bit divisions.
+*/
+extern fix32_t fix32_div_portable(fix32_t inArg0, fix32_t inArg1) FIXMATH_FUNC_ATTRS;
+
+/*! Portable 64-bit implementation of fix32_sqrt() computing the root bit by bit.
+*/
+extern fix32_t fix32_sqrt_portable(fix32_t inValue) FIXMATH_FUNC_ATTRS;
+
+/*! Turns the 128 bit product of two fix32_t's into the (rounded) fix32_t result.
+ * Shared by all implementations of fix32_mul() to keep them bit-exact.
+ */
+static inline fix32_t fix32_mul_result(int64_t product_hi, uint64_t product_lo)
+{
+#ifndef FIXMATH_NO_OVERFLOW
+	// The upper 33 bits should all be the same (the sign).
+	if (product_hi >> 63 != product_hi >> 31)
+		return fix32_overflow;
+#endif
+
+#ifdef FIXMATH_NO_ROUNDING
+	return (product_hi << 32) | (product_lo >> 32);
+#else
+	// Subtracting 0x80000000 (= 0.5) and then using signed right shift
+	// achieves proper rounding to result-1, except in the corner
+	// case of negative numbers and lowest word = 0x80000000.
+	// To handle that, we also have to subtract 1 for negative numbers.
+	uint64_t product_lo_tmp = product_lo;
+	product_lo -= 0x80000000;
+	product_lo -= (uint64_t)product_hi >> 63;
+	if (product_lo > product_lo_tmp)
+		product_hi--;
+
+	// Discard the lowest 32 bits. Note that this is not exactly the same
+	// as dividing by 0x100000000. For example if product = -1, result will
+	// also be -1 and not 0. This is compensated by adding +1 to the result
+	// and compensating this in turn in the rounding above.
+	fix32_t result = (product_hi << 32) | (product_lo >> 32);
+	result += 1;
+	return result;
+#endif
+}
+
 /*! Multiplies the two given fix32_t's and returns the result.
 */
-extern fix32_t fix32_mul(fix32_t inArg0, fix32_t inArg1) FIXMATH_FUNC_ATTRS;
+#if defined(FIXMATH_HAVE_INT128)
+static inline fix32_t fix32_mul(fix32_t inArg0, fix32_t inArg1)
+{
+	fix32_int128_t product = (fix32_int128_t)inArg0 * inArg1;
+	return fix32_mul_result((int64_t)(product >> 64), (uint64_t)product);
+}
+#elif defined(FIXMATH_HAVE_MUL128)
+static inline fix32_t fix32_mul(fix32_t inArg0, fix32_t inArg1)
+{
+	int64_t product_hi;
+	uint64_t product_lo = (uint64_t)_mul128(inArg0, inArg1, &product_hi);
+	return fix32_mul_result(product_hi, product_lo);
+}
+#else
+static inline fix32_t fix32_mul(fix32_t inArg0, fix32_t inArg1)
+	{ return fix32_mul_portable(inArg0, inArg1); }
+#endif
 
 /*! Divides the first given fix32_t by the second and returns the result.
 */
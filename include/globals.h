@@ -23,14 +23,15 @@
 #include <Colors.h>
 #include <FileClasses/Palette.h>
 #include <data.h>
-#include <misc/RobustList.h>
 #include <misc/DrawingRectHelper.h>
+#include <GameContext.h>
 
 #include <misc/SDL2pp.h>
 
 #include <memory>
 
-#define _(msgid) pTextManager->getLocalized(msgid)
+// every call site looks its text up by a LocalizedStringID that is created on the first call (msgid has to be a string literal)
+#define _(msgid) pTextManager->getLocalized([]() -> const LocalizedStringID& { static const LocalizedStringID id(msgid); return id; }())
 
 // forward declarations
 class SoundPlayer;
@@ -42,15 +43,7 @@ class SFXManager;
 class FontManager;
 class TextManager;
 class NetworkManager;
-
-class Game;
-class Map;
-class ScreenBorder;
-class House;
-class HumanPlayer;
-class UnitBase;
-class StructureBase;
-class Bullet;
+class ScreenshotWriter;
 
 #ifndef SKIP_EXTERN_DEFINITION
  #define EXTERN extern
@@ -80,17 +73,20 @@ EXTERN std::unique_ptr<SFXManager>          pSFXManager;                ///< man
 EXTERN std::unique_ptr<FontManager>         pFontManager;               ///< manager for loading and managing fonts
 EXTERN std::unique_ptr<TextManager>         pTextManager;               ///< manager for loading and managing texts and providing localization
 EXTERN std::unique_ptr<NetworkManager>      pNetworkManager;            ///< manager for all network events (nullptr if not in multiplayer game)
-
-// game stuff
-EXTERN Game*                currentGame;                ///< the current running game
-EXTERN ScreenBorder*        screenborder;               ///< the screen border for the current running game
-EXTERN Map*                 currentGameMap;             ///< the map for the current running game
-EXTERN House*               pLocalHouse;                ///< the house of the human player that is playing the current running game on this computer
-EXTERN HumanPlayer*         pLocalPlayer;               ///< the player that is playing the current running game on this computer
-
-EXTERN RobustList<UnitBase*>       unitList;            ///< the list of all units
-EXTERN RobustList<StructureBase*>  structureList;       ///< the list of all structures
-EXTERN RobustList<Bullet*>         bulletList;          ///< the list of all bullets
+EXTERN std::unique_ptr<ScreenshotWriter>    pScreenshotWriter;          ///< encodes and writes screenshots in the background
+
+// game stuff (these refer to the game context of the calling thread, see GameContext)
+#define currentGame         (GameContext::getCurrent()->pGame)          ///< the current running game
+#define screenborder        (GameContext::getCurrent()->pScreenborder)  ///< the screen border for the current running game
+#define currentGameMap      (GameContext::getCurrent()->pMap)           ///< the map for the current running game
+#define pLocalHouse         (GameContext::getCurrent()->pLocalHouse)    ///< the house of the human player that is playing the current running game on this computer
+#define pLocalPlayer        (GameContext::getCurrent()->pLocalPlayer)   ///< the player that is playing the current running game on this computer
+
+#define unitList            (GameContext::getCurrent()->unitList)       ///< the list of all units
+#define structureList       (GameContext::getCurrent()->structureList)  ///< the list of all structures
+#define unitListByItemID        (GameContext::getCurrent()->unitListByItemID)       ///< the units of unitList by item id, e.g. unitListByItemID[Unit_Carryall]
+#define structureListByItemID   (GameContext::getCurrent()->structureListByItemID)  ///< the structures of structureList by item id, e.g. structureListByItemID[Structure_Refinery]
+#define bulletList          (GameContext::getCurrent()->bulletList)     ///< the list of all bullets
 
 
 // misc
@@ -36,6 +36,12 @@ int getLogicalToPhysicalResolutionFactor(int physicalWidth, int physicalHeight);
 */
 void setVideoMode();
 
+/**
+    Changes the resolution and fullscreen mode of the existing window to the ones in the settings. Only the graphics
+    that depend on the screen size are recreated, everything else stays loaded.
+*/
+void changeVideoMode();
+
 /**
     Toggles fullscreen and windowed mode
 */
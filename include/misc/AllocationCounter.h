@@ -0,0 +1,106 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <misc/SDL2pp.h>
+
+/// The subsystems the heap memory is accounted to (see ScopedMemoryTag)
+enum MemoryTag {
+    MemoryTag_Other,        ///< everything not allocated inside a tagged scope
+    MemoryTag_Graphics,     ///< GFXManager: surfaces and generated pictures
+    MemoryTag_Sound,        ///< SFXManager: sounds and voices
+    MemoryTag_Map,          ///< Map: tiles and the per tile data of the map systems
+    MemoryTag_Objects,      ///< units, structures and everything they allocate while updated
+    MemoryTag_AI,           ///< the AI players and their state
+
+    NUM_MEMORYTAGS
+};
+
+/**
+    Counts the heap allocations done with operator new, e.g. to check that drawing a frame does not allocate.
+    Allocations are only counted if PROFILING is defined (configure --enable-profiling): then the global operator
+    new is replaced by a counting one. Memory allocated by SDL or other C libraries with malloc() is not counted.
+
+    With PROFILING the allocated bytes are also accounted to the memory tag that was current on the allocating thread
+    (see ScopedMemoryTag). The tag is stored in front of every allocation, so the memory is subtracted from the right
+    tag no matter where it is freed.
+*/
+class AllocationCounter {
+public:
+    AllocationCounter() = delete;
+
+    /**
+        Returns the number of allocations the calling thread has done so far.
+        \return the number of allocations (always 0 if PROFILING is not defined)
+    */
+    static Uint32 getNumAllocations();
+
+    /**
+        Returns the bytes currently allocated with a tag by all threads.
+        \param  tag the memory tag
+        \return the allocated bytes (always 0 if PROFILING is not defined)
+    */
+    static Uint64 getAllocatedBytes(MemoryTag tag);
+
+    /**
+        Sets the memory tag of the calling thread.
+        \param  tag the new memory tag
+        \return the previous memory tag
+    */
+    static MemoryTag setCurrentTag(MemoryTag tag);
+
+    /**
+        Returns the name of a memory tag.
+        \param  tag the memory tag
+        \return the name
+    */
+    static const char* getTagName(MemoryTag tag);
+};
+
+/**
+    Accounts all heap allocations of the calling thread from its construction to its destruction to a memory tag.
+*/
+class ScopedMemoryTag {
+public:
+    explicit ScopedMemoryTag(MemoryTag tag)
+     : previousTag(AllocationCounter::setCurrentTag(tag)) {
+    }
+
+    ScopedMemoryTag(const ScopedMemoryTag &) = delete;
+    ScopedMemoryTag& operator=(const ScopedMemoryTag &) = delete;
+
+    ~ScopedMemoryTag() {
+        AllocationCounter::setCurrentTag(previousTag);
+    }
+
+private:
+    MemoryTag previousTag;      ///< the tag to restore on destruction
+};
+
+#ifdef PROFILING
+#define MEMORY_TAG_CONCAT_IMPL(a, b) a##b
+#define MEMORY_TAG_CONCAT(a, b) MEMORY_TAG_CONCAT_IMPL(a, b)
+/// Accounts the heap allocations of the rest of the enclosing block to tag
+#define MEMORY_TAG(tag) ScopedMemoryTag MEMORY_TAG_CONCAT(memoryTag, __LINE__)(tag)
+#else
+#define MEMORY_TAG(tag)
+#endif
+
+#endif // ALLOCATIONCOUNTER_H
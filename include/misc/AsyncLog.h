@@ -0,0 +1,81 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ASYNCLOG_H
+#define ASYNCLOG_H
+
+#include <misc/SDL2pp.h>
+
+#include <string>
+
+#define ASYNCLOG_FLUSH_INTERVAL     100             ///< milliseconds the queued messages are written after at the latest
+#define ASYNCLOG_MAX_PENDING        (1024*1024)     ///< bytes of queued messages; further messages are dropped until the next write
+
+#define LOG_CATEGORY_AI             SDL_LOG_CATEGORY_CUSTOM     ///< the SDL log category of the AI players (see Player::logDebug())
+
+/**
+    The backend of the SDL log output function. Instead of writing and flushing stderr for every message the messages
+    are appended to a buffer that a background thread writes out every ASYNCLOG_FLUSH_INTERVAL milliseconds, so logging
+    does not stall the game or distort its timings. Messages of priority SDL_LOG_PRIORITY_ERROR or above are written
+    immediately. Before start() and after the program ends every message is written directly.
+
+    Which messages are logged at all is still controlled per category by SDL_LogSetPriority().
+*/
+class AsyncLog {
+public:
+    AsyncLog() = delete;
+
+    /**
+        Starts the writer thread. The remaining messages are written when the program exits.
+    */
+    static void start();
+
+    /**
+        Queues a message for being written to stderr.
+        \param  message the message (without trailing newline)
+        \param  bFlush  write the message and all queued messages before returning?
+    */
+    static void write(const char* message, bool bFlush = false);
+
+    /**
+        Writes all queued messages before returning.
+    */
+    static void flush();
+
+    /**
+        Parses the name of a log priority (verbose, debug, info, warn, error or critical).
+        \param  name        the name of the priority (case insensitive)
+        \param  priority    the parsed priority is stored here
+        \return true on success, false if name is no priority
+    */
+    static bool parsePriority(const std::string& name, SDL_LogPriority& priority);
+
+    /**
+        Parses the name of a log category (application, error, assert, system, audio, video, render, input or ai).
+        \param  name        the name of the category (case insensitive)
+        \param  category    the parsed category is stored here
+        \return true on success, false if name is no category
+    */
+    static bool parseCategory(const std::string& name, int& category);
+
+private:
+    static void stop();
+    static int writerThreadMain(void* data);
+};
+
+#endif // ASYNCLOG_H
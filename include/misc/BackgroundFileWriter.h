@@ -0,0 +1,96 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BACKGROUNDFILEWRITER_H
+#define BACKGROUNDFILEWRITER_H
+
+#include <misc/SDL2pp.h>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class OMemoryStream;
+
+/**
+    Compresses (see OCompressedStream) and writes files on a background thread, so the game thread only has to
+    serialize the data into memory. Every file is first written to "<filename>.tmp" and then renamed, so an
+    interrupted write never destroys an existing file. Files are written in the order they were queued.
+*/
+class BackgroundFileWriter final {
+public:
+    BackgroundFileWriter();
+
+    BackgroundFileWriter(const BackgroundFileWriter &) = delete;
+    BackgroundFileWriter(BackgroundFileWriter &&) = delete;
+    BackgroundFileWriter& operator=(const BackgroundFileWriter &) = delete;
+    BackgroundFileWriter& operator=(BackgroundFileWriter &&) = delete;
+
+    /// Destructor. Writes all queued files before returning.
+    ~BackgroundFileWriter();
+
+    /**
+        Queues pData for being compressed and written to filename.
+        \param  filename    the file to write
+        \param  pData       the data to write
+    */
+    void writeFile(const std::string& filename, std::unique_ptr<OMemoryStream> pData);
+
+    /**
+        Queues a file whose data is created by createData on the background thread right before it is written. This
+        allows to move expensive encoding off the game thread; createData must only access data that is not changed
+        by the game thread anymore (e.g. a std::shared_ptr<const std::string> it owns).
+        \param  filename    the file to write
+        \param  createData  returns the data to write
+    */
+    void writeFile(const std::string& filename, std::function<std::unique_ptr<OMemoryStream>()> createData);
+
+    /**
+        Blocks until all queued files are written.
+    */
+    void waitUntilIdle();
+
+    /**
+        Returns the files that could not be written since the last call.
+        \return the names of the files that were not written
+    */
+    std::vector<std::string> getFailedFiles();
+
+private:
+    struct Job {
+        std::string filename;                                       ///< the file to write
+        std::unique_ptr<OMemoryStream> pData;                       ///< the data to write
+        std::function<std::unique_ptr<OMemoryStream>()> createData; ///< creates pData if it is nullptr (both empty tells the thread to exit)
+    };
+
+    void queueJob(Job&& job);
+    static int writerThreadMain(void* data);
+    static bool write(Job& job);
+
+    SDL_Thread* pThread = nullptr;              ///< the writer thread
+    SDL_mutex* mutex = nullptr;                 ///< guards jobs, numPendingJobs and failedFiles
+    SDL_sem* availableJobsSemaphore = nullptr;  ///< posted once per queued job
+    SDL_cond* idleCondition = nullptr;          ///< signaled when numPendingJobs drops to zero
+
+    std::deque<Job> jobs;                       ///< the queued jobs
+    int numPendingJobs = 0;                     ///< the number of queued or currently written files
+    std::vector<std::string> failedFiles;       ///< the files that could not be written
+};
+
+#endif // BACKGROUNDFILEWRITER_H
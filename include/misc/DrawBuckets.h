@@ -0,0 +1,152 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DRAWBUCKETS_H
+#define DRAWBUCKETS_H
+
+#include <DataTypes.h>
+
+#include <algorithm>
+#include <vector>
+
+#define DRAWBUCKETS_CELLSIZE    8   ///< width and height of one bucket in tiles
+
+/**
+    A uniform grid over the map with the short living effects of type T (bullets and explosions) in each cell. The
+    effects add themselves when they are created, move between the cells when they enter another one and remove
+    themselves when they are destroyed. Drawing only visits the cells intersecting the visible part of the map instead
+    of testing every effect of the map against the screen.
+    Effects outside the map are kept in the nearest border cell.
+*/
+template<typename T>
+class DrawBuckets {
+public:
+    DrawBuckets() = default;
+
+    DrawBuckets(const DrawBuckets &) = delete;
+    DrawBuckets(DrawBuckets &&) = delete;
+    DrawBuckets& operator=(const DrawBuckets &) = delete;
+    DrawBuckets& operator=(DrawBuckets &&) = delete;
+
+    /**
+        Removes all effects and resizes the grid to a map of the given size.
+        \param  mapSizeX    the width of the map
+        \param  mapSizeY    the height of the map
+    */
+    void reset(int mapSizeX, int mapSizeY) {
+        numCellsX = std::max(1, (mapSizeX + DRAWBUCKETS_CELLSIZE - 1) / DRAWBUCKETS_CELLSIZE);
+        numCellsY = std::max(1, (mapSizeY + DRAWBUCKETS_CELLSIZE - 1) / DRAWBUCKETS_CELLSIZE);
+        cells.clear();
+        cells.resize(numCellsX*numCellsY);
+        nextOrder = 0;
+    }
+
+    /**
+        Adds pEffect at the tile location.
+        \return the cell pEffect was added to (needed for move() and remove())
+    */
+    int add(const T* pEffect, const Coord& location) {
+        const int cell = getCellIndex(location);
+        cells[cell].push_back( { nextOrder++, pEffect } );
+        return cell;
+    }
+
+    /**
+        Moves pEffect to the cell of the tile location.
+        \param  pEffect     the effect to move
+        \param  cell        the cell returned by add() or the last move()
+        \param  location    the new tile location of pEffect
+        \return the cell pEffect is in now
+    */
+    int move(const T* pEffect, int cell, const Coord& location) {
+        const int newCell = getCellIndex(location);
+        if((newCell != cell) && (cell >= 0)) {
+            std::vector<Entry>& oldEntries = cells[cell];
+            auto iter = std::find_if(oldEntries.begin(), oldEntries.end(), [pEffect](const Entry& entry) { return entry.pEffect == pEffect; });
+            if(iter != oldEntries.end()) {
+                cells[newCell].push_back(*iter);
+                *iter = oldEntries.back();
+                oldEntries.pop_back();
+            }
+        }
+        return newCell;
+    }
+
+    /**
+        Removes pEffect from the cell it was added or moved to.
+    */
+    void remove(const T* pEffect, int cell) {
+        if((cell < 0) || (cell >= static_cast<int>(cells.size()))) {
+            return;
+        }
+
+        std::vector<Entry>& entries = cells[cell];
+        auto iter = std::find_if(entries.begin(), entries.end(), [pEffect](const Entry& entry) { return entry.pEffect == pEffect; });
+        if(iter != entries.end()) {
+            *iter = entries.back();
+            entries.pop_back();
+        }
+    }
+
+    /**
+        Calls f(pEffect) for every effect in the cells intersecting the tile rectangle from topLeft to bottomRight
+        (inclusive) and their neighbour cells, so that the sprites of effects just outside the rectangle are not missed.
+        The effects are visited in the order they were added, i.e. they are drawn on top of each other as before.
+    */
+    template<typename F>
+    void forEachVisible(const Coord& topLeft, const Coord& bottomRight, F&& f) {
+        const int minCellX = std::max(0, topLeft.x / DRAWBUCKETS_CELLSIZE - 1);
+        const int minCellY = std::max(0, topLeft.y / DRAWBUCKETS_CELLSIZE - 1);
+        const int maxCellX = std::min(numCellsX - 1, bottomRight.x / DRAWBUCKETS_CELLSIZE + 1);
+        const int maxCellY = std::min(numCellsY - 1, bottomRight.y / DRAWBUCKETS_CELLSIZE + 1);
+
+        visibleEntries.clear();
+        for(int cy = minCellY; cy <= maxCellY; cy++) {
+            for(int cx = minCellX; cx <= maxCellX; cx++) {
+                const std::vector<Entry>& entries = cells[cy*numCellsX + cx];
+                visibleEntries.insert(visibleEntries.end(), entries.begin(), entries.end());
+            }
+        }
+
+        std::sort(visibleEntries.begin(), visibleEntries.end(), [](const Entry& a, const Entry& b) { return a.order < b.order; });
+
+        for(const Entry& entry : visibleEntries) {
+            f(entry.pEffect);
+        }
+    }
+
+private:
+    struct Entry {
+        Uint32 order;       ///< the number of effects added before this one
+        const T* pEffect;   ///< the effect
+    };
+
+    int getCellIndex(const Coord& location) const noexcept {
+        const int cx = std::min(numCellsX - 1, std::max(0, location.x) / DRAWBUCKETS_CELLSIZE);
+        const int cy = std::min(numCellsY - 1, std::max(0, location.y) / DRAWBUCKETS_CELLSIZE);
+        return cy*numCellsX + cx;
+    }
+
+    int numCellsX = 0;                      ///< number of cells in x direction
+    int numCellsY = 0;                      ///< number of cells in y direction
+    std::vector<std::vector<Entry>> cells;  ///< the effects in each cell
+    std::vector<Entry> visibleEntries;      ///< reusable buffer for forEachVisible()
+    Uint32 nextOrder = 0;                   ///< the order of the next effect added
+};
+
+#endif // DRAWBUCKETS_H
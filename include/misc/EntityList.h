@@ -0,0 +1,219 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ENTITYLIST_H
+#define ENTITYLIST_H
+
+#include <SimulationStats.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+    A list of pointers to game entities (units, structures) stored in one contiguous vector. Like RobustList
+    elements may be removed while the list is iterated, but iterating is a linear walk over the vector and
+    iterators do not register at the list.
+
+    remove() only replaces the element by a nullptr tombstone which is skipped by all iterators. The tombstones
+    are erased when the last iterator of the list is destroyed, i.e. at the end of the outermost loop over the list.
+    Elements added while iterating are visited by the running loops. The order of the elements is the order
+    they were added in.
+*/
+template<typename T>
+class EntityList {
+public:
+    class const_iterator {
+    public:
+        const_iterator(const const_iterator& x)
+         : pList(x.pList), index(x.index) {
+            if(pList != nullptr) {
+                pList->numIterators++;
+            }
+        }
+
+        ~const_iterator() {
+            if(pList != nullptr) {
+                pList->releaseIterator();
+            }
+        }
+
+        const_iterator& operator=(const const_iterator& x) {
+            if(pList != x.pList) {
+                if(x.pList != nullptr) {
+                    x.pList->numIterators++;
+                }
+                if(pList != nullptr) {
+                    pList->releaseIterator();
+                }
+                pList = x.pList;
+            }
+            index = x.index;
+            return *this;
+        }
+
+        const T& operator*() const {
+            return pList->elements[index];
+        }
+
+        const_iterator& operator++() {
+            index++;
+            skipTombstones();
+            return *this;
+        }
+
+        /**
+            Compares two iterators. The end iterator compares equal to every iterator that went past the last element.
+        */
+        bool operator==(const const_iterator& x) const {
+            if(pList == nullptr) {
+                return (x.pList == nullptr) || x.isAtEnd();
+            } else if(x.pList == nullptr) {
+                return isAtEnd();
+            } else {
+                return index == x.index;
+            }
+        }
+
+        bool operator!=(const const_iterator& x) const {
+            return !operator==(x);
+        }
+
+    private:
+        friend class EntityList<T>;
+
+        const_iterator(const EntityList<T>* pList, size_t index)
+         : pList(pList), index(index) {
+            if(pList != nullptr) {
+                COUNT_SIMULATION_EVENT(SimulationCounter_EntityListIterators);
+                pList->numIterators++;
+                skipTombstones();
+            }
+        }
+
+        bool isAtEnd() const {
+            // elements might be added while iterating so the end is not fixed
+            return index >= pList->elements.size();
+        }
+
+        void skipTombstones() {
+            while(!isAtEnd() && (pList->elements[index] == nullptr)) {
+                index++;
+            }
+        }
+
+        const EntityList<T>* pList;     ///< the list this iterator belongs to (nullptr for the end iterator)
+        size_t index;                   ///< the position in the list
+    };
+
+    typedef const_iterator iterator;
+
+    EntityList() = default;
+    EntityList(const EntityList &) = delete;
+    EntityList(EntityList &&) = delete;
+    EntityList& operator=(const EntityList &) = delete;
+    EntityList& operator=(EntityList &&) = delete;
+
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(nullptr, 0);
+    }
+
+    /**
+        Returns the number of elements in this list (tombstones are not counted).
+    */
+    int size() const {
+        return static_cast<int>(elements.size() - numRemoved);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+        Returns a number that changes whenever an element is added or removed. Caches derived from the elements can
+        compare it to the value they were built with.
+        \return the number of modifications of this list so far
+    */
+    Uint32 getVersion() const {
+        return version;
+    }
+
+    void push_back(const T& x) {
+        elements.push_back(x);
+        version++;
+    }
+
+    /**
+        Allocates memory for n elements so that adding up to n elements does not reallocate.
+        \param  n   the number of elements
+    */
+    void reserve(size_t n) {
+        elements.reserve(n);
+    }
+
+    /**
+        Removes value from this list. If this list is currently iterated the element is only marked as removed.
+        \param  value   the element to remove
+    */
+    void remove(const T& value) {
+        auto iter = std::find(elements.begin(), elements.end(), value);
+        if(iter == elements.end()) {
+            return;
+        }
+
+        version++;
+
+        if(numIterators == 0) {
+            elements.erase(iter);
+        } else {
+            *iter = nullptr;
+            numRemoved++;
+        }
+    }
+
+    void clear() {
+        version++;
+
+        if(numIterators == 0) {
+            elements.clear();
+            numRemoved = 0;
+        } else {
+            std::fill(elements.begin(), elements.end(), nullptr);
+            numRemoved = elements.size();
+        }
+    }
+
+private:
+    void releaseIterator() const {
+        if((--numIterators == 0) && (numRemoved > 0)) {
+            // the outermost loop is finished, erase all tombstones
+            elements.erase(std::remove(elements.begin(), elements.end(), nullptr), elements.end());
+            numRemoved = 0;
+        }
+    }
+
+    mutable std::vector<T> elements;    ///< all elements (nullptr if removed while iterating)
+    mutable size_t numRemoved = 0;      ///< number of tombstones in elements
+    mutable int numIterators = 0;       ///< number of iterators currently alive
+    Uint32 version = 0;                 ///< incremented by every modification (see getVersion())
+};
+
+#endif // ENTITYLIST_H
@@ -22,6 +22,8 @@
 #include <list>
 #include <stdint.h>
 
+#define FILELISTCACHE_MINAGE    2   // directories modified within this many seconds are not cached as later changes in the same second would not be noticed
+
 
 class FileInfo {
 public:
@@ -50,7 +52,7 @@ enum FileListOrder {
     This function finds all the files in the specified directory with the specified
     extension.
     \param  directory   the directory name
-    \param  extension   the extension to search for
+    \param  extension   the extension to search for (an empty extension matches all files)
     \param  bIgnoreCase true = extension comparison is case insensitive
     \return a list of all the files with the specified extension
 */
@@ -61,12 +63,19 @@ std::list<std::string> getFileNamesList(const std::string& directory, const std:
     This function finds all the files in the specified directory with the specified
     extension.
     \param  directory   the directory name
-    \param  extension   the extension to search for
+    \param  extension   the extension to search for (an empty extension matches all files)
     \param  IgnoreCase  true = extension comparison is case insensitive
     \return a list of all the files with the specified extension
 */
 std::list<FileInfo> getFileList(const std::string& directory, const std::string& extension, bool IgnoreCase = false, FileListOrder fileListOrder = FileListOrder_Unsorted);
 
+/**
+    getFileList() caches the content of each directory until the directory itself is modified. Writing to an already existing
+    file does not modify the directory, therefore this function has to be called afterwards to forget the cached file sizes
+    and modification dates.
+*/
+void invalidateFileListCache();
+
 /**
     This function is used to determine a case insensitive filename. The parameter filepath specifies the complete path to the file (relative or absolute).
     The path components are treated case sensitive to determine the directory to search the file in. The filename component of filepath is then compared
@@ -0,0 +1,73 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <misc/string_util.h>
+
+#include <deque>
+#include <string>
+
+/**
+    Scratch memory for the texts built while drawing one frame, e.g. numbers on the builder buttons or the fps counter.
+    The strings are handed out one after the other and are all given back at once by reset() at the start of the next
+    frame. They keep their capacity, so after the first few frames building the texts of a frame needs no heap
+    allocation. A string is only valid until the next reset(); whoever needs it longer has to copy it.
+*/
+class FrameArena {
+public:
+    FrameArena() = default;
+    FrameArena(const FrameArena &) = delete;
+    FrameArena& operator=(const FrameArena &) = delete;
+
+    /**
+        Gives back all strings. To be called once at the start of every frame.
+    */
+    void reset() {
+        numUsedStrings = 0;
+    }
+
+    /**
+        Returns the next unused string of this frame. It is empty but keeps the capacity from earlier frames.
+        \return the string (valid until the next reset())
+    */
+    std::string& allocateString();
+
+    /**
+        Copies a text into the next unused string of this frame, e.g. to pass a C string to a function taking a std::string.
+        \param  text    the text to copy
+        \return the copy (valid until the next reset())
+    */
+    const std::string& copy(const char* text) {
+        return allocateString().assign(text);
+    }
+
+    /**
+        Formats a text like printf into the next unused string of this frame.
+        \param  fmt the format string
+        \return the formatted text (valid until the next reset())
+    */
+    const std::string& sprintf(PRINTF_FORMAT_STRING const char* fmt, ...) PRINTF_VARARG_FUNC(2);
+
+private:
+    std::deque<std::string> strings;    ///< all strings handed out so far (a deque, so growing does not move them)
+    size_t numUsedStrings = 0;          ///< the number of strings handed out in the current frame
+};
+
+#endif // FRAMEARENA_H
@@ -0,0 +1,67 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <SDL2/SDL.h>
+
+#define FRAMEPACER_DEFAULT_FRAMETIME    32      ///< milliseconds per frame with the frame limit on (about 31 fps)
+
+/**
+    Paces the frames of a main loop to a fixed frame time. Instead of sleeping for the remaining milliseconds of each
+    frame it sleeps until a deadline on the high resolution performance counter, so rounding errors do not add up
+    and a slow frame does not shift all following frames. The sleep is done with SDL_Delay() and only the last
+    fraction of a millisecond is spent waiting actively. If the renderer waits for the vertical retrace itself,
+    the pacer wakes up half a refresh interval early and leaves the rest of the wait to SDL_RenderPresent().
+*/
+class FramePacer final {
+public:
+    /**
+        Constructor
+        \param  frameTime   the time per frame in milliseconds
+    */
+    explicit FramePacer(Uint32 frameTime = FRAMEPACER_DEFAULT_FRAMETIME);
+
+    /**
+        Changes the time per frame. The deadline of the current frame is not changed.
+        \param  frameTime   the time per frame in milliseconds
+    */
+    void setFrameTime(Uint32 frameTime);
+
+    /**
+        Sleeps until the deadline of the next frame. Returns immediately if the current frame already took longer.
+    */
+    void waitForNextFrame() { wait(false); }
+
+    /**
+        Like waitForNextFrame() but wakes up early if an event arrives. The event is not removed from the event queue.
+        \return true if an event is pending, false if the deadline was reached
+    */
+    bool waitForNextFrameOrEvent() { return wait(true); }
+
+private:
+    bool wait(bool bWakeOnEvent);
+
+    Uint64  counterFrequency;       ///< performance counter ticks per second
+    Uint64  frameDuration;          ///< performance counter ticks per frame
+    Uint64  vsyncMargin = 0;        ///< performance counter ticks left to SDL_RenderPresent() if it waits for the retrace
+    Uint64  lastDeadline = 0;       ///< the deadline of the last frame (0 = none yet)
+};
+
+#endif // FRAMEPACER_H
@@ -0,0 +1,86 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ICOMPRESSEDSTREAM_H
+#define ICOMPRESSEDSTREAM_H
+
+#include "InputStream.h"
+
+#include <memory>
+#include <string>
+
+/**
+    Reads a stream written by OCompressedStream. Only one block is decompressed at a time, so a big stream is never
+    held completely in memory.
+*/
+class ICompressedStream : public InputStream
+{
+public:
+    /**
+        Constructor. COMPRESSEDSTREAM_MAGIC must already be read from stream.
+        \param  stream  the stream to read the compressed blocks from; has to outlive this stream
+    */
+    explicit ICompressedStream(InputStream& stream);
+
+    /**
+        Constructor taking ownership of the stream. COMPRESSEDSTREAM_MAGIC must already be read from pStream.
+        \param  pStream the stream to read the compressed blocks from
+    */
+    explicit ICompressedStream(std::unique_ptr<InputStream> pStream);
+
+    ~ICompressedStream();
+
+    ICompressedStream(const ICompressedStream&) = delete;
+    ICompressedStream& operator=(const ICompressedStream&) = delete;
+
+    /**
+        Opens a file that was either written directly or through an OCompressedStream.
+        \param  filename    the file to open
+        \return the stream to read the (decompressed) file from or nullptr if the file cannot be opened
+    */
+    static std::unique_ptr<InputStream> openFile(const std::string& filename);
+
+    /**
+        Decompresses data written by an OCompressedStream.
+        \param  data    the data to decompress
+        \return the decompressed data or data itself if it is not compressed
+    */
+    static std::string decompress(const std::string& data);
+
+    std::string readString() override;
+
+    Uint8 readUint8() override;
+    Uint16 readUint16() override;
+    Uint32 readUint32() override;
+    Uint64 readUint64() override;
+    bool readBool() override;
+    float readFloat() override;
+
+    void readBytes(void* data, size_t length) override;
+
+private:
+    void readBlock();
+
+    std::unique_ptr<InputStream> pOwnedStream;  ///< the stream if owned by this stream
+    InputStream&    stream;                     ///< the stream the blocks are read from
+    std::string     block;                      ///< the current decompressed block
+    size_t          blockPos = 0;               ///< the read position in block
+    bool            bEndReached = false;        ///< was the block marking the end of the stream read
+    void*           pRangeCoder;                ///< the context of the ENet range coder
+};
+
+#endif // ICOMPRESSEDSTREAM_H
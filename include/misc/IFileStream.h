@@ -21,6 +21,9 @@
 #include "InputStream.h"
 #include <stdlib.h>
 #include <string>
+#include <vector>
+
+#define IFILESTREAM_BUFFERSIZE  (64*1024)   ///< the number of bytes read from the file at once
 
 class IFileStream : public InputStream
 {
@@ -41,8 +44,13 @@ public:
     bool readBool() override;
     float readFloat() override;
 
+    void readBytes(void* data, size_t length) override;
+
 private:
     FILE* fp;
+    std::vector<char> buffer;   ///< the data read ahead from fp
+    size_t bufferPos = 0;       ///< the next byte to read from buffer
+    size_t bufferFill = 0;      ///< the number of valid bytes in buffer
 };
 
 #endif // IFILESTREAM_H
@@ -26,7 +26,7 @@
 #include <memory.h>
 #include <string>
 
-class IMemoryStream : public InputStream
+class IMemoryStream final : public InputStream
 {
 public:
     IMemoryStream()
@@ -39,6 +39,19 @@ public:
         ;
     }
 
+    /**
+        Constructs a stream that owns the data it reads from.
+        \param  data    the data to read
+    */
+    explicit IMemoryStream(std::string&& data)
+     : currentPos(0), ownedData(std::move(data)) {
+        bufferSize = ownedData.size();
+        pBuffer = ownedData.data();
+    }
+
+    IMemoryStream(const IMemoryStream&) = delete;
+    IMemoryStream& operator=(const IMemoryStream&) = delete;
+
     ~IMemoryStream() = default;
 
     void open(const char* data, int length) {
@@ -117,10 +130,21 @@ public:
         return tmp2;
     }
 
+    void readBytes(void* data, size_t length) override
+    {
+        if(currentPos + length > bufferSize) {
+            THROW(InputStream::eof, "IMemoryStream::readBytes(): End-of-File reached!");
+        }
+
+        memcpy(data, pBuffer + currentPos, length);
+        currentPos += length;
+    }
+
 private:
     size_t      currentPos;
     size_t      bufferSize;
     const char* pBuffer;
+    std::string ownedData;      ///< the data if it is owned by this stream
 };
 
 #endif // IMEMORYSTREAM_H
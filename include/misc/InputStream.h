@@ -20,6 +20,7 @@
 
 #include <fixmath/FixPoint.h>
 #include <misc/SDL2pp.h>
+#include <misc/exceptions.h>
 
 #include <string>
 #include <list>
@@ -46,6 +47,19 @@ public:
     virtual bool readBool() = 0;
     virtual float readFloat() = 0;
 
+    /**
+        Reads in length raw bytes. The default implementation reads them one by one, streams that are backed by a
+        buffer or a file read them at once.
+        \param  data    the buffer to read into
+        \param  length  the number of bytes to read
+    */
+    virtual void readBytes(void* data, size_t length) {
+        Uint8* pData = static_cast<Uint8*>(data);
+        for(size_t i = 0; i < length; i++) {
+            pData[i] = readUint8();
+        }
+    }
+
     /**
         Reads in a Sint8 value.
         \return the read value
@@ -82,6 +96,54 @@ public:
         return *((Sint64*) &tmp);
     }
 
+    /**
+        Reads in count Uint32 values written by writeUint32Array().
+        \param  data    the array to read into
+        \param  count   the number of values to read
+    */
+    void readUint32Array(Uint32* data, size_t count) {
+        readBytes(data, count * sizeof(Uint32));
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+        for(size_t i = 0; i < count; i++) {
+            data[i] = SDL_SwapLE32(data[i]);
+        }
+#endif
+    }
+
+    /**
+        Reads in count Sint32 values written by writeSint32Array().
+        \param  data    the array to read into
+        \param  count   the number of values to read
+    */
+    void readSint32Array(Sint32* data, size_t count) {
+        readUint32Array(reinterpret_cast<Uint32*>(data), count);
+    }
+
+    /**
+        Reads in a Uint32 value written by writeVarUint32().
+        \return the read value
+    */
+    Uint32 readVarUint32() {
+        Uint32 x = 0;
+        for(int shift = 0; shift < 35; shift += 7) {
+            Uint8 tmp = readUint8();
+            x |= static_cast<Uint32>(tmp & 0x7F) << shift;
+            if((tmp & 0x80) == 0) {
+                return x;
+            }
+        }
+        THROW(InputStream::error, "InputStream::readVarUint32(): Variable length integer is too long!");
+    }
+
+    /**
+        Reads in a Sint32 value written by writeVarSint32().
+        \return the read value
+    */
+    Sint32 readVarSint32() {
+        Uint32 tmp = readVarUint32();
+        return static_cast<Sint32>((tmp >> 1) ^ (~(tmp & 1) + 1));
+    }
+
     /**
         Reads in a FixPoint value.
         \return the read value
@@ -128,16 +190,27 @@ public:
         return List;
     }
 
+    /**
+        Reads a list of Uint32 written by writeUint32List() into container.
+        \param  container   the container to fill (must provide clear() and push_back())
+    */
+    template<class Container>
+    void readUint32List(Container& container) {
+        container.clear();
+        Uint32 size = readUint32();
+        for(unsigned int i=0; i < size; i++) {
+            container.push_back(readUint32());
+        }
+    }
+
     /**
         Reads a vector of Uint32 written by writeUint32Vector().
         \return the read vector
     */
     std::vector<Uint32> readUint32Vector() {
-        std::vector<Uint32> vec;
         Uint32 size = readUint32();
-        for(unsigned int i=0; i < size; i++) {
-            vec.push_back(readUint32());
-        }
+        std::vector<Uint32> vec(size);
+        readUint32Array(vec.data(), size);
         return vec;
     }
 
@@ -0,0 +1,76 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OCOMPRESSEDSTREAM_H
+#define OCOMPRESSEDSTREAM_H
+
+#include "OutputStream.h"
+
+#include <string>
+#include <vector>
+
+#define COMPRESSEDSTREAM_MAGIC      0x5A4C4444              ///< marks the beginning of a compressed stream (different from all other magic numbers at the beginning of files)
+#define COMPRESSEDSTREAM_BLOCKSIZE  (64*1024)               ///< the data is compressed in blocks of this size
+
+/**
+    Compresses everything written to it with the range coder of ENet and writes it to another stream. The format is
+    COMPRESSEDSTREAM_MAGIC followed by blocks consisting of the uncompressed size (Uint32) and the compressed data (string).
+    A block that cannot be compressed is stored as it is. A block with uncompressed size 0 marks the end of the stream.
+    See ICompressedStream for reading it.
+*/
+class OCompressedStream : public OutputStream
+{
+public:
+    /**
+        Constructor
+        \param  stream  the stream to write the compressed data to; has to outlive this stream
+    */
+    explicit OCompressedStream(OutputStream& stream);
+    ~OCompressedStream();
+
+    OCompressedStream(const OCompressedStream&) = delete;
+    OCompressedStream& operator=(const OCompressedStream&) = delete;
+
+    /**
+        Writes the remaining data and the end of the stream. Nothing can be written afterwards.
+    */
+    void close();
+
+    void flush() override;
+
+    void writeString(const std::string& str) override;
+
+    void writeUint8(Uint8 x) override;
+    void writeUint16(Uint16 x) override;
+    void writeUint32(Uint32 x) override;
+    void writeUint64(Uint64 x) override;
+    void writeBool(bool x) override;
+    void writeFloat(float x) override;
+
+    void writeBytes(const void* data, size_t length) override;
+
+private:
+    void writeBlock();
+
+    OutputStream&   stream;                     ///< the stream the blocks are written to
+    std::string     block;                      ///< the data of the current block that is not compressed yet
+    std::vector<Uint8> compressedBlock;         ///< buffer for compressing a block
+    void*           pRangeCoder;                ///< the context of the ENet range coder
+    bool            bClosed = false;            ///< was close() already called
+};
+
+#endif // OCOMPRESSEDSTREAM_H
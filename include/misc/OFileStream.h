@@ -19,8 +19,12 @@
 #define OFILESTREAM_H
 
 #include "OutputStream.h"
+#include <misc/SDL2pp.h>
 #include <stdlib.h>
 #include <string>
+#include <vector>
+
+#define OFILESTREAM_BUFFERSIZE  (64*1024)   ///< the number of bytes written to the file at once
 
 class OFileStream : public OutputStream
 {
@@ -32,6 +36,14 @@ public:
     bool open(const std::string& filename);
     void close();
 
+    /**
+        Enables writing full buffers on a background thread. The game thread then only copies the data into the buffer and
+        never waits for the disk unless flush() or close() is called or the previous buffer is still being written.
+        Call this after open(); close() disables it again.
+        \param  bAsyncFlush true = write on a background thread, false = write on the calling thread
+    */
+    void setAsyncFlush(bool bAsyncFlush);
+
     void flush() override;
 
     // write operations
@@ -45,8 +57,25 @@ public:
     void writeBool(bool x) override;
     void writeFloat(float x) override;
 
+    void writeBytes(const void* data, size_t length) override;
+
 private:
+    bool flushBuffer();
+    bool waitForPendingWrite();
+    void stopFlushThread();
+
+    static int flushThreadMain(void* data);
+
     FILE* fp;
+    std::vector<char> buffer;   ///< the data not written to fp yet
+
+    SDL_Thread* pFlushThread = nullptr;     ///< the thread writing pendingBuffer if async flushing is enabled
+    SDL_mutex* flushMutex = nullptr;        ///< guards pendingBuffer, bPendingWrite, bQuitFlushThread and bAsyncWriteError
+    SDL_cond* flushCondition = nullptr;     ///< signaled whenever bPendingWrite or bQuitFlushThread changes
+    std::vector<char> pendingBuffer;        ///< the data handed to pFlushThread
+    bool bPendingWrite = false;             ///< pendingBuffer is not written yet
+    bool bQuitFlushThread = false;          ///< tells pFlushThread to exit
+    bool bAsyncWriteError = false;          ///< pFlushThread got an I/O-Error
 };
 
 #endif // OFILESTREAM_H
@@ -22,7 +22,7 @@
 #include <stdlib.h>
 #include <string>
 
-class OMemoryStream : public OutputStream
+class OMemoryStream final : public OutputStream
 {
 public:
     OMemoryStream()
@@ -50,7 +50,7 @@ public:
     }
 
     size_t getDataLength() const {
-        return (bReadOnly == true) ? bufferSize : currentPos;
+        return currentPos;
     }
 
     void flush() override
@@ -117,6 +117,13 @@ public:
         writeUint32(tmp);
     }
 
+    void writeBytes(const void* data, size_t length) override
+    {
+        ensureBufferSize(currentPos + length);
+        memcpy(pBuffer + currentPos, data, length);
+        currentPos += length;
+    }
+
     void ensureBufferSize(size_t minBufferSize) {
         if(minBufferSize < bufferSize) {
             return;
@@ -0,0 +1,88 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OBJECTARENA_H
+#define OBJECTARENA_H
+
+#include <misc/SDL2pp.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#define OBJECTARENA_GRANULARITY     32          ///< the block sizes of the size classes are multiples of this
+#define OBJECTARENA_NUM_SIZECLASSES 64          ///< blocks up to OBJECTARENA_GRANULARITY*OBJECTARENA_NUM_SIZECLASSES bytes come from the arena
+#define OBJECTARENA_CHUNKSIZE       (64*1024)   ///< the arena allocates memory in chunks of this size
+
+/**
+    Provides the memory for the units and structures of one game (see GameContext). The blocks are carved out of large chunks
+    and sorted into size classes, so objects of the same type end up next to each other and freeing an object only puts its
+    block on the free list of its size class. The chunks are kept when a game ends and reused by the next game of the same
+    context; they are all released at once when the arena is destroyed. Requests bigger than the largest size class are passed
+    on to the heap.
+
+    An arena must only be used by the thread running its game.
+*/
+class ObjectArena final {
+public:
+    ObjectArena() = default;
+    ObjectArena(const ObjectArena &) = delete;
+    ObjectArena(ObjectArena &&) = delete;
+    ObjectArena& operator=(const ObjectArena &) = delete;
+    ObjectArena& operator=(ObjectArena &&) = delete;
+    ~ObjectArena();
+
+    /**
+        Allocates a block for an object of size bytes.
+        \param  size    the size of the object
+        \return the memory for the object (aligned like memory returned by operator new)
+    */
+    void* allocate(size_t size);
+
+    /**
+        Frees a block allocated by allocate() of any arena. The block is returned to the arena it came from.
+        \param  p   the block to free (may be nullptr)
+    */
+    static void deallocate(void* p);
+
+    /**
+        Returns the number of blocks currently allocated from this arena.
+    */
+    size_t getNumAllocated() const noexcept { return numAllocated; }
+
+private:
+    /// Stored in front of every block to find its arena and size class when it is freed
+    struct alignas(std::max_align_t) Header {
+        ObjectArena*    pArena;     ///< the arena the block belongs to (nullptr = allocated from the heap)
+        size_t          sizeClass;  ///< the size class of the block
+    };
+
+    /// A free block is linked into the free list of its size class
+    struct FreeBlock {
+        FreeBlock*  pNext;
+    };
+
+    std::array<FreeBlock*, OBJECTARENA_NUM_SIZECLASSES> freeLists{};    ///< the free blocks per size class
+    std::vector<std::unique_ptr<char[]>> chunks;                        ///< all chunks of this arena
+    char*   pChunkPos = nullptr;                                        ///< the start of the not yet used part of the last chunk
+    size_t  chunkSpaceLeft = 0;                                         ///< the size of the not yet used part of the last chunk
+    size_t  numAllocated = 0;                                           ///< the number of blocks currently handed out
+};
+
+#endif // OBJECTARENA_H
@@ -0,0 +1,101 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OBJECTIDSET_H
+#define OBJECTIDSET_H
+
+#include <DataTypes.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/**
+    A set of object IDs stored as a sorted vector. It is used for the selection and the group lists which are
+    iterated and sent over the network far more often than they are changed. Iteration is in ascending ID order,
+    the same as with std::set<Uint32>.
+*/
+class ObjectIDSet {
+public:
+    typedef Uint32 value_type;
+    typedef std::vector<Uint32>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+
+    ObjectIDSet() = default;
+
+    /**
+        Creates a set from a list of IDs in any order, duplicates are removed.
+        \param  objectIDs   the IDs
+    */
+    explicit ObjectIDSet(std::vector<Uint32> objectIDs) : ids(std::move(objectIDs)) {
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    }
+
+    /**
+        Inserts objectID if it is not already in this set.
+        \param  objectID    the ID to insert
+        \return an iterator to objectID and true if it was inserted, false if it already was in this set
+    */
+    std::pair<const_iterator, bool> insert(Uint32 objectID) {
+        auto iter = std::lower_bound(ids.begin(), ids.end(), objectID);
+        if((iter != ids.end()) && (*iter == objectID)) {
+            return std::make_pair(const_iterator(iter), false);
+        }
+        return std::make_pair(const_iterator(ids.insert(iter, objectID)), true);
+    }
+
+    /**
+        Removes objectID from this set.
+        \param  objectID    the ID to remove
+        \return the number of removed IDs (0 or 1)
+    */
+    size_t erase(Uint32 objectID) {
+        auto iter = std::lower_bound(ids.begin(), ids.end(), objectID);
+        if((iter == ids.end()) || (*iter != objectID)) {
+            return 0;
+        }
+        ids.erase(iter);
+        return 1;
+    }
+
+    const_iterator find(Uint32 objectID) const {
+        auto iter = std::lower_bound(ids.begin(), ids.end(), objectID);
+        return ((iter != ids.end()) && (*iter == objectID)) ? iter : ids.end();
+    }
+
+    size_t count(Uint32 objectID) const { return (find(objectID) != ids.end()) ? 1 : 0; }
+
+    const_iterator begin() const noexcept { return ids.begin(); }
+    const_iterator end() const noexcept { return ids.end(); }
+    size_t size() const noexcept { return ids.size(); }
+    bool empty() const noexcept { return ids.empty(); }
+    void clear() noexcept { ids.clear(); }
+
+    /**
+        Returns the IDs in ascending order, e.g. for writing them with OutputStream::writeUint32Vector().
+    */
+    const std::vector<Uint32>& getIDs() const noexcept { return ids; }
+
+    bool operator==(const ObjectIDSet& other) const { return ids == other.ids; }
+    bool operator!=(const ObjectIDSet& other) const { return ids != other.ids; }
+
+private:
+    std::vector<Uint32> ids;    ///< the IDs in ascending order without duplicates
+};
+
+#endif // OBJECTIDSET_H
@@ -0,0 +1,180 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+    Owns all objects of type T that are created with create(). The objects are constructed in place inside chunks of
+    OBJECTPOOL_CHUNKSIZE slots and the slots of destroyed objects are reused, so creating and destroying short living
+    objects (e.g. bullets and explosions) does not allocate memory. The addresses of the objects stay valid until they
+    are destroyed.
+
+    forEach() visits all objects in the order they were created. Objects may be created and destroyed while iterating;
+    destroyed objects are skipped and objects created during the iteration are visited at the end (like RobustList).
+*/
+template<typename T>
+class ObjectPool {
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool(ObjectPool &&) = delete;
+    ObjectPool& operator=(const ObjectPool &) = delete;
+    ObjectPool& operator=(ObjectPool &&) = delete;
+
+    ~ObjectPool() {
+        clear();
+    }
+
+    /**
+        Constructs a new object in a free slot of this pool.
+        \param  args    the arguments passed to the constructor of T
+        \return the new object
+    */
+    template<typename... Args>
+    T* create(Args&&... args) {
+        if(freeSlots.empty()) {
+            chunks.emplace_back(new Slot[OBJECTPOOL_CHUNKSIZE]);
+            Slot* pChunk = chunks.back().get();
+            for(int i = OBJECTPOOL_CHUNKSIZE - 1; i >= 0; i--) {
+                freeSlots.push_back(&pChunk[i]);
+            }
+        }
+
+        Slot* pSlot = freeSlots.back();
+        T* pObject = new (&pSlot->storage) T(std::forward<Args>(args)...);
+        freeSlots.pop_back();
+
+        pSlot->index = objects.size();
+        objects.push_back(pObject);
+        return pObject;
+    }
+
+    /**
+        Destroys an object of this pool and recycles its slot.
+        \param  pObject the object to destroy (must have been created by this pool)
+    */
+    void destroy(T* pObject) {
+        Slot* pSlot = reinterpret_cast<Slot*>(pObject);
+        objects[pSlot->index] = nullptr;
+        numDestroyed++;
+
+        pObject->~T();
+        freeSlots.push_back(pSlot);
+
+        if((numIterating == 0) && (numDestroyed > objects.size()/2)) {
+            compact();
+        }
+    }
+
+    /**
+        Destroys all objects of this pool. The memory is kept for reuse.
+    */
+    void clear() {
+        numIterating++;
+        for(size_t i = 0; i < objects.size(); i++) {
+            if(objects[i] != nullptr) {
+                destroy(objects[i]);
+            }
+        }
+        numIterating--;
+        objects.clear();
+        numDestroyed = 0;
+    }
+
+    /**
+        Calls f for every object in the order the objects were created.
+        \param  f   the function to call with a T* as parameter
+    */
+    template<typename F>
+    void forEach(F f) {
+        numIterating++;
+        // objects might grow while iterating, so do not cache the size
+        for(size_t i = 0; i < objects.size(); i++) {
+            if(objects[i] != nullptr) {
+                f(objects[i]);
+            }
+        }
+        numIterating--;
+
+        if((numIterating == 0) && (numDestroyed > 0)) {
+            compact();
+        }
+    }
+
+    /**
+        Calls f for every object in the order the objects were created.
+        \param  f   the function to call with a const T* as parameter
+    */
+    template<typename F>
+    void forEach(F f) const {
+        for(const T* pObject : objects) {
+            if(pObject != nullptr) {
+                f(pObject);
+            }
+        }
+    }
+
+    /**
+        Returns the number of objects currently alive.
+    */
+    size_t size() const noexcept {
+        return objects.size() - numDestroyed;
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+private:
+    static constexpr int OBJECTPOOL_CHUNKSIZE = 256;    ///< number of slots allocated at once
+
+    struct Slot {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage; ///< the memory of the object (must be the first member)
+        size_t index;                                   ///< the position of the object in objects
+    };
+
+    /**
+        Removes the entries of destroyed objects from objects.
+    */
+    void compact() {
+        size_t numAlive = 0;
+        for(size_t i = 0; i < objects.size(); i++) {
+            if(objects[i] != nullptr) {
+                reinterpret_cast<Slot*>(objects[i])->index = numAlive;
+                objects[numAlive++] = objects[i];
+            }
+        }
+        objects.resize(numAlive);
+        numDestroyed = 0;
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> chunks;    ///< the memory of all slots
+    std::vector<Slot*> freeSlots;                   ///< all slots not used at the moment
+    std::vector<T*> objects;                        ///< all objects in the order of creation (nullptr if destroyed)
+    size_t numDestroyed = 0;                        ///< number of nullptr entries in objects
+    int numIterating = 0;                           ///< number of forEach() calls currently running
+};
+
+#endif // OBJECTPOOL_H
@@ -49,6 +49,19 @@ public:
     virtual void writeBool(bool x) = 0;
     virtual void writeFloat(float x) = 0;
 
+    /**
+        Writes out length raw bytes. The default implementation writes them one by one, streams that are backed by a
+        buffer or a file write them at once.
+        \param  data    the bytes to write
+        \param  length  the number of bytes to write
+    */
+    virtual void writeBytes(const void* data, size_t length) {
+        const Uint8* pData = static_cast<const Uint8*>(data);
+        for(size_t i = 0; i < length; i++) {
+            writeUint8(pData[i]);
+        }
+    }
+
     /**
         Writes out a Sint8 value.
         \param x    the value to write out
@@ -85,6 +98,51 @@ public:
         writeUint64(tmp);
     }
 
+    /**
+        Writes out count Uint32 values at once.
+        \param  data    the values to write out
+        \param  count   the number of values
+    */
+    void writeUint32Array(const Uint32* data, size_t count) {
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+        for(size_t i = 0; i < count; i++) {
+            writeUint32(data[i]);
+        }
+#else
+        writeBytes(data, count * sizeof(Uint32));
+#endif
+    }
+
+    /**
+        Writes out count Sint32 values at once.
+        \param  data    the values to write out
+        \param  count   the number of values
+    */
+    void writeSint32Array(const Sint32* data, size_t count) {
+        writeUint32Array(reinterpret_cast<const Uint32*>(data), count);
+    }
+
+    /**
+        Writes out a Uint32 value as a variable length integer (7 bits per byte, least significant group first).
+        Small values need less than 4 bytes.
+        \param x    the value to write out
+    */
+    void writeVarUint32(Uint32 x) {
+        while(x >= 0x80) {
+            writeUint8(static_cast<Uint8>(x | 0x80));
+            x >>= 7;
+        }
+        writeUint8(static_cast<Uint8>(x));
+    }
+
+    /**
+        Writes out a Sint32 value as a zigzag encoded variable length integer. Values close to zero need less than 4 bytes.
+        \param x    the value to write out
+    */
+    void writeVarSint32(Sint32 x) {
+        writeVarUint32((static_cast<Uint32>(x) << 1) ^ static_cast<Uint32>(x >> 31));
+    }
+
     /**
         Writes out a FixPoint value.
         \param x    the value to write out
@@ -112,9 +170,10 @@ public:
 
     /**
         Writes out a complete list of Uint32
-        \param  dataList    the list to write
+        \param  dataList    the list to write (any container of Uint32 can be used)
     */
-    void writeUint32List(const std::list<Uint32>& dataList) {
+    template<class Container>
+    void writeUint32List(const Container& dataList) {
         writeUint32(static_cast<Uint32>(dataList.size()));
         for(const Uint32 data : dataList) {
             writeUint32(data);
@@ -127,9 +186,7 @@ public:
     */
     void writeUint32Vector(const std::vector<Uint32>& dataVector) {
         writeUint32(static_cast<Uint32>(dataVector.size()));
-        for(const Uint32 data : dataVector) {
-            writeUint32(data);
-        }
+        writeUint32Array(dataVector.data(), dataVector.size());
     }
 
     /**
@@ -0,0 +1,92 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIMITIVEBATCHER_H
+#define PRIMITIVEBATCHER_H
+
+#include <misc/SDL2pp.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+/**
+    Collects the lines and rectangles of one draw layer (e.g. selection boxes and health bars) and renders them
+    together in flush(). Per color only one SDL_SetRenderDrawColor() call is needed and the horizontal and vertical
+    lines and filled rectangles of a color are submitted with a single SDL_RenderFillRects(). The primitives are
+    drawn after everything that was rendered before flush(), so they should not be covered by the layer itself.
+*/
+class PrimitiveBatcher {
+public:
+    PrimitiveBatcher() = default;
+    PrimitiveBatcher(const PrimitiveBatcher &) = delete;
+    PrimitiveBatcher& operator=(const PrimitiveBatcher &) = delete;
+
+    /**
+        Adds a line. Like renderDrawLine() both end points are part of the line.
+    */
+    void addLine(int x1, int y1, int x2, int y2, Uint32 color);
+
+    /**
+        Adds a horizontal line. Like renderDrawHLine() both end points are part of the line.
+    */
+    void addHLine(int x1, int y, int x2, Uint32 color) {
+        addFilledRect(SDL_Rect { std::min(x1, x2), y, std::abs(x2 - x1) + 1, 1 }, color);
+    }
+
+    /**
+        Adds a vertical line. Like renderDrawVLine() both end points are part of the line.
+    */
+    void addVLine(int x, int y1, int y2, Uint32 color) {
+        addFilledRect(SDL_Rect { x, std::min(y1, y2), 1, std::abs(y2 - y1) + 1 }, color);
+    }
+
+    /**
+        Adds the outline of a rectangle.
+    */
+    void addRect(const SDL_Rect& rect, Uint32 color);
+
+    /**
+        Adds a filled rectangle.
+    */
+    void addFilledRect(const SDL_Rect& rect, Uint32 color);
+
+    /**
+        Renders all primitives added since the last flush and removes them from this batcher.
+        \param  renderer    the renderer to draw with
+    */
+    void flush(SDL_Renderer* renderer);
+
+private:
+    /// All primitives of one color
+    struct Batch {
+        explicit Batch(Uint32 color) : color(color) { }
+
+        Uint32                  color;          ///< the color of the primitives
+        std::vector<SDL_Rect>   filledRects;    ///< the filled rectangles (including horizontal and vertical lines)
+        std::vector<SDL_Rect>   rects;          ///< the rectangle outlines
+        std::vector<SDL_Point>  linePoints;     ///< the other lines (two points per line)
+    };
+
+    Batch& getBatch(Uint32 color);
+
+    std::vector<Batch>  batches;        ///< the batches by color (kept between frames to reuse the memory)
+    size_t              numUsedBatches = 0;     ///< number of batches in use since the last flush
+};
+
+#endif // PRIMITIVEBATCHER_H
@@ -40,6 +40,15 @@ public:
         setSeed(seed);
     }
 
+    /**
+        Creates the random number generator for one stream of random numbers, e.g. the one of a single game object.
+        The sequence only depends on baseSeed and streamID and not on how many numbers other streams have drawn.
+        \param  baseSeed    the seed of the game
+        \param  streamID    the id of the stream (e.g. the object id)
+        \return the generator for this stream
+    */
+    static Random forStream(Uint32 baseSeed, Uint32 streamID);
+
     /// Destructor
     ~Random();
 
@@ -136,6 +136,55 @@ namespace sdl2
         surface_try_lock& operator=(surface_try_lock &&) = delete;
     };
 
+    class mutex_lock final
+    {
+        SDL_mutex * const mutex_;
+    public:
+        explicit mutex_lock(SDL_mutex* mutex) : mutex_(mutex)
+        {
+            assert(mutex);
+
+            if (0 == SDL_LockMutex(mutex_))
+                return;
+
+            THROW(std::runtime_error, "Unable to lock SDL mutex!");
+        }
+        ~mutex_lock()
+        {
+            SDL_UnlockMutex(mutex_);
+        }
+
+        mutex_lock(const mutex_lock &) = delete;
+        mutex_lock(mutex_lock &&) = delete;
+        mutex_lock& operator=(const mutex_lock &) = delete;
+        mutex_lock& operator=(mutex_lock &&) = delete;
+    };
+
+    /// temporarily releases a mutex locked by the current thread and locks it again when going out of scope
+    class mutex_unlock final
+    {
+        SDL_mutex * const mutex_;
+    public:
+        explicit mutex_unlock(SDL_mutex* mutex) : mutex_(mutex)
+        {
+            assert(mutex);
+
+            if (0 == SDL_UnlockMutex(mutex_))
+                return;
+
+            THROW(std::runtime_error, "Unable to unlock SDL mutex!");
+        }
+        ~mutex_unlock()
+        {
+            SDL_LockMutex(mutex_);
+        }
+
+        mutex_unlock(const mutex_unlock &) = delete;
+        mutex_unlock(mutex_unlock &&) = delete;
+        mutex_unlock& operator=(const mutex_unlock &) = delete;
+        mutex_unlock& operator=(mutex_unlock &&) = delete;
+    };
+
     namespace implementation
     {
         template<typename T, void(*Delete)(T*)>
@@ -0,0 +1,94 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <misc/SDL2pp.h>
+
+#include <array>
+#include <utility>
+
+/**
+    A bounded lock-free queue for passing items from exactly one producer thread to exactly one consumer thread.
+    The producer only writes tail and the consumer only writes head, SDL_AtomicSet() provides the needed memory barriers.
+    \tparam T           the type of the items
+    \tparam capacity    the size of the ring buffer (one slot always stays empty)
+*/
+template<typename T, int capacity>
+class SPSCQueue final {
+public:
+    SPSCQueue() {
+        SDL_AtomicSet(&head, 0);
+        SDL_AtomicSet(&tail, 0);
+    }
+
+    SPSCQueue(const SPSCQueue &) = delete;
+    SPSCQueue& operator=(const SPSCQueue &) = delete;
+
+    /**
+        Checks if the queue is full. Shall only be called from the producer thread.
+        \return true if the next push() would fail
+    */
+    bool isFull() const {
+        return next(SDL_AtomicGet(&tail)) == SDL_AtomicGet(&head);
+    }
+
+    /**
+        Adds an item to the queue. Shall only be called from the producer thread.
+        \param  item    the item to add
+        \return true on success, false if the queue is full
+    */
+    bool push(T item) {
+        int currentTail = SDL_AtomicGet(&tail);
+        int nextTail = next(currentTail);
+        if(nextTail == SDL_AtomicGet(&head)) {
+            return false;
+        }
+
+        items[currentTail] = std::move(item);
+        SDL_AtomicSet(&tail, nextTail);
+        return true;
+    }
+
+    /**
+        Removes the oldest item from the queue. Shall only be called from the consumer thread.
+        \param  item    the removed item is stored here
+        \return true on success, false if the queue is empty
+    */
+    bool pop(T& item) {
+        int currentHead = SDL_AtomicGet(&head);
+        if(currentHead == SDL_AtomicGet(&tail)) {
+            return false;
+        }
+
+        item = std::move(items[currentHead]);
+        SDL_AtomicSet(&head, next(currentHead));
+        return true;
+    }
+
+private:
+    static int next(int index) {
+        return (index + 1 == capacity) ? 0 : index + 1;
+    }
+
+    std::array<T, capacity> items;      ///< the ring buffer
+    mutable SDL_atomic_t head;          ///< the next item to pop (only written by the consumer)
+    mutable SDL_atomic_t tail;          ///< the next free slot (only written by the producer)
+};
+
+#endif // SPSCQUEUE_H
@@ -0,0 +1,123 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SCREENSHOTWRITER_H
+#define SCREENSHOTWRITER_H
+
+#include <misc/SDL2pp.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+    Encodes and writes screenshots on a background thread. Reading back the renderer has to happen on the thread
+    that renders, but the much slower conversion and PNG/QOI encoding is done by this writer, so taking a screenshot
+    does not freeze the game. Screenshots are written in the order they were queued.
+*/
+class ScreenshotWriter final {
+public:
+    /// The file format screenshots are written in
+    enum class Format {
+        PNG,    ///< PNG with the configured compression level
+        QOI     ///< QOI ("Quite OK Image"), much faster to encode than PNG but larger
+    };
+
+    /**
+        Constructor
+        \param  format              the file format of the screenshots
+        \param  compressionLevel    the PNG compression level (0 = uncompressed to PNG_MAX_COMPRESSION)
+    */
+    ScreenshotWriter(Format format, int compressionLevel);
+
+    ScreenshotWriter(const ScreenshotWriter &) = delete;
+    ScreenshotWriter(ScreenshotWriter &&) = delete;
+    ScreenshotWriter& operator=(const ScreenshotWriter &) = delete;
+    ScreenshotWriter& operator=(ScreenshotWriter &&) = delete;
+
+    /// Destructor. Writes all queued screenshots before returning.
+    ~ScreenshotWriter();
+
+    /**
+        Parses the format name used in the config file.
+        \param  name    "png" or "qoi" (case insensitive)
+        \return the format (Format::PNG for unknown names)
+    */
+    static Format getFormatByName(const std::string& name);
+
+    /**
+        Returns the file name extension (including the dot) of the screenshot format.
+    */
+    const char* getFileExtension() const;
+
+    /**
+        Returns the first filename "<prefix><number><extension>" that neither exists nor is queued for writing.
+        \param  prefix  the start of the filename, e.g. "Screenshot"
+        \return the filename
+    */
+    std::string getNextFilename(const std::string& prefix);
+
+    /**
+        Queues pSurface for being encoded and written to filename.
+        \param  filename    the file to write
+        \param  pSurface    the screenshot, e.g. from renderReadSurface()
+    */
+    void writeScreenshot(const std::string& filename, sdl2::surface_ptr pSurface);
+
+    /**
+        Blocks until all queued screenshots are written.
+    */
+    void waitUntilIdle();
+
+    /**
+        Returns the screenshots that were written since the last call.
+        \return the names of the written files
+    */
+    std::vector<std::string> getWrittenFiles();
+
+    /**
+        Returns the screenshots that could not be written since the last call.
+        \return the names of the files that were not written
+    */
+    std::vector<std::string> getFailedFiles();
+
+private:
+    struct Job {
+        std::string filename;           ///< the file to write
+        sdl2::surface_ptr pSurface;     ///< the screenshot (nullptr tells the thread to exit)
+    };
+
+    static int writerThreadMain(void* data);
+    bool write(const Job& job) const;
+    void finishJob(const std::string& filename, bool bSuccess);
+
+    const Format format;                        ///< the file format
+    const int compressionLevel;                 ///< the PNG compression level
+
+    SDL_Thread* pThread = nullptr;              ///< the writer thread
+    SDL_mutex* mutex = nullptr;                 ///< guards jobs, pendingFiles, writtenFiles and failedFiles
+    SDL_sem* availableJobsSemaphore = nullptr;  ///< posted once per queued job
+    SDL_cond* idleCondition = nullptr;          ///< signaled when pendingFiles gets empty
+
+    std::deque<Job> jobs;                       ///< the queued jobs
+    std::vector<std::string> pendingFiles;      ///< the files that are queued or currently written
+    std::vector<std::string> writtenFiles;      ///< the files that were written
+    std::vector<std::string> failedFiles;       ///< the files that could not be written
+};
+
+#endif // SCREENSHOTWRITER_H
@@ -0,0 +1,157 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+    A vector for trivially copyable types that stores up to N elements inside the object itself
+    and only allocates heap memory if more elements are added. The inline storage and the heap pointer
+    share the same memory so the object is not bigger than needed for the N inline elements.
+*/
+template<typename T, size_t N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector only supports trivially copyable types");
+    static_assert(N > 0, "SmallVector needs an inline capacity of at least one element");
+
+public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    SmallVector() noexcept = default;
+
+    SmallVector(const SmallVector& o) {
+        assign(o.begin(), o.end());
+    }
+
+    SmallVector(SmallVector&& o) noexcept {
+        moveFrom(o);
+    }
+
+    ~SmallVector() {
+        freeHeap();
+    }
+
+    SmallVector& operator=(const SmallVector& o) {
+        if(this != &o) {
+            assign(o.begin(), o.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& o) noexcept {
+        if(this != &o) {
+            freeHeap();
+            moveFrom(o);
+        }
+        return *this;
+    }
+
+    template<typename InputIterator>
+    void assign(InputIterator first, InputIterator last) {
+        clear();
+        for(; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + numElements; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + numElements; }
+
+    T* data() noexcept { return isInline() ? storage.inlineElements : storage.pHeap; }
+    const T* data() const noexcept { return isInline() ? storage.inlineElements : storage.pHeap; }
+
+    size_t size() const noexcept { return numElements; }
+    bool empty() const noexcept { return (numElements == 0); }
+
+    T& operator[](size_t i) noexcept { return data()[i]; }
+    const T& operator[](size_t i) const noexcept { return data()[i]; }
+
+    T& front() noexcept { return data()[0]; }
+    const T& front() const noexcept { return data()[0]; }
+    T& back() noexcept { return data()[numElements - 1]; }
+    const T& back() const noexcept { return data()[numElements - 1]; }
+
+    void push_back(const T& value) {
+        if(numElements == capacity) {
+            grow();
+        }
+        data()[numElements++] = value;
+    }
+
+    void clear() noexcept {
+        numElements = 0;
+    }
+
+    /**
+        Removes all elements equal to value. The order of the remaining elements is preserved (like std::list::remove()).
+        \param  value   the value to remove
+    */
+    void remove(const T& value) noexcept {
+        numElements = std::remove(begin(), end(), value) - begin();
+    }
+
+private:
+    bool isInline() const noexcept { return (capacity == N); }
+
+    void grow() {
+        const uint32_t newCapacity = 2*capacity;
+        T* pNewHeap = new T[newCapacity];
+        std::memcpy(pNewHeap, data(), numElements*sizeof(T));
+        freeHeap();
+        storage.pHeap = pNewHeap;
+        capacity = newCapacity;
+    }
+
+    void freeHeap() noexcept {
+        if(!isInline()) {
+            delete[] storage.pHeap;
+            capacity = N;
+        }
+    }
+
+    void moveFrom(SmallVector& o) noexcept {
+        numElements = o.numElements;
+        if(!o.isInline()) {
+            storage.pHeap = o.storage.pHeap;
+            capacity = o.capacity;
+            o.capacity = N;
+        } else {
+            std::memcpy(storage.inlineElements, o.storage.inlineElements, numElements*sizeof(T));
+        }
+        o.numElements = 0;
+    }
+
+    union Storage {
+        T   inlineElements[N];      ///< storage for the first N elements
+        T*  pHeap;                  ///< heap storage if more than N elements are needed
+    } storage;
+
+    uint32_t numElements = 0;       ///< number of stored elements
+    uint32_t capacity = N;          ///< current capacity (N means the inline storage is used)
+};
+
+#endif // SMALLVECTOR_H
@@ -0,0 +1,67 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <misc/SDL2pp.h>
+
+#include <vector>
+
+/**
+    Packs a number of surfaces into one texture so that drawing all of them does not need any texture switches.
+    The surfaces are placed into shelves sorted by their height.
+*/
+class TextureAtlas {
+public:
+    TextureAtlas() = default;
+
+    TextureAtlas(const TextureAtlas &) = delete;
+    TextureAtlas(TextureAtlas &&) = default;
+    TextureAtlas& operator=(const TextureAtlas &) = delete;
+    TextureAtlas& operator=(TextureAtlas &&) = default;
+
+    /**
+        Packs all surfaces into a new texture. Transparency (color key or alpha) of the surfaces is kept.
+        \param  surfaces    the surfaces to pack; the index in this vector is the index for getRect()
+        \param  maxSize     the maximum width and height of the texture
+        \return true on success, false if the surfaces do not fit or the texture could not be created
+    */
+    bool build(const std::vector<SDL_Surface*>& surfaces, int maxSize);
+
+    /**
+        Returns the packed texture or nullptr if build() was not successful.
+    */
+    SDL_Texture* getTexture() const noexcept {
+        return texture.get();
+    }
+
+    /**
+        Returns the position of the surface index inside the texture.
+        \param  index   the index of the surface passed to build()
+        \return the rectangle covered by this surface
+    */
+    const SDL_Rect& getRect(int index) const {
+        return rects[index];
+    }
+
+private:
+    sdl2::texture_ptr texture;      ///< the packed texture
+    std::vector<SDL_Rect> rects;    ///< the position of each packed surface
+};
+
+#endif // TEXTUREATLAS_H
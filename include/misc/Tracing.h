@@ -0,0 +1,127 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <misc/SDL2pp.h>
+
+#include <string>
+
+#define TRACING_MAX_EVENTS_PER_THREAD   (4*1024*1024)   ///< further events of a thread are dropped to bound the memory of long captures
+
+/**
+    Records a timeline of zones, counters and frame marks of all threads and saves it in the Chrome trace event format
+    (JSON). Such a trace can be opened in chrome://tracing, Perfetto or Tracy (via its import-chrome tool).
+
+    Every thread records into its own buffer, so recording only contends on a lock nobody else holds. Use the TRACE_*
+    macros for instrumenting code: they are only compiled in if TRACING is defined (configure --enable-tracing);
+    otherwise they expand to nothing. All names must be string literals or otherwise outlive the recording.
+*/
+class Tracing {
+public:
+    Tracing() = delete;
+
+    /**
+        Starts a new recording. All events of a previous recording are discarded.
+    */
+    static void start();
+
+    /**
+        Stops the current recording and saves it.
+        \param  filename    the file to save the trace to
+        \return true on success, false on failure
+    */
+    static bool stopAndSave(const std::string& filename);
+
+    /**
+        Is there a recording running?
+        \return true if events are recorded at the moment
+    */
+    static bool isRecording() {
+        return SDL_AtomicGet(&recording) != 0;
+    }
+
+    /**
+        Records a zone of the calling thread.
+        \param  name    the name of the zone
+        \param  start   the value of SDL_GetPerformanceCounter() when the zone was entered
+        \param  end     the value of SDL_GetPerformanceCounter() when the zone was left
+    */
+    static void addZone(const char* name, Uint64 start, Uint64 end);
+
+    /**
+        Records the current value of a counter.
+        \param  name    the name of the counter
+        \param  value   the value
+    */
+    static void addCounter(const char* name, Sint64 value);
+
+    /**
+        Records the end of a frame.
+    */
+    static void addFrameMark();
+
+    /**
+        Names the calling thread in the trace. Can already be called before the recording starts.
+        \param  name    the name of the thread
+    */
+    static void setThreadName(const char* name);
+
+private:
+    static SDL_atomic_t recording;      ///< 1 while a recording runs, 0 otherwise
+};
+
+/**
+    Records a zone from its construction to its destruction.
+*/
+class TraceZone {
+public:
+    explicit TraceZone(const char* name)
+     : name(name), start(Tracing::isRecording() ? SDL_GetPerformanceCounter() : 0) {
+    }
+
+    TraceZone(const TraceZone &) = delete;
+    TraceZone& operator=(const TraceZone &) = delete;
+
+    ~TraceZone() {
+        if((start != 0) && Tracing::isRecording()) {
+            Tracing::addZone(name, start, SDL_GetPerformanceCounter());
+        }
+    }
+
+private:
+    const char* name;   ///< the name of this zone
+    Uint64 start;       ///< the performance counter at construction (0 if not recording)
+};
+
+#ifdef TRACING
+#define TRACING_CONCAT_IMPL(a, b) a##b
+#define TRACING_CONCAT(a, b) TRACING_CONCAT_IMPL(a, b)
+/// Records the rest of the enclosing block as a zone
+#define TRACE_ZONE(name) TraceZone TRACING_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_COUNTER(name, value) do { if(Tracing::isRecording()) { Tracing::addCounter((name), (Sint64) (value)); } } while(0)
+#define TRACE_FRAME_MARK() do { if(Tracing::isRecording()) { Tracing::addFrameMark(); } } while(0)
+#define TRACE_THREAD_NAME(name) Tracing::setThreadName(name)
+#else
+#define TRACE_ZONE(name)
+#define TRACE_COUNTER(name, value)
+#define TRACE_FRAME_MARK()
+#define TRACE_THREAD_NAME(name)
+#endif
+
+#endif // TRACING_H
@@ -0,0 +1,100 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef VIDEOENCODERPIPE_H
+#define VIDEOENCODERPIPE_H
+
+#include <misc/SDL2pp.h>
+
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+#define VIDEOENCODERPIPE_MAX_QUEUED_FRAMES  8       ///< writeFrame() blocks while this many frames wait for the encoder
+
+/**
+    Streams raw video frames to the standard input of an encoder process (e.g. ffmpeg) on a background thread.
+    Every frame is written as width*height pixels in the byte order returned by getRawPixelFormatName() without any
+    padding, so the encoder has to be told the frame size, the pixel format and the frame rate. Reading back the
+    renderer has to happen on the thread that renders, but writing the frames into the pipe (and waiting for the encoder)
+    happens in parallel with simulating and drawing the next frames. At most VIDEOENCODERPIPE_MAX_QUEUED_FRAMES frames are
+    queued, so a slow encoder slows the game down instead of filling the memory.
+*/
+class VideoEncoderPipe final {
+public:
+    /**
+        Constructor. Starts the encoder.
+        \param  command the shell command starting the encoder; it reads the frames from its standard input
+    */
+    explicit VideoEncoderPipe(const std::string& command);
+
+    VideoEncoderPipe(const VideoEncoderPipe &) = delete;
+    VideoEncoderPipe(VideoEncoderPipe &&) = delete;
+    VideoEncoderPipe& operator=(const VideoEncoderPipe &) = delete;
+    VideoEncoderPipe& operator=(VideoEncoderPipe &&) = delete;
+
+    /// Destructor. Calls close() if not done yet.
+    ~VideoEncoderPipe();
+
+    /**
+        Writes all queued frames, closes the pipe and waits for the encoder to exit. No frames may be written afterwards.
+        \return true if all frames were written and the encoder exited successfully, false otherwise
+    */
+    bool close();
+
+    /**
+        Returns the name of the raw pixel format of the frames as used by ffmpeg (e.g. "rgba").
+    */
+    static const char* getRawPixelFormatName();
+
+    /**
+        Queues pFrame for being written to the encoder. All frames must have the same size and be in SCREEN_FORMAT.
+        \param  pFrame  the frame, e.g. from renderReadSurface()
+    */
+    void writeFrame(sdl2::surface_ptr pFrame);
+
+    /**
+        Has writing to the encoder failed, e.g. because the encoder exited?
+        \return true if frames were lost, false otherwise
+    */
+    bool hasFailed();
+
+    /**
+        Returns the number of frames written to the encoder.
+    */
+    Uint32 getNumWrittenFrames();
+
+private:
+    static int writerThreadMain(void* data);
+    bool write(SDL_Surface* pFrame);
+
+    FILE* pPipe = nullptr;                      ///< the standard input of the encoder
+
+    SDL_Thread* pThread = nullptr;              ///< the writer thread
+    SDL_mutex* mutex = nullptr;                 ///< guards frames, numWrittenFrames and bFailed
+    SDL_sem* availableFramesSemaphore = nullptr;    ///< posted once per queued frame
+    SDL_sem* freeSlotsSemaphore = nullptr;      ///< posted once per frame taken from the queue
+
+    std::deque<sdl2::surface_ptr> frames;       ///< the queued frames (nullptr tells the thread to exit)
+    std::vector<Uint8> frameBuffer;             ///< the pixels of one frame without padding (only used by the writer thread)
+    Uint32 numWrittenFrames = 0;                ///< the number of frames written
+    bool bFailed = false;                       ///< was a frame lost?
+};
+
+#endif // VIDEOENCODERPIPE_H
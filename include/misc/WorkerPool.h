@@ -0,0 +1,78 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <misc/SDL2pp.h>
+
+#include <exception>
+#include <functional>
+#include <vector>
+
+/**
+    A fixed set of worker threads for splitting independent work items of one simulation phase across all cores.
+    parallelFor() blocks until every item is processed, the calling thread works on items as well. The order in which
+    the items are processed is unspecified, so each item must only read shared state and write to its own result slot.
+*/
+class WorkerPool final {
+public:
+    /**
+        Creates a pool with the given number of worker threads (in addition to the calling thread).
+        \param  numThreads  the number of worker threads; 0 means all work is done by the calling thread
+    */
+    explicit WorkerPool(int numThreads);
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool(WorkerPool &&) = delete;
+    WorkerPool& operator=(const WorkerPool &) = delete;
+    WorkerPool& operator=(WorkerPool &&) = delete;
+
+    /// Destructor. Waits for all worker threads to exit.
+    ~WorkerPool();
+
+    /**
+        Returns the number of worker threads a pool should have on this machine (one less than the number of cores).
+    */
+    static int getDefaultNumThreads();
+
+    inline int getNumThreads() const { return static_cast<int>(threads.size()); }
+
+    /**
+        Calls job(i) for every i in [0; numItems) and returns when all calls are done. An exception thrown by a job
+        is rethrown in the calling thread.
+        \param  numItems    the number of work items
+        \param  job         the function to call for every item
+    */
+    void parallelFor(int numItems, const std::function<void (int)>& job);
+
+private:
+    static int workerThreadMain(void* data);
+    void processItems();
+
+    std::vector<SDL_Thread*> threads;               ///< the worker threads
+    SDL_sem* startSemaphore = nullptr;              ///< posted once per worker when a new job is available
+    SDL_sem* doneSemaphore = nullptr;               ///< posted by each worker when it finished its part of the job
+    SDL_mutex* exceptionMutex = nullptr;            ///< guards pException
+
+    const std::function<void (int)>* pJob = nullptr;///< the current job (nullptr tells the workers to exit)
+    int numJobItems = 0;                            ///< number of items of the current job
+    SDL_atomic_t nextItem;                          ///< the next item to be processed
+    std::exception_ptr pException;                  ///< the first exception thrown by the current job
+};
+
+#endif // WORKERPOOL_H
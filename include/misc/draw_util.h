@@ -21,6 +21,8 @@
 #include <Colors.h>
 #include <misc/SDL2pp.h>
 
+#include <vector>
+
 /**
     Return the pixel value at (x, y) in surface
     NOTE: The surface must be locked before calling this!
@@ -82,8 +84,53 @@ inline void renderFillRect(SDL_Renderer* renderer, int x1, int y1, int x2, int y
 
 sdl2::surface_ptr renderReadSurface(SDL_Renderer* renderer);
 
+/**
+    Converts the pixels of surface to 8-bit RGBA (the bytes r, g, b, a per pixel, rows without padding),
+    e.g. for image encoders. SCREEN_FORMAT surfaces are copied row by row, 8-bit surfaces are converted through
+    their palette.
+    \param  surface the surface to convert
+    \return the pixels (4*w*h bytes)
+*/
+std::vector<unsigned char> getSurfaceRGBA(SDL_Surface* surface);
+
 void replaceColor(SDL_Surface *surface, Uint32 oldColor, Uint32 newColor);
-void mapColor(SDL_Surface *surface, Uint8 colorMap[256]);
+void mapColor(SDL_Surface *surface, const Uint8 colorMap[256]);
+
+/**
+    Maps a row of 8-bit pixels through a lookup table, i.e. dest[x] = colorMap[src[x]].
+    \param  src         the source pixels (may be the same as dest)
+    \param  dest        the destination pixels
+    \param  width       the number of pixels
+    \param  colorMap    the lookup table
+*/
+void mapRowColors(const Uint8* src, Uint8* dest, int width, const Uint8 colorMap[256]);
+
+/**
+    Converts a row of 8-bit pixels to 32-bit pixels with a lookup table, i.e. dest[x] = colorMap[src[x]].
+    \param  src         the source pixels
+    \param  dest        the destination pixels (must not overlap src)
+    \param  width       the number of pixels
+    \param  colorMap    the lookup table, e.g. the palette converted to the destination format
+*/
+void mapRowColorsTo32(const Uint8* src, Uint32* dest, int width, const Uint32 colorMap[256]);
+
+/**
+    Maps all the colors in a row of 8-bit pixels which are in [srcColor;srcColor+7) to [destColor;destColor+7) like
+    mapSurfaceColorRange(). The loop has no table lookups and no branches, so the compiler can vectorize it.
+    \param  row         the pixels
+    \param  width       the number of pixels
+    \param  srcColor    the first color of the range to change
+    \param  destColor   the first color of the range to change to
+*/
+void mapRowColorRange(Uint8* row, int width, int srcColor, int destColor);
+
+/**
+    Fills a lookup table for mapColor() or mapSurfaceColors() with the mapping of mapSurfaceColorRange().
+    \param  colorMap    the lookup table to fill
+    \param  srcColor    Color range to change = [srcColor;srcColor+7)
+    \param  destColor   Color range to change to = [destColor;destColor+7)
+*/
+void initColorRangeMap(Uint8 colorMap[256], int srcColor, int destColor);
 
 sdl2::surface_ptr   copySurface(SDL_Surface* inSurface);
 
@@ -121,4 +168,22 @@ sdl2::surface_ptr    createShadowSurface(SDL_Surface* source);
 */
 sdl2::surface_ptr    mapSurfaceColorRange(SDL_Surface* source, int srcColor, int destColor);
 
+/**
+    Copies an 8-bit surface and maps all its pixels through a lookup table in the same pass.
+    \param  source      The source image
+    \param  colorMap    The lookup table
+    \return The mapped surface
+*/
+sdl2::surface_ptr    mapSurfaceColors(SDL_Surface* source, const Uint8 colorMap[256]);
+
+/**
+    Does the same as mapSurfaceColorRange() followed by mapColor() with colorMap, but in one pass over the pixels.
+    \param  source      The source image
+    \param  srcColor    Color range to change = [srcColor;srcColor+7)
+    \param  destColor   Color range to change to = [destColor;destColor+7)
+    \param  colorMap    The lookup table applied to the colors after mapping the range
+    \return The mapped surface
+*/
+sdl2::surface_ptr    mapSurfaceColorRange(SDL_Surface* source, int srcColor, int destColor, const Uint8 colorMap[256]);
+
 #endif // DRAW_UTIL_H
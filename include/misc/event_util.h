@@ -0,0 +1,35 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef EVENT_UTIL_H
+#define EVENT_UTIL_H
+
+#include <SDL2/SDL.h>
+
+/**
+    Like SDL_PollEvent() but merges a run of consecutive mouse motion events (with the same buttons held) into one
+    event with the last position and the summed up relative motion. A mouse polled at 1000 Hz otherwise produces
+    dozens of motion events per frame that only the last one matters for. Optionally, also a run of key repeats of
+    the same key is reduced to the last one. Events are never reordered.
+    \param  event               the event is stored here
+    \param  bCoalesceKeyRepeat  merge consecutive key repeats? (not wanted while typing text)
+    \return true if an event was stored in event, false if there was none
+*/
+bool pollCoalescedEvent(SDL_Event& event, bool bCoalesceKeyRepeat = true);
+
+#endif // EVENT_UTIL_H
@@ -20,8 +20,12 @@
 
 #include <misc/SDL2pp.h>
 #include <string>
+#include <vector>
 #include <SDL2/SDL_mixer.h>
 
+#define SOUND_RESAMPLER_TAPS    16  ///< the number of source samples each resampled sample is computed from
+#define SOUND_RESAMPLER_PHASES  256 ///< the number of precomputed filter kernels between two source samples
+
 sdl2::mix_chunk_ptr create_chunk();
 sdl2::mix_chunk_ptr concat2Chunks(Mix_Chunk* sound1, Mix_Chunk* sound2);
 sdl2::mix_chunk_ptr concat3Chunks(Mix_Chunk* sound1, Mix_Chunk* sound2, Mix_Chunk* sound3);
@@ -31,4 +35,36 @@ sdl2::mix_chunk_ptr createSilenceChunk(int length);
 sdl2::mix_chunk_ptr getChunkFromFile(const std::string& filename);
 sdl2::mix_chunk_ptr getChunkFromFile(const std::string& filename, const std::string& alternativeFilename);
 
+/**
+    Resamples mono samples with a windowed sinc filter (SOUND_RESAMPLER_TAPS taps, low-pass filtered when
+    downsampling). The filter kernels for all SOUND_RESAMPLER_PHASES sub-sample positions are computed once per call,
+    so every resampled sample is a fixed length dot product.
+    \param  samples         the samples to resample
+    \param  srcFrequency    the sample rate of samples
+    \param  destFrequency   the sample rate to convert to
+    \return the resampled samples
+*/
+std::vector<float> resampleSamples(const std::vector<float>& samples, int srcFrequency, int destFrequency);
+
+/**
+    Creates a chunk in the sample format and channel count of the opened audio device, so that SDL_mixer can mix it
+    without any conversion.
+    \param  samples     mono samples in [-1;1] at the frequency of the audio device
+    \param  numSamples  the number of samples
+    \return the chunk
+*/
+sdl2::mix_chunk_ptr createChunkFromSamples(const float* samples, size_t numSamples);
+
+/**
+    Converts a chunk to the frequency, sample format and channel count of the opened audio device. If the chunk
+    already matches the device it is returned unchanged. All channels are mixed down before resampling, i.e. this
+    is meant for the mono sources of the game (VOC files and the AdLib emulation).
+    \param  pChunk      the chunk to convert
+    \param  frequency   the sample rate of pChunk
+    \param  format      the sample format of pChunk (AUDIO_U8, AUDIO_S8 or one of the 16-bit formats)
+    \param  channels    the number of interleaved channels in pChunk
+    \return the chunk in the format of the audio device
+*/
+sdl2::mix_chunk_ptr convertChunkToDeviceFormat(sdl2::mix_chunk_ptr pChunk, int frequency, Uint16 format, int channels);
+
 #endif // SOUND_UTIL_H
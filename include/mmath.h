@@ -25,6 +25,7 @@ class Coord;
 #include <fixmath/FixPoint.h>
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 int getRandomInt();
 
@@ -144,6 +145,21 @@ inline FixPoint blockDistance(const Coord& p1, const Coord& p2) {
     }
 }
 
+#define BLOCKDISTANCE_OFFSETS_MAXRANGE  32  ///< the largest range covered by getBlockDistanceOffsets()
+
+struct BlockDistanceOffset {
+    Coord       offset;     ///< the offset to the center tile
+    FixPoint    distance;   ///< the blockDistance() from the center tile
+};
+
+/**
+    Returns the offsets of all tiles up to a blockDistance() of BLOCKDISTANCE_OFFSETS_MAXRANGE around a tile, sorted by
+    distance and for equal distance by y and then x. The tiles up to a smaller range are a prefix of this list.
+    The list is calculated on the first call and may be used from any thread.
+    \return the list of offsets
+*/
+const std::vector<BlockDistanceOffset>& getBlockDistanceOffsets();
+
 /**
     Calculates the block distance the same as the original, that is diffX + diffY/2 for diffX > diffY and diffX/2 + diffY for diffX <= diffY
     \param  p1  first coordinate
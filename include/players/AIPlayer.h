@@ -19,6 +19,7 @@
 #define AIPLAYER_H
 
 #include <players/Player.h>
+#include <players/AIScheduler.h>
 
 #include <DataTypes.h>
 
@@ -46,6 +47,12 @@ public:
     void onDamage(const ObjectBase* pObject, int damage, Uint32 damagerID) override;
 
 private:
+    enum AITask {
+        AITask_CheckAllUnits,
+        AITask_Build,
+        AITask_Attack
+    };
+
     void scrambleUnitsAndDefend(const ObjectBase* pIntruder);
 
     Coord findPlaceLocation(Uint32 itemID);
@@ -64,6 +71,8 @@ private:
     Sint32  attackTimer;    ///< When to attack?
     Sint32  buildTimer;     ///< When to build the next structure/unit
 
+    AIScheduler scheduler;  ///< decides in which game cycle the AITasks run
+
     std::deque<Coord> placeLocations;    ///< Where to place structures
 };
 
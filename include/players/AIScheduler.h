@@ -0,0 +1,113 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AISCHEDULER_H
+#define AISCHEDULER_H
+
+#include <DataTypes.h>
+
+#include <string>
+#include <vector>
+
+#define AISCHEDULER_DEFAULTBUDGET 2000     ///< default wall clock budget of one run of an AI subtask (in microseconds)
+
+/**
+    Decides in which game cycle the subtasks (e.g. build, attack or checking all units) of an AI player run.
+
+    Every subtask runs once per interval but the subtasks of one AI and the AIs of different houses are
+    placed into different game cycles of the interval so that their expensive passes do not pile up on the same
+    game cycle. The phase of a subtask only depends on the house ID, the subtask and the game cycle and thus the
+    schedule is deterministic and the same on all network peers.
+
+    The wall clock time of every run is measured against the budget of the subtask. This is only used for reporting
+    overruns and never influences what is run.
+*/
+class AIScheduler {
+public:
+    AIScheduler() = default;
+
+    /**
+        Adds a new subtask. All subtasks have to be added before the first game cycle.
+        \param  name        the name of the subtask (used for reporting overruns)
+        \param  interval    the number of game cycles between two runs of this subtask
+        \param  budget      the wall clock budget of one run (in microseconds)
+        \return the ID of the new subtask
+    */
+    int addTask(const std::string& name, Uint32 interval, Uint32 budget = AISCHEDULER_DEFAULTBUDGET);
+
+    /**
+        Changes the wall clock budget of a subtask.
+        \param  taskID  the ID of the subtask as returned by addTask()
+        \param  budget  the wall clock budget of one run (in microseconds)
+    */
+    void setBudget(int taskID, Uint32 budget) {
+        tasks[taskID].budget = budget;
+    }
+
+    /**
+        Returns the number of runs of a subtask that exceeded its budget.
+        \param  taskID  the ID of the subtask as returned by addTask()
+        \return the number of overruns
+    */
+    Uint32 getNumOverruns(int taskID) const noexcept {
+        return tasks[taskID].numOverruns;
+    }
+
+    /**
+        Checks if a subtask is due in the specified game cycle.
+        \param  taskID      the ID of the subtask as returned by addTask()
+        \param  houseID     the house the AI player plays
+        \param  gameCycle   the current game cycle
+        \return true if the subtask shall run in this game cycle
+    */
+    bool isDue(int taskID, int houseID, Uint32 gameCycle) const;
+
+    /**
+        Runs function if the subtask is due in the specified game cycle and checks its wall clock time.
+        \param  taskID      the ID of the subtask as returned by addTask()
+        \param  houseID     the house the AI player plays
+        \param  gameCycle   the current game cycle
+        \param  function    the subtask to run
+        \return true if the subtask was run
+    */
+    template<typename Function>
+    bool runIfDue(int taskID, int houseID, Uint32 gameCycle, Function&& function) {
+        if(!isDue(taskID, houseID, gameCycle)) {
+            return false;
+        }
+
+        const auto start = SDL_GetPerformanceCounter();
+        function();
+        reportDuration(taskID, houseID, gameCycle, SDL_GetPerformanceCounter() - start);
+
+        return true;
+    }
+
+private:
+    void reportDuration(int taskID, int houseID, Uint32 gameCycle, Uint64 ticks);
+
+    struct Task {
+        std::string name;           ///< the name of the subtask
+        Uint32 interval;            ///< the number of game cycles between two runs
+        Uint32 budget;              ///< the wall clock budget of one run (in microseconds)
+        Uint32 numOverruns;         ///< the number of runs exceeding the budget
+    };
+
+    std::vector<Task> tasks;        ///< all subtasks of this AI player
+};
+
+#endif // AISCHEDULER_H
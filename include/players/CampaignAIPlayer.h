@@ -19,6 +19,7 @@
 #define CAMPAIGNAIPLAYER_H
 
 #include <players/Player.h>
+#include <players/AIScheduler.h>
 
 #include <vector>
 
@@ -70,12 +71,19 @@ private:
         Coord location;
     };
 
+    enum AITask {
+        AITask_UpdateStructures,
+        AITask_UpdateUnits
+    };
+
     void updateStructures();
     void updateUnits();
 
     int calculateTargetPriority(const UnitBase* pUnit, const ObjectBase* pObject);
 
     std::vector<StructureInfo> structureQueue;    ///< Last destroyed structures and their location
+
+    AIScheduler scheduler;                        ///< decides in which game cycle the AITasks run
 };
 
 #endif //CAMPAIGNAIPLAYER_H
@@ -23,6 +23,7 @@
 #include <Definitions.h>
 
 #include <misc/SDL2pp.h>
+#include <misc/ObjectIDSet.h>
 
 // forward declarations
 class UnitBase;
@@ -101,25 +102,25 @@ public:
         The set of selected units or structures has changed.
         \param  selectedObjectIDs   the new set of selected objects
     */
-    virtual void onSelectionChanged(const std::set<Uint32>& selectedObjectIDs);
+    virtual void onSelectionChanged(const ObjectIDSet& selectedObjectIDs);
 
     /**
         Returns one of the 9 saved units lists
         \param  groupListIndex   which list should be returned
         \return the n-th list.
     */
-    inline std::set<Uint32>& getGroupList(int groupListIndex) { return selectedLists[groupListIndex]; }
+    inline ObjectIDSet& getGroupList(int groupListIndex) { return selectedLists[groupListIndex]; }
 
     /**
         Sets one of the 9 saved units lists
         \param  groupListIndex     which list should be set
         \param  newGroupList        the new list to set
     */
-    void setGroupList(int groupListIndex, const std::set<Uint32>& newGroupList);
+    void setGroupList(int groupListIndex, const ObjectIDSet& newGroupList);
 public:
     Uint32 nextExpectedCommandsCycle;                       ///< The next cycle we expect commands for (using for network games)
 
-    std::set<Uint32> selectedLists[NUMSELECTEDLISTS];       ///< Sets of all the different groups on key 1 to 9
+    ObjectIDSet selectedLists[NUMSELECTEDLISTS];       ///< Sets of all the different groups on key 1 to 9
 
     Uint32 alreadyShownTutorialHints;                       ///< Contains flags for each tutorial hint (see enum TutorialHint)
 
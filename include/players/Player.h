@@ -22,11 +22,16 @@
 #include <DataTypes.h>
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
-#include <misc/RobustList.h>
+#include <misc/EntityList.h>
+#include <misc/Random.h>
 #include <misc/string_util.h>
+#include <misc/SDL2pp.h>
+
+#include <cstdarg>
+#include <functional>
+#include <vector>
 
 class GameInitSettings;
-class Random;
 class Map;
 class House;
 class ObjectBase;
@@ -57,8 +62,23 @@ public:
 
     virtual void save(OutputStream& stream) const;
 
+    /**
+        Lets the player think and give its orders for this game cycle. It is called once per cycle for every player of
+        every house. Usually this happens on the game thread in the order of the house IDs (see House::update()) and the
+        orders given by the do*() methods take effect immediately, so a player sees its own orders and those of the houses
+        updated before it. The update of a player that plans concurrently (see isPlanningConcurrently()) runs earlier.
+    */
     virtual void update() = 0;
 
+    /**
+        Does this player plan concurrently? The update() of such a player runs on a worker thread together with the
+        ones of the other houses (see Game::planPlayers()). It only sees the game as it was at the start of the planning
+        and its orders are queued and executed in house order later (see House::update()). Thus it must only read the
+        game, i.e. not call anything that changes other objects or fills caches except the ones of this player.
+        \return true if this player plans concurrently, false if its update() runs on the game thread
+    */
+    virtual bool isPlanningConcurrently() const { return false; }
+
     /**
         Notifies that a structure or unit was built.
         \param  pObject  the object that was built
@@ -116,7 +136,21 @@ protected:
         */
     void logWarn(PRINTF_FORMAT_STRING const char* fmt, ...) const PRINTF_VARARG_FUNC(2);
 
-    Random& getRandomGen() const;
+    /**
+        Logs a message in the category LOG_CATEGORY_AI prefixed with the name and house of this player
+        \param  priority    the priority of the message
+        \param  fmt         the format string of the message
+        \param  arg         the arguments for fmt
+    */
+    void logMessage(SDL_LogPriority priority, const char* fmt, va_list arg) const;
+
+    /**
+        Returns the random number generator of this player. Every player has its own stream (see Random::forStream())
+        so that the numbers it gets do not depend on the other players.
+        \return the random number generator
+    */
+    Random& getRandomGen() const { return randomGen; }
+
     const GameInitSettings& getGameInitSettings() const;
     Uint32 getGameCycleCount() const;
     int getTechLevel() const;
@@ -124,8 +158,8 @@ protected:
     const Map& getMap() const;
     const ObjectBase* getObject(Uint32 objectID) const;
 
-    const RobustList<const StructureBase*>& getStructureList() const;
-    const RobustList<const UnitBase*>& getUnitList() const;
+    const EntityList<const StructureBase*>& getStructureList() const;
+    const EntityList<const UnitBase*>& getUnitList() const;
 
     const House* getHouse(int houseID) const;
 
@@ -301,10 +335,43 @@ protected:
 private:
     friend class House;
 
+    /**
+        Starts the planning of a player that plans concurrently: freezes the entity lists returned by getStructureList()
+        and getUnitList() and queues all orders until commitOrders(). Must be called on the game thread.
+    */
+    void beginPlanning();
+
+    /**
+        Ends the planning and executes the orders queued since beginPlanning() in the order they were given. An order is
+        dropped if its object was destroyed or is not active anymore, e.g. because an earlier order deployed it.
+    */
+    void commitOrders();
+
+    /**
+        Executes order on pObject or queues it while planning (see beginPlanning()).
+        \param  pObject     the object to give the order to (already checked to be owned by this player and active)
+        \param  order       the order to execute; returns if it succeeded
+        \return the result of order or true if it was queued
+    */
+    bool giveOrder(const ObjectBase* pObject, std::function<bool (ObjectBase*)>&& order) const;
+
     House* pHouse;
     Uint8 playerID;
     std::string playername;
     std::string playerclass;
+
+    mutable Random randomGen;                       ///< the random number stream of this player
+
+    /// An order given while planning
+    struct Order {
+        Uint32 objectID;                            ///< the object to give the order to
+        std::function<bool (ObjectBase*)> order;    ///< executes the order
+    };
+
+    bool bPlanning = false;                         ///< is this player planning (between beginPlanning() and commitOrders())?
+    mutable std::vector<Order> pendingOrders;       ///< the orders given while planning
+    EntityList<const StructureBase*> frozenStructureList;   ///< the structures when the planning started
+    EntityList<const UnitBase*> frozenUnitList;             ///< the units when the planning started
 };
 
 #endif // PLAYER_H
@@ -19,6 +19,7 @@
 #define QuantBot_H
 
 #include <players/Player.h>
+#include <players/AIScheduler.h>
 #include <units/MCV.h>
 
 #include <DataTypes.h>
@@ -47,6 +48,9 @@ public:
 
     void update() override;
 
+    /// The analysis of update() only reads the game and the state of this bot, so it plans concurrently
+    bool isPlanningConcurrently() const override { return true; }
+
     void onObjectWasBuilt(const ObjectBase* pObject) override;
     void onDecrementStructures(int itemID, const Coord& location) override;
     void onDecrementUnits(int itemID) override;
@@ -54,6 +58,11 @@ public:
     void onDamage(const ObjectBase* pObject, int damage, Uint32 damagerID) override;
 
 private:
+    enum AITask {
+        AITask_CheckAllUnits,
+        AITask_Build,
+        AITask_Attack
+    };
 
     Difficulty difficulty;  ///< difficulty level
     GameMode  gameMode;     ///< game mode (custom or campaign)
@@ -69,11 +78,24 @@ private:
     Coord squadRallyLocation = Coord::Invalid();
     Coord squadRetreatLocation = Coord::Invalid();
 
+    AIScheduler scheduler;  ///< decides in which game cycle the AITasks run
+
     void scrambleUnitsAndDefend(const ObjectBase* pIntruder, int numUnits = std::numeric_limits<int>::max());
 
 
     Coord findMcvPlaceLocation(const MCV* pMCV);
     Coord findPlaceLocation(Uint32 itemID);
+
+    /**
+        Scores the tiles around a possible location of a new structure (free sand, own structures, units nearby, map edges).
+        \param itemID          the structure to place
+        \param placeLocationX  the x coordinate of the top left tile of the structure
+        \param placeLocationY  the y coordinate of the top left tile of the structure
+        \param sizeX           the width of the structure
+        \param sizeY           the height of the structure
+        \return the score of the neighbourhood (higher is better)
+    */
+    int scorePlaceLocationNeighbourhood(Uint32 itemID, int placeLocationX, int placeLocationY, int sizeX, int sizeY);
     Coord findSquadCenter(int houseID);
     Coord findBaseCentre(int houseID);
     Coord findSquadRallyLocation();
@@ -83,6 +105,7 @@ private:
 
     void checkAllUnits();
     void retreatAllUnits();
+    int calculateMilitaryValue() const;
     void build(int militaryValue);
     void attack(int militaryValue);
 
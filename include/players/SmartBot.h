@@ -19,6 +19,7 @@
 #define SmartBot_H
 
 #include <players/Player.h>
+#include <players/AIScheduler.h>
 
 #include <DataTypes.h>
 
@@ -44,6 +45,12 @@ public:
     void onDamage(const ObjectBase* pObject, int damage, Uint32 damagerID) override;
 
 private:
+    enum AITask {
+        AITask_CheckAllUnits,
+        AITask_Build,
+        AITask_Attack
+    };
+
     void scrambleUnitsAndDefend(const ObjectBase* pIntruder);
 
     Coord findPlaceLocation(Uint32 itemID);
@@ -63,6 +70,8 @@ private:
     Sint32  buildTimer;     ///< When to build the next structure/unit
     int harvesterLimit = 4; ///< maximum number of harvesters
 
+    AIScheduler scheduler;  ///< decides in which game cycle the AITasks run
+
     std::list<Coord> placeLocations;    ///< Where to place structures
 
     bool focusEconomy();
@@ -72,6 +72,10 @@ inline int missionNumberToLevelNumber(int missionNumber) {
 }
 
 void startReplay(const std::string& filename);
+bool runHeadlessReplay(const std::string& filename, Uint32 maxGameCycle = 0);
+bool renderReplayVideo(const std::string& filename, const std::string& videoFilename, const std::string& encoderCommand, int framesPerSecond, Uint32 maxGameCycle = 0);
+void startSpectator(const std::string& hostname, int port);
+bool runBroadcastRelay(const std::string& hostname, int port, int relayPort);
 void startSinglePlayerGame(const GameInitSettings& init);
 void startMultiPlayerGame(const GameInitSettings& init);
 
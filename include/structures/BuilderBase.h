@@ -247,6 +247,9 @@ protected:
 
     FixPoint buildSpeedLimit;        ///< Limit the build speed to that percentage [0;1]. This may be used by the AI to make it weaker.
 
+    Uint32   buildCostsItemID = ItemID_Invalid; ///< The item buildCostsPerTick was calculated for (not saved)
+    FixPoint buildCostsPerTick = 0;             ///< The money spent per game tick on buildCostsItemID at full build speed (not saved)
+
     std::list<ProductionQueueItem>  currentProductionQueue;     ///< This list is the production queue (It contains the item IDs of the units/structures to produce)
     std::list<BuildItem>            buildList;                  ///< This list contains all the things that can be produced by this builder
 };
@@ -39,6 +39,13 @@ public:
 
     void assignHarvester(Harvester* newHarvester);
     void deployHarvester(Carryall* pCarryall = nullptr);
+
+    /**
+        Called by House::dispatchCarryalls() to answer the request for carrying the harvester back to its field.
+        \param  pCarryall   the carryall that should pick up the harvester or nullptr if the harvester has to drive
+    */
+    void assignCarryall(Carryall* pCarryall);
+
     void startAnimate();
     void stopAnimate();
 
@@ -53,6 +60,15 @@ public:
         }
     }
     inline bool isFree() const { return !extractingSpice; }
+
+    /**
+        Asks if a returning harvester may drive into this refinery now. While the refinery is free only one harvester
+        at a time gets the reservation, so the others do not crowd the entrance (see REFINERY_QUEUEDISTANCE).
+        \param  pHarvester  the returning harvester asking
+        \return true if the harvester holds the reservation, false if it has to wait
+    */
+    bool reserveDock(const Harvester* pHarvester);
+
     inline int getNumBookings() const { return bookings; }  //number of units goings there
     inline const Harvester* getHarvester() const  { return reinterpret_cast<Harvester*>(harvester.getObjPointer()); }
     inline Harvester* getHarvester() { return reinterpret_cast<Harvester*>(harvester.getObjPointer()); }
@@ -69,6 +85,7 @@ private:
     bool            extractingSpice;    ///< Currently extracting spice?
     ObjectPointer   harvester;          ///< The harverster currently in the refinery
     Uint32          bookings;           ///< How many bookings?
+    ObjectPointer   dockReservation;    ///< The returning harvester that may drive in next (see reserveDock())
 
     bool    firstRun;       ///< On first deploy of a harvester we tell it to the user
 };
@@ -37,6 +37,13 @@ public:
 
     void deployRepairUnit(Carryall* pCarryall = nullptr);
 
+    /**
+        Called by House::dispatchCarryalls() to answer the request for carrying the repaired unit back.
+        \param  pCarryall   the carryall that should pick up the unit or nullptr if the unit has to drive
+    */
+    void assignCarryall(Carryall* pCarryall);
+
+
     inline void book() { bookings++; }
     inline void unBook() { bookings--; }
     inline void assignUnit(ObjectPointer newUnit) { repairUnit = newUnit; repairingAUnit = true; }
@@ -142,6 +142,11 @@ protected:
     */
     virtual void updateStructureSpecificStuff() { }
 
+    /**
+        Checks if this structure is inside the visible part of the map. Headless games show nothing.
+        \return true if the structure might be drawn in the current frame
+    */
+    bool isVisibleOnScreen() const;
 
     // constant for all structures of the same type
     Coord   structureSize;      ///< The size of this structure in tile coordinates (e.g. (3,2) for a refinery)
@@ -55,6 +55,10 @@ public:
     void turnRight();
     virtual void attack();
 
+    bool isTargetScanPending() const override;
+
+    void restartTargetScan() override { findTargetTimer = 0; }
+
     inline int getTurretAngle() const { return lround(angle); }
 
 protected:
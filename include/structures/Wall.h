@@ -38,6 +38,32 @@ public:
         Wall_Full           = 12
     } WALLTYPE;
 
+    /**
+        Returns the tile of a wall. A side is connected if there is a wall on the neighbour tile or if the wall there was
+        destroyed. The destroyed walls on connected sides select one of the damaged wall tiles.
+        \param  connections the connected sides (1 = up, 2 = right, 4 = down, 8 = left)
+        \param  destroyed   the connected sides where the wall was destroyed (same bits as connections)
+        \return the wall tile
+    */
+    static int getWallTile(int connections, int destroyed) {
+        // the tiles by the connected sides
+        static const int intactWallTiles[16] = {  Wall_Standalone, Wall_UpDown, Wall_LeftRight, Wall_UpRight,
+                                                  Wall_UpDown, Wall_UpDown, Wall_DownRight, Wall_UpDownRight,
+                                                  Wall_LeftRight, Wall_UpLeft, Wall_LeftRight, Wall_UpLeftRight,
+                                                  Wall_DownLeft, Wall_UpDownLeft, Wall_DownLeftRight, Wall_Full };
+        static const int damagedWallTilesBase[16] = { 12, 16, 13, 19, 17, 16, 22, 31, 14, 28, 13, 52, 25, 45, 38, 59 };
+
+        // one bit per connected side in the order left, down, right, up
+        int destroyedTileIndex = 0;
+        for(int side = 8; side > 0; side >>= 1) {
+            if(connections & side) {
+                destroyedTileIndex = (destroyedTileIndex << 1) | ((destroyed & side) ? 1 : 0);
+            }
+        }
+
+        return (destroyedTileIndex == 0) ? intactWallTiles[connections] : damagedWallTilesBase[connections] + destroyedTileIndex;
+    }
+
     explicit Wall(House* newOwner);
     explicit Wall(InputStream& stream);
     void init();
@@ -61,6 +87,10 @@ private:
         curAnimFrame = firstAnimFrame = lastAnimFrame = newTile;
     }
 
+    static Wall* getWallAt(int x, int y);
+
+    void updateNeighbourWalls(bool bDestroyed);
+
     void fixWall();
 
     bool bWallDestroyedUp;
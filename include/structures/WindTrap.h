@@ -37,7 +37,10 @@ public:
 
     void setHealth(FixPoint newHealth) override;
 
-protected:
+    /**
+        The power this wind trap currently adds to House::getProducedPower(). It scales with the health.
+        \return the produced power
+    */
     int getProducedPower() const;
 
 private:
@@ -48,6 +48,10 @@ public:
 protected:
     virtual FixPoint getDestinationAngle() const;
 
+    /**
+        Air units are not blocked by anything, so they do not follow a path but fly straight to the destination
+        (see turn() and getDestinationAngle()).
+    */
     virtual void navigate() override;
     virtual void move() override;
     virtual void turn() override;
@@ -38,6 +38,8 @@ public:
     */
     bool update() override;
 
+    bool isTargetScanPending() const override { return false; }
+
     void deploy(const Coord& newLocation) override;
 
     void destroy() override;
@@ -20,6 +20,7 @@
 
 #include <units/UnitBase.h>
 
+class Carryall;
 
 class GroundUnit : public UnitBase
 {
@@ -48,6 +49,13 @@ public:
 
     void doRequestCarryallDrop(int x, int y);
     bool requestCarryall();
+
+    /**
+        Called by House::dispatchCarryalls() to answer a request made by requestCarryall().
+        \param  pCarryall   the carryall that should pick up this unit or nullptr if no carryall was idle
+    */
+    void assignCarryall(Carryall* pCarryall);
+
     void setPickedUp(UnitBase* newCarrier) override;
 
     /**
@@ -67,6 +67,14 @@ private:
 
     void setSpeeds() override;
 
+    void navigate() override;
+
+    /**
+        Checks if this harvester is returning to a busy refinery nearby and has to wait until it may drive in.
+        \return true if this harvester should stay where it is
+    */
+    bool isQueuedAtRefinery();
+
     // harvester state
     bool     harvestingMode;         ///< currently harvesting
     bool     returningToRefinery;    ///< currently on the way back to the refinery
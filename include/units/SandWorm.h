@@ -52,6 +52,9 @@ public:
     */
     bool update() override;
 
+    /// sandworms iterate over the unit list to find their prey which is not safe to do from a worker thread
+    bool isTargetScanPending() const override { return false; }
+
     bool canAttack(const ObjectBase* object) const override;
     bool canPass(int xPos, int yPos) const override;
     inline int getSleepTimer() const { return sleepTimer; }
@@ -78,6 +81,12 @@ public:
 
     bool isEating() const { return (drawnFrame != INVALID); }
 
+    /**
+        Is the shimmer of this sandworm drawn? The shimmer is copied from the already drawn screen (see screenTexture).
+        \return true if shimmering
+    */
+    bool isShimmering() const { return (shimmerOffsetIndex >= 0); }
+
 protected:
     const ObjectBase* findTarget() const override;
     void engageTarget() override;
@@ -43,6 +43,8 @@ public:
 
     int getCurrentAttackAngle() const override;
 
+    bool isTargetScanPending() const override;
+
 protected:
     void engageTarget() override;
     void targeting() override;
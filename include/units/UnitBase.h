@@ -168,6 +168,10 @@ public:
     */
     bool isInWeaponRange(const ObjectBase* object) const;
 
+    bool isTargetScanPending() const override;
+
+    void restartTargetScan() override { findTargetTimer = 0; }
+
     void setAngle(int newAngle);
 
     void setTarget(const ObjectBase* newTarget) override;
@@ -180,6 +184,29 @@ public:
 
     void setLocation(int xPos, int yPos) override;
 
+    /**
+        Remembers the current position as the position at the start of the next game cycle. Called by
+        Game::processObjects() before any object is updated.
+    */
+    inline void savePreviousPosition() {
+        previousRealX = realX;
+        previousRealY = realY;
+    }
+
+    /**
+        Returns the x coordinate in world coordinates this unit is drawn at. It is interpolated between the position
+        at the start of the last game cycle and the current position (see Game::getDrawInterpolation()).
+        This is only for drawing and must not be used for anything the game logic depends on.
+        \return the interpolated x coordinate
+    */
+    float getDrawnX() const;
+
+    /**
+        Returns the y coordinate in world coordinates this unit is drawn at (see getDrawnX()).
+        \return the interpolated y coordinate
+    */
+    float getDrawnY() const;
+
     inline void setLocation(const Coord& location) { setLocation(location.x, location.y); }
 
     inline void setDestination(int newX, int newY) override
@@ -200,6 +227,18 @@ public:
     */
     bool update() override;
 
+    /**
+        Returns the game cycle this unit was last updated in by Game::processObjects().
+        \return the game cycle or INVALID_GAMECYCLE if this unit was not updated yet
+    */
+    inline Uint32 getLastUpdateCycle() const { return lastUpdateCycle; }
+
+    /**
+        Marks this unit as updated in the specified game cycle.
+        \param  gameCycle   the current game cycle
+    */
+    inline void setLastUpdateCycle(Uint32 gameCycle) { lastUpdateCycle = gameCycle; }
+
     virtual bool canPass(int xPos, int yPos) const;
 
     virtual bool hasBumpyMovementOnRock() const { return false; }
@@ -217,12 +256,34 @@ public:
 
     inline void clearPath() {
         pathList.clear();
+        bPathRequested = false;
         nextSpotFound = false;
         recalculatePathTimer = 0;
         nextSpotAngle = INVALID;
         noCloserPointCount = 0;
+        blockedCount = 0;
     }
 
+    /**
+        Is a path request of this unit waiting in the PathRequestQueue?
+    */
+    inline bool isPathRequested() const { return bPathRequested; }
+
+    /**
+        Called by the PathRequestQueue before the path search for this unit is started. Determines the tile to search
+        a path to. If no search is necessary because the path can be taken from a flow field it is returned in path.
+        \param  searchDestination   the tile to search a path to is returned here
+        \param  path                the path is returned here if no search is necessary
+        \return true if path already contains the result, false if a search to searchDestination is needed
+    */
+    bool preparePathSearch(Coord& searchDestination, std::list<Coord>& path);
+
+    /**
+        Called by the PathRequestQueue when the requested path search has finished.
+        \param  path    the found path (empty if no path was found)
+    */
+    void onPathSearchFinished(std::list<Coord>&& path);
+
     inline bool isTracked() const { return tracked; }
 
     inline bool isTurreted() const { return turreted; }
@@ -253,6 +314,21 @@ protected:
 
     virtual void navigate();
 
+    /**
+        Checks if the next spot is only blocked by a friendly ground unit that is about to move on, so that waiting
+        for it is better than searching a new path. Every unit only waits for UNIT_MAXBLOCKEDWAIT navigation steps.
+        \return true if this unit should wait, false if it should search a new path
+    */
+    bool shouldWaitForBlockingUnit() const;
+
+    /**
+        Replaces the blocked next spot by a short detour that rejoins the current path a few spots later (see
+        PATHREPAIR_RADIUS and PATHREPAIR_LOOKAHEAD). This is a breadth first search over at most
+        (2*PATHREPAIR_RADIUS+1)^2 tiles instead of a full path search.
+        \return true if a detour was found and is the new path, false if a new path has to be searched
+    */
+    bool repairPath();
+
     /**
         When the unit is currently idling this method is called about every 5 seconds.
     */
@@ -268,7 +344,9 @@ protected:
 
     void quitDeviation();
 
-    bool SearchPathWithAStar();
+    void requestPath();
+
+    void takeNextSpotFromPath();
 
     void drawSmoke(int x, int y) const;
 
@@ -293,6 +371,8 @@ protected:
     FixPoint ySpeed;                 ///< Speed in y direction
     FixPoint bumpyOffsetX;           ///< The bumpy offset in x direction which is already included in realX
     FixPoint bumpyOffsetY;           ///< The bumpy offset in y direction which is already included in realY
+    FixPoint previousRealX;          ///< realX at the start of the last game cycle (only for drawing, not saved)
+    FixPoint previousRealY;          ///< realY at the start of the last game cycle (only for drawing, not saved)
 
     FixPoint targetDistance;         ///< Distance to the destination
     Sint8    targetAngle;            ///< Angle to the destination
@@ -302,6 +382,9 @@ protected:
     bool     nextSpotFound;          ///< Is the next spot to move to already found?
     Sint8    nextSpotAngle;          ///< The angle to get to the next spot
     Sint32   recalculatePathTimer;   ///< This timer is for recalculating the best path after x ticks
+    Uint8    blockedCount;           ///< For how many navigation steps has nextSpot been blocked by a friendly unit?
+    bool     bPathRequested = false; ///< Is a path request waiting in the PathRequestQueue?
+    Uint32   lastUpdateCycle = INVALID_GAMECYCLE; ///< The game cycle of the last update by Game::processObjects() (not saved)
     Coord    nextSpot;               ///< The next spot to move to
     std::list<Coord> pathList;       ///< The path to the destination found so far
 
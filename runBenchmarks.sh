@@ -0,0 +1,23 @@
+#!/bin/bash
+#
+# Builds an optimized dunelegacy, runs the fixmath micro-benchmark and simulates every benchmark
+# scenario in tests/Benchmarks headless in its own process (so that the peak memory is measured per scenario).
+# The original Dune II pak files have to be available as for playing the game.
+# All arguments are passed on to dunelegacy, e.g. --MaxGameCycles=1000 for a quick run.
+
+PREFIX="$(pwd)/build-benchmark/install"
+
+mkdir -p build-benchmark
+cd build-benchmark
+../configure --prefix="$PREFIX" || exit 1
+make install || exit 1
+make -C tests fixpointbenchmark || exit 1
+cd ..
+
+build-benchmark/tests/fixpointbenchmark || exit 1
+echo
+
+echo "scenario,gamecycles,randomseed,checksum,ms,cyclespersecond,peakmemorykib"
+for scenario in tests/Benchmarks/*.ini; do
+    "$PREFIX/bin/dunelegacy" --showlog --Benchmark="$scenario" "$@" 2>/dev/null | tail -n 1
+done
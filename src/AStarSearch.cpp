@@ -21,21 +21,106 @@
 
 #include <Map.h>
 #include <Game.h>
+#include <House.h>
 #include <units/UnitBase.h>
 
+#include <misc/exceptions.h>
+
+#include <algorithm>
+#include <iterator>
 #include <stdlib.h>
 
 #define MAX_NODES_CHECKED   (128*128)
 
-AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destination) {
-    FixPoint rotationSpeed = 1.0_fix/(currentGame->objectData.data[pUnit->getItemID()][pUnit->getOriginalHouseID()].turnspeed * TILESIZE);
+void AStarWorkspace::beginSearch(int sizeX, int sizeY) {
+    if((this->sizeX != sizeX) || (this->sizeY != sizeY)) {
+        this->sizeX = sizeX;
+        this->sizeY = sizeY;
+        numBlocksX = (sizeX + ASTAR_BLOCKSIZE - 1) >> ASTAR_BLOCKSHIFT;
+        const int numBlocksY = (sizeY + ASTAR_BLOCKSIZE - 1) >> ASTAR_BLOCKSHIFT;
+
+        blocks.clear();
+        blocks.resize(numBlocksX * numBlocksY);
+        currentGeneration = 0;
+    }
+
+    currentGeneration++;
+    if(currentGeneration == 0) {
+        // generation counter wrapped around => all stamps have to be reset once
+        for(std::unique_ptr<TileData[]>& pBlock : blocks) {
+            if(pBlock) {
+                for(int i = 0; i < ASTAR_BLOCKSIZE*ASTAR_BLOCKSIZE; i++) {
+                    pBlock[i].generation = 0;
+                }
+            }
+        }
+        currentGeneration = 1;
+    }
+
+    openList.clear();
+}
 
-    sizeX = pMap->getSizeX();
-    sizeY = pMap->getSizeY();
+AStarWorkspacePool::AStarWorkspacePool() {
+    mutex = SDL_CreateMutex();
+    if(mutex == nullptr) {
+        THROW(std::runtime_error, "AStarWorkspacePool::AStarWorkspacePool(): Unable to create mutex");
+    }
+}
+
+AStarWorkspacePool::~AStarWorkspacePool() {
+    SDL_DestroyMutex(mutex);
+}
 
-    mapData = static_cast<TileData*>(calloc(sizeX*sizeY, sizeof(TileData)));
-    if(mapData == nullptr) {
-        throw std::bad_alloc();
+AStarWorkspace& AStarWorkspacePool::acquire(int sizeX, int sizeY) {
+    SDL_LockMutex(mutex);
+
+    auto iter = std::find_if(workspaces.begin(), workspaces.end(), [](const std::unique_ptr<AStarWorkspace>& pWorkspace) { return !pWorkspace->bInUse; });
+
+    if(iter == workspaces.end()) {
+        workspaces.push_back(std::make_unique<AStarWorkspace>());
+        iter = std::prev(workspaces.end());
+    }
+
+    AStarWorkspace& workspace = **iter;
+    workspace.bInUse = true;
+
+    SDL_UnlockMutex(mutex);
+
+    workspace.beginSearch(sizeX, sizeY);
+    return workspace;
+}
+
+AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destination)
+ : workspacePool(pMap->getPathWorkspacePool()), workspace(workspacePool.acquire(pMap->getSizeX(), pMap->getSizeY())),
+   sizeX(pMap->getSizeX()), sizeY(pMap->getSizeY()), openList(workspace.openList) {
+
+    search(pMap, pUnit, start, destination);
+
+    COUNT_SIMULATION_EVENT(SimulationCounter_PathNodesExpanded, numNodesChecked, pUnit->getOwner()->getHouseID());
+    if(numNodesChecked >= MAX_NODES_CHECKED) {
+        COUNT_SIMULATION_EVENT(SimulationCounter_PathSearchesAborted, 1, pUnit->getOwner()->getHouseID());
+    }
+}
+
+void AStarSearch::search(Map* pMap, UnitBase* pUnit, Coord start, Coord destination) {
+    FixPoint rotationSpeed = 1.0_fix/(pUnit->getObjectData().turnspeed * TILESIZE);
+
+    // everything that only depends on the unit and the direction is calculated once per search
+    Coord neighbourOffsets[NUM_ANGLES];
+    for(int angle = 0; angle < NUM_ANGLES; angle++) {
+        neighbourOffsets[angle] = Map::getMapPos(angle, Coord(0, 0));
+    }
+
+    FixPoint straightCosts[Terrain_SpecialBloom + 1];
+    FixPoint diagonalCosts[Terrain_SpecialBloom + 1];
+    for(int terrainType = 0; terrainType <= Terrain_SpecialBloom; terrainType++) {
+        straightCosts[terrainType] = pUnit->getTerrainDifficulty((TERRAINTYPE) terrainType);
+        diagonalCosts[terrainType] = FixPt_SQRT2*pUnit->getTerrainDifficulty((TERRAINTYPE) terrainType);
+    }
+
+    FixPoint turnCosts[NUM_ANGLES/2 + 1];
+    for(int diff = 0; diff <= NUM_ANGLES/2; diff++) {
+        turnCosts[diff] = diff * rotationSpeed;
     }
 
     FixPoint heuristic = blockDistance(start, destination);
@@ -49,7 +134,6 @@ AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destinat
 
         std::vector<short> depthCheckCount(std::min(sizeX, sizeY));
 
-        int numNodesChecked = 0;
         while(openList.empty() == false) {
             Coord currentCoord = extractMin();
 
@@ -66,24 +150,28 @@ AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destinat
             }
 
             if (numNodesChecked < MAX_NODES_CHECKED) {
+                const TileData& currentData = getMapData(currentCoord);
+                const FixPoint currentG = currentData.g;
+                const bool bTurning = currentData.parentCoord.isValid();
+                const int posAngle = bTurning ? Map::getPosAngle(currentData.parentCoord, currentCoord) : 0;
+
                 //push a node for each direction we could go
                 for (int angle=0; angle<=7; angle++) {
-                    Coord nextCoord = pMap->getMapPos(angle, currentCoord);
+                    Coord nextCoord = currentCoord + neighbourOffsets[angle];
                     if(pUnit->canPass(nextCoord.x, nextCoord.y)) {
-                        Tile& nextTile = *(pMap->getTile(nextCoord));
-                        FixPoint g = getMapData(currentCoord).g;
+                        FixPoint g = currentG;
 
+                        const int terrainType = pMap->getTile(nextCoord)->getType();
                         if((nextCoord.x != currentCoord.x) && (nextCoord.y != currentCoord.y)) {
                             //add diagonal movement cost
-                            g += FixPt_SQRT2*(pUnit->isAFlyingUnit() ? 1.0_fix : pUnit->getTerrainDifficulty((TERRAINTYPE) nextTile.getType()));
+                            g += diagonalCosts[terrainType];
                         } else {
-                            g += (pUnit->isAFlyingUnit() ? 1.0_fix : pUnit->getTerrainDifficulty((TERRAINTYPE) nextTile.getType()));
+                            g += straightCosts[terrainType];
                         }
 
-                        if(getMapData(currentCoord).parentCoord.isValid())  {
+                        if(bTurning)  {
                             //add cost of turning time
-                            int posAngle = currentGameMap->getPosAngle(getMapData(currentCoord).parentCoord, currentCoord);
-                            g += angleDiff(angle,posAngle) * rotationSpeed;
+                            g += turnCosts[angleDiff(angle,posAngle)];
                         }
 
                         FixPoint h = blockDistance(nextCoord, destination);
@@ -151,11 +239,9 @@ AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destinat
         }
 
     }
-
-
 }
 
 AStarSearch::~AStarSearch() {
-    free(mapData);
+    workspacePool.release(workspace);
 }
 
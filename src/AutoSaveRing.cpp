@@ -0,0 +1,125 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <AutoSaveRing.h>
+
+#include <SnapshotDelta.h>
+
+#include <misc/BackgroundFileWriter.h>
+#include <misc/ICompressedStream.h>
+#include <misc/IMemoryStream.h>
+#include <misc/OMemoryStream.h>
+#include <misc/FileSystem.h>
+#include <misc/exceptions.h>
+#include <misc/format.h>
+
+#include <algorithm>
+#include <cstdio>
+
+AutoSaveRing::AutoSaveRing(const std::string& directory, int numSlots)
+ : directory(directory), numSlots(std::max(1, numSlots)) {
+}
+
+void AutoSaveRing::add(std::unique_ptr<OMemoryStream> pSnapshot, BackgroundFileWriter& writer) {
+    // the game goes on while the delta is created on the writer thread, so it gets its own immutable copy
+    auto pSnapshotData = std::make_shared<const std::string>(pSnapshot->getData(), pSnapshot->getDataLength());
+
+    if(currentBase < 0) {
+        // the autosaves of a previous game refer to bases that are overwritten now
+        for(int slot = 0; slot < numSlots; slot++) {
+            std::remove(getSlotFilename(slot).c_str());
+        }
+        for(int base = 0; base < AUTOSAVE_NUM_BASES; base++) {
+            std::remove(getBaseFilename(base).c_str());
+        }
+    }
+
+    if((currentBase < 0) || (numRestorePointsOnBase >= numSlots)) {
+        // all restore points in the ring refer to the other base
+        currentBase = (currentBase + 1) % AUTOSAVE_NUM_BASES;
+        numRestorePointsOnBase = 0;
+        pBaseSnapshot = pSnapshotData;
+        writer.writeFile(getBaseFilename(currentBase), std::move(pSnapshot));
+    }
+
+    writer.writeFile(getSlotFilename(nextSlot), [pBase = pBaseSnapshot, pSnapshotData, baseName = getBasename(getBaseFilename(currentBase))]() {
+        auto pStream = std::make_unique<OMemoryStream>();
+        pStream->open();
+        pStream->writeUint32(AUTOSAVE_DELTA_MAGIC);
+        pStream->writeString(baseName);
+        pStream->writeString(SnapshotDelta::create(*pBase, *pSnapshotData));
+        return pStream;
+    });
+
+    numRestorePointsOnBase++;
+    nextSlot = (nextSlot + 1) % numSlots;
+}
+
+std::unique_ptr<InputStream> AutoSaveRing::openSaveGame(const std::string& filename) {
+    std::unique_ptr<InputStream> pStream = ICompressedStream::openFile(filename);
+    if(pStream == nullptr) {
+        return nullptr;
+    }
+
+    bool bDelta = false;
+    try {
+        bDelta = (pStream->readUint32() == AUTOSAVE_DELTA_MAGIC);
+    } catch (InputStream::exception&) {
+        // too short for an autosave delta
+    }
+
+    if(bDelta) {
+        return std::make_unique<IMemoryStream>(readSaveGame(filename));
+    }
+
+    // read it again from the beginning
+    return ICompressedStream::openFile(filename);
+}
+
+std::string AutoSaveRing::readSaveGame(const std::string& filename) {
+    std::string data = ICompressedStream::decompress(readCompleteFile(filename));
+
+    IMemoryStream stream(data.data(), data.size());
+    try {
+        if(stream.readUint32() != AUTOSAVE_DELTA_MAGIC) {
+            return data;
+        }
+    } catch (InputStream::exception&) {
+        return data;
+    }
+
+    try {
+        const std::string baseFilename = getDirname(filename) + "/" + stream.readString();
+        const std::string delta = stream.readString();
+
+        const std::string base = ICompressedStream::decompress(readCompleteFile(baseFilename));
+        if(base.empty()) {
+            THROW(std::runtime_error, "Cannot open '%s'!", baseFilename);
+        }
+
+        return SnapshotDelta::apply(base, delta);
+    } catch (std::exception& e) {
+        THROW(std::runtime_error, "This autosave cannot be restored because its base was removed or overwritten (%s)", e.what());
+    }
+}
+
+std::string AutoSaveRing::getSlotFilename(int slot) const {
+    return directory + fmt::sprintf("autosave%d.dls", slot + 1);
+}
+
+std::string AutoSaveRing::getBaseFilename(int base) const {
+    return directory + fmt::sprintf("autosave_base%d.dlb", base + 1);
+}
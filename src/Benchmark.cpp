@@ -0,0 +1,159 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Benchmark.h>
+
+#include <globals.h>
+
+#include <Game.h>
+#include <GameInitSettings.h>
+#include <ReplayVerifier.h>
+#include <Definitions.h>
+#include <sand.h>
+
+#include <FileClasses/INIFile.h>
+
+#include <misc/FileSystem.h>
+#include <misc/string_util.h>
+#include <misc/exceptions.h>
+#include <misc/format.h>
+
+#include <algorithm>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+Uint32 BenchmarkResult::getCyclesPerSecond() const {
+    return (Uint32) ((Uint64) gameCycles * 1000 / std::max(elapsedTime, (Uint32) 1));
+}
+
+std::string BenchmarkResult::toCSV() const {
+    return fmt::sprintf("%s,%u,0x%08X,%s,%u,%u,%u",
+                        scenario, gameCycles, randomSeed, checksum, elapsedTime, getCyclesPerSecond(), peakMemory);
+}
+
+const char* BenchmarkResult::getCSVHeader() {
+    return "scenario,gamecycles,randomseed,checksum,ms,cyclespersecond,peakmemorykib";
+}
+
+namespace {
+
+/// Sets up the houses and players of a benchmark scenario. The first house is additionally controlled by an idle human player, as the game needs a local player.
+void addBenchmarkHouses(GameInitSettings& gameInitSettings, const INIFile& inifile, const std::string& filename) {
+    int team = 1;
+    for(const INIFile::Key& key : inifile.getSection("BENCHMARK")) {
+        const HOUSETYPE houseID = getHouseByName(key.getKeyName());
+        if(houseID == HOUSE_INVALID) {
+            continue;
+        }
+
+        GameInitSettings::HouseInfo houseInfo(houseID, team);
+
+        if(team == 1) {
+            houseInfo.addPlayerInfo(GameInitSettings::PlayerInfo("Benchmark", HUMANPLAYERCLASS));
+        }
+
+        int playerNumber = 1;
+        for(const std::string& playerClass : splitStringToStringVector(key.getStringValue(), ",")) {
+            houseInfo.addPlayerInfo(GameInitSettings::PlayerInfo(getHouseNameByNumber(houseID) + std::to_string(playerNumber++), playerClass));
+        }
+
+        gameInitSettings.addHouseInfo(houseInfo);
+        team++;
+    }
+
+    if(gameInitSettings.getHouseInfoList().empty()) {
+        THROW(std::runtime_error, "Benchmark scenario '%s' has no houses in section [BENCHMARK]!", filename);
+    }
+}
+
+}
+
+BenchmarkResult runBenchmark(const std::string& filename, Uint32 maxGameCycle) {
+    if(!existsFile(filename)) {
+        THROW(std::runtime_error, "Cannot open benchmark scenario '%s'!", filename);
+    }
+
+    const INIFile inifile(filename);
+    if(!inifile.hasSection("BENCHMARK")) {
+        THROW(std::runtime_error, "'%s' is no benchmark scenario as it has no section [BENCHMARK]!", filename);
+    }
+
+    BenchmarkResult benchmarkResult;
+    benchmarkResult.scenario = inifile.getStringValue("BENCHMARK", "Name", getBasename(filename, true));
+
+    if(maxGameCycle == 0) {
+        maxGameCycle = inifile.getIntValue("BENCHMARK", "GameCycles", 0);
+    }
+    if(maxGameCycle == 0) {
+        THROW(std::runtime_error, "Benchmark scenario '%s' does not specify the number of game cycles to simulate!", filename);
+    }
+
+    // default game options and a fixed seed make every run simulate the same game
+    GameInitSettings gameInitSettings(getBasename(filename, true), readCompleteFile(filename), true, SettingsClass::GameOptionsClass());
+    gameInitSettings.setRandomSeed(inifile.getIntValue("BENCHMARK", "Seed", 1));
+    addBenchmarkHouses(gameInitSettings, inifile, filename);
+
+    try {
+        currentGame = new Game();
+        currentGame->initGame(gameInitSettings);
+        currentGame->setHeadless(maxGameCycle);
+
+        const Uint32 startTime = SDL_GetTicks();
+        currentGame->runMainLoop();
+        benchmarkResult.elapsedTime = SDL_GetTicks() - startTime;
+
+        benchmarkResult.gameCycles = currentGame->getGameCycleCount();
+        benchmarkResult.randomSeed = currentGame->randomGen.getSeed();
+        benchmarkResult.checksum = getGameStateChecksum(currentGame);
+        benchmarkResult.peakMemory = getPeakMemoryUsage();
+    } catch(...) {
+        delete currentGame;
+        currentGame = nullptr;
+        throw;
+    }
+
+    delete currentGame;
+    currentGame = nullptr;
+
+    return benchmarkResult;
+}
+
+Uint32 getPeakMemoryUsage() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS memoryCounters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters)) == 0) {
+        return 0;
+    }
+    return (Uint32) (memoryCounters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    // macOS reports bytes instead of KiB
+    return (Uint32) (usage.ru_maxrss / 1024);
+#else
+    return (Uint32) usage.ru_maxrss;
+#endif
+#endif
+}
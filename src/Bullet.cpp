@@ -69,8 +69,10 @@ Bullet::Bullet(Uint32 shooterID, Coord* newRealLocation, Coord* newRealDestinati
         FixPoint distance = distanceFrom(*newRealLocation, *newRealDestination);
 
 
-        FixPoint randAngle = 2 * FixPt_PI * currentGame->randomGen.randFixPoint();
-        int radius = currentGame->randomGen.rand(0,lround(TILESIZE/2 + (distance/TILESIZE)));
+        // the scattering is drawn from the stream of the shooter which fires this bullet during its update
+        Random& randomGen = currentGame->getObjectManager().getObject(shooterID)->getRandomGen();
+        FixPoint randAngle = 2 * FixPt_PI * randomGen.randFixPoint();
+        int radius = randomGen.rand(0,lround(TILESIZE/2 + (distance/TILESIZE)));
 
         destination.x += lround(FixPoint::cos(randAngle) * radius);
         destination.y -= lround(FixPoint::sin(randAngle) * radius);
@@ -90,6 +92,8 @@ Bullet::Bullet(Uint32 shooterID, Coord* newRealLocation, Coord* newRealDestinati
 
     xSpeed = speed * FixPoint::cos(angleRad);
     ySpeed = speed * -FixPoint::sin(angleRad);
+
+    drawBucket = currentGameMap->getBulletDrawBuckets().add(this, location);
 }
 
 Bullet::Bullet(InputStream& stream)
@@ -126,6 +130,8 @@ Bullet::Bullet(InputStream& stream)
     Bullet::init();
 
     detonationTimer = stream.readSint8();
+
+    drawBucket = currentGameMap->getBulletDrawBuckets().add(this, location);
 }
 
 void Bullet::init()
@@ -230,7 +236,11 @@ void Bullet::init()
 }
 
 
-Bullet::~Bullet() = default;
+Bullet::~Bullet() {
+    if(currentGameMap != nullptr) {
+        currentGameMap->getBulletDrawBuckets().remove(this, drawBucket);
+    }
+}
 
 void Bullet::save(OutputStream& stream) const
 {
@@ -359,11 +369,11 @@ void Bullet::update()
     realY += ySpeed;
     location.x = floor(realX/TILESIZE);
     location.y = floor(realY/TILESIZE);
+    drawBucket = currentGameMap->getBulletDrawBuckets().move(this, drawBucket, location);
 
     if((location.x < -5) || (location.x >= currentGameMap->getSizeX() + 5) || (location.y < -5) || (location.y >= currentGameMap->getSizeY() + 5)) {
         // it's off the map => delete it
-        bulletList.remove(this);
-        delete this;
+        bulletList.destroy(this);
         return;
     } else {
         FixPoint newDistanceToDestination = distanceFrom(realX, realY, destination.x, destination.y);
@@ -389,14 +399,13 @@ void Bullet::update()
 
             FixPoint currentDamage = dist*damageDecrease + startDamage;
 
-            Coord realPos = Coord(lround(realX), lround(realY));
-            currentGameMap->damage(shooterID, owner, realPos, bulletID, currentDamage/2, damageRadius, false);
+            const Coord fromPos = Coord(lround(realX), lround(realY));
 
             realX += xSpeed;  //keep the bullet moving by its current speeds
             realY += ySpeed;
 
-            realPos = Coord(lround(realX), lround(realY));
-            currentGameMap->damage(shooterID, owner, realPos, bulletID, currentDamage/2, damageRadius, false);
+            const Coord toPos = Coord(lround(realX), lround(realY));
+            currentGameMap->damageLine(shooterID, owner, fromPos, toPos, bulletID, currentDamage/2, damageRadius, false);
         } else if( explodesAtGroundObjects
                     && currentGameMap->tileExists(location)
                     && currentGameMap->getTile(location)->hasAGroundObject()
@@ -432,7 +441,7 @@ void Bullet::destroy()
         case Bullet_DRocket: {
             currentGameMap->damage(shooterID, owner, position, bulletID, damage, damageRadius, airAttack);
             soundPlayer->playSoundAt(Sound_ExplosionGas, position);
-            currentGame->getExplosionList().push_back(new Explosion(Explosion_Gas,position,houseID));
+            currentGame->getExplosionList().create(Explosion_Gas,position,houseID);
         } break;
 
         case Bullet_LargeRocket: {
@@ -447,7 +456,7 @@ void Bullet::destroy()
                         currentGameMap->damage(shooterID, owner, position, bulletID, damage, damageRadius, airAttack);
 
                         Uint32 explosionID = currentGame->randomGen.getRandOf({Explosion_Large1,Explosion_Large2});
-                        currentGame->getExplosionList().push_back(new Explosion(explosionID,position,houseID));
+                        currentGame->getExplosionList().create(explosionID,position,houseID);
                         screenborder->shakeScreen(22);
                     }
                 }
@@ -458,27 +467,27 @@ void Bullet::destroy()
         case Bullet_TurretRocket:
         case Bullet_SmallRocket: {
             currentGameMap->damage(shooterID, owner, position, bulletID, damage, damageRadius, airAttack);
-            currentGame->getExplosionList().push_back(new Explosion(Explosion_Small,position,houseID));
+            currentGame->getExplosionList().create(Explosion_Small,position,houseID);
         } break;
 
         case Bullet_ShellSmall: {
             currentGameMap->damage(shooterID, owner, position, bulletID, damage, damageRadius, airAttack);
-            currentGame->getExplosionList().push_back(new Explosion(Explosion_ShellSmall,position,houseID));
+            currentGame->getExplosionList().create(Explosion_ShellSmall,position,houseID);
         } break;
 
         case Bullet_ShellMedium: {
             currentGameMap->damage(shooterID, owner, position, bulletID, damage, damageRadius, airAttack);
-            currentGame->getExplosionList().push_back(new Explosion(Explosion_ShellMedium,position,houseID));
+            currentGame->getExplosionList().create(Explosion_ShellMedium,position,houseID);
         } break;
 
         case Bullet_ShellLarge: {
             currentGameMap->damage(shooterID, owner, position, bulletID, damage, damageRadius, airAttack);
-            currentGame->getExplosionList().push_back(new Explosion(Explosion_ShellLarge,position,houseID));
+            currentGame->getExplosionList().create(Explosion_ShellLarge,position,houseID);
         } break;
 
         case Bullet_ShellTurret: {
             currentGameMap->damage(shooterID, owner, position, bulletID, damage, damageRadius, airAttack);
-            currentGame->getExplosionList().push_back(new Explosion(Explosion_ShellMedium,position,houseID));
+            currentGame->getExplosionList().create(Explosion_ShellMedium,position,houseID);
         } break;
 
         case Bullet_Sonic:
@@ -488,7 +497,6 @@ void Bullet::destroy()
         } break;
     }
 
-    bulletList.remove(this);
-    delete this;
+    bulletList.destroy(this);
 }
 
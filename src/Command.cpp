@@ -37,39 +37,37 @@
 #include <structures/StarPort.h>
 #include <structures/ConstructionYard.h>
 
+#include <algorithm>
+
 Command::Command(Uint8 playerID, CMDTYPE id)
  : playerID(playerID), commandID(id)
 {
 }
 
 Command::Command(Uint8 playerID, CMDTYPE id, Uint32 parameter1)
- : playerID(playerID), commandID(id)
+ : playerID(playerID), commandID(id), numParameters(1), inlineParameters{ { parameter1 } }
 {
-    parameter.push_back(parameter1);
 }
 
 Command::Command(Uint8 playerID, CMDTYPE id, Uint32 parameter1, Uint32 parameter2)
- : playerID(playerID), commandID(id)
+ : playerID(playerID), commandID(id), numParameters(2), inlineParameters{ { parameter1, parameter2 } }
 {
-    parameter.push_back(parameter1);
-    parameter.push_back(parameter2);
 }
 
 Command::Command(Uint8 playerID, CMDTYPE id, Uint32 parameter1, Uint32 parameter2, Uint32 parameter3)
- : playerID(playerID), commandID(id)
+ : playerID(playerID), commandID(id), numParameters(3), inlineParameters{ { parameter1, parameter2, parameter3 } }
 {
-    parameter.push_back(parameter1);
-    parameter.push_back(parameter2);
-    parameter.push_back(parameter3);
 }
 
 Command::Command(Uint8 playerID, CMDTYPE id, Uint32 parameter1, Uint32 parameter2, Uint32 parameter3, Uint32 parameter4)
+ : playerID(playerID), commandID(id), numParameters(4), inlineParameters{ { parameter1, parameter2, parameter3, parameter4 } }
+{
+}
+
+Command::Command(Uint8 playerID, CMDTYPE id, const std::vector<Uint32>& parameters)
  : playerID(playerID), commandID(id)
 {
-    parameter.push_back(parameter1);
-    parameter.push_back(parameter2);
-    parameter.push_back(parameter3);
-    parameter.push_back(parameter4);
+    setParameters(parameters.data(), parameters.size());
 }
 
 Command::Command(Uint8 playerID, Uint8* data, Uint32 length)
@@ -89,29 +87,99 @@ Command::Command(Uint8 playerID, Uint8* data, Uint32 length)
         THROW(std::invalid_argument, "Command::Command(): CommandID unknown!");
     }
 
-    Uint32* pData = (Uint32*) (data+4);
-    for(Uint32 i=0;i<(length-4)/4;i++) {
-        parameter.push_back(*pData);
-        pData++;
-    }
+    setParameters((Uint32*) (data+4), (length-4)/4);
 }
 
 Command::Command(InputStream& stream) {
     playerID = stream.readUint8();
     commandID = (CMDTYPE) stream.readUint32();
-    parameter = stream.readUint32Vector();
+
+    Uint32 count = stream.readUint32();
+    if(count <= COMMAND_INLINE_PARAMETERS) {
+        stream.readUint32Array(inlineParameters.data(), count);
+        numParameters = count;
+    } else {
+        std::vector<Uint32> parameters(count);
+        stream.readUint32Array(parameters.data(), count);
+        setParameters(parameters.data(), parameters.size());
+    }
+}
+
+Command::Command(InputStream& stream, const Command* pPrevCommand) {
+    Uint32 header = stream.readVarUint32();
+    commandID = (CMDTYPE) (header >> 1);
+    if(commandID >= CMD_MAX) {
+        THROW(InputStream::error, "Command::Command(): CommandID unknown!");
+    }
+
+    if((header & 1) || (pPrevCommand == nullptr)) {
+        playerID = stream.readUint8();
+    } else {
+        playerID = pPrevCommand->playerID;
+    }
+
+    const Parameters prevParameters = (pPrevCommand != nullptr) ? pPrevCommand->getParameter() : Parameters(nullptr, 0);
+
+    Uint32 count = stream.readVarUint32();
+    if(count <= COMMAND_INLINE_PARAMETERS) {
+        for(Uint32 i = 0; i < count; i++) {
+            Uint32 prevParameter = (i < prevParameters.size()) ? prevParameters[i] : 0;
+            inlineParameters[i] = prevParameter + (Uint32) stream.readVarSint32();
+        }
+        numParameters = count;
+    } else {
+        // no reserve() as count comes from the network
+        std::vector<Uint32> parameters;
+        for(Uint32 i = 0; i < count; i++) {
+            Uint32 prevParameter = (i < prevParameters.size()) ? prevParameters[i] : 0;
+            parameters.push_back(prevParameter + (Uint32) stream.readVarSint32());
+        }
+        setParameters(parameters.data(), parameters.size());
+    }
 }
 
 Command::~Command() = default;
 
+void Command::setParameters(const Uint32* pParameters, size_t count) {
+    if(count <= COMMAND_INLINE_PARAMETERS) {
+        std::copy(pParameters, pParameters + count, inlineParameters.begin());
+        pLongParameters.reset();
+    } else {
+        pLongParameters = std::make_shared<const std::vector<Uint32>>(pParameters, pParameters + count);
+    }
+    numParameters = (Uint32) count;
+}
+
 void Command::save(OutputStream& stream) const {
+    const Parameters parameter = getParameter();
+
     stream.writeUint8(playerID);
     stream.writeUint32((Uint32) commandID);
-    stream.writeUint32Vector(parameter);
+    stream.writeUint32((Uint32) parameter.size());
+    stream.writeUint32Array(parameter.begin(), parameter.size());
     stream.flush();
 }
 
+void Command::saveCompact(OutputStream& stream, const Command* pPrevCommand) const {
+    const Parameters parameter = getParameter();
+    const Parameters prevParameters = (pPrevCommand != nullptr) ? pPrevCommand->getParameter() : Parameters(nullptr, 0);
+
+    bool bNewPlayerID = (pPrevCommand == nullptr) || (pPrevCommand->playerID != playerID);
+    stream.writeVarUint32(((Uint32) commandID << 1) | (bNewPlayerID ? 1 : 0));
+    if(bNewPlayerID) {
+        stream.writeUint8(playerID);
+    }
+
+    stream.writeVarUint32((Uint32) parameter.size());
+    for(size_t i = 0; i < parameter.size(); i++) {
+        Uint32 prevParameter = (i < prevParameters.size()) ? prevParameters[i] : 0;
+        stream.writeVarSint32((Sint32) (parameter[i] - prevParameter));
+    }
+}
+
 void Command::executeCommand() const {
+    const Parameters parameter = getParameter();
+
     switch(commandID) {
 
         case CMD_PLACE_STRUCTURE: {
@@ -376,13 +444,44 @@ void Command::executeCommand() const {
             Uint32 currentSeed = currentGame->randomGen.getSeed();
             if(currentSeed != parameter[0]) {
                 SDL_Log("Warning: Game is asynchronous in game cycle %d! Saved seed and current seed do not match: %ud != %ud", currentGame->getGameCycleCount(), parameter[0], currentSeed);
+                currentGame->reportDesync();
 #ifdef TEST_SYNC
                 currentGame->saveGame("test.sav");
+                currentGame->waitForSaveGames();
                 exit(0);
 #endif
             }
         } break;
 
+        case CMD_NETWORK_CYCLE_BUFFER: {
+            if(parameter.size() != 1) {
+                THROW(std::invalid_argument, "Command::executeCommand(): CMD_NETWORK_CYCLE_BUFFER needs 1 Parameter!");
+            }
+
+            currentGame->getCommandManager().onRequestNetworkCycleBuffer(playerID, parameter[0]);
+        } break;
+
+        case CMD_TEST_STATEHASH: {
+            if(parameter.size() != 5) {
+                THROW(std::invalid_argument, "Command::executeCommand(): CMD_TEST_STATEHASH needs 5 Parameters!");
+            }
+
+            currentGame->checkStateHashes(playerID, parameter[0], StateHashes::fromParameters(std::vector<Uint32>(parameter.begin() + 1, parameter.end())));
+        } break;
+
+        case CMD_UNIT_MOVE2POS_GROUP: {
+            if(parameter.size() < 4) {
+                THROW(std::invalid_argument, "Command::executeCommand(): CMD_UNIT_MOVE2POS_GROUP needs at least 4 Parameters!");
+            }
+            // same effect as one CMD_UNIT_MOVE2POS per unit in this order
+            for(size_t i = 3; i < parameter.size(); i++) {
+                UnitBase* unit = dynamic_cast<UnitBase*>(currentGame->getObjectManager().getObject(parameter[i]));
+                if(unit != nullptr) {
+                    unit->doMove2Pos((int) parameter[0], (int) parameter[1], (bool) parameter[2]);
+                }
+            }
+        } break;
+
         default: {
             THROW(std::invalid_argument, "Command::executeCommand(): Unknown CommandID!");
         } break;
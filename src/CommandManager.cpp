@@ -19,6 +19,7 @@
 
 #include <Network/NetworkManager.h>
 #include <players/HumanPlayer.h>
+#include <House.h>
 
 #include <globals.h>
 
@@ -39,14 +40,16 @@ void CommandManager::addCommand(const Command& cmd) {
     Uint32 CycleNumber = currentGame->getGameCycleCount();
 
     if(pNetworkManager != nullptr) {
-        CycleNumber += networkCycleBuffer;
+        // the other peers treat every command list they already received as final, so if the buffer was reduced
+        // in the meantime the command has to wait for the first cycle that was not sent yet
+        CycleNumber = std::max(CycleNumber + networkCycleBuffer, nextUnsentCycle);
     }
     addCommand(cmd, CycleNumber);
 }
 
 void CommandManager::save(OutputStream& stream) const {
-    for(unsigned int i=0;i<timeslot.size();i++) {
-        for(const Command& command : timeslot[i]) {
+    for(Uint32 i = timeline.getNextCycleWithCommands(0); i < timeline.getNumCycles(); i = timeline.getNextCycleWithCommands(i + 1)) {
+        for(const Command& command : timeline.getCommands(i)) {
             stream.writeUint32(i);
             command.save(stream);
         }
@@ -66,15 +69,15 @@ void CommandManager::load(InputStream& stream) {
 
 void CommandManager::update() {
     if(pNetworkManager != nullptr) {
+        nextUnsentCycle = std::max(nextUnsentCycle, currentGame->getGameCycleCount() + networkCycleBuffer);
+
         CommandList commandList;
-        for(Uint32 i = std::max((int) currentGame->getGameCycleCount() - MILLI2CYCLES(2500), 0); i < currentGame->getGameCycleCount() + networkCycleBuffer; i++) {
+        for(Uint32 i = std::max((int) currentGame->getGameCycleCount() - MILLI2CYCLES(2500), 0); i < nextUnsentCycle; i++) {
             std::vector<Command> commands;
 
-            if(i < timeslot.size()) {
-                for(Command& command : timeslot[i]) {
-                    if(command.getPlayerID() == pLocalPlayer->getPlayerID()) {
-                        commands.push_back(command);
-                    }
+            for(const Command& command : timeline.getCommands(i)) {
+                if(command.getPlayerID() == pLocalPlayer->getPlayerID()) {
+                    commands.push_back(command);
                 }
             }
 
@@ -85,7 +88,58 @@ void CommandManager::update() {
     }
 }
 
+Uint32 CommandManager::getMeasuredNetworkCycleBuffer() const {
+    if(pNetworkManager == nullptr) {
+        return 0;
+    }
+
+    // commands sent now have to arrive before a peer with a slow connection simulates their cycle
+    const int latency = pNetworkManager->getMaxPeerRoundTripTime() + 4 * pNetworkManager->getMaxPeerJitter();
+    const Uint32 cycleBuffer = MILLI2CYCLES(latency) + NETWORKCYCLEBUFFER_MARGIN;
+
+    return std::min(std::max(cycleBuffer, (Uint32) NETWORKCYCLEBUFFER_MIN), (Uint32) NETWORKCYCLEBUFFER_MAX);
+}
+
+void CommandManager::requestNetworkCycleBuffer() {
+    if((pNetworkManager == nullptr) || (pLocalPlayer == nullptr) || bReadOnly) {
+        return;
+    }
+
+    if(pNetworkManager->getMinPeerProtocolVersion() < NETWORKPROTOCOL_VERSION_COMPACTCOMMANDLIST) {
+        // peers without a protocol version do not know this command; the cycle buffer stays at its initial value
+        return;
+    }
+
+    addCommand(Command(pLocalPlayer->getPlayerID(), CMD_NETWORK_CYCLE_BUFFER, getMeasuredNetworkCycleBuffer()));
+}
+
+void CommandManager::onRequestNetworkCycleBuffer(Uint8 playerID, Uint32 requestedCycleBuffer) {
+    const Uint32 gameCycle = currentGame->getGameCycleCount();
+
+    networkCycleBufferRequests[playerID] = { std::min(requestedCycleBuffer, (Uint32) NETWORKCYCLEBUFFER_MAX), gameCycle };
+
+    Uint32 newNetworkCycleBuffer = NETWORKCYCLEBUFFER_MIN;
+    for(auto iter = networkCycleBufferRequests.begin(); iter != networkCycleBufferRequests.end(); ) {
+        if(iter->second.gameCycle + NETWORKCYCLEBUFFER_REQUEST_LIFETIME < gameCycle) {
+            // this player probably left the game
+            iter = networkCycleBufferRequests.erase(iter);
+        } else {
+            newNetworkCycleBuffer = std::max(newNetworkCycleBuffer, iter->second.cycleBuffer);
+            ++iter;
+        }
+    }
+
+    if(newNetworkCycleBuffer != networkCycleBuffer) {
+        SDL_Log("Game cycle %d: Changing network cycle buffer from %d to %d game cycles", gameCycle, networkCycleBuffer, newNetworkCycleBuffer);
+        networkCycleBuffer = newNetworkCycleBuffer;
+    }
+}
+
 void CommandManager::addCommandList(const std::string& playername, const CommandList& commandList) {
+    if(bWaitingForCatchUpCommands) {
+        return;
+    }
+
     HumanPlayer* pPlayer = dynamic_cast<HumanPlayer*>(currentGame->getPlayerByName(playername));
     if(pPlayer == nullptr) {
         return;
@@ -100,41 +154,82 @@ void CommandManager::addCommandList(const std::string& playername, const Command
             if(command.getPlayerID() != pPlayer->getPlayerID()) {
                 SDL_Log("Warning: Player '%s' send a command which he is not allowed to give!", playername.c_str());
             }
-
-            addCommand(command, commandListEntry.cycle);
         }
 
+        addCommands(commandListEntry.commands, commandListEntry.cycle);
+
         pPlayer->nextExpectedCommandsCycle = std::max(pPlayer->nextExpectedCommandsCycle, commandListEntry.cycle+1);
     }
 }
 
-void CommandManager::addCommand(const Command& cmd, Uint32 CycleNumber) {
-    if(bReadOnly == false) {
+CommandList CommandManager::getCommandList(Uint32 startCycle, Uint32 endCycle) const {
+    CommandList commandList;
+    for(Uint32 i = timeline.getNextCycleWithCommands(startCycle); i < std::min(endCycle, timeline.getNumCycles()); i = timeline.getNextCycleWithCommands(i + 1)) {
+        const CommandTimeline::Range commands = timeline.getCommands(i);
+        commandList.commandList.emplace_back(i, std::vector<Command>(commands.begin(), commands.end()));
+    }
+
+    return commandList;
+}
+
+void CommandManager::addCatchUpCommands(Uint32 catchUpCycle, const CommandList& commandList) {
+    const Uint32 gameCycle = currentGame->getGameCycleCount();
+
+    bWaitingForCatchUpCommands = false;
+
+    // the snapshot only contained the commands known when it was taken
+    timeline.truncate(gameCycle);
 
-        if(CycleNumber >= timeslot.size()) {
-            timeslot.resize(CycleNumber+1);
+    for(const CommandList::CommandListEntry& commandListEntry : commandList.commandList) {
+        addCommands(commandListEntry.commands, commandListEntry.cycle);
+    }
+
+    for(int houseID = 0; houseID < NUM_HOUSES; houseID++) {
+        House* pHouse = currentGame->getHouse(houseID);
+        if(pHouse == nullptr) {
+            continue;
+        }
+
+        for(const auto& pPlayer : pHouse->getPlayerList()) {
+            HumanPlayer* pHumanPlayer = dynamic_cast<HumanPlayer*>(pPlayer.get());
+            if((pHumanPlayer != nullptr) && (pHumanPlayer != pLocalPlayer)) {
+                pHumanPlayer->nextExpectedCommandsCycle = std::max(pHumanPlayer->nextExpectedCommandsCycle, catchUpCycle);
+            }
         }
+    }
+
+    nextUnsentCycle = std::max(nextUnsentCycle, catchUpCycle + networkCycleBuffer);
+}
 
-        timeslot[CycleNumber].push_back(cmd);
-        std::stable_sort(   timeslot[CycleNumber].begin(),
-                            timeslot[CycleNumber].end(),
-                            [](const Command& cmd1, const Command& cmd2) {
-                                return (cmd1.getPlayerID() < cmd2.getPlayerID());
-                            });
+void CommandManager::addCommand(const Command& cmd, Uint32 CycleNumber) {
+    if(bReadOnly == false) {
+        timeline.insert(CycleNumber, cmd);
+        recordCommand(cmd, CycleNumber);
+    }
+}
 
-        if(pStream != nullptr) {
-            pStream->writeUint32(CycleNumber);
-            cmd.save(*pStream);
+void CommandManager::addCommands(const std::vector<Command>& commands, Uint32 CycleNumber) {
+    if(bReadOnly == false) {
+        timeline.insert(CycleNumber, commands);
+        for(const Command& command : commands) {
+            recordCommand(command, CycleNumber);
         }
     }
 }
 
-void CommandManager::executeCommands(Uint32 CycleNumber) const {
-    if(CycleNumber >= timeslot.size()) {
-        return;
+void CommandManager::recordCommand(const Command& cmd, Uint32 CycleNumber) {
+    if(pStream != nullptr) {
+        pStream->writeUint32(CycleNumber);
+        cmd.save(*pStream);
     }
 
-    for(const Command& command : timeslot[CycleNumber]) {
+    if(pOnAddCommand) {
+        pOnAddCommand(CycleNumber, cmd);
+    }
+}
+
+void CommandManager::executeCommands(Uint32 CycleNumber) const {
+    for(const Command& command : timeline.getCommands(CycleNumber)) {
         command.executeCommand();
     }
 }
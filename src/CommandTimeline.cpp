@@ -0,0 +1,92 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <CommandTimeline.h>
+
+#include <algorithm>
+
+static bool hasLowerPlayerID(const Command& cmd1, const Command& cmd2) {
+    return (cmd1.getPlayerID() < cmd2.getPlayerID());
+}
+
+void CommandTimeline::insert(Uint32 cycle, const Command& command) {
+    extendTo(cycle + 1);
+
+    const auto first = commands.begin() + cycleStart[cycle];
+    const auto last = commands.begin() + cycleStart[cycle + 1];
+    commands.insert(std::upper_bound(first, last, command, hasLowerPlayerID), command);
+
+    shiftCyclesAfter(cycle, 1);
+}
+
+void CommandTimeline::insert(Uint32 cycle, const std::vector<Command>& newCommands) {
+    if(newCommands.empty()) {
+        return;
+    }
+
+    extendTo(cycle + 1);
+
+    const Uint32 first = cycleStart[cycle];
+    const Uint32 last = cycleStart[cycle + 1];
+    commands.insert(commands.begin() + last, newCommands.begin(), newCommands.end());
+    std::stable_sort(commands.begin() + first, commands.begin() + last + newCommands.size(), hasLowerPlayerID);
+
+    shiftCyclesAfter(cycle, newCommands.size());
+}
+
+void CommandTimeline::truncate(Uint32 numCycles) {
+    if(numCycles >= getNumCycles()) {
+        return;
+    }
+
+    commands.erase(commands.begin() + cycleStart[numCycles], commands.end());
+    cycleStart.resize(numCycles + 1);
+}
+
+CommandTimeline::Range CommandTimeline::getCommands(Uint32 cycle) const {
+    if(cycle >= getNumCycles()) {
+        return Range(nullptr, nullptr);
+    }
+
+    return Range(commands.data() + cycleStart[cycle], commands.data() + cycleStart[cycle + 1]);
+}
+
+Uint32 CommandTimeline::getNextCycleWithCommands(Uint32 cycle) const {
+    if((cycle >= getNumCycles()) || (cycleStart[cycle] == commands.size())) {
+        return getNumCycles();
+    }
+
+    // the first command at or after cycle belongs to the last cycle starting at its index (the cycles before are empty)
+    const Uint32 index = cycleStart[cycle];
+    return (Uint32) (std::upper_bound(cycleStart.begin() + cycle, cycleStart.end(), index) - cycleStart.begin()) - 1;
+}
+
+void CommandTimeline::extendTo(Uint32 numCycles) {
+    if(cycleStart.empty()) {
+        cycleStart.push_back(0);
+    }
+
+    if(numCycles > getNumCycles()) {
+        cycleStart.resize(numCycles + 1, (Uint32) commands.size());
+    }
+}
+
+void CommandTimeline::shiftCyclesAfter(Uint32 cycle, Uint32 num) {
+    for(auto iter = cycleStart.begin() + cycle + 1; iter != cycleStart.end(); ++iter) {
+        *iter += num;
+    }
+}
@@ -0,0 +1,193 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ConnectivityMap.h>
+
+#include <Map.h>
+#include <mmath.h>
+
+#include <algorithm>
+
+ConnectivityMap::ConnectivityMap(const Map* pMap)
+ : pMap(pMap) {
+}
+
+void ConnectivityMap::reset() {
+    for(Layer& layer : layers) {
+        layer.labels.clear();
+        layer.nextLabel = 0;
+        layer.bDirty = true;
+    }
+}
+
+void ConnectivityMap::updateArea(int x, int y, int width, int height) {
+    const int x1 = std::max(0, x);
+    const int y1 = std::max(0, y);
+    const int x2 = std::min(pMap->getSizeX() - 1, x + width - 1);
+    const int y2 = std::min(pMap->getSizeY() - 1, y + height - 1);
+
+    for(int layerIndex = 0; layerIndex < 2; layerIndex++) {
+        Layer& layer = layers[layerIndex];
+        if(layer.bDirty) {
+            // will be recalculated completely anyway
+            continue;
+        }
+
+        for(int i = x1; i <= x2; i++) {
+            for(int j = y1; j <= y2; j++) {
+                layer.labels[pMap->getTileIndex(i, j)] = NONE_ID;
+            }
+        }
+
+        // every region touching the area might have been split or merged; label them again starting from the area and its border
+        const Uint32 firstNewLabel = layer.nextLabel;
+        for(int i = std::max(0, x1 - 1); i <= std::min(pMap->getSizeX() - 1, x2 + 1); i++) {
+            for(int j = std::max(0, y1 - 1); j <= std::min(pMap->getSizeY() - 1, y2 + 1); j++) {
+                const Uint32 label = layer.labels[pMap->getTileIndex(i, j)];
+                if(((label == NONE_ID) || (label < firstNewLabel)) && isPassable(layerIndex, i, j)) {
+                    floodFill(layerIndex, Coord(i, j), layer.nextLabel++);
+                }
+            }
+        }
+    }
+}
+
+bool ConnectivityMap::isReachable(bool bInfantry, const Coord& start, const Coord& destination) {
+    if(!pMap->tileExists(start) || !pMap->tileExists(destination)) {
+        return true;
+    }
+
+    const Layer& layer = getLayer(bInfantry);
+
+    const Uint32 startLabel = layer.labels[pMap->getTileIndex(start.x, start.y)];
+    if(startLabel == NONE_ID) {
+        // we are standing on an obstacle (e.g. leaving a structure)
+        return true;
+    }
+
+    const Uint32 destinationLabel = layer.labels[pMap->getTileIndex(destination.x, destination.y)];
+    if(destinationLabel != NONE_ID) {
+        return (destinationLabel == startLabel);
+    }
+
+    for(int angle = 0; angle < NUM_ANGLES; angle++) {
+        const Coord neighbour = Map::getMapPos(angle, destination);
+        if(pMap->tileExists(neighbour) && (layer.labels[pMap->getTileIndex(neighbour.x, neighbour.y)] == startLabel)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ConnectivityMap::findClosestReachable(bool bInfantry, const Coord& start, const Coord& destination, Coord& closest) {
+    if(!pMap->tileExists(start) || !pMap->tileExists(destination)) {
+        return false;
+    }
+
+    const Layer& layer = getLayer(bInfantry);
+
+    const Uint32 startLabel = layer.labels[pMap->getTileIndex(start.x, start.y)];
+    if(startLabel == NONE_ID) {
+        return false;
+    }
+
+    const int sizeX = pMap->getSizeX();
+    const int sizeY = pMap->getSizeY();
+    const int maxRing = std::max(sizeX, sizeY);
+
+    // search rings of increasing size around destination; no tile on ring k is closer than k
+    FixPoint closestDistance = FixPt_MAX;
+    for(int k = 0; (k <= maxRing) && (k < closestDistance); k++) {
+        for(int i = destination.x - k; i <= destination.x + k; i++) {
+            const int step = ((i == destination.x - k) || (i == destination.x + k)) ? 1 : std::max(1, 2*k);
+            for(int j = destination.y - k; j <= destination.y + k; j += step) {
+                if((i < 0) || (i >= sizeX) || (j < 0) || (j >= sizeY)) {
+                    continue;
+                }
+
+                if(layer.labels[pMap->getTileIndex(i, j)] == startLabel) {
+                    const Coord coord(i, j);
+                    const FixPoint distance = blockDistance(coord, destination);
+                    if(distance < closestDistance) {
+                        closestDistance = distance;
+                        closest = coord;
+                    }
+                }
+            }
+        }
+    }
+
+    return (closestDistance != FixPt_MAX);
+}
+
+bool ConnectivityMap::isPassable(int layerIndex, int x, int y) const {
+    const Tile* pTile = pMap->getTile(x, y);
+
+    if(pTile->hasAStructure()) {
+        return false;
+    }
+
+    return (layerIndex == 1) || !pTile->isMountain();
+}
+
+ConnectivityMap::Layer& ConnectivityMap::getLayer(bool bInfantry) {
+    const int layerIndex = bInfantry ? 1 : 0;
+    Layer& layer = layers[layerIndex];
+
+    if(layer.bDirty) {
+        layer.labels.assign(pMap->getSizeX()*pMap->getSizeY(), NONE_ID);
+        layer.nextLabel = 0;
+        layer.bDirty = false;
+
+        for(int i = 0; i < pMap->getSizeX(); i++) {
+            for(int j = 0; j < pMap->getSizeY(); j++) {
+                if((layer.labels[pMap->getTileIndex(i, j)] == NONE_ID) && isPassable(layerIndex, i, j)) {
+                    floodFill(layerIndex, Coord(i, j), layer.nextLabel++);
+                }
+            }
+        }
+    }
+
+    return layer;
+}
+
+void ConnectivityMap::floodFill(int layerIndex, const Coord& start, Uint32 label) {
+    std::vector<Uint32>& labels = layers[layerIndex].labels;
+
+    openTiles.clear();
+    openTiles.push_back(start);
+    labels[pMap->getTileIndex(start.x, start.y)] = label;
+
+    while(!openTiles.empty()) {
+        const Coord current = openTiles.back();
+        openTiles.pop_back();
+
+        for(int angle = 0; angle < NUM_ANGLES; angle++) {
+            const Coord next = Map::getMapPos(angle, current);
+            if(!pMap->tileExists(next)) {
+                continue;
+            }
+
+            const int index = pMap->getTileIndex(next.x, next.y);
+            if((labels[index] != label) && isPassable(layerIndex, next.x, next.y)) {
+                labels[index] = label;
+                openTiles.push_back(next);
+            }
+        }
+    }
+}
@@ -42,11 +42,15 @@ void CutScene::run()
 {
     SDL_Event event;
 
+    // the frames are scheduled on the performance counter, so the frame durations do not drift with the time
+    // spent in draw() or the inaccuracy of SDL_Delay()
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 nextFrameCounter = SDL_GetPerformanceCounter();
+
     while (!quiting)
     {
-        const int frameStart = SDL_GetTicks();
-
         const int nextFrameTime = draw();
+        nextFrameCounter += (Uint64) nextFrameTime * frequency / 1000;
 
         while(SDL_PollEvent(&event)) {
 
@@ -66,9 +70,11 @@ void CutScene::run()
             }
         }
 
-        const int frameTime = SDL_GetTicks() - frameStart;
-        if(frameTime < nextFrameTime) {
-            SDL_Delay(nextFrameTime - frameTime);
+        const Uint64 now = SDL_GetPerformanceCounter();
+        if(now < nextFrameCounter) {
+            SDL_Delay((Uint32) ((nextFrameCounter - now) * 1000 / frequency));
+        } else if(now - nextFrameCounter > CUTSCENE_MAX_LAG * frequency / 1000) {
+            nextFrameCounter = now;
         }
     }
 }
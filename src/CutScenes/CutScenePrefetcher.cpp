@@ -0,0 +1,139 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <CutScenes/CutScenePrefetcher.h>
+
+#include <misc/sound_util.h>
+#include <misc/exceptions.h>
+#include <misc/Tracing.h>
+
+CutScenePrefetcher::CutScenePrefetcher() {
+    mutex = SDL_CreateMutex();
+    soundAddedCond = SDL_CreateCond();
+    soundLoadedCond = SDL_CreateCond();
+    if((mutex == nullptr) || (soundAddedCond == nullptr) || (soundLoadedCond == nullptr)) {
+        THROW(std::runtime_error, "CutScenePrefetcher::CutScenePrefetcher(): Unable to create mutex: %s", SDL_GetError());
+    }
+
+    pThread = SDL_CreateThread(loaderThreadMain, "CutScenePrefetcher", (void*) this);
+    if(pThread == nullptr) {
+        SDL_Log("CutScenePrefetcher: Unable to create loader thread: %s", SDL_GetError());
+    }
+}
+
+CutScenePrefetcher::~CutScenePrefetcher() {
+    if(pThread != nullptr) {
+        SDL_LockMutex(mutex);
+        bStop = true;
+        SDL_CondSignal(soundAddedCond);
+        SDL_UnlockMutex(mutex);
+
+        SDL_WaitThread(pThread, nullptr);
+    }
+
+    if(soundLoadedCond != nullptr) {
+        SDL_DestroyCond(soundLoadedCond);
+    }
+
+    if(soundAddedCond != nullptr) {
+        SDL_DestroyCond(soundAddedCond);
+    }
+
+    if(mutex != nullptr) {
+        SDL_DestroyMutex(mutex);
+    }
+}
+
+int CutScenePrefetcher::addSound(const std::string& filename) {
+    return addSound([filename]() { return getChunkFromFile(filename); });
+}
+
+int CutScenePrefetcher::addSound(std::function<sdl2::mix_chunk_ptr ()> loader) {
+    SDL_LockMutex(mutex);
+    const int index = static_cast<int>(loaders.size());
+    loaders.push_back(std::move(loader));
+    sounds.emplace_back();
+    SDL_CondSignal(soundAddedCond);
+    SDL_UnlockMutex(mutex);
+
+    return index;
+}
+
+Mix_Chunk* CutScenePrefetcher::getSound(int index) {
+    if(pThread == nullptr) {
+        // no loader thread: load the sound on first use
+        if(sounds[index] == nullptr) {
+            sounds[index] = loaders[index]();
+        }
+        return sounds[index].get();
+    }
+
+    SDL_LockMutex(mutex);
+    while((numLoaded <= index) && !pException) {
+        SDL_CondWait(soundLoadedCond, mutex);
+    }
+    const bool bFailed = (numLoaded <= index);
+    // sounds may be reallocated by addSound(), so it is only read with the mutex locked
+    Mix_Chunk* pSound = bFailed ? nullptr : sounds[index].get();
+    SDL_UnlockMutex(mutex);
+
+    if(bFailed) {
+        std::rethrow_exception(pException);
+    }
+
+    return pSound;
+}
+
+int CutScenePrefetcher::loaderThreadMain(void* data) {
+    TRACE_THREAD_NAME("CutScenePrefetcher");
+    static_cast<CutScenePrefetcher*>(data)->loadSounds();
+    return 0;
+}
+
+void CutScenePrefetcher::loadSounds() {
+    try {
+        while(true) {
+            SDL_LockMutex(mutex);
+            while(!bStop && (numLoaded >= static_cast<int>(loaders.size()))) {
+                SDL_CondWait(soundAddedCond, mutex);
+            }
+            if(bStop) {
+                SDL_UnlockMutex(mutex);
+                return;
+            }
+            const std::function<sdl2::mix_chunk_ptr ()> loader = loaders[numLoaded];
+            SDL_UnlockMutex(mutex);
+
+            sdl2::mix_chunk_ptr pSound;
+            {
+                TRACE_ZONE("Load cutscene sound");
+                pSound = loader();
+            }
+
+            SDL_LockMutex(mutex);
+            sounds[numLoaded] = std::move(pSound);
+            numLoaded++;
+            SDL_CondBroadcast(soundLoadedCond);
+            SDL_UnlockMutex(mutex);
+        }
+    } catch(...) {
+        SDL_LockMutex(mutex);
+        pException = std::current_exception();
+        SDL_CondBroadcast(soundLoadedCond);
+        SDL_UnlockMutex(mutex);
+    }
+}
@@ -80,14 +80,15 @@ Finale::Finale(int house) {
     pPlanetDuneInHouseColorSurface = mapSurfaceColorRange(pPlanetDuneInHouseColorSurface.get(), houseToPaletteIndex[HOUSE_HARKONNEN], houseToPaletteIndex[house]);
 
     if(house == HOUSE_HARKONNEN || house == HOUSE_ATREIDES || house == HOUSE_ORDOS) {
-        lizard = getChunkFromFile("LIZARD1.VOC");
-        glass = getChunkFromFile("GLASS6.VOC");
-        click = getChunkFromFile("CLICK.VOC");
-        blaster = getChunkFromFile("BLASTER.VOC");
-        blowup = getChunkFromFile("BLOWUP1.VOC");
+        // the sounds are loaded in the background while the first scenes are playing
+        click = prefetcher.addSound("CLICK.VOC");
+        blaster = prefetcher.addSound("BLASTER.VOC");
+        blowup = prefetcher.addSound("BLOWUP1.VOC");
+        glass = prefetcher.addSound("GLASS6.VOC");
+        lizard = prefetcher.addSound("LIZARD1.VOC");
     }
 
-    const auto pIntroText = std::make_unique<IndexedTextFile>(pFileManager->openFile("INTRO." + _("LanguageFileExtension")).get());
+    const IndexedTextFile* pIntroText = &pTextManager->getIndexedTextFile("INTRO." + _("LanguageFileExtension"));
 
     const Uint32 color = SDL2RGB(palette[houseToPaletteIndex[house]+1]);
     const Uint32 sardaukarColor = SDL2RGB(palette[PALCOLOR_SARDAUKAR+1]);
@@ -131,13 +132,13 @@ Finale::Finale(int house) {
             addVideoEvent(std::make_unique<HoldPictureVideoEvent>(pPalace2->getPicture(pPalace2->getNumFrames()-1).get(), 15));
             addVideoEvent(std::make_unique<FadeOutVideoEvent>(pPalace2->getPicture(pPalace2->getNumFrames()-1).get(), 20));
             addTextEvent(std::make_unique<TextEvent>(pIntroText->getString(FinaleText_NO_NO_NOOO),sardaukarColor,10,30,false,true,false));
-            addTrigger(std::make_unique<CutSceneSoundTrigger>(10,click.get()));
-            addTrigger(std::make_unique<CutSceneSoundTrigger>(15,blaster.get()));
-            addTrigger(std::make_unique<CutSceneSoundTrigger>(17,blowup.get()));
-            addTrigger(std::make_unique<CutSceneSoundTrigger>(38,click.get()));
-            addTrigger(std::make_unique<CutSceneSoundTrigger>(43,blaster.get()));
-            addTrigger(std::make_unique<CutSceneSoundTrigger>(45,blowup.get()));
-            addTrigger(std::make_unique<CutSceneSoundTrigger>(67,glass.get()));
+            addTrigger(std::make_unique<CutSceneSoundTrigger>(10,prefetcher,click));
+            addTrigger(std::make_unique<CutSceneSoundTrigger>(15,prefetcher,blaster));
+            addTrigger(std::make_unique<CutSceneSoundTrigger>(17,prefetcher,blowup));
+            addTrigger(std::make_unique<CutSceneSoundTrigger>(38,prefetcher,click));
+            addTrigger(std::make_unique<CutSceneSoundTrigger>(43,prefetcher,blaster));
+            addTrigger(std::make_unique<CutSceneSoundTrigger>(45,prefetcher,blowup));
+            addTrigger(std::make_unique<CutSceneSoundTrigger>(67,prefetcher,glass));
 
         } break;
 
@@ -199,8 +200,8 @@ Finale::Finale(int house) {
             addTextEvent(std::make_unique<TextEvent>(pIntroText->getString(FinaleText_I_am_referring_to_your_game),color,2,35,false,true,false));
             addTextEvent(std::make_unique<TextEvent>(pIntroText->getString(FinaleText_We_were_your_pawns_and_Dune),color,40,45,true,true,false));
             addTextEvent(std::make_unique<TextEvent>(pIntroText->getString(FinaleText_We_have_decided_to_take),color,88,105,true,false,false));
-            addTrigger(std::make_unique<CutSceneSoundTrigger>(42,lizard.get()));
-            addTrigger(std::make_unique<CutSceneSoundTrigger>(62,lizard.get()));
+            addTrigger(std::make_unique<CutSceneSoundTrigger>(42,prefetcher,lizard));
+            addTrigger(std::make_unique<CutSceneSoundTrigger>(62,prefetcher,lizard));
 
             startNewScene();
 
@@ -96,36 +96,37 @@ Intro::Intro() {
     pHarkonnen = create_wsafile("INTRO8A.WSA", "INTRO8B.WSA", "INTRO8C.WSA");
     pDestroyedTank = create_wsafile("INTRO5.WSA");
 
-    IndexedTextFile intro_text{ pFileManager->openFile("INTRO." + _("LanguageFileExtension")).get() };
+    const IndexedTextFile& intro_text = pTextManager->getIndexedTextFile("INTRO." + _("LanguageFileExtension"));
 
 
-    wind = getChunkFromFile("WIND2BP.VOC");
-    carryallLanding = getChunkFromFile("CLANK.VOC");
-    harvester = getChunkFromFile("BRAKES2P.VOC");
+    // the sounds are loaded in the background while the first scenes are playing
+    wind = prefetcher.addSound("WIND2BP.VOC");
+    carryallLanding = prefetcher.addSound("CLANK.VOC");
+    harvester = prefetcher.addSound("BRAKES2P.VOC");
 
-    {
+    gunshot = prefetcher.addSound([]() {
         auto singleGunshot = getChunkFromFile("GUNSHOT.VOC");
         auto fourGunshots = concat4Chunks(singleGunshot.get(), singleGunshot.get(), singleGunshot.get(), singleGunshot.get());
         auto thirteenGunshots = concat4Chunks(fourGunshots.get(), fourGunshots.get(), fourGunshots.get(), singleGunshot.get());
-        gunshot = concat3Chunks(thirteenGunshots.get(), singleGunshot.get(), singleGunshot.get());
-    }
+        return concat3Chunks(thirteenGunshots.get(), singleGunshot.get(), singleGunshot.get());
+    });
 
-    glass = getChunkFromFile("GLASS.VOC");
-    missle = getChunkFromFile("MISSLE8.VOC");
-    blaster = getChunkFromFile("BLASTER.VOC");
-    blowup1 = getChunkFromFile("BLOWUP1.VOC");
-    blowup2 = getChunkFromFile("BLOWUP2.VOC");
+    glass = prefetcher.addSound("GLASS.VOC");
+    missle = prefetcher.addSound("MISSLE8.VOC");
+    blaster = prefetcher.addSound("BLASTER.VOC");
+    blowup1 = prefetcher.addSound("BLOWUP1.VOC");
+    blowup2 = prefetcher.addSound("BLOWUP2.VOC");
 
 
     bool bEnableVoice = (settings.general.language == "en");
     if(bEnableVoice == true) {
         // Load english voice
         for(int i=0;i<Voice_NUM_ENTRIES;i++) {
-            voice[i] = getChunkFromFile(VoiceFileNames[i]);
+            voice[i] = prefetcher.addSound(VoiceFileNames[i]);
         }
     } else {
         for(int i=0;i<Voice_NUM_ENTRIES;i++) {
-            voice[i] = nullptr;
+            voice[i] = -1;
         }
     }
 
@@ -139,8 +140,8 @@ Intro::Intro() {
     addVideoEvent(std::make_unique<FadeOutVideoEvent>(pDuneText->getPicture(pDuneText->getNumFrames() - 1).get(), 20, false));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_The_Battle_for_Arrakis),color,48,40,true,true,true));
     addTextEvent(std::make_unique<TextEvent>("The remake is called Dune Legacy!",color,48,40,true));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(52,voice[Voice_The_building].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(64,voice[Voice_of_a_Dynasty].get()));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(52,prefetcher,voice[Voice_The_building]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(64,prefetcher,voice[Voice_of_a_Dynasty]));
 
     startNewScene();
 
@@ -150,8 +151,8 @@ Intro::Intro() {
     addVideoEvent(std::make_unique<FadeOutVideoEvent>(pPlanet->getPicture(pPlanet->getNumFrames() - 1).get(), 20));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_The_planet_Arrakis),color,20,60,true,true,false));
     addTrigger(std::make_unique<CutSceneMusicTrigger>(25,MUSIC_INTRO));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(25,voice[Voice_The_Planet_Arrakis].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(38,voice[Voice_Known_As_Dune].get()));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(25,prefetcher,voice[Voice_The_Planet_Arrakis]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(38,prefetcher,voice[Voice_Known_As_Dune]));
 
     startNewScene();
 
@@ -160,11 +161,11 @@ Intro::Intro() {
     addVideoEvent(std::make_unique<HoldPictureVideoEvent>(pSandstorm->getPicture(pSandstorm->getNumFrames() - 1).get(), 50));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_Land_of_sand),color,20,40,true,true));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_Home_of_the_Spice_Melange),color,61,45,true,true,false));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(25,wind.get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(15,voice[Voice_Land_of_sand].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(70,voice[Voice_Home].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(78,voice[Voice_of_the_spice].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(92,voice[Voice_Melange].get()));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(25,prefetcher,wind));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(15,prefetcher,voice[Voice_Land_of_sand]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(70,prefetcher,voice[Voice_Home]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(78,prefetcher,voice[Voice_of_the_spice]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(92,prefetcher,voice[Voice_Melange]));
 
     startNewScene();
 
@@ -174,23 +175,23 @@ Intro::Intro() {
     addVideoEvent(std::make_unique<FadeOutVideoEvent>(pHarvesters->getPicture(pHarvesters->getNumFrames() - 1).get(), 20));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_Spice_controls_the_Empire),color,25,40,true,true,false));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_Whoever_controls_Dune),color,66,55,true,true,false));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(45,carryallLanding.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(79,harvester.get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(40,voice[Voice_The_spice].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(47,voice[Voice_controls].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(53,voice[Voice_the_Empire].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(90,voice[Voice_Whoever].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(96,voice[Voice_controls_dune].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(108,voice[Voice_controls_the_spice].get()));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(45,prefetcher,carryallLanding));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(79,prefetcher,harvester));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(40,prefetcher,voice[Voice_The_spice]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(47,prefetcher,voice[Voice_controls]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(53,prefetcher,voice[Voice_the_Empire]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(90,prefetcher,voice[Voice_Whoever]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(96,prefetcher,voice[Voice_controls_dune]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(108,prefetcher,voice[Voice_controls_the_spice]));
 
     startNewScene();
 
     addVideoEvent(std::make_unique<FadeInVideoEvent>(pPalace->getPicture(0).get(), 20));
     addVideoEvent(std::make_unique<HoldPictureVideoEvent>(pPalace->getPicture(0).get(), 50));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_The_Emperor_has_proposed),color,20,48,true,true,false));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(22,voice[Voice_The_Emperor].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(31,voice[Voice_has_proposed].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(49,voice[Voice_to_each_of_the_houses].get()));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(22,prefetcher,voice[Voice_The_Emperor]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(31,prefetcher,voice[Voice_has_proposed]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(49,prefetcher,voice[Voice_to_each_of_the_houses]));
 
     startNewScene();
 
@@ -202,14 +203,14 @@ Intro::Intro() {
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_The_House_that_produces),sardaukarColor,0,52,true,true,false));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_There_are_no_set_territories),sardaukarColor,68,30,true,true,false));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_And_no_rules_of_engagement),sardaukarColor,99,30,true,true,false));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(8,voice[Voice_The_House].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(14,voice[Voice_that_produces].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(20,voice[Voice_the_most_spice].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(30,voice[Voice_will_control_dune].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(81,voice[Voice_There_are_no_set].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(89,voice[Voice_territories].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(98,voice[Voice_and_no].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(102,voice[Voice_rules_of_engagment].get()));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(8,prefetcher,voice[Voice_The_House]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(14,prefetcher,voice[Voice_that_produces]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(20,prefetcher,voice[Voice_the_most_spice]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(30,prefetcher,voice[Voice_will_control_dune]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(81,prefetcher,voice[Voice_There_are_no_set]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(89,prefetcher,voice[Voice_territories]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(98,prefetcher,voice[Voice_and_no]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(102,prefetcher,voice[Voice_rules_of_engagment]));
 
     startNewScene();
 
@@ -218,62 +219,62 @@ Intro::Intro() {
     addVideoEvent(std::make_unique<HoldPictureVideoEvent>(pStarport->getPicture(pStarport->getNumFrames() - 1).get(), 20));
     addVideoEvent(std::make_unique<FadeOutVideoEvent>(pStarport->getPicture(pStarport->getNumFrames() - 1).get(), 20));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_Vast_armies_have_arrived),color,25,60,true,true,false));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(57,carryallLanding.get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(30,voice[Voice_Vast_armies].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(37,voice[Voice_have_arrived].get()));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(57,prefetcher,carryallLanding));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(30,prefetcher,voice[Voice_Vast_armies]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(37,prefetcher,voice[Voice_have_arrived]));
 
     startNewScene();
 
     addVideoEvent(std::make_unique<HoldPictureVideoEvent>(nullptr, 80));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_Now_three_houses_fight),color,0,80,true,false,true));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(10,voice[Voice_Now].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(17,voice[Voice_three_Houses_fight].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(34,voice[Voice_for_control].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(46,voice[Voice_of_Dune].get()));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(10,prefetcher,voice[Voice_Now]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(17,prefetcher,voice[Voice_three_Houses_fight]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(34,prefetcher,voice[Voice_for_control]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(46,prefetcher,voice[Voice_of_Dune]));
 
     startNewScene();
 
     addVideoEvent(std::make_unique<WSAVideoEvent>(pAtreides.get()));
     addVideoEvent(std::make_unique<HoldPictureVideoEvent>(pAtreides->getPicture(pAtreides->getNumFrames()-1).get(), 8));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_The_noble_Atreides),color,25,58,true,true,false));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(21,gunshot.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(31,glass.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(32,glass.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(33,glass.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(51,gunshot.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(61,glass.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(62,glass.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(63,glass.get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(36,voice[Voice_The_noble_Atreides].get()));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(21,prefetcher,gunshot));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(31,prefetcher,glass));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(32,prefetcher,glass));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(33,prefetcher,glass));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(51,prefetcher,gunshot));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(61,prefetcher,glass));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(62,prefetcher,glass));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(63,prefetcher,glass));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(36,prefetcher,voice[Voice_The_noble_Atreides]));
 
 
     startNewScene();
 
     addVideoEvent(std::make_unique<WSAVideoEvent>(pOrdos.get()));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_The_insidious_Ordos),color,-2,47,true,true,false));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(3,missle.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(8,missle.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(28,missle.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(38,missle.get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(12,voice[Voice_The_insidious].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(20,voice[Voice_Ordos].get()));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(3,prefetcher,missle));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(8,prefetcher,missle));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(28,prefetcher,missle));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(38,prefetcher,missle));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(12,prefetcher,voice[Voice_The_insidious]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(20,prefetcher,voice[Voice_Ordos]));
 
     startNewScene();
 
     addVideoEvent(std::make_unique<WSAVideoEvent>(pHarkonnen.get()));
     addVideoEvent(std::make_unique<FadeOutVideoEvent>(pHarkonnen->getPicture(pHarkonnen->getNumFrames() - 1).get(), 15, true, true));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_And_the_evil_Harkonnen),color,-2,45,true,true,false));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(0,gunshot.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(5,blaster.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(7,blaster.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(17,gunshot.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(21,blaster.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(28,gunshot.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(37,gunshot.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(50,blowup1.get()));
-    addTrigger(std::make_unique<CutSceneSoundTrigger>(60,blowup2.get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(4,voice[Voice_And_the].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(10,voice[Voice_evil_Harkonnen].get()));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(0,prefetcher,gunshot));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(5,prefetcher,blaster));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(7,prefetcher,blaster));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(17,prefetcher,gunshot));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(21,prefetcher,blaster));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(28,prefetcher,gunshot));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(37,prefetcher,gunshot));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(50,prefetcher,blowup1));
+    addTrigger(std::make_unique<CutSceneSoundTrigger>(60,prefetcher,blowup2));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(4,prefetcher,voice[Voice_And_the]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(10,prefetcher,voice[Voice_evil_Harkonnen]));
 
     startNewScene();
 
@@ -290,8 +291,8 @@ Intro::Intro() {
     addVideoEvent(std::make_unique<WSAVideoEvent>(pDestroyedTank.get()));
     addVideoEvent(std::make_unique<FadeOutVideoEvent>(pDestroyedTank->getPicture(pDestroyedTank->getNumFrames() - 1).get(), 15));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_Only_one_House_will_prevail),color,18,35,true,true,false));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(21,voice[Voice_Only_one_house].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(30,voice[Voice_will_prevail].get()));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(21,prefetcher,voice[Voice_Only_one_house]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(30,prefetcher,voice[Voice_will_prevail]));
 
     startNewScene();
 
@@ -299,10 +300,10 @@ Intro::Intro() {
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_Your_battle_for_Dune_begins),color,20,45,true,false,true));
     addTextEvent(std::make_unique<TextEvent>(intro_text.getString(IntroText_NOW),color,68,83,false,true,true));
 //    addTextEvent(std::make_unique<TextEvent>("",COLOR_BLACK,115,10,false,false,true));    // padding to give music time to complete
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(30,voice[Voice_Your].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(36,voice[Voice_battle_for_Dune].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(48,voice[Voice_begins].get()));
-    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(68,voice[Voice_Now_Now].get()));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(30,prefetcher,voice[Voice_Your]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(36,prefetcher,voice[Voice_battle_for_Dune]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(48,prefetcher,voice[Voice_begins]));
+    if(bEnableVoice) addTrigger(std::make_unique<CutSceneSoundTrigger>(68,prefetcher,voice[Voice_Now_Now]));
 }
 
 Intro::~Intro() = default;
@@ -44,7 +44,7 @@ Meanwhile::Meanwhile(int house, bool firstMeanwhile) {
     pMeanwhile = create_wsafile("MEANWHIL.WSA");
     pImperator = create_wsafile("EFINALA.WSA");
 
-    IndexedTextFile dune_text{ pFileManager->openFile("DUNE." + _("LanguageFileExtension")).get() };
+    const IndexedTextFile& dune_text = pTextManager->getIndexedTextFile("DUNE." + _("LanguageFileExtension"));
 
     int textBaseIndex = MeanwhileText_Base + ((house+2)%3) * MeanwhileText_NumTextsPerHouse;
 
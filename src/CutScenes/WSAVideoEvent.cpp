@@ -33,7 +33,11 @@ WSAVideoEvent::~WSAVideoEvent() = default;
 
 int WSAVideoEvent::draw()
 {
-    sdl2::surface_ptr pSurface = convertSurfaceToDisplayFormat(Scaler::defaultDoubleSurface(pWsafile->getPicture(currentFrame).get()).get());
+    if(pWsaStream == nullptr) {
+        pWsaStream = std::make_unique<WsaStream>(pWsafile);
+    }
+
+    sdl2::surface_ptr pSurface = convertSurfaceToDisplayFormat(Scaler::defaultDoubleSurface(pWsaStream->getNextPicture().get()).get());
 
     SDL_UpdateTexture(pStreamingTexture.get(), nullptr, pSurface->pixels, pSurface->pitch);
 
@@ -43,6 +47,11 @@ int WSAVideoEvent::draw()
 
     currentFrame++;
 
+    if(currentFrame >= pWsafile->getNumFrames()) {
+        // free the frame buffers and the decoder thread as soon as the video is over
+        pWsaStream.reset();
+    }
+
     //return (int) (1000.0/pWsafile->getFps());
     return 170;
 }
@@ -0,0 +1,487 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <DedicatedHost.h>
+
+#include <globals.h>
+
+#include <CommandManager.h>
+#include <GameInitSettings.h>
+#include <Definitions.h>
+#include <ReplayFile.h>
+#include <ReplayVerifier.h>
+#include <sand.h>
+
+#include <FileClasses/INIFile.h>
+
+#include <Network/NetworkManager.h>
+
+#include <players/PlayerFactory.h>
+
+#include <misc/OFileStream.h>
+#include <misc/FileSystem.h>
+#include <misc/string_util.h>
+#include <misc/format.h>
+#include <misc/fnkdat.h>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace {
+
+/// the state of one house in the lobby like the drop down boxes of CustomGamePlayers show it
+struct LobbyHouse {
+    int houseID = HOUSE_INVALID;    ///< the selected house or HOUSE_INVALID for a random house
+    int team = 0;                   ///< the selected team starting with 1
+    int player = PLAYER_OPEN;       ///< PLAYER_HUMAN, PLAYER_OPEN, PLAYER_CLOSED or the index of an AI player in PlayerFactory
+    std::string playerName;         ///< the name of the human player
+};
+
+/**
+    The lobby and the recording of the games of runDedicatedHost(). Only one player per house is supported.
+*/
+class DedicatedHost {
+public:
+    DedicatedHost(const std::string& mapFilename, bool bLANServer);
+
+    /**
+        Runs one lobby and the following game.
+        \param  bValidate   simulate the replay of the game afterwards and check it for desyncs
+        \return true if the game was played (and was in sync if validated), false otherwise
+    */
+    bool hostGame(bool bValidate);
+
+private:
+    void extractMapInfo(INIFile& inimap);
+    void resetLobby();
+
+    bool isReadyToStart() const;
+    int getNumPlayers() const;
+
+    ChangeEventList getChangeEventList() const;
+    ChangeEventList getChangeEventListForNewPlayer(const std::string& newPlayerName);
+    void onReceiveChangeEventList(const ChangeEventList& changeEventList);
+    void onPeerDisconnected(const std::string& playername, bool bHost, int cause);
+    void onReceiveCommandList(const std::string& playername, const CommandList& commandList);
+
+    void setPlayer2Slot(const std::string& playername, int slot);
+    void addAllPlayersToGameInitSettings();
+
+    /**
+        Saves the recorded commands as a replay.
+        \return the filename of the replay or an empty string if it cannot be saved
+    */
+    std::string saveReplay() const;
+
+    std::string mapFilename;
+    std::string mapFiledata;
+    bool bLANServer;
+
+    int numHouses = 0;                                  ///< the number of houses on the map
+    std::array<int, NUM_HOUSES> initialHouseID;         ///< the houses bound on the map or HOUSE_INVALID
+    std::array<int, NUM_HOUSES> initialTeam;            ///< the teams as named by the brains on the map
+
+    std::array<LobbyHouse, NUM_HOUSES> houses;          ///< the current lobby
+    GameInitSettings gameInitSettings;                  ///< the settings sent to the players (a new random seed for every game)
+
+    NetworkManager networkManager;
+
+    std::unique_ptr<CommandManager> pCmdManager;                    ///< all commands of the running game
+    std::map<std::string, Uint32> nextExpectedCommandsCycle;        ///< the first game cycle not yet received from each human player
+    Uint32 numGameCycles = 0;                                       ///< the last game cycle any command was received for + 1
+};
+
+DedicatedHost::DedicatedHost(const std::string& mapFilename, bool bLANServer)
+ : mapFilename(mapFilename), mapFiledata(readCompleteFile(mapFilename)), bLANServer(bLANServer),
+   networkManager(settings.network.serverPort, settings.network.metaServer) {
+
+    INIFile inimap(mapFilename);
+    extractMapInfo(inimap);
+
+    if(numHouses < 2) {
+        THROW(std::invalid_argument, "DedicatedHost: The map '%s' has less than 2 houses!", mapFilename);
+    }
+}
+
+void DedicatedHost::extractMapInfo(INIFile& inimap) {
+    // the same as CustomGamePlayers::extractMapInfo(), so new players see the same lobby as the players already in it
+    std::vector<HOUSETYPE> boundHousesOnMap;
+    for(int h = 0; h < NUM_HOUSES; h++) {
+        if(inimap.hasSection(getHouseNameByNumber((HOUSETYPE) h))) {
+            boundHousesOnMap.push_back((HOUSETYPE) h);
+        }
+    }
+
+    initialHouseID.fill(HOUSE_INVALID);
+    std::copy(boundHousesOnMap.begin(), boundHousesOnMap.end(), initialHouseID.begin());
+
+    numHouses = boundHousesOnMap.size();
+    for(int p = 0; p < NUM_HOUSES; p++) {
+        if(inimap.hasSection("Player" + std::to_string(p+1))) {
+            numHouses++;
+        }
+    }
+
+    int currentIndex = 0;
+    int currentTeam = 0;
+    std::vector<std::string> teamNames;
+    auto addTeam = [&](const std::string& teamName) {
+        auto iter = std::find(teamNames.begin(), teamNames.end(), teamName);
+        if(iter == teamNames.end()) {
+            initialTeam[currentIndex] = ++currentTeam;
+        } else {
+            initialTeam[currentIndex] = initialTeam[iter - teamNames.begin()];
+        }
+        teamNames.push_back(teamName);
+        currentIndex++;
+    };
+
+    for(HOUSETYPE houseType : boundHousesOnMap) {
+        addTeam(strToUpper(inimap.getStringValue(getHouseNameByNumber(houseType), "Brain", "Team " + std::to_string(currentIndex+1))));
+    }
+
+    for(int p = 0; (p < NUM_HOUSES) && (currentIndex < NUM_HOUSES); p++) {
+        const std::string sectionName = "Player" + std::to_string(p+1);
+        if(inimap.hasSection(sectionName)) {
+            addTeam(strToUpper(inimap.getStringValue(sectionName, "Brain", "Team " + std::to_string(currentIndex+p+1))));
+        }
+    }
+
+    for(; currentIndex < NUM_HOUSES; currentIndex++) {
+        initialTeam[currentIndex] = 0;
+    }
+}
+
+void DedicatedHost::resetLobby() {
+    for(int i = 0; i < NUM_HOUSES; i++) {
+        houses[i] = LobbyHouse();
+        houses[i].houseID = initialHouseID[i];
+        houses[i].team = initialTeam[i];
+    }
+
+    const std::string serverName = settings.general.playerName + " - " + getBasename(mapFilename, true);
+    gameInitSettings = GameInitSettings(getBasename(mapFilename, true), mapFiledata, serverName, false, settings.gameOptions);
+}
+
+bool DedicatedHost::isReadyToStart() const {
+    // like CustomGamePlayers::onNext() but the game is only started when all slots are taken
+    int numUsedHouses = 0;
+    int numHumanPlayers = 0;
+    std::vector<int> teams;
+    for(int i = 0; i < numHouses; i++) {
+        const LobbyHouse& house = houses[i];
+
+        if(house.player == PLAYER_OPEN) {
+            return false;
+        } else if(house.player != PLAYER_CLOSED) {
+            numUsedHouses++;
+            if(house.player == PLAYER_HUMAN) {
+                numHumanPlayers++;
+            }
+            if(std::find(teams.begin(), teams.end(), house.team) == teams.end()) {
+                teams.push_back(house.team);
+            }
+        }
+    }
+
+    return (numHumanPlayers > 0) && (numUsedHouses >= 2) && (teams.size() >= 2);
+}
+
+int DedicatedHost::getNumPlayers() const {
+    return std::count_if(houses.begin(), houses.begin() + numHouses, [](const LobbyHouse& house) { return house.player != PLAYER_OPEN; });
+}
+
+ChangeEventList DedicatedHost::getChangeEventList() const {
+    ChangeEventList changeEventList;
+
+    for(int i = 0; i < numHouses; i++) {
+        const LobbyHouse& house = houses[i];
+
+        changeEventList.changeEventList.emplace_back(ChangeEventList::ChangeEvent::EventType::ChangeHouse, i, house.houseID);
+        changeEventList.changeEventList.emplace_back(ChangeEventList::ChangeEvent::EventType::ChangeTeam, i, house.team);
+
+        if(house.player == PLAYER_HUMAN) {
+            changeEventList.changeEventList.emplace_back(2*i, house.playerName);
+        } else {
+            changeEventList.changeEventList.emplace_back(ChangeEventList::ChangeEvent::EventType::ChangePlayer, 2*i, house.player);
+        }
+    }
+
+    return changeEventList;
+}
+
+ChangeEventList DedicatedHost::getChangeEventListForNewPlayer(const std::string& newPlayerName) {
+    ChangeEventList changeEventList = getChangeEventList();
+
+    // an open slot or as a fallback any non-human slot
+    auto iter = std::find_if(houses.begin(), houses.begin() + numHouses, [](const LobbyHouse& house) { return house.player == PLAYER_OPEN; });
+    if(iter == houses.begin() + numHouses) {
+        iter = std::find_if(houses.begin(), houses.begin() + numHouses, [](const LobbyHouse& house) { return house.player != PLAYER_HUMAN; });
+    }
+
+    if(iter != houses.begin() + numHouses) {
+        const int newPlayerSlot = 2 * (iter - houses.begin());
+        setPlayer2Slot(newPlayerName, newPlayerSlot);
+
+        ChangeEventList::ChangeEvent changeEvent(newPlayerSlot, newPlayerName);
+        changeEventList.changeEventList.push_back(changeEvent);
+
+        // the other peers only need the new player
+        ChangeEventList changeEventList2;
+        changeEventList2.changeEventList.push_back(changeEvent);
+        networkManager.sendChangeEventList(changeEventList2);
+    }
+
+    SDL_Log("'%s' joined the lobby (%d of %d slots taken)", newPlayerName.c_str(), getNumPlayers(), numHouses);
+    networkManager.updateServer(getNumPlayers());
+
+    return changeEventList;
+}
+
+void DedicatedHost::onReceiveChangeEventList(const ChangeEventList& changeEventList) {
+    // the events come from the players, so everything is checked like the drop down boxes of CustomGamePlayers would do
+    for(const ChangeEventList::ChangeEvent& changeEvent : changeEventList.changeEventList) {
+        const int value = (int) changeEvent.newValue;
+
+        switch(changeEvent.eventType) {
+            case ChangeEventList::ChangeEvent::EventType::ChangeHouse: {
+                if(changeEvent.slot >= (Uint32) numHouses) {
+                    break;
+                }
+
+                const bool bHouseTaken = std::any_of(houses.begin(), houses.begin() + numHouses, [value](const LobbyHouse& house) { return house.houseID == value; });
+                if((value == HOUSE_INVALID) || ((value >= 0) && (value < NUM_HOUSES) && !bHouseTaken)) {
+                    houses[changeEvent.slot].houseID = value;
+                }
+            } break;
+
+            case ChangeEventList::ChangeEvent::EventType::ChangeTeam: {
+                if((changeEvent.slot < (Uint32) numHouses) && (value >= 1) && (value <= numHouses)) {
+                    houses[changeEvent.slot].team = value;
+                }
+            } break;
+
+            case ChangeEventList::ChangeEvent::EventType::ChangePlayer: {
+                if((changeEvent.slot % 2 != 0) || (changeEvent.slot/2 >= (Uint32) numHouses)) {
+                    break;
+                }
+
+                LobbyHouse& house = houses[changeEvent.slot/2];
+                if((house.player != PLAYER_HUMAN) && ((value == PLAYER_OPEN) || (value == PLAYER_CLOSED) || ((value > 0) && (value < (int) PlayerFactory::getList().size())))) {
+                    house.player = value;
+                }
+            } break;
+
+            case ChangeEventList::ChangeEvent::EventType::SetHumanPlayer: {
+                if((changeEvent.slot % 2 == 0) && (changeEvent.slot/2 < (Uint32) numHouses) && (houses[changeEvent.slot/2].player != PLAYER_CLOSED)) {
+                    setPlayer2Slot(changeEvent.newStringValue, changeEvent.slot);
+                }
+            } break;
+
+            default: {
+            } break;
+        }
+    }
+
+    networkManager.sendChangeEventList(getChangeEventList());
+    networkManager.updateServer(getNumPlayers());
+}
+
+void DedicatedHost::onPeerDisconnected(const std::string& playername, bool bHost, int cause) {
+    for(int i = 0; i < numHouses; i++) {
+        if((houses[i].player == PLAYER_HUMAN) && (houses[i].playerName == playername)) {
+            houses[i].player = PLAYER_OPEN;
+            houses[i].playerName.clear();
+        }
+    }
+
+    SDL_Log("'%s' left the lobby (%d of %d slots taken)", playername.c_str(), getNumPlayers(), numHouses);
+    networkManager.updateServer(getNumPlayers());
+}
+
+void DedicatedHost::onReceiveCommandList(const std::string& playername, const CommandList& commandList) {
+    // every command list repeats the commands of the last game cycles; only the new ones are recorded (see CommandManager::addCommandList())
+    auto iter = nextExpectedCommandsCycle.find(playername);
+    if(iter == nextExpectedCommandsCycle.end()) {
+        return;
+    }
+
+    for(const CommandList::CommandListEntry& commandListEntry : commandList.commandList) {
+        if(commandListEntry.cycle < iter->second) {
+            continue;
+        }
+
+        for(const Command& command : commandListEntry.commands) {
+            pCmdManager->addCommand(command, commandListEntry.cycle);
+        }
+
+        iter->second = commandListEntry.cycle + 1;
+        numGameCycles = std::max(numGameCycles, iter->second);
+    }
+}
+
+void DedicatedHost::setPlayer2Slot(const std::string& playername, int slot) {
+    LobbyHouse& newHouse = houses[slot/2];
+
+    // the player swaps the slot with the player there (see CustomGamePlayers::setPlayer2Slot())
+    for(int i = 0; i < numHouses; i++) {
+        LobbyHouse& oldHouse = houses[i];
+        if((oldHouse.player == PLAYER_HUMAN) && (oldHouse.playerName == playername)) {
+            oldHouse.player = newHouse.player;
+            oldHouse.playerName = newHouse.playerName;
+            break;
+        }
+    }
+
+    newHouse.player = PLAYER_HUMAN;
+    newHouse.playerName = playername;
+}
+
+void DedicatedHost::addAllPlayersToGameInitSettings() {
+    // the same as CustomGamePlayers::addAllPlayersToGameInitSettings() on every player's computer
+    gameInitSettings.clearHouseInfo();
+    nextExpectedCommandsCycle.clear();
+
+    for(int i = 0; i < numHouses; i++) {
+        const LobbyHouse& house = houses[i];
+
+        GameInitSettings::HouseInfo newHouseInfo((HOUSETYPE) house.houseID, house.team);
+
+        if(house.player == PLAYER_HUMAN) {
+            newHouseInfo.addPlayerInfo(GameInitSettings::PlayerInfo(house.playerName, HUMANPLAYERCLASS));
+            nextExpectedCommandsCycle[house.playerName] = 0;
+        } else if((house.player != PLAYER_OPEN) && (house.player != PLAYER_CLOSED)) {
+            const PlayerFactory::PlayerData* pPlayerData = PlayerFactory::getByIndex(house.player);
+            if(pPlayerData == nullptr) {
+                continue;
+            }
+
+            const std::string playerName = (house.houseID == HOUSE_INVALID) ? pPlayerData->getName() : getHouseNameByNumber((HOUSETYPE) house.houseID);
+            newHouseInfo.addPlayerInfo(GameInitSettings::PlayerInfo(playerName, pPlayerData->getPlayerClass()));
+        } else {
+            continue;
+        }
+
+        gameInitSettings.addHouseInfo(newHouseInfo);
+    }
+}
+
+std::string DedicatedHost::saveReplay() const {
+    // the replay is watched as the first human player
+    auto iter = std::find_if(houses.begin(), houses.begin() + numHouses, [](const LobbyHouse& house) { return house.player == PLAYER_HUMAN; });
+    const std::string localPlayerName = (iter != houses.begin() + numHouses) ? iter->playerName : "";
+
+    char tmp[FILENAME_MAX];
+    fnkdat(fmt::sprintf("replay/Dedicated - %s - %08X.rpl", getBasename(mapFilename, true), gameInitSettings.getRandomSeed()).c_str(),
+           tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+
+    OFileStream replayStream;
+    if(!replayStream.open(tmp)) {
+        SDL_Log("DedicatedHost: Cannot save the replay to '%s'!", tmp);
+        return "";
+    }
+
+    ReplayFile::save(replayStream, localPlayerName, numGameCycles, gameInitSettings, *pCmdManager);
+
+    return std::string(tmp);
+}
+
+bool DedicatedHost::hostGame(bool bValidate) {
+    resetLobby();
+
+    networkManager.setOnPeerDisconnected(std::bind(&DedicatedHost::onPeerDisconnected, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+    networkManager.setOnReceiveChangeEventList(std::bind(&DedicatedHost::onReceiveChangeEventList, this, std::placeholders::_1));
+    networkManager.setGetChangeEventListForNewPlayerCallback(std::bind(&DedicatedHost::getChangeEventListForNewPlayer, this, std::placeholders::_1));
+
+    SDL_Log("Hosting '%s' on port %d...", gameInitSettings.getServername().c_str(), settings.network.serverPort);
+    networkManager.startServer(bLANServer, gameInitSettings.getServername(), settings.general.playerName, &gameInitSettings, 0, numHouses);
+
+    Uint32 startGameTime = 0;
+    while((startGameTime == 0) || (SDL_GetTicks() < startGameTime)) {
+        networkManager.update();
+
+        if((startGameTime == 0) && isReadyToStart()) {
+            SDL_Log("All slots are taken, starting the game...");
+            networkManager.sendStartGame(DEDICATEDHOST_STARTGAME_DELAY);
+            startGameTime = SDL_GetTicks() + DEDICATEDHOST_STARTGAME_DELAY;
+        }
+
+        networkManager.flush();
+        networkManager.waitForReceivedEvents(DEDICATEDHOST_WAIT_TIMEOUT);
+    }
+
+    networkManager.setOnPeerDisconnected(std::function<void (const std::string&, bool, int)>());
+    networkManager.setOnReceiveChangeEventList(std::function<void (const ChangeEventList&)>());
+    networkManager.setGetChangeEventListForNewPlayerCallback(std::function<ChangeEventList (const std::string&)>());
+    networkManager.stopServer();
+
+    // the players start the game now; we stay connected to all of them and record their command lists until the last one leaves
+    addAllPlayersToGameInitSettings();
+    pCmdManager = std::make_unique<CommandManager>();
+    numGameCycles = 0;
+
+    networkManager.setOnReceiveCommandList(std::bind(&DedicatedHost::onReceiveCommandList, this, std::placeholders::_1, std::placeholders::_2));
+
+    const Uint32 gameStartTime = SDL_GetTicks();
+    while(!networkManager.getConnectedPeers().empty()) {
+        networkManager.update();
+        networkManager.waitForReceivedEvents(DEDICATEDHOST_WAIT_TIMEOUT);
+    }
+
+    networkManager.setOnReceiveCommandList(std::function<void (const std::string&, const CommandList&)>());
+
+    SDL_Log("The game ended after %u s and %u game cycles", (SDL_GetTicks() - gameStartTime) / 1000, numGameCycles);
+
+    const std::string replayFilename = (numGameCycles > 0) ? saveReplay() : "";
+    pCmdManager.reset();
+
+    if(replayFilename.empty()) {
+        return false;
+    }
+
+    if(!bValidate) {
+        return true;
+    }
+
+    const ReplayResult replayResult = simulateReplay(replayFilename);
+
+    fprintf(stdout, "Game '%s': %s after %u game cycles, %u desyncs (first at game cycle %s), checksum %s\n",
+                    getBasename(replayFilename).c_str(), replayResult.result.c_str(), replayResult.gameCycles, replayResult.numDesyncs,
+                    (replayResult.firstDesyncGameCycle == INVALID_GAMECYCLE) ? "-" : std::to_string(replayResult.firstDesyncGameCycle).c_str(),
+                    replayResult.checksum.c_str());
+    fflush(stdout);
+
+    return (replayResult.result != "error") && (replayResult.numDesyncs == 0);
+}
+
+}
+
+bool runDedicatedHost(const std::string& mapFilename, bool bLANServer, bool bValidate, int numGames) {
+    DedicatedHost dedicatedHost(mapFilename, bLANServer);
+
+    bool bAllPlayed = true;
+    for(int i = 0; (numGames == 0) || (i < numGames); i++) {
+        bAllPlayed &= dedicatedHost.hostGame(bValidate);
+    }
+
+    return bAllPlayed;
+}
@@ -0,0 +1,318 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <DeterminismCheck.h>
+
+#include <globals.h>
+
+#include <Game.h>
+#include <Definitions.h>
+#include <ReplayKeyframes.h>
+
+#include <misc/FileSystem.h>
+#include <misc/WorkerPool.h>
+#include <misc/string_util.h>
+#include <misc/format.h>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdio.h>
+
+namespace {
+
+/**
+    Simulates a replay in headless mode and records its state hashes. The simulation ends with the replay or at lastGameCycle.
+    \param  snapshotFilename    the hashed state at the end of the simulation is written to this file (empty = no snapshot)
+    \param  ppKeyframes         if not nullptr the keyframes recorded during the simulation are returned here
+    \param  pReplayPlayerName   if not nullptr the name of the local player when the replay was created is returned here
+    \return true on success, false if the replay cannot be simulated
+*/
+bool simulateStateHashTrace(const std::string& replayFilename, Uint32 interval, Uint32 firstGameCycle, Uint32 lastGameCycle,
+                            int numWorkerThreads, StateHashTrace& trace, const std::string& snapshotFilename = "",
+                            std::shared_ptr<ReplayKeyframes>* ppKeyframes = nullptr, std::string* pReplayPlayerName = nullptr) {
+    bool bSimulated = false;
+
+    try {
+        currentGame = new Game();
+        currentGame->initReplay(replayFilename);
+        currentGame->setHeadless((lastGameCycle == INVALID_GAMECYCLE) ? 0 : lastGameCycle, ppKeyframes != nullptr);
+        currentGame->setNumWorkerThreads((numWorkerThreads < 0) ? WorkerPool::getDefaultNumThreads() : numWorkerThreads);
+        currentGame->setStateHashTrace(interval, firstGameCycle, lastGameCycle);
+        currentGame->runMainLoop();
+
+        trace = currentGame->getStateHashTrace();
+        if(ppKeyframes != nullptr) {
+            *ppKeyframes = currentGame->getReplayKeyframes();
+        }
+        if(pReplayPlayerName != nullptr) {
+            *pReplayPlayerName = currentGame->getLocalPlayerName();
+        }
+        bSimulated = snapshotFilename.empty() || writeStateSnapshot(snapshotFilename);
+    } catch(std::exception& e) {
+        SDL_Log("Simulating replay '%s' failed: %s", replayFilename.c_str(), e.what());
+    }
+
+    delete currentGame;
+    currentGame = nullptr;
+
+    return bSimulated;
+}
+
+/**
+    Continues a replay from one of the keyframes recorded by simulateStateHashTrace() in headless mode and records its
+    state hashes after the keyframe. The simulation ends with the replay or at lastGameCycle.
+    \param  pKeyframes          the keyframes of the replay
+    \param  keyframeCycle       the game cycle of the keyframe to continue from
+    \param  replayPlayerName    the name of the local player when the replay was created
+    \param  snapshotFilename    the hashed state at the end of the simulation is written to this file (empty = no snapshot)
+    \return true on success, false if the keyframe cannot be loaded or simulated
+*/
+bool simulateStateHashTraceFromKeyframe(const std::shared_ptr<ReplayKeyframes>& pKeyframes, Uint32 keyframeCycle, const std::string& replayPlayerName,
+                                        Uint32 interval, Uint32 lastGameCycle, int numWorkerThreads, StateHashTrace& trace,
+                                        const std::string& snapshotFilename = "") {
+    bool bSimulated = false;
+
+    try {
+        currentGame = new Game();
+        currentGame->initReplayFromKeyframe(pKeyframes, keyframeCycle, replayPlayerName);
+        currentGame->setHeadless((lastGameCycle == INVALID_GAMECYCLE) ? 0 : lastGameCycle);
+        currentGame->setNumWorkerThreads((numWorkerThreads < 0) ? WorkerPool::getDefaultNumThreads() : numWorkerThreads);
+        currentGame->setStateHashTrace(interval, keyframeCycle + 1, lastGameCycle);
+        currentGame->runMainLoop();
+
+        trace = currentGame->getStateHashTrace();
+        bSimulated = snapshotFilename.empty() || writeStateSnapshot(snapshotFilename);
+    } catch(std::exception& e) {
+        SDL_Log("Continuing replay from keyframe at game cycle %u failed: %s", keyframeCycle, e.what());
+    }
+
+    delete currentGame;
+    currentGame = nullptr;
+
+    return bSimulated;
+}
+
+/// Returns the index of the first entry that differs or std::string::npos if both traces are identical
+size_t findFirstDivergence(const StateHashTrace& traceA, const StateHashTrace& traceB) {
+    for(size_t i = 0; i < std::min(traceA.size(), traceB.size()); i++) {
+        if((traceA[i].first != traceB[i].first) || (traceA[i].second != traceB[i].second)) {
+            return i;
+        }
+    }
+
+    return (traceA.size() == traceB.size()) ? std::string::npos : std::min(traceA.size(), traceB.size());
+}
+
+/// Returns the game cycle of the entry at index in the trace that has one
+Uint32 getGameCycle(const StateHashTrace& traceA, const StateHashTrace& traceB, size_t index) {
+    return (index < traceA.size()) ? traceA[index].first : traceB[index].first;
+}
+
+/// Returns the game cycle preceding the entry at index that is known to be identical in both traces
+Uint32 getLastMatchingGameCycle(const StateHashTrace& traceA, size_t index) {
+    return (index == 0) ? 0 : traceA[index - 1].first;
+}
+
+/// Describes how the traces differ at index
+std::string describeDivergence(const StateHashTrace& traceA, const StateHashTrace& traceB, size_t index) {
+    if((index >= traceA.size()) || (index >= traceB.size())) {
+        return "one simulation ended earlier";
+    } else if(traceA[index].first != traceB[index].first) {
+        return fmt::sprintf("recorded at game cycle %u and %u", traceA[index].first, traceB[index].first);
+    } else {
+        return traceA[index].second.getMismatchingSubsystems(traceB[index].second) + " differ";
+    }
+}
+
+bool writeStateHashTrace(const std::string& filename, const StateHashTrace& trace) {
+    FILE* file = fopen(filename.c_str(), "w");
+    if(file == nullptr) {
+        SDL_Log("Cannot write state hash trace '%s'!", filename.c_str());
+        return false;
+    }
+
+    fprintf(file, "gamecycle,units,structures,houses,spice\n");
+    for(const auto& entry : trace) {
+        fprintf(file, "%u,%08X,%08X,%08X,%08X\n", entry.first, entry.second.units, entry.second.structures, entry.second.houses, entry.second.spice);
+    }
+
+    fclose(file);
+    return true;
+}
+
+StateHashTrace readStateHashTrace(const std::string& filename) {
+    if(!existsFile(filename)) {
+        THROW(std::runtime_error, "Cannot open state hash trace '%s'!", filename);
+    }
+
+    StateHashTrace trace;
+    for(const std::string& line : splitStringToStringVector(readCompleteFile(filename), "\n")) {
+        Uint32 gameCycle;
+        StateHashes stateHashes;
+        if(sscanf(line.c_str(), "%u,%x,%x,%x,%x", &gameCycle, &stateHashes.units, &stateHashes.structures, &stateHashes.houses, &stateHashes.spice) == 5) {
+            trace.emplace_back(gameCycle, stateHashes);
+        }
+    }
+
+    return trace;
+}
+
+}
+
+bool recordStateHashTrace(const std::string& replayFilename, const std::string& traceFilename, Uint32 interval,
+                          Uint32 firstGameCycle, Uint32 lastGameCycle, int numWorkerThreads) {
+    SDL_Log("Recording the state hashes of replay '%s' every %u game cycles...", replayFilename.c_str(), interval);
+
+    StateHashTrace trace;
+    const std::string snapshotFilename = (lastGameCycle == INVALID_GAMECYCLE) ? "" : (traceFilename + ".snapshot");
+    if(!simulateStateHashTrace(replayFilename, interval, firstGameCycle, lastGameCycle, numWorkerThreads, trace, snapshotFilename)) {
+        return false;
+    }
+
+    return writeStateHashTrace(traceFilename, trace);
+}
+
+bool compareStateHashTraces(const std::string& traceFilenameA, const std::string& traceFilenameB) {
+    const StateHashTrace traceA = readStateHashTrace(traceFilenameA);
+    const StateHashTrace traceB = readStateHashTrace(traceFilenameB);
+
+    const size_t index = findFirstDivergence(traceA, traceB);
+    if(index == std::string::npos) {
+        fprintf(stdout, "# identical (%u game cycles compared)\n", (unsigned int) traceA.size());
+        fflush(stdout);
+        return true;
+    }
+
+    const Uint32 lastMatchingGameCycle = getLastMatchingGameCycle(traceA, index);
+    const Uint32 gameCycle = getGameCycle(traceA, traceB, index);
+    fprintf(stdout, "# first divergence between game cycle %u and %u: %s\n", lastMatchingGameCycle, gameCycle, describeDivergence(traceA, traceB, index).c_str());
+    if(gameCycle - lastMatchingGameCycle > 1) {
+        fprintf(stdout, "# record both again with --TraceInterval=1 --TraceRange=%u-%u to find the first diverging game cycle\n", lastMatchingGameCycle + 1, gameCycle);
+    }
+    fflush(stdout);
+
+    return false;
+}
+
+bool checkDeterminism(const std::string& replayFilename, Uint32 interval, int numWorkerThreadsA, int numWorkerThreadsB) {
+    if(numWorkerThreadsB < 0) {
+        numWorkerThreadsB = WorkerPool::getDefaultNumThreads();
+    }
+
+    SDL_Log("Checking replay '%s' with %d and %d worker threads every %u game cycles...", replayFilename.c_str(), numWorkerThreadsA, numWorkerThreadsB, interval);
+
+    StateHashTrace traceA;
+    StateHashTrace traceB;
+    if(!simulateStateHashTrace(replayFilename, interval, 0, INVALID_GAMECYCLE, numWorkerThreadsA, traceA)
+        || !simulateStateHashTrace(replayFilename, interval, 0, INVALID_GAMECYCLE, numWorkerThreadsB, traceB)) {
+        fprintf(stdout, "# %s: cannot be simulated\n", replayFilename.c_str());
+        fflush(stdout);
+        return false;
+    }
+
+    size_t index = findFirstDivergence(traceA, traceB);
+    if(index == std::string::npos) {
+        fprintf(stdout, "# %s: identical (%u game cycles compared)\n", replayFilename.c_str(), (unsigned int) traceA.size());
+        fflush(stdout);
+        return true;
+    }
+
+    // simulate the window in which the runs diverge again and compare every game cycle
+    const Uint32 lastMatchingGameCycle = getLastMatchingGameCycle(traceA, index);
+    const Uint32 windowEnd = getGameCycle(traceA, traceB, index);
+    if((windowEnd - lastMatchingGameCycle > 1)
+        && simulateStateHashTrace(replayFilename, 1, lastMatchingGameCycle + 1, windowEnd, numWorkerThreadsA, traceA)
+        && simulateStateHashTrace(replayFilename, 1, lastMatchingGameCycle + 1, windowEnd, numWorkerThreadsB, traceB)) {
+        index = findFirstDivergence(traceA, traceB);
+        if(index == std::string::npos) {
+            // the runs themselves are not reproducible, e.g. because of uninitialized memory or timing dependencies
+            fprintf(stdout, "# %s: diverges between game cycle %u and %u, but not when simulated again\n", replayFilename.c_str(), lastMatchingGameCycle, windowEnd);
+            fflush(stdout);
+            return false;
+        }
+    }
+
+    const Uint32 gameCycle = getGameCycle(traceA, traceB, index);
+    fprintf(stdout, "# %s: first divergence at game cycle %u: %s\n", replayFilename.c_str(), gameCycle, describeDivergence(traceA, traceB, index).c_str());
+
+    const std::string snapshotFilenameA = fmt::sprintf("%s.%u.a.txt", replayFilename, gameCycle);
+    const std::string snapshotFilenameB = fmt::sprintf("%s.%u.b.txt", replayFilename, gameCycle);
+    StateHashTrace unused;
+    if(simulateStateHashTrace(replayFilename, 0, 0, gameCycle, numWorkerThreadsA, unused, snapshotFilenameA)
+        && simulateStateHashTrace(replayFilename, 0, 0, gameCycle, numWorkerThreadsB, unused, snapshotFilenameB)) {
+        fprintf(stdout, "# state of both runs written to '%s' and '%s'\n", snapshotFilenameA.c_str(), snapshotFilenameB.c_str());
+    }
+    fflush(stdout);
+
+    return false;
+}
+
+bool checkSaveGameDeterminism(const std::string& replayFilename, Uint32 interval, int numWorkerThreads) {
+    SDL_Log("Checking replay '%s' continued from its keyframes every %u game cycles...", replayFilename.c_str(), interval);
+
+    StateHashTrace traceA;
+    std::shared_ptr<ReplayKeyframes> pKeyframes;
+    std::string replayPlayerName;
+    if(!simulateStateHashTrace(replayFilename, interval, 0, INVALID_GAMECYCLE, numWorkerThreads, traceA, "", &pKeyframes, &replayPlayerName)
+        || (pKeyframes == nullptr)) {
+        fprintf(stdout, "# %s: cannot be simulated\n", replayFilename.c_str());
+        fflush(stdout);
+        return false;
+    }
+
+    // keyframes are recorded at the start and every REPLAY_KEYFRAME_INTERVAL game cycles
+    int numKeyframes = 0;
+    for(Uint32 keyframeCycle = 0; pKeyframes->has(keyframeCycle); keyframeCycle += REPLAY_KEYFRAME_INTERVAL) {
+        StateHashTrace traceB;
+        if(!simulateStateHashTraceFromKeyframe(pKeyframes, keyframeCycle, replayPlayerName, interval, INVALID_GAMECYCLE, numWorkerThreads, traceB)) {
+            fprintf(stdout, "# %s: cannot be continued from the keyframe at game cycle %u\n", replayFilename.c_str(), keyframeCycle);
+            fflush(stdout);
+            return false;
+        }
+
+        // the continued run only records the game cycles after the keyframe
+        StateHashTrace traceAfterKeyframe;
+        std::copy_if(traceA.begin(), traceA.end(), std::back_inserter(traceAfterKeyframe),
+                     [keyframeCycle](const std::pair<Uint32, StateHashes>& entry) { return entry.first > keyframeCycle; });
+
+        const size_t index = findFirstDivergence(traceAfterKeyframe, traceB);
+        if(index != std::string::npos) {
+            const Uint32 gameCycle = getGameCycle(traceAfterKeyframe, traceB, index);
+            fprintf(stdout, "# %s: continued from the keyframe at game cycle %u it diverges first at game cycle %u: %s\n",
+                    replayFilename.c_str(), keyframeCycle, gameCycle, describeDivergence(traceAfterKeyframe, traceB, index).c_str());
+
+            const std::string snapshotFilenameA = fmt::sprintf("%s.%u.a.txt", replayFilename, gameCycle);
+            const std::string snapshotFilenameB = fmt::sprintf("%s.%u.b.txt", replayFilename, gameCycle);
+            StateHashTrace unused;
+            if(simulateStateHashTrace(replayFilename, 0, 0, gameCycle, numWorkerThreads, unused, snapshotFilenameA)
+                && simulateStateHashTraceFromKeyframe(pKeyframes, keyframeCycle, replayPlayerName, 0, gameCycle, numWorkerThreads, unused, snapshotFilenameB)) {
+                fprintf(stdout, "# state of both runs written to '%s' and '%s'\n", snapshotFilenameA.c_str(), snapshotFilenameB.c_str());
+            }
+            fflush(stdout);
+
+            return false;
+        }
+
+        numKeyframes++;
+    }
+
+    fprintf(stdout, "# %s: identical when continued from %d keyframes (%u game cycles compared)\n", replayFilename.c_str(), numKeyframes, (unsigned int) traceA.size());
+    fflush(stdout);
+    return true;
+}
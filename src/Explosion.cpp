@@ -21,16 +21,15 @@
 
 #include <FileClasses/GFXManager.h>
 #include <Game.h>
+#include <Map.h>
 #include <ScreenBorder.h>
 #include <misc/exceptions.h>
 
 #define CYCLES_PER_FRAME    5
 
 Explosion::Explosion()
- : explosionID(NONE_ID), house(HOUSE_HARKONNEN)
+ : explosionID(NONE_ID), house(HOUSE_HARKONNEN), startGameCycle(0)
 {
-    frameTimer = CYCLES_PER_FRAME;
-    currentFrame = 0;
 }
 
 Explosion::Explosion(Uint32 explosionID, const Coord& position, int house)
@@ -38,8 +37,9 @@ Explosion::Explosion(Uint32 explosionID, const Coord& position, int house)
 {
     init();
 
-    frameTimer = CYCLES_PER_FRAME;
-    currentFrame = 0;
+    startGameCycle = currentGame->getGameCycleCount();
+
+    drawBucket = currentGameMap->getExplosionDrawBuckets().add(this, position/TILESIZE);
 }
 
 Explosion::Explosion(InputStream& stream)
@@ -48,13 +48,20 @@ Explosion::Explosion(InputStream& stream)
     position.x = stream.readSint16();
     position.y = stream.readSint16();
     house = stream.readUint32();
-    frameTimer = stream.readSint32();
-    currentFrame = stream.readSint32();
+    int frameTimer = stream.readSint32();
+    int currentFrame = stream.readSint32();
+    startGameCycle = currentGame->getGameCycleCount() - (currentFrame*(CYCLES_PER_FRAME+1) + CYCLES_PER_FRAME - frameTimer);
 
     init();
+
+    drawBucket = currentGameMap->getExplosionDrawBuckets().add(this, position/TILESIZE);
 }
 
-Explosion::~Explosion() = default;
+Explosion::~Explosion() {
+    if(currentGameMap != nullptr) {
+        currentGameMap->getExplosionDrawBuckets().remove(this, drawBucket);
+    }
+}
 
 void Explosion::init()
 {
@@ -131,8 +138,11 @@ void Explosion::save(OutputStream& stream) const
     stream.writeSint16(position.x);
     stream.writeSint16(position.y);
     stream.writeUint32(house);
-    stream.writeSint32(frameTimer);
-    stream.writeSint32(currentFrame);
+
+    // the frame timer and the frame of older versions are written, so the saved games stay the same
+    const Uint32 age = getAge();
+    stream.writeSint32(CYCLES_PER_FRAME - age % (CYCLES_PER_FRAME+1));
+    stream.writeSint32(age / (CYCLES_PER_FRAME+1));
 }
 
 void Explosion::blitToScreen() const
@@ -146,6 +156,7 @@ void Explosion::blitToScreen() const
                                                 screenborder->world2screenY(position.y),
                                                 numFrames, 1,
                                                 HAlign::Center, VAlign::Center);
+        const int currentFrame = std::min(numFrames - 1, (int) (getAge() / (CYCLES_PER_FRAME+1)));
         SDL_Rect source = calcSpriteSourceRect(graphic[currentZoomlevel], currentFrame, numFrames);
         SDL_RenderCopy(renderer, graphic[currentZoomlevel], &source, &dest);
     }
@@ -153,16 +164,14 @@ void Explosion::blitToScreen() const
 
 void Explosion::update()
 {
-    frameTimer--;
-
-    if(frameTimer < 0) {
-        frameTimer = CYCLES_PER_FRAME;
-        currentFrame++;
-
-        if(currentFrame >= numFrames) {
-            //this explosion is finished
-            currentGame->getExplosionList().remove(this);
-            delete this;
-        }
+    // the age after this game cycle
+    if(getAge() + 1 >= (Uint32) (numFrames*(CYCLES_PER_FRAME+1))) {
+        //this explosion is finished
+        currentGame->getExplosionList().destroy(this);
     }
 }
+
+Uint32 Explosion::getAge() const
+{
+    return currentGame->getGameCycleCount() - startGameCycle;
+}
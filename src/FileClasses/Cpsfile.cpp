@@ -18,6 +18,7 @@
 #include <FileClasses/Cpsfile.h>
 #include <FileClasses/Decode.h>
 #include <FileClasses/Palette.h>
+#include <FileClasses/Pakfile.h>
 
 #include <misc/exceptions.h>
 
@@ -44,34 +45,45 @@ sdl2::surface_ptr LoadCPS_RW(SDL_RWops* RWop)
     }
 
     size_t cpsFilesize = static_cast<size_t>(endOffset);
-    auto pFiledata = std::make_unique<uint8_t[]>(cpsFilesize);
 
-    if(SDL_RWread(RWop, pFiledata.get(), cpsFilesize, 1) != 1) {
-        THROW(std::runtime_error, "LoadCPS_RW(): Reading this *.cps-File failed!");
+    // files inside a memory-mapped pak file are decoded in place
+    std::unique_ptr<uint8_t[]> pOwnedFiledata;
+    size_t mappedSize = 0;
+    const uint8_t* pFiledata = Pakfile::getMappedData(RWop, &mappedSize);
+    if((pFiledata == nullptr) || (mappedSize != cpsFilesize)) {
+        pOwnedFiledata = std::make_unique<uint8_t[]>(cpsFilesize);
+
+        if(SDL_RWread(RWop, pOwnedFiledata.get(), cpsFilesize, 1) != 1) {
+            THROW(std::runtime_error, "LoadCPS_RW(): Reading this *.cps-File failed!");
+        }
+
+        pFiledata = pOwnedFiledata.get();
     }
 
-    uint16_t format = SDL_SwapLE16(*reinterpret_cast<uint16_t*>(pFiledata.get()+ 2));
+    uint16_t format = SDL_SwapLE16(*reinterpret_cast<const uint16_t*>(pFiledata+ 2));
 
     if(format != 0x0004) {
         THROW(std::runtime_error, "LoadCPS_RW(): Only Format80 encoded *.cps-Files are supported!");
     }
 
-    unsigned int SizeXTimeSizeY = SDL_SwapLE16(*reinterpret_cast<uint16_t*>(pFiledata.get() + 4));
-    SizeXTimeSizeY += SDL_SwapLE16(*(reinterpret_cast<uint16_t*>(pFiledata.get()+ 6)));
+    unsigned int SizeXTimeSizeY = SDL_SwapLE16(*reinterpret_cast<const uint16_t*>(pFiledata + 4));
+    SizeXTimeSizeY += SDL_SwapLE16(*(reinterpret_cast<const uint16_t*>(pFiledata+ 6)));
 
     if(SizeXTimeSizeY != SIZE_X * SIZE_Y) {
         THROW(std::runtime_error, "LoadCPS_RW(): Images must be 320x200 pixels big!");
     }
 
-    uint16_t PaletteSize = SDL_SwapLE16(*(reinterpret_cast<uint16_t*>(pFiledata.get()+ 8)));
+    uint16_t PaletteSize = SDL_SwapLE16(*(reinterpret_cast<const uint16_t*>(pFiledata+ 8)));
 
     auto pImageOut = std::make_unique<uint8_t[]>(SIZE_X*SIZE_Y);
     memset(pImageOut.get(), 0, SIZE_X*SIZE_Y);
 
-    if(decode80(pFiledata.get() + 10 + PaletteSize, pImageOut.get(), 0) == -2) {
+    if(cpsFilesize < 10u + PaletteSize) {
         THROW(std::runtime_error, "LoadCPS_RW(): Decoding this *.cps-File failed!");
     }
 
+    decode80(pFiledata + 10 + PaletteSize, cpsFilesize - 10 - PaletteSize, pImageOut.get(), SIZE_X*SIZE_Y, 0);
+
     // create new picture surface
     auto pic = sdl2::surface_ptr{ SDL_CreateRGBSurface(0, SIZE_X, SIZE_Y, 8, 0, 0, 0, 0) };
     if(pic == nullptr) {
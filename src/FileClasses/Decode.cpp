@@ -18,8 +18,12 @@
 #include <FileClasses/Decode.h>
 
 #include <misc/exceptions.h>
+#include <Definitions.h>
 #include <misc/SDL2pp.h>
 
+#include <algorithm>
+#include <cstring>
+
 
 void memcpy_overlap(unsigned char *dst, const unsigned char *src, unsigned cnt)
 {
@@ -38,7 +42,76 @@ void memcpy_overlap(unsigned char *dst, const unsigned char *src, unsigned cnt)
 }
 
 
-int decode40(const unsigned char *image_in, unsigned char *image_out)
+namespace {
+
+    /// XORs cnt bytes from src into dst, eight bytes at a time where possible
+    inline void xor_bytes(unsigned char * RESTRICT dst, const unsigned char * RESTRICT src, size_t cnt)
+    {
+        for(; cnt >= 8; cnt -= 8, dst += 8, src += 8) {
+            Uint64 d, s;
+            memcpy(&d, dst, 8);
+            memcpy(&s, src, 8);
+            d ^= s;
+            memcpy(dst, &d, 8);
+        }
+        while(cnt--) {
+            *dst++ ^= *src++;
+        }
+    }
+
+    /// XORs value into cnt bytes of dst, eight bytes at a time where possible
+    inline void xor_fill(unsigned char *dst, unsigned char value, size_t cnt)
+    {
+        const Uint64 pattern = value * UINT64_C(0x0101010101010101);
+        for(; cnt >= 8; cnt -= 8, dst += 8) {
+            Uint64 d;
+            memcpy(&d, dst, 8);
+            d ^= pattern;
+            memcpy(dst, &d, 8);
+        }
+        while(cnt--) {
+            *dst++ ^= value;
+        }
+    }
+
+    /**
+        Copies cnt bytes inside out from srcPos to dstPos with the result of a forward byte by byte copy. If the source
+        lies less than cnt bytes before the destination the copied bytes repeat with a period of dstPos - srcPos; this is
+        done by memset for a period of one and otherwise by memcpy of the already repeated part, which doubles every step.
+    */
+    inline void copy_within(unsigned char *out, size_t dstPos, size_t srcPos, size_t cnt)
+    {
+        unsigned char * dst = out + dstPos;
+        const unsigned char * src = out + srcPos;
+
+        if(srcPos >= dstPos) {
+            if(srcPos != dstPos) {
+                // the source is ahead of the destination: a forward copy is the same as memmove
+                memmove(dst, src, cnt);
+            }
+        } else if(dstPos - srcPos >= cnt) {
+            memcpy(dst, src, cnt);
+        } else if(dstPos - srcPos == 1) {
+            memset(dst, *src, cnt);
+        } else {
+            while(cnt > 0) {
+                const size_t chunk = std::min(static_cast<size_t>(dst - src), cnt);
+                memcpy(dst, src, chunk);
+                dst += chunk;
+                cnt -= chunk;
+            }
+        }
+    }
+
+    inline Uint16 read_le16(const unsigned char *p)
+    {
+        return static_cast<Uint16>(p[0] | (p[1] << 8));
+    }
+
+}
+
+
+int decode40(const unsigned char *image_in, size_t inSize, unsigned char *image_out, size_t outSize)
 {
     /*
     0 fill 00000000 c v
@@ -50,86 +123,83 @@ int decode40(const unsigned char *image_in, unsigned char *image_out)
     */
 
     const unsigned char* readp = image_in;
-    unsigned char* writep = image_out;
-    Uint16 code;
-    Uint16 count;
+    const unsigned char* const readEnd = image_in + inSize;
+    size_t writePos = 0;
+
+    // a write of count bytes must stay inside image_out; skips may run past its end as long as nothing is written there
+    auto checkWrite = [&](size_t count) {
+        if((writePos > outSize) || (count > outSize - writePos)) {
+            THROW(std::invalid_argument, "Decode: format40 data writes beyond the end of the output buffer");
+        }
+    };
+    auto checkRead = [&](size_t count) {
+        if(count > static_cast<size_t>(readEnd - readp)) {
+            THROW(std::invalid_argument, "Decode: format40 data ends unexpectedly");
+        }
+    };
+
     while(1) {
-        code = *readp++;
-        if(~code & 0x80) {
-            //bit 7 = 0
-            if(!code) {
-                //command 0 (00000000 c v): fill
-                count = *readp++;
-                code = *readp++;
-                while (count--)
-                    *writep++ ^= code;
-            } else {
-                //command 1 (0ccccccc): copy
-                count = code;
-                while (count--)
-                    *writep++ ^= *readp++;
+        checkRead(1);
+        const unsigned char code = *readp++;
+
+        if(code & 0x80) {
+            size_t count = code & 0x7f;
+            if(count != 0) {
+                //command 5 (1ccccccc): skip
+                writePos += count;
+                continue;
             }
 
-        } else {
-            //bit 7 = 1
-            if(!(count = code & 0x7f)) {
-                count =  SDL_SwapLE16(*((Uint16*)readp));
-                readp += 2;
-                code = count >> 8;
-                if(~code & 0x80) {
-                    //bit 7 = 0
-                    //command 2 (10000000 c 0ccccccc): skip
-                    if(!count) {
-                        // end of image
-                        break;
-                    }
-                    writep += count;
-                } else {
-                    //bit 7 = 1
-                    count &= 0x3fff;
-                    if(~code & 0x40) {
-                        //bit 6 = 0
-                        //command 3 (10000000 c 10cccccc): copy
-                        while(count--) {
-                            *writep++ ^= *readp++;
-                        }
-                    } else {
-                        //bit 6 = 1
-                        //command 4 (10000000 c 11cccccc v): fill
-                        code = *readp++;
-                        while(count--) {
-                            *writep++ ^= code;
-                        }
-                    }
+            checkRead(2);
+            count = read_le16(readp);
+            readp += 2;
+
+            if(~count & 0x8000) {
+                //command 2 (10000000 c 0ccccccc): skip
+                if(!count) {
+                    // end of image
+                    break;
                 }
+                writePos += count;
+            } else if(~count & 0x4000) {
+                //command 3 (10000000 c 10cccccc): copy
+                count &= 0x3fff;
+                checkRead(count);
+                checkWrite(count);
+                xor_bytes(image_out + writePos, readp, count);
+                readp += count;
+                writePos += count;
             } else {
-                //command 5 (1ccccccc): skip
-                writep += count;
+                //command 4 (10000000 c 11cccccc v): fill
+                count &= 0x3fff;
+                checkRead(1);
+                checkWrite(count);
+                xor_fill(image_out + writePos, *readp++, count);
+                writePos += count;
             }
+        } else if(code != 0) {
+            //command 1 (0ccccccc): copy
+            checkRead(code);
+            checkWrite(code);
+            xor_bytes(image_out + writePos, readp, code);
+            readp += code;
+            writePos += code;
+        } else {
+            //command 0 (00000000 c v): fill
+            checkRead(2);
+            const size_t count = readp[0];
+            checkWrite(count);
+            xor_fill(image_out + writePos, readp[1], count);
+            readp += 2;
+            writePos += count;
         }
     }
-    return (writep - image_out);
+
+    return static_cast<int>(writePos);
 }
 
-int decode80(const unsigned char *image_in, unsigned char *image_out, unsigned checksum)
+int decode80(const unsigned char *image_in, size_t inSize, unsigned char *image_out, size_t outSize, unsigned checksum)
 {
-    //
-    // should decode all the format80 stuff ;-)
-    //
-
-    const unsigned char *readp = image_in;
-    unsigned char *writep = image_out;
-
-    unsigned int a = 0;
-    unsigned int b = 0;
-    unsigned int c = 0;
-    unsigned int d = 0;
-    unsigned int e = 0;
-    unsigned int megacounta = 0;
-    unsigned int megacountb = 0;
-    unsigned int megacountc = 0;
-    unsigned int megacountd = 0;
-    unsigned int megacounte = 0;
     /*
        1 10cccccc
        2 0cccpppp p
@@ -138,72 +208,97 @@ int decode80(const unsigned char *image_in, unsigned char *image_out, unsigned c
        5 11111111 c c p p
      */
 
+    const unsigned char *readp = image_in;
+    const unsigned char * const readEnd = image_in + inSize;
+    size_t writePos = 0;
+
+    auto checkRead = [&](size_t count) {
+        if(count > static_cast<size_t>(readEnd - readp)) {
+            THROW(std::invalid_argument, "Decode: format80 data ends unexpectedly");
+        }
+    };
+    auto checkWrite = [&](size_t count) {
+        if(count > outSize - writePos) {
+            THROW(std::invalid_argument, "Decode: format80 data writes beyond the end of the output buffer");
+        }
+    };
+
     while (1) {
-        if ((*readp & 0xc0) == 0x80) {
+        checkRead(1);
+        const unsigned char code = *readp;
+
+        if(code < 0x80) {
             //
-            // 10cccccc (1)
+            // 0cccpppp p (2): copy from relative position
             //
-            unsigned count = readp[0] & 0x3f;
-            //SDL_Log("Cmd 1, count: %d", count);
-            megacounta += count;
+            checkRead(2);
+            const size_t count = ((code & 0x70) >> 4) + 3;
+            const size_t relpos = ((code & 0xf) << 8) | readp[1];
+            readp += 2;
+            if(relpos > writePos) {
+                THROW(std::invalid_argument, "Decode: format80 data references data before the start of the output buffer");
+            }
+            checkWrite(count);
+            copy_within(image_out, writePos, writePos - relpos, count);
+            writePos += count;
+        } else if(code < 0xc0) {
+            //
+            // 10cccccc (1): copy from input
+            //
+            const size_t count = code & 0x3f;
             if (!count) {
                 break;
             }
             readp++;
-            memcpy_overlap(writep, readp, count);
+            checkRead(count);
+            checkWrite(count);
+            memcpy(image_out + writePos, readp, count);
             readp += count;
-            writep += count;
-            a++;
-        } else if ((*readp & 0x80) == 0x00) {
-            //
-            // 0cccpppp p (2)
-            //
-            unsigned count = ((readp[0] & 0x70) >> 4) + 3;
-            unsigned short relpos = (((unsigned short) (readp[0] & 0xf)) << 8) | ((unsigned short) readp[1]);
-            readp += 2;
-            megacountb += count;
-            memcpy_overlap(writep, writep - relpos, count);
-            writep += count;
-            b++;
-        } else if (*readp == 0xff) {
+            writePos += count;
+        } else if(code < 0xfe) {
             //
-            // 11111111 c c p p (5)
+            // 11cccccc p p (3): copy from absolute position
             //
-            unsigned short count = SDL_SwapLE16(*((unsigned short *) (readp + 1)));
-            unsigned short pos = SDL_SwapLE16(*((unsigned short *) (readp + 3)));
-            readp += 5;
-            megacounte += count;
-            memcpy_overlap(writep, image_out + pos, count);
-            writep += count;
-            e++;
-        } else if (*readp == 0xfe) {
+            checkRead(3);
+            const size_t count = (code & 0x3f) + 3;
+            const size_t pos = read_le16(readp + 1);
+            readp += 3;
+            checkWrite(count);
+            if(pos + count > outSize) {
+                THROW(std::invalid_argument, "Decode: format80 data references data beyond the end of the output buffer");
+            }
+            copy_within(image_out, writePos, pos, count);
+            writePos += count;
+        } else if(code == 0xfe) {
             //
-            // 11111110 c c v(4)
+            // 11111110 c c v (4): fill
             //
-            unsigned short count = SDL_SwapLE16(*((unsigned short *) (readp + 1)));
-            unsigned char color = readp[3];
+            checkRead(4);
+            const size_t count = read_le16(readp + 1);
+            const unsigned char color = readp[3];
             readp += 4;
-            memset(writep, color, count);
-            writep += count;
-            megacountd += count;
-            d++;
-        } else if ((*readp & 0xc0) == 0xc0) {
+            checkWrite(count);
+            memset(image_out + writePos, color, count);
+            writePos += count;
+        } else {
             //
-            // 11cccccc p p (3)
+            // 11111111 c c p p (5): long copy from absolute position
             //
-            unsigned short count = (*readp & 0x3f) + 3;
-            unsigned short pos = SDL_SwapLE16(*((unsigned short *) (readp + 1)));
-            readp += 3;
-            megacountc += count;
-            memcpy_overlap(writep, image_out + pos, count);
-            writep += count;
-            c++;
-        } else {
-            THROW(std::invalid_argument, "Decode: File contains unknown format80 command");
-
+            checkRead(5);
+            const size_t count = read_le16(readp + 1);
+            const size_t pos = read_le16(readp + 3);
+            readp += 5;
+            checkWrite(count);
+            if(pos + count > outSize) {
+                THROW(std::invalid_argument, "Decode: format80 data references data beyond the end of the output buffer");
+            }
+            copy_within(image_out, writePos, pos, count);
+            writePos += count;
         }
     }
-    if (megacounta + megacountb + megacountc + megacountd + megacounte != checksum)
+
+    // every command advances the output by its count, so the checksum is the number of written bytes
+    if (writePos != checksum)
         return -1;
 
     return 0;
@@ -20,6 +20,7 @@
 #include <globals.h>
 
 #include <FileClasses/TextManager.h>
+#include <FileClasses/INIFile.h>
 
 #include <misc/FileSystem.h>
 
@@ -38,14 +39,21 @@ FileManager::FileManager() {
 
     const auto search_path = getSearchPath();
 
+    char checksumCacheFilepath[FILENAME_MAX];
+    fnkdat(PAKCHECKSUMCACHE_FILENAME, checksumCacheFilepath, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+    INIFile checksumCache(checksumCacheFilepath);
+    bool bChecksumCacheChanged = false;
+
     for(const auto& filename : getNeededFiles()) {
         for(const auto& sp : search_path) {
             auto filepath = sp + "/";
             filepath += filename;
             if(getCaseInsensitiveFilename(filepath)) {
                 try {
-                    SDL_Log("%s  %s", md5FromFilename(filepath).c_str(), filepath.c_str());
+                    const std::string checksum = cachedMD5FromFilename(checksumCache, filepath, bChecksumCacheChanged);
+                    SDL_Log("%s  %s", checksum.c_str(), filepath.c_str());
                     pakFiles.push_back(std::make_unique<Pakfile>(filepath));
+                    pakFilesChecksum += checksum;
                 } catch (std::exception &e) {
                     pakFiles.clear();
 
@@ -60,6 +68,12 @@ FileManager::FileManager() {
     }
 
     SDL_Log("%s", "");
+
+    if(bChecksumCacheChanged && !checksumCache.saveChangesTo(checksumCacheFilepath)) {
+        SDL_Log("FileManager: Unable to save %s!", checksumCacheFilepath);
+    }
+
+    buildIndex();
 }
 
 FileManager::~FileManager() = default;
@@ -127,24 +141,29 @@ std::vector<std::string> FileManager::getMissingFiles() {
 }
 
 sdl2::RWops_ptr FileManager::openFile(const std::string& filename) {
-    sdl2::RWops_ptr ret;
-
-    // try loading external file
-    for(const auto& searchPath : getSearchPath()) {
-        auto externalFilename = searchPath + "/";
-        externalFilename += filename;
-        if(getCaseInsensitiveFilename(externalFilename)) {
-            ret = sdl2::RWops_ptr{SDL_RWFromFile(externalFilename.c_str(), "rb")};
+    const IndexEntry* pIndexEntry = findFile(filename);
+    if(pIndexEntry != nullptr) {
+        if(pIndexEntry->pPakfile == nullptr) {
+            auto ret = sdl2::RWops_ptr{SDL_RWFromFile(pIndexEntry->externalFilepath.c_str(), "rb")};
             if(ret) {
                 return ret;
             }
+        } else {
+            return pIndexEntry->pPakfile->openFile(pIndexEntry->pakIndex);
         }
     }
 
-    // now try loading from pak file
-    for(const auto& pPakFile : pakFiles) {
-        if(pPakFile->exists(filename)) {
-            return pPakFile->openFile(filename);
+    if(filename.find_first_of("/\\") != std::string::npos) {
+        // files in subdirectories of the search path are not indexed
+        for(const auto& searchPath : getSearchPath()) {
+            auto externalFilename = searchPath + "/";
+            externalFilename += filename;
+            if(getCaseInsensitiveFilename(externalFilename)) {
+                auto ret = sdl2::RWops_ptr{SDL_RWFromFile(externalFilename.c_str(), "rb")};
+                if(ret) {
+                    return ret;
+                }
+            }
         }
     }
 
@@ -152,39 +171,111 @@ sdl2::RWops_ptr FileManager::openFile(const std::string& filename) {
 }
 
 bool FileManager::exists(const std::string& filename) const {
+    if(findFile(filename) != nullptr) {
+        return true;
+    }
+
+    if(filename.find_first_of("/\\") != std::string::npos) {
+        // files in subdirectories of the search path are not indexed
+        for(const std::string& searchPath : getSearchPath()) {
+            auto externalFilename = searchPath + "/";
+            externalFilename += filename;
+            if(getCaseInsensitiveFilename(externalFilename)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+    Builds the index of all files in the search path and in the pak files. External files take precedence over the content of
+    the pak files, earlier search paths and pak files over later ones, as openFile() always did.
+*/
+void FileManager::buildIndex() {
+    fileIndex.clear();
 
-    // try finding external file
-    for(const std::string& searchPath : getSearchPath()) {
-        auto externalFilename = searchPath + "/";
-        externalFilename += filename;
-        if(getCaseInsensitiveFilename(externalFilename)) {
-            return true;
+    for(const auto& searchPath : getSearchPath()) {
+        for(const std::string& filename : getFileNamesList(searchPath, "")) {
+            IndexEntry indexEntry;
+            indexEntry.externalFilepath = searchPath + "/" + filename;
+            indexEntry.pPakfile = nullptr;
+            indexEntry.pakIndex = 0;
+            fileIndex.emplace(strToUpper(filename), std::move(indexEntry));
         }
     }
 
-    // now try finding in one pak file
     for(const auto& pPakFile : pakFiles) {
-        if(pPakFile->exists(filename)) {
-            return true;
+        for(int i = 0; i < pPakFile->getNumFiles(); i++) {
+            IndexEntry indexEntry;
+            indexEntry.pPakfile = pPakFile.get();
+            indexEntry.pakIndex = i;
+            fileIndex.emplace(strToUpper(pPakFile->getFilename(i)), std::move(indexEntry));
         }
     }
+}
 
-    return false;
+/**
+    Looks up filename in the index. The lookup is case insensitive.
+    \param  filename    the file to look for
+    \return the index entry or nullptr if the file is not indexed
+*/
+const FileManager::IndexEntry* FileManager::findFile(const std::string& filename) const {
+    const auto iter = fileIndex.find(strToUpper(filename));
+    return (iter != fileIndex.end()) ? &iter->second : nullptr;
 }
 
 
+static std::string md5ToHex(const unsigned char md5sum[16]) {
+    std::stringstream stream;
+    stream << std::setfill('0') << std::hex;
+    for(int i = 0; i < 16; i++) {
+        stream << std::setw(2) << static_cast<int>(md5sum[i]);
+    }
+    return stream.str();
+}
+
 std::string FileManager::md5FromFilename(const std::string& filename) const {
     unsigned char md5sum[16];
 
     if(md5_file(filename.c_str(), md5sum) != 0) {
         THROW(io_error, "Cannot open or read '%s'!", filename);
     } else {
+        return md5ToHex(md5sum);
+    }
+}
+
+std::string FileManager::cachedMD5FromFilename(INIFile& checksumCache, const std::string& filename, bool& bChecksumCacheChanged) const {
+    const std::string basename = getBasename(filename);
+    const std::list<FileInfo> files = getFileList(getDirname(filename), "");
+    const auto fileInfoIter = std::find_if(files.begin(), files.end(), [&](const FileInfo& fileInfo) { return fileInfo.name == basename; });
+    if(fileInfoIter == files.end()) {
+        return md5FromFilename(filename);
+    }
+
+    // every file has a section named after the md5 checksum of its path
+    unsigned char pathMD5[16];
+    md5(reinterpret_cast<const unsigned char*>(filename.data()), static_cast<int>(filename.size()), pathMD5);
+    const std::string section = md5ToHex(pathMD5);
 
-        std::stringstream stream;
-        stream << std::setfill('0') << std::hex;
-        for(int i : md5sum) {
-            stream << std::setw(2) << i;
+    const std::string fileSize = std::to_string(fileInfoIter->size);
+    const std::string modifyDate = std::to_string(fileInfoIter->modifydate);
+
+    if((checksumCache.getStringValue(section, "File Size") == fileSize)
+        && (checksumCache.getStringValue(section, "Modify Date") == modifyDate)) {
+        const std::string checksum = checksumCache.getStringValue(section, "MD5");
+        if(checksum.length() == 32) {
+            return checksum;
         }
-        return stream.str();
     }
+
+    const std::string checksum = md5FromFilename(filename);
+
+    checksumCache.setStringValue(section, "File Size", fileSize);
+    checksumCache.setStringValue(section, "Modify Date", modifyDate);
+    checksumCache.setStringValue(section, "MD5", checksum);
+    bChecksumCacheChanged = true;
+
+    return checksum;
 }
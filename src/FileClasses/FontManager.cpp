@@ -36,6 +36,10 @@ void FontManager::drawTextOnSurface(SDL_Surface* pSurface, const std::string& te
     return getFont(fontSize)->drawTextOnSurface(pSurface,text,color);
 }
 
+void FontManager::drawText(int x, int y, const std::string& text, Uint32 color, unsigned int fontSize) {
+    getFont(fontSize)->drawText(x, y, text, color);
+}
+
 int FontManager::getTextWidth(const std::string& text, unsigned int fontSize) {
     return getFont(fontSize)->getTextWidth(text);
 }
@@ -111,6 +115,39 @@ sdl2::texture_ptr FontManager::createTextureWithMultilineText(const std::string&
     return convertSurfaceToTexture(createSurfaceWithMultilineText(text, color, fontSize, bCentered));
 }
 
+SDL_Texture* FontManager::getCachedTextureWithText(const std::string& text, Uint32 color, unsigned int fontSize) {
+    auto& textures = cachedTextures[std::make_pair(fontSize, color)];
+    auto iter = textures.find(text);
+    if(iter != textures.end()) {
+        return iter->second.get();
+    }
+
+    if(numCachedTextures >= FONTMANAGER_MAX_CACHED_TEXTURES) {
+        for(auto& cachedTexturesOfFont : cachedTextures) {
+            cachedTexturesOfFont.second.clear();
+        }
+        numCachedTextures = 0;
+    }
+
+    numCachedTextures++;
+    return (textures[text] = createTextureWithText(text, color, fontSize)).get();
+}
+
 std::unique_ptr<Font> FontManager::loadFont(unsigned int fontSize) {
-    return std::make_unique<TTFFont>( pFileManager->openFile("Philosopher-Bold.ttf"), fontSize );
+    if(fontFileData.empty()) {
+        sdl2::RWops_ptr file = pFileManager->openFile("Philosopher-Bold.ttf");
+        const Sint64 fileSize = SDL_RWsize(file.get());
+        if(fileSize <= 0) {
+            THROW(std::runtime_error, "FontManager::loadFont(): Cannot determine size of the font file!");
+        }
+
+        fontFileData.resize(fileSize);
+        if(SDL_RWread(file.get(), &fontFileData[0], fileSize, 1) != 1) {
+            fontFileData.clear();
+            THROW(std::runtime_error, "FontManager::loadFont(): Reading the font file failed!");
+        }
+    }
+
+    // SDL_ttf reads the font directly from fontFileData, which lives as long as the fonts
+    return std::make_unique<TTFFont>( sdl2::RWops_ptr{ SDL_RWFromConstMem(fontFileData.data(), static_cast<int>(fontFileData.size())) }, fontSize );
 }
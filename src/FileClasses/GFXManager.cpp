@@ -32,6 +32,11 @@
 #include <misc/draw_util.h>
 #include <misc/Scaler.h>
 #include <misc/exceptions.h>
+#include <misc/fnkdat.h>
+#include <misc/WorkerPool.h>
+#include <misc/AllocationCounter.h>
+
+#include <algorithm>
 
 /**
     Number of columns and rows each obj pic has
@@ -116,6 +121,12 @@ static const Coord objPicTiles[] {
 
 
 GFXManager::GFXManager() {
+    MEMORY_TAG(MemoryTag_Graphics);
+
+    // the zoomed and recolored object pictures only depend on the pak files and the scaler
+    char cacheFilepath[FILENAME_MAX];
+    fnkdat(OBJPICCACHE_FILENAME, cacheFilepath, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+    pObjPicCache = std::make_unique<SurfaceCache>(cacheFilepath, OBJPICCACHE_VERSION ":" + settings.video.scaler + ":" + pFileManager->getPakFilesChecksum());
 
     // open all shp files
     std::unique_ptr<Shpfile> units = loadShpfile("UNITS.SHP");
@@ -257,127 +268,117 @@ GFXManager::GFXManager() {
     SDL_Color fogTransparent = { 0, 0, 0, 96};
     SDL_SetPaletteColors(objPic[ObjPic_Terrain_HiddenFog][HOUSE_HARKONNEN][0]->format->palette, &fogTransparent, PALCOLOR_BLACK, 1);
 
-    // scale obj pics and apply color key
+    // apply color key; the zoomed and house colored variants are generated on first use by getObjPicSurface()
     for(int id = 0; id < NUM_OBJPICS; id++) {
         for(int h = 0; h < (int) NUM_HOUSES; h++) {
-            if(objPic[id][h][0] != nullptr) {
-                if(objPic[id][h][1] == nullptr) {
-                    objPic[id][h][1] = generateDoubledObjPic(id, h);
-                }
-                SDL_SetColorKey(objPic[id][h][1].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
-
-                if(objPic[id][h][2] == nullptr) {
-                    objPic[id][h][2] = generateTripledObjPic(id, h);
+            for(int z = 0; z < NUM_ZOOMLEVEL; z++) {
+                if(objPic[id][h][z] != nullptr) {
+                    SDL_SetColorKey(objPic[id][h][z].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
                 }
-                SDL_SetColorKey(objPic[id][h][2].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
-
-                SDL_SetColorKey(objPic[id][h][0].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
             }
         }
     }
 
     objPic[ObjPic_CarryallShadow][HOUSE_HARKONNEN][0] = createShadowSurface(objPic[ObjPic_Carryall][HOUSE_HARKONNEN][0].get());
-    objPic[ObjPic_CarryallShadow][HOUSE_HARKONNEN][1] = createShadowSurface(objPic[ObjPic_Carryall][HOUSE_HARKONNEN][1].get());
-    objPic[ObjPic_CarryallShadow][HOUSE_HARKONNEN][2] = createShadowSurface(objPic[ObjPic_Carryall][HOUSE_HARKONNEN][2].get());
     objPic[ObjPic_FrigateShadow][HOUSE_HARKONNEN][0] = createShadowSurface(objPic[ObjPic_Frigate][HOUSE_HARKONNEN][0].get());
-    objPic[ObjPic_FrigateShadow][HOUSE_HARKONNEN][1] = createShadowSurface(objPic[ObjPic_Frigate][HOUSE_HARKONNEN][1].get());
-    objPic[ObjPic_FrigateShadow][HOUSE_HARKONNEN][2] = createShadowSurface(objPic[ObjPic_Frigate][HOUSE_HARKONNEN][2].get());
     objPic[ObjPic_OrnithopterShadow][HOUSE_HARKONNEN][0] = createShadowSurface(objPic[ObjPic_Ornithopter][HOUSE_HARKONNEN][0].get());
-    objPic[ObjPic_OrnithopterShadow][HOUSE_HARKONNEN][1] = createShadowSurface(objPic[ObjPic_Ornithopter][HOUSE_HARKONNEN][1].get());
-    objPic[ObjPic_OrnithopterShadow][HOUSE_HARKONNEN][2] = createShadowSurface(objPic[ObjPic_Ornithopter][HOUSE_HARKONNEN][2].get());
-
-    // load small detail pics
-    smallDetailPicTex[Picture_Barracks] = extractSmallDetailPic("BARRAC.WSA");
-    smallDetailPicTex[Picture_ConstructionYard] = extractSmallDetailPic("CONSTRUC.WSA");
-    smallDetailPicTex[Picture_Carryall] = extractSmallDetailPic("CARRYALL.WSA");
-    smallDetailPicTex[Picture_Devastator] = extractSmallDetailPic("HARKTANK.WSA");
-    smallDetailPicTex[Picture_Deviator] = extractSmallDetailPic("ORDRTANK.WSA");
-    smallDetailPicTex[Picture_DeathHand] = extractSmallDetailPic("GOLD-BB.WSA");
-    smallDetailPicTex[Picture_Fremen] = extractSmallDetailPic("FREMEN.WSA");
-    if(pFileManager->exists("FRIGATE.WSA")) {
-        smallDetailPicTex[Picture_Frigate] = extractSmallDetailPic("FRIGATE.WSA");
-    } else {
+
+    // load small detail pics; every WSA file is decoded independently, so they are spread over all cores
+    const std::vector<std::pair<unsigned int, std::string>> smallDetailPicFiles = {
+        { Picture_Barracks, "BARRAC.WSA" },
+        { Picture_ConstructionYard, "CONSTRUC.WSA" },
+        { Picture_Carryall, "CARRYALL.WSA" },
+        { Picture_Devastator, "HARKTANK.WSA" },
+        { Picture_Deviator, "ORDRTANK.WSA" },
+        { Picture_DeathHand, "GOLD-BB.WSA" },
+        { Picture_Fremen, "FREMEN.WSA" },
         // US-Version 1.07 does not contain FRIGATE.WSA
         // We replace it with the starport
-        smallDetailPicTex[Picture_Frigate] = extractSmallDetailPic("STARPORT.WSA");
-    }
-    smallDetailPicTex[Picture_GunTurret] = extractSmallDetailPic("TURRET.WSA");
-    smallDetailPicTex[Picture_Harvester] = extractSmallDetailPic("HARVEST.WSA");
-    smallDetailPicTex[Picture_HeavyFactory] = extractSmallDetailPic("HVYFTRY.WSA");
-    smallDetailPicTex[Picture_HighTechFactory] = extractSmallDetailPic("HITCFTRY.WSA");
-    smallDetailPicTex[Picture_Soldier] = extractSmallDetailPic("INFANTRY.WSA");
-    smallDetailPicTex[Picture_IX] = extractSmallDetailPic("IX.WSA");
-    smallDetailPicTex[Picture_Launcher] = extractSmallDetailPic("RTANK.WSA");
-    smallDetailPicTex[Picture_LightFactory] = extractSmallDetailPic("LITEFTRY.WSA");
-    smallDetailPicTex[Picture_MCV] = extractSmallDetailPic("MCV.WSA");
-    smallDetailPicTex[Picture_Ornithopter] = extractSmallDetailPic("ORNI.WSA");
-    smallDetailPicTex[Picture_Palace] = extractSmallDetailPic("PALACE.WSA");
-    smallDetailPicTex[Picture_Quad] = extractSmallDetailPic("QUAD.WSA");
-    smallDetailPicTex[Picture_Radar] = extractSmallDetailPic("HEADQRTS.WSA");
-    smallDetailPicTex[Picture_RaiderTrike] = extractSmallDetailPic("OTRIKE.WSA");
-    smallDetailPicTex[Picture_Refinery] = extractSmallDetailPic("REFINERY.WSA");
-    smallDetailPicTex[Picture_RepairYard] = extractSmallDetailPic("REPAIR.WSA");
-    smallDetailPicTex[Picture_RocketTurret] = extractSmallDetailPic("RTURRET.WSA");
-    smallDetailPicTex[Picture_Saboteur] = extractSmallDetailPic("SABOTURE.WSA");
-    smallDetailPicTex[Picture_Sandworm] = extractSmallDetailPic("WORM.WSA");
-    smallDetailPicTex[Picture_Sardaukar] = extractSmallDetailPic("SARDUKAR.WSA");
-    smallDetailPicTex[Picture_SiegeTank] = extractSmallDetailPic("HTANK.WSA");
-    smallDetailPicTex[Picture_Silo] = extractSmallDetailPic("STORAGE.WSA");
-    smallDetailPicTex[Picture_Slab1] = extractSmallDetailPic("SLAB.WSA");
-    smallDetailPicTex[Picture_Slab4] = extractSmallDetailPic("4SLAB.WSA");
-    smallDetailPicTex[Picture_SonicTank] = extractSmallDetailPic("STANK.WSA");
-    smallDetailPicTex[Picture_Special]  = nullptr;
-    smallDetailPicTex[Picture_StarPort] = extractSmallDetailPic("STARPORT.WSA");
-    smallDetailPicTex[Picture_Tank] = extractSmallDetailPic("LTANK.WSA");
-    smallDetailPicTex[Picture_Trike] = extractSmallDetailPic("TRIKE.WSA");
-    smallDetailPicTex[Picture_Trooper] = extractSmallDetailPic("HYINFY.WSA");
-    smallDetailPicTex[Picture_Wall] = extractSmallDetailPic("WALL.WSA");
-    smallDetailPicTex[Picture_WindTrap] = extractSmallDetailPic("WINDTRAP.WSA");
-    smallDetailPicTex[Picture_WOR] = extractSmallDetailPic("WOR.WSA");
+        { Picture_Frigate, pFileManager->exists("FRIGATE.WSA") ? "FRIGATE.WSA" : "STARPORT.WSA" },
+        { Picture_GunTurret, "TURRET.WSA" },
+        { Picture_Harvester, "HARVEST.WSA" },
+        { Picture_HeavyFactory, "HVYFTRY.WSA" },
+        { Picture_HighTechFactory, "HITCFTRY.WSA" },
+        { Picture_Soldier, "INFANTRY.WSA" },
+        { Picture_IX, "IX.WSA" },
+        { Picture_Launcher, "RTANK.WSA" },
+        { Picture_LightFactory, "LITEFTRY.WSA" },
+        { Picture_MCV, "MCV.WSA" },
+        { Picture_Ornithopter, "ORNI.WSA" },
+        { Picture_Palace, "PALACE.WSA" },
+        { Picture_Quad, "QUAD.WSA" },
+        { Picture_Radar, "HEADQRTS.WSA" },
+        { Picture_RaiderTrike, "OTRIKE.WSA" },
+        { Picture_Refinery, "REFINERY.WSA" },
+        { Picture_RepairYard, "REPAIR.WSA" },
+        { Picture_RocketTurret, "RTURRET.WSA" },
+        { Picture_Saboteur, "SABOTURE.WSA" },
+        { Picture_Sandworm, "WORM.WSA" },
+        { Picture_Sardaukar, "SARDUKAR.WSA" },
+        { Picture_SiegeTank, "HTANK.WSA" },
+        { Picture_Silo, "STORAGE.WSA" },
+        { Picture_Slab1, "SLAB.WSA" },
+        { Picture_Slab4, "4SLAB.WSA" },
+        { Picture_SonicTank, "STANK.WSA" },
+        { Picture_StarPort, "STARPORT.WSA" },
+        { Picture_Tank, "LTANK.WSA" },
+        { Picture_Trike, "TRIKE.WSA" },
+        { Picture_Trooper, "HYINFY.WSA" },
+        { Picture_Wall, "WALL.WSA" },
+        { Picture_WindTrap, "WINDTRAP.WSA" },
+        { Picture_WOR, "WOR.WSA" },
+        // Picture_Special has no small detail pic
+    };
+
+    WorkerPool loaderPool(WorkerPool::getDefaultNumThreads());
+    loaderPool.parallelFor(static_cast<int>(smallDetailPicFiles.size()), [this, &smallDetailPicFiles](int i) {
+        smallDetailPic[smallDetailPicFiles[i].first] = extractSmallDetailPic(smallDetailPicFiles[i].second);
+    });
+
     // unused: FARTR.WSA, FHARK.WSA, FORDOS.WSA
 
 
-    tinyPictureTex[TinyPicture_Spice] = convertSurfaceToTexture(shapes->getPicture(94));
-    tinyPictureTex[TinyPicture_Barracks] = convertSurfaceToTexture(shapes->getPicture(62));
-    tinyPictureTex[TinyPicture_ConstructionYard] = convertSurfaceToTexture(shapes->getPicture(60));
-    tinyPictureTex[TinyPicture_GunTurret] = convertSurfaceToTexture(shapes->getPicture(67));
-    tinyPictureTex[TinyPicture_HeavyFactory] = convertSurfaceToTexture(shapes->getPicture(56));
-    tinyPictureTex[TinyPicture_HighTechFactory] = convertSurfaceToTexture(shapes->getPicture(57));
-    tinyPictureTex[TinyPicture_IX] = convertSurfaceToTexture(shapes->getPicture(58));
-    tinyPictureTex[TinyPicture_LightFactory] = convertSurfaceToTexture(shapes->getPicture(55));
-    tinyPictureTex[TinyPicture_Palace] = convertSurfaceToTexture(shapes->getPicture(54));
-    tinyPictureTex[TinyPicture_Radar] = convertSurfaceToTexture(shapes->getPicture(70));
-    tinyPictureTex[TinyPicture_Refinery] = convertSurfaceToTexture(shapes->getPicture(64));
-    tinyPictureTex[TinyPicture_RepairYard] = convertSurfaceToTexture(shapes->getPicture(65));
-    tinyPictureTex[TinyPicture_RocketTurret] = convertSurfaceToTexture(shapes->getPicture(68));
-    tinyPictureTex[TinyPicture_Silo] = convertSurfaceToTexture(shapes->getPicture(69));
-    tinyPictureTex[TinyPicture_Slab1] = convertSurfaceToTexture(shapes->getPicture(53));
-    tinyPictureTex[TinyPicture_Slab4] = convertSurfaceToTexture(shapes->getPicture(71));
-    tinyPictureTex[TinyPicture_StarPort] = convertSurfaceToTexture(shapes->getPicture(63));
-    tinyPictureTex[TinyPicture_Wall] = convertSurfaceToTexture(shapes->getPicture(66));
-    tinyPictureTex[TinyPicture_WindTrap] = convertSurfaceToTexture(shapes->getPicture(61));
-    tinyPictureTex[TinyPicture_WOR] = convertSurfaceToTexture(shapes->getPicture(59));
-    tinyPictureTex[TinyPicture_Carryall] = convertSurfaceToTexture(shapes->getPicture(77));
-    tinyPictureTex[TinyPicture_Devastator] = convertSurfaceToTexture(shapes->getPicture(75));
-    tinyPictureTex[TinyPicture_Deviator] = convertSurfaceToTexture(shapes->getPicture(86));
-    tinyPictureTex[TinyPicture_Frigate] = convertSurfaceToTexture(shapes->getPicture(77));    // use carryall picture
-    tinyPictureTex[TinyPicture_Harvester] = convertSurfaceToTexture(shapes->getPicture(88));
-    tinyPictureTex[TinyPicture_Soldier] = convertSurfaceToTexture(shapes->getPicture(90));
-    tinyPictureTex[TinyPicture_Launcher] = convertSurfaceToTexture(shapes->getPicture(73));
-    tinyPictureTex[TinyPicture_MCV] = convertSurfaceToTexture(shapes->getPicture(89));
-    tinyPictureTex[TinyPicture_Ornithopter] = convertSurfaceToTexture(shapes->getPicture(85));
-    tinyPictureTex[TinyPicture_Quad] = convertSurfaceToTexture(shapes->getPicture(74));
-    tinyPictureTex[TinyPicture_Saboteur] = convertSurfaceToTexture(shapes->getPicture(84));
-    tinyPictureTex[TinyPicture_Sandworm] = convertSurfaceToTexture(shapes->getPicture(93));
-    tinyPictureTex[TinyPicture_SiegeTank] = convertSurfaceToTexture(shapes->getPicture(72));
-    tinyPictureTex[TinyPicture_SonicTank] = convertSurfaceToTexture(shapes->getPicture(79));
-    tinyPictureTex[TinyPicture_Tank] = convertSurfaceToTexture(shapes->getPicture(78));
-    tinyPictureTex[TinyPicture_Trike] = convertSurfaceToTexture(shapes->getPicture(80));
-    tinyPictureTex[TinyPicture_RaiderTrike] = convertSurfaceToTexture(shapes->getPicture(87));
-    tinyPictureTex[TinyPicture_Trooper] = convertSurfaceToTexture(shapes->getPicture(76));
-    tinyPictureTex[TinyPicture_Special] = convertSurfaceToTexture(shapes->getPicture(75));    // use devastator picture
-    tinyPictureTex[TinyPicture_Infantry] = convertSurfaceToTexture(shapes->getPicture(81));
-    tinyPictureTex[TinyPicture_Troopers] = convertSurfaceToTexture(shapes->getPicture(91));
+    tinyPicture[TinyPicture_Spice] = shapes->getPicture(94);
+    tinyPicture[TinyPicture_Barracks] = shapes->getPicture(62);
+    tinyPicture[TinyPicture_ConstructionYard] = shapes->getPicture(60);
+    tinyPicture[TinyPicture_GunTurret] = shapes->getPicture(67);
+    tinyPicture[TinyPicture_HeavyFactory] = shapes->getPicture(56);
+    tinyPicture[TinyPicture_HighTechFactory] = shapes->getPicture(57);
+    tinyPicture[TinyPicture_IX] = shapes->getPicture(58);
+    tinyPicture[TinyPicture_LightFactory] = shapes->getPicture(55);
+    tinyPicture[TinyPicture_Palace] = shapes->getPicture(54);
+    tinyPicture[TinyPicture_Radar] = shapes->getPicture(70);
+    tinyPicture[TinyPicture_Refinery] = shapes->getPicture(64);
+    tinyPicture[TinyPicture_RepairYard] = shapes->getPicture(65);
+    tinyPicture[TinyPicture_RocketTurret] = shapes->getPicture(68);
+    tinyPicture[TinyPicture_Silo] = shapes->getPicture(69);
+    tinyPicture[TinyPicture_Slab1] = shapes->getPicture(53);
+    tinyPicture[TinyPicture_Slab4] = shapes->getPicture(71);
+    tinyPicture[TinyPicture_StarPort] = shapes->getPicture(63);
+    tinyPicture[TinyPicture_Wall] = shapes->getPicture(66);
+    tinyPicture[TinyPicture_WindTrap] = shapes->getPicture(61);
+    tinyPicture[TinyPicture_WOR] = shapes->getPicture(59);
+    tinyPicture[TinyPicture_Carryall] = shapes->getPicture(77);
+    tinyPicture[TinyPicture_Devastator] = shapes->getPicture(75);
+    tinyPicture[TinyPicture_Deviator] = shapes->getPicture(86);
+    tinyPicture[TinyPicture_Frigate] = shapes->getPicture(77);    // use carryall picture
+    tinyPicture[TinyPicture_Harvester] = shapes->getPicture(88);
+    tinyPicture[TinyPicture_Soldier] = shapes->getPicture(90);
+    tinyPicture[TinyPicture_Launcher] = shapes->getPicture(73);
+    tinyPicture[TinyPicture_MCV] = shapes->getPicture(89);
+    tinyPicture[TinyPicture_Ornithopter] = shapes->getPicture(85);
+    tinyPicture[TinyPicture_Quad] = shapes->getPicture(74);
+    tinyPicture[TinyPicture_Saboteur] = shapes->getPicture(84);
+    tinyPicture[TinyPicture_Sandworm] = shapes->getPicture(93);
+    tinyPicture[TinyPicture_SiegeTank] = shapes->getPicture(72);
+    tinyPicture[TinyPicture_SonicTank] = shapes->getPicture(79);
+    tinyPicture[TinyPicture_Tank] = shapes->getPicture(78);
+    tinyPicture[TinyPicture_Trike] = shapes->getPicture(80);
+    tinyPicture[TinyPicture_RaiderTrike] = shapes->getPicture(87);
+    tinyPicture[TinyPicture_Trooper] = shapes->getPicture(76);
+    tinyPicture[TinyPicture_Special] = shapes->getPicture(75);    // use devastator picture
+    tinyPicture[TinyPicture_Infantry] = shapes->getPicture(81);
+    tinyPicture[TinyPicture_Troopers] = shapes->getPicture(91);
 
     // load UI graphics
     uiGraphic[UI_RadarAnimation][HOUSE_HARKONNEN] = Scaler::doubleSurfaceNN(radar->getAnimationAsPictureRow(NUM_STATIC_ANIMATIONS_PER_ROW).get());
@@ -611,12 +612,15 @@ GFXManager::GFXManager() {
 
         sdl2::surface_lock lock{ surface };
 
+        Uint8 colorMap[256];
+        for(int i = 0; i < 256; i++) {
+            colorMap[i] = static_cast<Uint8>(i);
+        }
+        colorMap[0] = PALCOLOR_BLACK;
+
         for(auto y = 48; y < 48+240; y++) {
-            for(auto x = 16; x < 16 + 608; x++) {
-                if(getPixel(surface, x, y) == 0) {
-                    putPixel(surface, x, y, PALCOLOR_BLACK);
-                }
-            }
+            Uint8* p = static_cast<Uint8*>(surface->pixels) + y * surface->pitch + 16;
+            mapRowColors(p, p, 608, colorMap);
         }
     }
 
@@ -830,33 +834,48 @@ GFXManager::GFXManager() {
     pBackgroundSurface = convertSurfaceToDisplayFormat(PicFactory->createBackground().get());
 }
 
-GFXManager::~GFXManager() = default;
+GFXManager::~GFXManager() {
+    if(pObjPicCache == nullptr) {
+        return;
+    }
+
+    for(int id = 0; id < NUM_OBJPICS; id++) {
+        for(int h = 0; h < (int) NUM_HOUSES; h++) {
+            for(int z = 0; z < NUM_ZOOMLEVEL; z++) {
+                if(objPicGenerated[id][h][z]) {
+                    pObjPicCache->putSurface((id*NUM_HOUSES + h)*NUM_ZOOMLEVEL + z, objPic[id][h][z].get());
+                }
+            }
+        }
+    }
+
+    pObjPicCache->save();
+}
 
 SDL_Texture* GFXManager::getZoomedObjPic(unsigned int id, int house, unsigned int z) {
+    MEMORY_TAG(MemoryTag_Graphics);
+
     if(id >= NUM_OBJPICS) {
         THROW(std::invalid_argument, "GFXManager::getZoomedObjPic(): Unit Picture with ID %u is not available!", id);
     }
 
-    if(objPic[id][house][z] == nullptr) {
-        // remap to this color
-        if(objPic[id][HOUSE_HARKONNEN][z] == nullptr) {
-            THROW(std::runtime_error, "GFXManager::getZoomedObjPic(): Unit Picture with ID %u is not loaded!", id);
-        }
-
-        objPic[id][house][z] = mapSurfaceColorRange(objPic[id][HOUSE_HARKONNEN][z].get(), PALCOLOR_HARKONNEN, houseToPaletteIndex[house]);
+    if((objPicTex[id][house][z] == nullptr) && (z > 0) && settings.video.gpuZoomScaling) {
+        objPicTex[id][house][z] = createGPUScaledObjPic(id, house, z);
     }
 
     if(objPicTex[id][house][z] == nullptr) {
+        SDL_Surface* pSurface = getObjPicSurface(id, house, z);
+
         // now convert to display format
         if(id == ObjPic_Windtrap) {
             // Windtrap uses palette animation on PALCOLOR_WINDTRAP_COLORCYCLE; fake this
-            objPicTex[id][house][z] = convertSurfaceToTexture(generateWindtrapAnimationFrames(objPic[id][house][z].get()));
+            objPicTex[id][house][z] = convertSurfaceToTexture(generateWindtrapAnimationFrames(pSurface));
         } else if(id == ObjPic_Bullet_SonicTemp) {
-            objPicTex[id][house][z] = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, objPic[id][house][z]->w, objPic[id][house][z]->h) };
+            objPicTex[id][house][z] = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, pSurface->w, pSurface->h) };
         } else if(id == ObjPic_SandwormShimmerTemp) {
-            objPicTex[id][house][z] = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, objPic[id][house][z]->w, objPic[id][house][z]->h) };
+            objPicTex[id][house][z] = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, pSurface->w, pSurface->h) };
         } else {
-            objPicTex[id][house][z] = convertSurfaceToTexture(objPic[id][house][z].get());
+            objPicTex[id][house][z] = convertSurfaceToTexture(pSurface);
         }
     }
 
@@ -877,11 +896,203 @@ zoomable_texture GFXManager::getObjPic(unsigned int id, int house) {
     return zoomable_texture{ objPicTex[id][house][0].get(), objPicTex[id][house][1].get(), objPicTex[id][house][2].get() };
 }
 
+void GFXManager::prefetchObjPics(const std::vector<int>& houses, unsigned int firstZoomlevel) {
+    prefetchQueue.clear();
+
+    for(unsigned int i = 0; i < NUM_ZOOMLEVEL; i++) {
+        const unsigned int z = (firstZoomlevel + i) % NUM_ZOOMLEVEL;
+
+        for(unsigned int id = 0; id < NUM_OBJPICS; id++) {
+            prefetchQueue.push_back(PrefetchItem{ id, HOUSE_HARKONNEN, z });
+        }
+
+        // only units and structures are drawn in the color of their owner
+        for(auto iter = houses.begin(); iter != houses.end(); ++iter) {
+            const int house = *iter;
+            if((house < 0) || (house >= (int) NUM_HOUSES) || (house == HOUSE_HARKONNEN) || (std::find(houses.begin(), iter, house) != iter)) {
+                // invalid (e.g. random), already queued as HOUSE_HARKONNEN or duplicate
+                continue;
+            }
+
+            for(unsigned int id = 0; id < ObjPic_Bullet_SmallRocket; id++) {
+                prefetchQueue.push_back(PrefetchItem{ id, house, z });
+            }
+        }
+    }
+}
+
+bool GFXManager::processPrefetchQueue(Uint32 maxTime) {
+    MEMORY_TAG(MemoryTag_Graphics);
+    const Uint32 startTime = SDL_GetTicks();
+
+    while(!prefetchQueue.empty() && (SDL_GetTicks() - startTime < maxTime)) {
+        const PrefetchItem item = prefetchQueue.front();
+        prefetchQueue.pop_front();
+
+        if((objPic[item.id][HOUSE_HARKONNEN][0] != nullptr) || (objPic[item.id][item.house][0] != nullptr)) {
+            getZoomedObjPic(item.id, item.house, item.z);
+        }
+    }
+
+    return !prefetchQueue.empty();
+}
+
+sdl2::texture_ptr GFXManager::createGPUScaledObjPic(unsigned int id, int house, unsigned int z) {
+    SDL_Texture* pBaseTexture = getZoomedObjPic(id, house, 0);
+
+    const int factor = static_cast<int>(z) + 1;
+    int w, h;
+    SDL_QueryTexture(pBaseTexture, nullptr, nullptr, &w, &h);
+
+    sdl2::texture_ptr pTexture{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, w*factor, h*factor) };
+    if(pTexture == nullptr) {
+        SDL_Log("GFXManager: SDL_CreateTexture() failed: %s", SDL_GetError());
+        return nullptr;
+    }
+
+    if((id == ObjPic_Bullet_SonicTemp) || (id == ObjPic_SandwormShimmerTemp)) {
+        // temporary render targets that are filled by their user every frame
+        return pTexture;
+    }
+
+    SDL_SetTextureBlendMode(pTexture.get(), SDL_BLENDMODE_BLEND);
+    if(!renderGPUScaledObjPic(pBaseTexture, pTexture.get(), factor)) {
+        // fall back to the scaled 8-bit surfaces
+        return nullptr;
+    }
+
+    return pTexture;
+}
+
+bool GFXManager::renderGPUScaledObjPic(SDL_Texture* pSource, SDL_Texture* pTarget, int factor) {
+    SDL_Texture* oldRenderTarget = SDL_GetRenderTarget(renderer);
+    if(SDL_SetRenderTarget(renderer, pTarget) != 0) {
+        SDL_Log("GFXManager: SDL_SetRenderTarget() failed: %s", SDL_GetError());
+        SDL_SetRenderTarget(renderer, oldRenderTarget);
+        return false;
+    }
+
+    Uint8 oldR, oldG, oldB, oldA;
+    SDL_GetRenderDrawColor(renderer, &oldR, &oldG, &oldB, &oldA);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, oldR, oldG, oldB, oldA);
+
+    // copy the alpha channel as is instead of blending onto the cleared target
+    SDL_BlendMode oldBlendMode;
+    SDL_GetTextureBlendMode(pSource, &oldBlendMode);
+    SDL_SetTextureBlendMode(pSource, SDL_BLENDMODE_NONE);
+
+    int w, h;
+    SDL_QueryTexture(pSource, nullptr, nullptr, &w, &h);
+    const SDL_Rect dest = { 0, 0, w*factor, h*factor };
+    SDL_RenderCopy(renderer, pSource, nullptr, &dest);
+
+    SDL_SetTextureBlendMode(pSource, oldBlendMode);
+    SDL_SetRenderTarget(renderer, oldRenderTarget);
+
+    return true;
+}
+
+void GFXManager::recreateScreenSizeDependentGraphics() {
+    // the PictureFactory only loads the few pictures it composes the frames and backgrounds of
+    PictureFactory picFactory;
+
+    replaceUIGraphic(UI_SideBar, picFactory.createSideBar(false));
+    replaceUIGraphic(UI_MenuBackground, picFactory.createMainBackground());
+    replaceUIGraphic(UI_TopBar, picFactory.createTopBar());
+    replaceUIGraphic(UI_MapEditor_SideBar, picFactory.createSideBar(true));
+    replaceUIGraphic(UI_MapEditor_BottomBar, picFactory.createBottomBar());
+
+    replaceUIGraphic(UI_GameStatsBackground, picFactory.createGameStatsBackground(HOUSE_HARKONNEN));
+    for(int house : { HOUSE_ATREIDES, HOUSE_ORDOS, HOUSE_FREMEN, HOUSE_SARDAUKAR, HOUSE_MERCENARY }) {
+        uiGraphic[UI_GameStatsBackground][house] = picFactory.createGameStatsBackground(house);
+    }
+
+    pBackgroundSurface = convertSurfaceToDisplayFormat(picFactory.createBackground().get());
+}
+
+void GFXManager::replaceUIGraphic(unsigned int id, sdl2::surface_ptr pSurface) {
+    for(int h = 0; h < NUM_HOUSES; h++) {
+        uiGraphic[id][h].reset();
+        uiGraphicTex[id][h].reset();
+    }
+
+    uiGraphic[id][HOUSE_HARKONNEN] = std::move(pSurface);
+}
+
+void GFXManager::restoreGPUScaledObjPics() {
+    if(!settings.video.gpuZoomScaling) {
+        return;
+    }
+
+    for(unsigned int id = 0; id < NUM_OBJPICS; id++) {
+        if((id == ObjPic_Bullet_SonicTemp) || (id == ObjPic_SandwormShimmerTemp)) {
+            continue;
+        }
+
+        for(int h = 0; h < (int) NUM_HOUSES; h++) {
+            for(int z = 1; z < NUM_ZOOMLEVEL; z++) {
+                // pictures with a zoomed surface were created by convertSurfaceToTexture() and are not affected
+                if((objPicTex[id][h][z] != nullptr) && (objPic[id][h][z] == nullptr) && (objPicTex[id][h][0] != nullptr)) {
+                    renderGPUScaledObjPic(objPicTex[id][h][0].get(), objPicTex[id][h][z].get(), z + 1);
+                }
+            }
+        }
+    }
+}
+
+// the pictures drawn for every tile by the ground and fog passes
+static const std::array<unsigned int, 7> groundAtlasPics = { { ObjPic_Terrain, ObjPic_DestroyedStructure, ObjPic_RockDamage, ObjPic_SandDamage,
+                                                               ObjPic_Terrain_Hidden, ObjPic_Terrain_HiddenFog, ObjPic_Terrain_Tracks } };
+
+AtlasPic GFXManager::getZoomedAtlasPic(unsigned int id, unsigned int z) {
+    if(!groundAtlasBuilt[z]) {
+        buildGroundAtlas(z);
+    }
+
+    if(groundAtlas[z].getTexture() != nullptr) {
+        const auto iter = std::find(groundAtlasPics.begin(), groundAtlasPics.end(), id);
+        if(iter != groundAtlasPics.end()) {
+            return AtlasPic{ groundAtlas[z].getTexture(), groundAtlas[z].getRect(static_cast<int>(iter - groundAtlasPics.begin())) };
+        }
+    }
+
+    SDL_Texture* pTexture = getZoomedObjPic(id, z);
+    int w, h;
+    SDL_QueryTexture(pTexture, nullptr, nullptr, &w, &h);
+    return AtlasPic{ pTexture, { 0, 0, w, h } };
+}
+
+void GFXManager::buildGroundAtlas(unsigned int z) {
+    groundAtlasBuilt[z] = true;
+
+    std::vector<SDL_Surface*> surfaces;
+    for(unsigned int id : groundAtlasPics) {
+        surfaces.push_back(getObjPicSurface(id, HOUSE_HARKONNEN, z));
+    }
+
+    SDL_RendererInfo rendererInfo;
+    int maxSize = 2048;
+    if((SDL_GetRendererInfo(renderer, &rendererInfo) == 0) && (rendererInfo.max_texture_width > 0) && (rendererInfo.max_texture_height > 0)) {
+        maxSize = std::min(rendererInfo.max_texture_width, rendererInfo.max_texture_height);
+    }
+
+    if(!groundAtlas[z].build(surfaces, maxSize)) {
+        SDL_Log("GFXManager: Cannot pack the ground pictures of zoom level %u into one texture; using separate textures", z);
+    }
+}
+
 
 SDL_Texture* GFXManager::getSmallDetailPic(unsigned int id) {
     if(id >= NUM_SMALLDETAILPICS) {
         return nullptr;
     }
+
+    if((smallDetailPicTex[id] == nullptr) && (smallDetailPic[id] != nullptr)) {
+        smallDetailPicTex[id] = convertSurfaceToTexture(smallDetailPic[id].get());
+    }
+
     return smallDetailPicTex[id].get();
 }
 
@@ -890,6 +1101,11 @@ SDL_Texture* GFXManager::getTinyPicture(unsigned int id) {
     if(id >= NUM_TINYPICTURE) {
         return nullptr;
     }
+
+    if((tinyPictureTex[id] == nullptr) && (tinyPicture[id] != nullptr)) {
+        tinyPictureTex[id] = convertSurfaceToTexture(tinyPicture[id].get());
+    }
+
     return tinyPictureTex[id].get();
 }
 
@@ -1061,6 +1277,97 @@ Animation* GFXManager::getAnimation(unsigned int id) {
     return animation[id].get();
 }
 
+/// the bytes of a texture as allocated by the driver, assuming it stores the pixels unpadded
+static size_t getTextureBytes(SDL_Texture* pTexture) {
+    if(pTexture == nullptr) {
+        return 0;
+    }
+
+    Uint32 format;
+    int w, h;
+    if(SDL_QueryTexture(pTexture, &format, nullptr, &w, &h) != 0) {
+        return 0;
+    }
+
+    return (size_t) w * h * SDL_BYTESPERPIXEL(format);
+}
+
+static size_t getSurfaceBytes(const SDL_Surface* pSurface) {
+    return (pSurface == nullptr) ? 0 : (size_t) pSurface->h * pSurface->pitch;
+}
+
+size_t GFXManager::getTextureMemory() const {
+    size_t bytes = 0;
+
+    for(const auto& houseTextures : objPicTex) {
+        for(const auto& zoomTextures : houseTextures) {
+            for(const sdl2::texture_ptr& pTexture : zoomTextures) {
+                bytes += getTextureBytes(pTexture.get());
+            }
+        }
+    }
+
+    for(const sdl2::texture_ptr& pTexture : smallDetailPicTex) {
+        bytes += getTextureBytes(pTexture.get());
+    }
+
+    for(const sdl2::texture_ptr& pTexture : tinyPictureTex) {
+        bytes += getTextureBytes(pTexture.get());
+    }
+
+    for(const auto& houseTextures : uiGraphicTex) {
+        for(const sdl2::texture_ptr& pTexture : houseTextures) {
+            bytes += getTextureBytes(pTexture.get());
+        }
+    }
+
+    for(const auto& houseTextures : mapChoicePiecesTex) {
+        for(const sdl2::texture_ptr& pTexture : houseTextures) {
+            bytes += getTextureBytes(pTexture.get());
+        }
+    }
+
+    for(const TextureAtlas& atlas : groundAtlas) {
+        bytes += getTextureBytes(atlas.getTexture());
+    }
+
+    return bytes;
+}
+
+size_t GFXManager::getSurfaceMemory() const {
+    size_t bytes = getSurfaceBytes(pBackgroundSurface.get());
+
+    for(const auto& houseSurfaces : objPic) {
+        for(const auto& zoomSurfaces : houseSurfaces) {
+            for(const sdl2::surface_ptr& pSurface : zoomSurfaces) {
+                bytes += getSurfaceBytes(pSurface.get());
+            }
+        }
+    }
+
+    for(const auto& houseSurfaces : uiGraphic) {
+        for(const sdl2::surface_ptr& pSurface : houseSurfaces) {
+            bytes += getSurfaceBytes(pSurface.get());
+        }
+    }
+
+    for(const auto& houseSurfaces : mapChoicePieces) {
+        for(const sdl2::surface_ptr& pSurface : houseSurfaces) {
+            bytes += getSurfaceBytes(pSurface.get());
+        }
+    }
+
+    for(const sdl2::surface_ptr& pSurface : smallDetailPic) {
+        bytes += getSurfaceBytes(pSurface.get());
+    }
+
+    for(const sdl2::surface_ptr& pSurface : tinyPicture) {
+        bytes += getSurfaceBytes(pSurface.get());
+    }
+
+    return bytes;
+}
+
 std::unique_ptr<Shpfile> GFXManager::loadShpfile(const std::string& filename) const {
     try {
         return std::make_unique<Shpfile>(pFileManager->openFile(filename).get());
@@ -1077,7 +1384,7 @@ std::unique_ptr<Wsafile> GFXManager::loadWsafile(const std::string& filename) co
     }
 }
 
-sdl2::texture_ptr GFXManager::extractSmallDetailPic(const std::string& filename) const
+sdl2::surface_ptr GFXManager::extractSmallDetailPic(const std::string& filename) const
 {
     sdl2::surface_ptr pSurface{ SDL_CreateRGBSurface(0, 91, 55, 8, 0, 0, 0, 0) };
 
@@ -1114,7 +1421,7 @@ sdl2::texture_ptr GFXManager::extractSmallDetailPic(const std::string& filename)
         }
     }
 
-    return convertSurfaceToTexture(pSurface.get());
+    return pSurface;
 }
 
 std::unique_ptr<Animation> GFXManager::loadAnimationFromWsa(const std::string& filename) const {
@@ -1192,6 +1499,38 @@ sdl2::surface_ptr GFXManager::generateMapChoiceArrowFrames(SDL_Surface* arrowPic
     return returnPic;
 }
 
+SDL_Surface* GFXManager::getObjPicSurface(unsigned int id, int house, unsigned int z) {
+    if(objPic[id][house][z] != nullptr) {
+        return objPic[id][house][z].get();
+    }
+
+    objPic[id][house][z] = pObjPicCache->getSurface((id*NUM_HOUSES + house)*NUM_ZOOMLEVEL + z);
+    if(objPic[id][house][z] != nullptr) {
+        return objPic[id][house][z].get();
+    }
+
+    if((house != HOUSE_HARKONNEN) && (objPic[id][house][0] == nullptr)) {
+        // remap to this color
+        objPic[id][house][z] = mapSurfaceColorRange(getObjPicSurface(id, HOUSE_HARKONNEN, z), PALCOLOR_HARKONNEN, houseToPaletteIndex[house]);
+    } else if(objPic[id][house][0] == nullptr) {
+        THROW(std::runtime_error, "GFXManager::getObjPicSurface(): Unit Picture with ID %u is not loaded!", id);
+    } else if(id == ObjPic_CarryallShadow) {
+        // the shadows are made from the scaled aircraft and not scaled themselves
+        objPic[id][house][z] = createShadowSurface(getObjPicSurface(ObjPic_Carryall, house, z));
+    } else if(id == ObjPic_FrigateShadow) {
+        objPic[id][house][z] = createShadowSurface(getObjPicSurface(ObjPic_Frigate, house, z));
+    } else if(id == ObjPic_OrnithopterShadow) {
+        objPic[id][house][z] = createShadowSurface(getObjPicSurface(ObjPic_Ornithopter, house, z));
+    } else {
+        objPic[id][house][z] = (z == 1) ? generateDoubledObjPic(id, house) : generateTripledObjPic(id, house);
+        SDL_SetColorKey(objPic[id][house][z].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
+    }
+
+    objPicGenerated[id][house][z] = true;
+
+    return objPic[id][house][z].get();
+}
+
 sdl2::surface_ptr GFXManager::generateDoubledObjPic(unsigned int id, int h) const {
     sdl2::surface_ptr pSurface;
     std::string filename = "Mask_2x_" + ObjPicNames.at(id) + ".png";
@@ -18,6 +18,7 @@
 #include <FileClasses/INIFile.h>
 
 #include <misc/exceptions.h>
+#include <misc/FileSystem.h>
 
 #include <fstream>
 #include <iostream>
@@ -26,6 +27,19 @@
 #include <stdio.h>
 
 
+size_t INIFile::NameHash::operator()(const std::string& name) const {
+    // FNV-1a over the lower case characters
+    size_t hash = 2166136261u;
+    for(unsigned char c : name) {
+        hash = (hash ^ (size_t) tolower(c)) * 16777619u;
+    }
+    return hash;
+}
+
+bool INIFile::NameEqual::operator()(const std::string& name1, const std::string& name2) const {
+    return (name1.size() == name2.size()) && (strncicmp(name1.c_str(), name2.c_str(), name1.size()) == 0);
+}
+
 INIFile::INIFileLine::INIFileLine(const std::string& completeLine, int lineNumber)
  : completeLine(completeLine), line(lineNumber), nextLine(nullptr), prevLine(nullptr) {
 }
@@ -157,12 +171,12 @@ std::string INIFile::Key::escapeValue(const std::string& value) {
 
 INIFile::Section::Section(const std::string& completeLine, int lineNumber, int sectionstringbegin, int sectionstringlength, bool bWhitespace)
  :  INIFileLine(completeLine, lineNumber), sectionStringBegin(sectionstringbegin), sectionStringLength(sectionstringlength),
-    nextSection(nullptr), prevSection(nullptr), keyRoot(nullptr), bWhitespace(bWhitespace) {
+    nextSection(nullptr), prevSection(nullptr), keyRoot(nullptr), keyLast(nullptr), bWhitespace(bWhitespace) {
 }
 
 INIFile::Section::Section(const std::string& sectionname, bool bWhitespace)
  :  INIFileLine("[" + sectionname + "]", INVALID_LINE), sectionStringBegin(1), sectionStringLength(sectionname.size()),
-    nextSection(nullptr), prevSection(nullptr), keyRoot(nullptr), bWhitespace(bWhitespace) {
+    nextSection(nullptr), prevSection(nullptr), keyRoot(nullptr), keyLast(nullptr), bWhitespace(bWhitespace) {
 }
 
 /// Get the name for this section
@@ -203,15 +217,8 @@ bool INIFile::Section::hasKey(const std::string& key) const {
 }
 
 INIFile::Key* INIFile::Section::getKey(const std::string& keyname) const {
-    for(INIFile::Key& key : *this) {
-        if(key.keyStringLength == (int) keyname.size()) {
-                if(strncicmp(keyname.c_str(), key.completeLine.c_str()+key.keyStringBegin, keyname.size()) == 0) {
-                    return &key;
-                }
-        }
-    }
-
-    return nullptr;
+    auto iter = keyIndex.find(keyname);
+    return (iter == keyIndex.end()) ? nullptr : iter->second;
 }
 
 
@@ -246,9 +253,7 @@ void INIFile::Section::setStringValue(const std::string& key, const std::string&
             }
         } else {
             // Section already has some keys
-            while(pKey->nextKey != nullptr) {
-                pKey = pKey->nextKey;
-            }
+            pKey = keyLast;
 
             if(pKey->nextLine == nullptr) {
                 // no line after this key
@@ -294,14 +299,55 @@ void INIFile::Section::insertKey(Key* newKey) {
         keyRoot = newKey;
     } else {
         // insert into list
-        Key* curKey = keyRoot;
-        while(curKey->nextKey != nullptr) {
-            curKey = curKey->nextKey;
-        }
+        keyLast->nextKey = newKey;
+        newKey->prevKey = keyLast;
+    }
+    keyLast = newKey;
+
+    // if there are several keys with the same name the first one is found
+    keyIndex.emplace(newKey->getKeyName(), newKey);
+}
+
+void INIFile::Section::unlinkKey(Key* key) {
+    if(key->prevKey != nullptr) {
+        key->prevKey->nextKey = key->nextKey;
+    }
+
+    if(key->nextKey != nullptr) {
+        key->nextKey->prevKey = key->prevKey;
+    }
+
+    if(keyRoot == key) {
+        keyRoot = key->nextKey;
+    }
 
-        curKey->nextKey = newKey;
-        newKey->prevKey = curKey;
+    if(keyLast == key) {
+        keyLast = key->prevKey;
     }
+
+    auto iter = keyIndex.find(key->getKeyName());
+    if((iter != keyIndex.end()) && (iter->second == key)) {
+        keyIndex.erase(iter);
+
+        // a later key with the same name becomes visible now
+        Key* pKey = key->nextKey;
+        while(pKey != nullptr) {
+            if(NameEqual()(pKey->getKeyName(), key->getKeyName())) {
+                keyIndex.emplace(pKey->getKeyName(), pKey);
+                break;
+            }
+            pKey = pKey->nextKey;
+        }
+    }
+
+    key->nextKey = nullptr;
+    key->prevKey = nullptr;
+}
+
+void INIFile::Section::clearKeys() {
+    keyRoot = nullptr;
+    keyLast = nullptr;
+    keyIndex.clear();
 }
 
 
@@ -315,12 +361,9 @@ void INIFile::Section::insertKey(Key* newKey) {
     \param  firstLineComment    A comment to put in the first line (no comment is added for an empty string)
 */
 INIFile::INIFile(bool bWhitespace, const std::string& firstLineComment)
- : firstLine(nullptr), sectionRoot(nullptr), bWhitespace(bWhitespace)
+ : firstLine(nullptr), sectionRoot(nullptr), sectionLast(nullptr), bWhitespace(bWhitespace)
 {
-    firstLine = nullptr;
-    sectionRoot = nullptr;
-
-    sectionRoot = new Section("", INVALID_LINE, 0, 0, bWhitespace);
+    insertSection(new Section("", INVALID_LINE, 0, 0, bWhitespace));
     if(!firstLineComment.empty()) {
         firstLine = new INIFileLine("; " + firstLineComment, 0);
         INIFileLine* blankLine = new INIFileLine("",1);
@@ -338,10 +381,8 @@ INIFile::INIFile(bool bWhitespace, const std::string& firstLineComment)
     \param  bWhitespace   Insert whitespace between key an value when creating a new entry
 */
 INIFile::INIFile(const std::string& filename, bool bWhitespace)
- : firstLine(nullptr), sectionRoot(nullptr), bWhitespace(bWhitespace) {
+ : firstLine(nullptr), sectionRoot(nullptr), sectionLast(nullptr), bWhitespace(bWhitespace) {
 
-    firstLine = nullptr;
-    sectionRoot = nullptr;
     SDL_RWops * file;
 
     // open file
@@ -349,7 +390,7 @@ INIFile::INIFile(const std::string& filename, bool bWhitespace)
         readfile(file);
         SDL_RWclose(file);
     } else {
-        sectionRoot = new Section("", INVALID_LINE, 0, 0, bWhitespace);
+        insertSection(new Section("", INVALID_LINE, 0, 0, bWhitespace));
     }
 }
 
@@ -359,7 +400,7 @@ INIFile::INIFile(const std::string& filename, bool bWhitespace)
     \param  RWopsFile   Pointer to RWopsFile (can be readonly)
 */
 INIFile::INIFile(SDL_RWops * RWopsFile, bool bWhitespace)
- : firstLine(nullptr), sectionRoot(nullptr), bWhitespace(bWhitespace) {
+ : firstLine(nullptr), sectionRoot(nullptr), sectionLast(nullptr), bWhitespace(bWhitespace) {
 
     if(RWopsFile == nullptr) {
         THROW(std::invalid_argument, "RWopsFile == nullptr!");
@@ -442,14 +483,7 @@ bool INIFile::removeSection(const std::string& sectionname) {
             firstLine = curSection->nextLine;
         }
 
-        // remove section from section list
-        if(curSection->prevSection != nullptr) {
-            curSection->prevSection->nextSection = curSection->nextSection;
-        }
-
-        if(curSection->nextSection != nullptr) {
-            curSection->nextSection->prevSection = curSection->prevSection;
-        }
+        unlinkSection(curSection);
 
         delete curSection;
     }
@@ -488,8 +522,7 @@ bool INIFile::clearSection(const std::string& sectionname, bool bBlankLineAtSect
         }
     }
 
-
-    curSection->keyRoot = nullptr;
+    curSection->clearKeys();
 
     // now we add one blank line if not last section
     if(bBlankLineAtSectionEnd && (curSection->nextSection != nullptr)) {
@@ -569,18 +602,7 @@ bool INIFile::removeKey(const std::string& sectionname, const std::string& keyna
         firstLine = key->nextLine;
     }
 
-    // remove key from section
-    if(key->prevKey != nullptr) {
-        key->prevKey->nextKey = key->nextKey;
-    }
-
-    if(key->nextKey != nullptr) {
-        key->nextKey->prevKey = key->prevKey;
-    }
-
-    if(curSection->keyRoot == key) {
-        curSection->keyRoot = key->nextKey;
-    }
+    curSection->unlinkKey(key);
 
     delete key;
 
@@ -810,6 +832,7 @@ bool INIFile::saveChangesTo(const std::string& filename, bool bDOSLineEnding) co
 
     bool ret = saveChangesTo(file, bDOSLineEnding);
     SDL_RWclose(file);
+    invalidateFileListCache();
     return ret;
 }
 
@@ -860,10 +883,26 @@ void INIFile::flush() const {
 }
 
 void INIFile::readfile(SDL_RWops * file) {
-    sectionRoot = new Section("", INVALID_LINE, 0, 0, bWhitespace);
+    insertSection(new Section("", INVALID_LINE, 0, 0, bWhitespace));
 
     Section* curSection = sectionRoot;
 
+    // read the whole file at once instead of querying the RWops for every single byte
+    std::string buffer;
+    Sint64 fileSize = SDL_RWsize(file);
+    Sint64 filePos = SDL_RWtell(file);
+    if((fileSize > 0) && (filePos >= 0) && (fileSize > filePos)) {
+        buffer.reserve(fileSize - filePos);
+    }
+
+    char chunk[4096];
+    size_t readbytes;
+    while((readbytes = SDL_RWread(file, chunk, 1, sizeof(chunk))) > 0) {
+        buffer.append(chunk, readbytes);
+    }
+
+    size_t lineBegin = 0;
+
     std::string completeLine;
     int lineNum = 0;
     INIFileLine* curLine = nullptr;
@@ -876,21 +915,16 @@ void INIFile::readfile(SDL_RWops * file) {
     while(!readfinished) {
         lineNum++;
 
-        completeLine = "";
-        unsigned char tmp;
-
-        while(1) {
-            size_t readbytes = SDL_RWread(file,&tmp,1,1);
-            if(readbytes == 0) {
-                readfinished = true;
-                break;
-            } else if(tmp == '\n') {
-                break;
-            } else if(tmp != '\r') {
-                completeLine += tmp;
-            }
+        size_t lineEnd = buffer.find('\n', lineBegin);
+        if(lineEnd == std::string::npos) {
+            lineEnd = buffer.size();
+            readfinished = true;
         }
 
+        completeLine.assign(buffer, lineBegin, lineEnd - lineBegin);
+        completeLine.erase(std::remove(completeLine.begin(), completeLine.end(), '\r'), completeLine.end());
+        lineBegin = lineEnd + 1;
+
         const unsigned char* line = (const unsigned char*) completeLine.c_str();
         bool bSyntaxError = false;
 
@@ -1031,32 +1065,51 @@ void INIFile::insertSection(Section* newSection) {
         sectionRoot = newSection;
     } else {
         // insert into list
-        Section* curSection = sectionRoot;
-        while(curSection->nextSection != nullptr) {
-            curSection = curSection->nextSection;
-        }
-
-        curSection->nextSection = newSection;
-        newSection->prevSection = curSection;
+        sectionLast->nextSection = newSection;
+        newSection->prevSection = sectionLast;
     }
+    sectionLast = newSection;
+
+    // if there are several sections with the same name the first one is found
+    sectionIndex.emplace(newSection->getSectionName(), newSection);
 }
 
+void INIFile::unlinkSection(Section* section) {
+    if(section->prevSection != nullptr) {
+        section->prevSection->nextSection = section->nextSection;
+    }
 
-const INIFile::Section* INIFile::getSectionInternal(const std::string& sectionname) const {
-    Section* curSection = sectionRoot;
-    int sectionnameSize = sectionname.size();
+    if(section->nextSection != nullptr) {
+        section->nextSection->prevSection = section->prevSection;
+    }
 
-    while(curSection != nullptr) {
-        if(curSection->sectionStringLength == sectionnameSize) {
-                if(strncicmp(sectionname.c_str(), curSection->completeLine.c_str()+curSection->sectionStringBegin, sectionnameSize) == 0) {
-                    return curSection;
-                }
-        }
+    if(sectionLast == section) {
+        sectionLast = section->prevSection;
+    }
+
+    auto iter = sectionIndex.find(section->getSectionName());
+    if((iter != sectionIndex.end()) && (iter->second == section)) {
+        sectionIndex.erase(iter);
 
-        curSection = curSection->nextSection;
+        // a later section with the same name becomes visible now
+        Section* pSection = section->nextSection;
+        while(pSection != nullptr) {
+            if(NameEqual()(pSection->getSectionName(), section->getSectionName())) {
+                sectionIndex.emplace(pSection->getSectionName(), pSection);
+                break;
+            }
+            pSection = pSection->nextSection;
+        }
     }
 
-    return nullptr;
+    section->nextSection = nullptr;
+    section->prevSection = nullptr;
+}
+
+
+const INIFile::Section* INIFile::getSectionInternal(const std::string& sectionname) const {
+    auto iter = sectionIndex.find(sectionname);
+    return (iter == sectionIndex.end()) ? nullptr : iter->second;
 }
 
 
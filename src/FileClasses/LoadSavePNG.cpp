@@ -22,6 +22,7 @@
 #include <Colors.h>
 #include <globals.h>
 
+#include <algorithm>
 #include <stdio.h>
 
 struct free_deleter
@@ -154,7 +155,7 @@ sdl2::surface_ptr LoadPNG_RW(SDL_RWops* RWop) {
     }
 }
 
-int SavePNG_RW(SDL_Surface* surface, SDL_RWops* RWop) {
+int SavePNG_RW(SDL_Surface* surface, SDL_RWops* RWop, int compressionLevel) {
     if(surface == nullptr) {
         return -1;
     }
@@ -162,26 +163,35 @@ int SavePNG_RW(SDL_Surface* surface, SDL_RWops* RWop) {
     unsigned int width = surface->w;
     unsigned int height = surface->h;
 
-    std::vector<unsigned char> image(width*height*4);
-
-    {
-        sdl2::surface_lock lock{ surface };
-
-        // Now we can copy pixel by pixel
-        for(unsigned int y = 0; y < height; y++) {
-            unsigned char* out = image.data() + y * 4*width;
-            for(unsigned int x = 0; x < width; x++) {
-                Uint32 pixel = getPixel(surface, x, y);
-                SDL_GetRGBA(pixel, surface->format, &out[0], &out[1], &out[2], &out[3]);
-                out += 4;
-            }
-        }
+    std::vector<unsigned char> image = getSurfaceRGBA(surface);
+
+    LodePNGState state;
+    lodepng_state_init(&state);
+    state.info_raw.colortype = LCT_RGBA;
+    state.info_raw.bitdepth = 8;
+
+    compressionLevel = std::max(0, std::min(compressionLevel, PNG_MAX_COMPRESSION));
+    if(compressionLevel == 0) {
+        // stored deflate blocks: no searching, filtering or color analysis at all
+        state.encoder.auto_convert = 0;
+        state.info_png.color.colortype = LCT_RGBA;
+        state.info_png.color.bitdepth = 8;
+        state.encoder.filter_strategy = LFS_ZERO;
+        state.encoder.zlibsettings.btype = 0;
+        state.encoder.zlibsettings.use_lz77 = 0;
+    } else {
+        // level PNG_DEFAULT_COMPRESSION corresponds to lodepng's default settings
+        state.encoder.filter_strategy = (compressionLevel <= 2) ? LFS_ZERO : LFS_MINSUM;
+        state.encoder.zlibsettings.windowsize = 1u << (compressionLevel + 5);
+        state.encoder.zlibsettings.lazymatching = (compressionLevel >= 4) ? 1 : 0;
+        state.encoder.zlibsettings.nicematch = (compressionLevel >= PNG_MAX_COMPRESSION) ? 258 : 128;
     }
 
     unsigned char* ppngFile;
     size_t pngFileSize;
 
-    unsigned int error = lodepng_encode32(&ppngFile, &pngFileSize, image.data(), width, height);
+    unsigned int error = lodepng_encode(&ppngFile, &pngFileSize, image.data(), width, height, &state);
+    lodepng_state_cleanup(&state);
     if(error != 0) {
         SDL_Log("%s", lodepng_error_text(error));
         free(ppngFile);
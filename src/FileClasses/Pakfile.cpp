@@ -20,8 +20,18 @@
 #include <misc/SDL2pp.h>
 
 #include <stdlib.h>
+#include <string.h>
 #include <string>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 
 /// Constructor for Pakfile
 /**
@@ -32,7 +42,10 @@
     \param write        Specified if the PAK-File is opened for reading or writing (default is false).
 */
 Pakfile::Pakfile(const std::string& pakfilename, bool write)
- : write(write), fPakFile(nullptr), filename(pakfilename), writeOutData(nullptr), numWriteOutData(0) {
+ : write(write), fPakFile(nullptr), fPakFileMutex(nullptr), filename(pakfilename), writeOutData(nullptr), numWriteOutData(0), pMappedData(nullptr), mappedSize(0) {
+#ifdef _WIN32
+    hMapping = nullptr;
+#endif
 
     if(write == false) {
         // Open for reading
@@ -46,6 +59,13 @@ Pakfile::Pakfile(const std::string& pakfilename, bool write)
             SDL_RWclose(fPakFile);
             throw;
         }
+
+        mapFile();
+
+        if((pMappedData == nullptr) && ((fPakFileMutex = SDL_CreateMutex()) == nullptr)) {
+            SDL_RWclose(fPakFile);
+            THROW(std::runtime_error, "Pakfile::Pakfile(): Cannot create mutex: %s!", SDL_GetError());
+        }
     } else {
         // Open for writing
         if( (fPakFile = SDL_RWFromFile(filename.c_str(), "wb")) == nullptr) {
@@ -86,10 +106,16 @@ Pakfile::~Pakfile()
         SDL_RWwrite(fPakFile,writeOutData,numWriteOutData,1);
     }
 
+    unmapFile();
+
     if(fPakFile != nullptr) {
         SDL_RWclose(fPakFile);
     }
 
+    if(fPakFileMutex != nullptr) {
+        SDL_DestroyMutex(fPakFileMutex);
+    }
+
     if(writeOutData != nullptr) {
         free(writeOutData);
         writeOutData = nullptr;
@@ -188,6 +214,24 @@ sdl2::RWops_ptr Pakfile::openFile(const std::string& filename) {
         THROW(io_error, "Pakfile::openFile(): Cannot find file with name '%s' in this PAK file!", filename.c_str());
     }
 
+    return openFile(index);
+}
+
+/// Opens a file in this PAK-File.
+/**
+    This method opens the file with the given index. See Pakfile::openFile(const std::string&) for details.
+    \param  index   Index in pak-File
+    \return SDL_RWops for this file
+*/
+sdl2::RWops_ptr Pakfile::openFile(unsigned int index) {
+    if(write == true) {
+        THROW(std::runtime_error, "Pakfile::openFile(): Writing files is not supported!");
+    }
+
+    if(index >= fileEntries.size()) {
+        THROW(std::invalid_argument, "Pakfile::openFile(%ud): This Pakfile has only %ud entries!", index, fileEntries.size());
+    }
+
     // alloc RWop
     SDL_RWops *pRWop;
     if((pRWop = SDL_AllocRW()) == nullptr) {
@@ -257,12 +301,17 @@ size_t Pakfile::ReadFile(SDL_RWops* pRWop, void *ptr, size_t size, size_t n) {
         }
     }
 
-    if(SDL_RWseek(pPakfile->fPakFile,readstartoffset,SEEK_SET) < 0) {
-        return 0;
-    }
+    if(pPakfile->pMappedData != nullptr) {
+        memcpy(ptr, pPakfile->pMappedData + readstartoffset, bytes2read);
+    } else {
+        SDL_LockMutex(pPakfile->fPakFileMutex);
+        const bool bSuccess = (SDL_RWseek(pPakfile->fPakFile,readstartoffset,SEEK_SET) >= 0)
+                                && (SDL_RWread(pPakfile->fPakFile,ptr,bytes2read,1) == 1);
+        SDL_UnlockMutex(pPakfile->fPakFileMutex);
 
-    if(SDL_RWread(pPakfile->fPakFile,ptr,bytes2read,1) != 1) {
-        return 0;
+        if(!bSuccess) {
+            return 0;
+        }
     }
 
     pRWopData->fileOffset += bytes2read;
@@ -353,6 +402,112 @@ int Pakfile::CloseFile(SDL_RWops *pRWop) {
     return 0;
 }
 
+/// Returns the content of a file in a memory-mapped PAK-File
+/**
+    This method gives direct read-only access to the content of a file opened with Pakfile::openFile(). The returned
+    pointer points to the current read position of pRWop and stays valid as long as the Pakfile-Object exists.
+    \param  pRWop   a SDL_RWops returned by Pakfile::openFile()
+    \param  pSize   the number of bytes from the current read position to the end of the file is stored here
+    \return the data at the current read position or nullptr if pRWop is not a file inside a memory-mapped PAK-File
+*/
+const unsigned char* Pakfile::getMappedData(SDL_RWops* pRWop, size_t* pSize) {
+    if((pRWop == nullptr) || (pRWop->hidden.unknown.data1 == nullptr) || (pRWop->type != PAKFILE_RWOP_TYPE)) {
+        return nullptr;
+    }
+
+    RWopData* pRWopData = static_cast<RWopData*>(pRWop->hidden.unknown.data1);
+    Pakfile* pPakfile = pRWopData->curPakfile;
+    if((pPakfile == nullptr) || (pPakfile->pMappedData == nullptr) || (pRWopData->fileIndex >= pPakfile->fileEntries.size())) {
+        return nullptr;
+    }
+
+    const PakFileEntry& entry = pPakfile->fileEntries[pRWopData->fileIndex];
+    const size_t fileSize = entry.endOffset + 1 - entry.startOffset;
+    if((entry.endOffset >= pPakfile->mappedSize) || (pRWopData->fileOffset > fileSize)) {
+        return nullptr;
+    }
+
+    *pSize = fileSize - pRWopData->fileOffset;
+    return pPakfile->pMappedData + entry.startOffset + pRWopData->fileOffset;
+}
+
+/**
+    Maps the whole PAK-File into memory. On failure the PAK-File is read through fPakFile as before.
+*/
+void Pakfile::mapFile() {
+    const Sint64 filesize = SDL_RWsize(fPakFile);
+    if((filesize <= 0) || (fileEntries.empty()) || (fileEntries.back().endOffset >= static_cast<Uint64>(filesize))) {
+        return;
+    }
+
+#ifdef _WIN32
+    WCHAR szwFilename[MAX_PATH];
+    if(MultiByteToWideChar(CP_UTF8, 0, filename.c_str(), -1, szwFilename, MAX_PATH) == 0) {
+        return;
+    }
+
+    HANDLE hFile = CreateFileW(szwFilename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(hFile == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    // the mapping keeps the file open
+    hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(hFile);
+    if(hMapping == nullptr) {
+        return;
+    }
+
+    void* pView = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    if(pView == nullptr) {
+        CloseHandle(hMapping);
+        hMapping = nullptr;
+        return;
+    }
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if(fd < 0) {
+        return;
+    }
+
+    struct stat fileStat;
+    if((fstat(fd, &fileStat) != 0) || (fileStat.st_size != filesize)) {
+        close(fd);
+        return;
+    }
+
+    // the mapping stays valid after closing the file descriptor
+    void* pView = mmap(nullptr, static_cast<size_t>(filesize), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(pView == MAP_FAILED) {
+        return;
+    }
+#endif
+
+    pMappedData = static_cast<const unsigned char*>(pView);
+    mappedSize = static_cast<size_t>(filesize);
+}
+
+/**
+    Releases the mapping created by mapFile().
+*/
+void Pakfile::unmapFile() {
+    if(pMappedData == nullptr) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(pMappedData);
+    CloseHandle(hMapping);
+    hMapping = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(pMappedData), mappedSize);
+#endif
+
+    pMappedData = nullptr;
+    mappedSize = 0;
+}
+
 void Pakfile::readIndex()
 {
     while(1) {
@@ -940,8 +940,6 @@ std::unique_ptr<Animation> PictureFactory::createMercenaryPlanet(Animation* atre
 }
 
 sdl2::surface_ptr PictureFactory::mapMentatSurfaceToMercenary(SDL_Surface* ordosMentat) {
-    auto mappedSurface = mapSurfaceColorRange(ordosMentat, PALCOLOR_ORDOS, PALCOLOR_MERCENARY);
-
     Uint8 colorMap[256];
     for(int i = 0; i < 256; i++) {
         colorMap[i] = i;
@@ -950,9 +948,7 @@ sdl2::surface_ptr PictureFactory::mapMentatSurfaceToMercenary(SDL_Surface* ordos
     colorMap[186] = 245;
     colorMap[187] = 250;
 
-    mapColor(mappedSurface.get(), colorMap);
-
-    return mappedSurface;
+    return mapSurfaceColorRange(ordosMentat, PALCOLOR_ORDOS, PALCOLOR_MERCENARY, colorMap);
 }
 
 std::unique_ptr<Animation> PictureFactory::mapMentatAnimationToFremen(Animation* fremenAnimation) {
@@ -969,8 +965,6 @@ std::unique_ptr<Animation> PictureFactory::mapMentatAnimationToFremen(Animation*
 }
 
 sdl2::surface_ptr PictureFactory::mapMentatSurfaceToSardaukar(SDL_Surface* harkonnenMentat) {
-    auto mappedSurface = mapSurfaceColorRange(harkonnenMentat, PALCOLOR_HARKONNEN, PALCOLOR_SARDAUKAR);
-
     Uint8 colorMap[256];
     for(int i = 0; i < 256; i++) {
         colorMap[i] = i;
@@ -986,9 +980,7 @@ sdl2::surface_ptr PictureFactory::mapMentatSurfaceToSardaukar(SDL_Surface* harko
     colorMap[201] = 211;
     colorMap[202] = 213;
 
-    mapColor(mappedSurface.get(), colorMap);
-
-    return mappedSurface;
+    return mapSurfaceColorRange(harkonnenMentat, PALCOLOR_HARKONNEN, PALCOLOR_SARDAUKAR, colorMap);
 }
 
 std::unique_ptr<Animation> PictureFactory::mapMentatAnimationToSardaukar(Animation* harkonnenAnimation) {
@@ -1018,8 +1010,6 @@ std::unique_ptr<Animation> PictureFactory::mapMentatAnimationToMercenary(Animati
 }
 
 sdl2::surface_ptr PictureFactory::mapMentatSurfaceToFremen(SDL_Surface* fremenMentat) {
-    sdl2::surface_ptr mappedSurface{ mapSurfaceColorRange(fremenMentat, PALCOLOR_ATREIDES, PALCOLOR_FREMEN) };
-
     Uint8 colorMap[256];
     for(int i = 0; i < 256; i++) {
         colorMap[i] = i;
@@ -1030,7 +1020,5 @@ sdl2::surface_ptr PictureFactory::mapMentatSurfaceToFremen(SDL_Surface* fremenMe
     colorMap[181] = 12;
     colorMap[182] = 12;
 
-    mapColor(mappedSurface.get(), colorMap);
-
-    return mappedSurface;
+    return mapSurfaceColorRange(fremenMentat, PALCOLOR_ATREIDES, PALCOLOR_FREMEN, colorMap);
 }
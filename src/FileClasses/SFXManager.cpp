@@ -28,6 +28,7 @@
 
 #include <misc/sound_util.h>
 #include <misc/exceptions.h>
+#include <misc/AllocationCounter.h>
 
 // Not used:
 // - EXCANNON.VOC (same as EXSMALL.VOC)
@@ -35,39 +36,124 @@
 // - POPPA.VOC
 
 SFXManager::SFXManager() {
-    // load voice and language specific sounds
+    MEMORY_TAG(MemoryTag_Sound);
+
+    // voices and sounds are loaded on first use
     if(settings.general.language == "de") {
-        loadNonEnglishVoice("G");
+        languagePrefix = "G";
     } else if(settings.general.language == "fr") {
-        loadNonEnglishVoice("F");
+        languagePrefix = "F";
     } else {
-        loadEnglishVoice();
+        languagePrefix.clear();
     }
 
-    for(int i = 0; i < NUM_SOUNDCHUNK; i++) {
-        if(soundChunk[i] == nullptr) {
-            THROW(std::runtime_error, "Not all sounds could be loaded: soundChunk[%d] == nullptr!", i);
-        }
-    }
+    const size_t numVoices = languagePrefix.empty() ? NUM_VOICE*NUM_HOUSES : NUM_VOICE;
+    lngVoice.resize(numVoices);
+    lngVoiceLastUse.resize(numVoices, 0);
 }
 
 SFXManager::~SFXManager() = default;
 
 Mix_Chunk* SFXManager::getVoice(Voice_enum id, int house) {
-    if(settings.general.language == "de" || settings.general.language == "fr") {
-        return getNonEnglishVoice(id,house);
-    } else {
-        return getEnglishVoice(id,house);
+    MEMORY_TAG(MemoryTag_Sound);
+
+    if((static_cast<unsigned int>(id) >= NUM_VOICE) || (house < 0) || (house >= NUM_HOUSES)) {
+        return nullptr;
+    }
+
+    const size_t voiceIndex = languagePrefix.empty() ? id*NUM_HOUSES + house : id;
+
+    if(lngVoice[voiceIndex] == nullptr) {
+        lngVoice[voiceIndex] = languagePrefix.empty() ? loadEnglishVoice(id, house) : loadNonEnglishVoice(id);
+        if(lngVoice[voiceIndex] == nullptr) {
+            THROW(std::runtime_error, "Voice %d of house %d could not be loaded!", id, house);
+        }
+        numLoadedVoices++;
     }
+
+    lngVoiceLastUse[voiceIndex] = ++voiceUseCounter;
+
+    if(numLoadedVoices > SFXMANAGER_MAX_LOADED_VOICES) {
+        evictLeastRecentlyUsedVoice(voiceIndex);
+    }
+
+    return lngVoice[voiceIndex].get();
 }
 
 Mix_Chunk* SFXManager::getSound(Sound_enum id) {
+    MEMORY_TAG(MemoryTag_Sound);
+
     if(id >= soundChunk.size())
         return nullptr;
 
+    if(soundChunk[id] == nullptr) {
+        soundChunk[id] = loadSound(id);
+        if(soundChunk[id] == nullptr) {
+            THROW(std::runtime_error, "Sound %d could not be loaded!", id);
+        }
+    }
+
     return soundChunk[id].get();
 }
 
+size_t SFXManager::getSoundMemory() const {
+    size_t bytes = 0;
+
+    for(const sdl2::mix_chunk_ptr& pChunk : lngVoice) {
+        if(pChunk != nullptr) {
+            bytes += pChunk->alen;
+        }
+    }
+
+    for(const sdl2::mix_chunk_ptr& pChunk : soundChunk) {
+        if(pChunk != nullptr) {
+            bytes += pChunk->alen;
+        }
+    }
+
+    return bytes;
+}
+
+void SFXManager::prewarm(int house) {
+    for(int i = 0; i < NUM_SOUNDCHUNK; i++) {
+        getSound(static_cast<Sound_enum>(i));
+    }
+
+    if((house >= 0) && (house < NUM_HOUSES)) {
+        for(int i = 0; i < NUM_VOICE; i++) {
+            getVoice(static_cast<Voice_enum>(i), house);
+        }
+    }
+}
+
+void SFXManager::evictLeastRecentlyUsedVoice(size_t keepIndex) {
+    size_t lruIndex = lngVoice.size();
+    for(size_t i = 0; i < lngVoice.size(); i++) {
+        if((i == keepIndex) || (lngVoice[i] == nullptr) || isPlaying(lngVoice[i].get())) {
+            continue;
+        }
+
+        if((lruIndex == lngVoice.size()) || (lngVoiceLastUse[i] < lngVoiceLastUse[lruIndex])) {
+            lruIndex = i;
+        }
+    }
+
+    if(lruIndex != lngVoice.size()) {
+        lngVoice[lruIndex].reset();
+        numLoadedVoices--;
+    }
+}
+
+bool SFXManager::isPlaying(const Mix_Chunk* pChunk) {
+    const int numChannels = Mix_AllocateChannels(-1);
+    for(int channel = 0; channel < numChannels; channel++) {
+        if(Mix_Playing(channel) && (Mix_GetChunk(channel) == pChunk)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 sdl2::mix_chunk_ptr SFXManager::loadMixFromADL(const std::string& adlFile, int index, int volume) const {
 
     auto rwop = pFileManager->openFile(adlFile);
@@ -75,316 +161,212 @@ sdl2::mix_chunk_ptr SFXManager::loadMixFromADL(const std::string& adlFile, int i
     pSoundAdlibPC->setVolume(volume);
     sdl2::mix_chunk_ptr chunk{ pSoundAdlibPC->getSubsong(index) };
 
-    return chunk;
+    // the emulation renders 16-bit stereo at AUDIO_FREQUENCY but the audio device may have been opened differently
+    return convertChunkToDeviceFormat(std::move(chunk), AUDIO_FREQUENCY, AUDIO_S16LSB, 2);
 }
 
-void SFXManager::loadEnglishVoice() {
-    lngVoice.clear();
-    lngVoice.resize(NUM_VOICE*NUM_HOUSES);
-
-    // now we can load
-    for(auto house = 0; house < NUM_HOUSES; house++) {
-        sdl2::mix_chunk_ptr HouseNameChunk;
-
-        std::string HouseString;
-        const int VoiceNum = house;
-        switch(house) {
-            case HOUSE_HARKONNEN:
-                HouseString = "H";
-                HouseNameChunk = getChunkFromFile(HouseString + "HARK.VOC");
-                break;
-            case HOUSE_ATREIDES:
-                HouseString = "A";
-                HouseNameChunk = getChunkFromFile(HouseString + "ATRE.VOC");
-                break;
-            case HOUSE_ORDOS:
-                HouseString = "O";
-                HouseNameChunk = getChunkFromFile(HouseString + "ORDOS.VOC");
-                break;
-            case HOUSE_FREMEN:
-                HouseString = "A";
-                HouseNameChunk = getChunkFromFile(HouseString + "FREMEN.VOC");
-                break;
-            case HOUSE_SARDAUKAR:
-                HouseString = "H";
-                HouseNameChunk = getChunkFromFile(HouseString + "SARD.VOC");
-                break;
-            case HOUSE_MERCENARY:
-                HouseString = "O";
-                HouseNameChunk = getChunkFromFile(HouseString + "MERC.VOC");
-                break;
-            default:
-                break;
-        }
+sdl2::mix_chunk_ptr SFXManager::loadEnglishVoice(Voice_enum id, int house) const {
+    std::string HouseString;
+    std::string HouseNameFile;
+    switch(house) {
+        case HOUSE_HARKONNEN:   HouseString = "H";  HouseNameFile = "HHARK.VOC";    break;
+        case HOUSE_ATREIDES:    HouseString = "A";  HouseNameFile = "AATRE.VOC";    break;
+        case HOUSE_ORDOS:       HouseString = "O";  HouseNameFile = "OORDOS.VOC";   break;
+        case HOUSE_FREMEN:      HouseString = "A";  HouseNameFile = "AFREMEN.VOC";  break;
+        case HOUSE_SARDAUKAR:   HouseString = "H";  HouseNameFile = "HSARD.VOC";    break;
+        case HOUSE_MERCENARY:   HouseString = "O";  HouseNameFile = "OMERC.VOC";    break;
+        default:                                                                    break;
+    }
 
-        { // Scope
+    switch(id) {
         // "... Harvester deployed", "... Unit deployed" and "... Unit launched"
-            auto Harvester = getChunkFromFile(HouseString + "HARVEST.VOC");
-            auto Unit = getChunkFromFile(HouseString + "UNIT.VOC");
-            auto Deployed = getChunkFromFile(HouseString + "DEPLOY.VOC");
-            auto Launched = getChunkFromFile(HouseString + "LAUNCH.VOC");
-            lngVoice[HarvesterDeployed*NUM_HOUSES + VoiceNum] = concat3Chunks(HouseNameChunk.get(), Harvester.get(), Deployed.get());
-            lngVoice[UnitDeployed*NUM_HOUSES + VoiceNum] = concat3Chunks(HouseNameChunk.get(), Unit.get(), Deployed.get());
-            lngVoice[UnitLaunched*NUM_HOUSES + VoiceNum] = concat3Chunks(HouseNameChunk.get(), Unit.get(), Launched.get());
-        }
+        case HarvesterDeployed:
+            return concat3Chunks(getChunkFromFile(HouseNameFile).get(), getChunkFromFile(HouseString + "HARVEST.VOC").get(), getChunkFromFile(HouseString + "DEPLOY.VOC").get());
+        case UnitDeployed:
+            return concat3Chunks(getChunkFromFile(HouseNameFile).get(), getChunkFromFile(HouseString + "UNIT.VOC").get(), getChunkFromFile(HouseString + "DEPLOY.VOC").get());
+        case UnitLaunched:
+            return concat3Chunks(getChunkFromFile(HouseNameFile).get(), getChunkFromFile(HouseString + "UNIT.VOC").get(), getChunkFromFile(HouseString + "LAUNCH.VOC").get());
 
         // "Contruction complete"
-        lngVoice[ConstructionComplete*NUM_HOUSES+VoiceNum] = getChunkFromFile(HouseString + "CONST.VOC");
+        case ConstructionComplete:      return getChunkFromFile(HouseString + "CONST.VOC");
 
-        { // Scope
-          // "Vehicle repaired"
-            auto Vehicle = getChunkFromFile(HouseString + "VEHICLE.VOC");
-            auto Repaired = getChunkFromFile(HouseString + "REPAIR.VOC");
-            lngVoice[VehicleRepaired*NUM_HOUSES + VoiceNum] = concat2Chunks(Vehicle.get(), Repaired.get());
-        }
+        // "Vehicle repaired"
+        case VehicleRepaired:           return concat2Chunks(getChunkFromFile(HouseString + "VEHICLE.VOC").get(), getChunkFromFile(HouseString + "REPAIR.VOC").get());
 
-        { // Scope
-          // "Frigate has arrived"
-            auto FrigateChunk = getChunkFromFile(HouseString + "FRIGATE.VOC");
-            auto HasArrivedChunk = getChunkFromFile(HouseString + "ARRIVE.VOC");
-            lngVoice[FrigateHasArrived*NUM_HOUSES + VoiceNum] = concat2Chunks(FrigateChunk.get(), HasArrivedChunk.get());
-        }
+        // "Frigate has arrived"
+        case FrigateHasArrived:         return concat2Chunks(getChunkFromFile(HouseString + "FRIGATE.VOC").get(), getChunkFromFile(HouseString + "ARRIVE.VOC").get());
 
         // "Your mission is complete"
-        lngVoice[YourMissionIsComplete*NUM_HOUSES+VoiceNum] = getChunkFromFile(HouseString + "WIN.VOC");
+        case YourMissionIsComplete:     return getChunkFromFile(HouseString + "WIN.VOC");
 
         // "You have failed your mission"
-        lngVoice[YouHaveFailedYourMission*NUM_HOUSES+VoiceNum] = getChunkFromFile(HouseString + "LOSE.VOC");
-
-        { // Scope
-          // "Radar activated"/"Radar deactivated"
-            auto RadarChunk = getChunkFromFile(HouseString + "RADAR.VOC");
-            auto RadarActivatedChunk = getChunkFromFile(HouseString + "ON.VOC");
-            auto RadarDeactivatedChunk = getChunkFromFile(HouseString + "OFF.VOC");
-            lngVoice[RadarActivated*NUM_HOUSES + VoiceNum] = concat2Chunks(RadarChunk.get(), RadarActivatedChunk.get());
-            lngVoice[RadarDeactivated*NUM_HOUSES + VoiceNum] = concat2Chunks(RadarChunk.get(), RadarDeactivatedChunk.get());
-        }
+        case YouHaveFailedYourMission:  return getChunkFromFile(HouseString + "LOSE.VOC");
 
-        { // Scope
-          // "Bloom located"
-            auto Bloom = getChunkFromFile(HouseString + "BLOOM.VOC");
-            auto Located = getChunkFromFile(HouseString + "LOCATED.VOC");
-            lngVoice[BloomLocated*NUM_HOUSES + VoiceNum] = concat2Chunks(Bloom.get(), Located.get());
-        }
+        // "Radar activated"/"Radar deactivated"
+        case RadarActivated:            return concat2Chunks(getChunkFromFile(HouseString + "RADAR.VOC").get(), getChunkFromFile(HouseString + "ON.VOC").get());
+        case RadarDeactivated:          return concat2Chunks(getChunkFromFile(HouseString + "RADAR.VOC").get(), getChunkFromFile(HouseString + "OFF.VOC").get());
 
-        { // Scope
-          // "Warning Wormsign"
-            auto WarningChunk = getChunkFromFile(HouseString + "WARNING.VOC");
-            auto WormSignChunk = getChunkFromFile(HouseString + "WORMY.VOC");
-            lngVoice[WarningWormSign*NUM_HOUSES + VoiceNum] = concat2Chunks(WarningChunk.get(), WormSignChunk.get());
-        }
+        // "Bloom located"
+        case BloomLocated:              return concat2Chunks(getChunkFromFile(HouseString + "BLOOM.VOC").get(), getChunkFromFile(HouseString + "LOCATED.VOC").get());
+
+        // "Warning Wormsign"
+        case WarningWormSign:           return concat2Chunks(getChunkFromFile(HouseString + "WARNING.VOC").get(), getChunkFromFile(HouseString + "WORMY.VOC").get());
 
         // "Our base is under attack"
-        lngVoice[BaseIsUnderAttack*NUM_HOUSES+VoiceNum] = getChunkFromFile(HouseString + "ATTACK.VOC");
-
-        { // Scope
-          // "Saboteur approaching" and "Missile approaching"
-            auto SabotChunk = getChunkFromFile(HouseString + "SABOT.VOC");
-            auto MissileChunk = getChunkFromFile(HouseString + "MISSILE.VOC");
-            auto ApproachingChunk = getChunkFromFile(HouseString + "APPRCH.VOC");
-            lngVoice[SaboteurApproaching*NUM_HOUSES + VoiceNum] = concat2Chunks(SabotChunk.get(), ApproachingChunk.get());
-            lngVoice[MissileApproaching*NUM_HOUSES + VoiceNum] = concat2Chunks(MissileChunk.get(), ApproachingChunk.get());
-        }
+        case BaseIsUnderAttack:         return getChunkFromFile(HouseString + "ATTACK.VOC");
 
-        HouseNameChunk.reset();
+        // "Saboteur approaching" and "Missile approaching"
+        case SaboteurApproaching:       return concat2Chunks(getChunkFromFile(HouseString + "SABOT.VOC").get(), getChunkFromFile(HouseString + "APPRCH.VOC").get());
+        case MissileApproaching:        return concat2Chunks(getChunkFromFile(HouseString + "MISSILE.VOC").get(), getChunkFromFile(HouseString + "APPRCH.VOC").get());
 
         // "Yes Sir"
-        lngVoice[YesSir*NUM_HOUSES+VoiceNum] = getChunkFromFile("ZREPORT1.VOC", "REPORT1.VOC");
+        case YesSir:                    return getChunkFromFile("ZREPORT1.VOC", "REPORT1.VOC");
 
         // "Reporting"
-        lngVoice[Reporting*NUM_HOUSES+VoiceNum] = getChunkFromFile("ZREPORT2.VOC", "REPORT2.VOC");
+        case Reporting:                 return getChunkFromFile("ZREPORT2.VOC", "REPORT2.VOC");
 
         // "Acknowledged"
-        lngVoice[Acknowledged*NUM_HOUSES+VoiceNum] = getChunkFromFile("ZREPORT3.VOC", "REPORT3.VOC");
+        case Acknowledged:              return getChunkFromFile("ZREPORT3.VOC", "REPORT3.VOC");
 
         // "Affirmative"
-        lngVoice[Affirmative*NUM_HOUSES+VoiceNum] = getChunkFromFile("ZAFFIRM.VOC", "AFFIRM.VOC");
+        case Affirmative:               return getChunkFromFile("ZAFFIRM.VOC", "AFFIRM.VOC");
 
         // "Moving out"
-        lngVoice[MovingOut*NUM_HOUSES+VoiceNum] = getChunkFromFile("ZMOVEOUT.VOC", "MOVEOUT.VOC");
+        case MovingOut:                 return getChunkFromFile("ZMOVEOUT.VOC", "MOVEOUT.VOC");
 
         // "Infantry out"
-        lngVoice[InfantryOut*NUM_HOUSES+VoiceNum] = getChunkFromFile("ZOVEROUT.VOC", "OVEROUT.VOC");
+        case InfantryOut:               return getChunkFromFile("ZOVEROUT.VOC", "OVEROUT.VOC");
 
         // "Somthing's under the sand"
-        lngVoice[SomethingUnderTheSand*NUM_HOUSES+VoiceNum] = getChunkFromFile("SANDBUG.VOC");
+        case SomethingUnderTheSand:     return getChunkFromFile("SANDBUG.VOC");
 
         // "House Harkonnen"
-        lngVoice[HouseHarkonnen*NUM_HOUSES+VoiceNum] = getChunkFromFile("MHARK.VOC");
+        case HouseHarkonnen:            return getChunkFromFile("MHARK.VOC");
 
         // "House Atreides"
-        lngVoice[HouseAtreides*NUM_HOUSES+VoiceNum] = getChunkFromFile("MATRE.VOC");
+        case HouseAtreides:             return getChunkFromFile("MATRE.VOC");
 
         // "House Ordos"
-        lngVoice[HouseOrdos*NUM_HOUSES+VoiceNum] = getChunkFromFile("MORDOS.VOC");
-    }
-
-    const auto bad_voice = std::find(lngVoice.cbegin(), lngVoice.cend(), nullptr);
+        case HouseOrdos:                return getChunkFromFile("MORDOS.VOC");
 
-    if (bad_voice != lngVoice.cend()) {
-        THROW(std::runtime_error, "Not all voice sounds could be loaded: lngVoice[%d] == nullptr!", static_cast<int>(bad_voice - lngVoice.cbegin()));
+        default:                        return nullptr;
     }
-
-    // Sfx
-    soundChunk[Sound_PlaceStructure] = getChunkFromFile("EXDUD.VOC");
-    soundChunk[Sound_ButtonClick] = getChunkFromFile("BUTTON.VOC");
-    soundChunk[Sound_InvalidAction] = loadMixFromADL("DUNE1.ADL", 47);
-    soundChunk[Sound_CreditsTick] = loadMixFromADL("DUNE1.ADL", 52, 4*MIX_MAX_VOLUME);
-    soundChunk[Sound_Tick] = loadMixFromADL("DUNE1.ADL", 38);
-    soundChunk[Sound_RadarNoise] = getChunkFromFile("STATICP.VOC");
-    soundChunk[Sound_ExplosionGas] = getChunkFromFile("EXGAS.VOC");
-    soundChunk[Sound_ExplosionTiny] = getChunkFromFile("EXTINY.VOC");
-    soundChunk[Sound_ExplosionSmall] = getChunkFromFile("EXSMALL.VOC");
-    soundChunk[Sound_ExplosionMedium] = getChunkFromFile("EXMED.VOC");
-    soundChunk[Sound_ExplosionLarge] = getChunkFromFile("EXLARGE.VOC");
-    soundChunk[Sound_ExplosionStructure] = getChunkFromFile("CRUMBLE.VOC");
-    soundChunk[Sound_WormAttack] = getChunkFromFile("WORMET3P.VOC");
-    soundChunk[Sound_Gun] = getChunkFromFile("GUN.VOC");
-    soundChunk[Sound_Rocket] = getChunkFromFile("ROCKET.VOC");
-    soundChunk[Sound_Bloom] = getChunkFromFile("EXSAND.VOC");
-    soundChunk[Sound_Scream1] = getChunkFromFile("VSCREAM1.VOC");
-    soundChunk[Sound_Scream2] = getChunkFromFile("VSCREAM2.VOC");
-    soundChunk[Sound_Scream3] = getChunkFromFile("VSCREAM3.VOC");
-    soundChunk[Sound_Scream4] = getChunkFromFile("VSCREAM4.VOC");
-    soundChunk[Sound_Scream5] = getChunkFromFile("VSCREAM5.VOC");
-    soundChunk[Sound_Trumpet] = loadMixFromADL("DUNE1.ADL", 30);
-    soundChunk[Sound_Drop] = loadMixFromADL("DUNE1.ADL", 24);
-    soundChunk[Sound_Squashed] = getChunkFromFile("SQUISH2.VOC");
-    soundChunk[Sound_MachineGun] = getChunkFromFile("GUNMULTI.VOC");
-    soundChunk[Sound_Sonic] = loadMixFromADL("DUNE1.ADL", 43);
-    soundChunk[Sound_RocketSmall] = getChunkFromFile("MISLTINP.VOC");
-}
-
-
-Mix_Chunk* SFXManager::getEnglishVoice(Voice_enum id, int house) const {
-    if(static_cast<size_t>(id) >= lngVoice.size())
-        return nullptr;
-
-    return lngVoice[id*NUM_HOUSES + house].get();
 }
 
-void SFXManager::loadNonEnglishVoice(const std::string& languagePrefix) {
-    lngVoice.clear();
-    lngVoice.resize(NUM_VOICE);
-
-    // "Harvester deployed"
-    lngVoice[HarvesterDeployed] = getChunkFromFile(languagePrefix + "HARVEST.VOC");
+sdl2::mix_chunk_ptr SFXManager::loadNonEnglishVoice(Voice_enum id) const {
+    switch(id) {
+        // "Harvester deployed"
+        case HarvesterDeployed:         return getChunkFromFile(languagePrefix + "HARVEST.VOC");
 
-    // "Unit deployed"
-    lngVoice[UnitDeployed] = getChunkFromFile(languagePrefix + "DEPLOY.VOC");
+        // "Unit deployed"
+        case UnitDeployed:              return getChunkFromFile(languagePrefix + "DEPLOY.VOC");
 
-    // "Unit launched"
-    lngVoice[UnitLaunched] = getChunkFromFile(languagePrefix + "VEHICLE.VOC");
+        // "Unit launched"
+        case UnitLaunched:              return getChunkFromFile(languagePrefix + "VEHICLE.VOC");
 
-    // "Contruction complete"
-    lngVoice[ConstructionComplete] = getChunkFromFile(languagePrefix + "CONST.VOC");
+        // "Contruction complete"
+        case ConstructionComplete:      return getChunkFromFile(languagePrefix + "CONST.VOC");
 
-    // "Vehicle repaired"
-    lngVoice[VehicleRepaired] = getChunkFromFile(languagePrefix + "REPAIR.VOC");
+        // "Vehicle repaired"
+        case VehicleRepaired:           return getChunkFromFile(languagePrefix + "REPAIR.VOC");
 
-    // "Frigate has arrived"
-    lngVoice[FrigateHasArrived] = getChunkFromFile(languagePrefix + "FRIGATE.VOC");
+        // "Frigate has arrived"
+        case FrigateHasArrived:         return getChunkFromFile(languagePrefix + "FRIGATE.VOC");
 
-    // "Your mission is complete" (No non-english voc available)
-    lngVoice[YourMissionIsComplete] = createEmptyChunk();
+        // "Your mission is complete" (No non-english voc available)
+        case YourMissionIsComplete:     return createEmptyChunk();
 
-    // "You have failed your mission" (No non-english voc available)
-    lngVoice[YouHaveFailedYourMission] = createEmptyChunk();
+        // "You have failed your mission" (No non-english voc available)
+        case YouHaveFailedYourMission:  return createEmptyChunk();
 
-    // "Radar activated"/"Radar deactivated"
-    lngVoice[RadarActivated] = getChunkFromFile(languagePrefix + "ON.VOC");
-    lngVoice[RadarDeactivated] = getChunkFromFile(languagePrefix + "OFF.VOC");
+        // "Radar activated"/"Radar deactivated"
+        case RadarActivated:            return getChunkFromFile(languagePrefix + "ON.VOC");
+        case RadarDeactivated:          return getChunkFromFile(languagePrefix + "OFF.VOC");
 
-    // "Bloom located"
-    lngVoice[BloomLocated] = getChunkFromFile(languagePrefix + "BLOOM.VOC");
+        // "Bloom located"
+        case BloomLocated:              return getChunkFromFile(languagePrefix + "BLOOM.VOC");
 
-    // "Warning Wormsign"
-    if(pFileManager->exists(languagePrefix + "WORMY.VOC")) {
-        auto WarningChunk = getChunkFromFile(languagePrefix + "WARNING.VOC");
-        auto WormSignChunk = getChunkFromFile(languagePrefix + "WORMY.VOC");
-        lngVoice[WarningWormSign] = concat2Chunks(WarningChunk.get(), WormSignChunk.get());
-    } else {
-        lngVoice[WarningWormSign] = getChunkFromFile(languagePrefix + "WARNING.VOC");
-    }
+        // "Warning Wormsign"
+        case WarningWormSign: {
+            if(pFileManager->exists(languagePrefix + "WORMY.VOC")) {
+                return concat2Chunks(getChunkFromFile(languagePrefix + "WARNING.VOC").get(), getChunkFromFile(languagePrefix + "WORMY.VOC").get());
+            } else {
+                return getChunkFromFile(languagePrefix + "WARNING.VOC");
+            }
+        }
 
-    // "Our base is under attack"
-    lngVoice[BaseIsUnderAttack] = getChunkFromFile(languagePrefix + "ATTACK.VOC");
+        // "Our base is under attack"
+        case BaseIsUnderAttack:         return getChunkFromFile(languagePrefix + "ATTACK.VOC");
 
-    // "Saboteur approaching"
-    lngVoice[SaboteurApproaching] = getChunkFromFile(languagePrefix + "SABOT.VOC");
+        // "Saboteur approaching"
+        case SaboteurApproaching:       return getChunkFromFile(languagePrefix + "SABOT.VOC");
 
-    // "Missile approaching"
-    lngVoice[MissileApproaching] = getChunkFromFile(languagePrefix + "MISSILE.VOC");
+        // "Missile approaching"
+        case MissileApproaching:        return getChunkFromFile(languagePrefix + "MISSILE.VOC");
 
         // "Yes Sir"
-    lngVoice[YesSir] = getChunkFromFile(languagePrefix + "REPORT1.VOC");
-
-    // "Reporting"
-    lngVoice[Reporting] = getChunkFromFile(languagePrefix + "REPORT2.VOC");
+        case YesSir:                    return getChunkFromFile(languagePrefix + "REPORT1.VOC");
 
-    // "Acknowledged"
-    lngVoice[Acknowledged] = getChunkFromFile(languagePrefix + "REPORT3.VOC");
+        // "Reporting"
+        case Reporting:                 return getChunkFromFile(languagePrefix + "REPORT2.VOC");
 
-    // "Affirmative"
-    lngVoice[Affirmative] = getChunkFromFile(languagePrefix + "AFFIRM.VOC");
+        // "Acknowledged"
+        case Acknowledged:              return getChunkFromFile(languagePrefix + "REPORT3.VOC");
 
-    // "Moving out"
-    lngVoice[MovingOut] = getChunkFromFile(languagePrefix + "MOVEOUT.VOC");
+        // "Affirmative"
+        case Affirmative:               return getChunkFromFile(languagePrefix + "AFFIRM.VOC");
 
-    // "Infantry out"
-    lngVoice[InfantryOut] = getChunkFromFile(languagePrefix + "OVEROUT.VOC");
+        // "Moving out"
+        case MovingOut:                 return getChunkFromFile(languagePrefix + "MOVEOUT.VOC");
 
-    // "Somthing's under the sand"
-    lngVoice[SomethingUnderTheSand] = getChunkFromFile("SANDBUG.VOC");
+        // "Infantry out"
+        case InfantryOut:               return getChunkFromFile(languagePrefix + "OVEROUT.VOC");
 
-    // "House Atreides"
-    lngVoice[HouseAtreides] = getChunkFromFile(languagePrefix + "ATRE.VOC");
+        // "Somthing's under the sand"
+        case SomethingUnderTheSand:     return getChunkFromFile("SANDBUG.VOC");
 
-    // "House Ordos"
-    lngVoice[HouseOrdos] = getChunkFromFile(languagePrefix + "ORDOS.VOC");
+        // "House Atreides"
+        case HouseAtreides:             return getChunkFromFile(languagePrefix + "ATRE.VOC");
 
-    // "House Harkonnen"
-    lngVoice[HouseHarkonnen] = getChunkFromFile(languagePrefix + "HARK.VOC");
+        // "House Ordos"
+        case HouseOrdos:                return getChunkFromFile(languagePrefix + "ORDOS.VOC");
 
-    const auto bad_voice = std::find(lngVoice.cbegin(), lngVoice.cend(), nullptr);
+        // "House Harkonnen"
+        case HouseHarkonnen:            return getChunkFromFile(languagePrefix + "HARK.VOC");
 
-    if (bad_voice != lngVoice.cend()) {
-        THROW(std::runtime_error, "Not all voice sounds could be loaded: lngVoice[%d] == nullptr!", static_cast<int>(bad_voice - lngVoice.cbegin()));
+        default:                        return nullptr;
     }
-
-    // Sfx
-    soundChunk[Sound_PlaceStructure] = getChunkFromFile("EXDUD.VOC");
-    soundChunk[Sound_ButtonClick] = getChunkFromFile("BUTTON.VOC");
-    soundChunk[Sound_InvalidAction] = loadMixFromADL("DUNE1.ADL", 47);
-    soundChunk[Sound_CreditsTick] = loadMixFromADL("DUNE1.ADL", 52, 4*MIX_MAX_VOLUME);
-    soundChunk[Sound_Tick] = loadMixFromADL("DUNE1.ADL", 38);
-    soundChunk[Sound_RadarNoise] = getChunkFromFile("STATICP.VOC");
-    soundChunk[Sound_ExplosionGas] = getChunkFromFile("EXGAS.VOC");
-    soundChunk[Sound_ExplosionTiny] = getChunkFromFile("EXTINY.VOC");
-    soundChunk[Sound_ExplosionSmall] = getChunkFromFile("EXSMALL.VOC");
-    soundChunk[Sound_ExplosionMedium] = getChunkFromFile("EXMED.VOC");
-    soundChunk[Sound_ExplosionLarge] = getChunkFromFile("EXLARGE.VOC");
-    soundChunk[Sound_ExplosionStructure] = getChunkFromFile("CRUMBLE.VOC");
-    soundChunk[Sound_WormAttack] = getChunkFromFile("WORMET3P.VOC");
-    soundChunk[Sound_Gun] = getChunkFromFile("GUN.VOC");
-    soundChunk[Sound_Rocket] = getChunkFromFile("ROCKET.VOC");
-    soundChunk[Sound_Bloom] = getChunkFromFile("EXSAND.VOC");
-    soundChunk[Sound_Scream1] = getChunkFromFile("VSCREAM1.VOC");
-    soundChunk[Sound_Scream2] = getChunkFromFile("VSCREAM2.VOC");
-    soundChunk[Sound_Scream3] = getChunkFromFile("VSCREAM3.VOC");
-    soundChunk[Sound_Scream4] = getChunkFromFile("VSCREAM4.VOC");
-    soundChunk[Sound_Scream5] = getChunkFromFile("VSCREAM5.VOC");
-    soundChunk[Sound_Trumpet] = loadMixFromADL("DUNE1.ADL", 30);
-    soundChunk[Sound_Drop] = loadMixFromADL("DUNE1.ADL", 24);
-    soundChunk[Sound_Squashed] = getChunkFromFile("SQUISH2.VOC");
-    soundChunk[Sound_MachineGun] = getChunkFromFile("GUNMULTI.VOC");
-    soundChunk[Sound_Sonic] = loadMixFromADL("DUNE1.ADL", 43);
-    soundChunk[Sound_RocketSmall] = getChunkFromFile("MISLTINP.VOC");
 }
 
-Mix_Chunk* SFXManager::getNonEnglishVoice(Voice_enum id, int house) const {
-    if(static_cast<size_t>(id) >= lngVoice.size())
-        return nullptr;
-
-    return lngVoice[id].get();
+sdl2::mix_chunk_ptr SFXManager::loadSound(Sound_enum id) const {
+    switch(id) {
+        case Sound_PlaceStructure:      return getChunkFromFile("EXDUD.VOC");
+        case Sound_ButtonClick:         return getChunkFromFile("BUTTON.VOC");
+        case Sound_InvalidAction:       return loadMixFromADL("DUNE1.ADL", 47);
+        case Sound_CreditsTick:         return loadMixFromADL("DUNE1.ADL", 52, 4*MIX_MAX_VOLUME);
+        case Sound_Tick:                return loadMixFromADL("DUNE1.ADL", 38);
+        case Sound_RadarNoise:          return getChunkFromFile("STATICP.VOC");
+        case Sound_ExplosionGas:        return getChunkFromFile("EXGAS.VOC");
+        case Sound_ExplosionTiny:       return getChunkFromFile("EXTINY.VOC");
+        case Sound_ExplosionSmall:      return getChunkFromFile("EXSMALL.VOC");
+        case Sound_ExplosionMedium:     return getChunkFromFile("EXMED.VOC");
+        case Sound_ExplosionLarge:      return getChunkFromFile("EXLARGE.VOC");
+        case Sound_ExplosionStructure:  return getChunkFromFile("CRUMBLE.VOC");
+        case Sound_WormAttack:          return getChunkFromFile("WORMET3P.VOC");
+        case Sound_Gun:                 return getChunkFromFile("GUN.VOC");
+        case Sound_Rocket:              return getChunkFromFile("ROCKET.VOC");
+        case Sound_Bloom:               return getChunkFromFile("EXSAND.VOC");
+        case Sound_Scream1:             return getChunkFromFile("VSCREAM1.VOC");
+        case Sound_Scream2:             return getChunkFromFile("VSCREAM2.VOC");
+        case Sound_Scream3:             return getChunkFromFile("VSCREAM3.VOC");
+        case Sound_Scream4:             return getChunkFromFile("VSCREAM4.VOC");
+        case Sound_Scream5:             return getChunkFromFile("VSCREAM5.VOC");
+        case Sound_Trumpet:             return loadMixFromADL("DUNE1.ADL", 30);
+        case Sound_Drop:                return loadMixFromADL("DUNE1.ADL", 24);
+        case Sound_Squashed:            return getChunkFromFile("SQUISH2.VOC");
+        case Sound_MachineGun:          return getChunkFromFile("GUNMULTI.VOC");
+        case Sound_Sonic:               return loadMixFromADL("DUNE1.ADL", 43);
+        case Sound_RocketSmall:         return getChunkFromFile("MISLTINP.VOC");
+        default:                        return nullptr;
+    }
 }
@@ -0,0 +1,134 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <FileClasses/SaveQOI.h>
+
+#include <misc/draw_util.h>
+
+#include <vector>
+
+#define QOI_OP_INDEX    0x00    ///< 00xxxxxx: index into the table of recently seen pixels
+#define QOI_OP_DIFF     0x40    ///< 01xxxxxx: small difference to the previous pixel
+#define QOI_OP_LUMA     0x80    ///< 10xxxxxx: difference to the previous pixel guided by green
+#define QOI_OP_RUN      0xc0    ///< 11xxxxxx: repeat the previous pixel
+#define QOI_OP_RGB      0xfe    ///< followed by r, g, b
+#define QOI_OP_RGBA     0xff    ///< followed by r, g, b, a
+
+#define QOI_MAX_RUN     62
+
+namespace {
+
+struct QOIPixel {
+    Uint8 r, g, b, a;
+
+    bool operator==(const QOIPixel& p) const {
+        return (r == p.r) && (g == p.g) && (b == p.b) && (a == p.a);
+    }
+
+    int getHash() const {
+        return (r*3 + g*5 + b*7 + a*11) % 64;
+    }
+};
+
+void write32BE(std::vector<Uint8>& out, Uint32 value) {
+    out.push_back(static_cast<Uint8>(value >> 24));
+    out.push_back(static_cast<Uint8>(value >> 16));
+    out.push_back(static_cast<Uint8>(value >> 8));
+    out.push_back(static_cast<Uint8>(value));
+}
+
+}
+
+int SaveQOI_RW(SDL_Surface* surface, SDL_RWops* RWop) {
+    if((surface == nullptr) || (RWop == nullptr)) {
+        return -1;
+    }
+
+    const std::vector<unsigned char> image = getSurfaceRGBA(surface);
+    const size_t numPixels = image.size() / 4;
+
+    std::vector<Uint8> out;
+    out.reserve(14 + numPixels*2 + 8);
+
+    // header
+    out.insert(out.end(), { 'q', 'o', 'i', 'f' });
+    write32BE(out, surface->w);
+    write32BE(out, surface->h);
+    out.push_back(4);   // channels
+    out.push_back(0);   // sRGB with linear alpha
+
+    QOIPixel index[64] = {};
+    QOIPixel prev = { 0, 0, 0, 255 };
+    int run = 0;
+
+    for(size_t i = 0; i < numPixels; i++) {
+        const QOIPixel px = { image[4*i], image[4*i+1], image[4*i+2], image[4*i+3] };
+
+        if(px == prev) {
+            run++;
+            if((run == QOI_MAX_RUN) || (i == numPixels - 1)) {
+                out.push_back(QOI_OP_RUN | (run - 1));
+                run = 0;
+            }
+            continue;
+        }
+
+        if(run > 0) {
+            out.push_back(QOI_OP_RUN | (run - 1));
+            run = 0;
+        }
+
+        const int hash = px.getHash();
+        if(index[hash] == px) {
+            out.push_back(QOI_OP_INDEX | hash);
+        } else {
+            index[hash] = px;
+
+            if(px.a == prev.a) {
+                const int vr = static_cast<Sint8>(px.r - prev.r);
+                const int vg = static_cast<Sint8>(px.g - prev.g);
+                const int vb = static_cast<Sint8>(px.b - prev.b);
+                const int vgr = vr - vg;
+                const int vgb = vb - vg;
+
+                if((vr >= -2) && (vr <= 1) && (vg >= -2) && (vg <= 1) && (vb >= -2) && (vb <= 1)) {
+                    out.push_back(QOI_OP_DIFF | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2));
+                } else if((vgr >= -8) && (vgr <= 7) && (vg >= -32) && (vg <= 31) && (vgb >= -8) && (vgb <= 7)) {
+                    out.push_back(QOI_OP_LUMA | (vg + 32));
+                    out.push_back(((vgr + 8) << 4) | (vgb + 8));
+                } else {
+                    out.insert(out.end(), { QOI_OP_RGB, px.r, px.g, px.b });
+                }
+            } else {
+                out.insert(out.end(), { QOI_OP_RGBA, px.r, px.g, px.b, px.a });
+            }
+        }
+
+        prev = px;
+    }
+
+    // end marker
+    out.insert(out.end(), { 0, 0, 0, 0, 0, 0, 0, 1 });
+
+    if(SDL_RWwrite(RWop, out.data(), 1, out.size()) != out.size()) {
+        SDL_Log("%s", SDL_GetError());
+        return -1;
+    }
+
+    return 0;
+}
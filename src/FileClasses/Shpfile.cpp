@@ -18,6 +18,7 @@
 #include <FileClasses/Shpfile.h>
 #include <FileClasses/Decode.h>
 #include <FileClasses/Palette.h>
+#include <FileClasses/Pakfile.h>
 #include <misc/exceptions.h>
 
 #include <Definitions.h>
@@ -31,7 +32,7 @@ extern Palette palette;
 /// Constructor
 /**
     The constructor reads from the rwop all data and saves them internally. The SDL_RWops can be readonly but must support
-    seeking.
+    seeking. Files inside a memory-mapped PAK-File are not copied but used in place.
     \param  rwop    SDL_RWops to the shp-File. (can be readonly)
 */
 Shpfile::Shpfile(SDL_RWops* rwop)
@@ -46,10 +47,17 @@ Shpfile::Shpfile(SDL_RWops* rwop)
     }
 
     shpFilesize = static_cast<size_t>(endOffset);
-    pFiledata = std::make_unique<unsigned char[]>(shpFilesize);
 
-    if(SDL_RWread(rwop, pFiledata.get(), shpFilesize, 1) != 1) {
-        THROW(std::runtime_error, "Shpfile::Shpfile(): Reading this *.shp-File failed!");
+    size_t mappedSize = 0;
+    pFiledata = Pakfile::getMappedData(rwop, &mappedSize);
+    if((pFiledata == nullptr) || (mappedSize != shpFilesize)) {
+        pOwnedFiledata = std::make_unique<unsigned char[]>(shpFilesize);
+
+        if(SDL_RWread(rwop, pOwnedFiledata.get(), shpFilesize, 1) != 1) {
+            THROW(std::runtime_error, "Shpfile::Shpfile(): Reading this *.shp-File failed!");
+        }
+
+        pFiledata = pOwnedFiledata.get();
     }
 
     readIndex();
@@ -73,7 +81,7 @@ sdl2::surface_ptr Shpfile::getPicture(Uint32 indexOfFile)
         THROW(std::invalid_argument, "Shpfile::getPicture(): Requested index %ud is invalid for a shp file with %ud entries!", indexOfFile, shpfileEntries.size());
     }
 
-    const unsigned char * Fileheader = pFiledata.get() + shpfileEntries[indexOfFile].startOffset;
+    const unsigned char * Fileheader = pFiledata + shpfileEntries[indexOfFile].startOffset;
 
     const unsigned char type = Fileheader[0];
 
@@ -94,7 +102,7 @@ sdl2::surface_ptr Shpfile::getPicture(Uint32 indexOfFile)
             DecodeDestination.clear();
             DecodeDestination.resize(size);
 
-            if(decode80(Fileheader + 10, &DecodeDestination[0], size) == -1) {
+            if(decode80(Fileheader + 10, getRemainingSize(Fileheader + 10), &DecodeDestination[0], size, size) == -1) {
                 SDL_Log("Warning: Checksum-Error in Shp-File!");
             }
 
@@ -106,7 +114,7 @@ sdl2::surface_ptr Shpfile::getPicture(Uint32 indexOfFile)
             DecodeDestination.clear();
             DecodeDestination.resize(size);
 
-            if(decode80(Fileheader + 10 + 16, &DecodeDestination[0], size) == -1) {
+            if(decode80(Fileheader + 10 + 16, getRemainingSize(Fileheader + 10 + 16), &DecodeDestination[0], size, size) == -1) {
                 SDL_Log("Warning: Checksum-Error in Shp-File!");
             }
 
@@ -196,7 +204,7 @@ sdl2::surface_ptr Shpfile::getPictureArray(unsigned int tilesX, unsigned int til
 
     va_end(arg_ptr);
 
-    unsigned char* pData = pFiledata.get();
+    const unsigned char* pData = pFiledata;
 
     unsigned char sizeY = (pData + shpfileEntries[TILE_GETINDEX(tiles[0])].startOffset)[2];
     unsigned char sizeX = (pData + shpfileEntries[TILE_GETINDEX(tiles[0])].startOffset)[3];
@@ -238,7 +246,7 @@ sdl2::surface_ptr Shpfile::getPictureArray(unsigned int tilesX, unsigned int til
                     DecodeDestination.clear();
                     DecodeDestination.resize(size);
 
-                    if(decode80(Fileheader + 10,&DecodeDestination[0],size) == -1) {
+                    if(decode80(Fileheader + 10, getRemainingSize(Fileheader + 10), &DecodeDestination[0], size, size) == -1) {
                         SDL_Log("Warning: Checksum-Error in Shp-File!");
                     }
 
@@ -250,7 +258,7 @@ sdl2::surface_ptr Shpfile::getPictureArray(unsigned int tilesX, unsigned int til
                     DecodeDestination.clear();
                     DecodeDestination.resize(size);
 
-                    if(decode80(Fileheader + 10 + 16, &DecodeDestination[0], size) == -1) {
+                    if(decode80(Fileheader + 10 + 16, getRemainingSize(Fileheader + 10 + 16), &DecodeDestination[0], size, size) == -1) {
                         SDL_Log("Warning: Checksum-Error in Shp-File!");
                     }
 
@@ -360,7 +368,7 @@ std::unique_ptr<Animation> Shpfile::getAnimation(unsigned int startindex,unsigne
 void Shpfile::readIndex()
 {
     // First get number of files in shp-file
-    Uint16 NumFiles = SDL_SwapLE16(reinterpret_cast<const Uint16 *>(pFiledata.get())[0]);
+    Uint16 NumFiles = SDL_SwapLE16(reinterpret_cast<const Uint16 *>(pFiledata)[0]);
 
     if(NumFiles == 0) {
         THROW(std::runtime_error, "Shpfile::readIndex(): There is no file in this shp-File!");
@@ -370,14 +378,14 @@ void Shpfile::readIndex()
         /* files with only one image might be different */
 
         ShpfileEntry newShpfileEntry;
-        if ((reinterpret_cast<const Uint16*>( pFiledata.get()))[2] != 0) {
+        if ((reinterpret_cast<const Uint16*>( pFiledata))[2] != 0) {
             /* File has special header with only 2 byte offset */
-            newShpfileEntry.startOffset = static_cast<Uint32>(reinterpret_cast<const Uint16 *>(pFiledata.get())[1]);
-            newShpfileEntry.endOffset = static_cast<Uint32>(reinterpret_cast<const Uint16 *>(pFiledata.get())[2]) - 1;
+            newShpfileEntry.startOffset = static_cast<Uint32>(reinterpret_cast<const Uint16 *>(pFiledata)[1]);
+            newShpfileEntry.endOffset = static_cast<Uint32>(reinterpret_cast<const Uint16 *>(pFiledata)[2]) - 1;
         } else {
             /* File has normal 4 byte offsets */
-            newShpfileEntry.startOffset = static_cast<Uint32>(*reinterpret_cast<const Uint32 *>(pFiledata.get()+2)) + 2;
-            newShpfileEntry.endOffset = static_cast<Uint32>(reinterpret_cast<const Uint16 *>(pFiledata.get())[3]) - 1 + 2;
+            newShpfileEntry.startOffset = static_cast<Uint32>(*reinterpret_cast<const Uint32 *>(pFiledata+2)) + 2;
+            newShpfileEntry.endOffset = static_cast<Uint32>(reinterpret_cast<const Uint16 *>(pFiledata)[3]) - 1 + 2;
         }
 
         shpfileEntries.push_back(newShpfileEntry);
@@ -385,7 +393,7 @@ void Shpfile::readIndex()
     } else {
         /* File contains more than one image */
 
-        if (reinterpret_cast<const Uint16 *>(pFiledata.get())[2] != 0) {
+        if (reinterpret_cast<const Uint16 *>(pFiledata)[2] != 0) {
             /* File has special header with only 2 byte offset */
 
             if( shpFilesize < static_cast<Uint32>((NumFiles * 2) + 2 + 2)) {
@@ -395,7 +403,7 @@ void Shpfile::readIndex()
             // now fill Index with start and end-offsets
             for(int i = 0; i < NumFiles; i++) {
                 ShpfileEntry newShpfileEntry;
-                newShpfileEntry.startOffset = SDL_SwapLE16(reinterpret_cast<const Uint16 *>(pFiledata.get() + 2)[i]);
+                newShpfileEntry.startOffset = SDL_SwapLE16(reinterpret_cast<const Uint16 *>(pFiledata + 2)[i]);
 
                 if(shpfileEntries.empty() == false) {
                     shpfileEntries.back().endOffset = newShpfileEntry.startOffset - 1;
@@ -409,7 +417,7 @@ void Shpfile::readIndex()
             }
 
             // Add the endOffset for the last file
-            shpfileEntries.back().endOffset = static_cast<Uint32>(*reinterpret_cast<const Uint16 *>(pFiledata.get()+ 2 +(NumFiles * 2))) - 1 + 2;
+            shpfileEntries.back().endOffset = static_cast<Uint32>(*reinterpret_cast<const Uint16 *>(pFiledata+ 2 +(NumFiles * 2))) - 1 + 2;
         } else {
             /* File has normal 4 byte offsets */
 
@@ -420,7 +428,7 @@ void Shpfile::readIndex()
             // now fill Index with start and end-offsets
             for(auto i = 0; i < NumFiles; i++) {
                 ShpfileEntry newShpfileEntry;
-                newShpfileEntry.startOffset = SDL_SwapLE32( (reinterpret_cast<const Uint32*>(pFiledata.get() + 2))[i]) + 2;
+                newShpfileEntry.startOffset = SDL_SwapLE32( (reinterpret_cast<const Uint32*>(pFiledata + 2))[i]) + 2;
 
                 if (shpfileEntries.empty() == false) {
                     shpfileEntries.back().endOffset = newShpfileEntry.startOffset - 1;
@@ -434,11 +442,22 @@ void Shpfile::readIndex()
             }
 
             // Add the endOffset for the last file
-            shpfileEntries.back().endOffset = static_cast<Uint32>(*reinterpret_cast<const Uint16 *>(pFiledata.get()+ 2 +(NumFiles * 4))) - 1 + 2;
+            shpfileEntries.back().endOffset = static_cast<Uint32>(*reinterpret_cast<const Uint16 *>(pFiledata+ 2 +(NumFiles * 4))) - 1 + 2;
         }
     }
 }
 
+/// Helper method for the number of bytes between p and the end of this shp-File
+/**
+    \param  p   pointer into the data of this shp-File
+    \return the number of bytes from p to the end of the file or 0 if p is beyond the end
+*/
+size_t Shpfile::getRemainingSize(const unsigned char* p) const
+{
+    const unsigned char* const pEnd = pFiledata + shpFilesize;
+    return (p < pEnd) ? static_cast<size_t>(pEnd - p) : 0;
+}
+
 /// Helper method for correcting the decoded picture.
 /**
     This helper method corrects the decoded picture.
@@ -0,0 +1,411 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FileClasses/SurfaceCache.h>
+
+#include <misc/md5.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define SURFACECACHE_MAGIC          "DLSC"
+#define SURFACECACHE_HEADERSIZE     48
+#define SURFACECACHE_ENTRYSIZE      24
+#define SURFACECACHE_ALIGNMENT      16
+
+static void appendUint16(std::vector<Uint8>& data, Uint16 x) {
+    data.push_back(x & 0xFF);
+    data.push_back((x >> 8) & 0xFF);
+}
+
+static void appendUint32(std::vector<Uint8>& data, Uint32 x) {
+    appendUint16(data, x & 0xFFFF);
+    appendUint16(data, (x >> 16) & 0xFFFF);
+}
+
+static void setUint32(std::vector<Uint8>& data, size_t offset, Uint32 x) {
+    data[offset] = x & 0xFF;
+    data[offset+1] = (x >> 8) & 0xFF;
+    data[offset+2] = (x >> 16) & 0xFF;
+    data[offset+3] = (x >> 24) & 0xFF;
+}
+
+static Uint16 getUint16(const Uint8* pData) {
+    return pData[0] | (pData[1] << 8);
+}
+
+static Uint32 getUint32(const Uint8* pData) {
+    return getUint16(pData) | (getUint16(pData + 2) << 16);
+}
+
+SurfaceCache::SurfaceCache(const std::string& filename, const std::string& sourceKey)
+ : filename(filename) {
+    md5((const unsigned char*) sourceKey.c_str(), sourceKey.size(), sourceChecksum);
+
+    if(!load()) {
+        unmapFile();
+        palettes.clear();
+        entries.clear();
+    }
+}
+
+SurfaceCache::~SurfaceCache() {
+    unmapFile();
+}
+
+sdl2::surface_ptr SurfaceCache::getSurface(Uint32 key) const {
+    const auto iter = entries.find(key);
+    if(iter == entries.end()) {
+        return nullptr;
+    }
+
+    const Entry& entry = iter->second;
+    const bool bShared = bMapped && entry.pixels.empty();
+
+    // surfaces from the mapping use the shared pages in place, all others get their own copy
+    sdl2::surface_ptr pSurface{ bShared ? SDL_CreateRGBSurfaceFrom(const_cast<Uint8*>(getPixels(entry)), entry.width, entry.height, 8, entry.pitch, 0, 0, 0, 0)
+                                        : SDL_CreateRGBSurface(0, entry.width, entry.height, 8, 0, 0, 0, 0) };
+    if(pSurface == nullptr) {
+        return nullptr;
+    }
+
+    const std::vector<SDL_Color>& palette = palettes[entry.paletteIndex];
+    SDL_SetPaletteColors(pSurface->format->palette, palette.data(), 0, std::min((int) palette.size(), pSurface->format->palette->ncolors));
+
+    if(entry.colorKey != SURFACECACHE_NO_COLORKEY) {
+        SDL_SetColorKey(pSurface.get(), SDL_TRUE, entry.colorKey);
+    }
+
+    if(bShared) {
+        return pSurface;
+    }
+
+    sdl2::surface_lock lock{ pSurface.get() };
+
+    const Uint8* pSrc = getPixels(entry);
+    Uint8* pDest = (Uint8*) pSurface->pixels;
+    if((Uint32) pSurface->pitch == entry.pitch) {
+        memcpy(pDest, pSrc, entry.pitch * entry.height);
+    } else {
+        for(int y = 0; y < entry.height; y++) {
+            memcpy(pDest + y*pSurface->pitch, pSrc + y*entry.pitch, entry.width);
+        }
+    }
+
+    return pSurface;
+}
+
+void SurfaceCache::putSurface(Uint32 key, SDL_Surface* pSurface) {
+    if((pSurface == nullptr) || (pSurface->format->BitsPerPixel != 8) || (pSurface->format->palette == nullptr)
+        || (pSurface->w > 0xFFFF) || (pSurface->h > 0xFFFF)) {
+        return;
+    }
+
+    const SDL_Palette* pPalette = pSurface->format->palette;
+    std::vector<SDL_Color> palette(pPalette->colors, pPalette->colors + pPalette->ncolors);
+
+    auto paletteIter = std::find_if(palettes.begin(), palettes.end(), [&palette](const std::vector<SDL_Color>& other) {
+        return (other.size() == palette.size()) && (memcmp(other.data(), palette.data(), palette.size()*sizeof(SDL_Color)) == 0);
+    });
+
+    Entry entry;
+    entry.width = pSurface->w;
+    entry.height = pSurface->h;
+    entry.pitch = (pSurface->w + 3) & ~3;
+    entry.paletteIndex = std::distance(palettes.begin(), paletteIter);
+    entry.fileOffset = 0;
+
+    Uint32 colorKey;
+    entry.colorKey = (SDL_GetColorKey(pSurface, &colorKey) == 0) ? colorKey : SURFACECACHE_NO_COLORKEY;
+
+    if(paletteIter == palettes.end()) {
+        palettes.push_back(std::move(palette));
+    }
+
+    entry.pixels.resize(entry.pitch * entry.height);
+
+    sdl2::surface_lock lock{ pSurface };
+    for(int y = 0; y < entry.height; y++) {
+        memcpy(entry.pixels.data() + y*entry.pitch, ((const Uint8*) pSurface->pixels) + y*pSurface->pitch, entry.width);
+    }
+
+    entries[key] = std::move(entry);
+    bModified = true;
+}
+
+bool SurfaceCache::save() {
+    if(!bModified) {
+        return true;
+    }
+
+    std::vector<Uint8> data;
+    data.insert(data.end(), SURFACECACHE_MAGIC, SURFACECACHE_MAGIC + 4);
+    appendUint32(data, SURFACECACHE_VERSION);
+    data.insert(data.end(), sourceChecksum, sourceChecksum + 16);
+    data.resize(data.size() + 16);  // content checksum is filled in below
+    appendUint32(data, palettes.size());
+    appendUint32(data, entries.size());
+
+    for(const std::vector<SDL_Color>& palette : palettes) {
+        appendUint32(data, palette.size());
+        for(const SDL_Color& color : palette) {
+            data.push_back(color.r);
+            data.push_back(color.g);
+            data.push_back(color.b);
+            data.push_back(color.a);
+        }
+    }
+
+    const size_t entryTableOffset = data.size();
+    data.resize(data.size() + entries.size() * SURFACECACHE_ENTRYSIZE);
+
+    size_t entryOffset = entryTableOffset;
+    for(const auto& keyEntryPair : entries) {
+        const Entry& entry = keyEntryPair.second;
+
+        data.resize((data.size() + SURFACECACHE_ALIGNMENT - 1) & ~(SURFACECACHE_ALIGNMENT - 1));
+        const size_t pixelOffset = data.size();
+        const Uint8* pPixels = getPixels(entry);
+        data.insert(data.end(), pPixels, pPixels + entry.pitch * entry.height);
+
+        setUint32(data, entryOffset, keyEntryPair.first);
+        setUint32(data, entryOffset + 4, entry.width | (entry.height << 16));
+        setUint32(data, entryOffset + 8, entry.pitch);
+        setUint32(data, entryOffset + 12, entry.colorKey);
+        setUint32(data, entryOffset + 16, entry.paletteIndex);
+        setUint32(data, entryOffset + 20, pixelOffset);
+        entryOffset += SURFACECACHE_ENTRYSIZE;
+    }
+
+    md5(data.data() + SURFACECACHE_HEADERSIZE, data.size() - SURFACECACHE_HEADERSIZE, data.data() + 24);
+
+    // other processes (and the surfaces of this one) may still use the mapping of the current file, so it must not be overwritten in place
+#ifdef _WIN32
+    const std::string tmpFilename = filename + "." + std::to_string(GetCurrentProcessId()) + ".tmp";
+#else
+    const std::string tmpFilename = filename + "." + std::to_string(getpid()) + ".tmp";
+#endif
+
+    sdl2::RWops_ptr file{ SDL_RWFromFile(tmpFilename.c_str(), "wb") };
+    if(file == nullptr) {
+        SDL_Log("SurfaceCache: Cannot open '%s' for writing: %s", tmpFilename.c_str(), SDL_GetError());
+        return false;
+    }
+
+    if(SDL_RWwrite(file.get(), data.data(), 1, data.size()) != data.size()) {
+        SDL_Log("SurfaceCache: Cannot write '%s': %s", tmpFilename.c_str(), SDL_GetError());
+        file.reset();
+        remove(tmpFilename.c_str());
+        return false;
+    }
+    file.reset();
+
+#ifdef _WIN32
+    // fails while the old file is mapped by any process; the old file then stays in use until the next run
+    WCHAR szwFilename[MAX_PATH];
+    WCHAR szwTmpFilename[MAX_PATH];
+    const bool bRenamed = (MultiByteToWideChar(CP_UTF8, 0, filename.c_str(), -1, szwFilename, MAX_PATH) != 0)
+                            && (MultiByteToWideChar(CP_UTF8, 0, tmpFilename.c_str(), -1, szwTmpFilename, MAX_PATH) != 0)
+                            && (MoveFileExW(szwTmpFilename, szwFilename, MOVEFILE_REPLACE_EXISTING) != 0);
+#else
+    const bool bRenamed = (rename(tmpFilename.c_str(), filename.c_str()) == 0);
+#endif
+    if(!bRenamed) {
+        SDL_Log("SurfaceCache: Cannot replace '%s'; it is probably in use by another process", filename.c_str());
+        remove(tmpFilename.c_str());
+        return false;
+    }
+
+    bModified = false;
+    return true;
+}
+
+bool SurfaceCache::load() {
+    sdl2::RWops_ptr file{ SDL_RWFromFile(filename.c_str(), "rb") };
+    if(file == nullptr) {
+        return false;
+    }
+
+    if(SDL_RWsize(file.get()) < SURFACECACHE_HEADERSIZE) {
+        return false;
+    }
+
+    mapFile(file.get());
+
+    if(!bMapped) {
+        fileBuffer.resize(SDL_RWsize(file.get()));
+        if(SDL_RWread(file.get(), fileBuffer.data(), 1, fileBuffer.size()) != fileBuffer.size()) {
+            return false;
+        }
+        pFileData = fileBuffer.data();
+        fileSize = fileBuffer.size();
+    }
+
+    const Uint8* pHeader = pFileData;
+    if((memcmp(pHeader, SURFACECACHE_MAGIC, 4) != 0) || (getUint32(pHeader + 4) != SURFACECACHE_VERSION)) {
+        SDL_Log("SurfaceCache: '%s' has an unknown format and is rebuilt", filename.c_str());
+        return false;
+    }
+
+    if(memcmp(pHeader + 8, sourceChecksum, 16) != 0) {
+        SDL_Log("SurfaceCache: '%s' was made from different data files or settings and is rebuilt", filename.c_str());
+        return false;
+    }
+
+    Uint8 contentChecksum[16];
+    md5(pFileData + SURFACECACHE_HEADERSIZE, fileSize - SURFACECACHE_HEADERSIZE, contentChecksum);
+    if(memcmp(pHeader + 24, contentChecksum, 16) != 0) {
+        SDL_Log("SurfaceCache: '%s' is corrupt and is rebuilt", filename.c_str());
+        return false;
+    }
+
+    const Uint32 numPalettes = getUint32(pHeader + 40);
+    const Uint32 numEntries = getUint32(pHeader + 44);
+
+    size_t offset = SURFACECACHE_HEADERSIZE;
+    for(Uint32 i = 0; i < numPalettes; i++) {
+        if(offset + 4 > fileSize) {
+            return false;
+        }
+        const Uint32 numColors = getUint32(pFileData + offset);
+        offset += 4;
+        if((numColors > 256) || (offset + numColors*4 > fileSize)) {
+            return false;
+        }
+
+        std::vector<SDL_Color> palette(numColors);
+        for(SDL_Color& color : palette) {
+            color.r = pFileData[offset];
+            color.g = pFileData[offset+1];
+            color.b = pFileData[offset+2];
+            color.a = pFileData[offset+3];
+            offset += 4;
+        }
+        palettes.push_back(std::move(palette));
+    }
+
+    if(offset + numEntries * SURFACECACHE_ENTRYSIZE > fileSize) {
+        return false;
+    }
+
+    for(Uint32 i = 0; i < numEntries; i++, offset += SURFACECACHE_ENTRYSIZE) {
+        const Uint8* pEntry = pFileData + offset;
+
+        Entry entry;
+        entry.width = getUint16(pEntry + 4);
+        entry.height = getUint16(pEntry + 6);
+        entry.pitch = getUint32(pEntry + 8);
+        entry.colorKey = getUint32(pEntry + 12);
+        entry.paletteIndex = getUint32(pEntry + 16);
+        entry.fileOffset = getUint32(pEntry + 20);
+
+        if((entry.pitch < entry.width) || (entry.paletteIndex >= palettes.size())
+            || (entry.fileOffset + (size_t) entry.pitch * entry.height > fileSize)) {
+            return false;
+        }
+
+        entries[getUint32(pEntry)] = std::move(entry);
+    }
+
+    SDL_Log("SurfaceCache: Loaded %d surfaces from '%s'%s", (int) entries.size(), filename.c_str(), bMapped ? " (shared)" : "");
+
+    return true;
+}
+
+void SurfaceCache::mapFile(SDL_RWops* pFile) {
+    const Sint64 size = SDL_RWsize(pFile);
+    if(size <= 0) {
+        return;
+    }
+
+#ifdef _WIN32
+    WCHAR szwFilename[MAX_PATH];
+    if(MultiByteToWideChar(CP_UTF8, 0, filename.c_str(), -1, szwFilename, MAX_PATH) == 0) {
+        return;
+    }
+
+    HANDLE hFile = CreateFileW(szwFilename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(hFile == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    // the mapping keeps the file open
+    hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(hFile);
+    if(hMapping == nullptr) {
+        return;
+    }
+
+    void* pView = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    if(pView == nullptr) {
+        CloseHandle(hMapping);
+        hMapping = nullptr;
+        return;
+    }
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if(fd < 0) {
+        return;
+    }
+
+    struct stat fileStat;
+    if((fstat(fd, &fileStat) != 0) || (fileStat.st_size != size)) {
+        close(fd);
+        return;
+    }
+
+    // the mapping stays valid after closing the file descriptor and after the file is replaced by save()
+    void* pView = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(pView == MAP_FAILED) {
+        return;
+    }
+#endif
+
+    pFileData = static_cast<const Uint8*>(pView);
+    fileSize = static_cast<size_t>(size);
+    bMapped = true;
+}
+
+void SurfaceCache::unmapFile() {
+    if(bMapped) {
+#ifdef _WIN32
+        UnmapViewOfFile(pFileData);
+        CloseHandle(hMapping);
+        hMapping = nullptr;
+#else
+        munmap(const_cast<Uint8*>(pFileData), fileSize);
+#endif
+    }
+
+    fileBuffer.clear();
+    fileBuffer.shrink_to_fit();
+    pFileData = nullptr;
+    fileSize = 0;
+    bMapped = false;
+}
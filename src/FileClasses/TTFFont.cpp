@@ -17,9 +17,52 @@
 
 #include <FileClasses/TTFFont.h>
 #include <misc/exceptions.h>
+#include <misc/string_util.h>
+
+#include <globals.h>
 
 #include <Colors.h>
 
+#include <algorithm>
+
+namespace {
+
+/**
+    Decodes one utf-8 encoded character.
+    \param  utf8Char    the bytes of exactly one character
+    \return the code point or 0 if it does not fit into 16 bit
+*/
+Uint16 decodeUTF8Char(const std::string& utf8Char) {
+    const unsigned char c = static_cast<unsigned char>(utf8Char[0]);
+
+    Uint32 codePoint;
+    size_t length;
+    if((c & 0x80) == 0) {
+        codePoint = c;
+        length = 1;
+    } else if((c & 0xE0) == 0xC0) {
+        codePoint = c & 0x1F;
+        length = 2;
+    } else if((c & 0xF0) == 0xE0) {
+        codePoint = c & 0x0F;
+        length = 3;
+    } else {
+        return 0;
+    }
+
+    if(utf8Char.length() != length) {
+        return 0;
+    }
+
+    for(size_t i = 1; i < length; i++) {
+        codePoint = (codePoint << 6) | (static_cast<unsigned char>(utf8Char[i]) & 0x3F);
+    }
+
+    return static_cast<Uint16>(codePoint);
+}
+
+}
+
 /// Constructor
 /**
     The constructor reads the font from the ttf file given via rwop.
@@ -78,3 +121,177 @@ int TTFFont::getTextWidth(const std::string& text) const {
     return width;
 }
 
+/// Draws a text directly with the renderer
+/**
+    The glyphs are copied out of the glyph atlas. Texts drawn before reuse their cached layout and new glyphs are
+    rendered once and added to the atlas.
+    \param  x           the x-coordinate of the left side of the text
+    \param  y           the y-coordinate of the top side of the text
+    \param  text        the text to draw
+    \param  baseColor   the color of the text
+*/
+void TTFFont::drawText(int x, int y, const std::string& text, Uint32 baseColor) {
+    if(text.empty()) {
+        return;
+    }
+
+    if(!pAtlasSurface) {
+        resetAtlas();
+    }
+
+    const std::vector<GlyphQuad>& layout = getLayout(text);
+
+    const SDL_Color color = RGBA2SDL(baseColor);
+    SDL_SetTextureColorMod(pAtlasTexture.get(), color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(pAtlasTexture.get(), color.a);
+
+    // same vertical offset as in drawTextOnSurface()
+    for(const GlyphQuad& quad : layout) {
+        SDL_Rect dest { x + quad.x, y - 2, quad.atlasRect.w, quad.atlasRect.h };
+        SDL_RenderCopy(renderer, pAtlasTexture.get(), &quad.atlasRect, &dest);
+    }
+}
+
+/**
+    Returns the glyph for a character and adds it to the atlas if it is not yet in there. This may clear the atlas
+    if it is full.
+    \param  utf8Char    the bytes of exactly one utf-8 encoded character
+    \return the glyph or nullptr if it cannot be rendered
+*/
+const TTFFont::Glyph* TTFFont::getGlyph(const std::string& utf8Char) {
+    auto iter = glyphs.find(utf8Char);
+    if(iter != glyphs.end()) {
+        return &iter->second;
+    }
+
+    // the glyph is rendered like a text of its own so that it is positioned the same as in drawTextOnSurface()
+    sdl2::surface_ptr pGlyphSurface { TTF_RenderUTF8_Solid(pTTFFont.get(), utf8Char.c_str(), SDL_Color { 255, 255, 255, 255 }) };
+    if(!pGlyphSurface || (pGlyphSurface->w > TTFFONT_ATLAS_SIZE) || (pGlyphSurface->h > TTFFONT_ATLAS_SIZE)) {
+        return nullptr;
+    }
+
+    if(atlasPenX + pGlyphSurface->w > TTFFONT_ATLAS_SIZE) {
+        atlasPenX = 0;
+        atlasPenY += atlasRowHeight;
+        atlasRowHeight = 0;
+    }
+
+    if(atlasPenY + pGlyphSurface->h > TTFFONT_ATLAS_SIZE) {
+        resetAtlas();
+    }
+
+    Glyph glyph;
+    glyph.atlasRect = { atlasPenX, atlasPenY, pGlyphSurface->w, pGlyphSurface->h };
+    glyph.ch = decodeUTF8Char(utf8Char);
+
+    int minx = 0;
+    if((glyph.ch == 0) || (TTF_GlyphMetrics(pTTFFont.get(), glyph.ch, &minx, nullptr, nullptr, nullptr, &glyph.advance) < 0)) {
+        minx = 0;
+        glyph.advance = pGlyphSurface->w;
+    }
+    glyph.offsetX = std::min(0, minx);
+
+    // the rendered glyph is palettized; index 0 is the background
+    for(int y = 0; y < pGlyphSurface->h; y++) {
+        const Uint8* pSrc = static_cast<const Uint8*>(pGlyphSurface->pixels) + y * pGlyphSurface->pitch;
+        Uint32* pDest = reinterpret_cast<Uint32*>(static_cast<Uint8*>(pAtlasSurface->pixels) + (atlasPenY + y) * pAtlasSurface->pitch) + atlasPenX;
+        for(int x = 0; x < pGlyphSurface->w; x++) {
+            pDest[x] = (pSrc[x] != 0) ? COLOR_WHITE : COLOR_TRANSPARENT;
+        }
+    }
+
+    const Uint8* pAtlasPixels = static_cast<const Uint8*>(pAtlasSurface->pixels) + atlasPenY * pAtlasSurface->pitch + atlasPenX * sizeof(Uint32);
+    SDL_UpdateTexture(pAtlasTexture.get(), &glyph.atlasRect, pAtlasPixels, pAtlasSurface->pitch);
+
+    atlasPenX += pGlyphSurface->w;
+    atlasRowHeight = std::max(atlasRowHeight, pGlyphSurface->h);
+
+    return &glyphs.emplace(utf8Char, glyph).first->second;
+}
+
+/**
+    Returns the positions of the glyphs of a text, either from the layout cache or by laying it out.
+    \param  text    the text to lay out
+    \return the glyphs of the text
+*/
+const std::vector<TTFFont::GlyphQuad>& TTFFont::getLayout(const std::string& text) {
+    auto iter = layouts.find(text);
+    if(iter != layouts.end()) {
+        return iter->second;
+    }
+
+    if(layouts.size() >= TTFFONT_MAX_CACHED_LAYOUTS) {
+        layouts.clear();
+    }
+
+    std::vector<GlyphQuad> layout;
+
+    // if the atlas runs full while laying out this text, the glyphs placed so far are gone; start over once
+    for(int tries = 0; tries < 2; tries++) {
+        const Uint32 generation = atlasGeneration;
+        layout.clear();
+
+        int penX = 0;
+        Uint16 prevCh = 0;
+        size_t pos = 0;
+        while(pos < text.length()) {
+            size_t next = pos + 1;
+            while((next < text.length()) && !utf8IsStartByte(static_cast<unsigned char>(text[next]))) {
+                next++;
+            }
+
+            const Glyph* pGlyph = getGlyph(text.substr(pos, next - pos));
+            pos = next;
+            if(pGlyph == nullptr) {
+                prevCh = 0;
+                continue;
+            }
+
+#if (SDL_TTF_MAJOR_VERSION > 2) || (SDL_TTF_MINOR_VERSION > 0) || (SDL_TTF_PATCHLEVEL >= 15)
+            if((prevCh != 0) && (pGlyph->ch != 0)) {
+                penX += TTF_GetFontKerningSizeGlyphs(pTTFFont.get(), prevCh, pGlyph->ch);
+            }
+#endif
+
+            layout.push_back(GlyphQuad { pGlyph->atlasRect, penX + pGlyph->offsetX });
+            penX += pGlyph->advance;
+            prevCh = pGlyph->ch;
+        }
+
+        if(generation == atlasGeneration) {
+            break;
+        }
+    }
+
+    return layouts.emplace(text, std::move(layout)).first->second;
+}
+
+/**
+    Clears the glyph atlas and all layouts that refer to it. The atlas surface and texture are created if they do
+    not exist yet.
+*/
+void TTFFont::resetAtlas() {
+    if(!pAtlasSurface) {
+        pAtlasSurface = sdl2::surface_ptr{ SDL_CreateRGBSurface(0, TTFFONT_ATLAS_SIZE, TTFFONT_ATLAS_SIZE, SCREEN_BPP, RMASK, GMASK, BMASK, AMASK) };
+        if(!pAtlasSurface) {
+            THROW(std::runtime_error, "TTFFont::resetAtlas(): SDL_CreateRGBSurface() failed: %s!", SDL_GetError());
+        }
+
+        pAtlasTexture = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_STATIC, TTFFONT_ATLAS_SIZE, TTFFONT_ATLAS_SIZE) };
+        if(!pAtlasTexture) {
+            THROW(std::runtime_error, "TTFFont::resetAtlas(): SDL_CreateTexture() failed: %s!", SDL_GetError());
+        }
+        SDL_SetTextureBlendMode(pAtlasTexture.get(), SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_FillRect(pAtlasSurface.get(), nullptr, COLOR_TRANSPARENT);
+    SDL_UpdateTexture(pAtlasTexture.get(), nullptr, pAtlasSurface->pixels, pAtlasSurface->pitch);
+
+    atlasPenX = 0;
+    atlasPenY = 0;
+    atlasRowHeight = 0;
+    atlasGeneration++;
+
+    glyphs.clear();
+    layouts.clear();
+}
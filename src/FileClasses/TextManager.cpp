@@ -30,7 +30,31 @@
 #ifdef _
 #undef _
 #endif
-#define _(msgid) getLocalized(msgid)
+#define _(msgid) getLocalized([]() -> const LocalizedStringID& { static const LocalizedStringID id(msgid); return id; }())
+
+LocalizedStringID::LocalizedStringID(const char* unlocalizedString) {
+    static SDL_mutex* mutex = SDL_CreateMutex();
+
+    SDL_LockMutex(mutex);
+    std::deque<std::string>& registeredStrings = getRegisteredStrings();
+    index = registeredStrings.size();
+    registeredStrings.emplace_back(unlocalizedString);
+    SDL_UnlockMutex(mutex);
+}
+
+const std::string& LocalizedStringID::getUnlocalizedString() const {
+    return getRegisteredStrings()[index];
+}
+
+size_t LocalizedStringID::getNumIDs() {
+    return getRegisteredStrings().size();
+}
+
+std::deque<std::string>& LocalizedStringID::getRegisteredStrings() {
+    // a deque never moves its elements, so references to the registered strings stay valid
+    static std::deque<std::string> registeredStrings;
+    return registeredStrings;
+}
 
 TextManager::TextManager() {
     std::list<std::string> languagesList = getFileNamesList(getDuneLegacyDataDir() + "/locale", settings.general.language + ".po", true, FileListOrder_Name_Asc);
@@ -484,8 +508,8 @@ std::string TextManager::getBriefingText(unsigned int mission, unsigned int text
     }
 }
 
-std::vector<MentatTextFile::MentatEntry> TextManager::getAllMentatEntries(int house, unsigned int techLevel) const {
-    std::vector<MentatTextFile::MentatEntry> mentatEntries;
+std::vector<const MentatTextFile::MentatEntry*> TextManager::getAllMentatEntries(int house, unsigned int techLevel) const {
+    std::vector<const MentatTextFile::MentatEntry*> mentatEntries;
 
     switch(house) {
         case HOUSE_HARKONNEN:
@@ -493,7 +517,7 @@ std::vector<MentatTextFile::MentatEntry> TextManager::getAllMentatEntries(int ho
         default: {
             for(unsigned int i = 0; i <  mentatStrings[HOUSE_HARKONNEN]->getNumEntries(); i++) {
                 if(mentatStrings[HOUSE_HARKONNEN]->getMentatEntry(i).techLevel <= techLevel) {
-                    mentatEntries.push_back(mentatStrings[HOUSE_HARKONNEN]->getMentatEntry(i));
+                    mentatEntries.push_back(&mentatStrings[HOUSE_HARKONNEN]->getMentatEntry(i));
                 }
             }
         } break;
@@ -502,7 +526,7 @@ std::vector<MentatTextFile::MentatEntry> TextManager::getAllMentatEntries(int ho
         case HOUSE_FREMEN: {
             for(unsigned int i = 0; i <  mentatStrings[HOUSE_ATREIDES]->getNumEntries(); i++) {
                 if(mentatStrings[HOUSE_ATREIDES]->getMentatEntry(i).techLevel <= techLevel) {
-                    mentatEntries.push_back(mentatStrings[HOUSE_ATREIDES]->getMentatEntry(i));
+                    mentatEntries.push_back(&mentatStrings[HOUSE_ATREIDES]->getMentatEntry(i));
                 }
             }
         } break;
@@ -511,7 +535,7 @@ std::vector<MentatTextFile::MentatEntry> TextManager::getAllMentatEntries(int ho
         case HOUSE_MERCENARY: {
             for(unsigned int i = 0; i <  mentatStrings[HOUSE_ORDOS]->getNumEntries(); i++) {
                 if(mentatStrings[HOUSE_ORDOS]->getMentatEntry(i).techLevel <= techLevel) {
-                    mentatEntries.push_back(mentatStrings[HOUSE_ORDOS]->getMentatEntry(i));
+                    mentatEntries.push_back(&mentatStrings[HOUSE_ORDOS]->getMentatEntry(i));
                 }
             }
         } break;
@@ -563,7 +587,33 @@ const std::string& TextManager::postProcessString(const std::string& unprocessed
     }
 }
 
+const std::string& TextManager::resolveLocalized(const LocalizedStringID& id) const {
+    const std::string& unlocalizedString = id.getUnlocalizedString();
+    const std::string& result = getLocalized(unlocalizedString);
+
+    // strings referring to the original Dune II texts cannot be resolved before loadData()
+    const std::string& localizedStringRaw = getLocalizedRaw(unlocalizedString);
+    if(!localizedStringRaw.empty() && (localizedStringRaw[0] == '@') && origDuneText.empty()) {
+        return result;
+    }
+
+    if(localizedStringByID.size() <= id.getIndex()) {
+        localizedStringByID.resize(std::max(LocalizedStringID::getNumIDs(), id.getIndex() + 1), nullptr);
+    }
+    localizedStringByID[id.getIndex()] = &result;
+
+    return result;
+}
+
+const IndexedTextFile& TextManager::getIndexedTextFile(const std::string& filename, bool bDecode) const {
+    std::unique_ptr<IndexedTextFile>& pIndexedTextFile = origDuneText[filename];
+    if(pIndexedTextFile == nullptr) {
+        pIndexedTextFile = std::make_unique<IndexedTextFile>(pFileManager->openFile(filename).get(), bDecode);
+    }
+    return *pIndexedTextFile;
+}
+
 void TextManager::addOrigDuneText(const std::string& filename, bool bDecode) {
-    origDuneText[filename] = std::make_unique<IndexedTextFile>(pFileManager->openFile(filename).get(), bDecode);
+    getIndexedTextFile(filename, bDecode);
 }
 
@@ -22,6 +22,8 @@
 
 #include <FileClasses/Vocfile.h>
 
+#include <misc/sound_util.h>
+
 #include <string>
 #include <SDL2/SDL_mixer.h>
 #include <stdlib.h>
@@ -235,50 +237,6 @@ static sdl2::sdl_ptr<Uint8[]> LoadVOC_RW(SDL_RWops* rwop, Uint32 &decsize, Uint3
     return ret_sound;
 }
 
-inline Uint8 Float2Uint8(float x) {
-    int val = lround(x*127.0f + 128.0f);
-    if(val < 0) {
-        val = 0;
-    } else if(val > 255) {
-        val = 255;
-    }
-
-    return (Uint8) val;
-}
-
-inline Sint8 Float2Sint8(float x) {
-    int val = lround(x*127.0f);
-    if(val < -128) {
-        val = -128;
-    } else if(val > 127) {
-        val = 127;
-    }
-
-    return (Sint8) val;
-}
-
-inline Uint16 Float2Uint16(float x) {
-    int val = lround(x*32767.0f + 32768.0f);
-    if(val < 0) {
-        val = 0;
-    } else if(val > 65535) {
-        val = 65535;
-    }
-
-    return (Uint16) val;
-}
-
-inline Sint16 Float2Sint16(float x) {
-    int val = lround(x*32767.0f);
-    if(val < -32768) {
-        val = -32768;
-    } else if(val > 32767) {
-        val = 32767;
-    }
-
-    return (Sint16) val;
-}
-
 sdl2::mix_chunk_ptr LoadVOC_RW(SDL_RWops* rwop) {
 
     if(rwop == nullptr) {
@@ -333,11 +291,6 @@ sdl2::mix_chunk_ptr LoadVOC_RW(SDL_RWops* rwop) {
 
     RawDataUint8.reset();
 
-    RawData_Samples += 2*NUM_SAMPLES_OF_SILENCE;
-
-    // To prevent strange invalid read in src_linear
-    RawData_Samples--;
-
     // Get audio device specifications
     int TargetFrequency, channels;
     Uint16 TargetFormat;
@@ -347,16 +300,8 @@ sdl2::mix_chunk_ptr LoadVOC_RW(SDL_RWops* rwop) {
 
     // Convert to audio device frequency
     float ConversionRatio = ((float) TargetFrequency) / ((float) RawData_Frequency);
-    Uint32 TargetDataFloat_Samples = (Uint32) ((float) RawData_Samples * ConversionRatio);
-    std::vector<float> TargetDataFloat(TargetDataFloat_Samples);
-
-    for(Uint32 x=0;x<TargetDataFloat_Samples;x++) {
-        float pos = x/ConversionRatio;
-        int i = (int) pos; //lrint(floor(pos));
-        TargetDataFloat[x] = RawDataFloat[i] * ((i+1)-pos) + RawDataFloat[i+1] * (pos-i);
-    }
-
-    Uint32 TargetData_Samples = TargetDataFloat_Samples;
+    std::vector<float> TargetDataFloat = resampleSamples(RawDataFloat, RawData_Frequency, TargetFrequency);
+    Uint32 TargetData_Samples = TargetDataFloat.size();
 
     RawDataFloat.clear();
 
@@ -377,103 +322,11 @@ sdl2::mix_chunk_ptr LoadVOC_RW(SDL_RWops* rwop) {
     }
 
 
-    // Convert floats back to integers but leave out 3/4 of silence
+    // Convert floats to the device format but leave out 3/4 of silence
     int ThreeQuaterSilenceLength = (int) ((NUM_SAMPLES_OF_SILENCE * ConversionRatio)*(3.0f/4.0f));
     TargetData_Samples -= 2*ThreeQuaterSilenceLength;
 
-    auto myChunk = sdl2::mix_chunk_ptr{ (Mix_Chunk*) SDL_calloc(sizeof(Mix_Chunk),1) };
-    if(myChunk == nullptr) {
-        throw std::bad_alloc();
-    }
-
-    myChunk->allocated = 1;
-    myChunk->volume = 128;
-
-    int SizeOfTargetSample;
-    switch(TargetFormat) {
-        case AUDIO_U8:      SizeOfTargetSample = sizeof(Uint8) * channels;      break;
-        case AUDIO_S8:      SizeOfTargetSample = sizeof(Sint8) * channels;      break;
-        case AUDIO_U16LSB:  SizeOfTargetSample = sizeof(Uint16) * channels;     break;
-        case AUDIO_S16LSB:  SizeOfTargetSample = sizeof(Sint16) * channels;     break;
-        case AUDIO_U16MSB:  SizeOfTargetSample = sizeof(Uint16) * channels;     break;
-        case AUDIO_S16MSB:  SizeOfTargetSample = sizeof(Sint16) * channels;     break;
-        default: {
-            THROW(std::runtime_error, "LoadVOC_RW(): Invalid target sample format!");
-        } break;
-    }
-
-    if((myChunk->abuf = (Uint8*) SDL_malloc(TargetData_Samples * SizeOfTargetSample)) == nullptr) {
-        throw std::bad_alloc();
-    }
-    myChunk->alen = TargetData_Samples * SizeOfTargetSample;
-
-    switch(TargetFormat) {
-        case AUDIO_U8: {
-            Uint8* TargetData = reinterpret_cast<Uint8*>(myChunk->abuf);
-            for(Uint32 i=0; i < TargetData_Samples*channels; i+=channels) {
-                TargetData[i] = Float2Uint8(TargetDataFloat[(i/channels)+ThreeQuaterSilenceLength]);
-                for(int j = 1; j < channels; j++) {
-                    TargetData[i+j] = TargetData[i];
-                }
-            }
-        } break;
-
-        case AUDIO_S8: {
-            Sint8* TargetData = reinterpret_cast<Sint8*>(myChunk->abuf);
-            for(Uint32 i=0; i < TargetData_Samples*channels; i+=channels) {
-                TargetData[i] = Float2Sint8(TargetDataFloat[(i/channels)+ThreeQuaterSilenceLength]);
-                for(int j = 1; j < channels; j++) {
-                    TargetData[i+j] = TargetData[i];
-                }
-            }
-        } break;
-
-        case AUDIO_U16LSB: {
-            Uint16* TargetData = reinterpret_cast<Uint16*>(myChunk->abuf);
-            for(Uint32 i=0; i < TargetData_Samples*channels; i+=channels) {
-                TargetData[i] = SDL_SwapLE16(Float2Uint16(TargetDataFloat[(i/channels)+ThreeQuaterSilenceLength]));
-                for(int j = 1; j < channels; j++) {
-                    TargetData[i+j] = TargetData[i];
-                }
-
-            }
-        } break;
-
-        case AUDIO_S16LSB: {
-            Sint16* TargetData = reinterpret_cast<Sint16*>(myChunk->abuf);
-            for(Uint32 i=0; i < TargetData_Samples*channels; i+=channels) {
-                TargetData[i] = SDL_SwapLE16(Float2Sint16(TargetDataFloat[(i/channels)+ThreeQuaterSilenceLength]));
-                for(int j = 1; j < channels; j++) {
-                    TargetData[i+j] = TargetData[i];
-                }
-            }
-        } break;
-
-        case AUDIO_U16MSB: {
-            Uint16* TargetData = reinterpret_cast<Uint16*>(myChunk->abuf);
-            for(Uint32 i=0; i < TargetData_Samples*channels; i+=channels) {
-                TargetData[i] = SDL_SwapBE16(Float2Uint16(TargetDataFloat[(i/channels)+ThreeQuaterSilenceLength]));
-                for(int j = 1; j < channels; j++) {
-                    TargetData[i+j] = TargetData[i];
-                }
-
-            }
-        } break;
-
-        case AUDIO_S16MSB: {
-            Sint16* TargetData = reinterpret_cast<Sint16*>(myChunk->abuf);
-            for(Uint32 i=0; i < TargetData_Samples*channels; i+=channels) {
-                TargetData[i] = SDL_SwapBE16(Float2Sint16(TargetDataFloat[(i/channels)+ThreeQuaterSilenceLength]));
-                for(int j = 1; j < channels; j++) {
-                    TargetData[i+j] = TargetData[i];
-                }
-            }
-        } break;
-
-        default: {
-            THROW(std::runtime_error, "LoadVOC_RW(): Invalid target sample format!");
-        } break;
-    }
+    auto myChunk = createChunkFromSamples(TargetDataFloat.data() + ThreeQuaterSilenceLength, TargetData_Samples);
 
     return myChunk;
 }
@@ -0,0 +1,161 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FileClasses/WsaStream.h>
+#include <FileClasses/Palette.h>
+
+#include <misc/exceptions.h>
+#include <misc/Tracing.h>
+
+#include <algorithm>
+#include <cstring>
+
+extern Palette palette;
+
+WsaStream::WsaStream(const Wsafile* pWsafile, int numBuffers)
+ : pWsafile(pWsafile) {
+    frameSize = static_cast<size_t>(pWsafile->getWidth()) * static_cast<size_t>(pWsafile->getHeight());
+    frameBuffers.resize(std::max(1, numBuffers), std::vector<unsigned char>(frameSize));
+
+    mutex = SDL_CreateMutex();
+    frameDecodedCond = SDL_CreateCond();
+    bufferFreeCond = SDL_CreateCond();
+    if((mutex == nullptr) || (frameDecodedCond == nullptr) || (bufferFreeCond == nullptr)) {
+        THROW(std::runtime_error, "WsaStream::WsaStream(): Unable to create mutex: %s", SDL_GetError());
+    }
+
+    pThread = SDL_CreateThread(decoderThreadMain, "WsaStream", (void*) this);
+    if(pThread == nullptr) {
+        SDL_Log("WsaStream: Unable to create decoder thread: %s", SDL_GetError());
+        frameBuffers.resize(1);
+    }
+}
+
+WsaStream::~WsaStream() {
+    if(pThread != nullptr) {
+        SDL_LockMutex(mutex);
+        bStop = true;
+        SDL_CondSignal(bufferFreeCond);
+        SDL_UnlockMutex(mutex);
+
+        SDL_WaitThread(pThread, nullptr);
+    }
+
+    if(bufferFreeCond != nullptr) {
+        SDL_DestroyCond(bufferFreeCond);
+    }
+
+    if(frameDecodedCond != nullptr) {
+        SDL_DestroyCond(frameDecodedCond);
+    }
+
+    if(mutex != nullptr) {
+        SDL_DestroyMutex(mutex);
+    }
+}
+
+sdl2::surface_ptr WsaStream::getNextPicture() {
+    if(numConsumed >= pWsafile->getNumFrames()) {
+        return nullptr;
+    }
+
+    if(pThread == nullptr) {
+        // no decoder thread: the single buffer always holds the previous frame
+        pWsafile->decodeFrame(numConsumed, frameBuffers[0].data());
+    } else {
+        SDL_LockMutex(mutex);
+        while((numDecoded == numConsumed) && !pException) {
+            SDL_CondWait(frameDecodedCond, mutex);
+        }
+        const bool bFailed = (numDecoded == numConsumed);
+        SDL_UnlockMutex(mutex);
+
+        if(bFailed) {
+            std::rethrow_exception(pException);
+        }
+    }
+
+    // the decoder thread does not touch this buffer before numConsumed is increased
+    const unsigned char* pFrame = frameBuffers[numConsumed % frameBuffers.size()].data();
+
+    auto pic = sdl2::surface_ptr{ SDL_CreateRGBSurface(0, pWsafile->getWidth(), pWsafile->getHeight(), 8, 0, 0, 0, 0) };
+    if(pic == nullptr) {
+        THROW(std::runtime_error, "WsaStream::getNextPicture(): Cannot create surface!");
+    }
+
+    palette.applyToSurface(pic.get());
+
+    { // Scope
+        sdl2::surface_lock lock{ pic.get() };
+
+        unsigned char* const pixels = static_cast<unsigned char*>(lock.pixels());
+        for(int y = 0; y < pic->h; ++y) {
+            memcpy(pixels + y * pic->pitch, pFrame + y * pic->w, pic->w);
+        }
+    }
+
+    SDL_LockMutex(mutex);
+    numConsumed++;
+    SDL_CondSignal(bufferFreeCond);
+    SDL_UnlockMutex(mutex);
+
+    return pic;
+}
+
+int WsaStream::decoderThreadMain(void* data) {
+    TRACE_THREAD_NAME("WsaStream");
+    static_cast<WsaStream*>(data)->decodeFrames();
+    return 0;
+}
+
+void WsaStream::decodeFrames() {
+    // frames are delta-coded, so the working frame always holds the last decoded frame
+    std::vector<unsigned char> workingFrame(frameSize);
+    const int numBuffers = static_cast<int>(frameBuffers.size());
+
+    try {
+        for(int i = 0; i < pWsafile->getNumFrames(); i++) {
+            {
+                TRACE_ZONE("Decode WSA frame");
+                pWsafile->decodeFrame(i, workingFrame.data());
+            }
+
+            SDL_LockMutex(mutex);
+            while(!bStop && (numDecoded - numConsumed >= numBuffers)) {
+                SDL_CondWait(bufferFreeCond, mutex);
+            }
+
+            if(bStop) {
+                SDL_UnlockMutex(mutex);
+                return;
+            }
+            SDL_UnlockMutex(mutex);
+
+            memcpy(frameBuffers[i % numBuffers].data(), workingFrame.data(), frameSize);
+
+            SDL_LockMutex(mutex);
+            numDecoded++;
+            SDL_CondSignal(frameDecodedCond);
+            SDL_UnlockMutex(mutex);
+        }
+    } catch(...) {
+        SDL_LockMutex(mutex);
+        pException = std::current_exception();
+        SDL_CondSignal(frameDecodedCond);
+        SDL_UnlockMutex(mutex);
+    }
+}
@@ -114,6 +114,8 @@ sdl2::surface_ptr Wsafile::getPicture(Uint32 frameNumber) const {
         THROW(std::invalid_argument, "Wsafile::getPicture(): Requested frame number is %ud but the file contains only %ud frames!", frameNumber, numFrames);
     }
 
+    decodeAllFrames();
+
     // create new picture surface
     auto pic = sdl2::surface_ptr{ SDL_CreateRGBSurface(0,sizeX,sizeY,8,0,0,0,0) };
     if(pic== nullptr) {
@@ -143,6 +145,8 @@ sdl2::surface_ptr Wsafile::getPicture(Uint32 frameNumber) const {
 */
 sdl2::surface_ptr Wsafile::getAnimationAsPictureRow(int numFramesX) const {
 
+    decodeAllFrames();
+
     numFramesX = std::min(numFramesX, static_cast<int>(numFrames));
     int numFramesY = (numFrames + numFramesX -1) / numFramesX;
 
@@ -198,30 +202,66 @@ std::unique_ptr<Animation> Wsafile::getAnimation(unsigned int startindex, unsign
     return animation;
 }
 
-/// Helper method to decode one frame
+/// Decodes one frame
 /**
-    This helper method decodes one frame.
-    \param  pFiledata       Pointer to the data of this wsa-File
-    \param  index           Array with startoffsets
-    \param  numberOfFrames  Number of frames to decode
-    \param  pDecodedFrames  memory to copy decoded frames to (must be x*y*NumberOfFrames bytes long)
-    \param  x               x-dimension of one frame
-    \param  y               y-dimension of one frame
+    This method decodes frame frameNumber on top of the previous frame. Every frame only stores the difference
+    to its predecessor, so pFrame must contain frame frameNumber-1 when this method is called. The first frame of every
+    file that does not continue the previous file (i.e. is no extended animation) is decoded on a cleared frame.
+    This method only reads data that does not change after construction and may be called from any thread.
+    \param  frameNumber specifies which frame to decode (zero based)
+    \param  pFrame      the frame buffer of getWidth()*getHeight() bytes; contains frame frameNumber afterwards
 */
-void Wsafile::decodeFrames(const unsigned char* pFiledata, Uint32* index, int numberOfFrames, unsigned char* pDecodedFrames, int x, int y) const
+void Wsafile::decodeFrame(Uint32 frameNumber, unsigned char* pFrame) const
 {
-    for(int i = 0; i < numberOfFrames; ++i) {
-        auto dec80 = std::make_unique<unsigned char[]>(x * y * 2);
+    if(frameNumber >= numFrames) {
+        THROW(std::invalid_argument, "Wsafile::decodeFrame(): Requested frame number is %ud but the file contains only %ud frames!", frameNumber, numFrames);
+    }
+
+    size_t partIndex = 0;
+    while(frameNumber >= parts[partIndex].numFrames) {
+        frameNumber -= parts[partIndex].numFrames;
+        partIndex++;
+    }
+    const WsaPart& part = parts[partIndex];
+
+    const size_t frameSize = static_cast<size_t>(sizeX) * static_cast<size_t>(sizeY);
+
+    if((frameNumber == 0) && ((partIndex == 0) || (part.extended == false))) {
+        memset(pFrame, 0, frameSize);
+    }
+
+    const size_t frameOffset = SDL_SwapLE32(part.index[frameNumber]);
+    if(frameOffset >= part.filesize) {
+        THROW(std::runtime_error, "Wsafile::decodeFrame(): Frame %ud is beyond the end of this file!", frameNumber);
+    }
+
+    auto dec80 = std::make_unique<unsigned char[]>(frameSize * 2);
 
-        decode80(pFiledata + SDL_SwapLE32(index[i]), dec80.get(), 0);
+    decode80(part.pFiledata.get() + frameOffset, part.filesize - frameOffset, dec80.get(), frameSize * 2, 0);
+
+    decode40(dec80.get(), frameSize * 2, pFrame, frameSize);
+}
+
+/// Helper method to decode all frames
+/**
+    This helper method decodes all frames into decodedFrames unless this was already done before.
+*/
+void Wsafile::decodeAllFrames() const
+{
+    if(!decodedFrames.empty()) {
+        return;
+    }
 
-        decode40(dec80.get(), pDecodedFrames + i * x*y);
+    const size_t frameSize = static_cast<size_t>(sizeX) * static_cast<size_t>(sizeY);
 
-        dec80.reset();
+    decodedFrames.resize(frameSize * numFrames);
 
-        if (i < numberOfFrames - 1) {
-            memcpy(pDecodedFrames + (i+1) * x*y, pDecodedFrames + i * x*y,x*y);
+    for(Uint32 i = 0; i < numFrames; ++i) {
+        if(i > 0) {
+            memcpy(&decodedFrames[i * frameSize], &decodedFrames[(i-1) * frameSize], frameSize);
         }
+
+        decodeFrame(i, &decodedFrames[i * frameSize]);
     }
 }
 
@@ -283,50 +323,54 @@ void Wsafile::readdata(int numFiles, ...) {
     \param  args        SDL_RWops for each wsa-File should be in this va_list. (can be readonly)
 */
 void Wsafile::readdata(int numFiles, va_list args) {
-    std::vector<std::unique_ptr<unsigned char[]>> pFiledata(numFiles);
-    std::vector<Uint32*> index(numFiles);
-    std::vector<Uint16> numberOfFrames(numFiles);
-    std::vector<bool> extended(numFiles);
+    parts.clear();
+    parts.resize(numFiles);
+    decodedFrames.clear();
 
     numFrames = 0;
     looped = false;
 
     for(int i = 0; i < numFiles; i++) {
+        WsaPart& part = parts[i];
+
         int wsaFilesize;
         const auto rwop = va_arg(args,SDL_RWops*);
-        pFiledata[i] = readfile(rwop,&wsaFilesize);
-        numberOfFrames[i] = SDL_SwapLE16(*(reinterpret_cast<Uint16*>(pFiledata[i].get())) );
+        part.pFiledata = readfile(rwop,&wsaFilesize);
+        part.filesize = wsaFilesize;
+        unsigned char* const pFiledata = part.pFiledata.get();
+
+        part.numFrames = SDL_SwapLE16(*(reinterpret_cast<Uint16*>(pFiledata)) );
 
         if(i == 0) {
-            sizeX = SDL_SwapLE16(*(reinterpret_cast<Uint16*>(pFiledata[0].get()+ 2)) );
-            sizeY = SDL_SwapLE16(*(reinterpret_cast<Uint16*>(pFiledata[0].get() + 4)) );
+            sizeX = SDL_SwapLE16(*(reinterpret_cast<Uint16*>(pFiledata + 2)) );
+            sizeY = SDL_SwapLE16(*(reinterpret_cast<Uint16*>(pFiledata + 4)) );
         } else {
-            if( (sizeX != (SDL_SwapLE16(*(reinterpret_cast<Uint16*>(pFiledata[i].get()+ 2)) )))
-                || (sizeY != (SDL_SwapLE16(*(reinterpret_cast<Uint16*>(pFiledata[i].get()+ 4)) )))) {
+            if( (sizeX != (SDL_SwapLE16(*(reinterpret_cast<Uint16*>(pFiledata + 2)) )))
+                || (sizeY != (SDL_SwapLE16(*(reinterpret_cast<Uint16*>(pFiledata + 4)) )))) {
                 THROW(std::runtime_error, "Wsafile::readdata(): The wsa-files have different image dimensions. Cannot concatenate them!");
             }
         }
 
-        if( reinterpret_cast<unsigned short *>(pFiledata[i].get())[6] == 0) {
-            index[i] = reinterpret_cast<Uint32 *>(pFiledata[i].get() + 10);
+        if( reinterpret_cast<unsigned short *>(pFiledata)[6] == 0) {
+            part.index = reinterpret_cast<Uint32 *>(pFiledata + 10);
         } else {
-            index[i] = reinterpret_cast<Uint32 *>(pFiledata[i].get() + 8);
+            part.index = reinterpret_cast<Uint32 *>(pFiledata + 8);
         }
 
-        if(index[i][0] == 0) {
+        if(part.index[0] == 0) {
             // extended animation
             if(i == 0) {
                 SDL_Log("Extended WSA-File!");
             }
-            index[i]++;
-            numberOfFrames[i]--;
-            extended[i] = true;
+            part.index++;
+            part.numFrames--;
+            part.extended = true;
         } else {
-            extended[i] = false;
+            part.extended = false;
         }
 
         if(i == 0) {
-            if(index[0][numberOfFrames[0]+1] == 0) {
+            if(part.index[part.numFrames+1] == 0) {
                 // index[numberOfFrames[0]] point to end of file
                 // => no loop
                 looped = false;
@@ -338,33 +382,10 @@ void Wsafile::readdata(int numFiles, va_list args) {
             }
         }
 
-        if(pFiledata[i].get() + wsaFilesize < (reinterpret_cast<unsigned char *>(index[i]) + sizeof(Uint32) * numberOfFrames[i])) {
+        if(pFiledata + wsaFilesize < (reinterpret_cast<const unsigned char *>(part.index) + sizeof(Uint32) * part.numFrames)) {
             THROW(std::runtime_error, "Wsafile::readdata(): No valid WSA-File: File too small!");
         }
 
-        numFrames += numberOfFrames[i];
-    }
-
-
-    decodedFrames.clear();
-    decodedFrames.resize(static_cast<size_t>(sizeX) * static_cast<size_t>(sizeY) * numFrames);
-
-    assert(decodedFrames.size() >= sizeX * sizeY);
-    decodeFrames(pFiledata[0].get(),index[0],numberOfFrames[0],&decodedFrames[0],sizeX,sizeY);
-    pFiledata[0].reset();
-
-    if (numFiles > 1) {
-        auto nextFreeFrame = &decodedFrames[(numberOfFrames[0] * static_cast<size_t>(sizeX) * static_cast<size_t>(sizeY))];
-
-        for (int i = 1; i < numFiles; i++) {
-            if (extended[i]) {
-                // copy last frame
-                memcpy(nextFreeFrame, nextFreeFrame - static_cast<size_t>(sizeX) * static_cast<size_t>(sizeY), static_cast<size_t>(sizeX) * static_cast<size_t>(sizeY));
-            }
-            assert(nextFreeFrame + sizeX * sizeY <= &decodedFrames[decodedFrames.size() - 1]);
-            decodeFrames(pFiledata[i].get(), index[i], numberOfFrames[i], nextFreeFrame, sizeX, sizeY);
-            nextFreeFrame += numberOfFrames[i] * sizeX * sizeY;
-            pFiledata[i].reset();
-        }
+        numFrames += part.numFrames;
     }
 }
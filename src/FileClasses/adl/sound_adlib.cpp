@@ -86,6 +86,13 @@ static inline uint16 READ_BE_uint16(const void *ptr) {
   return (b[0] << 8) + b[1];
 }
 
+// The OPL emulation keeps working buffers in static variables. Every use of an emulator must hold this mutex, so
+// that e.g. a music track can be rendered into a file while another track or a sound effect is played.
+static SDL_mutex* getEmulationMutex() {
+    static SDL_mutex* const pEmulationMutex = SDL_CreateMutex();
+    return pEmulationMutex;
+}
+
 static inline void warning(const char *str, ...)
 {
     va_list args;
@@ -2287,6 +2294,8 @@ SoundAdlibPC::SoundAdlibPC(SDL_RWops* rwop) : _driver(0), _trackEntries(), _soun
 
     Mix_QuerySpec(&m_freq, &m_format, &m_channels);
 
+    SDL_LockMutex(getEmulationMutex());
+
     _driver = new AdlibDriver(m_freq);
     assert(_driver);
 
@@ -2299,6 +2308,9 @@ SoundAdlibPC::SoundAdlibPC(SDL_RWops* rwop) : _driver(0), _trackEntries(), _soun
     bJustStartedPlaying = false;
 
     init();
+
+    SDL_UnlockMutex(getEmulationMutex());
+
     internalLoadFile(rwop);
 }
 
@@ -2309,6 +2321,8 @@ SoundAdlibPC::SoundAdlibPC(SDL_RWops* rwop, int freq) : _driver(nullptr), _track
     m_format = AUDIO_S16LSB;
     m_channels = 2;
 
+    SDL_LockMutex(getEmulationMutex());
+
     _driver = new AdlibDriver(m_freq);
     assert(_driver);
 
@@ -2321,6 +2335,9 @@ SoundAdlibPC::SoundAdlibPC(SDL_RWops* rwop, int freq) : _driver(nullptr), _track
     bJustStartedPlaying = false;
 
     init();
+
+    SDL_UnlockMutex(getEmulationMutex());
+
     internalLoadFile(rwop);
 }
 
@@ -2394,11 +2411,15 @@ void SoundAdlibPC::callback(void *userdata, Uint8 *audiobuf, int len)
 {
     SoundAdlibPC *self = static_cast<SoundAdlibPC*>(userdata);
 
+    SDL_LockMutex(getEmulationMutex());
+
     self->process();
 
     int16* buf = reinterpret_cast<int16*>(audiobuf);
     int samples = self->_driver->readBuffer(buf, len / self->getsampsize());
 
+    SDL_UnlockMutex(getEmulationMutex());
+
     int volume = self->getVolume();
     for(int i = 0; i < 2*samples; i++) {
         buf[i] = static_cast<int16>(buf[i] * volume / MIX_MAX_VOLUME);
@@ -22,14 +22,38 @@
 #include <FileClasses/FileManager.h>
 #include <FileClasses/adl/sound_adlib.h>
 
+#include <misc/FileSystem.h>
+#include <misc/fnkdat.h>
+#include <misc/md5.h>
+#include <misc/Tracing.h>
 #include <mmath.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
 ADLPlayer::ADLPlayer() : MusicPlayer(settings.audio.playMusic, settings.audio.musicVolume) {
     pSoundAdlibPC = nullptr;
+    music = nullptr;
+    pRenderThread = nullptr;
+    SDL_AtomicSet(&renderFinished, 0);
+    SDL_AtomicSet(&abortRendering, 0);
+
+    if(settings.audio.cacheMusic) {
+        char tmp[FILENAME_MAX];
+        fnkdat(ADLPLAYER_CACHE_DIRECTORY, tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+        cacheDirectory = tmp;
+    }
 }
 
 ADLPlayer::~ADLPlayer() {
     setMusic(false);
+
+    if(pRenderThread != nullptr) {
+        SDL_AtomicSet(&abortRendering, 1);
+        SDL_WaitThread(pRenderThread, nullptr);
+        pRenderThread = nullptr;
+    }
 }
 
 void ADLPlayer::changeMusic(MUSICTYPE musicType)
@@ -37,7 +61,7 @@ void ADLPlayer::changeMusic(MUSICTYPE musicType)
     int musicNum = -1;
     std::string filename = "";
 
-    if((currentMusicType == musicType) && (pSoundAdlibPC != nullptr) && pSoundAdlibPC->isPlaying()) {
+    if((currentMusicType == musicType) && isMusicPlaying()) {
         return;
     }
 
@@ -192,12 +216,22 @@ void ADLPlayer::changeMusic(MUSICTYPE musicType)
 
     currentMusicType = musicType;
 
+    stopMusic();
+
     if((musicOn == true) && (filename != "")) {
 
-        Mix_HookMusic(nullptr, nullptr);
-        delete pSoundAdlibPC;
+        std::vector<unsigned char> adlData = readFile(filename);
+
+        std::string cacheFilepath;
+        if(!cacheDirectory.empty()) {
+            cacheFilepath = getCacheFilepath(adlData, musicNum);
+            if(playCachedTrack(cacheFilepath)) {
+                SDL_Log("Now playing %s (cached)!",filename.c_str());
+                return;
+            }
+        }
 
-        sdl2::RWops_ptr rwop = pFileManager->openFile(filename);
+        sdl2::RWops_ptr rwop{ SDL_RWFromConstMem(adlData.data(), static_cast<int>(adlData.size())) };
 
         pSoundAdlibPC = new SoundAdlibPC(rwop.get());
         pSoundAdlibPC->setVolume(musicVolume);
@@ -207,6 +241,10 @@ void ADLPlayer::changeMusic(MUSICTYPE musicType)
         Mix_HookMusic(pSoundAdlibPC->callback, pSoundAdlibPC);
 
         SDL_Log("Now playing %s!",filename.c_str());
+
+        if(!cacheFilepath.empty()) {
+            startRendering(std::move(adlData), musicNum, cacheFilepath);
+        }
     }
 }
 
@@ -221,6 +259,10 @@ void ADLPlayer::toggleSound() {
 }
 
 bool ADLPlayer::isMusicPlaying() {
+    if(music != nullptr) {
+        return Mix_PlayingMusic();
+    }
+
     return (pSoundAdlibPC != nullptr) && pSoundAdlibPC->isPlaying();
 }
 
@@ -230,16 +272,189 @@ void ADLPlayer::setMusic(bool value) {
     if(musicOn) {
         changeMusic(MUSIC_RANDOM);
     } else {
-        Mix_HookMusic(nullptr, nullptr);
-
-        delete pSoundAdlibPC;
-        pSoundAdlibPC = nullptr;
+        stopMusic();
     }
 }
 
 void ADLPlayer::setMusicVolume(int newVolume) {
     MusicPlayer::setMusicVolume(newVolume);
-    if(musicOn) {
-        pSoundAdlibPC->setVolume(newVolume);
+    Mix_VolumeMusic(musicVolume);
+    if(pSoundAdlibPC != nullptr) {
+        pSoundAdlibPC->setVolume(musicVolume);
+    }
+}
+
+void ADLPlayer::stopMusic() {
+    Mix_HookMusic(nullptr, nullptr);
+
+    delete pSoundAdlibPC;
+    pSoundAdlibPC = nullptr;
+
+    if(music != nullptr) {
+        Mix_HaltMusic();
+        Mix_FreeMusic(music);
+        music = nullptr;
+    }
+}
+
+std::vector<unsigned char> ADLPlayer::readFile(const std::string& filename) {
+    sdl2::RWops_ptr rwop = pFileManager->openFile(filename);
+
+    const Sint64 filesize = SDL_RWsize(rwop.get());
+    if(filesize <= 0) {
+        THROW(std::runtime_error, "ADLPlayer::readFile(): Cannot determine size of '%s'!", filename);
+    }
+
+    std::vector<unsigned char> data(static_cast<size_t>(filesize));
+    if(SDL_RWread(rwop.get(), data.data(), data.size(), 1) != 1) {
+        THROW(std::runtime_error, "ADLPlayer::readFile(): Reading '%s' failed!", filename);
+    }
+
+    return data;
+}
+
+std::string ADLPlayer::getCacheFilepath(const std::vector<unsigned char>& adlData, int musicNum) const {
+    // the name depends on the content, so tracks of different game versions do not get mixed up
+    unsigned char md5sum[16];
+    md5(adlData.data(), static_cast<int>(adlData.size()), md5sum);
+
+    std::string name;
+    static const char* const hexDigits = "0123456789abcdef";
+    for(unsigned char c : md5sum) {
+        name += hexDigits[c >> 4];
+        name += hexDigits[c & 0xF];
+    }
+
+    return cacheDirectory + "/" + name + "_" + std::to_string(musicNum) + ".wav";
+}
+
+bool ADLPlayer::playCachedTrack(const std::string& cacheFilepath) {
+    if(!existsFile(cacheFilepath)) {
+        return false;
+    }
+
+    music = Mix_LoadMUS(cacheFilepath.c_str());
+    if(music == nullptr) {
+        SDL_Log("ADLPlayer: Unable to play cached track %s: %s!", cacheFilepath.c_str(), Mix_GetError());
+        return false;
+    }
+
+    Mix_VolumeMusic(musicVolume);
+    if(Mix_PlayMusic(music, 1) == -1) {
+        SDL_Log("ADLPlayer: Unable to play cached track %s: %s!", cacheFilepath.c_str(), Mix_GetError());
+        Mix_FreeMusic(music);
+        music = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void ADLPlayer::startRendering(std::vector<unsigned char>&& adlData, int musicNum, const std::string& cacheFilepath) {
+    if(pRenderThread != nullptr) {
+        if(SDL_AtomicGet(&renderFinished) == 0) {
+            // only one track is rendered at a time; this one is cached when it is played again later
+            return;
+        }
+
+        SDL_WaitThread(pRenderThread, nullptr);
+        pRenderThread = nullptr;
+    }
+
+    renderJob.adlData = std::move(adlData);
+    renderJob.musicNum = musicNum;
+    renderJob.cacheFilepath = cacheFilepath;
+    SDL_AtomicSet(&renderFinished, 0);
+
+    pRenderThread = SDL_CreateThread(renderThreadMain, "ADLPlayerRender", (void*) this);
+    if(pRenderThread == nullptr) {
+        SDL_Log("ADLPlayer: Unable to create render thread: %s", SDL_GetError());
+    }
+}
+
+int ADLPlayer::renderThreadMain(void* data) {
+    ADLPlayer* pPlayer = static_cast<ADLPlayer*>(data);
+    TRACE_THREAD_NAME("ADLPlayerRender");
+
+    try {
+        TRACE_ZONE("Render ADL track");
+        pPlayer->renderTrack();
+    } catch(std::exception& e) {
+        SDL_Log("ADLPlayer: Rendering %s failed: %s", pPlayer->renderJob.cacheFilepath.c_str(), e.what());
+    }
+
+    SDL_AtomicSet(&pPlayer->renderFinished, 1);
+    return 0;
+}
+
+void ADLPlayer::renderTrack() {
+    const std::string tmpFilepath = renderJob.cacheFilepath + ".tmp";
+
+    sdl2::RWops_ptr pAdlRWop{ SDL_RWFromConstMem(renderJob.adlData.data(), static_cast<int>(renderJob.adlData.size())) };
+    auto pRenderer = std::make_unique<SoundAdlibPC>(pAdlRWop.get(), AUDIO_FREQUENCY);
+    pRenderer->setVolume(MIX_MAX_VOLUME);       // the volume is applied by SDL_mixer when playing the cached track
+    pRenderer->playTrack(renderJob.musicNum);
+
+    sdl2::RWops_ptr pWavRWop{ SDL_RWFromFile(tmpFilepath.c_str(), "wb") };
+    if(pWavRWop == nullptr) {
+        THROW(std::runtime_error, "Cannot open '%s' for writing!", tmpFilepath);
     }
+
+    // 16-bit stereo little endian PCM, the sizes in the header are filled in when the track is complete
+    const Uint32 numChannels = 2;
+    const Uint32 bytesPerFrame = numChannels * 2;
+    bool bWriteOk = (SDL_RWwrite(pWavRWop.get(), "RIFF", 4, 1) == 1)
+                    && (SDL_WriteLE32(pWavRWop.get(), 0) == 1)
+                    && (SDL_RWwrite(pWavRWop.get(), "WAVEfmt ", 8, 1) == 1)
+                    && (SDL_WriteLE32(pWavRWop.get(), 16) == 1)
+                    && (SDL_WriteLE16(pWavRWop.get(), 1) == 1)
+                    && (SDL_WriteLE16(pWavRWop.get(), numChannels) == 1)
+                    && (SDL_WriteLE32(pWavRWop.get(), AUDIO_FREQUENCY) == 1)
+                    && (SDL_WriteLE32(pWavRWop.get(), AUDIO_FREQUENCY * bytesPerFrame) == 1)
+                    && (SDL_WriteLE16(pWavRWop.get(), bytesPerFrame) == 1)
+                    && (SDL_WriteLE16(pWavRWop.get(), 16) == 1)
+                    && (SDL_RWwrite(pWavRWop.get(), "data", 4, 1) == 1)
+                    && (SDL_WriteLE32(pWavRWop.get(), 0) == 1);
+
+    const Uint32 maxDataSize = ADLPLAYER_MAX_RENDER_SECONDS * AUDIO_FREQUENCY * bytesPerFrame;
+    Uint32 dataSize = 0;
+    Uint8 buffer[4096];
+    bool bSilent = false;
+    while(bWriteOk && (pRenderer->isPlaying() || !bSilent)) {
+        if(SDL_AtomicGet(&abortRendering) != 0) {
+            bWriteOk = false;
+            break;
+        }
+
+        memset(buffer, 0, sizeof(buffer));
+        SoundAdlibPC::callback(pRenderer.get(), buffer, sizeof(buffer));
+
+        bSilent = std::all_of(buffer, buffer + sizeof(buffer), [](Uint8 b) { return b == 0; });
+
+        bWriteOk = (SDL_RWwrite(pWavRWop.get(), buffer, sizeof(buffer), 1) == 1);
+        dataSize += sizeof(buffer);
+
+        if(dataSize >= maxDataSize) {
+            SDL_Log("ADLPlayer: Rendering %s stopped after %d seconds.", renderJob.cacheFilepath.c_str(), ADLPLAYER_MAX_RENDER_SECONDS);
+            break;
+        }
+    }
+
+    bWriteOk = bWriteOk
+                && (SDL_RWseek(pWavRWop.get(), 4, RW_SEEK_SET) == 4)
+                && (SDL_WriteLE32(pWavRWop.get(), 36 + dataSize) == 1)
+                && (SDL_RWseek(pWavRWop.get(), 40, RW_SEEK_SET) == 40)
+                && (SDL_WriteLE32(pWavRWop.get(), dataSize) == 1);
+
+    const bool bCloseOk = (SDL_RWclose(pWavRWop.release()) == 0);
+
+    if(!bWriteOk || !bCloseOk || (std::rename(tmpFilepath.c_str(), renderJob.cacheFilepath.c_str()) != 0)) {
+        std::remove(tmpFilepath.c_str());
+        if(SDL_AtomicGet(&abortRendering) == 0) {
+            SDL_Log("ADLPlayer: Unable to write %s!", renderJob.cacheFilepath.c_str());
+        }
+        return;
+    }
+
+    SDL_Log("ADLPlayer: Cached %s.", renderJob.cacheFilepath.c_str());
 }
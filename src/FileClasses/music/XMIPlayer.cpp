@@ -22,14 +22,46 @@
 #include <FileClasses/FileManager.h>
 #include <FileClasses/xmidi/xmidi.h>
 
+#include <misc/FileSystem.h>
+#include <misc/IMemoryStream.h>
+#include <misc/OMemoryStream.h>
+#include <misc/Tracing.h>
 #include <misc/fnkdat.h>
+#include <misc/md5.h>
 #include <mmath.h>
 
-#include <iostream>
+#include <cstdio>
+
+/// The XMI files in the order they are converted ahead of their first use (intro and menu music first)
+static const char* const preconvertFilenames[] = {
+    "DUNE0.XMI", "DUNE7.XMI", "DUNE16.XMI", "DUNE1.XMI", "DUNE2.XMI", "DUNE3.XMI", "DUNE4.XMI", "DUNE5.XMI",
+    "DUNE6.XMI", "DUNE9.XMI", "DUNE18.XMI", "DUNE10.XMI", "DUNE11.XMI", "DUNE12.XMI", "DUNE13.XMI", "DUNE14.XMI",
+    "DUNE15.XMI", "DUNE8.XMI", "DUNE17.XMI", "DUNE20.XMI", "DUNE19.XMI"
+};
 
 XMIPlayer::XMIPlayer() : MusicPlayer(settings.audio.playMusic, settings.audio.musicVolume) {
     music = nullptr;
 
+    midiCacheMutex = SDL_CreateMutex();
+    if(midiCacheMutex == nullptr) {
+        THROW(std::runtime_error, "XMIPlayer::XMIPlayer(): Unable to create mutex: %s", SDL_GetError());
+    }
+
+    if(musicOn) {
+        for(const char* filename : preconvertFilenames) {
+            try {
+                preconvertSources.emplace_back(filename, readXMIFile(filename));
+            } catch(std::exception& e) {
+                SDL_Log("XMIPlayer: Cannot read %s: %s", filename, e.what());
+            }
+        }
+
+        pPreconvertThread = SDL_CreateThread(preconvertThreadMain, "XMIPreconvert", (void*) this);
+        if(pPreconvertThread == nullptr) {
+            SDL_Log("XMIPlayer: Unable to create preconvert thread: %s", SDL_GetError());
+        }
+    }
+
 #if SDL_VERSIONNUM(SDL_MIXER_MAJOR_VERSION, SDL_MIXER_MINOR_VERSION, SDL_MIXER_PATCHLEVEL) >= SDL_VERSIONNUM(2,0,2)
     if((Mix_Init(MIX_INIT_MID) & MIX_INIT_MID) == 0) {
         SDL_Log("XMIPlayer: Failed to init required midi support: %s", SDL_GetError());
@@ -42,12 +74,20 @@ XMIPlayer::XMIPlayer() : MusicPlayer(settings.audio.playMusic, settings.audio.mu
 }
 
 XMIPlayer::~XMIPlayer() {
+    if(pPreconvertThread != nullptr) {
+        SDL_LockMutex(midiCacheMutex);
+        bStopPreconvert = true;
+        SDL_UnlockMutex(midiCacheMutex);
+
+        SDL_WaitThread(pPreconvertThread, nullptr);
+    }
+
     if(music != nullptr) {
         Mix_FreeMusic(music);
         music = nullptr;
     }
 
-    remove(getTmpFileName().c_str());
+    SDL_DestroyMutex(midiCacheMutex);
 
     Mix_Quit();
 }
@@ -212,23 +252,11 @@ void XMIPlayer::changeMusic(MUSICTYPE musicType)
     currentMusicType = musicType;
 
     if((musicOn == true) && (filename != "")) {
-        sdl2::RWops_ptr inputrwop = pFileManager->openFile(filename);
-        SDLDataSource input(inputrwop.release(),1);
-
-        std::string tmpFilename = getTmpFileName();
-
-        SDL_RWops* outputrwop = SDL_RWFromFile(tmpFilename.c_str(),"wb");
-        if(outputrwop == nullptr) {
-            std::cerr << "Cannot open file " << tmpFilename << "!" << std::endl;
+        const std::vector<Uint8>* pMIDITrack = getMIDITrack(filename, musicNum);
+        if(pMIDITrack == nullptr) {
+            SDL_Log("XMIPlayer: %s has no track %d!", filename.c_str(), musicNum);
             return;
         }
-        SDLDataSource output(outputrwop,1);
-
-        XMIDI myXMIDI(&input, XMIDI_CONVERT_NOCONVERSION);
-        myXMIDI.retrieve(musicNum, &output );
-
-        input.close();
-        output.close();
 
         Mix_HaltMusic();
         if(music != nullptr) {
@@ -236,13 +264,14 @@ void XMIPlayer::changeMusic(MUSICTYPE musicType)
             music = nullptr;
         }
 
-        music = Mix_LoadMUS(tmpFilename.c_str());
+        // the cached data stays valid as long as the player exists
+        music = Mix_LoadMUS_RW(SDL_RWFromConstMem(pMIDITrack->data(), static_cast<int>(pMIDITrack->size())), 1);
         if(music != nullptr) {
             if(Mix_PlayMusic(music, -1) == -1) {
                 SDL_Log("XMIPlayer: Playing music failed: %s", SDL_GetError());
             } else {
                 Mix_VolumeMusic(musicVolume);
-                SDL_Log("Now playing %s!", tmpFilename.c_str());
+                SDL_Log("Now playing %s/%d!", filename.c_str(), musicNum);
             }
         } else {
             SDL_Log("Unable to play %s: %s!", filename.c_str(), Mix_GetError());
@@ -279,9 +308,182 @@ void XMIPlayer::setMusic(bool value) {
     }
 }
 
-std::string XMIPlayer::getTmpFileName() {
-    // determine path to config file
-    char tmp[FILENAME_MAX];
-    fnkdat("tmp.mid", tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
-    return std::string(tmp);
+const std::vector<Uint8>* XMIPlayer::getMIDITrack(const std::string& filename, int musicNum) {
+    SDL_LockMutex(midiCacheMutex);
+    auto iter = midiCache.find(filename);
+    const bool bConverted = (iter != midiCache.end());
+    SDL_UnlockMutex(midiCacheMutex);
+
+    if(!bConverted) {
+        // not converted yet (or the preconvert thread is just converting it)
+        std::vector<std::vector<Uint8>> tracks = convertXMIFile(filename, readXMIFile(filename));
+
+        SDL_LockMutex(midiCacheMutex);
+        iter = midiCache.emplace(filename, std::move(tracks)).first;
+        SDL_UnlockMutex(midiCacheMutex);
+    }
+
+    const std::vector<std::vector<Uint8>>& tracks = iter->second;
+    if((musicNum < 0) || (musicNum >= static_cast<int>(tracks.size())) || tracks[musicNum].empty()) {
+        return nullptr;
+    }
+
+    return &tracks[musicNum];
+}
+
+std::string XMIPlayer::readXMIFile(const std::string& filename) {
+    sdl2::RWops_ptr file = pFileManager->openFile(filename);
+    const Sint64 fileSize = SDL_RWsize(file.get());
+    if(fileSize < 0) {
+        THROW(std::runtime_error, "XMIPlayer::readXMIFile(): Cannot determine size of '%s'!", filename);
+    }
+
+    std::string source;
+    source.resize(fileSize);
+    if((fileSize > 0) && (SDL_RWread(file.get(), &source[0], fileSize, 1) != 1)) {
+        THROW(std::runtime_error, "XMIPlayer::readXMIFile(): Reading '%s' failed!", filename);
+    }
+
+    return source;
+}
+
+std::vector<std::vector<Uint8>> XMIPlayer::convertXMIFile(const std::string& filename, const std::string& source) {
+    TRACE_ZONE("Convert XMI");
+
+    unsigned char sourceHash[16];
+    md5(reinterpret_cast<const unsigned char*>(source.data()), static_cast<int>(source.size()), sourceHash);
+
+    char cacheDirectory[FILENAME_MAX];
+    fnkdat(XMIPLAYER_CACHE_DIRECTORY "/", cacheDirectory, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+    const std::string cacheFilepath = std::string(cacheDirectory) + getBasename(filename, true) + ".bin";
+
+    std::vector<std::vector<Uint8>> tracks;
+    if(loadFromCache(cacheFilepath, sourceHash, tracks)) {
+        return tracks;
+    }
+
+    BufferDataSource input(const_cast<char*>(source.data()), static_cast<unsigned int>(source.size()));
+    XMIDI myXMIDI(&input, XMIDI_CONVERT_NOCONVERSION);
+
+    tracks.resize(myXMIDI.number_of_tracks());
+    for(size_t i = 0; i < tracks.size(); i++) {
+        // without a destination only the size is determined
+        const int size = myXMIDI.retrieve(i, nullptr);
+        if(size <= 0) {
+            continue;
+        }
+
+        tracks[i].resize(size);
+        BufferDataSource output(reinterpret_cast<char*>(tracks[i].data()), size);
+        myXMIDI.retrieve(i, &output);
+    }
+
+    saveToCache(cacheFilepath, sourceHash, tracks);
+
+    return tracks;
+}
+
+bool XMIPlayer::loadFromCache(const std::string& cacheFilepath, const unsigned char sourceHash[16], std::vector<std::vector<Uint8>>& tracks) {
+    if(!existsFile(cacheFilepath)) {
+        return false;
+    }
+
+    try {
+        const std::string cachedData = readCompleteFile(cacheFilepath);
+        IMemoryStream stream(cachedData.data(), static_cast<int>(cachedData.size()));
+
+        if((stream.readUint32() != XMIPLAYER_CACHE_MAGIC) || (stream.readUint32() != XMIPLAYER_CACHE_VERSION)
+            || (stream.readUint32() != XMIDI_CONVERT_NOCONVERSION)) {
+            return false;
+        }
+
+        for(int i = 0; i < 16; i++) {
+            if(stream.readUint8() != sourceHash[i]) {
+                return false;
+            }
+        }
+
+        // load into a temporary copy so that a truncated file does not leave half of the tracks behind
+        std::vector<std::vector<Uint8>> cachedTracks(stream.readUint32());
+        for(std::vector<Uint8>& track : cachedTracks) {
+            track.resize(stream.readUint32());
+            stream.readBytes(track.data(), track.size());
+        }
+        tracks = std::move(cachedTracks);
+    } catch(std::exception& e) {
+        SDL_Log("XMIPlayer: Ignoring converted music '%s': %s", cacheFilepath.c_str(), e.what());
+        return false;
+    }
+
+    return true;
+}
+
+void XMIPlayer::saveToCache(const std::string& cacheFilepath, const unsigned char sourceHash[16], const std::vector<std::vector<Uint8>>& tracks) {
+    OMemoryStream stream;
+    stream.open();
+
+    stream.writeUint32(XMIPLAYER_CACHE_MAGIC);
+    stream.writeUint32(XMIPLAYER_CACHE_VERSION);
+    stream.writeUint32(XMIDI_CONVERT_NOCONVERSION);
+    for(int i = 0; i < 16; i++) {
+        stream.writeUint8(sourceHash[i]);
+    }
+    stream.writeUint32(tracks.size());
+    for(const std::vector<Uint8>& track : tracks) {
+        stream.writeUint32(track.size());
+        stream.writeBytes(track.data(), track.size());
+    }
+
+    // write to a temporary file first so that concurrently starting games never see a partially written file
+    const std::string tmpFilepath = cacheFilepath + ".tmp";
+    bool bWriteOk = false;
+    {
+        sdl2::RWops_ptr file{ SDL_RWFromFile(tmpFilepath.c_str(), "wb") };
+        if(file) {
+            bWriteOk = (SDL_RWwrite(file.get(), stream.getData(), stream.getDataLength(), 1) == 1);
+        }
+    }
+
+    if(!bWriteOk || (std::rename(tmpFilepath.c_str(), cacheFilepath.c_str()) != 0)) {
+        SDL_Log("XMIPlayer: Cannot write converted music to '%s'", cacheFilepath.c_str());
+        std::remove(tmpFilepath.c_str());
+    }
+}
+
+int XMIPlayer::preconvertThreadMain(void* data) {
+    TRACE_THREAD_NAME("XMIPreconvert");
+    static_cast<XMIPlayer*>(data)->preconvertAll();
+    return 0;
+}
+
+void XMIPlayer::preconvertAll() {
+    for(const auto& preconvertSource : preconvertSources) {
+        const std::string& filename = preconvertSource.first;
+
+        SDL_LockMutex(midiCacheMutex);
+        const bool bStop = bStopPreconvert;
+        const bool bConverted = (midiCache.count(filename) > 0);
+        SDL_UnlockMutex(midiCacheMutex);
+
+        if(bStop) {
+            return;
+        } else if(bConverted) {
+            continue;
+        }
+
+        try {
+            std::vector<std::vector<Uint8>> tracks = convertXMIFile(filename, preconvertSource.second);
+
+            SDL_LockMutex(midiCacheMutex);
+            midiCache.emplace(filename, std::move(tracks));
+            SDL_UnlockMutex(midiCacheMutex);
+        } catch(std::exception& e) {
+            // this file is converted again on first use
+            SDL_Log("XMIPlayer: Converting %s in the background failed: %s", filename.c_str(), e.what());
+        }
+    }
+
+    // the main thread never touches preconvertSources while this thread runs
+    preconvertSources.clear();
+    preconvertSources.shrink_to_fit();
 }
@@ -0,0 +1,243 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FlowFieldCache.h>
+
+#include <globals.h>
+
+#include <Game.h>
+#include <Map.h>
+#include <misc/InputStream.h>
+#include <misc/OutputStream.h>
+#include <units/TrackedUnit.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#define FLOWFIELD_MAX_FIELDS        8                       ///< maximum number of flow fields kept at the same time
+#define FLOWFIELD_LIFETIME          MILLI2CYCLES(20*1000)   ///< flow fields unused for this time are discarded
+#define FLOWFIELD_GROUP_TIME        MILLI2CYCLES(5*1000)    ///< requests within this time are considered to belong to one order
+#define FLOWFIELD_CHECKED_STEPS     3                       ///< number of path steps checked against the current map state
+
+FlowFieldCache::FlowFieldCache(const Map* pMap)
+ : pMap(pMap) {
+}
+
+void FlowFieldCache::reset() {
+    flowFields.clear();
+    recentRequests.clear();
+}
+
+void FlowFieldCache::invalidate() {
+    flowFields.clear();
+}
+
+void FlowFieldCache::load(InputStream& stream) {
+    flowFields.clear();
+    const Uint32 numFlowFields = stream.readUint32();
+    for(Uint32 i = 0; i < numFlowFields; i++) {
+        FlowField flowField;
+        flowField.destination.x = stream.readSint32();
+        flowField.destination.y = stream.readSint32();
+        flowField.movementClass = stream.readSint32();
+        flowField.lastUsedCycle = stream.readUint32();
+        flowFields.push_back(std::move(flowField));
+    }
+
+    recentRequests.clear();
+    const Uint32 numRequests = stream.readUint32();
+    for(Uint32 i = 0; i < numRequests; i++) {
+        PathRequest request;
+        request.destination.x = stream.readSint32();
+        request.destination.y = stream.readSint32();
+        request.movementClass = stream.readSint32();
+        request.objectID = stream.readUint32();
+        request.cycle = stream.readUint32();
+        recentRequests.push_back(request);
+    }
+}
+
+void FlowFieldCache::save(OutputStream& stream) const {
+    stream.writeUint32(flowFields.size());
+    for(const FlowField& flowField : flowFields) {
+        stream.writeSint32(flowField.destination.x);
+        stream.writeSint32(flowField.destination.y);
+        stream.writeSint32(flowField.movementClass);
+        stream.writeUint32(flowField.lastUsedCycle);
+    }
+
+    stream.writeUint32(recentRequests.size());
+    for(const PathRequest& request : recentRequests) {
+        stream.writeSint32(request.destination.x);
+        stream.writeSint32(request.destination.y);
+        stream.writeSint32(request.movementClass);
+        stream.writeUint32(request.objectID);
+        stream.writeUint32(request.cycle);
+    }
+}
+
+bool FlowFieldCache::getPath(const UnitBase* pUnit, const Coord& destination, std::list<Coord>& path) {
+    const int movementClass = getMovementClass(pUnit);
+    if((movementClass < 0) || !pMap->tileExists(destination) || !pMap->tileExists(pUnit->getLocation())) {
+        return false;
+    }
+
+    const Uint32 cycle = currentGame->getGameCycleCount();
+
+    flowFields.erase(std::remove_if(flowFields.begin(), flowFields.end(),
+                                    [cycle](const FlowField& flowField) { return flowField.lastUsedCycle + FLOWFIELD_LIFETIME < cycle; }),
+                     flowFields.end());
+    recentRequests.erase(std::remove_if(recentRequests.begin(), recentRequests.end(),
+                                        [cycle](const PathRequest& request) { return request.cycle + FLOWFIELD_GROUP_TIME < cycle; }),
+                         recentRequests.end());
+
+    auto iter = std::find_if(flowFields.begin(), flowFields.end(),
+                             [&](const FlowField& flowField) { return (flowField.destination == destination) && (flowField.movementClass == movementClass); });
+
+    if(iter == flowFields.end()) {
+        auto requestIter = std::find_if(recentRequests.begin(), recentRequests.end(),
+                                        [&](const PathRequest& request) { return (request.destination == destination) && (request.movementClass == movementClass); });
+
+        if((requestIter == recentRequests.end()) || (requestIter->objectID == pUnit->getObjectID())) {
+            // a single unit is cheaper to handle with AStarSearch
+            if(requestIter == recentRequests.end()) {
+                recentRequests.push_back(PathRequest{destination, movementClass, pUnit->getObjectID(), cycle});
+            } else {
+                requestIter->cycle = cycle;
+            }
+            return false;
+        }
+
+        recentRequests.erase(requestIter);
+
+        if(flowFields.size() >= FLOWFIELD_MAX_FIELDS) {
+            flowFields.erase(std::min_element(flowFields.begin(), flowFields.end(),
+                                              [](const FlowField& a, const FlowField& b) { return a.lastUsedCycle < b.lastUsedCycle; }));
+        }
+
+        flowFields.emplace_back();
+        iter = std::prev(flowFields.end());
+        iter->destination = destination;
+        iter->movementClass = movementClass;
+    }
+
+    if(iter->costs.empty()) {
+        // a new field or one loaded from a savegame; all units of a movement class have the same terrain difficulties
+        calculateFlowField(pUnit, *iter);
+    }
+
+    iter->lastUsedCycle = cycle;
+
+    const int sizeX = pMap->getSizeX();
+    const std::vector<FixPoint>& costs = iter->costs;
+
+    Coord current = pUnit->getLocation();
+    if(costs[current.y*sizeX + current.x] == FixPt_MAX) {
+        return false;
+    }
+
+    path.clear();
+    while(current != destination) {
+        // follow the field to the neighbour with the smallest cost (lowest angle on ties)
+        Coord next = Coord::Invalid();
+        FixPoint nextCost = costs[current.y*sizeX + current.x];
+        for(int angle = 0; angle < NUM_ANGLES; angle++) {
+            const Coord neighbour = Map::getMapPos(angle, current);
+            if(pMap->tileExists(neighbour) && (costs[neighbour.y*sizeX + neighbour.x] < nextCost)) {
+                next = neighbour;
+                nextCost = costs[neighbour.y*sizeX + neighbour.x];
+            }
+        }
+
+        if(next.isInvalid()) {
+            path.clear();
+            return false;
+        }
+
+        if((path.size() < FLOWFIELD_CHECKED_STEPS) && !pUnit->canPass(next.x, next.y)) {
+            path.clear();
+            return false;
+        }
+
+        path.push_back(next);
+        current = next;
+    }
+
+    return !path.empty();
+}
+
+int FlowFieldCache::getMovementClass(const UnitBase* pUnit) {
+    if(!pUnit->isAGroundUnit() || (pUnit->getItemID() == Unit_Sandworm)) {
+        return -1;
+    } else if(pUnit->isInfantry()) {
+        return 2;
+    } else if(dynamic_cast<const TrackedUnit*>(pUnit) != nullptr) {
+        return 1;
+    } else {
+        return 0;
+    }
+}
+
+void FlowFieldCache::calculateFlowField(const UnitBase* pUnit, FlowField& flowField) const {
+    const int sizeX = pMap->getSizeX();
+    const int sizeY = pMap->getSizeY();
+    const bool bInfantry = pUnit->isInfantry();
+
+    flowField.costs.assign(sizeX*sizeY, FixPt_MAX);
+
+    typedef std::pair<FixPoint,int> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> openList;
+
+    const int destIndex = flowField.destination.y*sizeX + flowField.destination.x;
+    flowField.costs[destIndex] = 0;
+    openList.emplace(0, destIndex);
+
+    while(!openList.empty()) {
+        const FixPoint cost = openList.top().first;
+        const int index = openList.top().second;
+        openList.pop();
+
+        if(cost > flowField.costs[index]) {
+            continue;
+        }
+
+        // moving from a neighbour onto this tile costs the terrain difficulty of this tile (like in AStarSearch)
+        const Coord current(index % sizeX, index / sizeX);
+        const FixPoint difficulty = pUnit->getTerrainDifficulty(static_cast<TERRAINTYPE>(pMap->getTile(current)->getType()));
+
+        for(int angle = 0; angle < NUM_ANGLES; angle++) {
+            const Coord next = Map::getMapPos(angle, current);
+            if(!pMap->tileExists(next)) {
+                continue;
+            }
+
+            const Tile* pTile = pMap->getTile(next);
+            if(pTile->hasAStructure() || (!bInfantry && pTile->isMountain())) {
+                continue;
+            }
+
+            const int nextIndex = next.y*sizeX + next.x;
+            const FixPoint nextCost = cost + (((next.x != current.x) && (next.y != current.y)) ? FixPt_SQRT2*difficulty : difficulty);
+            if(nextCost < flowField.costs[nextIndex]) {
+                flowField.costs[nextIndex] = nextCost;
+                openList.emplace(nextCost, nextIndex);
+            }
+        }
+    }
+}
@@ -0,0 +1,266 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FogOverlayCache.h>
+
+#include <globals.h>
+
+#include <FileClasses/GFXManager.h>
+
+#include <Game.h>
+#include <Map.h>
+#include <ScreenBorder.h>
+#include <Tile.h>
+#include <mmath.h>
+
+#include <algorithm>
+
+void FogOverlayCache::invalidateAll() {
+    for(auto& chunk : chunks) {
+        chunk.texture.reset();
+        chunk.bDirty = true;
+    }
+}
+
+void FogOverlayCache::draw(int x1, int y1, int x2, int y2, int newTeamID) {
+    if((pMap != currentGameMap) || (mapSizeX != currentGameMap->getSizeX()) || (mapSizeY != currentGameMap->getSizeY()) || (teamID != newTeamID)) {
+        reset(currentGameMap, newTeamID);
+    }
+
+    if(zoomlevel != currentZoomlevel) {
+        invalidateAll();
+        zoomlevel = currentZoomlevel;
+    }
+
+    const auto zoomedTileSize = world2zoomedWorld(TILESIZE);
+
+    if((x1 < 0) || (y1 < 0) || (x2 > mapSizeX) || (y2 > mapSizeY)) {
+        // we are outside the map => draw complete hidden
+        const auto hiddenPic = pGFXManager->getZoomedAtlasPic(ObjPic_Terrain_Hidden, currentZoomlevel);
+        const SDL_Rect source = hiddenPic.getSourceRect(zoomedTileSize*Terrain_HiddenFull, 0, zoomedTileSize, zoomedTileSize);
+
+        for(int x = x1; x < x2; x++) {
+            for(int y = y1; y < y2; y++) {
+                if((x < 0) || (x >= mapSizeX) || (y < 0) || (y >= mapSizeY)) {
+                    SDL_Rect drawLocation = {   screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE),
+                                                zoomedTileSize, zoomedTileSize };
+                    SDL_RenderCopy(renderer, hiddenPic.texture, &source, &drawLocation);
+                }
+            }
+        }
+    }
+
+    const auto minTileX = std::max(0, x1);
+    const auto minTileY = std::max(0, y1);
+    const auto maxTileX = std::min(mapSizeX, x2);
+    const auto maxTileY = std::min(mapSizeY, y2);
+
+    if((minTileX >= maxTileX) || (minTileY >= maxTileY)) {
+        return;
+    }
+
+    const auto minChunkX = minTileX / FOGCHUNK_SIZE;
+    const auto minChunkY = minTileY / FOGCHUNK_SIZE;
+    const auto maxChunkX = (maxTileX - 1) / FOGCHUNK_SIZE;
+    const auto maxChunkY = (maxTileY - 1) / FOGCHUNK_SIZE;
+
+    // the edge tiles of the chunks depend on the tiles next to them
+    updateVisibility(minChunkX*FOGCHUNK_SIZE - 1, minChunkY*FOGCHUNK_SIZE - 1, (maxChunkX + 1)*FOGCHUNK_SIZE + 1, (maxChunkY + 1)*FOGCHUNK_SIZE + 1);
+
+    if(bRenderTargetsFailed) {
+        drawTiles(minTileX, minTileY, maxTileX, maxTileY);
+        return;
+    }
+
+    for(int chunkX = minChunkX; chunkX <= maxChunkX; chunkX++) {
+        for(int chunkY = minChunkY; chunkY <= maxChunkY; chunkY++) {
+            Chunk& chunk = chunks[chunkY*numChunksX + chunkX];
+
+            const auto tileX = chunkX*FOGCHUNK_SIZE;
+            const auto tileY = chunkY*FOGCHUNK_SIZE;
+            const auto chunkSizeX = std::min(FOGCHUNK_SIZE, mapSizeX - tileX);
+            const auto chunkSizeY = std::min(FOGCHUNK_SIZE, mapSizeY - tileY);
+
+            if((chunk.bDirty || !chunk.texture) && !renderChunk(chunk, chunkX, chunkY)) {
+                drawTiles(tileX, tileY, tileX + chunkSizeX, tileY + chunkSizeY);
+                continue;
+            }
+
+            SDL_Rect dest = {   screenborder->world2screenX(tileX*TILESIZE), screenborder->world2screenY(tileY*TILESIZE),
+                                chunkSizeX*zoomedTileSize, chunkSizeY*zoomedTileSize };
+            SDL_RenderCopy(renderer, chunk.texture.get(), nullptr, &dest);
+        }
+    }
+}
+
+void FogOverlayCache::reset(const Map* pNewMap, int newTeamID) {
+    pMap = pNewMap;
+    teamID = newTeamID;
+    mapSizeX = pMap->getSizeX();
+    mapSizeY = pMap->getSizeY();
+    numChunksX = (mapSizeX + FOGCHUNK_SIZE - 1) / FOGCHUNK_SIZE;
+    numChunksY = (mapSizeY + FOGCHUNK_SIZE - 1) / FOGCHUNK_SIZE;
+
+    visibility.assign(mapSizeX*mapSizeY, Visibility_Unknown);
+
+    chunks.clear();
+    chunks.resize(numChunksX*numChunksY);
+}
+
+void FogOverlayCache::updateVisibility(int x1, int y1, int x2, int y2) {
+    x1 = std::max(0, x1);
+    y1 = std::max(0, y1);
+    x2 = std::min(mapSizeX, x2);
+    y2 = std::min(mapSizeY, y2);
+
+    for(int x = x1; x < x2; x++) {
+        for(int y = y1; y < y2; y++) {
+            const Tile* pTile = pMap->getTile(x, y);
+
+            Uint8 newVisibility = 0;
+            if(pTile->isExploredByTeam(teamID)) {
+                newVisibility |= Visibility_Explored;
+            }
+            if(pTile->isFoggedByTeam(teamID)) {
+                newVisibility |= Visibility_Fogged;
+            }
+
+            Uint8& oldVisibility = visibility[x*mapSizeY + y];
+            if(newVisibility != oldVisibility) {
+                oldVisibility = newVisibility;
+                invalidateArea(x - 1, y - 1, 3, 3);
+            }
+        }
+    }
+}
+
+void FogOverlayCache::invalidateArea(int x, int y, int width, int height) {
+    const auto minChunkX = std::max(0, x / FOGCHUNK_SIZE);
+    const auto minChunkY = std::max(0, y / FOGCHUNK_SIZE);
+    const auto maxChunkX = std::min(numChunksX - 1, (x + width - 1) / FOGCHUNK_SIZE);
+    const auto maxChunkY = std::min(numChunksY - 1, (y + height - 1) / FOGCHUNK_SIZE);
+
+    for(int chunkX = minChunkX; chunkX <= maxChunkX; chunkX++) {
+        for(int chunkY = minChunkY; chunkY <= maxChunkY; chunkY++) {
+            chunks[chunkY*numChunksX + chunkX].bDirty = true;
+        }
+    }
+}
+
+bool FogOverlayCache::renderChunk(Chunk& chunk, int chunkX, int chunkY) {
+    const auto zoomedTileSize = world2zoomedWorld(TILESIZE);
+
+    const auto tileX = chunkX*FOGCHUNK_SIZE;
+    const auto tileY = chunkY*FOGCHUNK_SIZE;
+    const auto chunkSizeX = std::min(FOGCHUNK_SIZE, mapSizeX - tileX);
+    const auto chunkSizeY = std::min(FOGCHUNK_SIZE, mapSizeY - tileY);
+
+    if(!chunk.texture) {
+        chunk.texture = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, chunkSizeX*zoomedTileSize, chunkSizeY*zoomedTileSize) };
+        if(chunk.texture == nullptr) {
+            SDL_Log("FogOverlayCache: SDL_CreateTexture() failed: %s", SDL_GetError());
+            bRenderTargetsFailed = true;
+            return false;
+        }
+        SDL_SetTextureBlendMode(chunk.texture.get(), SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_Texture* oldRenderTarget = SDL_GetRenderTarget(renderer);
+    if(SDL_SetRenderTarget(renderer, chunk.texture.get()) != 0) {
+        SDL_Log("FogOverlayCache: SDL_SetRenderTarget() failed: %s", SDL_GetError());
+        SDL_SetRenderTarget(renderer, oldRenderTarget);
+        bRenderTargetsFailed = true;
+        invalidateAll();
+        return false;
+    }
+
+    // Visible tiles stay transparent. The shroud and fog pictures are black, so blending them onto a transparent
+    // texture first and the texture onto the screen afterwards gives the same result as blending them directly.
+    Uint8 oldR, oldG, oldB, oldA;
+    SDL_GetRenderDrawColor(renderer, &oldR, &oldG, &oldB, &oldA);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, oldR, oldG, oldB, oldA);
+
+    for(int x = 0; x < chunkSizeX; x++) {
+        for(int y = 0; y < chunkSizeY; y++) {
+            drawTile(tileX + x, tileY + y, x*zoomedTileSize, y*zoomedTileSize);
+        }
+    }
+
+    SDL_SetRenderTarget(renderer, oldRenderTarget);
+
+    chunk.bDirty = false;
+    return true;
+}
+
+void FogOverlayCache::drawTiles(int x1, int y1, int x2, int y2) const {
+    for(int x = x1; x < x2; x++) {
+        for(int y = y1; y < y2; y++) {
+            drawTile(x, y, screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE));
+        }
+    }
+}
+
+void FogOverlayCache::drawTile(int x, int y, int screenX, int screenY) const {
+    const auto hiddenPic = pGFXManager->getZoomedAtlasPic(ObjPic_Terrain_Hidden, currentZoomlevel);
+    const auto zoomedTileSize = world2zoomedWorld(TILESIZE);
+    SDL_Rect drawLocation = { screenX, screenY, zoomedTileSize, zoomedTileSize };
+
+    const Uint8 tileVisibility = visibility[x*mapSizeY + y];
+
+    if((tileVisibility & Visibility_Explored) == 0) {
+        SDL_Rect source = hiddenPic.getSourceRect(zoomedTileSize*Terrain_HiddenFull, 0, zoomedTileSize, zoomedTileSize);
+        SDL_RenderCopy(renderer, hiddenPic.texture, &source, &drawLocation);
+        return;
+    }
+
+    const int hideTile = getEdgeTile(x, y, Visibility_Explored, false);
+    if(hideTile != 0) {
+        SDL_Rect source = hiddenPic.getSourceRect(hideTile*zoomedTileSize, 0, zoomedTileSize, zoomedTileSize);
+        SDL_RenderCopy(renderer, hiddenPic.texture, &source, &drawLocation);
+    }
+
+    if(currentGame->getGameInitSettings().getGameOptions().fogOfWar == true) {
+        const int fogTile = (tileVisibility & Visibility_Fogged) ? Terrain_HiddenFull : getEdgeTile(x, y, Visibility_Fogged, true);
+
+        if(fogTile != 0) {
+            const auto hiddenFogPic = pGFXManager->getZoomedAtlasPic(ObjPic_Terrain_HiddenFog, currentZoomlevel);
+            SDL_Rect source = hiddenFogPic.getSourceRect(fogTile*zoomedTileSize, 0, zoomedTileSize, zoomedTileSize);
+            SDL_RenderCopy(renderer, hiddenFogPic.texture, &source, &drawLocation);
+        }
+    }
+}
+
+int FogOverlayCache::getEdgeTile(int x, int y, Uint8 flag, bool bSet) const {
+    // same as Tile::getHideTile() (flag = Visibility_Explored, bSet = false) and Tile::getFogTile() (flag = Visibility_Fogged, bSet = true)
+    const auto hasFlag = [&](int neighbourX, int neighbourY) {
+        return ((visibility[neighbourX*mapSizeY + neighbourY] & flag) != 0) == bSet;
+    };
+
+    const bool up = (y > 0) && hasFlag(x, y - 1);
+    const bool right = (x < mapSizeX - 1) && hasFlag(x + 1, y);
+    const bool down = (y < mapSizeY - 1) && hasFlag(x, y + 1);
+    const bool left = (x > 0) && hasFlag(x - 1, y);
+
+    if(!up && !right && !down && !left) {
+        return 0;
+    }
+
+    // tiles outside the map count as hidden/fogged
+    return (((int) (up || (y == 0))) | ((right || (x == mapSizeX - 1)) << 1) | ((down || (y == mapSizeY - 1)) << 2) | ((left || (x == 0)) << 3));
+}
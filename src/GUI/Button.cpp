@@ -166,7 +166,11 @@ void Button::draw(Point position) {
 void Button::drawOverlay(Point position) {
     if(!isVisible() || !isEnabled() || bHover != true || !tooltipTexture) return;
 
-    if(SDL_GetTicks() - tooltipLastMouseMotion <= 750) return;
+    if(SDL_GetTicks() - tooltipLastMouseMotion <= 750) {
+        // show the tooltip as soon as it is due
+        requestRedraw(751 - (SDL_GetTicks() - tooltipLastMouseMotion));
+        return;
+    }
 
     SDL_Rect renderRect = getRendererSize();
     SDL_Rect dest = calcDrawingRect(tooltipTexture.get(), drawnMouseX, drawnMouseY, HAlign::Left, VAlign::Bottom);
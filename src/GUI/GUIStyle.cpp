@@ -17,6 +17,8 @@
 
 #include <GUI/GUIStyle.h>
 
+#include <misc/draw_util.h>
+
 std::unique_ptr<GUIStyle> GUIStyle::currentGUIStyle;
 
 GUIStyle::GUIStyle() {
@@ -38,3 +40,42 @@ sdl2::surface_ptr GUIStyle::createEmptySurface(Uint32 width, Uint32 height, bool
 
     return pSurface;
 }
+
+void GUIStyle::clearSurfaceCache() {
+    surfaceCacheIndex.clear();
+    surfaceCacheList.clear();
+}
+
+sdl2::surface_ptr GUIStyle::getCachedSurface(const std::string& key) {
+    auto iter = surfaceCacheIndex.find(key);
+    if(iter == surfaceCacheIndex.end()) {
+        return nullptr;
+    }
+
+    // move to the front of the lru list
+    surfaceCacheList.splice(surfaceCacheList.begin(), surfaceCacheList, iter->second);
+
+    return copySurface(iter->second->second.get());
+}
+
+sdl2::surface_ptr GUIStyle::cacheSurface(const std::string& key, sdl2::surface_ptr pSurface) {
+    if(pSurface == nullptr) {
+        return pSurface;
+    }
+
+    auto iter = surfaceCacheIndex.find(key);
+    if(iter != surfaceCacheIndex.end()) {
+        surfaceCacheList.erase(iter->second);
+        surfaceCacheIndex.erase(iter);
+    }
+
+    surfaceCacheList.emplace_front(key, copySurface(pSurface.get()));
+    surfaceCacheIndex[key] = surfaceCacheList.begin();
+
+    while(surfaceCacheList.size() > GUISTYLE_SURFACECACHESIZE) {
+        surfaceCacheIndex.erase(surfaceCacheList.back().first);
+        surfaceCacheList.pop_back();
+    }
+
+    return pSurface;
+}
@@ -26,6 +26,8 @@ ListBox::ListBox() {
     bAutohideScrollbar = true;
     bHighlightSelectedElement = true;
     firstVisibleElement = 0;
+    firstRenderedElement = 0;
+    numRenderedElements = 0;
     selectedElement = -1;
     lastClickTime = 0;
 
@@ -120,8 +122,17 @@ void ListBox::draw(Point position) {
         SDL_RenderCopy(renderer, pBackground.get(), nullptr, &dest);
     }
 
-    SDL_Rect dest = calcDrawingRect(pForeground.get(), position.x + 2, position.y + 1);
-    SDL_RenderCopy(renderer, pForeground.get(), nullptr, &dest);
+    if(pForeground != nullptr) {
+        // only the visible part of the rendered entries is drawn
+        const int entryHeight = static_cast<int>(GUIStyle::getInstance().getListBoxEntryHeight());
+        const int textureHeight = getHeight(pForeground.get());
+        const int offset = std::min((firstVisibleElement - firstRenderedElement) * entryHeight, textureHeight);
+        const int visibleHeight = std::min(std::max(getSize().y - 2, 0), textureHeight - offset);
+
+        SDL_Rect source = { 0, offset, getWidth(pForeground.get()), visibleHeight };
+        SDL_Rect dest = { position.x + 2, position.y + 1, source.w, source.h };
+        SDL_RenderCopy(renderer, pForeground.get(), &source, &dest);
+    }
 
     Point ScrollBarPos = position;
     ScrollBarPos.x += getSize().x - scrollbar.getSize().x;
@@ -136,6 +147,7 @@ void ListBox::resize(Uint32 width, Uint32 height) {
 
     scrollbar.resize(scrollbar.getMinimumSize().x,height);
 
+    invalidateTextures();
     updateList();
 }
 
@@ -190,16 +202,16 @@ void ListBox::updateTextures() {
     }
 
     if (!pForeground) {
-        // create surfaces
-        int surfaceHeight = getSize().y - 2;
-        if (surfaceHeight < 0) {
-            surfaceHeight = 0;
-        }
+        // only the visible entries and a margin of LISTBOX_RENDERMARGIN entries above and below are rendered
+        const int entryHeight = static_cast<int>(GUIStyle::getInstance().getListBoxEntryHeight());
+        const int numVisibleElements = getNumVisibleElements();
 
-        sdl2::surface_ptr pForegroundSurface = sdl2::surface_ptr{ GUIStyle::getInstance().createEmptySurface(getSize().x - 4, surfaceHeight, true) };
+        firstRenderedElement = std::max(0, firstVisibleElement - LISTBOX_RENDERMARGIN);
+        numRenderedElements = (firstVisibleElement - firstRenderedElement) + numVisibleElements + LISTBOX_RENDERMARGIN;
 
-        int numVisibleElements = static_cast<int>(surfaceHeight / GUIStyle::getInstance().getListBoxEntryHeight());
-        for (int i = firstVisibleElement; i < firstVisibleElement + numVisibleElements; ++i) {
+        sdl2::surface_ptr pForegroundSurface = sdl2::surface_ptr{ GUIStyle::getInstance().createEmptySurface(getSize().x - 4, numRenderedElements * entryHeight, true) };
+
+        for (int i = firstRenderedElement; i < firstRenderedElement + numRenderedElements; ++i) {
             if (i >= getNumEntries())
                 break;
 
@@ -207,7 +219,7 @@ void ListBox::updateTextures() {
                                                                                                         bHighlightSelectedElement && (i == selectedElement),
                                                                                                         color) };
 
-            SDL_Rect dest = calcDrawingRect(pSurface.get(), 0, (i - firstVisibleElement) * static_cast<int>(GUIStyle::getInstance().getListBoxEntryHeight()));
+            SDL_Rect dest = calcDrawingRect(pSurface.get(), 0, (i - firstRenderedElement) * entryHeight);
             SDL_BlitSurface(pSurface.get(), nullptr, pForegroundSurface.get(), &dest);
         }
         pForeground = convertSurfaceToTexture(std::move(pForegroundSurface));
@@ -215,16 +227,21 @@ void ListBox::updateTextures() {
 }
 
 void ListBox::updateList() {
-    invalidateTextures();
+    // the background only depends on the size of this list box
+    pForeground.reset();
+    requestRedraw();
+
+    const int numVisibleElements = getNumVisibleElements();
 
-    // create surfaces
+    scrollbar.setRange(0,std::max(0,getNumEntries() - numVisibleElements));
+    scrollbar.setBigStepSize(std::max(1, numVisibleElements-1));
+}
+
+int ListBox::getNumVisibleElements() const {
     int surfaceHeight = getSize().y - 2;
     if(surfaceHeight < 0) {
         surfaceHeight = 0;
     }
 
-    const int numVisibleElements = surfaceHeight / GUIStyle::getInstance().getListBoxEntryHeight();
-
-    scrollbar.setRange(0,std::max(0,getNumEntries() - numVisibleElements));
-    scrollbar.setBigStepSize(std::max(1, numVisibleElements-1));
+    return surfaceHeight / static_cast<int>(GUIStyle::getInstance().getListBoxEntryHeight());
 }
@@ -30,6 +30,9 @@ Window::Window(Uint32 x, Uint32 y, Uint32 w, Uint32 h) : position(x,y) {
     pBackground = nullptr;
     bSelfGeneratedBackground = true;
 
+    bRedrawRequested = false;
+    redrawTime = 0;
+
     resize(w,h);
 }
 
@@ -56,6 +59,7 @@ void Window::openWindow(Window* pChildWindow) {
         this->pChildWindow = pChildWindow;
         this->pChildWindow->setParent(this);
         pChildWindowAlreadyClosed = false;
+        requestRedraw();
     }
 }
 
@@ -68,6 +72,23 @@ void Window::closeChildWindow() {
     }
 }
 
+void Window::requestRedraw(Uint32 delay) {
+    if(getParent() != nullptr) {
+        Widget::requestRedraw(delay);
+        return;
+    }
+
+    const Uint32 newRedrawTime = SDL_GetTicks() + delay;
+    if(!bRedrawRequested || (static_cast<Sint32>(newRedrawTime - redrawTime) < 0)) {
+        redrawTime = newRedrawTime;
+        bRedrawRequested = true;
+    }
+}
+
+bool Window::isRedrawRequested() const {
+    return bRedrawRequested && (static_cast<Sint32>(redrawTime - SDL_GetTicks()) <= 0);
+}
+
 void Window::setCurrentPosition(Uint32 x, Uint32 y, Uint32 w, Uint32 h) {
     position.x = x; position.y = y;
     resize(w,h);
@@ -91,6 +112,7 @@ bool Window::processChildWindowOpenCloses() {
             pChildWindow = nullptr;
         }
 
+        requestRedraw();
     }
 
     return bClosed;
@@ -296,8 +318,11 @@ void Window::setBackground(sdl2::texture_unique_or_nonowning_ptr pBackground) {
         bSelfGeneratedBackground = false;
         this->pBackground = std::move(pBackground);
     }
+
+    requestRedraw();
 }
 
 void Window::setTransparentBackground(bool bTransparent) {
     bTransparentBackground = bTransparent;
+    requestRedraw();
 }
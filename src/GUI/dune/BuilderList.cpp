@@ -71,7 +71,8 @@ BuilderList::BuilderList(Uint32 builderObjectID) {
     pUnitLimitReachedTextTexture = pFontManager->createTextureWithMultilineText(_("UNIT LIMIT\nREACHED"), COLOR_WHITE, 12, true);
 
     pLastTooltip = nullptr;
-    tooltipText = "";
+    tooltipItemID = ItemID_Invalid;
+    bTooltipWaitingToPlace = false;
     lastMouseMovement = (1u<<31);
 
     resize(BuilderList::getMinimumSize().x, BuilderList::getMinimumSize().y);
@@ -191,7 +192,6 @@ bool BuilderList::handleKeyPress(SDL_KeyboardEvent& key) {
 void BuilderList::draw(Point position) {
     SDL_Rect blackRectDest = {  position.x, position.y + ARROWBTN_HEIGHT + BUILDERBTN_SPACING,
                                 getSize().x, getRealHeight(getSize().y) - 2*(ARROWBTN_HEIGHT + BUILDERBTN_SPACING) - BUILDERBTN_SPACING - ORDERBTN_HEIGHT };
-    renderFillRect(renderer, &blackRectDest, COLOR_BLACK);
 
     BuilderBase* pBuilder = dynamic_cast<BuilderBase*>(currentGame->getObjectManager().getObject(builderObjectID));
     if(pBuilder != nullptr) {
@@ -224,98 +224,166 @@ void BuilderList::draw(Point position) {
             downButton.setVisible(false);
         }
 
-        int i = 0;
-        for(const BuildItem& buildItem : pBuilder->getBuildList()) {
+        getButtonStates(pBuilder, buttonStates);
+    } else {
+        buttonStates.clear();
+    }
 
-            if((i >= currentListPos) && (i < currentListPos+getNumButtons(getSize().y) )) {
-                SDL_Texture* pTexture = resolveItemPicture(buildItem.itemID);
+    if(!drawCachedButtons(Point(blackRectDest.x, blackRectDest.y), Point(blackRectDest.w, blackRectDest.h))) {
+        renderFillRect(renderer, &blackRectDest, COLOR_BLACK);
+        drawButtons(position);
+    }
 
-                const SDL_Rect dest = calcDrawingRect(pTexture, position.x + getButtonPosition(i - currentListPos).x, position.y + getButtonPosition(i - currentListPos).y);
+    SDL_Texture* pBuilderListUpperCap = pGFXManager->getUIGraphic(UI_BuilderListUpperCap);
+    SDL_Rect builderListUpperCapDest = calcDrawingRect(pBuilderListUpperCap, blackRectDest.x - 3, blackRectDest.y - 13 + 4);
+    SDL_RenderCopy(renderer, pBuilderListUpperCap, nullptr, &builderListUpperCapDest);
 
-                if(pTexture != nullptr) {
-                    SDL_Rect tmpDest = dest;
-                    SDL_RenderCopy(renderer, pTexture, nullptr, &tmpDest);
-                }
+    SDL_Texture* pBuilderListLowerCap = pGFXManager->getUIGraphic(UI_BuilderListLowerCap);
+    SDL_Rect builderListLowerCapDest = calcDrawingRect(pBuilderListLowerCap, blackRectDest.x - 3, blackRectDest.y + blackRectDest.h - 3 - 4);
+    SDL_RenderCopy(renderer, pBuilderListLowerCap, nullptr, &builderListLowerCapDest);
+
+    renderDrawVLine(renderer, builderListUpperCapDest.x + builderListUpperCapDest.w - 8, builderListUpperCapDest.y + builderListUpperCapDest.h, builderListLowerCapDest.y, COLOR_RGB(125,80,0));
+
+    StaticContainer::draw(position);
+}
 
-                if(isStructure(buildItem.itemID)) {
-                    SDL_Texture* pLattice = pGFXManager->getUIGraphic(UI_StructureSizeLattice);
-                    SDL_Rect destLattice = calcDrawingRect(pLattice, dest.x + 2, dest.y + 2);
-                    SDL_RenderCopy(renderer, pLattice, nullptr, &destLattice);
+void BuilderList::getButtonStates(BuilderBase* pBuilder, std::vector<ButtonState>& states) {
+    states.clear();
 
-                    SDL_Texture* pConcrete = pGFXManager->getUIGraphic(UI_StructureSizeConcrete);
-                    SDL_Rect srcConcrete = { 0, 0, 1 + getStructureSize(buildItem.itemID).x*6, 1 + getStructureSize(buildItem.itemID).y*6 };
-                    SDL_Rect destConcrete = { dest.x + 2, dest.y + 2, srcConcrete.w, srcConcrete.h };
-                    SDL_RenderCopy(renderer, pConcrete, &srcConcrete, &destConcrete);
+    StarPort* pStarport = dynamic_cast<StarPort*>(pBuilder);
+
+    int i = 0;
+    for(const BuildItem& buildItem : pBuilder->getBuildList()) {
+        if((i >= currentListPos) && (i < currentListPos+getNumButtons(getSize().y) )) {
+            ButtonState state;
+            state.slot = i - currentListPos;
+            state.itemID = buildItem.itemID;
+            state.price = buildItem.price;
+            state.num = buildItem.num;
+
+            if(pStarport != nullptr) {
+                bool bSoldOut = (pStarport->getOwner()->getChoam().getNumAvailable(buildItem.itemID) == 0);
+
+                if(!pStarport->okToOrder() || bSoldOut) {
+                    state.shadeWidth = BUILDERBTN_WIDTH;
                 }
 
-                // draw price
-                sdl2::texture_ptr pPriceTexture = pFontManager->createTextureWithText(fmt::sprintf("%d", buildItem.price), COLOR_WHITE, 12);
-                SDL_Rect drawLocation = calcDrawingRect(pPriceTexture.get(), dest.x + 2, dest.y + BUILDERBTN_HEIGHT - getHeight(pPriceTexture.get()) + 3);
-                SDL_RenderCopy(renderer, pPriceTexture.get(), nullptr, &drawLocation);
-
-                if(pStarport != nullptr) {
-                    bool bSoldOut = (pStarport->getOwner()->getChoam().getNumAvailable(buildItem.itemID) == 0);
-
-                    if(!pStarport->okToOrder() || bSoldOut) {
-                        SDL_Rect progressBar = { dest.x, dest.y, BUILDERBTN_WIDTH, BUILDERBTN_HEIGHT };
-                        renderFillRect(renderer, &progressBar, COLOR_HALF_TRANSPARENT);
-                    }
-
-                    if(bSoldOut) {
-                        SDL_Rect drawLocationSoldOut = calcDrawingRect(pSoldOutTextTexture.get(), dest.x + BUILDERBTN_WIDTH/2, dest.y + BUILDERBTN_HEIGHT/2, HAlign::Center, VAlign::Center);
-                        SDL_RenderCopy(renderer, pSoldOutTextTexture.get(), nullptr, &drawLocationSoldOut);
-                    }
-
-                } else if(currentGame->getGameInitSettings().getGameOptions().onlyOnePalace && buildItem.itemID == Structure_Palace && pBuilder->getOwner()->getNumItems(Structure_Palace) > 0) {
-
-                    SDL_Rect progressBar = { dest.x, dest.y, BUILDERBTN_WIDTH, BUILDERBTN_HEIGHT };
-                    renderFillRect(renderer, &progressBar, COLOR_HALF_TRANSPARENT);
-
-                    SDL_Rect drawLocationAlreadyBuilt = calcDrawingRect(pAlreadyBuiltTextTexture.get(), dest.x + BUILDERBTN_WIDTH/2, dest.y + BUILDERBTN_HEIGHT/2, HAlign::Center, VAlign::Center);
-                    SDL_RenderCopy(renderer, pAlreadyBuiltTextTexture.get(), nullptr, &drawLocationAlreadyBuilt);
-                } else if(buildItem.itemID == pBuilder->getCurrentProducedItem()) {
-                    FixPoint progress = pBuilder->getProductionProgress();
-                    FixPoint price = buildItem.price;
-                    int max_x = lround((progress/price)*BUILDERBTN_WIDTH);
-
-                    SDL_Rect progressBar = { dest.x, dest.y, max_x, BUILDERBTN_HEIGHT };
-                    renderFillRect(renderer, &progressBar, COLOR_HALF_TRANSPARENT);
-
-                    if(pBuilder->isWaitingToPlace()) {
-                        SDL_Rect drawLocationWaitingToPlace = calcDrawingRect(pPlaceItTextTexture.get(), dest.x + BUILDERBTN_WIDTH/2, dest.y + BUILDERBTN_HEIGHT/2, HAlign::Center, VAlign::Center);
-                        SDL_RenderCopy(renderer, pPlaceItTextTexture.get(), nullptr, &drawLocationWaitingToPlace);
-                    } else if(pBuilder->isOnHold()) {
-                        SDL_Rect drawLocationOnHold = calcDrawingRect(pOnHoldTextTexture.get(), dest.x + BUILDERBTN_WIDTH/2, dest.y + BUILDERBTN_HEIGHT/2, HAlign::Center, VAlign::Center);
-                        SDL_RenderCopy(renderer, pOnHoldTextTexture.get(), nullptr, &drawLocationOnHold);
-                    } else if(pBuilder->isUnitLimitReached(buildItem.itemID)) {
-                        SDL_Rect drawLocationUnitLimitReached = calcDrawingRect(pUnitLimitReachedTextTexture.get(), dest.x + BUILDERBTN_WIDTH/2, dest.y + BUILDERBTN_HEIGHT/2, HAlign::Center, VAlign::Center);
-                        SDL_RenderCopy(renderer, pUnitLimitReachedTextTexture.get(), nullptr, &drawLocationUnitLimitReached);
-                    }
+                if(bSoldOut) {
+                    state.pText = pSoldOutTextTexture.get();
                 }
 
-                if(buildItem.num > 0) {
-                    // draw number of this in build list
-                    sdl2::texture_ptr pNumberTexture = pFontManager->createTextureWithText(fmt::sprintf("%d", buildItem.num), COLOR_RED, 12);
-                    SDL_Rect drawLocationNumber = calcDrawingRect(pNumberTexture.get(), dest.x + BUILDERBTN_WIDTH - 3, dest.y + BUILDERBTN_HEIGHT + 2, HAlign::Right, VAlign::Bottom);
-                    SDL_RenderCopy(renderer, pNumberTexture.get(), nullptr, &drawLocationNumber);
+            } else if(currentGame->getGameInitSettings().getGameOptions().onlyOnePalace && buildItem.itemID == Structure_Palace && pBuilder->getOwner()->getNumItems(Structure_Palace) > 0) {
+                state.shadeWidth = BUILDERBTN_WIDTH;
+                state.pText = pAlreadyBuiltTextTexture.get();
+            } else if(buildItem.itemID == pBuilder->getCurrentProducedItem()) {
+                FixPoint progress = pBuilder->getProductionProgress();
+                FixPoint price = buildItem.price;
+                state.shadeWidth = lround((progress/price)*BUILDERBTN_WIDTH);
+
+                if(pBuilder->isWaitingToPlace()) {
+                    state.pText = pPlaceItTextTexture.get();
+                } else if(pBuilder->isOnHold()) {
+                    state.pText = pOnHoldTextTexture.get();
+                } else if(pBuilder->isUnitLimitReached(buildItem.itemID)) {
+                    state.pText = pUnitLimitReachedTextTexture.get();
                 }
             }
 
-            i++;
+            states.push_back(state);
         }
+
+        i++;
     }
+}
 
-    SDL_Texture* pBuilderListUpperCap = pGFXManager->getUIGraphic(UI_BuilderListUpperCap);
-    SDL_Rect builderListUpperCapDest = calcDrawingRect(pBuilderListUpperCap, blackRectDest.x - 3, blackRectDest.y - 13 + 4);
-    SDL_RenderCopy(renderer, pBuilderListUpperCap, nullptr, &builderListUpperCapDest);
+void BuilderList::drawButtons(Point position) {
+    for(const ButtonState& state : buttonStates) {
+        SDL_Texture* pTexture = resolveItemPicture(state.itemID);
 
-    SDL_Texture* pBuilderListLowerCap = pGFXManager->getUIGraphic(UI_BuilderListLowerCap);
-    SDL_Rect builderListLowerCapDest = calcDrawingRect(pBuilderListLowerCap, blackRectDest.x - 3, blackRectDest.y + blackRectDest.h - 3 - 4);
-    SDL_RenderCopy(renderer, pBuilderListLowerCap, nullptr, &builderListLowerCapDest);
+        const SDL_Rect dest = calcDrawingRect(pTexture, position.x + getButtonPosition(state.slot).x, position.y + getButtonPosition(state.slot).y);
 
-    renderDrawVLine(renderer, builderListUpperCapDest.x + builderListUpperCapDest.w - 8, builderListUpperCapDest.y + builderListUpperCapDest.h, builderListLowerCapDest.y, COLOR_RGB(125,80,0));
+        if(pTexture != nullptr) {
+            SDL_Rect tmpDest = dest;
+            SDL_RenderCopy(renderer, pTexture, nullptr, &tmpDest);
+        }
 
-    StaticContainer::draw(position);
+        if(isStructure(state.itemID)) {
+            SDL_Texture* pLattice = pGFXManager->getUIGraphic(UI_StructureSizeLattice);
+            SDL_Rect destLattice = calcDrawingRect(pLattice, dest.x + 2, dest.y + 2);
+            SDL_RenderCopy(renderer, pLattice, nullptr, &destLattice);
+
+            SDL_Texture* pConcrete = pGFXManager->getUIGraphic(UI_StructureSizeConcrete);
+            SDL_Rect srcConcrete = { 0, 0, 1 + getStructureSize(state.itemID).x*6, 1 + getStructureSize(state.itemID).y*6 };
+            SDL_Rect destConcrete = { dest.x + 2, dest.y + 2, srcConcrete.w, srcConcrete.h };
+            SDL_RenderCopy(renderer, pConcrete, &srcConcrete, &destConcrete);
+        }
+
+        // draw price
+        pFontManager->drawText(dest.x + 2, dest.y + BUILDERBTN_HEIGHT - pFontManager->getTextHeight(12) + 3, currentGame->getFrameArena().sprintf("%d", state.price), COLOR_WHITE, 12);
+
+        if(state.shadeWidth > 0) {
+            SDL_Rect progressBar = { dest.x, dest.y, state.shadeWidth, BUILDERBTN_HEIGHT };
+            renderFillRect(renderer, &progressBar, COLOR_HALF_TRANSPARENT);
+        }
+
+        if(state.pText != nullptr) {
+            SDL_Rect drawLocationText = calcDrawingRect(state.pText, dest.x + BUILDERBTN_WIDTH/2, dest.y + BUILDERBTN_HEIGHT/2, HAlign::Center, VAlign::Center);
+            SDL_RenderCopy(renderer, state.pText, nullptr, &drawLocationText);
+        }
+
+        if(state.num > 0) {
+            // draw number of this in build list
+            const std::string& strNumber = currentGame->getFrameArena().sprintf("%d", state.num);
+            pFontManager->drawText(dest.x + BUILDERBTN_WIDTH - 2 - pFontManager->getTextWidth(strNumber, 12), dest.y + BUILDERBTN_HEIGHT + 3 - pFontManager->getTextHeight(12), strNumber, COLOR_RED, 12);
+        }
+    }
+}
+
+bool BuilderList::drawCachedButtons(Point areaPosition, Point areaSize) {
+    if(bRenderTargetsFailed || (areaSize.x <= 0) || (areaSize.y <= 0)) {
+        return false;
+    }
+
+    if((pButtonsTexture == nullptr) || !(areaSize == buttonsTextureSize)) {
+        pButtonsTexture = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, areaSize.x, areaSize.y) };
+        if(pButtonsTexture == nullptr) {
+            SDL_Log("BuilderList: SDL_CreateTexture() failed: %s", SDL_GetError());
+            bRenderTargetsFailed = true;
+            return false;
+        }
+        buttonsTextureSize = areaSize;
+        bButtonsTextureValid = false;
+    }
+
+    if(!bButtonsTextureValid || (buttonStates != renderedButtonStates)) {
+        SDL_Texture* oldRenderTarget = SDL_GetRenderTarget(renderer);
+        if(SDL_SetRenderTarget(renderer, pButtonsTexture.get()) != 0) {
+            SDL_Log("BuilderList: SDL_SetRenderTarget() failed: %s", SDL_GetError());
+            SDL_SetRenderTarget(renderer, oldRenderTarget);
+            pButtonsTexture.reset();
+            bRenderTargetsFailed = true;
+            return false;
+        }
+
+        Uint8 oldR, oldG, oldB, oldA;
+        SDL_GetRenderDrawColor(renderer, &oldR, &oldG, &oldB, &oldA);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        SDL_SetRenderDrawColor(renderer, oldR, oldG, oldB, oldA);
+
+        // the buttons are drawn relative to this widget and the texture starts at the top of the black area
+        drawButtons(Point(0, -(ARROWBTN_HEIGHT + BUILDERBTN_SPACING)));
+
+        SDL_SetRenderTarget(renderer, oldRenderTarget);
+
+        renderedButtonStates = buttonStates;
+        bButtonsTextureValid = true;
+    }
+
+    SDL_Rect dest = { areaPosition.x, areaPosition.y, areaSize.x, areaSize.y };
+    SDL_RenderCopy(renderer, pButtonsTexture.get(), nullptr, &dest);
+
+    return true;
 }
 
 void BuilderList::drawOverlay(Point position) {
@@ -331,19 +399,23 @@ void BuilderList::drawOverlay(Point position) {
 
         const auto buildItemIter = std::next(pBuilder->getBuildList().begin(), btn);
 
-        std::string text = resolveItemName(buildItemIter->itemID);
-
-        if(buildItemIter->itemID == pBuilder->getCurrentProducedItem() && pBuilder->isWaitingToPlace()) {
-            text += " (Hotkey: P)";
-        }
+        const bool bWaitingToPlace = (buildItemIter->itemID == pBuilder->getCurrentProducedItem()) && pBuilder->isWaitingToPlace();
 
-        if(text != tooltipText) {
+        // the tooltip is only rendered again if it shows a different text
+        if((buildItemIter->itemID != tooltipItemID) || (bWaitingToPlace != bTooltipWaitingToPlace)) {
             pLastTooltip.reset();
         }
 
         if(pLastTooltip == nullptr) {
+            std::string text = resolveItemName(buildItemIter->itemID);
+
+            if(bWaitingToPlace) {
+                text += " (Hotkey: P)";
+            }
+
             pLastTooltip = convertSurfaceToTexture(GUIStyle::getInstance().createToolTip(text));
-            tooltipText = text;
+            tooltipItemID = buildItemIter->itemID;
+            bTooltipWaitingToPlace = bWaitingToPlace;
         }
 
         SDL_Rect dest = calcDrawingRect(pLastTooltip.get(), position.x + getButtonPosition(btn).x - 6, position.y + lastMousePos.y, HAlign::Right, VAlign::Center);
@@ -64,6 +64,16 @@ Point DuneStyle::getMinimumLabelSize(const std::string& text, int fontSize) {
 }
 
 sdl2::surface_ptr DuneStyle::createLabelSurface(Uint32 width, Uint32 height, const std::vector<std::string>& textLines, int fontSize, Alignment_Enum alignment, Uint32 textcolor, Uint32 textshadowcolor, Uint32 backgroundcolor) {
+    std::string key = "Label|" + std::to_string(width) + "|" + std::to_string(height) + "|" + std::to_string(fontSize) + "|" + std::to_string(alignment)
+                        + "|" + std::to_string(textcolor) + "|" + std::to_string(textshadowcolor) + "|" + std::to_string(backgroundcolor);
+    for(const std::string& textLine : textLines) {
+        key += "\n" + textLine;
+    }
+
+    sdl2::surface_ptr pCachedSurface = getCachedSurface(key);
+    if(pCachedSurface) {
+        return pCachedSurface;
+    }
 
     // create surfaces
     sdl2::surface_ptr surface = sdl2::surface_ptr{ SDL_CreateRGBSurface(0, width, height, SCREEN_BPP, RMASK, GMASK, BMASK, AMASK) };
@@ -117,7 +127,7 @@ sdl2::surface_ptr DuneStyle::createLabelSurface(Uint32 width, Uint32 height, con
         textpos_y += fontheight + spacing;
     }
 
-    return surface;
+    return cacheSurface(key, std::move(surface));
 }
 
 
@@ -296,6 +306,14 @@ Point DuneStyle::getMinimumButtonSize(const std::string& text) {
 }
 
 sdl2::surface_ptr DuneStyle::createButtonSurface(Uint32 width, Uint32 height, const std::string& text, bool pressed, bool activated, Uint32 textcolor, Uint32 textshadowcolor) {
+    const std::string key = "Button|" + std::to_string(width) + "|" + std::to_string(height) + "|" + std::to_string(pressed) + "|" + std::to_string(activated)
+                            + "|" + std::to_string(textcolor) + "|" + std::to_string(textshadowcolor) + "|" + text;
+
+    sdl2::surface_ptr pCachedSurface = getCachedSurface(key);
+    if(pCachedSurface) {
+        return pCachedSurface;
+    }
+
     sdl2::surface_ptr surface = sdl2::surface_ptr{ SDL_CreateRGBSurface(0, width, height, SCREEN_BPP, RMASK, GMASK, BMASK, AMASK) };
     if(!surface) {
         return nullptr;
@@ -338,7 +356,7 @@ sdl2::surface_ptr DuneStyle::createButtonSurface(Uint32 width, Uint32 height, co
     SDL_Rect textRect2 = calcDrawingRect(textSurface2.get(), surface->w / 2 + 1 + (pressed ? 1 : 0), surface->h / 2 + 2 + (pressed ? 1 : 0), HAlign::Center, VAlign::Center);
     SDL_BlitSurface(textSurface2.get(), nullptr, surface.get(), &textRect2);
 
-    return surface;
+    return cacheSurface(key, std::move(surface));
 }
 
 
@@ -489,6 +507,13 @@ Uint32 DuneStyle::getListBoxEntryHeight() {
 }
 
 sdl2::surface_ptr DuneStyle::createListBoxEntry(Uint32 width, const std::string& text, bool selected, Uint32 color) {
+    const std::string key = "ListBoxEntry|" + std::to_string(width) + "|" + std::to_string(selected) + "|" + std::to_string(color) + "|" + text;
+
+    sdl2::surface_ptr pCachedSurface = getCachedSurface(key);
+    if(pCachedSurface) {
+        return pCachedSurface;
+    }
+
     if(color == COLOR_DEFAULT) {
         color = defaultForegroundColor;
     }
@@ -509,7 +534,7 @@ sdl2::surface_ptr DuneStyle::createListBoxEntry(Uint32 width, const std::string&
     SDL_Rect textRect = calcDrawingRect(textSurface.get(), 3, surface->h/2 + 2, HAlign::Left, VAlign::Center);
     SDL_BlitSurface(textSurface.get(),nullptr,surface.get(),&textRect);
 
-    return surface;
+    return cacheSurface(key, std::move(surface));
 }
 
 
@@ -545,6 +570,13 @@ sdl2::surface_ptr DuneStyle::createProgressBarOverlay(Uint32 width, Uint32 heigh
 
 
 sdl2::surface_ptr DuneStyle::createToolTip(const std::string& text) {
+    const std::string key = "ToolTip|" + text;
+
+    sdl2::surface_ptr pCachedSurface = getCachedSurface(key);
+    if(pCachedSurface) {
+        return pCachedSurface;
+    }
+
     sdl2::surface_ptr helpTextSurface = createSurfaceWithText(text, COLOR_YELLOW, 12);
     if(helpTextSurface == nullptr) {
         return nullptr;
@@ -563,7 +595,7 @@ sdl2::surface_ptr DuneStyle::createToolTip(const std::string& text) {
     SDL_Rect textRect = calcDrawingRect(helpTextSurface.get(), 3, 3);
     SDL_BlitSurface(helpTextSurface.get(), nullptr, surface.get(), &textRect);
 
-    return surface;
+    return cacheSurface(key, std::move(surface));
 }
 
 
@@ -138,6 +138,7 @@ void InGameMenu::onChildWindowClose(Window* pChildWindow) {
         if(FileName != "") {
             if(bSave == false) {
                 // load window
+                currentGame->waitForSaveGames();
                 try {
                     currentGame->setNextGameInitSettings(GameInitSettings(FileName));
                 } catch (std::exception& e) {
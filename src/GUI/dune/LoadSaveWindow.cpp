@@ -86,7 +86,7 @@ LoadSaveWindow::LoadSaveWindow(bool bSave, const std::string& caption, const std
 
     mainVBox.addWidget(&buttonHBox);
 
-    okButton.setText(_(bSave ? "Save" : "Load"));
+    okButton.setText(bSave ? _("Save") : _("Load"));
     okButton.setTextColor(color);
     okButton.setOnClick(std::bind(&LoadSaveWindow::onOK, this));
 
@@ -25,15 +25,21 @@
 #include <FileClasses/GFXManager.h>
 #include <FileClasses/FontManager.h>
 #include <FileClasses/TextManager.h>
+#include <FileClasses/SFXManager.h>
 #include <FileClasses/music/MusicPlayer.h>
-#include <FileClasses/LoadSavePNG.h>
 #include <SoundPlayer.h>
-#include <misc/IFileStream.h>
 #include <misc/OFileStream.h>
 #include <misc/IMemoryStream.h>
+#include <misc/OMemoryStream.h>
 #include <misc/FileSystem.h>
 #include <misc/fnkdat.h>
 #include <misc/draw_util.h>
+#include <misc/ScreenshotWriter.h>
+#include <misc/VideoEncoderPipe.h>
+#include <misc/FramePacer.h>
+#include <misc/event_util.h>
+#include <misc/Tracing.h>
+#include <misc/AllocationCounter.h>
 #include <misc/md5.h>
 #include <misc/exceptions.h>
 #include <misc/format.h>
@@ -42,6 +48,9 @@
 #include <players/HumanPlayer.h>
 
 #include <Network/NetworkManager.h>
+#include <Network/BroadcastServer.h>
+#include <Network/BroadcastClient.h>
+#include <Network/MetricsServer.h>
 
 #include <GUI/dune/InGameMenu.h>
 #include <GUI/dune/WaitingForOtherPlayers.h>
@@ -54,6 +63,9 @@
 #include <Bullet.h>
 #include <Explosion.h>
 #include <GameInitSettings.h>
+#include <INIMap/INIMapPreloader.h>
+#include <ReplayFile.h>
+#include <GameEventBus.h>
 #include <ScreenBorder.h>
 #include <sand.h>
 
@@ -62,20 +74,52 @@
 #include <units/UnitBase.h>
 #include <structures/BuilderBase.h>
 #include <structures/Palace.h>
+#include <units/Carryall.h>
+#include <units/Devastator.h>
+#include <units/Deviator.h>
+#include <units/Frigate.h>
 #include <units/Harvester.h>
 #include <units/InfantryBase.h>
+#include <units/Launcher.h>
+#include <units/MCV.h>
+#include <units/Ornithopter.h>
+#include <units/Quad.h>
+#include <units/RaiderTrike.h>
+#include <units/Saboteur.h>
+#include <units/SandWorm.h>
+#include <units/SiegeTank.h>
+#include <units/Soldier.h>
+#include <units/SonicTank.h>
+#include <units/Tank.h>
+#include <units/Trike.h>
+#include <units/Trooper.h>
 
 #include <algorithm>
+#include <numeric>
 #include <sstream>
 #include <iomanip>
 
-Game::Game() {
+#ifdef __linux__
+    #include <unistd.h>
+#endif
+
+Game::Game() : Game(nullptr) {
+}
+
+Game::Game(std::unique_ptr<GameResources> pPreviousResources)
+ : pResources(pPreviousResources ? std::move(pPreviousResources) : std::make_unique<GameResources>()) {
     currentZoomlevel = settings.video.preferredZoomLevel;
 
     localPlayerName = settings.general.playerName;
 
     unitList.clear();       //holds all the units
     structureList.clear();  //all the structures
+    for(EntityList<UnitBase*>& itemUnitList : unitListByItemID) {
+        itemUnitList.clear();
+    }
+    for(EntityList<StructureBase*>& itemStructureList : structureListByItemID) {
+        itemStructureList.clear();
+    }
     bulletList.clear();
 
     sideBarPos = calcAlignedDrawingRect(pGFXManager->getUIGraphic(UI_SideBar), HAlign::Right, VAlign::Top);
@@ -90,6 +134,15 @@ Game::Game() {
     //////////////////////////////////////////////////////////////////////////
     SDL_Rect gameBoardRect = { 0, topBarPos.h, sideBarPos.x, getRendererHeight() - topBarPos.h };
     screenborder = new ScreenBorder(gameBoardRect);
+
+    if(pResources->pWorkerPool != nullptr) {
+        pWorkerPool = std::move(pResources->pWorkerPool);
+    } else {
+        pWorkerPool = std::make_unique<WorkerPool>(WorkerPool::getDefaultNumThreads());
+    }
+
+    terrainChunkCache.adoptTextures(std::move(pResources->terrainChunkTextures), pResources->terrainChunkZoomlevel);
+    pResources->terrainChunkTextures.clear();
 }
 
 
@@ -100,28 +153,31 @@ Game::~Game() {
     if(pNetworkManager != nullptr) {
         pNetworkManager->setOnReceiveChatMessage(std::function<void (const std::string&, const std::string&)>());
         pNetworkManager->setOnReceiveCommandList(std::function<void (const std::string&, const CommandList&)>());
-        pNetworkManager->setOnReceiveSelectionList(std::function<void (const std::string&, const std::set<Uint32>&, int)>());
+        pNetworkManager->setOnReceiveSelectionList(std::function<void (const std::string&, const ObjectIDSet&, int)>());
         pNetworkManager->setOnPeerDisconnected(std::function<void (const std::string&, bool, int)>());
+        pNetworkManager->setGetSnapshotForRejoiningPlayerCallback(std::function<std::string (const std::string&)>());
+        pNetworkManager->setGetCatchUpCommandsCallback(std::function<CatchUpData (const std::string&)>());
+        pNetworkManager->setOnReceiveCatchUpCommands(std::function<void (const CatchUpData&)>());
     }
 
     for(StructureBase* pStructure : structureList) {
         delete pStructure;
     }
     structureList.clear();
+    for(EntityList<StructureBase*>& itemStructureList : structureListByItemID) {
+        itemStructureList.clear();
+    }
 
     for(UnitBase* pUnit : unitList) {
         delete pUnit;
     }
     unitList.clear();
-
-    for(Bullet* pBullet : bulletList) {
-        delete pBullet;
+    for(EntityList<UnitBase*>& itemUnitList : unitListByItemID) {
+        itemUnitList.clear();
     }
+
     bulletList.clear();
 
-    for(Explosion* pExplosion : explosionList) {
-        delete pExplosion;
-    }
     explosionList.clear();
 
     delete currentGameMap;
@@ -156,19 +212,41 @@ void Game::initGame(const GameInitSettings& newGameInitSettings) {
             gameType = gameInitSettings.getGameType();
             randomGen.setSeed(gameInitSettings.getRandomSeed());
 
-            objectData.loadFromINIFile("ObjectData.ini");
+            if(pResources->pObjectData == nullptr) {
+                objectData.loadFromINIFile("ObjectData.ini");
+                pResources->pObjectData = std::make_unique<ObjectData>(objectData);
+            } else {
+                objectData = *pResources->pObjectData;
+            }
 
             if(gameInitSettings.getMission() != 0) {
                 techLevel = ((gameInitSettings.getMission() + 1)/3) + 1 ;
             }
 
-            INIMapLoader(this, gameInitSettings.getFilename(), gameInitSettings.getFiledata());
+            // the scenario file is parsed in the background while the player reads the briefing
+            std::unique_ptr<INIMapPreloader> pPreloader;
+            if((pResources->pScenarioINIFile == nullptr)
+                || (pResources->scenarioGameType != gameType)
+                || (pResources->scenarioFilename != gameInitSettings.getFilename())
+                || (pResources->scenarioFiledata != gameInitSettings.getFiledata())) {
+                pResources->pScenarioINIFile.reset();
+                pPreloader = std::make_unique<INIMapPreloader>(gameType, gameInitSettings.getFilename(), gameInitSettings.getFiledata());
+                pResources->scenarioGameType = gameType;
+                pResources->scenarioFilename = gameInitSettings.getFilename();
+                pResources->scenarioFiledata = gameInitSettings.getFiledata();
+            }
 
             if(bReplay == false && gameInitSettings.getGameType() != GameType::CustomGame && gameInitSettings.getGameType() != GameType::CustomMultiplayer) {
                 /* do briefing */
                 SDL_Log("Briefing...");
                 BriefingMenu(gameInitSettings.getHouseID(), gameInitSettings.getMission(),BRIEFING).showMenu();
             }
+
+            if(pPreloader != nullptr) {
+                pResources->pScenarioINIFile = pPreloader->getINIFile();
+            }
+
+            INIMapLoader(this, pResources->pScenarioINIFile.get(), gameInitSettings.getFilename());
         } break;
 
         default: {
@@ -176,135 +254,757 @@ void Game::initGame(const GameInitSettings& newGameInitSettings) {
     }
 }
 
+std::unique_ptr<GameResources> Game::releaseResources() {
+    pResources->pWorkerPool = std::move(pWorkerPool);
+    pResources->terrainChunkZoomlevel = terrainChunkCache.getZoomlevel();
+    pResources->terrainChunkTextures = terrainChunkCache.releaseTextures();
+
+    return std::move(pResources);
+}
+
 void Game::initReplay(const std::string& filename) {
     bReplay = true;
 
-    IFileStream fs;
+    // override local player name as it was when the replay was created and load all commands
+    std::unique_ptr<GameInitSettings> pLoadedGameInitSettings = ReplayFile::load(filename, localPlayerName, cmdManager);
+
+    initGame(*pLoadedGameInitSettings);
+
+    pReplayKeyframes = std::make_shared<ReplayKeyframes>();
+}
+
+void Game::initReplayFromKeyframe(const std::shared_ptr<ReplayKeyframes>& pKeyframes, Uint32 targetGameCycle, const std::string& replayPlayerName) {
+    bReplay = true;
+    pReplayKeyframes = pKeyframes;
+    localPlayerName = replayPlayerName;
+
+    const Uint32 keyframeCycle = pReplayKeyframes->findKeyframeBefore(targetGameCycle);
+    if(keyframeCycle == INVALID_GAMECYCLE) {
+        THROW(std::invalid_argument, "Game::initReplayFromKeyframe(): There is no keyframe before game cycle %u!", targetGameCycle);
+    }
+
+    const std::string snapshot = pReplayKeyframes->getSnapshot(keyframeCycle);
+    IMemoryStream memStream(snapshot.data(), snapshot.size());
+
+    // multiplayer save games do not contain the local player; it is looked up by name like when loading a multiplayer game
+    memStream.readUint32();     // magic number
+    memStream.readUint32();     // savegame version
+    memStream.readString();     // dune legacy version
+    GameInitSettings snapshotGameInitSettings(memStream);
+    if(snapshotGameInitSettings.getGameType() == GameType::CustomMultiplayer) {
+        gameInitSettings = GameInitSettings("", snapshot, "");
+        for(const GameInitSettings::HouseInfo& houseInfo : snapshotGameInitSettings.getHouseInfoList()) {
+            gameInitSettings.addHouseInfo(houseInfo);
+        }
+    }
+
+    memStream.open(snapshot.data(), snapshot.size());
+    if(loadSaveGame(memStream) == false) {
+        THROW(std::runtime_error, "Loading replay keyframe failed!");
+    }
+
+    skipToGameCycle = targetGameCycle;
+}
+
+void Game::initSpectator(std::unique_ptr<BroadcastClient> pNewBroadcastClient) {
+    bReplay = true;
+    pBroadcastClient = std::move(pNewBroadcastClient);
+
+    bool bHeaderReceived = false;
+    GameInitSettings spectatedGameInitSettings;
+    pBroadcastClient->setOnReceiveHeader([&](const std::string& header) {
+        IMemoryStream memStream(header.data(), header.size());
+
+        // the header is the beginning of the replay file of the broadcasting player
+        localPlayerName = memStream.readString();
+        spectatedGameInitSettings = GameInitSettings(memStream);
+        cmdManager.load(memStream);
+
+        // the first commands might be received in the same update()
+        pBroadcastClient->setOnReceiveCommands(std::bind(&Game::onReceiveBroadcastCommands, this, std::placeholders::_1, std::placeholders::_2));
+        bHeaderReceived = true;
+    });
+
+    const Uint32 startTime = SDL_GetTicks();
+    while(!bHeaderReceived) {
+        if(pBroadcastClient->isDisconnected() || (SDL_GetTicks() - startTime > BROADCAST_CONNECT_TIMEOUT)) {
+            THROW(std::runtime_error, "Game::initSpectator(): Cannot receive the broadcast!");
+        }
+
+        pBroadcastClient->update(10);
+    }
+    pBroadcastClient->setOnReceiveHeader(std::function<void (const std::string&)>());
+
+    initGame(spectatedGameInitSettings);
+}
+
+void Game::onReceiveBroadcastCommands(Uint32 availableCycle, const std::string& commands) {
+    // the commands are added like when loading a replay
+    const bool bReadOnly = cmdManager.getReadOnly();
+    cmdManager.setReadOnly(false);
+    IMemoryStream memStream(commands.data(), commands.size());
+    cmdManager.load(memStream);
+    cmdManager.setReadOnly(bReadOnly);
+
+    if(!bBroadcastCaughtUp) {
+        // a spectator joining late fast forwards to the current state of the broadcast
+        skipToGameCycle = availableCycle;
+        bBroadcastCaughtUp = true;
+    }
+}
+
+void Game::startBroadcast() {
+    try {
+        pBroadcastServer = std::make_unique<BroadcastServer>(settings.network.broadcastPort, MILLI2CYCLES(settings.network.broadcastDelay*1000));
+    } catch (std::exception& e) {
+        SDL_Log("Warning: Cannot broadcast this game: %s", e.what());
+        return;
+    }
+
+    // spectators receive the same stream that is written to the replay file
+    OMemoryStream memStream;
+    memStream.open();
+    saveReplay(memStream);
+    pBroadcastServer->setHeader(std::string(memStream.getData(), memStream.getDataLength()));
+
+    cmdManager.setOnAddCommand([this](Uint32 cycle, const Command& command) {
+        OMemoryStream commandStream;
+        commandStream.open();
+        commandStream.writeUint32(cycle);
+        command.save(commandStream);
+        pBroadcastServer->addCommands(cycle, std::string(commandStream.getData(), commandStream.getDataLength()));
+    });
+}
+
+std::string Game::getMetrics() {
+    std::string metrics;
+
+    metrics += "# TYPE dunelegacy_game_cycle counter\n";
+    metrics += fmt::sprintf("dunelegacy_game_cycle %u\n", gameCycleCount);
+
+    // the profiler only has samples if PROFILING or TRACING is defined
+    metrics += "# TYPE dunelegacy_phase_microseconds gauge\n";
+    for(int phase = 0; phase <= ProfilerPhase_Frame; phase++) {
+        const Profiler::Statistics statistics = profiler.getStatistics(static_cast<ProfilerPhase>(phase));
+        if(statistics.numSamples == 0) {
+            continue;
+        }
+
+        const char* phaseName = Profiler::getPhaseName(static_cast<ProfilerPhase>(phase));
+        metrics += fmt::sprintf("dunelegacy_phase_microseconds{phase=\"%s\",stat=\"avg\"} %.1f\n", phaseName, statistics.avg);
+        metrics += fmt::sprintf("dunelegacy_phase_microseconds{phase=\"%s\",stat=\"p99\"} %.1f\n", phaseName, statistics.p99);
+        metrics += fmt::sprintf("dunelegacy_phase_microseconds{phase=\"%s\",stat=\"max\"} %.1f\n", phaseName, statistics.max);
+    }
+
+    metrics += "# TYPE dunelegacy_network_wait_milliseconds counter\n";
+    metrics += fmt::sprintf("dunelegacy_network_wait_milliseconds %llu\n", (unsigned long long) networkWaitTime);
+
+    if(pNetworkManager != nullptr) {
+        metrics += "# TYPE dunelegacy_peer_rtt_milliseconds gauge\n";
+        for(const auto& peerRTT : pNetworkManager->getPeerRoundTripTimes()) {
+            metrics += fmt::sprintf("dunelegacy_peer_rtt_milliseconds{peer=\"%s\"} %d\n", peerRTT.first, peerRTT.second);
+        }
+    }
+
+    metrics += "# TYPE dunelegacy_objects gauge\n";
+    metrics += fmt::sprintf("dunelegacy_objects{type=\"units\"} %d\n", unitList.size());
+    metrics += fmt::sprintf("dunelegacy_objects{type=\"structures\"} %d\n", structureList.size());
+    metrics += fmt::sprintf("dunelegacy_objects{type=\"bullets\"} %d\n", bulletList.size());
+    metrics += fmt::sprintf("dunelegacy_objects{type=\"explosions\"} %d\n", explosionList.size());
+
+#ifdef __linux__
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if(statm != nullptr) {
+        unsigned long numPages = 0;
+        unsigned long numResidentPages = 0;
+        if(fscanf(statm, "%lu %lu", &numPages, &numResidentPages) == 2) {
+            metrics += "# TYPE dunelegacy_resident_memory_bytes gauge\n";
+            metrics += fmt::sprintf("dunelegacy_resident_memory_bytes %llu\n", (unsigned long long) numResidentPages * sysconf(_SC_PAGESIZE));
+        }
+        fclose(statm);
+    }
+#endif
+
+    return metrics;
+}
+
+void Game::seekReplay(Uint32 targetGameCycle) {
+    if(!bReplay || (pReplayKeyframes == nullptr)) {
+        return;
+    }
+
+    const Uint32 keyframeCycle = pReplayKeyframes->findKeyframeBefore(targetGameCycle);
+
+    const bool bRewind = (targetGameCycle < gameCycleCount);
+    const bool bKeyframeAhead = (keyframeCycle != INVALID_GAMECYCLE) && (keyframeCycle >= gameCycleCount + REPLAY_KEYFRAME_MIN_GAIN);
+    if((keyframeCycle != INVALID_GAMECYCLE) && (bRewind || bKeyframeAhead)) {
+        // continue with a new game loaded from the keyframe
+        replaySeekTarget = targetGameCycle;
+        quitGame();
+    } else if(!bRewind) {
+        skipToGameCycle = targetGameCycle;
+    }
+}
+
+void Game::recordReplayKeyframe() {
+    if((pReplayKeyframes == nullptr) || (gameCycleCount % REPLAY_KEYFRAME_INTERVAL != 0) || pReplayKeyframes->has(gameCycleCount)) {
+        return;
+    }
+
+    OMemoryStream memStream;
+    memStream.open();
+    saveGame(memStream);
+    pReplayKeyframes->add(gameCycleCount, std::string(memStream.getData(), memStream.getDataLength()));
+}
+
+void Game::recordAutoSave() {
+    if((pAutoSaveRing == nullptr) || (gameCycleCount % autosaveInterval != 0)) {
+        return;
+    }
+
+    auto pMemStream = std::make_unique<OMemoryStream>();
+    pMemStream->open();
+    saveGame(*pMemStream);
+
+    if(pSaveGameWriter == nullptr) {
+        pSaveGameWriter = std::make_unique<BackgroundFileWriter>();
+    }
+    pAutoSaveRing->add(std::move(pMemStream), *pSaveGameWriter);
+}
+
+void Game::setHeadless(Uint32 maxGameCycle, bool bKeepReplayKeyframes) {
+    bHeadless = true;
+
+    // nobody can seek in a headless replay
+    if(!bKeepReplayKeyframes) {
+        pReplayKeyframes.reset();
+    }
+
+    if((maxGameCycle == 0) && bReplay) {
+        maxGameCycle = cmdManager.getNumScheduledCycles() + HEADLESS_REPLAY_TRAILING_CYCLES;
+    }
+    headlessMaxGameCycle = maxGameCycle;
+}
+
+void Game::setOfflineRendering(VideoEncoderPipe* pVideoEncoderPipe, int framesPerSecond, Uint32 maxGameCycle) {
+    this->pVideoEncoderPipe = pVideoEncoderPipe;
+    videoFramesPerSecond = framesPerSecond;
+
+    // nobody can seek while rendering offline
+    pReplayKeyframes.reset();
+
+    if((maxGameCycle == 0) && bReplay) {
+        maxGameCycle = cmdManager.getNumScheduledCycles() + HEADLESS_REPLAY_TRAILING_CYCLES;
+    }
+    headlessMaxGameCycle = maxGameCycle;
+}
+
+void Game::setStateHashTrace(Uint32 interval, Uint32 firstGameCycle, Uint32 lastGameCycle) {
+    stateHashTraceInterval = interval;
+    stateHashTraceFirstCycle = firstGameCycle;
+    stateHashTraceLastCycle = lastGameCycle;
+    stateHashTrace.clear();
+}
+
+void Game::setNumWorkerThreads(int numThreads) {
+    pWorkerPool = std::make_unique<WorkerPool>(numThreads);
+}
 
-    if(fs.open(filename) == false) {
-        THROW(io_error, "Error while opening '%s'!", filename);
+
+void Game::reportDesync() {
+    if(firstDesyncGameCycle == INVALID_GAMECYCLE) {
+        firstDesyncGameCycle = gameCycleCount;
     }
+    numDesyncs++;
+}
 
-    // override local player name as it was when the replay was created
-    localPlayerName = fs.readString();
 
-    // read GameInitInfo
-    GameInitSettings loadedGameInitSettings(fs);
+void Game::checkStateHashes(Uint8 playerID, Uint32 gameCycle, const StateHashes& stateHashes) {
+    auto iter = stateHashHistory.find(gameCycle);
+    if((iter == stateHashHistory.end()) || (iter->second == stateHashes)) {
+        return;
+    }
 
-    // load all commands
-    cmdManager.load(fs);
+    const Player* pPlayer = getPlayerByID(playerID);
+    const std::string playername = (pPlayer != nullptr) ? pPlayer->getPlayername() : std::to_string(playerID);
 
-    initGame(loadedGameInitSettings);
+    reportStateHashMismatch(playername, gameCycle, iter->second, stateHashes);
 }
 
+void Game::checkRejoinStateHashes() {
+    if(rejoinCheckCycle != gameCycleCount) {
+        return;
+    }
+
+    rejoinCheckCycle = INVALID_GAMECYCLE;
+
+    const StateHashes ownStateHashes = StateHashes::compute();
+    if(ownStateHashes == rejoinCheckStateHashes) {
+        SDL_Log("Game cycle %d: Caught up with the game host, the state matches", gameCycleCount);
+    } else {
+        reportStateHashMismatch("game host", gameCycleCount, ownStateHashes, rejoinCheckStateHashes);
+    }
+}
+
+void Game::reportStateHashMismatch(const std::string& peerName, Uint32 gameCycle, const StateHashes& ownStateHashes, const StateHashes& stateHashes) {
+    SDL_Log("Warning: Game is asynchronous in game cycle %d! State of %s differs from the state of '%s' in game cycle %d.",
+            gameCycleCount, ownStateHashes.getMismatchingSubsystems(stateHashes).c_str(), peerName.c_str(), gameCycle);
+
+    if(firstDesyncGameCycle == INVALID_GAMECYCLE) {
+        // all peers execute CMD_TEST_STATEHASH in the same game cycle, so their snapshots can be compared
+        char tmp[FILENAME_MAX];
+        fnkdat(fmt::sprintf("desync/%u-%s.txt", gameCycleCount, localPlayerName).c_str(), tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+        if(writeStateSnapshot(tmp)) {
+            SDL_Log("State snapshot written to '%s'", tmp);
+        }
+    }
+
+    reportDesync();
+}
+
+
+template<class UnitType>
+void Game::updateUnitsOfType(const EntityList<UnitBase*>& units) {
+    for(UnitBase* pUnit : units) {
+        pUnit->setLastUpdateCycle(gameCycleCount);
+        SIMULATION_STATS_HOUSE(pUnit->getOwner()->getHouseID());
+        static_cast<UnitType*>(pUnit)->update();
+    }
+}
 
 void Game::processObjects()
 {
-    // update all tiles
-    for(int y = 0; y < currentGameMap->getSizeY(); y++) {
-        for(int x = 0; x < currentGameMap->getSizeX(); x++) {
-            currentGameMap->getTile(x,y)->update();
-        }
+    MEMORY_TAG(MemoryTag_Objects);
+
+    // update all tiles with something to update
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_Tiles);
+        MEMORY_TAG(MemoryTag_Map);
+        currentGameMap->updateTiles();
     }
 
-    for(StructureBase* pStructure : structureList) {
-        pStructure->update();
+    // search the paths requested in the last cycle
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_PathRequests);
+        MEMORY_TAG(MemoryTag_Map);
+        currentGameMap->getPathRequestQueue().service();
+    }
+
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_TargetScans);
+        prefetchTargets();
+    }
+
+    for(UnitBase* pUnit : unitList) {
+        pUnit->savePreviousPosition();
+    }
+
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_Structures);
+        for(StructureBase* pStructure : structureList) {
+            SIMULATION_STATS_HOUSE(pStructure->getOwner()->getHouseID());
+            pStructure->update();
+        }
+
+        // credit the spice refined in this cycle
+        for(int i = 0; i < NUM_HOUSES; i++) {
+            if(house[i] != nullptr) {
+                house[i]->updateEconomy();
+            }
+        }
     }
 
     if ((currentCursorMode == CursorMode_Placing) && selectedList.empty()) {
         currentCursorMode = CursorMode_Normal;
     }
 
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_Units);
+
+        // update the units type by type (in the order of the item ids) so that each loop runs through the same code
+        updateUnitsOfType<Carryall>(unitListByItemID[Unit_Carryall]);
+        updateUnitsOfType<Devastator>(unitListByItemID[Unit_Devastator]);
+        updateUnitsOfType<Deviator>(unitListByItemID[Unit_Deviator]);
+        updateUnitsOfType<Frigate>(unitListByItemID[Unit_Frigate]);
+        updateUnitsOfType<Harvester>(unitListByItemID[Unit_Harvester]);
+        updateUnitsOfType<Soldier>(unitListByItemID[Unit_Soldier]);
+        updateUnitsOfType<Launcher>(unitListByItemID[Unit_Launcher]);
+        updateUnitsOfType<MCV>(unitListByItemID[Unit_MCV]);
+        updateUnitsOfType<Ornithopter>(unitListByItemID[Unit_Ornithopter]);
+        updateUnitsOfType<Quad>(unitListByItemID[Unit_Quad]);
+        updateUnitsOfType<Saboteur>(unitListByItemID[Unit_Saboteur]);
+        updateUnitsOfType<Sandworm>(unitListByItemID[Unit_Sandworm]);
+        updateUnitsOfType<SiegeTank>(unitListByItemID[Unit_SiegeTank]);
+        updateUnitsOfType<SonicTank>(unitListByItemID[Unit_SonicTank]);
+        updateUnitsOfType<Tank>(unitListByItemID[Unit_Tank]);
+        updateUnitsOfType<Trike>(unitListByItemID[Unit_Trike]);
+        updateUnitsOfType<RaiderTrike>(unitListByItemID[Unit_RaiderTrike]);
+        updateUnitsOfType<Trooper>(unitListByItemID[Unit_Trooper]);
+
+        // units created in this cycle whose type was already updated are updated last (in the order they were created)
+        for(UnitBase* pUnit : unitList) {
+            if(pUnit->getLastUpdateCycle() != gameCycleCount) {
+                pUnit->setLastUpdateCycle(gameCycleCount);
+                SIMULATION_STATS_HOUSE(pUnit->getOwner()->getHouseID());
+                pUnit->update();
+            }
+        }
+
+        // book carryalls for the pickups requested by structures, units and ai players in this cycle
+        for(int i = 0; i < NUM_HOUSES; i++) {
+            if(house[i] != nullptr) {
+                house[i]->dispatchCarryalls();
+            }
+        }
+    }
+
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_Bullets);
+        bulletList.forEach([](Bullet* pBullet) { pBullet->update(); });
+    }
+
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_Explosions);
+        explosionList.forEach([](Explosion* pExplosion) { pExplosion->update(); });
+    }
+}
+
+
+void Game::prefetchTargets()
+{
+    targetScanObjects.clear();
+
+    for(StructureBase* pStructure : structureList) {
+        if(pStructure->isTargetScanPending()) {
+            targetScanObjects.push_back(pStructure);
+        }
+    }
+
     for(UnitBase* pUnit : unitList) {
-        pUnit->update();
+        if(pUnit->isTargetScanPending()) {
+            targetScanObjects.push_back(pUnit);
+        }
     }
 
-    for(Bullet* pBullet : bulletList) {
-        pBullet->update();
+    // every scan writes only to its own object, so the results do not depend on the number of threads
+    GameContext* pContext = GameContext::getCurrent();
+    pWorkerPool->parallelFor(static_cast<int>(targetScanObjects.size()), [this, pContext](int i) {
+        GameContext::Scope contextScope(pContext);
+        SIMULATION_STATS_HOUSE(targetScanObjects[i]->getOwner()->getHouseID());
+        targetScanObjects[i]->prefetchTarget();
+    });
+}
+
+
+void Game::planPlayers()
+{
+    planningHouses.clear();
+
+    for(int i = 0; i < NUM_HOUSES; i++) {
+        if((house[i] != nullptr) && house[i]->beginPlanning()) {
+            planningHouses.push_back(house[i].get());
+        }
     }
 
-    for(Explosion* pExplosion : explosionList) {
-        pExplosion->update();
+    if(planningHouses.empty()) {
+        return;
     }
+
+    // the caches must not be filled lazily by several players at once
+    currentGameMap->updateCaches();
+
+    PROFILE_PHASE(profiler, ProfilerPhase_AIPlayers);
+    GameContext* pContext = GameContext::getCurrent();
+    pWorkerPool->parallelFor(static_cast<int>(planningHouses.size()), [this, pContext](int i) {
+        GameContext::Scope contextScope(pContext);
+        SIMULATION_STATS_HOUSE(planningHouses[i]->getHouseID());
+        planningHouses[i]->planPlayers();
+    });
 }
 
 
 void Game::drawScreen()
 {
-    Coord TopLeftTile = screenborder->getTopLeftTile();
-    Coord BottomRightTile = screenborder->getBottomRightTile();
+    const Uint32 numAllocationsAtStart = AllocationCounter::getNumAllocations();
+    frameArena.reset();
+
+    if(bStrategicZoom) {
+        PROFILE_PHASE(profiler, ProfilerPhase_DrawGround);
+        const SDL_Rect gameBoardRect = { 0, topBarPos.h, sideBarPos.x, getRendererHeight() - topBarPos.h };
+        strategicMapView.draw(gameBoardRect, terrainChunkCache);
+    } else {
+        drawGameBoard();
+    }
+
+///////////draw game bar
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_DrawInterface);
+        pInterface->draw(Point(0,0));
+        pInterface->drawOverlay(Point(0,0));
+    }
+
+    // draw chat message currently typed
+    if(chatMode) {
+        pFontManager->drawText(20, getRendererHeight() - 40, frameArena.sprintf("Chat: %s%s", typingChatMessage.c_str(), ((SDL_GetTicks() / 150) % 2 == 0) ? "_" : ""), COLOR_WHITE, 14);
+    }
+
+    if(bShowFPS) {
+        const std::string& strFPS = frameArena.sprintf("fps: %.1f ", 1000.0f/averageFrameTime);
+
+        pFontManager->drawText(sideBarPos.x - strFPS.length()*8, 60, strFPS, COLOR_WHITE, 14);
+
+        const std::string& strCost = frameArena.sprintf("sim: %.1f ms draw: %.1f ms skipped: %.0f%% ", averageSimulationTime, averageRenderTime, skippedFramesRatio*100.0f);
+
+        pFontManager->drawText(sideBarPos.x - strCost.length()*8, 80, strCost, COLOR_WHITE, 14);
+    }
+
+#ifdef PROFILING
+    if(bShowProfiler) {
+        drawProfilerOverlay();
+    }
+#endif
+
+    if(bShowTime) {
+        int seconds = getGameTime() / 1000;
+        const std::string& strTime = frameArena.sprintf(" %.2d:%.2d:%.2d", seconds / 3600, (seconds % 3600)/60, (seconds % 60) );
+
+        pFontManager->drawText(0, getRendererHeight() - pFontManager->getTextHeight(14) + 1, strTime, COLOR_WHITE, 14);
+    }
+
+    if(finished) {
+        const std::string& message = won ? _("You Have Completed Your Mission.") : _("You Have Failed Your Mission.");
+
+        SDL_Texture* pFinishMessageTexture = pFontManager->getCachedTextureWithText(message, COLOR_WHITE, 28);
+        SDL_Rect drawLocation = calcDrawingRect(pFinishMessageTexture, sideBarPos.x/2, topBarPos.h + (getRendererHeight()-topBarPos.h)/2, HAlign::Center, VAlign::Center);
+        SDL_RenderCopy(renderer, pFinishMessageTexture, nullptr, &drawLocation);
+    }
+
+    if(pWaitingForOtherPlayers != nullptr) {
+        pWaitingForOtherPlayers->draw();
+    }
+
+    if(pInGameMenu != nullptr) {
+        pInGameMenu->draw();
+    } else if(pInGameMentat != nullptr) {
+        pInGameMentat->draw();
+    }
+
+    drawCursor();
+
+    numFrameAllocations = AllocationCounter::getNumAllocations() - numAllocationsAtStart;
+}
+
+void Game::getVisibleTiles(const ScreenBorder& border, Coord& topLeftTile, Coord& bottomRightTile) const
+{
+    topLeftTile = border.getTopLeftTile();
+    bottomRightTile = border.getBottomRightTile();
 
     // extend the view a little bit to avoid graphical glitches
-    TopLeftTile.x = std::max(0, TopLeftTile.x - 1);
-    TopLeftTile.y = std::max(0, TopLeftTile.y - 1);
-    BottomRightTile.x = std::min(currentGameMap->getSizeX()-1, BottomRightTile.x + 1);
-    BottomRightTile.y = std::min(currentGameMap->getSizeY()-1, BottomRightTile.y + 1);
+    topLeftTile.x = std::max(0, topLeftTile.x - 1);
+    topLeftTile.y = std::max(0, topLeftTile.y - 1);
+    bottomRightTile.x = std::min(currentGameMap->getSizeX()-1, bottomRightTile.x + 1);
+    bottomRightTile.y = std::min(currentGameMap->getSizeY()-1, bottomRightTile.y + 1);
+}
+
+void Game::drawGameBoard()
+{
+    /* gather everything to draw in one pass over the tiles visible in any viewport */
+
+    for(auto& layerTiles : drawTiles) {
+        layerTiles.clear();
+    }
+
+    Coord viewTopLeft[2];
+    Coord viewBottomRight[2];
+    const int numViews = (pSplitScreenborder != nullptr) ? 2 : 1;
+    getVisibleTiles(*screenborder, viewTopLeft[0], viewBottomRight[0]);
+    if(pSplitScreenborder != nullptr) {
+        getVisibleTiles(*pSplitScreenborder, viewTopLeft[1], viewBottomRight[1]);
+    }
+
+    const auto localTeamID = pLocalHouse->getTeamID();
+
+    const auto gatherTile = [&](Tile& t) {
+        if(t.hasGroundDetails()) {
+            drawTiles[DrawLayer_GroundDetails].push_back(&t);
+        }
+
+        if(t.hasANonInfantryGroundObject()) {
+            drawTiles[DrawLayer_Structures].push_back(&t);
+            drawTiles[DrawLayer_NonInfantryGroundUnits].push_back(&t);
+        }
+
+        if(t.hasAnUndergroundUnit()) {
+            drawTiles[DrawLayer_UndergroundUnits].push_back(&t);
+        }
+
+        if(t.hasDeadUnits()) {
+            drawTiles[DrawLayer_DeadUnits].push_back(&t);
+        }
+
+        if(t.hasInfantry()) {
+            drawTiles[DrawLayer_Infantry].push_back(&t);
+        }
+
+        if(t.hasAnAirUnit()) {
+            drawTiles[DrawLayer_AirUnits].push_back(&t);
+        }
+
+        if(t.hasAnObject() && (debug || t.isExploredByTeam(localTeamID))) {
+            drawTiles[DrawLayer_SelectionRects].push_back(&t);
+        }
+    };
+
+    // column by column like Map::for_each(), so every viewport gets its tiles in the same order as without split view
+    int numTilesGathered = 0;
+    const int minX = (numViews == 1) ? viewTopLeft[0].x : std::min(viewTopLeft[0].x, viewTopLeft[1].x);
+    const int maxX = (numViews == 1) ? viewBottomRight[0].x : std::max(viewBottomRight[0].x, viewBottomRight[1].x);
+    for(int x = minX; x <= maxX; x++) {
+        int rangeY1[2];
+        int rangeY2[2];
+        int numRanges = 0;
+        for(int v = 0; v < numViews; v++) {
+            if((x >= viewTopLeft[v].x) && (x <= viewBottomRight[v].x)) {
+                rangeY1[numRanges] = viewTopLeft[v].y;
+                rangeY2[numRanges] = viewBottomRight[v].y;
+                numRanges++;
+            }
+        }
+
+        if(numRanges == 2) {
+            if(rangeY1[1] < rangeY1[0]) {
+                std::swap(rangeY1[0], rangeY1[1]);
+                std::swap(rangeY2[0], rangeY2[1]);
+            }
+            if(rangeY1[1] <= rangeY2[0] + 1) {
+                // overlapping or adjacent => one range
+                rangeY2[0] = std::max(rangeY2[0], rangeY2[1]);
+                numRanges = 1;
+            }
+        }
+
+        for(int r = 0; r < numRanges; r++) {
+            currentGameMap->for_each(x, rangeY1[r], x + 1, rangeY2[r] + 1, gatherTile);
+            numTilesGathered += rangeY2[r] - rangeY1[r] + 1;
+        }
+    }
+
+    TRACE_COUNTER("Tiles drawn", numTilesGathered);
+
+    if(pSplitScreenborder != nullptr) {
+        // draw the other viewport with its own screen border, everything gathered above is shared
+        ScreenBorder* pActiveScreenborder = screenborder;
+        screenborder = pSplitScreenborder.get();
+        drawViewport(false);
+        screenborder = pActiveScreenborder;
+    }
+
+    drawViewport(true);
+}
+
+void Game::drawViewport(bool bActiveViewport)
+{
+    Coord TopLeftTile;
+    Coord BottomRightTile;
+    getVisibleTiles(*screenborder, TopLeftTile, BottomRightTile);
 
     const auto x1 = TopLeftTile.x;
     const auto y1 = TopLeftTile.y;
     const auto x2 = BottomRightTile.x + 1;
     const auto y2 = BottomRightTile.y + 1;
 
+    if(pSplitScreenborder != nullptr) {
+        SDL_RenderSetClipRect(renderer, &screenborder->getGameBoard());
+    }
+
+    /* pick the tiles of this viewport out of the tiles gathered by drawGameBoard() */
+
+    for(int layer = 0; layer < NUM_DRAWLAYERS; layer++) {
+        std::vector<DrawItem>& drawList = drawLists[layer];
+        drawList.clear();
+
+        for(Tile* pTile : drawTiles[layer]) {
+            const Coord& location = pTile->getLocation();
+            if((location.x >= x1) && (location.x < x2) && (location.y >= y1) && (location.y < y2)) {
+                drawList.push_back( { pTile, screenborder->world2screenX(location.x*TILESIZE), screenborder->world2screenY(location.y*TILESIZE) } );
+            }
+        }
+    }
+
+    TRACE_COUNTER("Draw items", std::accumulate(drawLists.begin(), drawLists.end(), (size_t) 0,
+                                                [](size_t sum, const std::vector<DrawItem>& drawList) { return sum + drawList.size(); }));
+
     /* draw ground */
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_DrawGround);
 
-    currentGameMap->for_each(x1, y1, x2, y2,
-        [](Tile& t) {
-            t.blitGround(screenborder->world2screenX(t.getLocation().x*TILESIZE),
-                screenborder->world2screenY(t.getLocation().y*TILESIZE));
-        });
+        terrainChunkCache.draw(x1, y1, x2, y2);
+
+        for(const auto& item : drawLists[DrawLayer_GroundDetails]) {
+            item.pTile->blitGroundDetails(item.screenX, item.screenY);
+        }
+    }
 
     /* draw structures */
-    currentGameMap->for_each(x1, y1, x2, y2,
-        [](Tile& t) {
-            t.blitStructures(screenborder->world2screenX(t.getLocation().x*TILESIZE),
-                screenborder->world2screenY(t.getLocation().y*TILESIZE));
-        });
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_DrawStructures);
+        for(const auto& item : drawLists[DrawLayer_Structures]) {
+            item.pTile->blitStructures(item.screenX, item.screenY);
+        }
+    }
 
     /* draw underground units */
-    currentGameMap->for_each(x1, y1, x2, y2,
-        [](Tile& t) {
-            t.blitUndergroundUnits(screenborder->world2screenX(t.getLocation().x*TILESIZE),
-                screenborder->world2screenY(t.getLocation().y*TILESIZE));
-        });
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_DrawUndergroundUnits);
+        for(const auto& item : drawLists[DrawLayer_UndergroundUnits]) {
+            item.pTile->blitUndergroundUnits(item.screenX, item.screenY);
+        }
+    }
 
     /* draw dead objects */
-    currentGameMap->for_each(x1, y1, x2, y2,
-        [](Tile& t) {
-            t.blitDeadUnits(screenborder->world2screenX(t.getLocation().x*TILESIZE),
-                screenborder->world2screenY(t.getLocation().y*TILESIZE));
-        });
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_DrawDeadUnits);
+        for(const auto& item : drawLists[DrawLayer_DeadUnits]) {
+            item.pTile->blitDeadUnits(item.screenX, item.screenY);
+        }
+    }
 
     /* draw infantry */
-    currentGameMap->for_each(x1, y1, x2, y2,
-        [](Tile& t) {
-            t.blitInfantry(screenborder->world2screenX(t.getLocation().x*TILESIZE),
-                screenborder->world2screenY(t.getLocation().y*TILESIZE));
-        });
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_DrawInfantry);
+        for(const auto& item : drawLists[DrawLayer_Infantry]) {
+            item.pTile->blitInfantry(item.screenX, item.screenY);
+        }
+    }
 
     /* draw non-infantry ground units */
-    currentGameMap->for_each(x1, y1, x2, y2,
-        [](Tile& t) {
-            t.blitNonInfantryGroundUnits(screenborder->world2screenX(t.getLocation().x*TILESIZE),
-                screenborder->world2screenY(t.getLocation().y*TILESIZE));
-        });
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_DrawGroundUnits);
+        for(const auto& item : drawLists[DrawLayer_NonInfantryGroundUnits]) {
+            item.pTile->blitNonInfantryGroundUnits(item.screenX, item.screenY);
+        }
+    }
 
     /* draw bullets */
-    for(const Bullet* pBullet : bulletList) {
-        pBullet->blitToScreen();
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_DrawBullets);
+        currentGameMap->getBulletDrawBuckets().forEachVisible(TopLeftTile, BottomRightTile, [](const Bullet* pBullet) { pBullet->blitToScreen(); });
     }
 
 
     /* draw explosions */
-    for(const Explosion* pExplosion : explosionList) {
-        pExplosion->blitToScreen();
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_DrawExplosions);
+        currentGameMap->getExplosionDrawBuckets().forEachVisible(TopLeftTile, BottomRightTile, [](const Explosion* pExplosion) { pExplosion->blitToScreen(); });
     }
 
     /* draw air units */
-    currentGameMap->for_each(x1, y1, x2, y2,
-        [&](Tile& t) {
-            t.blitAirUnits(screenborder->world2screenX(t.getLocation().x*TILESIZE),
-                screenborder->world2screenY(t.getLocation().y*TILESIZE));
-        });
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_DrawAirUnits);
+        for(const auto& item : drawLists[DrawLayer_AirUnits]) {
+            item.pTile->blitAirUnits(item.screenX, item.screenY);
+        }
+    }
 
     // draw the gathering point line if a structure is selected
     if(selectedList.size() == 1) {
@@ -315,75 +1015,29 @@ void Game::drawScreen()
     }
 
     /* draw selection rectangles */
-    currentGameMap->for_each(x1, y1, x2, y2,
-        [](Tile& t) {
-            if (debug || t.isExploredByTeam(pLocalHouse->getTeamID())) {
-                t.blitSelectionRects(screenborder->world2screenX(t.getLocation().x*TILESIZE),
-                    screenborder->world2screenY(t.getLocation().y*TILESIZE));
-            }
-        });
+    {
+        PROFILE_PHASE(profiler, ProfilerPhase_DrawSelectionRects);
+        for(const auto& item : drawLists[DrawLayer_SelectionRects]) {
+            item.pTile->blitSelectionRects(item.screenX, item.screenY);
+        }
+
+        // the lines of the gathering point, selection boxes and health bars collected above
+        primitiveBatcher.flush(renderer);
+    }
 
 
 //////////////////////////////draw unexplored/shade
 
     if(debug == false) {
-        SDL_Texture* hiddenTexZoomed = pGFXManager->getZoomedObjPic(ObjPic_Terrain_Hidden, currentZoomlevel);
-        SDL_Texture* hiddenFogTexZoomed = pGFXManager->getZoomedObjPic(ObjPic_Terrain_HiddenFog, currentZoomlevel);
-        int zoomedTileSize = world2zoomedWorld(TILESIZE);
-        for(int x = screenborder->getTopLeftTile().x - 1; x <= screenborder->getBottomRightTile().x + 1; x++) {
-            for (int y = screenborder->getTopLeftTile().y - 1; y <= screenborder->getBottomRightTile().y + 1; y++) {
-
-                if((x >= 0) && (x < currentGameMap->getSizeX()) && (y >= 0) && (y < currentGameMap->getSizeY())) {
-                    Tile* pTile = currentGameMap->getTile(x, y);
-
-                    if(pTile->isExploredByTeam(pLocalHouse->getTeamID())) {
-                        int hideTile = pTile->getHideTile(pLocalHouse->getTeamID());
-
-                        if(hideTile != 0) {
-                            SDL_Rect source = { hideTile*zoomedTileSize, 0, zoomedTileSize, zoomedTileSize };
-                            SDL_Rect drawLocation = {   screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE),
-                                                        zoomedTileSize, zoomedTileSize };
-                            SDL_RenderCopy(renderer, hiddenTexZoomed, &source, &drawLocation);
-                        }
-
-                        if(gameInitSettings.getGameOptions().fogOfWar == true) {
-                            int fogTile = pTile->getFogTile(pLocalHouse->getTeamID());
-
-                            if(pTile->isFoggedByTeam(pLocalHouse->getTeamID()) == true) {
-                                fogTile = Terrain_HiddenFull;
-                            }
-
-                            if(fogTile != 0) {
-                                SDL_Rect source = { fogTile*zoomedTileSize, 0,
-                                                    zoomedTileSize, zoomedTileSize };
-                                SDL_Rect drawLocation = {   screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE),
-                                                            zoomedTileSize, zoomedTileSize };
-
-                                SDL_RenderCopy(renderer, hiddenFogTexZoomed, &source, &drawLocation);
-                            }
-                        }
-                    } else {
-                        if(!debug) {
-                            SDL_Rect source = { zoomedTileSize*15, 0, zoomedTileSize, zoomedTileSize };
-                            SDL_Rect drawLocation = {   screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE),
-                                                        zoomedTileSize, zoomedTileSize };
-                            SDL_RenderCopy(renderer, hiddenTexZoomed, &source, &drawLocation);
-                        }
-                    }
-                } else {
-                    // we are outside the map => draw complete hidden
-                    SDL_Rect source = { zoomedTileSize*15, 0, zoomedTileSize, zoomedTileSize };
-                    SDL_Rect drawLocation = {   screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE),
-                                                zoomedTileSize, zoomedTileSize };
-                    SDL_RenderCopy(renderer, hiddenTexZoomed, &source, &drawLocation);
-                }
-            }
-        }
+        PROFILE_PHASE(profiler, ProfilerPhase_DrawFog);
+        fogOverlayCache.draw(screenborder->getTopLeftTile().x - 1, screenborder->getTopLeftTile().y - 1,
+                             screenborder->getBottomRightTile().x + 2, screenborder->getBottomRightTile().y + 2,
+                             pLocalHouse->getTeamID());
     }
 
 /////////////draw placement position
 
-    if(currentCursorMode == CursorMode_Placing) {
+    if(bActiveViewport && (currentCursorMode == CursorMode_Placing)) {
         //if user has selected to place a structure
 
         if(screenborder->isScreenCoordInsideMap(drawnMouseX, drawnMouseY)) {
@@ -451,7 +1105,7 @@ void Game::drawScreen()
     }
 
 ///////////draw game selection rectangle
-    if(selectionMode) {
+    if(bActiveViewport && selectionMode) {
 
         int finalMouseX = drawnMouseX;
         int finalMouseY = drawnMouseY;
@@ -488,75 +1142,50 @@ void Game::drawScreen()
         SDL_RenderCopy(renderer, pUIIndicator, &source, &drawLocation);
     }
 
+    if(pSplitScreenborder != nullptr) {
+        SDL_RenderSetClipRect(renderer, nullptr);
 
-///////////draw game bar
-    pInterface->draw(Point(0,0));
-    pInterface->drawOverlay(Point(0,0));
-
-    // draw chat message currently typed
-    if(chatMode) {
-        sdl2::texture_ptr pChatTexture = pFontManager->createTextureWithText("Chat: " + typingChatMessage + (((SDL_GetTicks() / 150) % 2 == 0) ? "_" : ""), COLOR_WHITE, 14);
-        SDL_Rect drawLocation = calcDrawingRect(pChatTexture.get(), 20, getRendererHeight() - 40);
-        SDL_RenderCopy(renderer, pChatTexture.get(), nullptr, &drawLocation);
-    }
-
-    if(bShowFPS) {
-        std::string strFPS = fmt::sprintf("fps: %.1f ", 1000.0f/averageFrameTime);
-
-        sdl2::texture_ptr pFPSTexture = pFontManager->createTextureWithText(strFPS, COLOR_WHITE, 14);
-        SDL_Rect drawLocation = calcDrawingRect(pFPSTexture.get(),sideBarPos.x - strFPS.length()*8, 60);
-        SDL_RenderCopy(renderer, pFPSTexture.get(), nullptr, &drawLocation);
-    }
-
-    if(bShowTime) {
-        int seconds = getGameTime() / 1000;
-        std::string strTime = fmt::sprintf(" %.2d:%.2d:%.2d", seconds / 3600, (seconds % 3600)/60, (seconds % 60) );
-
-        sdl2::texture_ptr pTimeTexture = pFontManager->createTextureWithText(strTime, COLOR_WHITE, 14);
-        SDL_Rect drawLocation = calcAlignedDrawingRect(pTimeTexture.get(), HAlign::Left, VAlign::Bottom);
-        drawLocation.y++;
-        SDL_RenderCopy(renderer, pTimeTexture.get(), nullptr, &drawLocation);
-    }
-
-    if(finished) {
-        std::string message;
-
-        if(won) {
-            message = _("You Have Completed Your Mission.");
-        } else {
-            message = _("You Have Failed Your Mission.");
+        // the line between the viewports
+        const SDL_Rect& gameBoard = screenborder->getGameBoard();
+        if(gameBoard.x > 0) {
+            renderDrawVLine(renderer, gameBoard.x - 1, gameBoard.y, gameBoard.y + gameBoard.h - 1, COLOR_BLACK);
         }
-
-        sdl2::texture_ptr pFinishMessageTexture = pFontManager->createTextureWithText(message.c_str(), COLOR_WHITE, 28);
-        SDL_Rect drawLocation = calcDrawingRect(pFinishMessageTexture.get(), sideBarPos.x/2, topBarPos.h + (getRendererHeight()-topBarPos.h)/2, HAlign::Center, VAlign::Center);
-        SDL_RenderCopy(renderer, pFinishMessageTexture.get(), nullptr, &drawLocation);
-    }
-
-    if(pWaitingForOtherPlayers != nullptr) {
-        pWaitingForOtherPlayers->draw();
     }
-
-    if(pInGameMenu != nullptr) {
-        pInGameMenu->draw();
-    } else if(pInGameMentat != nullptr) {
-        pInGameMentat->draw();
-    }
-
-    drawCursor();
 }
 
 
 void Game::doInput()
 {
+    // events left over when the time budget is used up stay queued for the next game cycle
+    const Uint32 inputStartTime = SDL_GetTicks();
+
     SDL_Event event;
-    while(SDL_PollEvent(&event)) {
+    while((SDL_GetTicks() - inputStartTime < GAME_INPUT_TIME_BUDGET) && pollCoalescedEvent(event, !chatMode && (pInGameMenu == nullptr))) {
+        bRedrawRequested = true;
+
         // check for a key press
 
+        if(event.type == SDL_RENDER_TARGETS_RESET) {
+            pGFXManager->restoreGPUScaledObjPics();
+            pInterface->resetObjectInterface();
+        }
+
         // first of all update mouse
         if(event.type == SDL_MOUSEMOTION) {
             SDL_MouseMotionEvent* mouse = &event.motion;
             drawnMouseX = std::max(0, std::min(mouse->x, settings.video.width-1));
             drawnMouseY = std::max(0, std::min(mouse->y, settings.video.height-1));
+
+            // the viewport under the mouse gets all the input (but not in the middle of dragging a selection rectangle)
+            if((pSplitScreenborder != nullptr) && !selectionMode) {
+                const SDL_Rect& otherGameBoard = pSplitScreenborder->getGameBoard();
+                if((mouse->x >= otherGameBoard.x) && (mouse->x < otherGameBoard.x + otherGameBoard.w)
+                    && (mouse->y >= otherGameBoard.y) && (mouse->y < otherGameBoard.y + otherGameBoard.h)) {
+                    ScreenBorder* pOtherScreenborder = pSplitScreenborder.release();
+                    pSplitScreenborder.reset(screenborder);
+                    screenborder = pOtherScreenborder;
+                }
+            }
         }
 
         if(pInGameMenu != nullptr) {
@@ -610,6 +1239,20 @@ void Game::doInput()
                 case SDL_MOUSEBUTTONDOWN: {
                     SDL_MouseButtonEvent* mouse = &event.button;
 
+                    if(bStrategicZoom && (mouse->x < sideBarPos.x) && (mouse->y >= topBarPos.h)) {
+                        // a left click in the strategic view centers the normal view there, a right click just leaves it
+                        if(mouse->button == SDL_BUTTON_LEFT) {
+                            const Coord tile = strategicMapView.screen2MapTile(mouse->x, mouse->y);
+                            if(tile.isValid()) {
+                                screenborder->setNewScreenCenter(tile*TILESIZE + Coord(TILESIZE/2, TILESIZE/2));
+                            }
+                        }
+                        if((mouse->button == SDL_BUTTON_LEFT) || (mouse->button == SDL_BUTTON_RIGHT)) {
+                            bStrategicZoom = false;
+                        }
+                        break;
+                    }
+
                     switch(mouse->button) {
                         case SDL_BUTTON_LEFT: {
                             pInterface->handleMouseLeft(mouse->x, mouse->y, true);
@@ -1006,6 +1649,8 @@ void Game::setupView()
 void Game::runMainLoop() {
     SDL_Log("Starting game...");
 
+    soundPlayer->clearQueuedSounds();
+
     // add interface
     if(pInterface == nullptr) {
         pInterface = std::make_unique<GameInterface>();
@@ -1020,6 +1665,11 @@ void Game::runMainLoop() {
 
     gameState = GameState::Running;
 
+    // load all sounds and the voices of the local house now instead of when they are first played
+    if(!bHeadless) {
+        pSFXManager->prewarm(pLocalHouse->getHouseID());
+    }
+
     //setup endlevel conditions
     finishedLevel = false;
 
@@ -1036,6 +1686,9 @@ void Game::runMainLoop() {
 
     if(bReplay) {
         cmdManager.setReadOnly(true);
+
+        // the state at the start of the replay (or the keyframe it was continued from) is always a keyframe
+        recordReplayKeyframe();
     } else {
         char tmp[FILENAME_MAX];
         fnkdat("replay/auto.rpl", tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
@@ -1054,6 +1707,9 @@ void Game::runMainLoop() {
             // flush stream
             pStream->flush();
 
+            // the commands are recorded during the whole game => never let the game thread wait for the disk
+            pStream->setAsyncFlush(true);
+
             // now all new commands might be added
             cmdManager.setStream(std::move(pStream));
         }
@@ -1065,84 +1721,239 @@ void Game::runMainLoop() {
         }
     }
 
+    if(!bReplay && !bHeadless && (settings.general.autosaveInterval > 0)) {
+        char tmp[FILENAME_MAX];
+        fnkdat((pNetworkManager != nullptr) ? "mpsave/" : "save/", tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+        pAutoSaveRing = std::make_unique<AutoSaveRing>(tmp, settings.general.autosaveSlots);
+        autosaveInterval = MILLI2CYCLES(settings.general.autosaveInterval * 60 * 1000);
+    }
+
+    if(!bReplay && (pNetworkManager != nullptr) && (settings.network.broadcastPort != 0)) {
+        startBroadcast();
+    }
+
+    if(settings.network.metricsPort != 0) {
+        try {
+            pMetricsServer = std::make_unique<MetricsServer>(settings.network.metricsPort);
+        } catch (std::exception& e) {
+            SDL_Log("Warning: Cannot serve the metrics of this game: %s", e.what());
+        }
+    }
+
     if(pNetworkManager != nullptr) {
         pNetworkManager->setOnReceiveChatMessage(std::bind(&ChatManager::addChatMessage, &(pInterface->getChatManager()), std::placeholders::_1, std::placeholders::_2));
         pNetworkManager->setOnReceiveCommandList(std::bind(&CommandManager::addCommandList, &cmdManager, std::placeholders::_1, std::placeholders::_2));
         pNetworkManager->setOnReceiveSelectionList(std::bind(&Game::onReceiveSelectionList, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
         pNetworkManager->setOnPeerDisconnected(std::bind(&Game::onPeerDisconnected, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 
-        cmdManager.setNetworkCycleBuffer( MILLI2CYCLES(pNetworkManager->getMaxPeerRoundTripTime()) + 5 );
+        if(pNetworkManager->isRejoining()) {
+            // the snapshot is older than the game state of the other players
+            cmdManager.waitForCatchUpCommands();
+            pNetworkManager->setOnReceiveCatchUpCommands(std::bind(&Game::onReceiveCatchUpCommands, this, std::placeholders::_1));
+            pNetworkManager->sendSnapshotLoaded();
+        } else if(pNetworkManager->isGameHost() && !bReplay) {
+            pNetworkManager->setGetSnapshotForRejoiningPlayerCallback(std::bind(&Game::getSnapshotForRejoiningPlayer, this, std::placeholders::_1));
+            pNetworkManager->setGetCatchUpCommandsCallback(std::bind(&Game::getCatchUpCommandsForRejoiningPlayer, this, std::placeholders::_1));
+        }
+
+        // start with the locally measured latency until the first requests of all players are executed
+        cmdManager.setNetworkCycleBuffer(cmdManager.getMeasuredNetworkCycleBuffer());
     }
 
     // Change music to ingame music
     musicPlayer->changeMusic(MUSIC_PEACE);
 
+    // generate the sprites of all houses in this game in the background of the first frames
+    std::vector<int> prefetchHouses;
+    for(const GameInitSettings::HouseInfo& houseInfo : gameInitSettings.getHouseInfoList()) {
+        prefetchHouses.push_back(houseInfo.houseID);
+    }
+    for(int h = 0; h < NUM_HOUSES; h++) {
+        if(getHouse(h) != nullptr) {
+            prefetchHouses.push_back(h);
+        }
+    }
+    if(!bHeadless) {
+        pGFXManager->prefetchObjPics(prefetchHouses, currentZoomlevel);
+    }
+
 
     int     frameStart = SDL_GetTicks();
     int     frameTime = 0;
     int     numFrames = 0;
 
+    FramePacer framePacer;
+    Uint32  lastDrawTime = 0;
+
+    const bool bOfflineRendering = (pVideoEncoderPipe != nullptr);
+    int     finishedVideoFrame = -1;
+
+    Uint32  lastCatchUpCycles = 0;
+
     //SDL_Log("Random Seed (GameCycle %d): 0x%0X", GameCycleCount, RandomGen.getSeed());
 
     //main game loop
     do {
-        SDL_SetRenderTarget(renderer, screenTexture);
+        bool bSkipFrame = false;
 
-        // clear whole screen
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
+        if(bHeadless) {
+            // nothing is drawn, so just simulate a batch of game cycles as fast as possible
+            frameTime = HEADLESS_CYCLES_PER_FRAME * getGameSpeed() + 1;
 
-        drawScreen();
+            if(finished) {
+                finishedLevel = true;
+            }
+        } else {
+            const bool bIdle = isIdle();
 
-        SDL_RenderPresent(renderer);
+            // when the simulation falls behind drop some frames instead of slowing down the game (for all players in multiplayer)
+            bSkipFrame = !bOfflineRendering && !bScreenshotRequested && isFrameSkipNeeded(lastCatchUpCycles);
+            if(bSkipFrame) {
+                numConsecutiveSkippedFrames++;
+            } else {
+                numConsecutiveSkippedFrames = 0;
+            }
+            skippedFramesRatio = 0.99f * skippedFramesRatio + (bSkipFrame ? 0.01f : 0.0f);
+
+            // when idle only redraw after input and now and then for e.g. the blinking cursor; never draw into a minimized window
+            if(!bSkipFrame && (bOfflineRendering || (!isWindowMinimized() && (!bIdle || bRedrawRequested || (SDL_GetTicks() - lastDrawTime >= GAME_IDLE_REDRAW_INTERVAL))))) {
+                bRedrawRequested = false;
+                lastDrawTime = SDL_GetTicks();
+                const Uint64 renderStart = SDL_GetPerformanceCounter();
+
+                // draw directly into the backbuffer (scaled to the window by the logical size) unless the frame has to be read back
+                const bool bUseScreenTexture = bOfflineRendering || isScreenTextureNeeded();
+                SDL_SetRenderTarget(renderer, bUseScreenTexture ? screenTexture : nullptr);
+
+                // clear whole screen
+                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+                SDL_RenderClear(renderer);
+
+                // the simulation runs in fixed steps of getGameSpeed() ms; draw the units in between the last two steps
+                if(bOfflineRendering) {
+                    // frameTime is the game time since the last step
+                    drawInterpolation = std::min(1.0f, static_cast<float>(frameTime) / getGameSpeed());
+                } else {
+                    drawInterpolation = std::min(1.0f, static_cast<float>(SDL_GetTicks() - lastGameCycleTime) / getGameSpeed());
+                }
 
-        SDL_SetRenderTarget(renderer, nullptr);
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, screenTexture, nullptr, nullptr);
-        SDL_RenderPresent(renderer);
+                {
+                    PROFILE_PHASE(profiler, ProfilerPhase_Frame);
+                    drawScreen();
+                }
+                PROFILE_END_FRAME(profiler);
 
-        const int frameEnd = SDL_GetTicks();
+                TRACE_FRAME_MARK();
 
-        if(frameEnd == frameStart) {
-            SDL_Delay(1);
-        }
+                if(bUseScreenTexture) {
+                    if(bScreenshotRequested) {
+                        bScreenshotRequested = false;
+                        takeScreenshot();
+                    }
 
-        frameTime += frameEnd - frameStart; // find difference to get frametime
-        frameStart = SDL_GetTicks();
+                    if(bOfflineRendering) {
+                        // only the readback is done here, the encoder is fed in the background
+                        pVideoEncoderPipe->writeFrame(renderReadSurface(renderer));
+                    } else {
+                        SDL_SetRenderTarget(renderer, nullptr);
+                        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+                        SDL_RenderClear(renderer);
+                        SDL_RenderCopy(renderer, screenTexture, nullptr, nullptr);
+                    }
+                }
+
+                if(!bOfflineRendering) {
+                    SDL_RenderPresent(renderer);
+                }
+
+                const float renderTime = (SDL_GetPerformanceCounter() - renderStart) * 1000.0f / SDL_GetPerformanceFrequency();
+                averageRenderTime = 0.9f * averageRenderTime + 0.1f * renderTime;
+            }
+
+            if(bOfflineRendering) {
+                soundPlayer->clearQueuedSounds();
+            } else {
+                soundPlayer->playQueuedSounds();
+            }
+
+            pGFXManager->processPrefetchQueue(GFX_PREFETCH_TIME_PER_FRAME);
+
+            if(bOfflineRendering) {
+                // every frame advances the game by the same game time, however long simulating and drawing took
+                frameTime += static_cast<int>(((Uint64) numFrames + 1) * 1000 / videoFramesPerSecond - (Uint64) numFrames * 1000 / videoFramesPerSecond);
+                numFrames++;
 
-        numFrames++;
+                if(finished) {
+                    // end timer for the ending message in video time
+                    if(finishedVideoFrame < 0) {
+                        finishedVideoFrame = numFrames;
+                    }
+                    if((numFrames - finishedVideoFrame) * 1000 / videoFramesPerSecond > END_WAIT_TIME) {
+                        finishedLevel = true;
+                    }
+                }
+            } else {
+                const int frameEnd = SDL_GetTicks();
+
+                if(frameEnd == frameStart) {
+                    SDL_Delay(1);
+                }
+
+                frameTime += frameEnd - frameStart; // find difference to get frametime
+                frameStart = SDL_GetTicks();
+
+                numFrames++;
+
+                if (bShowFPS) {
+                    averageFrameTime = 0.99f * averageFrameTime + 0.01f * frameTime;
+                }
+
+                if(bIdle) {
+                    // the simulation does not advance, so sleep until the next input or the next idle frame
+                    framePacer.setFrameTime(GAME_IDLE_FRAMETIME);
+                    if(framePacer.waitForNextFrameOrEvent()) {
+                        // let the game cycle loop below process the input right away
+                        frameTime = std::max(frameTime, getGameSpeed() + 1);
+                    }
+                } else if(!bSkipFrame && ((settings.video.frameLimit == true) || isWindowMinimized())) {
+                    framePacer.setFrameTime(FRAMEPACER_DEFAULT_FRAMETIME);
+                    framePacer.waitForNextFrame();
+                }
 
-        if (bShowFPS) {
-            averageFrameTime = 0.99f * averageFrameTime + 0.01f * frameTime;
-        }
+                if(finished) {
+                    // end timer for the ending message
+                    if(SDL_GetTicks() - finishedLevelTime > END_WAIT_TIME) {
+                        finishedLevel = true;
+                    }
+                }
 
-        if(settings.video.frameLimit == true) {
-            if(frameTime < 32) {
-                SDL_Delay(32 - frameTime);
+                if(takePeriodicalScreenshots && ((gameCycleCount % (MILLI2CYCLES(10*1000))) == 0)) {
+                    bScreenshotRequested = true;
+                    bRedrawRequested = true;
+                }
             }
         }
 
-        if(finished) {
-            // end timer for the ending message
-            if(SDL_GetTicks() - finishedLevelTime > END_WAIT_TIME) {
-                finishedLevel = true;
-            }
+        if(pMetricsServer != nullptr) {
+            pMetricsServer->update(std::bind(&Game::getMetrics, this));
         }
 
-        if(takePeriodicalScreenshots && ((gameCycleCount % (MILLI2CYCLES(10*1000))) == 0)) {
-            takeScreenshot();
-        }
 
+        const Uint32 catchUpStartCycle = gameCycleCount;
 
         while( (frameTime > getGameSpeed()) || (!finished && (gameCycleCount < skipToGameCycle)) )  {
 
             bool bWaitForNetwork = false;
 
             if(pNetworkManager != nullptr) {
+                PROFILE_PHASE(profiler, ProfilerPhase_Network);
                 pNetworkManager->update();
 
                 // test if we need to wait for data to arrive
+                if(cmdManager.isWaitingForCatchUpCommands()) {
+                    bWaitForNetwork = true;
+                }
+
                 for(const std::string& playername : pNetworkManager->getConnectedPeers()) {
                     HumanPlayer* pPlayer = dynamic_cast<HumanPlayer*>(getPlayerByName(playername));
                     if(pPlayer != nullptr) {
@@ -1168,17 +1979,57 @@ void Game::runMainLoop() {
                         }
                     }
 
-                    SDL_Delay(10);
+                    const Uint32 waitStart = SDL_GetTicks();
+                    pNetworkManager->waitForReceivedEvents(10);
+                    networkWaitTime += SDL_GetTicks() - waitStart;
                 } else {
                     startWaitingForOtherPlayersTime = 0;
                     pWaitingForOtherPlayers.reset();
                 }
             }
 
-            doInput();
-            pInterface->updateObjectInterface();
+            if(pBroadcastServer != nullptr) {
+                PROFILE_PHASE(profiler, ProfilerPhase_Network);
+                pBroadcastServer->update(gameCycleCount);
+            }
+
+            if(pBroadcastClient != nullptr) {
+                PROFILE_PHASE(profiler, ProfilerPhase_Network);
+                pBroadcastClient->update();
+
+                // spectators only wait for the broadcast, never the players for the spectators
+                skipToGameCycle = std::min(skipToGameCycle, pBroadcastClient->getAvailableCycle());
+                if(gameCycleCount >= pBroadcastClient->getAvailableCycle()) {
+                    bWaitForNetwork = true;
+                }
+            }
+
+            if(pSaveGameWriter != nullptr) {
+                for(const std::string& failedFilename : pSaveGameWriter->getFailedFiles()) {
+                    addToNewsTicker(std::string("Game NOT saved: Cannot write \"") + failedFilename + "\".");
+                }
+            }
+
+            if(pScreenshotWriter != nullptr) {
+                for(const std::string& screenshotFilename : pScreenshotWriter->getWrittenFiles()) {
+                    addToNewsTicker(_("Screenshot saved") + ": '" + screenshotFilename + "'");
+                }
+                for(const std::string& screenshotFilename : pScreenshotWriter->getFailedFiles()) {
+                    addToNewsTicker(std::string("Screenshot NOT saved: Cannot write \"") + screenshotFilename + "\".");
+                }
+            }
+
+            if(!bHeadless) {
+                doInput();
+
+                // nobody sees the object interface of skipped frames, so refresh it only once per catch up
+                if(!bSkipFrame || (gameCycleCount == catchUpStartCycle)) {
+                    pInterface->updateObjectInterface();
+                }
+            }
 
             if(pNetworkManager != nullptr) {
+                PROFILE_PHASE(profiler, ProfilerPhase_Network);
                 if(bSelectionChanged) {
                     pNetworkManager->sendSelectedList(selectedList);
 
@@ -1194,42 +2045,111 @@ void Game::runMainLoop() {
                 pWaitingForOtherPlayers->update();
             }
 
-            cmdManager.update();
+            {
+                PROFILE_PHASE(profiler, ProfilerPhase_Commands);
+                cmdManager.update();
+            }
+
+            if(!bWaitForNetwork && !bPause && !isSimulationSuspended()) {
+                const Uint64 cycleStart = SDL_GetPerformanceCounter();
+                {
+                    PROFILE_PHASE(profiler, ProfilerPhase_Cycle);
 
-            if(!bWaitForNetwork && !bPause) {
-                pInterface->getRadarView().update();
-                cmdManager.executeCommands(gameCycleCount);
+                    if(!bHeadless) {
+                        pInterface->getRadarView().update();
+                    }
+
+                    {
+                        PROFILE_PHASE(profiler, ProfilerPhase_Commands);
+                        cmdManager.executeCommands(gameCycleCount);
+                    }
 
 //              SDL_Log("cycle %d : %d", gameCycleCount, currentGame->randomGen.getSeed());
 
+                    if((pNetworkManager != nullptr) && (bReplay == false) && (gameCycleCount % NETWORKCYCLEBUFFER_UPDATE_INTERVAL == 0)) {
+                        // adapt how far commands are given in advance to the current network conditions
+                        cmdManager.requestNetworkCycleBuffer();
+                    }
+
+                    if((pNetworkManager != nullptr || bReplay) && (gameCycleCount % STATEHASH_INTERVAL == 0)) {
+                        // remember the own state hashes until the ones of the other peers arrive
+                        StateHashes stateHashes = StateHashes::compute();
+                        stateHashHistory[gameCycleCount] = stateHashes;
+                        stateHashHistory.erase(stateHashHistory.begin(), stateHashHistory.lower_bound(gameCycleCount - std::min(gameCycleCount, (Uint32) STATEHASH_HISTORY_LENGTH)));
+
+                        // CMD_TEST_STATEHASH came with the protocol version that allows rejoining
+                        if((bReplay == false) && (pNetworkManager->getMinPeerProtocolVersion() >= NETWORKPROTOCOL_VERSION_REJOIN)) {
+                            cmdManager.addCommand(Command(pLocalPlayer->getPlayerID(), CMD_TEST_STATEHASH, stateHashes.toParameters(gameCycleCount)));
+                        }
+                    }
+
 #ifdef TEST_SYNC
-                // add every gamecycles one test sync command
-                if(bReplay == false) {
-                    cmdManager.addCommand(Command(pLocalPlayer->getPlayerID(), CMD_TEST_SYNC, randomGen.getSeed()));
-                }
+                    // add every gamecycles one test sync command
+                    if(bReplay == false) {
+                        cmdManager.addCommand(Command(pLocalPlayer->getPlayerID(), CMD_TEST_SYNC, randomGen.getSeed()));
+                    }
 #endif
 
-                for (int i = 0; i < NUM_HOUSES; i++) {
-                    if (house[i] != nullptr) {
-                        house[i]->update();
+                    {
+                        PROFILE_PHASE(profiler, ProfilerPhase_Houses);
+                        planPlayers();
+                        for (int i = 0; i < NUM_HOUSES; i++) {
+                            if (house[i] != nullptr) {
+                                SIMULATION_STATS_HOUSE(i);
+                                house[i]->update();
+                            }
+                        }
+                    }
+
+                    screenborder->update();
+                    if(pSplitScreenborder != nullptr) {
+                        pSplitScreenborder->update();
+                    }
+
+                    triggerManager.trigger(gameCycleCount);
+
+                    processObjects();
+
+                    if ((indicatorFrame != NONE_ID) && (--indicatorTimer <= 0)) {
+                        indicatorTimer = indicatorTime;
+
+                        if (++indicatorFrame > 2) {
+                            indicatorFrame = NONE_ID;
+                        }
                     }
-                }
 
-                screenborder->update();
+                    if(GameEventBus::isAttached()) {
+                        GameEventBus::endGameCycle(gameCycleCount);
+                    }
 
-                triggerManager.trigger(gameCycleCount);
+                    gameCycleCount++;
+                    lastGameCycleTime = SDL_GetTicks();
 
-                processObjects();
+                    checkRejoinStateHashes();
 
-                if ((indicatorFrame != NONE_ID) && (--indicatorTimer <= 0)) {
-                    indicatorTimer = indicatorTime;
+                    if((stateHashTraceInterval != 0) && (gameCycleCount % stateHashTraceInterval == 0)
+                        && (gameCycleCount >= stateHashTraceFirstCycle) && (gameCycleCount <= stateHashTraceLastCycle)) {
+                        stateHashTrace.emplace_back(gameCycleCount, StateHashes::compute());
+                    }
 
-                    if (++indicatorFrame > 2) {
-                        indicatorFrame = NONE_ID;
+                    if(bReplay) {
+                        recordReplayKeyframe();
+                    } else {
+                        recordAutoSave();
                     }
                 }
+                const float cycleTime = (SDL_GetPerformanceCounter() - cycleStart) * 1000.0f / SDL_GetPerformanceFrequency();
+                averageSimulationTime = 0.99f * averageSimulationTime + 0.01f * cycleTime;
+
+                PROFILE_END_CYCLE(profiler);
+#ifdef PROFILING
+                simulationStats.endCycle();
+#endif
 
-                gameCycleCount++;
+                TRACE_COUNTER("Units", unitList.size());
+                TRACE_COUNTER("Structures", structureList.size());
+                TRACE_COUNTER("Bullets", bulletList.size());
+                TRACE_COUNTER("Explosions", explosionList.size());
             }
 
             if(gameCycleCount <= skipToGameCycle) {
@@ -1237,6 +2157,31 @@ void Game::runMainLoop() {
             } else {
                 frameTime -= getGameSpeed();
             }
+
+            if(bHeadless) {
+                if((headlessMaxGameCycle != 0) && (gameCycleCount >= headlessMaxGameCycle)) {
+                    quitGame();
+                }
+
+                if(finished || bQuitGame) {
+                    break;
+                }
+            } else if(bOfflineRendering) {
+                if((headlessMaxGameCycle != 0) && (gameCycleCount >= headlessMaxGameCycle)) {
+                    quitGame();
+                }
+
+                if(bQuitGame) {
+                    break;
+                }
+            }
+        }
+
+        lastCatchUpCycles = gameCycleCount - catchUpStartCycle;
+
+        if(pNetworkManager != nullptr) {
+            PROFILE_PHASE(profiler, ProfilerPhase_Network);
+            pNetworkManager->flush();
         }
 
         musicPlayer->musicCheck();  //if song has finished, start playing next one
@@ -1246,7 +2191,7 @@ void Game::runMainLoop() {
 
     // Game is finished
 
-    if(bReplay == false && currentGame->won == true) {
+    if(bReplay == false && currentGame->won == true && !bHeadless) {
         // save replay
         char tmp[FILENAME_MAX];
 
@@ -1256,15 +2201,29 @@ void Game::runMainLoop() {
 
         OFileStream replystream;
         replystream.open(replayname);
-        replystream.writeString(getLocalPlayerName());
-        gameInitSettings.save(replystream);
-        cmdManager.save(replystream);
+        saveReplayFile(replystream);
     }
 
+    if(pBroadcastServer != nullptr) {
+        pBroadcastServer->finish(gameCycleCount);
+        cmdManager.setOnAddCommand(std::function<void (Uint32, const Command&)>());
+        pBroadcastServer.reset();
+    }
+
+    pMetricsServer.reset();
+
     if(pNetworkManager != nullptr) {
         pNetworkManager->disconnect();
     }
 
+    const PathCache& pathCache = currentGameMap->getPathCache();
+    SDL_Log("Path cache: %u hits, %u spliced hits, %u misses", pathCache.getNumHits(), pathCache.getNumSplicedHits(), pathCache.getNumMisses());
+
+#ifdef PROFILING
+    SDL_Log("Simulation counters over %u game cycles:", simulationStats.getNumCycles());
+    simulationStats.logTotals();
+#endif
+
     gameState = GameState::Deinitialize;
     SDL_Log("Game finished!");
 }
@@ -1400,22 +2359,22 @@ int Game::whatNext()
 
 
 bool Game::loadSaveGame(const std::string& filename) {
-    IFileStream fs;
+    std::unique_ptr<InputStream> pStream = AutoSaveRing::openSaveGame(filename);
 
-    if(fs.open(filename) == false) {
+    if(pStream == nullptr) {
         return false;
     }
 
-    bool ret = loadSaveGame(fs);
-
-    fs.close();
-
-    return ret;
+    return loadSaveGame(*pStream);
 }
 
 bool Game::loadSaveGame(InputStream& stream) {
+    TRACE_ZONE("Load savegame");
+
     gameState = GameState::Loading;
 
+    const Uint64 startTime = SDL_GetPerformanceCounter();
+
     Uint32 magicNum = stream.readUint32();
     if (magicNum != SAVEMAGIC) {
         SDL_Log("Game::loadSaveGame(): No valid savegame! Expected magic number %.8X, but got %.8X!", SAVEMAGIC, magicNum);
@@ -1520,19 +2479,26 @@ bool Game::loadSaveGame(InputStream& stream) {
     winFlags = stream.readUint32();
     loseFlags = stream.readUint32();
 
+    const Uint64 mapStartTime = SDL_GetPerformanceCounter();
     currentGameMap->load(stream);
 
     //load the structures and units
+    const Uint64 objectsStartTime = SDL_GetPerformanceCounter();
     objectManager.load(stream);
 
+    const Uint64 relinkStartTime = SDL_GetPerformanceCounter();
+    currentGameMap->restoreVisionSources();
+    currentGameMap->restoreSandwormPrey();
+    const Uint64 relinkEndTime = SDL_GetPerformanceCounter();
+
     int numBullets = stream.readUint32();
     for(int i = 0; i < numBullets; i++) {
-        bulletList.push_back(new Bullet(stream));
+        bulletList.create(stream);
     }
 
     int numExplosions = stream.readUint32();
     for(int i = 0; i < numExplosions; i++) {
-        explosionList.push_back(new Explosion(stream));
+        explosionList.create(stream);
     }
 
     if(bMultiplayerLoad) {
@@ -1542,7 +2508,7 @@ bool Game::loadSaveGame(InputStream& stream) {
 
     } else {
         //load selection list
-        selectedList = stream.readUint32Set();
+        selectedList = ObjectIDSet(stream.readUint32Vector());
 
         //load the screenborder info
         screenborder->adjustScreenBorderToMapsize(currentGameMap->getSizeX(), currentGameMap->getSizeY());
@@ -1557,102 +2523,122 @@ bool Game::loadSaveGame(InputStream& stream) {
 
     finished = false;
 
+    const auto toMilliseconds = [](Uint64 ticks) { return static_cast<double>(ticks) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency()); };
+    SDL_Log("Game::loadSaveGame(): Loaded %d units and %d structures in %.1f ms (map %.1f ms, objects %.1f ms, relinking %.1f ms)",
+            unitList.size(), structureList.size(), toMilliseconds(SDL_GetPerformanceCounter() - startTime),
+            toMilliseconds(objectsStartTime - mapStartTime), toMilliseconds(relinkStartTime - objectsStartTime), toMilliseconds(relinkEndTime - relinkStartTime));
+
     return true;
 }
 
 
 bool Game::saveGame(const std::string& filename)
 {
-    OFileStream fs;
+    auto pMemStream = std::make_unique<OMemoryStream>();
+    pMemStream->open();
 
-    if(fs.open(filename) == false) {
-        SDL_Log("Game::saveGame(): %s", strerror(errno));
-        currentGame->addToNewsTicker(std::string("Game NOT saved: Cannot open \"") + filename + "\".");
-        return false;
+    saveGame(*pMemStream);
+
+    if(pSaveGameWriter == nullptr) {
+        pSaveGameWriter = std::make_unique<BackgroundFileWriter>();
+    }
+    pSaveGameWriter->writeFile(filename, std::move(pMemStream));
+
+    return true;
+}
+
+void Game::waitForSaveGames() {
+    if(pSaveGameWriter != nullptr) {
+        pSaveGameWriter->waitUntilIdle();
     }
+}
 
-    fs.writeUint32(SAVEMAGIC);
+void Game::saveReplay(OutputStream& stream) const {
+    stream.writeString(getLocalPlayerName());
+    gameInitSettings.save(stream);
+    cmdManager.save(stream);
+}
+
+void Game::saveReplayFile(OutputStream& stream) const {
+    ReplayFile::save(stream, getLocalPlayerName(), gameCycleCount, gameInitSettings, cmdManager);
+}
+
+void Game::saveGame(OutputStream& stream)
+{
+    stream.writeUint32(SAVEMAGIC);
 
-    fs.writeUint32(SAVEGAMEVERSION);
+    stream.writeUint32(SAVEGAMEVERSION);
 
-    fs.writeString(VERSIONSTRING);
+    stream.writeString(VERSIONSTRING);
 
     // write gameInitSettings
-    gameInitSettings.save(fs);
+    gameInitSettings.save(stream);
 
-    fs.writeUint32(houseInfoListSetup.size());
+    stream.writeUint32(houseInfoListSetup.size());
     for(const GameInitSettings::HouseInfo& houseInfo : houseInfoListSetup) {
-        houseInfo.save(fs);
+        houseInfo.save(stream);
     }
 
     //write the map size
-    fs.writeUint32(currentGameMap->getSizeX());
-    fs.writeUint32(currentGameMap->getSizeY());
+    stream.writeUint32(currentGameMap->getSizeX());
+    stream.writeUint32(currentGameMap->getSizeY());
 
     // write GameCycleCount
-    fs.writeUint32(gameCycleCount);
+    stream.writeUint32(gameCycleCount);
 
     // write some settings
-    fs.writeSint8(static_cast<Sint8>(gameType));
-    fs.writeUint8(techLevel);
-    fs.writeUint32(randomGen.getSeed());
+    stream.writeSint8(static_cast<Sint8>(gameType));
+    stream.writeUint8(techLevel);
+    stream.writeUint32(randomGen.getSeed());
 
     // write out the unit/structure data
-    objectData.save(fs);
+    objectData.save(stream);
 
     //write the house(s) info
     for(int i=0; i<NUM_HOUSES; i++) {
-        fs.writeBool(house[i] != nullptr);
+        stream.writeBool(house[i] != nullptr);
 
         if(house[i] != nullptr) {
-            house[i]->save(fs);
+            house[i]->save(stream);
         }
     }
 
     if(gameInitSettings.getGameType() != GameType::CustomMultiplayer) {
-        fs.writeUint8(pLocalPlayer->getPlayerID());
+        stream.writeUint8(pLocalPlayer->getPlayerID());
     }
 
-    fs.writeBool(debug);
-    fs.writeBool(bCheatsEnabled);
+    stream.writeBool(debug);
+    stream.writeBool(bCheatsEnabled);
 
-    fs.writeUint32(winFlags);
-    fs.writeUint32(loseFlags);
+    stream.writeUint32(winFlags);
+    stream.writeUint32(loseFlags);
 
-    currentGameMap->save(fs);
+    currentGameMap->save(stream);
 
     // save the structures and units
-    objectManager.save(fs);
+    objectManager.save(stream);
 
-    fs.writeUint32(bulletList.size());
-    for(const Bullet* pBullet : bulletList) {
-        pBullet->save(fs);
-    }
+    stream.writeUint32(bulletList.size());
+    bulletList.forEach([&stream](const Bullet* pBullet) { pBullet->save(stream); });
 
-    fs.writeUint32(explosionList.size());
-    for(const Explosion* pExplosion : explosionList) {
-        pExplosion->save(fs);
-    }
+    stream.writeUint32(explosionList.size());
+    explosionList.forEach([&stream](const Explosion* pExplosion) { pExplosion->save(stream); });
 
     if(gameInitSettings.getGameType() != GameType::CustomMultiplayer) {
         // save selection lists
 
         // write out selected units list
-        fs.writeUint32Set(selectedList);
+        stream.writeUint32Vector(selectedList.getIDs());
 
         // write the screenborder info
-        screenborder->save(fs);
+        screenborder->save(stream);
     }
 
     // save triggers
-    triggerManager.save(fs);
+    triggerManager.save(stream);
 
     // CommandManager is at the very end of the file. DO NOT CHANGE THIS!
-    cmdManager.save(fs);
-
-    fs.close();
-
-    return true;
+    cmdManager.save(stream);
 }
 
 
@@ -1681,7 +2667,7 @@ ObjectBase* Game::loadObject(InputStream& stream, Uint32 objectID)
 }
 
 
-void Game::selectAll(const std::set<Uint32>& aList)
+void Game::selectAll(const ObjectIDSet& aList)
 {
     for(Uint32 objectID : aList) {
         objectManager.getObject(objectID)->setSelected(true);
@@ -1689,14 +2675,14 @@ void Game::selectAll(const std::set<Uint32>& aList)
 }
 
 
-void Game::unselectAll(const std::set<Uint32>& aList)
+void Game::unselectAll(const ObjectIDSet& aList)
 {
     for(Uint32 objectID : aList) {
         objectManager.getObject(objectID)->setSelected(false);
     }
 }
 
-void Game::onReceiveSelectionList(const std::string& name, const std::set<Uint32>& newSelectionList, int groupListIndex)
+void Game::onReceiveSelectionList(const std::string& name, const ObjectIDSet& newSelectionList, int groupListIndex)
 {
     HumanPlayer* pHumanPlayer = dynamic_cast<HumanPlayer*>(getPlayerByName(name));
 
@@ -1736,6 +2722,59 @@ void Game::onPeerDisconnected(const std::string& name, bool bHost, int cause) {
     pInterface->getChatManager().addInfoMessage(name + " disconnected!");
 }
 
+std::string Game::getSnapshotForRejoiningPlayer(const std::string& name) {
+    HumanPlayer* pPlayer = dynamic_cast<HumanPlayer*>(getPlayerByName(name));
+    if((pPlayer == nullptr) || (pPlayer == pLocalPlayer) || finished) {
+        return "";
+    }
+
+    const std::list<std::string> connectedPeers = pNetworkManager->getConnectedPeers();
+    if(std::find(connectedPeers.begin(), connectedPeers.end(), name) != connectedPeers.end()) {
+        return "";
+    }
+
+    OMemoryStream memStream;
+    memStream.open();
+    saveGame(memStream);
+
+    rejoinSnapshotCycles[name] = gameCycleCount;
+
+    SDL_Log("Game cycle %d: Sending a snapshot of %d bytes to rejoining player '%s'", gameCycleCount, (int) memStream.getDataLength(), name.c_str());
+
+    return std::string(memStream.getData(), memStream.getDataLength());
+}
+
+CatchUpData Game::getCatchUpCommandsForRejoiningPlayer(const std::string& name) {
+    Uint32 snapshotCycle = gameCycleCount;
+
+    auto iter = rejoinSnapshotCycles.find(name);
+    if(iter != rejoinSnapshotCycles.end()) {
+        snapshotCycle = iter->second;
+        rejoinSnapshotCycles.erase(iter);
+    }
+
+    pInterface->getChatManager().addInfoMessage(name + " rejoined the game!");
+
+    CatchUpData catchUpData;
+    catchUpData.gameCycle = gameCycleCount;
+    catchUpData.commandList = cmdManager.getCommandList(snapshotCycle, gameCycleCount);
+    catchUpData.stateHashes = StateHashes::compute();
+    return catchUpData;
+}
+
+void Game::onReceiveCatchUpCommands(const CatchUpData& catchUpData) {
+    SDL_Log("Game cycle %d: Catching up to game cycle %d", gameCycleCount, catchUpData.gameCycle);
+
+    cmdManager.addCatchUpCommands(catchUpData.gameCycle, catchUpData.commandList);
+
+    // simulate the missed game cycles without drawing
+    skipToGameCycle = std::max(skipToGameCycle, catchUpData.gameCycle);
+
+    rejoinCheckCycle = catchUpData.gameCycle;
+    rejoinCheckStateHashes = catchUpData.stateHashes;
+    checkRejoinStateHashes();
+}
+
 void Game::setGameWon() {
     if(!bQuitGame && !finished) {
         won = true;
@@ -1809,6 +2848,48 @@ bool Game::isOnRadarView(int mouseX, int mouseY) const {
 }
 
 
+void Game::toggleSplitView() {
+    const SDL_Rect gameBoardRect = { 0, topBarPos.h, sideBarPos.x, getRendererHeight() - topBarPos.h };
+    const Coord center = screenborder->getCurrentCenter();
+
+    delete screenborder;
+
+    if(pSplitScreenborder == nullptr) {
+        // one pixel between the two halves for the separating line
+        const int leftWidth = gameBoardRect.w / 2;
+        const SDL_Rect leftGameBoardRect = { gameBoardRect.x, gameBoardRect.y, leftWidth, gameBoardRect.h };
+        const SDL_Rect rightGameBoardRect = { gameBoardRect.x + leftWidth + 1, gameBoardRect.y, gameBoardRect.w - leftWidth - 1, gameBoardRect.h };
+
+        screenborder = new ScreenBorder(leftGameBoardRect);
+        pSplitScreenborder = std::make_unique<ScreenBorder>(rightGameBoardRect);
+        pSplitScreenborder->adjustScreenBorderToMapsize(currentGameMap->getSizeX(), currentGameMap->getSizeY());
+        pSplitScreenborder->setNewScreenCenter(center);
+    } else {
+        screenborder = new ScreenBorder(gameBoardRect);
+        pSplitScreenborder.reset();
+    }
+
+    screenborder->adjustScreenBorderToMapsize(currentGameMap->getSizeX(), currentGameMap->getSizeY());
+    screenborder->setNewScreenCenter(center);
+}
+
+
+void Game::setZoomlevel(int newZoomlevel) {
+    const Coord oldCenterCoord = screenborder->getCurrentCenter();
+    const Coord oldSplitCenterCoord = (pSplitScreenborder != nullptr) ? pSplitScreenborder->getCurrentCenter() : Coord::Invalid();
+
+    currentZoomlevel = newZoomlevel;
+
+    screenborder->adjustScreenBorderToMapsize(currentGameMap->getSizeX(), currentGameMap->getSizeY());
+    screenborder->setNewScreenCenter(oldCenterCoord);
+
+    if(pSplitScreenborder != nullptr) {
+        pSplitScreenborder->adjustScreenBorderToMapsize(currentGameMap->getSizeX(), currentGameMap->getSizeY());
+        pSplitScreenborder->setNewScreenCenter(oldSplitCenterCoord);
+    }
+}
+
+
 void Game::handleChatInput(SDL_KeyboardEvent& keyboardEvent) {
     if(keyboardEvent.keysym.sym == SDLK_ESCAPE) {
         chatMode = false;
@@ -1916,7 +2997,7 @@ void Game::handleKeyInput(SDL_KeyboardEvent& keyboardEvent) {
 
                 pInterface->updateObjectInterface();
             } else {
-                std::set<Uint32>& groupList = pLocalPlayer->getGroupList(selectListIndex);
+                ObjectIDSet& groupList = pLocalPlayer->getGroupList(selectListIndex);
 
                 // find out if we are choosing a group with all items already selected
                 bool bEverythingWasSelected = (selectedList.size() == groupList.size());
@@ -2023,47 +3104,68 @@ void Game::handleKeyInput(SDL_KeyboardEvent& keyboardEvent) {
         } break;
 
         case SDLK_F1: {
-            Coord oldCenterCoord = screenborder->getCurrentCenter();
-            currentZoomlevel = 0;
-            screenborder->adjustScreenBorderToMapsize(currentGameMap->getSizeX(), currentGameMap->getSizeY());
-            screenborder->setNewScreenCenter(oldCenterCoord);
+            setZoomlevel(0);
         } break;
 
         case SDLK_F2: {
-            Coord oldCenterCoord = screenborder->getCurrentCenter();
-            currentZoomlevel = 1;
-            screenborder->adjustScreenBorderToMapsize(currentGameMap->getSizeX(), currentGameMap->getSizeY());
-            screenborder->setNewScreenCenter(oldCenterCoord);
+            setZoomlevel(1);
         } break;
 
         case SDLK_F3: {
-            Coord oldCenterCoord = screenborder->getCurrentCenter();
-            currentZoomlevel = 2;
-            screenborder->adjustScreenBorderToMapsize(currentGameMap->getSizeX(), currentGameMap->getSizeY());
-            screenborder->setNewScreenCenter(oldCenterCoord);
+            setZoomlevel(2);
         } break;
 
         case SDLK_F4: {
-            // skip a 30 seconds
-            if(gameType != GameType::CustomMultiplayer || bReplay) {
+            // skip 10 seconds (in replays shift goes back instead)
+            if(bReplay) {
+                const Uint32 seekCycles = (10*1000)/GAMESPEED_DEFAULT;
+                if(SDL_GetModState() & KMOD_SHIFT) {
+                    seekReplay((gameCycleCount > seekCycles) ? (gameCycleCount - seekCycles) : 0);
+                } else {
+                    seekReplay(gameCycleCount + seekCycles);
+                }
+            } else if(gameType != GameType::CustomMultiplayer) {
                 skipToGameCycle = gameCycleCount + (10*1000)/GAMESPEED_DEFAULT;
             }
         } break;
 
         case SDLK_F5: {
-            // skip a 30 seconds
-            if(gameType != GameType::CustomMultiplayer || bReplay) {
+            // skip 30 seconds (in replays shift goes back instead)
+            if(bReplay) {
+                const Uint32 seekCycles = (30*1000)/GAMESPEED_DEFAULT;
+                if(SDL_GetModState() & KMOD_SHIFT) {
+                    seekReplay((gameCycleCount > seekCycles) ? (gameCycleCount - seekCycles) : 0);
+                } else {
+                    seekReplay(gameCycleCount + seekCycles);
+                }
+            } else if(gameType != GameType::CustomMultiplayer) {
                 skipToGameCycle = gameCycleCount + (30*1000)/GAMESPEED_DEFAULT;
             }
         } break;
 
         case SDLK_F6: {
-            // skip 2 minutes
-            if(gameType != GameType::CustomMultiplayer || bReplay) {
+            // skip 2 minutes (in replays shift goes back instead)
+            if(bReplay) {
+                const Uint32 seekCycles = (120*1000)/GAMESPEED_DEFAULT;
+                if(SDL_GetModState() & KMOD_SHIFT) {
+                    seekReplay((gameCycleCount > seekCycles) ? (gameCycleCount - seekCycles) : 0);
+                } else {
+                    seekReplay(gameCycleCount + seekCycles);
+                }
+            } else if(gameType != GameType::CustomMultiplayer) {
                 skipToGameCycle = gameCycleCount + (120*1000)/GAMESPEED_DEFAULT;
             }
         } break;
 
+        case SDLK_F7: {
+            // toggle the strategic view of the whole map
+            bStrategicZoom = !bStrategicZoom;
+        } break;
+
+        case SDLK_F8: {
+            toggleSplitView();
+        } break;
+
         case SDLK_F10: {
             soundPlayer->toggleSound();
         } break;
@@ -2073,6 +3175,24 @@ void Game::handleKeyInput(SDL_KeyboardEvent& keyboardEvent) {
         } break;
 
         case SDLK_F12: {
+#ifdef TRACING
+            if(SDL_GetModState() & KMOD_ALT) {
+                toggleTraceRecording();
+                break;
+            }
+#endif
+#ifdef PROFILING
+            if((SDL_GetModState() & KMOD_SHIFT) && (SDL_GetModState() & KMOD_CTRL)) {
+                saveMemoryReport();
+                break;
+            } else if(SDL_GetModState() & KMOD_SHIFT) {
+                bShowProfiler = !bShowProfiler;
+                break;
+            } else if(SDL_GetModState() & KMOD_CTRL) {
+                saveProfile();
+                break;
+            }
+#endif
             bShowFPS = !bShowFPS;
         } break;
 
@@ -2134,7 +3254,7 @@ void Game::handleKeyInput(SDL_KeyboardEvent& keyboardEvent) {
             if(SDL_GetModState() & KMOD_SHIFT) {
                 takePeriodicalScreenshots = !takePeriodicalScreenshots;
             } else {
-                takeScreenshot();
+                bScreenshotRequested = true;
             }
         } break;
 
@@ -2342,15 +3462,18 @@ bool Game::handleSelectedObjectsAttackClick(int xPos, int yPos) {
 
 bool Game::handleSelectedObjectsMoveClick(int xPos, int yPos) {
     UnitBase* pResponder = nullptr;
+    std::vector<Uint32> groupParameters{ (Uint32) xPos, (Uint32) yPos, (Uint32) true };
 
     for(Uint32 objectID : selectedList) {
         ObjectBase* pObject = objectManager.getObject(objectID);
         if (pObject->isAUnit() && (pObject->getOwner() == pLocalHouse) && pObject->isRespondable()) {
             pResponder = static_cast<UnitBase*>(pObject);
-            pResponder->handleMoveClick(xPos,yPos);
+            groupParameters.push_back(objectID);
         }
     }
 
+    addMove2PosCommand(xPos, yPos, groupParameters);
+
     currentCursorMode = CursorMode_Normal;
     if(pResponder) {
         pResponder->playConfirmSound();
@@ -2429,10 +3552,18 @@ bool Game::handleSelectedObjectsCaptureClick(int xPos, int yPos) {
 bool Game::handleSelectedObjectsActionClick(int xPos, int yPos) {
     //let unit handle right click on map or target
     ObjectBase  *pResponder = nullptr;
+    // a click on an empty tile moves all units there, so they are sent together (see UnitBase::handleActionClick())
+    const bool bMoveUnits = currentGameMap->tileExists(xPos, yPos) && !currentGameMap->getTile(xPos, yPos)->hasAnObject();
+    std::vector<Uint32> groupParameters{ (Uint32) xPos, (Uint32) yPos, (Uint32) true };
+
     for(Uint32 objectID : selectedList) {
         ObjectBase* pObject = objectManager.getObject(objectID);
         if(pObject->getOwner() == pLocalHouse && pObject->isRespondable()) {
-            pObject->handleActionClick(xPos, yPos);
+            if(bMoveUnits && pObject->isAUnit()) {
+                groupParameters.push_back(objectID);
+            } else {
+                pObject->handleActionClick(xPos, yPos);
+            }
 
             //if this object obey the command
             if((pResponder == nullptr) && pObject->isRespondable())
@@ -2440,6 +3571,8 @@ bool Game::handleSelectedObjectsActionClick(int xPos, int yPos) {
         }
     }
 
+    addMove2PosCommand(xPos, yPos, groupParameters);
+
     if(pResponder) {
         pResponder->playConfirmSound();
         return true;
@@ -2449,17 +3582,175 @@ bool Game::handleSelectedObjectsActionClick(int xPos, int yPos) {
 }
 
 
+void Game::addMove2PosCommand(int xPos, int yPos, const std::vector<Uint32>& groupParameters) {
+    if(!currentGameMap->tileExists(xPos, yPos)) {
+        return;
+    }
+
+    const size_t numUnits = groupParameters.size() - 3;
+    const bool bGroupCommandKnown = (pNetworkManager == nullptr) || (pNetworkManager->getMinPeerProtocolVersion() >= NETWORKPROTOCOL_VERSION_GROUPCOMMANDS);
+    if((numUnits > 1) && bGroupCommandKnown) {
+        cmdManager.addCommand(Command(pLocalPlayer->getPlayerID(), CMD_UNIT_MOVE2POS_GROUP, groupParameters));
+    } else {
+        // a single unit keeps using the plain command and so do all units if a peer does not know the group command
+        for(size_t i = 3; i < groupParameters.size(); i++) {
+            cmdManager.addCommand(Command(pLocalPlayer->getPlayerID(), CMD_UNIT_MOVE2POS, groupParameters[i], groupParameters[0], groupParameters[1], groupParameters[2]));
+        }
+    }
+}
+
+
 void Game::takeScreenshot() const {
-    std::string screenshotFilename;
+    // only the readback is done here, the screenshot is encoded and written in the background (see the news ticker update in runMainLoop())
+    const std::string screenshotFilename = pScreenshotWriter->getNextFilename("Screenshot");
+    pScreenshotWriter->writeScreenshot(screenshotFilename, renderReadSurface(renderer));
+}
+
+
+bool Game::isScreenTextureNeeded() const {
+    if(bScreenshotRequested) {
+        return true;
+    }
+
+    for(const UnitBase* pUnit : unitListByItemID[Unit_Sandworm]) {
+        if(static_cast<const Sandworm*>(pUnit)->isShimmering()) {
+            return true;
+        }
+    }
+
+    bool bSonicBlast = false;
+    bulletList.forEach([&bSonicBlast](const Bullet* pBullet) { bSonicBlast |= (pBullet->getBulletID() == Bullet_Sonic); });
+    return bSonicBlast;
+}
+
+
+void Game::saveProfile() const {
+    std::string profileFilename;
+    int i = 1;
+    do {
+        profileFilename = "Profile" + std::to_string(i) + ".csv";
+        i++;
+    } while(existsFile(profileFilename) == true);
+
+    if(profiler.saveCSV(profileFilename)) {
+        currentGame->addToNewsTicker("Profile saved: '" + profileFilename + "'");
+    }
+}
+
+
+Game::MemoryUsageList Game::getMemoryUsage() const {
+    MemoryUsageList memoryUsage;
+
+    for(int tag = 0; tag < NUM_MEMORYTAGS; tag++) {
+        memoryUsage[tag] = { AllocationCounter::getTagName((MemoryTag) tag), AllocationCounter::getAllocatedBytes((MemoryTag) tag) };
+    }
+
+    memoryUsage[NUM_MEMORYTAGS] = { "Textures (estimated)", pGFXManager->getTextureMemory() };
+    memoryUsage[NUM_MEMORYTAGS + 1] = { "Surfaces", pGFXManager->getSurfaceMemory() };
+    memoryUsage[NUM_MEMORYTAGS + 2] = { "Sounds", pSFXManager->getSoundMemory() };
+    memoryUsage[NUM_MEMORYTAGS + 3] = { "Map tiles", (Uint64) currentGameMap->getSizeX() * currentGameMap->getSizeY() * sizeof(Tile) };
+
+    return memoryUsage;
+}
+
+
+void Game::saveMemoryReport() const {
+    std::string reportFilename;
+    int i = 1;
+    do {
+        reportFilename = "MemoryReport" + std::to_string(i) + ".txt";
+        i++;
+    } while(existsFile(reportFilename) == true);
+
+    FILE* file = fopen(reportFilename.c_str(), "w");
+    if(file == nullptr) {
+        SDL_Log("Game::saveMemoryReport(): Cannot open '%s'!", reportFilename.c_str());
+        return;
+    }
+
+    fprintf(file, "Game cycle %u\n\n", gameCycleCount);
+    for(const MemoryUsage& memoryUsage : getMemoryUsage()) {
+        fprintf(file, "%-24s %12llu\n", memoryUsage.name, (unsigned long long) memoryUsage.bytes);
+    }
+    fclose(file);
+
+    currentGame->addToNewsTicker("Memory report saved: '" + reportFilename + "'");
+}
+
+
+void Game::toggleTraceRecording() {
+    if(!Tracing::isRecording()) {
+        Tracing::start();
+        addToNewsTicker("Trace recording started");
+        return;
+    }
+
+    std::string traceFilename;
     int i = 1;
     do {
-        screenshotFilename = "Screenshot" + std::to_string(i) + ".png";
+        traceFilename = "Trace" + std::to_string(i) + ".json";
         i++;
-    } while(existsFile(screenshotFilename) == true);
+    } while(existsFile(traceFilename) == true);
+
+    if(Tracing::stopAndSave(traceFilename)) {
+        addToNewsTicker("Trace saved: '" + traceFilename + "'");
+    }
+}
+
+
+void Game::drawProfilerOverlay() const {
+    static const int columnX[] = { 10, 170, 230, 290 };
+
+    const int lineHeight = pFontManager->getTextHeight(12);
+    int y = topBarPos.h + 20;
+
+    const char* headers[] = { "Phase (us)", "min", "avg", "p99" };
+    for(int i = 0; i < 4; i++) {
+        pFontManager->drawText(columnX[i], y, frameArena.copy(headers[i]), COLOR_YELLOW, 12);
+    }
+    y += lineHeight;
+
+    for(int phase = 0; phase < NUM_PROFILERPHASES; phase++) {
+        const Profiler::Statistics statistics = profiler.getStatistics((ProfilerPhase) phase);
+        const Uint32 color = ((phase == ProfilerPhase_Cycle) || (phase == ProfilerPhase_Frame)) ? COLOR_WHITE : COLOR_LIGHTGREY;
+
+        pFontManager->drawText(columnX[0], y, frameArena.copy(Profiler::getPhaseName((ProfilerPhase) phase)), color, 12);
+        pFontManager->drawText(columnX[1], y, frameArena.sprintf("%.0f", statistics.min), color, 12);
+        pFontManager->drawText(columnX[2], y, frameArena.sprintf("%.1f", statistics.avg), color, 12);
+        pFontManager->drawText(columnX[3], y, frameArena.sprintf("%.0f", statistics.p99), color, 12);
+        y += lineHeight;
+    }
+
+    y += lineHeight;
+
+    const char* counterHeaders[] = { "Counter", "last", "avg" };
+    for(int i = 0; i < 3; i++) {
+        pFontManager->drawText(columnX[i], y, frameArena.copy(counterHeaders[i]), COLOR_YELLOW, 12);
+    }
+    y += lineHeight;
+
+    const Uint32 numCycles = std::max(simulationStats.getNumCycles(), (Uint32) 1);
+    for(int counter = 0; counter < NUM_SIMULATIONCOUNTERS; counter++) {
+        pFontManager->drawText(columnX[0], y, frameArena.copy(SimulationStats::getCounterName((SimulationCounter) counter)), COLOR_LIGHTGREY, 12);
+        pFontManager->drawText(columnX[1], y, frameArena.sprintf("%llu", (unsigned long long) simulationStats.getLastCycle((SimulationCounter) counter)), COLOR_LIGHTGREY, 12);
+        pFontManager->drawText(columnX[2], y, frameArena.sprintf("%.1f", (double) simulationStats.getTotal((SimulationCounter) counter) / numCycles), COLOR_LIGHTGREY, 12);
+        y += lineHeight;
+    }
+
+    // heap allocations of the last frame (should be 0 in a steady state)
+    y += lineHeight;
+    pFontManager->drawText(columnX[0], y, frameArena.copy("Allocations per frame"), COLOR_YELLOW, 12);
+    pFontManager->drawText(columnX[1], y, frameArena.sprintf("%u", numFrameAllocations), COLOR_WHITE, 12);
+
+    y += 2*lineHeight;
+    pFontManager->drawText(columnX[0], y, frameArena.copy("Memory (KiB)"), COLOR_YELLOW, 12);
+    y += lineHeight;
 
-    sdl2::surface_ptr pCurrentScreen = renderReadSurface(renderer);
-    SavePNG(pCurrentScreen.get(), screenshotFilename.c_str());
-    currentGame->addToNewsTicker(_("Screenshot saved") + ": '" + screenshotFilename + "'");
+    for(const MemoryUsage& memoryUsage : getMemoryUsage()) {
+        pFontManager->drawText(columnX[0], y, frameArena.copy(memoryUsage.name), COLOR_LIGHTGREY, 12);
+        pFontManager->drawText(columnX[1], y, frameArena.sprintf("%llu", (unsigned long long) (memoryUsage.bytes / 1024)), COLOR_LIGHTGREY, 12);
+        y += lineHeight;
+    }
 }
 
 
@@ -2511,6 +3802,47 @@ void Game::selectNextStructureOfType(const std::set<Uint32>& itemIDs) {
     }
 }
 
+bool Game::isWindowMinimized() {
+    return (SDL_GetWindowFlags(window) & (SDL_WINDOW_MINIMIZED | SDL_WINDOW_HIDDEN)) != 0;
+}
+
+bool Game::isSimulationSuspended() const {
+    if(!settings.general.pauseWhenInactive || bHeadless || (pVideoEncoderPipe != nullptr) || (pNetworkManager != nullptr) || (pBroadcastServer != nullptr) || (pBroadcastClient != nullptr)) {
+        // others depend on this game to keep running
+        return false;
+    }
+
+    if(gameCycleCount < skipToGameCycle) {
+        // fast forwarding has to finish
+        return false;
+    }
+
+    return isWindowMinimized() || ((SDL_GetWindowFlags(window) & SDL_WINDOW_INPUT_FOCUS) == 0);
+}
+
+bool Game::isIdle() const {
+    if((pInGameMentat != nullptr) || finished) {
+        // the mentat is animated and the end message is waiting for END_WAIT_TIME
+        return false;
+    }
+
+    return bPause || isSimulationSuspended();
+}
+
+bool Game::isFrameSkipNeeded(Uint32 lastCatchUpCycles) const {
+    if(numConsecutiveSkippedFrames >= FRAMESKIP_MAX_CONSECUTIVE) {
+        return false;
+    }
+
+    if(lastCatchUpCycles <= FRAMESKIP_BEHIND_CYCLES) {
+        // the simulation is on schedule
+        return false;
+    }
+
+    // skipping only helps if drawing takes a relevant share of the time the simulation has for catching up
+    return averageRenderTime * 2 > getGameSpeed();
+}
+
 int Game::getGameSpeed() const {
     if(gameType == GameType::CustomMultiplayer) {
         return gameInitSettings.getGameOptions().gameSpeed;
@@ -0,0 +1,187 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <GameEventBus.h>
+
+#include <globals.h>
+#include <Game.h>
+#include <House.h>
+#include <data.h>
+
+#include <misc/SPSCQueue.h>
+
+namespace {
+
+const char* const eventNames[] = { "built", "killed", "damaged", "harvested", "credits" };
+
+SPSCQueue<std::vector<GameEvent>, GAMEEVENTBUS_MAXBATCHES + 1> batchQueue;    ///< the batches waiting for the sink thread
+
+std::unique_ptr<GameEventSink> pSink;       ///< the attached sink
+SDL_Thread* pSinkThread = nullptr;          ///< the thread passing the batches to pSink
+SDL_sem* availableBatchesSemaphore = nullptr;   ///< posted once per queued batch and once for quitting
+SDL_atomic_t quitSinkThread;                ///< tells the sink thread to exit
+
+std::vector<GameEvent> currentBatch;        ///< the events not handed to the sink thread yet (only used by the simulating thread)
+Uint32 lastSubmitCycle = 0;                 ///< the game cycle the last batch was handed over in
+Uint64 numDroppedEvents = 0;                ///< events dropped because the queue was full
+
+}
+
+bool GameEventBus::bAttached = false;
+
+GameEventFileSink::GameEventFileSink(const std::string& filename) {
+    fp = fopen(filename.c_str(), "w");
+    if(fp == nullptr) {
+        SDL_Log("GameEventFileSink: Cannot open '%s'!", filename.c_str());
+    } else {
+        fprintf(fp, "gamecycle,event,house,item,value\n");
+    }
+}
+
+GameEventFileSink::~GameEventFileSink() {
+    if(fp != nullptr) {
+        fclose(fp);
+    }
+}
+
+void GameEventFileSink::write(const std::vector<GameEvent>& events) {
+    if(fp == nullptr) {
+        return;
+    }
+
+    for(const GameEvent& event : events) {
+        fprintf(fp, "%u,%s,%d,%d,%d\n", event.gameCycle, eventNames[static_cast<int>(event.type)], event.houseID, event.itemID, event.value);
+    }
+}
+
+void GameEventFileSink::close(Uint64 numDroppedEvents) {
+    if(fp == nullptr) {
+        return;
+    }
+
+    if(numDroppedEvents > 0) {
+        fprintf(fp, "# %llu events dropped\n", (unsigned long long) numDroppedEvents);
+    }
+    fflush(fp);
+}
+
+void GameEventBus::attach(std::unique_ptr<GameEventSink> pNewSink) {
+    detach();
+
+    pSink = std::move(pNewSink);
+    currentBatch.clear();
+    currentBatch.reserve(GAMEEVENTBUS_BATCHSIZE);
+    lastSubmitCycle = 0;
+    numDroppedEvents = 0;
+
+    SDL_AtomicSet(&quitSinkThread, 0);
+    availableBatchesSemaphore = SDL_CreateSemaphore(0);
+    pSinkThread = SDL_CreateThread(sinkThreadMain, "GameEventBus", nullptr);
+    if(pSinkThread == nullptr) {
+        SDL_Log("GameEventBus: Cannot create sink thread: %s", SDL_GetError());
+        SDL_DestroySemaphore(availableBatchesSemaphore);
+        availableBatchesSemaphore = nullptr;
+        pSink.reset();
+        return;
+    }
+
+    bAttached = true;
+}
+
+void GameEventBus::detach() {
+    if(!bAttached) {
+        return;
+    }
+
+    submitBatch();
+    bAttached = false;
+
+    SDL_AtomicSet(&quitSinkThread, 1);
+    SDL_SemPost(availableBatchesSemaphore);
+    SDL_WaitThread(pSinkThread, nullptr);
+    pSinkThread = nullptr;
+
+    SDL_DestroySemaphore(availableBatchesSemaphore);
+    availableBatchesSemaphore = nullptr;
+
+    pSink->close(numDroppedEvents);
+    pSink.reset();
+}
+
+void GameEventBus::add(GameEventType type, int houseID, int itemID, Sint32 value) {
+    const Uint32 gameCycle = (currentGame != nullptr) ? currentGame->getGameCycleCount() : 0;
+    currentBatch.push_back(GameEvent{ gameCycle, type, static_cast<Uint8>(houseID), static_cast<Uint16>(itemID), value });
+
+    if(currentBatch.size() >= GAMEEVENTBUS_BATCHSIZE) {
+        submitBatch();
+    }
+}
+
+void GameEventBus::endGameCycle(Uint32 gameCycle) {
+    if(gameCycle % GAMEEVENTBUS_CREDITSINTERVAL == 0) {
+        for(int i = 0; i < NUM_HOUSES; i++) {
+            const House* pHouse = currentGame->getHouse(i);
+            if(pHouse != nullptr) {
+                add(GameEventType::Credits, i, ItemID_Invalid, pHouse->getCredits());
+            }
+        }
+    }
+
+    if(!currentBatch.empty() && (gameCycle >= lastSubmitCycle + GAMEEVENTBUS_FLUSHINTERVAL)) {
+        submitBatch();
+        lastSubmitCycle = gameCycle;
+    }
+}
+
+/**
+    Hands currentBatch over to the sink thread or drops it if the sink thread cannot keep up.
+*/
+void GameEventBus::submitBatch() {
+    if(currentBatch.empty()) {
+        return;
+    }
+
+    if(batchQueue.isFull()) {
+        numDroppedEvents += currentBatch.size();
+        currentBatch.clear();
+        return;
+    }
+
+    std::vector<GameEvent> batch;
+    batch.reserve(GAMEEVENTBUS_BATCHSIZE);
+    batch.swap(currentBatch);
+    batchQueue.push(std::move(batch));
+    SDL_SemPost(availableBatchesSemaphore);
+}
+
+int GameEventBus::sinkThreadMain(void* data) {
+    std::vector<GameEvent> batch;
+    while(true) {
+        SDL_SemWait(availableBatchesSemaphore);
+
+        while(batchQueue.pop(batch)) {
+            pSink->write(batch);
+        }
+
+        if(SDL_AtomicGet(&quitSinkThread) != 0) {
+            break;
+        }
+    }
+
+    return 0;
+}
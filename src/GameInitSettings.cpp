@@ -17,7 +17,8 @@
 
 #include <GameInitSettings.h>
 
-#include <misc/IFileStream.h>
+#include <AutoSaveRing.h>
+
 #include <misc/IMemoryStream.h>
 #include <misc/string_util.h>
 #include <misc/exceptions.h>
@@ -160,15 +161,13 @@ std::string GameInitSettings::getScenarioFilename(HOUSETYPE newHouse, int missio
 }
 
 void GameInitSettings::checkSaveGame(const std::string& savegame) {
-    IFileStream fs;
+    std::unique_ptr<InputStream> pStream = AutoSaveRing::openSaveGame(savegame);
 
-    if(fs.open(savegame) == false) {
+    if(pStream == nullptr) {
         THROW(std::runtime_error, "Cannot open savegame. Make sure you have read access to this savegame!");
     }
 
-    checkSaveGame(fs);
-
-    fs.close();
+    checkSaveGame(*pStream);
 }
 
 
@@ -0,0 +1,413 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <HierarchicalPathGraph.h>
+
+#include <Map.h>
+#include <mmath.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <queue>
+#include <stdlib.h>
+
+#define HPA_CLUSTERSIZE         16      ///< width and height of one cluster in tiles
+#define HPA_MIN_DISTANCE        (2*HPA_CLUSTERSIZE)     ///< below this distance the normal AStarSearch is used
+#define HPA_MAX_LEG_DISTANCE    24      ///< maximum distance of the returned waypoint from the start
+#define HPA_MAX_SINGLE_ENTRANCE 6       ///< transitions shorter than this get only one entrance in the middle
+
+#define HPA_COST_STRAIGHT       10
+#define HPA_COST_DIAGONAL       14
+
+HierarchicalPathGraph::HierarchicalPathGraph(const Map* pMap)
+ : pMap(pMap) {
+}
+
+void HierarchicalPathGraph::reset() {
+    numClustersX = (pMap->getSizeX() + HPA_CLUSTERSIZE - 1) / HPA_CLUSTERSIZE;
+    numClustersY = (pMap->getSizeY() + HPA_CLUSTERSIZE - 1) / HPA_CLUSTERSIZE;
+
+    for(Layer& layer : layers) {
+        layer.clusters.clear();
+        layer.clusters.resize(numClustersX*numClustersY);
+        layer.eastBorders.clear();
+        layer.eastBorders.resize(numClustersX*numClustersY);
+        layer.southBorders.clear();
+        layer.southBorders.resize(numClustersX*numClustersY);
+        layer.bDirty = true;
+    }
+}
+
+void HierarchicalPathGraph::invalidateArea(int x, int y, int width, int height) {
+    if((numClustersX == 0) || (numClustersY == 0)) {
+        return;
+    }
+
+    // the tiles next to the area are part of the transitions that might have changed
+    const int x1 = std::max(0, x - 1);
+    const int y1 = std::max(0, y - 1);
+    const int x2 = std::min(pMap->getSizeX() - 1, x + width);
+    const int y2 = std::min(pMap->getSizeY() - 1, y + height);
+
+    if((x1 > x2) || (y1 > y2)) {
+        return;
+    }
+
+    for(Layer& layer : layers) {
+        for(int cy = y1 / HPA_CLUSTERSIZE; cy <= y2 / HPA_CLUSTERSIZE; cy++) {
+            for(int cx = x1 / HPA_CLUSTERSIZE; cx <= x2 / HPA_CLUSTERSIZE; cx++) {
+                layer.clusters[cy*numClustersX + cx].bBordersDirty = true;
+            }
+        }
+        layer.bDirty = true;
+    }
+}
+
+bool HierarchicalPathGraph::findWaypoint(bool bInfantry, const Coord& start, const Coord& destination, Coord& waypoint) {
+    if(!pMap->tileExists(start) || !pMap->tileExists(destination) || (blockDistance(start, destination) <= HPA_MIN_DISTANCE)) {
+        return false;
+    }
+
+    const int layerIndex = bInfantry ? 1 : 0;
+    update(layerIndex);
+    const Layer& layer = layers[layerIndex];
+
+    const int startCluster = getClusterIndex(start);
+    const int destCluster = getClusterIndex(destination);
+    if(startCluster == destCluster) {
+        return false;
+    }
+
+    std::vector<int> startCosts;
+    std::vector<int> destCosts;
+    calculateClusterDistances(layerIndex, startCluster, start, startCosts);
+    calculateClusterDistances(layerIndex, destCluster, destination, destCosts);
+
+    struct NodeInfo {
+        int  g;
+        int  parent;
+        int  cluster;
+        int  entrance;
+        bool bClosed;
+    };
+
+    const int sizeX = pMap->getSizeX();
+    const int goalKey = sizeX * pMap->getSizeY();
+
+    // the graph is small, so a map keyed by tile index is sufficient and keeps the search deterministic
+    std::map<int, NodeInfo> nodes;
+    std::priority_queue<std::pair<int,int>, std::vector<std::pair<int,int>>, std::greater<std::pair<int,int>>> openList;
+
+    auto heuristic = [&](int key) {
+        if(key == goalKey) {
+            return 0;
+        }
+        const int dx = abs(key % sizeX - destination.x);
+        const int dy = abs(key / sizeX - destination.y);
+        return HPA_COST_STRAIGHT*std::max(dx,dy) + (HPA_COST_DIAGONAL - HPA_COST_STRAIGHT)*std::min(dx,dy);
+    };
+
+    auto relax = [&](int key, int cluster, int entrance, int g, int parent) {
+        auto iter = nodes.find(key);
+        if(iter == nodes.end()) {
+            nodes.emplace(key, NodeInfo{g, parent, cluster, entrance, false});
+        } else if(iter->second.bClosed || (g >= iter->second.g)) {
+            return;
+        } else {
+            iter->second.g = g;
+            iter->second.parent = parent;
+        }
+        openList.emplace(g + heuristic(key), key);
+    };
+
+    const Cluster& firstCluster = layer.clusters[startCluster];
+    for(size_t i = 0; i < firstCluster.entrances.size(); i++) {
+        if(startCosts[i] >= 0) {
+            const Coord& entrance = firstCluster.entrances[i];
+            relax(entrance.y*sizeX + entrance.x, startCluster, i, startCosts[i], -1);
+        }
+    }
+
+    bool bFound = false;
+    while(!openList.empty()) {
+        const int key = openList.top().second;
+        openList.pop();
+
+        NodeInfo& node = nodes[key];
+        if(node.bClosed) {
+            continue;
+        }
+        node.bClosed = true;
+
+        if(key == goalKey) {
+            bFound = true;
+            break;
+        }
+
+        const int g = node.g;
+        const int nodeCluster = node.cluster;
+        const int i = node.entrance;
+        const Cluster& cluster = layer.clusters[nodeCluster];
+        const size_t numEntrances = cluster.entrances.size();
+
+        for(size_t j = 0; j < numEntrances; j++) {
+            const int distance = cluster.distances[i*numEntrances + j];
+            if((static_cast<int>(j) != i) && (distance >= 0)) {
+                const Coord& entrance = cluster.entrances[j];
+                relax(entrance.y*sizeX + entrance.x, nodeCluster, j, g + distance, key);
+            }
+        }
+
+        for(const Coord& partner : cluster.partners[i]) {
+            const int partnerCluster = getClusterIndex(partner);
+            const std::vector<Coord>& partnerEntrances = layer.clusters[partnerCluster].entrances;
+            const auto iter = std::find(partnerEntrances.begin(), partnerEntrances.end(), partner);
+            if(iter != partnerEntrances.end()) {
+                relax(partner.y*sizeX + partner.x, partnerCluster, iter - partnerEntrances.begin(), g + HPA_COST_STRAIGHT, key);
+            }
+        }
+
+        if((nodeCluster == destCluster) && (destCosts[i] >= 0)) {
+            relax(goalKey, destCluster, -1, g + destCosts[i], key);
+        }
+    }
+
+    if(!bFound) {
+        return false;
+    }
+
+    std::vector<Coord> route;
+    for(int key = nodes[goalKey].parent; key != -1; key = nodes[key].parent) {
+        route.emplace_back(key % sizeX, key / sizeX);
+    }
+    std::reverse(route.begin(), route.end());
+
+    bool bWaypointFound = false;
+    for(const Coord& coord : route) {
+        if(coord == start) {
+            continue;
+        }
+
+        if(bWaypointFound && (blockDistance(start, coord) > HPA_MAX_LEG_DISTANCE)) {
+            break;
+        }
+
+        waypoint = coord;
+        bWaypointFound = true;
+    }
+
+    return bWaypointFound;
+}
+
+bool HierarchicalPathGraph::isPassable(int layerIndex, int x, int y) const {
+    const Tile* pTile = pMap->getTile(x, y);
+
+    if(pTile->hasAStructure()) {
+        return false;
+    }
+
+    return (layerIndex == 1) || !pTile->isMountain();
+}
+
+int HierarchicalPathGraph::getClusterIndex(const Coord& coord) const {
+    return (coord.y / HPA_CLUSTERSIZE)*numClustersX + (coord.x / HPA_CLUSTERSIZE);
+}
+
+void HierarchicalPathGraph::update(int layerIndex) {
+    Layer& layer = layers[layerIndex];
+
+    if(!layer.bDirty) {
+        return;
+    }
+
+    for(int cy = 0; cy < numClustersY; cy++) {
+        for(int cx = 0; cx < numClustersX; cx++) {
+            const int index = cy*numClustersX + cx;
+            if(!layer.clusters[index].bBordersDirty) {
+                continue;
+            }
+
+            const int x = cx*HPA_CLUSTERSIZE;
+            const int y = cy*HPA_CLUSTERSIZE;
+            const int width = std::min(HPA_CLUSTERSIZE, pMap->getSizeX() - x);
+            const int height = std::min(HPA_CLUSTERSIZE, pMap->getSizeY() - y);
+
+            if(cx < numClustersX - 1) {
+                calculateBorder(layerIndex, Coord(x + width - 1, y), Coord(x + width, y), true, height, layer.eastBorders[index]);
+                layer.clusters[index + 1].bEdgesDirty = true;
+            }
+            if(cx > 0) {
+                calculateBorder(layerIndex, Coord(x - 1, y), Coord(x, y), true, height, layer.eastBorders[index - 1]);
+                layer.clusters[index - 1].bEdgesDirty = true;
+            }
+            if(cy < numClustersY - 1) {
+                calculateBorder(layerIndex, Coord(x, y + height - 1), Coord(x, y + height), false, width, layer.southBorders[index]);
+                layer.clusters[index + numClustersX].bEdgesDirty = true;
+            }
+            if(cy > 0) {
+                calculateBorder(layerIndex, Coord(x, y - 1), Coord(x, y), false, width, layer.southBorders[index - numClustersX]);
+                layer.clusters[index - numClustersX].bEdgesDirty = true;
+            }
+
+            layer.clusters[index].bBordersDirty = false;
+            layer.clusters[index].bEdgesDirty = true;
+        }
+    }
+
+    for(int index = 0; index < numClustersX*numClustersY; index++) {
+        if(layer.clusters[index].bEdgesDirty) {
+            calculateEdges(layerIndex, index);
+            layer.clusters[index].bEdgesDirty = false;
+        }
+    }
+
+    layer.bDirty = false;
+}
+
+void HierarchicalPathGraph::calculateBorder(int layerIndex, const Coord& first, const Coord& second, bool bVertical, int length, Border& border) const {
+    border.clear();
+
+    const Coord step = bVertical ? Coord(0,1) : Coord(1,0);
+
+    auto addTransition = [&](int i) {
+        border.emplace_back(Coord(first.x + i*step.x, first.y + i*step.y), Coord(second.x + i*step.x, second.y + i*step.y));
+    };
+
+    int runStart = -1;
+    for(int i = 0; i <= length; i++) {
+        const bool bOpen = (i < length)
+                            && isPassable(layerIndex, first.x + i*step.x, first.y + i*step.y)
+                            && isPassable(layerIndex, second.x + i*step.x, second.y + i*step.y);
+
+        if(bOpen && (runStart < 0)) {
+            runStart = i;
+        } else if(!bOpen && (runStart >= 0)) {
+            const int runLength = i - runStart;
+            if(runLength < HPA_MAX_SINGLE_ENTRANCE) {
+                addTransition(runStart + runLength/2);
+            } else {
+                addTransition(runStart);
+                addTransition(i - 1);
+            }
+            runStart = -1;
+        }
+    }
+}
+
+void HierarchicalPathGraph::calculateEdges(int layerIndex, int clusterIndex) {
+    Layer& layer = layers[layerIndex];
+    Cluster& cluster = layer.clusters[clusterIndex];
+
+    cluster.entrances.clear();
+    cluster.partners.clear();
+
+    auto addEntrance = [&](const Coord& entrance, const Coord& partner) {
+        auto iter = std::find(cluster.entrances.begin(), cluster.entrances.end(), entrance);
+        size_t index = iter - cluster.entrances.begin();
+        if(iter == cluster.entrances.end()) {
+            cluster.entrances.push_back(entrance);
+            cluster.partners.emplace_back();
+        }
+        cluster.partners[index].push_back(partner);
+    };
+
+    const int cx = clusterIndex % numClustersX;
+    const int cy = clusterIndex / numClustersX;
+
+    if(cy > 0) {
+        for(const auto& transition : layer.southBorders[clusterIndex - numClustersX]) {
+            addEntrance(transition.second, transition.first);
+        }
+    }
+    if(cx > 0) {
+        for(const auto& transition : layer.eastBorders[clusterIndex - 1]) {
+            addEntrance(transition.second, transition.first);
+        }
+    }
+    if(cx < numClustersX - 1) {
+        for(const auto& transition : layer.eastBorders[clusterIndex]) {
+            addEntrance(transition.first, transition.second);
+        }
+    }
+    if(cy < numClustersY - 1) {
+        for(const auto& transition : layer.southBorders[clusterIndex]) {
+            addEntrance(transition.first, transition.second);
+        }
+    }
+
+    const size_t numEntrances = cluster.entrances.size();
+    cluster.distances.assign(numEntrances*numEntrances, -1);
+
+    std::vector<int> costs;
+    for(size_t i = 0; i < numEntrances; i++) {
+        calculateClusterDistances(layerIndex, clusterIndex, cluster.entrances[i], costs);
+        std::copy(costs.begin(), costs.end(), cluster.distances.begin() + i*numEntrances);
+    }
+}
+
+void HierarchicalPathGraph::calculateClusterDistances(int layerIndex, int clusterIndex, const Coord& source, std::vector<int>& costs) const {
+    const Cluster& cluster = layers[layerIndex].clusters[clusterIndex];
+
+    const int clusterX = (clusterIndex % numClustersX) * HPA_CLUSTERSIZE;
+    const int clusterY = (clusterIndex / numClustersX) * HPA_CLUSTERSIZE;
+    const int width = std::min(HPA_CLUSTERSIZE, pMap->getSizeX() - clusterX);
+    const int height = std::min(HPA_CLUSTERSIZE, pMap->getSizeY() - clusterY);
+
+    // Dijkstra restricted to the cluster. The source tile itself is always entered even if it is blocked
+    std::vector<int> distance(width*height, -1);
+    std::priority_queue<std::pair<int,int>, std::vector<std::pair<int,int>>, std::greater<std::pair<int,int>>> openList;
+
+    const int sourceIndex = (source.y - clusterY)*width + (source.x - clusterX);
+    distance[sourceIndex] = 0;
+    openList.emplace(0, sourceIndex);
+
+    while(!openList.empty()) {
+        const int cost = openList.top().first;
+        const int index = openList.top().second;
+        openList.pop();
+
+        if(cost > distance[index]) {
+            continue;
+        }
+
+        const Coord current(clusterX + index % width, clusterY + index / width);
+        for(int angle = 0; angle < NUM_ANGLES; angle++) {
+            const Coord next = Map::getMapPos(angle, current);
+            if((next.x < clusterX) || (next.x >= clusterX + width) || (next.y < clusterY) || (next.y >= clusterY + height)) {
+                continue;
+            }
+
+            if(!isPassable(layerIndex, next.x, next.y)) {
+                continue;
+            }
+
+            const int nextIndex = (next.y - clusterY)*width + (next.x - clusterX);
+            const int nextCost = cost + (((next.x != current.x) && (next.y != current.y)) ? HPA_COST_DIAGONAL : HPA_COST_STRAIGHT);
+            if((distance[nextIndex] < 0) || (nextCost < distance[nextIndex])) {
+                distance[nextIndex] = nextCost;
+                openList.emplace(nextCost, nextIndex);
+            }
+        }
+    }
+
+    costs.resize(cluster.entrances.size());
+    for(size_t i = 0; i < cluster.entrances.size(); i++) {
+        const Coord& entrance = cluster.entrances[i];
+        costs[i] = distance[(entrance.y - clusterY)*width + (entrance.x - clusterX)];
+    }
+}
@@ -32,15 +32,19 @@
 #include <GameInterface.h>
 #include <Map.h>
 #include <SoundPlayer.h>
+#include <GameEventBus.h>
 
 #include <structures/StructureBase.h>
 #include <structures/BuilderBase.h>
 #include <structures/Refinery.h>
+#include <structures/RepairYard.h>
 #include <structures/ConstructionYard.h>
+#include <structures/WindTrap.h>
 #include <units/Carryall.h>
 #include <units/Harvester.h>
 
 #include <misc/exceptions.h>
+#include <misc/AllocationCounter.h>
 #include <misc/format.h>
 
 #include <algorithm>
@@ -145,6 +149,7 @@ void House::init() {
 
     capacity = 0;
     powerRequirement = 0;
+    pendingRefinedSpice = 0;
 
     numVisibleEnemyUnits = 0;
     numVisibleFriendlyUnits = 0;
@@ -222,11 +227,52 @@ void House::setProducedPower(int newPower) {
     producedPower = newPower;
 }
 
+bool House::checkStructureAggregates() const {
+    int recountedCapacity = 0;
+    int recountedProducedPower = 0;
+    int recountedPowerRequirement = 0;
+    for(const StructureBase* pStructure : structureList) {
+        if(pStructure->getOwner() != this) {
+            continue;
+        }
+
+        const int itemID = pStructure->getItemID();
+        const int itemPower = currentGame->objectData.data[itemID][houseID].power;
+        if(itemPower >= 0) {
+            recountedPowerRequirement += itemPower;
+        }
+        recountedCapacity += currentGame->objectData.data[itemID][houseID].capacity;
+
+        if(itemID == Structure_WindTrap) {
+            recountedProducedPower += static_cast<const WindTrap*>(pStructure)->getProducedPower();
+        }
+    }
+
+    bool bMatches = true;
+    if(capacity != recountedCapacity) {
+        SDL_Log("House %d: spice capacity is %d but the structures sum up to %d", houseID, capacity, recountedCapacity);
+        bMatches = false;
+    }
+    if(producedPower != recountedProducedPower) {
+        SDL_Log("House %d: produced power is %d but the structures sum up to %d", houseID, producedPower, recountedProducedPower);
+        bMatches = false;
+    }
+    if(powerRequirement != recountedPowerRequirement) {
+        SDL_Log("House %d: power requirement is %d but the structures sum up to %d", houseID, powerRequirement, recountedPowerRequirement);
+        bMatches = false;
+    }
+    return bMatches;
+}
+
 
 void House::addCredits(FixPoint newCredits, bool wasRefined) {
     if(newCredits > 0) {
         if(wasRefined == true) {
             harvestedSpice += newCredits;
+
+            if(GameEventBus::isAttached()) {
+                GameEventBus::add(GameEventType::Harvested, houseID, ItemID_Invalid, lround(newCredits));
+            }
         }
 
         storedCredits += newCredits;
@@ -325,11 +371,57 @@ void House::update() {
     numVisibleEnemyUnits = 0;
     numVisibleFriendlyUnits = 0;
 
-    if (oldCredits != getCredits()) {
-        if((this == pLocalHouse) && (getCredits() > 0)) {
-            soundPlayer->playSound(Sound_CreditsTick);
+#ifdef DEBUG_HOUSE_AGGREGATES
+    checkStructureAggregates();
+#endif
+
+    powerUsageTimer--;
+    if(powerUsageTimer <= 0) {
+        powerUsageTimer = MILLI2CYCLES(15*1000);
+        takeCredits(FixPoint(getPowerRequirement()) / 32);
+    }
+
+    choam.update();
+
+    PROFILE_PHASE(currentGame->getProfiler(), ProfilerPhase_AIPlayers);
+    MEMORY_TAG(MemoryTag_AI);
+    for(auto& pPlayer : players) {
+        if(pPlayer->isPlanningConcurrently()) {
+            // it already planned together with the other houses (see Game::planPlayers())
+            pPlayer->commitOrders();
+        } else {
+            pPlayer->update();
+        }
+    }
+}
+
+bool House::beginPlanning() {
+    bool bPlanning = false;
+    for(auto& pPlayer : players) {
+        if(pPlayer->isPlanningConcurrently()) {
+            pPlayer->beginPlanning();
+            bPlanning = true;
+        }
+    }
+    return bPlanning;
+}
+
+void House::planPlayers() {
+    MEMORY_TAG(MemoryTag_AI);
+    for(auto& pPlayer : players) {
+        if(pPlayer->isPlanningConcurrently()) {
+            pPlayer->update();
         }
-        oldCredits = getCredits();
+    }
+}
+
+
+
+
+void House::updateEconomy() {
+    if(pendingRefinedSpice > 0) {
+        addCredits(pendingRefinedSpice, true);
+        pendingRefinedSpice = 0;
     }
 
     if(storedCredits > capacity) {
@@ -343,21 +435,79 @@ void House::update() {
         }
     }
 
-    powerUsageTimer--;
-    if(powerUsageTimer <= 0) {
-        powerUsageTimer = MILLI2CYCLES(15*1000);
-        takeCredits(FixPoint(getPowerRequirement()) / 32);
+    if (oldCredits != getCredits()) {
+        if((this == pLocalHouse) && (getCredits() > 0)) {
+            soundPlayer->playSound(Sound_CreditsTick);
+        }
+        oldCredits = getCredits();
     }
+}
 
-    choam.update();
-
-    for(auto& pPlayer : players) {
-        pPlayer->update();
+void House::requestCarryall(const ObjectBase* pRequester) {
+    Uint32 objectID = pRequester->getObjectID();
+    if(std::find(carryallRequests.begin(), carryallRequests.end(), objectID) == carryallRequests.end()) {
+        carryallRequests.push_back(objectID);
     }
 }
 
+void House::dispatchCarryalls() {
+    if(carryallRequests.empty()) {
+        return;
+    }
+
+    std::vector<ObjectBase*> requesters;
+    for(Uint32 objectID : carryallRequests) {
+        ObjectBase* pRequester = currentGame->getObjectManager().getObject(objectID);
+        if((pRequester != nullptr) && (pRequester->getOwner() == this)) {
+            requesters.push_back(pRequester);
+        }
+    }
+    carryallRequests.clear();
+
+    std::vector<Carryall*> idleCarryalls;
+    for(UnitBase* pUnit : unitListByItemID[Unit_Carryall]) {
+        if((pUnit->getOwner() == this) && !static_cast<Carryall*>(pUnit)->isBooked()) {
+            idleCarryalls.push_back(static_cast<Carryall*>(pUnit));
+        }
+    }
+
+    // Serve the closest requester/carryall pair first. Ties go to the earlier request and the earlier carryall in the unit list.
+    while(!requesters.empty() && !idleCarryalls.empty()) {
+        size_t bestRequester = 0;
+        size_t bestCarryall = 0;
+        FixPoint bestDistance = FixPt_MAX;
+
+        for(size_t i = 0; i < requesters.size(); i++) {
+            for(size_t j = 0; j < idleCarryalls.size(); j++) {
+                const Coord& carryallLocation = idleCarryalls[j]->getLocation();
+                FixPoint distance = blockDistance(carryallLocation, requesters[i]->getClosestPoint(carryallLocation));
+                if(distance < bestDistance) {
+                    bestDistance = distance;
+                    bestRequester = i;
+                    bestCarryall = j;
+                }
+            }
+        }
+
+        assignCarryall(requesters[bestRequester], idleCarryalls[bestCarryall]);
+        requesters.erase(requesters.begin() + bestRequester);
+        idleCarryalls.erase(idleCarryalls.begin() + bestCarryall);
+    }
 
+    for(ObjectBase* pRequester : requesters) {
+        assignCarryall(pRequester, nullptr);
+    }
+}
 
+void House::assignCarryall(ObjectBase* pRequester, Carryall* pCarryall) {
+    if(pRequester->isAGroundUnit()) {
+        static_cast<GroundUnit*>(pRequester)->assignCarryall(pCarryall);
+    } else if(pRequester->getItemID() == Structure_Refinery) {
+        static_cast<Refinery*>(pRequester)->assignCarryall(pCarryall);
+    } else if(pRequester->getItemID() == Structure_RepairYard) {
+        static_cast<RepairYard*>(pRequester)->assignCarryall(pCarryall);
+    }
+}
 
 void House::incrementUnits(int itemID) {
     numUnits++;
@@ -423,7 +573,7 @@ void House::incrementStructures(int itemID) {
     // change spice capacity
     capacity += currentGame->objectData.data[itemID][houseID].capacity;
 
-    if(currentGame->gameState != GameState::Loading) {
+    if((currentGame->gameState != GameState::Loading) && !currentGame->bSpawningInBulk) {
         // do not check selection lists if we are loading
         updateBuildLists();
     }
@@ -446,7 +596,7 @@ void House::decrementStructures(int itemID, const Coord& location) {
     // change spice capacity
     capacity -= currentGame->objectData.data[itemID][houseID].capacity;
 
-    if(currentGame->gameState != GameState::Loading) {
+    if((currentGame->gameState != GameState::Loading) && !currentGame->bSpawningInBulk) {
         // do not check selection lists if we are loading
         updateBuildLists();
     }
@@ -485,6 +635,10 @@ void House::informWasBuilt(ObjectBase* pObject) {
 
     numItemBuilt[itemID]++;
 
+    if(GameEventBus::isAttached()) {
+        GameEventBus::add(GameEventType::Built, houseID, itemID, currentGame->objectData.data[itemID][houseID].price);
+    }
+
     for(auto& pPlayer : players) {
         pPlayer->onObjectWasBuilt(pObject);
     }
@@ -518,6 +672,9 @@ void House::informHasKilled(Uint32 itemID) {
 
     numItemKills[itemID]++;
 
+    if(GameEventBus::isAttached()) {
+        GameEventBus::add(GameEventType::Killed, houseID, itemID, 1);
+    }
 
     for(auto& pPlayer : players) {
         pPlayer->onIncrementUnitKills(itemID);
@@ -531,6 +688,10 @@ void House::informHasKilled(Uint32 itemID) {
 
 void House::informHasDamaged(Uint32 itemID, Uint32 damage) {
     numItemDamageInflicted[itemID] += damage;
+
+    if(GameEventBus::isAttached()) {
+        GameEventBus::add(GameEventType::Damaged, houseID, itemID, damage);
+    }
 }
 
 
@@ -751,8 +912,8 @@ StructureBase* House::placeStructure(Uint32 builderID, int itemID, int xPos, int
 
                 if(itemID == Structure_Palace) {
                     // cancel all other palaces
-                    for(StructureBase* pStructure : structureList) {
-                        if(pStructure->getOwner() == this && pStructure->getItemID() == Structure_ConstructionYard) {
+                    for(StructureBase* pStructure : structureListByItemID[Structure_ConstructionYard]) {
+                        if(pStructure->getOwner() == this) {
                             ConstructionYard* pConstructionYard = static_cast<ConstructionYard*>(pStructure);
                             if(pBuilder != pConstructionYard) {
                                 pConstructionYard->doCancelItem(Structure_Palace, false);
@@ -773,7 +934,7 @@ StructureBase* House::placeStructure(Uint32 builderID, int itemID, int xPos, int
                 pBuilder->getOwner()->informWasBuilt(newObject);
             }
 
-            if(newStructure->isABuilder()) {
+            if(newStructure->isABuilder() && !currentGame->bSpawningInBulk) {
                 static_cast<BuilderBase*>(newStructure)->updateBuildList();
             }
 
@@ -895,8 +1056,8 @@ void House::decrementHarvesters() {
             FixPoint    closestDistance = FixPt_MAX;
             StructureBase *pClosestRefinery = nullptr;
 
-            for(StructureBase* pStructure : structureList) {
-                if((pStructure->getItemID() == Structure_Refinery) && (pStructure->getOwner() == this) && (pStructure->getHealth() > 0)) {
+            for(StructureBase* pStructure : structureListByItemID[Structure_Refinery]) {
+                if((pStructure->getOwner() == this) && (pStructure->getHealth() > 0)) {
                     Coord pos = pStructure->getLocation();
 
                     Coord closestPoint = pStructure->getClosestPoint(pos);
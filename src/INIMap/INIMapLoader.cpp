@@ -35,6 +35,12 @@ INIMapLoader::INIMapLoader(Game* pGame, const std::string& mapname, const std::s
     load();
 }
 
+INIMapLoader::INIMapLoader(Game* pGame, INIFile* pINIFile, const std::string& mapname)
+ : INIMap(pINIFile, mapname), pGame(pGame)
+{
+    load();
+}
+
 INIMapLoader::~INIMapLoader() {
 }
 
@@ -47,8 +53,20 @@ void INIMapLoader::load() {
 
     loadMap();
     loadHouses();
+
+    // every structure would update the build lists of all builders of its house (quadratic in the number of structures)
+    pGame->bSpawningInBulk = true;
     loadUnits();
     loadStructures();
+    pGame->bSpawningInBulk = false;
+
+    for(int houseID = 0; houseID < NUM_HOUSES; houseID++) {
+        House* pHouse = pGame->getHouse(houseID);
+        if(pHouse != nullptr) {
+            pHouse->updateBuildLists();
+        }
+    }
+
     loadReinforcements();
     loadAITeams();
     loadView();
@@ -795,24 +813,20 @@ void INIMapLoader::loadReinforcements()
         for(int i=0;i<Num2Drop;i++) {
             // check if there is a similar trigger at the same time
 
-            bool bInserted = false;
-            for(const auto& pTrigger : pGame->getTriggerManager().getTriggers()) {
-                ReinforcementTrigger* pReinforcementTrigger = dynamic_cast<ReinforcementTrigger*>(pTrigger.get());
+            Trigger* pSimilarTrigger = pGame->getTriggerManager().findTrigger([&](const Trigger* pTrigger) {
+                const ReinforcementTrigger* pReinforcementTrigger = dynamic_cast<const ReinforcementTrigger*>(pTrigger);
 
-                if(pReinforcementTrigger != nullptr
-                    && pReinforcementTrigger->getCycleNumber() == dropCycle
-                    && pReinforcementTrigger->getHouseID() == houseID
-                    && pReinforcementTrigger->isRepeat() == bRepeat
-                    && pReinforcementTrigger->getDropLocation() == dropLocation) {
-
-                    // add the new reinforcement to this reinforcement (call only one carryall)
-                    pReinforcementTrigger->addUnit(itemID);
-                    bInserted = true;
-                    break;
-                }
-            }
+                return (pReinforcementTrigger != nullptr
+                        && pReinforcementTrigger->getCycleNumber() == dropCycle
+                        && pReinforcementTrigger->getHouseID() == houseID
+                        && pReinforcementTrigger->isRepeat() == bRepeat
+                        && pReinforcementTrigger->getDropLocation() == dropLocation);
+            });
 
-            if(bInserted == false) {
+            if(pSimilarTrigger != nullptr) {
+                // add the new reinforcement to this reinforcement (call only one carryall)
+                static_cast<ReinforcementTrigger*>(pSimilarTrigger)->addUnit(itemID);
+            } else {
                 getOrCreateHouse(houseID);  // create house if not yet available
                 pGame->getTriggerManager().addTrigger(std::make_unique<ReinforcementTrigger>(houseID, itemID, dropLocation, bRepeat, dropCycle));
             }
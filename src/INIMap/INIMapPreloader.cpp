@@ -0,0 +1,73 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <INIMap/INIMapPreloader.h>
+
+#include <INIMap/INIMap.h>
+
+#include <misc/exceptions.h>
+#include <misc/Tracing.h>
+
+INIMapPreloader::INIMapPreloader(GameType gameType, const std::string& mapname, const std::string& mapdata)
+ : gameType(gameType), mapname(mapname), mapdata(mapdata) {
+
+    pThread = SDL_CreateThread(preloaderThreadMain, "INIMapPreloader", (void*) this);
+    if(pThread == nullptr) {
+        // parse it when it is needed
+        SDL_Log("INIMapPreloader: Cannot create thread: %s", SDL_GetError());
+    }
+}
+
+INIMapPreloader::~INIMapPreloader() {
+    wait();
+}
+
+std::unique_ptr<INIFile> INIMapPreloader::getINIFile() {
+    wait();
+
+    if(pException) {
+        std::rethrow_exception(pException);
+    }
+
+    if(pINIFile == nullptr) {
+        pINIFile = INIMap::loadINIFile(gameType, mapname, mapdata);
+    }
+
+    return std::move(pINIFile);
+}
+
+void INIMapPreloader::wait() {
+    if(pThread != nullptr) {
+        SDL_WaitThread(pThread, nullptr);
+        pThread = nullptr;
+    }
+}
+
+int INIMapPreloader::preloaderThreadMain(void* data) {
+    INIMapPreloader* pPreloader = static_cast<INIMapPreloader*>(data);
+
+    TRACE_THREAD_NAME("INIMapPreloader");
+    TRACE_ZONE("Preload scenario");
+
+    try {
+        pPreloader->pINIFile = INIMap::loadINIFile(pPreloader->gameType, pPreloader->mapname, pPreloader->mapdata);
+    } catch(...) {
+        pPreloader->pException = std::current_exception();
+    }
+
+    return 0;
+}
@@ -46,6 +46,7 @@ sdl2::surface_ptr INIMapPreviewCreator::createMinimapImageOfMap(int borderWidth,
     int offsetX = 0;
     int offsetY = 0;
     int scale = 1;
+    int downsampling = 1;
     int sizeX = 64;
     int sizeY = 64;
     int logicalSizeX = 64;
@@ -177,7 +178,7 @@ sdl2::surface_ptr INIMapPreviewCreator::createMinimapImageOfMap(int borderWidth,
 
                 for(int i=0;i<scale;i++) {
                     for(int j=0;j<scale;j++) {
-                        putPixel(pMinimap.get(), x*scale + i + offsetX, y*scale + j + offsetY, color);
+                        putPixel(pMinimap.get(), (x/downsampling)*scale + i + offsetX, (y/downsampling)*scale + j + offsetY, color);
                     }
                 }
             }
@@ -197,7 +198,7 @@ sdl2::surface_ptr INIMapPreviewCreator::createMinimapImageOfMap(int borderWidth,
                     if(xpos >= 0 && xpos < sizeX && ypos >= 0 && ypos < sizeY) {
                         for(int i=0;i<scale;i++) {
                             for(int j=0;j<scale;j++) {
-                                putPixel(pMinimap.get(), xpos*scale + i + offsetX, ypos*scale + j + offsetY, COLOR_BLOOM);
+                                putPixel(pMinimap.get(), (xpos/downsampling)*scale + i + offsetX, (ypos/downsampling)*scale + j + offsetY, COLOR_BLOOM);
                             }
                         }
                     }
@@ -221,7 +222,7 @@ sdl2::surface_ptr INIMapPreviewCreator::createMinimapImageOfMap(int borderWidth,
                     if(xpos >= 0 && xpos < sizeX && ypos >= 0 && ypos < sizeY) {
                         for(int i=0;i<scale;i++) {
                             for(int j=0;j<scale;j++) {
-                                putPixel(pMinimap.get(), xpos*scale + i + offsetX, ypos*scale + j + offsetY, COLOR_BLOOM);
+                                putPixel(pMinimap.get(), (xpos/downsampling)*scale + i + offsetX, (ypos/downsampling)*scale + j + offsetY, COLOR_BLOOM);
                             }
                         }
                     }
@@ -245,7 +246,7 @@ sdl2::surface_ptr INIMapPreviewCreator::createMinimapImageOfMap(int borderWidth,
         logicalSizeX = sizeX;
         logicalSizeY = sizeY;
 
-        RadarView::calculateScaleAndOffsets(sizeX, sizeY, scale, offsetX, offsetY);
+        RadarView::calculateScaleAndOffsets(sizeX, sizeY, scale, downsampling, offsetX, offsetY);
 
         offsetX += borderWidth;
         offsetY += borderWidth;
@@ -304,7 +305,7 @@ sdl2::surface_ptr INIMapPreviewCreator::createMinimapImageOfMap(int borderWidth,
 
                 for(int i=0;i<scale;i++) {
                     for(int j=0;j<scale;j++) {
-                        putPixel(pMinimap.get(), x*scale + i + offsetX, y*scale + j + offsetY, color);
+                        putPixel(pMinimap.get(), (x/downsampling)*scale + i + offsetX, (y/downsampling)*scale + j + offsetY, color);
                     }
                 }
             }
@@ -356,7 +357,7 @@ sdl2::surface_ptr INIMapPreviewCreator::createMinimapImageOfMap(int borderWidth,
                     if(x >= 0 && x < sizeX && y >= 0 && y < sizeY) {
                         for(int i=0;i<scale;i++) {
                             for(int j=0;j<scale;j++) {
-                                putPixel(pMinimap.get(), x*scale + i + offsetX, y*scale + j + offsetY, color);
+                                putPixel(pMinimap.get(), (x/downsampling)*scale + i + offsetX, (y/downsampling)*scale + j + offsetY, color);
                             }
                         }
                     }
@@ -398,7 +399,7 @@ sdl2::surface_ptr INIMapPreviewCreator::createMinimapImageOfMap(int borderWidth,
                         if(x >= 0 && x < sizeX && y >= 0 && y < sizeY) {
                             for(int i=0;i<scale;i++) {
                                 for(int j=0;j<scale;j++) {
-                                    putPixel(pMinimap.get(), x*scale + i + offsetX, y*scale + j + offsetY, color);
+                                    putPixel(pMinimap.get(), (x/downsampling)*scale + i + offsetX, (y/downsampling)*scale + j + offsetY, color);
                                 }
                             }
                         }
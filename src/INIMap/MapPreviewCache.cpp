@@ -0,0 +1,332 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <INIMap/MapPreviewCache.h>
+
+#include <INIMap/INIMapPreviewCreator.h>
+#include <FileClasses/LoadSavePNG.h>
+#include <GUI/dune/DuneStyle.h>
+
+#include <misc/FileSystem.h>
+#include <misc/fnkdat.h>
+#include <misc/md5.h>
+#include <misc/Tracing.h>
+
+#include <algorithm>
+
+namespace {
+
+std::string getCacheDirectory() {
+    char tmp[FILENAME_MAX];
+    fnkdat(MAPPREVIEWCACHE_DIRECTORY "/", tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+    return tmp;
+}
+
+std::string md5Hex(const std::string& data) {
+    unsigned char md5sum[16];
+    md5(reinterpret_cast<const unsigned char*>(data.data()), static_cast<int>(data.size()), md5sum);
+
+    static const char* const hexDigits = "0123456789abcdef";
+    std::string result;
+    for(unsigned char c : md5sum) {
+        result += hexDigits[c >> 4];
+        result += hexDigits[c & 0xF];
+    }
+    return result;
+}
+
+}
+
+MapPreviewCache::MapPreviewCache()
+ : cacheDirectory(getCacheDirectory()), index(cacheDirectory + "index.ini"), bIndexChanged(false), bQuit(false) {
+
+    mutex = SDL_CreateMutex();
+    jobAvailableCond = SDL_CreateCond();
+
+    pWorkerThread = SDL_CreateThread(workerMain, "MapPreviewCache", (void*) this);
+    if(pWorkerThread == nullptr) {
+        SDL_Log("MapPreviewCache: Unable to create worker thread: %s", SDL_GetError());
+    }
+}
+
+MapPreviewCache::~MapPreviewCache() {
+    if(pWorkerThread != nullptr) {
+        SDL_LockMutex(mutex);
+        bQuit = true;
+        SDL_CondSignal(jobAvailableCond);
+        SDL_UnlockMutex(mutex);
+
+        SDL_WaitThread(pWorkerThread, nullptr);
+    }
+
+    SDL_DestroyCond(jobAvailableCond);
+    SDL_DestroyMutex(mutex);
+
+    if(bIndexChanged) {
+        if(!index.saveChangesTo(cacheDirectory + "index.ini")) {
+            SDL_Log("MapPreviewCache: Unable to save %sindex.ini!", cacheDirectory.c_str());
+        }
+    }
+}
+
+/**
+    Forgets all previews and queues all maps in directory for the background thread.
+    \param  directory   the directory the maps are in (with a trailing '/')
+*/
+void MapPreviewCache::setDirectory(const std::string& directory) {
+    std::list<FileInfo> files = getFileList(directory, "ini", true, FileListOrder_Name_CaseInsensitive_Asc);
+
+    SDL_LockMutex(mutex);
+
+    jobs.clear();
+    previews.clear();
+    for(const FileInfo& fileInfo : files) {
+        jobs.push_back(Job { directory + fileInfo.name, std::to_string(fileInfo.size), std::to_string(fileInfo.modifydate) });
+    }
+
+    SDL_CondSignal(jobAvailableCond);
+    SDL_UnlockMutex(mutex);
+}
+
+/**
+    Returns the preview of a map if the background thread has already created it. Otherwise the map is done next
+    and nullptr is returned; ask again later.
+    \param  mapFilepath the map file
+    \return the preview (valid until the next call of setDirectory()) or nullptr if it is not ready yet
+*/
+const MapPreview* MapPreviewCache::getPreview(const std::string& mapFilepath) {
+    SDL_LockMutex(mutex);
+
+    auto iter = previews.find(mapFilepath);
+    if(iter != previews.end()) {
+        const MapPreview* pPreview = iter->second.get();
+        SDL_UnlockMutex(mutex);
+        return pPreview;
+    }
+
+    Job job { mapFilepath, "", "" };
+    auto jobIter = std::find_if(jobs.begin(), jobs.end(), [&](const Job& j) { return j.filepath == mapFilepath; });
+    if(jobIter != jobs.end()) {
+        job = *jobIter;
+        jobs.erase(jobIter);
+    }
+
+    if(pWorkerThread == nullptr) {
+        // no background thread => do it now
+        SDL_UnlockMutex(mutex);
+        std::unique_ptr<MapPreview> pPreview;
+        try {
+            pPreview = createPreview(job);
+        } catch(std::exception& e) {
+            SDL_Log("MapPreviewCache: Cannot create preview of %s: %s", job.filepath.c_str(), e.what());
+            pPreview = std::make_unique<MapPreview>();
+        }
+        SDL_LockMutex(mutex);
+        const MapPreview* pResult = pPreview.get();
+        previews[mapFilepath] = std::move(pPreview);
+        SDL_UnlockMutex(mutex);
+        return pResult;
+    }
+
+    jobs.push_front(job);
+    SDL_CondSignal(jobAvailableCond);
+    SDL_UnlockMutex(mutex);
+
+    return nullptr;
+}
+
+int MapPreviewCache::workerMain(void* data) {
+    TRACE_THREAD_NAME("MapPreviewCache");
+    static_cast<MapPreviewCache*>(data)->processJobs();
+    return 0;
+}
+
+void MapPreviewCache::processJobs() {
+    SDL_LockMutex(mutex);
+
+    while(!bQuit) {
+        if(jobs.empty()) {
+            SDL_CondWait(jobAvailableCond, mutex);
+            continue;
+        }
+
+        Job job = jobs.front();
+        jobs.pop_front();
+
+        if(previews.count(job.filepath) > 0) {
+            continue;
+        }
+
+        SDL_UnlockMutex(mutex);
+
+        std::unique_ptr<MapPreview> pPreview;
+        try {
+            TRACE_ZONE("Create map preview");
+            pPreview = createPreview(job);
+        } catch(std::exception& e) {
+            SDL_Log("MapPreviewCache: Cannot create preview of %s: %s", job.filepath.c_str(), e.what());
+            pPreview = std::make_unique<MapPreview>();
+        }
+
+        SDL_LockMutex(mutex);
+
+        previews[job.filepath] = std::move(pPreview);
+    }
+
+    SDL_UnlockMutex(mutex);
+}
+
+/**
+    Creates the preview of a map, either from the cache directory or by parsing the map. This method is only
+    called by the background thread (or by getPreview() if there is no background thread).
+    \param  job the map to do
+    \return the preview
+*/
+std::unique_ptr<MapPreview> MapPreviewCache::createPreview(const Job& job) {
+    // the index remembers the hash of every file under a section named after the hash of its path
+    const std::string fileSection = md5Hex(job.filepath);
+
+    std::string mapdata;
+    std::string hash;
+    if(!job.fileSize.empty()
+        && (index.getStringValue(fileSection, "File Size") == job.fileSize)
+        && (index.getStringValue(fileSection, "Modify Date") == job.modifyDate)) {
+        hash = index.getStringValue(fileSection, "Hash");
+    }
+
+    if(hash.empty() || !index.hasSection(hash)) {
+        mapdata = readCompleteFile(job.filepath);
+        hash = md5Hex(mapdata);
+
+        if(!job.fileSize.empty()) {
+            index.setStringValue(fileSection, "File Size", job.fileSize);
+            index.setStringValue(fileSection, "Modify Date", job.modifyDate);
+            index.setStringValue(fileSection, "Hash", hash);
+            bIndexChanged = true;
+        }
+    }
+
+    const std::string minimapFilepath = cacheDirectory + hash + ".png";
+
+    if(index.hasSection(hash)) {
+        auto pPreview = std::make_unique<MapPreview>();
+        pPreview->sizeX = index.getIntValue(hash, "Size X");
+        pPreview->sizeY = index.getIntValue(hash, "Size Y");
+        pPreview->numPlayers = index.getIntValue(hash, "Players");
+        pPreview->author = index.getStringValue(hash, "Author", "-");
+        pPreview->license = index.getStringValue(hash, "License", "-");
+
+        if(!index.getBoolValue(hash, "Valid", false)) {
+            return pPreview;
+        }
+
+        sdl2::RWops_ptr pMinimapFile{ SDL_RWFromFile(minimapFilepath.c_str(), "rb") };
+        if(pMinimapFile) {
+            try {
+                pPreview->pMinimap = LoadPNG_RW(pMinimapFile.get());
+            } catch(std::exception&) {
+                pPreview->pMinimap = nullptr;
+            }
+        }
+        if(pPreview->pMinimap) {
+            return pPreview;
+        }
+
+        // the minimap is gone => create it again
+        if(mapdata.empty()) {
+            mapdata = readCompleteFile(job.filepath);
+        }
+    }
+
+    sdl2::RWops_ptr pRWops{ SDL_RWFromConstMem(mapdata.data(), static_cast<int>(mapdata.size())) };
+    INIFile inimap(pRWops.get());
+    std::unique_ptr<MapPreview> pPreview = readPreview(inimap);
+
+    index.setIntValue(hash, "Size X", pPreview->sizeX);
+    index.setIntValue(hash, "Size Y", pPreview->sizeY);
+    index.setIntValue(hash, "Players", pPreview->numPlayers);
+    index.setStringValue(hash, "Author", pPreview->author);
+    index.setStringValue(hash, "License", pPreview->license);
+    index.setBoolValue(hash, "Valid", pPreview->pMinimap != nullptr);
+    bIndexChanged = true;
+
+    if(pPreview->pMinimap && (SavePNG(pPreview->pMinimap.get(), minimapFilepath.c_str()) != 0)) {
+        SDL_Log("MapPreviewCache: Unable to save %s!", minimapFilepath.c_str());
+    }
+
+    return pPreview;
+}
+
+/**
+    Reads the properties of a map and renders its minimap.
+    \param  inimap  the map
+    \return the preview; its minimap is nullptr if the map is broken
+*/
+std::unique_ptr<MapPreview> MapPreviewCache::readPreview(INIFile& inimap) {
+    auto pPreview = std::make_unique<MapPreview>();
+
+    if(inimap.hasKey("MAP","Seed")) {
+        // old map format with seed value
+        int mapscale = inimap.getIntValue("BASIC", "MapScale", -1);
+
+        switch(mapscale) {
+            case 0: {
+                pPreview->sizeX = 62;
+                pPreview->sizeY = 62;
+            } break;
+
+            case 1: {
+                pPreview->sizeX = 32;
+                pPreview->sizeY = 32;
+            } break;
+
+            case 2: {
+                pPreview->sizeX = 21;
+                pPreview->sizeY = 21;
+            } break;
+
+            default: {
+                pPreview->sizeX = 64;
+                pPreview->sizeY = 64;
+            }
+        }
+    } else {
+        // new map format with saved map
+        pPreview->sizeX = inimap.getIntValue("MAP","SizeX", 0);
+        pPreview->sizeY = inimap.getIntValue("MAP","SizeY", 0);
+    }
+
+    try {
+        INIMapPreviewCreator mapPreviewCreator(&inimap);
+        pPreview->pMinimap = mapPreviewCreator.createMinimapImageOfMap(1, DuneStyle::buttonBorderColor);
+    } catch(...) {
+        pPreview->pMinimap = nullptr;
+    }
+
+    static const char* const playerSections[] = { "Atreides", "Ordos", "Harkonnen", "Fremen", "Mercenary", "Sardaukar",
+                                                  "Player1", "Player2", "Player3", "Player4", "Player5", "Player6" };
+    for(const char* section : playerSections) {
+        if(inimap.hasSection(section)) {
+            pPreview->numPlayers++;
+        }
+    }
+
+    pPreview->author = inimap.getStringValue("BASIC","Author", "-");
+    pPreview->license = inimap.getStringValue("BASIC","License", "-");
+
+    return pPreview;
+}
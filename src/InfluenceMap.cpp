@@ -0,0 +1,109 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <InfluenceMap.h>
+
+#include <globals.h>
+
+#include <House.h>
+#include <Map.h>
+#include <structures/StructureBase.h>
+#include <mmath.h>
+
+#include <algorithm>
+
+InfluenceMap::InfluenceMap(const Map* pMap) : pMap(pMap) {
+}
+
+void InfluenceMap::reset() {
+    std::fill(std::begin(baseCentres), std::end(baseCentres), BaseCentre());
+
+    bStructuresValid = false;
+}
+
+Coord InfluenceMap::getBaseCentre(int houseID) const {
+    updateStructures();
+
+    const auto& baseCentre = baseCentres[houseID];
+
+    if(baseCentre.numStructures == 0) {
+        return Coord::Invalid();
+    }
+
+    return Coord(baseCentre.totalX / baseCentre.numStructures, baseCentre.totalY / baseCentre.numStructures);
+}
+
+InfluenceMap::StructureTotals InfluenceMap::getStructureTotals(int houseID) const {
+    updateStructures();
+
+    return structureTotals[houseID];
+}
+
+FixPoint InfluenceMap::getDistanceToNearestEnemyStructure(int teamID, const Coord& location, FixPoint maxDistance) const {
+    updateStructures();
+
+    FixPoint nearestDistance = maxDistance;
+    for(int houseID = 0; houseID < NUM_HOUSES; houseID++) {
+        if(structureLocations[houseID].empty() || (houseTeams[houseID] == teamID)) {
+            continue;
+        }
+
+        for(const Coord& structureLocation : structureLocations[houseID]) {
+            const FixPoint distance = blockDistance(location, structureLocation);
+            if(distance < nearestDistance) {
+                nearestDistance = distance;
+            }
+        }
+    }
+
+    return nearestDistance;
+}
+
+void InfluenceMap::updateStructures() const {
+    if(bStructuresValid && (lastStructureListVersion == structureList.getVersion())) {
+        return;
+    }
+
+    std::fill(std::begin(structureTotals), std::end(structureTotals), StructureTotals());
+    std::fill(std::begin(baseCentres), std::end(baseCentres), BaseCentre());
+    for(auto& locations : structureLocations) {
+        locations.clear();
+    }
+
+    for(const StructureBase* pStructure : structureList) {
+        const auto houseID = pStructure->getOwner()->getHouseID();
+        const auto& location = pStructure->getLocation();
+
+        auto& totals = structureTotals[houseID];
+        totals.numStructures++;
+        totals.totalX += location.x;
+        totals.totalY += location.y;
+
+        if(pStructure->getStructureSizeX() != 1) {
+            auto& baseCentre = baseCentres[houseID];
+            baseCentre.numStructures++;
+            baseCentre.totalX += location.x;
+            baseCentre.totalY += location.y;
+        }
+
+        structureLocations[houseID].push_back(location);
+        houseTeams[houseID] = pStructure->getOwner()->getTeamID();
+    }
+
+    lastStructureListVersion = structureList.getVersion();
+    bStructuresValid = true;
+}
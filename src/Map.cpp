@@ -29,16 +29,36 @@
 #include <units/AirUnit.h>
 #include <structures/StructureBase.h>
 
+#include <misc/AllocationCounter.h>
+
+#include <algorithm>
 #include <climits>
+#include <cstdlib>
 #include <stack>
-#include <set>
 
 Map::Map(int xSize, int ySize)
- : sizeX(xSize), sizeY(ySize), lastSinglySelectedObject(nullptr) {
+ : sizeX(xSize), sizeY(ySize), layout(xSize, ySize), lastSinglySelectedObject(nullptr), pathGraph(this), connectivity(this), flowFields(this), pathCache(this), pathRequests(this), placementTables(this), influenceMap(this), visibility(tilePlanes) {
+
+    MEMORY_TAG(MemoryTag_Map);
 
     tiles.resize(sizeX * sizeY);
+    tilePlanes.reset(sizeX * sizeY, currentGame->getGameInitSettings().getGameOptions().startWithExploredMap);
 
     init_tile_location();
+
+    pathGraph.reset();
+    connectivity.reset();
+    flowFields.reset();
+    pathCache.reset();
+    pathRequests.reset();
+    objectIndex.reset(sizeX, sizeY);
+    targetChanges.reset(sizeX, sizeY);
+    bulletDrawBuckets.reset(sizeX, sizeY);
+    explosionDrawBuckets.reset(sizeX, sizeY);
+    visibility.reset(sizeX, sizeY);
+    spiceIndex.reset(sizeX, sizeY);
+    placementTables.reset();
+    influenceMap.reset();
 }
 
 
@@ -47,41 +67,88 @@ Map::~Map() = default;
 void Map::load(InputStream& stream) {
     sizeX = stream.readSint32();
     sizeY = stream.readSint32();
+    layout = TileLayout(sizeX, sizeY);
 
     tiles.clear();
     tiles.resize(sizeX * sizeY);
-
-    for (auto& tile : tiles)
-        tile.load(stream);
+    activeTiles.clear();
+    tilePlanes.reset(sizeX * sizeY, false);
+    visibility.reset(sizeX, sizeY);
 
     init_tile_location();
+
+    // the tiles are stored as one block and then read from memory
+    const Uint32 tileDataLength = stream.readUint32();
+    std::string tileData(tileDataLength, '\0');
+    stream.readBytes(&tileData[0], tileDataLength);
+
+    IMemoryStream tileStream(tileData.data(), tileData.size());
+    for_all([&](Tile& tile) { tile.load(tileStream); });
+
+    spiceIndex.reset(sizeX, sizeY);
+    for_all([&](const Tile& tile) { spiceIndex.spiceChanged(tile.location, 0, tile.getSpice()); });
+    placementTables.reset();
+    influenceMap.reset();
+
+    pathGraph.reset();
+    connectivity.reset();
+    flowFields.reset();
+    flowFields.load(stream);
+    pathCache.reset();
+    pathCache.load(stream);
+    pathRequests.load(stream);
+
+    objectIndex.reset(sizeX, sizeY);
+    targetChanges.reset(sizeX, sizeY);
+    for_all([&](const Tile& tile) {
+        for (auto objectID : tile.getInfantryList())
+            objectIndex.add(tile.location, objectID);
+        for (auto objectID : tile.getUndergroundUnitList())
+            objectIndex.add(tile.location, objectID);
+        for (auto objectID : tile.getNonInfantryGroundObjectList())
+            objectIndex.add(tile.location, objectID);
+    });
 }
 
 void Map::save(OutputStream& stream) const {
     stream.writeSint32(sizeX);
     stream.writeSint32(sizeY);
 
-    for (auto& tile : tiles)
-        tile.save(stream);
+    OMemoryStream tileStream;
+    tileStream.open();
+    for_all([&](const Tile& tile) { tile.save(tileStream); });
+
+    stream.writeUint32(tileStream.getDataLength());
+    stream.writeBytes(tileStream.getData(), tileStream.getDataLength());
+
+    flowFields.save(stream);
+    pathCache.save(stream);
+    pathRequests.save(stream);
 }
 
 void Map::init_tile_location() {
     for (auto i = 0; i < sizeX; ++i) {
         for (auto j = 0; j < sizeY; ++j) {
-            tiles[tile_index(i, j)].location = Coord(i, j);
+            const auto index = tile_index(i, j);
+            tiles[index].location = Coord(i, j);
+            tiles[index].bindPlanes(&tilePlanes, index);
         }
     }
 }
 
+void Map::updateTiles() {
+    activeTiles.erase(std::remove_if(activeTiles.begin(), activeTiles.end(), [](Tile* pTile) { return !pTile->update(); }),
+                      activeTiles.end());
+}
+
 void Map::createSandRegions() {
     std::stack<Tile*> tileQueue;
     std::vector<bool> visited(tiles.size());
 
-    for (auto& tile : tiles)
-        tile.setSandRegion(NONE_ID);
+    for_all([](Tile& tile) { tile.setSandRegion(NONE_ID); });
 
     Uint32 region = 0;
-    for (auto& tile : tiles) {
+    for_all([&](Tile& tile) {
         if (!tile.isRock() && !visited[tile_index(tile.location.x, tile.location.y)]) {
             tileQueue.push(&tile);
 
@@ -108,29 +175,186 @@ void Map::createSandRegions() {
             }
             region++;
         }
+    });
+
+    restoreSandwormPrey();
+}
+
+void Map::updateSandwormPrey(const UnitBase* pUnit) {
+    if(!pUnit->isAGroundUnit() || (pUnit->getItemID() == Unit_Sandworm)) {
+        return;
+    }
+
+    const Coord& location = pUnit->getLocation();
+    sandwormPreyIndex.setRegion(pUnit->getObjectID(), tileExists(location) ? getTile(location)->getSandRegion() : NONE_ID);
+}
+
+void Map::removeSandwormPrey(const UnitBase* pUnit) {
+    sandwormPreyIndex.setRegion(pUnit->getObjectID(), NONE_ID);
+}
+
+void Map::restoreSandwormPrey() {
+    sandwormPreyIndex.reset();
+
+    for(const UnitBase* pUnit : unitList) {
+        updateSandwormPrey(pUnit);
     }
 }
 
 void Map::damage(Uint32 damagerID, House* damagerOwner, const Coord& realPos, Uint32 bulletID, FixPoint damage, int damageRadius, bool air) {
     const auto location = Coord(realPos.x/TILESIZE, realPos.y/TILESIZE);
 
-    std::set<Uint32>    affectedAirUnits;
-    std::set<Uint32>    affectedGroundAndUndergroundUnits;
+    // damage() is reentrant (e.g. a destroyed devastator damages its surroundings), so every nesting level has its own buffers
+    if(damageCandidates.size() <= static_cast<size_t>(damageDepth)) {
+        damageCandidates.emplace_back();
+    }
+    DamageCandidates& candidates = damageCandidates[damageDepth];
+    damageDepth++;
+
+    // salvos hit the same tiles many times per cycle: the candidates of an impact tile are collected once and
+    // reused until an object is assigned to or unassigned from any tile
+    if(impactCandidateCacheGeneration != tileObjectsGeneration) {
+        impactCandidateCache.clear();
+        impactCandidateCacheGeneration = tileObjectsGeneration;
+    }
+
+    const Uint64 impactKey = (static_cast<Uint64>(static_cast<Uint32>(location.x)) << 32) | static_cast<Uint32>(location.y);
+    auto cacheIter = impactCandidateCache.find(impactKey);
+    if(cacheIter == impactCandidateCache.end()) {
+        cacheIter = impactCandidateCache.emplace(impactKey, DamageCandidates()).first;
 
-    for(auto i = location.x-2; i <= location.x+2; i++) {
-        for(auto j = location.y-2; j <= location.y+2; j++) {
-            const auto pTile = getTile_internal(i,j);
+        std::vector<Uint32>& cachedAirUnits = cacheIter->second.airUnits;
+        std::vector<Uint32>& cachedGroundAndUndergroundUnits = cacheIter->second.groundAndUndergroundUnits;
 
-            if (!pTile)
-                continue;
+        for(auto i = location.x-2; i <= location.x+2; i++) {
+            for(auto j = location.y-2; j <= location.y+2; j++) {
+                const auto pTile = getTile_internal(i,j);
+
+                if (!pTile)
+                    continue;
 
-            affectedAirUnits.insert(pTile->getAirUnitList().begin(), pTile->getAirUnitList().end());
-            affectedGroundAndUndergroundUnits.insert(pTile->getInfantryList().begin(), pTile->getInfantryList().end());
-            affectedGroundAndUndergroundUnits.insert(pTile->getUndergroundUnitList().begin(), pTile->getUndergroundUnitList().end());
-            affectedGroundAndUndergroundUnits.insert(pTile->getNonInfantryGroundObjectList().begin(), pTile->getNonInfantryGroundObjectList().end());
+                cachedAirUnits.insert(cachedAirUnits.end(), pTile->getAirUnitList().begin(), pTile->getAirUnitList().end());
+                cachedGroundAndUndergroundUnits.insert(cachedGroundAndUndergroundUnits.end(), pTile->getInfantryList().begin(), pTile->getInfantryList().end());
+                cachedGroundAndUndergroundUnits.insert(cachedGroundAndUndergroundUnits.end(), pTile->getUndergroundUnitList().begin(), pTile->getUndergroundUnitList().end());
+                cachedGroundAndUndergroundUnits.insert(cachedGroundAndUndergroundUnits.end(), pTile->getNonInfantryGroundObjectList().begin(), pTile->getNonInfantryGroundObjectList().end());
+            }
         }
+
+        // remove duplicates (structures cover several tiles); objects are damaged in the order of their IDs
+        std::sort(cachedAirUnits.begin(), cachedAirUnits.end());
+        cachedAirUnits.erase(std::unique(cachedAirUnits.begin(), cachedAirUnits.end()), cachedAirUnits.end());
+        std::sort(cachedGroundAndUndergroundUnits.begin(), cachedGroundAndUndergroundUnits.end());
+        cachedGroundAndUndergroundUnits.erase(std::unique(cachedGroundAndUndergroundUnits.begin(), cachedGroundAndUndergroundUnits.end()),
+                                              cachedGroundAndUndergroundUnits.end());
     }
 
+    // copy into the buffer of this nesting level as damaging objects may change the tiles and thereby clear the cache
+    std::vector<Uint32>& affectedAirUnits = candidates.airUnits;
+    std::vector<Uint32>& affectedGroundAndUndergroundUnits = candidates.groundAndUndergroundUnits;
+    affectedAirUnits.assign(cacheIter->second.airUnits.begin(), cacheIter->second.airUnits.end());
+    affectedGroundAndUndergroundUnits.assign(cacheIter->second.groundAndUndergroundUnits.begin(), cacheIter->second.groundAndUndergroundUnits.end());
+    COUNT_SIMULATION_EVENT(SimulationCounter_DamageCandidates, affectedAirUnits.size() + affectedGroundAndUndergroundUnits.size(),
+                           (damagerOwner != nullptr) ? damagerOwner->getHouseID() : HOUSE_INVALID);
+
+    applyDamage(candidates, damagerID, damagerOwner, realPos, bulletID, damage, damageRadius, air);
+
+    damageDepth--;
+}
+
+void Map::damageLine(Uint32 damagerID, House* damagerOwner, const Coord& from, const Coord& to, Uint32 bulletID, FixPoint damage, int damageRadius, bool air) {
+    const auto fromLocation = Coord(from.x/TILESIZE, from.y/TILESIZE);
+    const auto toLocation = Coord(to.x/TILESIZE, to.y/TILESIZE);
+
+    if(damageCandidates.size() <= static_cast<size_t>(damageDepth)) {
+        damageCandidates.emplace_back();
+    }
+    DamageCandidates& candidates = damageCandidates[damageDepth];
+    damageDepth++;
+
+    std::vector<Uint32>& affectedAirUnits = candidates.airUnits;
+    std::vector<Uint32>& affectedGroundAndUndergroundUnits = candidates.groundAndUndergroundUnits;
+    affectedAirUnits.clear();
+    affectedGroundAndUndergroundUnits.clear();
+
+    // the tiles within two tiles of the rasterized line are collected once; the bitmask over their bounding box
+    // makes sure overlapping neighbourhoods of consecutive line tiles are only visited once
+    const auto minX = std::min(fromLocation.x, toLocation.x) - 2;
+    const auto minY = std::min(fromLocation.y, toLocation.y) - 2;
+    const auto boxWidth = std::abs(toLocation.x - fromLocation.x) + 5;
+    const auto boxHeight = std::abs(toLocation.y - fromLocation.y) + 5;
+    lineTileVisited.assign(boxWidth*boxHeight, false);
+
+    const auto stepX = (toLocation.x > fromLocation.x) ? 1 : -1;
+    const auto stepY = (toLocation.y > fromLocation.y) ? 1 : -1;
+    const auto deltaX = std::abs(toLocation.x - fromLocation.x);
+    const auto deltaY = -std::abs(toLocation.y - fromLocation.y);
+    auto error = deltaX + deltaY;
+    auto lineTile = fromLocation;
+    while(true) {
+        for(auto i = lineTile.x-2; i <= lineTile.x+2; i++) {
+            for(auto j = lineTile.y-2; j <= lineTile.y+2; j++) {
+                const auto bit = (j - minY)*boxWidth + (i - minX);
+                if(lineTileVisited[bit]) {
+                    continue;
+                }
+                lineTileVisited[bit] = true;
+
+                const auto pTile = getTile_internal(i,j);
+
+                if (!pTile)
+                    continue;
+
+                affectedAirUnits.insert(affectedAirUnits.end(), pTile->getAirUnitList().begin(), pTile->getAirUnitList().end());
+                affectedGroundAndUndergroundUnits.insert(affectedGroundAndUndergroundUnits.end(), pTile->getInfantryList().begin(), pTile->getInfantryList().end());
+                affectedGroundAndUndergroundUnits.insert(affectedGroundAndUndergroundUnits.end(), pTile->getUndergroundUnitList().begin(), pTile->getUndergroundUnitList().end());
+                affectedGroundAndUndergroundUnits.insert(affectedGroundAndUndergroundUnits.end(), pTile->getNonInfantryGroundObjectList().begin(), pTile->getNonInfantryGroundObjectList().end());
+            }
+        }
+
+        if(lineTile == toLocation) {
+            break;
+        }
+
+        // bresenham step on the tile grid
+        const auto doubledError = 2*error;
+        if(doubledError >= deltaY) {
+            error += deltaY;
+            lineTile.x += stepX;
+        }
+        if(doubledError <= deltaX) {
+            error += deltaX;
+            lineTile.y += stepY;
+        }
+    }
+
+    std::sort(affectedAirUnits.begin(), affectedAirUnits.end());
+    affectedAirUnits.erase(std::unique(affectedAirUnits.begin(), affectedAirUnits.end()), affectedAirUnits.end());
+    std::sort(affectedGroundAndUndergroundUnits.begin(), affectedGroundAndUndergroundUnits.end());
+    affectedGroundAndUndergroundUnits.erase(std::unique(affectedGroundAndUndergroundUnits.begin(), affectedGroundAndUndergroundUnits.end()),
+                                            affectedGroundAndUndergroundUnits.end());
+    COUNT_SIMULATION_EVENT(SimulationCounter_DamageCandidates, affectedAirUnits.size() + affectedGroundAndUndergroundUnits.size(),
+                           (damagerOwner != nullptr) ? damagerOwner->getHouseID() : HOUSE_INVALID);
+
+    // the candidates are a superset of the candidates of each single impact and applyDamage() filters them by the
+    // exact impact position, so damaging both ends from the shared list gives the same result as two damage() calls
+    const auto gatheredGeneration = tileObjectsGeneration;
+    applyDamage(candidates, damagerID, damagerOwner, from, bulletID, damage, damageRadius, air);
+
+    if(tileObjectsGeneration == gatheredGeneration) {
+        applyDamage(candidates, damagerID, damagerOwner, to, bulletID, damage, damageRadius, air);
+        damageDepth--;
+    } else {
+        // the first impact destroyed or spawned objects => collect the candidates of the second impact anew
+        damageDepth--;
+        Map::damage(damagerID, damagerOwner, to, bulletID, damage, damageRadius, air);
+    }
+}
+
+void Map::applyDamage(const DamageCandidates& candidates, Uint32 damagerID, House* damagerOwner, const Coord& realPos, Uint32 bulletID, FixPoint damage, int damageRadius, bool air) {
+    const auto location = Coord(realPos.x/TILESIZE, realPos.y/TILESIZE);
+    const std::vector<Uint32>& affectedAirUnits = candidates.airUnits;
+    const std::vector<Uint32>& affectedGroundAndUndergroundUnits = candidates.groundAndUndergroundUnits;
+
     if(bulletID == Bullet_Sandworm) {
         for(auto objectID : affectedGroundAndUndergroundUnits) {
             auto pObject = currentGame->getObjectManager().getObject(objectID);
@@ -267,62 +491,44 @@ bool Map::isAStructureGap(int x, int y, int buildingSizeX, int buildingSizeY) co
     }
 
     const auto xMin = x - 1;
-    const auto xMax = x + buildingSizeX + 1;
     const auto yMin = y - 1;
-    const auto yMax = y + buildingSizeY + 1;
-
-    for(auto i = xMin; i < xMax; i++) {
-        for(auto j = yMin; j < yMax; j++) {
-            if(!((i == xMin || i == xMax) && (j == yMin || j == yMax))) { //Corners are ok as units can get through
-
-                const auto pTile = getTile_internal(i,j);
-
-                if(pTile && (pTile->hasAStructure() && !pTile->isConcrete())) { // I need some more conditions to make it ignore units
 
-                    return false;
-                }
-            }
-        }
-    }
+    // only the top left corner is ok as units can get through
+    auto numStructures = placementTables.countStructures(xMin, yMin, buildingSizeX + 2, buildingSizeY + 2);
+    numStructures -= placementTables.countStructures(xMin, yMin, 1, 1);
 
-    return true;
+    return numStructures == 0;
 }
 
 bool Map::okayToPlaceStructure(int x, int y, int buildingSizeX, int buildingSizeY, bool tilesRequired, const House* pHouse, bool bIgnoreUnits) const {
-    bool withinBuildRange = false;
-
-    for(auto i = x; i < x + buildingSizeX; i++) {
-        for(auto j = y; j < y + buildingSizeY; j++) {
+    if((buildingSizeX <= 0) || (buildingSizeY <= 0)
+        || (x < 0) || (y < 0) || (x + buildingSizeX > sizeX) || (y + buildingSizeY > sizeY)) {
+        return false;
+    }
 
-            const auto pTile = getTile_internal(i,j);
+    const auto area = buildingSizeX * buildingSizeY;
 
-            if (!pTile)
-                return false;
+    if(placementTables.countRock(x, y, buildingSizeX, buildingSizeY) != area) {
+        return false;
+    }
 
-            if(!pTile->isRock() || (tilesRequired && !pTile->isConcrete()) || (!bIgnoreUnits && pTile->isBlocked())) {
-                return false;
-            }
+    if(tilesRequired && (placementTables.countSlab(x, y, buildingSizeX, buildingSizeY) != area)) {
+        return false;
+    }
 
-            if((pHouse == nullptr) || isWithinBuildRange(i, j, pHouse)) {
-                withinBuildRange = true;
-            }
-        }
+    if(!bIgnoreUnits && (placementTables.countBlocked(x, y, buildingSizeX, buildingSizeY) != 0)) {
+        return false;
     }
-    return withinBuildRange;
+
+    // some tile of the structure has to be within build range of a tile owned by pHouse
+    return (pHouse == nullptr)
+            || (placementTables.countOwnedBy(pHouse->getHouseID(), x - BUILDRANGE, y - BUILDRANGE,
+                                             buildingSizeX + 2*BUILDRANGE, buildingSizeY + 2*BUILDRANGE) > 0);
 }
 
 
 bool Map::isWithinBuildRange(int x, int y, const House* pHouse) const {
-    for (auto i = x - BUILDRANGE; i <= x + BUILDRANGE; i++) {
-        for (auto j = y - BUILDRANGE; j <= y + BUILDRANGE; j++) {
-            const auto tile = getTile_internal(i, j);
-
-            if (tile && tile->getOwner() == pHouse->getHouseID())
-                return true;
-        }
-    }
-
-    return false;
+    return placementTables.countOwnedBy(pHouse->getHouseID(), x - BUILDRANGE, y - BUILDRANGE, 2*BUILDRANGE + 1, 2*BUILDRANGE + 1) > 0;
 }
 
 /**
@@ -379,88 +585,91 @@ Coord Map::getMapPos(int angle, const Coord& source) {
     }
 }
 
-//building size is num squares
+/**
+    Finds a free tile next to origin to deploy pUnit to. The rings around origin (or around the building at origin) are
+    searched outwards; every tile of a ring is tested exactly once and the innermost ring with a free tile wins.
+    \param pUnit           the unit to deploy
+    \param origin          the tile (or the top left tile of the building) to deploy around
+    \param randomGen       the random generator used to choose among the equally good tiles
+    \param gatherPoint     if valid the free tile closest to this tile is chosen, otherwise a random free tile
+    \param buildingSize    the number of tiles occupied by the building (e.g. 3x2 for refinery) or 0x0
+    \return the tile to deploy to or an invalid coordinate if the map is full
+*/
 Coord Map::findDeploySpot(UnitBase* pUnit, const Coord& origin, Random& randomGen, const Coord& gatherPoint, const Coord& buildingSize) const {
-    auto closestDistance = FixPt_MAX;
-    Coord       closestPoint;
-    Coord       size;
-
-    auto found = false;
-    auto foundClosest = false;
-
-    auto counter = 0;
-    auto depth = 0;
-
     if(pUnit->isAFlyingUnit()) {
         return origin;
     }
 
-    auto ranX = origin.x;
-    auto ranY = origin.y;
-
-    do {
-        const auto edge = randomGen.rand(0, 3);
-        switch(edge) {
-            case 0: //right edge
-                ranX = origin.x + buildingSize.x + depth;
-                ranY = randomGen.rand(origin.y - depth, origin.y + buildingSize.y + depth);
-                break;
-            case 1: //top edge
-                ranX = randomGen.rand(origin.x - depth, origin.x + buildingSize.x + depth);
-                ranY = origin.y - depth - ((buildingSize.y == 0) ? 0 : 1);
-                break;
-            case 2: //left edge
-                ranX = origin.x - depth - ((buildingSize.x == 0) ? 0 : 1);
-                ranY = randomGen.rand(origin.y - depth, origin.y + buildingSize.y + depth);
-                break;
-            case 3: //bottom edge
-                ranX = randomGen.rand(origin.x - depth, origin.x + buildingSize.x + depth);
-                ranY = origin.y + buildingSize.y + depth;
-                break;
-            default:
-                break;
-        }
-
-        auto bOK2Deploy = pUnit->canPass(ranX, ranY);
-
-        if (bOK2Deploy && pUnit->isTracked()) {
-            const auto tile = getTile_internal(ranX, ranY);
-
-            if (tile && tile->hasInfantry()) {
-                // we do not deploy on enemy infantry
-                bOK2Deploy = false;
-            }
+    std::vector<Coord> freeTiles;
+
+    const auto addIfFree = [&](int x, int y) {
+        if(!tileExists(x, y) || !pUnit->canPass(x, y)) {
+            return;
         }
 
-        if(bOK2Deploy) {
-            if(gatherPoint.isInvalid()) {
-                closestPoint.x = ranX;
-                closestPoint.y = ranY;
-                found = true;
-            } else {
-                const auto temp = Coord(ranX, ranY);
-                if(blockDistance(temp, gatherPoint) < closestDistance) {
-                    closestDistance = blockDistance(temp, gatherPoint);
-                    closestPoint.x = ranX;
-                    closestPoint.y = ranY;
-                    foundClosest = true;
+        if(pUnit->isTracked() && getTile_internal(x, y)->hasInfantry()) {
+            // we do not deploy on enemy infantry
+            return;
+        }
+
+        freeTiles.emplace_back(x, y);
+    };
+
+    const auto maxDepth = std::max(getSizeX(), getSizeY());
+    for(auto depth = 0; depth <= maxDepth; depth++) {
+        freeTiles.clear();
+
+        const auto left = origin.x - depth - ((buildingSize.x == 0) ? 0 : 1);
+        const auto right = origin.x + buildingSize.x + depth;
+        const auto top = origin.y - depth - ((buildingSize.y == 0) ? 0 : 1);
+        const auto bottom = origin.y + buildingSize.y + depth;
+
+        // walk the edges of the ring (clipped to the map) in a fixed order; edges that collapse into one line are only visited once
+        for(auto x = std::max(origin.x - depth, 0); x <= std::min(right, getSizeX() - 1); x++) {
+            addIfFree(x, top);
+            if(bottom != top) {
+                addIfFree(x, bottom);
+            }
+        }
+        for(auto y = std::max(origin.y - depth, 0); y <= std::min(bottom, getSizeY() - 1); y++) {
+            if(y != top && y != bottom) {
+                addIfFree(right, y);
+                if(left != right) {
+                    addIfFree(left, y);
                 }
             }
         }
+        if(left < origin.x - depth) {
+            // the left edge of the ring around a building reaches down to the bottom edge
+            addIfFree(left, bottom);
+        }
 
-        if(counter++ >= 100) {
-            //if hasn't found a spot on tempObject layer in 100 tries, goto next
+        if(freeTiles.empty()) {
+            continue;
+        }
 
-            counter = 0;
-            if(++depth > (std::max(currentGameMap->getSizeX(), currentGameMap->getSizeY()))) {
-                closestPoint.invalidate();
-                found = true;
-                SDL_Log("Warning: Cannot find deploy position because the map is full!");
+        if(gatherPoint.isValid()) {
+            // keep only the tiles closest to the gather point
+            auto closestDistance = FixPt_MAX;
+            auto numClosest = 0;
+            for(const auto& freeTile : freeTiles) {
+                const auto distance = blockDistance(freeTile, gatherPoint);
+                if(distance < closestDistance) {
+                    closestDistance = distance;
+                    numClosest = 0;
+                }
+                if(distance == closestDistance) {
+                    freeTiles[numClosest++] = freeTile;
+                }
             }
+            freeTiles.resize(numClosest);
         }
-    } while (!found && (!foundClosest || (counter > 0)));
 
-    return closestPoint;
+        return freeTiles[(freeTiles.size() == 1) ? 0 : randomGen.rand(0, static_cast<int>(freeTiles.size()) - 1)];
+    }
+
+    SDL_Log("Warning: Cannot find deploy position because the map is full!");
+    return Coord::Invalid();
 }
 
 /**
@@ -502,6 +711,8 @@ Coord Map::findClosestEdgePoint(const Coord& origin, const Coord& buildingSize)
 void Map::removeObjectFromMap(Uint32 objectID) {
     for (auto& tile : tiles)
         tile.unassignObject(objectID);
+
+    visibility.removeSource(objectID, currentGame->getGameCycleCount());
 }
 
 void Map::selectObjects(const House* pHouse, int x1, int y1, int x2, int y2, int realX, int realY, bool objectARGMode) {
@@ -530,14 +741,31 @@ void Map::selectObjects(const House* pHouse, int x1, int y1, int x2, int y2, int
 
         if((lastCheckedObject != nullptr) && (lastCheckedObject->getOwner() == pHouse)) {
             if((lastCheckedObject == lastSinglySelectedObject) && ( !lastCheckedObject->isAStructure())) {
-                for(auto i = screenborder->getTopLeftTile().x; i <= screenborder->getBottomRightTile().x; i++) {
-                    for(auto j = screenborder->getTopLeftTile().y; j <= screenborder->getBottomRightTile().y; j++) {
-                        const auto tile = getTile_internal(i, j);
+                // only look at the units of this type instead of all tiles on the screen
+                const Coord topLeft = screenborder->getTopLeftTile();
+                const Coord bottomRight = screenborder->getBottomRightTile();
+                bool bSelectionChanged = false;
+                for(UnitBase* pUnit : unitListByItemID[lastSinglySelectedObject->getItemID()]) {
+                    const Coord& unitLocation = pUnit->getLocation();
+                    if((pUnit->getOwner() != pHouse) || pUnit->isSelected()
+                        || (unitLocation.x < topLeft.x) || (unitLocation.x > bottomRight.x) || (unitLocation.y < topLeft.y) || (unitLocation.y > bottomRight.y)) {
+                        continue;
+                    }
 
-                        if (tile && tile->hasAnObject()) {
-                            tile->selectAllPlayersUnitsOfType(pHouse->getHouseID(), lastSinglySelectedObject->getItemID(), &lastCheckedObject, &lastSelectedObject);
-                        }
+                    // units inside carryalls or structures keep their last location but are not on the map
+                    const auto tile = getTile_internal(unitLocation.x, unitLocation.y);
+                    if((tile == nullptr) || !tile->hasObjectID(pUnit->getObjectID())) {
+                        continue;
                     }
+
+                    pUnit->setSelected(true);
+                    currentGame->getSelectedList().insert(pUnit->getObjectID());
+                    bSelectionChanged = true;
+                    lastCheckedObject = pUnit;
+                    lastSelectedObject = pUnit;
+                }
+                if(bSelectionChanged) {
+                    currentGame->selectionChanged();
                 }
                 lastSinglySelectedObject = nullptr;
 
@@ -594,36 +822,48 @@ bool Map::findSpice(Coord& destination, const Coord& origin) const {
         return true;
     }
 
-    auto counter = 0;
-    auto depth = 1;
-
-    while(true) {
-        auto ranX = 0;
-        auto ranY = 0;
-        do {
-            ranX = currentGame->randomGen.rand(origin.x-depth, origin.x + depth);
-            ranY = currentGame->randomGen.rand(origin.y-depth, origin.y + depth);
-        } while(((ranX >= (origin.x+1 - depth)) && (ranX < (origin.x + depth))) && ((ranY >= (origin.y+1 - depth)) && (ranY < (origin.y + depth))));
+    // search the chunks of the spice index in rings around the chunk of origin and skip all chunks without spice
+    const auto originChunkX = std::min(std::max(origin.x, 0), sizeX - 1) / SPICEINDEX_CHUNKSIZE;
+    const auto originChunkY = std::min(std::max(origin.y, 0), sizeY - 1) / SPICEINDEX_CHUNKSIZE;
+    const auto maxRing = std::max(spiceIndex.getNumChunksX(), spiceIndex.getNumChunksY());
 
-        const auto tile = getTile_internal(ranX, ranY);
+    auto bFound = false;
+    auto closestDistance = FixPt_MAX;
 
-        if (tile && !tile->hasAGroundObject() && tile->hasSpice()) {
-            destination.x = ranX;
-            destination.y = ranY;
-            return true;
+    for(auto ring = 0; ring <= maxRing; ring++) {
+        if(bFound && (ring - 1) * SPICEINDEX_CHUNKSIZE + 1 > closestDistance) {
+            // no tile of this ring can be closer
+            break;
         }
 
-        counter++;
-        if(counter >= 100) {
-            //if hasn't found a spot on tempObject layer in 100 tries, goto next
-            counter = 0;
-            depth++;
-        }
+        for(auto chunkX = originChunkX - ring; chunkX <= originChunkX + ring; chunkX++) {
+            const auto step = ((chunkX == originChunkX - ring) || (chunkX == originChunkX + ring)) ? 1 : std::max(1, 2*ring);
+            for(auto chunkY = originChunkY - ring; chunkY <= originChunkY + ring; chunkY += step) {
+                if((chunkX < 0) || (chunkX >= spiceIndex.getNumChunksX()) || (chunkY < 0) || (chunkY >= spiceIndex.getNumChunksY())
+                    || (spiceIndex.getNumSpiceTiles(chunkX, chunkY) == 0)) {
+                    continue;
+                }
 
-        if(depth > std::max(sizeX, sizeY)) {
-            return false;   //there is possibly no spice left anywhere on map
+                const auto x2 = std::min(sizeX, (chunkX + 1) * SPICEINDEX_CHUNKSIZE);
+                const auto y2 = std::min(sizeY, (chunkY + 1) * SPICEINDEX_CHUNKSIZE);
+                for(auto x = chunkX * SPICEINDEX_CHUNKSIZE; x < x2; x++) {
+                    for(auto y = chunkY * SPICEINDEX_CHUNKSIZE; y < y2; y++) {
+                        const auto& tile = tiles[tile_index(x, y)];
+                        if(tile.hasSpice() && !tile.hasAGroundObject()) {
+                            const auto distance = blockDistance(origin, tile.location);
+                            if(distance < closestDistance) {
+                                closestDistance = distance;
+                                destination = tile.location;
+                                bFound = true;
+                            }
+                        }
+                    }
+                }
+            }
         }
     }
+
+    return bFound;   // if not found there is no spice left anywhere on map
 }
 
 /**
@@ -666,29 +906,100 @@ void Map::viewMap(int houseID, const Coord& location, const int maxViewRange) {
 //                  *****
 //                    *
 
+    if(maxViewRange < 0) {
+        return;
+    }
+
     const auto cycle_count = currentGame->getGameCycleCount();
 
-    const auto startY = std::max(0, location.y - maxViewRange);
-    const auto endY = std::min(sizeY-1, location.y + maxViewRange);
-    const auto startX = std::max(0, location.x - maxViewRange);
-    const auto endX = std::min(sizeX - 1, location.x + maxViewRange);
+    noteTargetsChanged(location, maxViewRange);
 
-    Coord coord;
+    for(const auto& offset : visibility.getCircleMask(maxViewRange)) {
+        const auto coord = location + offset;
+        if(tileExists(coord)) {
+            tilePlanes.view(tile_index(coord.x, coord.y), houseID, cycle_count);
+        }
+    }
+}
 
-    for (coord.x = startX; coord.x <= endX; coord.x++) {
-        for(coord.y = startY; coord.y <= endY; coord.y++) {
-            const auto distance = maxViewRange <= 1 ? maximumDistance(location, coord) : blockDistanceApprox(location, coord);
-            if(distance > maxViewRange) {
-                continue;
-            }
+void Map::updateVisionSource(const ObjectBase* pObject, const Coord& location) {
+    // sandworms move underground and do not reveal the map
+    if(!tileExists(location) || (pObject->getItemID() == Unit_Sandworm)) {
+        return;
+    }
 
-            const auto tile = getTile_internal(coord.x, coord.y);
+    visibility.setSource(pObject->getObjectID(), pObject->getOwner()->getHouseID(), location, pObject->getViewRange(), currentGame->getGameCycleCount());
 
-            if (!tile) {
-                continue;
+    // the tiles coming into sight may reveal new targets
+    noteTargetsChanged(location, pObject->getViewRange());
+}
+
+void Map::noteTargetsChanged(const Coord& location, int range) {
+    targetChanges.noteChange(location, range, currentGame->getGameCycleCount());
+}
+
+void Map::restoreVisionSources() {
+    const auto& objectManager = currentGame->getObjectManager();
+
+    for_all([&](const Tile& tile) {
+        for (auto objectID : tile.getInfantryList()) {
+            const auto pObject = objectManager.getObject(objectID);
+            if ((pObject != nullptr) && (pObject->getLocation() == tile.location)) {
+                updateVisionSource(pObject, tile.location);
             }
+        }
+
+        for (auto objectID : tile.getNonInfantryGroundObjectList()) {
+            const auto pObject = objectManager.getObject(objectID);
+            if ((pObject != nullptr) && (pObject->getLocation() == tile.location)) {
+                updateVisionSource(pObject, tile.location);
+            }
+        }
+    });
+}
+
+void Map::restartTargetScans(const ObjectBase* pObject, const Coord& oldLocation) {
+    const Coord& location = pObject->getLocation();
+    if(!tileExists(location)) {
+        return;
+    }
 
-            tile->setExplored(houseID, cycle_count);
+    // sight counts are simulation state; fog (and the debug mode) is only for drawing
+    const Tile* pNewTile = getTile(location);
+    const Tile* pOldTile = tileExists(oldLocation) ? getTile(oldLocation) : nullptr;
+    const int teamID = pObject->getOwner()->getTeamID();
+
+    int sightingHouses = 0;
+    for(int h = 0; h < NUM_HOUSES; h++) {
+        const House* pHouse = currentGame->getHouse(h);
+        if((pHouse != nullptr) && (pHouse->getTeamID() != teamID)
+            && pNewTile->isInSightOfHouse(h) && ((pOldTile == nullptr) || !pOldTile->isInSightOfHouse(h))) {
+            sightingHouses |= (1 << h);
+        }
+    }
+
+    if(sightingHouses == 0) {
+        return;
+    }
+
+    const auto& objectManager = currentGame->getObjectManager();
+    const auto restartScan = [&](Uint32 objectID) {
+        ObjectBase* pCandidate = objectManager.getObject(objectID);
+        if((pCandidate != nullptr) && (sightingHouses & (1 << pCandidate->getOwner()->getHouseID()))) {
+            pCandidate->restartTargetScan();
+        }
+    };
+
+    Coord pos;
+    for(pos.x = std::max(0, location.x - TARGETSCAN_SIGHTING_RANGE); pos.x <= std::min(sizeX - 1, location.x + TARGETSCAN_SIGHTING_RANGE); pos.x++) {
+        for(pos.y = std::max(0, location.y - TARGETSCAN_SIGHTING_RANGE); pos.y <= std::min(sizeY - 1, location.y + TARGETSCAN_SIGHTING_RANGE); pos.y++) {
+            const Tile* pTile = getTile(pos);
+            for(Uint32 objectID : pTile->getNonInfantryGroundObjectList()) {
+                restartScan(objectID);
+            }
+            for(Uint32 objectID : pTile->getInfantryList()) {
+                restartScan(objectID);
+            }
         }
     }
 }
@@ -31,7 +31,6 @@
 #include <misc/draw_util.h>
 #include <misc/format.h>
 
-#include <INIMap/INIMapPreviewCreator.h>
 
 #include <globals.h>
 
@@ -170,6 +169,14 @@ bool LoadMapWindow::handleKeyPress(SDL_KeyboardEvent& key) {
 }
 
 
+void LoadMapWindow::draw(Point position) {
+    if(!pendingPreviewFilename.empty()) {
+        showMapPreview();
+    }
+
+    Window::draw(position);
+}
+
 void LoadMapWindow::onChildWindowClose(Window* pChildWindow) {
     QstBox* pQstBox = dynamic_cast<QstBox*>(pChildWindow);
     if(pQstBox != nullptr) {
@@ -235,6 +242,9 @@ void LoadMapWindow::onMapTypeChange(int buttonID)
         } break;
     }
 
+    mapPreviewCache.setDirectory(currentMapDirectory);
+    pendingPreviewFilename.clear();
+
     mapList.clearAllEntries();
 
     for(const std::string& filename : getFileNamesList(currentMapDirectory, "ini", true, FileListOrder_Name_CaseInsensitive_Asc)) {
@@ -263,79 +273,42 @@ void LoadMapWindow::onMapListSelectionChange(bool bInteractive)
     std::string mapFilename = currentMapDirectory + mapList.getSelectedEntry() + ".ini";
     getCaseInsensitiveFilename(mapFilename);
 
-    INIFile inimap(mapFilename);
-
-    int sizeX = 0;
-    int sizeY = 0;
-
-    if(inimap.hasKey("MAP","Seed")) {
-        // old map format with seed value
-        int mapscale = inimap.getIntValue("BASIC", "MapScale", -1);
+    pendingPreviewFilename = mapFilename;
+    showMapPreview();
+}
 
-        switch(mapscale) {
-            case 0: {
-                sizeX = 62;
-                sizeY = 62;
-            } break;
+void LoadMapWindow::showMapPreview()
+{
+    const MapPreview* pPreview = mapPreviewCache.getPreview(pendingPreviewFilename);
+    if(pPreview == nullptr) {
+        // the preview is shown as soon as the background thread is done with it
+        minimap.setSurface( GUIStyle::getInstance().createButtonSurface(130,130,_("Loading..."), true, false) );
+        mapPropertySize.setText("");
+        mapPropertyPlayers.setText("");
+        mapPropertyAuthors.setText("");
+        mapPropertyLicense.setText("");
+        requestRedraw(50);
+        return;
+    }
 
-            case 1: {
-                sizeX = 32;
-                sizeY = 32;
-            } break;
+    pendingPreviewFilename.clear();
 
-            case 2: {
-                sizeX = 21;
-                sizeY = 21;
-            } break;
+    mapPropertySize.setText(std::to_string(pPreview->sizeX) + " x " + std::to_string(pPreview->sizeY));
 
-            default: {
-                sizeX = 64;
-                sizeY = 64;
-            }
-        }
+    if(pPreview->pMinimap) {
+        minimap.setSurface(pPreview->pMinimap.get());
     } else {
-        // new map format with saved map
-        sizeX = inimap.getIntValue("MAP","SizeX", 0);
-        sizeY = inimap.getIntValue("MAP","SizeY", 0);
-    }
-
-    mapPropertySize.setText(std::to_string(sizeX) + " x " + std::to_string(sizeY));
-
-    sdl2::surface_ptr pMapSurface;
-    try {
-        INIMapPreviewCreator mapPreviewCreator(&inimap);
-        pMapSurface = mapPreviewCreator.createMinimapImageOfMap(1, DuneStyle::buttonBorderColor);
-    } catch(...) {
-        pMapSurface = sdl2::surface_ptr { GUIStyle::getInstance().createButtonSurface(130, 130, "Error", true, false) };
+        minimap.setSurface( GUIStyle::getInstance().createButtonSurface(130, 130, "Error", true, false) );
         loadButton.setEnabled(false);
     }
-    minimap.setSurface(std::move(pMapSurface));
-
-    int numPlayers = 0;
-    if(inimap.hasSection("Atreides")) numPlayers++;
-    if(inimap.hasSection("Ordos")) numPlayers++;
-    if(inimap.hasSection("Harkonnen")) numPlayers++;
-    if(inimap.hasSection("Fremen")) numPlayers++;
-    if(inimap.hasSection("Mercenary")) numPlayers++;
-    if(inimap.hasSection("Sardaukar")) numPlayers++;
-    if(inimap.hasSection("Player1")) numPlayers++;
-    if(inimap.hasSection("Player2")) numPlayers++;
-    if(inimap.hasSection("Player3")) numPlayers++;
-    if(inimap.hasSection("Player4")) numPlayers++;
-    if(inimap.hasSection("Player5")) numPlayers++;
-    if(inimap.hasSection("Player6")) numPlayers++;
-
-    mapPropertyPlayers.setText(std::to_string(numPlayers));
 
+    mapPropertyPlayers.setText(std::to_string(pPreview->numPlayers));
 
-
-    std::string authors = inimap.getStringValue("BASIC","Author", "-");
+    std::string authors = pPreview->author;
     if(authors.size() > 11) {
         authors = authors.substr(0,9) + "...";
     }
     mapPropertyAuthors.setText(authors);
 
-
-    mapPropertyLicense.setText(inimap.getStringValue("BASIC","License", "-"));
-
+    mapPropertyLicense.setText(pPreview->license);
 }
@@ -23,12 +23,14 @@
 #include <FileClasses/GFXManager.h>
 #include <FileClasses/TextManager.h>
 #include <FileClasses/INIFile.h>
-#include <FileClasses/LoadSavePNG.h>
 
 #include <structures/Wall.h>
 
 #include <misc/FileSystem.h>
 #include <misc/draw_util.h>
+#include <misc/ScreenshotWriter.h>
+#include <misc/FramePacer.h>
+#include <misc/event_util.h>
 #include <misc/format.h>
 
 #include <globals.h>
@@ -118,18 +120,14 @@ void MapEditor::setMirrorMode(MirrorMode newMirrorMode) {
 }
 
 void MapEditor::RunEditor() {
-    while(!bQuitEditor) {
-
-        int frameStart = SDL_GetTicks();
+    FramePacer framePacer;
 
+    while(!bQuitEditor) {
         processInput();
         drawScreen();
 
-        int frameTime = SDL_GetTicks() - frameStart;
         if(settings.video.frameLimit == true) {
-            if(frameTime < 32) {
-                SDL_Delay(32 - frameTime);
-            }
+            framePacer.waitForNextFrame();
         }
     }
 }
@@ -149,16 +147,12 @@ void MapEditor::setMap(const MapData& mapdata, const MapInfo& newMapInfo) {
         pInterface->deselectAll();
     }
 
-    while(!redoOperationStack.empty()) {
-        redoOperationStack.pop();
-    }
-
-    while(!undoOperationStack.empty()) {
-        undoOperationStack.pop();
-    }
+    clearRedoOperations();
+    clearUndoHistory();
 
     // reset other map properties
     loadedINIFile.reset();
+    loadedINIFileContent.clear();
     lastSaveName = "";
 
     spiceBlooms.clear();
@@ -206,7 +200,9 @@ void MapEditor::setMap(const MapData& mapdata, const MapInfo& newMapInfo) {
 
     currentEditorMode = EditorMode();
 
+    markAllTilesChanged();
     bChangedSinceLastSave = true;
+    editCount++;
 }
 
 bool MapEditor::isTileBlocked(int x, int y, bool bSlabIsBlocking, bool bUnitsAreBlocking) const {
@@ -299,41 +295,131 @@ void MapEditor::setEditorMode(const EditorMode& newEditorMode) {
 }
 
 void MapEditor::startOperation() {
-    if(undoOperationStack.empty() || !dynamic_cast<MapEditorStartOperation*>( undoOperationStack.top().get() )) {
+    finishTerrainStroke();
+
+    if(undoOperationStack.empty() || !dynamic_cast<MapEditorStartOperation*>( undoOperationStack.back().get() )) {
         addUndoOperation(std::make_unique<MapEditorStartOperation>());
     }
 }
 
 void MapEditor::undoLastOperation() {
+    finishTerrainStroke();
+
     if(!undoOperationStack.empty()) {
         redoOperationStack.push(std::make_unique<MapEditorStartOperation>());
 
-        while((!undoOperationStack.empty()) && !dynamic_cast<MapEditorStartOperation*>( undoOperationStack.top().get() )) {
-            redoOperationStack.push(undoOperationStack.top()->perform(this));
-            undoOperationStack.pop();
+        while((!undoOperationStack.empty()) && !dynamic_cast<MapEditorStartOperation*>( undoOperationStack.back().get() )) {
+            redoOperationStack.push(popUndoOperation()->perform(this));
         }
 
         if(!undoOperationStack.empty()) {
-            undoOperationStack.pop();
+            popUndoOperation();
         }
+
+        editCount++;
     }
 }
 
 void MapEditor::redoLastOperation() {
+    finishTerrainStroke();
+
     if(!redoOperationStack.empty()) {
-        undoOperationStack.push(std::make_unique<MapEditorStartOperation>());
+        pushUndoOperation(std::make_unique<MapEditorStartOperation>());
 
         while((!redoOperationStack.empty()) && !dynamic_cast<MapEditorStartOperation*>( redoOperationStack.top().get() )) {
-            undoOperationStack.push(redoOperationStack.top()->perform(this));
+            pushUndoOperation(redoOperationStack.top()->perform(this));
             redoOperationStack.pop();
         }
 
         if(!redoOperationStack.empty()) {
             redoOperationStack.pop();
         }
+
+        editCount++;
     }
 }
 
+void MapEditor::finishTerrainStroke() {
+    if(strokeOldTerrain.empty()) {
+        return;
+    }
+
+    std::vector<std::pair<Uint32, TERRAINTYPE>> changedTiles(strokeOldTerrain.begin(), strokeOldTerrain.end());
+    strokeOldTerrain.clear();
+    std::sort(changedTiles.begin(), changedTiles.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<MapEditorTerrainStrokeOperation::Run> runs;
+    std::vector<Uint8> terrainTypes;
+    terrainTypes.reserve(changedTiles.size());
+    for(const auto& changedTile : changedTiles) {
+        const Uint32 index = changedTile.first;
+        if(map(index % map.getSizeX(), index / map.getSizeX()) == changedTile.second) {
+            // painted over and back again
+            continue;
+        }
+
+        if(!runs.empty() && (runs.back().startIndex + runs.back().length == index)) {
+            runs.back().length++;
+        } else {
+            runs.push_back({index, 1});
+        }
+        terrainTypes.push_back(static_cast<Uint8>(changedTile.second));
+    }
+
+    if(!terrainTypes.empty()) {
+        runs.shrink_to_fit();
+        terrainTypes.shrink_to_fit();
+        addUndoOperation(std::make_unique<MapEditorTerrainStrokeOperation>(std::move(runs), std::move(terrainTypes)));
+    }
+}
+
+void MapEditor::pushUndoOperation(std::unique_ptr<MapEditorOperation> op) {
+    undoMemoryUsage += op->getMemoryUsage();
+    undoOperationStack.push_back(std::move(op));
+    limitUndoHistory();
+}
+
+std::unique_ptr<MapEditorOperation> MapEditor::popUndoOperation() {
+    std::unique_ptr<MapEditorOperation> op = std::move(undoOperationStack.back());
+    undoOperationStack.pop_back();
+    undoMemoryUsage -= op->getMemoryUsage();
+    return op;
+}
+
+void MapEditor::clearUndoHistory() {
+    undoOperationStack.clear();
+    undoMemoryUsage = 0;
+    strokeOldTerrain.clear();
+}
+
+void MapEditor::limitUndoHistory() {
+    while(undoMemoryUsage > MAPEDITOR_UNDO_MEMORY_LIMIT) {
+        // find the start of the second oldest group
+        auto nextGroup = undoOperationStack.begin();
+        if(nextGroup != undoOperationStack.end()) {
+            ++nextGroup;
+        }
+        while((nextGroup != undoOperationStack.end()) && !dynamic_cast<MapEditorStartOperation*>(nextGroup->get())) {
+            ++nextGroup;
+        }
+
+        if(nextGroup == undoOperationStack.end()) {
+            // only the newest group is left
+            break;
+        }
+
+        for(auto iter = undoOperationStack.begin(); iter != nextGroup; ++iter) {
+            undoMemoryUsage -= (*iter)->getMemoryUsage();
+        }
+        undoOperationStack.erase(undoOperationStack.begin(), nextGroup);
+    }
+}
+
+std::map<std::string, MapEditor::LoadedMap>& MapEditor::getLoadedMapCache() {
+    static std::map<std::string, LoadedMap> loadedMapCache;
+    return loadedMapCache;
+}
+
 void MapEditor::loadMap(const std::string& filepath) {
     // reset tools
     selectedUnitID = INVALID;
@@ -343,13 +429,8 @@ void MapEditor::loadMap(const std::string& filepath) {
         pInterface->deselectAll();
     }
 
-    while(!redoOperationStack.empty()) {
-        redoOperationStack.pop();
-    }
-
-    while(!undoOperationStack.empty()) {
-        undoOperationStack.pop();
-    }
+    clearRedoOperations();
+    clearUndoHistory();
 
     // reset other map properties
     spiceBlooms.clear();
@@ -370,11 +451,53 @@ void MapEditor::loadMap(const std::string& filepath) {
     players.push_back(Player(getHouseNameByNumber(HOUSE_MERCENARY),HOUSE_MERCENARY,HOUSE_MERCENARY,false,false,"Team6"));
 
     // load map
-    loadedINIFile = std::make_unique<INIFile>(filepath, false);
     lastSaveName = filepath;
+    loadedINIFile.reset();
+    loadedINIFileContent.clear();
+
+    const std::string fileContent = readCompleteFile(filepath);
+
+    auto& loadedMapCache = getLoadedMapCache();
+    const auto iter = loadedMapCache.find(filepath);
+    if(!fileContent.empty() && (iter != loadedMapCache.end()) && (iter->second.fileContent == fileContent)) {
+        // the file has not changed since it was loaded last time; the INIFile is only needed again for saving
+        const LoadedMap& loadedMap = iter->second;
+        map = loadedMap.map;
+        mapInfo = loadedMap.mapInfo;
+        players = loadedMap.players;
+        spiceBlooms = loadedMap.spiceBlooms;
+        specialBlooms = loadedMap.specialBlooms;
+        spiceFields = loadedMap.spiceFields;
+        choam = loadedMap.choam;
+        reinforcements = loadedMap.reinforcements;
+        aiteams = loadedMap.aiteams;
+        units = loadedMap.units;
+        structures = loadedMap.structures;
+
+        loadedINIFileContent = fileContent;
+
+        screenborder->adjustScreenBorderToMapsize(map.getSizeX(), map.getSizeY());
+        informPlayersChanged();
+    } else {
+        if(fileContent.empty()) {
+            loadedINIFile = std::make_unique<INIFile>(filepath, false);
+        } else {
+            auto RWopsFile = sdl2::RWops_ptr{ SDL_RWFromConstMem(fileContent.data(), static_cast<int>(fileContent.size())) };
+            loadedINIFile = std::make_unique<INIFile>(RWopsFile.get(), false);
+        }
+
+        // do the actual loading
+        INIMapEditorLoader INIMapEditorLoader(this, loadedINIFile.get());
+
+        if(!fileContent.empty()) {
+            if((iter == loadedMapCache.end()) && (loadedMapCache.size() >= MAPEDITOR_LOADEDMAPCACHE_SIZE)) {
+                loadedMapCache.erase(loadedMapCache.begin());
+            }
 
-    // do the actual loading
-    INIMapEditorLoader INIMapEditorLoader(this, loadedINIFile.get());
+            loadedMapCache[filepath] = LoadedMap{ fileContent, map, mapInfo, players, spiceBlooms, specialBlooms, spiceFields,
+                                                  choam, reinforcements, aiteams, units, structures };
+        }
+    }
 
     // update interface
     if(pInterface != nullptr) {
@@ -384,10 +507,19 @@ void MapEditor::loadMap(const std::string& filepath) {
 
     currentEditorMode = EditorMode();
 
+    markAllTilesChanged();
     bChangedSinceLastSave = false;
+    editCount++;
 }
 
 void MapEditor::saveMap(const std::string& filepath) {
+    if(!loadedINIFile && !loadedINIFileContent.empty()) {
+        // the map was restored from the cache without parsing the file
+        auto RWopsFile = sdl2::RWops_ptr{ SDL_RWFromConstMem(loadedINIFileContent.data(), static_cast<int>(loadedINIFileContent.size())) };
+        loadedINIFile = std::make_unique<INIFile>(RWopsFile.get(), false);
+        loadedINIFileContent.clear();
+    }
+
     if(!loadedINIFile) {
         std::string comment = "Created with Dune Legacy " + std::string(VERSION) + " Map Editor.";
         loadedINIFile = std::make_unique<INIFile>(false, comment);
@@ -710,6 +842,7 @@ void MapEditor::saveMap(const std::string& filepath) {
     }
 
     loadedINIFile->saveChangesTo(filepath, getMapVersion() < 2);
+    getLoadedMapCache().erase(filepath);
 
     lastSaveName = filepath;
     bChangedSinceLastSave = false;
@@ -892,8 +1025,12 @@ void MapEditor::performMapEdit(int xpos, int ypos, bool bRepeated) {
 
 void MapEditor::performTerrainChange(int x, int y, TERRAINTYPE terrainType) {
 
-    MapEditorTerrainEditOperation editOperation(x, y, terrainType);
-    addUndoOperation(editOperation.perform(this));
+    // only the terrain before the stroke is remembered; finishTerrainStroke() adds the undo operation
+    strokeOldTerrain.emplace(y*map.getSizeX() + x, map(x,y));
+    map(x,y) = terrainType;
+    markTilesChanged(x, y);
+    bChangedSinceLastSave = true;
+    editCount++;
 
     switch(terrainType) {
         case Terrain_Mountain: {
@@ -965,7 +1102,7 @@ void MapEditor::drawScreen() {
 void MapEditor::processInput() {
     SDL_Event event;
 
-    while(SDL_PollEvent(&event)) {
+    while(pollCoalescedEvent(event)) {
 
         // first of all update mouse
         if(event.type == SDL_MOUSEMOTION) {
@@ -1394,98 +1531,162 @@ TERRAINTYPE MapEditor::getTerrain(int x, int y) {
     return terrainType;
 }
 
-void MapEditor::drawMap(ScreenBorder* pScreenborder, bool bCompleteMap) {
-    int zoomedTilesize = world2zoomedWorld(TILESIZE);
+int MapEditor::getTerrainTile(int x, int y) {
+    if(terrainTileCache.size() != static_cast<size_t>(map.getSizeX()*map.getSizeY())) {
+        terrainTileCache.assign(map.getSizeX()*map.getSizeY(), -1);
+    }
 
-    Coord TopLeftTile = pScreenborder->getTopLeftTile();
-    Coord BottomRightTile = pScreenborder->getBottomRightTile();
+    Sint16& tile = terrainTileCache[y*map.getSizeX() + x];
+    if(tile < 0) {
+        tile = calculateTerrainTile(x, y);
+    }
+    return tile;
+}
 
-    // extend the view a little bit to avoid graphical glitches
-    TopLeftTile.x = std::max(0, TopLeftTile.x - 1);
-    TopLeftTile.y = std::max(0, TopLeftTile.y - 1);
-    BottomRightTile.x = std::min(map.getSizeX()-1, BottomRightTile.x + 1);
-    BottomRightTile.y = std::min(map.getSizeY()-1, BottomRightTile.y + 1);
+int MapEditor::calculateTerrainTile(int x, int y) {
+    int tile;
 
-    // Load Terrain Surface
-    SDL_Texture* TerrainSprite = pGFXManager->getZoomedObjPic(ObjPic_Terrain, currentZoomlevel);
+    switch(getTerrain(x,y)) {
+        case Terrain_Slab: {
+            tile = Tile::TerrainTile_Slab;
+        } break;
 
-    /* draw ground */
-    for(int y = TopLeftTile.y; y <= BottomRightTile.y; y++) {
-        for(int x = TopLeftTile.x; x <= BottomRightTile.x; x++) {
+        case Terrain_Sand: {
+            tile = Tile::TerrainTile_Sand;
+        } break;
 
-            int tile;
+        case Terrain_Rock: {
+            //determine which surounding tiles are rock
+            bool up = (y-1 < 0) || (getTerrain(x, y-1) == Terrain_Rock) || (getTerrain(x, y-1) == Terrain_Slab) || (getTerrain(x, y-1) == Terrain_Mountain);
+            bool right = (x+1 >= map.getSizeX()) || (getTerrain(x+1, y) == Terrain_Rock) || (getTerrain(x+1, y) == Terrain_Slab) || (getTerrain(x+1, y) == Terrain_Mountain);
+            bool down = (y+1 >= map.getSizeY()) || (getTerrain(x, y+1) == Terrain_Rock) || (getTerrain(x, y+1) == Terrain_Slab) || (getTerrain(x, y+1) == Terrain_Mountain);
+            bool left = (x-1 < 0) || (getTerrain(x-1, y) == Terrain_Rock) || (getTerrain(x-1, y) == Terrain_Slab) || (getTerrain(x-1, y) == Terrain_Mountain);
 
-            switch(getTerrain(x,y)) {
-                case Terrain_Slab: {
-                    tile = Tile::TerrainTile_Slab;
-                } break;
+            tile = Tile::TerrainTile_Rock + (up | (right << 1) | (down << 2) | (left << 3));
+        } break;
 
-                case Terrain_Sand: {
-                    tile = Tile::TerrainTile_Sand;
-                } break;
+        case Terrain_Dunes: {
+            //determine which surounding tiles are dunes
+            bool up = (y-1 < 0) || (getTerrain(x, y-1) == Terrain_Dunes);
+            bool right = (x+1 >= map.getSizeX()) || (getTerrain(x+1, y) == Terrain_Dunes);
+            bool down = (y+1 >= map.getSizeY()) || (getTerrain(x, y+1) == Terrain_Dunes);
+            bool left = (x-1 < 0) || (getTerrain(x-1, y) == Terrain_Dunes);
 
-                case Terrain_Rock: {
-                    //determine which surounding tiles are rock
-                    bool up = (y-1 < 0) || (getTerrain(x, y-1) == Terrain_Rock) || (getTerrain(x, y-1) == Terrain_Slab) || (getTerrain(x, y-1) == Terrain_Mountain);
-                    bool right = (x+1 >= map.getSizeX()) || (getTerrain(x+1, y) == Terrain_Rock) || (getTerrain(x+1, y) == Terrain_Slab) || (getTerrain(x+1, y) == Terrain_Mountain);
-                    bool down = (y+1 >= map.getSizeY()) || (getTerrain(x, y+1) == Terrain_Rock) || (getTerrain(x, y+1) == Terrain_Slab) || (getTerrain(x, y+1) == Terrain_Mountain);
-                    bool left = (x-1 < 0) || (getTerrain(x-1, y) == Terrain_Rock) || (getTerrain(x-1, y) == Terrain_Slab) || (getTerrain(x-1, y) == Terrain_Mountain);
+            tile = Tile::TerrainTile_Dunes + (up | (right << 1) | (down << 2) | (left << 3));
+        } break;
 
-                    tile = Tile::TerrainTile_Rock + (up | (right << 1) | (down << 2) | (left << 3));
-                } break;
+        case Terrain_Mountain: {
+            //determine which surounding tiles are mountains
+            bool up = (y-1 < 0) || (getTerrain(x, y-1) == Terrain_Mountain);
+            bool right = (x+1 >= map.getSizeX()) || (getTerrain(x+1, y) == Terrain_Mountain);
+            bool down = (y+1 >= map.getSizeY()) || (getTerrain(x, y+1) == Terrain_Mountain);
+            bool left = (x-1 < 0) || (getTerrain(x-1, y) == Terrain_Mountain);
 
-                case Terrain_Dunes: {
-                    //determine which surounding tiles are dunes
-                    bool up = (y-1 < 0) || (getTerrain(x, y-1) == Terrain_Dunes);
-                    bool right = (x+1 >= map.getSizeX()) || (getTerrain(x+1, y) == Terrain_Dunes);
-                    bool down = (y+1 >= map.getSizeY()) || (getTerrain(x, y+1) == Terrain_Dunes);
-                    bool left = (x-1 < 0) || (getTerrain(x-1, y) == Terrain_Dunes);
+            tile = Tile::TerrainTile_Mountain + (up | (right << 1) | (down << 2) | (left << 3));
+        } break;
 
-                    tile = Tile::TerrainTile_Dunes + (up | (right << 1) | (down << 2) | (left << 3));
-                } break;
+        case Terrain_Spice: {
+            //determine which surounding tiles are spice
+            bool up = (y-1 < 0) || (getTerrain(x, y-1) == Terrain_Spice) || (getTerrain(x, y-1) == Terrain_ThickSpice);
+            bool right = (x+1 >= map.getSizeX()) || (getTerrain(x+1, y) == Terrain_Spice) || (getTerrain(x+1, y) == Terrain_ThickSpice);
+            bool down = (y+1 >= map.getSizeY()) || (getTerrain(x, y+1) == Terrain_Spice) || (getTerrain(x, y+1) == Terrain_ThickSpice);
+            bool left = (x-1 < 0) || (getTerrain(x-1, y) == Terrain_Spice) || (getTerrain(x-1, y) == Terrain_ThickSpice);
 
-                case Terrain_Mountain: {
-                    //determine which surounding tiles are mountains
-                    bool up = (y-1 < 0) || (getTerrain(x, y-1) == Terrain_Mountain);
-                    bool right = (x+1 >= map.getSizeX()) || (getTerrain(x+1, y) == Terrain_Mountain);
-                    bool down = (y+1 >= map.getSizeY()) || (getTerrain(x, y+1) == Terrain_Mountain);
-                    bool left = (x-1 < 0) || (getTerrain(x-1, y) == Terrain_Mountain);
+            tile = Tile::TerrainTile_Spice + (up | (right << 1) | (down << 2) | (left << 3));
+        } break;
 
-                    tile = Tile::TerrainTile_Mountain + (up | (right << 1) | (down << 2) | (left << 3));
-                } break;
+        case Terrain_ThickSpice: {
+            //determine which surounding tiles are thick spice
+            bool up = (y-1 < 0) || (getTerrain(x, y-1) == Terrain_ThickSpice);
+            bool right = (x+1 >= map.getSizeX()) || (getTerrain(x+1, y) == Terrain_ThickSpice);
+            bool down = (y+1 >= map.getSizeY()) || (getTerrain(x, y+1) == Terrain_ThickSpice);
+            bool left = (x-1 < 0) || (getTerrain(x-1, y) == Terrain_ThickSpice);
 
-                case Terrain_Spice: {
-                    //determine which surounding tiles are spice
-                    bool up = (y-1 < 0) || (getTerrain(x, y-1) == Terrain_Spice) || (getTerrain(x, y-1) == Terrain_ThickSpice);
-                    bool right = (x+1 >= map.getSizeX()) || (getTerrain(x+1, y) == Terrain_Spice) || (getTerrain(x+1, y) == Terrain_ThickSpice);
-                    bool down = (y+1 >= map.getSizeY()) || (getTerrain(x, y+1) == Terrain_Spice) || (getTerrain(x, y+1) == Terrain_ThickSpice);
-                    bool left = (x-1 < 0) || (getTerrain(x-1, y) == Terrain_Spice) || (getTerrain(x-1, y) == Terrain_ThickSpice);
+            tile = Tile::TerrainTile_ThickSpice + (up | (right << 1) | (down << 2) | (left << 3));
+        } break;
 
-                    tile = Tile::TerrainTile_Spice + (up | (right << 1) | (down << 2) | (left << 3));
-                } break;
+        case Terrain_SpiceBloom: {
+            tile = Tile::TerrainTile_SpiceBloom;
+        } break;
 
-                case Terrain_ThickSpice: {
-                    //determine which surounding tiles are thick spice
-                    bool up = (y-1 < 0) || (getTerrain(x, y-1) == Terrain_ThickSpice);
-                    bool right = (x+1 >= map.getSizeX()) || (getTerrain(x+1, y) == Terrain_ThickSpice);
-                    bool down = (y+1 >= map.getSizeY()) || (getTerrain(x, y+1) == Terrain_ThickSpice);
-                    bool left = (x-1 < 0) || (getTerrain(x-1, y) == Terrain_ThickSpice);
+        case Terrain_SpecialBloom: {
+            tile = Tile::TerrainTile_SpecialBloom;
+        } break;
 
-                    tile = Tile::TerrainTile_ThickSpice + (up | (right << 1) | (down << 2) | (left << 3));
-                } break;
+        default: {
+            THROW(std::runtime_error, "MapEditor::calculateTerrainTile(): Invalid terrain type");
+        } break;
+    }
 
-                case Terrain_SpiceBloom: {
-                    tile = Tile::TerrainTile_SpiceBloom;
-                } break;
+    return tile;
+}
 
-                case Terrain_SpecialBloom: {
-                    tile = Tile::TerrainTile_SpecialBloom;
-                } break;
+void MapEditor::markTilesChanged(int x, int y, int width, int height) {
+    // the sprites of the neighbours depend on the terrain of these tiles
+    const int x1 = std::max(0, x - 1);
+    const int y1 = std::max(0, y - 1);
+    const int x2 = std::min(map.getSizeX() - 1, x + width);
+    const int y2 = std::min(map.getSizeY() - 1, y + height);
+    if((x1 > x2) || (y1 > y2)) {
+        return;
+    }
 
-                default: {
-                    THROW(std::runtime_error, "MapEditor::DrawMap(): Invalid terrain type");
-                } break;
-            }
+    if(terrainTileCache.size() == static_cast<size_t>(map.getSizeX()*map.getSizeY())) {
+        for(int j = y1; j <= y2; j++) {
+            std::fill_n(terrainTileCache.begin() + j*map.getSizeX() + x1, x2 - x1 + 1, -1);
+        }
+    }
+
+    const Coord topLeft(std::max(0, x), std::max(0, y));
+    const Coord bottomRight(std::min(map.getSizeX() - 1, x + width - 1), std::min(map.getSizeY() - 1, y + height - 1));
+    if(bTilesChanged) {
+        changedTilesTopLeft = Coord(std::min(changedTilesTopLeft.x, topLeft.x), std::min(changedTilesTopLeft.y, topLeft.y));
+        changedTilesBottomRight = Coord(std::max(changedTilesBottomRight.x, bottomRight.x), std::max(changedTilesBottomRight.y, bottomRight.y));
+    } else {
+        changedTilesTopLeft = topLeft;
+        changedTilesBottomRight = bottomRight;
+        bTilesChanged = true;
+    }
+}
+
+void MapEditor::markAllTilesChanged() {
+    terrainTileCache.clear();
+    changedTilesTopLeft = Coord(0, 0);
+    changedTilesBottomRight = Coord(map.getSizeX() - 1, map.getSizeY() - 1);
+    bTilesChanged = true;
+}
+
+bool MapEditor::takeChangedTiles(Coord& topLeft, Coord& bottomRight) {
+    if(!bTilesChanged) {
+        return false;
+    }
+
+    topLeft = changedTilesTopLeft;
+    bottomRight = changedTilesBottomRight;
+    bTilesChanged = false;
+    return true;
+}
+
+void MapEditor::drawMap(ScreenBorder* pScreenborder, bool bCompleteMap) {
+    int zoomedTilesize = world2zoomedWorld(TILESIZE);
+
+    Coord TopLeftTile = pScreenborder->getTopLeftTile();
+    Coord BottomRightTile = pScreenborder->getBottomRightTile();
+
+    // extend the view a little bit to avoid graphical glitches
+    TopLeftTile.x = std::max(0, TopLeftTile.x - 1);
+    TopLeftTile.y = std::max(0, TopLeftTile.y - 1);
+    BottomRightTile.x = std::min(map.getSizeX()-1, BottomRightTile.x + 1);
+    BottomRightTile.y = std::min(map.getSizeY()-1, BottomRightTile.y + 1);
+
+    // Load Terrain Surface
+    SDL_Texture* TerrainSprite = pGFXManager->getZoomedObjPic(ObjPic_Terrain, currentZoomlevel);
+
+    /* draw ground */
+    for(int y = TopLeftTile.y; y <= BottomRightTile.y; y++) {
+        for(int x = TopLeftTile.x; x <= BottomRightTile.x; x++) {
+
+            const int tile = getTerrainTile(x, y);
 
             //draw map[x][y]
             SDL_Rect source = { (tile % NUM_TERRAIN_TILES_X)*zoomedTilesize, (tile / NUM_TERRAIN_TILES_X)*zoomedTilesize,
@@ -1983,7 +2184,7 @@ void MapEditor::saveMapshot() {
     int oldCurrentZoomlevel = currentZoomlevel;
     currentZoomlevel = 0;
 
-    std::string mapshotFilename = (lastSaveName.empty() ? generateMapname() : getBasename(lastSaveName, true)) + ".png";
+    std::string mapshotFilename = (lastSaveName.empty() ? generateMapname() : getBasename(lastSaveName, true)) + pScreenshotWriter->getFileExtension();
 
     int sizeX = world2zoomedWorld(map.getSizeX()*TILESIZE);
     int sizeY = world2zoomedWorld(map.getSizeY()*TILESIZE);
@@ -2013,8 +2214,7 @@ void MapEditor::saveMapshot() {
 
     drawMap(&tmpScreenborder, true);
 
-    sdl2::surface_ptr pMapshotSurface = renderReadSurface(renderer);
-    SavePNG(pMapshotSurface.get(), mapshotFilename.c_str());
+    pScreenshotWriter->writeScreenshot(mapshotFilename, renderReadSurface(renderer));
 
     SDL_SetRenderTarget(renderer, oldRenderTarget);
 
@@ -3,6 +3,8 @@
 
 #include <MapEditor/MapEditor.h>
 
+#include <sand.h>
+
 #include <algorithm>
 
 
@@ -12,15 +14,24 @@ std::unique_ptr<MapEditorOperation> MapEditorStartOperation::perform(MapEditor *
 
 
 
-std::unique_ptr<MapEditorOperation> MapEditorTerrainEditOperation::perform(MapEditor *pMapEditor) {
-
-    MapData& map = pMapEditor->getMap();
 
-    TERRAINTYPE oldTerrainType = map(x,y);
+std::unique_ptr<MapEditorOperation> MapEditorTerrainStrokeOperation::perform(MapEditor *pMapEditor) {
 
-    map(x,y) = terrainType;
+    MapData& map = pMapEditor->getMap();
+    const Uint32 sizeX = map.getSizeX();
+
+    size_t i = 0;
+    for(const Run& run : runs) {
+        for(Uint32 index = run.startIndex; index < run.startIndex + run.length; index++, i++) {
+            TERRAINTYPE& terrainType = map(index % sizeX, index / sizeX);
+            const TERRAINTYPE oldTerrainType = terrainType;
+            terrainType = static_cast<TERRAINTYPE>(terrainTypes[i]);
+            terrainTypes[i] = static_cast<Uint8>(oldTerrainType);
+            pMapEditor->markTilesChanged(index % sizeX, index / sizeX);
+        }
+    }
 
-    return std::make_unique<MapEditorTerrainEditOperation>(x, y, oldTerrainType);
+    return std::make_unique<MapEditorTerrainStrokeOperation>(std::move(runs), std::move(terrainTypes));
 }
 
 
@@ -34,6 +45,7 @@ std::unique_ptr<MapEditorOperation> MapEditorTerrainAddSpiceBloomOperation::perf
         return std::make_unique<MapEditorNoOperation>();
     } else {
         spiceBlooms.emplace_back(x,y);
+        pMapEditor->markTilesChanged(x, y);
         return std::make_unique<MapEditorTerrainRemoveSpiceBloomOperation>(x, y);
     }
 }
@@ -47,6 +59,7 @@ std::unique_ptr<MapEditorOperation> MapEditorTerrainRemoveSpiceBloomOperation::p
 
     if(iter != spiceBlooms.end()) {
         spiceBlooms.erase(iter);
+        pMapEditor->markTilesChanged(x, y);
         return std::make_unique<MapEditorTerrainAddSpiceBloomOperation>(x, y);
     } else {
         return std::make_unique<MapEditorNoOperation>();
@@ -63,6 +76,7 @@ std::unique_ptr<MapEditorOperation> MapEditorTerrainAddSpecialBloomOperation::pe
         return std::make_unique<MapEditorNoOperation>();
     } else {
         specialBlooms.emplace_back(x,y);
+        pMapEditor->markTilesChanged(x, y);
         return std::make_unique<MapEditorTerrainRemoveSpecialBloomOperation>(x, y);
     }
 }
@@ -76,6 +90,7 @@ std::unique_ptr<MapEditorOperation> MapEditorTerrainRemoveSpecialBloomOperation:
 
     if(iter != specialBlooms.end()) {
         specialBlooms.erase(iter);
+        pMapEditor->markTilesChanged(x, y);
         return std::make_unique<MapEditorTerrainAddSpecialBloomOperation>(x, y);
     } else {
         return std::make_unique<MapEditorNoOperation>();
@@ -92,6 +107,8 @@ std::unique_ptr<MapEditorOperation> MapEditorTerrainAddSpiceFieldOperation::perf
         return std::make_unique<MapEditorNoOperation>();
     } else {
         spiceFields.emplace_back(x,y);
+        // a spice field covers all sand within a radius of 5 tiles
+        pMapEditor->markTilesChanged(x - 5, y - 5, 11, 11);
         return std::make_unique<MapEditorTerrainRemoveSpiceFieldOperation>(x, y);
     }
 }
@@ -105,6 +122,7 @@ std::unique_ptr<MapEditorOperation> MapEditorTerrainRemoveSpiceFieldOperation::p
 
     if(iter != spiceFields.end()) {
         spiceFields.erase(iter);
+        pMapEditor->markTilesChanged(x - 5, y - 5, 11, 11);
         return std::make_unique<MapEditorTerrainAddSpiceFieldOperation>(x, y);
     } else {
         return std::make_unique<MapEditorNoOperation>();
@@ -142,6 +160,9 @@ std::unique_ptr<MapEditorOperation> MapEditorStructurePlaceOperation::perform(Ma
 
     structures.emplace_back(newID, house, itemID, health, position);
 
+    const Coord structureSize = getStructureSize(itemID);
+    pMapEditor->markTilesChanged(position.x, position.y, structureSize.x, structureSize.y);
+
     return std::make_unique<MapEditorRemoveStructureOperation>(newID);
 }
 
@@ -155,6 +176,9 @@ std::unique_ptr<MapEditorOperation> MapEditorRemoveStructureOperation::perform(M
         if(iter->id == id) {
             auto redoOperation = std::make_unique<MapEditorStructurePlaceOperation>(iter->id, iter->position, iter->house, iter->itemID, iter->health);
 
+            const Coord structureSize = getStructureSize(iter->itemID);
+            pMapEditor->markTilesChanged(iter->position.x, iter->position.y, structureSize.x, structureSize.y);
+
             structures.erase(iter);
 
             return std::move(redoOperation);
@@ -179,6 +203,8 @@ std::unique_ptr<MapEditorOperation> MapEditorUnitPlaceOperation::perform(MapEdit
 
     units.emplace_back(newID, house, itemID, health, position, angle, attackmode);
 
+    pMapEditor->markTilesChanged(position.x, position.y);
+
     return std::make_unique<MapEditorRemoveUnitOperation>(newID);
 }
 
@@ -192,6 +218,8 @@ std::unique_ptr<MapEditorOperation> MapEditorRemoveUnitOperation::perform(MapEdi
         if(iter->id == id) {
             auto redoOperation = std::make_unique<MapEditorUnitPlaceOperation>(iter->id, iter->position, iter->house, iter->itemID, iter->health, iter->angle, iter->attackmode);
 
+            pMapEditor->markTilesChanged(iter->position.x, iter->position.y);
+
             units.erase(iter);
 
             return redoOperation;
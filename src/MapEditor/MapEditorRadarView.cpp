@@ -28,6 +28,9 @@
 
 #include <misc/draw_util.h>
 
+#include <algorithm>
+#include <vector>
+
 
 MapEditorRadarView::MapEditorRadarView(MapEditor* pMapEditor)
  : RadarViewBase(), pMapEditor(pMapEditor)
@@ -56,23 +59,32 @@ void MapEditorRadarView::draw(Point position)
     const MapData& map = pMapEditor->getMap();
 
     int scale = 1;
+    int downsampling = 1;
     int offsetX = 0;
     int offsetY = 0;
 
-    calculateScaleAndOffsets(map.getSizeX(), map.getSizeY(), scale, offsetX, offsetY);
+    calculateScaleAndOffsets(map.getSizeX(), map.getSizeY(), scale, downsampling, offsetX, offsetY);
 
-    updateRadarSurface(map, scale, offsetX, offsetY);
+    // the radar only changes when the map is edited and then only the changed tiles have to be recalculated
+    Coord changedTopLeft;
+    Coord changedBottomRight;
+    const bool bTilesChanged = pMapEditor->takeChangedTiles(changedTopLeft, changedBottomRight);
+    if(prepareRadarTiles(radarSurface.get(), map.getSizeX(), map.getSizeY(), scale, downsampling, offsetX, offsetY)) {
+        updateRadarSurface(map, Coord(0, 0), Coord(map.getSizeX() - 1, map.getSizeY() - 1));
+    } else if(bTilesChanged) {
+        updateRadarSurface(map, changedTopLeft, changedBottomRight);
+    }
 
-    SDL_UpdateTexture(radarTexture.get(), nullptr, radarSurface->pixels, radarSurface->pitch);
+    updateRadarTexture(radarTexture.get(), radarSurface.get());
 
     SDL_RenderCopy(renderer, radarTexture.get(), nullptr, &radarPosition);
 
     // draw viewport rect on radar
     SDL_Rect radarRect;
-    radarRect.x = (screenborder->getLeft() * map.getSizeX()*scale) / (map.getSizeX()*TILESIZE) + offsetX;
-    radarRect.y = (screenborder->getTop() * map.getSizeY()*scale) / (map.getSizeY()*TILESIZE) + offsetY;
-    radarRect.w = ((screenborder->getRight() - screenborder->getLeft()) * map.getSizeX()*scale) / (map.getSizeX()*TILESIZE);
-    radarRect.h = ((screenborder->getBottom() - screenborder->getTop()) * map.getSizeY()*scale) / (map.getSizeY()*TILESIZE);
+    radarRect.x = (screenborder->getLeft() * scale) / (TILESIZE * downsampling) + offsetX;
+    radarRect.y = (screenborder->getTop() * scale) / (TILESIZE * downsampling) + offsetY;
+    radarRect.w = ((screenborder->getRight() - screenborder->getLeft()) * scale) / (TILESIZE * downsampling);
+    radarRect.h = ((screenborder->getBottom() - screenborder->getTop()) * scale) / (TILESIZE * downsampling);
 
     if(radarRect.x < offsetX) {
         radarRect.w -= radarRect.x;
@@ -84,12 +96,12 @@ void MapEditorRadarView::draw(Point position)
         radarRect.y = offsetY;
     }
 
-    int offsetFromRightX = 128 - map.getSizeX()*scale - offsetX;
+    int offsetFromRightX = 128 - getRadarSize(map.getSizeX(), scale, downsampling) - offsetX;
     if(radarRect.x + radarRect.w > radarPosition.w - offsetFromRightX) {
         radarRect.w  = radarPosition.w - offsetFromRightX - radarRect.x - 1;
     }
 
-    int offsetFromBottomY = 128 - map.getSizeY()*scale - offsetY;
+    int offsetFromBottomY = 128 - getRadarSize(map.getSizeY(), scale, downsampling) - offsetY;
     if(radarRect.y + radarRect.h > radarPosition.h - offsetFromBottomY) {
         radarRect.h = radarPosition.h - offsetFromBottomY - radarRect.y - 1;
     }
@@ -103,20 +115,28 @@ void MapEditorRadarView::draw(Point position)
 
 }
 
-void MapEditorRadarView::updateRadarSurface(const MapData& map, int scale, int offsetX, int offsetY) {
+void MapEditorRadarView::updateRadarSurface(const MapData& map, const Coord& topLeft, const Coord& bottomRight) {
+    const int x1 = std::max(0, topLeft.x);
+    const int y1 = std::max(0, topLeft.y);
+    const int x2 = std::min(map.getSizeX() - 1, bottomRight.x);
+    const int y2 = std::min(map.getSizeY() - 1, bottomRight.y);
+    if((x1 > x2) || (y1 > y2)) {
+        return;
+    }
 
-    SDL_FillRect(radarSurface.get(), nullptr, COLOR_BLACK);
+    const int width = x2 - x1 + 1;
+    const int height = y2 - y1 + 1;
 
-    sdl2::surface_lock lock{radarSurface.get()};
+    std::vector<Uint32> colors(width * height);
+
+    const std::vector<Coord>& spiceFields = pMapEditor->getSpiceFields();
 
-    for(int y = 0; y <  map.getSizeY(); y++) {
-        for(int x = 0; x <  map.getSizeX(); x++) {
+    for(int y = y1; y <= y2; y++) {
+        for(int x = x1; x <= x2; x++) {
 
             Uint32 color = getColorByTerrainType(map(x,y));
 
             if(map(x,y) == Terrain_Sand) {
-                std::vector<Coord>& spiceFields = pMapEditor->getSpiceFields();
-
                 for(size_t i = 0; i < spiceFields.size(); i++) {
                     if(spiceFields[i].x == x && spiceFields[i].y == y) {
                         color = COLOR_THICKSPICE;
@@ -128,74 +148,54 @@ void MapEditorRadarView::updateRadarSurface(const MapData& map, int scale, int o
                 }
             }
 
-            // check for classic map items (spice blooms, special blooms)
-            std::vector<Coord>& spiceBlooms = pMapEditor->getSpiceBlooms();
-            for(size_t i = 0; i < spiceBlooms.size(); i++) {
-                if(spiceBlooms[i].x == x && spiceBlooms[i].y == y) {
-                    color = COLOR_BLOOM;
-                    break;
-                }
-            }
-
-
-
-            std::vector<Coord>& specialBlooms = pMapEditor->getSpecialBlooms();
-            for(size_t i = 0; i < specialBlooms.size(); i++) {
-                if(specialBlooms[i].x == x && specialBlooms[i].y == y) {
-                    color = COLOR_BLOOM;
-                    break;
-                }
-            }
-
-            color = MapRGBA(radarSurface->format, color);
+            colors[(y - y1) * width + (x - x1)] = color;
+        }
+    }
 
-            for(int j = 0; j < scale; j++) {
-                Uint32* p = ((Uint32*) ((Uint8 *) radarSurface->pixels + (offsetY + scale*y + j) * radarSurface->pitch)) + (offsetX + scale*x);
+    // check for classic map items (spice blooms, special blooms)
+    for(const Coord& spiceBloom : pMapEditor->getSpiceBlooms()) {
+        if(spiceBloom.x >= x1 && spiceBloom.x <= x2 && spiceBloom.y >= y1 && spiceBloom.y <= y2) {
+            colors[(spiceBloom.y - y1) * width + (spiceBloom.x - x1)] = COLOR_BLOOM;
+        }
+    }
 
-                for(int i = 0; i < scale; i++, p++) {
-                    // Do not use putPixel here to avoid overhead
-                    *p = color;
-                }
-            }
+    for(const Coord& specialBloom : pMapEditor->getSpecialBlooms()) {
+        if(specialBloom.x >= x1 && specialBloom.x <= x2 && specialBloom.y >= y1 && specialBloom.y <= y2) {
+            colors[(specialBloom.y - y1) * width + (specialBloom.x - x1)] = COLOR_BLOOM;
         }
     }
 
     for(const MapEditor::Unit& unit : pMapEditor->getUnitList()) {
 
-        if(unit.position.x >= 0 && unit.position.x < map.getSizeX()
-            && unit.position.y >= 0 && unit.position.y < map.getSizeY()) {
+        if(unit.position.x >= x1 && unit.position.x <= x2
+            && unit.position.y >= y1 && unit.position.y <= y2) {
 
-            for(int i = 0; i < scale; i++) {
-                for(int j = 0; j < scale; j++) {
-                    putPixel(   radarSurface.get(),
-                                offsetX + scale*unit.position.x + i,
-                                offsetY + scale*unit.position.y + j,
-                                SDL2RGB(palette[houseToPaletteIndex[unit.house]]));
-                }
-            }
+            colors[(unit.position.y - y1) * width + (unit.position.x - x1)] = SDL2RGB(palette[houseToPaletteIndex[unit.house]]);
         }
     }
 
     for(const MapEditor::Structure& structure : pMapEditor->getStructureList()) {
         Coord structureSize = getStructureSize(structure.itemID);
 
-        for(int y = 0; y < structureSize.y; y++) {
-            for(int x = 0; x < structureSize.x; x++) {
+        // only the part of the structure inside the rectangle
+        const int structureX1 = std::max(x1, structure.position.x);
+        const int structureY1 = std::max(y1, structure.position.y);
+        const int structureX2 = std::min(x2, structure.position.x + structureSize.x - 1);
+        const int structureY2 = std::min(y2, structure.position.y + structureSize.y - 1);
 
-                if(x >= 0 && x < map.getSizeX()
-                    && y >= 0 && y < map.getSizeY()) {
-
-                    for(int i = 0; i < scale; i++) {
-                        for(int j = 0; j < scale; j++) {
-                            putPixel(   radarSurface.get(),
-                                        offsetX + scale*(structure.position.x+x) + i,
-                                        offsetY + scale*(structure.position.y+y) + j,
-                                        SDL2RGB(palette[houseToPaletteIndex[structure.house]]));
-                        }
-                    }
-                }
+        for(int y = structureY1; y <= structureY2; y++) {
+            for(int x = structureX1; x <= structureX2; x++) {
+                colors[(y - y1) * width + (x - x1)] = SDL2RGB(palette[houseToPaletteIndex[structure.house]]);
             }
         }
     }
 
+    // only the tiles that changed since the last update are written to the surface
+    sdl2::surface_lock lock{radarSurface.get()};
+
+    for(int y = y1; y <= y2; y++) {
+        for(int x = x1; x <= x2; x++) {
+            setRadarTileColor(radarSurface.get(), x, y, MapRGBA(radarSurface->format, colors[(y - y1) * width + (x - x1)]));
+        }
+    }
 }
@@ -20,6 +20,7 @@
 #include <globals.h>
 
 #include <misc/Random.h>
+#include <misc/WorkerPool.h>
 
 
 #define ROCKFILLER 2        //how many times random generator will try to remove sand "holes" for rock from the map
@@ -201,15 +202,16 @@ private:
                 if(map(i,j) != type) {
                     // Found something else than what thickining
 
-                    if(side4(i, j, type) >= 3) {
+                    // setting the tile (or its mirrored tiles) can only increase the count, so it is only calculated once
+                    const int numTypeTiles = side4(i, j, type);
+
+                    if(numTypeTiles >= 3) {
                         // Seems enough of the type around it so make this also of this type
                         for(int m=0; m < mapMirror->getSize(); m++) {
                             Coord position = mapMirror->getCoord(Coord(i, j), m);
                             map(position.x,position.y) = type;
                         }
-                    }
-
-                    if(side4(i, j, type) == 2) {
+                    } else if(numTypeTiles == 2) {
                         // Gamble, fifty fifty... set this type or not?
                         if(randGen.rand(0,1) == 1) {
                             for(int m=0; m < mapMirror->getSize(); m++) {
@@ -236,15 +238,15 @@ private:
                 if(map(i,j) != Terrain_ThickSpice && (numSpiceTiles>=4)) {
                     // Found something else than what thickining
 
-                    if(side4(i, j, Terrain_ThickSpice) >= 3) {
+                    const int numThickSpiceTiles = side4(i, j, Terrain_ThickSpice);
+
+                    if(numThickSpiceTiles >= 3) {
                         // Seems enough of ThickSpice around it so make this also ThickSpice
                         for(int m=0; m < mapMirror->getSize(); m++) {
                             Coord position = mapMirror->getCoord(Coord(i, j), m);
                             map(position.x,position.y) = Terrain_ThickSpice;
                         }
-                    }
-
-                    if(side4(i, j, Terrain_ThickSpice) == 2) {
+                    } else if(numThickSpiceTiles == 2) {
                         // Gamble, fifty fifty... set this to ThickSpice or not?
                         if(randGen.rand(0,1) == 1) {
                             for(int m=0; m < mapMirror->getSize(); m++) {
@@ -375,3 +377,15 @@ MapData generateRandomMap(int sizeX, int sizeY, int randSeed, int rockfields, in
 
     return mapGenerator.getMap();
 }
+
+std::vector<MapData> generateRandomMaps(int sizeX, int sizeY, const std::vector<int>& randSeeds, int rockfields, int spicefields, MirrorMode mirrorMode) {
+    std::vector<MapData> maps(randSeeds.size(), MapData(0, 0));
+
+    // every map has its own random generator, so the result does not depend on the order the maps are generated in
+    WorkerPool workerPool(WorkerPool::getDefaultNumThreads());
+    workerPool.parallelFor(static_cast<int>(randSeeds.size()), [&](int i) {
+        maps[i] = generateRandomMap(sizeX, sizeY, randSeeds[i], rockfields, spicefields, mirrorMode);
+    });
+
+    return maps;
+}
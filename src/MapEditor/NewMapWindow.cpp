@@ -92,6 +92,8 @@ NewMapWindow::NewMapWindow(HOUSETYPE currentHouse) : Window(0,0,0,0), house(curr
     mapSizeXDropDownBox.addEntry("32",32);
     mapSizeXDropDownBox.addEntry("64",64);
     mapSizeXDropDownBox.addEntry("128",128);
+    mapSizeXDropDownBox.addEntry("256",256);
+    mapSizeXDropDownBox.addEntry("512",512);
     mapSizeXDropDownBox.setSelectedItem(2);
     mapSizeXDropDownBox.setOnSelectionChange(std::bind(&NewMapWindow::onMapPropertiesChanged,this));
     mapSizeYLabel.setText(_("Map Height:"));
@@ -100,6 +102,8 @@ NewMapWindow::NewMapWindow(HOUSETYPE currentHouse) : Window(0,0,0,0), house(curr
     mapSizeYDropDownBox.addEntry("32",32);
     mapSizeYDropDownBox.addEntry("64",64);
     mapSizeYDropDownBox.addEntry("128",128);
+    mapSizeYDropDownBox.addEntry("256",256);
+    mapSizeYDropDownBox.addEntry("512",512);
     mapSizeYDropDownBox.setSelectedItem(2);
     mapSizeYDropDownBox.setOnSelectionChange(std::bind(&NewMapWindow::onMapPropertiesChanged,this));
 
@@ -337,16 +341,17 @@ sdl2::surface_ptr NewMapWindow::createMinimapPicture(MapData& mapdata, int borde
     SDL_FillRect(pMinimap.get(), &dest, COLOR_BLACK);
 
     int scale = 1;
+    int downsampling = 1;
     int offsetX;
     int offsetY;
 
-    RadarViewBase::calculateScaleAndOffsets(mapdata.getSizeX(), mapdata.getSizeY(), scale, offsetX, offsetY);
+    RadarViewBase::calculateScaleAndOffsets(mapdata.getSizeX(), mapdata.getSizeY(), scale, downsampling, offsetX, offsetY);
 
     offsetX += borderWidth;
     offsetY += borderWidth;
 
-    for(int y = 0; y < mapdata.getSizeY(); y++) {
-        for(int x = 0; x < mapdata.getSizeX(); x++) {
+    for(int y = 0; y < mapdata.getSizeY(); y += downsampling) {
+        for(int x = 0; x < mapdata.getSizeX(); x += downsampling) {
 
             TERRAINTYPE terrainType = mapdata(x,y);
 
@@ -354,7 +359,7 @@ sdl2::surface_ptr NewMapWindow::createMinimapPicture(MapData& mapdata, int borde
 
             for(int i=0;i<scale;i++) {
                 for(int j=0;j<scale;j++) {
-                    putPixel(pMinimap.get(), x*scale + i + offsetX, y*scale + j + offsetY, color);
+                    putPixel(pMinimap.get(), (x/downsampling)*scale + i + offsetX, (y/downsampling)*scale + j + offsetY, color);
                 }
             }
         }
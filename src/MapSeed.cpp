@@ -20,8 +20,7 @@
 
 #include "MapSeed.h"
 
-// global seed value
-static Uint32 Seed;
+#include <misc/WorkerPool.h>
 
 // a point that has 2 coordinates
 typedef struct  {
@@ -162,9 +161,10 @@ static void SmoothNeighbourhood(Sint16 index, Uint32* pMapArray) {
 
 /**
     Creates new random value.
+    \param Seed     the state of the random generator (is updated)
     \return The new random value
 */
-static Uint16 SeedRand() {
+static Uint16 SeedRand(Uint32& Seed) {
     Uint8 a;
     Uint8 carry;
     Uint8 old_carry;
@@ -242,36 +242,37 @@ void createMapWithSeed(Uint32 Para_Seed,Uint16 *pResultMap)
     Uint16 oldMapRow[0x80];
     Uint32 Area[3][3];
 
-    Seed = Para_Seed;
+    // the seed is local so that several maps can be created in parallel
+    Uint32 Seed = Para_Seed;
 
     // clear map
     memset(MapArray,0,sizeof(MapArray));
 
     for(i = 0; i < 16*16+16 ; i++) {
-        Array4x4TerrainGrid[i] = SeedRand() & 0x0F;
+        Array4x4TerrainGrid[i] = SeedRand(Seed) & 0x0F;
         if(Array4x4TerrainGrid[i] <= 0x0A)
             continue;
 
         Array4x4TerrainGrid[i] = 0x0A;
     }
 
-    for(i = SeedRand() & 0x0F;i >= 0 ;i--) {
-        randNum = SeedRand() & 0xFF;
+    for(i = SeedRand(Seed) & 0x0F;i >= 0 ;i--) {
+        randNum = SeedRand(Seed) & 0xFF;
         for(j = 0; j < 21; j++) {
             index = randNum + OffsetArray1[j];
             index = index >= 0 ? index : 0;
             index = index <= (16*16+16) ? index : (16*16+16);
-            Array4x4TerrainGrid[index] = ((Uint16) Array4x4TerrainGrid[index] + (SeedRand() & 0x0F)) & 0x0F;
+            Array4x4TerrainGrid[index] = ((Uint16) Array4x4TerrainGrid[index] + (SeedRand(Seed) & 0x0F)) & 0x0F;
         }
     }
 
-    for(i = SeedRand() & 0x03; i >= 0; i--) {
-        randNum = SeedRand() & 0xFF;
+    for(i = SeedRand(Seed) & 0x03; i >= 0; i--) {
+        randNum = SeedRand(Seed) & 0xFF;
         for(j = 0; j < 21; j++) {
             index = randNum + OffsetArray1[j];
             index = index >= 0 ? index : 0;
             index = index <= (16*16+16) ? index : (16*16+16);
-            Array4x4TerrainGrid[index] = SeedRand() & 0x03;
+            Array4x4TerrainGrid[index] = SeedRand(Seed) & 0x03;
         }
     }
 
@@ -331,10 +332,10 @@ void createMapWithSeed(Uint32 Para_Seed,Uint16 *pResultMap)
         }
     }
 
-    randNum = SeedRand() & 0x0F;
+    randNum = SeedRand(Seed) & 0x0F;
     randNum = (randNum < 8 ? 8 : randNum);
     randNum = (randNum > 0x0C ? 0x0C : randNum);
-    point.y = (SeedRand() & 0x03) - 1;
+    point.y = (SeedRand(Seed) & 0x03) - 1;
     point.y = ( (randNum-3) < point.y ? randNum-3 : point.y);
 
     for(i = 0; i < 64*64; i++) {
@@ -351,9 +352,9 @@ void createMapWithSeed(Uint32 Para_Seed,Uint16 *pResultMap)
         }
     }
 
-    for(i = SeedRand() & 0x2F; i != 0; i--) {
-        point.y = SeedRand() & 0x3F;
-        point.x = SeedRand() & 0x3F;
+    for(i = SeedRand(Seed) & 0x2F; i != 0; i--) {
+        point.y = SeedRand(Seed) & 0x3F;
+        point.x = SeedRand(Seed) & 0x3F;
         index = MapArray2DToMapArray1D(point.x,point.y);
 
         if(BoolArray[MapArray[index]] == 1) {
@@ -362,9 +363,9 @@ void createMapWithSeed(Uint32 Para_Seed,Uint16 *pResultMap)
         }
 
 
-        randNum = SeedRand() & 0x1F;
+        randNum = SeedRand(Seed) & 0x1F;
         for(j=0; j < randNum; j++) {
-            max = SeedRand() & 0x3F;
+            max = SeedRand(Seed) & 0x3F;
 
             if(max == 0) {
                 pos = index;
@@ -372,12 +373,12 @@ void createMapWithSeed(Uint32 Para_Seed,Uint16 *pResultMap)
                 point.y = ((index << 2) & 0xFF00) | 0x80;
                 point.x = ((index & 0x3F) << 8) | 0x80;
 
-                randNum2 = SeedRand() & 0xFF;
+                randNum2 = SeedRand(Seed) & 0xFF;
 
                 while(randNum2 > max)
                     randNum2 = randNum2 >> 1;
 
-                randNum3 = SeedRand() & 0xFF;
+                randNum3 = SeedRand(Seed) & 0xFF;
 
                 point.x = point.x + (((sinus[randNum3] * randNum2) >> 7) << 4);
                 point.y = point.y + ((((-1) * sinus[(randNum3+64) % 256] * randNum2) >> 7) << 4);
@@ -583,3 +584,15 @@ MapData createMapWithSeed(Uint32 Para_Seed, int mapscale) {
 
     return mapData;
 }
+
+std::vector<MapData> createMapsWithSeeds(const std::vector<Uint32>& seeds, int mapscale) {
+    std::vector<MapData> maps(seeds.size(), MapData(0, 0));
+
+    // every map only depends on its own seed
+    WorkerPool workerPool(WorkerPool::getDefaultNumThreads());
+    workerPool.parallelFor(static_cast<int>(seeds.size()), [&](int i) {
+        maps[i] = createMapWithSeed(seeds[i], mapscale);
+    });
+
+    return maps;
+}
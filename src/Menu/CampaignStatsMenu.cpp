@@ -230,6 +230,9 @@ bool CampaignStatsMenu::doInput(SDL_Event &event)
 void CampaignStatsMenu::drawSpecificStuff()
 {
     doState(SDL_GetTicks() - currentStateStartTime);
+
+    // the statistics are counted up frame by frame
+    requestRedraw();
 }
 void CampaignStatsMenu::doState(int elapsedTime)
 {
@@ -42,11 +42,6 @@
 #include <globals.h>
 
 
-#define PLAYER_HUMAN        0
-#define PLAYER_OPEN         -1
-#define PLAYER_CLOSED       -2
-
-
 CustomGamePlayers::CustomGamePlayers(const GameInitSettings& newGameInitSettings, bool server, bool LANServer)
  : MenuBase(), gameInitSettings(newGameInitSettings), bServer(server), bLANServer(LANServer), startGameTime(0), brainEqHumanSlot(-1) {
 
@@ -131,8 +131,8 @@ void MainMenu::onOptions() {
     OptionsMenu  optionsMenu;
     int ret = optionsMenu.showMenu();
 
-    if(ret == MENU_QUIT_REINITIALIZE) {
-        quit(MENU_QUIT_REINITIALIZE);
+    if((ret == MENU_QUIT_REINITIALIZE) || (ret == MENU_QUIT_VIDEOMODECHANGED)) {
+        quit(ret);
     }
 }
 
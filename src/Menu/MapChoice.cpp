@@ -127,6 +127,9 @@ void MapChoice::drawSpecificStuff() {
     SDL_UpdateTexture(mapTexture.get(), nullptr, mapSurface->pixels, mapSurface->pitch);
     SDL_RenderCopy(renderer, mapTexture.get(), nullptr, &centerAreaRect);
 
+    // the map is blended in, the arrows are animated and the selected region blinks
+    requestRedraw();
+
     switch(mapChoiceState) {
 
         case MAPCHOICESTATE_FADEINPLANET: {
@@ -37,9 +37,9 @@ MentatHelp::MentatHelp(int newHouse, int techLevel, int mission) : MentatMenu(ne
     Uint32 color = SDL2RGB(palette[houseToPaletteIndex[newHouse]+3]);
 
     if(mission == 0) {
-        std::vector<MentatTextFile::MentatEntry>::iterator iter = mentatEntries.begin();
+        auto iter = mentatEntries.begin();
         while(iter != mentatEntries.end()) {
-            if(iter->numMenuEntry == 0) {
+            if((*iter)->numMenuEntry == 0) {
                 iter = mentatEntries.erase(iter);
             } else {
                 ++iter;
@@ -53,11 +53,11 @@ MentatHelp::MentatHelp(int newHouse, int techLevel, int mission) : MentatMenu(ne
     backgroundLabel.setTextColor(COLOR_DEFAULT, COLOR_DEFAULT, COLOR_THICKSPICE);
     windowWidget.addWidget(&backgroundLabel,Point(256,96),Point(368,224));
 
-    for(const MentatTextFile::MentatEntry& mentatEntry : mentatEntries) {
-        if(mentatEntry.menuLevel == 0) {
-            mentatTopicsList.addEntry("     " + mentatEntry.title + " :");
+    for(const MentatTextFile::MentatEntry* pMentatEntry : mentatEntries) {
+        if(pMentatEntry->menuLevel == 0) {
+            mentatTopicsList.addEntry("     " + pMentatEntry->title + " :");
         } else {
-            mentatTopicsList.addEntry("        " + mentatEntry.title);
+            mentatTopicsList.addEntry("        " + pMentatEntry->title);
         }
     }
     mentatTopicsList.setHighlightSelectedElement(false);
@@ -150,7 +150,7 @@ void MentatHelp::onListBoxClick() {
         return;
     }
 
-    MentatTextFile::MentatEntry& mentatEntry = mentatEntries[index];
+    const MentatTextFile::MentatEntry& mentatEntry = *mentatEntries[index];
 
     if(mentatEntry.menuLevel != 1) {
         return;
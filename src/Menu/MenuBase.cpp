@@ -19,7 +19,9 @@
 
 #include <Network/NetworkManager.h>
 
-#include <FileClasses/LoadSavePNG.h>
+#include <misc/ScreenshotWriter.h>
+#include <misc/FramePacer.h>
+#include <misc/event_util.h>
 #include <misc/string_util.h>
 #include <misc/FileSystem.h>
 #include <misc/draw_util.h>
@@ -51,9 +53,12 @@ int MenuBase::showMenu() {
 
     quiting = false;
 
-    while(!quiting) {
-        int frameStart = SDL_GetTicks();
+    requestRedraw();
+    Uint32 lastDrawTime = SDL_GetTicks();
+
+    FramePacer framePacer;
 
+    while(!quiting) {
         update();
 
         if(pNetworkManager != nullptr) {
@@ -64,27 +69,46 @@ int MenuBase::showMenu() {
             return retVal;
         }
 
-        if(bClearScreen == true) {
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-            SDL_RenderClear(renderer);
-        }
-        draw();
-        drawCursor();
-        SDL_RenderPresent(renderer);
+        // only draw if a widget changed, is animated or the last frame is getting old
+        bool bDrawn = false;
+        if(isRedrawRequested() || (SDL_GetTicks() - lastDrawTime >= MENUBASE_IDLE_REDRAW_INTERVAL)) {
+            clearRedrawRequest();
+            lastDrawTime = SDL_GetTicks();
 
-        while(SDL_PollEvent(&event)) {
-            //check the events
-            if(doInput(event) == false) {
-                break;
+            if(bClearScreen == true) {
+                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+                SDL_RenderClear(renderer);
             }
+            draw();
+            drawCursor();
+            SDL_RenderPresent(renderer);
+            bDrawn = true;
         }
 
-        int frameTime = SDL_GetTicks() - frameStart;
-        if(settings.video.frameLimit == true) {
-            if(frameTime < 32) {
-                SDL_Delay(32 - frameTime);
+        bool bContinue = true;
+        if(!bDrawn && !isRedrawRequested()) {
+            // nothing to do; sleep until the next input, the next requested redraw or the next update()
+            Uint32 now = SDL_GetTicks();
+            Uint32 timeout = std::min(static_cast<Uint32>(MENUBASE_MAX_IDLE_WAIT), lastDrawTime + MENUBASE_IDLE_REDRAW_INTERVAL - now);
+            if(hasPendingRedraw()) {
+                timeout = std::min(timeout, getRedrawTime() - now);
+            }
+
+            if(SDL_WaitEventTimeout(&event, timeout) == 1) {
+                requestRedraw();
+                bContinue = doInput(event);
             }
         }
+
+        while(bContinue && pollCoalescedEvent(event, false)) {
+            //check the events
+            requestRedraw();
+            bContinue = doInput(event);
+        }
+
+        if(bDrawn && (settings.video.frameLimit == true)) {
+            framePacer.waitForNextFrame();
+        }
     }
 
     return retVal;
@@ -134,16 +158,8 @@ bool MenuBase::doInput(SDL_Event &event) {
 
                 case SDLK_PRINTSCREEN:
                 case SDLK_SYSREQ: {
-
-                    std::string screenshotFilename;
-                    int i = 1;
-                    do {
-                        screenshotFilename = "Screenshot" + std::to_string(i) + ".png";
-                        i++;
-                    } while(existsFile(screenshotFilename) == true);
-
-                    sdl2::surface_ptr pCurrentScreen = renderReadSurface(renderer);
-                    SavePNG(pCurrentScreen.get(), screenshotFilename.c_str());
+                    const std::string screenshotFilename = pScreenshotWriter->getNextFilename("Screenshot");
+                    pScreenshotWriter->writeScreenshot(screenshotFilename, renderReadSurface(renderer));
                 } break;
 
                 case SDLK_TAB: {
@@ -14,6 +14,9 @@
 #include <globals.h>
 
 #include <misc/string_util.h>
+#include <misc/IMemoryStream.h>
+
+#include <sand.h>
 
 MultiPlayerMenu::MultiPlayerMenu() : MenuBase() {
     // set up window
@@ -150,6 +153,7 @@ void MultiPlayerMenu::onConnect() {
     int port = atol(connectPortTextBox.getText().c_str());
 
     pNetworkManager->setOnReceiveGameInfo(std::bind(&MultiPlayerMenu::onReceiveGameInfo, this, std::placeholders::_1, std::placeholders::_2));
+    pNetworkManager->setOnReceiveSnapshot(std::bind(&MultiPlayerMenu::onReceiveSnapshot, this, std::placeholders::_1));
     pNetworkManager->setOnPeerDisconnected(std::bind(&MultiPlayerMenu::onPeerDisconnected, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
     pNetworkManager->connect(hostname, port, settings.general.playerName);
 
@@ -160,6 +164,7 @@ void MultiPlayerMenu::onConnect() {
 void MultiPlayerMenu::onPeerDisconnected(const std::string& playername, bool bHost, int cause) {
     if(bHost) {
         pNetworkManager->setOnReceiveGameInfo(std::function<void (const GameInitSettings&, const ChangeEventList&)>());
+        pNetworkManager->setOnReceiveSnapshot(std::function<void (const std::string&)>());
         pNetworkManager->setOnPeerDisconnected(std::function<void (const std::string&, bool, int)>());
         closeChildWindow();
 
@@ -173,6 +178,7 @@ void MultiPlayerMenu::onJoin() {
         GameServerInfo* pGameServerInfo = static_cast<GameServerInfo*>(gameList.getEntryPtrData(selectedEntry));
 
         pNetworkManager->setOnReceiveGameInfo(std::bind(&MultiPlayerMenu::onReceiveGameInfo, this, std::placeholders::_1, std::placeholders::_2));
+        pNetworkManager->setOnReceiveSnapshot(std::bind(&MultiPlayerMenu::onReceiveSnapshot, this, std::placeholders::_1));
         pNetworkManager->setOnPeerDisconnected(std::bind(&MultiPlayerMenu::onPeerDisconnected, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
         pNetworkManager->connect(pGameServerInfo->serverAddress, settings.general.playerName);
 
@@ -342,6 +348,7 @@ void MultiPlayerMenu::onMetaServerError(int errorcause, const std::string& error
 void MultiPlayerMenu::onReceiveGameInfo(const GameInitSettings& gameInitSettings, const ChangeEventList& changeEventList) {
     closeChildWindow();
 
+    pNetworkManager->setOnReceiveSnapshot(std::function<void (const std::string&)>());
     pNetworkManager->setOnPeerDisconnected(std::function<void (const std::string&, bool, int)>());
 
     auto pCustomGamePlayers = std::make_unique<CustomGamePlayers>(gameInitSettings, false);
@@ -364,6 +371,30 @@ void MultiPlayerMenu::onReceiveGameInfo(const GameInitSettings& gameInitSettings
     }
 }
 
+void MultiPlayerMenu::onReceiveSnapshot(const std::string& snapshot) {
+    closeChildWindow();
+
+    pNetworkManager->setOnReceiveGameInfo(std::function<void (const GameInitSettings&, const ChangeEventList&)>());
+    pNetworkManager->setOnReceiveSnapshot(std::function<void (const std::string&)>());
+    pNetworkManager->setOnPeerDisconnected(std::function<void (const std::string&, bool, int)>());
+
+    // the game is already running and we rejoin it by loading the snapshot; the players are assigned to the houses as in the snapshot
+    IMemoryStream memStream(snapshot.data(), snapshot.size());
+    memStream.readUint32();     // magic number
+    memStream.readUint32();     // savegame version
+    memStream.readString();     // dune legacy version
+    GameInitSettings snapshotGameInitSettings(memStream);
+
+    GameInitSettings gameInitSettings("", snapshot, "");
+    for(const GameInitSettings::HouseInfo& houseInfo : snapshotGameInitSettings.getHouseInfoList()) {
+        gameInitSettings.addHouseInfo(houseInfo);
+    }
+
+    startMultiPlayerGame(gameInitSettings);
+
+    quit(MENU_QUIT_GAME_FINISHED);
+}
+
 void MultiPlayerMenu::showDisconnectMessageBox(int cause) {
     switch(cause) {
         case NETWORKDISCONNECT_QUIT: {
@@ -382,6 +413,10 @@ void MultiPlayerMenu::showDisconnectMessageBox(int cause) {
             openWindow(MsgBox::create(_("There is no free player slot in this game left!")));
         } break;
 
+        case NETWORKDISCONNECT_GAME_RUNNING: {
+            openWindow(MsgBox::create(_("This game is already running and you were not one of its players!")));
+        } break;
+
         default: {
             openWindow(MsgBox::create(_("The connection to the game host was lost!")));
         } break;
@@ -297,6 +297,13 @@ void OptionsMenu::onOptionsOK() {
         return;
     }
 
+    // only the texts and the scaled graphics need a complete reload, a new video mode is applied to the existing window
+    const int oldPhysicalWidth = settings.video.physicalWidth;
+    const int oldPhysicalHeight = settings.video.physicalHeight;
+    const bool bOldFullscreen = settings.video.fullscreen;
+    const std::string oldLanguage = settings.general.language;
+    const std::string oldScaler = settings.video.scaler;
+
     settings.general.playerName = playername;
     std::string languageFilename = (languageDropDownBox.getSelectedEntryIntData() < 0) ? "English.en.po" : availLanguages[languageDropDownBox.getSelectedEntryIntData()];
     settings.general.language = languageFilename.substr(languageFilename.size()-5,2);
@@ -334,7 +341,15 @@ void OptionsMenu::onOptionsOK() {
         musicPlayer->changeMusic(MUSIC_INTRO);
     }
 
-    quit(MENU_QUIT_REINITIALIZE);
+    if((settings.general.language != oldLanguage) || (settings.video.scaler != oldScaler)) {
+        quit(MENU_QUIT_REINITIALIZE);
+    } else if((settings.video.physicalWidth != oldPhysicalWidth) || (settings.video.physicalHeight != oldPhysicalHeight)
+                || (settings.video.fullscreen != bOldFullscreen)) {
+        changeVideoMode();
+        quit(MENU_QUIT_VIDEOMODECHANGED);
+    } else {
+        quit();
+    }
 }
 
 void OptionsMenu::onOptionsCancel() {
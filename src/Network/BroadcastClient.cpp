@@ -0,0 +1,133 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Network/BroadcastClient.h>
+
+#include <Network/BroadcastServer.h>
+#include <Network/ENetPacketIStream.h>
+
+#include <misc/exceptions.h>
+
+#include <algorithm>
+
+BroadcastClient::BroadcastClient(const std::string& hostname, int port) {
+
+    if(enet_initialize() != 0) {
+        THROW(std::runtime_error, "BroadcastClient: An error occurred while initializing ENet.");
+    }
+
+    ENetAddress address;
+    if(enet_address_set_host(&address, hostname.c_str()) < 0) {
+        enet_deinitialize();
+        THROW(std::runtime_error, "BroadcastClient: Resolving hostname '" + hostname + "' failed!");
+    }
+    address.port = port;
+
+    host = enet_host_create(nullptr, 1, 1, 0, 0);
+    if(host == nullptr) {
+        enet_deinitialize();
+        THROW(std::runtime_error, "BroadcastClient: An error occurred while trying to create a client host.");
+    }
+
+    if(enet_host_compress_with_range_coder(host) < 0) {
+        enet_host_destroy(host);
+        enet_deinitialize();
+        THROW(std::runtime_error, "BroadcastClient: Cannot activate range coder.");
+    }
+
+    serverPeer = enet_host_connect(host, &address, 1, 0);
+    if(serverPeer == nullptr) {
+        enet_host_destroy(host);
+        enet_deinitialize();
+        THROW(std::runtime_error, "BroadcastClient: No available peers for initiating a connection.");
+    }
+}
+
+BroadcastClient::~BroadcastClient() {
+    if(!bDisconnected) {
+        enet_peer_disconnect_now(serverPeer, 0);
+    }
+
+    enet_host_destroy(host);
+    enet_deinitialize();
+}
+
+void BroadcastClient::update(Uint32 timeout) {
+    if(bDisconnected) {
+        return;
+    }
+
+    ENetEvent event;
+    while(enet_host_service(host, &event, timeout) > 0) {
+        // only the first call may wait; the remaining events are already queued
+        timeout = 0;
+
+        switch(event.type) {
+            case ENET_EVENT_TYPE_CONNECT: {
+                SDL_Log("BroadcastClient: Connected to the broadcast server.");
+            } break;
+
+            case ENET_EVENT_TYPE_RECEIVE: {
+                handlePacket(event.packet);
+            } break;
+
+            case ENET_EVENT_TYPE_DISCONNECT: {
+                SDL_Log("BroadcastClient: Disconnected from the broadcast server.");
+                bDisconnected = true;
+                return;
+            } break;
+
+            default: {
+            } break;
+        }
+    }
+}
+
+void BroadcastClient::handlePacket(ENetPacket* pPacket) {
+    ENetPacketIStream packetStream(pPacket);
+
+    try {
+        Uint32 packetType = packetStream.readUint32();
+
+        switch(packetType) {
+            case BROADCASTPACKET_HEADER: {
+                std::string header = packetStream.readString();
+
+                if(pOnReceiveHeader) {
+                    pOnReceiveHeader(header);
+                }
+            } break;
+
+            case BROADCASTPACKET_COMMANDS: {
+                Uint32 newAvailableCycle = packetStream.readUint32();
+                std::string commands = packetStream.readString();
+
+                availableCycle = std::max(availableCycle, newAvailableCycle);
+
+                if(pOnReceiveCommands) {
+                    pOnReceiveCommands(availableCycle, commands);
+                }
+            } break;
+
+            default: {
+                SDL_Log("BroadcastClient: Received unknown packet of type %d.", packetType);
+            } break;
+        }
+    } catch (InputStream::eof&) {
+        SDL_Log("BroadcastClient: Received packet is too small");
+    }
+}
@@ -0,0 +1,235 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Network/BroadcastServer.h>
+
+#include <Network/ENetHelper.h>
+#include <Network/ENetPacketOStream.h>
+
+#include <misc/exceptions.h>
+
+#include <algorithm>
+
+BroadcastServer::BroadcastServer(int port, Uint32 delay) : delay(delay) {
+
+    if(enet_initialize() != 0) {
+        THROW(std::runtime_error, "BroadcastServer: An error occurred while initializing ENet.");
+    }
+
+    ENetAddress address;
+    address.host = ENET_HOST_ANY;
+    address.port = port;
+
+    host = enet_host_create(&address, BROADCAST_MAX_SPECTATORS, 1, 0, 0);
+    if(host == nullptr) {
+        enet_deinitialize();
+        THROW(std::runtime_error, "BroadcastServer: An error occurred while trying to create a server host on port %d.", port);
+    }
+
+    if(enet_host_compress_with_range_coder(host) < 0) {
+        enet_host_destroy(host);
+        enet_deinitialize();
+        THROW(std::runtime_error, "BroadcastServer: Cannot activate range coder.");
+    }
+
+    SDL_Log("BroadcastServer: Broadcasting on port %d with a delay of %d game cycles.", port, delay);
+}
+
+BroadcastServer::~BroadcastServer() {
+    enet_host_destroy(host);
+    enet_deinitialize();
+}
+
+void BroadcastServer::setHeader(const std::string& header) {
+    this->header = header;
+    bHeaderSet = true;
+}
+
+void BroadcastServer::addCommands(Uint32 cycle, const std::string& data) {
+    if(cycle < availableCycle) {
+        // already old enough (e.g. when relaying a broadcast)
+        releasedCommands += data;
+    } else {
+        pendingCommands.emplace_back(cycle, data);
+    }
+}
+
+void BroadcastServer::update(Uint32 gameCycle) {
+    if(gameCycle > delay) {
+        releaseCommands(gameCycle - delay);
+    }
+
+    serviceHost();
+
+    if(SDL_GetTicks() - lastSendTime >= BROADCAST_SEND_INTERVAL) {
+        sendCommands();
+    }
+
+    enet_host_flush(host);
+}
+
+void BroadcastServer::finish(Uint32 gameCycle) {
+    releaseCommands(gameCycle);
+    serviceHost();
+    sendCommands();
+
+    for(ENetPeer* pPeer : awaitingHeaderList) {
+        enet_peer_disconnect_later(pPeer, 0);
+    }
+
+    for(ENetPeer* pPeer : spectatorList) {
+        enet_peer_disconnect_later(pPeer, 0);
+    }
+
+    // the game has ended, so waiting for the spectators to receive the last commands delays nobody
+    const Uint32 startTime = SDL_GetTicks();
+    ENetEvent event;
+    while((!awaitingHeaderList.empty() || !spectatorList.empty()) && (SDL_GetTicks() - startTime < BROADCAST_FINISH_TIMEOUT)) {
+        if(enet_host_service(host, &event, 10) > 0) {
+            if(event.type == ENET_EVENT_TYPE_RECEIVE) {
+                enet_packet_destroy(event.packet);
+            } else if(event.type == ENET_EVENT_TYPE_DISCONNECT) {
+                awaitingHeaderList.remove(event.peer);
+                spectatorList.remove(event.peer);
+            }
+        }
+    }
+}
+
+void BroadcastServer::releaseCommands(Uint32 newAvailableCycle) {
+    if(newAvailableCycle <= availableCycle) {
+        return;
+    }
+
+    // keep the order of the recorded stream; spectators schedule each command by its own game cycle anyway
+    auto iter = std::stable_partition(pendingCommands.begin(), pendingCommands.end(),
+                                      [newAvailableCycle](const std::pair<Uint32, std::string>& commands) {
+                                        return (commands.first < newAvailableCycle);
+                                      });
+
+    for(auto releaseIter = pendingCommands.begin(); releaseIter != iter; ++releaseIter) {
+        releasedCommands += releaseIter->second;
+    }
+    pendingCommands.erase(pendingCommands.begin(), iter);
+
+    availableCycle = newAvailableCycle;
+}
+
+void BroadcastServer::serviceHost() {
+    ENetEvent event;
+    while(enet_host_service(host, &event, 0) > 0) {
+        switch(event.type) {
+            case ENET_EVENT_TYPE_CONNECT: {
+                SDL_Log("BroadcastServer: Spectator %s:%d connected.", Address2String(event.peer->address).c_str(), event.peer->address.port);
+                awaitingHeaderList.push_back(event.peer);
+            } break;
+
+            case ENET_EVENT_TYPE_RECEIVE: {
+                // spectators have nothing to tell
+                enet_packet_destroy(event.packet);
+            } break;
+
+            case ENET_EVENT_TYPE_DISCONNECT: {
+                SDL_Log("BroadcastServer: Spectator %s:%d disconnected.", Address2String(event.peer->address).c_str(), event.peer->address.port);
+                awaitingHeaderList.remove(event.peer);
+                spectatorList.remove(event.peer);
+            } break;
+
+            default: {
+            } break;
+        }
+    }
+
+    if(bHeaderSet) {
+        for(ENetPeer* pPeer : awaitingHeaderList) {
+            sendStreamTo(pPeer);
+            spectatorList.push_back(pPeer);
+        }
+        awaitingHeaderList.clear();
+    }
+}
+
+void BroadcastServer::sendCommands() {
+    lastSendTime = SDL_GetTicks();
+
+    if((numSentBytes == releasedCommands.size()) && (sentAvailableCycle == availableCycle)) {
+        return;
+    }
+
+    // a spectator that cannot keep up would make ENet queue more and more data; it has to reconnect and start over
+    auto iter = spectatorList.begin();
+    while(iter != spectatorList.end()) {
+        ENetPeer* pPeer = *iter;
+        if(enet_list_size(&pPeer->outgoingReliableCommands) > BROADCAST_MAX_QUEUED_COMMANDS) {
+            SDL_Log("BroadcastServer: Spectator %s:%d is too slow and gets disconnected.", Address2String(pPeer->address).c_str(), pPeer->address.port);
+            enet_peer_disconnect(pPeer, 0);
+            iter = spectatorList.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+
+    const Uint32 length = releasedCommands.size() - numSentBytes;
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE, 3*sizeof(Uint32) + length);
+    packetStream.writeUint32(BROADCASTPACKET_COMMANDS);
+    packetStream.writeUint32(availableCycle);
+    packetStream.writeString(releasedCommands.substr(numSentBytes));
+
+    ENetPacket* enetPacket = packetStream.getPacket();
+
+    for(ENetPeer* pPeer : spectatorList) {
+        if(enet_peer_send(pPeer, 0, enetPacket) < 0) {
+            SDL_Log("BroadcastServer: Cannot send packet!");
+        }
+    }
+
+    if(enetPacket->referenceCount == 0) {
+        enet_packet_destroy(enetPacket);
+    }
+
+    numSentBytes = releasedCommands.size();
+    sentAvailableCycle = availableCycle;
+}
+
+void BroadcastServer::sendStreamTo(ENetPeer* peer) {
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE, 2*sizeof(Uint32) + header.size());
+    packetStream.writeUint32(BROADCASTPACKET_HEADER);
+    packetStream.writeString(header);
+
+    ENetPacket* enetPacket = packetStream.getPacket();
+    if(enet_peer_send(peer, 0, enetPacket) < 0) {
+        SDL_Log("BroadcastServer: Cannot send packet!");
+        enet_packet_destroy(enetPacket);
+        return;
+    }
+
+    // catch up to the other spectators; everything newer is sent to all of them together
+    sendCommandsTo(peer, sentAvailableCycle, releasedCommands.substr(0, numSentBytes));
+}
+
+void BroadcastServer::sendCommandsTo(ENetPeer* peer, Uint32 cycle, const std::string& data) {
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE, 3*sizeof(Uint32) + data.size());
+    packetStream.writeUint32(BROADCASTPACKET_COMMANDS);
+    packetStream.writeUint32(cycle);
+    packetStream.writeString(data);
+
+    ENetPacket* enetPacket = packetStream.getPacket();
+    if(enet_peer_send(peer, 0, enetPacket) < 0) {
+        SDL_Log("BroadcastServer: Cannot send packet!");
+        enet_packet_destroy(enetPacket);
+    }
+}
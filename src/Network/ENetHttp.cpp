@@ -20,8 +20,11 @@
 #include <Network/ENetHelper.h>
 
 #include <misc/exceptions.h>
+#include <misc/string_util.h>
 
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <stdio.h>
 #include <enet/enet.h>
 
@@ -93,12 +96,24 @@ std::string percentEncode(const std::string & s) {
 }
 
 
-std::string loadFromHttp(const std::string& url, const std::map<std::string, std::string>& parameters) {
+std::string getFilePathWithQuery(const std::string& url, const std::map<std::string, std::string>& parameters) {
+    std::string filepath = getFilePathFromURL(url);
+
+    for(const auto& param : parameters) {
+        if(filepath.find_first_of('?') == std::string::npos) {
+            // first parameter
+            filepath += "?";
+        } else {
+            filepath += "&";
+        }
 
-    std::string domain = getDomainFromURL(url);
+        filepath += percentEncode(param.first) + "=" + percentEncode(param.second);
+    }
 
-    std::string filepath = getFilePathFromURL(url);
+    return filepath;
+}
 
+static unsigned short getValidPortFromURL(const std::string& url) {
     int port = getPortFromURL(url);
 
     if(port < 0 || port > 65535) {
@@ -109,21 +124,71 @@ std::string loadFromHttp(const std::string& url, const std::map<std::string, std
         port = PORT_HTTP;
     }
 
-    for(const auto& param : parameters) {
-        if(filepath.find_first_of('?') == std::string::npos) {
-            // first parameter
-            filepath += "?";
-        } else {
-            filepath += "&";
+    return (unsigned short) port;
+}
+
+std::string loadFromHttp(const std::string& url, const std::map<std::string, std::string>& parameters) {
+    return loadFromHttp(getDomainFromURL(url), getFilePathWithQuery(url, parameters), getValidPortFromURL(url));
+}
+
+std::string loadFromHttp(const std::string& domain, const std::string& filepath, unsigned short port) {
+    HttpConnection httpConnection(domain, port);
+    return httpConnection.get(filepath);
+}
+
+
+HttpConnection::HttpConnection(const std::string& domain, unsigned short port)
+ : domain(domain), port(port), httpSocket(ENET_SOCKET_NULL) {
+}
+
+HttpConnection::HttpConnection(const std::string& url)
+ : HttpConnection(getDomainFromURL(url), getValidPortFromURL(url)) {
+}
+
+HttpConnection::~HttpConnection() {
+    close();
+}
+
+std::string HttpConnection::get(const std::string& filepath) {
+    const std::string newline = "\x0D\x0A";
+    const std::string request = "GET " + filepath + " HTTP/1.1" + newline + "Host: " + domain + newline + "Connection: keep-alive" + newline + newline;
+
+    while(true) {
+        const bool bReusedConnection = (httpSocket != ENET_SOCKET_NULL);
+        if(!bReusedConnection) {
+            open();
         }
 
-        filepath += percentEncode(param.first) + "=" + percentEncode(param.second);
+        ENetBuffer sendBuffer;
+        memset(&sendBuffer, 0, sizeof(sendBuffer));
+        sendBuffer.data = (void*) request.c_str();
+        sendBuffer.dataLength = request.size();
+
+        if((enet_socket_send(httpSocket, nullptr, &sendBuffer, 1) < 0) || !receive()) {
+            close();
+
+            if(bReusedConnection) {
+                // the server closed the kept-alive connection in the meantime => try again with a new one
+                continue;
+            }
+
+            THROW(std::runtime_error, "Error while sending HTTP request to '" + domain + "'");
+        }
+
+        return receiveResponse();
+    }
+}
+
+void HttpConnection::close() {
+    if(httpSocket != ENET_SOCKET_NULL) {
+        enet_socket_destroy(httpSocket);
+        httpSocket = ENET_SOCKET_NULL;
     }
 
-    return loadFromHttp(domain, filepath, (unsigned short) port);
+    receiveBuffer.clear();
 }
 
-std::string loadFromHttp(const std::string& domain, const std::string& filepath, unsigned short port) {
+void HttpConnection::open() {
     ENetAddress address;
     if(enet_address_set_host(&address, domain.c_str()) < 0) {
         THROW(std::runtime_error, "Cannot resolve '" + domain + "'");
@@ -131,65 +196,152 @@ std::string loadFromHttp(const std::string& domain, const std::string& filepath,
 
     address.port = port;
 
-    ENetSocket httpSocket = enet_socket_create(ENET_SOCKET_TYPE_STREAM);
+    httpSocket = enet_socket_create(ENET_SOCKET_TYPE_STREAM);
     if(httpSocket == ENET_SOCKET_NULL) {
         THROW(std::runtime_error, "Unable to create socket");
     }
 
     if(enet_socket_connect(httpSocket, &address) < 0) {
+        close();
         THROW(std::runtime_error, "Unable to connect to '" + domain + "'");
     }
+}
 
+/**
+    Receives the next data into receiveBuffer (throws a std::runtime_error on error or timeout)
+    \return false if the server closed the connection
+*/
+bool HttpConnection::receive() {
+    enet_uint32 waitCondition = ENET_SOCKET_WAIT_RECEIVE;
+    if((enet_socket_wait(httpSocket, &waitCondition, HTTP_TIMEOUT) < 0) || !(waitCondition & ENET_SOCKET_WAIT_RECEIVE)) {
+        close();
+        THROW(std::runtime_error, "Timeout while receiving from '" + domain + "'");
+    }
 
-    const std::string newline = "\x0D\x0A";
-    const std::string doubleNewline = newline + newline;
-    std::string request = "GET " + filepath + " HTTP/1.0" + newline + "Host: " + domain + doubleNewline;
+    char resultBuffer[4096];
 
-    ENetBuffer sendBuffer;
-    memset(&sendBuffer, 0, sizeof(sendBuffer));
-    sendBuffer.data = (void*) request.c_str();
-    sendBuffer.dataLength = request.size();
+    ENetBuffer buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.data = resultBuffer;
+    buffer.dataLength = sizeof(resultBuffer);
 
-    if(enet_socket_send(httpSocket, nullptr, &sendBuffer, 1) < 0) {
-        THROW(std::runtime_error, "Error while sending HTTP request to '" + domain + "'");
+    int receiveLength = enet_socket_receive(httpSocket, nullptr, &buffer, 1);
+
+    if(receiveLength < 0) {
+        close();
+        THROW(std::runtime_error, "Error while receiving from '" + domain + "'");
     }
 
-    std::string result;
+    receiveBuffer.append(resultBuffer, receiveLength);
 
-    char resultBuffer[1024];
+    return (receiveLength > 0);
+}
 
-    while(true) {
+std::string HttpConnection::receiveResponse() {
+    const std::string newline = "\x0D\x0A";
+    const std::string doubleNewline = newline + newline;
 
-        ENetBuffer receiveBuffer;
-        memset(&receiveBuffer, 0, sizeof(sendBuffer));
-        receiveBuffer.data = resultBuffer;
-        receiveBuffer.dataLength = sizeof(resultBuffer);
+    auto receiveMore = [this]() {
+        if(!receive()) {
+            close();
+            THROW(std::runtime_error, "Incomplete response from '" + domain + "'");
+        }
+    };
 
-        int receiveLength = enet_socket_receive(httpSocket, nullptr, &receiveBuffer, 1);
+    size_t headerEnd;
+    while((headerEnd = receiveBuffer.find(doubleNewline)) == std::string::npos) {
+        receiveMore();
+    }
 
-        if(receiveLength < 0) {
-            THROW(std::runtime_error, "Error while receiving from '" + domain + "'");
-        }
+    const std::string header = receiveBuffer.substr(0, headerEnd);
+    receiveBuffer.erase(0, headerEnd + doubleNewline.length());
 
-        result.append(resultBuffer, receiveLength);
+    const std::string statusLine = header.substr(0, header.find(newline));
+    const std::string statusCode = (statusLine.size() >= 12) ? statusLine.substr(9,3) : "";
 
-        if((size_t) receiveLength < sizeof(resultBuffer)) {
-            break;
+    bool bKeepAlive = (statusLine.substr(0,8) == "HTTP/1.1");
+    bool bChunked = false;
+    bool bContentLength = false;
+    size_t contentLength = 0;
+
+    for(const std::string& line : splitStringToStringVector(header.substr(std::min(statusLine.size() + newline.length(), header.size())), newline)) {
+        const size_t colon = line.find(':');
+        if(colon == std::string::npos) {
+            continue;
         }
 
+        const std::string name = strToLower(trim(line.substr(0, colon)));
+        const std::string value = strToLower(trim(line.substr(colon + 1)));
+
+        if(name == "content-length") {
+            bContentLength = parseString(value, contentLength);
+        } else if(name == "transfer-encoding") {
+            bChunked = (value.find("chunked") != std::string::npos);
+        } else if(name == "connection") {
+            if(value == "close") {
+                bKeepAlive = false;
+            } else if(value == "keep-alive") {
+                bKeepAlive = true;
+            }
+        }
     }
 
-    enet_socket_destroy(httpSocket);
+    std::string content;
+
+    if(bChunked) {
+        while(true) {
+            size_t lineEnd;
+            while((lineEnd = receiveBuffer.find(newline)) == std::string::npos) {
+                receiveMore();
+            }
+
+            const size_t chunkSize = strtoul(receiveBuffer.c_str(), nullptr, 16);
+            receiveBuffer.erase(0, lineEnd + newline.length());
+
+            if(chunkSize == 0) {
+                // skip the trailer up to the empty line
+                while((lineEnd = receiveBuffer.find(newline)) != 0) {
+                    if(lineEnd == std::string::npos) {
+                        receiveMore();
+                    } else {
+                        receiveBuffer.erase(0, lineEnd + newline.length());
+                    }
+                }
+                receiveBuffer.erase(0, newline.length());
+                break;
+            }
+
+            while(receiveBuffer.size() < chunkSize + newline.length()) {
+                receiveMore();
+            }
+
+            content.append(receiveBuffer, 0, chunkSize);
+            receiveBuffer.erase(0, chunkSize + newline.length());
+        }
+    } else if(bContentLength) {
+        while(receiveBuffer.size() < contentLength) {
+            receiveMore();
+        }
+
+        content = receiveBuffer.substr(0, contentLength);
+        receiveBuffer.erase(0, contentLength);
+    } else {
+        // the end of the content is only marked by closing the connection
+        while(receive()) {
+            ;
+        }
 
-    if(result.substr(9,3) != "200") {
-        THROW(std::runtime_error, "Server Error: Received status code '" + result.substr(9,3) + "' from " + domain + ": " + result.substr(0, result.find(newline)));
+        content.swap(receiveBuffer);
+        bKeepAlive = false;
     }
 
-    size_t contentStart = result.find(doubleNewline);
+    if(!bKeepAlive) {
+        close();
+    }
 
-    std::string content = result.substr(contentStart + doubleNewline.length());
+    if(statusCode != "200") {
+        THROW(std::runtime_error, "Server Error: Received status code '" + statusCode + "' from " + domain + ": " + statusLine);
+    }
 
     return content;
 }
-
-
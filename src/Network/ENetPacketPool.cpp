@@ -0,0 +1,141 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Network/ENetPacketPool.h>
+
+#include <misc/exceptions.h>
+
+#include <cstdint>
+#include <cstring>
+
+/**
+    Gets the size class of a buffer that can hold bufferSize bytes.
+    \param  bufferSize  the needed size
+    \return the size class or ENETPACKETPOOL_NUM_SIZECLASSES if the buffer is too big to be pooled
+*/
+static int getSizeClass(size_t bufferSize) {
+    int sizeClass = 0;
+    while((sizeClass < ENETPACKETPOOL_NUM_SIZECLASSES) && (((size_t) ENETPACKETPOOL_MIN_BUFFERSIZE << sizeClass) < bufferSize)) {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+/**
+    Gets the real size of a buffer that can hold bufferSize bytes.
+    \param  bufferSize  the needed size
+    \return the size of the buffer that will be allocated
+*/
+static size_t getRoundedBufferSize(size_t bufferSize) {
+    int sizeClass = getSizeClass(bufferSize);
+    return (sizeClass < ENETPACKETPOOL_NUM_SIZECLASSES) ? ((size_t) ENETPACKETPOOL_MIN_BUFFERSIZE << sizeClass) : bufferSize;
+}
+
+ENetPacketPool::ENetPacketPool() {
+    mutex = SDL_CreateMutex();
+    if(mutex == nullptr) {
+        THROW(std::runtime_error, "ENetPacketPool: Unable to create mutex.");
+    }
+}
+
+ENetPacketPool::~ENetPacketPool() {
+    for(std::vector<enet_uint8*>& buffers : freeBuffers) {
+        for(enet_uint8* pBuffer : buffers) {
+            enet_free(pBuffer);
+        }
+    }
+
+    SDL_DestroyMutex(mutex);
+}
+
+ENetPacketPool& ENetPacketPool::getInstance() {
+    static ENetPacketPool packetPool;
+    return packetPool;
+}
+
+ENetPacket* ENetPacketPool::createPacket(size_t sizeHint, enet_uint32 flags) {
+    size_t bufferSize = getRoundedBufferSize(sizeHint);
+
+    ENetPacketPool& packetPool = getInstance();
+    enet_uint8* pBuffer = packetPool.allocateBuffer(getSizeClass(bufferSize), bufferSize);
+    if(pBuffer == nullptr) {
+        return nullptr;
+    }
+
+    ENetPacket* pPacket = enet_packet_create(pBuffer, bufferSize, flags | ENET_PACKET_FLAG_NO_ALLOCATE);
+    if(pPacket == nullptr) {
+        packetPool.releaseBuffer(pBuffer, getSizeClass(bufferSize));
+        return nullptr;
+    }
+
+    pPacket->userData = reinterpret_cast<void*>((uintptr_t) bufferSize);
+    pPacket->freeCallback = freePacket;
+    return pPacket;
+}
+
+bool ENetPacketPool::growPacket(ENetPacket* pPacket, size_t minBufferSize, size_t usedSize) {
+    size_t oldBufferSize = getBufferSize(pPacket);
+    size_t newBufferSize = getRoundedBufferSize(minBufferSize);
+
+    ENetPacketPool& packetPool = getInstance();
+    enet_uint8* pNewBuffer = packetPool.allocateBuffer(getSizeClass(newBufferSize), newBufferSize);
+    if(pNewBuffer == nullptr) {
+        return false;
+    }
+
+    memcpy(pNewBuffer, pPacket->data, usedSize);
+    packetPool.releaseBuffer(pPacket->data, getSizeClass(oldBufferSize));
+
+    pPacket->data = pNewBuffer;
+    pPacket->dataLength = newBufferSize;
+    pPacket->userData = reinterpret_cast<void*>((uintptr_t) newBufferSize);
+    return true;
+}
+
+size_t ENetPacketPool::getBufferSize(const ENetPacket* pPacket) {
+    return (size_t) reinterpret_cast<uintptr_t>(pPacket->userData);
+}
+
+void ENET_CALLBACK ENetPacketPool::freePacket(ENetPacket* pPacket) {
+    getInstance().releaseBuffer(pPacket->data, getSizeClass(getBufferSize(pPacket)));
+    pPacket->data = nullptr;
+}
+
+enet_uint8* ENetPacketPool::allocateBuffer(int sizeClass, size_t bufferSize) {
+    if(sizeClass < ENETPACKETPOOL_NUM_SIZECLASSES) {
+        sdl2::mutex_lock lock(mutex);
+        if(!freeBuffers[sizeClass].empty()) {
+            enet_uint8* pBuffer = freeBuffers[sizeClass].back();
+            freeBuffers[sizeClass].pop_back();
+            return pBuffer;
+        }
+    }
+
+    return static_cast<enet_uint8*>(enet_malloc(bufferSize));
+}
+
+void ENetPacketPool::releaseBuffer(enet_uint8* pBuffer, int sizeClass) {
+    if(sizeClass < ENETPACKETPOOL_NUM_SIZECLASSES) {
+        sdl2::mutex_lock lock(mutex);
+        if(freeBuffers[sizeClass].size() < ENETPACKETPOOL_MAX_FREEBUFFERS) {
+            freeBuffers[sizeClass].push_back(pBuffer);
+            return;
+        }
+    }
+
+    enet_free(pBuffer);
+}
@@ -124,11 +124,14 @@ void LANGameFinderAndAnnouncer::update() {
     receivePackets();
 }
 
-void LANGameFinderAndAnnouncer::announceGame() {
+void LANGameFinderAndAnnouncer::announceGame(const ENetAddress* pDestinationAddress) {
 
     ENetAddress destinationAddress;
     destinationAddress.host = ENET_HOST_BROADCAST;
     destinationAddress.port = LANGAME_ANNOUNCER_PORT;
+    if(pDestinationAddress != nullptr) {
+        destinationAddress = *pDestinationAddress;
+    }
 
     NetworkPacket_AnnounceGame announcePacket;
     memset(&announcePacket, 0, sizeof(NetworkPacket_AnnounceGame));
@@ -150,7 +153,7 @@ void LANGameFinderAndAnnouncer::announceGame() {
         // blocked
     } else if(err < 0) {
         THROW(std::runtime_error, "LANGameFinderAndAnnouncer: Announcing failed!");
-    } else {
+    } else if(pDestinationAddress == nullptr) {
         lastAnnounce = SDL_GetTicks();
     }
 }
@@ -179,6 +182,19 @@ void LANGameFinderAndAnnouncer::refreshServerList() const {
 }
 
 void LANGameFinderAndAnnouncer::receivePackets() {
+    // process everything received since the last update, so the server list is complete right after the first answers
+    for(int i = 0; i < LANGAME_ANNOUNCER_MAXPACKETSPERUPDATE; i++) {
+        if(receivePacket() == false) {
+            break;
+        }
+    }
+}
+
+/**
+    Receives and processes one packet
+    \return false if there was no packet to receive
+*/
+bool LANGameFinderAndAnnouncer::receivePacket() {
     NetworkPacket_AnnounceGame announcePacket;
 
     ENetAddress senderAddress;
@@ -189,6 +205,7 @@ void LANGameFinderAndAnnouncer::receivePackets() {
     int receivedBytes = enet_socket_receive(announceSocket, &senderAddress, &enetBuffer, 1);
     if(receivedBytes==0) {
         // blocked
+        return false;
     } else if(receivedBytes < 0) {
         THROW(std::runtime_error, "LANGameFinderAndAnnouncer: Receiving data failed!");
     } else {
@@ -217,19 +234,22 @@ void LANGameFinderAndAnnouncer::receivePackets() {
             gameServerInfo.bPasswordProtected = false;
             gameServerInfo.lastUpdate = SDL_GetTicks();
 
-            bool bUpdate = false;
+            bool bFound = false;
+            bool bChanged = false;
             for(GameServerInfo& curGameServerInfo : gameServerInfoList) {
                 if((curGameServerInfo.serverAddress.host == gameServerInfo.serverAddress.host)
                     && (curGameServerInfo.serverAddress.port == gameServerInfo.serverAddress.port)) {
+                    // keep-alive announcements and answers to other requests only refresh the expiry time
+                    bChanged = !((curGameServerInfo == gameServerInfo) && (curGameServerInfo.numPlayers == gameServerInfo.numPlayers));
                     curGameServerInfo = gameServerInfo;
-                    bUpdate = true;
+                    bFound = true;
                     break;
                 }
 
             }
 
-            if(bUpdate) {
-                if(pOnUpdateServer) {
+            if(bFound) {
+                if(bChanged && pOnUpdateServer) {
                     pOnUpdateServer(gameServerInfo);
                 }
             } else {
@@ -263,10 +283,13 @@ void LANGameFinderAndAnnouncer::receivePackets() {
             && (SDL_SwapLE32(announcePacket.magicNumber) == LANGAME_ANNOUNCER_MAGICNUMBER)
             && (announcePacket.type == NETWORKPACKET_REQUESTANNOUNCE)) {
 
-            announceGame();
+            // answer immediately and only to the requesting computer
+            announceGame(&senderAddress);
         }
 
     }
+
+    return true;
 }
 
 void LANGameFinderAndAnnouncer::updateServerInfoList() {
@@ -274,7 +297,7 @@ void LANGameFinderAndAnnouncer::updateServerInfoList() {
 
     std::list<GameServerInfo>::iterator iter = gameServerInfoList.begin();
     while(iter != gameServerInfoList.end()) {
-        if(iter->lastUpdate + 3 * LANGAME_ANNOUNCER_INTERVAL < currentTime) {
+        if(iter->lastUpdate + LANGAME_ANNOUNCER_EXPIRY_TIME < currentTime) {
             if(pOnRemoveServer) {
                 pOnRemoveServer(*iter);
             }
@@ -21,6 +21,7 @@
 
 #include <misc/string_util.h>
 #include <misc/exceptions.h>
+#include <misc/Tracing.h>
 #include <mmath.h>
 
 #include <config.h>
@@ -28,24 +29,29 @@
 #include <sstream>
 #include <iostream>
 #include <map>
+#include <algorithm>
 
 
 MetaServerClient::MetaServerClient(const std::string& metaServerURL)
  : metaServerURL(metaServerURL) {
 
-    availableMetaServerCommandsSemaphore = SDL_CreateSemaphore(0);
-    if(availableMetaServerCommandsSemaphore == nullptr) {
-        THROW(std::runtime_error, "Unable to create semaphore");
-    }
-
     sharedDataMutex = SDL_CreateMutex();
     if(sharedDataMutex == nullptr) {
         THROW(std::runtime_error, "Unable to create mutex");
     }
 
-    connectionThread = SDL_CreateThread(connectionThreadMain, nullptr, (void*) this);
-    if(connectionThread == nullptr) {
-        THROW(std::runtime_error, "Unable to create thread");
+    for(Connection& connection : connections) {
+        connection.pMetaServerClient = this;
+
+        connection.availableMetaServerCommandsSemaphore = SDL_CreateSemaphore(0);
+        if(connection.availableMetaServerCommandsSemaphore == nullptr) {
+            THROW(std::runtime_error, "Unable to create semaphore");
+        }
+
+        connection.connectionThread = SDL_CreateThread(connectionThreadMain, nullptr, (void*) &connection);
+        if(connection.connectionThread == nullptr) {
+            THROW(std::runtime_error, "Unable to create thread");
+        }
     }
 }
 
@@ -54,13 +60,33 @@ MetaServerClient::~MetaServerClient() {
 
     stopAnnounce();
 
-    enqueueMetaServerCommand(std::make_unique<MetaServerExit>());
+    for(Connection& connection : connections) {
+        enqueueMetaServerCommand(connection, std::make_unique<MetaServerExit>());
+    }
 
-    SDL_WaitThread(connectionThread, nullptr);
+    for(Connection& connection : connections) {
+        SDL_WaitThread(connection.connectionThread, nullptr);
+        SDL_DestroySemaphore(connection.availableMetaServerCommandsSemaphore);
+    }
 
     SDL_DestroyMutex(sharedDataMutex);
+}
+
+
+void MetaServerClient::setOnGameServerInfoList(std::function<void (std::list<GameServerInfo>&)> pOnGameServerInfoList) {
+    this->pOnGameServerInfoList = pOnGameServerInfoList;
+    lastServerInfoListUpdate = 0;
+
+    if(pOnGameServerInfoList) {
+        SDL_LockMutex(sharedDataMutex);
 
-    SDL_DestroySemaphore(availableMetaServerCommandsSemaphore);
+        // show the cached list until the new one is received
+        if((gameServerInfoListTime != 0) && (SDL_GetTicks() - gameServerInfoListTime < SERVERLIST_CACHE_TTL)) {
+            bUpdatedGameServerInfoList = true;
+        }
+
+        SDL_UnlockMutex(sharedDataMutex);
+    }
 }
 
 
@@ -157,40 +183,49 @@ void MetaServerClient::update() {
 
 
 void MetaServerClient::enqueueMetaServerCommand(std::unique_ptr<MetaServerCommand> metaServerCommand) {
+    const int connectionIndex = (metaServerCommand->type == METASERVERCOMMAND_LIST) ? METASERVERCONNECTION_LIST : METASERVERCONNECTION_ANNOUNCE;
+
+    enqueueMetaServerCommand(connections[connectionIndex], std::move(metaServerCommand));
+}
+
+
+void MetaServerClient::enqueueMetaServerCommand(Connection& connection, std::unique_ptr<MetaServerCommand> metaServerCommand) {
 
     SDL_LockMutex(sharedDataMutex);
 
     bool bInsert = true;
 
-    for(const auto& pMetaServerCommand : metaServerCommandList) {
-        if(*pMetaServerCommand == *metaServerCommand) {
+    for(auto& pMetaServerCommand : connection.metaServerCommandList) {
+        if(metaServerCommand->supersedes(*pMetaServerCommand)) {
+            // replace the queued command at its position
+            pMetaServerCommand = std::move(metaServerCommand);
             bInsert = false;
             break;
         }
     }
 
     if(bInsert == true) {
-        metaServerCommandList.push_back(std::move(metaServerCommand));
+        connection.metaServerCommandList.push_back(std::move(metaServerCommand));
     }
 
     SDL_UnlockMutex(sharedDataMutex);
 
     if(bInsert == true) {
-        SDL_SemPost(availableMetaServerCommandsSemaphore);
+        SDL_SemPost(connection.availableMetaServerCommandsSemaphore);
     }
 }
 
 
-std::unique_ptr<MetaServerCommand> MetaServerClient::dequeueMetaServerCommand() {
+std::unique_ptr<MetaServerCommand> MetaServerClient::dequeueMetaServerCommand(Connection& connection) {
 
-    while(SDL_SemWait(availableMetaServerCommandsSemaphore) != 0) {
+    while(SDL_SemWait(connection.availableMetaServerCommandsSemaphore) != 0) {
         ;   // try again in case of error
     }
 
     SDL_LockMutex(sharedDataMutex);
 
-    std::unique_ptr<MetaServerCommand> nextMetaServerCommand = std::move(metaServerCommandList.front());
-    metaServerCommandList.pop_front();
+    std::unique_ptr<MetaServerCommand> nextMetaServerCommand = std::move(connection.metaServerCommandList.front());
+    connection.metaServerCommandList.pop_front();
 
     SDL_UnlockMutex(sharedDataMutex);
 
@@ -211,21 +246,50 @@ void MetaServerClient::setErrorMessage(int errorCause, const std::string& errorM
 
 
 void MetaServerClient::setNewGameServerInfoList(const std::list<GameServerInfo>& newGameServerInfoList) {
+    // GameServerInfo::operator== ignores the fields that change while a game is set up
+    auto isSameGameServerInfo = [](const GameServerInfo& gameServerInfo1, const GameServerInfo& gameServerInfo2) {
+        return ((gameServerInfo1 == gameServerInfo2)
+                 && (gameServerInfo1.serverVersion == gameServerInfo2.serverVersion)
+                 && (gameServerInfo1.numPlayers == gameServerInfo2.numPlayers)
+                 && (gameServerInfo1.bPasswordProtected == gameServerInfo2.bPasswordProtected));
+    };
+
     SDL_LockMutex(sharedDataMutex);
 
-    gameServerInfoList = newGameServerInfoList;
-    bUpdatedGameServerInfoList = true;
+    const bool bChanged = (gameServerInfoListTime == 0)
+                            || (gameServerInfoList.size() != newGameServerInfoList.size())
+                            || !std::equal(gameServerInfoList.begin(), gameServerInfoList.end(), newGameServerInfoList.begin(), isSameGameServerInfo);
+
+    gameServerInfoListTime = std::max(SDL_GetTicks(), (Uint32) 1);
+
+    if(bChanged) {
+        gameServerInfoList = newGameServerInfoList;
+        bUpdatedGameServerInfoList = true;
+    }
 
     SDL_UnlockMutex(sharedDataMutex);
 }
 
 
 int MetaServerClient::connectionThreadMain(void* data) {
-    MetaServerClient* pMetaServerClient = static_cast<MetaServerClient*>(data);
+    Connection* pConnection = static_cast<Connection*>(data);
+    MetaServerClient* pMetaServerClient = pConnection->pMetaServerClient;
+    TRACE_THREAD_NAME("MetaServerClient");
+
+    // the connection is opened with the first request and then kept open for the following ones
+    std::unique_ptr<HttpConnection> pHttpConnection;
+    auto loadFromMetaServer = [&](const std::map<std::string, std::string>& parameters) {
+        if(!pHttpConnection) {
+            pHttpConnection = std::make_unique<HttpConnection>(pMetaServerClient->metaServerURL);
+        }
+
+        return pHttpConnection->get(getFilePathWithQuery(pMetaServerClient->metaServerURL, parameters));
+    };
 
     while(true) {
         try {
-            std::unique_ptr<MetaServerCommand> nextMetaServerCommand = pMetaServerClient->dequeueMetaServerCommand();
+            std::unique_ptr<MetaServerCommand> nextMetaServerCommand = pMetaServerClient->dequeueMetaServerCommand(*pConnection);
+            TRACE_ZONE("Meta server command");
 
             switch(nextMetaServerCommand->type) {
 
@@ -251,7 +315,7 @@ int MetaServerClient::connectionThreadMain(void* data) {
                     std::string result;
 
                     try {
-                        result = loadFromHttp(pMetaServerClient->metaServerURL, parameters);
+                        result = loadFromMetaServer(parameters);
                     } catch(std::exception& e) {
                         pMetaServerClient->setErrorMessage(METASERVERCOMMAND_ADD, e.what());
                         break;
@@ -282,7 +346,7 @@ int MetaServerClient::connectionThreadMain(void* data) {
                     std::string result1;
 
                     try {
-                        result1 = loadFromHttp(pMetaServerClient->metaServerURL, parameters);
+                        result1 = loadFromMetaServer(parameters);
                     } catch(std::exception& e) {
                         pMetaServerClient->setErrorMessage(METASERVERCOMMAND_UPDATE, e.what());
                         break;
@@ -302,7 +366,7 @@ int MetaServerClient::connectionThreadMain(void* data) {
                         std::string result2;
 
                         try {
-                            result2 = loadFromHttp(pMetaServerClient->metaServerURL, parameters);
+                            result2 = loadFromMetaServer(parameters);
                         } catch(std::exception&) {
                             // adding the game again did not work => report updating error
 
@@ -337,7 +401,7 @@ int MetaServerClient::connectionThreadMain(void* data) {
                     parameters["secret"] = pMetaServerRemove->secret;
 
                     try {
-                        loadFromHttp(pMetaServerClient->metaServerURL, parameters);
+                        loadFromMetaServer(parameters);
                     } catch(std::exception& e) {
                         pMetaServerClient->setErrorMessage(METASERVERCOMMAND_REMOVE, e.what());
                         break;
@@ -353,7 +417,7 @@ int MetaServerClient::connectionThreadMain(void* data) {
                     std::string result;
 
                     try {
-                        result = loadFromHttp(pMetaServerClient->metaServerURL, parameters);
+                        result = loadFromMetaServer(parameters);
                     } catch(std::exception& e) {
                         pMetaServerClient->setErrorMessage(METASERVERCOMMAND_LIST, e.what());
                         break;
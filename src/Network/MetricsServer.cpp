@@ -0,0 +1,168 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Network/MetricsServer.h>
+
+#include <misc/exceptions.h>
+
+#include <algorithm>
+#include <cstring>
+
+MetricsServer::MetricsServer(int port) {
+
+    if(enet_initialize() != 0) {
+        THROW(std::runtime_error, "MetricsServer: An error occurred while initializing ENet.");
+    }
+
+    listenSocket = enet_socket_create(ENET_SOCKET_TYPE_STREAM);
+    if(listenSocket == ENET_SOCKET_NULL) {
+        enet_deinitialize();
+        THROW(std::runtime_error, "MetricsServer: Unable to create socket.");
+    }
+
+    enet_socket_set_option(listenSocket, ENET_SOCKOPT_REUSEADDR, 1);
+    enet_socket_set_option(listenSocket, ENET_SOCKOPT_NONBLOCK, 1);
+
+    ENetAddress address;
+    address.host = ENET_HOST_ANY;
+    address.port = port;
+
+    if((enet_socket_bind(listenSocket, &address) < 0) || (enet_socket_listen(listenSocket, METRICS_MAX_CLIENTS) < 0)) {
+        enet_socket_destroy(listenSocket);
+        enet_deinitialize();
+        THROW(std::runtime_error, "MetricsServer: Unable to listen on port %d.", port);
+    }
+
+    SDL_Log("MetricsServer: Serving metrics on port %d.", port);
+}
+
+MetricsServer::~MetricsServer() {
+    for(Client& client : clients) {
+        enet_socket_destroy(client.socket);
+    }
+
+    enet_socket_destroy(listenSocket);
+    enet_deinitialize();
+}
+
+void MetricsServer::update(const std::function<std::string ()>& getMetrics) {
+    acceptClients();
+
+    const Uint32 now = SDL_GetTicks();
+
+    // the metrics are generated at most once per update() for all clients that are waiting for them
+    std::string metrics;
+    bool bMetricsGenerated = false;
+
+    auto iter = clients.begin();
+    while(iter != clients.end()) {
+        Client& client = *iter;
+
+        bool bKeep = true;
+        if(client.response.empty()) {
+            if(!receiveRequest(client)) {
+                bKeep = false;
+            } else if(client.request.find("\r\n\r\n") != std::string::npos) {
+                if(!bMetricsGenerated) {
+                    metrics = getMetrics();
+                    bMetricsGenerated = true;
+                }
+
+                client.response =   "HTTP/1.0 200 OK\r\n"
+                                    "Content-Type: text/plain; version=0.0.4\r\n"
+                                    "Content-Length: " + std::to_string(metrics.size()) + "\r\n"
+                                    "Connection: close\r\n"
+                                    "\r\n" + metrics;
+            }
+        }
+
+        if(bKeep && !client.response.empty()) {
+            bKeep = sendResponse(client);
+        }
+
+        if(bKeep && (now - client.connectTime > METRICS_CLIENT_TIMEOUT)) {
+            bKeep = false;
+        }
+
+        if(bKeep) {
+            ++iter;
+        } else {
+            enet_socket_destroy(client.socket);
+            iter = clients.erase(iter);
+        }
+    }
+}
+
+void MetricsServer::acceptClients() {
+    while(clients.size() < METRICS_MAX_CLIENTS) {
+        ENetSocket clientSocket = enet_socket_accept(listenSocket, nullptr);
+        if(clientSocket == ENET_SOCKET_NULL) {
+            return;
+        }
+
+        enet_socket_set_option(clientSocket, ENET_SOCKOPT_NONBLOCK, 1);
+
+        Client client;
+        client.socket = clientSocket;
+        client.connectTime = SDL_GetTicks();
+        clients.push_back(std::move(client));
+    }
+}
+
+/**
+    Receives what the client has sent so far without waiting.
+    \param  client  the client to receive from
+    \return false if the client has to be disconnected
+*/
+bool MetricsServer::receiveRequest(Client& client) {
+    char receiveBuffer[1024];
+
+    ENetBuffer buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.data = receiveBuffer;
+    buffer.dataLength = sizeof(receiveBuffer);
+
+    const int receiveLength = enet_socket_receive(client.socket, nullptr, &buffer, 1);
+    if(receiveLength < 0) {
+        return false;
+    }
+
+    client.request.append(receiveBuffer, receiveLength);
+
+    return (client.request.size() <= METRICS_MAX_REQUESTSIZE);
+}
+
+/**
+    Sends as much of the pending response as the socket accepts without waiting.
+    \param  client  the client to send to
+    \return false if the response is sent completely or the client has to be disconnected
+*/
+bool MetricsServer::sendResponse(Client& client) {
+    ENetBuffer buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.data = &client.response[0];
+    buffer.dataLength = client.response.size();
+
+    const int sentLength = enet_socket_send(client.socket, nullptr, &buffer, 1);
+    if(sentLength < 0) {
+        return false;
+    }
+
+    client.response.erase(0, sentLength);
+
+    return !client.response.empty();
+}
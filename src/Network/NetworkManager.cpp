@@ -22,11 +22,14 @@
 #include <GameInitSettings.h>
 
 #include <misc/exceptions.h>
+#include <misc/Tracing.h>
 
 #include <globals.h>
 
 #include <stdio.h>
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
 
 NetworkManager::NetworkManager(int port, const std::string& metaserver) {
 
@@ -56,12 +59,54 @@ NetworkManager::NetworkManager(int port, const std::string& metaserver) {
         enet_deinitialize();
         throw;
     }
+
+    hostMutex = SDL_CreateMutex();
+    if(hostMutex == nullptr) {
+        enet_deinitialize();
+        THROW(std::runtime_error, "NetworkManager: Unable to create mutex.");
+    }
+
+    receivedEventsSemaphore = SDL_CreateSemaphore(0);
+    if(receivedEventsSemaphore == nullptr) {
+        SDL_DestroyMutex(hostMutex);
+        enet_deinitialize();
+        THROW(std::runtime_error, "NetworkManager: Unable to create semaphore.");
+    }
+
+    SDL_AtomicSet(&quitNetworkThread, 0);
+    networkThread = SDL_CreateThread(networkThreadMain, "Network", (void*) this);
+    if(networkThread == nullptr) {
+        SDL_DestroySemaphore(receivedEventsSemaphore);
+        SDL_DestroyMutex(hostMutex);
+        enet_deinitialize();
+        THROW(std::runtime_error, "NetworkManager: Unable to create network thread.");
+    }
 }
 
 
 NetworkManager::~NetworkManager() {
     pMetaServerClient.reset();
     pLANGameFinderAndAnnouncer.reset();
+
+    SDL_AtomicSet(&quitNetworkThread, 1);
+    SDL_WaitThread(networkThread, nullptr);
+
+    for(OutgoingPacket& outgoingPacket : outgoingPackets) {
+        if(--outgoingPacket.pPacket->referenceCount == 0) {
+            enet_packet_destroy(outgoingPacket.pPacket);
+        }
+    }
+
+    ReceivedEvent receivedEvent;
+    while(receivedEvents.pop(receivedEvent)) {
+        if(receivedEvent.event.type == ENET_EVENT_TYPE_RECEIVE) {
+            enet_packet_destroy(receivedEvent.event.packet);
+        }
+    }
+
+    SDL_DestroySemaphore(receivedEventsSemaphore);
+    SDL_DestroyMutex(hostMutex);
+
     enet_host_destroy(host);
     enet_deinitialize();
 }
@@ -78,6 +123,7 @@ void NetworkManager::startServer(bool bLANServer, const std::string& serverName,
     }
 
     bIsServer = true;
+    bGameHost = true;
     this->bLANServer = bLANServer;
     this->numPlayers = numPlayers;
     this->maxPlayers = maxPlayers;
@@ -129,18 +175,28 @@ void NetworkManager::connect(const std::string& hostname, int port, const std::s
 void NetworkManager::connect(ENetAddress address, const std::string& playerName) {
     debugNetwork("Connecting to %s:%d\n", Address2String(address).c_str(), address.port);
 
+    sdl2::mutex_lock lock(hostMutex);
+
     connectPeer = enet_host_connect(host, &address, 2, 0);
     if(connectPeer == nullptr) {
         THROW(std::runtime_error, "NetworkManager: No available peers for initiating a connection.");
     }
 
     this->playerName = playerName;
+    bGameHost = false;
+    bRejoining = false;
+    receivedSnapshot.clear();
 
     connectPeer->data = new PeerData(connectPeer, PeerData::PeerState::WaitingForConnect);
     awaitingConnectionList.push_back(connectPeer);
 }
 
 void NetworkManager::disconnect() {
+    // the queued packets (e.g. the last command list) shall arrive before the disconnect
+    flush();
+
+    sdl2::mutex_lock lock(hostMutex);
+
     for(ENetPeer* pAwaitingConnectionPeer : awaitingConnectionList) {
         enet_peer_disconnect_later(pAwaitingConnectionPeer, NETWORKDISCONNECT_QUIT);
     }
@@ -159,56 +215,48 @@ void NetworkManager::update()
         pMetaServerClient->update();
     }
 
-    if(bIsServer) {
+    // send what is still queued before any disconnect event below can free a peer for reuse
+    flush();
+
+    // all ENet calls below need the host, so the network thread has to wait until all received events are handled.
+    // The callbacks are called unlocked as they might run nested menus (or a whole game) that call update() themselves.
+    sdl2::mutex_lock lock(hostMutex);
+
+    if(isAcceptingPeers()) {
         // Check for timeout of one client
         if(awaitingConnectionList.empty() == false) {
             ENetPeer* pCurrentPeer = awaitingConnectionList.front();
             PeerData* peerData = static_cast<PeerData*>(pCurrentPeer->data);
 
             if(peerData->peerState == PeerData::PeerState::ReadyForOtherPeersToConnect) {
-                if(numPlayers >= maxPlayers) {
-                    enet_peer_disconnect_later(pCurrentPeer, NETWORKDISCONNECT_GAME_FULL);
-                } else {
-                    // only one peer should be in state 'PeerState::WaitingForOtherPeersToConnect'
-                    peerData->peerState = PeerData::PeerState::WaitingForOtherPeersToConnect;
-                    peerData->timeout = SDL_GetTicks() + AWAITING_CONNECTION_TIMEOUT;
-                    peerData->notYetConnectedPeers = peerList;
-
-                    if(peerData->notYetConnectedPeers.empty()) {
-                        // first client on this server
-                        // => change immediately to connected
-
-                        // get change event list first
-                        ChangeEventList changeEventList = pGetChangeEventListForNewPlayerCallback(peerData->name);
-
-                        debugNetwork("Moving '%s' from awaiting connection list to peer list\n", peerData->name.c_str());
-                        peerList.push_back(pCurrentPeer);
-                        peerData->peerState = PeerData::PeerState::Connected;
-                        peerData->timeout = 0;
-                        awaitingConnectionList.remove(pCurrentPeer);
-
-                        // send peer game settings
-                        ENetPacketOStream packetOStream2(ENET_PACKET_FLAG_RELIABLE);
-                        packetOStream2.writeUint32(NETWORKPACKET_SENDGAMEINFO);
-                        pGameInitSettings->save(packetOStream2);
-
-                        changeEventList.save(packetOStream2);
+                if(bIsServer == false) {
+                    // the game is already running => only players that lost their connection can rejoin
+                    std::string snapshot;
+                    if(peerData->protocolVersion >= NETWORKPROTOCOL_VERSION_REJOIN) {
+                        snapshot = pGetSnapshotForRejoiningPlayerCallback(peerData->name);
+                    }
 
-                        sendPacketToPeer(pCurrentPeer, packetOStream2);
+                    if(snapshot.empty()) {
+                        enet_peer_disconnect_later(pCurrentPeer, NETWORKDISCONNECT_GAME_RUNNING);
+                        peerData->peerState = PeerData::PeerState::WaitingForName;
                     } else {
-                        // instruct all connected peers to connect
-
-                        ENetPacketOStream packetOStream(ENET_PACKET_FLAG_RELIABLE);
-                        packetOStream.writeUint32(NETWORKPACKET_CONNECT);
-                        packetOStream.writeUint32(SDL_SwapBE32(pCurrentPeer->address.host));
-                        packetOStream.writeUint16(pCurrentPeer->address.port);
-                        packetOStream.writeString(peerData->name);
-
-                        sendPacketToAllConnectedPeers(packetOStream);
+                        debugNetwork("Sending snapshot of %d bytes to '%s'\n", (int) snapshot.size(), peerData->name.c_str());
+                        peerData->peerState = PeerData::PeerState::ReceivingSnapshot;
+                        peerData->timeout = 0;
+                        peerData->snapshot = std::move(snapshot);
+                        peerData->snapshotOffset = 0;
                     }
+                } else if(numPlayers >= maxPlayers) {
+                    enet_peer_disconnect_later(pCurrentPeer, NETWORKDISCONNECT_GAME_FULL);
+                } else {
+                    connectOtherPeersTo(pCurrentPeer);
                 }
             }
 
+            if(peerData->peerState == PeerData::PeerState::ReceivingSnapshot) {
+                sendSnapshotChunks(pCurrentPeer);
+            }
+
             if(peerData->timeout > 0 && SDL_GetTicks() > peerData->timeout) {
                 // timeout
                 switch(peerData->peerState) {
@@ -239,14 +287,19 @@ void NetworkManager::update()
         }
     }
 
-    ENetEvent event;
-    while(enet_host_service(host, &event, 0) > 0) {
+    while(SDL_SemTryWait(receivedEventsSemaphore) == 0) {
+        // all events are processed below
+    }
 
+    ReceivedEvent receivedEvent;
+    while(receivedEvents.pop(receivedEvent)) {
+
+        const ENetEvent& event = receivedEvent.event;
         ENetPeer* peer = event.peer;
 
         switch(event.type) {
             case ENET_EVENT_TYPE_CONNECT: {
-                if(bIsServer) {
+                if(isAcceptingPeers()) {
                     // Server
                     debugNetwork("NetworkManager: %s:%u connected.\n", Address2String(peer->address).c_str(), peer->address.port);
 
@@ -261,6 +314,7 @@ void NetworkManager::update()
                     ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
                     packetStream.writeUint32(NETWORKPACKET_SENDNAME);
                     packetStream.writeString(playerName);
+                    packetStream.writeUint32(NETWORKPROTOCOL_VERSION);
 
                     sendPacketToPeer(peer, packetStream);
                 } else if(connectPeer != nullptr) {
@@ -271,6 +325,7 @@ void NetworkManager::update()
                         ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
                         packetStream.writeUint32(NETWORKPACKET_SENDNAME);
                         packetStream.writeString(playerName);
+                        packetStream.writeUint32(NETWORKPROTOCOL_VERSION);
 
                         sendPacketToHost(packetStream);
 
@@ -300,6 +355,7 @@ void NetworkManager::update()
                             ENetPacketOStream packetStream2(ENET_PACKET_FLAG_RELIABLE);
                             packetStream2.writeUint32(NETWORKPACKET_SENDNAME);
                             packetStream2.writeString(playerName);
+                            packetStream2.writeUint32(NETWORKPROTOCOL_VERSION);
 
                             sendPacketToPeer(peer, packetStream2);
                         }
@@ -315,7 +371,7 @@ void NetworkManager::update()
 
                 ENetPacketIStream packetStream(event.packet);
 
-                handlePacket(peer, packetStream);
+                handlePacket(peer, packetStream, receivedEvent.receiveTime);
             } break;
 
             case ENET_EVENT_TYPE_DISCONNECT: {
@@ -323,15 +379,15 @@ void NetworkManager::update()
 
                 int disconnectCause = event.data;
 
-                debugNetwork("NetworkManager: %s:%u (%s) disconnected (%d).\n", Address2String(peer->address).c_str(), peer->address.port, (peerData != nullptr) ? peerData->name.c_str() : "unknown", disconnectCause);
+                debugNetwork("NetworkManager: %s:%u (%s) disconnected (%d).\n", Address2String(receivedEvent.address).c_str(), receivedEvent.address.port, (peerData != nullptr) ? peerData->name.c_str() : "unknown", disconnectCause);
 
                 if(peerData != nullptr) {
                     if(std::find(awaitingConnectionList.begin(), awaitingConnectionList.end(), peer) != awaitingConnectionList.end()) {
                         if(peerData->peerState == PeerData::PeerState::WaitingForOtherPeersToConnect) {
                             ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
                             packetStream.writeUint32(NETWORKPACKET_DISCONNECT);
-                            packetStream.writeUint32(SDL_SwapBE32(peer->address.host));
-                            packetStream.writeUint16(peer->address.port);
+                            packetStream.writeUint32(SDL_SwapBE32(receivedEvent.address.host));
+                            packetStream.writeUint16(receivedEvent.address.port);
 
                             sendPacketToAllConnectedPeers(packetStream);
                         }
@@ -347,18 +403,20 @@ void NetworkManager::update()
 
                         ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
                         packetStream.writeUint32(NETWORKPACKET_DISCONNECT);
-                        packetStream.writeUint32(SDL_SwapBE32(peer->address.host));
-                        packetStream.writeUint16(peer->address.port);
+                        packetStream.writeUint32(SDL_SwapBE32(receivedEvent.address.host));
+                        packetStream.writeUint16(receivedEvent.address.port);
 
                         sendPacketToAllConnectedPeers(packetStream);
 
                         if(pOnPeerDisconnected) {
+                            sdl2::mutex_unlock unlock(hostMutex);
                             pOnPeerDisconnected(peerData->name, (peer == connectPeer), disconnectCause);
                         }
                     } else {
                         if(peer == connectPeer) {
                             // host disconnected while establishing connection
                             if(pOnPeerDisconnected) {
+                                sdl2::mutex_unlock unlock(hostMutex);
                                 pOnPeerDisconnected(peerData->name, true, disconnectCause);
                             }
                         }
@@ -382,7 +440,7 @@ void NetworkManager::update()
     }
 }
 
-void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStream)
+void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStream, Uint32 receiveTime)
 {
     try {
         Uint32 packetType = packetStream.readUint32();
@@ -404,6 +462,7 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
                     } else {
                         PeerData* peerData = new PeerData(newPeer, PeerData::PeerState::WaitingForOtherPeersToConnect);
                         peerData->name = packetStream.readString();
+                        peerData->protocolVersion = readProtocolVersion(packetStream);
 
                         newPeer->data = peerData;
                         debugNetwork("Adding '%s' to awaiting connection list\n", peerData->name.c_str());
@@ -441,7 +500,7 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
                 address.host = SDL_SwapBE32(packetStream.readUint32());
                 address.port = packetStream.readUint16();
 
-                if(isServer()) {
+                if(isAcceptingPeers()) {
 
                     if(awaitingConnectionList.empty() == false) {
                         ENetPeer* pCurrentPeer = awaitingConnectionList.front();
@@ -463,24 +522,7 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
 
                                 sendPacketToAllConnectedPeers(packetOStream);
 
-                                // get change event list first
-                                ChangeEventList changeEventList = pGetChangeEventListForNewPlayerCallback(peerData->name);
-
-                                // move peer to peer list
-                                debugNetwork("Moving '%s' from awaiting connection list to peer list\n", peerData->name.c_str());
-                                peerList.push_back(pCurrentPeer);
-                                peerData->peerState = PeerData::PeerState::Connected;
-                                peerData->timeout = 0;
-                                awaitingConnectionList.remove(pCurrentPeer);
-
-                                // send peer game settings
-                                ENetPacketOStream packetOStream2(ENET_PACKET_FLAG_RELIABLE);
-                                packetOStream2.writeUint32(NETWORKPACKET_SENDGAMEINFO);
-                                pGameInitSettings->save(packetOStream2);
-
-                                changeEventList.save(packetOStream2);
-
-                                sendPacketToPeer(pCurrentPeer, packetOStream2);
+                                addConnectedPeer(pCurrentPeer);
                             }
                         }
                     }
@@ -524,6 +566,7 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
                 ChangeEventList changeEventList(packetStream);
 
                 if(pOnReceiveGameInfo) {
+                    sdl2::mutex_unlock unlock(hostMutex);
                     pOnReceiveGameInfo(gameInitSettings, changeEventList);
                 }
             } break;
@@ -535,10 +578,11 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
                 }
 
                 std::string newName = packetStream.readString();
+                Uint32 protocolVersion = readProtocolVersion(packetStream);
                 bool bFoundName = false;
 
                 //check if name already exists
-                if(bIsServer) {
+                if(isAcceptingPeers()) {
                     if(playerName == newName) {
                         enet_peer_disconnect_later(peer, NETWORKDISCONNECT_PLAYER_EXISTS);
                         bFoundName = true;
@@ -572,6 +616,7 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
 
                 if(bFoundName == false) {
                     peerData->name = newName;
+                    peerData->protocolVersion = protocolVersion;
 
                     if(peerData->peerState == PeerData::PeerState::WaitingForName) {
                         peerData->peerState = PeerData::PeerState::ReadyForOtherPeersToConnect;
@@ -579,6 +624,78 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
                 }
             } break;
 
+            case NETWORKPACKET_SNAPSHOTCHUNK: {
+                if(peer != connectPeer) {
+                    break;
+                }
+
+                Uint32 snapshotSize = packetStream.readUint32();
+                Uint32 offset = packetStream.readUint32();
+                std::string chunk = packetStream.readString();
+
+                if((offset != receivedSnapshot.size()) || (offset + chunk.size() > snapshotSize)) {
+                    SDL_Log("NetworkManager: Received invalid snapshot chunk");
+                    break;
+                }
+
+                receivedSnapshot += chunk;
+
+                if(receivedSnapshot.size() == snapshotSize) {
+                    std::string snapshot;
+                    snapshot.swap(receivedSnapshot);
+                    bRejoining = true;
+
+                    if(pOnReceiveSnapshot) {
+                        sdl2::mutex_unlock unlock(hostMutex);
+                        pOnReceiveSnapshot(snapshot);
+                    }
+                }
+            } break;
+
+            case NETWORKPACKET_SNAPSHOTLOADED: {
+                PeerData* peerData = static_cast<PeerData*>(peer->data);
+                if(!peerData || !isAcceptingPeers() || awaitingConnectionList.empty() || (awaitingConnectionList.front() != peer)) {
+                    break;
+                }
+
+                if((peerData->peerState == PeerData::PeerState::ReceivingSnapshot) && (peerData->snapshotOffset == peerData->snapshot.size())) {
+                    std::string().swap(peerData->snapshot);
+                    peerData->snapshotOffset = 0;
+
+                    connectOtherPeersTo(peer);
+                }
+            } break;
+
+            case NETWORKPACKET_CATCHUPCOMMANDS: {
+                if(!connectPeer || (peer != connectPeer)) {
+                    break;
+                }
+
+                PeerData* peerData = static_cast<PeerData*>(connectPeer->data);
+                if(!peerData) {
+                    break;
+                }
+
+                peerList = awaitingConnectionList;
+                peerData->peerState = PeerData::PeerState::Connected;
+                peerData->timeout = 0;
+                awaitingConnectionList.clear();
+                bRejoining = false;
+
+                CatchUpData catchUpData;
+                catchUpData.gameCycle = packetStream.readUint32();
+                catchUpData.commandList = CommandList::loadCompact(packetStream);
+                catchUpData.stateHashes.units = packetStream.readUint32();
+                catchUpData.stateHashes.structures = packetStream.readUint32();
+                catchUpData.stateHashes.houses = packetStream.readUint32();
+                catchUpData.stateHashes.spice = packetStream.readUint32();
+
+                if(pOnReceiveCatchUpCommands) {
+                    sdl2::mutex_unlock unlock(hostMutex);
+                    pOnReceiveCatchUpCommands(catchUpData);
+                }
+            } break;
+
             case NETWORKPACKET_CHATMESSAGE: {
                 PeerData* peerData = static_cast<PeerData*>(peer->data);
                 if(!peerData) {
@@ -587,6 +704,7 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
 
                 std::string message = packetStream.readString();
                 if(pOnReceiveChatMessage) {
+                    sdl2::mutex_unlock unlock(hostMutex);
                     pOnReceiveChatMessage(peerData->name, message);
                 }
             } break;
@@ -595,6 +713,7 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
                 ChangeEventList changeEventList(packetStream);
 
                 if(pOnReceiveChangeEventList) {
+                    sdl2::mutex_unlock unlock(hostMutex);
                     pOnReceiveChangeEventList(changeEventList);
                 }
             } break;
@@ -603,19 +722,30 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
                 Uint32 timeLeft = packetStream.readUint32();
 
                 if(pOnStartGame) {
+                    sdl2::mutex_unlock unlock(hostMutex);
                     pOnStartGame(timeLeft);
                 }
             } break;
 
-            case NETWORKPACKET_COMMANDLIST: {
+            case NETWORKPACKET_COMMANDLIST:
+            case NETWORKPACKET_COMMANDLIST_COMPACT: {
                 PeerData* peerData = static_cast<PeerData*>(peer->data);
                 if(!peerData) {
                     break;
                 }
 
-                CommandList commandList(packetStream);
+                CommandList commandList = (packetType == NETWORKPACKET_COMMANDLIST_COMPACT) ? CommandList::loadCompact(packetStream) : CommandList(packetStream);
+
+                // command lists are sent every game cycle, so variations of their arrival interval show how much earlier commands have to be sent
+                if(peerData->lastCommandListTime != 0) {
+                    const int interval = (int) (receiveTime - peerData->lastCommandListTime);
+                    peerData->commandListJitter += (std::abs(interval - peerData->lastCommandListInterval) - peerData->commandListJitter) / 16.0f;
+                    peerData->lastCommandListInterval = interval;
+                }
+                peerData->lastCommandListTime = receiveTime;
 
                 if(pOnReceiveCommandList) {
+                    sdl2::mutex_unlock unlock(hostMutex);
                     pOnReceiveCommandList(peerData->name, commandList);
                 }
             } break;
@@ -627,9 +757,13 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
                 }
 
                 int groupListIndex = packetStream.readSint32();
-                std::set<Uint32> selectedList = packetStream.readUint32Set();
+                // read element by element so a corrupt size cannot allocate more than the packet holds
+                std::vector<Uint32> selectedIDs;
+                packetStream.readUint32List(selectedIDs);
+                ObjectIDSet selectedList(std::move(selectedIDs));
 
                 if(pOnReceiveSelectionList) {
+                    sdl2::mutex_unlock unlock(hostMutex);
                     pOnReceiveSelectionList(peerData->name, selectedList, groupListIndex);
                 }
             } break;
@@ -648,24 +782,136 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
 }
 
 
+void NetworkManager::connectOtherPeersTo(ENetPeer* pNewPeer) {
+    PeerData* peerData = static_cast<PeerData*>(pNewPeer->data);
+
+    // only one peer should be in state 'PeerState::WaitingForOtherPeersToConnect'
+    peerData->peerState = PeerData::PeerState::WaitingForOtherPeersToConnect;
+    peerData->timeout = SDL_GetTicks() + AWAITING_CONNECTION_TIMEOUT;
+    peerData->notYetConnectedPeers = peerList;
+
+    if(peerData->notYetConnectedPeers.empty()) {
+        // first client on this server
+        // => change immediately to connected
+        addConnectedPeer(pNewPeer);
+    } else {
+        // instruct all connected peers to connect
+
+        ENetPacketOStream packetOStream(ENET_PACKET_FLAG_RELIABLE);
+        packetOStream.writeUint32(NETWORKPACKET_CONNECT);
+        packetOStream.writeUint32(SDL_SwapBE32(pNewPeer->address.host));
+        packetOStream.writeUint16(pNewPeer->address.port);
+        packetOStream.writeString(peerData->name);
+        packetOStream.writeUint32(peerData->protocolVersion);
+
+        sendPacketToAllConnectedPeers(packetOStream);
+    }
+}
+
+void NetworkManager::addConnectedPeer(ENetPeer* pNewPeer) {
+    PeerData* peerData = static_cast<PeerData*>(pNewPeer->data);
+
+    if(bIsServer) {
+        // get change event list first
+        ChangeEventList changeEventList = pGetChangeEventListForNewPlayerCallback(peerData->name);
+
+        // move peer to peer list
+        debugNetwork("Moving '%s' from awaiting connection list to peer list\n", peerData->name.c_str());
+        peerList.push_back(pNewPeer);
+        peerData->peerState = PeerData::PeerState::Connected;
+        peerData->timeout = 0;
+        awaitingConnectionList.remove(pNewPeer);
+
+        // send peer game settings
+        ENetPacketOStream packetOStream(ENET_PACKET_FLAG_RELIABLE, NETWORKPACKET_SIZEHINT_SENDGAMEINFO);
+        packetOStream.writeUint32(NETWORKPACKET_SENDGAMEINFO);
+        pGameInitSettings->save(packetOStream);
+
+        changeEventList.save(packetOStream);
+
+        sendPacketToPeer(pNewPeer, packetOStream);
+    } else {
+        // the rejoining player gets everything that happened since the snapshot; from now on it receives all command lists
+        const CatchUpData catchUpData = pGetCatchUpCommandsCallback(peerData->name);
+
+        debugNetwork("Moving '%s' from awaiting connection list to peer list\n", peerData->name.c_str());
+        peerList.push_back(pNewPeer);
+        peerData->peerState = PeerData::PeerState::Connected;
+        peerData->timeout = 0;
+        awaitingConnectionList.remove(pNewPeer);
+
+        ENetPacketOStream packetOStream(ENET_PACKET_FLAG_RELIABLE, NETWORKPACKET_SIZEHINT_CATCHUPCOMMANDS);
+        packetOStream.writeUint32(NETWORKPACKET_CATCHUPCOMMANDS);
+        packetOStream.writeUint32(catchUpData.gameCycle);
+        catchUpData.commandList.saveCompact(packetOStream);
+        // the rejoining player compares them with its own state once it has caught up
+        packetOStream.writeUint32(catchUpData.stateHashes.units);
+        packetOStream.writeUint32(catchUpData.stateHashes.structures);
+        packetOStream.writeUint32(catchUpData.stateHashes.houses);
+        packetOStream.writeUint32(catchUpData.stateHashes.spice);
+
+        sendPacketToPeer(pNewPeer, packetOStream);
+    }
+}
+
+void NetworkManager::sendSnapshotChunks(ENetPeer* pPeer) {
+    PeerData* peerData = static_cast<PeerData*>(pPeer->data);
+
+    while((peerData->snapshotOffset < peerData->snapshot.size()) && (enet_list_size(&pPeer->outgoingReliableCommands) < NETWORKSNAPSHOT_MAX_QUEUED_CHUNKS)) {
+        const size_t chunkSize = std::min((size_t) NETWORKSNAPSHOT_CHUNK_SIZE, peerData->snapshot.size() - peerData->snapshotOffset);
+
+        ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE, 4*sizeof(Uint32) + chunkSize);
+        packetStream.writeUint32(NETWORKPACKET_SNAPSHOTCHUNK);
+        packetStream.writeUint32(peerData->snapshot.size());
+        packetStream.writeUint32(peerData->snapshotOffset);
+        packetStream.writeString(peerData->snapshot.substr(peerData->snapshotOffset, chunkSize));
+
+        // the chunks bypass the outgoing queue, as the throttling above counts the commands already handed to ENet
+        ENetPacket* enetPacket = packetStream.getPacket();
+        if(enet_peer_send(pPeer, NETWORKCHANNEL_SNAPSHOT, enetPacket) < 0) {
+            SDL_Log("NetworkManager: Cannot send packet!");
+            enet_packet_destroy(enetPacket);
+            return;
+        }
+
+        peerData->snapshotOffset += chunkSize;
+    }
+}
+
+Uint32 NetworkManager::readProtocolVersion(ENetPacketIStream& packetStream) {
+    try {
+        return packetStream.readUint32();
+    } catch (InputStream::eof&) {
+        // older versions send nothing after the player name
+        return NETWORKPROTOCOL_VERSION_LEGACY;
+    }
+}
+
 void NetworkManager::sendPacketToHost(ENetPacketOStream& packetStream, int channel) {
+    sdl2::mutex_lock lock(hostMutex);
+
     if(connectPeer == nullptr) {
         SDL_Log("NetworkManager: sendPacketToHost() called on server!");
         return;
     }
 
-    ENetPacket* enetPacket = packetStream.getPacket();
-
-    if(enet_peer_send(connectPeer, channel, enetPacket) < 0) {
-        SDL_Log("NetworkManager: Cannot send packet!");
-    }
+    queuePacket(connectPeer, channel, packetStream.getPacket());
 }
 
 void NetworkManager::sendPacketToPeer(ENetPeer* peer, ENetPacketOStream& packetStream, int channel) {
+    sdl2::mutex_lock lock(hostMutex);
+
+    queuePacket(peer, channel, packetStream.getPacket());
+}
+
+
+void NetworkManager::sendPacketToAllConnectedPeers(ENetPacketOStream& packetStream, int channel) {
+    sdl2::mutex_lock lock(hostMutex);
+
     ENetPacket* enetPacket = packetStream.getPacket();
 
-    if(enet_peer_send(peer, channel, enetPacket) < 0) {
-        SDL_Log("NetworkManager: Cannot send packet!");
+    for(ENetPeer* pCurrentPeer : peerList) {
+        queuePacket(pCurrentPeer, channel, enetPacket);
     }
 
     if(enetPacket->referenceCount == 0) {
@@ -673,26 +919,48 @@ void NetworkManager::sendPacketToPeer(ENetPeer* peer, ENetPacketOStream& packetS
     }
 }
 
+void NetworkManager::queuePacket(ENetPeer* pPeer, int channel, ENetPacket* pPacket) {
+    pPacket->referenceCount++;
+    outgoingPackets.push_back({ pPeer, channel, pPacket });
+}
 
-void NetworkManager::sendPacketToAllConnectedPeers(ENetPacketOStream& packetStream, int channel) {
-    ENetPacket* enetPacket = packetStream.getPacket();
+void NetworkManager::flush() {
+    if(outgoingPackets.empty()) {
+        return;
+    }
 
-    for(ENetPeer* pCurrentPeer : peerList) {
-        if(enet_peer_send(pCurrentPeer, channel, enetPacket) < 0) {
+    sdl2::mutex_lock lock(hostMutex);
+
+    for(OutgoingPacket& outgoingPacket : outgoingPackets) {
+        if(enet_peer_send(outgoingPacket.pPeer, outgoingPacket.channel, outgoingPacket.pPacket) < 0) {
             SDL_Log("NetworkManager: Cannot send packet!");
-            continue;
         }
-    }
 
-    if(enetPacket->referenceCount == 0) {
-        enet_packet_destroy(enetPacket);
+        // enet_peer_send() holds its own reference
+        if(--outgoingPacket.pPacket->referenceCount == 0) {
+            enet_packet_destroy(outgoingPacket.pPacket);
+        }
     }
+    outgoingPackets.clear();
+
+    enet_host_flush(host);
 }
 
 
+void NetworkManager::waitForReceivedEvents(Uint32 timeout) {
+    SDL_SemWaitTimeout(receivedEventsSemaphore, timeout);
+}
+
+void NetworkManager::sendSnapshotLoaded() {
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+    packetStream.writeUint32(NETWORKPACKET_SNAPSHOTLOADED);
+
+    sendPacketToHost(packetStream);
+}
+
 void NetworkManager::sendChatMessage(const std::string& message)
 {
-    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE, 2*sizeof(Uint32) + message.size());
     packetStream.writeUint32(NETWORKPACKET_CHATMESSAGE);
     packetStream.writeString(message);
 
@@ -701,7 +969,7 @@ void NetworkManager::sendChatMessage(const std::string& message)
 
 void NetworkManager::sendChangeEventList(const ChangeEventList& changeEventList)
 {
-    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE, NETWORKPACKET_SIZEHINT_CHANGEEVENTLIST);
     packetStream.writeUint32(NETWORKPACKET_CHANGEEVENTLIST);
     changeEventList.save(packetStream);
 
@@ -713,6 +981,8 @@ void NetworkManager::sendChangeEventList(const ChangeEventList& changeEventList)
 }
 
 void NetworkManager::sendStartGame(unsigned int timeLeft) {
+    sdl2::mutex_lock lock(hostMutex);
+
     for(ENetPeer* pCurrentPeer : peerList) {
         ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
         packetStream.writeUint32(NETWORKPACKET_STARTGAME);
@@ -724,23 +994,60 @@ void NetworkManager::sendStartGame(unsigned int timeLeft) {
 }
 
 void NetworkManager::sendCommandList(const CommandList& commandList) {
-    ENetPacketOStream packetStream(ENET_PACKET_FLAG_UNSEQUENCED);
-    packetStream.writeUint32(NETWORKPACKET_COMMANDLIST);
-    commandList.save(packetStream);
+    size_t numCommands = 0;
+    for(const CommandList::CommandListEntry& commandListEntry : commandList.commandList) {
+        numCommands += commandListEntry.commands.size();
+    }
+
+    // about 8 bytes per compact command, the run-length coding of empty cycles makes the rest negligible
+    ENetPacketOStream compactPacketStream(ENET_PACKET_FLAG_UNSEQUENCED, 16 + 8*numCommands);
+    compactPacketStream.writeUint32(NETWORKPACKET_COMMANDLIST_COMPACT);
+    commandList.saveCompact(compactPacketStream);
+    ENetPacket* compactPacket = compactPacketStream.getPacket();
+
+    ENetPacket* legacyPacket = nullptr;
+
+    sdl2::mutex_lock lock(hostMutex);
 
-    sendPacketToAllConnectedPeers(packetStream, 1);
+    for(ENetPeer* pCurrentPeer : peerList) {
+        PeerData* peerData = static_cast<PeerData*>(pCurrentPeer->data);
+
+        ENetPacket* enetPacket = compactPacket;
+        if((peerData == nullptr) || (peerData->protocolVersion < NETWORKPROTOCOL_VERSION_COMPACTCOMMANDLIST)) {
+            // older peers only understand the uncompressed command list
+            if(legacyPacket == nullptr) {
+                ENetPacketOStream legacyPacketStream(ENET_PACKET_FLAG_UNSEQUENCED, 2*sizeof(Uint32) + 2*sizeof(Uint32)*commandList.commandList.size() + 21*numCommands);
+                legacyPacketStream.writeUint32(NETWORKPACKET_COMMANDLIST);
+                commandList.save(legacyPacketStream);
+                legacyPacket = legacyPacketStream.getPacket();
+            }
+            enetPacket = legacyPacket;
+        }
+
+        queuePacket(pCurrentPeer, 1, enetPacket);
+    }
+
+    if(compactPacket->referenceCount == 0) {
+        enet_packet_destroy(compactPacket);
+    }
+
+    if((legacyPacket != nullptr) && (legacyPacket->referenceCount == 0)) {
+        enet_packet_destroy(legacyPacket);
+    }
 }
 
-void NetworkManager::sendSelectedList(const std::set<Uint32>& selectedList, int groupListIndex) {
-    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+void NetworkManager::sendSelectedList(const ObjectIDSet& selectedList, int groupListIndex) {
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE, 3*sizeof(Uint32) + sizeof(Uint32)*selectedList.size());
     packetStream.writeUint32(NETWORKPACKET_SELECTIONLIST);
     packetStream.writeSint32(groupListIndex);
-    packetStream.writeUint32Set(selectedList);
+    packetStream.writeUint32Vector(selectedList.getIDs());
 
     sendPacketToAllConnectedPeers(packetStream, 0);
 }
 
 int NetworkManager::getMaxPeerRoundTripTime() {
+    sdl2::mutex_lock lock(hostMutex);
+
     int maxPeerRTT = 0;
 
     for(ENetPeer* pCurrentPeer : peerList) {
@@ -750,6 +1057,91 @@ int NetworkManager::getMaxPeerRoundTripTime() {
     return maxPeerRTT;
 }
 
+std::list<std::pair<std::string, int>> NetworkManager::getPeerRoundTripTimes() {
+    sdl2::mutex_lock lock(hostMutex);
+
+    std::list<std::pair<std::string, int>> peerRTTs;
+
+    for(ENetPeer* pCurrentPeer : peerList) {
+        PeerData* peerData = static_cast<PeerData*>(pCurrentPeer->data);
+        if(peerData != nullptr) {
+            peerRTTs.emplace_back(peerData->name, (int) (pCurrentPeer->roundTripTime));
+        }
+    }
+
+    return peerRTTs;
+}
+
+int NetworkManager::getMaxPeerJitter() {
+    sdl2::mutex_lock lock(hostMutex);
+
+    int maxPeerJitter = 0;
+
+    for(ENetPeer* pCurrentPeer : peerList) {
+        maxPeerJitter = std::max(maxPeerJitter, (int) (pCurrentPeer->roundTripTimeVariance));
+
+        PeerData* peerData = static_cast<PeerData*>(pCurrentPeer->data);
+        if(peerData != nullptr) {
+            maxPeerJitter = std::max(maxPeerJitter, (int) std::lround(peerData->commandListJitter));
+        }
+    }
+
+    return maxPeerJitter;
+}
+
+Uint32 NetworkManager::getMinPeerProtocolVersion() {
+    sdl2::mutex_lock lock(hostMutex);
+
+    Uint32 minProtocolVersion = NETWORKPROTOCOL_VERSION;
+
+    for(const std::list<ENetPeer*>* pPeers : { &peerList, &awaitingConnectionList }) {
+        for(ENetPeer* pCurrentPeer : *pPeers) {
+            PeerData* peerData = static_cast<PeerData*>(pCurrentPeer->data);
+            minProtocolVersion = std::min(minProtocolVersion, (peerData != nullptr) ? peerData->protocolVersion : (Uint32) NETWORKPROTOCOL_VERSION_LEGACY);
+        }
+    }
+
+    return minProtocolVersion;
+}
+
+int NetworkManager::networkThreadMain(void* data) {
+    NetworkManager* pNetworkManager = static_cast<NetworkManager*>(data);
+    TRACE_THREAD_NAME("Network");
+
+    while(SDL_AtomicGet(&pNetworkManager->quitNetworkThread) == 0) {
+        pNetworkManager->serviceHost();
+
+        if(pNetworkManager->receivedEvents.isFull()) {
+            // the game thread is busy, there is no point in waking up on incoming data
+            SDL_Delay(NETWORKTHREAD_WAIT_TIMEOUT);
+        } else {
+            // wake up as soon as something arrives, but service the host regularly to send resends and pings
+            enet_uint32 waitCondition = ENET_SOCKET_WAIT_RECEIVE;
+            enet_socket_wait(pNetworkManager->host->socket, &waitCondition, NETWORKTHREAD_WAIT_TIMEOUT);
+        }
+    }
+
+    return 0;
+}
+
+void NetworkManager::serviceHost() {
+    sdl2::mutex_lock lock(hostMutex);
+
+    // if the game thread falls behind, the remaining events stay in the ENet queues until there is space again
+    bool bNewEvents = false;
+    ENetEvent event;
+    while(!receivedEvents.isFull() && (enet_host_service(host, &event, 0) > 0)) {
+        receivedEvents.push({ event, event.peer->address, SDL_GetTicks() });
+        bNewEvents = true;
+    }
+
+    if(bNewEvents && (SDL_SemValue(receivedEventsSemaphore) == 0)) {
+        SDL_SemPost(receivedEventsSemaphore);
+    }
+
+    enet_host_flush(host);
+}
+
 void NetworkManager::debugNetwork(const char* fmt, ...) {
     if(settings.network.debugNetwork) {
         va_list args;
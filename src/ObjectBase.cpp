@@ -23,6 +23,7 @@
 #include <FileClasses/music/MusicPlayer.h>
 
 #include <Game.h>
+#include <GameContext.h>
 #include <House.h>
 #include <SoundPlayer.h>
 #include <Map.h>
@@ -69,7 +70,11 @@
 #include <units/Trike.h>
 #include <units/Trooper.h>
 
+#include <misc/AllocationCounter.h>
+
+#include <algorithm>
 #include <array>
+#include <vector>
 
 ObjectBase::ObjectBase(House* newOwner) : originalHouseID(newOwner->getHouseID()), owner(newOwner) {
     ObjectBase::init();
@@ -147,10 +152,13 @@ ObjectBase::ObjectBase(InputStream& stream) {
 
     for (decltype(visible.size()) i = 0; i < visible.size(); ++i)
         visible[i] = b[i];
+
+    randomGen.setSeed(stream.readUint32());
 }
 
 void ObjectBase::init() {
     itemID = ItemID_Invalid;
+    pObjectData = nullptr;
 
     aFlyingUnit = false;
     aGroundUnit = false;
@@ -171,6 +179,14 @@ void ObjectBase::init() {
 
 ObjectBase::~ObjectBase() = default;
 
+void* ObjectBase::operator new(size_t size) {
+    return GameContext::getCurrent()->objectArena.allocate(size);
+}
+
+void ObjectBase::operator delete(void* p) {
+    ObjectArena::deallocate(p);
+}
+
 void ObjectBase::save(OutputStream& stream) const {
     stream.writeUint32(originalHouseID);
     stream.writeUint32(owner->getHouseID());
@@ -205,6 +221,8 @@ void ObjectBase::save(OutputStream& stream) const {
     stream.writeUint32(attackMode);
 
     stream.writeBools(visible[0], visible[1], visible[2], visible[3], visible[4], visible[5], visible[6]);
+
+    stream.writeUint32(randomGen.getSeed());
 }
 
 
@@ -221,8 +239,17 @@ Coord ObjectBase::getClosestCenterPoint(const Coord& objectLocation) const {
 }
 
 
+const ObjectData::ObjectDataStruct& ObjectBase::resolveObjectData() const {
+    const ObjectData::ObjectDataStruct& objectData = getObjectData();
+    if(itemID != ItemID_Invalid) {
+        // the subclass has set the final item id
+        pObjectData = &objectData;
+    }
+    return objectData;
+}
+
 int ObjectBase::getMaxHealth() const {
-    return currentGame->objectData.data[itemID][originalHouseID].hitpoints;
+    return getObjectData().hitpoints;
 }
 
 void ObjectBase::handleDamage(int damage, Uint32 damagerID, House* damagerOwner) {
@@ -297,6 +324,8 @@ void ObjectBase::setObjectID(int newObjectID) {
 }
 
 void ObjectBase::setVisible(int teamID, bool status) {
+    const auto oldVisible = visible;
+
     if(teamID == VIS_ALL) {
         if (status)
             visible.set();
@@ -305,6 +334,11 @@ void ObjectBase::setVisible(int teamID, bool status) {
     } else if ((teamID >= 0) && (teamID < NUM_TEAMS)) {
         visible[teamID] = status;
     }
+
+    if((visible & ~oldVisible).any() && currentGameMap->tileExists(location)) {
+        // this object may have become a target
+        currentGameMap->noteTargetsChanged(location);
+    }
 }
 
 void ObjectBase::setTarget(const ObjectBase* newTarget) {
@@ -362,73 +396,66 @@ Coord ObjectBase::getClosestPoint(const Coord& point) const {
 }
 
 const StructureBase* ObjectBase::findClosestTargetStructure() const {
-    const StructureBase *pClosestStructure = nullptr;
-    auto closestDistance = FixPt_MAX;
-    for(const StructureBase* pStructure : structureList) {
-        if(canAttack(pStructure)) {
-            const auto closestPoint = pStructure->getClosestPoint(getLocation());
-            auto structureDistance = blockDistance(getLocation(), closestPoint);
-
-            if(pStructure->getItemID() == Structure_Wall) {
-                structureDistance += 20000000; //so that walls are targeted very last
-            }
-
-            if(structureDistance < closestDistance) {
-                closestDistance = structureDistance;
-                pClosestStructure = pStructure;
-            }
-        }
-    }
-
-    return pClosestStructure;
+    return static_cast<const StructureBase*>(findClosestTargetObject(true, false));
 }
 
 const UnitBase* ObjectBase::findClosestTargetUnit() const {
-    const UnitBase *pClosestUnit = nullptr;
-    auto closestDistance = FixPt_MAX;
-    for(const UnitBase* pUnit : unitList) {
-        if(canAttack(pUnit)) {
-            const auto closestPoint = pUnit->getClosestPoint(getLocation());
-            const auto unitDistance = blockDistance(getLocation(), closestPoint);
-
-            if(unitDistance < closestDistance) {
-                closestDistance = unitDistance;
-                pClosestUnit = pUnit;
-            }
-        }
-    }
-
-    return pClosestUnit;
+    return static_cast<const UnitBase*>(findClosestTargetObject(false, true));
 }
 
 const ObjectBase* ObjectBase::findClosestTarget() const {
+    return findClosestTargetObject(true, true);
+}
+
+/**
+    Searches the closest object this object can attack. The search is done ring by ring around this object using the
+    spatial object index of the map. On equal distance structures are preferred over units and then lower object IDs.
+    \param  bStructures consider structures?
+    \param  bUnits      consider units?
+    \return the closest target or nullptr if none was found
+*/
+const ObjectBase* ObjectBase::findClosestTargetObject(bool bStructures, bool bUnits) const {
     const ObjectBase *pClosestObject = nullptr;
     FixPoint closestDistance = FixPt_MAX;
-    for(const StructureBase* pStructure : structureList) {
-        if(canAttack(pStructure)) {
-            const auto closestPoint = pStructure->getClosestPoint(getLocation());
-            auto structureDistance = blockDistance(getLocation(), closestPoint);
 
-            if(pStructure->getItemID() == Structure_Wall) {
-                    structureDistance += 20000000; //so that walls are targeted very last
-            }
+    // sorted IDs of the objects already checked; reused by all searches of this thread (target scans run on worker threads)
+    static thread_local std::vector<Uint32> checkedObjects;
+    checkedObjects.clear();
 
-            if(structureDistance < closestDistance) {
-                closestDistance = structureDistance;
-                pClosestObject = pStructure;
-            }
+    auto checkObject = [&](Uint32 objectID) {
+        const auto iter = std::lower_bound(checkedObjects.begin(), checkedObjects.end(), objectID);
+        if((iter != checkedObjects.end()) && (*iter == objectID)) {
+            return;
         }
-    }
+        checkedObjects.insert(iter, objectID);
 
-    for(const UnitBase* pUnit : unitList) {
-        if(canAttack(pUnit)) {
-            const auto closestPoint = pUnit->getClosestPoint(getLocation());
-            const auto unitDistance = blockDistance(getLocation(), closestPoint);
+        const ObjectBase* pObject = currentGame->getObjectManager().getObject(objectID);
+        if((pObject == nullptr) || (pObject->isAStructure() ? !bStructures : !bUnits) || !canAttack(pObject)) {
+            return;
+        }
 
-            if(unitDistance < closestDistance) {
-                closestDistance = unitDistance;
-                pClosestObject = pUnit;
-            }
+        const auto closestPoint = pObject->getClosestPoint(getLocation());
+        auto distance = blockDistance(getLocation(), closestPoint);
+
+        if(pObject->getItemID() == Structure_Wall) {
+            distance += 20000000; //so that walls are targeted very last
+        }
+
+        if((pClosestObject == nullptr)
+            || (distance < closestDistance)
+            || ((distance == closestDistance)
+                && ((pObject->isAStructure() && !pClosestObject->isAStructure())
+                    || ((pObject->isAStructure() == pClosestObject->isAStructure()) && (objectID < pClosestObject->getObjectID()))))) {
+            closestDistance = distance;
+            pClosestObject = pObject;
+        }
+    };
+
+    const auto& objectIndex = currentGameMap->getSpatialObjectIndex();
+    for(int ring = 0; objectIndex.forEachInRing(getLocation(), ring, checkObject); ring++) {
+        if(closestDistance < SpatialObjectIndex::getMinimumDistanceBeyond(ring)) {
+            // nothing further away can be closer
+            break;
         }
     }
 
@@ -446,70 +473,159 @@ const ObjectBase* ObjectBase::findTarget() const {
 //                  *****
 //                    *
 
-    auto checkRange = 0;
-    switch(attackMode) {
-        case GUARD: {
-            checkRange = getWeaponRange();
-        } break;
-
-        case AREAGUARD: {
-            checkRange = getAreaGuardRange();
-        } break;
-
-        case AMBUSH: {
-            checkRange = getViewRange();
-        } break;
-
-        case HUNT: {
-            // check whole map
-            return findClosestTarget();
-        } break;
-
-        case STOP:
-        default: {
-            return nullptr;
-        } break;
+    if(attackMode == HUNT) {
+        // check whole map
+        return findClosestTarget();
     }
 
-    if(getItemID() == Unit_Sandworm) {
-        checkRange = getViewRange();
+    const auto checkRange = getTargetScanRange();
+    if(checkRange < 0) {
+        return nullptr;
     }
 
+    // walls and carryalls are only attacked if there is nothing else in range
     ObjectBase *pClosestTarget = nullptr;
     auto closestTargetDistance = FixPt_MAX;
+    ObjectBase *pClosestFallbackTarget = nullptr;
+    auto closestFallbackTargetDistance = FixPt_MAX;
+
+    // returns true if a target was found that is not a wall or carryall
+    const auto checkTile = [&](const Coord& coord, FixPoint targetDistance) {
+        Tile* pTile = currentGameMap->getTile(coord);
+        if(isTargetTileScannable(pTile) && pTile->hasAnObject()) {
+
+            const auto pNewTarget = pTile->getObject();
+            if(canAttack(pNewTarget)) {
+                if((pNewTarget->getItemID() == Structure_Wall) || (pNewTarget->getItemID() == Unit_Carryall)) {
+                    if(targetDistance < closestFallbackTargetDistance) {
+                        pClosestFallbackTarget = pNewTarget;
+                        closestFallbackTargetDistance = targetDistance;
+                    }
+                } else if(targetDistance < closestTargetDistance) {
+                    pClosestTarget = pNewTarget;
+                    closestTargetDistance = targetDistance;
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    if(checkRange <= BLOCKDISTANCE_OFFSETS_MAXRANGE) {
+        // nearest tiles first, so the first target found is the closest one
+        int numScannedTiles = 0;
+        for(const BlockDistanceOffset& rangeOffset : getBlockDistanceOffsets()) {
+            if(rangeOffset.distance > checkRange) {
+                break;
+            }
 
-    Coord coord;
-    const auto startY = std::max(0, location.y - checkRange);
-    const auto endY = std::min(currentGameMap->getSizeY()-1, location.y + checkRange);
-    for(coord.y = startY; coord.y <= endY; coord.y++) {
+            const Coord coord = location + rangeOffset.offset;
+            if(currentGameMap->tileExists(coord)) {
+                numScannedTiles++;
+                if(checkTile(coord, rangeOffset.distance)) {
+                    break;
+                }
+            }
+        }
+        COUNT_SIMULATION_EVENT(SimulationCounter_TargetTilesScanned, numScannedTiles, getOwner()->getHouseID());
+    } else {
+        Coord coord;
+        const auto startY = std::max(0, location.y - checkRange);
+        const auto endY = std::min(currentGameMap->getSizeY()-1, location.y + checkRange);
         const auto startX = std::max(0, location.x - checkRange);
         const auto endX = std::min(currentGameMap->getSizeX()-1, location.x + checkRange);
-        for(coord.x = startX; coord.x <= endX; coord.x++) {
-
-            const auto targetDistance = blockDistance(location, coord);
-            if(targetDistance <= checkRange) {
-                Tile* pTile = currentGameMap->getTile(coord);
-                if( pTile->isExploredByTeam(getOwner()->getTeamID())
-                    && !pTile->isFoggedByTeam(getOwner()->getTeamID())
-                    && pTile->hasAnObject()) {
-
-                    const auto pNewTarget = pTile->getObject();
-                    if(((pNewTarget->getItemID() != Structure_Wall && pNewTarget->getItemID() != Unit_Carryall) || pClosestTarget == nullptr) && canAttack(pNewTarget)) {
-                        if(targetDistance < closestTargetDistance) {
-                            pClosestTarget = pNewTarget;
-                            closestTargetDistance = targetDistance;
-                        }
-                    }
+        COUNT_SIMULATION_EVENT(SimulationCounter_TargetTilesScanned, (endX - startX + 1) * (endY - startY + 1), getOwner()->getHouseID());
+        for(coord.y = startY; coord.y <= endY; coord.y++) {
+            for(coord.x = startX; coord.x <= endX; coord.x++) {
+                const auto targetDistance = blockDistance(location, coord);
+                if(targetDistance <= checkRange) {
+                    checkTile(coord, targetDistance);
                 }
             }
         }
     }
 
+    if(pClosestTarget == nullptr) {
+        pClosestTarget = pClosestFallbackTarget;
+    }
+
     return pClosestTarget;
 }
 
+int ObjectBase::getTargetScanRange() const {
+    if(getItemID() == Unit_Sandworm) {
+        return ((attackMode == STOP) || (attackMode == HUNT)) ? -1 : getViewRange();
+    }
+
+    switch(attackMode) {
+        case GUARD:     return getWeaponRange();
+        case AREAGUARD: return getAreaGuardRange();
+        case AMBUSH:    return getViewRange();
+        case HUNT:
+        case STOP:
+        default:        return -1;
+    }
+}
+
+bool ObjectBase::isTargetTileScannable(const Tile* pTile) const {
+    return pTile->isExploredByTeam(getOwner()->getTeamID()) && !pTile->isFoggedByTeam(getOwner()->getTeamID());
+}
+
+bool ObjectBase::isScannedTargetValid(const ObjectBase* pTarget) const {
+    if(!canAttack(pTarget)) {
+        return false;
+    }
+
+    // the target must still be on the map (e.g. not picked up by a carryall)
+    const Coord closestPoint = pTarget->getClosestPoint(location);
+    if(!currentGameMap->tileExists(closestPoint)) {
+        return false;
+    }
+    const Tile* pTile = currentGameMap->getTile(closestPoint);
+    if(!pTile->hasObjectID(pTarget->getObjectID())) {
+        return false;
+    }
+
+    if(attackMode == HUNT) {
+        return true;
+    }
+
+    // the same conditions findTarget() checks for the tiles in range
+    const auto checkRange = getTargetScanRange();
+    return (checkRange >= 0)
+            && (blockDistance(location, closestPoint) <= checkRange)
+            && isTargetTileScannable(pTile)
+            && (pTile->getObject() == pTarget);
+}
+
+void ObjectBase::prefetchTarget() {
+    const auto pTarget = findTarget();
+    scannedTargetID = (pTarget != nullptr) ? pTarget->getObjectID() : NONE_ID;
+    scannedTargetCycle = currentGame->getGameCycleCount();
+    scannedTargetLocation = location;
+    scannedTargetAttackMode = attackMode;
+}
+
+const ObjectBase* ObjectBase::getScannedTarget() const {
+    if((scannedTargetCycle == currentGame->getGameCycleCount()) && (scannedTargetLocation == location) && (scannedTargetAttackMode == attackMode)) {
+        if(scannedTargetID == NONE_ID) {
+            // nothing was found, which is only still true if no target can have appeared in range since then
+            if(!currentGameMap->getTargetChangeGrid().hasChanged(location, getTargetScanRange(), scannedTargetCycle)) {
+                return nullptr;
+            }
+        } else {
+            const auto pTarget = currentGame->getObjectManager().getObject(scannedTargetID);
+            if((pTarget != nullptr) && isScannedTargetValid(pTarget)) {
+                return pTarget;
+            }
+        }
+    }
+
+    return findTarget();
+}
+
 int ObjectBase::getViewRange() const {
-    return currentGame->objectData.data[itemID][originalHouseID].viewrange;
+    return getObjectData().viewrange;
 }
 
 int ObjectBase::getAreaGuardRange() const {
@@ -517,18 +633,19 @@ int ObjectBase::getAreaGuardRange() const {
 }
 
 int ObjectBase::getWeaponRange() const {
-    return currentGame->objectData.data[itemID][originalHouseID].weaponrange;
+    return getObjectData().weaponrange;
 }
 
 int ObjectBase::getWeaponReloadTime() const {
-    return currentGame->objectData.data[itemID][originalHouseID].weaponreloadtime;
+    return getObjectData().weaponreloadtime;
 }
 
 int ObjectBase::getInfSpawnProp() const {
-    return currentGame->objectData.data[itemID][originalHouseID].infspawnprop;
+    return getObjectData().infspawnprop;
 }
 
 ObjectBase* ObjectBase::createObject(int itemID, House* Owner, bool byScenario) {
+    MEMORY_TAG(MemoryTag_Objects);
 
     ObjectBase* newObject = nullptr;
     switch(itemID) {
@@ -599,11 +716,15 @@ ObjectBase* ObjectBase::createObject(int itemID, House* Owner, bool byScenario)
 
     Uint32 objectID = currentGame->getObjectManager().addObject(newObject);
     newObject->setObjectID(objectID);
+    newObject->randomGen = Random::forStream(currentGame->getGameInitSettings().getRandomSeed(), objectID);
+
+    addToItemList(newObject);
 
     return newObject;
 }
 
 ObjectBase* ObjectBase::loadObject(InputStream& stream, int itemID, Uint32 objectID) {
+    MEMORY_TAG(MemoryTag_Objects);
     ObjectBase* newObject = nullptr;
     switch(itemID) {
         case Structure_Barracks:            newObject = new Barracks(stream); break;
@@ -654,12 +775,23 @@ ObjectBase* ObjectBase::loadObject(InputStream& stream, int itemID, Uint32 objec
 
     newObject->setObjectID(objectID);
 
+    addToItemList(newObject);
+
     return newObject;
 }
 
+void ObjectBase::addToItemList(ObjectBase* pObject) {
+    // the constructors of the units and structures already added them to unitList or structureList
+    if(pObject->isAUnit()) {
+        unitListByItemID[pObject->getItemID()].push_back(static_cast<UnitBase*>(pObject));
+    } else if(pObject->isAStructure()) {
+        structureListByItemID[pObject->getItemID()].push_back(static_cast<StructureBase*>(pObject));
+    }
+}
+
 bool ObjectBase::targetInWeaponRange() const {
     Coord coord = (target.getObjPointer())->getClosestPoint(location);
     FixPoint dist = blockDistance(location,coord);
 
-    return ( dist <= currentGame->objectData.data[itemID][originalHouseID].weaponrange);
+    return ( dist <= getObjectData().weaponrange);
 }
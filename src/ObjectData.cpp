@@ -23,8 +23,16 @@
 #include <FileClasses/INIFile.h>
 #include <sand.h>
 
+#include <misc/FileSystem.h>
+#include <misc/IMemoryStream.h>
+#include <misc/OMemoryStream.h>
+#include <misc/fnkdat.h>
+#include <misc/md5.h>
 #include <misc/string_util.h>
 
+#include <cstdio>
+#include <cstring>
+
 ObjectData::ObjectData()
 {
     // set default values
@@ -55,8 +63,39 @@ ObjectData::~ObjectData() = default;
 
 void ObjectData::loadFromINIFile(const std::string& filename)
 {
-    INIFile objectDataFile(pFileManager->openFile(filename).get());
+    std::string source;
+    {
+        sdl2::RWops_ptr file = pFileManager->openFile(filename);
+        Sint64 fileSize = SDL_RWsize(file.get());
+        if(fileSize < 0) {
+            THROW(std::runtime_error, "ObjectData::loadFromINIFile(): Cannot determine size of '%s'!", filename);
+        }
+
+        source.resize(fileSize);
+        if((fileSize > 0) && (SDL_RWread(file.get(), &source[0], fileSize, 1) != 1)) {
+            THROW(std::runtime_error, "ObjectData::loadFromINIFile(): Reading '%s' failed!", filename);
+        }
+    }
+
+    unsigned char sourceHash[16];
+    md5(reinterpret_cast<const unsigned char*>(source.data()), static_cast<int>(source.size()), sourceHash);
+
+    char cacheDirectory[FILENAME_MAX];
+    fnkdat(OBJECTDATA_CACHE_DIRECTORY "/", cacheDirectory, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+    const std::string cacheFilepath = std::string(cacheDirectory) + getBasename(filename, true) + ".bin";
+
+    if(loadFromCache(cacheFilepath, sourceHash)) {
+        return;
+    }
+
+    INIFile objectDataFile(sdl2::RWops_ptr{ SDL_RWFromConstMem(source.data(), static_cast<int>(source.size())) }.get());
+    parseINIFile(objectDataFile);
+
+    saveToCache(cacheFilepath, sourceHash);
+}
 
+void ObjectData::parseINIFile(const INIFile& objectDataFile)
+{
     // load default structure values
     ObjectDataStruct structureDefaultData[NUM_HOUSES];
     for(int h=0;h<NUM_HOUSES;h++) {
@@ -153,25 +192,15 @@ void ObjectData::loadFromINIFile(const std::string& filename)
 
 void ObjectData::save(OutputStream& stream) const
 {
+    // most houses use the same values as the first one, so only the different ones are stored completely
     for(int i=0;i<Num_ItemID;i++) {
-        for(int h=0;h<NUM_HOUSES;h++) {
-            stream.writeBool(data[i][h].enabled);
-            stream.writeSint32(data[i][h].hitpoints);
-            stream.writeSint32(data[i][h].price);
-            stream.writeSint32(data[i][h].power);
-            stream.writeSint32(data[i][h].viewrange);
-            stream.writeSint32(data[i][h].capacity);
-            stream.writeSint32(data[i][h].weapondamage);
-            stream.writeSint32(data[i][h].weaponrange);
-            stream.writeSint32(data[i][h].weaponreloadtime);
-            stream.writeFixPoint(data[i][h].maxspeed);
-            stream.writeFixPoint(data[i][h].turnspeed);
-            stream.writeSint32(data[i][h].buildtime);
-            stream.writeSint32(data[i][h].infspawnprop);
-            stream.writeSint32(data[i][h].builder);
-            stream.writeUint32((Uint32) data[i][h].prerequisiteStructuresSet.to_ulong());
-            stream.writeSint8(data[i][h].techLevel);
-            stream.writeSint8(data[i][h].upgradeLevel);
+        saveObjectDataStruct(stream, data[i][0]);
+        for(int h=1;h<NUM_HOUSES;h++) {
+            const bool bSameAsFirstHouse = (data[i][h] == data[i][0]);
+            stream.writeBool(bSameAsFirstHouse);
+            if(!bSameAsFirstHouse) {
+                saveObjectDataStruct(stream, data[i][h]);
+            }
         }
     }
 }
@@ -179,28 +208,122 @@ void ObjectData::save(OutputStream& stream) const
 void ObjectData::load(InputStream& stream)
 {
     for(int i=0;i<Num_ItemID;i++) {
-        for(int h=0;h<NUM_HOUSES;h++) {
-            data[i][h].enabled = stream.readBool();
-            data[i][h].hitpoints = stream.readSint32();
-            data[i][h].price = stream.readSint32();
-            data[i][h].power = stream.readSint32();
-            data[i][h].viewrange = stream.readSint32();
-            data[i][h].capacity = stream.readSint32();
-            data[i][h].weapondamage = stream.readSint32();
-            data[i][h].weaponrange = stream.readSint32();
-            data[i][h].weaponreloadtime = stream.readSint32();
-            data[i][h].maxspeed = stream.readFixPoint();
-            data[i][h].turnspeed = stream.readFixPoint();
-            data[i][h].buildtime = stream.readSint32();
-            data[i][h].infspawnprop = stream.readSint32();
-            data[i][h].builder = stream.readSint32();
-            data[i][h].prerequisiteStructuresSet = std::bitset<Structure_LastID + 1>( (unsigned long) stream.readUint32());
-            data[i][h].techLevel = stream.readSint8();
-            data[i][h].upgradeLevel = stream.readSint8();
+        loadObjectDataStruct(stream, data[i][0]);
+        for(int h=1;h<NUM_HOUSES;h++) {
+            if(stream.readBool()) {
+                data[i][h] = data[i][0];
+            } else {
+                loadObjectDataStruct(stream, data[i][h]);
+            }
         }
     }
 }
 
+void ObjectData::saveObjectDataStruct(OutputStream& stream, const ObjectDataStruct& objectDataStruct)
+{
+    stream.writeBool(objectDataStruct.enabled);
+    stream.writeSint32(objectDataStruct.hitpoints);
+    stream.writeSint32(objectDataStruct.price);
+    stream.writeSint32(objectDataStruct.power);
+    stream.writeSint32(objectDataStruct.viewrange);
+    stream.writeSint32(objectDataStruct.capacity);
+    stream.writeSint32(objectDataStruct.weapondamage);
+    stream.writeSint32(objectDataStruct.weaponrange);
+    stream.writeSint32(objectDataStruct.weaponreloadtime);
+    stream.writeFixPoint(objectDataStruct.maxspeed);
+    stream.writeFixPoint(objectDataStruct.turnspeed);
+    stream.writeSint32(objectDataStruct.buildtime);
+    stream.writeSint32(objectDataStruct.infspawnprop);
+    stream.writeSint32(objectDataStruct.builder);
+    stream.writeUint32((Uint32) objectDataStruct.prerequisiteStructuresSet.to_ulong());
+    stream.writeSint8(objectDataStruct.techLevel);
+    stream.writeSint8(objectDataStruct.upgradeLevel);
+}
+
+void ObjectData::loadObjectDataStruct(InputStream& stream, ObjectDataStruct& objectDataStruct)
+{
+    objectDataStruct.enabled = stream.readBool();
+    objectDataStruct.hitpoints = stream.readSint32();
+    objectDataStruct.price = stream.readSint32();
+    objectDataStruct.power = stream.readSint32();
+    objectDataStruct.viewrange = stream.readSint32();
+    objectDataStruct.capacity = stream.readSint32();
+    objectDataStruct.weapondamage = stream.readSint32();
+    objectDataStruct.weaponrange = stream.readSint32();
+    objectDataStruct.weaponreloadtime = stream.readSint32();
+    objectDataStruct.maxspeed = stream.readFixPoint();
+    objectDataStruct.turnspeed = stream.readFixPoint();
+    objectDataStruct.buildtime = stream.readSint32();
+    objectDataStruct.infspawnprop = stream.readSint32();
+    objectDataStruct.builder = stream.readSint32();
+    objectDataStruct.prerequisiteStructuresSet = std::bitset<Structure_LastID + 1>( (unsigned long) stream.readUint32());
+    objectDataStruct.techLevel = stream.readSint8();
+    objectDataStruct.upgradeLevel = stream.readSint8();
+}
+
+bool ObjectData::loadFromCache(const std::string& cacheFilepath, const unsigned char sourceHash[16])
+{
+    if(!existsFile(cacheFilepath)) {
+        return false;
+    }
+
+    try {
+        const std::string compiledData = readCompleteFile(cacheFilepath);
+        IMemoryStream stream(compiledData.data(), static_cast<int>(compiledData.size()));
+
+        if((stream.readUint32() != OBJECTDATA_CACHE_MAGIC) || (stream.readUint32() != OBJECTDATA_CACHE_VERSION)
+            || (stream.readUint32() != Num_ItemID) || (stream.readUint32() != NUM_HOUSES)) {
+            return false;
+        }
+
+        for(int i = 0; i < 16; i++) {
+            if(stream.readUint8() != sourceHash[i]) {
+                return false;
+            }
+        }
+
+        // load into a temporary copy so that a truncated file does not leave half of the data behind
+        auto pCompiled = std::make_unique<ObjectData>();
+        pCompiled->load(stream);
+        std::copy(&pCompiled->data[0][0], &pCompiled->data[0][0] + Num_ItemID*NUM_HOUSES, &data[0][0]);
+    } catch(std::exception& e) {
+        SDL_Log("ObjectData: Ignoring compiled object data '%s': %s", cacheFilepath.c_str(), e.what());
+        return false;
+    }
+
+    return true;
+}
+
+void ObjectData::saveToCache(const std::string& cacheFilepath, const unsigned char sourceHash[16]) const
+{
+    OMemoryStream stream;
+    stream.open();
+
+    stream.writeUint32(OBJECTDATA_CACHE_MAGIC);
+    stream.writeUint32(OBJECTDATA_CACHE_VERSION);
+    stream.writeUint32(Num_ItemID);
+    stream.writeUint32(NUM_HOUSES);
+    for(int i = 0; i < 16; i++) {
+        stream.writeUint8(sourceHash[i]);
+    }
+    save(stream);
+
+    // write to a temporary file first so that concurrently starting games never see a partially written file
+    const std::string tmpFilepath = cacheFilepath + ".tmp";
+    bool bWriteOk = false;
+    {
+        sdl2::RWops_ptr file{ SDL_RWFromFile(tmpFilepath.c_str(), "wb") };
+        if(file) {
+            bWriteOk = (SDL_RWwrite(file.get(), stream.getData(), stream.getDataLength(), 1) == 1);
+        }
+    }
+
+    if(!bWriteOk || (std::rename(tmpFilepath.c_str(), cacheFilepath.c_str()) != 0)) {
+        SDL_Log("ObjectData: Cannot write compiled object data to '%s'", cacheFilepath.c_str());
+        std::remove(tmpFilepath.c_str());
+    }
+}
+
 int ObjectData::loadIntValue(const INIFile& objectDataFile, const std::string& section, const std::string& key, char houseChar, int defaultValue) {
     std::string specializedKey = key + "(" + houseChar + ")";
     if(objectDataFile.hasKey(section, specializedKey)) {
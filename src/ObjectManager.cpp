@@ -22,21 +22,37 @@
 #include <Game.h>
 #include <ObjectBase.h>
 
+#include <utility>
+
 void ObjectManager::save(OutputStream& stream) const {
     stream.writeUint32(nextFreeObjectID);
 
-    stream.writeUint32(objectMap.size());
-    for(const auto& objectEntry : objectMap) {
-        stream.writeUint32(objectEntry.second->getObjectID());
-        currentGame->saveObject(stream, objectEntry.second);
+    stream.writeUint32(numObjects);
+    for(const auto& page : pages) {
+        for(Uint32 i = 0; i < OBJECTMANAGER_PAGESIZE; i++) {
+            ObjectBase* pObject = page[i];
+            if(pObject != nullptr) {
+                stream.writeUint32(pObject->getObjectID());
+                currentGame->saveObject(stream, pObject);
+            }
+        }
     }
 }
 
 void ObjectManager::load(InputStream& stream) {
     nextFreeObjectID = stream.readUint32();
 
-    Uint32 numObjects = stream.readUint32();
-    for(Uint32 i=0;i<numObjects;i++) {
+    const Uint32 numSavedObjects = stream.readUint32();
+
+    // all object IDs are below nextFreeObjectID
+    allocateSlots(nextFreeObjectID);
+    unitList.reserve(numSavedObjects);
+    structureList.reserve(numSavedObjects);
+
+    // first create all objects...
+    std::vector<std::pair<Uint32, ObjectBase*>> loadedObjects;
+    loadedObjects.reserve(numSavedObjects);
+    for(Uint32 i=0;i<numSavedObjects;i++) {
         Uint32 objectID = stream.readUint32();
 
         ObjectBase* pObject = currentGame->loadObject(stream,objectID);
@@ -44,19 +60,42 @@ void ObjectManager::load(InputStream& stream) {
             SDL_Log("ObjectManager::load(): The loaded object has a different ID than expected (%d!=%d)!",objectID,pObject->getObjectID());
         }
 
-        objectMap.insert( std::pair<Uint32,ObjectBase*>(objectID, pObject) );
+        loadedObjects.emplace_back(objectID, pObject);
+    }
+
+    // ...and then link them
+    for(const auto& loadedObject : loadedObjects) {
+        if(getObject(loadedObject.first) == nullptr) {
+            insertObject(loadedObject.first, loadedObject.second);
+        }
     }
 }
 
 Uint32 ObjectManager::addObject(ObjectBase* pObject) {
-    std::pair<ObjectMap::iterator,bool> insertPosition;
-
-    insertPosition = objectMap.insert( std::pair<Uint32,ObjectBase*>(nextFreeObjectID, pObject) );
-
-    if(insertPosition.second == false) {
+    if(getObject(nextFreeObjectID) != nullptr) {
         // there is already such an object in the list
         return NONE_ID;
     } else {
+        insertObject(nextFreeObjectID, pObject);
         return nextFreeObjectID++;  // Caution: Old value is returned but value is incremented afterwards
     }
 }
+
+void ObjectManager::insertObject(Uint32 objectID, ObjectBase* pObject) {
+    allocateSlots(objectID);
+
+    pages[objectID / OBJECTMANAGER_PAGESIZE][objectID % OBJECTMANAGER_PAGESIZE] = pObject;
+    numObjects++;
+}
+
+void ObjectManager::allocateSlots(Uint32 maxObjectID) {
+    const size_t numPages = maxObjectID / OBJECTMANAGER_PAGESIZE + 1;
+    if(numPages <= pages.size()) {
+        return;
+    }
+
+    pages.reserve(numPages);
+    while(pages.size() < numPages) {
+        pages.emplace_back(new ObjectBase*[OBJECTMANAGER_PAGESIZE]());
+    }
+}
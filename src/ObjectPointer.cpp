@@ -22,15 +22,14 @@
 #include <Game.h>
 #include <ObjectBase.h>
 
-ObjectBase* ObjectPointer::getObjPointer() const
+ObjectBase* ObjectPointer::resolve() const
 {
-    if(objectID == NONE_ID) {
-        return nullptr;
-    }
+    pSlot = currentGame->getObjectManager().getSlot(objectID);
 
-    ObjectBase* ObjPointer = currentGame->getObjectManager().getObject(objectID);
+    ObjectBase* ObjPointer = (pSlot != nullptr) ? *pSlot : nullptr;
     if(ObjPointer == nullptr) {
         objectID = NONE_ID;
+        pSlot = nullptr;
     }
     return ObjPointer;
 }
@@ -52,4 +51,5 @@ void ObjectPointer::pointTo(const ObjectBase* newObject)
     } else {
         objectID = NONE_ID;
     }
+    pSlot = nullptr;
 }
@@ -0,0 +1,212 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <PathCache.h>
+
+#include <globals.h>
+
+#include <FlowFieldCache.h>
+#include <Game.h>
+#include <Map.h>
+#include <mmath.h>
+#include <misc/InputStream.h>
+#include <misc/OutputStream.h>
+#include <units/UnitBase.h>
+
+#include <algorithm>
+
+#define PATHCACHE_MAX_PATHS         32                      ///< maximum number of paths kept at the same time
+#define PATHCACHE_LIFETIME          MILLI2CYCLES(5*1000)    ///< paths older than this are discarded
+#define PATHCACHE_SPLICE_STEPS      4                       ///< number of steps of a path searched for a tile to re-join it
+#define PATHCACHE_SPLICE_DISTANCE   2                       ///< units closer than this to each other wait for a shared path
+#define PATHCACHE_CHECKED_STEPS     3                       ///< number of path steps checked against the current map state
+
+PathCache::PathCache(const Map* pMap)
+ : pMap(pMap), numHits(0), numSplicedHits(0), numMisses(0) {
+}
+
+void PathCache::reset() {
+    cachedPaths.clear();
+    numHits = 0;
+    numSplicedHits = 0;
+    numMisses = 0;
+}
+
+void PathCache::invalidate() {
+    cachedPaths.clear();
+}
+
+void PathCache::load(InputStream& stream) {
+    cachedPaths.clear();
+
+    const Uint32 numPaths = stream.readUint32();
+    for(Uint32 i = 0; i < numPaths; i++) {
+        CachedPath cachedPath;
+        cachedPath.key.movementClass = stream.readSint32();
+        cachedPath.key.targetID = stream.readUint32();
+        cachedPath.key.destination.x = stream.readSint32();
+        cachedPath.key.destination.y = stream.readSint32();
+        cachedPath.start.x = stream.readSint32();
+        cachedPath.start.y = stream.readSint32();
+        cachedPath.cycle = stream.readUint32();
+
+        const Uint32 numSteps = stream.readUint32();
+        std::vector<Sint32> pathCoords(2*numSteps);
+        stream.readSint32Array(pathCoords.data(), pathCoords.size());
+        std::vector<Coord> steps;
+        steps.reserve(numSteps);
+        for(Uint32 j = 0; j < numSteps; j++) {
+            steps.emplace_back(pathCoords[2*j], pathCoords[2*j+1]);
+        }
+        cachedPath.path = std::make_shared<const std::vector<Coord>>(std::move(steps));
+
+        cachedPaths.push_back(std::move(cachedPath));
+    }
+}
+
+void PathCache::save(OutputStream& stream) const {
+    stream.writeUint32(cachedPaths.size());
+    for(const CachedPath& cachedPath : cachedPaths) {
+        stream.writeSint32(cachedPath.key.movementClass);
+        stream.writeUint32(cachedPath.key.targetID);
+        stream.writeSint32(cachedPath.key.destination.x);
+        stream.writeSint32(cachedPath.key.destination.y);
+        stream.writeSint32(cachedPath.start.x);
+        stream.writeSint32(cachedPath.start.y);
+        stream.writeUint32(cachedPath.cycle);
+
+        std::vector<Sint32> pathCoords;
+        pathCoords.reserve(2*cachedPath.path->size());
+        for(const Coord& coord : *cachedPath.path) {
+            pathCoords.push_back(coord.x);
+            pathCoords.push_back(coord.y);
+        }
+        stream.writeUint32(cachedPath.path->size());
+        stream.writeSint32Array(pathCoords.data(), pathCoords.size());
+    }
+}
+
+bool PathCache::getPath(const UnitBase* pUnit, const Coord& destination, std::list<Coord>& path) {
+    Key key;
+    if(!getKey(pUnit, destination, key)) {
+        return false;
+    }
+
+    const Uint32 cycle = currentGame->getGameCycleCount();
+    cachedPaths.erase(std::remove_if(cachedPaths.begin(), cachedPaths.end(),
+                                     [cycle](const CachedPath& cachedPath) { return cachedPath.cycle + PATHCACHE_LIFETIME < cycle; }),
+                      cachedPaths.end());
+
+    const Coord& location = pUnit->getLocation();
+
+    const auto isPassable = [&](std::vector<Coord>::const_iterator first, std::vector<Coord>::const_iterator last) {
+        for(int i = 0; (first != last) && (i < PATHCACHE_CHECKED_STEPS); ++first, ++i) {
+            if(!pUnit->canPass(first->x, first->y)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    auto iter = std::find_if(cachedPaths.begin(), cachedPaths.end(),
+                             [&](const CachedPath& cachedPath) { return (cachedPath.key == key) && (cachedPath.start == location); });
+
+    if(iter != cachedPaths.end()) {
+        if(isPassable(iter->path->begin(), iter->path->end())) {
+            path.assign(iter->path->begin(), iter->path->end());
+            numHits++;
+            return true;
+        }
+    } else {
+        for(const CachedPath& cachedPath : cachedPaths) {
+            if(!(cachedPath.key == key)) {
+                continue;
+            }
+
+            // re-join the path at the last of its first steps next to our location
+            const std::vector<Coord>& steps = *cachedPath.path;
+            const int numSteps = std::min(static_cast<int>(steps.size()), PATHCACHE_SPLICE_STEPS);
+            auto joinIter = steps.end();
+            for(int i = 0; i < numSteps; i++) {
+                if(steps[i] == location) {
+                    joinIter = steps.begin() + i + 1;
+                } else if(maximumDistance(steps[i], location) == 1) {
+                    joinIter = steps.begin() + i;
+                }
+            }
+
+            if((joinIter != steps.end()) && isPassable(joinIter, steps.end())) {
+                path.assign(joinIter, steps.end());
+                numSplicedHits++;
+                return true;
+            }
+        }
+    }
+
+    numMisses++;
+    return false;
+}
+
+void PathCache::addPath(const UnitBase* pUnit, const Coord& destination, const std::list<Coord>& path) {
+    Key key;
+    if(path.empty() || !getKey(pUnit, destination, key)) {
+        return;
+    }
+
+    const Coord& location = pUnit->getLocation();
+    auto iter = std::find_if(cachedPaths.begin(), cachedPaths.end(),
+                             [&](const CachedPath& cachedPath) { return (cachedPath.key == key) && (cachedPath.start == location); });
+
+    if(iter == cachedPaths.end()) {
+        if(cachedPaths.size() >= PATHCACHE_MAX_PATHS) {
+            cachedPaths.erase(std::min_element(cachedPaths.begin(), cachedPaths.end(),
+                                               [](const CachedPath& a, const CachedPath& b) { return a.cycle < b.cycle; }));
+        }
+
+        cachedPaths.emplace_back();
+        iter = std::prev(cachedPaths.end());
+        iter->key = key;
+        iter->start = location;
+    }
+
+    iter->cycle = currentGame->getGameCycleCount();
+    iter->path = std::make_shared<const std::vector<Coord>>(path.begin(), path.end());
+}
+
+bool PathCache::canShare(const UnitBase* pUnit, const Coord& destination, const UnitBase* pOther, const Coord& otherDestination) const {
+    Key key;
+    Key otherKey;
+    if(!getKey(pUnit, destination, key) || !getKey(pOther, otherDestination, otherKey)) {
+        return false;
+    }
+
+    return (key == otherKey) && (maximumDistance(pUnit->getLocation(), pOther->getLocation()) <= PATHCACHE_SPLICE_DISTANCE);
+}
+
+bool PathCache::getKey(const UnitBase* pUnit, const Coord& destination, Key& key) {
+    const ObjectBase* pTarget = pUnit->getTarget();
+
+    key.movementClass = FlowFieldCache::getMovementClass(pUnit);
+    if((key.movementClass < 0) || ((pTarget != nullptr) && pUnit->isTargetFriendly())) {
+        // the path of units moving to a friendly structure depends on the state of that structure (e.g. a free repair yard)
+        return false;
+    }
+
+    key.targetID = (pTarget != nullptr) ? pTarget->getObjectID() : NONE_ID;
+    key.destination = destination;
+    return true;
+}
@@ -0,0 +1,130 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <PathRequestQueue.h>
+
+#include <globals.h>
+
+#include <Game.h>
+#include <House.h>
+#include <Map.h>
+#include <AStarSearch.h>
+#include <misc/InputStream.h>
+#include <misc/OutputStream.h>
+#include <misc/WorkerPool.h>
+#include <misc/Tracing.h>
+#include <units/UnitBase.h>
+
+#include <algorithm>
+#include <utility>
+
+#define PATHREQUEST_NODEBUDGET      (128*128)   ///< number of AStarSearch nodes that may be expanded per game cycle
+#define PATHREQUEST_BATCHSIZE       8           ///< number of searches run in parallel (fixed to keep the game deterministic)
+
+PathRequestQueue::PathRequestQueue(Map* pMap)
+ : pMap(pMap) {
+    batch.reserve(PATHREQUEST_BATCHSIZE);
+}
+
+void PathRequestQueue::reset() {
+    pendingRequests.clear();
+    batch.clear();
+}
+
+void PathRequestQueue::load(InputStream& stream) {
+    stream.readUint32List(pendingRequests);
+    batch.clear();
+}
+
+void PathRequestQueue::save(OutputStream& stream) const {
+    // the batch is only filled inside service(), so the pending requests are the complete state between two cycles
+    stream.writeUint32List(pendingRequests);
+}
+
+void PathRequestQueue::request(const UnitBase* pUnit) {
+    pendingRequests.push_back(pUnit->getObjectID());
+}
+
+void PathRequestQueue::service() {
+    int nodesLeft = PATHREQUEST_NODEBUDGET;
+
+    while(!pendingRequests.empty() && (nodesLeft > 0)) {
+        batch.clear();
+
+        while(!pendingRequests.empty() && (batch.size() < PATHREQUEST_BATCHSIZE)) {
+            ObjectBase* pObject = currentGame->getObjectManager().getObject(pendingRequests.front());
+            pendingRequests.pop_front();
+
+            if((pObject == nullptr) || !pObject->isAUnit()) {
+                // the unit was destroyed in the meantime
+                continue;
+            }
+
+            UnitBase* pUnit = static_cast<UnitBase*>(pObject);
+            if(!pUnit->isPathRequested()) {
+                // the request was cancelled in the meantime (e.g. the unit got a new destination)
+                continue;
+            }
+
+            Search search;
+            search.pUnit = pUnit;
+            search.numNodesChecked = 0;
+            if(pUnit->preparePathSearch(search.destination, search.path)) {
+                // no search needed (e.g. the path was taken from a flow field)
+                pUnit->onPathSearchFinished(std::move(search.path));
+                continue;
+            }
+
+            if(std::any_of(batch.begin(), batch.end(), [&](const Search& other) {
+                    return pMap->getPathCache().canShare(pUnit, search.destination, other.pUnit, other.destination);
+                })) {
+                // wait for the result of a unit right next to us instead of searching the same path again
+                pendingRequests.push_front(pUnit->getObjectID());
+                break;
+            }
+
+            if(pMap->getPathCache().getPath(pUnit, search.destination, search.path)) {
+                // another unit started at the same location or close to it
+                pUnit->onPathSearchFinished(std::move(search.path));
+                continue;
+            }
+
+            batch.push_back(std::move(search));
+        }
+
+        GameContext* pContext = GameContext::getCurrent();
+        currentGame->getWorkerPool().parallelFor(static_cast<int>(batch.size()), [this, pContext](int i) {
+            GameContext::Scope contextScope(pContext);
+            TRACE_ZONE("AStarSearch");
+            Search& search = batch[i];
+            SIMULATION_STATS_HOUSE(search.pUnit->getOwner()->getHouseID());
+            AStarSearch pathfinder(pMap, search.pUnit, search.pUnit->getLocation(), search.destination);
+            search.path = pathfinder.getFoundPath();
+            search.numNodesChecked = pathfinder.getNumNodesChecked();
+        });
+
+        for(Search& search : batch) {
+            nodesLeft -= search.numNodesChecked;
+            pMap->getPathCache().addPath(search.pUnit, search.destination, search.path);
+            search.pUnit->onPathSearchFinished(std::move(search.path));
+        }
+    }
+
+    batch.clear();
+
+    TRACE_COUNTER("Path nodes expanded", PATHREQUEST_NODEBUDGET - nodesLeft);
+}
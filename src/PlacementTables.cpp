@@ -0,0 +1,148 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <PlacementTables.h>
+
+#include <Map.h>
+#include <Tile.h>
+#include <TilePlanes.h>
+
+#include <algorithm>
+
+PlacementTables::PlacementTables(const Map* pMap) : pMap(pMap) {
+}
+
+void PlacementTables::reset() {
+    for(auto& table : tables) {
+        table.clear();
+    }
+
+    bStructuresDirty = true;
+    bValid = false;
+}
+
+int PlacementTables::countRock(int x, int y, int width, int height) const {
+    return count(Table_Rock, x, y, width, height);
+}
+
+int PlacementTables::countSlab(int x, int y, int width, int height) const {
+    return count(Table_Slab, x, y, width, height);
+}
+
+int PlacementTables::countBlocked(int x, int y, int width, int height) const {
+    return count(Table_Blocked, x, y, width, height);
+}
+
+int PlacementTables::countStructures(int x, int y, int width, int height) const {
+    return count(Table_Structure, x, y, width, height);
+}
+
+int PlacementTables::countOwnedBy(int houseID, int x, int y, int width, int height) const {
+    if((houseID < 0) || (houseID >= NUM_HOUSES)) {
+        return 0;
+    }
+
+    return count(Table_Owner + houseID, x, y, width, height);
+}
+
+int PlacementTables::count(int table, int x, int y, int width, int height) const {
+    update();
+
+    const auto sizeX = pMap->getSizeX();
+    const auto sizeY = pMap->getSizeY();
+
+    const auto x1 = std::max(x, 0);
+    const auto y1 = std::max(y, 0);
+    const auto x2 = std::min(x + width, sizeX);
+    const auto y2 = std::min(y + height, sizeY);
+
+    if((x1 >= x2) || (y1 >= y2)) {
+        return 0;
+    }
+
+    const auto& sums = tables[table];
+    const auto stride = sizeY + 1;
+
+    return sums[x2*stride + y2] - sums[x1*stride + y2] - sums[x2*stride + y1] + sums[x1*stride + y1];
+}
+
+void PlacementTables::update() const {
+    const auto& planes = pMap->getTilePlanes();
+
+    const bool bTerrainChanged = !bValid || (terrainVersion != planes.getTerrainVersion());
+    const bool bBlockedChanged = !bValid || (blockedVersion != planes.getBlockedVersion());
+    const bool bOwnerChanged = !bValid || (ownerVersion != planes.getOwnerVersion());
+    const bool bStructuresChanged = bTerrainChanged || bStructuresDirty;
+
+    if(!bTerrainChanged && !bBlockedChanged && !bOwnerChanged && !bStructuresChanged) {
+        return;
+    }
+
+    const auto sizeX = pMap->getSizeX();
+    const auto sizeY = pMap->getSizeY();
+    const auto stride = sizeY + 1;
+
+    // sums[x*stride + y] is the number of tiles in [0,x) x [0,y) having the property
+    const auto build = [&](std::vector<int>& sums, auto&& hasProperty) {
+        sums.assign(static_cast<size_t>(sizeX + 1) * stride, 0);
+
+        for(int x = 0; x < sizeX; x++) {
+            for(int y = 0; y < sizeY; y++) {
+                sums[(x+1)*stride + (y+1)] = sums[x*stride + (y+1)] + sums[(x+1)*stride + y] - sums[x*stride + y]
+                                             + (hasProperty(x, y) ? 1 : 0);
+            }
+        }
+    };
+
+    if(bTerrainChanged) {
+        build(tables[Table_Rock], [&](int x, int y) {
+            const auto type = planes.getTerrainType(pMap->getTileIndex(x, y));
+            return (type == Terrain_Rock) || (type == Terrain_Slab) || (type == Terrain_Mountain);
+        });
+
+        build(tables[Table_Slab], [&](int x, int y) {
+            return planes.getTerrainType(pMap->getTileIndex(x, y)) == Terrain_Slab;
+        });
+    }
+
+    if(bBlockedChanged) {
+        build(tables[Table_Blocked], [&](int x, int y) {
+            return planes.isBlocked(pMap->getTileIndex(x, y));
+        });
+    }
+
+    if(bStructuresChanged) {
+        build(tables[Table_Structure], [&](int x, int y) {
+            const auto pTile = pMap->getTile(x, y);
+            return pTile->hasAStructure() && !pTile->isConcrete();
+        });
+    }
+
+    if(bOwnerChanged) {
+        for(int houseID = 0; houseID < NUM_HOUSES; houseID++) {
+            build(tables[Table_Owner + houseID], [&](int x, int y) {
+                return planes.getOwner(pMap->getTileIndex(x, y)) == houseID;
+            });
+        }
+    }
+
+    terrainVersion = planes.getTerrainVersion();
+    blockedVersion = planes.getBlockedVersion();
+    ownerVersion = planes.getOwnerVersion();
+    bStructuresDirty = false;
+    bValid = true;
+}
@@ -0,0 +1,117 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Profiler.h>
+
+#include <misc/exceptions.h>
+
+#include <algorithm>
+#include <cstdio>
+
+void Profiler::commitSamples(int firstPhase, int lastPhase) {
+    static const Uint64 frequency = SDL_GetPerformanceFrequency();
+
+    for(int phase = firstPhase; phase < lastPhase; phase++) {
+        std::vector<Uint32>& phaseSamples = samples[phase];
+        if(phaseSamples.empty()) {
+            phaseSamples.resize(PROFILER_NUM_SAMPLES);
+        }
+
+        phaseSamples[numSamples[phase] % PROFILER_NUM_SAMPLES] = static_cast<Uint32>((pendingTicks[phase] * 1000000) / frequency);
+        numSamples[phase]++;
+        pendingTicks[phase] = 0;
+    }
+}
+
+Profiler::Statistics Profiler::getStatistics(ProfilerPhase phase) const {
+    Statistics statistics;
+
+    statistics.numSamples = std::min(numSamples[phase], (Uint32) PROFILER_NUM_SAMPLES);
+    if(statistics.numSamples == 0) {
+        return statistics;
+    }
+
+    std::vector<Uint32> sortedSamples(samples[phase].begin(), samples[phase].begin() + statistics.numSamples);
+    std::sort(sortedSamples.begin(), sortedSamples.end());
+
+    Uint64 sum = 0;
+    for(Uint32 sample : sortedSamples) {
+        sum += sample;
+    }
+
+    statistics.min = (float) sortedSamples.front();
+    statistics.avg = (float) sum / statistics.numSamples;
+    statistics.p99 = (float) sortedSamples[(statistics.numSamples * 99) / 100];
+    statistics.max = (float) sortedSamples.back();
+
+    return statistics;
+}
+
+bool Profiler::saveCSV(const std::string& filename) const {
+    FILE* file = fopen(filename.c_str(), "w");
+    if(file == nullptr) {
+        SDL_Log("Profiler::saveCSV(): Cannot open '%s'!", filename.c_str());
+        return false;
+    }
+
+    fprintf(file, "phase,sample,microseconds\n");
+
+    for(int phase = 0; phase < NUM_PROFILERPHASES; phase++) {
+        // write the samples in the order they were taken
+        const Uint32 numPhaseSamples = std::min(numSamples[phase], (Uint32) PROFILER_NUM_SAMPLES);
+        const Uint32 firstSample = numSamples[phase] - numPhaseSamples;
+        for(Uint32 i = firstSample; i < numSamples[phase]; i++) {
+            fprintf(file, "%s,%u,%u\n", getPhaseName((ProfilerPhase) phase), i, samples[phase][i % PROFILER_NUM_SAMPLES]);
+        }
+    }
+
+    const bool bSuccess = (ferror(file) == 0);
+    fclose(file);
+
+    return bSuccess;
+}
+
+const char* Profiler::getPhaseName(ProfilerPhase phase) {
+    switch(phase) {
+        case ProfilerPhase_Cycle:                   return "Cycle";
+        case ProfilerPhase_Network:                 return "Network";
+        case ProfilerPhase_Commands:                return "Commands";
+        case ProfilerPhase_Houses:                  return "Houses";
+        case ProfilerPhase_AIPlayers:               return "AIPlayers";
+        case ProfilerPhase_Tiles:                   return "Tiles";
+        case ProfilerPhase_PathRequests:            return "PathRequests";
+        case ProfilerPhase_TargetScans:             return "TargetScans";
+        case ProfilerPhase_Structures:              return "Structures";
+        case ProfilerPhase_Units:                   return "Units";
+        case ProfilerPhase_Bullets:                 return "Bullets";
+        case ProfilerPhase_Explosions:              return "Explosions";
+        case ProfilerPhase_Frame:                   return "Frame";
+        case ProfilerPhase_DrawGround:              return "DrawGround";
+        case ProfilerPhase_DrawStructures:          return "DrawStructures";
+        case ProfilerPhase_DrawUndergroundUnits:    return "DrawUndergroundUnits";
+        case ProfilerPhase_DrawDeadUnits:           return "DrawDeadUnits";
+        case ProfilerPhase_DrawInfantry:            return "DrawInfantry";
+        case ProfilerPhase_DrawGroundUnits:         return "DrawGroundUnits";
+        case ProfilerPhase_DrawBullets:             return "DrawBullets";
+        case ProfilerPhase_DrawExplosions:          return "DrawExplosions";
+        case ProfilerPhase_DrawAirUnits:            return "DrawAirUnits";
+        case ProfilerPhase_DrawSelectionRects:      return "DrawSelectionRects";
+        case ProfilerPhase_DrawFog:                 return "DrawFog";
+        case ProfilerPhase_DrawInterface:           return "DrawInterface";
+        default: THROW(std::invalid_argument, "Profiler::getPhaseName(): Invalid phase %d!", phase);
+    }
+}
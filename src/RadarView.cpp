@@ -70,23 +70,24 @@ void RadarView::draw(Point position)
             int mapSizeY = currentGameMap->getSizeY();
 
             int scale = 1;
+            int downsampling = 1;
             int offsetX = 0;
             int offsetY = 0;
 
-            calculateScaleAndOffsets(mapSizeX, mapSizeY, scale, offsetX, offsetY);
+            calculateScaleAndOffsets(mapSizeX, mapSizeY, scale, downsampling, offsetX, offsetY);
 
-            updateRadarSurface(mapSizeX, mapSizeY, scale, offsetX, offsetY);
+            updateRadarSurface(mapSizeX, mapSizeY, scale, downsampling, offsetX, offsetY);
 
-            SDL_UpdateTexture(radarTexture.get(), nullptr, radarSurface->pixels, radarSurface->pitch);
+            updateRadarTexture(radarTexture.get(), radarSurface.get());
 
             SDL_Rect dest = calcDrawingRect(radarTexture.get(), radarPosition.x, radarPosition.y);
             SDL_RenderCopy(renderer, radarTexture.get(), nullptr, &dest);
 
             SDL_Rect radarRect;
-            radarRect.x = (screenborder->getLeft() * mapSizeX*scale) / (mapSizeX*TILESIZE) + offsetX;
-            radarRect.y = (screenborder->getTop() * mapSizeY*scale) / (mapSizeY*TILESIZE) + offsetY;
-            radarRect.w = ((screenborder->getRight() - screenborder->getLeft()) * mapSizeX*scale) / (mapSizeX*TILESIZE);
-            radarRect.h = ((screenborder->getBottom() - screenborder->getTop()) * mapSizeY*scale) / (mapSizeY*TILESIZE);
+            radarRect.x = (screenborder->getLeft() * scale) / (TILESIZE * downsampling) + offsetX;
+            radarRect.y = (screenborder->getTop() * scale) / (TILESIZE * downsampling) + offsetY;
+            radarRect.w = ((screenborder->getRight() - screenborder->getLeft()) * scale) / (TILESIZE * downsampling);
+            radarRect.h = ((screenborder->getBottom() - screenborder->getTop()) * scale) / (TILESIZE * downsampling);
 
             if(radarRect.x < offsetX) {
                 radarRect.w -= radarRect.x;
@@ -98,12 +99,12 @@ void RadarView::draw(Point position)
                 radarRect.y = offsetY;
             }
 
-            int offsetFromRightX = 128 - mapSizeX*scale - offsetX;
+            int offsetFromRightX = 128 - getRadarSize(mapSizeX, scale, downsampling) - offsetX;
             if(radarRect.x + radarRect.w > radarPosition.w - offsetFromRightX) {
                 radarRect.w  = radarPosition.w - offsetFromRightX - radarRect.x - 1;
             }
 
-            int offsetFromBottomY = 128 - mapSizeY*scale - offsetY;
+            int offsetFromBottomY = 128 - getRadarSize(mapSizeY, scale, downsampling) - offsetY;
             if(radarRect.y + radarRect.h > radarPosition.h - offsetFromBottomY) {
                 radarRect.h = radarPosition.h - offsetFromBottomY - radarRect.y - 1;
             }
@@ -192,25 +193,38 @@ void RadarView::switchRadarMode(bool bOn) {
     }
 }
 
-void RadarView::updateRadarSurface(int mapSizeX, int mapSizeY, int scale, int offsetX, int offsetY) {
+void RadarView::updateRadarSurface(int mapSizeX, int mapSizeY, int scale, int downsampling, int offsetX, int offsetY) {
+    const bool bRadar = ((currentRadarMode == RadarMode::RadarOn) || (currentRadarMode == RadarMode::AnimationRadarOff));
+
+    bool bRedrawAll = prepareRadarTiles(radarSurface.get(), mapSizeX, mapSizeY, scale, downsampling, offsetX, offsetY);
+    bRedrawAll |= (bRadar != bLastRadar) || (debug != bLastDebug);
+    bLastRadar = bRadar;
+    bLastDebug = debug;
+
     sdl2::surface_lock lock{ radarSurface.get() };
-    for(int x = 0; x <  mapSizeX; x++) {
-        for(int y = 0; y <  mapSizeY; y++) {
 
-            Tile* pTile = currentGameMap->getTile(x,y);
+    const auto drawTile = [&](int x, int y) {
+        if(!isRadarTileShown(x, y)) {
+            return;
+        }
+
+        Tile* pTile = currentGameMap->getTile(x,y);
 
-            /* Selecting the right color is handled in Tile::getRadarColor() */
-            Uint32 color = pTile->getRadarColor(pLocalHouse, ((currentRadarMode == RadarMode::RadarOn) || (currentRadarMode == RadarMode::AnimationRadarOff)));
-            color = MapRGBA(radarSurface->format, color);
+        /* Selecting the right color is handled in Tile::getRadarColor() */
+        const Uint32 color = pTile->getRadarColor(pLocalHouse, bRadar);
+        setRadarTileColor(radarSurface.get(), x, y, MapRGBA(radarSurface->format, color));
+    };
 
-            for(int j = 0; j < scale; j++) {
-                Uint32* p = ((Uint32*) ((Uint8 *) radarSurface->pixels + (offsetY + scale*y + j) * radarSurface->pitch)) + (offsetX + scale*x);
+    if(bRedrawAll) {
+        currentGameMap->takeRadarDirtyTiles(currentGame->getGameCycleCount(), [](int x, int y) { });
 
-                for(int i = 0; i < scale; i++, p++) {
-                    // Do not use putPixel here to avoid overhead
-                    *p = color;
-                }
+        for(int x = 0; x <  mapSizeX; x += downsampling) {
+            for(int y = 0; y <  mapSizeY; y += downsampling) {
+                drawTile(x, y);
             }
         }
+    } else {
+        // only tiles with changed objects, terrain or fog can change their color
+        currentGameMap->takeRadarDirtyTiles(currentGame->getGameCycleCount(), drawTile);
     }
 }
@@ -0,0 +1,193 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <ReplayFile.h>
+
+#include <config.h>
+
+#include <GameInitSettings.h>
+#include <CommandManager.h>
+
+#include <misc/IFileStream.h>
+#include <misc/IMemoryStream.h>
+#include <misc/OMemoryStream.h>
+#include <misc/ICompressedStream.h>
+#include <misc/OCompressedStream.h>
+#include <misc/exceptions.h>
+
+#include <vector>
+
+namespace {
+
+std::string compress(const OMemoryStream& memStream) {
+    OMemoryStream compressedMemStream;
+    compressedMemStream.open();
+
+    OCompressedStream compressedStream(compressedMemStream);
+    compressedStream.writeBytes(memStream.getData(), memStream.getDataLength());
+    compressedStream.close();
+
+    return std::string(compressedMemStream.getData(), compressedMemStream.getDataLength());
+}
+
+/// One entry of the chunk index
+struct ReplayChunk {
+    Uint32 firstCycle;      ///< the first game cycle of this chunk
+    Uint32 numCommands;     ///< the number of commands in this chunk
+};
+
+}
+
+void ReplayFile::save(OutputStream& stream, const std::string& localPlayerName, Uint32 numGameCycles, const GameInitSettings& gameInitSettings, const CommandManager& cmdManager) {
+    const CommandTimeline& timeline = cmdManager.getTimeline();
+
+    // split the commands into chunks
+    std::vector<ReplayChunk> chunks;
+    std::vector<std::string> chunkData;
+    for(Uint32 i = timeline.getNextCycleWithCommands(0); i < timeline.getNumCycles(); ) {
+        const Uint32 firstCycle = i - (i % REPLAY_CHUNKCYCLES);
+        const Uint32 endCycle = firstCycle + REPLAY_CHUNKCYCLES;
+
+        OMemoryStream memStream;
+        memStream.open();
+        Uint32 numCommands = 0;
+        for( ; (i < endCycle) && (i < timeline.getNumCycles()); i = timeline.getNextCycleWithCommands(i + 1)) {
+            for(const Command& command : timeline.getCommands(i)) {
+                memStream.writeUint32(i);
+                command.save(memStream);
+                numCommands++;
+            }
+        }
+
+        chunks.push_back(ReplayChunk{ firstCycle, numCommands });
+        chunkData.push_back(compress(memStream));
+    }
+
+    stream.writeUint32(REPLAYMAGIC);
+    stream.writeUint32(REPLAYVERSION);
+
+    stream.writeString(localPlayerName);
+    stream.writeString(gameInitSettings.getFilename());
+    stream.writeString(VERSIONSTRING);
+    stream.writeUint32(numGameCycles);
+    stream.writeUint32(static_cast<Uint32>(timeline.getNumCommands()));
+
+    stream.writeUint32(static_cast<Uint32>(chunks.size()));
+    for(const ReplayChunk& chunk : chunks) {
+        stream.writeUint32(chunk.firstCycle);
+        stream.writeUint32(chunk.numCommands);
+    }
+
+    OMemoryStream settingsStream;
+    settingsStream.open();
+    gameInitSettings.save(settingsStream);
+    stream.writeString(compress(settingsStream));
+
+    for(const std::string& data : chunkData) {
+        stream.writeString(data);
+    }
+}
+
+bool ReplayFile::readMetadata(const std::string& filename, ReplayMetadata& metadata) {
+    IFileStream fs;
+    if(fs.open(filename) == false) {
+        return false;
+    }
+
+    try {
+        if(fs.readUint32() != REPLAYMAGIC) {
+            return false;
+        }
+
+        metadata = readMetadata(fs);
+    } catch (std::exception& e) {
+        SDL_Log("ReplayFile: Cannot read the metadata of '%s': %s", filename.c_str(), e.what());
+        return false;
+    }
+
+    return true;
+}
+
+std::unique_ptr<GameInitSettings> ReplayFile::load(const std::string& filename, std::string& localPlayerName, CommandManager& cmdManager) {
+    IFileStream fs;
+
+    if(fs.open(filename) == false) {
+        THROW(io_error, "Error while opening '%s'!", filename);
+    }
+
+    bool bOldFormat;
+    try {
+        bOldFormat = (fs.readUint32() != REPLAYMAGIC);
+    } catch (InputStream::exception&) {
+        bOldFormat = true;
+    }
+
+    if(bOldFormat) {
+        // read it again from the beginning
+        fs.close();
+        if(fs.open(filename) == false) {
+            THROW(io_error, "Error while opening '%s'!", filename);
+        }
+
+        localPlayerName = fs.readString();
+        auto pGameInitSettings = std::make_unique<GameInitSettings>(fs);
+        cmdManager.load(fs);
+        return pGameInitSettings;
+    }
+
+    const ReplayMetadata metadata = readMetadata(fs);
+    localPlayerName = metadata.localPlayerName;
+
+    const Uint32 numChunks = fs.readUint32();
+    std::vector<ReplayChunk> chunks;
+    for(Uint32 i = 0; i < numChunks; i++) {
+        const Uint32 firstCycle = fs.readUint32();
+        const Uint32 numCommands = fs.readUint32();
+        chunks.push_back(ReplayChunk{ firstCycle, numCommands });
+    }
+
+    const std::string settingsData = ICompressedStream::decompress(fs.readString());
+    IMemoryStream settingsStream(settingsData.data(), settingsData.size());
+    auto pGameInitSettings = std::make_unique<GameInitSettings>(settingsStream);
+
+    for(const ReplayChunk& chunk : chunks) {
+        const std::string commandData = ICompressedStream::decompress(fs.readString());
+        IMemoryStream commandStream(commandData.data(), commandData.size());
+        for(Uint32 i = 0; i < chunk.numCommands; i++) {
+            const Uint32 cycle = commandStream.readUint32();
+            cmdManager.addCommand(Command(commandStream), cycle);
+        }
+    }
+
+    return pGameInitSettings;
+}
+
+ReplayMetadata ReplayFile::readMetadata(InputStream& stream) {
+    const Uint32 version = stream.readUint32();
+    if(version > REPLAYVERSION) {
+        THROW(std::runtime_error, "Replay file version %u is newer than the supported version %u!", version, REPLAYVERSION);
+    }
+
+    ReplayMetadata metadata;
+    metadata.localPlayerName = stream.readString();
+    metadata.mapFilename = stream.readString();
+    metadata.duneVersion = stream.readString();
+    metadata.numGameCycles = stream.readUint32();
+    metadata.numCommands = stream.readUint32();
+    return metadata;
+}
@@ -0,0 +1,69 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReplayKeyframes.h>
+
+#include <SnapshotDelta.h>
+
+#include <utility>
+
+void ReplayKeyframes::add(Uint32 gameCycle, std::string&& snapshot) {
+    if(has(gameCycle)) {
+        return;
+    }
+
+    Keyframe keyframe{ INVALID_GAMECYCLE, 0, std::move(snapshot) };
+
+    // store it as delta to the closest complete keyframe before it, unless that one has enough deltas already
+    auto iter = keyframes.upper_bound(gameCycle);
+    while(iter != keyframes.begin()) {
+        --iter;
+        if(iter->second.baseGameCycle == INVALID_GAMECYCLE) {
+            if(iter->second.numDeltas < REPLAY_KEYFRAME_MAX_DELTAS) {
+                std::string delta = SnapshotDelta::create(iter->second.data, keyframe.data);
+                if(delta.size() < keyframe.data.size() / 2) {
+                    keyframe.baseGameCycle = iter->first;
+                    keyframe.data = std::move(delta);
+                    iter->second.numDeltas++;
+                }
+            }
+            break;
+        }
+    }
+
+    totalSize += keyframe.data.size();
+    keyframes.emplace(gameCycle, std::move(keyframe));
+}
+
+std::string ReplayKeyframes::getSnapshot(Uint32 gameCycle) const {
+    const Keyframe& keyframe = keyframes.at(gameCycle);
+    if(keyframe.baseGameCycle == INVALID_GAMECYCLE) {
+        return keyframe.data;
+    }
+
+    return SnapshotDelta::apply(keyframes.at(keyframe.baseGameCycle).data, keyframe.data);
+}
+
+Uint32 ReplayKeyframes::findKeyframeBefore(Uint32 gameCycle) const {
+    auto iter = keyframes.upper_bound(gameCycle);
+    if(iter == keyframes.begin()) {
+        return INVALID_GAMECYCLE;
+    }
+
+    --iter;
+    return iter->first;
+}
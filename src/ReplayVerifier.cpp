@@ -0,0 +1,212 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReplayVerifier.h>
+
+#include <globals.h>
+
+#include <Game.h>
+#include <ReplayFile.h>
+#include <Definitions.h>
+
+#include <misc/OMemoryStream.h>
+#include <misc/FileSystem.h>
+#include <misc/string_util.h>
+#include <misc/format.h>
+#include <misc/md5.h>
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <vector>
+
+ReplayResult::ReplayResult() : firstDesyncGameCycle(INVALID_GAMECYCLE) {
+}
+
+Uint32 ReplayResult::getCyclesPerSecond() const {
+    return (Uint32) ((Uint64) gameCycles * 1000 / std::max(elapsedTime, (Uint32) 1));
+}
+
+std::string ReplayResult::toCSV() const {
+    return fmt::sprintf("%s,%s,%u,0x%08X,%s,%s,%u,%u,%u",
+                        filename, result, gameCycles, randomSeed, checksum,
+                        (firstDesyncGameCycle == INVALID_GAMECYCLE) ? std::string("-") : std::to_string(firstDesyncGameCycle),
+                        numDesyncs, elapsedTime, getCyclesPerSecond());
+}
+
+const char* ReplayResult::getCSVHeader() {
+    return "replay,result,gamecycles,randomseed,checksum,firstdesync,desyncs,ms,cyclespersecond";
+}
+
+std::string getGameStateChecksum(Game* pGame) {
+    OMemoryStream memStream;
+    memStream.open();
+    pGame->saveGame(memStream);
+
+    unsigned char digest[16];
+    md5((const unsigned char*) memStream.getData(), (int) memStream.getDataLength(), digest);
+
+    std::string checksum;
+    for(unsigned char c : digest) {
+        checksum += fmt::sprintf("%02x", c);
+    }
+    return checksum;
+}
+
+namespace {
+
+/// Reads the csv output of an earlier run of verifyReplays() and returns the fields of every line indexed by the replay name
+std::map<std::string, std::vector<std::string>> readReferenceResults(const std::string& referenceFile) {
+    std::map<std::string, std::vector<std::string>> referenceResults;
+
+    if(!existsFile(referenceFile)) {
+        THROW(std::runtime_error, "Cannot open reference results '%s'!", referenceFile);
+    }
+
+    for(std::string line : splitStringToStringVector(readCompleteFile(referenceFile), "\n")) {
+        if(!line.empty() && (line.back() == '\r')) {
+            line.pop_back();
+        }
+
+        if(line.empty() || (line[0] == '#') || (line == ReplayResult::getCSVHeader())) {
+            continue;
+        }
+
+        std::vector<std::string> fields = splitStringToStringVector(line, ",");
+        referenceResults[fields[0]] = fields;
+    }
+
+    return referenceResults;
+}
+
+}
+
+ReplayResult simulateReplay(const std::string& filename, Uint32 maxGameCycle) {
+    ReplayResult replayResult;
+    replayResult.filename = getBasename(filename);
+
+    try {
+        currentGame = new Game();
+        currentGame->initReplay(filename);
+        currentGame->setHeadless(maxGameCycle);
+
+        const Uint32 startTime = SDL_GetTicks();
+        currentGame->runMainLoop();
+        replayResult.elapsedTime = SDL_GetTicks() - startTime;
+
+        replayResult.result = currentGame->isFinished() ? (currentGame->isWon() ? "won" : "lost") : "stopped";
+        replayResult.gameCycles = currentGame->getGameCycleCount();
+        replayResult.randomSeed = currentGame->randomGen.getSeed();
+        replayResult.checksum = getGameStateChecksum(currentGame);
+        replayResult.firstDesyncGameCycle = currentGame->getFirstDesyncGameCycle();
+        replayResult.numDesyncs = currentGame->getNumDesyncs();
+
+#ifdef PROFILING
+        for(int phase = 0; phase < ProfilerPhase_Frame; phase++) {
+            const Profiler::Statistics statistics = currentGame->getProfiler().getStatistics((ProfilerPhase) phase);
+            SDL_Log("%-14s min %6.0f us, avg %8.1f us, p99 %6.0f us, max %6.0f us", Profiler::getPhaseName((ProfilerPhase) phase),
+                    statistics.min, statistics.avg, statistics.p99, statistics.max);
+        }
+#endif
+    } catch(std::exception& e) {
+        SDL_Log("Simulating replay '%s' failed: %s", filename.c_str(), e.what());
+        replayResult.result = "error";
+    }
+
+    delete currentGame;
+    currentGame = nullptr;
+
+    return replayResult;
+}
+
+bool verifyReplays(const std::string& directory, const std::string& referenceFile, int shardIndex, int numShards, Uint32 maxGameCycle) {
+    if((numShards < 1) || (shardIndex < 0) || (shardIndex >= numShards)) {
+        THROW(std::invalid_argument, "verifyReplays(): Invalid shard %d of %d!", shardIndex, numShards);
+    }
+
+    std::map<std::string, std::vector<std::string>> referenceResults;
+    if(!referenceFile.empty()) {
+        referenceResults = readReferenceResults(referenceFile);
+    }
+
+    std::string replayDirectory = directory;
+    if(!replayDirectory.empty() && (replayDirectory.back() != '/') && (replayDirectory.back() != '\\')) {
+        replayDirectory += '/';
+    }
+
+    std::list<std::string> replayNames = getFileNamesList(replayDirectory, "rpl", true, FileListOrder_Name_Asc);
+
+    fprintf(stdout, "%s\n", ReplayResult::getCSVHeader());
+    fflush(stdout);
+
+    int numReplays = 0;
+    int numFailed = 0;
+    Uint64 totalGameCycles = 0;
+    Uint64 totalElapsedTime = 0;
+
+    int replayIndex = 0;
+    for(const std::string& replayName : replayNames) {
+        if(replayIndex++ % numShards != shardIndex) {
+            continue;
+        }
+
+        ReplayMetadata metadata;
+        if(ReplayFile::readMetadata(replayDirectory + replayName, metadata)) {
+            SDL_Log("Verifying replay '%s' (%s, %u game cycles, recorded with %s)...", replayName.c_str(), metadata.mapFilename.c_str(), metadata.numGameCycles, metadata.duneVersion.c_str());
+        } else {
+            SDL_Log("Verifying replay '%s'...", replayName.c_str());
+        }
+        ReplayResult replayResult = simulateReplay(replayDirectory + replayName, maxGameCycle);
+        numReplays++;
+        totalGameCycles += replayResult.gameCycles;
+        totalElapsedTime += replayResult.elapsedTime;
+
+        std::string problem;
+        if(replayResult.result == "error") {
+            problem = "cannot be simulated";
+        } else if(replayResult.numDesyncs > 0) {
+            problem = "desync";
+        } else if(!referenceFile.empty()) {
+            auto iter = referenceResults.find(replayResult.filename);
+            if(iter == referenceResults.end()) {
+                problem = "no reference result";
+            } else {
+                // result, game cycles, random seed and checksum have to be identical; the timings may differ
+                const std::vector<std::string> currentFields = splitStringToStringVector(replayResult.toCSV(), ",");
+                const std::vector<std::string>& referenceFields = iter->second;
+                if((referenceFields.size() < 5) || !std::equal(referenceFields.begin() + 1, referenceFields.begin() + 5, currentFields.begin() + 1)) {
+                    problem = "differs from reference";
+                }
+            }
+        }
+
+        fprintf(stdout, "%s\n", replayResult.toCSV().c_str());
+        if(!problem.empty()) {
+            numFailed++;
+            fprintf(stdout, "# %s: %s\n", replayResult.filename.c_str(), problem.c_str());
+        }
+        fflush(stdout);
+    }
+
+    fprintf(stdout, "# %d replays, %d failed, %llu game cycles in %llu ms, %llu cycles/s\n",
+                    numReplays, numFailed,
+                    (unsigned long long) totalGameCycles, (unsigned long long) totalElapsedTime,
+                    (unsigned long long) (totalGameCycles * 1000 / std::max(totalElapsedTime, (Uint64) 1)));
+    fflush(stdout);
+
+    return (numFailed == 0);
+}
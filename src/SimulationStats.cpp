@@ -0,0 +1,116 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <SimulationStats.h>
+
+#include <misc/SDL2pp.h>
+#include <misc/exceptions.h>
+
+#include <algorithm>
+#include <string>
+
+namespace {
+SDL_SpinLock allThreadCountsLock = 0;
+}
+
+thread_local SimulationStats::ThreadCounts SimulationStats::threadCounts;
+thread_local int SimulationStats::currentHouseIndex = NUM_HOUSES;
+std::vector<SimulationStats::ThreadCounts*> SimulationStats::allThreadCounts;
+
+SimulationStats::ThreadCounts::ThreadCounts() {
+    SDL_AtomicLock(&allThreadCountsLock);
+    allThreadCounts.push_back(this);
+    SDL_AtomicUnlock(&allThreadCountsLock);
+}
+
+SimulationStats::ThreadCounts::~ThreadCounts() {
+    SDL_AtomicLock(&allThreadCountsLock);
+    allThreadCounts.erase(std::remove(allThreadCounts.begin(), allThreadCounts.end(), this), allThreadCounts.end());
+    SDL_AtomicUnlock(&allThreadCountsLock);
+}
+
+void SimulationStats::endCycle() {
+    for(auto& houseCounts : lastCycle) {
+        houseCounts.fill(0);
+    }
+
+    SDL_AtomicLock(&allThreadCountsLock);
+    for(ThreadCounts* pThreadCounts : allThreadCounts) {
+        for(int house = 0; house < NUM_HOUSEINDICES; house++) {
+            for(int counter = 0; counter < NUM_SIMULATIONCOUNTERS; counter++) {
+                lastCycle[house][counter] += pThreadCounts->counts[house][counter];
+                pThreadCounts->counts[house][counter] = 0;
+            }
+        }
+    }
+    SDL_AtomicUnlock(&allThreadCountsLock);
+
+    for(int house = 0; house < NUM_HOUSEINDICES; house++) {
+        for(int counter = 0; counter < NUM_SIMULATIONCOUNTERS; counter++) {
+            total[house][counter] += lastCycle[house][counter];
+        }
+    }
+
+    numCycles++;
+}
+
+Uint64 SimulationStats::getLastCycle(SimulationCounter counter) const {
+    Uint64 sum = 0;
+    for(const auto& houseCounts : lastCycle) {
+        sum += houseCounts[counter];
+    }
+    return sum;
+}
+
+Uint64 SimulationStats::getTotal(SimulationCounter counter) const {
+    Uint64 sum = 0;
+    for(const auto& houseCounts : total) {
+        sum += houseCounts[counter];
+    }
+    return sum;
+}
+
+void SimulationStats::logTotals() const {
+    if(numCycles == 0) {
+        return;
+    }
+
+    for(int counter = 0; counter < NUM_SIMULATIONCOUNTERS; counter++) {
+        const Uint64 counterTotal = getTotal((SimulationCounter) counter);
+        SDL_Log("%-20s %12llu total, %10.1f per cycle", getCounterName((SimulationCounter) counter),
+                (unsigned long long) counterTotal, (double) counterTotal / numCycles);
+
+        for(int house = 0; house < NUM_HOUSEINDICES; house++) {
+            if(total[house][counter] != 0) {
+                SDL_Log("    %-16s %12llu total, %10.1f per cycle", (house == NUM_HOUSES) ? "no house" : ("house " + std::to_string(house)).c_str(),
+                        (unsigned long long) total[house][counter], (double) total[house][counter] / numCycles);
+            }
+        }
+    }
+}
+
+const char* SimulationStats::getCounterName(SimulationCounter counter) {
+    switch(counter) {
+        case SimulationCounter_PathNodesExpanded:       return "PathNodesExpanded";
+        case SimulationCounter_PathSearchesAborted:     return "PathSearchesAborted";
+        case SimulationCounter_TargetTilesScanned:      return "TargetTilesScanned";
+        case SimulationCounter_GetObjectCalls:          return "GetObjectCalls";
+        case SimulationCounter_DamageCandidates:        return "DamageCandidates";
+        case SimulationCounter_EntityListIterators:     return "EntityListIterators";
+        default: THROW(std::invalid_argument, "SimulationStats::getCounterName(): Invalid counter %d!", counter);
+    }
+}
@@ -0,0 +1,214 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <SnapshotDelta.h>
+
+#include <misc/IMemoryStream.h>
+#include <misc/OMemoryStream.h>
+#include <misc/exceptions.h>
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+#include <string.h>
+
+#define SNAPSHOTDELTA_OP_END    0
+#define SNAPSHOTDELTA_OP_COPY   1
+#define SNAPSHOTDELTA_OP_INSERT 2
+
+namespace {
+
+struct Chunk {
+    size_t offset;
+    size_t length;
+};
+
+/// The random values for the rolling ("gear") hash, one per byte value
+const std::array<Uint64, 256>& getGearTable() {
+    static const std::array<Uint64, 256> gearTable = [] {
+        std::array<Uint64, 256> table;
+        Uint64 x = 0x9E3779B97F4A7C15ull;
+        for(Uint64& value : table) {
+            // xorshift64
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            value = x;
+        }
+        return table;
+    }();
+
+    return gearTable;
+}
+
+/// Splits data into chunks whose boundaries only depend on the bytes right before them
+std::vector<Chunk> splitIntoChunks(const std::string& data) {
+    const std::array<Uint64, 256>& gearTable = getGearTable();
+
+    std::vector<Chunk> chunks;
+    chunks.reserve(data.size() / (SNAPSHOTDELTA_CHUNK_MASK + 1) + 1);
+
+    size_t chunkStart = 0;
+    Uint64 rollingHash = 0;
+    for(size_t i = 0; i < data.size(); i++) {
+        rollingHash = (rollingHash << 1) + gearTable[(Uint8) data[i]];
+
+        const size_t chunkLength = i + 1 - chunkStart;
+        if(((chunkLength >= SNAPSHOTDELTA_MIN_CHUNK_SIZE) && ((rollingHash & SNAPSHOTDELTA_CHUNK_MASK) == 0))
+            || (chunkLength == SNAPSHOTDELTA_MAX_CHUNK_SIZE)) {
+            chunks.push_back({ chunkStart, chunkLength });
+            chunkStart = i + 1;
+            rollingHash = 0;
+        }
+    }
+
+    if(chunkStart < data.size()) {
+        chunks.push_back({ chunkStart, data.size() - chunkStart });
+    }
+
+    return chunks;
+}
+
+Uint32 hashBytes(const char* data, size_t length) {
+    Uint32 h = 2166136261u;
+    for(size_t i = 0; i < length; i++) {
+        h = (h ^ (Uint8) data[i]) * 16777619u;
+    }
+    return h;
+}
+
+}
+
+std::string SnapshotDelta::create(const std::string& base, const std::string& target) {
+    std::unordered_multimap<Uint32, Chunk> baseChunks;
+    for(const Chunk& chunk : splitIntoChunks(base)) {
+        baseChunks.emplace(hashBytes(base.data() + chunk.offset, chunk.length), chunk);
+    }
+
+    OMemoryStream stream;
+    stream.open();
+    stream.writeUint32(SNAPSHOTDELTA_MAGIC);
+    stream.writeUint32(base.size());
+    stream.writeUint32(hash(base));
+    stream.writeUint32(target.size());
+
+    Chunk pendingCopy = { 0, 0 };
+    Chunk pendingInsert = { 0, 0 };
+
+    const auto flushCopy = [&]() {
+        if(pendingCopy.length > 0) {
+            stream.writeUint8(SNAPSHOTDELTA_OP_COPY);
+            stream.writeUint32(pendingCopy.offset);
+            stream.writeUint32(pendingCopy.length);
+            pendingCopy.length = 0;
+        }
+    };
+
+    const auto flushInsert = [&]() {
+        if(pendingInsert.length > 0) {
+            stream.writeUint8(SNAPSHOTDELTA_OP_INSERT);
+            stream.writeString(target.substr(pendingInsert.offset, pendingInsert.length));
+            pendingInsert.length = 0;
+        }
+    };
+
+    for(const Chunk& chunk : splitIntoChunks(target)) {
+        const char* pChunkData = target.data() + chunk.offset;
+
+        const Chunk* pBaseChunk = nullptr;
+        const auto range = baseChunks.equal_range(hashBytes(pChunkData, chunk.length));
+        for(auto iter = range.first; iter != range.second; ++iter) {
+            if((iter->second.length == chunk.length) && (memcmp(base.data() + iter->second.offset, pChunkData, chunk.length) == 0)) {
+                pBaseChunk = &iter->second;
+                break;
+            }
+        }
+
+        if(pBaseChunk == nullptr) {
+            flushCopy();
+            if(pendingInsert.length == 0) {
+                pendingInsert.offset = chunk.offset;
+            }
+            pendingInsert.length += chunk.length;
+        } else {
+            flushInsert();
+            if((pendingCopy.length > 0) && (pendingCopy.offset + pendingCopy.length == pBaseChunk->offset)) {
+                // continues the previous copy
+                pendingCopy.length += pBaseChunk->length;
+            } else {
+                flushCopy();
+                pendingCopy = *pBaseChunk;
+            }
+        }
+    }
+
+    flushCopy();
+    flushInsert();
+    stream.writeUint8(SNAPSHOTDELTA_OP_END);
+
+    return std::string(stream.getData(), stream.getDataLength());
+}
+
+std::string SnapshotDelta::apply(const std::string& base, const std::string& delta) {
+    IMemoryStream stream(delta.data(), delta.size());
+
+    try {
+        if(stream.readUint32() != SNAPSHOTDELTA_MAGIC) {
+            THROW(std::invalid_argument, "SnapshotDelta::apply(): Invalid delta!");
+        }
+
+        const Uint32 baseSize = stream.readUint32();
+        const Uint32 baseHash = stream.readUint32();
+        if((baseSize != base.size()) || (baseHash != hash(base))) {
+            THROW(std::invalid_argument, "SnapshotDelta::apply(): The delta was not created for this base snapshot!");
+        }
+
+        const Uint32 targetSize = stream.readUint32();
+
+        std::string target;
+        target.reserve(targetSize);
+
+        while(true) {
+            const Uint8 op = stream.readUint8();
+            if(op == SNAPSHOTDELTA_OP_END) {
+                break;
+            } else if(op == SNAPSHOTDELTA_OP_COPY) {
+                const Uint32 offset = stream.readUint32();
+                const Uint32 length = stream.readUint32();
+                if((offset > base.size()) || (length > base.size() - offset)) {
+                    THROW(std::invalid_argument, "SnapshotDelta::apply(): Invalid chunk reference!");
+                }
+                target.append(base, offset, length);
+            } else if(op == SNAPSHOTDELTA_OP_INSERT) {
+                target += stream.readString();
+            } else {
+                THROW(std::invalid_argument, "SnapshotDelta::apply(): Unknown operation %d!", op);
+            }
+        }
+
+        if(target.size() != targetSize) {
+            THROW(std::invalid_argument, "SnapshotDelta::apply(): Reconstructed snapshot has the wrong size!");
+        }
+
+        return target;
+    } catch (InputStream::exception&) {
+        THROW(std::invalid_argument, "SnapshotDelta::apply(): Delta is truncated!");
+    }
+}
+
+Uint32 SnapshotDelta::hash(const std::string& data) {
+    return hashBytes(data.data(), data.size());
+}
@@ -26,24 +26,35 @@
 
 #include <misc/exceptions.h>
 
+#include <algorithm>
+
+
+const SoundPlayer::ChannelRange SoundPlayer::channelRanges[] = {
+    {  0,  1 },     // ChannelGroup::Voice
+    {  2,  3 },     // ChannelGroup::UI
+    {  4,  5 },     // ChannelGroup::Credits
+    {  6,  8 },     // ChannelGroup::Explosion
+    {  9, 10 },     // ChannelGroup::ExplosionStructure
+    { 11, 13 },     // ChannelGroup::Gun
+    { 14, 16 },     // ChannelGroup::Rocket
+    { 17, 18 },     // ChannelGroup::Scream
+    { 19, 21 },     // ChannelGroup::Sonic
+    { 22, 23 },     // ChannelGroup::Other
+};
 
 SoundPlayer::SoundPlayer() {
     sfxVolume = settings.audio.sfxVolume;
 
     Mix_Volume(-1, sfxVolume);
 
-    Mix_ReserveChannels(24);  //Reserve a channel for voice over
+    Mix_ReserveChannels(SOUNDPLAYER_NUM_CHANNELS);  //Reserve a channel for voice over
 
-    Mix_GroupChannels( 0,  1, static_cast<int>(ChannelGroup::Voice));
-    Mix_GroupChannels( 2,  3, static_cast<int>(ChannelGroup::UI));
-    Mix_GroupChannels( 4,  5, static_cast<int>(ChannelGroup::Credits));
-    Mix_GroupChannels( 6,  8, static_cast<int>(ChannelGroup::Explosion));
-    Mix_GroupChannels( 9, 10, static_cast<int>(ChannelGroup::ExplosionStructure));
-    Mix_GroupChannels(11, 13, static_cast<int>(ChannelGroup::Gun));
-    Mix_GroupChannels(14, 16, static_cast<int>(ChannelGroup::Rocket));
-    Mix_GroupChannels(17, 18, static_cast<int>(ChannelGroup::Scream));
-    Mix_GroupChannels(19, 21, static_cast<int>(ChannelGroup::Sonic));
-    Mix_GroupChannels(22, 23, static_cast<int>(ChannelGroup::Other));
+    for(int group = 0; group < static_cast<int>(ChannelGroup::NumGroups); group++) {
+        Mix_GroupChannels(channelRanges[group].first, channelRanges[group].last, group);
+    }
+
+    channelSounds.fill(NUM_SOUNDCHUNK);
+    channelVolumes.fill(0);
 
     soundOn = settings.audio.playSFX;
 }
@@ -75,18 +86,49 @@ void SoundPlayer::playSoundAt(Sound_enum soundID, const Coord& location)
 
         Coord realCoord = location * TILESIZE + Coord(TILESIZE/2, TILESIZE/2);
 
+        int volume;
         if(screenborder->isInsideScreen(realCoord, Coord(TILESIZE, TILESIZE)) ) {
-            playSound(soundID, sfxVolume);
+            volume = sfxVolume;
         } else if(screenborder->isInsideScreen(realCoord, Coord(TILESIZE*16, TILESIZE*16)) ) {
-            playSound(soundID, (sfxVolume*3)/4);
+            volume = (sfxVolume*3)/4;
         } else if(screenborder->isInsideScreen(realCoord, Coord(TILESIZE*24, TILESIZE*24)) ) {
-            playSound(soundID, sfxVolume/2);
+            volume = sfxVolume/2;
         } else {
-            playSound(soundID, sfxVolume/4);
+            volume = sfxVolume/4;
         }
+
+        QueuedSound& queuedSound = queuedSounds[soundID];
+        queuedSound.count++;
+        queuedSound.maxVolume = std::max(queuedSound.maxVolume, volume);
+        queuedSound.sumVolume += volume;
     }
 }
 
+void SoundPlayer::playQueuedSounds() {
+    for(int i = 0; i < NUM_SOUNDCHUNK; i++) {
+        QueuedSound& queuedSound = queuedSounds[i];
+        if(queuedSound.count == 0) {
+            continue;
+        }
+
+        // many identical sounds at once sound louder than the loudest one but not as loud as all of them together
+        const int volume = std::min(sfxVolume, queuedSound.maxVolume + (queuedSound.sumVolume - queuedSound.maxVolume) / 4);
+        queuedSound = QueuedSound();
+
+        if(soundOn) {
+            const Sound_enum soundID = static_cast<Sound_enum>(i);
+            const int channel = findChannel(soundID, getChannelGroup(soundID), volume);
+            if(channel != -1) {
+                startSound(soundID, channel, volume);
+            }
+        }
+    }
+}
+
+void SoundPlayer::clearQueuedSounds() {
+    queuedSounds.fill(QueuedSound());
+}
+
 void SoundPlayer::playSound(Mix_Chunk* sound) {
     if(soundOn) {
         int channel = Mix_PlayChannel(-1, sound, 0);
@@ -102,7 +144,74 @@ void SoundPlayer::playSound(Sound_enum id) {
 
 void SoundPlayer::playSound(Sound_enum soundID, int volume)
 {
-    static ChannelGroup soundID2ChannelGroup[] = {
+    if(soundOn) {
+        startSound(soundID, Mix_GroupAvailable(static_cast<int>(getChannelGroup(soundID))), volume);
+    }
+}
+
+void SoundPlayer::startSound(Sound_enum soundID, int channel, int volume) {
+    Mix_Chunk* sound;
+
+    if((sound = pSFXManager->getSound(soundID)) == nullptr) {
+        THROW(std::invalid_argument, "There is no sound with ID %d!", soundID);
+    }
+
+    channel = Mix_PlayChannel(channel, sound, 0);
+    if(channel != -1) {
+        Mix_Volume(channel, volume);
+        if(channel < SOUNDPLAYER_NUM_CHANNELS) {
+            channelSounds[channel] = soundID;
+            channelVolumes[channel] = volume;
+        }
+    }
+}
+
+int SoundPlayer::findChannel(Sound_enum soundID, ChannelGroup group, int volume) {
+    const ChannelRange& range = channelRanges[static_cast<int>(group)];
+
+    int freeChannel = -1;
+    int numInstances = 0;
+    int quietestInstance = -1;
+    int quietestChannel = -1;
+    for(int channel = range.first; channel <= range.last; channel++) {
+        if(Mix_Playing(channel) == 0) {
+            if(freeChannel == -1) {
+                freeChannel = channel;
+            }
+            continue;
+        }
+
+        if(channelSounds[channel] == soundID) {
+            numInstances++;
+            if((quietestInstance == -1) || (channelVolumes[channel] < channelVolumes[quietestInstance])) {
+                quietestInstance = channel;
+            }
+        }
+
+        if((quietestChannel == -1) || (channelVolumes[channel] < channelVolumes[quietestChannel])) {
+            quietestChannel = channel;
+        }
+    }
+
+    // at the cap only replace a quieter instance of the same sound
+    int channel = (numInstances >= SOUNDPLAYER_MAX_INSTANCES_PER_SOUND) ? quietestInstance
+                                                                       : ((freeChannel != -1) ? freeChannel : quietestChannel);
+    if(channel == -1) {
+        return -1;
+    }
+
+    if(Mix_Playing(channel) != 0) {
+        if(channelVolumes[channel] >= volume) {
+            return -1;
+        }
+        Mix_HaltChannel(channel);
+    }
+
+    return channel;
+}
+
+SoundPlayer::ChannelGroup SoundPlayer::getChannelGroup(Sound_enum soundID) {
+    static const ChannelGroup soundID2ChannelGroup[] = {
         ChannelGroup::UI,                   // Sound_PlaceStructure
         ChannelGroup::UI,                   // Sound_ButtonClick
         ChannelGroup::UI,                   // Sound_InvalidAction
@@ -132,17 +241,5 @@ void SoundPlayer::playSound(Sound_enum soundID, int volume)
         ChannelGroup::Rocket,               // Sound_RocketSmall
     };
 
-    if(soundOn) {
-        Mix_Chunk* sound;
-
-        if((sound = pSFXManager->getSound(soundID)) == nullptr) {
-            THROW(std::invalid_argument, "There is no sound with ID %d!", soundID);
-        }
-
-        int channel = Mix_GroupAvailable(static_cast<int>(soundID2ChannelGroup[soundID]));
-        channel = Mix_PlayChannel(channel, sound, 0);
-        if(channel != -1) {
-            Mix_Volume(channel, volume);
-        }
-    }
+    return soundID2ChannelGroup[soundID];
 }
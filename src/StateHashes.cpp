@@ -0,0 +1,218 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <StateHashes.h>
+
+#include <globals.h>
+
+#include <Game.h>
+#include <House.h>
+#include <Map.h>
+#include <SpiceIndex.h>
+#include <units/UnitBase.h>
+#include <structures/StructureBase.h>
+
+#include <misc/format.h>
+
+#include <array>
+#include <stdio.h>
+
+namespace {
+
+/// The fields of one unit, structure or house that are hashed and written to the snapshot
+class StateFields {
+public:
+    void add(const char* name, Sint64 value) {
+        names[numFields] = name;
+        values[numFields] = value;
+        numFields++;
+    }
+
+    void add(const char* name, FixPoint value) {
+        add(name, (Sint64) value.getRawValue());
+    }
+
+    /// FNV-1a over all values
+    Uint32 hash(Uint32 h) const {
+        for(int i = 0; i < numFields; i++) {
+            Uint64 value = (Uint64) values[i];
+            for(int j = 0; j < 8; j++) {
+                h = (h ^ (Uint32) ((value >> (8*j)) & 0xFF)) * 16777619u;
+            }
+        }
+        return h;
+    }
+
+    std::string toString() const {
+        std::string result;
+        for(int i = 0; i < numFields; i++) {
+            result += fmt::sprintf("%s%s=%d", (i == 0) ? "" : " ", names[i], values[i]);
+        }
+        return result;
+    }
+
+private:
+    std::array<const char*, 16> names;
+    std::array<Sint64, 16> values;
+    int numFields = 0;
+};
+
+#define FNV_OFFSET_BASIS    2166136261u
+
+void getObjectFields(const ObjectBase* pObject, StateFields& fields) {
+    const ObjectBase* pTarget = pObject->getTarget();
+
+    fields.add("id", pObject->getObjectID());
+    fields.add("item", pObject->getItemID());
+    fields.add("owner", pObject->getOwner()->getHouseID());
+    fields.add("x", pObject->getX());
+    fields.add("y", pObject->getY());
+    fields.add("realx", pObject->getRealX());
+    fields.add("realy", pObject->getRealY());
+    fields.add("health", pObject->getHealth());
+    fields.add("target", (pTarget != nullptr) ? pTarget->getObjectID() : NONE_ID);
+    fields.add("random", pObject->getRandomGen().getSeed());
+}
+
+void getUnitFields(const UnitBase* pUnit, StateFields& fields) {
+    getObjectFields(pUnit, fields);
+    fields.add("destx", pUnit->getDestination().x);
+    fields.add("desty", pUnit->getDestination().y);
+    fields.add("angle", pUnit->getAngle());
+    fields.add("attackmode", pUnit->getAttackMode());
+}
+
+void getHouseFields(const House* pHouse, StateFields& fields) {
+    fields.add("house", pHouse->getHouseID());
+    fields.add("startingcredits", pHouse->getStartingCredits());
+    fields.add("storedcredits", pHouse->getStoredCredits());
+    fields.add("harvestedspice", pHouse->getHarvestedSpice());
+    fields.add("units", pHouse->getNumUnits());
+    fields.add("structures", pHouse->getNumStructures());
+    fields.add("producedpower", pHouse->getProducedPower());
+    fields.add("powerrequirement", pHouse->getPowerRequirement());
+    fields.add("capacity", pHouse->getCapacity());
+}
+
+}
+
+StateHashes StateHashes::compute() {
+    StateHashes stateHashes;
+
+    stateHashes.units = FNV_OFFSET_BASIS;
+    for(const UnitBase* pUnit : unitList) {
+        StateFields fields;
+        getUnitFields(pUnit, fields);
+        stateHashes.units = fields.hash(stateHashes.units);
+    }
+
+    stateHashes.structures = FNV_OFFSET_BASIS;
+    for(const StructureBase* pStructure : structureList) {
+        StateFields fields;
+        getObjectFields(pStructure, fields);
+        stateHashes.structures = fields.hash(stateHashes.structures);
+    }
+
+    stateHashes.houses = FNV_OFFSET_BASIS;
+    for(int i = 0; i < NUM_HOUSES; i++) {
+        const House* pHouse = currentGame->getHouse(i);
+        if(pHouse != nullptr) {
+            StateFields fields;
+            getHouseFields(pHouse, fields);
+            stateHashes.houses = fields.hash(stateHashes.houses);
+        }
+    }
+
+    stateHashes.spice = currentGameMap->getSpiceIndex().getSpiceHash();
+
+    return stateHashes;
+}
+
+StateHashes StateHashes::fromParameters(const std::vector<Uint32>& parameters) {
+    StateHashes stateHashes;
+    stateHashes.units = parameters.at(0);
+    stateHashes.structures = parameters.at(1);
+    stateHashes.houses = parameters.at(2);
+    stateHashes.spice = parameters.at(3);
+    return stateHashes;
+}
+
+std::vector<Uint32> StateHashes::toParameters(Uint32 gameCycle) const {
+    return { gameCycle, units, structures, houses, spice };
+}
+
+std::string StateHashes::getMismatchingSubsystems(const StateHashes& other) const {
+    std::string result;
+    auto addSubsystem = [&](bool bMismatch, const char* name) {
+        if(bMismatch) {
+            result += (result.empty() ? "" : ", ") + std::string(name);
+        }
+    };
+
+    addSubsystem(units != other.units, "units");
+    addSubsystem(structures != other.structures, "structures");
+    addSubsystem(houses != other.houses, "houses");
+    addSubsystem(spice != other.spice, "spice");
+    return result;
+}
+
+bool writeStateSnapshot(const std::string& filename) {
+    FILE* file = fopen(filename.c_str(), "w");
+    if(file == nullptr) {
+        SDL_Log("Cannot write state snapshot '%s'!", filename.c_str());
+        return false;
+    }
+
+    StateHashes stateHashes = StateHashes::compute();
+    fprintf(file, "gamecycle=%u random=%u units=%08X structures=%08X houses=%08X spice=%08X\n",
+            currentGame->getGameCycleCount(), currentGame->randomGen.getSeed(),
+            stateHashes.units, stateHashes.structures, stateHashes.houses, stateHashes.spice);
+
+    for(int i = 0; i < NUM_HOUSES; i++) {
+        const House* pHouse = currentGame->getHouse(i);
+        if(pHouse != nullptr) {
+            StateFields fields;
+            getHouseFields(pHouse, fields);
+            fprintf(file, "house %s\n", fields.toString().c_str());
+        }
+    }
+
+    for(const UnitBase* pUnit : unitList) {
+        StateFields fields;
+        getUnitFields(pUnit, fields);
+        fprintf(file, "unit %s\n", fields.toString().c_str());
+    }
+
+    for(const StructureBase* pStructure : structureList) {
+        StateFields fields;
+        getObjectFields(pStructure, fields);
+        fprintf(file, "structure %s\n", fields.toString().c_str());
+    }
+
+    const SpiceIndex& spiceIndex = currentGameMap->getSpiceIndex();
+    for(int chunkY = 0; chunkY < spiceIndex.getNumChunksY(); chunkY++) {
+        for(int chunkX = 0; chunkX < spiceIndex.getNumChunksX(); chunkX++) {
+            if(spiceIndex.getNumSpiceTiles(chunkX, chunkY) > 0) {
+                fprintf(file, "spice chunkx=%d chunky=%d tiles=%d total=%lld\n", chunkX, chunkY,
+                        spiceIndex.getNumSpiceTiles(chunkX, chunkY), (long long) spiceIndex.getSpice(chunkX, chunkY).getRawValue());
+            }
+        }
+    }
+
+    fclose(file);
+    return true;
+}
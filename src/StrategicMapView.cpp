@@ -0,0 +1,170 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <StrategicMapView.h>
+
+#include <globals.h>
+
+#include <House.h>
+#include <Map.h>
+#include <ScreenBorder.h>
+#include <TerrainChunkCache.h>
+#include <Tile.h>
+#include <units/UnitBase.h>
+#include <structures/StructureBase.h>
+
+#include <algorithm>
+
+void StrategicMapView::draw(const SDL_Rect& gameBoardRect, TerrainChunkCache& terrainChunkCache) {
+    mapSizeX = currentGameMap->getSizeX();
+    mapSizeY = currentGameMap->getSizeY();
+
+    // the largest scale at which the whole map fits, rounded down to whole pixels per tile if there are more than one
+    float tileSize = std::min(static_cast<float>(gameBoardRect.w) / mapSizeX, static_cast<float>(gameBoardRect.h) / mapSizeY);
+    tileSize = std::min(tileSize, static_cast<float>(STRATEGICMAPVIEW_MAX_TILESIZE));
+    if(tileSize > 1.0f) {
+        tileSize = static_cast<float>(static_cast<int>(tileSize));
+    }
+
+    mapRect.w = static_cast<int>(mapSizeX * tileSize);
+    mapRect.h = static_cast<int>(mapSizeY * tileSize);
+    mapRect.x = gameBoardRect.x + (gameBoardRect.w - mapRect.w) / 2;
+    mapRect.y = gameBoardRect.y + (gameBoardRect.h - mapRect.h) / 2;
+
+    terrainChunkCache.drawMipLevel(mapRect);
+
+    const auto teamID = pLocalHouse->getTeamID();
+    const auto markerSize = std::max(STRATEGICMAPVIEW_MIN_MARKERSIZE, static_cast<int>(tileSize));
+
+    const auto getHouseColor = [](const ObjectBase* pObject) {
+        return SDL2RGB(palette[houseToPaletteIndex[pObject->getOwner()->getHouseID()]]);
+    };
+
+    for(const StructureBase* pStructure : structureList) {
+        const Coord& location = pStructure->getLocation();
+        if(!debug && !currentGameMap->getTile(location)->isExploredByTeam(teamID)) {
+            continue;
+        }
+
+        const Coord& size = pStructure->getStructureSize();
+        const int x = mapRect.x + static_cast<int>(location.x * tileSize);
+        const int y = mapRect.y + static_cast<int>(location.y * tileSize);
+        SDL_Rect rect = {   x, y,
+                            std::max(markerSize, mapRect.x + static_cast<int>((location.x + size.x) * tileSize) - x),
+                            std::max(markerSize, mapRect.y + static_cast<int>((location.y + size.y) * tileSize) - y) };
+        markers.addFilledRect(rect, getHouseColor(pStructure));
+    }
+
+    for(const UnitBase* pUnit : unitList) {
+        if(!pUnit->isActive() || (!debug && !pUnit->isVisible(teamID))) {
+            continue;
+        }
+
+        const Coord center = pUnit->getCenterPoint();
+        SDL_Rect rect = {   mapRect.x + static_cast<int>(center.x * tileSize / TILESIZE) - markerSize/2,
+                            mapRect.y + static_cast<int>(center.y * tileSize / TILESIZE) - markerSize/2,
+                            markerSize, markerSize };
+        markers.addFilledRect(rect, (pUnit->getItemID() == Unit_Sandworm) ? COLOR_WHITE : getHouseColor(pUnit));
+    }
+
+    markers.flush(renderer);
+
+    if(!debug) {
+        updateShroud();
+        if(shroudTexture) {
+            SDL_RenderCopy(renderer, shroudTexture.get(), nullptr, &mapRect);
+        }
+    }
+
+    // the part of the map the normal view shows
+    const Coord& topLeft = screenborder->getTopLeftTile();
+    const Coord& bottomRight = screenborder->getBottomRightTile();
+    const int x1 = mapRect.x + static_cast<int>(topLeft.x * tileSize);
+    const int y1 = mapRect.y + static_cast<int>(topLeft.y * tileSize);
+    const int x2 = mapRect.x + static_cast<int>((bottomRight.x + 1) * tileSize) - 1;
+    const int y2 = mapRect.y + static_cast<int>((bottomRight.y + 1) * tileSize) - 1;
+    markers.addRect(SDL_Rect { x1, y1, x2 - x1 + 1, y2 - y1 + 1 }, COLOR_WHITE);
+    markers.flush(renderer);
+}
+
+Coord StrategicMapView::screen2MapTile(int screenX, int screenY) const {
+    if((mapRect.w <= 0) || (mapRect.h <= 0)
+        || (screenX < mapRect.x) || (screenY < mapRect.y) || (screenX >= mapRect.x + mapRect.w) || (screenY >= mapRect.y + mapRect.h)) {
+        return Coord::Invalid();
+    }
+
+    return Coord((screenX - mapRect.x) * mapSizeX / mapRect.w, (screenY - mapRect.y) * mapSizeY / mapRect.h);
+}
+
+void StrategicMapView::updateShroud() {
+    int textureWidth = 0;
+    int textureHeight = 0;
+    if(shroudTexture && ((SDL_QueryTexture(shroudTexture.get(), nullptr, nullptr, &textureWidth, &textureHeight) != 0)
+                         || (textureWidth != mapSizeX) || (textureHeight != mapSizeY))) {
+        shroudTexture.reset();
+    }
+
+    if(!shroudTexture) {
+        shroudTexture = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, mapSizeX, mapSizeY) };
+        if(!shroudTexture) {
+            SDL_Log("StrategicMapView: SDL_CreateTexture() failed: %s", SDL_GetError());
+            return;
+        }
+        SDL_SetTextureBlendMode(shroudTexture.get(), SDL_BLENDMODE_BLEND);
+        nextShroudRow = 0;
+        bShroudComplete = false;
+    }
+
+    // a new texture is filled completely before it is shown, afterwards only some rows are refreshed per frame
+    const auto teamID = pLocalHouse->getTeamID();
+    const int numRows = bShroudComplete ? std::min(STRATEGICMAPVIEW_SHROUD_ROWS, mapSizeY) : mapSizeY;
+
+    for(int i = 0; i < numRows; ) {
+        const int firstRow = (nextShroudRow + i) % mapSizeY;
+        const int rows = std::min(numRows - i, mapSizeY - firstRow);
+
+        SDL_Rect lockRect = { 0, firstRow, mapSizeX, rows };
+        void* pPixels = nullptr;
+        int pitch = 0;
+        if(SDL_LockTexture(shroudTexture.get(), &lockRect, &pPixels, &pitch) != 0) {
+            SDL_Log("StrategicMapView: SDL_LockTexture() failed: %s", SDL_GetError());
+            shroudTexture.reset();
+            return;
+        }
+
+        for(int y = 0; y < rows; y++) {
+            Uint32* pRow = reinterpret_cast<Uint32*>(static_cast<Uint8*>(pPixels) + y*pitch);
+            for(int x = 0; x < mapSizeX; x++) {
+                const Tile* pTile = currentGameMap->getTile(x, firstRow + y);
+                if(!pTile->isExploredByTeam(teamID)) {
+                    pRow[x] = 0xFF000000;
+                } else if(pTile->isFoggedByTeam(teamID)) {
+                    pRow[x] = 0x80000000;
+                } else {
+                    pRow[x] = 0x00000000;
+                }
+            }
+        }
+
+        SDL_UnlockTexture(shroudTexture.get());
+        i += rows;
+    }
+
+    nextShroudRow = (nextShroudRow + numRows) % mapSizeY;
+    bShroudComplete = true;
+}
@@ -0,0 +1,334 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TerrainChunkCache.h>
+
+#include <globals.h>
+
+#include <Map.h>
+#include <ScreenBorder.h>
+#include <Tile.h>
+#include <mmath.h>
+
+#include <algorithm>
+
+void TerrainChunkCache::invalidateArea(int x, int y, int width, int height) {
+    const auto minChunkX = std::max(0, x / TERRAINCHUNK_SIZE);
+    const auto minChunkY = std::max(0, y / TERRAINCHUNK_SIZE);
+    const auto maxChunkX = std::min(numChunksX - 1, (x + width - 1) / TERRAINCHUNK_SIZE);
+    const auto maxChunkY = std::min(numChunksY - 1, (y + height - 1) / TERRAINCHUNK_SIZE);
+
+    for(int chunkX = minChunkX; chunkX <= maxChunkX; chunkX++) {
+        for(int chunkY = minChunkY; chunkY <= maxChunkY; chunkY++) {
+            chunks[chunkY*numChunksX + chunkX].bDirty = true;
+            chunks[chunkY*numChunksX + chunkX].bMipDirty = true;
+        }
+    }
+}
+
+void TerrainChunkCache::invalidateAll() {
+    for(auto& chunk : chunks) {
+        chunk.texture.reset();
+        chunk.mipTexture.reset();
+        chunk.bDirty = true;
+        chunk.bMipDirty = true;
+    }
+    spareTextures.clear();
+    mipScratchTexture.reset();
+}
+
+std::vector<sdl2::texture_ptr> TerrainChunkCache::releaseTextures() {
+    std::vector<sdl2::texture_ptr> textures = std::move(spareTextures);
+    spareTextures.clear();
+
+    for(auto& chunk : chunks) {
+        if(chunk.texture) {
+            textures.push_back(std::move(chunk.texture));
+        }
+        chunk.bDirty = true;
+    }
+
+    return textures;
+}
+
+void TerrainChunkCache::adoptTextures(std::vector<sdl2::texture_ptr> textures, int texturesZoomlevel) {
+    if((zoomlevel != -1) && (zoomlevel != texturesZoomlevel)) {
+        return;
+    }
+
+    zoomlevel = texturesZoomlevel;
+    for(auto& texture : textures) {
+        spareTextures.push_back(std::move(texture));
+    }
+}
+
+void TerrainChunkCache::draw(int x1, int y1, int x2, int y2) {
+    checkMapAndZoomlevel();
+
+    if(bRenderTargetsFailed) {
+        drawTiles(x1, y1, x2, y2);
+        return;
+    }
+
+    const auto zoomedTileSize = world2zoomedWorld(TILESIZE);
+
+    const auto minChunkX = std::max(0, x1 / TERRAINCHUNK_SIZE);
+    const auto minChunkY = std::max(0, y1 / TERRAINCHUNK_SIZE);
+    const auto maxChunkX = std::min(numChunksX - 1, (x2 - 1) / TERRAINCHUNK_SIZE);
+    const auto maxChunkY = std::min(numChunksY - 1, (y2 - 1) / TERRAINCHUNK_SIZE);
+
+    for(int chunkX = minChunkX; chunkX <= maxChunkX; chunkX++) {
+        for(int chunkY = minChunkY; chunkY <= maxChunkY; chunkY++) {
+            Chunk& chunk = chunks[chunkY*numChunksX + chunkX];
+
+            const auto tileX = chunkX*TERRAINCHUNK_SIZE;
+            const auto tileY = chunkY*TERRAINCHUNK_SIZE;
+            const auto chunkSizeX = std::min(TERRAINCHUNK_SIZE, mapSizeX - tileX);
+            const auto chunkSizeY = std::min(TERRAINCHUNK_SIZE, mapSizeY - tileY);
+
+            if((chunk.bDirty || !chunk.texture) && !renderChunk(chunk, chunkX, chunkY)) {
+                drawTiles(tileX, tileY, tileX + chunkSizeX, tileY + chunkSizeY);
+                continue;
+            }
+
+            SDL_Rect dest = {   screenborder->world2screenX(tileX*TILESIZE), screenborder->world2screenY(tileY*TILESIZE),
+                                chunkSizeX*zoomedTileSize, chunkSizeY*zoomedTileSize };
+            SDL_RenderCopy(renderer, chunk.texture.get(), nullptr, &dest);
+        }
+    }
+}
+
+void TerrainChunkCache::drawMipLevel(const SDL_Rect& dest) {
+    checkMapAndZoomlevel();
+
+    if(bRenderTargetsFailed) {
+        return;
+    }
+
+    int numRendered = 0;
+
+    for(int chunkX = 0; chunkX < numChunksX; chunkX++) {
+        for(int chunkY = 0; chunkY < numChunksY; chunkY++) {
+            Chunk& chunk = chunks[chunkY*numChunksX + chunkX];
+
+            if((chunk.bMipDirty || !chunk.mipTexture) && (numRendered < TERRAINCHUNK_MIPS_PER_FRAME)) {
+                if(!renderChunkMip(chunk, chunkX, chunkY)) {
+                    return;
+                }
+                numRendered++;
+            }
+
+            if(!chunk.mipTexture) {
+                continue;
+            }
+
+            const auto tileX = chunkX*TERRAINCHUNK_SIZE;
+            const auto tileY = chunkY*TERRAINCHUNK_SIZE;
+            const auto chunkSizeX = std::min(TERRAINCHUNK_SIZE, mapSizeX - tileX);
+            const auto chunkSizeY = std::min(TERRAINCHUNK_SIZE, mapSizeY - tileY);
+
+            // the edges are computed from the tile coordinates so that neighbouring chunks neither overlap nor leave gaps
+            const auto left = dest.x + tileX*dest.w/mapSizeX;
+            const auto top = dest.y + tileY*dest.h/mapSizeY;
+            const auto right = dest.x + (tileX + chunkSizeX)*dest.w/mapSizeX;
+            const auto bottom = dest.y + (tileY + chunkSizeY)*dest.h/mapSizeY;
+
+            SDL_Rect chunkDest = { left, top, right - left, bottom - top };
+            SDL_RenderCopy(renderer, chunk.mipTexture.get(), nullptr, &chunkDest);
+        }
+    }
+}
+
+void TerrainChunkCache::checkMapAndZoomlevel() {
+    if((pMap != currentGameMap) || (mapSizeX != currentGameMap->getSizeX()) || (mapSizeY != currentGameMap->getSizeY())) {
+        reset(currentGameMap);
+    }
+
+    if(zoomlevel != currentZoomlevel) {
+        invalidateAll();
+        zoomlevel = currentZoomlevel;
+    }
+}
+
+void TerrainChunkCache::reset(const Map* pNewMap) {
+    pMap = pNewMap;
+    mapSizeX = pMap->getSizeX();
+    mapSizeY = pMap->getSizeY();
+    numChunksX = (mapSizeX + TERRAINCHUNK_SIZE - 1) / TERRAINCHUNK_SIZE;
+    numChunksY = (mapSizeY + TERRAINCHUNK_SIZE - 1) / TERRAINCHUNK_SIZE;
+
+    // keep the textures of the old chunks for chunks of the same size
+    for(auto& chunk : chunks) {
+        if(chunk.texture) {
+            spareTextures.push_back(std::move(chunk.texture));
+        }
+    }
+
+    chunks.clear();
+    chunks.resize(numChunksX*numChunksY);
+}
+
+bool TerrainChunkCache::renderChunk(Chunk& chunk, int chunkX, int chunkY) {
+    const auto zoomedTileSize = world2zoomedWorld(TILESIZE);
+
+    const auto tileX = chunkX*TERRAINCHUNK_SIZE;
+    const auto tileY = chunkY*TERRAINCHUNK_SIZE;
+    const auto chunkSizeX = std::min(TERRAINCHUNK_SIZE, mapSizeX - tileX);
+    const auto chunkSizeY = std::min(TERRAINCHUNK_SIZE, mapSizeY - tileY);
+
+    if(!chunk.texture) {
+        chunk.texture = takeSpareTexture(chunkSizeX*zoomedTileSize, chunkSizeY*zoomedTileSize);
+    }
+
+    if(!chunk.texture) {
+        chunk.texture = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, chunkSizeX*zoomedTileSize, chunkSizeY*zoomedTileSize) };
+        if(chunk.texture == nullptr) {
+            SDL_Log("TerrainChunkCache: SDL_CreateTexture() failed: %s", SDL_GetError());
+            bRenderTargetsFailed = true;
+            return false;
+        }
+        SDL_SetTextureBlendMode(chunk.texture.get(), SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_Texture* oldRenderTarget = SDL_GetRenderTarget(renderer);
+    if(SDL_SetRenderTarget(renderer, chunk.texture.get()) != 0) {
+        SDL_Log("TerrainChunkCache: SDL_SetRenderTarget() failed: %s", SDL_GetError());
+        SDL_SetRenderTarget(renderer, oldRenderTarget);
+        bRenderTargetsFailed = true;
+        invalidateAll();
+        return false;
+    }
+
+    renderGround(tileX, tileY, chunkSizeX, chunkSizeY);
+
+    SDL_SetRenderTarget(renderer, oldRenderTarget);
+
+    chunk.bDirty = false;
+    return true;
+}
+
+bool TerrainChunkCache::renderChunkMip(Chunk& chunk, int chunkX, int chunkY) {
+    const auto zoomedTileSize = world2zoomedWorld(TILESIZE);
+
+    const auto tileX = chunkX*TERRAINCHUNK_SIZE;
+    const auto tileY = chunkY*TERRAINCHUNK_SIZE;
+    const auto chunkSizeX = std::min(TERRAINCHUNK_SIZE, mapSizeX - tileX);
+    const auto chunkSizeY = std::min(TERRAINCHUNK_SIZE, mapSizeY - tileY);
+
+    SDL_Texture* oldRenderTarget = SDL_GetRenderTarget(renderer);
+
+    // the ground is rendered at the current zoom level first (unless the chunk texture is up to date) and then scaled down
+    SDL_Texture* pSource = chunk.texture.get();
+    if(chunk.bDirty || (pSource == nullptr)) {
+        if(!mipScratchTexture) {
+            mipScratchTexture = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, TERRAINCHUNK_SIZE*zoomedTileSize, TERRAINCHUNK_SIZE*zoomedTileSize) };
+            if(mipScratchTexture == nullptr) {
+                SDL_Log("TerrainChunkCache: SDL_CreateTexture() failed: %s", SDL_GetError());
+                bRenderTargetsFailed = true;
+                return false;
+            }
+            SDL_SetTextureBlendMode(mipScratchTexture.get(), SDL_BLENDMODE_BLEND);
+        }
+
+        if(SDL_SetRenderTarget(renderer, mipScratchTexture.get()) != 0) {
+            SDL_Log("TerrainChunkCache: SDL_SetRenderTarget() failed: %s", SDL_GetError());
+            SDL_SetRenderTarget(renderer, oldRenderTarget);
+            bRenderTargetsFailed = true;
+            invalidateAll();
+            return false;
+        }
+
+        renderGround(tileX, tileY, chunkSizeX, chunkSizeY);
+        pSource = mipScratchTexture.get();
+    }
+
+    if(!chunk.mipTexture) {
+        chunk.mipTexture = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, chunkSizeX*TERRAINCHUNK_MIPTILESIZE, chunkSizeY*TERRAINCHUNK_MIPTILESIZE) };
+        if(chunk.mipTexture == nullptr) {
+            SDL_Log("TerrainChunkCache: SDL_CreateTexture() failed: %s", SDL_GetError());
+            SDL_SetRenderTarget(renderer, oldRenderTarget);
+            bRenderTargetsFailed = true;
+            return false;
+        }
+        SDL_SetTextureBlendMode(chunk.mipTexture.get(), SDL_BLENDMODE_BLEND);
+    }
+
+    if(SDL_SetRenderTarget(renderer, chunk.mipTexture.get()) != 0) {
+        SDL_Log("TerrainChunkCache: SDL_SetRenderTarget() failed: %s", SDL_GetError());
+        SDL_SetRenderTarget(renderer, oldRenderTarget);
+        bRenderTargetsFailed = true;
+        invalidateAll();
+        return false;
+    }
+
+    Uint8 oldR, oldG, oldB, oldA;
+    SDL_GetRenderDrawColor(renderer, &oldR, &oldG, &oldB, &oldA);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, oldR, oldG, oldB, oldA);
+
+    SDL_Rect source = { 0, 0, chunkSizeX*zoomedTileSize, chunkSizeY*zoomedTileSize };
+    SDL_SetTextureBlendMode(pSource, SDL_BLENDMODE_NONE);
+    SDL_RenderCopy(renderer, pSource, &source, nullptr);
+    SDL_SetTextureBlendMode(pSource, SDL_BLENDMODE_BLEND);
+
+    SDL_SetRenderTarget(renderer, oldRenderTarget);
+
+    chunk.bMipDirty = false;
+    return true;
+}
+
+void TerrainChunkCache::renderGround(int tileX, int tileY, int chunkSizeX, int chunkSizeY) const {
+    const auto zoomedTileSize = world2zoomedWorld(TILESIZE);
+
+    // tiles covered by a structure are not drawn and stay transparent
+    Uint8 oldR, oldG, oldB, oldA;
+    SDL_GetRenderDrawColor(renderer, &oldR, &oldG, &oldB, &oldA);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, oldR, oldG, oldB, oldA);
+
+    for(int x = 0; x < chunkSizeX; x++) {
+        for(int y = 0; y < chunkSizeY; y++) {
+            pMap->getTile(tileX + x, tileY + y)->blitGroundTerrain(x*zoomedTileSize, y*zoomedTileSize);
+        }
+    }
+}
+
+sdl2::texture_ptr TerrainChunkCache::takeSpareTexture(int width, int height) {
+    for(auto iter = spareTextures.begin(); iter != spareTextures.end(); ++iter) {
+        int textureWidth = 0;
+        int textureHeight = 0;
+        if((SDL_QueryTexture(iter->get(), nullptr, nullptr, &textureWidth, &textureHeight) == 0)
+            && (textureWidth == width) && (textureHeight == height)) {
+            sdl2::texture_ptr texture = std::move(*iter);
+            *iter = std::move(spareTextures.back());
+            spareTextures.pop_back();
+            return texture;
+        }
+    }
+
+    return nullptr;
+}
+
+void TerrainChunkCache::drawTiles(int x1, int y1, int x2, int y2) const {
+    for(int x = x1; x < x2; x++) {
+        for(int y = y1; y < y2; y++) {
+            pMap->getTile(x, y)->blitGroundTerrain(screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE));
+        }
+    }
+}
@@ -33,29 +33,22 @@
 #include <units/InfantryBase.h>
 #include <units/AirUnit.h>
 
-#define FOGTIME MILLI2CYCLES(10 * 1000)
 
 Tile::Tile() {
-    type = Terrain_Sand;
-
-    for (auto i = 0; i < NUM_TEAMS; i++) {
-        explored[i] = currentGame->getGameInitSettings().getGameOptions().startWithExploredMap;
-        lastAccess[i] = 0;
-    }
-
     fogColor = COLOR_BLACK;
 
-    owner = INVALID;
     sandRegion = NONE_ID;
 
     spice = 0;
 
-    sprite = pGFXManager->getObjPic(ObjPic_Terrain);
-
     for (auto& time : tracksCreationTime) {
         time = 0;
     }
 
+    for (auto& position : infantryPositions) {
+        position = INVALID_POS;
+    }
+
     location.x = 0;
     location.y = 0;
 
@@ -65,23 +58,23 @@ Tile::Tile() {
 
 Tile::~Tile() = default;
 
-void Tile::load(InputStream& stream) {
-    type = stream.readUint32();
+void Tile::load(IMemoryStream& stream) {
+    pPlanes->setTerrainType(planeIndex, stream.readUint32());
 
+    bool explored[NUM_TEAMS];
     stream.readBools(&explored[0], &explored[1], &explored[2], &explored[3], &explored[4], &explored[5], &explored[6]);
 
     bool bLastAccess[NUM_TEAMS];
     stream.readBools(&bLastAccess[0], &bLastAccess[1], &bLastAccess[2], &bLastAccess[3], &bLastAccess[4], &bLastAccess[5], &bLastAccess[6]);
 
     for (int i = 0; i < NUM_TEAMS; i++) {
-        if (bLastAccess[i] == true) {
-            lastAccess[i] = stream.readUint32();
-        }
+        pPlanes->setExplored(planeIndex, i, explored[i]);
+        pPlanes->setLastAccess(planeIndex, i, bLastAccess[i] ? stream.readUint32() : 0);
     }
 
     fogColor = stream.readUint32();
 
-    owner = stream.readSint32();
+    setOwner(stream.readSint32());
     sandRegion = stream.readUint32();
 
     spice = stream.readFixPoint();
@@ -90,6 +83,7 @@ void Tile::load(InputStream& stream) {
     stream.readBools(&bHasDamage, &bHasDeadUnits, &bHasAirUnits, &bHasInfantry, &bHasUndergroundUnits, &bHasNonInfantryGroundObjects);
 
     if (bHasDamage) {
+        auto& damage = createDecals().damage;
         damage.clear();
         Uint32 numDamage = stream.readUint32();
         damage.reserve(numDamage);
@@ -105,6 +99,7 @@ void Tile::load(InputStream& stream) {
     }
 
     if (bHasDeadUnits) {
+        auto& deadUnits = createDecals().deadUnits;
         deadUnits.clear();
         Uint32 numDeadUnits = stream.readUint32();
         deadUnits.reserve(numDeadUnits);
@@ -119,6 +114,8 @@ void Tile::load(InputStream& stream) {
 
             deadUnits.push_back(newDeadUnit);
         }
+
+        registerForUpdates();
     }
 
     destroyedStructureTile = stream.readSint32();
@@ -133,24 +130,42 @@ void Tile::load(InputStream& stream) {
     }
 
     if (bHasAirUnits) {
-        assignedAirUnitList = stream.readUint32List();
+        stream.readUint32List(assignedAirUnitList);
     }
 
     if (bHasInfantry) {
-        assignedInfantryList = stream.readUint32List();
+        stream.readUint32List(assignedInfantryList);
+
+        const auto numPositions = std::min(assignedInfantryList.size(), static_cast<size_t>(NUM_INFANTRY_PER_TILE));
+        for (size_t i = 0; i < numPositions; i++) {
+            infantryPositions[i] = stream.readSint8();
+            if ((infantryPositions[i] >= 0) && (infantryPositions[i] < NUM_INFANTRY_PER_TILE)) {
+                infantryPositionMask |= (1 << infantryPositions[i]);
+            }
+        }
+        infantryTeam = stream.readSint8();
     }
 
     if (bHasUndergroundUnits) {
-        assignedUndergroundUnitList = stream.readUint32List();
+        stream.readUint32List(assignedUndergroundUnitList);
     }
 
     if (bHasNonInfantryGroundObjects) {
-        assignedNonInfantryGroundObjectList = stream.readUint32List();
+        stream.readUint32List(assignedNonInfantryGroundObjectList);
     }
+
+    updateBlocked();
 }
 
-void Tile::save(OutputStream& stream) const {
-    stream.writeUint32(type);
+void Tile::save(OMemoryStream& stream) const {
+    stream.writeUint32(getType());
+
+    bool explored[NUM_TEAMS];
+    Uint32 lastAccess[NUM_TEAMS];
+    for (int i = 0; i < NUM_TEAMS; i++) {
+        explored[i] = pPlanes->isExplored(planeIndex, i);
+        lastAccess[i] = pPlanes->getLastAccess(planeIndex, i);
+    }
 
     stream.writeBools(explored[0], explored[1], explored[2], explored[3], explored[4], explored[5], explored[6]);
 
@@ -163,11 +178,16 @@ void Tile::save(OutputStream& stream) const {
 
     stream.writeUint32(fogColor);
 
-    stream.writeUint32(owner);
+    stream.writeUint32(getOwner());
     stream.writeUint32(sandRegion);
 
     stream.writeFixPoint(spice);
 
+    static const TileDecals noDecals;
+    const TileDecals& decals = (decalIndex != NO_TILEDECALS) ? getDecals() : noDecals;
+    const auto& damage = decals.damage;
+    const auto& deadUnits = decals.deadUnits;
+
     stream.writeBools(!damage.empty(), !deadUnits.empty(), !assignedAirUnitList.empty(),
         !assignedInfantryList.empty(), !assignedUndergroundUnitList.empty(), !assignedNonInfantryGroundObjectList.empty());
 
@@ -215,6 +235,12 @@ void Tile::save(OutputStream& stream) const {
 
     if (!assignedInfantryList.empty()) {
         stream.writeUint32List(assignedInfantryList);
+
+        const auto numPositions = std::min(assignedInfantryList.size(), static_cast<size_t>(NUM_INFANTRY_PER_TILE));
+        for (size_t i = 0; i < numPositions; i++) {
+            stream.writeSint8(infantryPositions[i]);
+        }
+        stream.writeSint8(infantryTeam);
     }
 
     if (!assignedUndergroundUnitList.empty()) {
@@ -228,49 +254,61 @@ void Tile::save(OutputStream& stream) const {
 
 void Tile::assignAirUnit(Uint32 newObjectID) {
     assignedAirUnitList.push_back(newObjectID);
+    currentGameMap->noteTileObjectsChanged(location);
+    pPlanes->markRadarDirty(planeIndex);
 }
 
 void Tile::assignNonInfantryGroundObject(Uint32 newObjectID) {
     assignedNonInfantryGroundObjectList.push_back(newObjectID);
+    currentGameMap->getSpatialObjectIndex().add(location, newObjectID);
+    currentGameMap->noteTileObjectsChanged(location);
+    updateBlocked();
+    pPlanes->markRadarDirty(planeIndex);
 }
 
-int Tile::assignInfantry(Uint32 newObjectID, Sint8 currentPosition) {
+int Tile::assignInfantry(Uint32 newObjectID, int team, Sint8 currentPosition) {
     Sint8 newPosition = currentPosition;
 
     if (currentPosition < 0) {
-        bool used[NUM_INFANTRY_PER_TILE]{ false };
-
-        for (auto objectID : assignedInfantryList) {
-            const auto pInfantry = dynamic_cast<InfantryBase*>(currentGame->getObjectManager().getObject(objectID));
-            if (pInfantry == nullptr) {
-                continue;
-            }
-
-            const auto pos = pInfantry->getTilePosition();
-            if ((pos >= 0) && (pos < NUM_INFANTRY_PER_TILE)) {
-                used[pos] = true;
-            }
-        }
-
+        // take the first free position
         for (newPosition = 0; newPosition < NUM_INFANTRY_PER_TILE; newPosition++) {
-            if (used[newPosition] == false) {
+            if ((infantryPositionMask & (1 << newPosition)) == 0) {
                 break;
             }
         }
+    }
+
+    const auto index = assignedInfantryList.size();
+    if (index < NUM_INFANTRY_PER_TILE) {
+        if ((newPosition < NUM_INFANTRY_PER_TILE) && ((infantryPositionMask & (1 << newPosition)) == 0)) {
+            infantryPositions[index] = newPosition;
+            infantryPositionMask |= (1 << newPosition);
+        } else {
+            infantryPositions[index] = INVALID_POS;
+        }
+    }
 
-        newPosition = std::max(static_cast<Sint8>(0), std::min(newPosition, static_cast<Sint8>(NUM_INFANTRY_PER_TILE)));
+    if (assignedInfantryList.empty()) {
+        infantryTeam = team;
     }
 
     assignedInfantryList.push_back(newObjectID);
+    currentGameMap->getSpatialObjectIndex().add(location, newObjectID);
+    currentGameMap->noteTileObjectsChanged(location);
+    updateBlocked();
+    pPlanes->markRadarDirty(planeIndex);
     return newPosition;
 }
 
 
 void Tile::assignUndergroundUnit(Uint32 newObjectID) {
     assignedUndergroundUnitList.push_back(newObjectID);
+    currentGameMap->getSpatialObjectIndex().add(location, newObjectID);
+    currentGameMap->noteTileObjectsChanged(location);
+    pPlanes->markRadarDirty(planeIndex);
 }
 
-void Tile::blitGround(int xPos, int yPos) {
+void Tile::blitGroundTerrain(int xPos, int yPos) const {
     if (hasANonInfantryGroundObject() && getNonInfantryGroundObject()->isAStructure())
         return;
 
@@ -278,47 +316,89 @@ void Tile::blitGround(int xPos, int yPos) {
     const auto indexX = tileIndex % NUM_TERRAIN_TILES_X;
     const auto indexY = tileIndex / NUM_TERRAIN_TILES_X;
     const auto zoomed_tilesize = world2zoomedWorld(TILESIZE);
-    SDL_Rect source = { indexX*zoomed_tilesize, indexY*zoomed_tilesize, zoomed_tilesize, zoomed_tilesize };
     SDL_Rect drawLocation = { xPos, yPos, zoomed_tilesize, zoomed_tilesize };
 
     //draw terrain
     if (destroyedStructureTile == DestroyedStructure_None || destroyedStructureTile == DestroyedStructure_Wall) {
-        SDL_RenderCopy(renderer, sprite[currentZoomlevel], &source, &drawLocation);
+        const auto terrainPic = pGFXManager->getZoomedAtlasPic(ObjPic_Terrain, currentZoomlevel);
+        SDL_Rect source = terrainPic.getSourceRect(indexX*zoomed_tilesize, indexY*zoomed_tilesize, zoomed_tilesize, zoomed_tilesize);
+        SDL_RenderCopy(renderer, terrainPic.texture, &source, &drawLocation);
     }
 
     if (destroyedStructureTile != DestroyedStructure_None) {
-        SDL_Texture* pDestroyedStructureTex = pGFXManager->getZoomedObjPic(ObjPic_DestroyedStructure, currentZoomlevel);
-        SDL_Rect source2 = { destroyedStructureTile*zoomed_tilesize, 0, zoomed_tilesize, zoomed_tilesize };
-        SDL_RenderCopy(renderer, pDestroyedStructureTex, &source2, &drawLocation);
+        const auto destroyedStructurePic = pGFXManager->getZoomedAtlasPic(ObjPic_DestroyedStructure, currentZoomlevel);
+        SDL_Rect source2 = destroyedStructurePic.getSourceRect(destroyedStructureTile*zoomed_tilesize, 0, zoomed_tilesize, zoomed_tilesize);
+        SDL_RenderCopy(renderer, destroyedStructurePic.texture, &source2, &drawLocation);
+    }
+}
+
+bool Tile::hasGroundDetails() const noexcept {
+    if ((decalIndex != NO_TILEDECALS) && !getDecals().damage.empty()) {
+        return true;
     }
 
+    // tracks are only reset when saving, so faded tracks must not keep the tile in the draw list
+    const Uint32 gameCycle = currentGame->getGameCycleCount();
+    return std::any_of(std::begin(tracksCreationTime), std::end(tracksCreationTime),
+                       [gameCycle](Uint32 t) { return (t != 0) && (gameCycle - t < (Uint32) TRACKSTIME); });
+}
+
+void Tile::blitGroundDetails(int xPos, int yPos) const {
+    if (hasANonInfantryGroundObject() && getNonInfantryGroundObject()->isAStructure())
+        return;
+
+    if (!hasGroundDetails())
+        return;
+
     if (isFoggedByTeam(pLocalHouse->getTeamID()))
         return;
 
+    // the tracks and damage pictures have only one row; parts outside of them are not drawn
+    const auto zoomed_tilesize = world2zoomedWorld(TILESIZE);
+    const auto sourceY = (getTerrainTile() / NUM_TERRAIN_TILES_X) * zoomed_tilesize;
+    SDL_Rect drawLocation = { xPos, yPos, zoomed_tilesize, zoomed_tilesize };
+
     // tracks
-    SDL_Texture* pTracks = pGFXManager->getZoomedObjPic(ObjPic_Terrain_Tracks, currentZoomlevel);
+    const auto tracksPic = pGFXManager->getZoomedAtlasPic(ObjPic_Terrain_Tracks, currentZoomlevel);
+    bool bTracksAlphaChanged = false;
     for (auto i = 0; i < NUM_ANGLES; i++) {
         const auto tracktime = static_cast<int>(currentGame->getGameCycleCount() - tracksCreationTime[i]);
-        if ((tracksCreationTime[i] != 0) && (tracktime < TRACKSTIME)) {
-            source.x = ((10 - i) % 8)*zoomed_tilesize;
-            SDL_SetTextureAlphaMod(pTracks, std::min(255, 256 * (TRACKSTIME - tracktime) / TRACKSTIME));
-            SDL_RenderCopy(renderer, pTracks, &source, &drawLocation);
+        const auto sourceX = ((10 - i) % 8)*zoomed_tilesize;
+        if ((tracksCreationTime[i] != 0) && (tracktime < TRACKSTIME) && tracksPic.contains(sourceX, sourceY, zoomed_tilesize, zoomed_tilesize)) {
+            SDL_Rect source = tracksPic.getSourceRect(sourceX, sourceY, zoomed_tilesize, zoomed_tilesize);
+            SDL_SetTextureAlphaMod(tracksPic.texture, std::min(255, 256 * (TRACKSTIME - tracktime) / TRACKSTIME));
+            SDL_RenderCopy(renderer, tracksPic.texture, &source, &drawLocation);
+            bTracksAlphaChanged = true;
         }
     }
 
+    if (bTracksAlphaChanged) {
+        // the tracks may share their texture with other ground pictures
+        SDL_SetTextureAlphaMod(tracksPic.texture, 255);
+    }
+
     // damage
-    for (const auto& damageItem : damage) {
-        source.x = damageItem.tile*zoomed_tilesize;
-        SDL_Rect dest = { screenborder->world2screenX(damageItem.realPos.x) - zoomed_tilesize / 2,
-            screenborder->world2screenY(damageItem.realPos.y) - zoomed_tilesize / 2,
-            zoomed_tilesize,
-            zoomed_tilesize };
+    static const std::vector<DAMAGETYPE> noDamage;
+    for (const auto& damageItem : (decalIndex != NO_TILEDECALS) ? getDecals().damage : noDamage) {
+        const auto sourceX = damageItem.tile*zoomed_tilesize;
 
         if (damageItem.damageType == Terrain_RockDamage) {
-            SDL_RenderCopy(renderer, pGFXManager->getZoomedObjPic(ObjPic_RockDamage, currentZoomlevel), &source, &dest);
+            const auto rockDamagePic = pGFXManager->getZoomedAtlasPic(ObjPic_RockDamage, currentZoomlevel);
+            if (rockDamagePic.contains(sourceX, sourceY, zoomed_tilesize, zoomed_tilesize)) {
+                SDL_Rect source = rockDamagePic.getSourceRect(sourceX, sourceY, zoomed_tilesize, zoomed_tilesize);
+                SDL_Rect dest = { screenborder->world2screenX(damageItem.realPos.x) - zoomed_tilesize / 2,
+                    screenborder->world2screenY(damageItem.realPos.y) - zoomed_tilesize / 2,
+                    zoomed_tilesize,
+                    zoomed_tilesize };
+                SDL_RenderCopy(renderer, rockDamagePic.texture, &source, &dest);
+            }
         }
         else {
-            SDL_RenderCopy(renderer, pGFXManager->getZoomedObjPic(ObjPic_SandDamage, currentZoomlevel), &source, &drawLocation);
+            const auto sandDamagePic = pGFXManager->getZoomedAtlasPic(ObjPic_SandDamage, currentZoomlevel);
+            if (sandDamagePic.contains(sourceX, sourceY, zoomed_tilesize, zoomed_tilesize)) {
+                SDL_Rect source = sandDamagePic.getSourceRect(sourceX, sourceY, zoomed_tilesize, zoomed_tilesize);
+                SDL_RenderCopy(renderer, sandDamagePic.texture, &source, &drawLocation);
+            }
         }
     }
 }
@@ -366,12 +446,12 @@ void Tile::blitUndergroundUnits(int xPos, int yPos) const {
 }
 
 void Tile::blitDeadUnits(int xPos, int yPos) {
-    if (isFoggedByTeam(pLocalHouse->getTeamID()))
+    if (!hasDeadUnits() || isFoggedByTeam(pLocalHouse->getTeamID()))
         return;
 
     const auto zoomed_tile = world2zoomedWorld(TILESIZE);
 
-    for (const auto& deadUnit : deadUnits) {
+    for (const auto& deadUnit : getDecals().deadUnits) {
         SDL_Rect source = { 0, 0, zoomed_tile, zoomed_tile };
         SDL_Texture* pTexture = nullptr;
         switch (deadUnit.type) {
@@ -517,8 +597,38 @@ void Tile::blitSelectionRects(int xPos, int yPos) const {
                     blitObjectSelectionRect);
 }
 
+void Tile::assignDeadUnit(Uint8 type, Uint8 house, const Coord& position) {
+    DEADUNITTYPE newDeadUnit;
+    newDeadUnit.type = type;
+    newDeadUnit.house = house;
+    newDeadUnit.onSand = isSand() || isDunes();
+    newDeadUnit.realPos = position;
+    newDeadUnit.timer = 2000;
+
+    auto& deadUnits = createDecals().deadUnits;
+    if (deadUnits.size() >= DEADUNITS_PER_TILE) {
+        // the oldest dead unit has the lowest timer and goes first
+        deadUnits.erase(deadUnits.begin());
+    }
+    deadUnits.push_back(newDeadUnit);
+
+    registerForUpdates();
+}
+
+void Tile::registerForUpdates() {
+    if (!bRegisteredForUpdates && hasDeadUnits()) {
+        bRegisteredForUpdates = true;
+        currentGameMap->addActiveTile(this);
+    }
+}
+
 void Tile::update_impl()
 {
+    if (decalIndex == NO_TILEDECALS) {
+        return;
+    }
+
+    auto& deadUnits = pPlanes->getDecalStore().get(decalIndex).deadUnits;
     deadUnits.erase(
         std::remove_if(std::begin(deadUnits), std::end(deadUnits),
             [](DEADUNITTYPE& dut)
@@ -529,15 +639,20 @@ void Tile::update_impl()
                 return false;
             }),
         std::end(deadUnits));
+
+    releaseDecalsIfEmpty();
 }
 
 
 void Tile::clearTerrain() {
-    damage.clear();
-    deadUnits.clear();
+    if (decalIndex != NO_TILEDECALS) {
+        pPlanes->getDecalStore().release(decalIndex);
+        decalIndex = NO_TILEDECALS;
+    }
 }
 
 void Tile::setTrack(Uint8 direction) {
+    const auto type = getType();
     if (type == Terrain_Sand || type == Terrain_Dunes || type == Terrain_Spice || type == Terrain_ThickSpice) {
         tracksCreationTime[direction] = currentGame->getGameCycleCount();
     }
@@ -548,26 +663,61 @@ void Tile::selectAllPlayersUnits(int houseID, ObjectBase** lastCheckedObject, Ob
         [](ObjectBase* obj) { return  obj->isAUnit() && obj->isRespondable(); });
 }
 
-
-void Tile::selectAllPlayersUnitsOfType(int houseID, int itemID, ObjectBase** lastCheckedObject, ObjectBase** lastSelectedObject) {
-    selectFilter(houseID, lastCheckedObject, lastSelectedObject,
-        [=](ObjectBase* obj) { return  obj->getItemID() == itemID; });
-}
-
 void Tile::unassignAirUnit(Uint32 objectID) {
     assignedAirUnitList.remove(objectID);
+    currentGameMap->noteTileObjectsChanged(location);
+    pPlanes->markRadarDirty(planeIndex);
 }
 
 void Tile::unassignNonInfantryGroundObject(Uint32 objectID) {
-    assignedNonInfantryGroundObjectList.remove(objectID);
+    unassignFromList(assignedNonInfantryGroundObjectList, objectID);
+    updateBlocked();
 }
 
 void Tile::unassignUndergroundUnit(Uint32 objectID) {
-    assignedUndergroundUnitList.remove(objectID);
+    unassignFromList(assignedUndergroundUnitList, objectID);
 }
 
 void Tile::unassignInfantry(Uint32 objectID, int currentPosition) {
-    assignedInfantryList.remove(objectID);
+    const auto iter = std::find(assignedInfantryList.begin(), assignedInfantryList.end(), objectID);
+    if (iter == assignedInfantryList.end()) {
+        return;
+    }
+
+    // free the position of the unit and move the positions of the following units up like the list itself
+    const auto index = static_cast<size_t>(iter - assignedInfantryList.begin());
+    if (index < NUM_INFANTRY_PER_TILE) {
+        if (infantryPositions[index] != INVALID_POS) {
+            infantryPositionMask &= ~(1 << infantryPositions[index]);
+        }
+
+        for (auto i = index; i + 1 < NUM_INFANTRY_PER_TILE; i++) {
+            infantryPositions[i] = infantryPositions[i + 1];
+        }
+        infantryPositions[NUM_INFANTRY_PER_TILE - 1] = INVALID_POS;
+    }
+
+    unassignFromList(assignedInfantryList, objectID);
+    updateBlocked();
+
+    if (assignedInfantryList.empty()) {
+        infantryTeam = INVALID;
+    } else if (index == 0) {
+        updateInfantryTeam();
+    }
+}
+
+template<class ObjectList>
+void Tile::unassignFromList(ObjectList& objectList, Uint32 objectID) {
+    const auto oldSize = objectList.size();
+    objectList.remove(objectID);
+
+    const auto numRemoved = oldSize - objectList.size();
+    if(numRemoved > 0) {
+        currentGameMap->getSpatialObjectIndex().remove(location, objectID, numRemoved);
+        currentGameMap->noteTileObjectsChanged(location);
+        pPlanes->markRadarDirty(planeIndex);
+    }
 }
 
 void Tile::unassignObject(Uint32 objectID) {
@@ -578,52 +728,64 @@ void Tile::unassignObject(Uint32 objectID) {
 }
 
 
+void Tile::setDestroyedStructureTile(int newDestroyedStructureTile) {
+    destroyedStructureTile = newDestroyedStructureTile;
+    currentGame->getTerrainChunkCache().invalidateTile(location.x, location.y);
+}
+
 void Tile::setType(int newType) {
-    type = newType;
+    if(newType != getType()) {
+        // the cached flow fields contain the terrain difficulty of this tile
+        currentGameMap->getFlowFieldCache().invalidate();
+    }
+
+    pPlanes->setTerrainType(planeIndex, newType);
     destroyedStructureTile = DestroyedStructure_None;
+    invalidateTerrainTiles();
+    currentGame->getTerrainChunkCache().invalidateTile(location.x, location.y);
 
-    if (type == Terrain_Spice) {
-        spice = currentGame->randomGen.rand(RANDOMSPICEMIN, RANDOMSPICEMAX);
+    if (newType == Terrain_Spice) {
+        changeSpice(currentGame->randomGen.rand(RANDOMSPICEMIN, RANDOMSPICEMAX));
     }
-    else if (type == Terrain_ThickSpice) {
-        spice = currentGame->randomGen.rand(RANDOMTHICKSPICEMIN, RANDOMTHICKSPICEMAX);
+    else if (newType == Terrain_ThickSpice) {
+        changeSpice(currentGame->randomGen.rand(RANDOMTHICKSPICEMIN, RANDOMTHICKSPICEMAX));
     }
-    else if (type == Terrain_Dunes) {
+    else if (newType == Terrain_Dunes) {
     }
     else {
-        spice = 0;
+        changeSpice(0);
 
         if (isRock()) {
             sandRegion = NONE_ID;
             if (hasAnUndergroundUnit()) {
-                auto iter = assignedUndergroundUnitList.begin();
+                // iterate over a copy as destroying the units modifies the list
+                const auto undergroundUnits = assignedUndergroundUnitList;
 
-                do {
-                    ObjectBase* current = currentGame->getObjectManager().getObject(*iter);
-                    ++iter;
+                for (auto objectID : undergroundUnits) {
+                    ObjectBase* current = currentGame->getObjectManager().getObject(objectID);
 
                     if(current == nullptr)
                         continue;
 
                     unassignUndergroundUnit(current->getObjectID());
                     current->destroy();
-                } while(iter != assignedUndergroundUnitList.end());
+                }
             }
 
-            if (type == Terrain_Mountain) {
+            if (newType == Terrain_Mountain) {
                 if (hasANonInfantryGroundObject()) {
-                    auto iter = assignedNonInfantryGroundObjectList.begin();
+                    // iterate over a copy as destroying the objects modifies the list
+                    const auto groundObjects = assignedNonInfantryGroundObjectList;
 
-                    do {
-                        ObjectBase* current = currentGame->getObjectManager().getObject(*iter);
-                        ++iter;
+                    for (auto objectID : groundObjects) {
+                        ObjectBase* current = currentGame->getObjectManager().getObject(objectID);
 
                         if(current == nullptr)
                             continue;
 
                         unassignNonInfantryGroundObject(current->getObjectID());
                         current->destroy();
-                    } while(iter != assignedNonInfantryGroundObjectList.end());
+                    }
                 }
             }
         }
@@ -636,24 +798,27 @@ void Tile::setType(int newType) {
 void Tile::squash() const {
     if (!hasInfantry()) return;
 
-    auto iter = assignedInfantryList.begin();
-    do {
-        InfantryBase* current = static_cast<InfantryBase*>(currentGame->getObjectManager().getObject(*iter));
-        ++iter;
+    // iterate over a copy as squashing infantry modifies the list
+    const auto infantryList = assignedInfantryList;
+    for (auto objectID : infantryList) {
+        InfantryBase* current = static_cast<InfantryBase*>(currentGame->getObjectManager().getObject(objectID));
 
         if(current == nullptr)
             continue;
 
         current->squash();
-    } while(iter != assignedInfantryList.end());
+    }
 }
 
 
-int Tile::getInfantryTeam() const {
-    int team = INVALID;
-    if (hasInfantry())
-        team = getInfantry()->getOwner()->getTeamID();
-    return team;
+void Tile::updateInfantryTeam() {
+    infantryTeam = INVALID;
+    if (hasInfantry()) {
+        const auto pInfantry = getInfantry();
+        if (pInfantry != nullptr) {
+            infantryTeam = pInfantry->getOwner()->getTeamID();
+        }
+    }
 }
 
 
@@ -661,10 +826,10 @@ FixPoint Tile::harvestSpice() {
     const auto oldSpice = spice;
 
     if ((spice - HARVESTSPEED) >= 0) {
-        spice -= HARVESTSPEED;
+        changeSpice(spice - HARVESTSPEED);
     }
     else {
-        spice = 0;
+        changeSpice(0);
     }
 
     if (oldSpice >= RANDOMTHICKSPICEMIN && spice < RANDOMTHICKSPICEMIN) {
@@ -680,16 +845,29 @@ FixPoint Tile::harvestSpice() {
 
 
 void Tile::setSpice(FixPoint newSpice) {
+    int newType = Terrain_Spice;
     if (newSpice <= 0) {
-        type = Terrain_Sand;
+        newType = Terrain_Sand;
     }
     else if (newSpice >= RANDOMTHICKSPICEMIN) {
-        type = Terrain_ThickSpice;
+        newType = Terrain_ThickSpice;
     }
-    else {
-        type = Terrain_Spice;
+
+    if(newType != getType()) {
+        // the cached flow fields contain the terrain difficulty of this tile
+        currentGameMap->getFlowFieldCache().invalidate();
+    }
+    pPlanes->setTerrainType(planeIndex, newType);
+    invalidateTerrainTiles();
+    currentGame->getTerrainChunkCache().invalidateTile(location.x, location.y);
+    changeSpice(newSpice);
+}
+
+void Tile::changeSpice(FixPoint newSpice) {
+    if (newSpice != spice) {
+        currentGameMap->getSpiceIndex().spiceChanged(location, spice, newSpice);
+        spice = newSpice;
     }
-    spice = newSpice;
 }
 
 
@@ -823,16 +1001,9 @@ void Tile::triggerSpiceBloom(House* pTrigger) {
 
     const auto realLocation = location * TILESIZE + Coord(TILESIZE / 2, TILESIZE / 2);
 
-    if (damage.size() < DAMAGE_PER_TILE) {
-        DAMAGETYPE newDamage;
-        newDamage.tile = SandDamage1;
-        newDamage.damageType = Terrain_SandDamage;
-        newDamage.realPos = realLocation;
+    addDamage(Terrain_SandDamage, SandDamage1, realLocation);
 
-        damage.push_back(newDamage);
-    }
-
-    currentGame->getExplosionList().push_back(new Explosion(Explosion_SpiceBloom, realLocation, pTrigger->getHouseID()));
+    currentGame->getExplosionList().create(Explosion_SpiceBloom, realLocation, pTrigger->getHouseID());
 }
 
 void Tile::triggerSpecialBloom(House* pTrigger) {
@@ -945,10 +1116,15 @@ bool Tile::hasAStructure() const {
 }
 
 bool Tile::isExploredByTeam(int teamID) const {
+    const auto exploredMask = pPlanes->getExploredMask(planeIndex);
+    if (exploredMask == 0) {
+        return false;
+    }
+
     for (auto h = 0; h < NUM_HOUSES; h++) {
         const auto* pHouse = currentGame->getHouse(h);
         if ((pHouse != nullptr) && (pHouse->getTeamID() == teamID)) {
-            if(isExploredByHouse(h)) {
+            if(exploredMask & (1 << h)) {
                 return true;
             }
         }
@@ -964,7 +1140,11 @@ bool Tile::isFoggedByHouse(int houseID) const noexcept {
         return false;
     }
 
-    return (currentGame->getGameCycleCount() - lastAccess[houseID]) >= FOGTIME;
+    if (pPlanes->isInSight(planeIndex, houseID)) {
+        return false;
+    }
+
+    return (currentGame->getGameCycleCount() - pPlanes->getLastAccess(planeIndex, houseID)) >= FOGTIME;
 }
 
 bool Tile::isFoggedByTeam(int teamID) const noexcept {
@@ -978,7 +1158,7 @@ bool Tile::isFoggedByTeam(int teamID) const noexcept {
     for (auto h = 0; h < NUM_HOUSES; h++) {
         const auto* pHouse = currentGame->getHouse(h);
         if ((pHouse != nullptr) && (pHouse->getTeamID() == teamID)) {
-            if((currentGame->getGameCycleCount() - lastAccess[h]) < FOGTIME) {
+            if(pPlanes->isInSight(planeIndex, h) || ((currentGame->getGameCycleCount() - pPlanes->getLastAccess(planeIndex, h)) < FOGTIME)) {
                 return false;
             }
         }
@@ -1039,8 +1219,8 @@ Uint32 Tile::getRadarColor(House* pHouse, bool radar) {
     return fogColor;
 }
 
-int Tile::getTerrainTile() const {
-    auto terrainType = type;
+int Tile::computeTerrainTile() const {
+    auto terrainType = getType();
     if (terrainType == Terrain_ThickSpice) {
         // check if we are surrounded by spice/thick spice
         bool up = (currentGameMap->tileExists(location.x, location.y - 1) == false) || (currentGameMap->getTile(location.x, location.y - 1)->isSpice() == true);
@@ -1122,11 +1302,25 @@ int Tile::getTerrainTile() const {
     } break;
 
     default: {
-        THROW(std::runtime_error, "Tile::getTerrainTile(): Invalid terrain type");
+        THROW(std::runtime_error, "Tile::computeTerrainTile(): Invalid terrain type");
     } break;
     }
 }
 
+void Tile::invalidateTerrainTiles() {
+    terrainTile = -1;
+
+    static const int offsetX[] = { 0, 1, 0, -1 };
+    static const int offsetY[] = { -1, 0, 1, 0 };
+    for(int i = 0; i < 4; i++) {
+        const int x = location.x + offsetX[i];
+        const int y = location.y + offsetY[i];
+        if(currentGameMap->tileExists(x, y)) {
+            currentGameMap->getTile(x, y)->terrainTile = -1;
+        }
+    }
+}
+
 int Tile::getHideTile(int teamID) const {
     // are all surrounding tiles explored?
     if (((currentGameMap->tileExists(location.x, location.y - 1) == false) || (currentGameMap->getTile(location.x, location.y - 1)->isExploredByTeam(teamID) == true))
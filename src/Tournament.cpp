@@ -0,0 +1,293 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <Tournament.h>
+
+#include <globals.h>
+
+#include <Game.h>
+#include <GameInitSettings.h>
+#include <Definitions.h>
+#include <sand.h>
+
+#include <FileClasses/INIFile.h>
+
+#include <players/PlayerFactory.h>
+
+#include <misc/OMemoryStream.h>
+#include <misc/OFileStream.h>
+#include <misc/FileSystem.h>
+#include <misc/string_util.h>
+#include <misc/exceptions.h>
+#include <misc/format.h>
+#include <misc/fnkdat.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+std::string TournamentGameResult::toCSV() const {
+    return fmt::sprintf("%s,%u,%s,%s,%s,%s,%s,%u,%u",
+                        map, seed, playerClass[0], getHouseNameByNumber(house[0]), playerClass[1], getHouseNameByNumber(house[1]),
+                        result, gameCycles, elapsedTime);
+}
+
+const char* TournamentGameResult::getCSVHeader() {
+    return "map,seed,player1,house1,player2,house2,result,gamecycles,ms";
+}
+
+namespace {
+
+/// The results of all games of one player against another player
+struct TournamentScore {
+    int numWon = 0;
+    int numLost = 0;
+    int numDraws = 0;
+    double totalGameCycles = 0.0;
+    double totalSquaredGameCycles = 0.0;
+
+    void add(const std::string& result, Uint32 gameCycles) {
+        if(result == "won") {
+            numWon++;
+        } else if(result == "lost") {
+            numLost++;
+        } else {
+            numDraws++;
+        }
+        totalGameCycles += gameCycles;
+        totalSquaredGameCycles += (double) gameCycles * gameCycles;
+    }
+
+    int getNumGames() const { return numWon + numLost + numDraws; }
+
+    /// the share of the possible points (1 for a win, 0.5 for a draw)
+    double getScore() const { return (numWon + 0.5 * numDraws) / std::max(getNumGames(), 1); }
+
+    /// Formats score, 95% confidence interval (Wilson score interval) and average game length with its 95% confidence interval
+    std::string toString() const {
+        const double z = 1.96;
+        const double n = std::max(getNumGames(), 1);
+        const double p = getScore();
+        const double center = (p + z*z / (2*n)) / (1 + z*z / n);
+        const double halfWidth = z * std::sqrt(p * (1 - p) / n + z*z / (4*n*n)) / (1 + z*z / n);
+
+        const double meanGameCycles = totalGameCycles / n;
+        const double variance = std::max(totalSquaredGameCycles / n - meanGameCycles*meanGameCycles, 0.0) * n / std::max(n - 1, 1.0);
+
+        return fmt::sprintf("%d games, %d won, %d lost, %d draws, score %.1f%% (95%% CI %.1f%% - %.1f%%), %.0f +- %.0f game cycles",
+                            getNumGames(), numWon, numLost, numDraws,
+                            p * 100, std::max(center - halfWidth, 0.0) * 100, std::min(center + halfWidth, 1.0) * 100,
+                            meanGameCycles, z * std::sqrt(variance / n));
+    }
+};
+
+/// Plays one game of the tournament and returns the recorded replay in replay
+TournamentGameResult playTournamentGame(const std::string& mapfile, Uint32 seed, const std::string playerClass[2], const HOUSETYPE house[2], Uint32 maxGameCycle, std::string& replay) {
+    TournamentGameResult gameResult;
+    gameResult.map = getBasename(mapfile, true);
+    gameResult.seed = seed;
+
+    // default game options and the seed make every game reproducible
+    GameInitSettings gameInitSettings(getBasename(mapfile, true), readCompleteFile(mapfile), true, SettingsClass::GameOptionsClass());
+    gameInitSettings.setRandomSeed(seed);
+
+    for(int i = 0; i < 2; i++) {
+        gameResult.playerClass[i] = playerClass[i];
+        gameResult.house[i] = house[i];
+
+        GameInitSettings::HouseInfo houseInfo(house[i], i + 1);
+        if(i == 0) {
+            // the game needs a local player; it is idle and only observes whether the first house wins or loses
+            houseInfo.addPlayerInfo(GameInitSettings::PlayerInfo("Tournament", HUMANPLAYERCLASS));
+        }
+        houseInfo.addPlayerInfo(GameInitSettings::PlayerInfo(getHouseNameByNumber(house[i]) + "1", playerClass[i]));
+        gameInitSettings.addHouseInfo(houseInfo);
+    }
+
+    try {
+        currentGame = new Game();
+        currentGame->initGame(gameInitSettings);
+        currentGame->setHeadless(maxGameCycle);
+
+        const Uint32 startTime = SDL_GetTicks();
+        currentGame->runMainLoop();
+        gameResult.elapsedTime = SDL_GetTicks() - startTime;
+
+        gameResult.result = currentGame->isFinished() ? (currentGame->isWon() ? "won" : "lost") : "draw";
+        gameResult.gameCycles = currentGame->getGameCycleCount();
+
+        OMemoryStream memStream;
+        memStream.open();
+        currentGame->saveReplayFile(memStream);
+        replay.assign(memStream.getData(), memStream.getDataLength());
+    } catch(std::exception& e) {
+        SDL_Log("Playing '%s' with seed %u failed: %s", mapfile.c_str(), seed, e.what());
+        gameResult.result = "error";
+    }
+
+    delete currentGame;
+    currentGame = nullptr;
+
+    return gameResult;
+}
+
+}
+
+bool runTournament(const std::string& filename, int shardIndex, int numShards, Uint32 maxGameCycle) {
+    if((numShards < 1) || (shardIndex < 0) || (shardIndex >= numShards)) {
+        THROW(std::invalid_argument, "runTournament(): Invalid shard %d of %d!", shardIndex, numShards);
+    }
+
+    if(!existsFile(filename)) {
+        THROW(std::runtime_error, "Cannot open tournament '%s'!", filename);
+    }
+
+    const INIFile inifile(filename);
+    if(!inifile.hasSection("TOURNAMENT")) {
+        THROW(std::runtime_error, "'%s' is no tournament as it has no section [TOURNAMENT]!", filename);
+    }
+
+    std::vector<std::string> playerClasses;
+    for(const std::string& playerClass : splitStringToStringVector(inifile.getStringValue("TOURNAMENT", "Players"), ",")) {
+        if(PlayerFactory::getByPlayerClass(trim(playerClass)) == nullptr) {
+            THROW(std::runtime_error, "Tournament '%s' contains the unknown player class '%s'!", filename, trim(playerClass));
+        }
+        playerClasses.push_back(trim(playerClass));
+    }
+    if(playerClasses.size() < 2) {
+        THROW(std::runtime_error, "Tournament '%s' needs at least two players!", filename);
+    }
+
+    const std::string directory = getDirname(filename);
+    std::vector<std::string> mapfiles;
+    for(const std::string& map : splitStringToStringVector(inifile.getStringValue("TOURNAMENT", "Maps"), ",")) {
+        std::string mapfile = trim(map);
+        if(!mapfile.empty() && (mapfile[0] != '/') && !directory.empty()) {
+            mapfile = directory + "/" + mapfile;
+        }
+        if(!existsFile(mapfile)) {
+            THROW(std::runtime_error, "Cannot open map '%s' of tournament '%s'!", mapfile, filename);
+        }
+        mapfiles.push_back(mapfile);
+    }
+    if(mapfiles.empty()) {
+        THROW(std::runtime_error, "Tournament '%s' has no maps!", filename);
+    }
+
+    HOUSETYPE houses[2] = { HOUSE_HARKONNEN, HOUSE_ATREIDES };
+    const std::vector<std::string> houseNames = splitStringToStringVector(inifile.getStringValue("TOURNAMENT", "Houses", "Harkonnen,Atreides"), ",");
+    for(int i = 0; i < 2; i++) {
+        houses[i] = (houseNames.size() == 2) ? getHouseByName(trim(houseNames[i])) : HOUSE_INVALID;
+        if(houses[i] == HOUSE_INVALID) {
+            THROW(std::runtime_error, "Tournament '%s' does not specify two valid houses!", filename);
+        }
+    }
+
+    const Uint32 numSeeds = std::max(inifile.getIntValue("TOURNAMENT", "Seeds", 1), 1);
+
+    if(maxGameCycle == 0) {
+        maxGameCycle = inifile.getIntValue("TOURNAMENT", "GameCycles", 0);
+    }
+    if(maxGameCycle == 0) {
+        THROW(std::runtime_error, "Tournament '%s' does not specify the maximum number of game cycles per game!", filename);
+    }
+
+    fprintf(stdout, "%s\n", TournamentGameResult::getCSVHeader());
+    fflush(stdout);
+
+    std::vector<TournamentGameResult> gameResults;
+    std::vector<std::string> replays;
+    int numFailed = 0;
+
+    int gameIndex = 0;
+    for(size_t first = 0; first < playerClasses.size(); first++) {
+        for(size_t second = first + 1; second < playerClasses.size(); second++) {
+            for(const std::string& mapfile : mapfiles) {
+                for(Uint32 seed = 1; seed <= numSeeds; seed++) {
+                    if(gameIndex++ % numShards != shardIndex) {
+                        continue;
+                    }
+
+                    // swap the houses with every seed, so that no player profits from a better start position
+                    const std::string gamePlayerClasses[2] = { playerClasses[first], playerClasses[second] };
+                    const HOUSETYPE gameHouses[2] = { houses[(seed + 1) % 2], houses[seed % 2] };
+
+                    SDL_Log("Playing %s vs. %s on '%s' with seed %u...", gamePlayerClasses[0].c_str(), gamePlayerClasses[1].c_str(), mapfile.c_str(), seed);
+                    std::string replay;
+                    TournamentGameResult gameResult = playTournamentGame(mapfile, seed, gamePlayerClasses, gameHouses, maxGameCycle, replay);
+
+                    fprintf(stdout, "%s\n", gameResult.toCSV().c_str());
+                    fflush(stdout);
+
+                    if(gameResult.result == "error") {
+                        numFailed++;
+                        continue;
+                    }
+
+                    gameResults.push_back(gameResult);
+                    replays.push_back(replay);
+                }
+            }
+        }
+    }
+
+    // overall score of every player and the score of every pairing from the view of the first player
+    std::map<std::string, TournamentScore> playerScores;
+    std::map<std::pair<std::string, std::string>, TournamentScore> pairingScores;
+    for(const TournamentGameResult& gameResult : gameResults) {
+        const std::string opponentResult = (gameResult.result == "won") ? "lost" : ((gameResult.result == "lost") ? "won" : gameResult.result);
+        playerScores[gameResult.playerClass[0]].add(gameResult.result, gameResult.gameCycles);
+        playerScores[gameResult.playerClass[1]].add(opponentResult, gameResult.gameCycles);
+        pairingScores[std::make_pair(gameResult.playerClass[0], gameResult.playerClass[1])].add(gameResult.result, gameResult.gameCycles);
+    }
+
+    for(const auto& pairingScore : pairingScores) {
+        fprintf(stdout, "# %s vs. %s: %s\n", pairingScore.first.first.c_str(), pairingScore.first.second.c_str(), pairingScore.second.toString().c_str());
+    }
+    for(const auto& playerScore : playerScores) {
+        fprintf(stdout, "# %s: %s\n", playerScore.first.c_str(), playerScore.second.toString().c_str());
+    }
+
+    // draws and upsets are worth watching
+    int numSavedReplays = 0;
+    for(size_t i = 0; i < gameResults.size(); i++) {
+        const TournamentGameResult& gameResult = gameResults[i];
+        const double firstScore = playerScores[gameResult.playerClass[0]].getScore();
+        const double secondScore = playerScores[gameResult.playerClass[1]].getScore();
+        const bool bUpset = ((gameResult.result == "won") && (firstScore < secondScore)) || ((gameResult.result == "lost") && (firstScore > secondScore));
+        if((gameResult.result != "draw") && !bUpset) {
+            continue;
+        }
+
+        char tmp[FILENAME_MAX];
+        fnkdat(fmt::sprintf("replay/Tournament - %s - %s vs. %s - %u.rpl", gameResult.map, gameResult.playerClass[0], gameResult.playerClass[1], gameResult.seed).c_str(),
+               tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+
+        OFileStream replayStream;
+        if(replayStream.open(tmp)) {
+            replayStream.writeBytes(replays[i].data(), replays[i].size());
+            numSavedReplays++;
+        }
+    }
+
+    fprintf(stdout, "# %d games, %d failed, %d replays saved\n", (int) gameResults.size() + numFailed, numFailed, numSavedReplays);
+    fflush(stdout);
+
+    return (numFailed == 0);
+}
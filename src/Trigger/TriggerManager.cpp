@@ -21,14 +21,24 @@
 
 #include <misc/exceptions.h>
 
+#include <algorithm>
+
 TriggerManager::TriggerManager() = default;
 
 TriggerManager::~TriggerManager() = default;
 
 void TriggerManager::save(OutputStream& stream) const {
-    stream.writeUint32(triggers.size());
-    for(const auto& pTrigger : triggers) {
-        saveTrigger(stream, pTrigger.get());
+    // save in trigger order, so loading adds them in the same order again
+    std::vector<const QueuedTrigger*> sortedTriggers;
+    sortedTriggers.reserve(triggers.size());
+    for(const QueuedTrigger& queuedTrigger : triggers) {
+        sortedTriggers.push_back(&queuedTrigger);
+    }
+    std::sort(sortedTriggers.begin(), sortedTriggers.end(), [](const QueuedTrigger* a, const QueuedTrigger* b) { return isTriggeredLater(*b, *a); });
+
+    stream.writeUint32(sortedTriggers.size());
+    for(const QueuedTrigger* pQueuedTrigger : sortedTriggers) {
+        saveTrigger(stream, pQueuedTrigger->pTrigger.get());
     }
 }
 
@@ -36,29 +46,24 @@ void TriggerManager::load(InputStream& stream) {
     Uint32 numTriggers = stream.readUint32();
 
     for(Uint32 i=0;i<numTriggers;i++) {
-        triggers.push_back(loadTrigger(stream));
+        addTrigger(loadTrigger(stream));
     }
 }
 
 void TriggerManager::trigger(Uint32 CycleNumber)
 {
-    while((triggers.empty() == false) && (triggers.front()->getCycleNumber() == CycleNumber)) {
-        std::unique_ptr<Trigger> pCurrentTrigger = std::move(triggers.front());
-        triggers.pop_front();
+    while((triggers.empty() == false) && (triggers.front().pTrigger->getCycleNumber() == CycleNumber)) {
+        std::pop_heap(triggers.begin(), triggers.end(), isTriggeredLater);
+        std::unique_ptr<Trigger> pCurrentTrigger = std::move(triggers.back().pTrigger);
+        triggers.pop_back();
         pCurrentTrigger->trigger();
     }
 }
 
 void TriggerManager::addTrigger(std::unique_ptr<Trigger> newTrigger)
 {
-    for(auto iter = triggers.begin(); iter != triggers.end(); ++iter) {
-        if((*iter)->getCycleNumber() > newTrigger->getCycleNumber()) {
-            triggers.insert(iter, std::move(newTrigger));
-            return;
-        }
-    }
-
-    triggers.push_back(std::move(newTrigger));
+    triggers.push_back(QueuedTrigger{std::move(newTrigger), nextSequenceNumber++});
+    std::push_heap(triggers.begin(), triggers.end(), isTriggeredLater);
 }
 
 void TriggerManager::saveTrigger(OutputStream& stream, const Trigger* t) const
@@ -0,0 +1,147 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <VisibilityGrid.h>
+
+#include <TilePlanes.h>
+#include <mmath.h>
+
+#include <algorithm>
+
+VisibilityGrid::VisibilityGrid(TilePlanes& tilePlanes) : tilePlanes(tilePlanes) {
+}
+
+void VisibilityGrid::reset(int newSizeX, int newSizeY) {
+    sizeX = newSizeX;
+    sizeY = newSizeY;
+    layout = TileLayout(sizeX, sizeY);
+    sources.clear();
+}
+
+void VisibilityGrid::setSource(Uint32 objectID, int houseID, const Coord& location, int viewRange, Uint32 cycle) {
+    viewRange = std::max(0, viewRange);
+
+    auto iter = sources.find(objectID);
+    if(iter == sources.end()) {
+        addSight(houseID, location, getCircleMask(viewRange), cycle);
+        sources.emplace(objectID, VisionSource{houseID, location, viewRange});
+        return;
+    }
+
+    VisionSource& source = iter->second;
+    if((source.houseID == houseID) && (source.location == location) && (source.viewRange == viewRange)) {
+        return;
+    }
+
+    const Coord step = location - source.location;
+    if((source.houseID == houseID) && (source.viewRange == viewRange) && (std::abs(step.x) <= 1) && (std::abs(step.y) <= 1)) {
+        // add first so that tiles in both ranges never drop to zero
+        const DeltaMask& deltaMask = getDeltaMask(viewRange, step);
+        addSight(houseID, location, deltaMask.entering, cycle);
+        removeSight(houseID, source.location, deltaMask.leaving, cycle);
+    } else {
+        addSight(houseID, location, getCircleMask(viewRange), cycle);
+        removeSight(source.houseID, source.location, getCircleMask(source.viewRange), cycle);
+    }
+
+    source.houseID = houseID;
+    source.location = location;
+    source.viewRange = viewRange;
+}
+
+void VisibilityGrid::removeSource(Uint32 objectID, Uint32 cycle) {
+    auto iter = sources.find(objectID);
+    if(iter == sources.end()) {
+        return;
+    }
+
+    const VisionSource& source = iter->second;
+    removeSight(source.houseID, source.location, getCircleMask(source.viewRange), cycle);
+    sources.erase(iter);
+}
+
+const std::vector<Coord>& VisibilityGrid::getCircleMask(int viewRange) {
+    viewRange = std::max(0, viewRange);
+
+    if(viewRange >= (int) circleMasks.size()) {
+        circleMasks.resize(viewRange + 1);
+    }
+
+    std::vector<Coord>& mask = circleMasks[viewRange];
+    if(mask.empty()) {
+        Coord offset;
+        for(offset.x = -viewRange; offset.x <= viewRange; offset.x++) {
+            for(offset.y = -viewRange; offset.y <= viewRange; offset.y++) {
+                if(isInRange(offset, viewRange)) {
+                    mask.push_back(offset);
+                }
+            }
+        }
+    }
+
+    return mask;
+}
+
+bool VisibilityGrid::isInRange(const Coord& offset, int viewRange) {
+    const Coord center(0, 0);
+    const auto distance = (viewRange <= 1) ? maximumDistance(center, offset) : blockDistanceApprox(center, offset);
+    return distance <= viewRange;
+}
+
+const VisibilityGrid::DeltaMask& VisibilityGrid::getDeltaMask(int viewRange, const Coord& step) {
+    if(viewRange >= (int) deltaMasks.size()) {
+        deltaMasks.resize(viewRange + 1);
+    }
+
+    DeltaMask& deltaMask = deltaMasks[viewRange][getDirectionIndex(step)];
+    if(!deltaMask.bCalculated) {
+        for(const Coord& offset : getCircleMask(viewRange)) {
+            // offset is relative to the new location; seen from the old location it is offset + step
+            if(!isInRange(offset + step, viewRange)) {
+                deltaMask.entering.push_back(offset);
+            }
+
+            // offset is relative to the old location; seen from the new location it is offset - step
+            if(!isInRange(offset - step, viewRange)) {
+                deltaMask.leaving.push_back(offset);
+            }
+        }
+        deltaMask.bCalculated = true;
+    }
+
+    return deltaMask;
+}
+
+template<class OffsetList>
+void VisibilityGrid::addSight(int houseID, const Coord& location, const OffsetList& offsets, Uint32 cycle) {
+    for(const Coord& offset : offsets) {
+        const Coord pos = location + offset;
+        if((pos.x >= 0) && (pos.x < sizeX) && (pos.y >= 0) && (pos.y < sizeY)) {
+            tilePlanes.addSight(layout.getIndex(pos.x, pos.y), houseID, cycle);
+        }
+    }
+}
+
+template<class OffsetList>
+void VisibilityGrid::removeSight(int houseID, const Coord& location, const OffsetList& offsets, Uint32 cycle) {
+    for(const Coord& offset : offsets) {
+        const Coord pos = location + offset;
+        if((pos.x >= 0) && (pos.x < sizeX) && (pos.y >= 0) && (pos.y < sizeY)) {
+            tilePlanes.removeSight(layout.getIndex(pos.x, pos.y), houseID, cycle);
+        }
+    }
+}
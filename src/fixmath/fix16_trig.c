@@ -57,11 +57,11 @@ fix16_t fix16_sin(fix16_t inAngle)
 		tempAngle -= fix16_pi;
 		if(tempAngle >= (fix16_pi >> 1))
 			tempAngle = fix16_pi - tempAngle;
-		tempOut = -(tempAngle >= _fix16_sin_lut_count ? fix16_one : _fix16_sin_lut[tempAngle]);
+		tempOut = -(tempAngle >= _fix16_sin_lut_count ? fix16_one : _fix16_sin_lut_get(tempAngle));
 	} else {
 		if(tempAngle >= (fix16_pi >> 1))
 			tempAngle = fix16_pi - tempAngle;
-		tempOut = (tempAngle >= _fix16_sin_lut_count ? fix16_one : _fix16_sin_lut[tempAngle]);
+		tempOut = (tempAngle >= _fix16_sin_lut_count ? fix16_one : _fix16_sin_lut_get(tempAngle));
 	}
 	#else
 	if(tempAngle > fix16_pi)
@@ -61,7 +61,7 @@ fix32_t fix32_ssub(fix32_t a, fix32_t b)
  * and this is a relatively good compromise for compilers that do not support
  * uint128_t. Uses 32*32->64bit multiplications.
  */
-fix32_t fix32_mul(fix32_t inArg0, fix32_t inArg1)
+fix32_t fix32_mul_portable(fix32_t inArg0, fix32_t inArg1)
 {
 	// Each argument is divided to 32-bit parts.
 	//					AB
@@ -87,33 +87,7 @@ fix32_t fix32_mul(fix32_t inArg0, fix32_t inArg1)
 	if (product_lo < BD)
 		product_hi++;
 
-#ifndef FIXMATH_NO_OVERFLOW
-	// The upper 33 bits should all be the same (the sign).
-	if (product_hi >> 63 != product_hi >> 31)
-		return fix32_overflow;
-#endif
-
-#ifdef FIXMATH_NO_ROUNDING
-	return (product_hi << 32) | (product_lo >> 32);
-#else
-	// Subtracting 0x80000000 (= 0.5) and then using signed right shift
-	// achieves proper rounding to result-1, except in the corner
-	// case of negative numbers and lowest word = 0x80000000.
-	// To handle that, we also have to subtract 1 for negative numbers.
-	uint64_t product_lo_tmp = product_lo;
-	product_lo -= 0x80000000;
-	product_lo -= (uint64_t)product_hi >> 63;
-	if (product_lo > product_lo_tmp)
-		product_hi--;
-
-	// Discard the lowest 32 bits. Note that this is not exactly the same
-	// as dividing by 0x100000000. For example if product = -1, result will
-	// also be -1 and not 0. This is compensated by adding +1 to the result
-	// and compensating this in turn in the rounding above.
-	fix32_t result = (product_hi << 32) | (product_lo >> 32);
-	result += 1;
-	return result;
-#endif
+	return fix32_mul_result(product_hi, product_lo);
 }
 
 
@@ -153,7 +127,7 @@ static uint8_t clz(uint64_t x)
 }
 #endif
 
-fix32_t fix32_div(fix32_t a, fix32_t b)
+fix32_t fix32_div_portable(fix32_t a, fix32_t b)
 {
 	// This uses a hardware 64/64 bit division multiple times, until we have
 	// computed all the bits in (a<<33)/b. Usually this takes 1-3 iterations.
@@ -243,6 +217,68 @@ fix32_t fix32_div(fix32_t a, fix32_t b)
 	return result;
 }
 
+#ifdef FIXMATH_HAVE_INT128
+/* 128-bit implementation of fix32_div. Computes the same quotient as
+ * fix32_div_portable() with one 128/64 bit division instead of the loop.
+ */
+fix32_t fix32_div(fix32_t a, fix32_t b)
+{
+	if (b == 0)
+			return fix32_minimum;
+
+	// The magnitude of fix32_minimum does not fit into fix32_t and the portable
+	// version loses bits for it, so it has to compute this case to stay bit-exact.
+	if (a == fix32_minimum || b == fix32_minimum)
+		return fix32_div_portable(a, b);
+
+	uint64_t remainder = (a >= 0) ? a : (-a);
+	uint64_t divider = (b >= 0) ? b : (-b);
+	uint64_t quotient = 0;
+
+	// The same kick-start as in the portable version. Its truncated remainder
+	// can make the final quotient differ from the exact one by one.
+	if (divider & 0xFFFFFFF000000000ULL)
+	{
+		quotient = remainder / ((divider >> 33) + 1);
+		remainder -= (uint64_t)(((fix32_uint128_t)quotient * divider) >> 33);
+	}
+
+	fix32_uint128_t quotient_rest = ((fix32_uint128_t)remainder << 33) / divider;
+
+	#ifndef FIXMATH_NO_OVERFLOW
+	if (quotient_rest >> 64)
+			return fix32_overflow;
+	#endif
+
+	quotient += (uint64_t)quotient_rest;
+
+	#ifndef FIXMATH_NO_ROUNDING
+	// Quotient is always positive so rounding is easy
+	quotient++;
+	#endif
+
+	fix32_t result = quotient >> 1;
+
+	// Figure out the sign of the result
+	if ((a ^ b) & 0x8000000000000000ULL)
+	{
+		#ifndef FIXMATH_NO_OVERFLOW
+		if (result == fix32_minimum)
+				return fix32_overflow;
+		#endif
+
+		result = -result;
+	}
+
+	return result;
+}
+#else
+fix32_t fix32_div(fix32_t a, fix32_t b)
+{
+	return fix32_div_portable(a, b);
+}
+#endif
+
 #ifndef FIXMATH_NO_OVERFLOW
 /* Wrapper around fix32_div to add saturating arithmetic. */
 fix32_t fix32_sdiv(fix32_t inArg0, fix32_t inArg1)
@@ -1,5 +1,9 @@
 #include <fixmath/fix32.h>
 
+#ifdef FIXMATH_HAVE_INT128
+#include <math.h>
+#endif
+
 /* The square root algorithm is quite directly from
  * http://en.wikipedia.org/wiki/Methods_of_computing_square_roots#Binary_numeral_system_.28base_2.29
  * An important difference is that it is split to two parts
@@ -9,7 +13,7 @@
  * Not sure if someone relies on this behaviour, but not going
  * to break it for now. It doesn't slow the code much overall.
  */
-fix32_t fix32_sqrt(fix32_t inValue)
+fix32_t fix32_sqrt_portable(fix32_t inValue)
 {
 	uint8_t  neg = (inValue < 0);
 	uint64_t num = (neg ? -inValue : inValue);
@@ -82,3 +86,40 @@ fix32_t fix32_sqrt(fix32_t inValue)
 
 	return (neg ? -(fix32_t)result : (fix32_t)result);
 }
+
+#ifdef FIXMATH_HAVE_INT128
+/* The portable version computes the integer square root of inValue << 32
+ * and rounds it to the nearest integer. Here the root is estimated with a
+ * double precision square root and then corrected with exact integer
+ * arithmetic, so the result does not depend on the floating point unit.
+ */
+fix32_t fix32_sqrt(fix32_t inValue)
+{
+	uint8_t  neg = (inValue < 0);
+	uint64_t num = (neg ? -inValue : inValue);
+
+	fix32_uint128_t square = (fix32_uint128_t)num << 32;
+	uint64_t result = (uint64_t)sqrt((double)square);
+
+	// the estimate is off by at most a few units in the last place
+	while ((fix32_uint128_t)result * result > square)
+		result--;
+	while ((fix32_uint128_t)(result + 1) * (result + 1) <= square)
+		result++;
+
+#ifndef FIXMATH_NO_ROUNDING
+	// Round upwards if square >= (result + 0.5)^2
+	if (square - (fix32_uint128_t)result * result > result)
+	{
+		result++;
+	}
+#endif
+
+	return (neg ? -(fix32_t)result : (fix32_t)result);
+}
+#else
+fix32_t fix32_sqrt(fix32_t inValue)
+{
+	return fix32_sqrt_portable(inValue);
+}
+#endif
@@ -15,6 +15,7 @@
  *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <Bullet.h>
 #include <SoundPlayer.h>
 #include <FileClasses/music/MusicPlayer.h>
 
@@ -28,6 +28,7 @@
 #include <FileClasses/TextManager.h>
 #include <FileClasses/INIFile.h>
 #include <FileClasses/Palfile.h>
+#include <FileClasses/LoadSavePNG.h>
 #include <FileClasses/music/DirectoryPlayer.h>
 #include <FileClasses/music/ADLPlayer.h>
 #include <FileClasses/music/XMIPlayer.h>
@@ -36,6 +37,7 @@
 #include <GUI/dune/DuneStyle.h>
 
 #include <Menu/MainMenu.h>
+#include <Menu/OptionsMenu.h>
 
 #include <misc/fnkdat.h>
 #include <misc/FileSystem.h>
@@ -44,8 +46,18 @@
 #include <misc/exceptions.h>
 #include <misc/format.h>
 #include <misc/SDL2pp.h>
+#include <misc/AsyncLog.h>
+#include <misc/Tracing.h>
+#include <misc/ScreenshotWriter.h>
 
 #include <SoundPlayer.h>
+#include <sand.h>
+#include <ReplayVerifier.h>
+#include <Benchmark.h>
+#include <Tournament.h>
+#include <DedicatedHost.h>
+#include <DeterminismCheck.h>
+#include <GameEventBus.h>
 
 #include <mmath.h>
 
@@ -105,7 +117,33 @@ void setVideoMode(int displayIndex);
 void realign_buttons();
 
 static void printUsage() {
-    fprintf(stderr, "Usage:\n\tdunelegacy [--showlog] [--fullscreen|--window] [--PlayerName=X] [--ServerPort=X]\n");
+    fprintf(stderr, "Usage:\n\tdunelegacy [--showlog] [--fullscreen|--window] [--PlayerName=X] [--ServerPort=X] [--BroadcastPort=X] [--MetricsPort=X] [--Trace=FILE] [--EventLog=FILE] [--LogPriority=CATEGORY:PRIORITY]\n");
+    fprintf(stderr, "\tdunelegacy [--showlog] [--fullscreen|--window] --Spectate=HOST[:PORT]\n");
+    fprintf(stderr, "\tdunelegacy [--showlog] --Relay=HOST[:PORT] [--BroadcastPort=X]\n");
+    fprintf(stderr, "\tdunelegacy [--showlog] --HeadlessReplay=FILE [--MaxGameCycles=X]\n");
+    fprintf(stderr, "\tdunelegacy [--showlog] --RenderReplay=FILE (--VideoFile=FILE|--Encoder=COMMAND) [--FramesPerSecond=X] [--VideoSize=WxH] [--MaxGameCycles=X]\n");
+    fprintf(stderr, "\tdunelegacy [--showlog] --VerifyReplays=DIRECTORY [--ReferenceResults=FILE] [--Shard=I/N] [--MaxGameCycles=X]\n");
+    fprintf(stderr, "\tdunelegacy [--showlog] --CheckDeterminism=FILE [--TraceInterval=X] [--Threads=A/B]\n");
+    fprintf(stderr, "\tdunelegacy [--showlog] --CheckSaveGames=FILE [--TraceInterval=X] [--Threads=X]\n");
+    fprintf(stderr, "\tdunelegacy [--showlog] --StateHashTrace=FILE --TraceFile=FILE [--TraceInterval=X] [--TraceRange=A-B] [--Threads=X]\n");
+    fprintf(stderr, "\tdunelegacy [--showlog] --CompareTraces=FILE,FILE\n");
+    fprintf(stderr, "\tdunelegacy [--showlog] --Benchmark=FILE [--MaxGameCycles=X]\n");
+    fprintf(stderr, "\tdunelegacy [--showlog] --Tournament=FILE [--Shard=I/N] [--MaxGameCycles=X]\n");
+    fprintf(stderr, "\tdunelegacy [--showlog] --DedicatedHost=MAPFILE [--LANServer] [--Validate] [--Games=X] [--PlayerName=X] [--ServerPort=X]\n");
+}
+
+/**
+    Splits an address given on the command line into host name and port.
+    \param  address     the address in the form HOST[:PORT]
+    \param  hostname    the host name is returned here
+    \param  port        the port is returned here (DEFAULT_BROADCASTPORT if no port is specified)
+    \return true on success, false if the address is invalid
+*/
+static bool parseBroadcastAddress(const std::string& address, std::string& hostname, int& port) {
+    const size_t colonPos = address.rfind(':');
+    hostname = address.substr(0, colonPos);
+    port = (colonPos == std::string::npos) ? DEFAULT_BROADCASTPORT : atol(address.c_str() + colonPos + 1);
+    return !hostname.empty() && (port > 0) && (port <= 65535);
 }
 
 int getLogicalToPhysicalResolutionFactor(int physicalWidth, int physicalHeight) {
@@ -118,14 +156,12 @@ int getLogicalToPhysicalResolutionFactor(int physicalWidth, int physicalHeight)
     }
 }
 
-void setVideoMode(int displayIndex)
+/**
+    Replaces the physical and logical resolution in the settings by the closest one the display supports.
+    \param  displayIndex    the display to check
+*/
+static void selectClosestDisplayMode(int displayIndex)
 {
-    int videoFlags = 0;
-
-    if(settings.video.fullscreen) {
-        videoFlags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
-    }
-
     SDL_DisplayMode targetDisplayMode = { 0, settings.video.physicalWidth, settings.video.physicalHeight, 0, nullptr};
     SDL_DisplayMode closestDisplayMode;
 
@@ -143,18 +179,63 @@ void setVideoMode(int displayIndex)
         settings.video.height = settings.video.physicalHeight / factor;
 
     }
+}
+
+void setVideoMode(int displayIndex)
+{
+    int videoFlags = 0;
+
+    if(settings.video.fullscreen) {
+        videoFlags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
+    }
+
+    selectClosestDisplayMode(displayIndex);
 
     window = SDL_CreateWindow("Dune Legacy",
                               SDL_WINDOWPOS_CENTERED_DISPLAY(displayIndex), SDL_WINDOWPOS_CENTERED_DISPLAY(displayIndex),
                               settings.video.physicalWidth, settings.video.physicalHeight,
                               videoFlags);
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
+    const Uint32 vsyncFlag = settings.video.vsync ? SDL_RENDERER_PRESENTVSYNC : 0;
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE | vsyncFlag);
+    if(renderer == nullptr) {
+        // e.g. the dummy video driver used in headless mode has no accelerated renderer
+        SDL_Log("Warning: No accelerated renderer available (%s), falling back to software rendering!", SDL_GetError());
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE | SDL_RENDERER_TARGETTEXTURE | vsyncFlag);
+    }
     SDL_RenderSetLogicalSize(renderer, settings.video.width, settings.video.height);
     screenTexture = SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, settings.video.width, settings.video.height);
 
     SDL_ShowCursor(SDL_DISABLE);
 }
 
+void changeVideoMode()
+{
+    const int displayIndex = SDL_GetWindowDisplayIndex(window);
+
+    selectClosestDisplayMode(displayIndex);
+
+    SDL_Log("Changing video mode to %dx%d (%s)...", settings.video.physicalWidth, settings.video.physicalHeight, settings.video.fullscreen ? "fullscreen" : "windowed");
+
+    if(settings.video.fullscreen) {
+        SDL_SetWindowFullscreen(window, SDL_WINDOW_FULLSCREEN_DESKTOP);
+    } else {
+        SDL_SetWindowFullscreen(window, 0);
+        SDL_SetWindowSize(window, settings.video.physicalWidth, settings.video.physicalHeight);
+        SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED_DISPLAY(displayIndex), SDL_WINDOWPOS_CENTERED_DISPLAY(displayIndex));
+    }
+
+    // the renderer and all textures stay valid, only what has the size of the screen is recreated
+    SDL_RenderSetLogicalSize(renderer, settings.video.width, settings.video.height);
+    SDL_DestroyTexture(screenTexture);
+    screenTexture = SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, settings.video.width, settings.video.height);
+
+    pGFXManager->recreateScreenSizeDependentGraphics();
+
+    // we just need to flush all events; otherwise we might get the resize events of the window
+    SDL_PumpEvents();
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+}
+
 void toogleFullscreen()
 {
     if(SDL_GetWindowFlags(window) & SDL_WINDOW_FULLSCREEN_DESKTOP) {
@@ -219,6 +300,9 @@ void createDefaultConfigFile(const std::string& configfilepath, const std::strin
                                 "Language = %s               # en = English, fr = French, de = German\n"
                                 "Scroll Speed = 50           # Amount to scroll the map when the cursor is near the screen border\n"
                                 "Show Tutorial Hints = true  # Show tutorial hints during the game\n"
+                                "Autosave Interval = 5       # Minutes between two autosaves (0 = no autosaves)\n"
+                                "Autosave Slots = 5          # The number of autosaves that are kept\n"
+                                "Pause When Inactive = true  # Pause single player games while the game window is in the background\n"
                                 "\n"
                                 "[Video]\n"
                                 "# Minimum resolution is 640x480\n"
@@ -228,9 +312,13 @@ void createDefaultConfigFile(const std::string& configfilepath, const std::strin
                                 "Physical Height = 480\n"
                                 "Fullscreen = true\n"
                                 "FrameLimit = true           # Limit the frame rate to save energy?\n"
+                                "VSync = false               # Wait for the vertical retrace of the display to avoid tearing\n"
                                 "Preferred Zoom Level = 1    # 0 = no zooming, 1 = 2x, 2 = 3x\n"
                                 "Scaler = ScaleHD            # Scaler to use: ScaleHD = apply manual drawn mask to upscale, Scale2x = smooth edges, ScaleNN = nearest neighbour, \n"
                                 "RotateUnitGraphics = false  # Freely rotate unit graphics, e.g. carryall graphics\n"
+                                "GPU Zoom Scaling = false    # Scale zoomed unit graphics on the graphics card (nearest neighbour, no ScaleHD masks, less memory)\n"
+                                "Screenshot Format = png     # png or qoi (much faster to save but larger files)\n"
+                                "Screenshot Compression = 6  # PNG compression of screenshots: 0 = uncompressed (fastest) to 9 = smallest files\n"
                                 "\n"
                                 "[Audio]\n"
                                 "# There are three different possibilities to play music\n"
@@ -240,6 +328,7 @@ void createDefaultConfigFile(const std::string& configfilepath, const std::strin
                                 "#              The \"music\"-directory should contain 5 subdirectories named attack, intro, peace, win and lose\n"
                                 "#              Put any mp3, ogg or mid file there and it will be played in the particular situation\n"
                                 "Music Type = adl\n"
+                                "Cache Music = false         # adl only: render every track once into the \"music-cache\"-directory and play it from there afterwards\n"
                                 "Play Music = true\n"
                                 "Music Volume = 64           # Volume between 0 and 128\n"
                                 "Play SFX = true\n"
@@ -248,6 +337,9 @@ void createDefaultConfigFile(const std::string& configfilepath, const std::strin
                                 "[Network]\n"
                                 "ServerPort = %d\n"
                                 "MetaServer = %s\n"
+                                "Broadcast Port = 0          # Broadcast multiplayer games to spectators on this port (0 = no broadcast)\n"
+                                "Broadcast Delay = 120       # Spectators see the broadcast games this many seconds late\n"
+                                "Metrics Port = 0            # Serve the metrics of running games as text over HTTP on this port (0 = no metrics)\n"
                                 "\n"
                                 "[AI]\n"
                                 "Campaign AI = qBotMedium\n"
@@ -303,8 +395,7 @@ void logOutputFunction(void *userdata, int category, SDL_LogPriority priority, c
     };
     fprintf(stderr, "%s:   %s\n", priorityStrings[priority], message);
     */
-    fprintf(stderr, "%s\n", message);
-    fflush(stderr);
+    AsyncLog::write(message, priority >= SDL_LOG_PRIORITY_ERROR);
 }
 
 void showMissingFilesMessageBox() {
@@ -373,9 +464,14 @@ int main(int argc, char *argv[]) {
     SDL_LogSetOutputFunction(logOutputFunction, nullptr);
     SDL_LogSetAllPriority(SDL_LOG_PRIORITY_WARN);
     SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_VERBOSE);
+#ifdef DEBUG_AI
+    SDL_LogSetPriority(LOG_CATEGORY_AI, SDL_LOG_PRIORITY_DEBUG);
+#endif
 
     SDL_SetHint(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH, "1");
 
+    int exitCode = EXIT_SUCCESS;
+
     // global try/catch around everything
     try {
 
@@ -385,6 +481,40 @@ int main(int argc, char *argv[]) {
         }
 
         bool bShowDebugLog = false;
+        std::string headlessReplayFilename;
+        Uint32 headlessMaxGameCycles = 0;
+        std::string verifyReplayDirectory;
+        std::string renderReplayFilename;
+        std::string videoFilename;
+        std::string encoderCommand;
+        int videoFramesPerSecond = 30;
+        int videoWidth = 0;
+        int videoHeight = 0;
+        std::string benchmarkFilename;
+        std::string tournamentFilename;
+        std::string traceFilename;
+        std::string eventLogFilename;
+        std::string referenceResultsFilename;
+        int shardIndex = 0;
+        int numShards = 1;
+        std::string spectateHostname;
+        int spectatePort = 0;
+        std::string relayHostname;
+        int relayPort = 0;
+        std::string dedicatedHostMapFilename;
+        bool bDedicatedHostLAN = false;
+        bool bDedicatedHostValidate = false;
+        int dedicatedHostNumGames = 0;
+        std::string determinismReplayFilename;
+        std::string saveGameCheckReplayFilename;
+        std::string traceReplayFilename;
+        std::string stateHashTraceFilename;
+        std::string compareTraceFilenames;
+        Uint32 traceInterval = DETERMINISMCHECK_DEFAULT_INTERVAL;
+        Uint32 traceFirstGameCycle = 0;
+        Uint32 traceLastGameCycle = INVALID_GAMECYCLE;
+        int numWorkerThreadsA = 0;
+        int numWorkerThreadsB = -1;
         for(int i=1; i < argc; i++) {
             //check for overiding params
             std::string parameter(argv[i]);
@@ -392,7 +522,125 @@ int main(int argc, char *argv[]) {
             if(parameter == "--showlog") {
                 // special parameter which does not overwrite settings
                 bShowDebugLog = true;
-            } else if((parameter == "-f") || (parameter == "--fullscreen") || (parameter == "-w") || (parameter == "--window") || (parameter.compare(0, 13, "--PlayerName=") == 0) || (parameter.compare(0, 13, "--ServerPort=") == 0)) {
+            } else if(parameter.compare(0, 17, "--HeadlessReplay=") == 0) {
+                // special parameter for only simulating a replay without window, input and sound
+                headlessReplayFilename = parameter.substr(strlen("--HeadlessReplay="));
+            } else if(parameter.compare(0, 16, "--MaxGameCycles=") == 0) {
+                headlessMaxGameCycles = atol(argv[i] + strlen("--MaxGameCycles="));
+            } else if(parameter.compare(0, 15, "--RenderReplay=") == 0) {
+                // special parameter for rendering a replay into a video faster than real time without window and sound
+                renderReplayFilename = parameter.substr(strlen("--RenderReplay="));
+            } else if(parameter.compare(0, 12, "--VideoFile=") == 0) {
+                videoFilename = parameter.substr(strlen("--VideoFile="));
+            } else if(parameter.compare(0, 10, "--Encoder=") == 0) {
+                encoderCommand = parameter.substr(strlen("--Encoder="));
+            } else if(parameter.compare(0, 18, "--FramesPerSecond=") == 0) {
+                videoFramesPerSecond = atol(argv[i] + strlen("--FramesPerSecond="));
+                if(videoFramesPerSecond <= 0) {
+                    printUsage();
+                    exit(EXIT_FAILURE);
+                }
+            } else if(parameter.compare(0, 12, "--VideoSize=") == 0) {
+                if((sscanf(argv[i] + strlen("--VideoSize="), "%dx%d", &videoWidth, &videoHeight) != 2) || (videoWidth < 640) || (videoHeight < 480)) {
+                    printUsage();
+                    exit(EXIT_FAILURE);
+                }
+            } else if(parameter.compare(0, 16, "--VerifyReplays=") == 0) {
+                // special parameter for simulating all replays in a directory and checking their outcome
+                verifyReplayDirectory = parameter.substr(strlen("--VerifyReplays="));
+            } else if(parameter.compare(0, 19, "--CheckDeterminism=") == 0) {
+                // special parameter for simulating a replay serial and parallel and finding the first game cycle they differ
+                determinismReplayFilename = parameter.substr(strlen("--CheckDeterminism="));
+            } else if(parameter.compare(0, 17, "--CheckSaveGames=") == 0) {
+                // special parameter for continuing a replay from its keyframes and comparing it with the uninterrupted replay
+                saveGameCheckReplayFilename = parameter.substr(strlen("--CheckSaveGames="));
+            } else if(parameter.compare(0, 17, "--StateHashTrace=") == 0) {
+                // special parameter for recording the state hashes of a replay to compare them with the ones of another build
+                traceReplayFilename = parameter.substr(strlen("--StateHashTrace="));
+            } else if(parameter.compare(0, 12, "--TraceFile=") == 0) {
+                stateHashTraceFilename = parameter.substr(strlen("--TraceFile="));
+            } else if(parameter.compare(0, 16, "--CompareTraces=") == 0) {
+                compareTraceFilenames = parameter.substr(strlen("--CompareTraces="));
+                if(compareTraceFilenames.find(',') == std::string::npos) {
+                    printUsage();
+                    exit(EXIT_FAILURE);
+                }
+            } else if(parameter.compare(0, 16, "--TraceInterval=") == 0) {
+                traceInterval = atol(argv[i] + strlen("--TraceInterval="));
+                if(traceInterval == 0) {
+                    printUsage();
+                    exit(EXIT_FAILURE);
+                }
+            } else if(parameter.compare(0, 13, "--TraceRange=") == 0) {
+                if((sscanf(argv[i] + strlen("--TraceRange="), "%u-%u", &traceFirstGameCycle, &traceLastGameCycle) != 2) || (traceFirstGameCycle > traceLastGameCycle)) {
+                    printUsage();
+                    exit(EXIT_FAILURE);
+                }
+            } else if(parameter.compare(0, 10, "--Threads=") == 0) {
+                // either the worker threads of both runs of --CheckDeterminism or the ones of --StateHashTrace and --CheckSaveGames
+                const int numValues = sscanf(argv[i] + strlen("--Threads="), "%d/%d", &numWorkerThreadsA, &numWorkerThreadsB);
+                if((numValues < 1) || (numWorkerThreadsA < 0) || ((numValues == 2) && (numWorkerThreadsB < 0))) {
+                    printUsage();
+                    exit(EXIT_FAILURE);
+                }
+                if(numValues == 1) {
+                    numWorkerThreadsB = numWorkerThreadsA;
+                }
+            } else if(parameter.compare(0, 12, "--Benchmark=") == 0) {
+                // special parameter for simulating a seeded benchmark scenario and measuring its performance
+                benchmarkFilename = parameter.substr(strlen("--Benchmark="));
+            } else if(parameter.compare(0, 13, "--Tournament=") == 0) {
+                // special parameter for playing a round robin tournament between AI players
+                tournamentFilename = parameter.substr(strlen("--Tournament="));
+            } else if(parameter.compare(0, 19, "--ReferenceResults=") == 0) {
+                referenceResultsFilename = parameter.substr(strlen("--ReferenceResults="));
+            } else if(parameter.compare(0, 8, "--Trace=") == 0) {
+                // special parameter for recording a trace from startup until exit
+                traceFilename = parameter.substr(strlen("--Trace="));
+            } else if(parameter.compare(0, 11, "--EventLog=") == 0) {
+                // special parameter for writing the events of all games (see GameEventBus) to a csv file
+                eventLogFilename = parameter.substr(strlen("--EventLog="));
+            } else if(parameter.compare(0, 14, "--LogPriority=") == 0) {
+                // special parameter for changing which messages of a log category are logged (e.g. --LogPriority=ai:debug)
+                const std::string value = parameter.substr(strlen("--LogPriority="));
+                const size_t colonPos = value.find(':');
+                int category = 0;
+                SDL_LogPriority priority = SDL_LOG_PRIORITY_WARN;
+                if((colonPos == std::string::npos) || !AsyncLog::parseCategory(value.substr(0, colonPos), category)
+                    || !AsyncLog::parsePriority(value.substr(colonPos + 1), priority)) {
+                    printUsage();
+                    exit(EXIT_FAILURE);
+                }
+                SDL_LogSetPriority(category, priority);
+            } else if(parameter.compare(0, 8, "--Shard=") == 0) {
+                // shards are numbered from 1 to N on the command line
+                if((sscanf(argv[i] + strlen("--Shard="), "%d/%d", &shardIndex, &numShards) != 2) || (numShards < 1) || (shardIndex < 1) || (shardIndex > numShards)) {
+                    printUsage();
+                    exit(EXIT_FAILURE);
+                }
+                shardIndex--;
+            } else if(parameter.compare(0, 11, "--Spectate=") == 0) {
+                // special parameter for watching a broadcast game instead of showing the main menu first
+                if(!parseBroadcastAddress(parameter.substr(strlen("--Spectate=")), spectateHostname, spectatePort)) {
+                    printUsage();
+                    exit(EXIT_FAILURE);
+                }
+            } else if(parameter.compare(0, 8, "--Relay=") == 0) {
+                // special parameter for passing a broadcast game on to further spectators without window, input and sound
+                if(!parseBroadcastAddress(parameter.substr(strlen("--Relay=")), relayHostname, relayPort)) {
+                    printUsage();
+                    exit(EXIT_FAILURE);
+                }
+            } else if(parameter.compare(0, 16, "--DedicatedHost=") == 0) {
+                // special parameter for hosting multiplayer games without playing them and without window, input and sound
+                dedicatedHostMapFilename = parameter.substr(strlen("--DedicatedHost="));
+            } else if(parameter == "--LANServer") {
+                bDedicatedHostLAN = true;
+            } else if(parameter == "--Validate") {
+                bDedicatedHostValidate = true;
+            } else if(parameter.compare(0, 8, "--Games=") == 0) {
+                dedicatedHostNumGames = atol(argv[i] + strlen("--Games="));
+            } else if((parameter == "-f") || (parameter == "--fullscreen") || (parameter == "-w") || (parameter == "--window") || (parameter.compare(0, 13, "--PlayerName=") == 0) || (parameter.compare(0, 13, "--ServerPort=") == 0) || (parameter.compare(0, 16, "--BroadcastPort=") == 0) || (parameter.compare(0, 14, "--MetricsPort=") == 0)) {
                 // normal parameter for overwriting settings
                 // handle later
             } else {
@@ -401,6 +649,31 @@ int main(int argc, char *argv[]) {
             }
         }
 
+        if((!traceReplayFilename.empty() && stateHashTraceFilename.empty())
+            || (!renderReplayFilename.empty() && videoFilename.empty() && encoderCommand.empty())) {
+            printUsage();
+            exit(EXIT_FAILURE);
+        }
+
+        const bool bHeadless = !headlessReplayFilename.empty() || !renderReplayFilename.empty() || !verifyReplayDirectory.empty() || !determinismReplayFilename.empty()
+                                || !saveGameCheckReplayFilename.empty() || !traceReplayFilename.empty() || !compareTraceFilenames.empty() || !benchmarkFilename.empty() || !tournamentFilename.empty() || !relayHostname.empty() || !dedicatedHostMapFilename.empty();
+
+        TRACE_THREAD_NAME("Main");
+        if(!traceFilename.empty()) {
+#ifdef TRACING
+            Tracing::start();
+#else
+            fprintf(stderr, "Warning: --Trace is ignored as Dune Legacy was compiled without tracing support!\n");
+#endif
+        }
+
+        if(!eventLogFilename.empty()) {
+            auto pEventSink = std::make_unique<GameEventFileSink>(eventLogFilename);
+            if(pEventSink->isOpen()) {
+                GameEventBus::attach(std::move(pEventSink));
+            }
+        }
+
         if(bShowDebugLog == false) {
             // get utf8-encoded log file path
             std::string logfilePath = getLogFilepath();
@@ -456,6 +729,9 @@ int main(int argc, char *argv[]) {
             #endif
         }
 
+        // from now on the log is written by a background thread
+        AsyncLog::start();
+
         SDL_Log("Starting Dune Legacy %s on %s", VERSION, SDL_GetPlatform());
 
         // First check for missing files
@@ -504,16 +780,24 @@ int main(int argc, char *argv[]) {
             settings.general.language = myINIFile.getStringValue("General","Language","en");
             settings.general.scrollSpeed = myINIFile.getIntValue("General","Scroll Speed",50);
             settings.general.showTutorialHints = myINIFile.getBoolValue("General","Show Tutorial Hints",true);
+            settings.general.autosaveInterval = myINIFile.getIntValue("General","Autosave Interval",5);
+            settings.general.autosaveSlots = myINIFile.getIntValue("General","Autosave Slots",5);
+            settings.general.pauseWhenInactive = myINIFile.getBoolValue("General","Pause When Inactive",true);
             settings.video.width = myINIFile.getIntValue("Video","Width",640);
             settings.video.height = myINIFile.getIntValue("Video","Height",480);
             settings.video.physicalWidth= myINIFile.getIntValue("Video","Physical Width",640);
             settings.video.physicalHeight = myINIFile.getIntValue("Video","Physical Height",480);
             settings.video.fullscreen = myINIFile.getBoolValue("Video","Fullscreen",false);
             settings.video.frameLimit = myINIFile.getBoolValue("Video","FrameLimit",true);
+            settings.video.vsync = myINIFile.getBoolValue("Video","VSync",false);
             settings.video.preferredZoomLevel = myINIFile.getIntValue("Video","Preferred Zoom Level", 0);
             settings.video.scaler = myINIFile.getStringValue("Video","Scaler","ScaleHD");
             settings.video.rotateUnitGraphics = myINIFile.getBoolValue("Video","RotateUnitGraphics",false);
+            settings.video.gpuZoomScaling = myINIFile.getBoolValue("Video","GPU Zoom Scaling",false);
+            settings.video.screenshotFormat = myINIFile.getStringValue("Video","Screenshot Format","png");
+            settings.video.screenshotCompression = myINIFile.getIntValue("Video","Screenshot Compression",PNG_DEFAULT_COMPRESSION);
             settings.audio.musicType = myINIFile.getStringValue("Audio","Music Type","adl");
+            settings.audio.cacheMusic = myINIFile.getBoolValue("Audio","Cache Music", false);
             settings.audio.playMusic = myINIFile.getBoolValue("Audio","Play Music", true);
             settings.audio.musicVolume = myINIFile.getIntValue("Audio","Music Volume", 64);
             settings.audio.playSFX = myINIFile.getBoolValue("Audio","Play SFX", true);
@@ -522,6 +806,9 @@ int main(int argc, char *argv[]) {
             settings.network.serverPort = myINIFile.getIntValue("Network","ServerPort",DEFAULT_PORT);
             settings.network.metaServer = myINIFile.getStringValue("Network","MetaServer",DEFAULT_METASERVER);
             settings.network.debugNetwork = myINIFile.getBoolValue("Network","Debug Network",false);
+            settings.network.broadcastPort = myINIFile.getIntValue("Network","Broadcast Port",0);
+            settings.network.broadcastDelay = myINIFile.getIntValue("Network","Broadcast Delay",DEFAULT_BROADCASTDELAY);
+            settings.network.metricsPort = myINIFile.getIntValue("Network","Metrics Port",0);
 
             settings.ai.campaignAI = myINIFile.getStringValue("AI","Campaign AI",DEFAULTAIPLAYERCLASS);
 
@@ -572,12 +859,28 @@ int main(int argc, char *argv[]) {
                     settings.general.playerName = parameter.substr(strlen("--PlayerName="));
                 } else if(parameter.compare(0, 13, "--ServerPort=") == 0) {
                     settings.network.serverPort = atol(argv[i] + strlen("--ServerPort="));
+                } else if(parameter.compare(0, 16, "--BroadcastPort=") == 0) {
+                    settings.network.broadcastPort = atol(argv[i] + strlen("--BroadcastPort="));
+                } else if(parameter.compare(0, 14, "--MetricsPort=") == 0) {
+                    settings.network.metricsPort = atol(argv[i] + strlen("--MetricsPort="));
                 }
             }
 
+            if(bHeadless) {
+                settings.video.fullscreen = false;
+                settings.audio.playSFX = false;
+                settings.audio.playMusic = false;
+            }
+
             if(bFirstInit == true) {
                 SDL_Log("Initializing SDL...");
 
+                if(bHeadless) {
+                    // neither a real window nor a sound device is needed
+                    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+                    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+                }
+
                 if(SDL_Init(SDL_INIT_TIMER | SDL_INIT_VIDEO) < 0) {
                     THROW(sdl_error, "Couldn't initialize SDL: %s!", SDL_GetError());
                 }
@@ -641,10 +944,20 @@ int main(int argc, char *argv[]) {
 
             SDL_Log("Setting video mode...");
             setVideoMode(currentDisplayIndex);
+            if(videoWidth > 0) {
+                // the dummy video driver only offers its own display mode, but a rendered video is drawn into screenTexture anyway
+                settings.video.width = videoWidth;
+                settings.video.height = videoHeight;
+                SDL_RenderSetLogicalSize(renderer, videoWidth, videoHeight);
+                SDL_DestroyTexture(screenTexture);
+                screenTexture = SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, videoWidth, videoHeight);
+            }
             SDL_RendererInfo rendererInfo;
             SDL_GetRendererInfo(renderer, &rendererInfo);
             SDL_Log("Renderer: %s (max texture size: %dx%d)", rendererInfo.name, rendererInfo.max_texture_width, rendererInfo.max_texture_height);
 
+            pScreenshotWriter = std::make_unique<ScreenshotWriter>(ScreenshotWriter::getFormatByName(settings.video.screenshotFormat), settings.video.screenshotCompression);
+
 
             SDL_Log("Loading fonts...");
             pFontManager = std::make_unique<FontManager>();
@@ -652,19 +965,19 @@ int main(int argc, char *argv[]) {
             SDL_Log("Loading graphics and sounds...");
 
 #ifdef HAS_ASYNC
-            auto gfxManagerFut = std::async(std::launch::async, []() { return std::make_unique<GFXManager>(); } );
-            auto sfxManagerFut = std::async(std::launch::async, []() { return std::make_unique<SFXManager>(); } );
-
-            pGFXManager = gfxManagerFut.get();
-            pSFXManager = sfxManagerFut.get();
-#else
-            // g++ does not provide std::launch::async on all platforms
-            pGFXManager = std::make_unique<GFXManager>();
-            pSFXManager = std::make_unique<SFXManager>();
+            auto gfxManagerFut = std::async(std::launch::async, []() {
+                TRACE_THREAD_NAME("GFXManager loader");
+                TRACE_ZONE("Load GFXManager");
+                return std::make_unique<GFXManager>();
+            } );
+            auto sfxManagerFut = std::async(std::launch::async, []() {
+                TRACE_THREAD_NAME("SFXManager loader");
+                TRACE_ZONE("Load SFXManager");
+                return std::make_unique<SFXManager>();
+            } );
 #endif
 
-            GUIStyle::setGUIStyle(std::make_unique<DuneStyle>());
-
+            // the players only need the mixer, so they are started while graphics and sounds are still loading
             if(bFirstInit == true) {
                 SDL_Log("Starting sound player...");
                 soundPlayer = std::make_unique<SoundPlayer>();
@@ -685,17 +998,94 @@ int main(int argc, char *argv[]) {
                 //musicPlayer->changeMusic(MUSIC_INTRO);
             }
 
+#ifdef HAS_ASYNC
+            pGFXManager = gfxManagerFut.get();
+            pSFXManager = sfxManagerFut.get();
+#else
+            // g++ does not provide std::launch::async on all platforms
+            pGFXManager = std::make_unique<GFXManager>();
+            pSFXManager = std::make_unique<SFXManager>();
+#endif
+
+            GUIStyle::setGUIStyle(std::make_unique<DuneStyle>());
+
+            if(!headlessReplayFilename.empty()) {
+                const bool bFinished = runHeadlessReplay(headlessReplayFilename, headlessMaxGameCycles);
+                exitCode = bFinished ? EXIT_SUCCESS : EXIT_FAILURE;
+                bExitGame = true;
+            } else if(!renderReplayFilename.empty()) {
+                const bool bRendered = renderReplayVideo(renderReplayFilename, videoFilename, encoderCommand, videoFramesPerSecond, headlessMaxGameCycles);
+                exitCode = bRendered ? EXIT_SUCCESS : EXIT_FAILURE;
+                bExitGame = true;
+            } else if(!verifyReplayDirectory.empty()) {
+                const bool bVerified = verifyReplays(verifyReplayDirectory, referenceResultsFilename, shardIndex, numShards, headlessMaxGameCycles);
+                exitCode = bVerified ? EXIT_SUCCESS : EXIT_FAILURE;
+                bExitGame = true;
+            } else if(!determinismReplayFilename.empty()) {
+                const bool bDeterministic = checkDeterminism(determinismReplayFilename, traceInterval, numWorkerThreadsA, numWorkerThreadsB);
+                exitCode = bDeterministic ? EXIT_SUCCESS : EXIT_FAILURE;
+                bExitGame = true;
+            } else if(!saveGameCheckReplayFilename.empty()) {
+                const bool bDeterministic = checkSaveGameDeterminism(saveGameCheckReplayFilename, traceInterval, numWorkerThreadsA);
+                exitCode = bDeterministic ? EXIT_SUCCESS : EXIT_FAILURE;
+                bExitGame = true;
+            } else if(!traceReplayFilename.empty()) {
+                const bool bRecorded = recordStateHashTrace(traceReplayFilename, stateHashTraceFilename, traceInterval, traceFirstGameCycle, traceLastGameCycle, numWorkerThreadsA);
+                exitCode = bRecorded ? EXIT_SUCCESS : EXIT_FAILURE;
+                bExitGame = true;
+            } else if(!compareTraceFilenames.empty()) {
+                const size_t commaPos = compareTraceFilenames.find(',');
+                const bool bIdentical = compareStateHashTraces(compareTraceFilenames.substr(0, commaPos), compareTraceFilenames.substr(commaPos + 1));
+                exitCode = bIdentical ? EXIT_SUCCESS : EXIT_FAILURE;
+                bExitGame = true;
+            } else if(!benchmarkFilename.empty()) {
+                SDL_Log("Running benchmark scenario '%s'...", benchmarkFilename.c_str());
+                const BenchmarkResult benchmarkResult = runBenchmark(benchmarkFilename, headlessMaxGameCycles);
+                fprintf(stdout, "%s\n%s\n", BenchmarkResult::getCSVHeader(), benchmarkResult.toCSV().c_str());
+                fflush(stdout);
+                exitCode = EXIT_SUCCESS;
+                bExitGame = true;
+            } else if(!tournamentFilename.empty()) {
+                SDL_Log("Running tournament '%s'...", tournamentFilename.c_str());
+                const bool bPlayed = runTournament(tournamentFilename, shardIndex, numShards, headlessMaxGameCycles);
+                exitCode = bPlayed ? EXIT_SUCCESS : EXIT_FAILURE;
+                bExitGame = true;
+            } else if(!relayHostname.empty()) {
+                const int broadcastPort = (settings.network.broadcastPort != 0) ? settings.network.broadcastPort : DEFAULT_BROADCASTPORT;
+                const bool bReceived = runBroadcastRelay(relayHostname, relayPort, broadcastPort);
+                exitCode = bReceived ? EXIT_SUCCESS : EXIT_FAILURE;
+                bExitGame = true;
+            } else if(!dedicatedHostMapFilename.empty()) {
+                SDL_Log("Running dedicated host for '%s'...", dedicatedHostMapFilename.c_str());
+                const bool bAllPlayed = runDedicatedHost(dedicatedHostMapFilename, bDedicatedHostLAN, bDedicatedHostValidate, dedicatedHostNumGames);
+                exitCode = bAllPlayed ? EXIT_SUCCESS : EXIT_FAILURE;
+                bExitGame = true;
+            }
+
             // Playing intro
-            if(((bFirstGamestart == true) || (settings.general.playIntro == true)) && (bFirstInit==true)) {
+            if(!bHeadless && ((bFirstGamestart == true) || (settings.general.playIntro == true)) && (bFirstInit==true)) {
                 SDL_Log("Playing intro...");
                 Intro().run();
             }
 
             bFirstInit = false;
 
-            SDL_Log("Starting main menu...");
-            { // Scope
-                if (MainMenu().showMenu() == MENU_QUIT_DEFAULT) {
+            if((bExitGame == false) && !spectateHostname.empty()) {
+                startSpectator(spectateHostname, spectatePort);
+
+                // only spectate once and continue with the main menu afterwards
+                spectateHostname.clear();
+            }
+
+            if(bExitGame == false) {
+                SDL_Log("Starting main menu...");
+                int menuResult;
+                do {
+                    // after a video mode change the menus are laid out anew for the new screen size
+                    menuResult = MainMenu().showMenu();
+                } while(menuResult == MENU_QUIT_VIDEOMODECHANGED);
+
+                if(menuResult == MENU_QUIT_DEFAULT) {
                     bExitGame = true;
                 }
             }
@@ -715,6 +1105,7 @@ int main(int argc, char *argv[]) {
                 currentDisplayIndex = SDL_GetWindowDisplayIndex(window);
             }
 
+            pScreenshotWriter.reset();
             pTextManager.reset();
             pSFXManager.reset();
             pGFXManager.reset();
@@ -732,6 +1123,14 @@ int main(int argc, char *argv[]) {
             SDL_Log("Deinitialization finished!");
         } while(bExitGame == false);
 
+#ifdef TRACING
+        if(!traceFilename.empty()) {
+            Tracing::stopAndSave(traceFilename);
+        }
+#endif
+
+        GameEventBus::detach();
+
         // deinit fnkdat
         if(fnkdat(nullptr, nullptr, 0, FNKDAT_UNINIT) < 0) {
             THROW(std::runtime_error, "Cannot uninitialize fnkdat!");
@@ -743,5 +1142,5 @@ int main(int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
-    return EXIT_SUCCESS;
+    return exitCode;
 }
@@ -0,0 +1,146 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <misc/AllocationCounter.h>
+
+namespace {
+    thread_local MemoryTag currentTag = MemoryTag_Other;    ///< the memory tag of the current thread
+}
+
+MemoryTag AllocationCounter::setCurrentTag(MemoryTag tag) {
+    const MemoryTag previousTag = currentTag;
+    currentTag = tag;
+    return previousTag;
+}
+
+const char* AllocationCounter::getTagName(MemoryTag tag) {
+    switch(tag) {
+        case MemoryTag_Other:       return "Other";
+        case MemoryTag_Graphics:    return "Graphics";
+        case MemoryTag_Sound:       return "Sound";
+        case MemoryTag_Map:         return "Map";
+        case MemoryTag_Objects:     return "Objects";
+        case MemoryTag_AI:          return "AI";
+        default:                    return "Unknown";
+    }
+}
+
+#ifdef PROFILING
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    thread_local Uint32 numAllocations = 0;     ///< the allocations of the current thread
+
+    std::atomic<Uint64> allocatedBytes[NUM_MEMORYTAGS];    ///< the bytes currently allocated per tag (by all threads)
+
+    /// stored in front of every allocation
+    struct AllocationHeader {
+        std::size_t size;       ///< the requested size
+        MemoryTag   tag;        ///< the tag the allocation is accounted to
+    };
+
+    /// the header size rounded up, so that the returned memory keeps the alignment of malloc()
+    const std::size_t headerSize = ((sizeof(AllocationHeader) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t)) * alignof(std::max_align_t);
+}
+
+void* operator new(std::size_t size) {
+    numAllocations++;
+
+    void* p = std::malloc(headerSize + size);
+    if(p == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    AllocationHeader* pHeader = static_cast<AllocationHeader*>(p);
+    pHeader->size = size;
+    pHeader->tag = currentTag;
+    allocatedBytes[currentTag].fetch_add(size, std::memory_order_relaxed);
+
+    return static_cast<char*>(p) + headerSize;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+// all variants need the header, so the nothrow ones are replaced as well
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return operator new(size);
+    } catch(std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void* p) noexcept {
+    if(p == nullptr) {
+        return;
+    }
+
+    AllocationHeader* pHeader = reinterpret_cast<AllocationHeader*>(static_cast<char*>(p) - headerSize);
+    allocatedBytes[pHeader->tag].fetch_sub(pHeader->size, std::memory_order_relaxed);
+    std::free(pHeader);
+}
+
+void operator delete[](void* p) noexcept {
+    operator delete(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    operator delete(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    operator delete(p);
+}
+
+Uint32 AllocationCounter::getNumAllocations() {
+    return numAllocations;
+}
+
+Uint64 AllocationCounter::getAllocatedBytes(MemoryTag tag) {
+    return allocatedBytes[tag].load(std::memory_order_relaxed);
+}
+
+#else
+
+Uint32 AllocationCounter::getNumAllocations() {
+    return 0;
+}
+
+Uint64 AllocationCounter::getAllocatedBytes(MemoryTag) {
+    return 0;
+}
+
+#endif
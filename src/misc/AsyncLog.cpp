@@ -0,0 +1,190 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <misc/AsyncLog.h>
+
+#include <misc/string_util.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    SDL_mutex* mutex = nullptr;             ///< guards pending, numDropped and bRunning
+    SDL_mutex* writeMutex = nullptr;        ///< held while writing out, so messages are written in the order they were queued
+    SDL_cond* wakeupCondition = nullptr;    ///< wakes the writer thread before ASYNCLOG_FLUSH_INTERVAL has passed
+    SDL_Thread* pThread = nullptr;          ///< the writer thread
+
+    std::string pending;                    ///< the queued messages separated by newlines
+    std::string writing;                    ///< the messages currently written (only accessed with writeMutex held)
+    Uint32 numDropped = 0;                  ///< the number of messages dropped since the last write
+    bool bRunning = false;                  ///< is the writer thread running?
+
+    /// Writes out all queued messages
+    void writeOut() {
+        SDL_LockMutex(writeMutex);
+
+        SDL_LockMutex(mutex);
+        writing.swap(pending);
+        const Uint32 dropped = numDropped;
+        numDropped = 0;
+        SDL_UnlockMutex(mutex);
+
+        if(!writing.empty()) {
+            fwrite(writing.data(), 1, writing.size(), stderr);
+            writing.clear();
+        }
+        if(dropped > 0) {
+            fprintf(stderr, "AsyncLog: %u messages were dropped!\n", dropped);
+        }
+        fflush(stderr);
+
+        SDL_UnlockMutex(writeMutex);
+    }
+}
+
+void AsyncLog::start() {
+    if(mutex != nullptr) {
+        return;
+    }
+
+    mutex = SDL_CreateMutex();
+    writeMutex = SDL_CreateMutex();
+    wakeupCondition = SDL_CreateCond();
+    if((mutex == nullptr) || (writeMutex == nullptr) || (wakeupCondition == nullptr)) {
+        fprintf(stderr, "AsyncLog: Unable to create mutexes: %s\n", SDL_GetError());
+        return;
+    }
+
+    pending.reserve(ASYNCLOG_MAX_PENDING);
+    writing.reserve(ASYNCLOG_MAX_PENDING);
+
+    bRunning = true;
+    pThread = SDL_CreateThread(writerThreadMain, "AsyncLog", nullptr);
+    if(pThread == nullptr) {
+        fprintf(stderr, "AsyncLog: Unable to create writer thread: %s\n", SDL_GetError());
+        bRunning = false;
+        return;
+    }
+
+    atexit(stop);
+}
+
+void AsyncLog::write(const char* message, bool bFlush) {
+    if(mutex == nullptr) {
+        fprintf(stderr, "%s\n", message);
+        fflush(stderr);
+        return;
+    }
+
+    const size_t length = strlen(message);
+
+    SDL_LockMutex(mutex);
+    if(!bRunning) {
+        SDL_UnlockMutex(mutex);
+
+        SDL_LockMutex(writeMutex);
+        fprintf(stderr, "%s\n", message);
+        fflush(stderr);
+        SDL_UnlockMutex(writeMutex);
+        return;
+    }
+
+    if(pending.size() + length + 1 > ASYNCLOG_MAX_PENDING) {
+        numDropped++;
+    } else {
+        pending.append(message, length);
+        pending += '\n';
+    }
+    const bool bHalfFull = (pending.size() > ASYNCLOG_MAX_PENDING/2);
+    SDL_UnlockMutex(mutex);
+
+    if(bFlush) {
+        writeOut();
+    } else if(bHalfFull) {
+        SDL_CondSignal(wakeupCondition);
+    }
+}
+
+void AsyncLog::flush() {
+    if(mutex != nullptr) {
+        writeOut();
+    }
+}
+
+bool AsyncLog::parsePriority(const std::string& name, SDL_LogPriority& priority) {
+    static const char* const priorityNames[] = { "verbose", "debug", "info", "warn", "error", "critical" };
+
+    const std::string lowerName = strToLower(name);
+    for(int i = 0; i < static_cast<int>(sizeof(priorityNames)/sizeof(priorityNames[0])); i++) {
+        if(lowerName == priorityNames[i]) {
+            priority = static_cast<SDL_LogPriority>(SDL_LOG_PRIORITY_VERBOSE + i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AsyncLog::parseCategory(const std::string& name, int& category) {
+    static const char* const categoryNames[] = { "application", "error", "assert", "system", "audio", "video", "render", "input" };
+
+    const std::string lowerName = strToLower(name);
+    if(lowerName == "ai") {
+        category = LOG_CATEGORY_AI;
+        return true;
+    }
+
+    for(int i = 0; i < static_cast<int>(sizeof(categoryNames)/sizeof(categoryNames[0])); i++) {
+        if(lowerName == categoryNames[i]) {
+            category = SDL_LOG_CATEGORY_APPLICATION + i;
+            return true;
+        }
+    }
+    return false;
+}
+
+void AsyncLog::stop() {
+    SDL_LockMutex(mutex);
+    bRunning = false;
+    SDL_UnlockMutex(mutex);
+    SDL_CondSignal(wakeupCondition);
+
+    SDL_WaitThread(pThread, nullptr);
+    pThread = nullptr;
+
+    writeOut();
+}
+
+int AsyncLog::writerThreadMain(void* data) {
+    while(true) {
+        SDL_LockMutex(mutex);
+        if(bRunning) {
+            SDL_CondWaitTimeout(wakeupCondition, mutex, ASYNCLOG_FLUSH_INTERVAL);
+        }
+        const bool bQuit = !bRunning;
+        SDL_UnlockMutex(mutex);
+
+        writeOut();
+
+        if(bQuit) {
+            break;
+        }
+    }
+
+    return 0;
+}
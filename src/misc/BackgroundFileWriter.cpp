@@ -0,0 +1,164 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/BackgroundFileWriter.h>
+
+#include <misc/OMemoryStream.h>
+#include <misc/OFileStream.h>
+#include <misc/OCompressedStream.h>
+#include <misc/exceptions.h>
+
+#include <cstdio>
+
+BackgroundFileWriter::BackgroundFileWriter() {
+    mutex = SDL_CreateMutex();
+    availableJobsSemaphore = SDL_CreateSemaphore(0);
+    idleCondition = SDL_CreateCond();
+    if((mutex == nullptr) || (availableJobsSemaphore == nullptr) || (idleCondition == nullptr)) {
+        THROW(std::runtime_error, "BackgroundFileWriter::BackgroundFileWriter(): Unable to create semaphores: %s", SDL_GetError());
+    }
+
+    pThread = SDL_CreateThread(writerThreadMain, "BackgroundFileWriter", (void*) this);
+    if(pThread == nullptr) {
+        SDL_Log("BackgroundFileWriter: Unable to create writer thread: %s", SDL_GetError());
+    }
+}
+
+BackgroundFileWriter::~BackgroundFileWriter() {
+    if(pThread != nullptr) {
+        SDL_LockMutex(mutex);
+        jobs.push_back(Job{ "", nullptr, nullptr });
+        SDL_UnlockMutex(mutex);
+        SDL_SemPost(availableJobsSemaphore);
+
+        SDL_WaitThread(pThread, nullptr);
+    }
+
+    SDL_DestroyCond(idleCondition);
+    SDL_DestroySemaphore(availableJobsSemaphore);
+    SDL_DestroyMutex(mutex);
+}
+
+void BackgroundFileWriter::writeFile(const std::string& filename, std::unique_ptr<OMemoryStream> pData) {
+    queueJob(Job{ filename, std::move(pData), nullptr });
+}
+
+void BackgroundFileWriter::writeFile(const std::string& filename, std::function<std::unique_ptr<OMemoryStream>()> createData) {
+    queueJob(Job{ filename, nullptr, std::move(createData) });
+}
+
+void BackgroundFileWriter::queueJob(Job&& job) {
+    if(pThread == nullptr) {
+        // no thread => write it directly
+        if(write(job) == false) {
+            SDL_LockMutex(mutex);
+            failedFiles.push_back(job.filename);
+            SDL_UnlockMutex(mutex);
+        }
+        return;
+    }
+
+    SDL_LockMutex(mutex);
+    jobs.push_back(std::move(job));
+    numPendingJobs++;
+    SDL_UnlockMutex(mutex);
+
+    SDL_SemPost(availableJobsSemaphore);
+}
+
+void BackgroundFileWriter::waitUntilIdle() {
+    SDL_LockMutex(mutex);
+    while(numPendingJobs > 0) {
+        SDL_CondWait(idleCondition, mutex);
+    }
+    SDL_UnlockMutex(mutex);
+}
+
+std::vector<std::string> BackgroundFileWriter::getFailedFiles() {
+    SDL_LockMutex(mutex);
+    std::vector<std::string> result;
+    result.swap(failedFiles);
+    SDL_UnlockMutex(mutex);
+    return result;
+}
+
+int BackgroundFileWriter::writerThreadMain(void* data) {
+    BackgroundFileWriter* pWriter = static_cast<BackgroundFileWriter*>(data);
+
+    while(true) {
+        while(SDL_SemWait(pWriter->availableJobsSemaphore) != 0) {
+            ;   // try again in case of error
+        }
+
+        SDL_LockMutex(pWriter->mutex);
+        Job job = std::move(pWriter->jobs.front());
+        pWriter->jobs.pop_front();
+        SDL_UnlockMutex(pWriter->mutex);
+
+        if((job.pData == nullptr) && !job.createData) {
+            return 0;
+        }
+
+        const bool bSuccess = write(job);
+
+        SDL_LockMutex(pWriter->mutex);
+        if(bSuccess == false) {
+            pWriter->failedFiles.push_back(job.filename);
+        }
+        pWriter->numPendingJobs--;
+        if(pWriter->numPendingJobs == 0) {
+            SDL_CondBroadcast(pWriter->idleCondition);
+        }
+        SDL_UnlockMutex(pWriter->mutex);
+    }
+}
+
+bool BackgroundFileWriter::write(Job& job) {
+    const std::string tmpFilename = job.filename + ".tmp";
+
+    try {
+        if(job.pData == nullptr) {
+            job.pData = job.createData();
+        }
+
+        OFileStream fs;
+        if(fs.open(tmpFilename) == false) {
+            SDL_Log("BackgroundFileWriter: Cannot open '%s'", tmpFilename.c_str());
+            return false;
+        }
+
+        OCompressedStream compressedStream(fs);
+        compressedStream.writeBytes(job.pData->getData(), job.pData->getDataLength());
+        compressedStream.close();
+
+        fs.close();
+    } catch (std::exception& e) {
+        SDL_Log("BackgroundFileWriter: Cannot write '%s': %s", tmpFilename.c_str(), e.what());
+        std::remove(tmpFilename.c_str());
+        return false;
+    }
+
+    // rename() does not replace an existing file on all platforms
+    std::remove(job.filename.c_str());
+    if(std::rename(tmpFilename.c_str(), job.filename.c_str()) != 0) {
+        SDL_Log("BackgroundFileWriter: Cannot rename '%s' to '%s'", tmpFilename.c_str(), job.filename.c_str());
+        std::remove(tmpFilename.c_str());
+        return false;
+    }
+
+    return true;
+}
@@ -22,7 +22,9 @@
 
 #include <stdio.h>
 #include <algorithm>
+#include <map>
 #include <ctype.h>
+#include <time.h>
 
 #include <SDL2/SDL_filesystem.h>
 
@@ -85,10 +87,36 @@ static bool cmp_Size_Dsc(const FileInfo& a, const FileInfo& b) { return a.size >
 static bool cmp_ModifyDate_Asc(const FileInfo& a, const FileInfo& b) { return a.modifydate < b.modifydate; }
 static bool cmp_ModifyDate_Dsc(const FileInfo& a, const FileInfo& b) { return a.modifydate > b.modifydate; }
 
-std::list<FileInfo> getFileList(const std::string& directory, const std::string& extension, bool bIgnoreCase, FileListOrder fileListOrder)
+static bool hasExtension(const std::string& filename, const std::string& lowerExtension, bool bIgnoreCase) {
+    if(lowerExtension.empty()) {
+        return true;
+    }
+
+    if(filename.length() < lowerExtension.length()+1) {
+        return false;
+    }
+
+    if(filename[filename.length() - lowerExtension.length() - 1] != '.') {
+        return false;
+    }
+
+    std::string ext = filename.substr(filename.length() - lowerExtension.length());
+
+    if(bIgnoreCase == true) {
+        convertToLower(ext);
+    }
+
+    return (ext == lowerExtension);
+}
+
+/**
+    Reads all files (but no directories) in directory.
+    \param  directory   the directory name
+    \return all files in directory
+*/
+static std::list<FileInfo> readDirectory(const std::string& directory)
 {
     std::list<FileInfo> Files;
-    std::string lowerExtension= bIgnoreCase ? strToLower(extension) : extension;
 
 #ifdef _WIN32
     // on win32 we need an ansi-encoded filepath
@@ -96,12 +124,12 @@ std::list<FileInfo> getFileList(const std::string& directory, const std::string&
     char szPath[MAX_PATH];
 
     if(MultiByteToWideChar(CP_UTF8, 0, directory.c_str(), -1, szwPath, MAX_PATH) == 0) {
-        SDL_Log("getFileList(): Conversion of search path from utf-8 to utf-16 failed!");
+        SDL_Log("readDirectory(): Conversion of search path from utf-8 to utf-16 failed!");
         return Files;
     }
 
     if(WideCharToMultiByte(CP_ACP, 0, szwPath, -1, szPath, MAX_PATH, nullptr, nullptr) == 0) {
-        SDL_Log("getFileList(): Conversion of search path from utf-16 to ansi failed!");
+        SDL_Log("readDirectory(): Conversion of search path from utf-16 to ansi failed!");
         return Files;
     }
 
@@ -115,37 +143,25 @@ std::list<FileInfo> getFileList(const std::string& directory, const std::string&
         do {
             std::string filename = fdata.name;
 
-            if(filename.length() < lowerExtension.length()+1) {
+            if(fdata.attrib & _A_SUBDIR) {
                 continue;
             }
 
-            if(filename[filename.length() - lowerExtension.length() - 1] != '.') {
+            // on win32 we get an ansi-encoded filename
+            WCHAR szwFilename[MAX_PATH];
+            char szFilename[MAX_PATH];
+
+            if(MultiByteToWideChar(CP_ACP, 0, filename.c_str(), -1, szwFilename, MAX_PATH) == 0) {
+                SDL_Log("readDirectory(): Conversion of filename from ansi to utf-16 failed!");
                 continue;
             }
 
-            std::string ext = filename.substr(filename.length() - lowerExtension.length());
-
-            if(bIgnoreCase == true) {
-                convertToLower(ext);
+            if(WideCharToMultiByte(CP_UTF8, 0, szwFilename, -1, szFilename, MAX_PATH, nullptr, nullptr) == 0) {
+                SDL_Log("readDirectory(): Conversion of search path from utf-16 to utf-8 failed!");
+                continue;
             }
 
-            if(ext == lowerExtension) {
-                // on win32 we get an ansi-encoded filename
-                WCHAR szwFilename[MAX_PATH];
-                char szFilename[MAX_PATH];
-
-                if(MultiByteToWideChar(CP_ACP, 0, filename.c_str(), -1, szwFilename, MAX_PATH) == 0) {
-                    SDL_Log("getFileList(): Conversion of filename from ansi to utf-16 failed!");
-                    continue;
-                }
-
-                if(WideCharToMultiByte(CP_UTF8, 0, szwFilename, -1, szFilename, MAX_PATH, nullptr, nullptr) == 0) {
-                    SDL_Log("getFileList(): Conversion of search path from utf-16 to utf-8 failed!");
-                    continue;
-                }
-
-                Files.emplace_back(szFilename, fdata.size, fdata.time_write);
-            }
+            Files.emplace_back(szFilename, fdata.size, fdata.time_write);
         } while(_findnext(hFile, &fdata) == 0);
 
         _findclose(hFile);
@@ -164,29 +180,16 @@ std::list<FileInfo> getFileList(const std::string& directory, const std::string&
     while((curEntry = readdir(dir)) != nullptr) {
             std::string filename = curEntry->d_name;
 
-            if(filename.length() < lowerExtension.length()+1) {
+            std::string fullpath = directory + "/" + filename;
+            struct stat fdata;
+            if(stat(fullpath.c_str(), &fdata) != 0) {
+                SDL_Log("stat(): %s", strerror(errno));
                 continue;
             }
-
-            if(filename[filename.length() - lowerExtension.length() - 1] != '.') {
+            if(S_ISDIR(fdata.st_mode)) {
                 continue;
             }
-
-            std::string ext = filename.substr(filename.length() - lowerExtension.length());
-
-            if(bIgnoreCase == true) {
-                convertToLower(ext);
-            }
-
-            if(ext == lowerExtension) {
-                std::string fullpath = directory + "/" + filename;
-                struct stat fdata;
-                if(stat(fullpath.c_str(), &fdata) != 0) {
-                    SDL_Log("stat(): %s", strerror(errno));
-                    continue;
-                }
-                Files.push_back(FileInfo(filename, fdata.st_size, fdata.st_mtime));
-            }
+            Files.push_back(FileInfo(filename, fdata.st_size, fdata.st_mtime));
     }
 
     if(errno != 0) {
@@ -197,6 +200,98 @@ std::list<FileInfo> getFileList(const std::string& directory, const std::string&
 
 #endif
 
+
+    return Files;
+}
+
+#ifndef _WIN32
+
+namespace {
+
+/// A listing of a directory as it was when the directory had the modification time modifydate
+struct CachedDirectoryListing {
+    uint64_t modifydate;
+    std::list<FileInfo> files;
+};
+
+SDL_mutex* getFileListCacheMutex() {
+    static SDL_mutex* mutex = SDL_CreateMutex();
+    return mutex;
+}
+
+std::map<std::string, CachedDirectoryListing>& getFileListCache() {
+    static std::map<std::string, CachedDirectoryListing> fileListCache;
+    return fileListCache;
+}
+
+}
+
+/**
+    Returns all files in directory. The listing is cached and only read again if the modification time of the
+    directory has changed, i.e. files were added, removed or renamed. Files rewritten in place do not change the
+    directory, therefore OFileStream and INIFile call invalidateFileListCache() after writing.
+    \param  directory   the directory name
+    \return all files in directory
+*/
+static std::list<FileInfo> readDirectoryCached(const std::string& directory)
+{
+    struct stat dirdata;
+    if(stat(directory.c_str(), &dirdata) != 0) {
+        return readDirectory(directory);
+    }
+
+    // the modification time has a resolution of one second => changes within the current second might be missed
+    if(static_cast<time_t>(dirdata.st_mtime + FILELISTCACHE_MINAGE) > time(nullptr)) {
+        return readDirectory(directory);
+    }
+
+    SDL_LockMutex(getFileListCacheMutex());
+    auto& fileListCache = getFileListCache();
+    auto iter = fileListCache.find(directory);
+    if((iter != fileListCache.end()) && (iter->second.modifydate == static_cast<uint64_t>(dirdata.st_mtime))) {
+        std::list<FileInfo> files = iter->second.files;
+        SDL_UnlockMutex(getFileListCacheMutex());
+        return files;
+    }
+    SDL_UnlockMutex(getFileListCacheMutex());
+
+    std::list<FileInfo> files = readDirectory(directory);
+
+    SDL_LockMutex(getFileListCacheMutex());
+    getFileListCache()[directory] = CachedDirectoryListing{ static_cast<uint64_t>(dirdata.st_mtime), files };
+    SDL_UnlockMutex(getFileListCacheMutex());
+
+    return files;
+}
+
+#endif
+
+void invalidateFileListCache()
+{
+#ifndef _WIN32
+    SDL_LockMutex(getFileListCacheMutex());
+    getFileListCache().clear();
+    SDL_UnlockMutex(getFileListCacheMutex());
+#endif
+}
+
+std::list<FileInfo> getFileList(const std::string& directory, const std::string& extension, bool bIgnoreCase, FileListOrder fileListOrder)
+{
+    std::list<FileInfo> Files;
+    std::string lowerExtension= bIgnoreCase ? strToLower(extension) : extension;
+
+#ifdef _WIN32
+    std::list<FileInfo> allFiles = readDirectory(directory);
+#else
+    std::list<FileInfo> allFiles = readDirectoryCached(directory);
+#endif
+
+    for(FileInfo& fileInfo : allFiles) {
+        if(hasExtension(fileInfo.name, lowerExtension, bIgnoreCase)) {
+            Files.push_back(std::move(fileInfo));
+        }
+    }
+
     switch(fileListOrder) {
         case FileListOrder_Name_Asc: {
             Files.sort(cmp_Name_Asc);
@@ -0,0 +1,58 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <misc/FrameArena.h>
+
+#include <cstdarg>
+#include <cstdio>
+
+std::string& FrameArena::allocateString() {
+    if(numUsedStrings == strings.size()) {
+        strings.emplace_back();
+    }
+
+    std::string& str = strings[numUsedStrings++];
+    str.clear();
+    return str;
+}
+
+const std::string& FrameArena::sprintf(const char* fmt, ...) {
+    std::string& str = allocateString();
+
+    // first try to format into the capacity the string already has
+    str.resize(str.capacity());
+
+    va_list args;
+    va_start(args, fmt);
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    const int length = vsnprintf(&str[0], str.size() + 1, fmt, args);
+    va_end(args);
+
+    if(length < 0) {
+        str.clear();
+    } else if(static_cast<size_t>(length) > str.size()) {
+        str.resize(length);
+        vsnprintf(&str[0], str.size() + 1, fmt, argsCopy);
+    } else {
+        str.resize(length);
+    }
+    va_end(argsCopy);
+
+    return str;
+}
@@ -0,0 +1,79 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <misc/FramePacer.h>
+
+#include <globals.h>
+
+#include <algorithm>
+
+static bool isEventPending() {
+    SDL_PumpEvents();
+    return SDL_HasEvents(SDL_FIRSTEVENT, SDL_LASTEVENT) == SDL_TRUE;
+}
+
+FramePacer::FramePacer(Uint32 frameTime) : counterFrequency(SDL_GetPerformanceFrequency()) {
+    setFrameTime(frameTime);
+
+    SDL_RendererInfo rendererInfo;
+    if((renderer != nullptr) && (SDL_GetRendererInfo(renderer, &rendererInfo) == 0) && (rendererInfo.flags & SDL_RENDERER_PRESENTVSYNC)) {
+        SDL_DisplayMode displayMode;
+        int refreshRate = 60;
+        if((window != nullptr) && (SDL_GetWindowDisplayMode(window, &displayMode) == 0) && (displayMode.refresh_rate > 0)) {
+            refreshRate = displayMode.refresh_rate;
+        }
+        vsyncMargin = counterFrequency / (2 * refreshRate);
+    }
+}
+
+void FramePacer::setFrameTime(Uint32 frameTime) {
+    frameDuration = counterFrequency * frameTime / 1000;
+}
+
+bool FramePacer::wait(bool bWakeOnEvent) {
+    const Uint64 now = SDL_GetPerformanceCounter();
+
+    Uint64 deadline = lastDeadline + frameDuration;
+    if((lastDeadline == 0) || (now >= deadline) || (deadline - now > frameDuration)) {
+        // first frame, the frame took too long or the frame time was reduced; start a new cadence from now
+        lastDeadline = now;
+        return bWakeOnEvent && isEventPending();
+    }
+    lastDeadline = deadline;
+
+    const Uint64 wakeupTime = deadline - std::min(vsyncMargin, deadline - now);
+    Uint64 current = now;
+    while(current < wakeupTime) {
+        const Uint32 remainingMs = static_cast<Uint32>((wakeupTime - current) * 1000 / counterFrequency);
+        if(remainingMs >= 2) {
+            // SDL_Delay() and SDL_WaitEventTimeout() may oversleep by up to a millisecond
+            if(bWakeOnEvent) {
+                if(SDL_WaitEventTimeout(nullptr, remainingMs - 1) == 1) {
+                    return true;
+                }
+            } else {
+                SDL_Delay(remainingMs - 1);
+            }
+        } else if(bWakeOnEvent && isEventPending()) {
+            return true;
+        }
+        current = SDL_GetPerformanceCounter();
+    }
+
+    return false;
+}
@@ -0,0 +1,195 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/ICompressedStream.h>
+
+#include <misc/OCompressedStream.h>
+#include <misc/IFileStream.h>
+#include <misc/IMemoryStream.h>
+#include <misc/exceptions.h>
+
+#include <enet/enet.h>
+
+#include <SDL2/SDL_endian.h>
+
+#include <algorithm>
+#include <string.h>
+
+ICompressedStream::ICompressedStream(InputStream& stream)
+ : stream(stream) {
+    pRangeCoder = enet_range_coder_create();
+    if(pRangeCoder == nullptr) {
+        THROW(InputStream::error, "ICompressedStream::ICompressedStream(): Creating range coder failed!");
+    }
+}
+
+ICompressedStream::ICompressedStream(std::unique_ptr<InputStream> pStream)
+ : pOwnedStream(std::move(pStream)), stream(*pOwnedStream) {
+    pRangeCoder = enet_range_coder_create();
+    if(pRangeCoder == nullptr) {
+        THROW(InputStream::error, "ICompressedStream::ICompressedStream(): Creating range coder failed!");
+    }
+}
+
+ICompressedStream::~ICompressedStream() {
+    enet_range_coder_destroy(pRangeCoder);
+}
+
+std::unique_ptr<InputStream> ICompressedStream::openFile(const std::string& filename) {
+    auto pFileStream = std::make_unique<IFileStream>();
+    if(pFileStream->open(filename) == false) {
+        return nullptr;
+    }
+
+    try {
+        if(pFileStream->readUint32() == COMPRESSEDSTREAM_MAGIC) {
+            return std::make_unique<ICompressedStream>(std::move(pFileStream));
+        }
+    } catch (InputStream::exception&) {
+        // too short for being compressed
+    }
+
+    // read it again from the beginning
+    pFileStream->close();
+    if(pFileStream->open(filename) == false) {
+        return nullptr;
+    }
+
+    return std::move(pFileStream);
+}
+
+std::string ICompressedStream::decompress(const std::string& data) {
+    IMemoryStream memStream(data.data(), data.size());
+
+    try {
+        if(memStream.readUint32() != COMPRESSEDSTREAM_MAGIC) {
+            return data;
+        }
+    } catch (InputStream::exception&) {
+        return data;
+    }
+
+    ICompressedStream compressedStream(memStream);
+
+    std::string result;
+    while(true) {
+        try {
+            compressedStream.readBlock();
+        } catch (InputStream::eof&) {
+            return result;
+        }
+
+        result += compressedStream.block;
+        compressedStream.blockPos = compressedStream.block.size();
+    }
+}
+
+std::string ICompressedStream::readString() {
+    Uint32 length = readUint32();
+
+    std::string str(length, '\0');
+    if(length > 0) {
+        readBytes(&str[0], length);
+    }
+    return str;
+}
+
+Uint8 ICompressedStream::readUint8() {
+    Uint8 tmp;
+    readBytes(&tmp, sizeof(Uint8));
+    return tmp;
+}
+
+Uint16 ICompressedStream::readUint16() {
+    Uint16 tmp;
+    readBytes(&tmp, sizeof(Uint16));
+    return SDL_SwapLE16(tmp);
+}
+
+Uint32 ICompressedStream::readUint32() {
+    Uint32 tmp;
+    readBytes(&tmp, sizeof(Uint32));
+    return SDL_SwapLE32(tmp);
+}
+
+Uint64 ICompressedStream::readUint64() {
+    Uint64 tmp;
+    readBytes(&tmp, sizeof(Uint64));
+    return SDL_SwapLE64(tmp);
+}
+
+bool ICompressedStream::readBool() {
+    return (readUint8() == 1 ? true : false);
+}
+
+float ICompressedStream::readFloat() {
+    Uint32 tmp = readUint32();
+    float tmp2;
+    memcpy(&tmp2,&tmp,sizeof(Uint32)); // workaround for a strange optimization in gcc 4.1
+    return tmp2;
+}
+
+void ICompressedStream::readBytes(void* data, size_t length) {
+    char* pData = static_cast<char*>(data);
+
+    while(length > 0) {
+        if(blockPos == block.size()) {
+            readBlock();
+        }
+
+        const size_t n = std::min(length, block.size() - blockPos);
+        memcpy(pData, block.data() + blockPos, n);
+        blockPos += n;
+        pData += n;
+        length -= n;
+    }
+}
+
+/**
+    Reads and decompresses the next block. Throws InputStream::eof at the end of the stream.
+*/
+void ICompressedStream::readBlock() {
+    if(bEndReached) {
+        THROW(InputStream::eof, "ICompressedStream::readBlock(): End-of-File reached!");
+    }
+
+    const Uint32 blockSize = stream.readUint32();
+    if(blockSize == 0) {
+        bEndReached = true;
+        THROW(InputStream::eof, "ICompressedStream::readBlock(): End-of-File reached!");
+    }
+
+    if(blockSize > COMPRESSEDSTREAM_BLOCKSIZE) {
+        THROW(InputStream::error, "ICompressedStream::readBlock(): Invalid block size %d!", blockSize);
+    }
+
+    std::string compressedBlock = stream.readString();
+    blockPos = 0;
+
+    if(compressedBlock.size() == blockSize) {
+        // stored uncompressed
+        block.swap(compressedBlock);
+        return;
+    }
+
+    block.resize(blockSize);
+    const size_t decompressedSize = enet_range_coder_decompress(pRangeCoder, (const enet_uint8*) compressedBlock.data(), compressedBlock.size(), (enet_uint8*) &block[0], blockSize);
+    if(decompressedSize != blockSize) {
+        block.clear();
+        THROW(InputStream::error, "ICompressedStream::readBlock(): Decompressing block failed!");
+    }
+}
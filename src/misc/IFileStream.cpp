@@ -21,6 +21,8 @@
 
 #include <SDL2/SDL_endian.h>
 
+#include <algorithm>
+
 #ifdef _WIN32
     #include <windows.h>
 #endif
@@ -61,9 +63,13 @@ bool IFileStream::open(const char* filename)
 
     #endif
 
+    bufferPos = 0;
+    bufferFill = 0;
+
     if( (fp = fopen(pFilename,"rb")) == nullptr) {
         return false;
     } else {
+        buffer.resize(IFILESTREAM_BUFFERSIZE);
         return true;
     }
 }
@@ -79,85 +85,47 @@ void IFileStream::close()
         fclose(fp);
         fp = nullptr;
     }
+
+    bufferPos = 0;
+    bufferFill = 0;
 }
 
 std::string IFileStream::readString()
 {
-    Uint32 length;
-
-    length = readUint32();
-
-    if(length == 0) {
-        return "";
-    } else {
-        std::string str;
+    Uint32 length = readUint32();
 
-        str.resize(length);
-
-        if(fread(&str[0],length,1,fp) != 1) {
-            if(feof(fp) != 0) {
-                THROW(InputStream::eof, "IFileStream::readString(): End-of-File reached!");
-            } else {
-                THROW(InputStream::error, "IFileStream::readString(): An I/O-Error occurred!");
-            }
-        }
-
-        return str;
+    std::string str(length, '\0');
+    if(length > 0) {
+        readBytes(&str[0], length);
     }
+    return str;
 }
 
 Uint8 IFileStream::readUint8()
 {
     Uint8 tmp;
-    if(fread(&tmp,sizeof(Uint8),1,fp) != 1) {
-        if(feof(fp) != 0) {
-            THROW(InputStream::eof, "IFileStream::readUint8(): End-of-File reached!");
-        } else {
-            THROW(InputStream::error, "IFileStream::readUint8(): An I/O-Error occurred!");
-        }
-    }
-
+    readBytes(&tmp, sizeof(Uint8));
     return tmp;
 }
 
 Uint16 IFileStream::readUint16()
 {
     Uint16 tmp;
-    if(fread(&tmp,sizeof(Uint16),1,fp) != 1) {
-        if(feof(fp) != 0) {
-            THROW(InputStream::eof, "IFileStream::readUint16(): End-of-File reached!");
-        } else {
-            THROW(InputStream::error, "IFileStream::readUint16(): An I/O-Error occurred!");
-        }
-    }
-
+    readBytes(&tmp, sizeof(Uint16));
     return SDL_SwapLE16(tmp);
 }
 
 Uint32 IFileStream::readUint32()
 {
     Uint32 tmp;
-    if(fread(&tmp,sizeof(Uint32),1,fp) != 1) {
-        if(feof(fp) != 0) {
-            THROW(InputStream::eof, "IFileStream::readUint32(): End-of-File reached!");
-        } else {
-            THROW(InputStream::error, "IFileStream::readUint32(): An I/O-Error occurred!");
-        }
-    }
-
+    readBytes(&tmp, sizeof(Uint32));
     return SDL_SwapLE32(tmp);
 }
 
 Uint64 IFileStream::readUint64()
 {
     Uint64 tmp;
-    if(fread(&tmp,sizeof(Uint64),1,fp) != 1) {
-        if(feof(fp) != 0) {
-            THROW(InputStream::eof, "IFileStream::readUint64(): End-of-File reached!");
-        } else {
-            THROW(InputStream::error, "IFileStream::readUint64(): An I/O-Error occurred!");
-        }
-    }
+    readBytes(&tmp, sizeof(Uint64));
     return SDL_SwapLE64(tmp);
 }
 
@@ -173,3 +141,40 @@ float IFileStream::readFloat()
     memcpy(&tmp2,&tmp,sizeof(Uint32)); // workaround for a strange optimization in gcc 4.1
     return tmp2;
 }
+
+void IFileStream::readBytes(void* data, size_t length)
+{
+    char* pData = static_cast<char*>(data);
+
+    while(length > 0) {
+        if(bufferPos == bufferFill) {
+            if(length >= buffer.size()) {
+                // big reads bypass the buffer
+                if(fread(pData,length,1,fp) != 1) {
+                    break;
+                }
+                return;
+            }
+
+            bufferPos = 0;
+            bufferFill = fread(buffer.data(),1,buffer.size(),fp);
+            if(bufferFill == 0) {
+                break;
+            }
+        }
+
+        const size_t n = std::min(length, bufferFill - bufferPos);
+        memcpy(pData, buffer.data() + bufferPos, n);
+        bufferPos += n;
+        pData += n;
+        length -= n;
+    }
+
+    if(length > 0) {
+        if(feof(fp) != 0) {
+            THROW(InputStream::eof, "IFileStream::readBytes(): End-of-File reached!");
+        } else {
+            THROW(InputStream::error, "IFileStream::readBytes(): An I/O-Error occurred!");
+        }
+    }
+}
@@ -0,0 +1,146 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/OCompressedStream.h>
+
+#include <misc/exceptions.h>
+
+#include <enet/enet.h>
+
+#include <SDL2/SDL_endian.h>
+
+#include <algorithm>
+#include <string.h>
+
+OCompressedStream::OCompressedStream(OutputStream& stream)
+ : stream(stream) {
+    pRangeCoder = enet_range_coder_create();
+    if(pRangeCoder == nullptr) {
+        THROW(OutputStream::error, "OCompressedStream::OCompressedStream(): Creating range coder failed!");
+    }
+
+    block.reserve(COMPRESSEDSTREAM_BLOCKSIZE);
+    compressedBlock.resize(COMPRESSEDSTREAM_BLOCKSIZE);
+
+    stream.writeUint32(COMPRESSEDSTREAM_MAGIC);
+}
+
+OCompressedStream::~OCompressedStream() {
+    try {
+        close();
+    } catch (std::exception& e) {
+        SDL_Log("OCompressedStream::~OCompressedStream(): %s", e.what());
+    }
+
+    enet_range_coder_destroy(pRangeCoder);
+}
+
+void OCompressedStream::close() {
+    if(bClosed) {
+        return;
+    }
+
+    bClosed = true;
+
+    if(!block.empty()) {
+        writeBlock();
+    }
+    stream.writeUint32(0);
+    stream.flush();
+}
+
+void OCompressedStream::writeBytes(const void* data, size_t length) {
+    if(bClosed) {
+        THROW(OutputStream::error, "OCompressedStream::writeBytes(): Stream is already closed!");
+    }
+
+    const char* pData = static_cast<const char*>(data);
+
+    while(length > 0) {
+        const size_t n = std::min(length, (size_t) COMPRESSEDSTREAM_BLOCKSIZE - block.size());
+        block.append(pData, n);
+        pData += n;
+        length -= n;
+
+        if(block.size() == COMPRESSEDSTREAM_BLOCKSIZE) {
+            writeBlock();
+        }
+    }
+}
+
+void OCompressedStream::flush() {
+    if(!bClosed && !block.empty()) {
+        writeBlock();
+    }
+    stream.flush();
+}
+
+void OCompressedStream::writeString(const std::string& str) {
+    writeUint32(str.length());
+    writeBytes(str.data(), str.length());
+}
+
+void OCompressedStream::writeUint8(Uint8 x) {
+    writeBytes(&x, sizeof(Uint8));
+}
+
+void OCompressedStream::writeUint16(Uint16 x) {
+    x = SDL_SwapLE16(x);
+    writeBytes(&x, sizeof(Uint16));
+}
+
+void OCompressedStream::writeUint32(Uint32 x) {
+    x = SDL_SwapLE32(x);
+    writeBytes(&x, sizeof(Uint32));
+}
+
+void OCompressedStream::writeUint64(Uint64 x) {
+    x = SDL_SwapLE64(x);
+    writeBytes(&x, sizeof(Uint64));
+}
+
+void OCompressedStream::writeBool(bool x) {
+    writeUint8(x == true ? 1 : 0);
+}
+
+void OCompressedStream::writeFloat(float x) {
+    if(sizeof(float) != sizeof(Uint32)) {
+        THROW(OutputStream::error, "OCompressedStream::writeFloat(): sizeof(float) != sizeof(Uint32). Cannot save floats on such systems.");
+    }
+    Uint32 tmp;
+    memcpy(&tmp,&x,sizeof(Uint32)); // workaround for a strange optimization in gcc 4.1
+    writeUint32(tmp);
+}
+
+void OCompressedStream::writeBlock() {
+    ENetBuffer inBuffer;
+    inBuffer.data = (void*) block.data();
+    inBuffer.dataLength = block.size();
+
+    // the compressed block must be smaller, otherwise it cannot be told apart from a stored block
+    const size_t compressedSize = enet_range_coder_compress(pRangeCoder, &inBuffer, 1, block.size(), compressedBlock.data(), block.size() - 1);
+
+    stream.writeUint32(block.size());
+    if(compressedSize == 0) {
+        // does not compress => store it as it is
+        stream.writeString(block);
+    } else {
+        stream.writeString(std::string((const char*) compressedBlock.data(), compressedSize));
+    }
+
+    block.clear();
+}
@@ -18,6 +18,7 @@
 #include <misc/OFileStream.h>
 
 #include <misc/exceptions.h>
+#include <misc/FileSystem.h>
 
 #include <SDL2/SDL_endian.h>
 
@@ -38,6 +39,7 @@ OFileStream::~OFileStream()
 bool OFileStream::open(const char* filename)
 {
     if(fp != nullptr) {
+        stopFlushThread();
         fclose(fp);
     }
 
@@ -61,9 +63,12 @@ bool OFileStream::open(const char* filename)
 
     #endif
 
+    buffer.clear();
+
     if( (fp = fopen(pFilename,"wb")) == nullptr) {
         return false;
     } else {
+        buffer.reserve(OFILESTREAM_BUFFERSIZE);
         return true;
     }
 }
@@ -76,13 +81,52 @@ bool OFileStream::open(const std::string& filename)
 void OFileStream::close()
 {
     if(fp != nullptr) {
+        if((flushBuffer() == false) || (waitForPendingWrite() == false)) {
+            SDL_Log("OFileStream::close(): An I/O-Error occurred!");
+        }
+        stopFlushThread();
         fclose(fp);
         fp = nullptr;
+
+        invalidateFileListCache();
+    }
+}
+
+void OFileStream::setAsyncFlush(bool bAsyncFlush) {
+    if(!bAsyncFlush) {
+        if(waitForPendingWrite() == false) {
+            SDL_Log("OFileStream::setAsyncFlush(): An I/O-Error occurred!");
+        }
+        stopFlushThread();
+        return;
+    }
+
+    if((fp == nullptr) || (pFlushThread != nullptr)) {
+        return;
+    }
+
+    flushMutex = SDL_CreateMutex();
+    flushCondition = SDL_CreateCond();
+    bPendingWrite = false;
+    bQuitFlushThread = false;
+    bAsyncWriteError = false;
+
+    pFlushThread = SDL_CreateThread(flushThreadMain, "OFileStream", (void*) this);
+    if(pFlushThread == nullptr) {
+        // we just keep on writing synchronously
+        SDL_Log("OFileStream::setAsyncFlush(): Cannot create thread: %s", SDL_GetError());
+        SDL_DestroyCond(flushCondition);
+        flushCondition = nullptr;
+        SDL_DestroyMutex(flushMutex);
+        flushMutex = nullptr;
     }
 }
 
 void OFileStream::flush() {
     if(fp != nullptr) {
+        if((flushBuffer() == false) || (waitForPendingWrite() == false)) {
+            THROW(OutputStream::error, "OFileStream::flush(): An I/O-Error occurred!");
+        }
         fflush(fp);
     }
 }
@@ -90,45 +134,30 @@ void OFileStream::flush() {
 void OFileStream::writeString(const std::string& str)
 {
     writeUint32(str.length());
-
-    if(!str.empty()) {
-        if(fwrite(str.c_str(),str.length(),1,fp) != 1) {
-            THROW(OutputStream::error, "OFileStream::writeString(): An I/O-Error occurred!");
-        }
-    }
+    writeBytes(str.data(), str.length());
 }
 
 void OFileStream::writeUint8(Uint8 x)
 {
-    if(fwrite(&x,sizeof(Uint8),1,fp) != 1) {
-        THROW(OutputStream::error, "OFileStream::writeUint8(): An I/O-Error occurred!");
-    }
+    writeBytes(&x, sizeof(Uint8));
 }
 
 void OFileStream::writeUint16(Uint16 x)
 {
     x = SDL_SwapLE16(x);
-
-    if(fwrite(&x,sizeof(Uint16),1,fp) != 1) {
-        THROW(OutputStream::error, "OFileStream::writeUint16(): An I/O-Error occurred!");
-    }
+    writeBytes(&x, sizeof(Uint16));
 }
 
 void OFileStream::writeUint32(Uint32 x)
 {
     x = SDL_SwapLE32(x);
-
-    if(fwrite(&x,sizeof(Uint32),1,fp) != 1) {
-        THROW(OutputStream::error, "OFileStream::writeUint32(): An I/O-Error occurred!");
-    }
+    writeBytes(&x, sizeof(Uint32));
 }
 
 void OFileStream::writeUint64(Uint64 x)
 {
     x = SDL_SwapLE64(x);
-    if(fwrite(&x,sizeof(Uint64),1,fp) != 1) {
-        THROW(OutputStream::error, "OFileStream::writeUint64(): An I/O-Error occurred!");
-    }
+    writeBytes(&x, sizeof(Uint64));
 }
 
 void OFileStream::writeBool(bool x)
@@ -142,3 +171,135 @@ void OFileStream::writeFloat(float x)
     memcpy(&tmp,&x,sizeof(Uint32)); // workaround for a strange optimization in gcc 4.1
     writeUint32(tmp);
 }
+
+void OFileStream::writeBytes(const void* data, size_t length)
+{
+    if(buffer.size() + length > OFILESTREAM_BUFFERSIZE) {
+        if(flushBuffer() == false) {
+            THROW(OutputStream::error, "OFileStream::writeBytes(): An I/O-Error occurred!");
+        }
+
+        if((length >= OFILESTREAM_BUFFERSIZE) && (pFlushThread == nullptr)) {
+            // big writes bypass the buffer
+            if(fwrite(data,length,1,fp) != 1) {
+                THROW(OutputStream::error, "OFileStream::writeBytes(): An I/O-Error occurred!");
+            }
+            return;
+        }
+    }
+
+    const char* pData = static_cast<const char*>(data);
+    buffer.insert(buffer.end(), pData, pData + length);
+}
+
+/**
+    Writes the buffered data to the file.
+    \return true on success, false on an I/O-Error
+*/
+bool OFileStream::flushBuffer()
+{
+    if(buffer.empty()) {
+        return true;
+    }
+
+    if(pFlushThread != nullptr) {
+        // hand the buffer over to the flush thread and continue with its previous buffer
+        SDL_LockMutex(flushMutex);
+        while(bPendingWrite) {
+            SDL_CondWait(flushCondition, flushMutex);
+        }
+        const bool bSuccess = !bAsyncWriteError;
+        bAsyncWriteError = false;
+        pendingBuffer.swap(buffer);
+        bPendingWrite = true;
+        SDL_CondBroadcast(flushCondition);
+        SDL_UnlockMutex(flushMutex);
+
+        buffer.clear();
+        return bSuccess;
+    }
+
+    const bool bSuccess = (fwrite(buffer.data(),buffer.size(),1,fp) == 1);
+    buffer.clear();
+    return bSuccess;
+}
+
+/**
+    Waits until the flush thread has written the buffer handed to it.
+    \return true on success, false if the flush thread got an I/O-Error
+*/
+bool OFileStream::waitForPendingWrite()
+{
+    if(pFlushThread == nullptr) {
+        return true;
+    }
+
+    SDL_LockMutex(flushMutex);
+    while(bPendingWrite) {
+        SDL_CondWait(flushCondition, flushMutex);
+    }
+    const bool bSuccess = !bAsyncWriteError;
+    bAsyncWriteError = false;
+    SDL_UnlockMutex(flushMutex);
+
+    return bSuccess;
+}
+
+/**
+    Lets the flush thread write the buffer handed to it and stops it. Data still in buffer is kept.
+*/
+void OFileStream::stopFlushThread()
+{
+    if(pFlushThread == nullptr) {
+        return;
+    }
+
+    SDL_LockMutex(flushMutex);
+    bQuitFlushThread = true;
+    SDL_CondBroadcast(flushCondition);
+    SDL_UnlockMutex(flushMutex);
+
+    SDL_WaitThread(pFlushThread, nullptr);
+    pFlushThread = nullptr;
+
+    SDL_DestroyCond(flushCondition);
+    flushCondition = nullptr;
+    SDL_DestroyMutex(flushMutex);
+    flushMutex = nullptr;
+
+    if(bAsyncWriteError) {
+        SDL_Log("OFileStream: An I/O-Error occurred while writing on the flush thread!");
+    }
+}
+
+int OFileStream::flushThreadMain(void* data)
+{
+    OFileStream* pStream = static_cast<OFileStream*>(data);
+
+    SDL_LockMutex(pStream->flushMutex);
+    while(true) {
+        while(!pStream->bPendingWrite && !pStream->bQuitFlushThread) {
+            SDL_CondWait(pStream->flushCondition, pStream->flushMutex);
+        }
+
+        if(!pStream->bPendingWrite) {
+            // nothing left to write and asked to quit
+            break;
+        }
+
+        // the game thread does not touch pendingBuffer while bPendingWrite is set
+        SDL_UnlockMutex(pStream->flushMutex);
+        const bool bSuccess = (fwrite(pStream->pendingBuffer.data(), pStream->pendingBuffer.size(), 1, pStream->fp) == 1);
+        SDL_LockMutex(pStream->flushMutex);
+
+        pStream->pendingBuffer.clear();
+        pStream->bPendingWrite = false;
+        if(!bSuccess) {
+            pStream->bAsyncWriteError = true;
+        }
+        SDL_CondBroadcast(pStream->flushCondition);
+    }
+    SDL_UnlockMutex(pStream->flushMutex);
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <misc/ObjectArena.h>
+
+#include <new>
+
+ObjectArena::~ObjectArena() {
+    if(numAllocated != 0) {
+        SDL_Log("Warning: %u objects are still alive when destroying their ObjectArena!", static_cast<unsigned int>(numAllocated));
+    }
+}
+
+void* ObjectArena::allocate(size_t size) {
+    const size_t blockSize = sizeof(Header) + size;
+    const size_t sizeClass = (blockSize + OBJECTARENA_GRANULARITY - 1) / OBJECTARENA_GRANULARITY;
+
+    Header* pHeader;
+    if(sizeClass >= OBJECTARENA_NUM_SIZECLASSES) {
+        pHeader = static_cast<Header*>(::operator new(blockSize));
+        pHeader->pArena = nullptr;
+    } else {
+        if(freeLists[sizeClass] != nullptr) {
+            FreeBlock* pBlock = freeLists[sizeClass];
+            freeLists[sizeClass] = pBlock->pNext;
+            pHeader = reinterpret_cast<Header*>(pBlock);
+        } else {
+            const size_t classSize = sizeClass * OBJECTARENA_GRANULARITY;
+            if(chunkSpaceLeft < classSize) {
+                // the rest of the last chunk is too small for this size class and stays unused
+                chunks.emplace_back(new char[OBJECTARENA_CHUNKSIZE]);
+                pChunkPos = chunks.back().get();
+                chunkSpaceLeft = OBJECTARENA_CHUNKSIZE;
+            }
+            pHeader = reinterpret_cast<Header*>(pChunkPos);
+            pChunkPos += classSize;
+            chunkSpaceLeft -= classSize;
+        }
+        pHeader->pArena = this;
+        numAllocated++;
+    }
+
+    pHeader->sizeClass = sizeClass;
+    return pHeader + 1;
+}
+
+void ObjectArena::deallocate(void* p) {
+    if(p == nullptr) {
+        return;
+    }
+
+    Header* pHeader = static_cast<Header*>(p) - 1;
+    ObjectArena* pArena = pHeader->pArena;
+    if(pArena == nullptr) {
+        ::operator delete(pHeader);
+        return;
+    }
+
+    const size_t sizeClass = pHeader->sizeClass;
+    FreeBlock* pBlock = reinterpret_cast<FreeBlock*>(pHeader);
+    pBlock->pNext = pArena->freeLists[sizeClass];
+    pArena->freeLists[sizeClass] = pBlock;
+    pArena->numAllocated--;
+}
@@ -0,0 +1,85 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <misc/PrimitiveBatcher.h>
+
+#include <misc/draw_util.h>
+
+void PrimitiveBatcher::addLine(int x1, int y1, int x2, int y2, Uint32 color) {
+    if(y1 == y2) {
+        addHLine(x1, y1, x2, color);
+    } else if(x1 == x2) {
+        addVLine(x1, y1, y2, color);
+    } else {
+        Batch& batch = getBatch(color);
+        batch.linePoints.push_back(SDL_Point { x1, y1 });
+        batch.linePoints.push_back(SDL_Point { x2, y2 });
+    }
+}
+
+void PrimitiveBatcher::addRect(const SDL_Rect& rect, Uint32 color) {
+    getBatch(color).rects.push_back(rect);
+}
+
+void PrimitiveBatcher::addFilledRect(const SDL_Rect& rect, Uint32 color) {
+    getBatch(color).filledRects.push_back(rect);
+}
+
+void PrimitiveBatcher::flush(SDL_Renderer* renderer) {
+    for(size_t i = 0; i < numUsedBatches; i++) {
+        Batch& batch = batches[i];
+
+        setRenderDrawColor(renderer, batch.color);
+
+        if(!batch.filledRects.empty()) {
+            SDL_RenderFillRects(renderer, batch.filledRects.data(), static_cast<int>(batch.filledRects.size()));
+        }
+
+        if(!batch.rects.empty()) {
+            SDL_RenderDrawRects(renderer, batch.rects.data(), static_cast<int>(batch.rects.size()));
+        }
+
+        // SDL_RenderDrawLines() would connect all points, so the remaining (few) lines are drawn one by one
+        for(size_t j = 0; j + 1 < batch.linePoints.size(); j += 2) {
+            SDL_RenderDrawLine(renderer, batch.linePoints[j].x, batch.linePoints[j].y, batch.linePoints[j+1].x, batch.linePoints[j+1].y);
+        }
+
+        batch.filledRects.clear();
+        batch.rects.clear();
+        batch.linePoints.clear();
+    }
+
+    numUsedBatches = 0;
+}
+
+PrimitiveBatcher::Batch& PrimitiveBatcher::getBatch(Uint32 color) {
+    // there are only a handful of colors per layer, so a linear search is fastest
+    for(size_t i = 0; i < numUsedBatches; i++) {
+        if(batches[i].color == color) {
+            return batches[i];
+        }
+    }
+
+    if(numUsedBatches == batches.size()) {
+        batches.emplace_back(color);
+    } else {
+        batches[numUsedBatches].color = color;
+    }
+
+    return batches[numUsedBatches++];
+}
@@ -3,3 +3,17 @@
 
 Random::~Random() = default;
 
+Random Random::forStream(Uint32 baseSeed, Uint32 streamID) {
+    // mix both values (murmur3 finalizer) so that neighbouring stream ids give unrelated sequences
+    Uint32 h = baseSeed ^ (streamID * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+
+    // rand() needs an internal state in [1; 2147483646], see the MASK there
+    const Uint32 MASK = 123459876;
+    const Uint32 idum = (h % 2147483646u) + 1;
+    return Random(idum ^ MASK);
+}
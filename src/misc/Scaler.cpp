@@ -17,7 +17,21 @@
 
 #include <misc/Scaler.h>
 
+#include <misc/WorkerPool.h>
+
 #include <algorithm>
+#include <functional>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SCALER_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SCALER_USE_NEON
+#endif
+
+#define SCALER_MIN_ROWS_PER_BAND    16      ///< bands are never smaller than this many source rows
+#define SCALER_MIN_PIXELS_PER_BAND  16384   ///< surfaces with less source pixels per band are not split
 
 DoubleSurfaceFunction* Scaler::defaultDoubleSurface = Scaler::doubleSurfaceScale2x;
 DoubleTiledSurfaceFunction* Scaler::defaultDoubleTiledSurface = Scaler::doubleTiledSurfaceScale2x;
@@ -173,6 +187,329 @@ sdl2::surface_ptr Scaler::tripleTiledSurfaceNN(SDL_Surface* src, int tilesX, int
 
 
 
+namespace {
+
+/**
+    Calls scaleRows(firstRow, lastRow) for consecutive row bands covering [0; numRows). Large surfaces are split into
+    several bands which are scaled in parallel, small ones are scaled by the calling thread in one go.
+    \param  numRows     the number of source rows to scale
+    \param  rowWidth    the width of a source row in pixels
+    \param  scaleRows   the function scaling the source rows [firstRow; lastRow)
+*/
+void forEachRowBand(int numRows, int rowWidth, const std::function<void (int, int)>& scaleRows) {
+    static WorkerPool workerPool(WorkerPool::getDefaultNumThreads());
+    static SDL_atomic_t workerPoolInUse;
+
+    int numBands = std::min(numRows / SCALER_MIN_ROWS_PER_BAND, (numRows * rowWidth) / SCALER_MIN_PIXELS_PER_BAND);
+    numBands = std::min(numBands, 2*(workerPool.getNumThreads() + 1));
+
+    // the pool can only run one job at a time; a concurrent caller scales on its own thread
+    if((numBands <= 1) || (workerPool.getNumThreads() == 0) || !SDL_AtomicCAS(&workerPoolInUse, 0, 1)) {
+        scaleRows(0, numRows);
+        return;
+    }
+
+    try {
+        workerPool.parallelFor(numBands, [&](int band) {
+            scaleRows((band * numRows) / numBands, ((band + 1) * numRows) / numBands);
+        });
+    } catch(...) {
+        SDL_AtomicSet(&workerPoolInUse, 0);
+        throw;
+    }
+
+    SDL_AtomicSet(&workerPoolInUse, 0);
+}
+
+
+/*
+
+Scale center pixel E into 4 new pixels
+
+    Source            Dest
++---+---+---+
+| A | B | C |       +--+--+
++---+---+---+       |E0|E1|
+| D | E | F |   ->  +--+--+
++---+---+---+       |E2|E3|
+| G | H | I |       +--+--+
++---+---+---+
+
+*/
+
+inline void scale2xPixel(const Uint8* srcRowAbove, const Uint8* srcRow, const Uint8* srcRowBelow, Uint8* destRow0, Uint8* destRow1, int x, int width) {
+    Uint8 E = srcRow[x];
+    Uint8 B = srcRowAbove[x];
+    Uint8 H = srcRowBelow[x];
+    Uint8 D = srcRow[std::max(0,x-1)];
+    Uint8 F = srcRow[std::min(width-1,x+1)];
+
+    Uint8 E0, E1, E2, E3;
+
+    if(B != H && D != F) {
+        E0 = (D == B) ? D : E;
+        E1 = (B == F) ? F : E;
+        E2 = (D == H) ? D : E;
+        E3 = (H == F) ? F : E;
+    } else {
+        E0 = E;
+        E1 = E;
+        E2 = E;
+        E3 = E;
+    }
+
+    destRow0[2*x] = E0;
+    destRow0[2*x + 1] = E1;
+    destRow1[2*x] = E2;
+    destRow1[2*x + 1] = E3;
+}
+
+/**
+    Scales one row of a (sub)image with scale2x. The rows above and below are the clamped neighbour rows.
+    The first and last pixel are clamped horizontally and therefore always done by the scalar code; the pixels
+    in between are processed 16 at a time if SSE2 or NEON is available.
+*/
+void scale2xRow(const Uint8* srcRowAbove, const Uint8* srcRow, const Uint8* srcRowBelow, Uint8* destRow0, Uint8* destRow1, int width) {
+    if(width <= 0) {
+        return;
+    }
+
+    scale2xPixel(srcRowAbove, srcRow, srcRowBelow, destRow0, destRow1, 0, width);
+
+    int x = 1;
+
+#if defined(SCALER_USE_SSE2)
+    for(; x + 16 < width; x += 16) {
+        const __m128i B = _mm_loadu_si128((const __m128i*) (srcRowAbove + x));
+        const __m128i H = _mm_loadu_si128((const __m128i*) (srcRowBelow + x));
+        const __m128i D = _mm_loadu_si128((const __m128i*) (srcRow + x - 1));
+        const __m128i E = _mm_loadu_si128((const __m128i*) (srcRow + x));
+        const __m128i F = _mm_loadu_si128((const __m128i*) (srcRow + x + 1));
+
+        const __m128i notSmoothed = _mm_or_si128(_mm_cmpeq_epi8(B, H), _mm_cmpeq_epi8(D, F));
+        const __m128i selE0 = _mm_andnot_si128(notSmoothed, _mm_cmpeq_epi8(D, B));
+        const __m128i selE1 = _mm_andnot_si128(notSmoothed, _mm_cmpeq_epi8(B, F));
+        const __m128i selE2 = _mm_andnot_si128(notSmoothed, _mm_cmpeq_epi8(D, H));
+        const __m128i selE3 = _mm_andnot_si128(notSmoothed, _mm_cmpeq_epi8(H, F));
+
+        const __m128i E0 = _mm_or_si128(_mm_and_si128(selE0, D), _mm_andnot_si128(selE0, E));
+        const __m128i E1 = _mm_or_si128(_mm_and_si128(selE1, F), _mm_andnot_si128(selE1, E));
+        const __m128i E2 = _mm_or_si128(_mm_and_si128(selE2, D), _mm_andnot_si128(selE2, E));
+        const __m128i E3 = _mm_or_si128(_mm_and_si128(selE3, F), _mm_andnot_si128(selE3, E));
+
+        _mm_storeu_si128((__m128i*) (destRow0 + 2*x), _mm_unpacklo_epi8(E0, E1));
+        _mm_storeu_si128((__m128i*) (destRow0 + 2*x + 16), _mm_unpackhi_epi8(E0, E1));
+        _mm_storeu_si128((__m128i*) (destRow1 + 2*x), _mm_unpacklo_epi8(E2, E3));
+        _mm_storeu_si128((__m128i*) (destRow1 + 2*x + 16), _mm_unpackhi_epi8(E2, E3));
+    }
+#elif defined(SCALER_USE_NEON)
+    for(; x + 16 < width; x += 16) {
+        const uint8x16_t B = vld1q_u8(srcRowAbove + x);
+        const uint8x16_t H = vld1q_u8(srcRowBelow + x);
+        const uint8x16_t D = vld1q_u8(srcRow + x - 1);
+        const uint8x16_t E = vld1q_u8(srcRow + x);
+        const uint8x16_t F = vld1q_u8(srcRow + x + 1);
+
+        const uint8x16_t notSmoothed = vorrq_u8(vceqq_u8(B, H), vceqq_u8(D, F));
+
+        uint8x16x2_t upper;
+        upper.val[0] = vbslq_u8(vbicq_u8(vceqq_u8(D, B), notSmoothed), D, E);
+        upper.val[1] = vbslq_u8(vbicq_u8(vceqq_u8(B, F), notSmoothed), F, E);
+        vst2q_u8(destRow0 + 2*x, upper);
+
+        uint8x16x2_t lower;
+        lower.val[0] = vbslq_u8(vbicq_u8(vceqq_u8(D, H), notSmoothed), D, E);
+        lower.val[1] = vbslq_u8(vbicq_u8(vceqq_u8(H, F), notSmoothed), F, E);
+        vst2q_u8(destRow1 + 2*x, lower);
+    }
+#endif
+
+    for(; x < width; ++x) {
+        scale2xPixel(srcRowAbove, srcRow, srcRowBelow, destRow0, destRow1, x, width);
+    }
+}
+
+
+/*
+
+Scale center pixel E into 9 new pixels
+
+    Source             Dest
++---+---+---+       +--+--+--+
+| A | B | C |       |E0|E1|E2|
++---+---+---+       +--+--+--+
+| D | E | F |   ->  |E3|E4|E5|
++---+---+---+       +--+--+--+
+| G | H | I |       |E6|E7|E8|
++---+---+---+       +--+--+--+
+
+*/
+
+inline void scale3xPixel(const Uint8* srcRowAbove, const Uint8* srcRow, const Uint8* srcRowBelow, Uint8* destRow0, Uint8* destRow1, Uint8* destRow2, int x, int width) {
+    const int left = std::max(0,x-1);
+    const int right = std::min(width-1,x+1);
+
+    Uint8 A = srcRowAbove[left];
+    Uint8 B = srcRowAbove[x];
+    Uint8 C = srcRowAbove[right];
+    Uint8 D = srcRow[left];
+    Uint8 E = srcRow[x];
+    Uint8 F = srcRow[right];
+    Uint8 G = srcRowBelow[left];
+    Uint8 H = srcRowBelow[x];
+    Uint8 I = srcRowBelow[right];
+
+    Uint8 E0, E1, E2, E3, E4, E5, E6, E7, E8;
+
+    if(B != H && D != F) {
+        E0 = (D == B) ? D : E;
+        E1 = (((D == B) && (E != C)) || ((B == F) && (E != A))) ? B : E;
+        E2 = (B == F) ? F : E;
+        E3 = (((D == B && E != G)) || ((D == H) && (E != A))) ? D : E;
+        E4 = E;
+        E5 = (((B == F) && (E != I)) || ((H == F) && (E != C))) ? F : E;
+        E6 = (D == H) ? D : E;
+        E7 = (((D == H) && (E != I)) || ((H == F) && (E != G))) ? H : E;
+        E8 = (H == F) ? F : E;
+    } else {
+        E0 = E;
+        E1 = E;
+        E2 = E;
+        E3 = E;
+        E4 = E;
+        E5 = E;
+        E6 = E;
+        E7 = E;
+        E8 = E;
+    }
+
+    destRow0[3*x] = E0;
+    destRow0[3*x + 1] = E1;
+    destRow0[3*x + 2] = E2;
+    destRow1[3*x] = E3;
+    destRow1[3*x + 1] = E4;
+    destRow1[3*x + 2] = E5;
+    destRow2[3*x] = E6;
+    destRow2[3*x + 1] = E7;
+    destRow2[3*x + 2] = E8;
+}
+
+/**
+    Scales one row of a (sub)image with scale3x. See scale2xRow() for the handling of the borders.
+*/
+void scale3xRow(const Uint8* srcRowAbove, const Uint8* srcRow, const Uint8* srcRowBelow, Uint8* destRow0, Uint8* destRow1, Uint8* destRow2, int width) {
+    if(width <= 0) {
+        return;
+    }
+
+    scale3xPixel(srcRowAbove, srcRow, srcRowBelow, destRow0, destRow1, destRow2, 0, width);
+
+    int x = 1;
+
+#if defined(SCALER_USE_SSE2)
+    for(; x + 16 < width; x += 16) {
+        const __m128i A = _mm_loadu_si128((const __m128i*) (srcRowAbove + x - 1));
+        const __m128i B = _mm_loadu_si128((const __m128i*) (srcRowAbove + x));
+        const __m128i C = _mm_loadu_si128((const __m128i*) (srcRowAbove + x + 1));
+        const __m128i D = _mm_loadu_si128((const __m128i*) (srcRow + x - 1));
+        const __m128i E = _mm_loadu_si128((const __m128i*) (srcRow + x));
+        const __m128i F = _mm_loadu_si128((const __m128i*) (srcRow + x + 1));
+        const __m128i G = _mm_loadu_si128((const __m128i*) (srcRowBelow + x - 1));
+        const __m128i H = _mm_loadu_si128((const __m128i*) (srcRowBelow + x));
+        const __m128i I = _mm_loadu_si128((const __m128i*) (srcRowBelow + x + 1));
+
+        const __m128i notSmoothed = _mm_or_si128(_mm_cmpeq_epi8(B, H), _mm_cmpeq_epi8(D, F));
+        const __m128i DB = _mm_andnot_si128(notSmoothed, _mm_cmpeq_epi8(D, B));
+        const __m128i BF = _mm_andnot_si128(notSmoothed, _mm_cmpeq_epi8(B, F));
+        const __m128i DH = _mm_andnot_si128(notSmoothed, _mm_cmpeq_epi8(D, H));
+        const __m128i HF = _mm_andnot_si128(notSmoothed, _mm_cmpeq_epi8(H, F));
+        const __m128i EA = _mm_cmpeq_epi8(E, A);
+        const __m128i EC = _mm_cmpeq_epi8(E, C);
+        const __m128i EG = _mm_cmpeq_epi8(E, G);
+        const __m128i EI = _mm_cmpeq_epi8(E, I);
+
+        const __m128i selE1 = _mm_or_si128(_mm_andnot_si128(EC, DB), _mm_andnot_si128(EA, BF));
+        const __m128i selE3 = _mm_or_si128(_mm_andnot_si128(EG, DB), _mm_andnot_si128(EA, DH));
+        const __m128i selE5 = _mm_or_si128(_mm_andnot_si128(EI, BF), _mm_andnot_si128(EC, HF));
+        const __m128i selE7 = _mm_or_si128(_mm_andnot_si128(EI, DH), _mm_andnot_si128(EG, HF));
+
+        // SSE2 has no byte shuffle for interleaving three vectors, so the results go through a small buffer
+        alignas(16) Uint8 result[9][16];
+        _mm_store_si128((__m128i*) result[0], _mm_or_si128(_mm_and_si128(DB, D), _mm_andnot_si128(DB, E)));
+        _mm_store_si128((__m128i*) result[1], _mm_or_si128(_mm_and_si128(selE1, B), _mm_andnot_si128(selE1, E)));
+        _mm_store_si128((__m128i*) result[2], _mm_or_si128(_mm_and_si128(BF, F), _mm_andnot_si128(BF, E)));
+        _mm_store_si128((__m128i*) result[3], _mm_or_si128(_mm_and_si128(selE3, D), _mm_andnot_si128(selE3, E)));
+        _mm_store_si128((__m128i*) result[4], E);
+        _mm_store_si128((__m128i*) result[5], _mm_or_si128(_mm_and_si128(selE5, F), _mm_andnot_si128(selE5, E)));
+        _mm_store_si128((__m128i*) result[6], _mm_or_si128(_mm_and_si128(DH, D), _mm_andnot_si128(DH, E)));
+        _mm_store_si128((__m128i*) result[7], _mm_or_si128(_mm_and_si128(selE7, H), _mm_andnot_si128(selE7, E)));
+        _mm_store_si128((__m128i*) result[8], _mm_or_si128(_mm_and_si128(HF, F), _mm_andnot_si128(HF, E)));
+
+        Uint8* pDest0 = destRow0 + 3*x;
+        Uint8* pDest1 = destRow1 + 3*x;
+        Uint8* pDest2 = destRow2 + 3*x;
+        for(int k = 0; k < 16; ++k) {
+            pDest0[3*k] = result[0][k];
+            pDest0[3*k + 1] = result[1][k];
+            pDest0[3*k + 2] = result[2][k];
+            pDest1[3*k] = result[3][k];
+            pDest1[3*k + 1] = result[4][k];
+            pDest1[3*k + 2] = result[5][k];
+            pDest2[3*k] = result[6][k];
+            pDest2[3*k + 1] = result[7][k];
+            pDest2[3*k + 2] = result[8][k];
+        }
+    }
+#elif defined(SCALER_USE_NEON)
+    for(; x + 16 < width; x += 16) {
+        const uint8x16_t A = vld1q_u8(srcRowAbove + x - 1);
+        const uint8x16_t B = vld1q_u8(srcRowAbove + x);
+        const uint8x16_t C = vld1q_u8(srcRowAbove + x + 1);
+        const uint8x16_t D = vld1q_u8(srcRow + x - 1);
+        const uint8x16_t E = vld1q_u8(srcRow + x);
+        const uint8x16_t F = vld1q_u8(srcRow + x + 1);
+        const uint8x16_t G = vld1q_u8(srcRowBelow + x - 1);
+        const uint8x16_t H = vld1q_u8(srcRowBelow + x);
+        const uint8x16_t I = vld1q_u8(srcRowBelow + x + 1);
+
+        const uint8x16_t notSmoothed = vorrq_u8(vceqq_u8(B, H), vceqq_u8(D, F));
+        const uint8x16_t DB = vbicq_u8(vceqq_u8(D, B), notSmoothed);
+        const uint8x16_t BF = vbicq_u8(vceqq_u8(B, F), notSmoothed);
+        const uint8x16_t DH = vbicq_u8(vceqq_u8(D, H), notSmoothed);
+        const uint8x16_t HF = vbicq_u8(vceqq_u8(H, F), notSmoothed);
+        const uint8x16_t EA = vceqq_u8(E, A);
+        const uint8x16_t EC = vceqq_u8(E, C);
+        const uint8x16_t EG = vceqq_u8(E, G);
+        const uint8x16_t EI = vceqq_u8(E, I);
+
+        uint8x16x3_t row0;
+        row0.val[0] = vbslq_u8(DB, D, E);
+        row0.val[1] = vbslq_u8(vorrq_u8(vbicq_u8(DB, EC), vbicq_u8(BF, EA)), B, E);
+        row0.val[2] = vbslq_u8(BF, F, E);
+        vst3q_u8(destRow0 + 3*x, row0);
+
+        uint8x16x3_t row1;
+        row1.val[0] = vbslq_u8(vorrq_u8(vbicq_u8(DB, EG), vbicq_u8(DH, EA)), D, E);
+        row1.val[1] = E;
+        row1.val[2] = vbslq_u8(vorrq_u8(vbicq_u8(BF, EI), vbicq_u8(HF, EC)), F, E);
+        vst3q_u8(destRow1 + 3*x, row1);
+
+        uint8x16x3_t row2;
+        row2.val[0] = vbslq_u8(DH, D, E);
+        row2.val[1] = vbslq_u8(vorrq_u8(vbicq_u8(DH, EI), vbicq_u8(HF, EG)), H, E);
+        row2.val[2] = vbslq_u8(HF, F, E);
+        vst3q_u8(destRow2 + 3*x, row2);
+    }
+#endif
+
+    for(; x < width; ++x) {
+        scale3xPixel(srcRowAbove, srcRow, srcRowBelow, destRow0, destRow1, destRow2, x, width);
+    }
+}
+
+} // namespace
+
+
 /**
     This function doubles a surface while smoothing edges (see http://scale2x.sourceforge.net/algorithm.html ).
     \param  src             the source image
@@ -214,66 +551,34 @@ sdl2::surface_ptr Scaler::doubleTiledSurfaceScale2x(SDL_Surface* src, int tilesX
         SDL_SetSurfaceRLE(returnPic.get(), SDL_TRUE);
     }
 
-    Uint8* srcPixels = (Uint8*) src->pixels;
-    Uint8* destPixels = (Uint8*) returnPic->pixels;
-
     int tileWidth = srcWidth / tilesX;
     int tileHeight = srcHeight / tilesY;
 
     sdl2::surface_lock return_lock{ returnPic.get() };
     sdl2::surface_lock src_lock{ src };
 
-    for(int j=0;j<tilesY;++j) {
-        for(int i=0;i<tilesX;++i) {
-
-
-
-            /*
-
-            Scale center pixel E into 4 new pixels
-
-                Source            Dest
-            +---+---+---+
-            | A | B | C |       +--+--+
-            +---+---+---+       |E0|E1|
-            | D | E | F |   ->  +--+--+
-            +---+---+---+       |E2|E3|
-            | G | H | I |       +--+--+
-            +---+---+---+
-
-            */
-
-            for(int y = 0; y < tileHeight; ++y) {
-                for(int x = 0; x < tileWidth; ++x) {
-                    Uint8 E = *( srcPixels + (j*tileHeight+y)*src->pitch + (i*tileWidth+x) );
-                    Uint8 B = *( srcPixels + (j*tileHeight+std::max(0,y-1))*src->pitch + (i*tileWidth+x) );
-                    Uint8 H = *( srcPixels + (j*tileHeight+std::min(tileHeight-1,y+1))*src->pitch + (i*tileWidth+x) );
-                    Uint8 D = *( srcPixels + (j*tileHeight+y)*src->pitch + (i*tileWidth+std::max(0,x-1)) );
-                    Uint8 F = *( srcPixels + (j*tileHeight+y)*src->pitch + (i*tileWidth+std::min(tileWidth-1,x+1)) );
-
-                    Uint8 E0, E1, E2, E3;
-
-                    if(B != H && D != F) {
-                        E0 = (D == B) ? D : E;
-                        E1 = (B == F) ? F : E;
-                        E2 = (D == H) ? D : E;
-                        E3 = (H == F) ? F : E;
-                    } else {
-                        E0 = E;
-                        E1 = E;
-                        E2 = E;
-                        E3 = E;
-                    }
-
-                    *(destPixels + (j*tileHeight+y)*2*returnPic->pitch + (i*tileWidth+x)*2) = E0;
-                    *(destPixels + (j*tileHeight+y)*2*returnPic->pitch + (i*tileWidth+x)*2 + 1) = E1;
-                    *(destPixels + ((j*tileHeight+y)*2+1)*returnPic->pitch + (i*tileWidth+x)*2) = E2;
-                    *(destPixels + ((j*tileHeight+y)*2+1)*returnPic->pitch + (i*tileWidth+x)*2 + 1) = E3;
-                }
+    const Uint8* srcPixels = (const Uint8*) src->pixels;
+    Uint8* destPixels = (Uint8*) returnPic->pixels;
+    const int srcPitch = src->pitch;
+    const int destPitch = returnPic->pitch;
+
+    forEachRowBand(tilesY*tileHeight, srcWidth, [&](int firstRow, int lastRow) {
+        for(int row = firstRow; row < lastRow; ++row) {
+            const int y = row % tileHeight;
+            const int tileTop = row - y;
+
+            const Uint8* srcRowAbove = srcPixels + (tileTop + std::max(0,y-1))*srcPitch;
+            const Uint8* srcRow = srcPixels + row*srcPitch;
+            const Uint8* srcRowBelow = srcPixels + (tileTop + std::min(tileHeight-1,y+1))*srcPitch;
+            Uint8* destRow0 = destPixels + row*2*destPitch;
+            Uint8* destRow1 = destRow0 + destPitch;
+
+            for(int i=0;i<tilesX;++i) {
+                const int tileLeft = i*tileWidth;
+                scale2xRow(srcRowAbove + tileLeft, srcRow + tileLeft, srcRowBelow + tileLeft, destRow0 + tileLeft*2, destRow1 + tileLeft*2, tileWidth);
             }
-
         }
-    }
+    });
 
     return returnPic;
 }
@@ -320,87 +625,36 @@ sdl2::surface_ptr Scaler::tripleTiledSurfaceScale3x(SDL_Surface* src, int tilesX
         SDL_SetSurfaceRLE(returnPic.get(), SDL_TRUE);
     }
 
-    Uint8* srcPixels = (Uint8*) src->pixels;
-    Uint8* destPixels = (Uint8*) returnPic->pixels;
-
     int tileWidth = srcWidth / tilesX;
     int tileHeight = srcHeight / tilesY;
 
     sdl2::surface_lock return_lock{ returnPic.get() };
     sdl2::surface_lock src_lock{ src };
 
-    for(int j=0;j<tilesY;++j) {
-        for(int i=0;i<tilesX;++i) {
-
-
-
-            /*
-
-            Scale center pixel E into 4 new pixels
-
-                Source             Dest
-            +---+---+---+       +--+--+--+
-            | A | B | C |       |E0|E1|E2|
-            +---+---+---+       +--+--+--+
-            | D | E | F |   ->  |E3|E4|E5|
-            +---+---+---+       +--+--+--+
-            | G | H | I |       |E6|E7|E8|
-            +---+---+---+       +--+--+--+
-
-            */
-
-            for(int y = 0; y < tileHeight; ++y) {
-                for(int x = 0; x < tileWidth; ++x) {
-                    Uint8 A = *( srcPixels + (j*tileHeight+std::max(0,y-1))*src->pitch + (i*tileWidth+std::max(0,x-1)) );
-                    Uint8 B = *( srcPixels + (j*tileHeight+std::max(0,y-1))*src->pitch + (i*tileWidth+x) );
-                    Uint8 C = *( srcPixels + (j*tileHeight+std::max(0,y-1))*src->pitch + (i*tileWidth+std::min(tileWidth-1,x+1)) );
-                    Uint8 D = *( srcPixels + (j*tileHeight+y)*src->pitch + (i*tileWidth+std::max(0,x-1)) );
-                    Uint8 E = *( srcPixels + (j*tileHeight+y)*src->pitch + (i*tileWidth+x) );
-                    Uint8 F = *( srcPixels + (j*tileHeight+y)*src->pitch + (i*tileWidth+std::min(tileWidth-1,x+1)) );
-                    Uint8 G = *( srcPixels + (j*tileHeight+std::min(tileHeight-1,y+1))*src->pitch + (i*tileWidth+std::max(0,x-1)) );
-                    Uint8 H = *( srcPixels + (j*tileHeight+std::min(tileHeight-1,y+1))*src->pitch + (i*tileWidth+x) );
-                    Uint8 I = *( srcPixels + (j*tileHeight+std::min(tileHeight-1,y+1))*src->pitch + (i*tileWidth+std::min(tileWidth-1,x+1)) );
-
-                    Uint8 E0, E1, E2, E3, E4, E5, E6, E7, E8;
-
-                    if(B != H && D != F) {
-                        E0 = (D == B) ? D : E;
-                        E1 = (((D == B) && (E != C)) || ((B == F) && (E != A))) ? B : E;
-                        E2 = (B == F) ? F : E;
-                        E3 = (((D == B && E != G)) || ((D == H) && (E != A))) ? D : E;
-                        E4 = E;
-                        E5 = (((B == F) && (E != I)) || ((H == F) && (E != C))) ? F : E;
-                        E6 = (D == H) ? D : E;
-                        E7 = (((D == H) && (E != I)) || ((H == F) && (E != G))) ? H : E;
-                        E8 = (H == F) ? F : E;
-                    } else {
-                        E0 = E;
-                        E1 = E;
-                        E2 = E;
-                        E3 = E;
-                        E4 = E;
-                        E5 = E;
-                        E6 = E;
-                        E7 = E;
-                        E8 = E;
-                    }
-
-                    *(destPixels + (j*tileHeight+y)*3*returnPic->pitch + (i*tileWidth+x)*3) = E0;
-                    *(destPixels + (j*tileHeight+y)*3*returnPic->pitch + (i*tileWidth+x)*3 + 1) = E1;
-                    *(destPixels + (j*tileHeight+y)*3*returnPic->pitch + (i*tileWidth+x)*3 + 2) = E2;
-                    *(destPixels + ((j*tileHeight+y)*3+1)*returnPic->pitch + (i*tileWidth+x)*3) = E3;
-                    *(destPixels + ((j*tileHeight+y)*3+1)*returnPic->pitch + (i*tileWidth+x)*3 + 1) = E4;
-                    *(destPixels + ((j*tileHeight+y)*3+1)*returnPic->pitch + (i*tileWidth+x)*3 + 2) = E5;
-                    *(destPixels + ((j*tileHeight+y)*3+2)*returnPic->pitch + (i*tileWidth+x)*3) = E6;
-                    *(destPixels + ((j*tileHeight+y)*3+2)*returnPic->pitch + (i*tileWidth+x)*3 + 1) = E7;
-                    *(destPixels + ((j*tileHeight+y)*3+2)*returnPic->pitch + (i*tileWidth+x)*3 + 2) = E8;
-                }
+    const Uint8* srcPixels = (const Uint8*) src->pixels;
+    Uint8* destPixels = (Uint8*) returnPic->pixels;
+    const int srcPitch = src->pitch;
+    const int destPitch = returnPic->pitch;
+
+    forEachRowBand(tilesY*tileHeight, srcWidth, [&](int firstRow, int lastRow) {
+        for(int row = firstRow; row < lastRow; ++row) {
+            const int y = row % tileHeight;
+            const int tileTop = row - y;
+
+            const Uint8* srcRowAbove = srcPixels + (tileTop + std::max(0,y-1))*srcPitch;
+            const Uint8* srcRow = srcPixels + row*srcPitch;
+            const Uint8* srcRowBelow = srcPixels + (tileTop + std::min(tileHeight-1,y+1))*srcPitch;
+            Uint8* destRow0 = destPixels + row*3*destPitch;
+            Uint8* destRow1 = destRow0 + destPitch;
+            Uint8* destRow2 = destRow1 + destPitch;
+
+            for(int i=0;i<tilesX;++i) {
+                const int tileLeft = i*tileWidth;
+                scale3xRow(srcRowAbove + tileLeft, srcRow + tileLeft, srcRowBelow + tileLeft,
+                           destRow0 + tileLeft*3, destRow1 + tileLeft*3, destRow2 + tileLeft*3, tileWidth);
             }
-
         }
-    }
+    });
 
     return returnPic;
 }
-
-
@@ -0,0 +1,188 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <misc/ScreenshotWriter.h>
+
+#include <FileClasses/LoadSavePNG.h>
+#include <FileClasses/SaveQOI.h>
+#include <misc/FileSystem.h>
+#include <misc/string_util.h>
+#include <misc/exceptions.h>
+
+#include <algorithm>
+#include <cstdio>
+
+ScreenshotWriter::ScreenshotWriter(Format format, int compressionLevel)
+ : format(format), compressionLevel(compressionLevel) {
+    mutex = SDL_CreateMutex();
+    availableJobsSemaphore = SDL_CreateSemaphore(0);
+    idleCondition = SDL_CreateCond();
+    if((mutex == nullptr) || (availableJobsSemaphore == nullptr) || (idleCondition == nullptr)) {
+        THROW(std::runtime_error, "ScreenshotWriter::ScreenshotWriter(): Unable to create semaphores: %s", SDL_GetError());
+    }
+
+    pThread = SDL_CreateThread(writerThreadMain, "ScreenshotWriter", (void*) this);
+    if(pThread == nullptr) {
+        SDL_Log("ScreenshotWriter: Unable to create writer thread: %s", SDL_GetError());
+    }
+}
+
+ScreenshotWriter::~ScreenshotWriter() {
+    if(pThread != nullptr) {
+        SDL_LockMutex(mutex);
+        jobs.push_back(Job{ "", nullptr });
+        SDL_UnlockMutex(mutex);
+        SDL_SemPost(availableJobsSemaphore);
+
+        SDL_WaitThread(pThread, nullptr);
+    }
+
+    SDL_DestroyCond(idleCondition);
+    SDL_DestroySemaphore(availableJobsSemaphore);
+    SDL_DestroyMutex(mutex);
+}
+
+ScreenshotWriter::Format ScreenshotWriter::getFormatByName(const std::string& name) {
+    if(strToLower(name) == "qoi") {
+        return Format::QOI;
+    } else {
+        return Format::PNG;
+    }
+}
+
+const char* ScreenshotWriter::getFileExtension() const {
+    return (format == Format::QOI) ? ".qoi" : ".png";
+}
+
+std::string ScreenshotWriter::getNextFilename(const std::string& prefix) {
+    SDL_LockMutex(mutex);
+    std::string filename;
+    int i = 1;
+    do {
+        filename = prefix + std::to_string(i) + getFileExtension();
+        i++;
+    } while(existsFile(filename) || (std::find(pendingFiles.begin(), pendingFiles.end(), filename) != pendingFiles.end()));
+    SDL_UnlockMutex(mutex);
+    return filename;
+}
+
+void ScreenshotWriter::writeScreenshot(const std::string& filename, sdl2::surface_ptr pSurface) {
+    if(pSurface == nullptr) {
+        SDL_LockMutex(mutex);
+        failedFiles.push_back(filename);
+        SDL_UnlockMutex(mutex);
+        return;
+    }
+
+    if(pThread == nullptr) {
+        // no thread => write it directly
+        Job job{ filename, std::move(pSurface) };
+        finishJob(filename, write(job));
+        return;
+    }
+
+    SDL_LockMutex(mutex);
+    jobs.push_back(Job{ filename, std::move(pSurface) });
+    pendingFiles.push_back(filename);
+    SDL_UnlockMutex(mutex);
+
+    SDL_SemPost(availableJobsSemaphore);
+}
+
+void ScreenshotWriter::waitUntilIdle() {
+    SDL_LockMutex(mutex);
+    while(!pendingFiles.empty()) {
+        SDL_CondWait(idleCondition, mutex);
+    }
+    SDL_UnlockMutex(mutex);
+}
+
+std::vector<std::string> ScreenshotWriter::getWrittenFiles() {
+    SDL_LockMutex(mutex);
+    std::vector<std::string> result;
+    result.swap(writtenFiles);
+    SDL_UnlockMutex(mutex);
+    return result;
+}
+
+std::vector<std::string> ScreenshotWriter::getFailedFiles() {
+    SDL_LockMutex(mutex);
+    std::vector<std::string> result;
+    result.swap(failedFiles);
+    SDL_UnlockMutex(mutex);
+    return result;
+}
+
+int ScreenshotWriter::writerThreadMain(void* data) {
+    ScreenshotWriter* pWriter = static_cast<ScreenshotWriter*>(data);
+
+    while(true) {
+        while(SDL_SemWait(pWriter->availableJobsSemaphore) != 0) {
+            ;   // try again in case of error
+        }
+
+        SDL_LockMutex(pWriter->mutex);
+        Job job = std::move(pWriter->jobs.front());
+        pWriter->jobs.pop_front();
+        SDL_UnlockMutex(pWriter->mutex);
+
+        if(job.pSurface == nullptr) {
+            return 0;
+        }
+
+        pWriter->finishJob(job.filename, pWriter->write(job));
+    }
+}
+
+bool ScreenshotWriter::write(const Job& job) const {
+    sdl2::RWops_ptr RWop{ SDL_RWFromFile(job.filename.c_str(), "wb") };
+    if(RWop == nullptr) {
+        SDL_Log("ScreenshotWriter: Cannot open '%s': %s", job.filename.c_str(), SDL_GetError());
+        return false;
+    }
+
+    const int result = (format == Format::QOI) ? SaveQOI_RW(job.pSurface.get(), RWop.get())
+                                               : SavePNG_RW(job.pSurface.get(), RWop.get(), compressionLevel);
+    RWop.reset();
+
+    if(result != 0) {
+        SDL_Log("ScreenshotWriter: Cannot write '%s'", job.filename.c_str());
+        std::remove(job.filename.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void ScreenshotWriter::finishJob(const std::string& filename, bool bSuccess) {
+    SDL_LockMutex(mutex);
+    if(bSuccess) {
+        writtenFiles.push_back(filename);
+    } else {
+        failedFiles.push_back(filename);
+    }
+
+    auto iter = std::find(pendingFiles.begin(), pendingFiles.end(), filename);
+    if(iter != pendingFiles.end()) {
+        pendingFiles.erase(iter);
+        if(pendingFiles.empty()) {
+            SDL_CondBroadcast(idleCondition);
+        }
+    }
+    SDL_UnlockMutex(mutex);
+}
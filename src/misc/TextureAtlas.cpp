@@ -0,0 +1,86 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/TextureAtlas.h>
+
+#include <misc/draw_util.h>
+
+#include <globals.h>
+
+#include <algorithm>
+#include <numeric>
+
+bool TextureAtlas::build(const std::vector<SDL_Surface*>& surfaces, int maxSize) {
+    texture.reset();
+    rects.assign(surfaces.size(), SDL_Rect{ 0, 0, 0, 0 });
+
+    int widest = 0;
+    for(const SDL_Surface* pSurface : surfaces) {
+        widest = std::max(widest, pSurface->w);
+    }
+
+    const int width = std::min(maxSize, std::max(widest, 1024));
+    if(widest > width) {
+        return false;
+    }
+
+    // place the highest surfaces first, each shelf is as high as its first surface
+    std::vector<size_t> order(surfaces.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return surfaces[a]->h > surfaces[b]->h; });
+
+    int shelfX = 0;
+    int shelfY = 0;
+    int shelfHeight = 0;
+    for(size_t index : order) {
+        const SDL_Surface* pSurface = surfaces[index];
+        if(shelfX + pSurface->w > width) {
+            shelfY += shelfHeight;
+            shelfX = 0;
+            shelfHeight = 0;
+        }
+
+        rects[index] = { shelfX, shelfY, pSurface->w, pSurface->h };
+        shelfX += pSurface->w;
+        shelfHeight = std::max(shelfHeight, pSurface->h);
+    }
+
+    const int height = shelfY + shelfHeight;
+    if(height > maxSize) {
+        return false;
+    }
+
+    sdl2::surface_ptr pAtlasSurface{ SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SCREEN_FORMAT) };
+    if(pAtlasSurface == nullptr) {
+        SDL_Log("TextureAtlas::build(): SDL_CreateRGBSurfaceWithFormat() failed: %s", SDL_GetError());
+        return false;
+    }
+    SDL_FillRect(pAtlasSurface.get(), nullptr, SDL_MapRGBA(pAtlasSurface->format, 0, 0, 0, 0));
+
+    for(size_t index = 0; index < surfaces.size(); index++) {
+        // converting to 32 bit turns the color key into alpha; copy the pixels without blending them
+        sdl2::surface_ptr pConverted = convertSurfaceToDisplayFormat(surfaces[index]);
+        SDL_SetSurfaceBlendMode(pConverted.get(), SDL_BLENDMODE_NONE);
+        SDL_Rect dest = rects[index];
+        SDL_BlitSurface(pConverted.get(), nullptr, pAtlasSurface.get(), &dest);
+    }
+
+    texture = convertSurfaceToTexture(pAtlasSurface.get());
+    SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+
+    return texture != nullptr;
+}
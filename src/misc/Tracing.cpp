@@ -0,0 +1,209 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/Tracing.h>
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+SDL_atomic_t Tracing::recording = { 0 };
+
+namespace {
+
+enum TraceEventType {
+    TraceEvent_Zone,
+    TraceEvent_Counter,
+    TraceEvent_FrameMark
+};
+
+struct TraceEvent {
+    const char*     name;       ///< the name of the zone or counter
+    TraceEventType  type;       ///< what kind of event this is
+    Uint64          start;      ///< the performance counter when the event started
+    Uint64          end;        ///< the performance counter when the zone was left (only zones)
+    Sint64          value;      ///< the value of the counter (only counters)
+};
+
+struct ThreadBuffer {
+    SDL_threadID            threadID;               ///< the thread recording into this buffer
+    const char*             threadName = nullptr;   ///< the name of the thread (nullptr = unnamed)
+    SDL_SpinLock            lock = 0;               ///< protects events against the thread saving the trace
+    std::vector<TraceEvent> events;                 ///< all events recorded by this thread
+    Uint32                  numDropped = 0;         ///< the number of events dropped because the buffer was full
+};
+
+SDL_SpinLock threadBuffersLock = 0;
+Uint64 recordingStart = 0;
+thread_local ThreadBuffer* pCurrentThreadBuffer = nullptr;
+
+/// All thread buffers ever created; they are never freed as their threads might have ended before the trace is saved
+std::vector<std::unique_ptr<ThreadBuffer>>& getThreadBuffers() {
+    static std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+    return threadBuffers;
+}
+
+ThreadBuffer* getCurrentThreadBuffer() {
+    if(pCurrentThreadBuffer == nullptr) {
+        auto pThreadBuffer = std::make_unique<ThreadBuffer>();
+        pThreadBuffer->threadID = SDL_ThreadID();
+        pCurrentThreadBuffer = pThreadBuffer.get();
+
+        SDL_AtomicLock(&threadBuffersLock);
+        getThreadBuffers().push_back(std::move(pThreadBuffer));
+        SDL_AtomicUnlock(&threadBuffersLock);
+    }
+
+    return pCurrentThreadBuffer;
+}
+
+void addEvent(const TraceEvent& event) {
+    ThreadBuffer* pThreadBuffer = getCurrentThreadBuffer();
+
+    SDL_AtomicLock(&pThreadBuffer->lock);
+    if(pThreadBuffer->events.size() < TRACING_MAX_EVENTS_PER_THREAD) {
+        pThreadBuffer->events.push_back(event);
+    } else {
+        pThreadBuffer->numDropped++;
+    }
+    SDL_AtomicUnlock(&pThreadBuffer->lock);
+}
+
+/// Writes str as JSON string literal
+void writeJSONString(FILE* file, const char* str) {
+    fputc('"', file);
+    for(const char* p = str; *p != '\0'; p++) {
+        if((*p == '"') || (*p == '\\')) {
+            fputc('\\', file);
+        }
+        fputc(*p, file);
+    }
+    fputc('"', file);
+}
+
+}
+
+void Tracing::start() {
+    SDL_AtomicSet(&recording, 0);
+
+    SDL_AtomicLock(&threadBuffersLock);
+    for(auto& pThreadBuffer : getThreadBuffers()) {
+        SDL_AtomicLock(&pThreadBuffer->lock);
+        pThreadBuffer->events.clear();
+        pThreadBuffer->numDropped = 0;
+        SDL_AtomicUnlock(&pThreadBuffer->lock);
+    }
+    SDL_AtomicUnlock(&threadBuffersLock);
+
+    recordingStart = SDL_GetPerformanceCounter();
+    SDL_AtomicSet(&recording, 1);
+}
+
+bool Tracing::stopAndSave(const std::string& filename) {
+    SDL_AtomicSet(&recording, 0);
+
+    FILE* file = fopen(filename.c_str(), "w");
+    if(file == nullptr) {
+        SDL_Log("Tracing::stopAndSave(): Cannot open '%s'!", filename.c_str());
+        return false;
+    }
+
+    // all timestamps are in microseconds since the start of the recording
+    const double ticksToMicroseconds = 1000000.0 / SDL_GetPerformanceFrequency();
+    auto toTimestamp = [&](Uint64 counter) {
+        return (counter > recordingStart) ? (counter - recordingStart) * ticksToMicroseconds : 0.0;
+    };
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Dune Legacy\"}}");
+
+    Uint32 numDropped = 0;
+
+    SDL_AtomicLock(&threadBuffersLock);
+    for(auto& pThreadBuffer : getThreadBuffers()) {
+        SDL_AtomicLock(&pThreadBuffer->lock);
+
+        const unsigned long tid = (unsigned long) pThreadBuffer->threadID;
+
+        if(pThreadBuffer->threadName != nullptr) {
+            fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":", tid);
+            writeJSONString(file, pThreadBuffer->threadName);
+            fprintf(file, "}}");
+        }
+
+        for(const TraceEvent& event : pThreadBuffer->events) {
+            switch(event.type) {
+                case TraceEvent_Zone: {
+                    fprintf(file, ",\n{\"name\":");
+                    writeJSONString(file, event.name);
+                    fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}",
+                                  tid, toTimestamp(event.start), (event.end - event.start) * ticksToMicroseconds);
+                } break;
+
+                case TraceEvent_Counter: {
+                    fprintf(file, ",\n{\"name\":");
+                    writeJSONString(file, event.name);
+                    fprintf(file, ",\"ph\":\"C\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+                                  tid, toTimestamp(event.start), (long long) event.value);
+                } break;
+
+                case TraceEvent_FrameMark: {
+                    fprintf(file, ",\n{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f}",
+                                  tid, toTimestamp(event.start));
+                } break;
+            }
+        }
+
+        numDropped += pThreadBuffer->numDropped;
+        pThreadBuffer->events.clear();
+        pThreadBuffer->numDropped = 0;
+
+        SDL_AtomicUnlock(&pThreadBuffer->lock);
+    }
+    SDL_AtomicUnlock(&threadBuffersLock);
+
+    fprintf(file, "\n]}\n");
+
+    const bool bSuccess = (ferror(file) == 0);
+    fclose(file);
+
+    if(numDropped > 0) {
+        SDL_Log("Tracing: %u events were dropped because the trace got too long", numDropped);
+    }
+
+    return bSuccess;
+}
+
+void Tracing::addZone(const char* name, Uint64 start, Uint64 end) {
+    addEvent( { name, TraceEvent_Zone, start, end, 0 } );
+}
+
+void Tracing::addCounter(const char* name, Sint64 value) {
+    addEvent( { name, TraceEvent_Counter, SDL_GetPerformanceCounter(), 0, value } );
+}
+
+void Tracing::addFrameMark() {
+    addEvent( { "Frame", TraceEvent_FrameMark, SDL_GetPerformanceCounter(), 0, 0 } );
+}
+
+void Tracing::setThreadName(const char* name) {
+    ThreadBuffer* pThreadBuffer = getCurrentThreadBuffer();
+
+    SDL_AtomicLock(&pThreadBuffer->lock);
+    pThreadBuffer->threadName = name;
+    SDL_AtomicUnlock(&pThreadBuffer->lock);
+}
@@ -0,0 +1,189 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <misc/VideoEncoderPipe.h>
+
+#include <misc/exceptions.h>
+
+#include <cstring>
+
+#ifdef _WIN32
+#define popen   _popen
+#define pclose  _pclose
+#define VIDEOENCODERPIPE_MODE   "wb"
+#else
+#include <signal.h>
+#define VIDEOENCODERPIPE_MODE   "w"
+#endif
+
+VideoEncoderPipe::VideoEncoderPipe(const std::string& command) {
+#ifndef _WIN32
+    // an exiting encoder must not kill the game; the failed write is reported by hasFailed() instead
+    signal(SIGPIPE, SIG_IGN);
+#endif
+
+    pPipe = popen(command.c_str(), VIDEOENCODERPIPE_MODE);
+    if(pPipe == nullptr) {
+        THROW(std::runtime_error, "VideoEncoderPipe::VideoEncoderPipe(): Cannot start encoder '%s'!", command);
+    }
+
+    mutex = SDL_CreateMutex();
+    availableFramesSemaphore = SDL_CreateSemaphore(0);
+    freeSlotsSemaphore = SDL_CreateSemaphore(VIDEOENCODERPIPE_MAX_QUEUED_FRAMES);
+    if((mutex == nullptr) || (availableFramesSemaphore == nullptr) || (freeSlotsSemaphore == nullptr)) {
+        THROW(std::runtime_error, "VideoEncoderPipe::VideoEncoderPipe(): Unable to create semaphores: %s", SDL_GetError());
+    }
+
+    pThread = SDL_CreateThread(writerThreadMain, "VideoEncoderPipe", (void*) this);
+    if(pThread == nullptr) {
+        SDL_Log("VideoEncoderPipe: Unable to create writer thread: %s", SDL_GetError());
+    }
+}
+
+VideoEncoderPipe::~VideoEncoderPipe() {
+    close();
+
+    SDL_DestroySemaphore(freeSlotsSemaphore);
+    SDL_DestroySemaphore(availableFramesSemaphore);
+    SDL_DestroyMutex(mutex);
+}
+
+bool VideoEncoderPipe::close() {
+    if(pPipe == nullptr) {
+        return !hasFailed();
+    }
+
+    if(pThread != nullptr) {
+        SDL_LockMutex(mutex);
+        frames.push_back(nullptr);
+        SDL_UnlockMutex(mutex);
+        SDL_SemPost(availableFramesSemaphore);
+
+        SDL_WaitThread(pThread, nullptr);
+        pThread = nullptr;
+    }
+
+    const int exitCode = pclose(pPipe);
+    pPipe = nullptr;
+    if(exitCode != 0) {
+        SDL_Log("VideoEncoderPipe: The encoder exited with %d", exitCode);
+        SDL_LockMutex(mutex);
+        bFailed = true;
+        SDL_UnlockMutex(mutex);
+    }
+
+    return !hasFailed();
+}
+
+const char* VideoEncoderPipe::getRawPixelFormatName() {
+    // SCREEN_FORMAT is SDL_PIXELFORMAT_ABGR8888, i.e. packed as 32-bit values
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    return "abgr";
+#else
+    return "rgba";
+#endif
+}
+
+void VideoEncoderPipe::writeFrame(sdl2::surface_ptr pFrame) {
+    if(pFrame == nullptr) {
+        SDL_LockMutex(mutex);
+        bFailed = true;
+        SDL_UnlockMutex(mutex);
+        return;
+    }
+
+    if(pThread == nullptr) {
+        // no thread => write it directly
+        write(pFrame.get());
+        return;
+    }
+
+    while(SDL_SemWait(freeSlotsSemaphore) != 0) {
+        ;   // try again in case of error
+    }
+
+    SDL_LockMutex(mutex);
+    frames.push_back(std::move(pFrame));
+    SDL_UnlockMutex(mutex);
+
+    SDL_SemPost(availableFramesSemaphore);
+}
+
+bool VideoEncoderPipe::hasFailed() {
+    SDL_LockMutex(mutex);
+    const bool bResult = bFailed;
+    SDL_UnlockMutex(mutex);
+    return bResult;
+}
+
+Uint32 VideoEncoderPipe::getNumWrittenFrames() {
+    SDL_LockMutex(mutex);
+    const Uint32 result = numWrittenFrames;
+    SDL_UnlockMutex(mutex);
+    return result;
+}
+
+int VideoEncoderPipe::writerThreadMain(void* data) {
+    VideoEncoderPipe* pEncoderPipe = static_cast<VideoEncoderPipe*>(data);
+
+    while(true) {
+        while(SDL_SemWait(pEncoderPipe->availableFramesSemaphore) != 0) {
+            ;   // try again in case of error
+        }
+
+        SDL_LockMutex(pEncoderPipe->mutex);
+        sdl2::surface_ptr pFrame = std::move(pEncoderPipe->frames.front());
+        pEncoderPipe->frames.pop_front();
+        SDL_UnlockMutex(pEncoderPipe->mutex);
+
+        SDL_SemPost(pEncoderPipe->freeSlotsSemaphore);
+
+        if(pFrame == nullptr) {
+            fflush(pEncoderPipe->pPipe);
+            return 0;
+        }
+
+        pEncoderPipe->write(pFrame.get());
+    }
+}
+
+bool VideoEncoderPipe::write(SDL_Surface* pFrame) {
+    const size_t rowSize = static_cast<size_t>(pFrame->w) * 4;
+    const Uint8* pPixels = static_cast<const Uint8*>(pFrame->pixels);
+
+    const Uint8* pData = pPixels;
+    if(static_cast<size_t>(pFrame->pitch) != rowSize) {
+        frameBuffer.resize(rowSize * pFrame->h);
+        for(int y = 0; y < pFrame->h; y++) {
+            memcpy(frameBuffer.data() + y * rowSize, pPixels + y * pFrame->pitch, rowSize);
+        }
+        pData = frameBuffer.data();
+    }
+
+    const bool bWritten = (fwrite(pData, rowSize, pFrame->h, pPipe) == static_cast<size_t>(pFrame->h));
+
+    SDL_LockMutex(mutex);
+    if(bWritten) {
+        numWrittenFrames++;
+    } else {
+        bFailed = true;
+    }
+    SDL_UnlockMutex(mutex);
+
+    return bWritten;
+}
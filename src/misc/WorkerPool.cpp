@@ -0,0 +1,149 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/WorkerPool.h>
+
+#include <misc/exceptions.h>
+#include <misc/Tracing.h>
+
+#include <algorithm>
+
+#define WORKERPOOL_MAXTHREADS   15
+
+WorkerPool::WorkerPool(int numThreads) {
+    SDL_AtomicSet(&nextItem, 0);
+
+    numThreads = std::max(0, std::min(numThreads, WORKERPOOL_MAXTHREADS));
+    if(numThreads == 0) {
+        return;
+    }
+
+    startSemaphore = SDL_CreateSemaphore(0);
+    doneSemaphore = SDL_CreateSemaphore(0);
+    exceptionMutex = SDL_CreateMutex();
+    if((startSemaphore == nullptr) || (doneSemaphore == nullptr) || (exceptionMutex == nullptr)) {
+        THROW(std::runtime_error, "WorkerPool::WorkerPool(): Unable to create semaphores: %s", SDL_GetError());
+    }
+
+    for(int i = 0; i < numThreads; i++) {
+        SDL_Thread* pThread = SDL_CreateThread(workerThreadMain, "WorkerPool", (void*) this);
+        if(pThread == nullptr) {
+            SDL_Log("WorkerPool: Unable to create worker thread: %s", SDL_GetError());
+            break;
+        }
+        threads.push_back(pThread);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    pJob = nullptr;
+    for(size_t i = 0; i < threads.size(); i++) {
+        SDL_SemPost(startSemaphore);
+    }
+
+    for(SDL_Thread* pThread : threads) {
+        SDL_WaitThread(pThread, nullptr);
+    }
+
+    if(exceptionMutex != nullptr) {
+        SDL_DestroyMutex(exceptionMutex);
+    }
+
+    if(doneSemaphore != nullptr) {
+        SDL_DestroySemaphore(doneSemaphore);
+    }
+
+    if(startSemaphore != nullptr) {
+        SDL_DestroySemaphore(startSemaphore);
+    }
+}
+
+int WorkerPool::getDefaultNumThreads() {
+    return std::max(0, SDL_GetCPUCount() - 1);
+}
+
+void WorkerPool::parallelFor(int numItems, const std::function<void (int)>& job) {
+    if(threads.empty() || (numItems <= 1)) {
+        for(int i = 0; i < numItems; i++) {
+            job(i);
+        }
+        return;
+    }
+
+    pJob = &job;
+    numJobItems = numItems;
+    pException = nullptr;
+    SDL_AtomicSet(&nextItem, 0);
+
+    for(size_t i = 0; i < threads.size(); i++) {
+        SDL_SemPost(startSemaphore);
+    }
+
+    processItems();
+
+    for(size_t i = 0; i < threads.size(); i++) {
+        while(SDL_SemWait(doneSemaphore) != 0) {
+            // retry on spurious failure
+        }
+    }
+
+    pJob = nullptr;
+
+    if(pException) {
+        std::rethrow_exception(pException);
+    }
+}
+
+int WorkerPool::workerThreadMain(void* data) {
+    WorkerPool* pPool = static_cast<WorkerPool*>(data);
+    TRACE_THREAD_NAME("WorkerPool");
+
+    while(true) {
+        while(SDL_SemWait(pPool->startSemaphore) != 0) {
+            // retry on spurious failure
+        }
+
+        if(pPool->pJob == nullptr) {
+            return 0;
+        }
+
+        pPool->processItems();
+
+        SDL_SemPost(pPool->doneSemaphore);
+    }
+}
+
+void WorkerPool::processItems() {
+    TRACE_ZONE("WorkerPool items");
+
+    while(true) {
+        const int item = SDL_AtomicAdd(&nextItem, 1);
+        if(item >= numJobItems) {
+            return;
+        }
+
+        try {
+            (*pJob)(item);
+        } catch(...) {
+            SDL_LockMutex(exceptionMutex);
+            if(!pException) {
+                pException = std::current_exception();
+            }
+            SDL_UnlockMutex(exceptionMutex);
+        }
+    }
+}
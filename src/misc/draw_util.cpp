@@ -202,7 +202,62 @@ sdl2::surface_ptr renderReadSurface(SDL_Renderer* renderer) {
     return pScreen;
 }
 
+std::vector<unsigned char> getSurfaceRGBA(SDL_Surface* surface) {
+    const int width = surface->w;
+    const int height = surface->h;
+
+    std::vector<unsigned char> image(4*width*height);
+
+    sdl2::surface_lock lock{ surface };
+
+    // the pixel format of which the memory layout is r, g, b, a regardless of the byte order
+    const Uint32 rgbaFormat = (SDL_BYTEORDER == SDL_BIG_ENDIAN) ? SDL_PIXELFORMAT_RGBA8888 : SDL_PIXELFORMAT_ABGR8888;
+
+    if(surface->format->format == rgbaFormat) {
+        for(int y = 0; y < height; y++) {
+            memcpy(image.data() + y * 4*width, static_cast<const Uint8*>(surface->pixels) + y * surface->pitch, 4*width);
+        }
+    } else if(surface->format->BytesPerPixel == 1) {
+        // convert every palette entry once and then whole rows through this table
+        Uint32 colorMap[256];
+        for(int i = 0; i < 256; i++) {
+            unsigned char rgba[4];
+            SDL_GetRGBA(i, surface->format, &rgba[0], &rgba[1], &rgba[2], &rgba[3]);
+            memcpy(&colorMap[i], rgba, sizeof(rgba));
+        }
+
+        std::vector<Uint32> row(width);
+        for(int y = 0; y < height; y++) {
+            mapRowColorsTo32(static_cast<const Uint8*>(surface->pixels) + y * surface->pitch, row.data(), width, colorMap);
+            memcpy(image.data() + y * 4*width, row.data(), 4*width);
+        }
+    } else if(SDL_ConvertPixels(width, height, surface->format->format, surface->pixels, surface->pitch, rgbaFormat, image.data(), 4*width) != 0) {
+        // unusual format => copy pixel by pixel
+        for(int y = 0; y < height; y++) {
+            unsigned char* out = image.data() + y * 4*width;
+            for(int x = 0; x < width; x++) {
+                Uint32 pixel = getPixel(surface, x, y);
+                SDL_GetRGBA(pixel, surface->format, &out[0], &out[1], &out[2], &out[3]);
+                out += 4;
+            }
+        }
+    }
+
+    return image;
+}
+
 void replaceColor(SDL_Surface *surface, Uint32 oldColor, Uint32 newColor) {
+    if((surface->format->BytesPerPixel == 1) && (oldColor < 256)) {
+        Uint8 colorMap[256];
+        for(int i = 0; i < 256; i++) {
+            colorMap[i] = static_cast<Uint8>(i);
+        }
+        colorMap[oldColor] = static_cast<Uint8>(newColor);
+
+        mapColor(surface, colorMap);
+        return;
+    }
+
     if(!SDL_MUSTLOCK(surface) || (SDL_LockSurface(surface) == 0)) {
         for(int y = 0; y < surface->h; y++) {
             Uint8 *p = (Uint8 *)surface->pixels + (y * surface->pitch);
@@ -221,14 +276,11 @@ void replaceColor(SDL_Surface *surface, Uint32 oldColor, Uint32 newColor) {
     }
 }
 
-void mapColor(SDL_Surface *surface, Uint8 colorMap[256]) {
+void mapColor(SDL_Surface *surface, const Uint8 colorMap[256]) {
     if(!SDL_MUSTLOCK(surface) || (SDL_LockSurface(surface) == 0)) {
         for(int y = 0; y < surface->h; y++) {
             Uint8 *p = (Uint8 *)surface->pixels + (y * surface->pitch);
-
-            for(int x = 0; x < surface->w; x++, ++p) {
-                *p = colorMap[*p];
-            }
+            mapRowColors(p, p, surface->w, colorMap);
         }
 
         if(SDL_MUSTLOCK(surface)) {
@@ -237,6 +289,57 @@ void mapColor(SDL_Surface *surface, Uint8 colorMap[256]) {
     }
 }
 
+void mapRowColors(const Uint8* src, Uint8* dest, int width, const Uint8 colorMap[256]) {
+    // four independent lookups per iteration keep several loads in flight
+    int x = 0;
+    for(; x + 4 <= width; x += 4) {
+        const Uint8 c0 = colorMap[src[x]];
+        const Uint8 c1 = colorMap[src[x+1]];
+        const Uint8 c2 = colorMap[src[x+2]];
+        const Uint8 c3 = colorMap[src[x+3]];
+        dest[x] = c0;
+        dest[x+1] = c1;
+        dest[x+2] = c2;
+        dest[x+3] = c3;
+    }
+
+    for(; x < width; x++) {
+        dest[x] = colorMap[src[x]];
+    }
+}
+
+void mapRowColorsTo32(const Uint8* RESTRICT src, Uint32* RESTRICT dest, int width, const Uint32 colorMap[256]) {
+    int x = 0;
+    for(; x + 4 <= width; x += 4) {
+        dest[x] = colorMap[src[x]];
+        dest[x+1] = colorMap[src[x+1]];
+        dest[x+2] = colorMap[src[x+2]];
+        dest[x+3] = colorMap[src[x+3]];
+    }
+
+    for(; x < width; x++) {
+        dest[x] = colorMap[src[x]];
+    }
+}
+
+void mapRowColorRange(Uint8* RESTRICT row, int width, int srcColor, int destColor) {
+    const Uint8 first = static_cast<Uint8>(srcColor);
+    const Uint8 rangeSize = static_cast<Uint8>(std::min(7, 256 - srcColor));
+    const Uint8 offset = static_cast<Uint8>(destColor - srcColor);
+
+    for(int x = 0; x < width; x++) {
+        const Uint8 c = row[x];
+        // c - first wraps around for colors below the range, so one unsigned compare checks both ends
+        row[x] = (static_cast<Uint8>(c - first) < rangeSize) ? static_cast<Uint8>(c + offset) : c;
+    }
+}
+
+void initColorRangeMap(Uint8 colorMap[256], int srcColor, int destColor) {
+    for(int i = 0; i < 256; i++) {
+        colorMap[i] = ((i >= srcColor) && (i < srcColor + 7)) ? static_cast<Uint8>(i - srcColor + destColor) : static_cast<Uint8>(i);
+    }
+}
+
 
 sdl2::surface_ptr copySurface(SDL_Surface* inSurface) {
     //return SDL_DisplayFormat(inSurface);
@@ -592,11 +695,43 @@ sdl2::surface_ptr mapSurfaceColorRange(SDL_Surface* source, int srcColor, int de
     sdl2::surface_lock lock{ retPic.get() };
 
     for(auto y = 0; y < retPic->h; ++y) {
-        Uint8* RESTRICT p = static_cast<Uint8*>(retPic->pixels) + y * retPic->pitch;
-        for(auto x = 0; x < retPic->w; ++x, ++p) {
-            if ((*p >= srcColor) && (*p < srcColor + 7))
-                *p = *p - srcColor + destColor;
-        }
+        mapRowColorRange(static_cast<Uint8*>(retPic->pixels) + y * retPic->pitch, retPic->w, srcColor, destColor);
+    }
+
+    return retPic;
+}
+
+sdl2::surface_ptr mapSurfaceColorRange(SDL_Surface* source, int srcColor, int destColor, const Uint8 colorMap[256]) {
+    Uint8 combinedMap[256];
+    initColorRangeMap(combinedMap, srcColor, destColor);
+    for(int i = 0; i < 256; i++) {
+        combinedMap[i] = colorMap[combinedMap[i]];
+    }
+
+    return mapSurfaceColors(source, combinedMap);
+}
+
+sdl2::surface_ptr mapSurfaceColors(SDL_Surface* source, const Uint8 colorMap[256]) {
+    if (!source)
+        THROW(std::runtime_error, "mapSurfaceColors(): Null source!");
+
+    sdl2::surface_ptr retPic{ SDL_ConvertSurface(source,source->format,source->flags) };
+
+    if (!retPic)
+        THROW(std::runtime_error, "mapSurfaceColors(): Cannot copy image!");
+
+    if (retPic->format->BytesPerPixel != 1)
+        THROW(std::invalid_argument, "mapSurfaceColors(): Only 8-bit images can be mapped!");
+
+    if (retPic->format->BytesPerPixel == 1) {
+        SDL_SetSurfaceBlendMode(retPic.get(), SDL_BLENDMODE_NONE);
+    }
+
+    sdl2::surface_lock lock{ retPic.get() };
+
+    for(auto y = 0; y < retPic->h; ++y) {
+        Uint8* p = static_cast<Uint8*>(retPic->pixels) + y * retPic->pitch;
+        mapRowColors(p, p, retPic->w, colorMap);
     }
 
     return retPic;
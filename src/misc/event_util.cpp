@@ -0,0 +1,55 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <misc/event_util.h>
+
+static bool isMergeable(const SDL_Event& event, const SDL_Event& next, bool bCoalesceKeyRepeat) {
+    if((event.type == SDL_MOUSEMOTION) && (next.type == SDL_MOUSEMOTION)) {
+        return (event.motion.which == next.motion.which) && (event.motion.state == next.motion.state);
+    }
+
+    if(bCoalesceKeyRepeat && (event.type == SDL_KEYDOWN) && (next.type == SDL_KEYDOWN)) {
+        return event.key.repeat && next.key.repeat
+                && (event.key.keysym.scancode == next.key.keysym.scancode) && (event.key.keysym.mod == next.key.keysym.mod);
+    }
+
+    return false;
+}
+
+bool pollCoalescedEvent(SDL_Event& event, bool bCoalesceKeyRepeat) {
+    if(SDL_PollEvent(&event) == 0) {
+        return false;
+    }
+
+    SDL_Event next;
+    while((SDL_PeepEvents(&next, 1, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT) == 1) && isMergeable(event, next, bCoalesceKeyRepeat)) {
+        SDL_PeepEvents(&next, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+        if(event.type == SDL_MOUSEMOTION) {
+            const Sint32 xrel = event.motion.xrel + next.motion.xrel;
+            const Sint32 yrel = event.motion.yrel + next.motion.yrel;
+            event = next;
+            event.motion.xrel = xrel;
+            event.motion.yrel = yrel;
+        } else {
+            event = next;
+        }
+    }
+
+    return true;
+}
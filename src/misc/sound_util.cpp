@@ -11,6 +11,9 @@
 
 #include <SDL2/SDL_mixer.h>
 
+#include <algorithm>
+#include <cmath>
+
 sdl2::mix_chunk_ptr create_chunk()
 {
     return sdl2::mix_chunk_ptr{ static_cast<Mix_Chunk*>(SDL_malloc(sizeof(Mix_Chunk))) };
@@ -158,3 +161,221 @@ sdl2::mix_chunk_ptr getChunkFromFile(const std::string& filename, const std::str
     }
     return nullptr;
 }
+
+namespace {
+
+inline Uint8 Float2Uint8(float x) {
+    int val = lround(x*127.0f + 128.0f);
+    if(val < 0) {
+        val = 0;
+    } else if(val > 255) {
+        val = 255;
+    }
+
+    return (Uint8) val;
+}
+
+inline Sint8 Float2Sint8(float x) {
+    int val = lround(x*127.0f);
+    if(val < -128) {
+        val = -128;
+    } else if(val > 127) {
+        val = 127;
+    }
+
+    return (Sint8) val;
+}
+
+inline Uint16 Float2Uint16(float x) {
+    int val = lround(x*32767.0f + 32768.0f);
+    if(val < 0) {
+        val = 0;
+    } else if(val > 65535) {
+        val = 65535;
+    }
+
+    return (Uint16) val;
+}
+
+inline Sint16 Float2Sint16(float x) {
+    int val = lround(x*32767.0f);
+    if(val < -32768) {
+        val = -32768;
+    } else if(val > 32767) {
+        val = 32767;
+    }
+
+    return (Sint16) val;
+}
+
+/**
+    Writes every sample to all channels of the interleaved buffer dest.
+*/
+template<typename SampleType, typename ConvertFunc>
+void writeSamples(Uint8* dest, const float* samples, size_t numSamples, int channels, ConvertFunc convert) {
+    SampleType* target = reinterpret_cast<SampleType*>(dest);
+    for(size_t i = 0; i < numSamples; i++) {
+        const SampleType value = convert(samples[i]);
+        for(int j = 0; j < channels; j++) {
+            target[i*channels + j] = value;
+        }
+    }
+}
+
+int getSampleSize(Uint16 format) {
+    switch(format) {
+        case AUDIO_U8:
+        case AUDIO_S8:      return 1;
+        case AUDIO_U16LSB:
+        case AUDIO_S16LSB:
+        case AUDIO_U16MSB:
+        case AUDIO_S16MSB:  return 2;
+        default:            return 0;
+    }
+}
+
+float readSample(const Uint8* p, Uint16 format) {
+    switch(format) {
+        case AUDIO_U8:      return (p[0] - 128) / 128.0f;
+        case AUDIO_S8:      return static_cast<Sint8>(p[0]) / 128.0f;
+        case AUDIO_U16LSB:  return ((p[0] | (p[1] << 8)) - 32768) / 32768.0f;
+        case AUDIO_S16LSB:  return static_cast<Sint16>(p[0] | (p[1] << 8)) / 32768.0f;
+        case AUDIO_U16MSB:  return (((p[0] << 8) | p[1]) - 32768) / 32768.0f;
+        case AUDIO_S16MSB:  return static_cast<Sint16>((p[0] << 8) | p[1]) / 32768.0f;
+        default:            return 0.0f;
+    }
+}
+
+}
+
+std::vector<float> resampleSamples(const std::vector<float>& samples, int srcFrequency, int destFrequency) {
+    if((srcFrequency == destFrequency) || samples.empty()) {
+        return samples;
+    }
+
+    const double step = static_cast<double>(srcFrequency) / destFrequency;
+    const size_t numDestSamples = static_cast<size_t>(samples.size() / step);
+
+    // when downsampling the cutoff frequency has to be lowered to the new nyquist frequency
+    const double cutoff = std::min(1.0, 1.0 / step);
+
+    const int halfTaps = SOUND_RESAMPLER_TAPS / 2;
+    const double pi = 3.14159265358979323846;
+
+    // kernel[phase][k] is the weight of source sample (i - halfTaps + 1 + k) for the position i + phase/SOUND_RESAMPLER_PHASES
+    std::vector<float> kernel((SOUND_RESAMPLER_PHASES + 1) * SOUND_RESAMPLER_TAPS);
+    for(int phase = 0; phase <= SOUND_RESAMPLER_PHASES; phase++) {
+        float* weights = &kernel[phase * SOUND_RESAMPLER_TAPS];
+        double sum = 0.0;
+        for(int k = 0; k < SOUND_RESAMPLER_TAPS; k++) {
+            const double distance = (k - halfTaps + 1) - static_cast<double>(phase) / SOUND_RESAMPLER_PHASES;
+            const double x = pi * cutoff * distance;
+            const double sinc = (x == 0.0) ? 1.0 : std::sin(x) / x;
+            // Blackman window over [-halfTaps;halfTaps]
+            const double t = (distance + halfTaps) / SOUND_RESAMPLER_TAPS;
+            const double window = 0.42 - 0.5 * std::cos(2.0 * pi * t) + 0.08 * std::cos(4.0 * pi * t);
+            weights[k] = static_cast<float>(sinc * window);
+            sum += weights[k];
+        }
+
+        // no change of the volume of constant signals
+        for(int k = 0; k < SOUND_RESAMPLER_TAPS; k++) {
+            weights[k] = static_cast<float>(weights[k] / sum);
+        }
+    }
+
+    // pad with silence so that the dot product never has to check the bounds
+    std::vector<float> padded(samples.size() + SOUND_RESAMPLER_TAPS + 1, 0.0f);
+    std::copy(samples.begin(), samples.end(), padded.begin() + halfTaps);
+
+    std::vector<float> result(numDestSamples);
+    for(size_t n = 0; n < numDestSamples; n++) {
+        const double pos = n * step;
+        const size_t i = static_cast<size_t>(pos);
+        const int phase = static_cast<int>(lround((pos - i) * SOUND_RESAMPLER_PHASES));
+
+        const float* src = &padded[i + 1];
+        const float* weights = &kernel[phase * SOUND_RESAMPLER_TAPS];
+        float value = 0.0f;
+        for(int k = 0; k < SOUND_RESAMPLER_TAPS; k++) {
+            value += src[k] * weights[k];
+        }
+        result[n] = value;
+    }
+
+    return result;
+}
+
+sdl2::mix_chunk_ptr createChunkFromSamples(const float* samples, size_t numSamples) {
+    int frequency, channels;
+    Uint16 format;
+    if(Mix_QuerySpec(&frequency, &format, &channels) == 0) {
+        THROW(std::runtime_error, "createChunkFromSamples(): Mix_QuerySpec failed!");
+    }
+
+    const int sampleSize = getSampleSize(format);
+    if(sampleSize == 0) {
+        THROW(std::runtime_error, "createChunkFromSamples(): Invalid target sample format!");
+    }
+
+    auto myChunk = sdl2::mix_chunk_ptr{ (Mix_Chunk*) SDL_calloc(sizeof(Mix_Chunk),1) };
+    if(myChunk == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    myChunk->allocated = 1;
+    myChunk->volume = 128;
+
+    if((myChunk->abuf = (Uint8*) SDL_malloc(numSamples * sampleSize * channels)) == nullptr) {
+        throw std::bad_alloc();
+    }
+    myChunk->alen = numSamples * sampleSize * channels;
+
+    switch(format) {
+        case AUDIO_U8:      writeSamples<Uint8>(myChunk->abuf, samples, numSamples, channels, [](float x) { return Float2Uint8(x); });                   break;
+        case AUDIO_S8:      writeSamples<Sint8>(myChunk->abuf, samples, numSamples, channels, [](float x) { return Float2Sint8(x); });                   break;
+        case AUDIO_U16LSB:  writeSamples<Uint16>(myChunk->abuf, samples, numSamples, channels, [](float x) { return SDL_SwapLE16(Float2Uint16(x)); }); break;
+        case AUDIO_S16LSB:  writeSamples<Sint16>(myChunk->abuf, samples, numSamples, channels, [](float x) { return (Sint16) SDL_SwapLE16(Float2Sint16(x)); }); break;
+        case AUDIO_U16MSB:  writeSamples<Uint16>(myChunk->abuf, samples, numSamples, channels, [](float x) { return SDL_SwapBE16(Float2Uint16(x)); }); break;
+        case AUDIO_S16MSB:  writeSamples<Sint16>(myChunk->abuf, samples, numSamples, channels, [](float x) { return (Sint16) SDL_SwapBE16(Float2Sint16(x)); }); break;
+        default:            break;
+    }
+
+    return myChunk;
+}
+
+sdl2::mix_chunk_ptr convertChunkToDeviceFormat(sdl2::mix_chunk_ptr pChunk, int frequency, Uint16 format, int channels) {
+    int deviceFrequency, deviceChannels;
+    Uint16 deviceFormat;
+    if(Mix_QuerySpec(&deviceFrequency, &deviceFormat, &deviceChannels) == 0) {
+        THROW(std::runtime_error, "convertChunkToDeviceFormat(): Mix_QuerySpec failed!");
+    }
+
+    if((pChunk == nullptr) || ((frequency == deviceFrequency) && (format == deviceFormat) && (channels == deviceChannels))) {
+        return pChunk;
+    }
+
+    const int sampleSize = getSampleSize(format);
+    if((sampleSize == 0) || (channels <= 0)) {
+        THROW(std::invalid_argument, "convertChunkToDeviceFormat(): Unsupported sample format!");
+    }
+
+    const int frameSize = sampleSize * channels;
+    const size_t numFrames = pChunk->alen / frameSize;
+
+    std::vector<float> samples(numFrames);
+    for(size_t i = 0; i < numFrames; i++) {
+        const Uint8* frame = pChunk->abuf + i * frameSize;
+        float sum = 0.0f;
+        for(int j = 0; j < channels; j++) {
+            sum += readSample(frame + j * sampleSize, format);
+        }
+        samples[i] = sum / channels;
+    }
+
+    const std::vector<float> resampled = resampleSamples(samples, frequency, deviceFrequency);
+
+    auto pConvertedChunk = createChunkFromSamples(resampled.data(), resampled.size());
+    pConvertedChunk->volume = pChunk->volume;
+    return pConvertedChunk;
+}
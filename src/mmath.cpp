@@ -81,3 +81,25 @@ int zoomedWorld2world(int x) {
 Coord zoomedWorld2world(const Coord& coord) {
     return Coord(zoomedWorld2world(coord.x), zoomedWorld2world(coord.y));
 }
+
+const std::vector<BlockDistanceOffset>& getBlockDistanceOffsets() {
+    static const std::vector<BlockDistanceOffset> offsets = []() {
+        std::vector<BlockDistanceOffset> result;
+
+        Coord offset;
+        for(offset.y = -BLOCKDISTANCE_OFFSETS_MAXRANGE; offset.y <= BLOCKDISTANCE_OFFSETS_MAXRANGE; offset.y++) {
+            for(offset.x = -BLOCKDISTANCE_OFFSETS_MAXRANGE; offset.x <= BLOCKDISTANCE_OFFSETS_MAXRANGE; offset.x++) {
+                const FixPoint distance = blockDistance(Coord(0,0), offset);
+                if(distance <= BLOCKDISTANCE_OFFSETS_MAXRANGE) {
+                    result.push_back({offset, distance});
+                }
+            }
+        }
+
+        // stable: tiles with the same distance stay in row order
+        std::stable_sort(result.begin(), result.end(), [](const BlockDistanceOffset& a, const BlockDistanceOffset& b) { return a.distance < b.distance; });
+        return result;
+    }();
+
+    return offsets;
+}
@@ -38,6 +38,8 @@
 
 AIPlayer::AIPlayer(House* associatedHouse, const std::string& playername, Difficulty difficulty)
  : Player(associatedHouse, playername), difficulty(difficulty) {
+    AIPlayer::init();
+
     attackTimer = ((2-static_cast<Uint8>(difficulty)) * MILLI2CYCLES(2*60*1000)) + getRandomGen().rand(MILLI2CYCLES(8*60*1000), MILLI2CYCLES(11*60*1000));
     buildTimer = getRandomGen().rand(0,3) * 50;
 }
@@ -59,6 +61,9 @@ AIPlayer::AIPlayer(InputStream& stream, House* associatedHouse) : Player(stream,
 }
 
 void AIPlayer::init() {
+    scheduler.addTask("checkAllUnits", AIUPDATEINTERVAL);
+    scheduler.addTask("build", AIUPDATEINTERVAL);
+    scheduler.addTask("attack", AIUPDATEINTERVAL);
 }
 
 
@@ -81,24 +86,28 @@ void AIPlayer::save(OutputStream& stream) const {
 
 
 void AIPlayer::update() {
-    if( (getGameCycleCount() + getHouse()->getHouseID()) % AIUPDATEINTERVAL != 0) {
-        // we are not updating this AI player this cycle
-        return;
-    }
-
-    checkAllUnits();
-
-    if(buildTimer <= 0) {
-        build();
-    } else {
-        buildTimer -= AIUPDATEINTERVAL;
-    }
+    const auto houseID = getHouse()->getHouseID();
+    const auto gameCycle = getGameCycleCount();
+
+    scheduler.runIfDue(AITask_CheckAllUnits, houseID, gameCycle, [&]() {
+        checkAllUnits();
+    });
+
+    scheduler.runIfDue(AITask_Build, houseID, gameCycle, [&]() {
+        if(buildTimer <= 0) {
+            build();
+        } else {
+            buildTimer -= AIUPDATEINTERVAL;
+        }
+    });
 
-    if(attackTimer <= 0) {
-        attack();
-    } else {
-        attackTimer -= AIUPDATEINTERVAL;
-    }
+    scheduler.runIfDue(AITask_Attack, houseID, gameCycle, [&]() {
+        if(attackTimer <= 0) {
+            attack();
+        } else {
+            attackTimer -= AIUPDATEINTERVAL;
+        }
+    });
 }
 
 void AIPlayer::onObjectWasBuilt(const ObjectBase* pObject) {
@@ -261,15 +270,7 @@ Coord AIPlayer::findPlaceLocation(Uint32 itemID) {
                 case Structure_GunTurret:
                 case Structure_RocketTurret: {
                     // place towards enemy
-                    FixPoint nearestEnemy = 10000000;
-                    for(const StructureBase* pStructure : getStructureList()) {
-                        if(pStructure->getOwner()->getTeamID() != getHouse()->getTeamID()) {
-                            FixPoint distance = blockDistance(pos, pStructure->getLocation());
-                            if(distance < nearestEnemy) {
-                                nearestEnemy = distance;
-                            }
-                        }
-                    }
+                    FixPoint nearestEnemy = getMap().getInfluenceMap().getDistanceToNearestEnemyStructure(getHouse()->getTeamID(), pos, 10000000);
 
                     rating = 10000000 - nearestEnemy;
                 } break;
@@ -282,15 +283,7 @@ Coord AIPlayer::findPlaceLocation(Uint32 itemID) {
                 case Structure_WindTrap:
                 default: {
                     // place at a save place
-                    FixPoint nearestEnemy = 10000000;
-                    for(const StructureBase* pStructure : getStructureList()) {
-                        if(pStructure->getOwner()->getTeamID() != getHouse()->getTeamID()) {
-                            FixPoint distance = blockDistance(pos, pStructure->getLocation());
-                            if(distance < nearestEnemy) {
-                                nearestEnemy = distance;
-                            }
-                        }
-                    }
+                    FixPoint nearestEnemy = getMap().getInfluenceMap().getDistanceToNearestEnemyStructure(getHouse()->getTeamID(), pos, 10000000);
 
                     rating = nearestEnemy;
                     rating *= (1+getNumAdjacentStructureTiles(pos, structureSizeX, structureSizeY));
@@ -0,0 +1,53 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <players/AIScheduler.h>
+
+#include <algorithm>
+
+int AIScheduler::addTask(const std::string& name, Uint32 interval, Uint32 budget) {
+    tasks.push_back( { name, std::max(interval, 1u), budget, 0 } );
+    return static_cast<int>(tasks.size()) - 1;
+}
+
+bool AIScheduler::isDue(int taskID, int houseID, Uint32 gameCycle) const {
+    const auto& task = tasks[taskID];
+
+    // spread the subtasks of all houses evenly over the interval
+    const Uint32 numSlots = NUM_HOUSES * tasks.size();
+    const Uint32 slot = houseID * tasks.size() + taskID;
+    const Uint32 phase = (slot * task.interval) / numSlots;
+
+    return (gameCycle % task.interval) == phase;
+}
+
+void AIScheduler::reportDuration(int taskID, int houseID, Uint32 gameCycle, Uint64 ticks) {
+    auto& task = tasks[taskID];
+
+    const auto duration = static_cast<Uint32>((ticks * 1000000) / SDL_GetPerformanceFrequency());
+    if(duration <= task.budget) {
+        return;
+    }
+
+    task.numOverruns++;
+
+    // only report the first overrun and then every time the number of overruns doubled
+    if((task.numOverruns & (task.numOverruns - 1)) == 0) {
+        SDL_Log("AI subtask '%s' of house %d exceeded its budget in game cycle %u: %u us > %u us (%u overruns so far)",
+                task.name.c_str(), houseID, gameCycle, duration, task.budget, task.numOverruns);
+    }
+}
@@ -94,6 +94,7 @@ static std::map<Uint32, int> targetPriorityMap = {
 
 CampaignAIPlayer::CampaignAIPlayer(House* associatedHouse, const std::string& playername)
  : Player(associatedHouse, playername) {
+    CampaignAIPlayer::init();
 }
 
 CampaignAIPlayer::CampaignAIPlayer(InputStream& stream, House* associatedHouse) : Player(stream, associatedHouse) {
@@ -106,6 +107,8 @@ CampaignAIPlayer::CampaignAIPlayer(InputStream& stream, House* associatedHouse)
 }
 
 void CampaignAIPlayer::init() {
+    scheduler.addTask("updateStructures", AIUPDATEINTERVAL);
+    scheduler.addTask("updateUnits", AIUPDATEINTERVAL);
 }
 
 
@@ -123,18 +126,21 @@ void CampaignAIPlayer::save(OutputStream& stream) const {
 
 
 void CampaignAIPlayer::update() {
-    if( (getGameCycleCount() + getHouse()->getHouseID()) % AIUPDATEINTERVAL != 0) {
-        // we are not updating this AI player this cycle
-        return;
-    }
-
     if(!getHouse()->hadDirectContactWithEnemy()) {
         // we are not doing anything until we had contact with the enemy
         return;
     }
 
-    updateStructures();
-    updateUnits();
+    const auto houseID = getHouse()->getHouseID();
+    const auto gameCycle = getGameCycleCount();
+
+    scheduler.runIfDue(AITask_UpdateStructures, houseID, gameCycle, [&]() {
+        updateStructures();
+    });
+
+    scheduler.runIfDue(AITask_UpdateUnits, houseID, gameCycle, [&]() {
+        updateUnits();
+    });
 }
 
 void CampaignAIPlayer::onObjectWasBuilt(const ObjectBase* pObject) {
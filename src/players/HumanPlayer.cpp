@@ -45,7 +45,7 @@ HumanPlayer::HumanPlayer(InputStream& stream, House* associatedHouse) : Player(s
     HumanPlayer::init();
 
     for(int i=0;i < NUMSELECTEDLISTS; i++) {
-        selectedLists[i] = stream.readUint32Set();
+        selectedLists[i] = ObjectIDSet(stream.readUint32Vector());
     }
 
     alreadyShownTutorialHints = stream.readUint32();
@@ -63,7 +63,7 @@ void HumanPlayer::save(OutputStream& stream) const {
 
     // write out selection groups (Key 1 to 9)
     for(int i=0; i < NUMSELECTEDLISTS; i++) {
-        stream.writeUint32Set(selectedLists[i]);
+        stream.writeUint32Vector(selectedLists[i].getIDs());
     }
 
     stream.writeUint32(alreadyShownTutorialHints);
@@ -138,7 +138,7 @@ void HumanPlayer::onUnitDeployed(const UnitBase* pUnit) {
 
 }
 
-void HumanPlayer::onSelectionChanged(const std::set<Uint32>& selectedObjectIDs) {
+void HumanPlayer::onSelectionChanged(const ObjectIDSet& selectedObjectIDs) {
     if(!settings.general.showTutorialHints || (currentGame->gameState != GameState::Running)) {
         return;
     }
@@ -157,7 +157,7 @@ void HumanPlayer::onSelectionChanged(const std::set<Uint32>& selectedObjectIDs)
     }
 }
 
-void HumanPlayer::setGroupList(int groupListIndex, const std::set<Uint32>& newGroupList) {
+void HumanPlayer::setGroupList(int groupListIndex, const ObjectIDSet& newGroupList) {
     selectedLists[groupListIndex].clear();
 
     for(Uint32 objectID : newGroupList) {
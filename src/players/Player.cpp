@@ -35,17 +35,25 @@
 #include <units/MCV.h>
 
 #include <misc/Random.h>
+#include <misc/AsyncLog.h>
 
 #include <sand.h>
 #include <globals.h>
 
+#define PLAYER_RANDOMSTREAM_BASE    0x80000000u     ///< the random streams of the players start here, far above the object ids used as streams of the objects
+#define PLAYER_RANDOMSTREAMS_PER_HOUSE  256         ///< the number of random streams reserved for the players of one house
+
 
 Player::Player(House* associatedHouse, const std::string& playername) : pHouse(associatedHouse), playerID(0), playername(playername) {
+    // the player is added to its house after construction, so the size of the player list is its index
+    const Uint32 streamID = PLAYER_RANDOMSTREAM_BASE + associatedHouse->getHouseID() * PLAYER_RANDOMSTREAMS_PER_HOUSE + associatedHouse->getPlayerList().size();
+    randomGen = Random::forStream(currentGame->getGameInitSettings().getRandomSeed(), streamID);
 }
 
 Player::Player(InputStream& stream, House* associatedHouse) : pHouse(associatedHouse) {
     playerID = stream.readUint8();
     playername = stream.readString();
+    randomGen.setSeed(stream.readUint32());
 }
 
 Player::~Player() {
@@ -55,32 +63,80 @@ Player::~Player() {
 void Player::save(OutputStream& stream) const {
     stream.writeUint8(playerID);
     stream.writeString(playername);
+    stream.writeUint32(randomGen.getSeed());
+}
+
+void Player::beginPlanning() {
+    frozenStructureList.clear();
+    for(const StructureBase* pStructure : structureList) {
+        frozenStructureList.push_back(pStructure);
+    }
+
+    frozenUnitList.clear();
+    for(const UnitBase* pUnit : unitList) {
+        frozenUnitList.push_back(pUnit);
+    }
+
+    bPlanning = true;
+}
+
+void Player::commitOrders() {
+    bPlanning = false;
+
+    // the frozen lists might contain objects destroyed by the orders
+    frozenStructureList.clear();
+    frozenUnitList.clear();
+
+    for(const Order& order : pendingOrders) {
+        ObjectBase* pObject = currentGame->getObjectManager().getObject(order.objectID);
+        if((pObject != nullptr) && (pObject->getOwner() == getHouse()) && pObject->isActive()) {
+            order.order(pObject);
+        }
+    }
+    pendingOrders.clear();
+}
+
+bool Player::giveOrder(const ObjectBase* pObject, std::function<bool (ObjectBase*)>&& order) const {
+    if(bPlanning) {
+        pendingOrders.push_back(Order{ pObject->getObjectID(), std::move(order) });
+        return true;
+    }
+
+    return order(const_cast<ObjectBase*>(pObject));
 }
 
 void Player::logDebug(const char* fmt, ...) const {
 #ifdef DEBUG_AI
-    std::string house = getHouseNameByNumber((HOUSETYPE) pHouse->getHouseID());
-    fprintf(stderr, "%s (%s):   ", playername.c_str(), house.c_str());
+    if(SDL_LogGetPriority(LOG_CATEGORY_AI) > SDL_LOG_PRIORITY_DEBUG) {
+        return;
+    }
+
     va_list arg;
     va_start(arg, fmt);
-    vfprintf(stderr, fmt, arg);
+    logMessage(SDL_LOG_PRIORITY_DEBUG, fmt, arg);
     va_end(arg);
-    fprintf(stderr, "\n");
 #endif
 }
 
 void Player::logWarn(const char* fmt, ...) const {
-    std::string house = getHouseNameByNumber((HOUSETYPE) pHouse->getHouseID());
-    fprintf(stderr, "%s (%s):   ", playername.c_str(), house.c_str());
+    if(SDL_LogGetPriority(LOG_CATEGORY_AI) > SDL_LOG_PRIORITY_WARN) {
+        return;
+    }
+
     va_list arg;
     va_start(arg, fmt);
-    vfprintf(stderr, fmt, arg);
+    logMessage(SDL_LOG_PRIORITY_WARN, fmt, arg);
     va_end(arg);
-    fprintf(stderr, "\n");
 }
 
-Random& Player::getRandomGen() const {
-    return currentGame->randomGen;
+void Player::logMessage(SDL_LogPriority priority, const char* fmt, va_list arg) const {
+    static const char* const houseNames[NUM_HOUSES] = { "Harkonnen", "Atreides", "Ordos", "Fremen", "Sardaukar", "Mercenary" };
+
+    char message[SDL_MAX_LOG_MESSAGE];
+    vsnprintf(message, sizeof(message), fmt, arg);
+
+    const int houseID = pHouse->getHouseID();
+    SDL_LogMessage(LOG_CATEGORY_AI, priority, "%s (%s):   %s", playername.c_str(), ((houseID >= 0) && (houseID < NUM_HOUSES)) ? houseNames[houseID] : "?", message);
 }
 
 const GameInitSettings& Player::getGameInitSettings() const {
@@ -103,12 +159,12 @@ const ObjectBase* Player::getObject(Uint32 objectID) const {
     return currentGame->getObjectManager().getObject(objectID);
 }
 
-const RobustList<const StructureBase*>& Player::getStructureList() const {
-    return reinterpret_cast<const RobustList<const StructureBase*>&>(structureList);
+const EntityList<const StructureBase*>& Player::getStructureList() const {
+    return bPlanning ? frozenStructureList : reinterpret_cast<const EntityList<const StructureBase*>&>(structureList);
 }
 
-const RobustList<const UnitBase*>& Player::getUnitList() const {
-    return reinterpret_cast<const RobustList<const UnitBase*>&>(unitList);
+const EntityList<const UnitBase*>& Player::getUnitList() const {
+    return bPlanning ? frozenUnitList : reinterpret_cast<const EntityList<const UnitBase*>&>(unitList);
 }
 
 const House* Player::getHouse(int houseID) const {
@@ -120,7 +176,10 @@ const House* Player::getHouse(int houseID) const {
 
 void Player::doRepair(const ObjectBase* pObject) const {
     if(pObject->getOwner() == getHouse() && pObject->isActive()) {
-        const_cast<ObjectBase*>(pObject)->doRepair();
+        giveOrder(pObject, [](ObjectBase* pOrderedObject) {
+            pOrderedObject->doRepair();
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to repair a structure or unit he doesn't own or that is inactive!\n", playername.c_str());
     }
@@ -128,7 +187,10 @@ void Player::doRepair(const ObjectBase* pObject) const {
 
 void Player::doSetDeployPosition(const StructureBase* pStructure, int x, int y) const {
     if(pStructure->getOwner() == getHouse() && pStructure->isActive()) {
-        const_cast<StructureBase*>(pStructure)->doSetDeployPosition(x, y);
+        giveOrder(pStructure, [x, y](ObjectBase* pOrderedObject) {
+            static_cast<StructureBase*>(pOrderedObject)->doSetDeployPosition(x, y);
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to set the deploy position of a structure he doesn't own or that is inactive!\n", playername.c_str());
     }
@@ -136,7 +198,9 @@ void Player::doSetDeployPosition(const StructureBase* pStructure, int x, int y)
 
 bool Player::doUpgrade(const BuilderBase* pBuilder) const {
     if(pBuilder->getOwner() == getHouse() && pBuilder->isActive()) {
-        return const_cast<BuilderBase*>(pBuilder)->doUpgrade();
+        return giveOrder(pBuilder, [](ObjectBase* pOrderedObject) {
+            return static_cast<BuilderBase*>(pOrderedObject)->doUpgrade();
+        });
     } else {
         logWarn("The player '%s' tries to upgrade a structure he doesn't own or that is inactive!\n", playername.c_str());
         return false;
@@ -145,7 +209,10 @@ bool Player::doUpgrade(const BuilderBase* pBuilder) const {
 
 void Player::doProduceItem(const BuilderBase* pBuilder, Uint32 itemID) const {
     if(pBuilder->getOwner() == getHouse() && pBuilder->isActive()) {
-        const_cast<BuilderBase*>(pBuilder)->doProduceItem(itemID);
+        giveOrder(pBuilder, [itemID](ObjectBase* pOrderedObject) {
+            static_cast<BuilderBase*>(pOrderedObject)->doProduceItem(itemID);
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to build some item in a structure he doesn't own or that is inactive!\n", playername.c_str());
     }
@@ -153,7 +220,10 @@ void Player::doProduceItem(const BuilderBase* pBuilder, Uint32 itemID) const {
 
 void Player::doCancelItem(const BuilderBase* pBuilder, Uint32 itemID) const {
     if(pBuilder->getOwner() == getHouse() && pBuilder->isActive()) {
-        const_cast<BuilderBase*>(pBuilder)->doCancelItem(itemID);
+        giveOrder(pBuilder, [itemID](ObjectBase* pOrderedObject) {
+            static_cast<BuilderBase*>(pOrderedObject)->doCancelItem(itemID);
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to cancel production of some item in a structure he doesn't own or that is inactive!\n", playername.c_str());
     }
@@ -161,7 +231,10 @@ void Player::doCancelItem(const BuilderBase* pBuilder, Uint32 itemID) const {
 
 void Player::doSetOnHold(const BuilderBase* pBuilder, bool bOnHold) const {
     if(pBuilder->getOwner() == getHouse() && pBuilder->isActive()) {
-        const_cast<BuilderBase*>(pBuilder)->doSetOnHold(bOnHold);
+        giveOrder(pBuilder, [bOnHold](ObjectBase* pOrderedObject) {
+            static_cast<BuilderBase*>(pOrderedObject)->doSetOnHold(bOnHold);
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to hold/resume production in a structure he doesn't own or that is inactive!\n", playername.c_str());
     }
@@ -169,7 +242,10 @@ void Player::doSetOnHold(const BuilderBase* pBuilder, bool bOnHold) const {
 
 void Player::doSetBuildSpeedLimit(const BuilderBase* pBuilder, FixPoint buildSpeedLimit) const {
     if(pBuilder->getOwner() == getHouse() && pBuilder->isActive()) {
-        const_cast<BuilderBase*>(pBuilder)->doSetBuildSpeedLimit(buildSpeedLimit);
+        giveOrder(pBuilder, [buildSpeedLimit](ObjectBase* pOrderedObject) {
+            static_cast<BuilderBase*>(pOrderedObject)->doSetBuildSpeedLimit(buildSpeedLimit);
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to limit the build speed of a structure he doesn't own or that is inactive!\n", playername.c_str());
     }
@@ -177,7 +253,10 @@ void Player::doSetBuildSpeedLimit(const BuilderBase* pBuilder, FixPoint buildSpe
 
 void Player::doBuildRandom(const BuilderBase* pBuilder) const {
     if(pBuilder->getOwner() == getHouse() && pBuilder->isActive()) {
-        const_cast<BuilderBase*>(pBuilder)->doBuildRandom();
+        giveOrder(pBuilder, [](ObjectBase* pOrderedObject) {
+            static_cast<BuilderBase*>(pOrderedObject)->doBuildRandom();
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to randomly build some item in a structure he doesn't own or that is inactive!\n", playername.c_str());
     }
@@ -185,7 +264,10 @@ void Player::doBuildRandom(const BuilderBase* pBuilder) const {
 
 void Player::doPlaceOrder(const StarPort* pStarport) const {
     if(pStarport->getOwner() == getHouse() && pStarport->isActive()) {
-        const_cast<StarPort*>(pStarport)->doPlaceOrder();
+        giveOrder(pStarport, [](ObjectBase* pOrderedObject) {
+            static_cast<StarPort*>(pOrderedObject)->doPlaceOrder();
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to order something from a starport he doesn't own or that is inactive!\n", playername.c_str());
     }
@@ -193,7 +275,9 @@ void Player::doPlaceOrder(const StarPort* pStarport) const {
 
 bool Player::doPlaceStructure(const ConstructionYard* pConstYard, int x, int y) const {
     if(pConstYard->getOwner() == getHouse() && pConstYard->isActive()) {
-        return const_cast<ConstructionYard*>(pConstYard)->doPlaceStructure(x, y);
+        return giveOrder(pConstYard, [x, y](ObjectBase* pOrderedObject) {
+            return static_cast<ConstructionYard*>(pOrderedObject)->doPlaceStructure(x, y);
+        });
     } else {
         logWarn("The player '%s' tries to place a structure he hasn't produced (or the construction yard is inactive)!\n", playername.c_str());
         return false;
@@ -202,7 +286,10 @@ bool Player::doPlaceStructure(const ConstructionYard* pConstYard, int x, int y)
 
 void Player::doSpecialWeapon(const Palace* pPalace) const {
     if(pPalace->getOwner() == getHouse() && pPalace->isActive()) {
-        const_cast<Palace*>(pPalace)->doSpecialWeapon();
+        giveOrder(pPalace, [](ObjectBase* pOrderedObject) {
+            static_cast<Palace*>(pOrderedObject)->doSpecialWeapon();
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to activate a special weapon from a palace he doesn't own or that is inactive!\n", playername.c_str());
     }
@@ -210,7 +297,10 @@ void Player::doSpecialWeapon(const Palace* pPalace) const {
 
 void Player::doLaunchDeathhand(const Palace* pPalace, int x, int y) const {
     if(pPalace->getOwner() == getHouse() && pPalace->isActive()) {
-        const_cast<Palace*>(pPalace)->doLaunchDeathhand(x, y);
+        giveOrder(pPalace, [x, y](ObjectBase* pOrderedObject) {
+            static_cast<Palace*>(pOrderedObject)->doLaunchDeathhand(x, y);
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to launch a deathhand from a palace he doesn't own or that is inactive!\n", playername.c_str());
     }
@@ -218,7 +308,11 @@ void Player::doLaunchDeathhand(const Palace* pPalace, int x, int y) const {
 
 void Player::doAttackObject(const TurretBase* pTurret, const ObjectBase* pTargetObject) const {
     if(pTurret->getOwner() == getHouse() && pTurret->isActive()) {
-        const_cast<TurretBase*>(pTurret)->doAttackObject(pTargetObject);
+        const Uint32 targetID = (pTargetObject != nullptr) ? pTargetObject->getObjectID() : NONE_ID;
+        giveOrder(pTurret, [targetID](ObjectBase* pOrderedObject) {
+            static_cast<TurretBase*>(pOrderedObject)->doAttackObject(targetID);
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to attack with a turret he doesn't own or that is inactive!\n", playername.c_str());
         return;
@@ -229,7 +323,10 @@ void Player::doAttackObject(const TurretBase* pTurret, const ObjectBase* pTarget
 
 void Player::doMove2Pos(const UnitBase* pUnit, int x, int y, bool bForced) const {
     if(pUnit->getOwner() == getHouse() && pUnit->isActive()) {
-        const_cast<UnitBase*>(pUnit)->doMove2Pos(x, y, bForced);
+        giveOrder(pUnit, [x, y, bForced](ObjectBase* pOrderedObject) {
+            static_cast<UnitBase*>(pOrderedObject)->doMove2Pos(x, y, bForced);
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to move a unit he doesn't own or that is inactive!\n", playername.c_str());
         return;
@@ -238,7 +335,11 @@ void Player::doMove2Pos(const UnitBase* pUnit, int x, int y, bool bForced) const
 
 void Player::doMove2Object(const UnitBase* pUnit, const ObjectBase* pTargetObject) const {
     if(pUnit->getOwner() == getHouse() && pUnit->isActive()) {
-        const_cast<UnitBase*>(pUnit)->doMove2Object(pTargetObject);
+        const Uint32 targetID = pTargetObject->getObjectID();
+        giveOrder(pUnit, [targetID](ObjectBase* pOrderedObject) {
+            static_cast<UnitBase*>(pOrderedObject)->doMove2Object(targetID);
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to move a unit (to an object) he doesn't own or that is inactive!\n", playername.c_str());
         return;
@@ -247,7 +348,10 @@ void Player::doMove2Object(const UnitBase* pUnit, const ObjectBase* pTargetObjec
 
 void Player::doAttackPos(const UnitBase* pUnit, int x, int y, bool bForced) const {
     if(pUnit->getOwner() == getHouse() && pUnit->isActive()) {
-        const_cast<UnitBase*>(pUnit)->doAttackPos(x, y, bForced);
+        giveOrder(pUnit, [x, y, bForced](ObjectBase* pOrderedObject) {
+            static_cast<UnitBase*>(pOrderedObject)->doAttackPos(x, y, bForced);
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to order a unit (to attack a position) he doesn't own or that is inactive!\n", playername.c_str());
         return;
@@ -256,7 +360,11 @@ void Player::doAttackPos(const UnitBase* pUnit, int x, int y, bool bForced) cons
 
 void Player::doAttackObject(const UnitBase* pUnit, const ObjectBase* pTargetObject, bool bForced) const {
     if(pUnit->getOwner() == getHouse() && pUnit->isActive()) {
-        const_cast<UnitBase*>(pUnit)->doAttackObject(pTargetObject, bForced);
+        const Uint32 targetID = pTargetObject->getObjectID();
+        giveOrder(pUnit, [targetID, bForced](ObjectBase* pOrderedObject) {
+            static_cast<UnitBase*>(pOrderedObject)->doAttackObject(targetID, bForced);
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to attack with a unit he doesn't own or that is inactive!\n", playername.c_str());
         return;
@@ -265,7 +373,10 @@ void Player::doAttackObject(const UnitBase* pUnit, const ObjectBase* pTargetObje
 
 void Player::doSetAttackMode(const UnitBase* pUnit, ATTACKMODE attackMode) const {
     if(pUnit->getOwner() == getHouse() && pUnit->isActive()) {
-        const_cast<UnitBase*>(pUnit)->doSetAttackMode(attackMode);
+        giveOrder(pUnit, [attackMode](ObjectBase* pOrderedObject) {
+            static_cast<UnitBase*>(pOrderedObject)->doSetAttackMode(attackMode);
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to change the attack mode of a unit he doesn't own or that is inactive!\n", playername.c_str());
         return;
@@ -274,7 +385,10 @@ void Player::doSetAttackMode(const UnitBase* pUnit, ATTACKMODE attackMode) const
 
 void Player::doStartDevastate(const Devastator* pDevastator) const {
     if(pDevastator->getOwner() == getHouse() && pDevastator->isActive()) {
-        const_cast<Devastator*>(pDevastator)->doStartDevastate();
+        giveOrder(pDevastator, [](ObjectBase* pOrderedObject) {
+            static_cast<Devastator*>(pOrderedObject)->doStartDevastate();
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to devastate a devastator he doesn't own or that is inactive!\n", playername.c_str());
         return;
@@ -283,7 +397,10 @@ void Player::doStartDevastate(const Devastator* pDevastator) const {
 
 void Player::doReturn(const Harvester* pHarvester) const {
     if(pHarvester->getOwner() == getHouse() && pHarvester->isActive()) {
-        const_cast<Harvester*>(pHarvester)->doReturn();
+        giveOrder(pHarvester, [](ObjectBase* pOrderedObject) {
+            static_cast<Harvester*>(pOrderedObject)->doReturn();
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to return a harvester he doesn't own or that is inactive!\n", playername.c_str());
         return;
@@ -292,7 +409,11 @@ void Player::doReturn(const Harvester* pHarvester) const {
 
 void Player::doCaptureStructure(const InfantryBase* pInfantry, const StructureBase* pTargetStructure) const {
     if(pInfantry->getOwner() == getHouse() && pInfantry->isActive()) {
-        const_cast<InfantryBase*>(pInfantry)->doCaptureStructure(pTargetStructure);
+        const Uint32 targetID = (pTargetStructure != nullptr) ? pTargetStructure->getObjectID() : NONE_ID;
+        giveOrder(pInfantry, [targetID](ObjectBase* pOrderedObject) {
+            static_cast<InfantryBase*>(pOrderedObject)->doCaptureStructure(targetID);
+            return true;
+        });
     } else {
         logWarn("The player '%s' tries to capture with a unit he doesn't own or that is inactive!\n", playername.c_str());
         return;
@@ -301,7 +422,9 @@ void Player::doCaptureStructure(const InfantryBase* pInfantry, const StructureBa
 
 bool Player::doDeploy(const MCV* pMCV) const {
     if(pMCV->getOwner() == getHouse() && pMCV->isActive()) {
-        return const_cast<MCV*>(pMCV)->doDeploy();
+        return giveOrder(pMCV, [](ObjectBase* pOrderedObject) {
+            return static_cast<MCV*>(pOrderedObject)->doDeploy();
+        });
     } else {
         logWarn("The player '%s' tries to deploy a MCV he doesn't own or that is inactive!\n", playername.c_str());
         return false;
@@ -311,7 +434,9 @@ bool Player::doDeploy(const MCV* pMCV) const {
 
 bool Player::doRequestCarryallDrop(const GroundUnit* pGroundUnit) const {
     if(pGroundUnit->getOwner() == getHouse() && pGroundUnit->isActive()) {
-        return const_cast<GroundUnit*>(pGroundUnit)->requestCarryall();
+        return giveOrder(pGroundUnit, [](ObjectBase* pOrderedObject) {
+            return static_cast<GroundUnit*>(pOrderedObject)->requestCarryall();
+        });
     } else {
         logWarn("The player '%s' tries request a carryall for a ground unit he doesn't own or that is inactive!\n", playername.c_str());
         return false;
@@ -38,6 +38,7 @@
 #include <units/Devastator.h>
 
 #include <algorithm>
+#include <vector>
 
 #define AIUPDATEINTERVAL 50
 
@@ -122,6 +123,7 @@
 
 QuantBot::QuantBot(House* associatedHouse, const std::string& playername, Difficulty difficulty)
 : Player(associatedHouse, playername), difficulty(difficulty) {
+    QuantBot::init();
 
     buildTimer = getRandomGen().rand(0,3) * 50;
 
@@ -196,6 +198,9 @@ QuantBot::QuantBot(InputStream& stream, House* associatedHouse) : Player(stream,
 
 
 void QuantBot::init() {
+    scheduler.addTask("checkAllUnits", AIUPDATEINTERVAL);
+    scheduler.addTask("build", AIUPDATEINTERVAL);
+    scheduler.addTask("attack", AIUPDATEINTERVAL);
 }
 
 
@@ -367,12 +372,44 @@ void QuantBot::update() {
     }
 
 
-    if((getGameCycleCount() + getHouse()->getHouseID()) % AIUPDATEINTERVAL != 0) {
-        // we are not updating this AI player this cycle
-        return;
-    }
+    const auto houseID = getHouse()->getHouseID();
+    const auto gameCycle = getGameCycleCount();
 
-    // Calculate the total military value of the player
+    scheduler.runIfDue(AITask_CheckAllUnits, houseID, gameCycle, [&]() {
+        checkAllUnits();
+    });
+
+    scheduler.runIfDue(AITask_Build, houseID, gameCycle, [&]() {
+        if(buildTimer <= 0) {
+            build(calculateMilitaryValue());
+        } else {
+            buildTimer -= AIUPDATEINTERVAL;
+        }
+    });
+
+    scheduler.runIfDue(AITask_Attack, houseID, gameCycle, [&]() {
+        if(attackTimer <= 0) {
+            attack(calculateMilitaryValue());
+        } else if (attackTimer > MILLI2CYCLES(100000) ) {
+            // If we have taken substantial losses then retreat
+            attackTimer = MILLI2CYCLES(90000);
+
+            if(retreatTimer < 0){
+                retreatAllUnits();
+            }
+        } else {
+            attackTimer -= AIUPDATEINTERVAL;
+            retreatTimer -= AIUPDATEINTERVAL;
+        }
+    });
+}
+
+
+/**
+    Calculates the total military value of this player
+    \return the sum of the prices of all units except carryalls and harvesters
+*/
+int QuantBot::calculateMilitaryValue() const {
     int militaryValue = 0;
     for(Uint32 i = Unit_FirstID; i <= Unit_LastID; i++){
         if(i != Unit_Carryall && i != Unit_Harvester){
@@ -381,27 +418,7 @@ void QuantBot::update() {
     }
     //logDebug("Military Value %d  Initial Military Value %d", militaryValue, initialMilitaryValue);
 
-    checkAllUnits();
-
-    if(buildTimer <= 0) {
-        build(militaryValue);
-    } else {
-        buildTimer -= AIUPDATEINTERVAL;
-    }
-
-    if(attackTimer <= 0) {
-        attack(militaryValue);
-    } else if (attackTimer > MILLI2CYCLES(100000) ) {
-        // If we have taken substantial losses then retreat
-        attackTimer = MILLI2CYCLES(90000);
-
-        if(retreatTimer < 0){
-            retreatAllUnits();
-        }
-    } else {
-        attackTimer -= AIUPDATEINTERVAL;
-        retreatTimer -= AIUPDATEINTERVAL;
-    }
+    return militaryValue;
 }
 
 
@@ -460,8 +477,6 @@ void QuantBot::onDamage(const ObjectBase* pObject, int damage, Uint32 damagerID)
     } else if(pObject->isAGroundUnit()) {
         const GroundUnit* pGroundUnit = static_cast<const GroundUnit*>(pObject);
 
-        Coord squadCenterLocation = findSquadCenter(pGroundUnit->getOwner()->getHouseID());
-
         if(pGroundUnit->isAwaitingPickup()) {
             return;
         }
@@ -494,6 +509,7 @@ void QuantBot::onDamage(const ObjectBase* pObject, int damage, Uint32 damagerID)
                     && (difficulty == Difficulty::Hard || difficulty == Difficulty::Brutal) ) {
             // Always keep Launchers away from harm
 
+            const Coord squadCenterLocation = findSquadCenter(pGroundUnit->getOwner()->getHouseID());
             doSetAttackMode(pGroundUnit, AREAGUARD);
             doMove2Pos(pGroundUnit, squadCenterLocation.x, squadCenterLocation.y, true);
 
@@ -505,6 +521,7 @@ void QuantBot::onDamage(const ObjectBase* pObject, int damage, Uint32 damagerID)
                     && (pDamager->getItemID() != Unit_Quad)) {
             // We want out quads as raiders
             // Quads flee from every unit except trikes, infantry and other quads (but only if quads are not our main vehicle for that techlevel)
+            const Coord squadCenterLocation = findSquadCenter(pGroundUnit->getOwner()->getHouseID());
             doSetAttackMode(pGroundUnit, AREAGUARD);
             doMove2Pos(pGroundUnit, squadCenterLocation.x, squadCenterLocation.y, true);
         } else if(  (currentGame->techLevel > 3)
@@ -517,6 +534,7 @@ void QuantBot::onDamage(const ObjectBase* pObject, int damage, Uint32 damagerID)
             // This means they are free to engage other light military units
             // but should run away from tanks
 
+            const Coord squadCenterLocation = findSquadCenter(pGroundUnit->getOwner()->getHouseID());
             doSetAttackMode(pGroundUnit, AREAGUARD);
             doMove2Pos(pGroundUnit, squadCenterLocation.x, squadCenterLocation.y, true);
 
@@ -570,9 +588,17 @@ Coord QuantBot::findMcvPlaceLocation(const MCV* pMCV) {
 }
 
 Coord QuantBot::findPlaceLocation(Uint32 itemID) {
-    // Will over allocate space for small maps so its not clean
-    // But should allow Richard to compile
-    int buildLocationScore[128][128] = {{0}};
+    const int mapSizeX = getMap().getSizeX();
+    const int mapSizeY = getMap().getSizeY();
+    std::vector<int> buildLocationScores(mapSizeX * mapSizeY, 0);
+    const auto buildLocationScore = [&](int x, int y) -> int& { return buildLocationScores[x * mapSizeY + y]; };
+
+    // A location next to several of our structures is scored once per structure, but whether the structure fits
+    // there and how its neighbourhood looks does not change during this search. So both are only computed on the
+    // first visit of a location (-1 = not visited yet, 0 = structure does not fit, 1 = structure fits).
+    std::vector<Sint8> placeable(mapSizeX * mapSizeY, -1);
+    std::vector<int> neighbourhoodScores(mapSizeX * mapSizeY, 0);
+    std::vector<int> distanceScores(mapSizeX * mapSizeY, 0);
 
     int bestLocationX = -1;
     int bestLocationY = -1;
@@ -581,6 +607,9 @@ Coord QuantBot::findPlaceLocation(Uint32 itemID) {
     int newSizeY = getStructureSize(itemID).y;
     Coord bestLocation = Coord::Invalid();
 
+    const Coord baseCentre = findBaseCentre(getHouse()->getHouseID());
+    bool bSquadRallyLocationUpdated = false;
+
     for(const StructureBase* pStructureExisting : getStructureList()) {
         if(pStructureExisting->getOwner() == getHouse()) {
 
@@ -593,7 +622,11 @@ Coord QuantBot::findPlaceLocation(Uint32 itemID) {
             int existingEndX = existingStartX + existingSizeX;
             int existingEndY = existingStartY + existingSizeY;
 
-            squadRallyLocation = findSquadRallyLocation();
+            // the rally location only depends on the positions of all structures
+            if(!bSquadRallyLocationUpdated) {
+                squadRallyLocation = findSquadRallyLocation();
+                bSquadRallyLocationUpdated = true;
+            }
 
             bool existingIsBuilder = (pStructureExisting->getItemID() == Structure_HeavyFactory
                                    || pStructureExisting->getItemID() == Structure_RepairYard
@@ -609,71 +642,44 @@ Coord QuantBot::findPlaceLocation(Uint32 itemID) {
             for(int placeLocationX = existingStartX - newSizeX; placeLocationX <= existingEndX; placeLocationX++){
                 for(int placeLocationY = existingStartY - newSizeY; placeLocationY <= existingEndY; placeLocationY++){
                     if(getMap().tileExists(placeLocationX,placeLocationY)){
-                        if(getMap().okayToPlaceStructure(placeLocationX, placeLocationY, newSizeX, newSizeY,
-                                                         false, (itemID == Structure_ConstructionYard) ? nullptr : getHouse())) {
-
-                            int placeLocationEndX = placeLocationX + newSizeX;
-                            int placeLocationEndY = placeLocationY + newSizeY;
+                        Sint8& bPlaceable = placeable[placeLocationX * mapSizeY + placeLocationY];
+                        if(bPlaceable == -1) {
+                            bPlaceable = getMap().okayToPlaceStructure(placeLocationX, placeLocationY, newSizeX, newSizeY,
+                                                                       false, (itemID == Structure_ConstructionYard) ? nullptr : getHouse()) ? 1 : 0;
+                            if(bPlaceable == 1) {
+                                neighbourhoodScores[placeLocationX * mapSizeY + placeLocationY] = scorePlaceLocationNeighbourhood(itemID, placeLocationX, placeLocationY, newSizeX, newSizeY);
+                                distanceScores[placeLocationX * mapSizeY + placeLocationY] = - lround(blockDistance(squadRallyLocation, Coord(placeLocationX,placeLocationY))/2)
+                                                                                             - lround(blockDistance(baseCentre, Coord(placeLocationX,placeLocationY)));
+                            }
+                        }
 
+                        if(bPlaceable == 1) {
                             bool alignedX = (placeLocationX == existingStartX && sizeMatchX);
                             bool alignedY = (placeLocationY == existingStartY && sizeMatchY);
 
-                            // bool placeGapExists = (placeLocationEndX < existingStartX || placeLocationX > existingEndX || placeLocationEndY < existingStartY || placeLocationY > existingEndY);
-
                             // How many free spaces the building will have if placed
-                            for(int i = placeLocationX-1; i <= placeLocationEndX; i++) {
-                                for(int j = placeLocationY-1; j <= placeLocationEndY; j++) {
-                                    if(getMap().tileExists(i,j) && (getMap().getSizeX() > i) && (0 <= i) && (getMap().getSizeY() > j) && (0 <= j)) {
-                                            // Penalise if near edge of map
-                                            if((i == 0) || (i == getMap().getSizeX() - 1) || (j == 0) || (j == getMap().getSizeY() - 1)) {
-                                                buildLocationScore[placeLocationX][placeLocationY] -= 10;
-                                            }
-
-                                            if(getMap().getTile(i,j)->hasAStructure()) {
-                                                // If one of our buildings is nearby favour the location
-                                                // if it is someone elses building don't favour it
-                                                if(getMap().getTile(i,j)->getOwner() == getHouse()->getHouseID()){
-                                                    buildLocationScore[placeLocationX][placeLocationY]+=3;
-                                                } else{
-                                                    buildLocationScore[placeLocationX][placeLocationY]-=10;
-                                                }
-                                            } else if(!getMap().getTile(i,j)->isRock()){
-                                                // square isn't rock, favour it
-                                                buildLocationScore[placeLocationX][placeLocationY]+=1;
-                                            } else if(getMap().getTile(i,j)->hasAGroundObject()){
-                                                if(getMap().getTile(i,j)->getOwner() != getHouse()->getHouseID()){
-                                                    // try not to build next to units which aren't yours
-                                                    buildLocationScore[placeLocationX][placeLocationY]-=100;
-                                                } else if(itemID != Structure_RocketTurret){
-                                                    buildLocationScore[placeLocationX][placeLocationY]-=20;
-                                                }
-                                            }
-                                    } else {
-                                        // penalise if on edge of map
-                                        buildLocationScore[placeLocationX][placeLocationY]-=200;
-                                    }
-                                }
-                            }
+                            buildLocationScore(placeLocationX, placeLocationY) += neighbourhoodScores[placeLocationX * mapSizeY + placeLocationY];
 
                             //encourage structure alignment
                             if(alignedX) {
-                                buildLocationScore[placeLocationX][placeLocationX] += 10;
+                                // the score of the diagonal tile is raised (this has always been so and the AI relies on it)
+                                if(placeLocationX < mapSizeY) {
+                                    buildLocationScore(placeLocationX, placeLocationX) += 10;
+                                }
                             }
 
                             if(alignedY) {
-                                buildLocationScore[placeLocationX][placeLocationY] += 10;
+                                buildLocationScore(placeLocationX, placeLocationY) += 10;
                             }
 
                             // Add building specific scores
                             if(existingIsBuilder || itemID == Structure_GunTurret || itemID == Structure_RocketTurret){
-                                buildLocationScore[placeLocationX][placeLocationY] -= lround(blockDistance(squadRallyLocation, Coord(placeLocationX,placeLocationY))/2);
-
-                                buildLocationScore[placeLocationX][placeLocationY] -= lround(blockDistance(findBaseCentre(getHouse()->getHouseID()), Coord(placeLocationX,placeLocationY)));
+                                buildLocationScore(placeLocationX, placeLocationY) += distanceScores[placeLocationX * mapSizeY + placeLocationY];
                             }
 
                             // Pick this location if it has the best score
-                            if (buildLocationScore[placeLocationX][placeLocationY] > bestLocationScore) {
-                                bestLocationScore = buildLocationScore[placeLocationX][placeLocationY];
+                            if (buildLocationScore(placeLocationX, placeLocationY) > bestLocationScore) {
+                                bestLocationScore = buildLocationScore(placeLocationX, placeLocationY);
                                 bestLocationX = placeLocationX;
                                 bestLocationY = placeLocationY;
                                 //logDebug("Build location for item:%d  x:%d y:%d score:%d", itemID, bestLocationX, bestLocationY, bestLocationScore);
@@ -693,6 +699,49 @@ Coord QuantBot::findPlaceLocation(Uint32 itemID) {
     return bestLocation;
 }
 
+int QuantBot::scorePlaceLocationNeighbourhood(Uint32 itemID, int placeLocationX, int placeLocationY, int sizeX, int sizeY) {
+    int score = 0;
+
+    int placeLocationEndX = placeLocationX + sizeX;
+    int placeLocationEndY = placeLocationY + sizeY;
+
+    for(int i = placeLocationX-1; i <= placeLocationEndX; i++) {
+        for(int j = placeLocationY-1; j <= placeLocationEndY; j++) {
+            if(getMap().tileExists(i,j) && (getMap().getSizeX() > i) && (0 <= i) && (getMap().getSizeY() > j) && (0 <= j)) {
+                    // Penalise if near edge of map
+                    if((i == 0) || (i == getMap().getSizeX() - 1) || (j == 0) || (j == getMap().getSizeY() - 1)) {
+                        score -= 10;
+                    }
+
+                    if(getMap().getTile(i,j)->hasAStructure()) {
+                        // If one of our buildings is nearby favour the location
+                        // if it is someone elses building don't favour it
+                        if(getMap().getTile(i,j)->getOwner() == getHouse()->getHouseID()){
+                            score+=3;
+                        } else{
+                            score-=10;
+                        }
+                    } else if(!getMap().getTile(i,j)->isRock()){
+                        // square isn't rock, favour it
+                        score+=1;
+                    } else if(getMap().getTile(i,j)->hasAGroundObject()){
+                        if(getMap().getTile(i,j)->getOwner() != getHouse()->getHouseID()){
+                            // try not to build next to units which aren't yours
+                            score-=100;
+                        } else if(itemID != Structure_RocketTurret){
+                            score-=20;
+                        }
+                    }
+            } else {
+                // penalise if on edge of map
+                score-=200;
+            }
+        }
+    }
+
+    return score;
+}
+
 
 void QuantBot::build(int militaryValue) {
     int houseID = getHouse()->getHouseID();
@@ -1291,6 +1340,9 @@ void QuantBot::build(int militaryValue) {
                                         logDebug("***CampAI Build itemID: %o structure count: %o, initial count: %o", i, itemCount[i], initialItemCount[i]);
                                         doProduceItem(pBuilder, i);
                                         itemCount[i]++;
+
+                                        // the production queue only grows when the orders are committed
+                                        break;
                                     }
                                 }
 
@@ -1608,16 +1660,22 @@ Coord QuantBot::findSquadRallyLocation() {
     int enemyTotalX = 0;
     int enemyTotalY = 0;
 
-    for(const StructureBase* pCurrentStructure : getStructureList()) {
-        if(pCurrentStructure->getOwner()->getHouseID() == getHouse()->getHouseID()) {
+    // the influence map keeps the totals of all structures of each house
+    for(int houseID = 0; houseID < NUM_HOUSES; houseID++) {
+        const InfluenceMap::StructureTotals structureTotals = getMap().getInfluenceMap().getStructureTotals(houseID);
+        if(structureTotals.numStructures == 0) {
+            continue;
+        }
+
+        if(houseID == getHouse()->getHouseID()) {
             // Lets find the center of mass of our squad
-            buildingCount++;
-            totalX += pCurrentStructure->getX();
-            totalY += pCurrentStructure->getY();
-        } else if(pCurrentStructure->getOwner()->getTeamID() != getHouse()->getTeamID()) {
-            enemyBuildingCount++;
-            enemyTotalX += pCurrentStructure->getX();
-            enemyTotalY += pCurrentStructure->getY();
+            buildingCount += structureTotals.numStructures;
+            totalX += structureTotals.totalX;
+            totalY += structureTotals.totalY;
+        } else if(currentGame->getHouse(houseID)->getTeamID() != getHouse()->getTeamID()) {
+            enemyBuildingCount += structureTotals.numStructures;
+            enemyTotalX += structureTotals.totalX;
+            enemyTotalY += structureTotals.totalY;
         }
     }
 
@@ -1653,27 +1711,8 @@ Coord QuantBot::findSquadRetreatLocation() {
 }
 
 Coord QuantBot::findBaseCentre(int houseID) {
-    int buildingCount = 0;
-    int totalX = 0;
-    int totalY = 0;
-
-    for(const StructureBase* pCurrentStructure : getStructureList()) {
-        if(pCurrentStructure->getOwner()->getHouseID() == houseID && pCurrentStructure->getStructureSizeX() != 1) {
-            // Lets find the center of mass of our squad
-            buildingCount++;
-            totalX += pCurrentStructure->getX();
-            totalY += pCurrentStructure->getY();
-        }
-    }
-
-    Coord baseCentreLocation = Coord::Invalid();
-
-    if(buildingCount > 0) {
-        baseCentreLocation.x = totalX / buildingCount;
-        baseCentreLocation.y = totalY / buildingCount;
-    }
-
-    return baseCentreLocation;
+    // the influence map keeps the centre of mass of all structures except walls and turrets
+    return getMap().getInfluenceMap().getBaseCentre(houseID);
 }
 
 
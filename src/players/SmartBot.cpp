@@ -65,6 +65,9 @@ SmartBot::SmartBot(InputStream& stream, House* associatedHouse) : Player(stream,
 
 
 void SmartBot::init() {
+    scheduler.addTask("checkAllUnits", AIUPDATEINTERVAL);
+    scheduler.addTask("build", AIUPDATEINTERVAL);
+    scheduler.addTask("attack", AIUPDATEINTERVAL);
     harvesterLimit = (currentGameMap->getSizeX() * currentGameMap->getSizeY())/512;
 }
 
@@ -88,24 +91,28 @@ void SmartBot::save(OutputStream& stream) const {
 
 
 void SmartBot::update() {
-    if( (getGameCycleCount() + getHouse()->getHouseID()) % AIUPDATEINTERVAL != 0) {
-        // we are not updating this AI player this cycle
-        return;
-    }
-
-    checkAllUnits();
-
-    if(buildTimer <= 0) {
-        build();
-    } else {
-        buildTimer -= AIUPDATEINTERVAL;
-    }
+    const auto houseID = getHouse()->getHouseID();
+    const auto gameCycle = getGameCycleCount();
+
+    scheduler.runIfDue(AITask_CheckAllUnits, houseID, gameCycle, [&]() {
+        checkAllUnits();
+    });
+
+    scheduler.runIfDue(AITask_Build, houseID, gameCycle, [&]() {
+        if(buildTimer <= 0) {
+            build();
+        } else {
+            buildTimer -= AIUPDATEINTERVAL;
+        }
+    });
 
-    if(attackTimer <= 0) {
-        attack();
-    } else {
-        attackTimer -= AIUPDATEINTERVAL;
-    }
+    scheduler.runIfDue(AITask_Attack, houseID, gameCycle, [&]() {
+        if(attackTimer <= 0) {
+            attack();
+        } else {
+            attackTimer -= AIUPDATEINTERVAL;
+        }
+    });
 }
 
 
@@ -296,17 +303,7 @@ Coord SmartBot::findPlaceLocation(Uint32 itemID) {
                 case Structure_GunTurret:
                 case Structure_RocketTurret: {
                     // place towards enemy
-                    FixPoint nearestEnemy = 10000000;
-
-                    for(const StructureBase* pStructure : getStructureList()) {
-                        if(pStructure->getOwner()->getTeamID() != getHouse()->getTeamID()) {
-                            FixPoint dist = blockDistance(pos, pStructure->getLocation());
-                            if(dist < nearestEnemy) {
-                                nearestEnemy = dist;
-                            }
-
-                        }
-                    }
+                    FixPoint nearestEnemy = getMap().getInfluenceMap().getDistanceToNearestEnemyStructure(getHouse()->getTeamID(), pos, 10000000);
 
                     rating = 10000000 - nearestEnemy;
                 } break;
@@ -319,16 +316,7 @@ Coord SmartBot::findPlaceLocation(Uint32 itemID) {
                 case Structure_WindTrap:
                 default: {
                     // place at a save place
-                    FixPoint nearestEnemy = 10000000;
-
-                    for(const StructureBase* pStructure : getStructureList()) {
-                        if(pStructure->getOwner()->getTeamID() != getHouse()->getTeamID()) {
-                            FixPoint dist = blockDistance(pos, pStructure->getLocation());
-                            if(dist < nearestEnemy) {
-                                nearestEnemy = dist;
-                            }
-                        }
-                    }
+                    FixPoint nearestEnemy = getMap().getInfluenceMap().getDistanceToNearestEnemyStructure(getHouse()->getTeamID(), pos, 10000000);
 
                     rating = nearestEnemy;
                     rating *= (1+getNumAdjacentStructureTiles(pos, structureSizeX, structureSizeY));
@@ -32,9 +32,15 @@
 
 #include <Game.h>
 #include <GameInitSettings.h>
+#include <ReplayVerifier.h>
+#include <Network/BroadcastClient.h>
+#include <Network/BroadcastServer.h>
 #include <data.h>
 
 #include <misc/exceptions.h>
+#include <misc/DrawingRectHelper.h>
+#include <misc/VideoEncoderPipe.h>
+#include <misc/format.h>
 
 #include <algorithm>
 
@@ -649,6 +655,129 @@ void startReplay(const std::string& filename) {
 
         currentGame->runMainLoop();
 
+        // seeking to a keyframe continues the replay in a new game loaded from that keyframe
+        while(currentGame->isReplaySeekPending()) {
+            const std::shared_ptr<ReplayKeyframes> pKeyframes = currentGame->getReplayKeyframes();
+            const Uint32 targetGameCycle = currentGame->getReplaySeekTarget();
+            const std::string replayPlayerName = currentGame->getLocalPlayerName();
+
+            std::unique_ptr<GameResources> pResources = currentGame->releaseResources();
+            delete currentGame;
+            currentGame = nullptr;
+
+            SDL_Log("Seeking replay to game cycle %u...", targetGameCycle);
+            currentGame = new Game(std::move(pResources));
+            currentGame->initReplayFromKeyframe(pKeyframes, targetGameCycle, replayPlayerName);
+
+            currentGame->runMainLoop();
+        }
+
+        delete currentGame;
+        currentGame = nullptr;
+
+        // Change music to menu music
+        musicPlayer->changeMusic(MUSIC_MENU);
+    } catch(...) {
+        delete currentGame;
+        currentGame = nullptr;
+        throw;
+    }
+}
+
+
+/**
+    Runs a game replay in headless mode (see Game::setHeadless()) and prints the outcome to stdout.
+    \param  filename        the filename of the replay file
+    \param  maxGameCycle    the replay is stopped at this game cycle (0 = shortly after the last recorded command)
+    \return true if the replayed game was finished, false if it was stopped before
+*/
+bool runHeadlessReplay(const std::string& filename, Uint32 maxGameCycle) {
+    SDL_Log("Initializing headless replay...");
+    const ReplayResult replayResult = simulateReplay(filename, maxGameCycle);
+    if(replayResult.result == "error") {
+        THROW(std::runtime_error, "Replay '%s' cannot be simulated!", filename);
+    }
+
+    fprintf(stdout, "Replay '%s': %s after %u game cycles (random seed 0x%08X, checksum %s), %u ms, %u cycles/s\n",
+                    filename.c_str(), replayResult.result.c_str(),
+                    replayResult.gameCycles, replayResult.randomSeed, replayResult.checksum.c_str(),
+                    replayResult.elapsedTime, replayResult.getCyclesPerSecond());
+    fflush(stdout);
+
+    return (replayResult.result != "stopped");
+}
+
+
+/**
+    Renders a replay into a video as fast as possible (see Game::setOfflineRendering()). The frames are drawn in the
+    current resolution and piped to an encoder.
+    \param  filename        the filename of the replay file
+    \param  videoFilename   the video file ffmpeg writes to (ignored if encoderCommand is given)
+    \param  encoderCommand  the command reading the raw frames from its standard input (empty = encode with ffmpeg to videoFilename)
+    \param  framesPerSecond the frame rate of the video
+    \param  maxGameCycle    the replay is stopped at this game cycle (0 = shortly after the last recorded command)
+    \return true if all frames were encoded, false otherwise
+*/
+bool renderReplayVideo(const std::string& filename, const std::string& videoFilename, const std::string& encoderCommand, int framesPerSecond, Uint32 maxGameCycle) {
+    const SDL_Rect rendererSize = getRendererSize();
+
+    std::string command = encoderCommand;
+    if(command.empty()) {
+        command = fmt::sprintf("ffmpeg -loglevel error -y -f rawvideo -pixel_format %s -video_size %dx%d -framerate %d -i - -c:v libx264 -preset veryfast -pix_fmt yuv420p \"%s\"",
+                               VideoEncoderPipe::getRawPixelFormatName(), rendererSize.w, rendererSize.h, framesPerSecond, videoFilename);
+    }
+
+    SDL_Log("Rendering replay '%s' with %dx%d pixels in %s at %d frames per second...",
+            filename.c_str(), rendererSize.w, rendererSize.h, VideoEncoderPipe::getRawPixelFormatName(), framesPerSecond);
+    SDL_Log("Encoder: %s", command.c_str());
+
+    std::unique_ptr<VideoEncoderPipe> pVideoEncoderPipe;
+    Uint32 numGameCycles = 0;
+    const Uint32 startTime = SDL_GetTicks();
+    try {
+        pVideoEncoderPipe = std::make_unique<VideoEncoderPipe>(command);
+
+        currentGame = new Game();
+        currentGame->initReplay(filename);
+        currentGame->setOfflineRendering(pVideoEncoderPipe.get(), framesPerSecond, maxGameCycle);
+        currentGame->runMainLoop();
+
+        numGameCycles = currentGame->getGameCycleCount();
+    } catch(std::exception& e) {
+        SDL_Log("Rendering replay '%s' failed: %s", filename.c_str(), e.what());
+    }
+
+    delete currentGame;
+    currentGame = nullptr;
+
+    if(pVideoEncoderPipe == nullptr) {
+        return false;
+    }
+
+    // write the remaining frames and wait for the encoder to finish
+    const bool bEncoded = pVideoEncoderPipe->close() && (numGameCycles > 0);
+
+    fprintf(stdout, "Replay '%s': %u game cycles rendered into %u frames in %u ms%s\n",
+                    filename.c_str(), numGameCycles, pVideoEncoderPipe->getNumWrittenFrames(), SDL_GetTicks() - startTime, bEncoded ? "" : " (failed)");
+    fflush(stdout);
+
+    return bEncoded;
+}
+
+
+/**
+    Spectates a game broadcast by a BroadcastServer (or a relay). The game is simulated locally like a replay.
+    \param  hostname    the host name or IP address of the broadcast server
+    \param  port        the port of the broadcast server
+*/
+void startSpectator(const std::string& hostname, int port) {
+    SDL_Log("Connecting to the broadcast at %s:%d...", hostname.c_str(), port);
+    try {
+        currentGame = new Game();
+        currentGame->initSpectator(std::make_unique<BroadcastClient>(hostname, port));
+
+        currentGame->runMainLoop();
+
         delete currentGame;
         currentGame = nullptr;
 
@@ -662,6 +791,43 @@ void startReplay(const std::string& filename) {
 }
 
 
+/**
+    Relays a broadcast to further spectators without an additional delay. Nothing is simulated, the received
+    commands are only passed on. Runs until the upstream broadcast ends.
+    \param  hostname    the host name or IP address of the upstream broadcast server
+    \param  port        the port of the upstream broadcast server
+    \param  relayPort   the port to broadcast on
+    \return true if the broadcast was received, false if the upstream broadcast server could not be reached
+*/
+bool runBroadcastRelay(const std::string& hostname, int port, int relayPort) {
+    SDL_Log("Relaying the broadcast at %s:%d on port %d...", hostname.c_str(), port, relayPort);
+
+    BroadcastClient broadcastClient(hostname, port);
+    BroadcastServer broadcastServer(relayPort, 0);
+
+    bool bHeaderReceived = false;
+    broadcastClient.setOnReceiveHeader([&](const std::string& header) {
+        broadcastServer.setHeader(header);
+        bHeaderReceived = true;
+    });
+    broadcastClient.setOnReceiveCommands([&](Uint32 availableCycle, const std::string& commands) {
+        // all received commands are scheduled before availableCycle
+        if(!commands.empty()) {
+            broadcastServer.addCommands(availableCycle - 1, commands);
+        }
+    });
+
+    while(!broadcastClient.isDisconnected()) {
+        broadcastClient.update(BROADCAST_RELAY_WAIT_TIMEOUT);
+        broadcastServer.update(broadcastClient.getAvailableCycle());
+    }
+
+    broadcastServer.finish(broadcastClient.getAvailableCycle());
+
+    return bHeaderReceived;
+}
+
+
 /**
     Starts a new game. If this game is quit it might start another game. This other game is also started from
     this function. This is done until there is no more game to be started.
@@ -671,12 +837,15 @@ void startSinglePlayerGame(const GameInitSettings& init)
 {
     GameInitSettings currentGameInitInfo = init;
 
+    // the resources of the previous game (when restarting the mission or continuing with the next one)
+    std::unique_ptr<GameResources> pResources;
+
     while(1) {
 
         try {
 
             SDL_Log("Initializing game...");
-            currentGame = new Game();
+            currentGame = new Game(std::move(pResources));
             currentGame->initGame(currentGameInitInfo);
 
             // get init settings from game as it might have changed (through loading the game)
@@ -737,6 +906,10 @@ void startSinglePlayerGame(const GameInitSettings& init)
                     case GAME_NEXTMISSION: {
                         currentGameInitInfo = currentGame->getNextGameInitSettings();
                         bGetNext = false;
+
+                        pResources = currentGame->releaseResources();
+                        delete currentGame;
+                        currentGame = nullptr;
                     } break;
 
                     case GAME_RETURN_TO_MENU:
@@ -223,12 +223,17 @@ void BuilderBase::updateProductionProgress() {
                 productionProgress += owner->takeCredits(buildCosts);
             } else {
 
+                if(buildCostsItemID != currentProducedItem) {
+                    // price and build time do not change during the game
+                    FixPoint totalBuildCosts = currentGame->objectData.data[currentProducedItem][originalHouseID].price;
+                    FixPoint totalBuildGameTicks = currentGame->objectData.data[currentProducedItem][originalHouseID].buildtime*15;
+                    buildCostsPerTick = totalBuildCosts / totalBuildGameTicks;
+                    buildCostsItemID = currentProducedItem;
+                }
+
                 FixPoint buildSpeed = std::min( getHealth() / getMaxHealth(), buildSpeedLimit);
-                FixPoint totalBuildCosts = currentGame->objectData.data[currentProducedItem][originalHouseID].price;
-                FixPoint totalBuildGameTicks = currentGame->objectData.data[currentProducedItem][originalHouseID].buildtime*15;
-                FixPoint buildCosts = totalBuildCosts / totalBuildGameTicks;
 
-                productionProgress += owner->takeCredits(buildCosts*buildSpeed);
+                productionProgress += owner->takeCredits(buildCostsPerTick*buildSpeed);
 
                 /* That was wrong. Build speed does not depend on power production
                 if (getOwner()->hasPower() || (((currentGame->gameType == GameType::Campaign) || (currentGame->gameType == GameType::Skirmish)) && getOwner()->isAI())) {
@@ -253,7 +258,7 @@ void BuilderBase::updateProductionProgress() {
 
 void BuilderBase::doBuildRandom() {
     if(!buildList.empty()) {
-        int item2Produce = std::next(buildList.begin(), currentGame->randomGen.rand(0, static_cast<Sint32>(buildList.size())-1))->itemID;
+        int item2Produce = std::next(buildList.begin(), randomGen.rand(0, static_cast<Sint32>(buildList.size())-1))->itemID;
         doProduceItem(item2Produce);
     }
 }
@@ -348,7 +353,7 @@ void BuilderBase::unSetWaitingToPlace() {
 }
 
 int BuilderBase::getUpgradeCost() const {
-    return currentGame->objectData.data[itemID][originalHouseID].price / 2;
+    return getObjectData().price / 2;
 }
 
 
@@ -391,7 +396,7 @@ bool BuilderBase::update() {
                         unitDestination = destination;
                     }
 
-                    Coord spot = newUnit->isAFlyingUnit() ? location + Coord(1,1) : currentGameMap->findDeploySpot(newUnit, location, currentGame->randomGen, unitDestination, structureSize);
+                    Coord spot = newUnit->isAFlyingUnit() ? location + Coord(1,1) : currentGameMap->findDeploySpot(newUnit, location, randomGen, unitDestination, structureSize);
                     newUnit->deploy(spot);
 
                     if(unitDestination.isValid()) {
@@ -60,7 +60,7 @@ void HeavyFactory::doBuildRandom() {
         int item2Produce = ItemID_Invalid;
 
         do {
-            item2Produce = std::next(buildList.begin(), currentGame->randomGen.rand(0, static_cast<Sint32>(buildList.size())-1))->itemID;
+            item2Produce = std::next(buildList.begin(), randomGen.rand(0, static_cast<Sint32>(buildList.size())-1))->itemID;
         } while((item2Produce == Unit_Harvester) || (item2Produce == Unit_MCV));
 
         doProduceItem(item2Produce);
@@ -139,8 +139,8 @@ void Palace::doLaunchDeathhand(int x, int y) {
         return;
     }
 
-    FixPoint randAngle = 2 * FixPt_PI * currentGame->randomGen.randFixPoint();
-    int radius = currentGame->randomGen.rand(0,10*TILESIZE);
+    FixPoint randAngle = 2 * FixPt_PI * randomGen.randFixPoint();
+    int radius = randomGen.rand(0,10*TILESIZE);
     int deathOffX = lround(FixPoint::sin(randAngle) * radius);
     int deathOffY = lround(FixPoint::cos(randAngle) * radius);
 
@@ -148,7 +148,7 @@ void Palace::doLaunchDeathhand(int x, int y) {
     Coord dest( x * TILESIZE + TILESIZE/2 + deathOffX,
                 y * TILESIZE + TILESIZE/2 + deathOffY);
 
-    bulletList.push_back(new Bullet(objectID, &centerPoint, &dest, Bullet_LargeRocket, PALACE_DEATHHAND_WEAPONDAMAGE, false, nullptr));
+    bulletList.create(objectID, &centerPoint, &dest, Bullet_LargeRocket, PALACE_DEATHHAND_WEAPONDAMAGE, false, nullptr);
     soundPlayer->playSoundAt(Sound_Rocket, getLocation());
 
     if(getOwner() != pLocalHouse) {
@@ -194,8 +194,8 @@ bool Palace::callFremen() {
     int x;
     int y;
     do {
-        x = currentGame->randomGen.rand(1, currentGameMap->getSizeX()-2);
-        y = currentGame->randomGen.rand(1, currentGameMap->getSizeY()-2);
+        x = randomGen.rand(1, currentGameMap->getSizeX()-2);
+        y = randomGen.rand(1, currentGameMap->getSizeY()-2);
     } while((currentGameMap->getTile(x-1, y-1)->hasAGroundObject()
             || currentGameMap->getTile(x, y-1)->hasAGroundObject()
             || currentGameMap->getTile(x+1, y-1)->hasAGroundObject()
@@ -210,7 +210,7 @@ bool Palace::callFremen() {
     if(count < 1000) {
 
         for(int numFremen = 0; numFremen < 15; numFremen++) {
-            if(currentGame->randomGen.rand(0, 5) == 0) {
+            if(randomGen.rand(0, 5) == 0) {
                 continue;
             }
 
@@ -219,8 +219,8 @@ bool Palace::callFremen() {
             int i;
             int j;
             do {
-                i = currentGame->randomGen.rand(-1, 1);
-                j = currentGame->randomGen.rand(-1, 1);
+                i = randomGen.rand(-1, 1);
+                j = randomGen.rand(-1, 1);
             } while (!currentGameMap->getTile(x + i, y + j)->infantryNotFull());
 
             pFremen->deploy(Coord(x + i,y + j));
@@ -254,7 +254,7 @@ bool Palace::callFremen() {
 
 bool Palace::spawnSaboteur() {
     Saboteur* saboteur = static_cast<Saboteur*>(getOwner()->createUnit(Unit_Saboteur));
-    Coord spot = currentGameMap->findDeploySpot(saboteur, getLocation(), currentGame->randomGen, getDestination(), getStructureSize());
+    Coord spot = currentGameMap->findDeploySpot(saboteur, getLocation(), randomGen, getDestination(), getStructureSize());
 
     saboteur->deploy(spot);
 
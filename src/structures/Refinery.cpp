@@ -53,6 +53,7 @@ Refinery::Refinery(InputStream& stream) : StructureBase(stream) {
     extractingSpice = stream.readBool();
     harvester.load(stream);
     bookings = stream.readUint32();
+    dockReservation.load(stream);
 
     if(extractingSpice) {
         firstAnimFrame = 8;
@@ -94,6 +95,7 @@ void Refinery::save(OutputStream& stream) const {
     stream.writeBool(extractingSpice);
     harvester.save(stream);
     stream.writeUint32(bookings);
+    dockReservation.save(stream);
 }
 
 ObjectInterface* Refinery::getInterfaceContainer() {
@@ -104,9 +106,26 @@ ObjectInterface* Refinery::getInterfaceContainer() {
     }
 }
 
+bool Refinery::reserveDock(const Harvester* pHarvester) {
+    const Harvester* pReservingHarvester = static_cast<const Harvester*>(dockReservation.getObjPointer());
+    if((pReservingHarvester != nullptr) && pReservingHarvester->isReturning() && (pReservingHarvester->getTarget() == this)) {
+        return (pReservingHarvester == pHarvester);
+    }
+
+    // the reservation is unused or the harvester holding it went somewhere else
+    if(!isFree()) {
+        dockReservation.pointTo(NONE_ID);
+        return false;
+    }
+
+    dockReservation.pointTo(pHarvester);
+    return true;
+}
+
 void Refinery::assignHarvester(Harvester* newHarvester) {
     extractingSpice = true;
     harvester.pointTo(newHarvester);
+    dockReservation.pointTo(NONE_ID);
     drawnAngle = 1;
     firstAnimFrame = 8;
     lastAnimFrame = 9;
@@ -132,7 +151,7 @@ void Refinery::deployHarvester(Carryall* pCarryall) {
         pCarryall->setTarget(nullptr);
         pCarryall->setDestination(pHarvester->getGuardPoint());
     } else {
-        Coord deployPos = currentGameMap->findDeploySpot(pHarvester, location, currentGame->randomGen, destination, structureSize);
+        Coord deployPos = currentGameMap->findDeploySpot(pHarvester, location, randomGen, destination, structureSize);
         pHarvester->deploy(deployPos);
     }
 
@@ -143,6 +162,24 @@ void Refinery::deployHarvester(Carryall* pCarryall) {
     }
 }
 
+void Refinery::assignCarryall(Carryall* pCarryall) {
+    if(!extractingSpice) {
+        return;
+    }
+
+    Harvester* pHarvester = static_cast<Harvester*>(harvester.getObjPointer());
+
+    if((pCarryall != nullptr) && !pHarvester->isAwaitingPickup()) {
+        pCarryall->setTarget(this);
+        pCarryall->clearPath();
+        pHarvester->bookCarrier(pCarryall);
+        pHarvester->setTarget(nullptr);
+        pHarvester->setDestination(pHarvester->getGuardPoint());
+    } else if(!pHarvester->hasBookedCarrier()) {
+        deployHarvester();
+    }
+}
+
 void Refinery::startAnimate() {
     if(extractingSpice == false) {
         firstAnimFrame = 2;
@@ -174,28 +211,11 @@ void Refinery::updateStructureSpecificStuff() {
             extractionSpeed = (extractionSpeed * scale) / 5;
 
 
-            owner->addCredits(pHarvester->extractSpice(extractionSpeed), true);
+            owner->addRefinedSpice(pHarvester->extractSpice(extractionSpeed));
         } else if((pHarvester->isAwaitingPickup() == false) && (pHarvester->getGuardPoint().isValid())) {
-            // find carryall
-            Carryall* pCarryall = nullptr;
-            if((pHarvester->getGuardPoint().isValid()) && getOwner()->hasCarryalls())   {
-                for(UnitBase* pUnit : unitList) {
-                    if ((pUnit->getOwner() == owner) && (pUnit->getItemID() == Unit_Carryall)) {
-                        Carryall* pTmpCarryall = static_cast<Carryall*>(pUnit);
-                        if (!pTmpCarryall->isBooked()) {
-                            pCarryall = pTmpCarryall;
-                            break;
-                        }
-                    }
-                }
-            }
-
-            if(pCarryall != nullptr) {
-                pCarryall->setTarget(this);
-                pCarryall->clearPath();
-                pHarvester->bookCarrier(pCarryall);
-                pHarvester->setTarget(nullptr);
-                pHarvester->setDestination(pHarvester->getGuardPoint());
+            if(getOwner()->hasCarryalls()) {
+                // the harvester stays inside until assignCarryall() is called at the end of this cycle
+                getOwner()->requestCarryall(this);
             } else {
                 deployHarvester();
             }
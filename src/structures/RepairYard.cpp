@@ -97,7 +97,7 @@ void RepairYard::deployRepairUnit(Carryall* pCarryall) {
         pCarryall->setTarget(nullptr);
         pCarryall->setDestination(pRepairUnit->getGuardPoint());
     } else {
-        Coord deployPos = currentGameMap->findDeploySpot(pRepairUnit, location, currentGame->randomGen, destination, structureSize);
+        Coord deployPos = currentGameMap->findDeploySpot(pRepairUnit, location, randomGen, destination, structureSize);
 
         pRepairUnit->setForced(false);
         pRepairUnit->doSetAttackMode((pRepairUnit->getItemID() == Unit_Harvester) ? HARVEST : GUARD);
@@ -113,6 +113,24 @@ void RepairYard::deployRepairUnit(Carryall* pCarryall) {
     }
 }
 
+void RepairYard::assignCarryall(Carryall* pCarryall) {
+    if(!repairingAUnit) {
+        return;
+    }
+
+    GroundUnit* pRepairUnit = static_cast<GroundUnit*>(repairUnit.getUnitPointer());
+
+    if((pCarryall != nullptr) && !pRepairUnit->isAwaitingPickup()) {
+        pCarryall->setTarget(this);
+        pCarryall->clearPath();
+        pRepairUnit->bookCarrier(pCarryall);
+        pRepairUnit->setTarget(nullptr);
+        pRepairUnit->setDestination(pRepairUnit->getGuardPoint());
+    } else if(!pRepairUnit->hasBookedCarrier()) {
+        deployRepairUnit();
+    }
+}
+
 void RepairYard::updateStructureSpecificStuff() {
     if(repairingAUnit) {
         if(curAnimFrame < 6) {
@@ -137,25 +155,9 @@ void RepairYard::updateStructureSpecificStuff() {
             }
 
         } else if(!pRepairUnit->isAwaitingPickup() && blockDistance(location, pRepairUnit->getGuardPoint()) >= MIN_CARRYALL_LIFT_DISTANCE) {
-            // find carryall
-            Carryall* pCarryall = nullptr;
             if((pRepairUnit->getGuardPoint().isValid()) && getOwner()->hasCarryalls())  {
-                for(UnitBase* pUnit : unitList) {
-                    if ((pUnit->getOwner() == owner) && (pUnit->getItemID() == Unit_Carryall)) {
-                        Carryall* pTmpCarryall = static_cast<Carryall*>(pUnit);
-                        if (!pTmpCarryall->isBooked()) {
-                            pCarryall = pTmpCarryall;
-                        }
-                    }
-                }
-            }
-
-            if(pCarryall != nullptr) {
-                pCarryall->setTarget(this);
-                pCarryall->clearPath();
-                static_cast<GroundUnit*>(pRepairUnit)->bookCarrier(pCarryall);
-                pRepairUnit->setTarget(nullptr);
-                pRepairUnit->setDestination(pRepairUnit->getGuardPoint());
+                // the unit stays inside until assignCarryall() is called at the end of this cycle
+                getOwner()->requestCarryall(this);
             } else {
                 deployRepairUnit();
             }
@@ -81,10 +81,10 @@ void RocketTurret::attack() {
             // we are just shooting a bullet as a gun turret would do
             // for air units do nothing
             if(!pObject->isAFlyingUnit()) {
-                bulletList.push_back( new Bullet( objectID, &centerPoint, &targetCenterPoint, Bullet_ShellTurret,
-                                                       currentGame->objectData.data[Structure_GunTurret][originalHouseID].weapondamage,
-                                                       pObject->isAFlyingUnit(),
-                                                       pObject ) );
+                bulletList.create(objectID, &centerPoint, &targetCenterPoint, Bullet_ShellTurret,
+                                  currentGame->objectData.data[Structure_GunTurret][originalHouseID].weapondamage,
+                                  pObject->isAFlyingUnit(),
+                                  pObject);
 
                 currentGameMap->viewMap(pObject->getOwner()->getHouseID(), location, 2);
                 soundPlayer->playSoundAt(Sound_ExplosionSmall, location);
@@ -92,10 +92,10 @@ void RocketTurret::attack() {
             }
         } else {
             // we are in normal shooting mode
-            bulletList.push_back( new Bullet( objectID, &centerPoint, &targetCenterPoint, bulletType,
-                                                   currentGame->objectData.data[itemID][originalHouseID].weapondamage,
-                                                   pObject->isAFlyingUnit(),
-                                                   pObject ) );
+            bulletList.create(objectID, &centerPoint, &targetCenterPoint, bulletType,
+                              getObjectData().weapondamage,
+                              pObject->isAFlyingUnit(),
+                              pObject);
 
             currentGameMap->viewMap(pObject->getOwner()->getHouseID(), location, 2);
             soundPlayer->playSoundAt(attackSound, location);
@@ -85,7 +85,7 @@ void StarPort::doBuildRandom() {
         int item2Produce = ItemID_Invalid;
 
         do {
-            item2Produce = std::next(buildList.begin(), currentGame->randomGen.rand(0, static_cast<Sint32>(buildList.size())-1))->itemID;
+            item2Produce = std::next(buildList.begin(), randomGen.rand(0, static_cast<Sint32>(buildList.size())-1))->itemID;
         } while((item2Produce == Unit_Harvester) || (item2Produce == Unit_MCV) || (item2Produce == Unit_Carryall));
 
         doProduceItem(item2Produce);
@@ -297,7 +297,7 @@ void StarPort::updateStructureSpecificStuff() {
                             unitDestination = destination;
                         }
 
-                        Coord spot = newUnit->isAFlyingUnit() ? location + Coord(1,1) : currentGameMap->findDeploySpot(newUnit, location, currentGame->randomGen, unitDestination, structureSize);
+                        Coord spot = newUnit->isAFlyingUnit() ? location + Coord(1,1) : currentGameMap->findDeploySpot(newUnit, location, randomGen, unitDestination, structureSize);
                         newUnit->deploy(spot);
 
                         if(unitDestination.isValid()) {
@@ -74,8 +74,11 @@ void StructureBase::init() {
 StructureBase::~StructureBase() {
     try {
         currentGameMap->removeObjectFromMap(getObjectID()); //no map point will reference now
+        currentGameMap->invalidatePathCaches(location.x, location.y, structureSize.x, structureSize.y);
+        currentGame->getTerrainChunkCache().invalidateArea(location.x, location.y, structureSize.x, structureSize.y);
         currentGame->getObjectManager().removeObject(getObjectID());
         structureList.remove(this);
+        structureListByItemID[itemID].remove(this);
         owner->decrementStructures(itemID, location);
 
         removeFromSelectionLists();
@@ -129,7 +132,10 @@ void StructureBase::assignToMap(const Coord& pos) {
         }
     }
 
-    currentGameMap->viewMap(getOwner()->getHouseID(), pos, getViewRange());
+    currentGameMap->invalidatePathCaches(pos.x, pos.y, structureSize.x, structureSize.y);
+    currentGame->getTerrainChunkCache().invalidateArea(pos.x, pos.y, structureSize.x, structureSize.y);
+
+    currentGameMap->updateVisionSource(this, pos);
 
     if(!bFoundNonConcreteTile && !currentGame->getGameInitSettings().getGameOptions().structuresDegradeOnConcrete) {
         degradeTimer = -1;
@@ -189,31 +195,31 @@ void StructureBase::drawSelectionBox() {
 
     // top left bit
     for(int i=0;i<=currentZoomlevel;i++) {
-        renderDrawHLine(renderer, dest.x+i, dest.y+i, dest.x+(currentZoomlevel+1)*3, COLOR_WHITE);
-        renderDrawVLine(renderer, dest.x+i, dest.y+i, dest.y+(currentZoomlevel+1)*3, COLOR_WHITE);
+        currentGame->getPrimitiveBatcher().addHLine(dest.x+i, dest.y+i, dest.x+(currentZoomlevel+1)*3, COLOR_WHITE);
+        currentGame->getPrimitiveBatcher().addVLine(dest.x+i, dest.y+i, dest.y+(currentZoomlevel+1)*3, COLOR_WHITE);
     }
 
     // top right bit
     for(int i=0;i<=currentZoomlevel;i++) {
-        renderDrawHLine(renderer, dest.x + dest.w-1 - i, dest.y+i, dest.x + dest.w-1 - (currentZoomlevel+1)*3, COLOR_WHITE);
-        renderDrawVLine(renderer, dest.x + dest.w-1 - i, dest.y+i, dest.y+(currentZoomlevel+1)*3, COLOR_WHITE);
+        currentGame->getPrimitiveBatcher().addHLine(dest.x + dest.w-1 - i, dest.y+i, dest.x + dest.w-1 - (currentZoomlevel+1)*3, COLOR_WHITE);
+        currentGame->getPrimitiveBatcher().addVLine(dest.x + dest.w-1 - i, dest.y+i, dest.y+(currentZoomlevel+1)*3, COLOR_WHITE);
     }
 
     // bottom left bit
     for(int i=0;i<=currentZoomlevel;i++) {
-        renderDrawHLine(renderer, dest.x+i, dest.y + dest.h-1 - i, dest.x+(currentZoomlevel+1)*3, COLOR_WHITE);
-        renderDrawVLine(renderer, dest.x+i, dest.y + dest.h-1 - i, dest.y + dest.h-1 - (currentZoomlevel+1)*3, COLOR_WHITE);
+        currentGame->getPrimitiveBatcher().addHLine(dest.x+i, dest.y + dest.h-1 - i, dest.x+(currentZoomlevel+1)*3, COLOR_WHITE);
+        currentGame->getPrimitiveBatcher().addVLine(dest.x+i, dest.y + dest.h-1 - i, dest.y + dest.h-1 - (currentZoomlevel+1)*3, COLOR_WHITE);
     }
 
     // bottom right bit
     for(int i=0;i<=currentZoomlevel;i++) {
-        renderDrawHLine(renderer, dest.x + dest.w-1 - i, dest.y + dest.h-1 - i, dest.x + dest.w-1 - (currentZoomlevel+1)*3, COLOR_WHITE);
-        renderDrawVLine(renderer, dest.x + dest.w-1 - i, dest.y + dest.h-1 - i, dest.y + dest.h-1 - (currentZoomlevel+1)*3, COLOR_WHITE);
+        currentGame->getPrimitiveBatcher().addHLine(dest.x + dest.w-1 - i, dest.y + dest.h-1 - i, dest.x + dest.w-1 - (currentZoomlevel+1)*3, COLOR_WHITE);
+        currentGame->getPrimitiveBatcher().addVLine(dest.x + dest.w-1 - i, dest.y + dest.h-1 - i, dest.y + dest.h-1 - (currentZoomlevel+1)*3, COLOR_WHITE);
     }
 
     // health bar
     for(int i=1;i<=currentZoomlevel+1;i++) {
-        renderDrawHLine(renderer, dest.x, dest.y-i-1, dest.x + (lround((getHealth()/getMaxHealth())*(world2zoomedWorld(TILESIZE)*structureSize.x - 1))), getHealthColor());
+        currentGame->getPrimitiveBatcher().addHLine(dest.x, dest.y-i-1, dest.x + (lround((getHealth()/getMaxHealth())*(world2zoomedWorld(TILESIZE)*structureSize.x - 1))), getHealthColor());
     }
 }
 
@@ -228,26 +234,26 @@ void StructureBase::drawOtherPlayerSelectionBox() {
 
     // top left bit
     for(int i=0;i<=currentZoomlevel;i++) {
-        renderDrawHLine(renderer, dest.x+i, dest.y+i, dest.x+(currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
-        renderDrawVLine(renderer, dest.x+i, dest.y+i, dest.y+(currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
+        currentGame->getPrimitiveBatcher().addHLine(dest.x+i, dest.y+i, dest.x+(currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
+        currentGame->getPrimitiveBatcher().addVLine(dest.x+i, dest.y+i, dest.y+(currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
     }
 
     // top right bit
     for(int i=0;i<=currentZoomlevel;i++) {
-        renderDrawHLine(renderer, dest.x + dest.w-1 - i, dest.y+i, dest.x + dest.w-1 - (currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
-        renderDrawVLine(renderer, dest.x + dest.w-1 - i, dest.y+i, dest.y+(currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
+        currentGame->getPrimitiveBatcher().addHLine(dest.x + dest.w-1 - i, dest.y+i, dest.x + dest.w-1 - (currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
+        currentGame->getPrimitiveBatcher().addVLine(dest.x + dest.w-1 - i, dest.y+i, dest.y+(currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
     }
 
     // bottom left bit
     for(int i=0;i<=currentZoomlevel;i++) {
-        renderDrawHLine(renderer, dest.x+i, dest.y + dest.h-1 - i, dest.x+(currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
-        renderDrawVLine(renderer, dest.x+i, dest.y + dest.h-1 - i, dest.y + dest.h-1 - (currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
+        currentGame->getPrimitiveBatcher().addHLine(dest.x+i, dest.y + dest.h-1 - i, dest.x+(currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
+        currentGame->getPrimitiveBatcher().addVLine(dest.x+i, dest.y + dest.h-1 - i, dest.y + dest.h-1 - (currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
     }
 
     // bottom right bit
     for(int i=0;i<=currentZoomlevel;i++) {
-        renderDrawHLine(renderer, dest.x + dest.w-1 - i, dest.y + dest.h-1 - i, dest.x + dest.w-1 - (currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
-        renderDrawVLine(renderer, dest.x + dest.w-1 - i, dest.y + dest.h-1 - i, dest.y + dest.h-1 - (currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
+        currentGame->getPrimitiveBatcher().addHLine(dest.x + dest.w-1 - i, dest.y + dest.h-1 - i, dest.x + dest.w-1 - (currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
+        currentGame->getPrimitiveBatcher().addVLine(dest.x + dest.w-1 - i, dest.y + dest.h-1 - i, dest.y + dest.h-1 - (currentZoomlevel+1)*2, COLOR_LIGHTBLUE);
     }
 }
 
@@ -256,10 +262,9 @@ void StructureBase::drawGatheringPointLine() {
         Coord indicatorPosition = destination*TILESIZE + Coord(TILESIZE/2, TILESIZE/2);
         Coord structurePosition = getCenterPoint();
 
-        renderDrawLine( renderer,
-                        screenborder->world2screenX(structurePosition.x), screenborder->world2screenY(structurePosition.y),
-                        screenborder->world2screenX(indicatorPosition.x), screenborder->world2screenY(indicatorPosition.y),
-                        COLOR_HALF_TRANSPARENT);
+        currentGame->getPrimitiveBatcher().addLine(screenborder->world2screenX(structurePosition.x), screenborder->world2screenY(structurePosition.y),
+                                                   screenborder->world2screenX(indicatorPosition.x), screenborder->world2screenY(indicatorPosition.y),
+                                                   COLOR_HALF_TRANSPARENT);
 
 
         SDL_Texture* pUIIndicator = pGFXManager->getUIGraphic(UI_Indicator);
@@ -327,7 +332,7 @@ void StructureBase::setJustPlaced() {
 
 bool StructureBase::update() {
     if(((currentGame->getGameCycleCount() + getObjectID()) % 512) == 0) {
-        currentGameMap->viewMap(owner->getHouseID(), location, getViewRange());
+        currentGameMap->updateVisionSource(this, location);
     }
 
     if(!fogged) {
@@ -367,7 +372,7 @@ bool StructureBase::update() {
             // Original dune 2 is doing the repair calculation with fix-point math (multiply everything with 256).
             // It is calculating what fraction 2 hitpoints of the maximum health would be.
             int fraction = (2*256)/getMaxHealth();
-            FixPoint repairprice = FixPoint(fraction * currentGame->objectData.data[itemID][originalHouseID].price) / 256;
+            FixPoint repairprice = FixPoint(fraction * getObjectData().price) / 256;
 
             // Original dune is always repairing 5 hitpoints (for the costs of 2) but we are only repairing 1/30th of that
             const auto repairHealth = 5_fix/30_fix;
@@ -396,7 +401,11 @@ bool StructureBase::update() {
         }
     }
 
-    // update animations
+    // update animations; the looping animations are purely cosmetic, so they are paused while nobody can see them
+    if((justPlacedTimer <= 0) && !isVisibleOnScreen()) {
+        return true;
+    }
+
     animationCounter++;
     if(animationCounter > STRUCTURE_ANIMATIONTIMER) {
         animationCounter = 0;
@@ -414,6 +423,15 @@ bool StructureBase::update() {
     return true;
 }
 
+bool StructureBase::isVisibleOnScreen() const {
+    if(currentGame->isHeadless()) {
+        return false;
+    }
+
+    const Coord size = structureSize*TILESIZE;
+    return screenborder->isInsideScreen(Coord(lround(realX), lround(realY)) + size/2, size);
+}
+
 void StructureBase::destroy() {
     int*    pDestroyedStructureTiles = nullptr;
     int     DestroyedStructureTilesSizeY = 0;
@@ -468,10 +486,10 @@ void StructureBase::destroy() {
                 pTile->setDestroyedStructureTile(pDestroyedStructureTiles[DestroyedStructureTilesSizeY*j + i]);
 
                 Coord position((location.x+i)*TILESIZE + TILESIZE/2, (location.y+j)*TILESIZE + TILESIZE/2);
-                Uint32 explosionID = currentGame->randomGen.getRandOf({Explosion_Large1,Explosion_Large2});
-                currentGame->getExplosionList().push_back(new Explosion(explosionID, position, owner->getHouseID()) );
+                Uint32 explosionID = randomGen.getRandOf({Explosion_Large1,Explosion_Large2});
+                currentGame->getExplosionList().create(explosionID, position, owner->getHouseID());
 
-                if(currentGame->randomGen.rand(1,100) <= getInfSpawnProp()) {
+                if(randomGen.rand(1,100) <= getInfSpawnProp()) {
                     UnitBase* pNewUnit = owner->createUnit(Unit_Soldier);
                     pNewUnit->setHealth(pNewUnit->getMaxHealth()/2);
                     pNewUnit->deploy(location + Coord(i,j));
@@ -65,10 +65,20 @@ void TurretBase::save(OutputStream& stream) const {
     stream.writeSint32(weaponTimer);
 }
 
+bool TurretBase::isTargetScanPending() const {
+    return (attackMode != STOP) && (findTargetTimer == 0) && !(target && (target.getObjPointer() != nullptr));
+}
+
 void TurretBase::updateStructureSpecificStuff() {
+    if(target && (target.getObjPointer() == nullptr)) {
+        // the target was destroyed => look for the next one right away
+        findTargetTimer = 0;
+    }
+
     if(target && (target.getObjPointer() != nullptr)) {
         if(!canAttack(target.getObjPointer()) || !targetInWeaponRange()) {
             setTarget(nullptr);
+            findTargetTimer = 0;
         } else if(targetInWeaponRange()) {
             Coord closestPoint = target.getObjPointer()->getClosestPoint(location);
             int wantedAngle = destinationDrawnAngle(location, closestPoint);
@@ -100,10 +110,11 @@ void TurretBase::updateStructureSpecificStuff() {
 
         } else {
             setTarget(nullptr);
+            findTargetTimer = 0;
         }
     } else if((attackMode != STOP) && (findTargetTimer == 0)) {
-        setTarget(findTarget());
-        findTargetTimer = 100;
+        setTarget(getScannedTarget());
+        findTargetTimer = 100 + getTargetScanStagger();
     }
 
     if(findTargetTimer > 0) {
@@ -139,7 +150,7 @@ void TurretBase::doAttackObject(const ObjectBase* pObject) {
 }
 
 void TurretBase::turnLeft() {
-    angle += currentGame->objectData.data[itemID][originalHouseID].turnspeed;
+    angle += getObjectData().turnspeed;
     if (angle >= 7.5_fix)    //must keep drawnangle between 0 and 7
         angle -= 8;
     drawnAngle = lround(angle);
@@ -147,7 +158,7 @@ void TurretBase::turnLeft() {
 }
 
 void TurretBase::turnRight() {
-    angle -= currentGame->objectData.data[itemID][originalHouseID].turnspeed;
+    angle -= getObjectData().turnspeed;
     if(angle < -0.5_fix) {
         //must keep angle between 0 and 7
         angle += 8;
@@ -162,10 +173,10 @@ void TurretBase::attack() {
         ObjectBase* pObject = target.getObjPointer();
         Coord targetCenterPoint = pObject->getClosestCenterPoint(location);
 
-        bulletList.push_back( new Bullet( objectID, &centerPoint, &targetCenterPoint,bulletType,
-                                               currentGame->objectData.data[itemID][originalHouseID].weapondamage,
-                                               pObject->isAFlyingUnit(),
-                                               pObject) );
+        bulletList.create(objectID, &centerPoint, &targetCenterPoint,bulletType,
+                          getObjectData().weapondamage,
+                          pObject->isAFlyingUnit(),
+                          pObject);
 
         currentGameMap->viewMap(pObject->getOwner()->getHouseID(), location, 2);
         soundPlayer->playSoundAt(attackSound, location);
@@ -69,46 +69,8 @@ void Wall::save(OutputStream& stream) const {
 }
 
 void Wall::destroy() {
-    // fix wall to the north
-    if(currentGameMap->tileExists(location.x, location.y-1) == true) {
-        ObjectBase* obj = currentGameMap->getTile(location.x, location.y-1)->getGroundObject();
-        if((obj != nullptr) && (obj->getItemID() == Structure_Wall)) {
-            Wall* pWall = static_cast<Wall*>(obj);
-            pWall->bWallDestroyedDown = true;
-            pWall->fixWall();
-        }
-    }
-
-    // fix wall to the south
-    if(currentGameMap->tileExists(location.x, location.y+1) == true) {
-        ObjectBase* obj = currentGameMap->getTile(location.x, location.y+1)->getGroundObject();
-        if((obj != nullptr) && (obj->getItemID() == Structure_Wall)) {
-            Wall* pWall = static_cast<Wall*>(obj);
-            pWall->bWallDestroyedUp = true;
-            pWall->fixWall();
-        }
-    }
-
-    // fix wall to the west
-    if(currentGameMap->tileExists(location.x-1, location.y) == true) {
-        ObjectBase* obj = currentGameMap->getTile(location.x-1, location.y)->getGroundObject();
-        if((obj != nullptr) && (obj->getItemID() == Structure_Wall)) {
-            Wall* pWall = static_cast<Wall*>(obj);
-            pWall->bWallDestroyedRight = true;
-            pWall->fixWall();
-        }
-    }
-
-    // fix wall to the east
-    if(currentGameMap->tileExists(location.x+1, location.y) == true) {
-        ObjectBase* obj = currentGameMap->getTile(location.x+1, location.y)->getGroundObject();
-        if((obj != nullptr) && (obj->getItemID() == Structure_Wall)) {
-            Wall* pWall = static_cast<Wall*>(obj);
-            pWall->bWallDestroyedLeft = true;
-            pWall->fixWall();
-        }
-    }
-
+    // the neighbour walls keep their connection to this side but show it as destroyed
+    updateNeighbourWalls(true);
 
     StructureBase::destroy();
 }
@@ -124,42 +86,38 @@ void Wall::setLocation(int xPos, int yPos) {
     // fix this wall
     fixWall();
 
-    // fix wall to the north
-    if(currentGameMap->tileExists(location.x, location.y-1) == true) {
-        ObjectBase* obj = currentGameMap->getTile(location.x, location.y-1)->getGroundObject();
-        if((obj != nullptr) && (obj->getItemID() == Structure_Wall)) {
-            Wall* pWall = static_cast<Wall*>(obj);
-            pWall->bWallDestroyedDown = false;
-            pWall->fixWall();
-        }
-    }
+    updateNeighbourWalls(false);
+}
 
-    // fix wall to the south
-    if(currentGameMap->tileExists(location.x, location.y+1) == true) {
-        ObjectBase* obj = currentGameMap->getTile(location.x, location.y+1)->getGroundObject();
-        if((obj != nullptr) && (obj->getItemID() == Structure_Wall)) {
-            Wall* pWall = static_cast<Wall*>(obj);
-            pWall->bWallDestroyedUp = false;
-            pWall->fixWall();
-        }
+/**
+    Returns the wall on the tile x,y.
+    \param  x   the x coordinate of the tile
+    \param  y   the y coordinate of the tile
+    \return the wall or nullptr if there is no wall on this tile
+*/
+Wall* Wall::getWallAt(int x, int y) {
+    if((currentGameMap->tileExists(x, y) == false) || (currentGameMap->getTile(x, y)->hasAGroundObject() == false)) {
+        return nullptr;
     }
 
-    // fix wall to the west
-    if(currentGameMap->tileExists(location.x-1, location.y) == true) {
-        ObjectBase* obj = currentGameMap->getTile(location.x-1, location.y)->getGroundObject();
-        if((obj != nullptr) && (obj->getItemID() == Structure_Wall)) {
-            Wall* pWall = static_cast<Wall*>(obj);
-            pWall->bWallDestroyedRight = false;
-            pWall->fixWall();
-        }
-    }
+    ObjectBase* obj = currentGameMap->getTile(x, y)->getGroundObject();
+    return ((obj != nullptr) && (obj->getItemID() == Structure_Wall)) ? static_cast<Wall*>(obj) : nullptr;
+}
 
-    // fix wall to the east
-    if(currentGameMap->tileExists(location.x+1, location.y) == true) {
-        ObjectBase* obj = currentGameMap->getTile(location.x+1, location.y)->getGroundObject();
-        if((obj != nullptr) && (obj->getItemID() == Structure_Wall)) {
-            Wall* pWall = static_cast<Wall*>(obj);
-            pWall->bWallDestroyedLeft = false;
+/**
+    Marks the side facing this wall of the 4 surrounding walls as destroyed or not and fixes them.
+    \param  bDestroyed  true if this wall is destroyed, false if it was placed
+*/
+void Wall::updateNeighbourWalls(bool bDestroyed) {
+    // up, right, down, left
+    static const int offsetX[] = { 0, 1, 0, -1 };
+    static const int offsetY[] = { -1, 0, 1, 0 };
+    static bool Wall::* const oppositeSide[] = { &Wall::bWallDestroyedDown, &Wall::bWallDestroyedLeft, &Wall::bWallDestroyedUp, &Wall::bWallDestroyedRight };
+
+    for(int i = 0; i < 4; i++) {
+        Wall* pWall = getWallAt(location.x + offsetX[i], location.y + offsetY[i]);
+        if(pWall != nullptr) {
+            pWall->*oppositeSide[i] = bDestroyed;
             pWall->fixWall();
         }
     }
@@ -169,66 +127,16 @@ void Wall::setLocation(int xPos, int yPos) {
     Fixes this wall. The choosen wall tile is based on the 4 surounding tiles and previously destroyed walls.
 */
 void Wall::fixWall() {
-
     int i = location.x;
     int j = location.y;
 
-    int maketile = Wall_LeftRight;
-
-    // Walls
-    bool up = (currentGameMap->tileExists(i, j-1) && (currentGameMap->getTile(i,j-1)->hasAGroundObject()
-                && (currentGameMap->getTile(i,j-1)->getGroundObject()->getItemID() == Structure_Wall))) || bWallDestroyedUp;
-
-    bool right = (currentGameMap->tileExists(i+1, j) && (currentGameMap->getTile(i+1,j)->hasAGroundObject()
-                && (currentGameMap->getTile(i+1,j)->getGroundObject()->getItemID() == Structure_Wall))) || bWallDestroyedRight;
-
-    bool down = (currentGameMap->tileExists(i, j+1) && (currentGameMap->getTile(i,j+1)->hasAGroundObject()
-                && (currentGameMap->getTile(i,j+1)->getGroundObject()->getItemID() == Structure_Wall))) || bWallDestroyedDown;
-
-    bool left = (currentGameMap->tileExists(i-1, j) && (currentGameMap->getTile(i-1,j)->hasAGroundObject()
-                && (currentGameMap->getTile(i-1,j)->getGroundObject()->getItemID() == Structure_Wall))) || bWallDestroyedLeft;
-
-    // calculate destroyed tile index
-    int destroyedTileIndex = 0;
-    if(left == true)    destroyedTileIndex = (destroyedTileIndex << 1) | ((int) bWallDestroyedLeft);
-    if(down == true)    destroyedTileIndex = (destroyedTileIndex << 1) | ((int) bWallDestroyedDown);
-    if(right == true)   destroyedTileIndex = (destroyedTileIndex << 1) | ((int) bWallDestroyedRight);
-    if(up == true)      destroyedTileIndex = (destroyedTileIndex << 1) | ((int) bWallDestroyedUp);
-
-    // Now perform the test
-    if ((left == true) && (right == true) && (up == true) && (down == true)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_Full : 59 + destroyedTileIndex; //solid wall
-    } else if ((left == false) && (right == true) && (up == true) && (down == true)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_UpDownRight : 31 + destroyedTileIndex; //missing left edge
-    } else if ((left == true) && (right == false)&& (up == true) && (down == true)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_UpDownLeft : 45 + destroyedTileIndex; //missing right edge
-    } else if ((left == true) && (right == true) && (up == false) && (down == true)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_DownLeftRight : 38 + destroyedTileIndex; //missing top edge
-    } else if ((left == true) && (right == true) && (up == true) && (down == false)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_UpLeftRight : 52 + destroyedTileIndex; //missing bottom edge
-    } else if ((left == false) && (right == true) && (up == false) && (down == true)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_DownRight : 22 + destroyedTileIndex; //missing top left edge
-    } else if ((left == true) && (right == false) && (up == true) && (down == false)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_UpLeft : 28 + destroyedTileIndex; //missing bottom right edge
-    } else if ((left == true) && (right == false) && (up == false) && (down == true)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_DownLeft : 25 + destroyedTileIndex; //missing top right edge
-    } else if ((left == false) && (right == true) && (up == true) && (down == false)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_UpRight : 19 + destroyedTileIndex; //missing bottom left edge
-    } else if ((left == true) && (right == false) && (up == false) && (down == false)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_LeftRight : 14 + destroyedTileIndex; //missing above, right and below
-    } else if ((left == false) && (right == true) && (up == false) && (down == false)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_LeftRight : 13 + destroyedTileIndex; //missing above, left and below
-    } else if ((left == false) && (right == false) && (up == true) && (down == false)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_UpDown : 16 + destroyedTileIndex; //only up
-    } else if ((left == false) && (right == false) && (up == false) && (down == true)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_UpDown : 17 + destroyedTileIndex; //only down
-    } else if ((left == true) && (right == true) && (up == false) && (down == false)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_LeftRight : 13 + destroyedTileIndex; //missing above and below
-    } else if ((left == false) && (right == false) && (up == true) && (down == true)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_UpDown : 16 + destroyedTileIndex; //missing left and right
-    } else if ((left == false) && (right == false) && (up == false) && (down == false)) {
-        maketile = (destroyedTileIndex == 0) ? Wall_Standalone : 12 + destroyedTileIndex; //missing left and right
-    }
+    bool up = (getWallAt(i, j-1) != nullptr) || bWallDestroyedUp;
+    bool right = (getWallAt(i+1, j) != nullptr) || bWallDestroyedRight;
+    bool down = (getWallAt(i, j+1) != nullptr) || bWallDestroyedDown;
+    bool left = (getWallAt(i-1, j) != nullptr) || bWallDestroyedLeft;
+
+    const int connections = ((int) up) | (((int) right) << 1) | (((int) down) << 2) | (((int) left) << 3);
+    const int destroyed = ((int) bWallDestroyedUp) | (((int) bWallDestroyedRight) << 1) | (((int) bWallDestroyedDown) << 2) | (((int) bWallDestroyedLeft) << 3);
 
-    setWallTile(maketile);
+    setWallTile(getWallTile(connections, destroyed));
 }
@@ -49,7 +49,10 @@ void WindTrap::init() {
     lastAnimFrame = 2+NUM_WINDTRAP_ANIMATIONS-1;
 }
 
-WindTrap::~WindTrap() = default;
+WindTrap::~WindTrap() {
+    // remove the power that is left if this wind trap is deleted without its health dropping to zero first
+    owner->setProducedPower(owner->getProducedPower() - getProducedPower());
+}
 
 ObjectInterface* WindTrap::getInterfaceContainer() {
     if((pLocalHouse == owner) || (debug == true)) {
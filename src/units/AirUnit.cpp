@@ -64,7 +64,7 @@ void AirUnit::destroy()
 {
     if(isVisible()) {
         Coord position(lround(realX), lround(realY));
-        currentGame->getExplosionList().push_back(new Explosion(Explosion_Medium2, position, owner->getHouseID()));
+        currentGame->getExplosionList().create(Explosion_Medium2, position, owner->getHouseID());
 
         if(isVisible(getOwner()->getTeamID()))
             soundPlayer->playSoundAt(Sound_ExplosionMedium,location);
@@ -97,8 +97,8 @@ void AirUnit::blitToScreen()
         double rotationAngleDeg = -angle.toDouble()*360.0/8.0;
 
         if(shadowGraphic[currentZoomlevel] != nullptr) {
-            int x = screenborder->world2screenX(realX + 4);
-            int y = screenborder->world2screenY(realY + 12);
+            int x = screenborder->world2screenX(getDrawnX() + 4);
+            int y = screenborder->world2screenY(getDrawnY() + 12);
 
             SDL_Rect source = calcSpriteSourceRect(shadowGraphic[currentZoomlevel], RIGHT, numImagesX, drawnFrame, numImagesY);
             SDL_Rect dest = calcSpriteDrawingRect(shadowGraphic[currentZoomlevel], x, y, numImagesX, numImagesY, HAlign::Center, VAlign::Center);
@@ -106,8 +106,8 @@ void AirUnit::blitToScreen()
             SDL_RenderCopyEx(renderer, shadowGraphic[currentZoomlevel], &source, &dest, rotationAngleDeg, nullptr, SDL_FLIP_NONE);
         }
 
-        int x = screenborder->world2screenX(realX);
-        int y = screenborder->world2screenY(realY);
+        int x = screenborder->world2screenX(getDrawnX());
+        int y = screenborder->world2screenY(getDrawnY());
 
         SDL_Texture* pUnitGraphic = graphic[currentZoomlevel];
         SDL_Rect source = calcSpriteSourceRect(pUnitGraphic, RIGHT, numImagesX, drawnFrame, numImagesY);
@@ -116,8 +116,8 @@ void AirUnit::blitToScreen()
         SDL_RenderCopyEx(renderer, pUnitGraphic, &source, &dest, rotationAngleDeg, nullptr, SDL_FLIP_NONE);
     } else {
         if(shadowGraphic[currentZoomlevel] != nullptr) {
-            int x = screenborder->world2screenX(realX + 4);
-            int y = screenborder->world2screenY(realY + 12);
+            int x = screenborder->world2screenX(getDrawnX() + 4);
+            int y = screenborder->world2screenY(getDrawnY() + 12);
 
             SDL_Rect source = calcSpriteSourceRect(shadowGraphic[currentZoomlevel], drawnAngle, numImagesX, drawnFrame, numImagesY);
             SDL_Rect dest = calcSpriteDrawingRect(shadowGraphic[currentZoomlevel], x, y, numImagesX, numImagesY, HAlign::Center, VAlign::Center);
@@ -125,8 +125,8 @@ void AirUnit::blitToScreen()
             SDL_RenderCopy(renderer, shadowGraphic[currentZoomlevel], &source, &dest);
         }
 
-        int x = screenborder->world2screenX(realX);
-        int y = screenborder->world2screenY(realY);
+        int x = screenborder->world2screenX(getDrawnX());
+        int y = screenborder->world2screenY(getDrawnY());
 
         SDL_Texture* pUnitGraphic = graphic[currentZoomlevel];
         SDL_Rect source = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX, drawnFrame, numImagesY);
@@ -184,20 +184,20 @@ void AirUnit::turn() {
         }
 
         if(angleLeft <= angleRight) {
-            angle += std::min(currentGame->objectData.data[itemID][originalHouseID].turnspeed, angleLeft);
+            angle += std::min(getObjectData().turnspeed, angleLeft);
             if(angle >= NUM_ANGLES) {
                 angle -= NUM_ANGLES;
             }
             drawnAngle = lround(angle) % NUM_ANGLES;
         } else {
-            angle -= std::min(currentGame->objectData.data[itemID][originalHouseID].turnspeed, angleRight);
+            angle -= std::min(getObjectData().turnspeed, angleRight);
             if(angle < 0) {
                 angle += NUM_ANGLES;
             }
             drawnAngle = lround(angle) % NUM_ANGLES;
         }
     } else {
-        angle -= currentGame->objectData.data[itemID][originalHouseID].turnspeed / 8;
+        angle -= getObjectData().turnspeed / 8;
         if(angle < 0) {
             angle += NUM_ANGLES;
         }
@@ -86,7 +86,7 @@ void Carryall::save(OutputStream& stream) const
 }
 
 bool Carryall::update() {
-    const auto& maxSpeed = currentGame->objectData.data[itemID][originalHouseID].maxspeed;
+    const auto& maxSpeed = getObjectData().maxspeed;
 
     FixPoint dist = -1;
     const auto pTarget = target.getObjPointer();
@@ -171,8 +171,8 @@ void Carryall::checkPos()
                 if(pickedUpUnitList.empty() == false) {
                     // find next place to drop
                     for(int i=8;i<18;i++) {
-                        int r = currentGame->randomGen.rand(3,i/2);
-                        FixPoint angle = 2 * FixPt_PI * currentGame->randomGen.randFixPoint();
+                        int r = randomGen.rand(3,i/2);
+                        FixPoint angle = 2 * FixPt_PI * randomGen.randFixPoint();
 
                         Coord dropCoord = location + Coord( lround(r*FixPoint::sin(angle)), lround(-r*FixPoint::cos(angle)));
                         if(currentGameMap->tileExists(dropCoord) && currentGameMap->getTile(dropCoord)->hasAGroundObject() == false) {
@@ -254,7 +254,7 @@ void Carryall::deployUnit(Uint32 unitID)
 
         if(pUnit != nullptr) {
             pUnit->setAngle(drawnAngle);
-            Coord deployPos = currentGameMap->findDeploySpot(pUnit, location, currentGame->randomGen);
+            Coord deployPos = currentGameMap->findDeploySpot(pUnit, location, randomGen);
             pUnit->setForced(false); // Stop units being forced if they are deployed
             pUnit->deploy(deployPos);
             if(pUnit->getItemID() == Unit_Saboteur) {
@@ -74,8 +74,8 @@ void Devastator::save(OutputStream& stream) const
 
 void Devastator::blitToScreen()
 {
-    int x1 = screenborder->world2screenX(realX);
-    int y1 = screenborder->world2screenY(realY);
+    int x1 = screenborder->world2screenX(getDrawnX());
+    int y1 = screenborder->world2screenY(getDrawnY());
 
     SDL_Texture* pUnitGraphic = graphic[currentZoomlevel];
     SDL_Rect source1 = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX);
@@ -97,8 +97,8 @@ void Devastator::blitToScreen()
     SDL_Texture* pTurretGraphic = turretGraphic[currentZoomlevel];
     SDL_Rect source2 = calcSpriteSourceRect(pTurretGraphic, drawnAngle, numImagesX);
     SDL_Rect dest2 = calcSpriteDrawingRect( pTurretGraphic,
-                                            screenborder->world2screenX(realX + devastatorTurretOffset[drawnAngle].x),
-                                            screenborder->world2screenY(realY + devastatorTurretOffset[drawnAngle].y),
+                                            screenborder->world2screenX(getDrawnX() + devastatorTurretOffset[drawnAngle].x),
+                                            screenborder->world2screenY(getDrawnY() + devastatorTurretOffset[drawnAngle].y),
                                             numImagesX, 1, HAlign::Center, VAlign::Center);
 
     SDL_RenderCopy(renderer, pTurretGraphic, &source2, &dest2);
@@ -127,8 +127,8 @@ void Devastator::destroy()
 
                 currentGameMap->damage(objectID, owner, realPos, itemID, 150, 16, false);
 
-                Uint32 explosionID = currentGame->randomGen.getRandOf({Explosion_Large1, Explosion_Large2});
-                currentGame->getExplosionList().push_back(new Explosion(explosionID, realPos, owner->getHouseID()));
+                Uint32 explosionID = randomGen.getRandOf({Explosion_Large1, Explosion_Large2});
+                currentGame->getExplosionList().create(explosionID, realPos, owner->getHouseID());
             }
         }
 
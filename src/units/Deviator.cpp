@@ -60,8 +60,8 @@ Deviator::~Deviator() = default;
 
 void Deviator::blitToScreen()
 {
-    int x1 = screenborder->world2screenX(realX);
-    int y1 = screenborder->world2screenY(realY);
+    int x1 = screenborder->world2screenX(getDrawnX());
+    int y1 = screenborder->world2screenY(getDrawnY());
 
     SDL_Texture* pUnitGraphic = graphic[currentZoomlevel];
     SDL_Rect source1 = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX);
@@ -82,8 +82,8 @@ void Deviator::blitToScreen()
     SDL_Texture* pTurretGraphic = turretGraphic[currentZoomlevel];
     SDL_Rect source2 = calcSpriteSourceRect(pTurretGraphic, drawnAngle, numImagesX);
     SDL_Rect dest2 = calcSpriteDrawingRect( pTurretGraphic,
-                                            screenborder->world2screenX(realX + deviatorTurretOffset[drawnAngle].x),
-                                            screenborder->world2screenY(realY + deviatorTurretOffset[drawnAngle].y),
+                                            screenborder->world2screenX(getDrawnX() + deviatorTurretOffset[drawnAngle].x),
+                                            screenborder->world2screenY(getDrawnY() + deviatorTurretOffset[drawnAngle].y),
                                             numImagesX, 1, HAlign::Center, VAlign::Center);
 
     SDL_RenderCopy(renderer, pTurretGraphic, &source2, &dest2);
@@ -96,8 +96,8 @@ void Deviator::blitToScreen()
 void Deviator::destroy() {
     if(currentGameMap->tileExists(location) && isVisible()) {
         Coord realPos(lround(realX), lround(realY));
-        Uint32 explosionID = currentGame->randomGen.getRandOf({Explosion_Medium1, Explosion_Medium2,Explosion_Flames});
-        currentGame->getExplosionList().push_back(new Explosion(explosionID, realPos, owner->getHouseID()));
+        Uint32 explosionID = randomGen.getRandOf({Explosion_Medium1, Explosion_Medium2,Explosion_Flames});
+        currentGame->getExplosionList().create(explosionID, realPos, owner->getHouseID());
 
         if(isVisible(getOwner()->getTeamID()))
             soundPlayer->playSoundAt(Sound_ExplosionMedium,location);
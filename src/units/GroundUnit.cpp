@@ -61,7 +61,7 @@ void GroundUnit::save(OutputStream& stream) const {
 void GroundUnit::assignToMap(const Coord& pos) {
     if (currentGameMap->tileExists(pos)) {
         currentGameMap->getTile(pos)->assignNonInfantryGroundObject(getObjectID());
-        currentGameMap->viewMap(owner->getHouseID(), pos, getViewRange());
+        currentGameMap->updateVisionSource(this, pos);
     }
 }
 
@@ -123,7 +123,7 @@ void GroundUnit::checkPos() {
                     setGettingRepaired();
                 } else {
                     // the repair yard is already in use by some other unit => move out
-                    Coord newDestination = currentGameMap->findDeploySpot(this, target.getObjPointer()->getLocation(), currentGame->randomGen, getLocation(), pRepairYard->getStructureSize());
+                    Coord newDestination = currentGameMap->findDeploySpot(this, target.getObjPointer()->getLocation(), randomGen, getLocation(), pRepairYard->getStructureSize());
                     doMove2Pos(newDestination, true);
                 }
             }
@@ -166,28 +166,28 @@ void GroundUnit::doRequestCarryallDrop(int xPos, int yPos) {
 
 bool GroundUnit::requestCarryall() {
     if (getOwner()->hasCarryalls() && !awaitingPickup)  {
-        Carryall* carryall = nullptr;
-
         // This allows a unit to keep requesting a carryall even if one isn't available right now
         doSetAttackMode(CARRYALLREQUESTED);
 
-        for(UnitBase* pUnit : unitList) {
-            if ((pUnit->getOwner() == owner) && (pUnit->getItemID() == Unit_Carryall)) {
-                if(!static_cast<Carryall*>(pUnit)->isBooked()) {
-                    carryall = static_cast<Carryall*>(pUnit);
-                    carryall->setTarget(this);
-                    carryall->clearPath();
-                    bookCarrier(carryall);
+        // the carryall is booked in assignCarryall() at the end of this cycle
+        getOwner()->requestCarryall(this);
+        return true;
+    }
 
-                    //setDestination(&location);    //stop moving, and wait for carryall to arrive
+    return false;
+}
 
-                    return true;
-                }
-            }
-        }
+void GroundUnit::assignCarryall(Carryall* pCarryall) {
+    if((pCarryall == nullptr) || awaitingPickup || pickedUp) {
+        // no carryall this cycle; checkPos() asks again as long as we are in CARRYALLREQUESTED mode
+        return;
     }
 
-    return false;
+    pCarryall->setTarget(this);
+    pCarryall->clearPath();
+    bookCarrier(pCarryall);
+
+    //setDestination(&location);    //stop moving, and wait for carryall to arrive
 }
 
 void GroundUnit::setPickedUp(UnitBase* newCarrier) {
@@ -224,7 +224,7 @@ const UnitBase* GroundUnit::getCarrier() const {
 
 void GroundUnit::move() {
     if(!moving && !justStoppedMoving && (((currentGame->getGameCycleCount() + getObjectID()) % 512) == 0)) {
-        currentGameMap->viewMap(owner->getHouseID(), location, getViewRange());
+        currentGameMap->updateVisionSource(this, location);
     }
 
     UnitBase::move();
@@ -250,8 +250,8 @@ void GroundUnit::doRepair() {
         FixPoint closestLeastBookedRepairYardDistance = 1000000;
         RepairYard* pBestRepairYard = nullptr;
 
-        for(StructureBase* pStructure : structureList) {
-            if ((pStructure->getItemID() == Structure_RepairYard) && (pStructure->getOwner() == owner)) {
+        for(StructureBase* pStructure : structureListByItemID[Structure_RepairYard]) {
+            if (pStructure->getOwner() == owner) {
                 RepairYard* pRepairYard = static_cast<RepairYard*>(pStructure);
 
                 if(pRepairYard->getNumBookings() == 0) {
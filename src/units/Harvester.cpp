@@ -99,8 +99,8 @@ void Harvester::save(OutputStream& stream) const
 
 void Harvester::blitToScreen()
 {
-    int x = screenborder->world2screenX(realX);
-    int y = screenborder->world2screenY(realY);
+    int x = screenborder->world2screenX(getDrawnX());
+    int y = screenborder->world2screenY(getDrawnY());
 
     SDL_Texture* pUnitGraphic = graphic[currentZoomlevel];
     SDL_Rect source = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX);
@@ -129,8 +129,8 @@ void Harvester::blitToScreen()
 
         SDL_Rect sandSource = calcSpriteSourceRect(pSandGraphic, drawnAngle, NUM_ANGLES, frame, LASTSANDFRAME+1);
         SDL_Rect sandDest = calcSpriteDrawingRect(  pSandGraphic,
-                                                    screenborder->world2screenX(realX + harvesterSandOffset[drawnAngle].x),
-                                                    screenborder->world2screenY(realY + harvesterSandOffset[drawnAngle].y),
+                                                    screenborder->world2screenX(getDrawnX() + harvesterSandOffset[drawnAngle].x),
+                                                    screenborder->world2screenY(getDrawnY() + harvesterSandOffset[drawnAngle].y),
                                                     NUM_ANGLES, LASTSANDFRAME+1,
                                                     HAlign::Center, VAlign::Center);
 
@@ -170,7 +170,7 @@ void Harvester::checkPos()
                         setReturned();
                     } else {
                         // the repair yard is already in use by some other unit => move out
-                        Coord newDestination = currentGameMap->findDeploySpot(this, target.getObjPointer()->getLocation(), currentGame->randomGen, getLocation(), pRefinery->getStructureSize());
+                        Coord newDestination = currentGameMap->findDeploySpot(this, target.getObjPointer()->getLocation(), randomGen, getLocation(), pRefinery->getStructureSize());
                         doMove2Pos(newDestination, true);
                         requestCarryall();
                     }
@@ -184,8 +184,8 @@ void Harvester::checkPos()
                 FixPoint closestLeastBookedRefineryDistance = FixPt32_MAX;
                 Refinery* pBestRefinery = nullptr;
 
-                for(StructureBase* pStructure : structureList) {
-                    if((pStructure->getItemID() == Structure_Refinery) && (pStructure->getOwner() == owner)) {
+                for(StructureBase* pStructure : structureListByItemID[Structure_Refinery]) {
+                    if(pStructure->getOwner() == owner) {
                         Refinery* pRefinery = static_cast<Refinery*>(pStructure);
                         Coord closestPoint = pRefinery->getClosestPoint(location);
                         FixPoint refineryDistance = blockDistance(location, closestPoint);
@@ -295,8 +295,8 @@ void Harvester::destroy()
         setTarget(nullptr);
 
         Coord realPos(lround(realX), lround(realY));
-        Uint32 explosionID = currentGame->randomGen.getRandOf({Explosion_Medium1, Explosion_Medium2});
-        currentGame->getExplosionList().push_back(new Explosion(explosionID, realPos, owner->getHouseID()));
+        Uint32 explosionID = randomGen.getRandOf({Explosion_Medium1, Explosion_Medium2});
+        currentGame->getExplosionList().create(explosionID, realPos, owner->getHouseID());
 
         if(isVisible(getOwner()->getTeamID())) {
             screenborder->shakeScreen(18);
@@ -318,16 +318,16 @@ void Harvester::drawSelectionBox()
         default:    selectionBox = pGFXManager->getUIGraphic(UI_SelectionBox_Zoomlevel2);   break;
     }
 
-    SDL_Rect dest = calcDrawingRect(selectionBox, screenborder->world2screenX(realX), screenborder->world2screenY(realY), HAlign::Center, VAlign::Center);
+    SDL_Rect dest = calcDrawingRect(selectionBox, screenborder->world2screenX(getDrawnX()), screenborder->world2screenY(getDrawnY()), HAlign::Center, VAlign::Center);
     SDL_RenderCopy(renderer, selectionBox, nullptr, &dest);
 
     for(int i=1;i<=currentZoomlevel+1;i++) {
-        renderDrawHLine(renderer, dest.x+1, dest.y-i, dest.x+1 + (lround((getHealth()/getMaxHealth())*(getWidth(selectionBox)-3))), getHealthColor());
+        currentGame->getPrimitiveBatcher().addHLine(dest.x+1, dest.y-i, dest.x+1 + (lround((getHealth()/getMaxHealth())*(getWidth(selectionBox)-3))), getHealthColor());
     }
 
     if((getOwner() == pLocalHouse) && (spice > 0)) {
         for(int i=1;i<=currentZoomlevel+1;i++) {
-            renderDrawHLine(renderer, dest.x+1, dest.y-i-(currentZoomlevel+1), dest.x+1 + (lround(((spice)/HARVESTERMAXSPICE)*(getWidth(selectionBox)-3))), COLOR_ORANGE);
+            currentGame->getPrimitiveBatcher().addHLine(dest.x+1, dest.y-i-(currentZoomlevel+1), dest.x+1 + (lround(((spice)/HARVESTERMAXSPICE)*(getWidth(selectionBox)-3))), COLOR_ORANGE);
         }
     }
 }
@@ -413,6 +413,28 @@ void Harvester::setReturned()
     setVisible(VIS_ALL, false);
 }
 
+void Harvester::navigate() {
+    if(isQueuedAtRefinery()) {
+        // wait here instead of crowding the entrance of the refinery
+        return;
+    }
+
+    TrackedUnit::navigate();
+}
+
+bool Harvester::isQueuedAtRefinery() {
+    if(!returningToRefinery || moving || (target.getObjPointer() == nullptr) || (target.getObjPointer()->getItemID() != Structure_Refinery)) {
+        return false;
+    }
+
+    Refinery* pRefinery = static_cast<Refinery*>(target.getObjPointer());
+    if(blockDistance(location, pRefinery->getClosestPoint(location)) > REFINERY_QUEUEDISTANCE) {
+        return false;
+    }
+
+    return !pRefinery->reserveDock(this);
+}
+
 void Harvester::move()
 {
     TrackedUnit::move();
@@ -103,15 +103,15 @@ void InfantryBase::doCaptureStructure(const StructureBase* pStructure) {
 void InfantryBase::assignToMap(const Coord& pos) {
     if(currentGameMap->tileExists(pos)) {
         oldTilePosition = tilePosition;
-        tilePosition = currentGameMap->getTile(pos)->assignInfantry(getObjectID());
-        currentGameMap->viewMap(owner->getHouseID(), pos, getViewRange());
+        tilePosition = currentGameMap->getTile(pos)->assignInfantry(getObjectID(), getOwner()->getTeamID());
+        currentGameMap->updateVisionSource(this, pos);
     }
 }
 
 void InfantryBase::blitToScreen() {
     SDL_Rect dest = calcSpriteDrawingRect(  graphic[currentZoomlevel],
-                                            screenborder->world2screenX(realX),
-                                            screenborder->world2screenY(realY),
+                                            screenborder->world2screenX(getDrawnX()),
+                                            screenborder->world2screenY(getDrawnY()),
                                             numImagesX, numImagesY,
                                             HAlign::Center, VAlign::Center);
 
@@ -240,7 +240,7 @@ void InfantryBase::checkPos() {
                         for(int j = capturedStructureLocation.y; j < capturedStructureLocation.y + pCapturedStructure->getStructureSizeY(); j++) {
 
                             // make a copy of infantry list to avoid problems of modifying the list during iteration (!)
-                            const std::list<Uint32> infantryList = currentGameMap->getTile(i,j)->getInfantryList();
+                            const auto infantryList = currentGameMap->getTile(i,j)->getInfantryList();
                             for(const Uint32& infantryID : infantryList) {
                                 if(infantryID != getObjectID()) {
                                     ObjectBase* pObject = currentGame->getObjectManager().getObject(infantryID);
@@ -332,7 +332,7 @@ void InfantryBase::destroy() {
         if(pTile->hasANonInfantryGroundObject() == true) {
             if(pTile->getNonInfantryGroundObject()->isAUnit()) {
                 // squashed
-                pTile->assignDeadUnit( currentGame->randomGen.randBool() ? DeadUnit_Infantry_Squashed1 : DeadUnit_Infantry_Squashed2,
+                pTile->assignDeadUnit( randomGen.randBool() ? DeadUnit_Infantry_Squashed1 : DeadUnit_Infantry_Squashed2,
                                             owner->getHouseID(),
                                             Coord(lround(realX), lround(realY)) );
 
@@ -360,7 +360,7 @@ void InfantryBase::destroy() {
 
 void InfantryBase::move() {
     if(!moving && !justStoppedMoving && (((currentGame->getGameCycleCount() + getObjectID()) % 512) == 0)) {
-        currentGameMap->viewMap(owner->getHouseID(), location, getViewRange());
+        currentGameMap->updateVisionSource(this, location);
     }
 
     if(moving && !justStoppedMoving) {
@@ -392,7 +392,9 @@ void InfantryBase::move() {
                 oldLocation = location;
                 location = nextSpot;
 
-                currentGameMap->viewMap(owner->getHouseID(), location, getViewRange());
+                currentGameMap->updateVisionSource(this, location);
+                currentGameMap->restartTargetScans(this, oldLocation);
+                currentGameMap->updateSandwormPrey(this);
             }
 
         } else {
@@ -477,7 +479,7 @@ void InfantryBase::setSpeeds() {
         dx -= sx;
         dy -= sy;
 
-        FixPoint scale = currentGame->objectData.data[itemID][originalHouseID].maxspeed/FixPoint::sqrt((dx*dx + dy*dy));
+        FixPoint scale = getObjectData().maxspeed/FixPoint::sqrt((dx*dx + dy*dy));
         xSpeed = dx*scale;
         ySpeed = dy*scale;
     }
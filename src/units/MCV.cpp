@@ -100,7 +100,7 @@ bool MCV::canAttack(const ObjectBase* object) const {
 void MCV::destroy() {
     if(currentGameMap->tileExists(location) && isVisible()) {
         Coord realPos(lround(realX), lround(realY));
-        currentGame->getExplosionList().push_back(new Explosion(Explosion_SmallUnit, realPos, owner->getHouseID()));
+        currentGame->getExplosionList().create(Explosion_SmallUnit, realPos, owner->getHouseID());
 
         if(isVisible(getOwner()->getTeamID()))
             soundPlayer->playSoundAt(Sound_ExplosionSmall,location);
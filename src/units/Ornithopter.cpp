@@ -56,7 +56,7 @@ void Ornithopter::init() {
     numWeapons = 1;
     bulletType = Bullet_SmallRocket;
 
-    currentMaxSpeed = currentGame->objectData.data[itemID][originalHouseID].maxspeed;
+    currentMaxSpeed = getObjectData().maxspeed;
 }
 
 Ornithopter::~Ornithopter() = default;
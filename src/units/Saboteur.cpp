@@ -145,8 +145,8 @@ bool Saboteur::canAttack(const ObjectBase* object) const {
 void Saboteur::destroy()
 {
     Coord realPos(lround(realX), lround(realY));
-    Uint32 explosionID = currentGame->randomGen.getRandOf({Explosion_Medium1, Explosion_Medium2});
-    currentGame->getExplosionList().push_back(new Explosion(explosionID, realPos, owner->getHouseID()));
+    Uint32 explosionID = randomGen.getRandOf({Explosion_Medium1, Explosion_Medium2});
+    currentGame->getExplosionList().create(explosionID, realPos, owner->getHouseID());
 
     if(isVisible(getOwner()->getTeamID())) {
         soundPlayer->playSoundAt(Sound_ExplosionLarge,location);
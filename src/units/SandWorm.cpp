@@ -172,8 +172,8 @@ void Sandworm::blitToScreen() {
 
     if(drawnFrame != INVALID) {
         SDL_Rect dest = calcSpriteDrawingRect(  graphic[currentZoomlevel],
-                                                screenborder->world2screenX(realX),
-                                                screenborder->world2screenY(realY),
+                                                screenborder->world2screenX(getDrawnX()),
+                                                screenborder->world2screenY(getDrawnY()),
                                                 numImagesX, numImagesY,
                                                 HAlign::Center, VAlign::Center);
         SDL_Rect source = calcSpriteSourceRect(graphic[currentZoomlevel], 0, numImagesX, drawnFrame, numImagesY);
@@ -245,7 +245,7 @@ void Sandworm::setLocation(int xPos, int yPos) {
     Put sandworm to sleep for a while
 */
 void Sandworm::sleep() {
-    sleepTimer = currentGame->randomGen.rand(MIN_SANDWORMSLEEPTIME, MAX_SANDWORMSLEEPTIME);
+    sleepTimer = randomGen.rand(MIN_SANDWORMSLEEPTIME, MAX_SANDWORMSLEEPTIME);
     setActive(false);
     setVisible(VIS_ALL, false);
     setForced(false);
@@ -356,8 +356,8 @@ bool Sandworm::update() {
                 // awaken the worm!
 
                 for(int tries = 0 ; tries < 1000 ; tries++) {
-                    int x = currentGame->randomGen.rand(0, currentGameMap->getSizeX() - 1);
-                    int y = currentGame->randomGen.rand(0, currentGameMap->getSizeY() - 1);
+                    int x = randomGen.rand(0, currentGameMap->getSizeX() - 1);
+                    int y = randomGen.rand(0, currentGameMap->getSizeY() - 1);
 
                     if(canPass(x, y)) {
                         deploy(currentGameMap->getTile(x, y)->getLocation());
@@ -408,15 +408,24 @@ const ObjectBase* Sandworm::findTarget() const {
     const ObjectBase* closestTarget = nullptr;
 
     if((attackMode == HUNT) || (attackMode == AREAGUARD)) {
+        if(!currentGameMap->tileExists(location)) {
+            return nullptr;
+        }
+
         FixPoint closestDistance = FixPt_MAX;
 
-        for(UnitBase* pUnit : unitList) {
-            if (canAttack(pUnit)
-                && (blockDistance(location, pUnit->getLocation()) < closestDistance)) {
-                closestTarget = pUnit;
-                closestDistance = blockDistance(location, pUnit->getLocation());
+        // only units in our sand region can be reached; on equal distance prefer the lower object id (= the unit that comes first in unitList)
+        const auto& objectManager = currentGame->getObjectManager();
+        currentGameMap->getSandwormPreyIndex().forEachInRegion(currentGameMap->getTile(location)->getSandRegion(), [&](Uint32 objectID) {
+            const ObjectBase* pUnit = objectManager.getObject(objectID);
+            if(canAttack(pUnit)) {
+                FixPoint distance = blockDistance(location, pUnit->getLocation());
+                if((distance < closestDistance) || ((distance == closestDistance) && (closestTarget != nullptr) && (pUnit->getObjectID() < closestTarget->getObjectID()))) {
+                    closestTarget = pUnit;
+                    closestDistance = distance;
+                }
             }
-        }
+        });
     } else {
         closestTarget = ObjectBase::findTarget();
     }
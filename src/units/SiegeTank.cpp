@@ -56,8 +56,8 @@ void SiegeTank::init() {
 SiegeTank::~SiegeTank() = default;
 
 void SiegeTank::blitToScreen() {
-    int x1 = screenborder->world2screenX(realX);
-    int y1 = screenborder->world2screenY(realY);
+    int x1 = screenborder->world2screenX(getDrawnX());
+    int y1 = screenborder->world2screenY(getDrawnY());
 
     SDL_Texture* pUnitGraphic = graphic[currentZoomlevel];
     SDL_Rect source1 = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX);
@@ -78,8 +78,8 @@ void SiegeTank::blitToScreen() {
     SDL_Texture* pTurretGraphic = turretGraphic[currentZoomlevel];
     SDL_Rect source2 = calcSpriteSourceRect(pTurretGraphic, drawnTurretAngle, NUM_ANGLES);
     SDL_Rect dest2 = calcSpriteDrawingRect( pTurretGraphic,
-                                            screenborder->world2screenX(realX + siegeTankTurretOffset[drawnTurretAngle].x),
-                                            screenborder->world2screenY(realY + siegeTankTurretOffset[drawnTurretAngle].y),
+                                            screenborder->world2screenX(getDrawnX() + siegeTankTurretOffset[drawnTurretAngle].x),
+                                            screenborder->world2screenY(getDrawnY() + siegeTankTurretOffset[drawnTurretAngle].y),
                                             NUM_ANGLES, 1, HAlign::Center, VAlign::Center);
 
     SDL_RenderCopy(renderer, pTurretGraphic, &source2, &dest2);
@@ -92,8 +92,8 @@ void SiegeTank::blitToScreen() {
 void SiegeTank::destroy() {
     if(currentGameMap->tileExists(location) && isVisible()) {
         Coord realPos(lround(realX), lround(realY));
-        Uint32 explosionID = currentGame->randomGen.getRandOf({Explosion_Medium1, Explosion_Medium2});
-        currentGame->getExplosionList().push_back(new Explosion(explosionID, realPos, owner->getHouseID()));
+        Uint32 explosionID = randomGen.getRandOf({Explosion_Medium1, Explosion_Medium2});
+        currentGame->getExplosionList().create(explosionID, realPos, owner->getHouseID());
 
         if(isVisible(getOwner()->getTeamID())) {
             screenborder->shakeScreen(18);
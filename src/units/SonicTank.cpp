@@ -57,8 +57,8 @@ void SonicTank::init() {
 SonicTank::~SonicTank() = default;
 
 void SonicTank::blitToScreen() {
-    int x1 = screenborder->world2screenX(realX);
-    int y1 = screenborder->world2screenY(realY);
+    int x1 = screenborder->world2screenX(getDrawnX());
+    int y1 = screenborder->world2screenY(getDrawnY());
 
     SDL_Texture* pUnitGraphic = graphic[currentZoomlevel];
     SDL_Rect source1 = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX);
@@ -79,8 +79,8 @@ void SonicTank::blitToScreen() {
     SDL_Texture* pTurretGraphic = turretGraphic[currentZoomlevel];
     SDL_Rect source2 = calcSpriteSourceRect(pTurretGraphic, drawnAngle, numImagesX);
     SDL_Rect dest2 = calcSpriteDrawingRect( pTurretGraphic,
-                                            screenborder->world2screenX(realX + sonicTankTurretOffset[drawnAngle].x),
-                                            screenborder->world2screenY(realY + sonicTankTurretOffset[drawnAngle].y),
+                                            screenborder->world2screenX(getDrawnX() + sonicTankTurretOffset[drawnAngle].x),
+                                            screenborder->world2screenY(getDrawnY() + sonicTankTurretOffset[drawnAngle].y),
                                             numImagesX, 1, HAlign::Center, VAlign::Center);
 
     SDL_RenderCopy(renderer, pTurretGraphic, &source2, &dest2);
@@ -93,7 +93,7 @@ void SonicTank::blitToScreen() {
 void SonicTank::destroy() {
     if(currentGameMap->tileExists(location) && isVisible()) {
         Coord realPos(lround(realX), lround(realY));
-        currentGame->getExplosionList().push_back(new Explosion(Explosion_SmallUnit, realPos, owner->getHouseID()));
+        currentGame->getExplosionList().create(Explosion_SmallUnit, realPos, owner->getHouseID());
 
         if(isVisible(getOwner()->getTeamID()))
             soundPlayer->playSoundAt(Sound_ExplosionSmall,location);
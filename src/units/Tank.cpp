@@ -58,8 +58,8 @@ Tank::~Tank() = default;
 
 
 void Tank::blitToScreen() {
-    int x = screenborder->world2screenX(realX);
-    int y = screenborder->world2screenY(realY);
+    int x = screenborder->world2screenX(getDrawnX());
+    int y = screenborder->world2screenY(getDrawnY());
 
     SDL_Texture* pUnitGraphic = graphic[currentZoomlevel];
     SDL_Rect source1 = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX);
@@ -81,8 +81,8 @@ void Tank::blitToScreen() {
 void Tank::destroy() {
     if(currentGameMap->tileExists(location) && isVisible()) {
         Coord realPos(lround(realX), lround(realY));
-        Uint32 explosionID = currentGame->randomGen.getRandOf({Explosion_Medium1, Explosion_Medium2,Explosion_Flames});
-        currentGame->getExplosionList().push_back(new Explosion(explosionID, realPos, owner->getHouseID()));
+        Uint32 explosionID = randomGen.getRandOf({Explosion_Medium1, Explosion_Medium2,Explosion_Flames});
+        currentGame->getExplosionList().create(explosionID, realPos, owner->getHouseID());
 
         if(isVisible(getOwner()->getTeamID()))
             soundPlayer->playSoundAt(Sound_ExplosionMedium,location);
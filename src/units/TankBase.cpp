@@ -87,15 +87,15 @@ void TankBase::navigate() {
 void TankBase::idleAction() {
     if(getAttackMode() == GUARD) {
         // do some random turning with 20% chance
-        switch(currentGame->randomGen.rand(0, 9)) {
+        switch(randomGen.rand(0, 9)) {
             case 0: {
                 // choose a random one of the eight possible angles
-                nextSpotAngle = currentGame->randomGen.rand(0, 7);
+                nextSpotAngle = randomGen.rand(0, 7);
             } break;
 
             case 1: {
                 // choose a random one of the eight possible angles
-                targetAngle = currentGame->randomGen.rand(0, 7);
+                targetAngle = randomGen.rand(0, 7);
             } break;
 
             default: {
@@ -159,11 +159,19 @@ void TankBase::engageTarget() {
     }
 }
 
+bool TankBase::isTargetScanPending() const {
+    if(active && (findTargetTimer == 0) && (attackMode != STOP) && !closeTarget && !moving && !justStoppedMoving) {
+        return true;
+    }
+
+    return TrackedUnit::isTargetScanPending();
+}
+
 void TankBase::targeting() {
     if(findTargetTimer == 0) {
         if(attackMode != STOP && !closeTarget && !moving && !justStoppedMoving) {
             // find a temporary target
-            closeTarget = findTarget();
+            closeTarget = getScannedTarget();
         }
     }
 
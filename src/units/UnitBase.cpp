@@ -39,6 +39,10 @@
 #include <structures/RepairYard.h>
 #include <units/Harvester.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 #define SMOKEDELAY 30
 #define UNITIDLETIMER (GAMESPEED_DEFAULT *  315)  // about every 5s
 
@@ -62,6 +66,8 @@ UnitBase::UnitBase(House* newOwner) : ObjectBase(newOwner) {
     ySpeed = 0;
     bumpyOffsetX = 0;
     bumpyOffsetY = 0;
+    previousRealX = realX;
+    previousRealY = realY;
 
     targetDistance = 0;
     targetAngle = INVALID;
@@ -70,6 +76,7 @@ UnitBase::UnitBase(House* newOwner) : ObjectBase(newOwner) {
     nextSpotFound = false;
     nextSpotAngle = drawnAngle;
     recalculatePathTimer = 0;
+    blockedCount = 0;
     nextSpot = Coord::Invalid();
 
     findTargetTimer = 0;
@@ -94,21 +101,24 @@ UnitBase::UnitBase(InputStream& stream) : ObjectBase(stream) {
     ySpeed = stream.readFixPoint();
     bumpyOffsetX = stream.readFixPoint();
     bumpyOffsetY = stream.readFixPoint();
+    previousRealX = realX;
+    previousRealY = realY;
 
     targetDistance = stream.readFixPoint();
     targetAngle = stream.readSint8();
 
     noCloserPointCount = stream.readUint8();
-    nextSpotFound = stream.readBool();
+    stream.readBools(&nextSpotFound, &bPathRequested);
     nextSpotAngle = stream.readSint8();
     recalculatePathTimer = stream.readSint32();
+    blockedCount = stream.readUint8();
     nextSpot.x = stream.readSint32();
     nextSpot.y = stream.readSint32();
-    int numPathNodes = stream.readUint32();
-    for(int i=0;i<numPathNodes; i++) {
-        Sint32 x = stream.readSint32();
-        Sint32 y = stream.readSint32();
-        pathList.emplace_back(x,y);
+    const Uint32 numPathNodes = stream.readUint32();
+    std::vector<Sint32> pathCoords(2*numPathNodes);
+    stream.readSint32Array(pathCoords.data(), pathCoords.size());
+    for(Uint32 i = 0; i < numPathNodes; i++) {
+        pathList.emplace_back(pathCoords[2*i], pathCoords[2*i+1]);
     }
 
     findTargetTimer = stream.readSint32();
@@ -164,16 +174,20 @@ void UnitBase::save(OutputStream& stream) const {
     stream.writeSint8(targetAngle);
 
     stream.writeUint8(noCloserPointCount);
-    stream.writeBool(nextSpotFound);
+    stream.writeBools(nextSpotFound, bPathRequested);
     stream.writeSint8(nextSpotAngle);
     stream.writeSint32(recalculatePathTimer);
+    stream.writeUint8(blockedCount);
     stream.writeSint32(nextSpot.x);
     stream.writeSint32(nextSpot.y);
-    stream.writeUint32(pathList.size());
+    std::vector<Sint32> pathCoords;
+    pathCoords.reserve(2*pathList.size());
     for(const Coord& coord : pathList) {
-        stream.writeSint32(coord.x);
-        stream.writeSint32(coord.y);
+        pathCoords.push_back(coord.x);
+        pathCoords.push_back(coord.y);
     }
+    stream.writeUint32(pathList.size());
+    stream.writeSint32Array(pathCoords.data(), pathCoords.size());
 
     stream.writeSint32(findTargetTimer);
     stream.writeSint32(primaryWeaponTimer);
@@ -201,7 +215,7 @@ bool UnitBase::attack() {
             }
 
             int currentBulletType = bulletType;
-            Sint32 currentWeaponDamage = currentGame->objectData.data[itemID][originalHouseID].weapondamage;
+            Sint32 currentWeaponDamage = getObjectData().weapondamage;
 
             if(getItemID() == Unit_Trooper && !bAirBullet) {
                 // Troopers change weapon type depending on distance
@@ -217,7 +231,7 @@ bool UnitBase::attack() {
             }
 
             if(primaryWeaponTimer == 0) {
-                bulletList.push_back( new Bullet( objectID, &centerPoint, &targetCenterPoint, currentBulletType, currentWeaponDamage, bAirBullet, pObject) );
+                bulletList.create(objectID, &centerPoint, &targetCenterPoint, currentBulletType, currentWeaponDamage, bAirBullet, pObject);
                 if(pObject != nullptr) {
                     currentGameMap->viewMap(pObject->getOwner()->getHouseID(), location, 2);
                 }
@@ -239,7 +253,7 @@ bool UnitBase::attack() {
             }
 
             if((numWeapons == 2) && (secondaryWeaponTimer == 0) && (isBadlyDamaged() == false)) {
-                bulletList.push_back( new Bullet( objectID, &centerPoint, &targetCenterPoint, currentBulletType, currentWeaponDamage, bAirBullet, pObject) );
+                bulletList.create(objectID, &centerPoint, &targetCenterPoint, currentBulletType, currentWeaponDamage, bAirBullet, pObject);
                 if(pObject != nullptr) {
                     currentGameMap->viewMap(pObject->getOwner()->getHouseID(), location, 2);
                 }
@@ -265,8 +279,8 @@ bool UnitBase::attack() {
 }
 
 void UnitBase::blitToScreen() {
-    int x = screenborder->world2screenX(realX);
-    int y = screenborder->world2screenY(realY);
+    int x = screenborder->world2screenX(getDrawnX());
+    int y = screenborder->world2screenY(getDrawnY());
 
     SDL_Texture* pUnitGraphic = graphic[currentZoomlevel];
     SDL_Rect source = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX, drawnFrame, numImagesY);
@@ -339,9 +353,11 @@ void UnitBase::destroy() {
     currentGame->getHouse(originalHouseID)->decrementUnits(itemID);
 
     unitList.remove(this);
+    unitListByItemID[itemID].remove(this);
+    currentGameMap->removeSandwormPrey(this);
 
     if(isVisible()) {
-        if(currentGame->randomGen.rand(1,100) <= getInfSpawnProp()) {
+        if(randomGen.rand(1,100) <= getInfSpawnProp()) {
             UnitBase* pNewUnit = currentGame->getHouse(originalHouseID)->createUnit(Unit_Soldier);
             pNewUnit->setHealth(pNewUnit->getMaxHealth()/2);
             pNewUnit->deploy(location);
@@ -351,6 +367,9 @@ void UnitBase::destroy() {
                 pNewUnit->owner = owner;
                 pNewUnit->graphic = pGFXManager->getObjPic(pNewUnit->graphicID,owner->getHouseID());
                 pNewUnit->deviationTimer = deviationTimer;
+                if(currentGameMap->tileExists(pNewUnit->getLocation())) {
+                    currentGameMap->getTile(pNewUnit->getLocation())->updateInfantryTeam();
+                }
             }
         }
     }
@@ -373,6 +392,11 @@ void UnitBase::deviate(House* newOwner) {
 
         graphic = pGFXManager->getObjPic(graphicID,getOwner()->getHouseID());
         deviationTimer = DEVIATIONTIME;
+        if(currentGameMap->tileExists(location)) {
+            currentGameMap->getTile(location)->invalidateRadarColor();
+            currentGameMap->getTile(location)->updateInfantryTeam();
+            currentGameMap->noteTargetsChanged(location);
+        }
     }
 
     // Adding this in as a surrogate for damage inflicted upon deviation.. Still not sure what the best value
@@ -399,13 +423,13 @@ void UnitBase::drawSelectionBox() {
         default:    selectionBox = pGFXManager->getUIGraphic(UI_SelectionBox_Zoomlevel2);   break;
     }
 
-    SDL_Rect dest = calcDrawingRect(selectionBox, screenborder->world2screenX(realX), screenborder->world2screenY(realY), HAlign::Center, VAlign::Center);
+    SDL_Rect dest = calcDrawingRect(selectionBox, screenborder->world2screenX(getDrawnX()), screenborder->world2screenY(getDrawnY()), HAlign::Center, VAlign::Center);
     SDL_RenderCopy(renderer, selectionBox, nullptr, &dest);
 
-    int x = screenborder->world2screenX(realX) - getWidth(selectionBox)/2;
-    int y = screenborder->world2screenY(realY) - getHeight(selectionBox)/2;
+    int x = screenborder->world2screenX(getDrawnX()) - getWidth(selectionBox)/2;
+    int y = screenborder->world2screenY(getDrawnY()) - getHeight(selectionBox)/2;
     for(int i=1;i<=currentZoomlevel+1;i++) {
-        renderDrawHLine(renderer, x+1, y-i, x+1 + (lround((getHealth()/getMaxHealth())*(getWidth(selectionBox)-3))), getHealthColor());
+        currentGame->getPrimitiveBatcher().addHLine(x+1, y-i, x+1 + (lround((getHealth()/getMaxHealth())*(getWidth(selectionBox)-3))), getHealthColor());
     }
 }
 
@@ -419,7 +443,7 @@ void UnitBase::drawOtherPlayerSelectionBox() {
         default:    selectionBox = pGFXManager->getUIGraphic(UI_OtherPlayerSelectionBox_Zoomlevel2);   break;
     }
 
-    SDL_Rect dest = calcDrawingRect(selectionBox, screenborder->world2screenX(realX), screenborder->world2screenY(realY), HAlign::Center, VAlign::Center);
+    SDL_Rect dest = calcDrawingRect(selectionBox, screenborder->world2screenX(getDrawnX()), screenborder->world2screenY(getDrawnY()), HAlign::Center, VAlign::Center);
     SDL_RenderCopy(renderer, selectionBox, nullptr, &dest);
 }
 
@@ -578,8 +602,11 @@ void UnitBase::move() {
                 location = nextSpot;
 
                 if(isAFlyingUnit() == false && itemID != Unit_Sandworm) {
-                    currentGameMap->viewMap(owner->getHouseID(), location, getViewRange());
+                    currentGameMap->updateVisionSource(this, location);
                 }
+
+                currentGameMap->restartTargetScans(this, oldLocation);
+                currentGameMap->updateSandwormPrey(this);
             }
 
         } else {
@@ -622,44 +649,67 @@ void UnitBase::move() {
 
 void UnitBase::bumpyMovementOnRock(FixPoint fromDistanceX, FixPoint fromDistanceY, FixPoint toDistanceX, FixPoint toDistanceY) {
 
-    if(hasBumpyMovementOnRock() && ((currentGameMap->getTile(location)->getType() == Terrain_Rock)
-                                    || (currentGameMap->getTile(location)->getType() == Terrain_Mountain)
-                                    || (currentGameMap->getTile(location)->getType() == Terrain_ThickSpice))) {
-        // bumping effect
+    if(!hasBumpyMovementOnRock()) {
+        return;
+    }
+
+    const auto terrainType = currentGameMap->getTile(location)->getType();
+    if((terrainType != Terrain_Rock) && (terrainType != Terrain_Mountain) && (terrainType != Terrain_ThickSpice)) {
+        return;
+    }
 
-        const FixPoint epsilon = 0.005_fix;
-        const FixPoint bumpyOffset = 2.5_fix;
-        const FixPoint absXSpeed = FixPoint::abs(xSpeed);
-        const FixPoint absYSpeed = FixPoint::abs(ySpeed);
+    // bumping effect
 
+    const FixPoint epsilon = 0.005_fix;
+    const FixPoint bumpyOffset = 2.5_fix;
+    const FixPoint absXSpeed = FixPoint::abs(xSpeed);
+    const FixPoint absYSpeed = FixPoint::abs(ySpeed);
 
-        if((FixPoint::abs(xSpeed) >= epsilon) && (FixPoint::abs(fromDistanceX - absXSpeed) < absXSpeed/2)) { realY -= bumpyOffset; bumpyOffsetY -= bumpyOffset; }
-        if((FixPoint::abs(ySpeed) >= epsilon) && (FixPoint::abs(fromDistanceY - absYSpeed) < absYSpeed/2)) { realX += bumpyOffset; bumpyOffsetX += bumpyOffset; }
+    // the speeds do not change while bumping, so everything that only depends on them is calculated once
+    const bool bMovingX = (absXSpeed >= epsilon);
+    const bool bMovingY = (absYSpeed >= epsilon);
+    const FixPoint halfXSpeed = absXSpeed/2;
+    const FixPoint halfYSpeed = absYSpeed/2;
+    const FixPoint xSpeed4 = 4*absXSpeed;
+    const FixPoint ySpeed4 = 4*absYSpeed;
+    const FixPoint xSpeed10 = 10*absXSpeed;
+    const FixPoint ySpeed10 = 10*absYSpeed;
+    const FixPoint xSpeed14 = 14*absXSpeed;
+    const FixPoint ySpeed14 = 14*absYSpeed;
+    const FixPoint ySpeed20 = 20*absYSpeed;
 
-        if((FixPoint::abs(xSpeed) >= epsilon) && (FixPoint::abs(fromDistanceX - 4*absXSpeed) < absXSpeed/2)) { realY += bumpyOffset; bumpyOffsetY += bumpyOffset; }
-        if((FixPoint::abs(ySpeed) >= epsilon) && (FixPoint::abs(fromDistanceY - 4*absYSpeed) < absYSpeed/2)) { realX -= bumpyOffset; bumpyOffsetX -= bumpyOffset; }
+    const auto bumpX = [&](FixPoint distance, FixPoint speedDistance, FixPoint offset) {
+        if(bMovingX && (FixPoint::abs(distance - speedDistance) < halfXSpeed)) { realY += offset; bumpyOffsetY += offset; }
+    };
+    const auto bumpY = [&](FixPoint distance, FixPoint speedDistance, FixPoint offset) {
+        if(bMovingY && (FixPoint::abs(distance - speedDistance) < halfYSpeed)) { realX += offset; bumpyOffsetX += offset; }
+    };
 
+    bumpX(fromDistanceX, absXSpeed, -bumpyOffset);
+    bumpY(fromDistanceY, absYSpeed, bumpyOffset);
 
-        if((FixPoint::abs(xSpeed) >= epsilon) && (FixPoint::abs(fromDistanceX - 10*absXSpeed) < absXSpeed/2)) { realY -= bumpyOffset; bumpyOffsetY -= bumpyOffset; }
-        if((FixPoint::abs(ySpeed) >= epsilon) && (FixPoint::abs(fromDistanceY - 20*absYSpeed) < absYSpeed/2)) { realX += bumpyOffset; bumpyOffsetX += bumpyOffset; }
+    bumpX(fromDistanceX, xSpeed4, bumpyOffset);
+    bumpY(fromDistanceY, ySpeed4, -bumpyOffset);
 
-        if((FixPoint::abs(xSpeed) >= epsilon) && (FixPoint::abs(fromDistanceX - 14*absXSpeed) < absXSpeed/2)) { realY += bumpyOffset; bumpyOffsetY += bumpyOffset; }
-        if((FixPoint::abs(ySpeed) >= epsilon) && (FixPoint::abs(fromDistanceY - 14*absYSpeed) < absYSpeed/2)) { realX -= bumpyOffset; bumpyOffsetX -= bumpyOffset; }
 
+    bumpX(fromDistanceX, xSpeed10, -bumpyOffset);
+    bumpY(fromDistanceY, ySpeed20, bumpyOffset);
 
-        if((FixPoint::abs(xSpeed) >= epsilon) && (FixPoint::abs(toDistanceX - absXSpeed) < absXSpeed/2)) { realY -= bumpyOffset; bumpyOffsetY -= bumpyOffset; }
-        if((FixPoint::abs(ySpeed) >= epsilon) && (FixPoint::abs(toDistanceY - absYSpeed) < absYSpeed/2)) { realX += bumpyOffset; bumpyOffsetX += bumpyOffset; }
+    bumpX(fromDistanceX, xSpeed14, bumpyOffset);
+    bumpY(fromDistanceY, ySpeed14, -bumpyOffset);
 
-        if((FixPoint::abs(xSpeed) >= epsilon) && (FixPoint::abs(toDistanceX - 4*absXSpeed) < absXSpeed/2)) { realY += bumpyOffset; bumpyOffsetY += bumpyOffset; }
-        if((FixPoint::abs(ySpeed) >= epsilon) && (FixPoint::abs(toDistanceY - 4*absYSpeed) < absYSpeed/2)) { realX -= bumpyOffset; bumpyOffsetX -= bumpyOffset; }
 
-        if((FixPoint::abs(xSpeed) >= epsilon) && (FixPoint::abs(toDistanceX - 10*absXSpeed) < absXSpeed/2)) { realY -= bumpyOffset; bumpyOffsetY -= bumpyOffset; }
-        if((FixPoint::abs(ySpeed) >= epsilon) && (FixPoint::abs(toDistanceY - 10*absYSpeed) < absYSpeed/2)) { realX += bumpyOffset; bumpyOffsetX += bumpyOffset; }
+    bumpX(toDistanceX, absXSpeed, -bumpyOffset);
+    bumpY(toDistanceY, absYSpeed, bumpyOffset);
 
-        if((FixPoint::abs(xSpeed) >= epsilon) && (FixPoint::abs(toDistanceX - 14*absXSpeed) < absXSpeed/2)) { realY += bumpyOffset; bumpyOffsetY += bumpyOffset; }
-        if((FixPoint::abs(ySpeed) >= epsilon) && (FixPoint::abs(toDistanceY - 14*absYSpeed) < absYSpeed/2)) { realX -= bumpyOffset; bumpyOffsetX -= bumpyOffset; }
+    bumpX(toDistanceX, xSpeed4, bumpyOffset);
+    bumpY(toDistanceY, ySpeed4, -bumpyOffset);
 
-    }
+    bumpX(toDistanceX, xSpeed10, -bumpyOffset);
+    bumpY(toDistanceY, ySpeed10, bumpyOffset);
+
+    bumpX(toDistanceX, xSpeed14, bumpyOffset);
+    bumpY(toDistanceY, ySpeed14, -bumpyOffset);
 }
 
 void UnitBase::navigate() {
@@ -671,46 +721,11 @@ void UnitBase::navigate() {
             if(location != destination) {
                 if(nextSpotFound == false)  {
 
-                    if(pathList.empty() && (recalculatePathTimer == 0)) {
-                        recalculatePathTimer = 100;
-
-                        if(!SearchPathWithAStar() && (++noCloserPointCount >= 3)
-                            && (location != oldLocation))
-                        {   //try searching for a path a number of times then give up
-                            if (target.getObjPointer() != nullptr && targetFriendly
-                                && (target.getObjPointer()->getItemID() != Structure_RepairYard)
-                                && ((target.getObjPointer()->getItemID() != Structure_Refinery)
-                                || (getItemID() != Unit_Harvester))) {
-                                setTarget(nullptr);
-                            }
-
-                            /// This method will transport units if they get stuck inside a base
-                            /// This often happens after an AI get nuked and has a hole in their base
-                            if(getOwner()->hasCarryalls()
-                               && this->isAGroundUnit()
-                               && (currentGame->getGameInitSettings().getGameOptions().manualCarryallDrops || getOwner()->isAI())
-                               && blockDistance(location, destination) >= MIN_CARRYALL_LIFT_DISTANCE ) {
-                               static_cast<GroundUnit*>(this)->requestCarryall();
-                            } else if(  getOwner()->isAI()
-                                        && (getItemID() == Unit_Harvester)
-                                        && !static_cast<Harvester*>(this)->isReturning()
-                                        && blockDistance(location, destination) >= 2) {
-                                // try getting back to a refinery
-                                static_cast<Harvester*>(this)->doReturn();
-                            } else {
-                                setDestination(location);   //can't get any closer, give up
-                                forced = false;
-                            }
-                        }
+                    if(pathList.empty() && (recalculatePathTimer == 0) && !bPathRequested) {
+                        requestPath();
                     }
 
-                    if(!pathList.empty()) {
-                        nextSpot = pathList.front();
-                        pathList.pop_front();
-                        nextSpotFound = true;
-                        recalculatePathTimer = 0;
-                        noCloserPointCount = 0;
-                    }
+                    takeNextSpotFromPath();
                 } else {
                     int tempAngle = currentGameMap->getPosAngle(location, nextSpot);
                     if(tempAngle != INVALID) {
@@ -718,11 +733,17 @@ void UnitBase::navigate() {
                     }
 
                     if(!canPass(nextSpot.x, nextSpot.y)) {
-                        clearPath();
+                        if(shouldWaitForBlockingUnit()) {
+                            // most blockages inside a moving group clear up by themselves
+                            blockedCount++;
+                        } else if(!repairPath()) {
+                            clearPath();
+                        }
                     } else {
                         if (drawnAngle == nextSpotAngle)    {
                             moving = true;
                             nextSpotFound = false;
+                            blockedCount = 0;
 
                             assignToMap(nextSpot);
                             angle = drawnAngle;
@@ -739,13 +760,97 @@ void UnitBase::navigate() {
     }
 }
 
+bool UnitBase::shouldWaitForBlockingUnit() const {
+    if((blockedCount >= UNIT_MAXBLOCKEDWAIT) || !currentGameMap->tileExists(nextSpot)) {
+        return false;
+    }
+
+    const Tile* pTile = currentGameMap->getTile(nextSpot);
+    if(pTile->isMountain() || !pTile->hasAGroundObject()) {
+        return false;
+    }
+
+    const ObjectBase* pObject = pTile->getGroundObject();
+    if((pObject == nullptr) || !pObject->isAGroundUnit() || (pObject->getOwner()->getTeamID() != owner->getTeamID())) {
+        return false;
+    }
+
+    const UnitBase* pBlockingUnit = static_cast<const UnitBase*>(pObject);
+    return pBlockingUnit->isMoving() || (pBlockingUnit->getLocation() != pBlockingUnit->getDestination());
+}
+
+bool UnitBase::repairPath() {
+    if(pathList.empty()) {
+        return false;
+    }
+
+    constexpr int boxSize = 2*PATHREPAIR_RADIUS + 1;
+    const Coord boxOrigin = location - Coord(PATHREPAIR_RADIUS, PATHREPAIR_RADIUS);
+    const auto boxIndex = [&](const Coord& coord) { return (coord.y - boxOrigin.y) * boxSize + (coord.x - boxOrigin.x); };
+
+    // the spots the detour may rejoin
+    std::array<Coord, PATHREPAIR_LOOKAHEAD> rejoinSpots;
+    int numRejoinSpots = 0;
+    for(const Coord& coord : pathList) {
+        if(numRejoinSpots == PATHREPAIR_LOOKAHEAD) {
+            break;
+        }
+        rejoinSpots[numRejoinSpots++] = coord;
+    }
+
+    std::array<Sint16, boxSize*boxSize> parents;
+    parents.fill(-1);
+    std::array<Coord, boxSize*boxSize> queue;
+    int queueHead = 0;
+    int queueTail = 0;
+
+    queue[queueTail++] = location;
+    parents[boxIndex(location)] = boxIndex(location);
+
+    while(queueHead < queueTail) {
+        const Coord current = queue[queueHead++];
+
+        for(int angle = 0; angle < NUM_ANGLES; angle++) {
+            const Coord next = Map::getMapPos(angle, current);
+            if((std::abs(next.x - location.x) > PATHREPAIR_RADIUS) || (std::abs(next.y - location.y) > PATHREPAIR_RADIUS)
+                || (parents[boxIndex(next)] != -1) || (next == nextSpot) || !canPass(next.x, next.y)) {
+                continue;
+            }
+
+            parents[boxIndex(next)] = boxIndex(current);
+
+            const auto rejoinIter = std::find(rejoinSpots.begin(), rejoinSpots.begin() + numRejoinSpots, next);
+            if(rejoinIter != rejoinSpots.begin() + numRejoinSpots) {
+                // drop the path up to the rejoin spot and put the detour in front of the rest
+                for(auto iter = rejoinSpots.begin(); iter <= rejoinIter; ++iter) {
+                    pathList.pop_front();
+                }
+
+                for(Coord coord = next; coord != location; ) {
+                    pathList.push_front(coord);
+                    const int parent = parents[boxIndex(coord)];
+                    coord = boxOrigin + Coord(parent % boxSize, parent / boxSize);
+                }
+
+                blockedCount = 0;
+                takeNextSpotFromPath();
+                return true;
+            }
+
+            queue[queueTail++] = next;
+        }
+    }
+
+    return false;
+}
+
 void UnitBase::idleAction() {
     //not moving and not wanting to go anywhere, do some random turning
     if(isAGroundUnit() && (getItemID() != Unit_Harvester) && (getAttackMode() == GUARD)) {
         // we might turn this cylce with 20% chance
-        if(currentGame->randomGen.rand(0, 4) == 0) {
+        if(randomGen.rand(0, 4) == 0) {
             // choose a random one of the eight possible angles
-            nextSpotAngle = currentGame->randomGen.rand(0, 7);
+            nextSpotAngle = randomGen.rand(0, 7);
         }
     }
 }
@@ -1129,6 +1234,11 @@ void UnitBase::setLocation(int xPos, int yPos) {
         bumpyOffsetY = 0;
     }
 
+    currentGameMap->updateSandwormPrey(this);
+
+    // do not interpolate between the old and the new location
+    savePreviousPosition();
+
     moving = false;
     pickedUp = false;
     setTarget(nullptr);
@@ -1136,6 +1246,27 @@ void UnitBase::setLocation(int xPos, int yPos) {
     clearPath();
 }
 
+/**
+    Interpolates between the position at the start of the last game cycle and the current position. Jumps of more than
+    one tile (e.g. when being dropped by a carryall) are not interpolated.
+*/
+static float interpolateDrawnPosition(FixPoint previous, FixPoint current) {
+    const float delta = (current - previous).toFloat();
+    if(std::abs(delta) > TILESIZE) {
+        return current.toFloat();
+    }
+
+    return previous.toFloat() + delta * currentGame->getDrawInterpolation();
+}
+
+float UnitBase::getDrawnX() const {
+    return interpolateDrawnPosition(previousRealX, realX);
+}
+
+float UnitBase::getDrawnY() const {
+    return interpolateDrawnPosition(previousRealY, realY);
+}
+
 void UnitBase::setPickedUp(UnitBase* newCarrier) {
     if(selected) {
         removeFromSelectionLists();
@@ -1168,7 +1299,7 @@ void UnitBase::setPickedUp(UnitBase* newCarrier) {
 }
 
 FixPoint UnitBase::getMaxSpeed() const {
-    return currentGame->objectData.data[itemID][originalHouseID].maxspeed;
+    return getObjectData().maxspeed;
 }
 
 void UnitBase::setSpeeds() {
@@ -1213,6 +1344,19 @@ void UnitBase::setTarget(const ObjectBase* newTarget) {
     }
 }
 
+bool UnitBase::isTargetScanPending() const {
+    if(!active || (findTargetTimer != 0) || (attackMode == STOP) || (attackMode == CARRYALLREQUESTED)) {
+        return false;
+    }
+
+    // the same conditions as in targeting()
+    if(target && !attackPos && !forced && (attackMode == GUARD || attackMode == AREAGUARD || attackMode == HUNT)) {
+        return !isInWeaponRange(target.getObjPointer());
+    }
+
+    return !target && !attackPos && !moving && !justStoppedMoving && !forced;
+}
+
 void UnitBase::targeting() {
     if(findTargetTimer == 0) {
 
@@ -1221,13 +1365,13 @@ void UnitBase::targeting() {
             // lets add a bit of logic to make units recalibrate their nearest target if the target isn't in weapon range
             if(target && !attackPos && !forced &&(attackMode == GUARD || attackMode == AREAGUARD || attackMode == HUNT)){
                 if(!isInWeaponRange(target.getObjPointer())){
-                    const ObjectBase* pNewTarget = findTarget();
+                    const ObjectBase* pNewTarget = getScannedTarget();
 
                     if(pNewTarget != nullptr) {
 
                         doAttackObject(pNewTarget, false);
 
-                        findTargetTimer = 500;
+                        findTargetTimer = 500 + getTargetScanStagger();
                     }
                 }
             }
@@ -1236,7 +1380,7 @@ void UnitBase::targeting() {
             if(!target && !attackPos && !moving && !justStoppedMoving && !forced) {
                 // we have no target, we have stopped moving and we weren't forced to do anything else
 
-                const ObjectBase* pNewTarget = findTarget();
+                const ObjectBase* pNewTarget = getScannedTarget();
 
                 if(pNewTarget != nullptr && isInGuardRange(pNewTarget)) {
                     // we have found a new target => attack it
@@ -1254,7 +1398,7 @@ void UnitBase::targeting() {
                 }
 
                 // reset target timer
-                findTargetTimer = MILLI2CYCLES(2*1000);
+                findTargetTimer = MILLI2CYCLES(2*1000) + getTargetScanStagger();
             }
         }
 
@@ -1296,7 +1440,7 @@ void UnitBase::turn() {
 }
 
 void UnitBase::turnLeft() {
-    angle += currentGame->objectData.data[itemID][originalHouseID].turnspeed;
+    angle += getObjectData().turnspeed;
     if(angle >= 7.5_fix) {
         drawnAngle = lround(angle) - NUM_ANGLES;
         angle -= NUM_ANGLES;
@@ -1306,7 +1450,7 @@ void UnitBase::turnLeft() {
 }
 
 void UnitBase::turnRight() {
-    angle -= currentGame->objectData.data[itemID][originalHouseID].turnspeed;
+    angle -= getObjectData().turnspeed;
     if(angle <= -0.5_fix) {
         drawnAngle = lround(angle) + NUM_ANGLES;
         angle += NUM_ANGLES;
@@ -1325,6 +1469,11 @@ void UnitBase::quitDeviation() {
         owner = currentGame->getHouse(originalHouseID);
         graphic = pGFXManager->getObjPic(graphicID,getOwner()->getHouseID());
         deviationTimer = INVALID;
+        if(currentGameMap->tileExists(location)) {
+            currentGameMap->getTile(location)->invalidateRadarColor();
+            currentGameMap->getTile(location)->updateInfantryTeam();
+            currentGameMap->noteTargetsChanged(location);
+        }
     }
 }
 
@@ -1421,30 +1570,109 @@ bool UnitBase::canPass(int xPos, int yPos) const {
     return true;
 }
 
-bool UnitBase::SearchPathWithAStar() {
-    Coord destinationCoord;
+void UnitBase::requestPath() {
+    bPathRequested = true;
+    currentGameMap->getPathRequestQueue().request(this);
+}
+
+void UnitBase::takeNextSpotFromPath() {
+    if(!pathList.empty()) {
+        nextSpot = pathList.front();
+        pathList.pop_front();
+        nextSpotFound = true;
+        recalculatePathTimer = 0;
+        noCloserPointCount = 0;
+    }
+}
 
+bool UnitBase::preparePathSearch(Coord& searchDestination, std::list<Coord>& path) {
     if(target && target.getObjPointer() != nullptr) {
         if(itemID == Unit_Carryall && target.getObjPointer()->getItemID() == Structure_Refinery) {
-            destinationCoord = target.getObjPointer()->getLocation() + Coord(2,0);
+            searchDestination = target.getObjPointer()->getLocation() + Coord(2,0);
         } else if(itemID == Unit_Frigate && target.getObjPointer()->getItemID() == Structure_StarPort) {
-            destinationCoord = target.getObjPointer()->getLocation() + Coord(1,1);
+            searchDestination = target.getObjPointer()->getLocation() + Coord(1,1);
         } else {
-            destinationCoord = target.getObjPointer()->getClosestPoint(location);
+            searchDestination = target.getObjPointer()->getClosestPoint(location);
         }
     } else {
-        destinationCoord = destination;
+        searchDestination = destination;
+    }
+
+    if(isAFlyingUnit()) {
+        // nothing blocks flying units, so the path is the straight line (diagonal steps first) and no search is needed.
+        // AirUnit::navigate() steers directly towards the destination anyway, this is only a fallback.
+        Coord current = location;
+        while(current != searchDestination) {
+            current.x += (searchDestination.x > current.x) - (searchDestination.x < current.x);
+            current.y += (searchDestination.y > current.y) - (searchDestination.y < current.y);
+            path.push_back(current);
+        }
+        return true;
+    }
+
+    if(!target && currentGameMap->getFlowFieldCache().getPath(this, searchDestination, path)) {
+        // another unit of the same group already calculated a flow field to this destination
+        return true;
+    }
+
+    if(isAGroundUnit() && (itemID != Unit_Sandworm)) {
+        ConnectivityMap& connectivity = currentGameMap->getConnectivityMap();
+        if(!connectivity.isReachable(isInfantry(), location, searchDestination)) {
+            // the destination is enclosed by obstacles (e.g. on a plateau); get as close as possible instead
+            Coord closest;
+            if(connectivity.findClosestReachable(isInfantry(), location, searchDestination, closest)) {
+                searchDestination = closest;
+            }
+        }
+
+        // for long distances only search the path to the next waypoint of the coarse route
+        Coord waypoint;
+        if(currentGameMap->getHierarchicalPathGraph().findWaypoint(isInfantry(), location, searchDestination, waypoint)) {
+            searchDestination = waypoint;
+        }
     }
 
-    AStarSearch pathfinder(currentGameMap, this, location, destinationCoord);
-    pathList = pathfinder.getFoundPath();
+    return false;
+}
 
-    if(pathList.empty() == true) {
+void UnitBase::onPathSearchFinished(std::list<Coord>&& path) {
+    bPathRequested = false;
+    recalculatePathTimer = 100;
+    pathList = std::move(path);
+
+    if(pathList.empty()) {
         nextSpotFound = false;
-        return false;
-    } else {
-        return true;
+
+        if((++noCloserPointCount >= 3) && (location != oldLocation)) {
+            //try searching for a path a number of times then give up
+            if (target.getObjPointer() != nullptr && targetFriendly
+                && (target.getObjPointer()->getItemID() != Structure_RepairYard)
+                && ((target.getObjPointer()->getItemID() != Structure_Refinery)
+                || (getItemID() != Unit_Harvester))) {
+                setTarget(nullptr);
+            }
+
+            /// This method will transport units if they get stuck inside a base
+            /// This often happens after an AI get nuked and has a hole in their base
+            if(getOwner()->hasCarryalls()
+               && this->isAGroundUnit()
+               && (currentGame->getGameInitSettings().getGameOptions().manualCarryallDrops || getOwner()->isAI())
+               && blockDistance(location, destination) >= MIN_CARRYALL_LIFT_DISTANCE ) {
+               static_cast<GroundUnit*>(this)->requestCarryall();
+            } else if(  getOwner()->isAI()
+                        && (getItemID() == Unit_Harvester)
+                        && !static_cast<Harvester*>(this)->isReturning()
+                        && blockDistance(location, destination) >= 2) {
+                // try getting back to a refinery
+                static_cast<Harvester*>(this)->doReturn();
+            } else {
+                setDestination(location);   //can't get any closer, give up
+                forced = false;
+            }
+        }
     }
+
+    takeNextSpotFromPath();
 }
 
 void UnitBase::drawSmoke(int x, int y) const {
@@ -0,0 +1,195 @@
+/*
+ *  Micro-benchmark for the fixed point kernels the simulation is built on.
+ *
+ *  For mul, div and sqrt the optimized implementations (fix32_mul, fix32_div, fix32_sqrt)
+ *  are compared against the portable ones (fix32_*_portable): first all results are checked
+ *  to be bit-exact, then both are timed. atan2, sin/cos and the distance functions of mmath.h
+ *  are only timed. The compressed sine table of FIXMATH_SIN_LUT is checked against
+ *  round(sin(x) * 65536) and its lookup is timed.
+ *
+ *  Usage: fixpointbenchmark [iterations]
+ */
+
+#include <fixmath/FixPoint.h>
+#include <mmath.h>
+
+#include <cstdint>
+#include <fixmath/fix16_trig_sin_lut.h>
+
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+volatile fix32_t sink;
+
+/// Returns random raw values of all magnitudes with a bias towards the range the simulation uses (|x| < 2^16)
+std::vector<fix32_t> getRandomValues(std::mt19937_64& randomGen, size_t count, int maxIntegerBits) {
+    std::vector<fix32_t> values;
+    values.reserve(count);
+    std::uniform_int_distribution<int> shiftDist(0, 32 + maxIntegerBits - 1);
+    while(values.size() < count) {
+        const int bits = shiftDist(randomGen) + 1;
+        fix32_t value = (fix32_t) (randomGen() >> (64 - bits));
+        values.push_back((randomGen() & 1) ? -value : value);
+    }
+    return values;
+}
+
+/// Returns values at the edges of the value range
+std::vector<fix32_t> getEdgeValues() {
+    std::vector<fix32_t> values = { 0, 1, -1, fix32_one, -fix32_one, fix32_one >> 1, fix32_maximum, fix32_minimum, fix32_minimum + 1 };
+    for(int bit = 0; bit < 63; bit++) {
+        const fix32_t value = (fix32_t) 1 << bit;
+        for(fix32_t x : { value - 1, value, value + 1 }) {
+            values.push_back(x);
+            values.push_back(-x);
+        }
+    }
+    return values;
+}
+
+int checkBinary(const char* name, fix32_t (*optimized)(fix32_t, fix32_t), fix32_t (*portable)(fix32_t, fix32_t),
+                const std::vector<fix32_t>& a, const std::vector<fix32_t>& b, const std::vector<fix32_t>& edges) {
+    int numMismatches = 0;
+    auto check = [&](fix32_t x, fix32_t y) {
+        const fix32_t expected = portable(x, y);
+        const fix32_t actual = optimized(x, y);
+        if(expected != actual) {
+            if(numMismatches++ < 10) {
+                fprintf(stderr, "%s(0x%016" PRIX64 ", 0x%016" PRIX64 ") = 0x%016" PRIX64 " but expected 0x%016" PRIX64 "\n",
+                        name, (uint64_t) x, (uint64_t) y, (uint64_t) actual, (uint64_t) expected);
+            }
+        }
+    };
+
+    for(size_t i = 0; i < a.size(); i++) {
+        check(a[i], b[i]);
+    }
+    for(fix32_t x : edges) {
+        for(fix32_t y : edges) {
+            check(x, y);
+        }
+    }
+    return numMismatches;
+}
+
+int checkUnary(const char* name, fix32_t (*optimized)(fix32_t), fix32_t (*portable)(fix32_t),
+               const std::vector<fix32_t>& a, const std::vector<fix32_t>& edges) {
+    int numMismatches = 0;
+    auto check = [&](fix32_t x) {
+        const fix32_t expected = portable(x);
+        const fix32_t actual = optimized(x);
+        if(expected != actual) {
+            if(numMismatches++ < 10) {
+                fprintf(stderr, "%s(0x%016" PRIX64 ") = 0x%016" PRIX64 " but expected 0x%016" PRIX64 "\n",
+                        name, (uint64_t) x, (uint64_t) actual, (uint64_t) expected);
+            }
+        }
+    };
+
+    for(fix32_t x : a) {
+        check(x);
+    }
+    for(fix32_t x : edges) {
+        check(x);
+    }
+    return numMismatches;
+}
+
+int checkSinLUT() {
+    int numMismatches = 0;
+    for(uint32_t i = 0; i < _fix16_sin_lut_count; i++) {
+        const long expected = std::lround(std::sin(i / 65536.0) * 65536.0);
+        const long actual = _fix16_sin_lut_get(i);
+        if(expected != actual) {
+            if(numMismatches++ < 10) {
+                fprintf(stderr, "_fix16_sin_lut_get(%u) = %ld but expected %ld\n", i, actual, expected);
+            }
+        }
+    }
+    return numMismatches;
+}
+
+/// Runs kernel(i) for every input index and returns the time per call in ns
+double measure(size_t numInputs, int iterations, const std::function<fix32_t(size_t)>& kernel) {
+    fix32_t accumulator = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for(int iteration = 0; iteration < iterations; iteration++) {
+        for(size_t i = 0; i < numInputs; i++) {
+            accumulator ^= kernel(i);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    sink = accumulator;
+    return std::chrono::duration<double, std::nano>(end - start).count() / ((double) numInputs * iterations);
+}
+
+void printResult(const char* name, double optimized, double portable) {
+    if(portable > 0.0) {
+        printf("%-12s %8.2f ns %8.2f ns %7.2fx\n", name, optimized, portable, portable / optimized);
+    } else {
+        printf("%-12s %8.2f ns\n", name, optimized);
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+    const int iterations = (argc > 1) ? std::max(1, atoi(argv[1])) : 10;
+    const size_t numInputs = 1 << 16;
+    const size_t numCheckInputs = 1 << 22;
+
+    std::mt19937_64 randomGen(0x5EED);
+
+    const std::vector<fix32_t> edges = getEdgeValues();
+    const std::vector<fix32_t> checkA = getRandomValues(randomGen, numCheckInputs, 31);
+    const std::vector<fix32_t> checkB = getRandomValues(randomGen, numCheckInputs, 31);
+
+    int numMismatches = 0;
+    numMismatches += checkBinary("fix32_mul", fix32_mul, fix32_mul_portable, checkA, checkB, edges);
+    numMismatches += checkBinary("fix32_div", fix32_div, fix32_div_portable, checkA, checkB, edges);
+    numMismatches += checkUnary("fix32_sqrt", fix32_sqrt, fix32_sqrt_portable, checkA, edges);
+    numMismatches += checkSinLUT();
+    printf("bit-exactness: %d mismatches in %zu random inputs and %zu edge values\n", numMismatches, numCheckInputs, edges.size());
+
+    // timing inputs in the range of world coordinates and angles
+    const std::vector<fix32_t> a = getRandomValues(randomGen, numInputs, 14);
+    const std::vector<fix32_t> b = getRandomValues(randomGen, numInputs, 14);
+    std::vector<fix32_t> nonZeroB = b;
+    for(fix32_t& x : nonZeroB) {
+        x = (x == 0) ? fix32_one : x;
+    }
+    std::vector<fix32_t> angles(numInputs);
+    for(size_t i = 0; i < numInputs; i++) {
+        angles[i] = a[i] % (fix32_pi << 1);
+    }
+
+    printf("%-12s %11s %11s %8s\n", "kernel", "optimized", "portable", "speedup");
+
+    printResult("mul", measure(numInputs, iterations, [&](size_t i) { return fix32_mul(a[i], b[i]); }),
+                       measure(numInputs, iterations, [&](size_t i) { return fix32_mul_portable(a[i], b[i]); }));
+    printResult("div", measure(numInputs, iterations, [&](size_t i) { return fix32_div(a[i], nonZeroB[i]); }),
+                       measure(numInputs, iterations, [&](size_t i) { return fix32_div_portable(a[i], nonZeroB[i]); }));
+    printResult("sqrt", measure(numInputs, iterations, [&](size_t i) { return fix32_sqrt(a[i] & fix32_maximum); }),
+                        measure(numInputs, iterations, [&](size_t i) { return fix32_sqrt_portable(a[i] & fix32_maximum); }));
+    printResult("atan2", measure(numInputs, iterations, [&](size_t i) { return fix32_atan2(a[i], b[i]); }), 0.0);
+    printResult("sin", measure(numInputs, iterations, [&](size_t i) { return fix32_sin(angles[i]); }), 0.0);
+    printResult("cos", measure(numInputs, iterations, [&](size_t i) { return fix32_cos(angles[i]); }), 0.0);
+    printResult("fix16 sinlut", measure(numInputs, iterations, [&](size_t i) { return (fix32_t) _fix16_sin_lut_get((uint32_t) a[i] % _fix16_sin_lut_count); }), 0.0);
+    printResult("distance", measure(numInputs, iterations, [&](size_t i) {
+                    return distanceFrom(FixPoint::FromRawValue(a[i]), FixPoint::FromRawValue(b[i]),
+                                        FixPoint::FromRawValue(b[(i + 1) % numInputs]), FixPoint::FromRawValue(a[(i + 1) % numInputs])).getRawValue();
+                }), 0.0);
+    printResult("blockdist", measure(numInputs, iterations, [&](size_t i) {
+                    return blockDistance(Coord((int) (a[i] >> 32), (int) (b[i] >> 32)), Coord((int) (b[(i + 1) % numInputs] >> 32), (int) (a[(i + 1) % numInputs] >> 32))).getRawValue();
+                }), 0.0);
+
+    return (numMismatches == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,53 @@
+#include "FixPointTestCase.h"
+
+#include <cstdint>
+#include <fixmath/fix16_trig_sin_lut.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cmath>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FixPointTestCase);
+
+
+static long roundedSin(uint32_t index) {
+	return std::lround(std::sin(index / 65536.0) * 65536.0);
+}
+
+void FixPointTestCase::setUp() {
+}
+
+void FixPointTestCase::tearDown() {
+}
+
+void FixPointTestCase::testSinLUT() {
+	// the compressed table has to give round(sin(x) * 65536) for every index, like the uncompressed one did
+	uint32_t numMismatches = 0;
+	for(uint32_t i = 0; i < _fix16_sin_lut_count; i++) {
+		if(_fix16_sin_lut_get(i) != roundedSin(i)) {
+			numMismatches++;
+		}
+	}
+	CPPUNIT_ASSERT(numMismatches == 0);
+}
+
+void FixPointTestCase::testSinLUTValues() {
+	// some values of the uncompressed table
+	CPPUNIT_ASSERT(_fix16_sin_lut_get(0) == 0);
+	CPPUNIT_ASSERT(_fix16_sin_lut_get(1) == 1);
+	CPPUNIT_ASSERT(_fix16_sin_lut_get(63) == 63);
+	CPPUNIT_ASSERT(_fix16_sin_lut_get(64) == 64);
+	CPPUNIT_ASSERT(_fix16_sin_lut_get(1000) == 1000);
+	CPPUNIT_ASSERT(_fix16_sin_lut_get(12345) == 12272);
+	CPPUNIT_ASSERT(_fix16_sin_lut_get(51471) == 46340);
+	CPPUNIT_ASSERT(_fix16_sin_lut_get(65535) == 55146);
+	CPPUNIT_ASSERT(_fix16_sin_lut_get(90000) == 64262);
+	CPPUNIT_ASSERT(_fix16_sin_lut_get(102686) == 65535);
+	CPPUNIT_ASSERT(_fix16_sin_lut_get(102687) == 65535);
+}
+
+void FixPointTestCase::testSinLUTEnd() {
+	// the table ends right before the first angle that rounds to fix16_one
+	CPPUNIT_ASSERT(roundedSin(_fix16_sin_lut_count - 1) == 65535);
+	CPPUNIT_ASSERT(roundedSin(_fix16_sin_lut_count) == 65536);
+}
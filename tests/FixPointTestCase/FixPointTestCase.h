@@ -0,0 +1,25 @@
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class FixPointTestCase: public CppUnit::TestFixture  {
+
+	CPPUNIT_TEST_SUITE(FixPointTestCase);
+
+	CPPUNIT_TEST(testSinLUT);
+	CPPUNIT_TEST(testSinLUTValues);
+	CPPUNIT_TEST(testSinLUTEnd);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testSinLUT();
+	void testSinLUTValues();
+	void testSinLUTEnd();
+
+private:
+
+};
+
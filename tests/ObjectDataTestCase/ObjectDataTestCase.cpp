@@ -0,0 +1,127 @@
+#include "ObjectDataTestCase.h"
+
+#include <misc/IMemoryStream.h>
+#include <misc/OMemoryStream.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+// the size of one ObjectDataStruct in the save format; if this changes, SAVEGAMEVERSION and OBJECTDATA_CACHE_VERSION have to be increased
+#define OBJECTDATASTRUCT_SAVE_LENGTH	67
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ObjectDataTestCase);
+
+
+void ObjectDataTestCase::setUp() {
+	pObjectData = new ObjectData();
+	fillObjectData(*pObjectData);
+}
+
+void ObjectDataTestCase::tearDown() {
+	delete pObjectData;
+}
+
+void ObjectDataTestCase::testSaveAndLoad() {
+	ObjectData loaded;
+	size_t savedLength;
+	saveAndLoad(*pObjectData, loaded, savedLength);
+
+	CPPUNIT_ASSERT(isEqual(*pObjectData, loaded) == true);
+}
+
+void ObjectDataTestCase::testSaveAndLoadDifferentHouses() {
+	pObjectData->data[Unit_Harvester][HOUSE_ATREIDES].price = 1234;
+	pObjectData->data[Unit_Harvester][HOUSE_ORDOS].maxspeed = FixPoint(3)/2;
+	pObjectData->data[Structure_Refinery][NUM_HOUSES - 1].prerequisiteStructuresSet.set(Structure_Palace);
+	pObjectData->data[Structure_Refinery][NUM_HOUSES - 1].upgradeLevel = 2;
+
+	// every house that is saved as equal to the first house has to be overwritten on loading
+	ObjectData loaded;
+	fillObjectData(loaded);
+	for(int i=0;i<Num_ItemID;i++) {
+		for(int h=1;h<NUM_HOUSES;h++) {
+			loaded.data[i][h].hitpoints = -1;
+		}
+	}
+
+	size_t savedLength;
+	saveAndLoad(*pObjectData, loaded, savedLength);
+
+	CPPUNIT_ASSERT(isEqual(*pObjectData, loaded) == true);
+	CPPUNIT_ASSERT(loaded.data[Unit_Harvester][HOUSE_ATREIDES].price == 1234);
+	CPPUNIT_ASSERT(loaded.data[Unit_Harvester][HOUSE_HARKONNEN].price != 1234);
+	CPPUNIT_ASSERT(loaded.data[Unit_Harvester][HOUSE_ORDOS].maxspeed == FixPoint(3)/2);
+	CPPUNIT_ASSERT(loaded.data[Structure_Refinery][NUM_HOUSES - 1].prerequisiteStructuresSet.test(Structure_Palace) == true);
+	CPPUNIT_ASSERT(loaded.data[Structure_Refinery][HOUSE_HARKONNEN].prerequisiteStructuresSet.test(Structure_Palace) == false);
+}
+
+void ObjectDataTestCase::testSaveFormat() {
+	ObjectData loaded;
+	size_t savedLength;
+
+	// the first house is saved completely, every other house only as a flag that it is the same
+	saveAndLoad(*pObjectData, loaded, savedLength);
+	CPPUNIT_ASSERT(savedLength == Num_ItemID * (OBJECTDATASTRUCT_SAVE_LENGTH + (NUM_HOUSES - 1)));
+
+	// a house that differs is saved completely after its flag
+	pObjectData->data[Unit_Harvester][HOUSE_ATREIDES].price++;
+	pObjectData->data[Unit_Harvester][HOUSE_ORDOS].price++;
+	saveAndLoad(*pObjectData, loaded, savedLength);
+	CPPUNIT_ASSERT(savedLength == Num_ItemID * (OBJECTDATASTRUCT_SAVE_LENGTH + (NUM_HOUSES - 1)) + 2 * OBJECTDATASTRUCT_SAVE_LENGTH);
+}
+
+/**
+	Sets every value of every item to something different from the default values. All houses get the same values.
+	\param	objectData	the object data to fill
+*/
+void ObjectDataTestCase::fillObjectData(ObjectData& objectData) {
+	for(int i=0;i<Num_ItemID;i++) {
+		for(int h=0;h<NUM_HOUSES;h++) {
+			ObjectData::ObjectDataStruct& objectDataStruct = objectData.data[i][h];
+			objectDataStruct.enabled = (i % 2 == 0);
+			objectDataStruct.hitpoints = 100 + i;
+			objectDataStruct.price = 200 + i;
+			objectDataStruct.power = -i;
+			objectDataStruct.viewrange = i % 7;
+			objectDataStruct.capacity = 1000 * i;
+			objectDataStruct.weapondamage = 3 * i;
+			objectDataStruct.weaponrange = i % 9;
+			objectDataStruct.weaponreloadtime = 50 + i;
+			objectDataStruct.maxspeed = FixPoint(i) / 8;
+			objectDataStruct.turnspeed = FixPoint(1) / (i + 1);
+			objectDataStruct.buildtime = 10 * i;
+			objectDataStruct.infspawnprop = i % 100;
+			objectDataStruct.builder = isUnit(i) ? Structure_HeavyFactory : Structure_ConstructionYard;
+			objectDataStruct.prerequisiteStructuresSet.reset();
+			objectDataStruct.prerequisiteStructuresSet.set(i % (Structure_LastID + 1));
+			objectDataStruct.techLevel = i % 10;
+			objectDataStruct.upgradeLevel = i % 3;
+		}
+	}
+}
+
+bool ObjectDataTestCase::isEqual(const ObjectData& objectData1, const ObjectData& objectData2) {
+	for(int i=0;i<Num_ItemID;i++) {
+		for(int h=0;h<NUM_HOUSES;h++) {
+			if(!(objectData1.data[i][h] == objectData2.data[i][h])) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+	Saves source to a memory stream and loads destination from it.
+	\param	source			the object data to save
+	\param	destination		the object data to load
+	\param	savedLength		the number of bytes saved is returned here
+*/
+void ObjectDataTestCase::saveAndLoad(const ObjectData& source, ObjectData& destination, size_t& savedLength) {
+	OMemoryStream outputStream;
+	outputStream.open();
+	source.save(outputStream);
+	savedLength = outputStream.getDataLength();
+
+	IMemoryStream inputStream(outputStream.getData(), static_cast<int>(savedLength));
+	destination.load(inputStream);
+}
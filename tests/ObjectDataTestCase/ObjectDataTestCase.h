@@ -0,0 +1,31 @@
+
+#include <ObjectData.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class ObjectDataTestCase: public CppUnit::TestFixture  {
+
+	CPPUNIT_TEST_SUITE(ObjectDataTestCase);
+
+	CPPUNIT_TEST(testSaveAndLoad);
+	CPPUNIT_TEST(testSaveAndLoadDifferentHouses);
+	CPPUNIT_TEST(testSaveFormat);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testSaveAndLoad();
+	void testSaveAndLoadDifferentHouses();
+	void testSaveFormat();
+
+private:
+	static void fillObjectData(ObjectData& objectData);
+	static bool isEqual(const ObjectData& objectData1, const ObjectData& objectData2);
+	static void saveAndLoad(const ObjectData& source, ObjectData& destination, size_t& savedLength);
+
+	ObjectData* pObjectData;
+};
+
@@ -0,0 +1,19 @@
+// ObjectData.cpp needs these for loading the object data from the pak files, which is not tested here
+
+#include <globals.h>
+#include <sand.h>
+
+#include <FileClasses/FileManager.h>
+#include <misc/exceptions.h>
+
+std::unique_ptr<FileManager> pFileManager;
+
+FileManager::~FileManager() = default;
+
+sdl2::RWops_ptr FileManager::openFile(const std::string& filename) {
+	THROW(io_error, "FileManager::openFile(): Cannot open '%s' in the tests!", filename.c_str());
+}
+
+Uint32 getItemIDByName(const std::string&) {
+	return ItemID_Invalid;
+}
@@ -0,0 +1,106 @@
+#include "WallTestCase.h"
+
+#include <structures/Wall.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#define UP		1
+#define RIGHT	2
+#define DOWN	4
+#define LEFT	8
+
+CPPUNIT_TEST_SUITE_REGISTRATION(WallTestCase);
+
+
+void WallTestCase::setUp() {
+}
+
+void WallTestCase::tearDown() {
+}
+
+void WallTestCase::testIntactWallTiles() {
+	CPPUNIT_ASSERT(Wall::getWallTile(0, 0) == Wall::Wall_Standalone);
+	CPPUNIT_ASSERT(Wall::getWallTile(UP, 0) == Wall::Wall_UpDown);
+	CPPUNIT_ASSERT(Wall::getWallTile(LEFT, 0) == Wall::Wall_LeftRight);
+	CPPUNIT_ASSERT(Wall::getWallTile(LEFT | RIGHT, 0) == Wall::Wall_LeftRight);
+	CPPUNIT_ASSERT(Wall::getWallTile(UP | RIGHT, 0) == Wall::Wall_UpRight);
+	CPPUNIT_ASSERT(Wall::getWallTile(DOWN | LEFT, 0) == Wall::Wall_DownLeft);
+	CPPUNIT_ASSERT(Wall::getWallTile(UP | DOWN | LEFT, 0) == Wall::Wall_UpDownLeft);
+	CPPUNIT_ASSERT(Wall::getWallTile(UP | RIGHT | DOWN | LEFT, 0) == Wall::Wall_Full);
+}
+
+void WallTestCase::testDamagedWallTiles() {
+	CPPUNIT_ASSERT(Wall::getWallTile(UP, UP) == 17);
+	CPPUNIT_ASSERT(Wall::getWallTile(UP | DOWN, DOWN) == 18);
+	CPPUNIT_ASSERT(Wall::getWallTile(UP | DOWN, UP | DOWN) == 19);
+	CPPUNIT_ASSERT(Wall::getWallTile(LEFT | RIGHT, LEFT) == 15);
+	CPPUNIT_ASSERT(Wall::getWallTile(UP | RIGHT | DOWN | LEFT, UP) == 60);
+	CPPUNIT_ASSERT(Wall::getWallTile(UP | RIGHT | DOWN | LEFT, UP | RIGHT | DOWN | LEFT) == 74);
+}
+
+void WallTestCase::testAllWallTiles() {
+	// every side that has a destroyed wall is also connected
+	for(int connections = 0; connections < 16; connections++) {
+		for(int destroyed = 0; destroyed < 16; destroyed++) {
+			if((destroyed & ~connections) == 0) {
+				CPPUNIT_ASSERT(Wall::getWallTile(connections, destroyed) == getReferenceWallTile(connections, destroyed));
+			}
+		}
+	}
+}
+
+/**
+	Returns the wall tile the way Wall::fixWall() chose it before the tiles were looked up in a table.
+	\param	connections	the connected sides
+	\param	destroyed	the connected sides where the wall was destroyed
+	\return	the wall tile
+*/
+int WallTestCase::getReferenceWallTile(int connections, int destroyed) {
+	const bool up = (connections & UP) != 0;
+	const bool right = (connections & RIGHT) != 0;
+	const bool down = (connections & DOWN) != 0;
+	const bool left = (connections & LEFT) != 0;
+
+	int destroyedTileIndex = 0;
+	if(left == true)	destroyedTileIndex = (destroyedTileIndex << 1) | ((destroyed & LEFT) ? 1 : 0);
+	if(down == true)	destroyedTileIndex = (destroyedTileIndex << 1) | ((destroyed & DOWN) ? 1 : 0);
+	if(right == true)	destroyedTileIndex = (destroyedTileIndex << 1) | ((destroyed & RIGHT) ? 1 : 0);
+	if(up == true)		destroyedTileIndex = (destroyedTileIndex << 1) | ((destroyed & UP) ? 1 : 0);
+
+	int maketile = Wall::Wall_LeftRight;
+	if ((left == true) && (right == true) && (up == true) && (down == true)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_Full : 59 + destroyedTileIndex;
+	} else if ((left == false) && (right == true) && (up == true) && (down == true)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_UpDownRight : 31 + destroyedTileIndex;
+	} else if ((left == true) && (right == false)&& (up == true) && (down == true)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_UpDownLeft : 45 + destroyedTileIndex;
+	} else if ((left == true) && (right == true) && (up == false) && (down == true)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_DownLeftRight : 38 + destroyedTileIndex;
+	} else if ((left == true) && (right == true) && (up == true) && (down == false)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_UpLeftRight : 52 + destroyedTileIndex;
+	} else if ((left == false) && (right == true) && (up == false) && (down == true)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_DownRight : 22 + destroyedTileIndex;
+	} else if ((left == true) && (right == false) && (up == true) && (down == false)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_UpLeft : 28 + destroyedTileIndex;
+	} else if ((left == true) && (right == false) && (up == false) && (down == true)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_DownLeft : 25 + destroyedTileIndex;
+	} else if ((left == false) && (right == true) && (up == true) && (down == false)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_UpRight : 19 + destroyedTileIndex;
+	} else if ((left == true) && (right == false) && (up == false) && (down == false)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_LeftRight : 14 + destroyedTileIndex;
+	} else if ((left == false) && (right == true) && (up == false) && (down == false)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_LeftRight : 13 + destroyedTileIndex;
+	} else if ((left == false) && (right == false) && (up == true) && (down == false)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_UpDown : 16 + destroyedTileIndex;
+	} else if ((left == false) && (right == false) && (up == false) && (down == true)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_UpDown : 17 + destroyedTileIndex;
+	} else if ((left == true) && (right == true) && (up == false) && (down == false)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_LeftRight : 13 + destroyedTileIndex;
+	} else if ((left == false) && (right == false) && (up == true) && (down == true)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_UpDown : 16 + destroyedTileIndex;
+	} else if ((left == false) && (right == false) && (up == false) && (down == false)) {
+		maketile = (destroyedTileIndex == 0) ? Wall::Wall_Standalone : 12 + destroyedTileIndex;
+	}
+
+	return maketile;
+}
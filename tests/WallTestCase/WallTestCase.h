@@ -0,0 +1,25 @@
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class WallTestCase: public CppUnit::TestFixture  {
+
+	CPPUNIT_TEST_SUITE(WallTestCase);
+
+	CPPUNIT_TEST(testIntactWallTiles);
+	CPPUNIT_TEST(testDamagedWallTiles);
+	CPPUNIT_TEST(testAllWallTiles);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testIntactWallTiles();
+	void testDamagedWallTiles();
+	void testAllWallTiles();
+
+private:
+	static int getReferenceWallTile(int connections, int destroyed);
+};
+